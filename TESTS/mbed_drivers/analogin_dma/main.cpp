@@ -0,0 +1,161 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if !DEVICE_ANALOGIN_DMA
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+#define TEST_RATE_HZ    10000
+#define TEST_LENGTH     200
+#define TEST_TIME_MS    500
+
+static uint16_t samples[TEST_LENGTH];
+static volatile int half_count;
+static volatile int full_count;
+static volatile int error_count;
+static volatile bool in_order;
+static volatile int last_event;
+static const uint16_t *volatile half_ptr;
+static const uint16_t *volatile full_ptr;
+
+static void on_samples(const uint16_t *data, size_t count, int event)
+{
+    if (event == ANALOGIN_DMA_EVENT_ERROR) {
+        error_count++;
+        return;
+    }
+    if (count != TEST_LENGTH / 2 || event == last_event) {
+        in_order = false;
+    }
+    last_event = event;
+    if (event == ANALOGIN_DMA_EVENT_HALF) {
+        half_ptr = data;
+        half_count++;
+    } else {
+        full_ptr = data;
+        full_count++;
+    }
+}
+
+static void reset_counts()
+{
+    half_count = 0;
+    full_count = 0;
+    error_count = 0;
+    in_order = true;
+    last_event = ANALOGIN_DMA_EVENT_FULL;
+}
+
+static PinName first_pin()
+{
+    return analogin_pinmap()[0].pin;
+}
+
+// Another pin on the same converter as first_pin
+static PinName second_pin()
+{
+    const PinMap *map = analogin_pinmap();
+    for (int i = 1; map[i].pin != NC; i++) {
+        if (map[i].peripheral == map[0].peripheral && map[i].pin != map[0].pin) {
+            return map[i].pin;
+        }
+    }
+    return NC;
+}
+
+void test_set_sample_rate()
+{
+    AnalogInDMA adc(first_pin());
+
+    uint32_t rate = adc.set_sample_rate(TEST_RATE_HZ);
+    TEST_ASSERT_UINT32_WITHIN(TEST_RATE_HZ / 100, TEST_RATE_HZ, rate);
+    TEST_ASSERT_EQUAL_UINT32(0, adc.set_sample_rate(0));
+}
+
+void test_single_channel()
+{
+    AnalogInDMA adc(first_pin());
+    reset_counts();
+
+    TEST_ASSERT_NOT_EQUAL(0, adc.set_sample_rate(TEST_RATE_HZ));
+    TEST_ASSERT_EQUAL(-1, adc.start(samples, TEST_LENGTH - 1, on_samples));
+    TEST_ASSERT_EQUAL(0, adc.start(samples, TEST_LENGTH, on_samples));
+    TEST_ASSERT_EQUAL(-1, adc.start(samples, TEST_LENGTH, on_samples));
+    wait_ms(TEST_TIME_MS);
+    adc.stop();
+
+    // Each half holds TEST_LENGTH / 2 samples
+    int expected = TEST_RATE_HZ * TEST_TIME_MS / 1000 / (TEST_LENGTH / 2);
+    TEST_ASSERT_INT_WITHIN(2, expected, half_count + full_count);
+    TEST_ASSERT_INT_WITHIN(1, half_count, full_count);
+    TEST_ASSERT_EQUAL(0, error_count);
+    TEST_ASSERT_TRUE(in_order);
+    TEST_ASSERT_EQUAL_PTR(samples, half_ptr);
+    TEST_ASSERT_EQUAL_PTR(samples + TEST_LENGTH / 2, full_ptr);
+
+    // No more callbacks once stopped
+    int count = half_count + full_count;
+    wait_ms(50);
+    TEST_ASSERT_EQUAL(count, half_count + full_count);
+}
+
+void test_multi_channel()
+{
+    const PinName pins[2] = {first_pin(), second_pin()};
+    if (pins[1] == NC) {
+        TEST_IGNORE_MESSAGE("No second input on the same converter");
+    }
+    AnalogInDMA adc(pins, 2);
+    reset_counts();
+
+    TEST_ASSERT_NOT_EQUAL(0, adc.set_sample_rate(TEST_RATE_HZ));
+    TEST_ASSERT_EQUAL(-1, adc.start(samples, TEST_LENGTH + 2, on_samples));
+    TEST_ASSERT_EQUAL(0, adc.start(samples, TEST_LENGTH, on_samples));
+    wait_ms(TEST_TIME_MS);
+    adc.stop();
+
+    // Both channels are sampled at the rate, so halves fill twice as fast
+    int expected = 2 * TEST_RATE_HZ * TEST_TIME_MS / 1000 / (TEST_LENGTH / 2);
+    TEST_ASSERT_INT_WITHIN(2, expected, half_count + full_count);
+    TEST_ASSERT_EQUAL(0, error_count);
+    TEST_ASSERT_TRUE(in_order);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("AnalogInDMA - set sample rate", test_set_sample_rate),
+    Case("AnalogInDMA - single channel", test_single_channel),
+    Case("AnalogInDMA - multi channel", test_multi_channel),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
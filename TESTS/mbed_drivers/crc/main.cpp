@@ -125,6 +125,89 @@ void test_any_polynomial()
     }
 }
 
+void test_sliced_crc()
+{
+    char  test[] = "123456789";
+    uint32_t crc;
+    {
+        MbedCRC<POLY_32BIT_ANSI, 32, 4> ct;
+        TEST_ASSERT_EQUAL(0, ct.compute((void *)test, strlen((const char *)test), &crc));
+        TEST_ASSERT_EQUAL(0xCBF43926, crc);
+    }
+    {
+        MbedCRC<POLY_32BIT_ANSI, 32, 8> ct;
+        TEST_ASSERT_EQUAL(0, ct.compute((void *)test, strlen((const char *)test), &crc));
+        TEST_ASSERT_EQUAL(0xCBF43926, crc);
+    }
+    {
+        MbedCRC<POLY_32BIT_REV_ANSI, 32, 8> ct;
+        TEST_ASSERT_EQUAL(0, ct.compute((void *)test, strlen((const char *)test), &crc));
+        TEST_ASSERT_EQUAL(0xCBF43926, crc);
+    }
+    {
+        // Unaligned start, odd length and no remainder reflection as used by TDBStore
+        MbedCRC<POLY_32BIT_ANSI, 32> ref(0x12345678, 0, true, false);
+        MbedCRC<POLY_32BIT_ANSI, 32, 8> ct(0x12345678, 0, true, false);
+        uint8_t data[67];
+        uint32_t expected;
+        for (size_t i = 0; i < sizeof(data); i++) {
+            data[i] = i * 7;
+        }
+        TEST_ASSERT_EQUAL(0, ref.compute(&data[1], sizeof(data) - 1, &expected));
+        TEST_ASSERT_EQUAL(0, ct.compute_partial_start(&crc));
+        TEST_ASSERT_EQUAL(0, ct.compute_partial(&data[1], 21, &crc));
+        TEST_ASSERT_EQUAL(0, ct.compute_partial(&data[22], sizeof(data) - 22, &crc));
+        TEST_ASSERT_EQUAL(0, ct.compute_partial_stop(&crc));
+        TEST_ASSERT_EQUAL(expected, crc);
+    }
+}
+
+template <class T>
+static int crc_benchmark_us(T &ct, const uint8_t *data, size_t size, uint32_t *crc)
+{
+    Timer timer;
+    timer.start();
+    TEST_ASSERT_EQUAL(0, ct.compute(data, size, crc));
+    timer.stop();
+    return timer.read_us();
+}
+
+void test_benchmark()
+{
+    const size_t size = 4096;
+    static uint8_t data[size];
+    for (size_t i = 0; i < size; i++) {
+        data[i] = i;
+    }
+    uint32_t crc;
+    uint32_t expected;
+
+    // CRC-32C has no table, so it shows the cost of the bitwise computation
+    MbedCRC<0x1EDC6F41, 32> bitwise(0xFFFFFFFF, 0xFFFFFFFF, 1, 1);
+    int bitwise_us = crc_benchmark_us(bitwise, data, size, &crc);
+
+    MbedCRC<POLY_32BIT_ANSI, 32> automatic;
+    int automatic_us = crc_benchmark_us(automatic, data, size, &expected);
+
+    MbedCRC<POLY_16BIT_CCITT, 16> table;
+    int table_us = crc_benchmark_us(table, data, size, &crc);
+
+    MbedCRC<POLY_32BIT_ANSI, 32, 4> slice4;
+    int slice4_us = crc_benchmark_us(slice4, data, size, &crc);
+    TEST_ASSERT_EQUAL(expected, crc);
+
+    MbedCRC<POLY_32BIT_ANSI, 32, 8> slice8;
+    int slice8_us = crc_benchmark_us(slice8, data, size, &crc);
+    TEST_ASSERT_EQUAL(expected, crc);
+
+    printf("CRC of %u bytes, in us:\r\n", (unsigned)size);
+    printf("  bitwise CRC-32C       %d\r\n", bitwise_us);
+    printf("  default CRC-32        %d\r\n", automatic_us);
+    printf("  table CRC-16 CCITT    %d\r\n", table_us);
+    printf("  slice-by-4 CRC-32     %d\r\n", slice4_us);
+    printf("  slice-by-8 CRC-32     %d\r\n", slice8_us);
+}
+
 void test_thread(void)
 {
     char  test[] = "123456789";
@@ -159,6 +242,8 @@ Case cases[] = {
     Case("Test partial CRC", test_partial_crc),
     Case("Test SD CRC polynomials", test_sd_crc),
     Case("Test not supported polynomials", test_any_polynomial),
+    Case("Test sliced CRC", test_sliced_crc),
+    Case("Test CRC benchmark", test_benchmark),
     Case("Test thread safety", test_thread_safety)
 };
 
@@ -119,6 +119,14 @@ void flashiap_program_test()
         TEST_ASSERT_EQUAL_UINT8_ARRAY(data, data_flashed, prog_size);
     }
 
+    // memory-mapped flash reads back the same in place
+    const uint8_t *mapped = static_cast<const uint8_t *>(flash_device.get_mapped_address(address));
+    if (mapped) {
+        for (uint32_t i = 0; i < sector_size / prog_size; i++) {
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(data, mapped + i * prog_size, prog_size);
+        }
+    }
+
     // check programming of unaligned buffer and size
     ret = flash_device.erase(address, sector_size);
     TEST_ASSERT_EQUAL_INT32(0, ret);
@@ -307,6 +315,75 @@ void flashiap_timing_test()
     TEST_ASSERT_EQUAL_INT32(0, ret);
 }
 
+static volatile int async_result;
+static volatile bool async_done;
+
+static void flashiap_async_callback(int result)
+{
+    async_result = result;
+    async_done = true;
+}
+
+static void flashiap_async_wait()
+{
+    Timer timer;
+    timer.start();
+    while (!async_done && timer.read_ms() < 10000) {
+    }
+    TEST_ASSERT_TRUE(async_done);
+    TEST_ASSERT_EQUAL_INT32(0, async_result);
+}
+
+void flashiap_async_test()
+{
+    FlashIAP flash_device;
+    int ret = flash_device.init();
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    // the last sector in the system
+    uint32_t sector_size = flash_device.get_sector_size(flash_device.get_flash_start() + flash_device.get_flash_size() - 1UL);
+    uint32_t page_size = flash_device.get_page_size();
+    uint32_t address = (flash_device.get_flash_start() + flash_device.get_flash_size()) - (sector_size);
+    TEST_SKIP_UNLESS_MESSAGE(address >= FLASHIAP_APP_ROM_END_ADDR, "Test skipped. Test region overlaps code.");
+    utest_printf("Test sector at 0x%lx is %s the application bank\n", address,
+                 flash_device.is_background_writable(address) ? "outside" : "in");
+
+    uint32_t prog_size = std::max(page_size, (uint32_t)256) / page_size * page_size;
+    uint32_t *data = new uint32_t[(prog_size + 3) / 4];
+    uint8_t *data_flashed = new uint8_t[prog_size];
+    for (uint32_t i = 0; i < prog_size; i++) {
+        ((uint8_t *) data)[i] = i;
+    }
+
+    async_done = false;
+    ret = flash_device.erase_async(address, sector_size, flashiap_async_callback);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    flashiap_async_wait();
+
+    async_done = false;
+    ret = flash_device.program_async(data, address, prog_size, flashiap_async_callback);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    // only one operation at a time
+    if (!async_done) {
+        TEST_ASSERT_NOT_EQUAL(0, flash_device.erase(address, sector_size));
+    }
+    flashiap_async_wait();
+
+    ret = flash_device.read(data_flashed, address, prog_size);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, data_flashed, prog_size);
+
+    // unaligned buffers are refused
+    ret = flash_device.program_async((uint8_t *) data + 1, address, prog_size, flashiap_async_callback);
+    TEST_ASSERT_NOT_EQUAL(0, ret);
+
+    delete[] data;
+    delete[] data_flashed;
+
+    ret = flash_device.deinit();
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+}
+
 
 Case cases[] = {
     Case("FlashIAP - init", flashiap_init_test),
@@ -314,6 +391,7 @@ Case cases[] = {
     Case("FlashIAP - program across sectors", flashiap_cross_sector_program_test),
     Case("FlashIAP - program errors", flashiap_program_error_test),
     Case("FlashIAP - timing", flashiap_timing_test),
+    Case("FlashIAP - asynchronous erase and program", flashiap_async_test),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
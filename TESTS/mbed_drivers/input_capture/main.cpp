@@ -0,0 +1,106 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if !DEVICE_CAPTURE
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+// Any pin on a capture channel of a timer supported by the target, left unconnected
+#ifndef CAPTURE_TEST_PIN
+#define CAPTURE_TEST_PIN D3
+#endif
+
+#define TEST_FREQUENCY_HZ   1000000
+#define TEST_LENGTH         16
+
+static uint32_t timestamps[TEST_LENGTH];
+static volatile int callback_count;
+
+static void on_edges(const uint32_t *data, size_t count, int event)
+{
+    callback_count++;
+}
+
+void test_set_frequency()
+{
+    InputCapture capture(CAPTURE_TEST_PIN);
+
+    uint32_t frequency = capture.set_frequency(TEST_FREQUENCY_HZ);
+    TEST_ASSERT_UINT32_WITHIN(TEST_FREQUENCY_HZ / 100, TEST_FREQUENCY_HZ, frequency);
+    TEST_ASSERT_EQUAL_UINT32(0, capture.set_frequency(0));
+}
+
+void test_set_debounce()
+{
+    InputCapture capture(CAPTURE_TEST_PIN);
+
+    TEST_ASSERT_EQUAL_UINT32(0, capture.set_debounce(0));
+
+    // The filter applied is at least as long as requested, up to the longest available
+    uint32_t short_filter = capture.set_debounce(100);
+    TEST_ASSERT_TRUE(short_filter >= 100);
+    uint32_t long_filter = capture.set_debounce(2000);
+    TEST_ASSERT_TRUE(long_filter >= short_filter);
+}
+
+void test_start_stop()
+{
+    InputCapture capture(CAPTURE_TEST_PIN);
+    callback_count = 0;
+
+    // Starting needs a frequency and an even buffer length
+    TEST_ASSERT_EQUAL(-1, capture.start(timestamps, TEST_LENGTH, CAPTURE_EDGE_BOTH, on_edges));
+    TEST_ASSERT_NOT_EQUAL(0, capture.set_frequency(TEST_FREQUENCY_HZ));
+    TEST_ASSERT_EQUAL(-1, capture.start(timestamps, TEST_LENGTH - 1, CAPTURE_EDGE_BOTH, on_edges));
+    TEST_ASSERT_EQUAL(0, capture.start(timestamps, TEST_LENGTH, CAPTURE_EDGE_BOTH, on_edges));
+    TEST_ASSERT_EQUAL(-1, capture.start(timestamps, TEST_LENGTH, CAPTURE_EDGE_BOTH, on_edges));
+
+    // The input is left unconnected, no edges are captured
+    wait_ms(50);
+    TEST_ASSERT_EQUAL(0, capture.position());
+    capture.stop();
+    TEST_ASSERT_EQUAL(0, callback_count);
+
+    // Can be restarted once stopped
+    TEST_ASSERT_EQUAL(0, capture.start(timestamps, TEST_LENGTH, CAPTURE_EDGE_RISING, on_edges));
+    capture.stop();
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("InputCapture - set frequency", test_set_frequency),
+    Case("InputCapture - set debounce", test_set_debounce),
+    Case("InputCapture - start and stop", test_start_stop),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
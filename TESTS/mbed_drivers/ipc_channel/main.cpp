@@ -0,0 +1,202 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#if !DEVICE_IPC
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+// The channel sends to itself, so the test runs on one core
+#define TEST_CHANNEL    0
+#define TEST_RING_SIZE  (64 + 256)
+
+// The peer channel echoes between the cores, through the two rings after the loopback ring.
+// On PSoC6 the CM0+ image of this test is the echo peer of the CM4 image.
+#if defined(TARGET_MCU_PSOC6_M0) || defined(TARGET_MCU_PSOC6_M4)
+#define TEST_PEER_CHANNEL   1
+#endif
+
+#if defined(TARGET_MCU_PSOC6_M0)
+
+int main()
+{
+    size_t shared_size;
+    uint8_t *shared = static_cast<uint8_t *>(ipc_get_shared_memory(&shared_size));
+    MBED_ASSERT(shared && shared_size >= 3 * TEST_RING_SIZE);
+    IPCChannel peer(TEST_PEER_CHANNEL, shared + 2 * TEST_RING_SIZE, TEST_RING_SIZE, shared + TEST_RING_SIZE);
+
+    uint8_t message[TEST_RING_SIZE];
+    while (true) {
+        ssize_t size = peer.receive(message, sizeof(message));
+        if (size > 0) {
+            peer.send(message, size, IPCChannel::wait_forever);
+        }
+    }
+}
+
+#else
+
+static IPCChannel *channel;
+#ifdef TEST_PEER_CHANNEL
+static IPCChannel *peer;
+#endif
+
+/** Test messages written and read in place
+
+    Given a channel looped back on itself
+    When messages are reserved, committed, peeked and consumed
+    Then the messages are received in order, also across the end of the ring
+ */
+void test_zero_copy()
+{
+    for (uint32_t i = 0; i < 40; i++) {
+        size_t size = 1 + (i * 13) % channel->max_message_size();
+        uint8_t *data = static_cast<uint8_t *>(channel->reserve(size));
+        TEST_ASSERT_NOT_NULL(data);
+        memset(data, i, size);
+        channel->commit(size);
+
+        size_t received;
+        const uint8_t *message = static_cast<const uint8_t *>(channel->peek(&received));
+        TEST_ASSERT_NOT_NULL(message);
+        TEST_ASSERT_EQUAL(size, received);
+        TEST_ASSERT_EACH_EQUAL_UINT8(i, message, size);
+        channel->consume();
+    }
+
+    size_t received;
+    TEST_ASSERT_NULL(channel->peek(&received));
+}
+
+/** Test copying messages in and out
+
+    Given a channel looped back on itself
+    When messages are sent until the ring is full
+    Then sending fails without blocking, and the messages are received in order
+ */
+void test_send_receive()
+{
+    uint32_t value;
+    uint32_t sent = 0;
+
+    TEST_ASSERT_EQUAL(-EMSGSIZE, channel->send(&value, channel->max_message_size() + 1));
+    TEST_ASSERT_EQUAL(-EAGAIN, channel->receive(&value, sizeof(value), 0));
+
+    while (channel->send(&sent, sizeof(sent)) == sizeof(sent)) {
+        sent++;
+    }
+    // 8 bytes per message, less one if the end of the ring was skipped
+    TEST_ASSERT_UINT32_WITHIN(1, 256 / 8 - 1, sent);
+    TEST_ASSERT_TRUE(sent <= 256 / 8);
+
+    for (uint32_t i = 0; i < sent; i++) {
+        TEST_ASSERT_EQUAL(sizeof(value), channel->receive(&value, sizeof(value), 0));
+        TEST_ASSERT_EQUAL(i, value);
+    }
+    TEST_ASSERT_EQUAL(-EAGAIN, channel->receive(&value, sizeof(value), 0));
+}
+
+/** Test the FileHandle interface
+
+    Given a non-blocking channel looped back on itself
+    When more bytes than a message holds are written
+    Then they are read back in pieces of any size, and poll reports the state
+ */
+void test_stream()
+{
+    static const char text[] = "The quick brown fox jumps over the lazy dog, then over the lazy dog again and again.";
+    char buffer[sizeof(text)];
+    size_t length = 0;
+    ssize_t got;
+
+    channel->set_blocking(false);
+    TEST_ASSERT_EQUAL(POLLOUT, channel->poll(POLLIN | POLLOUT));
+    TEST_ASSERT_EQUAL(sizeof(text), channel->write(text, sizeof(text)));
+    TEST_ASSERT_TRUE(channel->poll(POLLIN) & POLLIN);
+
+    while ((got = channel->read(buffer + length, 5)) > 0) {
+        length += got;
+    }
+    TEST_ASSERT_EQUAL(-EAGAIN, got);
+    TEST_ASSERT_EQUAL(sizeof(text), length);
+    TEST_ASSERT_EQUAL_STRING(text, buffer);
+    channel->set_blocking(true);
+}
+
+#ifdef TEST_PEER_CHANNEL
+/** Test messages echoed by the other core
+
+    Given a channel to the other core, which sends every message back
+    When messages of growing size are sent, and received blocking
+    Then the interrupt of the other core wakes the receive, with the same message
+ */
+void test_peer_echo()
+{
+    uint8_t message[TEST_RING_SIZE];
+    uint8_t echo[TEST_RING_SIZE];
+
+    for (uint32_t i = 0; i < 100; i++) {
+        size_t size = 1 + (i * 7) % peer->max_message_size();
+        memset(message, i, size);
+        TEST_ASSERT_EQUAL(size, peer->send(message, size, 1000));
+        TEST_ASSERT_EQUAL(size, peer->receive(echo, sizeof(echo), 1000));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(message, echo, size);
+    }
+}
+#endif
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    size_t shared_size;
+    uint8_t *shared = static_cast<uint8_t *>(ipc_get_shared_memory(&shared_size));
+    if (!shared || shared_size < TEST_RING_SIZE) {
+        return STATUS_ABORT;
+    }
+    channel = new IPCChannel(TEST_CHANNEL, shared, TEST_RING_SIZE, shared);
+#ifdef TEST_PEER_CHANNEL
+    if (shared_size < 3 * TEST_RING_SIZE) {
+        return STATUS_ABORT;
+    }
+    peer = new IPCChannel(TEST_PEER_CHANNEL, shared + TEST_RING_SIZE, TEST_RING_SIZE, shared + 2 * TEST_RING_SIZE);
+#endif
+
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test zero copy messages", test_zero_copy),
+    Case("Test send and receive", test_send_receive),
+    Case("Test stream", test_stream),
+#ifdef TEST_PEER_CHANNEL
+    Case("Test echo from the other core", test_peer_echo),
+#endif
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif
@@ -0,0 +1,126 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+static int static_func(int a)
+{
+    return a * 2;
+}
+
+struct Thing {
+    int t;
+    Thing() : t(0x80) {}
+    int member_func(int a)
+    {
+        return t | a;
+    }
+    int const_member_func(int a) const
+    {
+        return t + a;
+    }
+};
+
+void test_inline_callback_lambda()
+{
+    int a = 1, b = 2, c = 3;
+    InlineCallback<int(int)> cb = [a, b, c](int x) {
+        return a + b + c + x;
+    };
+    TEST_ASSERT_TRUE(cb);
+    TEST_ASSERT_EQUAL(16, cb(10));
+    TEST_ASSERT_EQUAL(16, cb.call(10));
+    TEST_ASSERT_EQUAL(16, (InlineCallback<int(int)>::thunk(&cb, 10)));
+}
+
+void test_inline_callback_large_lambda()
+{
+    uint32_t values[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    InlineCallback<uint32_t(), sizeof(values)> cb = [values]() {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            sum += values[i];
+        }
+        return sum;
+    };
+    TEST_ASSERT_EQUAL(36, cb());
+}
+
+void test_inline_callback_functions()
+{
+    Thing thing;
+
+    InlineCallback<int(int)> sf(static_func);
+    TEST_ASSERT_EQUAL(42, sf(21));
+
+    InlineCallback<int(int)> mf(&thing, &Thing::member_func);
+    TEST_ASSERT_EQUAL(0x81, mf(1));
+
+    InlineCallback<int(int)> cmf((const Thing *)&thing, &Thing::const_member_func);
+    TEST_ASSERT_EQUAL(0x82, cmf(2));
+
+    InlineCallback<int(int)> empty;
+    TEST_ASSERT_FALSE(empty);
+    InlineCallback<int(int)> null_func((int (*)(int))NULL);
+    TEST_ASSERT_FALSE(null_func);
+}
+
+void test_inline_callback_copy_move()
+{
+    int a = 5;
+    InlineCallback<int()> cb = [a]() {
+        return a;
+    };
+
+    InlineCallback<int()> copy(cb);
+    TEST_ASSERT_TRUE(cb);
+    TEST_ASSERT_EQUAL(5, copy());
+
+    InlineCallback<int()> moved(std::move(cb));
+    TEST_ASSERT_FALSE(cb);
+    TEST_ASSERT_EQUAL(5, moved());
+
+    cb = copy;
+    TEST_ASSERT_EQUAL(5, cb());
+    copy = std::move(moved);
+    TEST_ASSERT_FALSE(moved);
+    TEST_ASSERT_EQUAL(5, copy());
+}
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Testing inline callback with lambda", test_inline_callback_lambda),
+    Case("Testing inline callback with large lambda", test_inline_callback_large_lambda),
+    Case("Testing inline callback with functions", test_inline_callback_functions),
+    Case("Testing inline callback copy and move", test_inline_callback_copy_move),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -23,6 +23,7 @@ using namespace utest::v1;
 
 #include "PinNames.h"
 #include "gpio_api.h"
+#include "gpio_fast_api.h"
 
 static void gpio_nc_test()
 {
@@ -39,8 +40,30 @@ static void gpio_nc_test()
     }
 }
 
+static void gpio_fast_test()
+{
+    if (LED1 == NC) {
+        TEST_IGNORE_MESSAGE("LED1 not available");
+        return;
+    }
+
+    gpio_t led_obj;
+    gpio_init_out(&led_obj, LED1);
+
+    gpio_fast_set(&led_obj);
+    TEST_ASSERT_EQUAL(gpio_read(&led_obj), gpio_fast_read(&led_obj));
+    gpio_fast_clear(&led_obj);
+    TEST_ASSERT_EQUAL(gpio_read(&led_obj), gpio_fast_read(&led_obj));
+
+    gpio_write(&led_obj, 1);
+    TEST_ASSERT_EQUAL(gpio_read(&led_obj), gpio_fast_read(&led_obj));
+    gpio_write(&led_obj, 0);
+    TEST_ASSERT_EQUAL(gpio_read(&led_obj), gpio_fast_read(&led_obj));
+}
+
 Case cases[] = {
-    Case("gpio NC test", gpio_nc_test)
+    Case("gpio NC test", gpio_nc_test),
+    Case("gpio fast API test", gpio_fast_test)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
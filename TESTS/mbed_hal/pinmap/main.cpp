@@ -28,6 +28,7 @@ using namespace utest::v1;
 #include "qspi_api.h"
 #include "serial_api.h"
 #include "spi_api.h"
+#include "static_pinmap.h"
 
 #define PINMAP_TEST_ENTRY(function)     {function, #function}
 
@@ -109,8 +110,53 @@ void pinmap_validation()
     }
 }
 
+/* Static pinmaps resolve each pin like the run time lookup in the HAL's tables */
+static void check_static_peripheral(const PinMap *map, int peripheral, PinName pin)
+{
+#if defined(TARGET_STATIC_PINMAP_READY)
+    TEST_ASSERT_EQUAL((int)pinmap_find_peripheral(pin, map), peripheral);
+#else
+    (void)map;
+    (void)pin;
+    TEST_ASSERT_EQUAL((int)NC, peripheral);
+#endif
+}
+
+void pinmap_static()
+{
+#if DEVICE_SPI
+    for (const PinMap *map = spi_master_mosi_pinmap(); map->pin != NC; map++) {
+        spi_pinmap_t spi_pinmap = get_spi_pinmap(map->pin, NC, NC, NC);
+        TEST_ASSERT_EQUAL(map->pin, spi_pinmap.mosi_pin);
+        check_static_peripheral(spi_master_mosi_pinmap(), spi_pinmap.peripheral, map->pin);
+    }
+#endif
+#if DEVICE_I2C
+    for (const PinMap *map = i2c_master_sda_pinmap(); map->pin != NC; map++) {
+        i2c_pinmap_t i2c_pinmap = get_i2c_pinmap(map->pin, NC);
+        TEST_ASSERT_EQUAL(map->pin, i2c_pinmap.sda_pin);
+        check_static_peripheral(i2c_master_sda_pinmap(), i2c_pinmap.peripheral, map->pin);
+    }
+#endif
+#if DEVICE_SERIAL
+    for (const PinMap *map = serial_tx_pinmap(); map->pin != NC; map++) {
+        serial_pinmap_t serial_pinmap = get_uart_pinmap(map->pin, NC);
+        TEST_ASSERT_EQUAL(map->pin, serial_pinmap.tx_pin);
+        check_static_peripheral(serial_tx_pinmap(), serial_pinmap.peripheral, map->pin);
+    }
+#endif
+#if DEVICE_PWMOUT
+    for (const PinMap *map = pwmout_pinmap(); map->pin != NC; map++) {
+        PinMap pwm_pinmap = get_pwm_pinmap(map->pin);
+        TEST_ASSERT_EQUAL(map->pin, pwm_pinmap.pin);
+        check_static_peripheral(pwmout_pinmap(), pwm_pinmap.peripheral, map->pin);
+    }
+#endif
+}
+
 Case cases[] = {
-    Case("pinmap - validation", pinmap_validation)
+    Case("pinmap - validation", pinmap_validation),
+    Case("pinmap - static pinmap", pinmap_static)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -67,6 +67,31 @@ void test_lock_unlock()
     TEST_ASSERT_TRUE(sleep_manager_can_deep_sleep());
 }
 
+void test_latency_constraint()
+{
+    sleep_manager_latency_t strict, relaxed;
+
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, sleep_manager_max_latency());
+    TEST_ASSERT_TRUE(sleep_manager_can_deep_sleep());
+
+    sleep_manager_latency_add(&relaxed, MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY);
+    TEST_ASSERT_EQUAL_UINT32(MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY, sleep_manager_max_latency());
+    TEST_ASSERT_TRUE(sleep_manager_can_deep_sleep());
+
+    if (MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY > 0) {
+        sleep_manager_latency_add(&strict, MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY - 1);
+        TEST_ASSERT_EQUAL_UINT32(MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY - 1, sleep_manager_max_latency());
+        TEST_ASSERT_FALSE(sleep_manager_can_deep_sleep());
+
+        sleep_manager_latency_remove(&strict);
+        TEST_ASSERT_TRUE(sleep_manager_can_deep_sleep());
+    }
+
+    sleep_manager_latency_remove(&relaxed);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, sleep_manager_max_latency());
+    TEST_ASSERT_TRUE(sleep_manager_can_deep_sleep());
+}
+
 void test_lock_eq_ushrt_max()
 {
     uint32_t lock_count = 0;
@@ -309,6 +334,10 @@ Case cases[] = {
          (utest::v1::case_setup_handler_t) testcase_setup,
          test_lock_unlock,
          (utest::v1::case_teardown_handler_t) testcase_teardown),
+    Case("wake-up latency constraints",
+         (utest::v1::case_setup_handler_t) testcase_setup,
+         test_latency_constraint,
+         (utest::v1::case_teardown_handler_t) testcase_teardown),
     Case("deep sleep locked USHRT_MAX times",
          (utest::v1::case_setup_handler_t) testcase_setup,
          test_lock_eq_ushrt_max,
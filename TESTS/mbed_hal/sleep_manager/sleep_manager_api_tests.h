@@ -50,6 +50,20 @@ void test_lock_unlock();
  */
 void test_lock_eq_ushrt_max();
 
+/** Test wake-up latency constraints
+ *
+ * Given no prior latency constraints
+ * When a constraint shorter than the deep sleep latency is added
+ * Then the deep sleep is not allowed
+ *
+ * When a constraint at least as long as the deep sleep latency is added
+ * Then the strictest constraint applies
+ *
+ * When the constraints are removed
+ * Then the deep sleep is allowed again
+ */
+void test_latency_constraint();
+
 /** Test sleep_auto calls sleep and deep sleep based on lock
  *
  * Given a device with sleep mode support
@@ -135,6 +135,7 @@ static void reset_queue_stub()
     queue_stub.max_delta = 0;
     queue_stub.max_delta_us = 0;
     queue_stub.present_time = 0;
+    queue_stub.sequence = 0;
     queue_stub.initialized = false;
 }
 
@@ -1143,6 +1144,45 @@ static void test_insert_event_us_tail()
     TEST_ASSERT_EQUAL(0, interface_stub.disable_interrupt_call);
 }
 
+/**
+ * Given an initialized ticker.
+ * When events are inserted with ticker_insert_event_us_slack.
+ * Then
+ *   - An event should take the timestamp of a queued event within its slack
+ *     window.
+ *   - An event without a queued event in its window should be rounded up to
+ *     a multiple of the largest power of two not above its slack.
+ *   - An event with no slack should keep its timestamp.
+ *   - Events in the queue should remained ordered by timestamp.
+ */
+static void test_insert_event_us_slack()
+{
+    ticker_set_handler(&ticker_stub, NULL);
+    interface_stub.set_interrupt_call = 0;
+
+    ticker_event_t events[4] = { 0 };
+
+    ticker_insert_event_us(&ticker_stub, &events[0], 1000, 0);
+
+    ticker_insert_event_us_slack(&ticker_stub, &events[1], 900, 200, 1);
+    TEST_ASSERT_EQUAL_UINT64(1000, events[1].timestamp);
+
+    ticker_insert_event_us_slack(&ticker_stub, &events[2], 1100, 100, 2);
+    TEST_ASSERT_EQUAL_UINT64(1152, events[2].timestamp);
+
+    ticker_insert_event_us_slack(&ticker_stub, &events[3], 1101, 0, 3);
+    TEST_ASSERT_EQUAL_UINT64(1101, events[3].timestamp);
+
+    TEST_ASSERT_EQUAL_PTR(&events[0], queue_stub.head);
+    TEST_ASSERT_EQUAL_UINT32(1000, interface_stub.interrupt_timestamp);
+
+    ticker_event_t *e = queue_stub.head;
+    while (e->next) {
+        TEST_ASSERT_TRUE(e->timestamp <= e->next->timestamp);
+        e = e->next;
+    }
+}
+
 /**
  * Given an initialized ticker.
  * When an event is inserted with ticker_insert_event_us.
@@ -2148,6 +2188,31 @@ void test_frequencies_and_masks(uint32_t frequency, uint32_t bits)
     }
 }
 
+/**
+ * Given an initialized ticker instance and an interface of a
+ * certain frequency and bit width.
+ * Then the time read without a critical section should match the cumulative
+ * time, before and after the present time is updated.
+ */
+void test_read_lock_free(uint32_t frequency, uint32_t bits)
+{
+    const uint32_t bitmask = ((uint64_t)1 << bits) - 1;
+
+    ticker_set_handler(&ticker_stub, NULL);
+    uint64_t ticks = 0;
+
+    for (unsigned int k = 0; k < 1000; k++) {
+        // Less than the counter range between updates, in uneven steps
+        ticks += (((uint64_t)1 << bits) - 1) / (k % 7 + 2) + 1;
+        interface_stub.timestamp = ticks & bitmask;
+        TEST_ASSERT_EQUAL_UINT64(convert_to_us(ticks, frequency), ticker_read_us_lock_free(&ticker_stub));
+        if (k % 2) {
+            TEST_ASSERT_EQUAL_UINT64(convert_to_us(ticks, frequency), ticker_read_us(&ticker_stub));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, queue_stub.sequence & 1);
+}
+
 /**
  * Given an uninitialized ticker_data instance.
  * When the ticker is initialized
@@ -2389,6 +2454,7 @@ static const case_t cases[] = {
     ),
     MAKE_TEST_CASE("test_insert_event_us_head", test_insert_event_us_head),
     MAKE_TEST_CASE("test_insert_event_us_tail", test_insert_event_us_tail),
+    MAKE_TEST_CASE("test_insert_event_us_slack", test_insert_event_us_slack),
     MAKE_TEST_CASE(
         "test_insert_event_us_multiple_random",
         test_insert_event_us_multiple_random
@@ -2441,6 +2507,10 @@ static const case_t cases[] = {
         "test_frequencies_and_masks",
         test_over_frequency_and_width<test_frequencies_and_masks>
     ),
+    MAKE_TEST_CASE(
+        "test_read_lock_free",
+        test_over_frequency_and_width<test_read_lock_free>
+    ),
     MAKE_TEST_CASE(
         "test_ticker_max_value",
         test_ticker_max_value
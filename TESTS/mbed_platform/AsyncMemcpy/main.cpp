@@ -0,0 +1,132 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+
+#include "platform/AsyncMemcpy.h"
+
+using utest::v1::Case;
+
+#define BUFFER_SIZE 4096
+
+static uint8_t source_data[BUFFER_SIZE];
+static uint8_t dest_data[BUFFER_SIZE + 8];
+
+static volatile int copy_result;
+static volatile int copy_count;
+
+static void copied(int result)
+{
+    copy_result = result;
+    copy_count++;
+}
+
+static void fill()
+{
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        source_data[i] = i * 7 + 1;
+    }
+    memset(dest_data, 0, sizeof(dest_data));
+    copy_result = 1;
+    copy_count = 0;
+}
+
+static void wait_copied(AsyncMemcpy &copier)
+{
+    Timer timer;
+    timer.start();
+    while (copier.busy() && timer.read_ms() < 1000) {
+    }
+    TEST_ASSERT_FALSE(copier.busy());
+}
+
+/**
+ * Test that small copies are done before copy() returns
+ */
+void test_small_copy()
+{
+    AsyncMemcpy copier;
+
+    fill();
+    TEST_ASSERT_EQUAL(0, copier.copy(dest_data, source_data, 100, copied));
+    TEST_ASSERT_EQUAL(1, copy_count);
+    TEST_ASSERT_EQUAL(0, copy_result);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(source_data, dest_data, 100);
+    TEST_ASSERT_EQUAL(0, dest_data[100]);
+}
+
+/**
+ * Test large copies at every alignment of source and destination
+ */
+void test_large_copy()
+{
+    AsyncMemcpy copier;
+
+    for (int src_offset = 0; src_offset < 4; src_offset++) {
+        for (int dst_offset = 0; dst_offset < 4; dst_offset++) {
+            size_t size = BUFFER_SIZE - 4 - dst_offset;
+            fill();
+            TEST_ASSERT_EQUAL(0, copier.copy(dest_data + dst_offset, source_data + src_offset, size, copied));
+            wait_copied(copier);
+            TEST_ASSERT_EQUAL(1, copy_count);
+            TEST_ASSERT_EQUAL(0, copy_result);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(source_data + src_offset, dest_data + dst_offset, size);
+            TEST_ASSERT_EQUAL(0, dest_data[dst_offset + size]);
+            if (dst_offset) {
+                TEST_ASSERT_EQUAL(0, dest_data[dst_offset - 1]);
+            }
+        }
+    }
+}
+
+/**
+ * Test that a second copy is refused while one is in progress
+ */
+void test_busy()
+{
+    AsyncMemcpy copier;
+
+    fill();
+    TEST_ASSERT_EQUAL(0, copier.copy(dest_data, source_data, BUFFER_SIZE, copied));
+    if (copier.busy()) {
+        TEST_ASSERT_EQUAL(DMA_ERROR_BUSY, copier.copy(dest_data, source_data, BUFFER_SIZE, copied));
+    }
+    wait_copied(copier);
+    TEST_ASSERT_EQUAL(1, copy_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(source_data, dest_data, BUFFER_SIZE);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return utest::v1::verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test small copies by the CPU", test_small_copy),
+    Case("Test large copies at all alignments", test_large_copy),
+    Case("Test copy while busy", test_busy)
+};
+
+utest::v1::Specification specification(test_setup, cases);
+
+int main()
+{
+    return !utest::v1::Harness::run(specification);
+}
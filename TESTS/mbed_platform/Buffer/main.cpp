@@ -0,0 +1,112 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+
+#include "platform/Buffer.h"
+
+using utest::v1::Case;
+
+#define BLOCK_SIZE  64
+#define BLOCK_COUNT 4
+
+/**
+ * Test that blocks are handed out until the pool is exhausted, and come back
+ * when the last Buffer referring to them goes away
+ */
+void test_alloc_free()
+{
+    StaticBufferPool<BLOCK_SIZE, BLOCK_COUNT> pool;
+    TEST_ASSERT_EQUAL(BLOCK_COUNT, pool.block_count());
+    TEST_ASSERT_EQUAL(BLOCK_COUNT, pool.free_count());
+
+    {
+        Buffer buffers[BLOCK_COUNT];
+        for (int i = 0; i < BLOCK_COUNT; i++) {
+            buffers[i] = pool.alloc(BLOCK_SIZE);
+            TEST_ASSERT_TRUE(buffers[i]);
+            TEST_ASSERT_EQUAL(BLOCK_SIZE, buffers[i].size());
+            memset(buffers[i].data(), i, BLOCK_SIZE);
+        }
+        TEST_ASSERT_EQUAL(0, pool.free_count());
+        TEST_ASSERT_FALSE(pool.alloc(1));
+
+        for (int i = 0; i < BLOCK_COUNT; i++) {
+            TEST_ASSERT_EACH_EQUAL_UINT8(i, buffers[i].data(), BLOCK_SIZE);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(BLOCK_COUNT, pool.free_count());
+    TEST_ASSERT_FALSE(pool.alloc(BLOCK_SIZE + 1));
+}
+
+/**
+ * Test that copies and slices share the block
+ */
+void test_slice_sharing()
+{
+    StaticBufferPool<BLOCK_SIZE, BLOCK_COUNT> pool;
+
+    Buffer slice;
+    {
+        Buffer buffer = pool.alloc(BLOCK_SIZE);
+        for (int i = 0; i < BLOCK_SIZE; i++) {
+            buffer.data()[i] = i;
+        }
+
+        slice = buffer.slice(16, 8);
+        TEST_ASSERT_TRUE(slice);
+        TEST_ASSERT_EQUAL(8, slice.size());
+        TEST_ASSERT_EQUAL_PTR(buffer.data() + 16, slice.data());
+        TEST_ASSERT_EQUAL(2, buffer.use_count());
+
+        // Out of range slices are empty
+        TEST_ASSERT_FALSE(buffer.slice(BLOCK_SIZE - 4, 8));
+    }
+
+    // The slice keeps the block alive
+    TEST_ASSERT_EQUAL(BLOCK_COUNT - 1, pool.free_count());
+    TEST_ASSERT_EQUAL(1, slice.use_count());
+    TEST_ASSERT_EQUAL(16, slice.span()[0]);
+
+    Buffer moved(std::move(slice));
+    TEST_ASSERT_FALSE(slice);
+    TEST_ASSERT_EQUAL(1, moved.use_count());
+
+    moved = Buffer();
+    TEST_ASSERT_EQUAL(BLOCK_COUNT, pool.free_count());
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return utest::v1::verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test buffer pool allocation", test_alloc_free),
+    Case("Test buffer slices", test_slice_sharing)
+};
+
+utest::v1::Specification specification(test_setup, cases);
+
+int main()
+{
+    return !utest::v1::Harness::run(specification);
+}
@@ -513,6 +513,142 @@ void test_ftruncate_fstat()
     close(fildes);
 }
 
+/** Test writev and readv
+ *
+ *  Given already opened file
+ *
+ *  When data is written from several buffers
+ *  Then underneath retargeting layer write function is called
+ *       and the buffers are written in order
+ *
+ *  When the file is read into several buffers
+ *  Then the buffers are filled in order up to the end of the file
+ *
+ *  When the file is full
+ *  Then writev returns what was written before it filled up
+ *
+ */
+void test_writev_readv()
+{
+    int fildes;
+    ssize_t ret;
+    const uint32_t FS = 10;
+    TestFile<FS> fh;
+    char head[] = "abc";
+    char body[] = "defgh";
+    char out1[2];
+    char out2[10];
+    struct iovec iov[2];
+
+    iov[0].iov_base = head;
+    iov[0].iov_len = 3;
+    iov[1].iov_base = body;
+    iov[1].iov_len = 5;
+
+    ret = writev(12345678, iov, 2);
+    TEST_ASSERT_EQUAL(-1, ret);
+    TEST_ASSERT_EQUAL(EBADF, errno);
+
+    fildes = bind_to_fd(&fh);
+    TEST_ASSERT_TRUE(fildes >= 0);
+
+    ret = writev(fildes, iov, -1);
+    TEST_ASSERT_EQUAL(-1, ret);
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+
+    TestFile<FS>::resetFunctionCallHistory();
+    ret = writev(fildes, iov, 2);
+    TEST_ASSERT_TRUE(TestFile<FS>::functionCalled(TestFile<FS>::fnWrite));
+    TEST_ASSERT_EQUAL(8, ret);
+
+    ret = lseek(fildes, 0, SEEK_SET);
+    TEST_ASSERT_EQUAL(0, ret);
+
+    iov[0].iov_base = out1;
+    iov[0].iov_len = sizeof(out1);
+    iov[1].iov_base = out2;
+    iov[1].iov_len = sizeof(out2);
+    TestFile<FS>::resetFunctionCallHistory();
+    ret = readv(fildes, iov, 2);
+    TEST_ASSERT_TRUE(TestFile<FS>::functionCalled(TestFile<FS>::fnRead));
+    TEST_ASSERT_EQUAL(8, ret);
+    TEST_ASSERT_EQUAL_MEMORY("ab", out1, 2);
+    TEST_ASSERT_EQUAL_MEMORY("cdefgh", out2, 6);
+
+    // at the end of the file
+    ret = readv(fildes, iov, 2);
+    TEST_ASSERT_EQUAL(0, ret);
+
+    // 2 bytes left in the file
+    iov[0].iov_base = head;
+    iov[0].iov_len = 3;
+    iov[1].iov_base = body;
+    iov[1].iov_len = 5;
+    ret = writev(fildes, iov, 2);
+    TEST_ASSERT_EQUAL(2, ret);
+
+    ret = writev(fildes, iov, 2);
+    TEST_ASSERT_EQUAL(-1, ret);
+    TEST_ASSERT_EQUAL(ENOSPC, errno);
+
+    close(fildes);
+}
+
+/** Test bind_to_fd and close
+ *
+ *  Given a file bound to a file descriptor
+ *
+ *  When the descriptor is closed
+ *  Then the file is closed and closing it again fails with EBADF
+ *
+ *  When another file is bound
+ *  Then the closed descriptor is reused
+ *
+ *  When two descriptors are closed, the lower one first
+ *  Then the next file bound gets the lowest free descriptor
+ *
+ */
+void test_bind_close()
+{
+    int fildes, ret;
+    const uint32_t FS = 10;
+    TestFile<FS> fh1, fh2;
+    TestFile<FS> fhs[4];
+    int fds[4];
+
+    fildes = bind_to_fd(&fh1);
+    TEST_ASSERT_TRUE(fildes >= 3);
+
+    TestFile<FS>::resetFunctionCallHistory();
+    ret = close(fildes);
+    TEST_ASSERT_TRUE(TestFile<FS>::functionCalled(TestFile<FS>::fnClose));
+    TEST_ASSERT_EQUAL(0, ret);
+
+    TestFile<FS>::resetFunctionCallHistory();
+    ret = close(fildes);
+    TEST_ASSERT_FALSE(TestFile<FS>::functionCalled(TestFile<FS>::fnClose));
+    TEST_ASSERT_EQUAL(-1, ret);
+    TEST_ASSERT_EQUAL(EBADF, errno);
+
+    TEST_ASSERT_EQUAL(fildes, bind_to_fd(&fh2));
+    close(fildes);
+
+    // descriptors are handed out lowest first, as in POSIX
+    for (int i = 0; i < 4; i++) {
+        fds[i] = bind_to_fd(&fhs[i]);
+        TEST_ASSERT_TRUE(fds[i] >= 3);
+        TEST_ASSERT_TRUE(i == 0 || fds[i] > fds[i - 1]);
+    }
+    TEST_ASSERT_EQUAL(0, close(fds[1]));
+    TEST_ASSERT_EQUAL(0, close(fds[3]));
+    TEST_ASSERT_EQUAL(fds[1], bind_to_fd(&fh1));
+    TEST_ASSERT_EQUAL(fds[3], bind_to_fd(&fh2));
+    close(fds[0]);
+    close(fds[1]);
+    close(fds[2]);
+    close(fds[3]);
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -526,7 +662,9 @@ Case cases[] = {
     Case("Test fputs/fgets", test_fputs_fgets),
     Case("Test fprintf/fscanf", test_fprintf_fscanf),
     Case("Test fseek/ftell", test_fseek_ftell),
-    Case("Test ftruncate/fstat", test_ftruncate_fstat)
+    Case("Test ftruncate/fstat", test_ftruncate_fstat),
+    Case("Test writev/readv", test_writev_readv),
+    Case("Test bind_to_fd/close", test_bind_close)
 };
 
 utest::v1::Specification specification(test_setup, cases);
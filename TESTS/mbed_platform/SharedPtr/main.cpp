@@ -19,6 +19,7 @@
 #include "unity/unity.h"
 
 #include "platform/SharedPtr.h"
+#include "platform/IntrusivePtr.h"
 
 using utest::v1::Case;
 
@@ -108,6 +109,94 @@ void test_equality_comparators()
     TEST_ASSERT_TRUE(s_ptr1_1 != s_ptr2); // Shared pointer / Shared pointer
 }
 
+/**
+ * Test that make_shared_ptr constructs the object and manages its lifetime
+ */
+void test_make_shared_ptr()
+{
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+
+    {
+        SharedPtr<TestStruct> s_ptr1 = make_shared_ptr<TestStruct>();
+        TEST_ASSERT_EQUAL(1, TestStruct::s_count);
+        TEST_ASSERT_EQUAL(42, s_ptr1->value);
+        TEST_ASSERT_EQUAL(1, s_ptr1.use_count());
+
+        SharedPtr<TestStruct> s_ptr2 = s_ptr1;
+        TEST_ASSERT_EQUAL(2, s_ptr1.use_count());
+        TEST_ASSERT_TRUE(s_ptr1 == s_ptr2);
+    }
+
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+}
+
+/**
+ * Test that a weak pointer doesn't keep the object alive, and only gives
+ * access to it while it exists
+ */
+void test_weak_ptr()
+{
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+
+    WeakPtr<TestStruct> w_ptr;
+    TEST_ASSERT_TRUE(w_ptr.expired());
+
+    {
+        SharedPtr<TestStruct> s_ptr = make_shared_ptr<TestStruct>();
+        w_ptr = WeakPtr<TestStruct>(s_ptr);
+        TEST_ASSERT_FALSE(w_ptr.expired());
+        TEST_ASSERT_EQUAL(1, w_ptr.use_count());
+
+        SharedPtr<TestStruct> locked = w_ptr.lock();
+        TEST_ASSERT_TRUE(locked == s_ptr);
+        TEST_ASSERT_EQUAL(2, s_ptr.use_count());
+    }
+
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+    TEST_ASSERT_TRUE(w_ptr.expired());
+    TEST_ASSERT_FALSE(w_ptr.lock());
+}
+
+struct RefCountedStruct : RefCounted<RefCountedStruct> {
+    RefCountedStruct()
+    {
+        s_count++;
+    }
+
+    ~RefCountedStruct()
+    {
+        s_count--;
+    }
+
+    static int s_count;
+};
+
+int RefCountedStruct::s_count = 0;
+
+/**
+ * Test that an intrusive pointer manages the lifetime of a reference counted object
+ */
+void test_intrusive_ptr()
+{
+    TEST_ASSERT_EQUAL(0, RefCountedStruct::s_count);
+
+    {
+        IntrusivePtr<RefCountedStruct> i_ptr1(new RefCountedStruct);
+        TEST_ASSERT_EQUAL(1, RefCountedStruct::s_count);
+        TEST_ASSERT_EQUAL(1, i_ptr1.use_count());
+
+        // The counter is in the object, so raw pointers can be shared again
+        IntrusivePtr<RefCountedStruct> i_ptr2(i_ptr1.get());
+        TEST_ASSERT_EQUAL(2, i_ptr1.use_count());
+
+        i_ptr1.reset();
+        TEST_ASSERT_EQUAL(1, RefCountedStruct::s_count);
+        TEST_ASSERT_EQUAL(1, i_ptr2.use_count());
+    }
+
+    TEST_ASSERT_EQUAL(0, RefCountedStruct::s_count);
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -117,7 +206,10 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 Case cases[] = {
     Case("Test single shared pointer instance", test_single_sharedptr_lifetime),
     Case("Test instance sharing across multiple shared pointers", test_instance_sharing),
-    Case("Test equality comparators", test_equality_comparators)
+    Case("Test equality comparators", test_equality_comparators),
+    Case("Test make_shared_ptr", test_make_shared_ptr),
+    Case("Test weak pointer", test_weak_ptr),
+    Case("Test intrusive pointer", test_intrusive_ptr)
 };
 
 utest::v1::Specification specification(test_setup, cases);
@@ -231,6 +231,54 @@ void test_atomic_struct()
     TEST_ASSERT_EQUAL(uint8_t(add_iterations(data)), final_val.c);
 }
 
+static volatile uint32_t wait_value;
+static volatile uint32_t woken;
+
+void waiter()
+{
+    uint32_t value = core_util_atomic_load_u32(&wait_value);
+    while (value == 0) {
+        core_util_atomic_wait_u32(&wait_value, value, osWaitForever);
+        value = core_util_atomic_load_u32(&wait_value);
+    }
+    core_util_atomic_incr_u32(&woken, 1);
+}
+
+void test_atomic_wait_notify()
+{
+    wait_value = 0;
+    woken = 0;
+
+    Thread t1(osPriorityNormal, THREAD_STACK);
+    Thread t2(osPriorityNormal, THREAD_STACK);
+
+    TEST_ASSERT_EQUAL(osOK, t1.start(waiter));
+    TEST_ASSERT_EQUAL(osOK, t2.start(waiter));
+    ThisThread::sleep_for(10);
+    TEST_ASSERT_EQUAL(0, woken);
+
+    core_util_atomic_store_u32(&wait_value, 1);
+    core_util_atomic_notify_all(&wait_value);
+
+    t1.join();
+    t2.join();
+    TEST_ASSERT_EQUAL(2, woken);
+}
+
+void test_atomic_wait_timeout()
+{
+    volatile uint32_t value32 = 5;
+    volatile uint64_t value64 = 0x100000000ULL;
+
+    // A changed value returns straight away
+    TEST_ASSERT_TRUE(core_util_atomic_wait_u32(&value32, 4, osWaitForever));
+    TEST_ASSERT_TRUE(core_util_atomic_wait_u64(&value64, 0, osWaitForever));
+
+    TEST_ASSERT_FALSE(core_util_atomic_wait_u32(&value32, 5, 0));
+    TEST_ASSERT_FALSE(core_util_atomic_wait_u32(&value32, 5, 10));
+    TEST_ASSERT_FALSE(core_util_atomic_wait_u64(&value64, 0x100000000ULL, 10));
+}
+
 } // namespace
 
 utest::v1::status_t test_setup(const size_t number_of_cases)
@@ -266,7 +314,9 @@ Case cases[] = {
     Case("Test atomic compare exchange strong 32-bit", test_atomic_add<uint32_t, strong_incrementer>),
     Case("Test atomic compare exchange strong 64-bit", test_atomic_add<uint64_t, strong_incrementer>),
     Case("Test small atomic custom structure", test_atomic_struct<small, 4>),
-    Case("Test large atomic custom structure", test_atomic_struct<large, 11>)
+    Case("Test large atomic custom structure", test_atomic_struct<large, 11>),
+    Case("Test atomic wait and notify", test_atomic_wait_notify),
+    Case("Test atomic wait timeout", test_atomic_wait_timeout)
 };
 
 utest::v1::Specification specification(test_setup, cases);
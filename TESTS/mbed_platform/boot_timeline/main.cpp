@@ -0,0 +1,83 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(MBED_BOOT_TIMELINE_ENABLED) || !DEVICE_USTICKER || !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+void test_boot_stages()
+{
+    const mbed_boot_stage_t stages[] = {
+        MBED_BOOT_STAGE_SDK_INIT,
+        MBED_BOOT_STAGE_RTOS_INIT,
+        MBED_BOOT_STAGE_RTOS_START,
+        MBED_BOOT_STAGE_CXX_INIT,
+        MBED_BOOT_STAGE_MAIN
+    };
+    uint64_t prev = 0;
+
+    for (size_t i = 0; i < sizeof(stages) / sizeof(stages[0]); i++) {
+        uint64_t timestamp;
+        TEST_ASSERT_TRUE(mbed_boot_timeline_get(stages[i], &timestamp));
+        TEST_ASSERT_TRUE(timestamp >= prev);
+        prev = timestamp;
+    }
+}
+
+void test_app_ready()
+{
+    uint64_t main_time, ready_time, again_time;
+
+    TEST_ASSERT_FALSE(mbed_boot_timeline_get(MBED_BOOT_STAGE_APP_READY, &ready_time));
+
+    mbed_boot_timeline_record(MBED_BOOT_STAGE_APP_READY);
+    TEST_ASSERT_TRUE(mbed_boot_timeline_get(MBED_BOOT_STAGE_MAIN, &main_time));
+    TEST_ASSERT_TRUE(mbed_boot_timeline_get(MBED_BOOT_STAGE_APP_READY, &ready_time));
+    TEST_ASSERT_TRUE(ready_time >= main_time);
+
+    // Only the first time a stage is reached is kept
+    wait_us(1000);
+    mbed_boot_timeline_record(MBED_BOOT_STAGE_APP_READY);
+    TEST_ASSERT_TRUE(mbed_boot_timeline_get(MBED_BOOT_STAGE_APP_READY, &again_time));
+    TEST_ASSERT_EQUAL_UINT64(ready_time, again_time);
+}
+
+Case cases[] = {
+    Case("Boot stages recorded in order", test_boot_stages),
+    Case("Application stage", test_app_ready),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
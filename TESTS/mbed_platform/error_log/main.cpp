@@ -0,0 +1,107 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !MBED_CONF_PLATFORM_ERROR_LOG_ENABLED || !DEVICE_FLASH
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define EVENT_CODE      0x1234
+
+void test_reset()
+{
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_error_log_reset());
+    TEST_ASSERT_EQUAL(0, mbed_error_log_get_count());
+
+    mbed_error_log_entry_t entry;
+    TEST_ASSERT_EQUAL(MBED_ERROR_ITEM_NOT_FOUND, mbed_error_log_get(0, &entry));
+}
+
+void test_event()
+{
+    mbed_error_log_entry_t entry;
+
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_error_log_event(EVENT_CODE, 42));
+    int count = mbed_error_log_get_count();
+    TEST_ASSERT(count >= 1);
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_error_log_get(count - 1, &entry));
+    TEST_ASSERT_EQUAL(MBED_ERROR_LOG_EVENT, entry.type);
+    TEST_ASSERT_EQUAL(EVENT_CODE, entry.status);
+    TEST_ASSERT_EQUAL(42, entry.value);
+}
+
+void test_warning()
+{
+    mbed_error_log_entry_t entry;
+
+    mbed_warning(MBED_ERROR_INVALID_ARGUMENT, "error log test", 0xAA, MBED_FILENAME, __LINE__);
+    int count = mbed_error_log_get_count();
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_error_log_get(count - 1, &entry));
+    TEST_ASSERT_EQUAL(MBED_ERROR_LOG_WARNING, entry.type);
+    TEST_ASSERT_EQUAL(MBED_ERROR_INVALID_ARGUMENT, entry.status);
+    TEST_ASSERT_EQUAL(0xAA, entry.value);
+}
+
+void test_wrap()
+{
+    mbed_error_log_entry_t entry, previous;
+    int i;
+
+    // Enough appends to go round the region several times, maintaining on the way
+    for (i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_error_log_event(EVENT_CODE, i));
+        if (i % 8 == 0) {
+            TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_error_log_maintain());
+        }
+    }
+
+    int count = mbed_error_log_get_count();
+    TEST_ASSERT(count > 1);
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_error_log_get(0, &previous));
+    for (i = 1; i < count; i++) {
+        TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_error_log_get(i, &entry));
+        TEST_ASSERT_EQUAL(previous.sequence + 1, entry.sequence);
+        previous = entry;
+    }
+    TEST_ASSERT_EQUAL(999, entry.value);
+}
+
+Case cases[] = {
+    Case("Test reset", test_reset),
+    Case("Test event", test_event),
+    Case("Test warning", test_warning),
+    Case("Test wrap", test_wrap)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
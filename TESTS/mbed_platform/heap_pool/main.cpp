@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if !MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define BLOCK_COUNT     MBED_CONF_PLATFORM_HEAP_POOL_BLOCK_COUNT
+#define THREAD_COUNT    3
+#define ITERATIONS      1000
+
+static const size_t class_sizes[] = {32, 64, 128, 256};
+
+void test_case_exhaust_pool()
+{
+    for (uint32_t c = 0; c < sizeof(class_sizes) / sizeof(class_sizes[0]); c++) {
+        // Take more blocks than the pool holds, the rest must come from the heap
+        uint8_t *blocks[BLOCK_COUNT + 2];
+        for (uint32_t i = 0; i < BLOCK_COUNT + 2; i++) {
+            blocks[i] = (uint8_t *)malloc(class_sizes[c]);
+            TEST_ASSERT_NOT_NULL(blocks[i]);
+            TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)blocks[i] % 8);
+            memset(blocks[i], i, class_sizes[c]);
+        }
+
+        for (uint32_t i = 0; i < BLOCK_COUNT + 2; i++) {
+            for (uint32_t j = 0; j < class_sizes[c]; j++) {
+                TEST_ASSERT_EQUAL_UINT8(i, blocks[i][j]);
+            }
+            free(blocks[i]);
+        }
+    }
+}
+
+void test_case_calloc_realloc()
+{
+    uint8_t *data = (uint8_t *)calloc(4, 16);
+    TEST_ASSERT_NOT_NULL(data);
+    for (uint32_t i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, data[i]);
+        data[i] = i;
+    }
+
+    // Shrinking keeps the block, growing past the largest class moves to the heap
+    TEST_ASSERT_EQUAL_PTR(data, realloc(data, 40));
+    data = (uint8_t *)realloc(data, 1024);
+    TEST_ASSERT_NOT_NULL(data);
+    for (uint32_t i = 0; i < 40; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i, data[i]);
+    }
+    free(data);
+}
+
+static void churn()
+{
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        size_t size = class_sizes[i % 4] - 4;
+        uint8_t *data = (uint8_t *)malloc(size);
+        TEST_ASSERT_NOT_NULL(data);
+        memset(data, i, size);
+        ThisThread::yield();
+        for (uint32_t j = 0; j < size; j++) {
+            TEST_ASSERT_EQUAL_UINT8((uint8_t)i, data[j]);
+        }
+        free(data);
+    }
+}
+
+void test_case_multithread()
+{
+    Thread *threads[THREAD_COUNT];
+    for (uint32_t i = 0; i < THREAD_COUNT; i++) {
+        threads[i] = new Thread(osPriorityNormal, 1024);
+        TEST_ASSERT_EQUAL(osOK, threads[i]->start(churn));
+    }
+    for (uint32_t i = 0; i < THREAD_COUNT; i++) {
+        threads[i]->join();
+        delete threads[i];
+    }
+}
+
+Case cases[] = {
+    Case("exhaust pools", test_case_exhaust_pool),
+    Case("calloc and realloc", test_case_calloc_realloc),
+    Case("multithreaded alloc and free", test_case_multithread),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
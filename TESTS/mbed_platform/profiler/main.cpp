@@ -0,0 +1,107 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(MBED_PROFILER_ENABLED) || !DEVICE_USTICKER || !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define RATE_HZ     1000
+#define BUSY_MS     200
+
+static mbed_profiler_sample_t samples[MBED_CONF_PLATFORM_PROFILER_BUCKETS];
+
+void test_samples()
+{
+    mbed_profiler_stats_t stats;
+
+    mbed_profiler_reset();
+    TEST_ASSERT_TRUE(mbed_profiler_start(RATE_HZ));
+    wait_us(BUSY_MS * 1000);
+    mbed_profiler_stop();
+
+    mbed_profiler_get_stats(&stats);
+    TEST_ASSERT_UINT32_WITHIN(BUSY_MS / 4, BUSY_MS * RATE_HZ / 1000, stats.samples);
+
+    size_t count = mbed_profiler_get_samples(samples, MBED_CONF_PLATFORM_PROFILER_BUCKETS);
+    TEST_ASSERT_EQUAL(stats.buckets, count);
+
+    // Every sample is in the histogram or counted apart, busy waiting keeps the main thread running
+    uint32_t total = 0;
+    uint32_t in_main = 0;
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_NOT_EQUAL(0, samples[i].pc);
+        total += samples[i].count;
+        if (samples[i].thread_id == (uint32_t)ThisThread::get_id()) {
+            in_main += samples[i].count;
+        }
+    }
+    TEST_ASSERT_EQUAL(stats.samples, total + stats.other + stats.dropped);
+    TEST_ASSERT_TRUE(in_main > stats.samples / 2);
+}
+
+void test_stop()
+{
+    mbed_profiler_stats_t before, after;
+
+    mbed_profiler_get_stats(&before);
+    wait_us(20000);
+    mbed_profiler_get_stats(&after);
+    TEST_ASSERT_EQUAL(before.samples, after.samples);
+
+    mbed_profiler_reset();
+    mbed_profiler_get_stats(&after);
+    TEST_ASSERT_EQUAL(0, after.samples);
+    TEST_ASSERT_EQUAL(0, mbed_profiler_get_samples(samples, MBED_CONF_PLATFORM_PROFILER_BUCKETS));
+}
+
+void test_rate()
+{
+    TEST_ASSERT_FALSE(mbed_profiler_start(2000000));
+
+    // Default rate
+    TEST_ASSERT_TRUE(mbed_profiler_start(0));
+    wait_us(20000);
+    mbed_profiler_stop();
+    mbed_profiler_dump();
+}
+
+Case cases[] = {
+    Case("Samples taken at the sampling rate", test_samples),
+    Case("No samples once stopped", test_stop),
+    Case("Sampling rate", test_rate),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -0,0 +1,107 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+
+using utest::v1::Case;
+
+static volatile uint32_t calls;
+
+MBED_RAMFUNC static uint32_t ram_sum(const uint32_t *data, int count)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += data[i];
+    }
+    calls++;
+    return sum;
+}
+
+MBED_ITCM static uint32_t itcm_sum(const uint32_t *data, int count)
+{
+    // Calls back into a function in RAM or flash
+    return ram_sum(data, count) + 1;
+}
+
+static bool in_flash(void (*function)())
+{
+#if defined(MBED_ROM_START) && defined(MBED_ROM_SIZE)
+    uint32_t addr = (uint32_t)function & ~1;
+    return addr >= MBED_ROM_START && addr < MBED_ROM_START + MBED_ROM_SIZE;
+#else
+    return true;
+#endif
+}
+
+/**
+ * Test that functions placed in RAM and ITCM run and call each other
+ */
+void test_ramfunc_call()
+{
+    uint32_t data[16];
+    for (int i = 0; i < 16; i++) {
+        data[i] = i;
+    }
+
+    calls = 0;
+    TEST_ASSERT_EQUAL(120, ram_sum(data, 16));
+    TEST_ASSERT_EQUAL(121, itcm_sum(data, 16));
+    TEST_ASSERT_EQUAL(2, calls);
+
+    // Placement depends on the linker script of the target
+    printf("MBED_RAMFUNC in %s, MBED_ITCM in %s\r\n",
+           in_flash((void (*)())ram_sum) ? "flash" : "RAM",
+           in_flash((void (*)())itcm_sum) ? "flash" : "ITCM");
+}
+
+static void ram_sum_irq()
+{
+    uint32_t one = 1;
+    ram_sum(&one, 1);
+}
+
+/**
+ * Test that a function in RAM can be called from interrupt context
+ */
+void test_ramfunc_interrupt()
+{
+    Timeout timeout;
+    calls = 0;
+    timeout.attach_us(ram_sum_irq, 1000);
+    wait_us(10000);
+    TEST_ASSERT_EQUAL(1, calls);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return utest::v1::verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test calling MBED_RAMFUNC and MBED_ITCM functions", test_ramfunc_call),
+    Case("Test calling MBED_RAMFUNC from an interrupt", test_ramfunc_interrupt)
+};
+
+utest::v1::Specification specification(test_setup, cases);
+
+int main()
+{
+    return !utest::v1::Harness::run(specification);
+}
@@ -0,0 +1,120 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(MBED_SCHED_TRACE_ENABLED) || !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+// The idle thread would drain the ring before the test can read it
+#if DEVICE_ITM && MBED_CONF_PLATFORM_SCHED_TRACE_SWO_IDLE_FLUSH
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define TEST_STACK_SIZE     512
+#define MAX_EVENTS          MBED_CONF_PLATFORM_SCHED_TRACE_BUFFER_SIZE
+
+static mbed_sched_trace_event_t events[MAX_EVENTS];
+static Semaphore sem(0, 1);
+
+static void wait_on_semaphore()
+{
+    sem.acquire();
+}
+
+static size_t count_events(size_t count, uint16_t type)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (events[i].type == type) {
+            n++;
+        }
+    }
+    return n;
+}
+
+void test_thread_switch_and_wait()
+{
+    Thread t(osPriorityAboveNormal, TEST_STACK_SIZE);
+
+    mbed_sched_trace_start();
+    t.start(wait_on_semaphore);
+    sem.release();
+    t.join();
+    mbed_sched_trace_stop();
+
+    size_t count = mbed_sched_trace_read(events, MAX_EVENTS);
+    TEST_ASSERT_TRUE(count > 0);
+    TEST_ASSERT_EQUAL(MBED_SCHED_TRACE_START, events[0].type);
+    TEST_ASSERT_EQUAL(us_ticker_get_info()->frequency, events[0].arg);
+
+    TEST_ASSERT_TRUE(count_events(count, MBED_SCHED_TRACE_SEMAPHORE_WAIT) >= 1);
+    TEST_ASSERT_TRUE(count_events(count, MBED_SCHED_TRACE_THREAD_SWITCH) >= 2);
+
+    bool switched_to_thread = false;
+    for (size_t i = 0; i < count; i++) {
+        if (events[i].type == MBED_SCHED_TRACE_THREAD_SWITCH && events[i].arg == (uint32_t)t.get_id()) {
+            switched_to_thread = true;
+        }
+    }
+    TEST_ASSERT_TRUE(switched_to_thread);
+}
+
+void test_overflow()
+{
+    mbed_sched_trace_start();
+    // Fill the ring and drop a few events on top
+    for (int i = 0; i < MAX_EVENTS + 4; i++) {
+        mbed_sched_trace_record(MBED_SCHED_TRACE_ISR_ENTER, i);
+    }
+    TEST_ASSERT_EQUAL(MAX_EVENTS, mbed_sched_trace_read(events, MAX_EVENTS));
+
+    // The next event is preceded by a marker counting the dropped events
+    mbed_sched_trace_record(MBED_SCHED_TRACE_ISR_EXIT, 0);
+    mbed_sched_trace_stop();
+
+    size_t count = mbed_sched_trace_read(events, MAX_EVENTS);
+    TEST_ASSERT_TRUE(count >= 2);
+    TEST_ASSERT_EQUAL(MBED_SCHED_TRACE_OVERFLOW, events[0].type);
+    TEST_ASSERT_TRUE(events[0].arg >= 5);
+    TEST_ASSERT_EQUAL(1, count_events(count, MBED_SCHED_TRACE_ISR_EXIT));
+}
+
+Case cases[] = {
+    Case("Thread switch and wait events", test_thread_switch_and_wait),
+    Case("Overflow marker", test_overflow),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
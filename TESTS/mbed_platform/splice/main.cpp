@@ -0,0 +1,204 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+
+#include "platform/mbed_splice.h"
+
+using utest::v1::Case;
+
+#define FILE_SIZE 2000
+
+// File in RAM, optionally read in place and accepting a limited number of bytes
+class MemFile : public FileHandle {
+public:
+    MemFile(uint8_t *data, size_t size, bool in_place = false)
+        : _data(data), _size(size), _pos(0), _in_place(in_place), _limit(size)
+    {
+    }
+
+    virtual ssize_t read(void *buffer, size_t size)
+    {
+        size = std::min(size, _size - _pos);
+        memcpy(buffer, _data + _pos, size);
+        _pos += size;
+        return size;
+    }
+
+    virtual ssize_t read_in_place(const void **data, size_t size)
+    {
+        if (!_in_place) {
+            return -ENOSYS;
+        }
+        // Contiguous in pieces of 100 bytes, like blocks of a file system
+        size = std::min(size, std::min(_size - _pos, 100 - _pos % 100));
+        *data = _data + _pos;
+        _pos += size;
+        return size;
+    }
+
+    virtual ssize_t write(const void *buffer, size_t size)
+    {
+        size = std::min(size, _limit - _pos);
+        if (!size) {
+            return -EAGAIN;
+        }
+        memcpy(_data + _pos, buffer, size);
+        _pos += size;
+        return size;
+    }
+
+    virtual off_t seek(off_t offset, int whence = SEEK_SET)
+    {
+        if (whence == SEEK_CUR) {
+            offset += _pos;
+        } else if (whence == SEEK_END) {
+            offset += _size;
+        }
+        if (offset < 0 || (size_t)offset > _size) {
+            return -EINVAL;
+        }
+        _pos = offset;
+        return _pos;
+    }
+
+    virtual int close()
+    {
+        return 0;
+    }
+
+    uint8_t *_data;
+    size_t _size;
+    size_t _pos;
+    bool _in_place;
+    size_t _limit;
+};
+
+static uint8_t source_data[FILE_SIZE];
+static uint8_t dest_data[FILE_SIZE];
+
+static void fill()
+{
+    for (int i = 0; i < FILE_SIZE; i++) {
+        source_data[i] = i * 7;
+    }
+    memset(dest_data, 0, sizeof(dest_data));
+}
+
+/**
+ * Test copying through the shared buffers from the file position
+ */
+void test_splice_copy()
+{
+    fill();
+    MemFile in(source_data, FILE_SIZE);
+    MemFile out(dest_data, FILE_SIZE);
+
+    in.seek(10);
+    TEST_ASSERT_EQUAL(1500, splice(&out, &in, NULL, 1500));
+    TEST_ASSERT_EQUAL(1510, in.tell());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(source_data + 10, dest_data, 1500);
+
+    // Stops at end of file
+    TEST_ASSERT_EQUAL(FILE_SIZE - 1510, splice(&out, &in, NULL, 1000));
+    TEST_ASSERT_EQUAL(0, splice(&out, &in, NULL, 1000));
+}
+
+/**
+ * Test copying from an offset, leaving the file position alone
+ */
+void test_splice_offset()
+{
+    fill();
+    MemFile in(source_data, FILE_SIZE);
+    MemFile out(dest_data, FILE_SIZE);
+
+    off_t offset = 300;
+    in.seek(5);
+    TEST_ASSERT_EQUAL(700, splice(&out, &in, &offset, 700));
+    TEST_ASSERT_EQUAL(1000, offset);
+    TEST_ASSERT_EQUAL(5, in.tell());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(source_data + 300, dest_data, 700);
+}
+
+static const uint8_t *last_write;
+
+static ssize_t record_write(MemFile *out, const void *data, size_t size)
+{
+    last_write = static_cast<const uint8_t *>(data);
+    return out->write(data, size);
+}
+
+/**
+ * Test that data read in place is written straight from the source
+ */
+void test_splice_in_place()
+{
+    fill();
+    MemFile in(source_data, FILE_SIZE, true);
+    MemFile out(dest_data, FILE_SIZE);
+
+    in.seek(150);
+    TEST_ASSERT_EQUAL(1000, splice(callback(record_write, &out), &in, NULL, 1000));
+    TEST_ASSERT_EQUAL(1150, in.tell());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(source_data + 150, dest_data, 1000);
+    TEST_ASSERT_EQUAL_PTR(source_data + 1100, last_write);
+}
+
+/**
+ * Test that data the destination doesn't take is given back to the source
+ */
+void test_splice_partial()
+{
+    fill();
+    MemFile in(source_data, FILE_SIZE);
+    MemFile out(dest_data, FILE_SIZE);
+
+    out._limit = 700;
+    TEST_ASSERT_EQUAL(700, splice(&out, &in, NULL, 1000));
+    TEST_ASSERT_EQUAL(700, in.tell());
+
+    // Nothing taken gives the destination's error
+    TEST_ASSERT_EQUAL(-EAGAIN, splice(&out, &in, NULL, 1000));
+    TEST_ASSERT_EQUAL(700, in.tell());
+
+    out._limit = FILE_SIZE;
+    TEST_ASSERT_EQUAL(FILE_SIZE - 700, splice(&out, &in, NULL, FILE_SIZE));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(source_data, dest_data, FILE_SIZE);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return utest::v1::verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test splice copying through shared buffers", test_splice_copy),
+    Case("Test splice from an offset", test_splice_offset),
+    Case("Test splice reading in place", test_splice_in_place),
+    Case("Test splice with a partial write", test_splice_partial)
+};
+
+utest::v1::Specification specification(test_setup, cases);
+
+int main()
+{
+    return !utest::v1::Harness::run(specification);
+}
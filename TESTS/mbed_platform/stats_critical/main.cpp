@@ -0,0 +1,115 @@
+
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(MBED_CRITICAL_STATS_ENABLED) || !defined(DWT_CTRL_CYCCNTENA_Msk)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define LONG_SECTION_US     200
+#define SITES               4
+
+static MBED_NOINLINE void long_section()
+{
+    core_util_critical_section_enter();
+    wait_us(LONG_SECTION_US);
+    core_util_critical_section_exit();
+}
+
+void test_reset()
+{
+    mbed_stats_critical_t stats;
+    mbed_stats_critical_site_t sites[SITES];
+
+    long_section();
+    mbed_stats_critical_reset();
+    mbed_stats_critical_get(&stats, sites, SITES);
+
+    // Only interrupts can have entered short sections since the reset
+    TEST_ASSERT(stats.max_cycles < (SystemCoreClock / 1000000) * LONG_SECTION_US);
+}
+
+void test_longest_section()
+{
+    mbed_stats_critical_t stats;
+    mbed_stats_critical_site_t sites[SITES];
+
+    mbed_stats_critical_reset();
+    long_section();
+    size_t count = mbed_stats_critical_get(&stats, sites, SITES);
+
+    uint32_t expected = (SystemCoreClock / 1000000) * LONG_SECTION_US;
+    TEST_ASSERT(stats.count >= 1);
+    TEST_ASSERT(stats.max_cycles >= expected);
+    TEST_ASSERT_NOT_NULL(stats.max_caller);
+
+    TEST_ASSERT(count >= 1);
+    TEST_ASSERT_EQUAL_PTR(stats.max_caller, sites[0].caller);
+    TEST_ASSERT_EQUAL(stats.max_cycles, sites[0].max_cycles);
+    for (size_t i = 1; i < count; i++) {
+        TEST_ASSERT(sites[i].max_cycles <= sites[i - 1].max_cycles);
+    }
+}
+
+void test_histogram()
+{
+    mbed_stats_critical_t stats;
+
+    mbed_stats_critical_reset();
+    for (int i = 0; i < 100; i++) {
+        core_util_critical_section_enter();
+        core_util_critical_section_enter();
+        core_util_critical_section_exit();
+        core_util_critical_section_exit();
+    }
+    mbed_stats_critical_get(&stats, NULL, 0);
+
+    // Nested sections count once, and interrupts may add their own
+    uint32_t total = 0;
+    for (int i = 0; i < MBED_STATS_CRITICAL_BUCKETS; i++) {
+        total += stats.histogram[i];
+    }
+    TEST_ASSERT_EQUAL(stats.count, total);
+    TEST_ASSERT(stats.count >= 100);
+    TEST_ASSERT(stats.count < 200);
+}
+
+Case cases[] = {
+    Case("Test reset", test_reset),
+    Case("Test longest section", test_longest_section),
+    Case("Test histogram", test_histogram)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
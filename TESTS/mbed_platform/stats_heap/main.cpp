@@ -188,11 +188,52 @@ void test_case_realloc_size()
     TEST_ASSERT_EQUAL_UINT32(stats_start.current_size, stats_current.current_size);
 }
 
+#ifdef MBED_HEAP_PROFILE_ENABLED
+MBED_NOINLINE static void *profile_site(uint32_t size)
+{
+    return malloc(size);
+}
+
+void test_case_heap_profile()
+{
+    mbed_stats_heap_profile_t profile;
+    mbed_stats_heap_site_t sites[MBED_CONF_PLATFORM_HEAP_PROFILE_SITES];
+    void *data[3];
+
+    for (uint32_t i = 0; i < 3; i++) {
+        data[i] = profile_site(ALLOCATION_SIZE_SMALL);
+        TEST_ASSERT(data[i] != NULL);
+    }
+
+    size_t count = mbed_stats_heap_profile_get(&profile, sites, MBED_CONF_PLATFORM_HEAP_PROFILE_SITES);
+    TEST_ASSERT_EQUAL_UINT32(profile.site_cnt, count);
+    TEST_ASSERT(profile.largest_free_size > 0);
+    TEST_ASSERT(profile.largest_free_size <= profile.free_size);
+    TEST_ASSERT(profile.fragmentation <= 100);
+
+    // Exactly one site made our allocations, all of the same size
+    uint32_t matches = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (sites[i].alloc_cnt >= 3 && sites[i].alloc_size == sites[i].alloc_cnt * ALLOCATION_SIZE_SMALL) {
+            matches++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, matches);
+
+    for (uint32_t i = 0; i < 3; i++) {
+        free(data[i]);
+    }
+}
+#endif
+
 Case cases[] = {
     Case("malloc and free size", test_case_malloc_free_size),
     Case("allocate size zero", test_case_allocate_zero),
     Case("allocation failure", test_case_allocate_fail),
     Case("realloc size", test_case_realloc_size),
+#ifdef MBED_HEAP_PROFILE_ENABLED
+    Case("heap profile", test_case_heap_profile),
+#endif
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
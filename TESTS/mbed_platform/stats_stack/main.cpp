@@ -0,0 +1,135 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(MBED_STACK_STATS_ENABLED)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define TEST_STACK_SIZE     1024
+#define MAX_THREAD_STATS    0x8
+#define MAX_IDLE_CYCLES     1000
+
+static Semaphore go(0);
+static Semaphore done(0);
+static volatile uint32_t frames;
+
+MBED_NOINLINE static uint32_t use_stack(uint32_t n)
+{
+    volatile uint8_t buf[64];
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = n;
+    }
+    return n ? buf[0] + use_stack(n - 1) : buf[0];
+}
+
+static void worker()
+{
+    while (true) {
+        go.acquire();
+        use_stack(frames);
+        done.release();
+    }
+}
+
+static uint32_t max_size(size_t (*get_each)(mbed_stats_stack_t *, size_t), osThreadId_t id)
+{
+    mbed_stats_stack_t stats[MAX_THREAD_STATS];
+    size_t count = get_each(stats, MAX_THREAD_STATS);
+    for (size_t i = 0; i < count; i++) {
+        if (stats[i].thread_id == (uint32_t)id) {
+            return stats[i].max_size;
+        }
+    }
+    TEST_FAIL_MESSAGE("thread not found");
+    return 0;
+}
+
+void test_case_cached_not_above_exact()
+{
+    mbed_stats_stack_t *cached = new mbed_stats_stack_t[MAX_THREAD_STATS];
+    mbed_stats_stack_t *exact = new mbed_stats_stack_t[MAX_THREAD_STATS];
+
+    size_t cached_count = mbed_stats_stack_get_each_cached(cached, MAX_THREAD_STATS);
+    size_t exact_count = mbed_stats_stack_get_each(exact, MAX_THREAD_STATS);
+    TEST_ASSERT_EQUAL(exact_count, cached_count);
+
+    for (size_t i = 0; i < cached_count; i++) {
+        size_t j = 0;
+        while (j < exact_count && exact[j].thread_id != cached[i].thread_id) {
+            j++;
+        }
+        TEST_ASSERT_TRUE(j < exact_count);
+        TEST_ASSERT_EQUAL(exact[j].reserved_size, cached[i].reserved_size);
+        TEST_ASSERT_EQUAL(1, cached[i].stack_cnt);
+        TEST_ASSERT_TRUE(cached[i].max_size <= exact[j].max_size);
+    }
+
+    delete[] cached;
+    delete[] exact;
+}
+
+void test_case_cached_catches_up()
+{
+    Thread t(osPriorityNormal, TEST_STACK_SIZE);
+    t.start(worker);
+
+    frames = 1;
+    go.release();
+    done.acquire();
+    uint32_t before = max_size(mbed_stats_stack_get_each_cached, t.get_id());
+
+    frames = 8;
+    go.release();
+    done.acquire();
+    uint32_t exact = max_size(mbed_stats_stack_get_each, t.get_id());
+    TEST_ASSERT_TRUE(exact > before);
+
+    // The idle thread updates the cache a little on every idle cycle
+    uint32_t cached = 0;
+    for (int i = 0; i < MAX_IDLE_CYCLES && cached != exact; i++) {
+        ThisThread::sleep_for(1);
+        cached = max_size(mbed_stats_stack_get_each_cached, t.get_id());
+    }
+    TEST_ASSERT_EQUAL(exact, cached);
+
+    t.terminate();
+}
+
+Case cases[] = {
+    Case("Cached watermark not above exact", test_case_cached_not_above_exact),
+    Case("Cached watermark catches up", test_case_cached_catches_up),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -155,11 +155,53 @@ void test_case_multi_threads_terminate()
     delete[] stats;
 }
 
+void busy_loop()
+{
+    while (1) {
+    }
+}
+
+void test_case_cpu_time()
+{
+#if DEVICE_USTICKER
+    mbed_stats_thread_t *stats = new mbed_stats_thread_t[MAX_THREAD_STATS];
+    uint64_t busy_time = 0;
+    uint64_t sleep_time = 0;
+
+    // Th1 runs whenever the main thread sleeps, Th2 wakes up only briefly
+    Thread t1(osPriorityBelowNormal, TEST_STACK_SIZE, NULL, "Th1");
+    Thread t2(osPriorityNormal1, TEST_STACK_SIZE, NULL, "Th2");
+    t1.start(busy_loop);
+    t2.start(increment_with_delay);
+
+    ThisThread::sleep_for(200);
+
+    int count = mbed_stats_thread_get_each(stats, MAX_THREAD_STATS);
+    for (int i = 0; i < count; i++) {
+        if (0 == strcmp(stats[i].name, "Th1")) {
+            busy_time = stats[i].cpu_time;
+        } else if (0 == strcmp(stats[i].name, "Th2")) {
+            sleep_time = stats[i].cpu_time;
+        }
+    }
+
+    TEST_ASSERT_TRUE(busy_time >= 150000);
+    TEST_ASSERT_TRUE(busy_time > sleep_time);
+
+    t1.terminate();
+    t2.terminate();
+    delete[] stats;
+#else
+    TEST_IGNORE_MESSAGE("CPU time accounting needs a us ticker");
+#endif
+}
+
 Case cases[] = {
     Case("Single Thread Stats", test_case_single_thread_stats),
     Case("Less count value", test_case_less_count),
     Case("Multiple Threads blocked", test_case_multi_threads_blocked),
     Case("Multiple Threads terminate", test_case_multi_threads_terminate),
+    Case("Thread CPU time", test_case_cpu_time),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
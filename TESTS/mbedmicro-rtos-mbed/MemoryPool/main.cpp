@@ -527,6 +527,61 @@ void test_mem_pool_waitforever()
     t.join();
 }
 
+namespace {
+struct counted_item {
+    static int live;
+    int a;
+    char b;
+
+    counted_item(int a, char b) : a(a), b(b)
+    {
+        live++;
+    }
+
+    ~counted_item()
+    {
+        live--;
+    }
+};
+int counted_item::live = 0;
+}
+
+/** Test construct and destroy
+ *
+ * Given a pool with two slots for a type with a non-trivial constructor
+ * When objects are constructed in the pool until it is exhausted
+ * Then the constructor runs with the given arguments for each block
+ *     and construction fails once no block is left
+ * When the objects are destroyed
+ * Then the destructor runs and the blocks can be reused
+ */
+void test_mem_pool_construct_destroy()
+{
+    MemoryPool<counted_item, 2> pool;
+
+    counted_item *first = pool.construct(1, 'a');
+    counted_item *second = pool.construct_for(TEST_TIMEOUT, 2, 'b');
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_EQUAL(2, counted_item::live);
+    TEST_ASSERT_EQUAL(1, first->a);
+    TEST_ASSERT_EQUAL('a', first->b);
+    TEST_ASSERT_EQUAL(2, second->a);
+    TEST_ASSERT_EQUAL('b', second->b);
+
+    TEST_ASSERT_NULL(pool.construct(3, 'c'));
+    TEST_ASSERT_EQUAL(2, counted_item::live);
+
+    TEST_ASSERT_EQUAL(osOK, pool.destroy(first));
+    TEST_ASSERT_EQUAL(1, counted_item::live);
+    counted_item *third = pool.construct(3, 'c');
+    TEST_ASSERT_EQUAL_PTR(first, third);
+
+    TEST_ASSERT_EQUAL(osOK, pool.destroy(second));
+    TEST_ASSERT_EQUAL(osOK, pool.destroy(third));
+    TEST_ASSERT_EQUAL(0, counted_item::live);
+}
+
 /* Robustness checks for free() function.
  * Function under test is called with invalid parameters.
  *
@@ -648,6 +703,7 @@ Case cases[] = {
 
     Case("Test: timeout", test_mem_pool_timeout),
     Case("Test: wait forever", test_mem_pool_waitforever),
+    Case("Test: construct() and destroy()", test_mem_pool_construct_destroy),
 
     Case("Test: free() - robust (free called with invalid param - NULL).", free_block_invalid_parameter_null),
     Case("Test: free() - robust (free called with invalid param).", free_block_invalid_parameter)
@@ -0,0 +1,296 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+#if !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+/* Cost of RTOS primitives, in CPU cycles.
+ *
+ * Each case reports its average with greentea_send_kv, as a key ending in
+ * "_cycles", so results can be collected from the logs and compared between
+ * targets and releases. Cases only fail if the primitive itself fails.
+ */
+
+#if defined(__CORTEX_M23) || defined(__CORTEX_M33)
+#define TEST_STACK_SIZE 768
+#else
+#define TEST_STACK_SIZE 512
+#endif
+
+#define ITERATIONS      1000
+#define ISR_ITERATIONS  100
+#define ISR_DELAY_US    500
+
+#define FLAG_PING       (1 << 0)
+#define FLAG_ISR        (1 << 1)
+
+/* Cycle counter: DWT CYCCNT where the core has one, else the us ticker
+ * scaled to the core clock.
+ */
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+static bool dwt_available;
+#endif
+
+static void cycles_init()
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(DWT_CTRL_NOCYCCNT_Msk)
+    dwt_available = !(DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk);
+#else
+    dwt_available = true;
+#endif
+    if (dwt_available) {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        // Some cores implement the bit as read-as-zero
+        dwt_available = (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0;
+    }
+#endif
+}
+
+static inline uint32_t cycles_read()
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (dwt_available) {
+        return DWT->CYCCNT;
+    }
+#endif
+    return us_ticker_read() * (SystemCoreClock / 1000000);
+}
+
+static void report(const char *key, uint32_t total_cycles, uint32_t count)
+{
+    uint32_t average = total_cycles / count;
+    utest_printf("%s: %lu cycles\r\n", key, (unsigned long) average);
+    greentea_send_kv(key, (int) average);
+}
+
+/** Uncontended lock and unlock of a Mutex */
+void test_mutex_uncontended()
+{
+    Mutex mutex;
+
+    uint32_t start = cycles_read();
+    for (int i = 0; i < ITERATIONS; i++) {
+        mutex.lock();
+        mutex.unlock();
+    }
+    uint32_t total = cycles_read() - start;
+
+    report("mutex_uncontended_cycles", total, ITERATIONS);
+}
+
+static Mutex contended_mutex;
+static Semaphore contended_ready;
+static volatile uint32_t contended_unlock_time;
+static volatile bool contended_stop;
+
+static void mutex_holder()
+{
+    while (!contended_stop) {
+        contended_mutex.lock();
+        contended_ready.release();
+        // Let the waiter block on the mutex
+        ThisThread::yield();
+        contended_unlock_time = cycles_read();
+        contended_mutex.unlock();
+    }
+}
+
+/** Time from unlock by one thread to lock return in a higher priority thread blocked on it */
+void test_mutex_contended()
+{
+    Thread holder(osPriorityNormal, TEST_STACK_SIZE);
+    uint32_t total = 0;
+
+    contended_stop = false;
+    holder.start(mutex_holder);
+    ThisThread::set_priority(osPriorityAboveNormal);
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        contended_ready.acquire();
+        if (i == ITERATIONS - 1) {
+            contended_stop = true;
+        }
+        contended_mutex.lock();
+        total += cycles_read() - contended_unlock_time;
+        contended_mutex.unlock();
+    }
+
+    ThisThread::set_priority(osPriorityNormal);
+    holder.join();
+
+    report("mutex_contended_handoff_cycles", total, ITERATIONS);
+}
+
+static uint32_t queue_token;
+static Queue<uint32_t, 1> ping_queue;
+static Queue<uint32_t, 1> pong_queue;
+
+static void queue_echo()
+{
+    for (int i = 0; i < ITERATIONS; i++) {
+        osEvent evt = ping_queue.get();
+        pong_queue.put((uint32_t *) evt.value.p);
+    }
+}
+
+/** Round trip of a message through two Queues and a second thread, halved */
+void test_queue_ping_pong()
+{
+    Thread echo(osPriorityNormal, TEST_STACK_SIZE);
+    echo.start(queue_echo);
+
+    uint32_t start = cycles_read();
+    for (int i = 0; i < ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(osOK, ping_queue.put(&queue_token));
+        osEvent evt = pong_queue.get();
+        TEST_ASSERT_EQUAL(osEventMessage, evt.status);
+    }
+    uint32_t total = cycles_read() - start;
+
+    echo.join();
+
+    report("queue_put_get_latency_cycles", total, 2 * ITERATIONS);
+}
+
+static volatile bool yield_stop;
+
+static void yielder()
+{
+    while (!yield_stop) {
+        ThisThread::yield();
+    }
+}
+
+/** Context switch between two threads of the same priority yielding to each other */
+void test_context_switch()
+{
+    Thread other(osPriorityNormal, TEST_STACK_SIZE);
+
+    yield_stop = false;
+    other.start(yielder);
+    ThisThread::yield();
+
+    // Each yield switches to the other thread, which yields back
+    uint32_t start = cycles_read();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ThisThread::yield();
+    }
+    uint32_t total = cycles_read() - start;
+
+    yield_stop = true;
+    other.join();
+
+    report("context_switch_cycles", total, 2 * ITERATIONS);
+}
+
+static Thread *isr_target;
+static volatile uint32_t isr_time;
+static volatile uint32_t isr_latency;
+
+static void isr_signal()
+{
+    isr_time = cycles_read();
+    isr_target->flags_set(FLAG_ISR);
+}
+
+static void isr_waiter()
+{
+    for (int i = 0; i < ISR_ITERATIONS; i++) {
+        ThisThread::flags_wait_any(FLAG_ISR);
+        isr_latency = cycles_read() - isr_time;
+        // Wait for the main thread to collect the result
+        ThisThread::flags_wait_any(FLAG_PING);
+    }
+}
+
+/** Time from a thread flag set in an interrupt handler to the waiting thread running */
+void test_isr_to_thread()
+{
+    Thread waiter(osPriorityHigh, TEST_STACK_SIZE);
+    Timeout timeout;
+    uint32_t total = 0;
+
+    isr_target = &waiter;
+    waiter.start(isr_waiter);
+
+    for (int i = 0; i < ISR_ITERATIONS; i++) {
+        timeout.attach_us(isr_signal, ISR_DELAY_US);
+        // The waiter preempts this thread as soon as it's signalled
+        ThisThread::sleep_for(2);
+        total += isr_latency;
+        waiter.flags_set(FLAG_PING);
+    }
+
+    waiter.join();
+
+    report("isr_to_thread_latency_cycles", total, ISR_ITERATIONS);
+}
+
+/** Allocation and free of a MemoryPool block */
+void test_memory_pool()
+{
+    MemoryPool<uint32_t, 4> pool;
+
+    uint32_t start = cycles_read();
+    for (int i = 0; i < ITERATIONS; i++) {
+        uint32_t *block = pool.alloc();
+        TEST_ASSERT_NOT_NULL(block);
+        pool.free(block);
+    }
+    uint32_t total = cycles_read() - start;
+
+    report("memory_pool_alloc_free_cycles", total, ITERATIONS);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    cycles_init();
+    utest_printf("Core clock: %lu Hz\r\n", (unsigned long) SystemCoreClock);
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark uncontended mutex lock/unlock", test_mutex_uncontended),
+    Case("Benchmark contended mutex handoff", test_mutex_contended),
+    Case("Benchmark queue put/get ping-pong", test_queue_ping_pong),
+    Case("Benchmark context switch", test_context_switch),
+    Case("Benchmark ISR to thread signal", test_isr_to_thread),
+    Case("Benchmark MemoryPool alloc/free", test_memory_pool),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -96,6 +96,76 @@ void test_notify_all()
     t2.join();
 }
 
+void test_notify_n()
+{
+    Thread t1(osPriorityNormal, TEST_STACK_SIZE);
+    Thread t2(osPriorityNormal, TEST_STACK_SIZE);
+    Thread t3(osPriorityNormal, TEST_STACK_SIZE);
+
+    change_counter = 0;
+    t1.start(increment_on_signal);
+    t2.start(increment_on_signal);
+    t3.start(increment_on_signal);
+
+    wait_ms(TEST_DELAY);
+    TEST_ASSERT_EQUAL(0, change_counter);
+
+    mutex.lock();
+    cond.notify_n(2);
+    mutex.unlock();
+
+    wait_ms(TEST_DELAY);
+    TEST_ASSERT_EQUAL(2, change_counter);
+
+    mutex.lock();
+    cond.notify_n(2);
+    mutex.unlock();
+
+    wait_ms(TEST_DELAY);
+    TEST_ASSERT_EQUAL(3, change_counter);
+
+    t1.join();
+    t2.join();
+    t3.join();
+}
+
+void increment_on_notify_before_timeout()
+{
+    mutex.lock();
+
+    if (!cond.wait_for(3 * TEST_DELAY)) {
+        change_counter++;
+    }
+
+    mutex.unlock();
+}
+
+void test_notify_all_timeout()
+{
+    Thread t1(osPriorityNormal, TEST_STACK_SIZE);
+    Thread t2(osPriorityNormal, TEST_STACK_SIZE);
+    Thread t3(osPriorityNormal, TEST_STACK_SIZE);
+
+    change_counter = 0;
+    t1.start(increment_on_notify_before_timeout);
+    t2.start(increment_on_notify_before_timeout);
+    t3.start(increment_on_notify_before_timeout);
+
+    wait_ms(TEST_DELAY);
+
+    // Holding the mutex past the timeouts, the waiters notified but not yet
+    // woken in turn time out, and must still see the notification
+    mutex.lock();
+    cond.notify_all();
+    wait_ms(4 * TEST_DELAY);
+    mutex.unlock();
+
+    t1.join();
+    t2.join();
+    t3.join();
+    TEST_ASSERT_EQUAL(3, change_counter);
+}
+
 
 class TestConditionVariable : public ConditionVariable {
 
@@ -179,6 +249,8 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 Case cases[] = {
     Case("Test notify one", test_notify_one),
     Case("Test notify all", test_notify_all),
+    Case("Test notify n", test_notify_n),
+    Case("Test notify all with a timeout", test_notify_all_timeout),
     Case("Test linked list", TestConditionVariable::test_linked_list),
 };
 
@@ -482,6 +482,39 @@ void test_mail_full()
     TEST_ASSERT_EQUAL(true, m.full());
 }
 
+/** Test batch alloc, put, get and free
+
+    Given a mail of mail_t data with size of 4
+    when a batch of 6 blocks is allocated
+    then only 4 blocks are returned
+    when they are put and read back as a batch
+    then they arrive in order and can be freed together
+ */
+void test_batch()
+{
+    Mail<mail_t, 4> m;
+    mail_t *tx[6];
+    mail_t *rx[6];
+
+    TEST_ASSERT_EQUAL(4, m.alloc_n(tx, 6));
+    TEST_ASSERT_EQUAL(0, m.alloc_n(tx + 4, 2));
+    for (uint32_t i = 0; i < 4; i++) {
+        tx[i]->data = DATA_BASE + i;
+    }
+
+    TEST_ASSERT_EQUAL(4, m.put_n(tx, 4));
+    TEST_ASSERT_EQUAL(true, m.full());
+
+    TEST_ASSERT_EQUAL(4, m.get_n(rx, 6, 0));
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_PTR(tx[i], rx[i]);
+        TEST_ASSERT_EQUAL(DATA_BASE + i, rx[i]->data);
+    }
+
+    TEST_ASSERT_EQUAL(osOK, m.free_n(rx, 4));
+    TEST_ASSERT_EQUAL(4, m.alloc_n(tx, 4));
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -503,7 +536,8 @@ Case cases[] = {
     Case("Test message send/receive multi-thread and per thread order", test_multi_thread_order),
     Case("Test message send/receive multi-thread, multi-Mail and per thread order", test_multi_thread_multi_mail_order),
     Case("Test mail empty", test_mail_empty),
-    Case("Test mail full", test_mail_full)
+    Case("Test mail full", test_mail_full),
+    Case("Test batch alloc, put, get and free", test_batch)
 };
 
 Specification specification(test_setup, cases);
@@ -232,6 +232,46 @@ void test_dual_thread_lock(void)
     mutex.unlock();
 }
 
+void test_priority_inheritance_thread(Mutex *mutex)
+{
+    mutex->lock();
+    TEST_ASSERT_EQUAL(ThisThread::get_id(), mutex->get_owner());
+    mutex->unlock();
+}
+
+/** Test priority inheritance
+
+    Given a mutex locked by thread A
+    When a higher priority thread B blocks on @a lock
+    Then thread A inherits the priority of thread B
+    When thread A calls @a unlock
+    Then thread B acquires the mutex and thread A gets its own priority back
+*/
+void test_priority_inheritance(void)
+{
+    Mutex mutex;
+    Thread thread(osPriorityAboveNormal, TEST_STACK_SIZE);
+    osThreadId_t self = ThisThread::get_id();
+    osPriority_t base = osThreadGetPriority(self);
+
+    mutex.lock();
+    mutex.lock();
+    TEST_ASSERT_EQUAL(self, mutex.get_owner());
+
+    thread.start(callback(test_priority_inheritance_thread, &mutex));
+    ThisThread::sleep_for(TEST_DELAY);
+    TEST_ASSERT_EQUAL(osPriorityAboveNormal, osThreadGetPriority(self));
+
+    mutex.unlock();
+    TEST_ASSERT_EQUAL(osPriorityAboveNormal, osThreadGetPriority(self));
+    mutex.unlock();
+    TEST_ASSERT_EQUAL(base, osThreadGetPriority(self));
+
+    thread.join();
+    TEST_ASSERT_TRUE(mutex.trylock());
+    mutex.unlock();
+}
+
 /** Test single thread lock recursive
 
     Given a mutex and a single running thread
@@ -300,6 +340,7 @@ Case cases[] = {
     Case("Test dual thread second thread lock", test_dual_thread_nolock<test_dual_thread_nolock_lock_thread>),
     Case("Test dual thread second thread trylock", test_dual_thread_nolock<test_dual_thread_nolock_trylock_thread>),
     Case("Test multiple thread", test_multiple_threads),
+    Case("Test priority inheritance", test_priority_inheritance),
 };
 
 Specification specification(test_setup, cases);
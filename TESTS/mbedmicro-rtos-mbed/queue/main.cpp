@@ -320,6 +320,73 @@ void test_queue_full()
     TEST_ASSERT_EQUAL(true, q.full());
 }
 
+/** Test batch put and get
+
+    Given a queue of uint32_t data with size of 4
+    when a batch of 6 messages is put
+    then only the first 4 are inserted
+    when the messages are read back in batches of 3
+    then they are retrieved in order and the last batch is short
+ */
+void test_put_get_n()
+{
+    Queue<uint32_t, 4> q;
+    uint32_t *msgs[6];
+    uint32_t *rx[3];
+
+    for (uint32_t i = 0; i < 6; i++) {
+        msgs[i] = (uint32_t *)(TEST_UINT_MSG + i);
+    }
+
+    TEST_ASSERT_EQUAL(4, q.put_n(msgs, 6));
+    TEST_ASSERT_EQUAL(true, q.full());
+    TEST_ASSERT_EQUAL(0, q.put_n(msgs + 4, 2));
+
+    TEST_ASSERT_EQUAL(3, q.get_n(rx, 3, 0));
+    TEST_ASSERT_EQUAL_PTR(msgs[0], rx[0]);
+    TEST_ASSERT_EQUAL_PTR(msgs[1], rx[1]);
+    TEST_ASSERT_EQUAL_PTR(msgs[2], rx[2]);
+    TEST_ASSERT_EQUAL(1, q.get_n(rx, 3, 0));
+    TEST_ASSERT_EQUAL_PTR(msgs[3], rx[0]);
+    TEST_ASSERT_EQUAL(0, q.get_n(rx, 3, 0));
+}
+
+void thread_get_n(Queue<uint32_t, 4> *q)
+{
+    uint32_t *rx[4];
+    uint32_t received = 0;
+    while (received < 4) {
+        uint32_t n = q->get_n(rx, 4);
+        for (uint32_t i = 0; i < n; i++) {
+            TEST_ASSERT_EQUAL_PTR((uint32_t *)(TEST_UINT_MSG + received + i), rx[i]);
+        }
+        received += n;
+    }
+}
+
+/** Test batch put to a waiting receiver
+
+    Given a thread blocked in get_n on an empty queue
+    when a batch of 4 messages is put
+    then the thread receives all of them in order
+ */
+void test_put_n_wakes_receiver()
+{
+    Thread t(osPriorityAboveNormal, THREAD_STACK_SIZE);
+    Queue<uint32_t, 4> q;
+    uint32_t *msgs[4];
+
+    for (uint32_t i = 0; i < 4; i++) {
+        msgs[i] = (uint32_t *)(TEST_UINT_MSG + i);
+    }
+
+    t.start(callback(thread_get_n, &q));
+    ThisThread::sleep_for(TEST_TIMEOUT);
+
+    TEST_ASSERT_EQUAL(4, q.put_n(msgs, 4, TEST_TIMEOUT));
+    t.join();
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(5, "default_auto");
@@ -339,7 +406,9 @@ Case cases[] = {
     Case("Test message ordering", test_msg_order),
     Case("Test message priority", test_msg_prio),
     Case("Test queue empty", test_queue_empty),
-    Case("Test queue full", test_queue_full)
+    Case("Test queue full", test_queue_full),
+    Case("Test batch put and get", test_put_get_n),
+    Case("Test batch put wakes receiver", test_put_n_wakes_receiver)
 };
 
 Specification specification(test_setup, cases);
@@ -0,0 +1,171 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+#if !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#if defined(__CORTEX_M23) || defined(__CORTEX_M33)
+#define TEST_STACK_SIZE 768
+#else
+#define TEST_STACK_SIZE 512
+#endif
+
+#define TEST_DELAY 10
+
+volatile bool thread_done;
+
+void reader_trylock_thread(RWMutex *rw)
+{
+    TEST_ASSERT_TRUE(rw->trylock_shared());
+    TEST_ASSERT_FALSE(rw->trylock());
+    rw->unlock_shared();
+}
+
+/** Test that readers share the lock
+
+    Given a RWMutex held shared by the main thread
+    When a second thread tries to lock it shared and exclusively
+    Then the shared lock succeeds and the exclusive lock fails
+ */
+void test_shared_readers(void)
+{
+    RWMutex rw;
+    Thread thread(osPriorityNormal, TEST_STACK_SIZE);
+
+    rw.lock_shared();
+    thread.start(callback(reader_trylock_thread, &rw));
+    thread.join();
+    rw.unlock_shared();
+
+    TEST_ASSERT_TRUE(rw.trylock());
+    rw.unlock();
+}
+
+void reader_excluded_thread(RWMutex *rw)
+{
+    TEST_ASSERT_FALSE(rw->trylock_shared());
+    TEST_ASSERT_FALSE(rw->trylock_shared_for(TEST_DELAY));
+    TEST_ASSERT_FALSE(rw->trylock());
+}
+
+/** Test that a writer excludes readers and writers
+
+    Given a RWMutex held exclusively by the main thread
+    When a second thread tries to lock it
+    Then every attempt fails
+ */
+void test_writer_excludes(void)
+{
+    RWMutex rw;
+    Thread thread(osPriorityNormal, TEST_STACK_SIZE);
+
+    rw.lock();
+    thread.start(callback(reader_excluded_thread, &rw));
+    thread.join();
+    rw.unlock();
+}
+
+void writer_lock_thread(RWMutex *rw)
+{
+    rw->lock();
+    thread_done = true;
+    rw->unlock();
+}
+
+/** Test that a writer waits for readers and blocks new ones
+
+    Given a RWMutex held shared by the main thread
+    When a second thread locks it exclusively
+    Then the writer blocks until the reader leaves
+        and new readers are refused while the writer is waiting
+ */
+void test_writer_waits_readers(void)
+{
+    RWMutex rw;
+    Thread thread(osPriorityNormal, TEST_STACK_SIZE);
+
+    thread_done = false;
+    rw.lock_shared();
+    thread.start(callback(writer_lock_thread, &rw));
+    ThisThread::sleep_for(TEST_DELAY);
+
+    TEST_ASSERT_FALSE(thread_done);
+    TEST_ASSERT_FALSE(rw.trylock_shared());
+
+    rw.unlock_shared();
+    thread.join();
+    TEST_ASSERT_TRUE(thread_done);
+}
+
+void writer_timeout_thread(RWMutex *rw)
+{
+    TEST_ASSERT_FALSE(rw->trylock_for(TEST_DELAY));
+}
+
+/** Test writer timeout
+
+    Given a RWMutex held shared by the main thread
+    When a second thread tries to lock it exclusively with a timeout
+    Then the attempt times out and readers are admitted again afterwards
+ */
+void test_writer_timeout(void)
+{
+    RWMutex rw;
+    Thread thread(osPriorityNormal, TEST_STACK_SIZE);
+
+    rw.lock_shared();
+    thread.start(callback(writer_timeout_thread, &rw));
+    thread.join();
+
+    TEST_ASSERT_TRUE(rw.trylock_shared());
+    rw.unlock_shared();
+    rw.unlock_shared();
+
+    TEST_ASSERT_TRUE(rw.trylock());
+    rw.unlock();
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test shared readers", test_shared_readers),
+    Case("Test writer excludes", test_writer_excludes),
+    Case("Test writer waits for readers", test_writer_waits_readers),
+    Case("Test writer timeout", test_writer_timeout),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,156 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#if defined(__CORTEX_M23) || defined(__CORTEX_M33)
+#define TEST_STACK_SIZE 1024
+#else
+#define TEST_STACK_SIZE 768
+#endif
+
+#define TEST_WORKERS 2
+#define TEST_RANGE 100
+#define TEST_NESTED 4
+
+static volatile uint32_t job_count;
+static volatile uint8_t range_hits[TEST_RANGE];
+static ThreadPool *test_pool;
+
+void count_job()
+{
+    core_util_atomic_incr_u32(&job_count, 1);
+}
+
+void mark_range(uint32_t first, uint32_t last)
+{
+    for (uint32_t i = first; i < last; i++) {
+        core_util_atomic_incr_u8(&range_hits[i], 1);
+    }
+}
+
+void nested_job()
+{
+    ThreadPool::Task tasks[TEST_NESTED];
+
+    for (int i = 0; i < TEST_NESTED; i++) {
+        tasks[i].set(count_job);
+        TEST_ASSERT_TRUE(test_pool->submit(tasks[i]));
+    }
+    for (int i = 0; i < TEST_NESTED; i++) {
+        test_pool->wait(tasks[i]);
+    }
+}
+
+/** Test that submitted tasks complete
+
+    Given a ThreadPool
+    When tasks are submitted and waited for
+    Then every task has run once, and can be submitted again
+ */
+void test_submit(void)
+{
+    ThreadPool pool(TEST_WORKERS, osPriorityNormal, TEST_STACK_SIZE);
+    ThreadPool::Task tasks[5];
+
+    job_count = 0;
+    for (int i = 0; i < 5; i++) {
+        tasks[i].set(count_job);
+        TEST_ASSERT_TRUE(pool.submit(tasks[i]));
+    }
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(tasks[i].wait_for(1000));
+        TEST_ASSERT_TRUE(tasks[i].done());
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, job_count);
+
+    TEST_ASSERT_TRUE(pool.submit(tasks[0]));
+    pool.wait(tasks[0]);
+    TEST_ASSERT_EQUAL_UINT32(6, job_count);
+}
+
+/** Test that tasks waiting for tasks don't deadlock the pool
+
+    Given a ThreadPool whose workers all run tasks submitting more tasks
+    When those tasks wait for the tasks they submitted
+    Then every task completes
+ */
+void test_nested(void)
+{
+    ThreadPool pool(TEST_WORKERS, osPriorityNormal, TEST_STACK_SIZE);
+    ThreadPool::Task tasks[TEST_WORKERS + 1];
+
+    test_pool = &pool;
+    job_count = 0;
+    for (int i = 0; i < TEST_WORKERS + 1; i++) {
+        tasks[i].set(nested_job);
+        TEST_ASSERT_TRUE(pool.submit(tasks[i]));
+    }
+    for (int i = 0; i < TEST_WORKERS + 1; i++) {
+        pool.wait(tasks[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32((TEST_WORKERS + 1) * TEST_NESTED, job_count);
+}
+
+/** Test that parallel_for covers the range once
+
+    Given a ThreadPool
+    When parallel_for is run over a range with a grain not dividing it
+    Then every index of the range is visited exactly once, and none outside it
+ */
+void test_parallel_for(void)
+{
+    ThreadPool pool(TEST_WORKERS, osPriorityNormal, TEST_STACK_SIZE);
+
+    memset((void *)range_hits, 0, sizeof(range_hits));
+    pool.parallel_for(3, TEST_RANGE - 3, mark_range, 7);
+    for (int i = 0; i < TEST_RANGE; i++) {
+        TEST_ASSERT_EQUAL_UINT8((i >= 3 && i < TEST_RANGE - 3) ? 1 : 0, range_hits[i]);
+    }
+
+    // Empty range
+    pool.parallel_for(10, 10, mark_range, 7);
+    TEST_ASSERT_EQUAL_UINT8(0, range_hits[0]);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test submit", test_submit),
+    Case("Test nested tasks", test_nested),
+    Case("Test parallel_for", test_parallel_for),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,128 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#if !DEVICE_TRNG
+#error [NOT_SUPPORTED] TRNG not supported for this target
+#endif
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/entropy_poll.h"
+#include "mbed_entropy_pool.h"
+#include <string.h>
+
+using namespace utest::v1;
+
+#define BUFFER_SIZE 64
+
+static void health_failure(mbed_entropy_health_t failure)
+{
+    TEST_FAIL_MESSAGE("TRNG output failed a health test");
+}
+
+/**
+ * Test that requests are served and counted
+ */
+void test_entropy_pool_get()
+{
+    uint8_t buffer[BUFFER_SIZE] = {0};
+    uint8_t zeros[BUFFER_SIZE] = {0};
+    mbed_entropy_pool_stats_t before, after;
+    size_t output_length = 0;
+
+    mbed_entropy_pool_attach_health_failure(health_failure);
+    mbed_entropy_pool_get_stats(&before);
+
+    for (int i = 0; i < 4; i++) {
+        size_t length = 0;
+        TEST_ASSERT_EQUAL(0, mbed_entropy_pool_get(buffer + output_length, BUFFER_SIZE / 4, &length));
+        output_length += length;
+    }
+    TEST_ASSERT_TRUE(output_length > 0);
+    TEST_ASSERT_TRUE(memcmp(buffer, zeros, output_length) != 0);
+
+    mbed_entropy_pool_get_stats(&after);
+    TEST_ASSERT_EQUAL(output_length, after.bytes_served - before.bytes_served);
+    TEST_ASSERT_EQUAL(before.health_failures, after.health_failures);
+
+    mbed_entropy_pool_attach_health_failure(NULL);
+}
+
+/**
+ * Test that a filled pool serves a request without polling the TRNG
+ */
+void test_entropy_pool_refill()
+{
+#if MBED_CONF_ENTROPY_POOL_SIZE
+    uint8_t buffer[MBED_CONF_ENTROPY_POOL_SIZE / 2];
+    mbed_entropy_pool_stats_t before, after;
+    size_t output_length = 0;
+
+    mbed_entropy_pool_refill();
+    mbed_entropy_pool_get_stats(&before);
+
+    TEST_ASSERT_EQUAL(0, mbed_entropy_pool_get(buffer, sizeof(buffer), &output_length));
+    TEST_ASSERT_EQUAL(sizeof(buffer), output_length);
+
+    mbed_entropy_pool_get_stats(&after);
+    TEST_ASSERT_EQUAL(before.pool_misses, after.pool_misses);
+#else
+    TEST_IGNORE_MESSAGE("entropy-pool.size is 0");
+#endif
+}
+
+/**
+ * Test mbed TLS getting its entropy through the pool
+ */
+void test_entropy_pool_hardware_poll()
+{
+    uint8_t buffer[BUFFER_SIZE];
+    mbed_entropy_pool_stats_t before, after;
+    size_t output_length = 0;
+
+    mbed_entropy_pool_get_stats(&before);
+    TEST_ASSERT_EQUAL(0, mbedtls_hardware_poll(NULL, buffer, sizeof(buffer), &output_length));
+    mbed_entropy_pool_get_stats(&after);
+    TEST_ASSERT_EQUAL(output_length, after.bytes_served - before.bytes_served);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Entropy pool get", test_entropy_pool_get),
+    Case("Entropy pool refill", test_entropy_pool_refill),
+    Case("Entropy pool as mbedtls_hardware_poll", test_entropy_pool_hardware_poll)
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
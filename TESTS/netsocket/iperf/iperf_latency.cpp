@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "TCPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "iperf_tests.h"
+
+using namespace utest::v1;
+
+namespace {
+static const int SAMPLES = 200;
+static const int PACKET_SIZE = 64;
+
+uint32_t rtt_us[SAMPLES];
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(const uint32_t *sorted, int count, int pct)
+{
+    int index = (count * pct) / 100;
+    return sorted[index < count ? index : count - 1];
+}
+
+/** Round trip time of small packets through the TCP echo server */
+void IPERF_TCP_LATENCY()
+{
+    SocketAddress addr;
+    NetworkInterface::get_default_instance()->gethostbyname(ECHO_SERVER_ADDR, &addr);
+    addr.set_port(ECHO_SERVER_PORT);
+
+    TCPSocket sock;
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.open(NetworkInterface::get_default_instance()));
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.connect(addr));
+
+    uint8_t tx_buff[PACKET_SIZE];
+    uint8_t rx_buff[PACKET_SIZE];
+    memset(tx_buff, 'x', sizeof(tx_buff));
+
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < SAMPLES; i++) {
+        uint32_t start = timer.read_us();
+        TEST_ASSERT_EQUAL(PACKET_SIZE, sock.send(tx_buff, PACKET_SIZE));
+        int recvd = 0;
+        while (recvd < PACKET_SIZE) {
+            nsapi_size_or_error_t ret = sock.recv(rx_buff + recvd, PACKET_SIZE - recvd);
+            TEST_ASSERT(ret > 0);
+            recvd += ret;
+        }
+        rtt_us[i] = timer.read_us() - start;
+    }
+    sock.close();
+
+    qsort(rtt_us, SAMPLES, sizeof(rtt_us[0]), compare_u32);
+    uint32_t p50 = percentile(rtt_us, SAMPLES, 50);
+    uint32_t p90 = percentile(rtt_us, SAMPLES, 90);
+    uint32_t p99 = percentile(rtt_us, SAMPLES, 99);
+
+    printf("MBED: tcp_latency: min %lu us, p50 %lu us, p90 %lu us, p99 %lu us, max %lu us\n",
+           (unsigned long) rtt_us[0], (unsigned long) p50, (unsigned long) p90,
+           (unsigned long) p99, (unsigned long) rtt_us[SAMPLES - 1]);
+    greentea_send_kv("tcp_latency_p50_us", (int) p50);
+    greentea_send_kv("tcp_latency_p90_us", (int) p90);
+    greentea_send_kv("tcp_latency_p99_us", (int) p99);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "TCPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "iperf_tests.h"
+
+using namespace utest::v1;
+
+/* iperf2 TCP streams carry no framing: the client sends an all-zero header,
+ * meaning no dual or tradeoff test, followed by data until it closes.
+ * Start the server with `iperf -s -p <iperf-server-port>`.
+ */
+
+namespace {
+struct tcp_stream_t {
+    TCPSocket sock;
+    uint8_t *buffer;
+    uint64_t bytes;
+    nsapi_error_t error;
+};
+
+tcp_stream_t streams[iperf_global::MAX_STREAMS];
+Timer run_timer;
+}
+
+static void fill_iperf_pattern(uint8_t *buff, size_t len)
+{
+    for (size_t i = 0; i < len; ++i) {
+        buff[i] = '0' + (i % 10);
+    }
+}
+
+static void tcp_stream_send(tcp_stream_t *stream)
+{
+    while (run_timer.read_ms() < IPERF_DURATION * 1000) {
+        nsapi_size_or_error_t sent = stream->sock.send(stream->buffer, IPERF_TCP_BUFFER_SIZE);
+        if (sent < 0) {
+            stream->error = sent;
+            return;
+        }
+        stream->bytes += sent;
+    }
+}
+
+void IPERF_TCP_CLIENT()
+{
+    SKIP_IF_NO_IPERF_SERVER();
+    MBED_STATIC_ASSERT(IPERF_STREAMS <= iperf_global::MAX_STREAMS, "Too many iperf streams");
+
+    SocketAddress addr;
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, iperf_server_address(addr));
+
+    Thread *threads[IPERF_STREAMS];
+    int i;
+
+    for (i = 0; i < IPERF_STREAMS; i++) {
+        tcp_stream_t &stream = streams[i];
+        stream.bytes = 0;
+        stream.error = NSAPI_ERROR_OK;
+        stream.buffer = (uint8_t *)calloc(1, IPERF_TCP_BUFFER_SIZE);
+        TEST_ASSERT_NOT_NULL(stream.buffer);
+        // The iperf header at the start of the buffer stays zeroed
+        fill_iperf_pattern(stream.buffer + iperf_global::CLIENT_HEADER_SIZE,
+                           IPERF_TCP_BUFFER_SIZE - iperf_global::CLIENT_HEADER_SIZE);
+
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, stream.sock.open(NetworkInterface::get_default_instance()));
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, stream.sock.connect(addr));
+    }
+
+    CpuLoad load;
+    load.start();
+    run_timer.reset();
+    run_timer.start();
+
+    for (i = 0; i < IPERF_STREAMS; i++) {
+        threads[i] = new Thread(osPriorityNormal, iperf_global::STREAM_STACK_SIZE);
+        TEST_ASSERT_EQUAL(osOK, threads[i]->start(callback(tcp_stream_send, &streams[i])));
+    }
+
+    for (i = 0; i < IPERF_STREAMS; i++) {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    run_timer.stop();
+    load.stop();
+
+    uint64_t total = 0;
+    for (i = 0; i < IPERF_STREAMS; i++) {
+        tcp_stream_t &stream = streams[i];
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, stream.error);
+        total += stream.bytes;
+        stream.sock.close();
+        free(stream.buffer);
+    }
+
+    iperf_report("tcp_client", total, run_timer.read_us(), load);
+}
+
+void IPERF_TCP_SERVER()
+{
+    TCPSocket listener;
+    nsapi_error_t err;
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, listener.open(NetworkInterface::get_default_instance()));
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, listener.bind(IPERF_SERVER_PORT));
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, listener.listen(1));
+
+    printf("MBED: run `iperf -c %s -p %d` on the host\n",
+           NetworkInterface::get_default_instance()->get_ip_address(), IPERF_SERVER_PORT);
+
+    listener.set_timeout(IPERF_ACCEPT_TIMEOUT * 1000);
+    TCPSocket *client = listener.accept(&err);
+    if (client == NULL) {
+        listener.close();
+        TEST_IGNORE_MESSAGE("No iperf client connected");
+        return;
+    }
+
+    uint8_t *buffer = (uint8_t *)malloc(IPERF_TCP_BUFFER_SIZE);
+    TEST_ASSERT_NOT_NULL(buffer);
+
+    CpuLoad load;
+    Timer timer;
+    uint64_t total = 0;
+    nsapi_size_or_error_t recvd;
+
+    client->set_timeout(IPERF_ACCEPT_TIMEOUT * 1000);
+    load.start();
+    timer.start();
+    // The client closing the connection ends the run
+    while ((recvd = client->recv(buffer, IPERF_TCP_BUFFER_SIZE)) > 0) {
+        total += recvd;
+    }
+    timer.stop();
+    load.stop();
+
+    free(buffer);
+    client->close();
+    listener.close();
+
+    TEST_ASSERT_EQUAL(0, recvd);
+    iperf_report("tcp_server", total, timer.read_us(), load);
+}
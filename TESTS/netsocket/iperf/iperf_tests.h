@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IPERF_TESTS_H
+#define IPERF_TESTS_H
+
+#include "../test_params.h"
+
+/*
+ * Tuning of the runs, overridable from mbed_app.json
+ */
+#ifndef MBED_CONF_APP_IPERF_DURATION
+#define IPERF_DURATION 10 // [s]
+#else
+#define IPERF_DURATION MBED_CONF_APP_IPERF_DURATION
+#endif
+
+#ifndef MBED_CONF_APP_IPERF_STREAMS
+#define IPERF_STREAMS 1
+#else
+#define IPERF_STREAMS MBED_CONF_APP_IPERF_STREAMS
+#endif
+
+#ifndef MBED_CONF_APP_IPERF_TCP_BUFFER_SIZE
+#define IPERF_TCP_BUFFER_SIZE 1460
+#else
+#define IPERF_TCP_BUFFER_SIZE MBED_CONF_APP_IPERF_TCP_BUFFER_SIZE
+#endif
+
+#ifndef MBED_CONF_APP_IPERF_UDP_DATAGRAM_SIZE
+#define IPERF_UDP_DATAGRAM_SIZE 1470
+#else
+#define IPERF_UDP_DATAGRAM_SIZE MBED_CONF_APP_IPERF_UDP_DATAGRAM_SIZE
+#endif
+
+#ifndef MBED_CONF_APP_IPERF_UDP_BANDWIDTH
+#define IPERF_UDP_BANDWIDTH 1000000 // [bit/s]
+#else
+#define IPERF_UDP_BANDWIDTH MBED_CONF_APP_IPERF_UDP_BANDWIDTH
+#endif
+
+#ifndef MBED_CONF_APP_IPERF_ACCEPT_TIMEOUT
+#define IPERF_ACCEPT_TIMEOUT 60 // [s]
+#else
+#define IPERF_ACCEPT_TIMEOUT MBED_CONF_APP_IPERF_ACCEPT_TIMEOUT
+#endif
+
+namespace iperf_global {
+#ifdef MBED_GREENTEA_TEST_IPERF_TIMEOUT_S
+static const int TESTS_TIMEOUT = MBED_GREENTEA_TEST_IPERF_TIMEOUT_S;
+#else
+static const int TESTS_TIMEOUT = (10 * 60);
+#endif
+static const int STREAM_STACK_SIZE = 2048;
+static const int MAX_STREAMS = 8;
+
+// iperf2 client_hdr, sent zeroed after the UDP datagram header or at the start of a TCP stream
+static const int CLIENT_HEADER_SIZE = 24;
+}
+
+/** CPU usage over a measurement, from mbed_stats_cpu_get()
+ *
+ * Requires MBED_CPU_STATS_ENABLED, otherwise reported as unavailable.
+ */
+class CpuLoad {
+public:
+    void start();
+    void stop();
+    /** Percentage of the time not spent in the idle thread, or -1 if unknown */
+    int percent() const;
+
+private:
+    mbed_stats_cpu_t _start;
+    mbed_stats_cpu_t _stop;
+};
+
+/** Resolve the configured iperf server, with IPERF_SERVER_PORT */
+nsapi_error_t iperf_server_address(SocketAddress &addr);
+
+/** Whether iperf-server-addr is set in mbed_app.json */
+bool iperf_server_address_configured();
+
+/** Print a result line and send it to the host as key/value */
+void iperf_report(const char *key, uint64_t bytes, uint32_t duration_us, const CpuLoad &load);
+
+#define SKIP_IF_NO_IPERF_SERVER() \
+    if (!iperf_server_address_configured()) { \
+        TEST_SKIP_MESSAGE("iperf-server-addr not configured"); \
+    }
+
+/*
+ * Test cases
+ */
+void IPERF_TCP_CLIENT();
+void IPERF_UDP_CLIENT();
+void IPERF_TCP_SERVER();
+void IPERF_TCP_LATENCY();
+
+#endif //IPERF_TESTS_H
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "UDPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "iperf_tests.h"
+
+using namespace utest::v1;
+
+/* iperf2 UDP datagrams start with a sequence number and a send timestamp,
+ * big endian. The last datagram carries the negated sequence number, and the
+ * server answers it with its report: datagrams received, lost and jitter.
+ * Start the server with `iperf -s -u -p <iperf-server-port>`.
+ */
+
+namespace {
+static const int DATAGRAM_HEADER_SIZE = 12;
+static const int SERVER_REPORT_SIZE = DATAGRAM_HEADER_SIZE + 40;
+static const int FIN_RETRIES = 10;
+static const int FIN_TIMEOUT = 250; // [ms]
+}
+
+static void put_be32(uint8_t *buff, uint32_t value)
+{
+    buff[0] = value >> 24;
+    buff[1] = value >> 16;
+    buff[2] = value >> 8;
+    buff[3] = value;
+}
+
+static uint32_t get_be32(const uint8_t *buff)
+{
+    return ((uint32_t)buff[0] << 24) | ((uint32_t)buff[1] << 16) | ((uint32_t)buff[2] << 8) | buff[3];
+}
+
+static void fill_datagram_header(uint8_t *buff, int32_t id, uint32_t time_us)
+{
+    put_be32(buff, (uint32_t)id);
+    put_be32(buff + 4, time_us / 1000000);
+    put_be32(buff + 8, time_us % 1000000);
+}
+
+static void print_server_report(const uint8_t *report)
+{
+    // server_hdr follows the datagram header
+    const uint8_t *hdr = report + DATAGRAM_HEADER_SIZE;
+    uint32_t errors = get_be32(hdr + 20);
+    uint32_t datagrams = get_be32(hdr + 28);
+    uint32_t jitter_us = get_be32(hdr + 32) * 1000000 + get_be32(hdr + 36);
+    uint32_t loss_permille = datagrams ? (errors * 1000) / datagrams : 0;
+
+    printf("MBED: udp_client: server received %lu datagrams, %lu lost, jitter %lu us\n",
+           (unsigned long) datagrams, (unsigned long) errors, (unsigned long) jitter_us);
+    greentea_send_kv("udp_client_loss_permille", (int) loss_permille);
+    greentea_send_kv("udp_client_jitter_us", (int) jitter_us);
+}
+
+void IPERF_UDP_CLIENT()
+{
+    SKIP_IF_NO_IPERF_SERVER();
+
+    SocketAddress addr;
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, iperf_server_address(addr));
+
+    UDPSocket sock;
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.open(NetworkInterface::get_default_instance()));
+
+    uint8_t *buffer = (uint8_t *)calloc(1, IPERF_UDP_DATAGRAM_SIZE);
+    TEST_ASSERT_NOT_NULL(buffer);
+    for (int i = DATAGRAM_HEADER_SIZE + iperf_global::CLIENT_HEADER_SIZE; i < IPERF_UDP_DATAGRAM_SIZE; i++) {
+        buffer[i] = '0' + (i % 10);
+    }
+
+    // Datagrams are paced to the configured bandwidth
+    const uint32_t interval_us = (uint64_t)IPERF_UDP_DATAGRAM_SIZE * 8 * 1000000 / IPERF_UDP_BANDWIDTH;
+    const uint32_t duration_us = IPERF_DURATION * 1000000;
+
+    CpuLoad load;
+    Timer timer;
+    uint64_t total = 0;
+    uint32_t next_us = 0;
+    int32_t id = 0;
+
+    load.start();
+    timer.start();
+    while (true) {
+        uint32_t now_us = timer.read_us();
+        if (now_us >= duration_us) {
+            break;
+        }
+        if (now_us < next_us) {
+            uint32_t wait_ms = (next_us - now_us) / 1000;
+            if (wait_ms > 0) {
+                ThisThread::sleep_for(wait_ms);
+            }
+            continue;
+        }
+
+        fill_datagram_header(buffer, id++, now_us);
+        nsapi_size_or_error_t sent = sock.sendto(addr, buffer, IPERF_UDP_DATAGRAM_SIZE);
+        next_us += interval_us;
+        if (sent == NSAPI_ERROR_NO_MEMORY || sent == NSAPI_ERROR_WOULD_BLOCK) {
+            // Dropped before reaching the wire, the server counts it as lost
+            continue;
+        }
+        TEST_ASSERT_EQUAL(IPERF_UDP_DATAGRAM_SIZE, sent);
+        total += sent;
+    }
+    timer.stop();
+    load.stop();
+
+    iperf_report("udp_client", total, timer.read_us(), load);
+
+    // Ask the server for its report
+    uint8_t report[SERVER_REPORT_SIZE];
+    bool reported = false;
+    sock.set_timeout(FIN_TIMEOUT);
+    for (int i = 0; i < FIN_RETRIES && !reported; i++) {
+        fill_datagram_header(buffer, -id, timer.read_us());
+        sock.sendto(addr, buffer, IPERF_UDP_DATAGRAM_SIZE);
+        reported = sock.recvfrom(NULL, report, sizeof(report)) >= SERVER_REPORT_SIZE;
+    }
+
+    free(buffer);
+    sock.close();
+
+    if (reported) {
+        print_server_report(report);
+    } else {
+        printf("MBED: udp_client: no report from the server\n");
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define WIFI 2
+#if !defined(MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE) || \
+    (MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == WIFI && !defined(MBED_CONF_NSAPI_DEFAULT_WIFI_SSID))
+#error [NOT_SUPPORTED] No network configuration found for this target.
+#endif
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "utest/utest_stack_trace.h"
+#include "iperf_tests.h"
+
+using namespace utest::v1;
+
+void CpuLoad::start()
+{
+    mbed_stats_cpu_get(&_start);
+}
+
+void CpuLoad::stop()
+{
+    mbed_stats_cpu_get(&_stop);
+}
+
+int CpuLoad::percent() const
+{
+    us_timestamp_t uptime = _stop.uptime - _start.uptime;
+    us_timestamp_t idle = _stop.idle_time - _start.idle_time;
+    if (uptime == 0 || idle > uptime) {
+        return -1;
+    }
+    return (int)(100 - (idle * 100) / uptime);
+}
+
+bool iperf_server_address_configured()
+{
+#ifdef IPERF_SERVER_ADDR
+    return true;
+#else
+    return false;
+#endif
+}
+
+nsapi_error_t iperf_server_address(SocketAddress &addr)
+{
+#ifdef IPERF_SERVER_ADDR
+    nsapi_error_t err = NetworkInterface::get_default_instance()->gethostbyname(IPERF_SERVER_ADDR, &addr);
+    if (err != NSAPI_ERROR_OK) {
+        return err;
+    }
+    addr.set_port(IPERF_SERVER_PORT);
+    printf("MBED: iperf server '%s', port %d\n", addr.get_ip_address(), addr.get_port());
+    return NSAPI_ERROR_OK;
+#else
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+void iperf_report(const char *key, uint64_t bytes, uint32_t duration_us, const CpuLoad &load)
+{
+    uint32_t kbps = duration_us ? (uint32_t)((bytes * 8 * 1000) / duration_us) : 0;
+    int cpu = load.percent();
+
+    printf("MBED: %s: %llu bytes in %lu ms, %lu.%03lu Mbit/s, CPU %d%%\n", key,
+           (unsigned long long) bytes, (unsigned long)(duration_us / 1000),
+           (unsigned long)(kbps / 1000), (unsigned long)(kbps % 1000), cpu);
+
+    char kv_key[32];
+    snprintf(kv_key, sizeof(kv_key), "%s_kbps", key);
+    greentea_send_kv(kv_key, (int) kbps);
+    if (cpu >= 0) {
+        snprintf(kv_key, sizeof(kv_key), "%s_cpu", key);
+        greentea_send_kv(kv_key, cpu);
+    }
+}
+
+static void _ifup()
+{
+    NetworkInterface *net = NetworkInterface::get_default_instance();
+    nsapi_error_t err = net->connect();
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, err);
+    printf("MBED: iperf IP address is '%s'\n", net->get_ip_address());
+}
+
+static void _ifdown()
+{
+    NetworkInterface::get_default_instance()->disconnect();
+    printf("MBED: ifdown\n");
+}
+
+// Test setup
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(iperf_global::TESTS_TIMEOUT, "default_auto");
+    _ifup();
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+void greentea_teardown(const size_t passed, const size_t failed, const failure_t failure)
+{
+    _ifdown();
+    return greentea_test_teardown_handler(passed, failed, failure);
+}
+
+static void test_failure_handler(const failure_t failure)
+{
+    UTEST_LOG_FUNCTION();
+    if (failure.location == LOCATION_TEST_SETUP || failure.location == LOCATION_TEST_TEARDOWN) {
+        verbose_test_failure_handler(failure);
+        GREENTEA_TESTSUITE_RESULT(false);
+        while (1) ;
+    }
+}
+
+Case cases[] = {
+    Case("IPERF_TCP_LATENCY", IPERF_TCP_LATENCY),
+    Case("IPERF_TCP_CLIENT", IPERF_TCP_CLIENT),
+    Case("IPERF_UDP_CLIENT", IPERF_UDP_CLIENT),
+#if MBED_CONF_APP_IPERF_SERVER_MODE
+    Case("IPERF_TCP_SERVER", IPERF_TCP_SERVER),
+#endif
+};
+
+handlers_t iperf_test_case_handlers = {
+    default_greentea_test_setup_handler,
+    greentea_test_teardown_handler,
+    test_failure_handler,
+    greentea_case_setup_handler,
+    greentea_case_teardown_handler,
+    greentea_case_failure_continue_handler
+};
+
+Specification specification(greentea_setup, cases, greentea_teardown, iperf_test_case_handlers);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -48,4 +48,14 @@
 #define ECHO_SERVER_DISCARD_PORT_TLS MBED_CONF_APP_ECHO_SERVER_DISCARD_PORT_TLS
 #endif
 
+#ifdef MBED_CONF_APP_IPERF_SERVER_ADDR
+#define IPERF_SERVER_ADDR MBED_CONF_APP_IPERF_SERVER_ADDR
+#endif
+
+#ifndef MBED_CONF_APP_IPERF_SERVER_PORT
+#define IPERF_SERVER_PORT 5001
+#else
+#define IPERF_SERVER_PORT MBED_CONF_APP_IPERF_SERVER_PORT
+#endif
+
 #endif //TEST_PARAMS_H
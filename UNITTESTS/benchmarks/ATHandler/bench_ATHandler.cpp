@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "events/EventQueue.h"
+#include "ATHandler.h"
+#include "platform/FileHandle.h"
+#include "mbed_poll_stub.h"
+#include <string.h>
+
+using namespace mbed;
+using namespace events;
+
+/* Modem that answers every command with the same response, handed out in
+ * one read as a UART with a deep enough buffer would.
+ */
+class ModemFileHandle : public FileHandle {
+public:
+    ModemFileHandle(const char *response) : _response(response), _pending(0)
+    {
+    }
+
+    virtual ssize_t read(void *buffer, size_t size)
+    {
+        size_t len = strlen(_pending ? _pending : "");
+        if (len > size) {
+            len = size;
+        }
+        if (len) {
+            memcpy(buffer, _pending, len);
+            _pending += len;
+            if (*_pending == '\0') {
+                _pending = 0;
+            }
+        }
+        return len;
+    }
+
+    virtual ssize_t write(const void *buffer, size_t size)
+    {
+        // The response is armed by the end of the command
+        if (size && ((const char *)buffer)[size - 1] == '\r') {
+            _pending = _response;
+        }
+        return size;
+    }
+
+    virtual off_t seek(off_t offset, int whence = SEEK_SET)
+    {
+        return 0;
+    }
+
+    virtual int close()
+    {
+        return 0;
+    }
+
+private:
+    const char *_response;
+    const char *_pending;
+};
+
+class BenchATHandler : public testing::Test {
+protected:
+    EventQueue queue;
+
+    virtual void SetUp()
+    {
+        mbed_poll_stub::revents_value = POLLIN | POLLOUT;
+        mbed_poll_stub::int_value = 1;
+    }
+};
+
+static void urc_callback()
+{
+}
+
+TEST_F(BenchATHandler, read_int)
+{
+    ModemFileHandle fh("\r\n+CSQ: 23,99\r\n\r\nOK\r\n");
+    ATHandler at(&fh, queue, 1000, "\r");
+    at.set_debug(false);
+    int rssi = 0;
+
+    benchmark::run("athandler_csq_read_int", [&]() {
+        at.lock();
+        at.cmd_start_stop("+CSQ", "");
+        at.resp_start("+CSQ:");
+        rssi = at.read_int();
+        at.read_int();
+        at.resp_stop();
+        at.unlock();
+    });
+    EXPECT_EQ(23, rssi);
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+}
+
+TEST_F(BenchATHandler, read_string)
+{
+    ModemFileHandle fh("\r\n+COPS: 0,0,\"Operator Name Long\",7\r\n\r\nOK\r\n");
+    ATHandler at(&fh, queue, 1000, "\r");
+    at.set_debug(false);
+    char name[32];
+
+    benchmark::run("athandler_cops_read_string", [&]() {
+        at.lock();
+        at.cmd_start_stop("+COPS", "?");
+        at.resp_start("+COPS:");
+        at.skip_param(2);
+        at.read_string(name, sizeof(name));
+        at.read_int();
+        at.resp_stop();
+        at.unlock();
+    });
+    EXPECT_STREQ("Operator Name Long", name);
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+}
+
+TEST_F(BenchATHandler, urc_scan)
+{
+    // Every line of a response is matched against the URC prefixes
+    ModemFileHandle fh("\r\n+CGDCONT: 1,\"IP\",\"internet\"\r\n"
+                       "+CGDCONT: 2,\"IPV6\",\"ims\"\r\n"
+                       "+CGDCONT: 3,\"IPV4V6\",\"sos\"\r\n\r\nOK\r\n");
+    ATHandler at(&fh, queue, 1000, "\r");
+    at.set_debug(false);
+    static const char *const urcs[] = {
+        "+CEREG:", "+CGREG:", "+CREG:", "+CMTI:", "+CGEV:", "+CUSD:", "+CIEV:", "NO CARRIER"
+    };
+    for (unsigned i = 0; i < sizeof(urcs) / sizeof(urcs[0]); i++) {
+        at.set_urc_handler(urcs[i], urc_callback);
+    }
+
+    benchmark::run("athandler_urc_scan_3_lines", [&]() {
+        at.lock();
+        at.cmd_start_stop("+CGDCONT", "?");
+        at.resp_start("+CGDCONT:");
+        while (at.info_resp()) {
+            at.skip_param(3);
+        }
+        at.resp_stop();
+        at.unlock();
+    });
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "LoRaMacCrypto.h"
+#include <string.h>
+
+/* The per frame crypto of LoRaMac::prepare_frame: FRMPayload encryption and
+ * the MIC over the whole frame, at the largest EU868 payload.
+ */
+
+#define BENCH_PAYLOAD_SIZE  222
+#define BENCH_HEADER_SIZE   9
+
+static const uint8_t nwk_skey[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const uint8_t app_skey[16] = {
+    0x3c, 0x4f, 0xcf, 0x09, 0x88, 0x15, 0xf7, 0xab, 0xa6, 0xd2, 0xae, 0x28, 0x16, 0x15, 0x7e, 0x2b
+};
+static const uint32_t dev_addr = 0x26011bda;
+
+class BenchLoRaMacCrypto : public testing::Test {
+protected:
+    LoRaMacCrypto crypto;
+    uint8_t payload[BENCH_PAYLOAD_SIZE];
+    uint8_t frame[BENCH_HEADER_SIZE + BENCH_PAYLOAD_SIZE + 4];
+
+    virtual void SetUp()
+    {
+        for (unsigned i = 0; i < sizeof(payload); i++) {
+            payload[i] = i;
+        }
+        memset(frame, 0, sizeof(frame));
+    }
+};
+
+TEST_F(BenchLoRaMacCrypto, encrypt_payload)
+{
+    uint32_t fcnt = 0;
+    int result = 0;
+
+    benchmark::run("loramac_encrypt_222", [&]() {
+        result |= crypto.encrypt_payload(payload, sizeof(payload), app_skey, 128, dev_addr, 0, fcnt++,
+                                         frame + BENCH_HEADER_SIZE);
+    });
+    EXPECT_EQ(0, result);
+}
+
+TEST_F(BenchLoRaMacCrypto, compute_mic)
+{
+    uint32_t fcnt = 0;
+    uint32_t mic;
+    int result = 0;
+
+    benchmark::run("loramac_mic_231", [&]() {
+        result |= crypto.compute_mic(frame, BENCH_HEADER_SIZE + BENCH_PAYLOAD_SIZE, nwk_skey, 128, dev_addr, 0,
+                                     fcnt++, &mic);
+        benchmark::do_not_optimize(mic);
+    });
+    EXPECT_EQ(0, result);
+}
+
+TEST_F(BenchLoRaMacCrypto, uplink_frame)
+{
+    uint32_t fcnt = 0;
+    int result = 0;
+
+    // MHDR, FHDR and FPort, then the encrypted payload and the MIC after it
+    benchmark::run("loramac_uplink_frame_222", [&]() {
+        uint32_t mic;
+        frame[0] = 0x40;
+        memcpy(frame + 1, &dev_addr, sizeof(dev_addr));
+        frame[5] = 0;
+        frame[6] = fcnt & 0xff;
+        frame[7] = (fcnt >> 8) & 0xff;
+        frame[8] = 1;
+        result |= crypto.encrypt_payload(payload, sizeof(payload), app_skey, 128, dev_addr, 0, fcnt,
+                                         frame + BENCH_HEADER_SIZE);
+        result |= crypto.compute_mic(frame, BENCH_HEADER_SIZE + BENCH_PAYLOAD_SIZE, nwk_skey, 128, dev_addr, 0,
+                                     fcnt, &mic);
+        memcpy(frame + BENCH_HEADER_SIZE + BENCH_PAYLOAD_SIZE, &mic, sizeof(mic));
+        fcnt++;
+    });
+    EXPECT_EQ(0, result);
+}
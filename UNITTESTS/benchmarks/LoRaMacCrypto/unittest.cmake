@@ -0,0 +1,34 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(unittest-includes ${unittest-includes}
+  benchmarks
+  target_h
+  ../features/lorawan/lorastack/mac
+)
+
+# Real mbedtls with the default configuration, where the unit tests link stubs
+set(unittest-sources
+  ../features/lorawan/lorastack/mac/LoRaMacCrypto.cpp
+  ../features/mbedtls/mbed-crypto/src/aes.c
+  ../features/mbedtls/mbed-crypto/src/ccm.c
+  ../features/mbedtls/mbed-crypto/src/chacha20.c
+  ../features/mbedtls/mbed-crypto/src/chachapoly.c
+  ../features/mbedtls/mbed-crypto/src/cipher.c
+  ../features/mbedtls/mbed-crypto/src/cipher_wrap.c
+  ../features/mbedtls/mbed-crypto/src/cmac.c
+  ../features/mbedtls/mbed-crypto/src/gcm.c
+  ../features/mbedtls/mbed-crypto/src/platform.c
+  ../features/mbedtls/mbed-crypto/src/platform_util.c
+  ../features/mbedtls/mbed-crypto/src/poly1305.c
+)
+
+set(unittest-test-sources
+  benchmarks/LoRaMacCrypto/bench_LoRaMacCrypto.cpp
+  stubs/mbed_assert_stub.c
+)
+
+set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DMBED_CONF_LORA_TX_MAX_SIZE=255")
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DMBED_CONF_LORA_TX_MAX_SIZE=255")
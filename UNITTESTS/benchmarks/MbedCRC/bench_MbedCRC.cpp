@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "drivers/MbedCRC.h"
+
+using namespace mbed;
+
+class BenchMbedCRC : public testing::Test {
+protected:
+    uint8_t data[1024];
+
+    virtual void SetUp()
+    {
+        for (size_t i = 0; i < sizeof(data); i++) {
+            data[i] = i * 7;
+        }
+    }
+};
+
+TEST_F(BenchMbedCRC, crc32_1k)
+{
+    MbedCRC<POLY_32BIT_ANSI, 32> crc;
+    uint32_t result;
+
+    benchmark::run("crc32_1k", [&]() {
+        crc.compute(data, sizeof(data), &result);
+        benchmark::do_not_optimize(result);
+    });
+    EXPECT_NE(0U, result);
+}
+
+TEST_F(BenchMbedCRC, crc32_partial_64)
+{
+    MbedCRC<POLY_32BIT_ANSI, 32> crc;
+    uint32_t result;
+
+    benchmark::run("crc32_partial_64", [&]() {
+        crc.compute_partial_start(&result);
+        for (size_t i = 0; i < sizeof(data); i += 64) {
+            crc.compute_partial(data + i, 64, &result);
+        }
+        crc.compute_partial_stop(&result);
+        benchmark::do_not_optimize(result);
+    });
+}
+
+TEST_F(BenchMbedCRC, crc16_ccitt_1k)
+{
+    MbedCRC<POLY_16BIT_CCITT, 16> crc;
+    uint32_t result;
+
+    benchmark::run("crc16_ccitt_1k", [&]() {
+        crc.compute(data, sizeof(data), &result);
+        benchmark::do_not_optimize(result);
+    });
+}
+
+TEST_F(BenchMbedCRC, crc7_sd_512)
+{
+    MbedCRC<POLY_7BIT_SD, 7> crc;
+    uint32_t result;
+
+    benchmark::run("crc7_sd_512", [&]() {
+        crc.compute(data, 512, &result);
+        benchmark::do_not_optimize(result);
+    });
+}
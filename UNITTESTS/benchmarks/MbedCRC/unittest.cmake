@@ -0,0 +1,20 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(unittest-includes ${unittest-includes}
+  benchmarks
+)
+
+set(unittest-sources
+  ../drivers/MbedCRC.cpp
+  ../drivers/TableCRC.cpp
+)
+
+set(unittest-test-sources
+  benchmarks/MbedCRC/bench_MbedCRC.cpp
+  stubs/Mutex_stub.cpp
+  stubs/mbed_assert_stub.c
+  stubs/mbed_critical_stub.c
+)
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "TDBStore.h"
+#include "HeapBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "mbed_error.h"
+#include <stdio.h>
+
+using namespace mbed;
+
+#define BENCH_KEYS      64
+#define BENCH_DATA_SIZE 32
+
+class BenchTDBStore : public testing::Test {
+protected:
+    HeapBlockDevice heap{64 * 1024, 1, 1, 4096};
+    FlashSimBlockDevice flash{&heap};
+    TDBStore *tdb;
+    uint8_t data[BENCH_DATA_SIZE];
+    char keys[BENCH_KEYS][16];
+
+    virtual void SetUp()
+    {
+        tdb = new TDBStore(&flash);
+        ASSERT_EQ(MBED_SUCCESS, tdb->init());
+        ASSERT_EQ(MBED_SUCCESS, tdb->reset());
+        memset(data, 0x5a, sizeof(data));
+        for (int i = 0; i < BENCH_KEYS; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "key_%d", i);
+            ASSERT_EQ(MBED_SUCCESS, tdb->set(keys[i], data, sizeof(data), 0));
+        }
+    }
+
+    virtual void TearDown()
+    {
+        tdb->deinit();
+        delete tdb;
+    }
+};
+
+TEST_F(BenchTDBStore, get)
+{
+    uint8_t buf[BENCH_DATA_SIZE];
+    size_t actual_size;
+    int i = 0;
+
+    benchmark::run("tdbstore_get_64_keys", [&]() {
+        tdb->get(keys[i++ % BENCH_KEYS], buf, sizeof(buf), &actual_size);
+    });
+    EXPECT_EQ(sizeof(buf), actual_size);
+}
+
+TEST_F(BenchTDBStore, set_overwrite)
+{
+    int i = 0;
+    int result = MBED_SUCCESS;
+
+    // Includes the garbage collections the overwrites cause
+    benchmark::run("tdbstore_set_overwrite_64_keys", [&]() {
+        data[0] = i;
+        if (tdb->set(keys[i++ % BENCH_KEYS], data, sizeof(data), 0) != MBED_SUCCESS) {
+            result = MBED_ERROR_WRITE_FAILED;
+        }
+    });
+    EXPECT_EQ(MBED_SUCCESS, result);
+}
+
+TEST_F(BenchTDBStore, get_info_missing)
+{
+    KVStore::info_t info;
+
+    benchmark::run("tdbstore_get_info_missing", [&]() {
+        benchmark::do_not_optimize(tdb->get_info("no_such_key", &info));
+    });
+}
+
+TEST_F(BenchTDBStore, init)
+{
+    // Mount, which rebuilds the RAM table from the records on flash
+    benchmark::run("tdbstore_init_64_keys", [&]() {
+        tdb->deinit();
+        tdb->init();
+    });
+}
@@ -0,0 +1,32 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(unittest-includes ${unittest-includes}
+  benchmarks
+  ../features/storage/blockdevice
+  ../features/storage/kvstore/include
+  ../features/storage/kvstore/tdbstore
+  ../features/storage/system_storage
+)
+
+set(unittest-sources
+  ../features/storage/kvstore/tdbstore/TDBStore.cpp
+  ../features/storage/blockdevice/HeapBlockDevice.cpp
+  ../features/storage/blockdevice/FlashSimBlockDevice.cpp
+  ../features/storage/blockdevice/BufferedBlockDevice.cpp
+  ../drivers/MbedCRC.cpp
+  ../drivers/TableCRC.cpp
+)
+
+set(unittest-test-sources
+  benchmarks/TDBStore/bench_TDBStore.cpp
+  stubs/Mutex_stub.cpp
+  stubs/mbed_assert_stub.c
+  benchmarks/mbed_atomic_host.c
+  stubs/mbed_critical_stub.c
+  stubs/mbed_error.c
+  stubs/mbed_wait_api_stub.cpp
+  stubs/SystemStorage_stub.cpp
+)
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UNITTESTS_BENCHMARK_H
+#define UNITTESTS_BENCHMARK_H
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include "gtest/gtest.h"
+
+/* Host microbenchmarks, run by gtest like the unit tests.
+ *
+ * Each benchmark body is run in batches of growing size until a batch takes
+ * at least the minimum time, 200 ms by default or MBED_BENCHMARK_MIN_TIME_MS
+ * from the environment. The time per iteration of the last batch is printed
+ * and recorded as a test property, which ends up in the XML report with
+ * --gtest_output=xml so results can be tracked between builds.
+ *
+ * @code
+ * TEST_F(BenchMbedCRC, crc32_1k)
+ * {
+ *     benchmark::run("crc32_1k", [&]() {
+ *         crc.compute(data, sizeof(data), &result);
+ *         benchmark::do_not_optimize(result);
+ *     });
+ * }
+ * @endcode
+ */
+
+namespace benchmark {
+
+/** Prevent the compiler from optimising away a computed value */
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/** Run body repeatedly and report the time per iteration, in ns */
+template <typename F>
+double run(const char *name, F body)
+{
+    typedef std::chrono::steady_clock clock;
+
+    const char *env = getenv("MBED_BENCHMARK_MIN_TIME_MS");
+    const long min_time_ns = (env ? atol(env) : 200) * 1000000L;
+
+    unsigned long iterations = 1;
+    long elapsed_ns;
+
+    while (true) {
+        clock::time_point start = clock::now();
+        for (unsigned long i = 0; i < iterations; i++) {
+            body();
+        }
+        elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+        if (elapsed_ns >= min_time_ns || iterations >= (1UL << 30)) {
+            break;
+        }
+        // Aim past the minimum time on the next batch, growing at most 10x
+        unsigned long next = elapsed_ns > 0 ? (iterations * (min_time_ns * 14 / 10)) / elapsed_ns : iterations * 10;
+        iterations = next > iterations * 10 ? iterations * 10 : (next > iterations ? next : iterations + 1);
+    }
+
+    double ns_per_iteration = (double)elapsed_ns / iterations;
+    printf("[ BENCH    ] %s: %.1f ns/iteration (%lu iterations)\n", name, ns_per_iteration, iterations);
+    ::testing::Test::RecordProperty("ns_per_iteration", (int)(ns_per_iteration + 0.5));
+    return ns_per_iteration;
+}
+
+} // namespace benchmark
+
+#endif // UNITTESTS_BENCHMARK_H
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "equeue/equeue.h"
+
+static void count_cb(void *p)
+{
+    (*(unsigned *)p)++;
+}
+
+// Event allocated with equeue_alloc, holding a pointer to the counter
+static void count_event_cb(void *p)
+{
+    count_cb(*(unsigned **)p);
+}
+
+class BenchEqueue : public testing::Test {
+protected:
+    equeue_t q;
+    unsigned count;
+
+    virtual void SetUp()
+    {
+        ASSERT_EQ(0, equeue_create(&q, 32 * EQUEUE_EVENT_SIZE));
+        count = 0;
+    }
+
+    virtual void TearDown()
+    {
+        equeue_destroy(&q);
+    }
+};
+
+TEST_F(BenchEqueue, call_dispatch)
+{
+    benchmark::run("equeue_call_dispatch", [&]() {
+        equeue_call(&q, count_cb, &count);
+        equeue_dispatch(&q, 0);
+    });
+    EXPECT_NE(0U, count);
+}
+
+TEST_F(BenchEqueue, alloc_post_dispatch_16)
+{
+    benchmark::run("equeue_alloc_post_dispatch_16", [&]() {
+        for (int i = 0; i < 16; i++) {
+            unsigned **e = (unsigned **)equeue_alloc(&q, sizeof(unsigned *));
+            *e = &count;
+            equeue_post(&q, count_event_cb, e);
+        }
+        equeue_dispatch(&q, 0);
+    });
+    EXPECT_NE(0U, count);
+}
+
+TEST_F(BenchEqueue, call_in_cancel)
+{
+    benchmark::run("equeue_call_in_cancel", [&]() {
+        int id = equeue_call_in(&q, 1000, count_cb, &count);
+        equeue_cancel(&q, id);
+    });
+    EXPECT_EQ(0U, count);
+}
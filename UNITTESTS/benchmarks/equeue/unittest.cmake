@@ -0,0 +1,20 @@
+
+####################
+# BENCHMARKS
+####################
+
+# The real POSIX port of equeue, ahead of the stubbed platform header
+set(unittest-includes
+  ../events
+  ${unittest-includes}
+  benchmarks
+)
+
+set(unittest-sources
+  ../events/equeue/equeue.c
+  ../events/equeue/equeue_posix.c
+)
+
+set(unittest-test-sources
+  benchmarks/equeue/bench_equeue.cpp
+)
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "netsocket/NetworkStack.h"
+#include "nsapi_dns.h"
+#include <string.h>
+
+/* Stack whose DNS server answers every query at once with the same
+ * response, so a query costs building the question, the socket calls and
+ * decoding the answer.
+ */
+class DnsResponderStack : public NetworkStack {
+public:
+    DnsResponderStack(const uint8_t *response, nsapi_size_t size) : _response(response), _size(size)
+    {
+    }
+
+    virtual const char *get_ip_address()
+    {
+        return "10.0.0.2";
+    }
+
+protected:
+    virtual nsapi_error_t socket_open(nsapi_socket_t *handle, nsapi_protocol_t proto)
+    {
+        *handle = this;
+        return NSAPI_ERROR_OK;
+    }
+    virtual nsapi_error_t socket_close(nsapi_socket_t handle)
+    {
+        return NSAPI_ERROR_OK;
+    }
+    virtual nsapi_error_t socket_bind(nsapi_socket_t handle, const SocketAddress &address)
+    {
+        return NSAPI_ERROR_OK;
+    }
+    virtual nsapi_error_t socket_listen(nsapi_socket_t handle, int backlog)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    virtual nsapi_error_t socket_connect(nsapi_socket_t handle, const SocketAddress &address)
+    {
+        return NSAPI_ERROR_OK;
+    }
+    virtual nsapi_error_t socket_accept(nsapi_socket_t server, nsapi_socket_t *handle, SocketAddress *address = 0)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    virtual nsapi_size_or_error_t socket_send(nsapi_socket_t handle, const void *data, nsapi_size_t size)
+    {
+        return size;
+    }
+    virtual nsapi_size_or_error_t socket_recv(nsapi_socket_t handle, void *data, nsapi_size_t size)
+    {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+    virtual nsapi_size_or_error_t socket_sendto(nsapi_socket_t handle, const SocketAddress &address,
+                                                const void *data, nsapi_size_t size)
+    {
+        return size;
+    }
+    virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
+                                                  void *buffer, nsapi_size_t size)
+    {
+        nsapi_size_t len = _size < size ? _size : size;
+        memcpy(buffer, _response, len);
+        return len;
+    }
+    virtual void socket_attach(nsapi_socket_t handle, void (*callback)(void *), void *data)
+    {
+    }
+
+private:
+    const uint8_t *_response;
+    nsapi_size_t _size;
+};
+
+// Answer to query id 1 for "www.example.com": a CNAME and four A records
+static const uint8_t dns_response[] = {
+    0x00, 0x01, 0x81, 0x80, 0x00, 0x01, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00,
+    // Question
+    0x03, 'w', 'w', 'w', 0x07, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 0x03, 'c', 'o', 'm', 0x00,
+    0x00, 0x01, 0x00, 0x01,
+    // www.example.com CNAME edge.example.net
+    0xc0, 0x0c, 0x00, 0x05, 0x00, 0x01, 0x00, 0x00, 0x0e, 0x10, 0x00, 0x12,
+    0x04, 'e', 'd', 'g', 'e', 0x07, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 0x03, 'n', 'e', 't', 0x00,
+    // edge.example.net A x4
+    0xc0, 0x2d, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x04, 93, 184, 216, 34,
+    0xc0, 0x2d, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x04, 93, 184, 216, 35,
+    0xc0, 0x2d, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x04, 93, 184, 216, 36,
+    0xc0, 0x2d, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x04, 93, 184, 216, 37,
+};
+
+TEST(BenchNsapiDns, query)
+{
+    DnsResponderStack stack(dns_response, sizeof(dns_response));
+    SocketAddress addr;
+    nsapi_error_t result = NSAPI_ERROR_OK;
+
+    benchmark::run("nsapi_dns_query_a", [&]() {
+        nsapi_error_t err = nsapi_dns_query(&stack, "www.example.com", &addr, NULL, NSAPI_IPv4);
+        if (err != NSAPI_ERROR_OK) {
+            result = err;
+        }
+    });
+    EXPECT_EQ(NSAPI_ERROR_OK, result);
+    EXPECT_STREQ("93.184.216.34", addr.get_ip_address());
+}
+
+TEST(BenchNsapiDns, query_multiple)
+{
+    DnsResponderStack stack(dns_response, sizeof(dns_response));
+    SocketAddress addr[4];
+    nsapi_size_or_error_t count = 0;
+
+    benchmark::run("nsapi_dns_query_multiple_4_a", [&]() {
+        count = nsapi_dns_query_multiple(&stack, "www.example.com", addr, 4, NULL, NSAPI_IPv4);
+    });
+    EXPECT_EQ(4, count);
+    EXPECT_STREQ("93.184.216.37", addr[3].get_ip_address());
+}
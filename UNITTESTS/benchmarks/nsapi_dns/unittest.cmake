@@ -0,0 +1,41 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(unittest-includes ${unittest-includes}
+  benchmarks
+)
+
+set(unittest-sources
+  ../features/netsocket/nsapi_dns.cpp
+  ../features/netsocket/SocketAddress.cpp
+  ../features/netsocket/NetworkStack.cpp
+  ../features/netsocket/InternetSocket.cpp
+  ../features/netsocket/SocketSet.cpp
+  ../features/netsocket/UDPSocket.cpp
+  ../features/netsocket/NetStackBuffer.cpp
+  ../features/frameworks/nanostack-libservice/source/libip4string/ip4tos.c
+  ../features/frameworks/nanostack-libservice/source/libip6string/ip6tos.c
+  ../features/frameworks/nanostack-libservice/source/libip4string/stoip4.c
+  ../features/frameworks/nanostack-libservice/source/libip6string/stoip6.c
+  ../features/frameworks/nanostack-libservice/source/libBits/common_functions.c
+)
+
+set(unittest-test-sources
+  benchmarks/nsapi_dns/bench_nsapi_dns.cpp
+  stubs/Mutex_stub.cpp
+  stubs/mbed_assert_stub.c
+  stubs/mbed_atomic_stub.c
+  stubs/mbed_critical_stub.c
+  stubs/equeue_stub.c
+  stubs/EventQueue_stub.cpp
+  stubs/mbed_error.c
+  stubs/mbed_shared_queues_stub.cpp
+  stubs/EventFlags_stub.cpp
+  stubs/Kernel_stub.cpp
+  stubs/SocketStats_Stub.cpp
+)
+
+# No cache, so every query decodes a response
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DMBED_CONF_NSAPI_DNS_CACHE_SIZE=0 -DMBED_CONF_NSAPI_DNS_RESPONSE_WAIT_TIME=5000 -DMBED_CONF_NSAPI_DNS_RETRIES=0 -DMBED_CONF_NSAPI_DNS_TOTAL_ATTEMPTS=1")
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "drivers/UARTSerial.h"
+#include <deque>
+
+using namespace mbed;
+
+/* Fake UART behaving like a DMA target: characters are moved into the buffer
+ * of the ongoing transfer, but the count is only updated on completion, or
+ * latched on abort if the target reports it. */
+struct FakeUart {
+    std::deque<uint8_t> line;
+    uint8_t *buffer = nullptr;
+    size_t length = 0;
+    size_t moved = 0;
+    int pos = 0;
+    bool reports_received = true;
+    event_callback_t callback;
+};
+
+static FakeUart uart;
+
+/* Move the characters on the line into the ongoing transfers, completing them */
+static void uart_service()
+{
+    while (uart.callback && !uart.line.empty()) {
+        uart.buffer[uart.moved++] = uart.line.front();
+        uart.line.pop_front();
+        if (uart.moved == uart.length) {
+            uart.pos = uart.length;
+            event_callback_t callback = uart.callback;
+            uart.callback = nullptr;
+            callback.call(SERIAL_EVENT_RX_COMPLETE);
+        }
+    }
+}
+
+int serial_rx_asynch_received(serial_t *obj)
+{
+    return uart.reports_received ? uart.pos : -1;
+}
+
+namespace mbed {
+
+SerialBase::SerialBase(PinName tx, PinName rx, int baud) : _thunk_irq(this), _baud(baud)
+{
+}
+
+SerialBase::~SerialBase()
+{
+}
+
+void SerialBase::baud(int baudrate)
+{
+    _baud = baudrate;
+}
+
+void SerialBase::format(int bits, Parity parity, int stop_bits)
+{
+}
+
+int SerialBase::readable()
+{
+    return 0;
+}
+
+int SerialBase::writeable()
+{
+    return 0;
+}
+
+void SerialBase::attach(Callback<void()> func, IrqType type)
+{
+}
+
+int SerialBase::_base_getc()
+{
+    return 0;
+}
+
+int SerialBase::_base_putc(int c)
+{
+    return 0;
+}
+
+void SerialBase::lock()
+{
+}
+
+void SerialBase::unlock()
+{
+}
+
+int SerialBase::write(const uint8_t *buffer, int length, const event_callback_t &callback, int event)
+{
+    return 0;
+}
+
+void SerialBase::abort_write()
+{
+}
+
+int SerialBase::read(uint8_t *buffer, int length, const event_callback_t &callback, int event, unsigned char char_match)
+{
+    uart.buffer = buffer;
+    uart.length = length;
+    uart.moved = 0;
+    uart.pos = 0;
+    uart.callback = callback;
+    return 0;
+}
+
+void SerialBase::abort_read()
+{
+    if (uart.callback && uart.reports_received) {
+        uart.pos = uart.moved;
+    }
+    uart.callback = nullptr;
+}
+
+int SerialBase::set_dma_usage_tx(DMAUsage usage)
+{
+    return 0;
+}
+
+int SerialBase::set_dma_usage_rx(DMAUsage usage)
+{
+    return 0;
+}
+
+InterruptIn::InterruptIn(PinName pin)
+{
+}
+
+InterruptIn::~InterruptIn()
+{
+}
+
+int InterruptIn::read()
+{
+    return 0;
+}
+
+void InterruptIn::rise(Callback<void()> func)
+{
+}
+
+void InterruptIn::fall(Callback<void()> func)
+{
+}
+
+void Timeout::handler()
+{
+}
+
+} // namespace mbed
+
+class TestUARTSerial : public testing::Test {
+protected:
+    UARTSerial *serial;
+
+    void SetUp()
+    {
+        uart = FakeUart();
+        serial = new UARTSerial(PTC0, PTC1, 115200);
+        serial->set_blocking(false);
+    }
+
+    void TearDown()
+    {
+        delete serial;
+    }
+
+    void send(const char *data)
+    {
+        uart.line.insert(uart.line.end(), data, data + strlen(data));
+        uart_service();
+    }
+
+    /* Let the chunk time elapse */
+    bool flush()
+    {
+        Ticker *flush_timeout = Ticker::last_attached();
+        return flush_timeout && flush_timeout->fire();
+    }
+};
+
+TEST_F(TestUARTSerial, asynch_burst_shorter_than_chunk)
+{
+    char buffer[MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE] = {};
+
+    EXPECT_EQ(0, serial->set_asynch(true));
+    EXPECT_EQ(1, uart.length);
+
+    send("hello");
+    EXPECT_EQ(MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE, uart.length);
+    EXPECT_TRUE(flush());
+    EXPECT_EQ(5, serial->read(buffer, sizeof buffer));
+    EXPECT_STREQ("hello", buffer);
+
+    // nothing received in a chunk time, back to waiting for line activity
+    EXPECT_TRUE(flush());
+    EXPECT_EQ(1, uart.length);
+    EXPECT_FALSE(flush());
+    EXPECT_EQ(-EAGAIN, serial->read(buffer, sizeof buffer));
+}
+
+TEST_F(TestUARTSerial, asynch_burst_shorter_than_chunk_without_received_count)
+{
+    char buffer[MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE] = {};
+    uart.reports_received = false;
+
+    EXPECT_EQ(0, serial->set_asynch(true));
+
+    // chunks can't be cut short, so the transfers stay one character long
+    send("hello");
+    EXPECT_EQ(1, uart.length);
+    EXPECT_FALSE(flush());
+    EXPECT_EQ(5, serial->read(buffer, sizeof buffer));
+    EXPECT_STREQ("hello", buffer);
+}
+
+TEST_F(TestUARTSerial, asynch_disable_keeps_received)
+{
+    char buffer[MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE] = {};
+
+    EXPECT_EQ(0, serial->set_asynch(true));
+    send("hello");
+    EXPECT_EQ(0, serial->set_asynch(false));
+    EXPECT_FALSE(flush());
+    EXPECT_EQ(5, serial->read(buffer, sizeof buffer));
+    EXPECT_STREQ("hello", buffer);
+}
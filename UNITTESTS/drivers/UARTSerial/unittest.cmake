@@ -0,0 +1,33 @@
+
+####################
+# UNIT TESTS
+####################
+set(TEST_SUITE_NAME "UARTSerial")
+
+# Add test specific include paths
+set(unittest-includes ${unittest-includes}
+  .
+  ../hal
+)
+
+# Source files
+set(unittest-sources
+  ../drivers/UARTSerial.cpp
+  ../platform/CThunkBase.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  drivers/UARTSerial/test_UARTSerial.cpp
+  stubs/FileHandle_stub.cpp
+  stubs/mbed_critical_stub.c
+  stubs/mbed_assert_stub.c
+  stubs/mbed_error.c
+  stubs/mbed_poll_stub.cpp
+  stubs/mbed_wait_api_stub.cpp
+)
+
+# Only these sources see the serial device, the stubs are shared with other suites
+set(UARTSERIAL_DEFINITIONS "DEVICE_SERIAL=1;DEVICE_INTERRUPTIN=1;DEVICE_SERIAL_ASYNCH=1;MBED_CONF_PLATFORM_CTHUNK_COUNT_MAX=8;MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE=115200")
+set_source_files_properties(drivers/UARTSerial/test_UARTSerial.cpp PROPERTIES COMPILE_DEFINITIONS "${UARTSERIAL_DEFINITIONS}")
+set_source_files_properties(../drivers/UARTSerial.cpp ../platform/CThunkBase.cpp PROPERTIES COMPILE_DEFINITIONS "${UARTSERIAL_DEFINITIONS}")
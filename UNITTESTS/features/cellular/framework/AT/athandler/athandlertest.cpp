@@ -451,6 +451,58 @@ TEST_F(TestATHandler, test_ATHandler_write_bytes)
     EXPECT_TRUE(NSAPI_ERROR_DEVICE_ERROR == at.get_last_error());
 }
 
+TEST_F(TestATHandler, test_ATHandler_write_bytes_at_prompt)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+    uint8_t data[] = "data";
+
+    ATHandler at(&fh1, que, 0, ",");
+    char table[] = "> ";
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN | POLLOUT;
+    mbed_poll_stub::int_value = 1;
+    fh1.size_value = 1;
+    EXPECT_EQ(4, at.write_bytes_at_prompt(">", data, 4));
+    EXPECT_TRUE(NSAPI_ERROR_OK == at.get_last_error());
+
+    // no prompt, nothing is written
+    at.flush();
+    at.clear_error();
+    char table2[] = "ERROR\r\n";
+    filehandle_stub_table = table2;
+    filehandle_stub_table_pos = 0;
+    fh1.size_value = 1;
+    EXPECT_EQ(0, at.write_bytes_at_prompt(">", data, 4));
+    EXPECT_TRUE(NSAPI_ERROR_DEVICE_ERROR == at.get_last_error());
+
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+}
+
+TEST_F(TestATHandler, test_ATHandler_write_hex_string)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+    uint8_t data[100];
+    memset(data, 0xA5, sizeof(data));
+
+    ATHandler at(&fh1, que, 0, ",");
+    mbed_poll_stub::revents_value = POLLOUT;
+    mbed_poll_stub::int_value = 1;
+    fh1.size_value = 4;
+    at.cmd_start("s");
+    at.write_hex_string(data, sizeof(data));
+    EXPECT_TRUE(NSAPI_ERROR_OK == at.get_last_error());
+
+    at.clear_error();
+    fh1.size_value = -1;
+    at.cmd_start("s");
+    at.write_hex_string(data, sizeof(data), true);
+    EXPECT_TRUE(NSAPI_ERROR_DEVICE_ERROR == at.get_last_error());
+}
+
 TEST_F(TestATHandler, test_ATHandler_set_stop_tag)
 {
     EventQueue que;
@@ -552,7 +604,7 @@ TEST_F(TestATHandler, test_ATHandler_read_bytes)
     filehandle_stub_table_pos = 0;
 
     ATHandler at(&fh1, que, 0, ",");
-    uint8_t buf[5];
+    uint8_t buf[8];
 
     // TEST EMPTY BUFFER
     // Shouldn't read any byte since buffer is empty
@@ -581,6 +633,41 @@ TEST_F(TestATHandler, test_ATHandler_read_bytes)
     EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, at.get_last_error());
 }
 
+TEST_F(TestATHandler, test_ATHandler_read_bytes_bulk)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    uint8_t buf[MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE + 8];
+
+    char table[MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE * 2 + 1];
+    for (size_t i = 0; i < sizeof(table) - 1; i++) {
+        table[i] = 'a' + i % 26;
+    }
+    table[sizeof(table) - 1] = '\0';
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+
+    // Bulk read goes straight from the file handle and doesn't fill the receive buffer
+    EXPECT_EQ(sizeof(buf), at.read_bytes(buf, sizeof(buf)));
+    EXPECT_TRUE(!memcmp(buf, table, sizeof(buf)));
+    EXPECT_EQ(filehandle_stub_table_pos, sizeof(buf));
+
+    // Short read fills the receive buffer, next bulk read starts from what is buffered
+    EXPECT_EQ(1, at.read_bytes(buf, 1));
+    EXPECT_EQ(table[sizeof(buf)], buf[0]);
+    size_t left = strlen(table) - sizeof(buf) - 1;
+    EXPECT_EQ(left, at.read_bytes(buf, left));
+    EXPECT_TRUE(!memcmp(buf, table + sizeof(buf) + 1, left));
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+}
+
 TEST_F(TestATHandler, test_ATHandler_read_string)
 {
     EventQueue que;
@@ -909,6 +996,56 @@ TEST_F(TestATHandler, test_ATHandler_read_hex_string)
     EXPECT_TRUE(!strncmp(buf4, "h", 1));
 }
 
+TEST_F(TestATHandler, test_ATHandler_read_hex_string_bulk)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+
+    ATHandler at(&fh1, que, 0, ",");
+    char buf[MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE * 2];
+    char resp[sizeof(buf) + 1];
+    memset(resp, 'a', sizeof(buf));
+    resp[sizeof(buf)] = '\0';
+    CellularUtil_stub::char_ptr = resp;
+
+    // *** Payload larger than the receive buffer is read straight into caller memory ***
+    char table1[sizeof(buf) * 2 + 6];
+    memset(table1, '6', sizeof(buf) * 2);
+    strcpy(table1 + sizeof(buf) * 2, "OK\r\n");
+    at.clear_error();
+    at.flush();
+    filehandle_stub_table = table1;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+    // Set _stop_tag to resp_stop(OKCRLF)
+    at.resp_start();
+    CellularUtil_stub::char_pos = 0;
+    EXPECT_EQ(sizeof(buf), at.read_hex_string(buf, sizeof(buf)));
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+    at.resp_stop();
+    EXPECT_EQ(filehandle_stub_table_pos, strlen(table1));
+
+    // *** Stop tag within a direct read is parsed from the receive buffer ***
+    size_t hex_len = sizeof(buf) * 2 - 38;
+    char table2[sizeof(buf) * 2 + 6];
+    memset(table2, '6', hex_len);
+    strcpy(table2 + hex_len, "OK\r\n");
+    at.clear_error();
+    at.flush();
+    filehandle_stub_table = table2;
+    filehandle_stub_table_pos = 0;
+    at.resp_start();
+    CellularUtil_stub::char_pos = 0;
+    EXPECT_EQ(hex_len / 2, at.read_hex_string(buf, sizeof(buf)));
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+}
+
 TEST_F(TestATHandler, test_ATHandler_read_int)
 {
     EventQueue que;
@@ -1353,6 +1490,63 @@ TEST_F(TestATHandler, test_ATHandler_at_cmd_discard)
     EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, at.at_cmd_discard("+CREG", "=1,", "%d%s%b", 3, "test", byte, 4));
 }
 
+static int pipeline_resp[2];
+
+static void pipeline_parser(ATHandler &at)
+{
+    pipeline_resp[0] = at.read_int();
+}
+
+static void pipeline_parser2(ATHandler &at)
+{
+    pipeline_resp[1] = at.read_int();
+}
+
+TEST_F(TestATHandler, test_ATHandler_at_cmd_pipeline)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    const ATHandler::at_cmd_t cmds[] = {
+        { "+CMEE", "=1", NULL },
+        { "+CFUN", "?", pipeline_parser },
+        { "+CGATT", "?", pipeline_parser2 },
+    };
+
+    // Nothing written -> ERROR
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, at.at_cmd_pipeline(cmds, 3));
+
+    char table[] = "\r\n+CFUN: 1\r\n\r\n+CGATT: 0\r\n\r\nOK\r\n\0";
+    at.clear_error();
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN + POLLOUT;
+    mbed_poll_stub::int_value = 1;
+    fh1.size_value = 16;
+    pipeline_resp[0] = -1;
+    pipeline_resp[1] = -1;
+
+    // Concatenated on a single command line, responses parsed in order
+    EXPECT_EQ(NSAPI_ERROR_OK, at.at_cmd_pipeline(cmds, 3));
+    EXPECT_EQ(1, pipeline_resp[0]);
+    EXPECT_EQ(0, pipeline_resp[1]);
+    EXPECT_EQ(filehandle_stub_table_pos, strlen(table));
+
+    // One by one, each command reads its own final result
+    char table2[] = "\r\nOK\r\n\r\n+CFUN: 4\r\n\r\nOK\r\n\r\n+CGATT: 1\r\n\r\nOK\r\n\0";
+    filehandle_stub_table = table2;
+    filehandle_stub_table_pos = 0;
+    fh1.size_value = 32;
+    EXPECT_EQ(NSAPI_ERROR_OK, at.at_cmd_pipeline(cmds, 3, false));
+    EXPECT_EQ(4, pipeline_resp[0]);
+    EXPECT_EQ(1, pipeline_resp[1]);
+    EXPECT_EQ(filehandle_stub_table_pos, strlen(table2));
+
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+}
+
 TEST_F(TestATHandler, test_ATHandler_sync)
 {
     EventQueue que;
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include <string.h>
+#include <vector>
+#include "CellularMux.h"
+
+using namespace mbed;
+
+static uint8_t fcs_update(uint8_t fcs, uint8_t byte)
+{
+    fcs ^= byte;
+    for (int i = 0; i < 8; i++) {
+        fcs = (fcs & 1) ? (fcs >> 1) ^ 0xE0 : fcs >> 1;
+    }
+    return fcs;
+}
+
+static std::vector<uint8_t> frame(uint8_t address, uint8_t control, const char *data, size_t len)
+{
+    std::vector<uint8_t> f;
+    f.push_back(0xF9);
+    f.push_back(address);
+    f.push_back(control);
+    f.push_back((len << 1) | 1);
+    uint8_t fcs = 0xFF;
+    for (size_t i = 1; i < f.size(); i++) {
+        fcs = fcs_update(fcs, f[i]);
+    }
+    f.insert(f.end(), data, data + len);
+    f.push_back(0xFF - fcs);
+    f.push_back(0xF9);
+    return f;
+}
+
+// Modem end of the serial line, accepts every channel
+class FakeModem : public FileHandle {
+public:
+    FakeModem() : accept(true), cmux_reply("\r\nOK\r\n"), blocking(true) {}
+
+    virtual ssize_t read(void *buffer, size_t size)
+    {
+        if (rx.empty()) {
+            return -EAGAIN;
+        }
+        size_t len = size < rx.size() ? size : rx.size();
+        memcpy(buffer, &rx[0], len);
+        rx.erase(rx.begin(), rx.begin() + len);
+        return len;
+    }
+
+    virtual ssize_t write(const void *buffer, size_t size)
+    {
+        const uint8_t *data = (const uint8_t *)buffer;
+        tx.insert(tx.end(), data, data + size);
+        if (!strncmp((const char *)data, "AT+CMUX", 7)) {
+            rx.insert(rx.end(), cmux_reply, cmux_reply + strlen(cmux_reply));
+            tx.clear();
+            return size;
+        }
+        // Frames are written in pieces, answer once one is complete
+        while (tx.size() >= 6 && tx[0] == 0xF9 && tx.size() >= (size_t)(6 + (tx[3] >> 1))) {
+            size_t len = tx[3] >> 1;
+            uint8_t address = tx[1];
+            uint8_t control = tx[2] & ~0x10;
+            frames.push_back(std::vector<uint8_t>(tx.begin(), tx.begin() + 6 + len));
+            tx.erase(tx.begin(), tx.begin() + 6 + len);
+            if (control == 0x2F || control == 0x43) {
+                std::vector<uint8_t> ua = frame(address, (accept ? 0x63 : 0x0F) | 0x10, NULL, 0);
+                rx.insert(rx.end(), ua.begin(), ua.end());
+            } else if (control == 0xEF && (address >> 2) == 0 && len && frames.back()[4] == 0xC3) {
+                const char cld[] = { (char)0xC1, 0x01 };
+                std::vector<uint8_t> r = frame(0x03, 0xEF, cld, sizeof(cld));
+                rx.insert(rx.end(), r.begin(), r.end());
+            }
+        }
+        return size;
+    }
+
+    virtual off_t seek(off_t offset, int whence = SEEK_SET)
+    {
+        return -ESPIPE;
+    }
+
+    virtual int close()
+    {
+        return 0;
+    }
+
+    virtual int set_blocking(bool blocking)
+    {
+        this->blocking = blocking;
+        return 0;
+    }
+
+    virtual bool is_blocking() const
+    {
+        return blocking;
+    }
+
+    virtual short poll(short events) const
+    {
+        return POLLOUT | (rx.empty() ? 0 : POLLIN);
+    }
+
+    void receive(const std::vector<uint8_t> &data)
+    {
+        rx.insert(rx.end(), data.begin(), data.end());
+    }
+
+    bool accept;
+    const char *cmux_reply;
+    bool blocking;
+    std::vector<uint8_t> rx;
+    std::vector<uint8_t> tx;
+    std::vector<std::vector<uint8_t> > frames;
+};
+
+// AStyle ignored as the definition is not clear due to preprocessor usage
+// *INDENT-OFF*
+class TestCellularMux : public testing::Test {
+protected:
+
+    void SetUp()
+    {
+    }
+
+    void TearDown()
+    {
+    }
+};
+// *INDENT-ON*
+
+TEST_F(TestCellularMux, test_start_stop)
+{
+    FakeModem modem;
+    CellularMux mux(&modem);
+
+    EXPECT_TRUE(mux.open_channel(1) == NULL);
+    EXPECT_EQ(NSAPI_ERROR_OK, mux.start());
+    EXPECT_FALSE(modem.is_blocking());
+    ASSERT_EQ(1, modem.frames.size());
+    EXPECT_TRUE(modem.frames[0] == frame(0x03, 0x3F, NULL, 0));
+
+    EXPECT_EQ(NSAPI_ERROR_OK, mux.stop());
+    EXPECT_TRUE(modem.is_blocking());
+}
+
+TEST_F(TestCellularMux, test_start_error)
+{
+    FakeModem modem;
+    modem.cmux_reply = "\r\nERROR\r\n";
+    CellularMux mux(&modem);
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, mux.start());
+
+    modem.cmux_reply = "";
+    EXPECT_EQ(NSAPI_ERROR_TIMEOUT, mux.start());
+
+    modem.accept = false;
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, mux.start(false));
+}
+
+TEST_F(TestCellularMux, test_open_write)
+{
+    FakeModem modem;
+    CellularMux mux(&modem);
+    ASSERT_EQ(NSAPI_ERROR_OK, mux.start(false));
+
+    FileHandle *ch = mux.open_channel(2);
+    ASSERT_TRUE(ch != NULL);
+    EXPECT_TRUE(mux.open_channel(2) == NULL);
+    EXPECT_TRUE(mux.open_channel(64) == NULL);
+
+    modem.frames.clear();
+    EXPECT_EQ(4, ch->write("AT\r\n", 4));
+    ASSERT_EQ(1, modem.frames.size());
+    EXPECT_TRUE(modem.frames[0] == frame(0x0B, 0xEF, "AT\r\n", 4));
+
+    // Longer writes are split into frames of the maximum size
+    char data[MBED_CONF_CELLULAR_MUX_FRAME_SIZE + 10];
+    memset(data, 'x', sizeof(data));
+    modem.frames.clear();
+    EXPECT_EQ(sizeof(data), ch->write(data, sizeof(data)));
+    ASSERT_EQ(2, modem.frames.size());
+    EXPECT_TRUE(modem.frames[1] == frame(0x0B, 0xEF, data, 10));
+
+    EXPECT_EQ(0, ch->close());
+    EXPECT_EQ(-EPIPE, ch->write("AT\r\n", 4));
+
+    modem.accept = false;
+    EXPECT_TRUE(mux.open_channel(3) == NULL);
+}
+
+TEST_F(TestCellularMux, test_receive)
+{
+    FakeModem modem;
+    CellularMux mux(&modem);
+    ASSERT_EQ(NSAPI_ERROR_OK, mux.start(false));
+    FileHandle *at = mux.open_channel(1);
+    FileHandle *data = mux.open_channel(2);
+    ASSERT_TRUE(at != NULL && data != NULL);
+    at->set_blocking(false);
+    data->set_blocking(false);
+
+    char buf[16];
+    EXPECT_EQ(-EAGAIN, at->read(buf, sizeof(buf)));
+
+    modem.receive(frame(0x05, 0xEF, "OK", 2));
+    modem.receive(frame(0x09, 0xEF, "~ppp~", 5));
+    EXPECT_EQ(POLLIN, data->poll(POLLIN) & POLLIN);
+    EXPECT_EQ(5, data->read(buf, sizeof(buf)));
+    EXPECT_EQ(0, memcmp(buf, "~ppp~", 5));
+    EXPECT_EQ(2, at->read(buf, sizeof(buf)));
+    EXPECT_EQ(0, memcmp(buf, "OK", 2));
+
+    // Frames with a bad FCS are dropped
+    std::vector<uint8_t> bad = frame(0x05, 0xEF, "XX", 2);
+    bad[bad.size() - 2] ^= 1;
+    modem.receive(bad);
+    EXPECT_EQ(-EAGAIN, at->read(buf, sizeof(buf)));
+
+    // Closed by the modem
+    modem.frames.clear();
+    modem.receive(frame(0x0B, 0x53, NULL, 0));
+    EXPECT_EQ(0, data->read(buf, sizeof(buf)));
+    ASSERT_EQ(1, modem.frames.size());
+    EXPECT_TRUE(modem.frames[0] == frame(0x09, 0x73, NULL, 0));
+    EXPECT_EQ(POLLHUP, data->poll(POLLIN) & POLLHUP);
+}
+
+TEST_F(TestCellularMux, test_flow_control)
+{
+    FakeModem modem;
+    CellularMux mux(&modem);
+    ASSERT_EQ(NSAPI_ERROR_OK, mux.start(false));
+    FileHandle *ch = mux.open_channel(1);
+    ASSERT_TRUE(ch != NULL);
+    ch->set_blocking(false);
+
+    char data[100];
+    memset(data, 'x', sizeof(data));
+    for (int i = 0; i < MBED_CONF_CELLULAR_MUX_BUFFER_SIZE / 100 + 1; i++) {
+        modem.receive(frame(0x07, 0xEF, data, sizeof(data)));
+    }
+
+    modem.frames.clear();
+    char buf[MBED_CONF_CELLULAR_MUX_BUFFER_SIZE];
+    EXPECT_EQ(MBED_CONF_CELLULAR_MUX_BUFFER_SIZE, ch->read(buf, sizeof(buf)));
+    EXPECT_EQ(100 - MBED_CONF_CELLULAR_MUX_BUFFER_SIZE % 100, mux.get_dropped_bytes());
+
+    // Paused with flow control when the buffer filled, resumed once read
+    const char flow_off[] = { (char)0xE3, 0x05, 0x07, (char)0x8F };
+    const char flow_on[] = { (char)0xE3, 0x05, 0x07, (char)0x8D };
+    ASSERT_EQ(2, modem.frames.size());
+    EXPECT_TRUE(modem.frames[0] == frame(0x03, 0xEF, flow_off, sizeof(flow_off)));
+    EXPECT_TRUE(modem.frames[1] == frame(0x03, 0xEF, flow_on, sizeof(flow_on)));
+}
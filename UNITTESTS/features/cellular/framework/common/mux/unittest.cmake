@@ -0,0 +1,25 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Add test specific include paths
+set(unittest-includes ${unittest-includes}
+  features/cellular/framework/common/mux
+  ../features/cellular/framework/common
+)
+
+# Source files
+set(unittest-sources
+  ../features/cellular/framework/common/CellularMux.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  features/cellular/framework/common/mux/muxtest.cpp
+  stubs/FileHandle_stub.cpp
+  stubs/Kernel_stub.cpp
+  stubs/mbed_assert_stub.c
+  stubs/mbed_poll_stub.cpp
+  stubs/Mutex_stub.cpp
+)
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "mbed-coap/sn_coap_protocol.h"
+#include "sn_coap_header_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+int allocations;
+
+void *test_malloc(uint16_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+void test_free(void *ptr)
+{
+    if (ptr) {
+        allocations--;
+    }
+    free(ptr);
+}
+
+uint8_t test_tx(uint8_t *, uint16_t, sn_nsdl_addr_s *, void *)
+{
+    return 1;
+}
+
+std::string field(const uint8_t *ptr, uint16_t len)
+{
+    return ptr ? std::string((const char *)ptr, len) : std::string();
+}
+
+}
+
+class TestCoapParser: public testing::Test {
+protected:
+    struct coap_s *handle;
+    sn_coap_hdr_s header;
+    sn_coap_options_list_s options;
+
+    virtual void SetUp()
+    {
+        allocations = 0;
+        handle = sn_coap_protocol_init(test_malloc, test_free, test_tx, NULL);
+        ASSERT_TRUE(handle != NULL);
+
+        sn_coap_parser_init_message(&header);
+        memset(&options, 0, sizeof(options));
+        options.uri_port = -1;
+        options.observe = COAP_OBSERVE_NONE;
+        options.accept = COAP_CT_NONE;
+        options.block1 = -1;
+        options.block2 = -1;
+        options.max_age = 60;
+    }
+
+    virtual void TearDown()
+    {
+        EXPECT_EQ(0, sn_coap_protocol_destroy(handle));
+        EXPECT_EQ(0, allocations);
+    }
+
+    std::vector<uint8_t> build()
+    {
+        std::vector<uint8_t> packet(sn_coap_builder_calc_needed_packet_data_size(&header));
+        EXPECT_EQ((int16_t)packet.size(), sn_coap_builder(packet.data(), &header));
+        return packet;
+    }
+
+    void set_all_options()
+    {
+        static uint8_t token[] = { 0x01, 0x02, 0x03, 0x04 };
+        static uint8_t etag[] = { 0x11, 0x22 };
+        header.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+        header.msg_code = COAP_MSG_CODE_REQUEST_PUT;
+        header.msg_id = 0x1234;
+        header.token_ptr = token;
+        header.token_len = sizeof(token);
+        header.uri_path_ptr = (uint8_t *)"sensors/temp/1";
+        header.uri_path_len = 14;
+        header.content_format = COAP_CT_JSON;
+        header.payload_ptr = (uint8_t *)"{\"v\":1}";
+        header.payload_len = 7;
+
+        options.uri_host_ptr = (uint8_t *)"example.org";
+        options.uri_host_len = 11;
+        options.uri_port = 5684;
+        options.etag_ptr = etag;
+        options.etag_len = sizeof(etag);
+        options.location_path_ptr = (uint8_t *)"a/b";
+        options.location_path_len = 3;
+        options.location_query_ptr = (uint8_t *)"q=1&r=2";
+        options.location_query_len = 7;
+        options.uri_query_ptr = (uint8_t *)"x=1&y=22";
+        options.uri_query_len = 8;
+        options.observe = 5;
+        options.max_age = 120;
+        options.accept = COAP_CT_TEXT_PLAIN;
+        options.block2 = 0x12;
+        options.use_size2 = true;
+        options.size2 = 300;
+        options.proxy_uri_ptr = (uint8_t *)"coap://proxy";
+        options.proxy_uri_len = 12;
+        header.options_list_ptr = &options;
+    }
+
+    void expect_equal(const sn_coap_hdr_s *expected, const sn_coap_hdr_s *parsed)
+    {
+        EXPECT_EQ(COAP_STATUS_OK, parsed->coap_status);
+        EXPECT_EQ(expected->msg_type, parsed->msg_type);
+        EXPECT_EQ(expected->msg_code, parsed->msg_code);
+        EXPECT_EQ(expected->msg_id, parsed->msg_id);
+        EXPECT_EQ(expected->content_format, parsed->content_format);
+        EXPECT_EQ(field(expected->token_ptr, expected->token_len), field(parsed->token_ptr, parsed->token_len));
+        EXPECT_EQ(field(expected->uri_path_ptr, expected->uri_path_len), field(parsed->uri_path_ptr, parsed->uri_path_len));
+        EXPECT_EQ(field(expected->payload_ptr, expected->payload_len), field(parsed->payload_ptr, parsed->payload_len));
+
+        const sn_coap_options_list_s *e = expected->options_list_ptr;
+        const sn_coap_options_list_s *p = parsed->options_list_ptr;
+        ASSERT_EQ(e == NULL, p == NULL);
+        if (!e) {
+            return;
+        }
+        EXPECT_EQ(field(e->uri_host_ptr, e->uri_host_len), field(p->uri_host_ptr, p->uri_host_len));
+        EXPECT_EQ(field(e->etag_ptr, e->etag_len), field(p->etag_ptr, p->etag_len));
+        EXPECT_EQ(field(e->location_path_ptr, e->location_path_len), field(p->location_path_ptr, p->location_path_len));
+        EXPECT_EQ(field(e->location_query_ptr, e->location_query_len), field(p->location_query_ptr, p->location_query_len));
+        EXPECT_EQ(field(e->uri_query_ptr, e->uri_query_len), field(p->uri_query_ptr, p->uri_query_len));
+        EXPECT_EQ(field(e->proxy_uri_ptr, e->proxy_uri_len), field(p->proxy_uri_ptr, p->proxy_uri_len));
+        EXPECT_EQ(e->uri_port, p->uri_port);
+        EXPECT_EQ(e->observe, p->observe);
+        EXPECT_EQ(e->accept, p->accept);
+        EXPECT_EQ(e->block1, p->block1);
+        EXPECT_EQ(e->block2, p->block2);
+        EXPECT_EQ(e->use_size1, p->use_size1);
+        EXPECT_EQ(e->use_size2, p->use_size2);
+        EXPECT_EQ(e->size2, p->size2);
+    }
+
+    /* Parses a copy of the packet both ways and checks that the results are the same */
+    int8_t parse_both(const std::vector<uint8_t> &packet)
+    {
+        // Exactly sized copies, so that reading past the end is caught by the sanitizers
+        std::vector<uint8_t> copy(packet);
+        std::vector<uint8_t> view_copy(packet);
+        coap_version_e version = COAP_VERSION_UNKNOWN;
+
+        sn_coap_hdr_s *parsed = sn_coap_parser(handle, copy.size(), copy.data(), &version);
+        EXPECT_TRUE(parsed != NULL);
+        if (!parsed) {
+            return -1;
+        }
+
+        sn_coap_hdr_s view;
+        sn_coap_options_list_s view_options;
+        int8_t ret = sn_coap_parser_view(view_copy.size(), view_copy.data(), &view, &view_options, &version);
+        EXPECT_EQ(parsed->coap_status, view.coap_status);
+        if (ret == 0) {
+            EXPECT_EQ(COAP_VERSION_1, version);
+            expect_equal(parsed, &view);
+        } else {
+            EXPECT_EQ(COAP_STATUS_PARSER_ERROR_IN_HEADER, view.coap_status);
+        }
+
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, parsed);
+        return ret;
+    }
+
+    void expect_error(const std::vector<uint8_t> &packet)
+    {
+        EXPECT_EQ(-1, parse_both(packet));
+    }
+};
+
+TEST_F(TestCoapParser, parse_all_options)
+{
+    set_all_options();
+    std::vector<uint8_t> packet = build();
+
+    coap_version_e version = COAP_VERSION_UNKNOWN;
+    sn_coap_hdr_s *parsed = sn_coap_parser(handle, packet.size(), packet.data(), &version);
+    ASSERT_TRUE(parsed != NULL);
+    EXPECT_EQ(COAP_VERSION_1, version);
+    expect_equal(&header, parsed);
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, parsed);
+}
+
+TEST_F(TestCoapParser, view_parses_in_place)
+{
+    set_all_options();
+    std::vector<uint8_t> packet = build();
+    int before = allocations;
+
+    sn_coap_hdr_s view;
+    sn_coap_options_list_s view_options;
+    coap_version_e version = COAP_VERSION_UNKNOWN;
+    ASSERT_EQ(0, sn_coap_parser_view(packet.size(), packet.data(), &view, &view_options, &version));
+    EXPECT_EQ(before, allocations);
+    EXPECT_EQ(&view_options, view.options_list_ptr);
+    expect_equal(&header, &view);
+
+    // Everything points into the packet
+    const uint8_t *begin = packet.data();
+    const uint8_t *end = begin + packet.size();
+    EXPECT_TRUE(view.token_ptr > begin && view.token_ptr < end);
+    EXPECT_TRUE(view.uri_path_ptr > begin && view.uri_path_ptr + view.uri_path_len < end);
+    EXPECT_TRUE(view_options.uri_query_ptr > begin && view_options.uri_query_ptr + view_options.uri_query_len < end);
+    EXPECT_EQ(end, view.payload_ptr + view.payload_len);
+}
+
+TEST_F(TestCoapParser, view_long_options)
+{
+    std::string part1(20, 'a');
+    std::string part2(255, 'b');
+    std::string path = part1 + "/" + part2 + "/c";
+    std::string proxy(300, 'p');
+    header.msg_code = COAP_MSG_CODE_REQUEST_GET;
+    header.uri_path_ptr = (uint8_t *)path.data();
+    header.uri_path_len = path.size();
+    options.proxy_uri_ptr = (uint8_t *)proxy.data();
+    options.proxy_uri_len = proxy.size();
+    header.options_list_ptr = &options;
+
+    std::vector<uint8_t> packet = build();
+    EXPECT_EQ(0, parse_both(packet));
+
+    sn_coap_hdr_s view;
+    sn_coap_options_list_s view_options;
+    coap_version_e version;
+    ASSERT_EQ(0, sn_coap_parser_view(packet.size(), packet.data(), &view, &view_options, &version));
+    expect_equal(&header, &view);
+}
+
+TEST_F(TestCoapParser, view_without_options)
+{
+    static uint8_t token[] = { 0xAB };
+    header.msg_type = COAP_MSG_TYPE_NON_CONFIRMABLE;
+    header.msg_code = COAP_MSG_CODE_RESPONSE_CONTENT;
+    header.token_ptr = token;
+    header.token_len = sizeof(token);
+    header.payload_ptr = (uint8_t *)"hello";
+    header.payload_len = 5;
+    std::vector<uint8_t> packet = build();
+
+    sn_coap_hdr_s view;
+    sn_coap_options_list_s view_options;
+    coap_version_e version;
+    ASSERT_EQ(0, sn_coap_parser_view(packet.size(), packet.data(), &view, &view_options, &version));
+    EXPECT_TRUE(view.options_list_ptr == NULL);
+    expect_equal(&header, &view);
+    EXPECT_EQ(0, parse_both(packet));
+
+    EXPECT_EQ(-1, sn_coap_parser_view(3, packet.data(), &view, &view_options, &version));
+    EXPECT_EQ(-1, sn_coap_parser_view(packet.size(), NULL, &view, &view_options, &version));
+    EXPECT_EQ(-1, sn_coap_parser_view(packet.size(), packet.data(), &view, NULL, &version));
+}
+
+TEST_F(TestCoapParser, malformed_options)
+{
+    // Token longer than 8
+    expect_error({ 0x49, 0x01, 0x00, 0x01, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+    // Option delta 15 is reserved
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xF1, 0x00 });
+    // Option length 15 is reserved
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0x3F, 'a', 'b' });
+    // Unknown option 2
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0x21, 'a' });
+    // Payload marker without payload
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xFF });
+    // Content-Format twice
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xC1, 0x32, 0x01, 0x32 });
+    // Content-Format longer than 2
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xC3, 0x00, 0x00, 0x32 });
+    // Empty Uri-Host
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0x30 });
+    // Uri-Host twice
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0x31, 'a', 0x01, 'b' });
+    // ETag longer than 8
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0x49, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+    // Block2 longer than 3
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xD4, 0x0A, 1, 2, 3, 4 });
+    // Observe twice
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0x61, 0x01, 0x01, 0x02 });
+
+    // Uri-Path part longer than 255
+    std::vector<uint8_t> packet = { 0x40, 0x01, 0x00, 0x01, 0xBE, 0x00, 0x01 };
+    packet.resize(packet.size() + 270, 'a');
+    expect_error(packet);
+}
+
+TEST_F(TestCoapParser, truncated_options)
+{
+    // Token cut
+    expect_error({ 0x44, 0x01, 0x00, 0x01, 0xAA, 0xBB });
+    // Extended option delta cut
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xD0 });
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xE0, 0x00 });
+    // Extended option length cut
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0x3D });
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0x3E, 0x00 });
+    // Uri-Host value cut
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0x35, 'a', 'b' });
+    // Proxy-Uri value cut
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xD8, 0x16, 'c', 'o', 'a' });
+    // Second Uri-Path part cut
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xB1, 'a', 0x05, 'b' });
+    // Max-Age value cut
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xD2, 0x01, 0x10 });
+    // Observe value cut
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0x62, 0x01 });
+    // Content-Format value cut
+    expect_error({ 0x40, 0x01, 0x00, 0x01, 0xC2, 0x00 });
+}
+
+TEST_F(TestCoapParser, every_truncation_of_a_message)
+{
+    set_all_options();
+    std::vector<uint8_t> packet = build();
+
+    for (size_t len = 4; len <= packet.size(); len++) {
+        std::vector<uint8_t> truncated(packet.begin(), packet.begin() + len);
+        SCOPED_TRACE(len);
+        parse_both(truncated);
+    }
+}
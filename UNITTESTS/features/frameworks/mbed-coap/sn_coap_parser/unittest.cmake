@@ -0,0 +1,26 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Add test specific include paths
+set(unittest-includes ${unittest-includes}
+  ../features/frameworks/mbed-coap
+  ../features/frameworks/mbed-coap/source/include
+  ../features/frameworks/mbed-client-randlib/mbed-client-randlib
+)
+
+# Source files
+set(unittest-sources
+  ../features/frameworks/mbed-coap/source/sn_coap_builder.c
+  ../features/frameworks/mbed-coap/source/sn_coap_header_check.c
+  ../features/frameworks/mbed-coap/source/sn_coap_parser.c
+  ../features/frameworks/mbed-coap/source/sn_coap_protocol.c
+  ../features/frameworks/nanostack-libservice/source/libList/ns_list.c
+)
+
+# Test files
+set(unittest-test-sources
+  features/frameworks/mbed-coap/sn_coap_parser/test_sn_coap_parser.cpp
+  stubs/randLIB_stub.c
+)
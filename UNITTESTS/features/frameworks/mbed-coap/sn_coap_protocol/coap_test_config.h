@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COAP_TEST_CONFIG_H
+#define COAP_TEST_CONFIG_H
+
+#define SN_COAP_DUPLICATION_MAX_MSGS_COUNT  4
+#define SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE  16
+#define SN_COAP_RESENDING_QUEUE_SIZE_MSGS   6
+#define DEFAULT_RESPONSE_TIMEOUT            2
+#define SN_COAP_RESENDING_MAX_COUNT         2
+
+#endif
@@ -0,0 +1,582 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "mbed-coap/sn_coap_protocol.h"
+#include "sn_coap_protocol_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace {
+
+struct sent_packet {
+    std::vector<uint8_t> data;
+    uint16_t port;
+};
+
+std::vector<sent_packet> sent;
+std::vector<sn_coap_status_e> received_status;
+int allocations;
+
+void *test_malloc(uint16_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+void test_free(void *ptr)
+{
+    if (ptr) {
+        allocations--;
+    }
+    free(ptr);
+}
+
+uint8_t test_tx(uint8_t *packet, uint16_t len, sn_nsdl_addr_s *addr, void *)
+{
+    sent_packet p;
+    p.data.assign(packet, packet + len);
+    p.port = addr ? addr->port : 0;
+    sent.push_back(p);
+    return 1;
+}
+
+int8_t test_rx(sn_coap_hdr_s *header, sn_nsdl_addr_s *, void *)
+{
+    received_status.push_back(header->coap_status);
+    return 0;
+}
+
+uint16_t packet_msg_id(const sent_packet &p)
+{
+    return (p.data[2] << 8) | p.data[3];
+}
+
+std::vector<uint8_t> streamed;
+std::vector<uint32_t> streamed_offsets;
+
+void test_stream(const sn_coap_hdr_s *, uint32_t offset, const uint8_t *payload_ptr, uint16_t payload_len, void *)
+{
+    streamed_offsets.push_back(offset);
+    streamed.insert(streamed.end(), payload_ptr, payload_ptr + payload_len);
+}
+
+}
+
+class TestCoapProtocol: public testing::Test {
+protected:
+    struct coap_s *handle;
+    uint8_t address[16];
+    sn_nsdl_addr_s addr;
+
+    virtual void SetUp()
+    {
+        sent.clear();
+        received_status.clear();
+        streamed.clear();
+        streamed_offsets.clear();
+        allocations = 0;
+        handle = sn_coap_protocol_init(test_malloc, test_free, test_tx, test_rx);
+        ASSERT_TRUE(handle != NULL);
+
+        memset(address, 0x11, sizeof(address));
+        addr.addr_len = sizeof(address);
+        addr.type = SN_NSDL_ADDRESS_TYPE_IPV6;
+        addr.port = 5683;
+        addr.addr_ptr = address;
+    }
+
+    virtual void TearDown()
+    {
+        EXPECT_EQ(0, sn_coap_protocol_destroy(handle));
+        EXPECT_EQ(0, allocations);
+    }
+
+    /* Builds a message with no payload and returns its Message ID */
+    uint16_t build(sn_coap_msg_type_e type, sn_coap_msg_code_e code, uint16_t msg_id = 0,
+                   uint8_t *token = NULL, uint8_t token_len = 0, int16_t expected = 0)
+    {
+        sn_coap_hdr_s header;
+        uint8_t buffer[64];
+        sn_coap_parser_init_message(&header);
+        header.msg_type = type;
+        header.msg_code = code;
+        header.msg_id = msg_id;
+        header.token_ptr = token;
+        header.token_len = token_len;
+        int16_t len = sn_coap_protocol_build(handle, &addr, buffer, &header, NULL);
+        if (expected) {
+            EXPECT_EQ(expected, len);
+        } else {
+            EXPECT_EQ(4 + token_len, len);
+        }
+        return header.msg_id;
+    }
+
+    /* Parses a four byte header of the given type, code and Message ID */
+    sn_coap_hdr_s *parse(sn_coap_msg_type_e type, uint8_t code, uint16_t msg_id)
+    {
+        uint8_t packet[4] = { (uint8_t)(COAP_VERSION_1 | type), code, (uint8_t)(msg_id >> 8), (uint8_t)msg_id };
+        return sn_coap_protocol_parse(handle, &addr, sizeof(packet), packet, NULL);
+    }
+
+    void ack(uint16_t msg_id)
+    {
+        sn_coap_hdr_s *header = parse(COAP_MSG_TYPE_ACKNOWLEDGEMENT, COAP_MSG_CODE_RESPONSE_CONTENT, msg_id);
+        ASSERT_TRUE(header != NULL);
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+    }
+
+    /* Builds a request with a token as mbed-client does, its packet is recorded as sent */
+    void build_request(sn_coap_msg_code_e code, const uint8_t *payload, uint16_t payload_len)
+    {
+        static uint8_t token[] = { 0x5A, 0xA5 };
+        sn_coap_hdr_s header;
+        uint8_t buffer[64];
+        sn_coap_parser_init_message(&header);
+        header.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+        header.msg_code = code;
+        header.token_ptr = token;
+        header.token_len = sizeof(token);
+        header.uri_path_ptr = (uint8_t *)"res";
+        header.uri_path_len = 3;
+        header.payload_ptr = (uint8_t *)payload;
+        header.payload_len = payload_len;
+        ASSERT_EQ(0, prepare_blockwise_message(handle, &header));
+        int16_t len = sn_coap_protocol_build(handle, &addr, buffer, &header, NULL);
+        test_free(header.options_list_ptr);
+        ASSERT_GT(len, 0);
+
+        sent_packet p;
+        p.data.assign(buffer, buffer + len);
+        p.port = addr.port;
+        sent.push_back(p);
+    }
+
+    /* Answers a request as the server would, with a piggybacked response, and parses the answer */
+    sn_coap_hdr_s *respond(const sent_packet &request, sn_coap_msg_code_e code, int32_t block1, int32_t block2,
+                           const uint8_t *payload, uint16_t payload_len, uint32_t size2 = 0)
+    {
+        std::vector<uint8_t> data(request.data);
+        coap_version_e version;
+        sn_coap_hdr_s *parsed = sn_coap_parser(handle, data.size(), data.data(), &version);
+        EXPECT_TRUE(parsed != NULL);
+
+        sn_coap_hdr_s header;
+        sn_coap_options_list_s options;
+        sn_coap_parser_init_message(&header);
+        memset(&options, 0, sizeof(options));
+        options.uri_port = COAP_OPTION_URI_PORT_NONE;
+        options.observe = COAP_OBSERVE_NONE;
+        options.accept = COAP_CT_NONE;
+        options.max_age = COAP_OPTION_MAX_AGE_DEFAULT;
+        options.block1 = block1;
+        options.block2 = block2;
+        if (size2) {
+            options.use_size2 = true;
+            options.size2 = size2;
+        }
+        header.options_list_ptr = &options;
+        header.msg_type = COAP_MSG_TYPE_ACKNOWLEDGEMENT;
+        header.msg_code = code;
+        header.msg_id = parsed->msg_id;
+        header.token_ptr = parsed->token_ptr;
+        header.token_len = parsed->token_len;
+        header.payload_ptr = (uint8_t *)payload;
+        header.payload_len = payload_len;
+
+        std::vector<uint8_t> packet(sn_coap_builder_calc_needed_packet_data_size(&header));
+        EXPECT_EQ((int16_t)packet.size(), sn_coap_builder(packet.data(), &header));
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, parsed);
+        return sn_coap_protocol_parse(handle, &addr, packet.size(), packet.data(), NULL);
+    }
+
+    /* Answers a Block2 request with its block of the resource, 16 byte blocks */
+    sn_coap_hdr_s *respond_block2(const sent_packet &request, const uint8_t *resource, uint16_t resource_len, bool size2)
+    {
+        std::vector<uint8_t> data(request.data);
+        coap_version_e version;
+        sn_coap_hdr_s *parsed = sn_coap_parser(handle, data.size(), data.data(), &version);
+        EXPECT_TRUE(parsed != NULL);
+        uint32_t block_number = 0;
+        if (parsed->options_list_ptr && parsed->options_list_ptr->block2 != COAP_OPTION_BLOCK_NONE) {
+            block_number = parsed->options_list_ptr->block2 >> 4;
+        }
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, parsed);
+
+        uint16_t offset = block_number * 16;
+        uint16_t len = resource_len - offset > 16 ? 16 : resource_len - offset;
+        bool more = offset + len < resource_len;
+        return respond(request, COAP_MSG_CODE_RESPONSE_CONTENT, COAP_OPTION_BLOCK_NONE,
+                       (block_number << 4) | (more ? 0x08 : 0), resource + offset, len, size2 ? resource_len : 0);
+    }
+
+    /* Serves the Block2 transfer of the resource, the requests of each round in the given order */
+    std::vector<uint8_t> fetch_block2(const uint8_t *resource, uint16_t resource_len, bool size2, bool reverse,
+                                      size_t *max_outstanding)
+    {
+        std::vector<uint8_t> payload;
+        bool done = false;
+        *max_outstanding = 0;
+        while (!sent.empty() && !done) {
+            std::vector<sent_packet> requests;
+            requests.swap(sent);
+            if (requests.size() > *max_outstanding) {
+                *max_outstanding = requests.size();
+            }
+            for (size_t i = 0; i < requests.size(); i++) {
+                sn_coap_hdr_s *header = respond_block2(requests[reverse ? requests.size() - 1 - i : i],
+                                                       resource, resource_len, size2);
+                if (!header) {
+                    continue;
+                }
+                if (header->coap_status == COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED) {
+                    EXPECT_FALSE(done);
+                    done = true;
+                    payload.assign(header->payload_ptr, header->payload_ptr + header->payload_len);
+                    test_free(header->payload_ptr);
+                    header->payload_ptr = NULL;
+                } else {
+                    EXPECT_EQ(COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING, header->coap_status);
+                }
+                sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+            }
+        }
+        EXPECT_TRUE(done);
+        return payload;
+    }
+};
+
+TEST_F(TestCoapProtocol, resend_queue_is_ordered_by_time)
+{
+    uint16_t first = build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST);
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 1));
+    uint16_t second = build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST);
+    EXPECT_TRUE(sent.empty());
+
+    // First resendings are due one interval (2 s) after building
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 2));
+    ASSERT_EQ(1U, sent.size());
+    EXPECT_EQ(first, packet_msg_id(sent[0]));
+
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 3));
+    ASSERT_EQ(2U, sent.size());
+    EXPECT_EQ(second, packet_msg_id(sent[1]));
+
+    // The interval doubles, the first message is due at 6 and the second at 7
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 5));
+    EXPECT_EQ(2U, sent.size());
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 6));
+    ASSERT_EQ(3U, sent.size());
+    EXPECT_EQ(first, packet_msg_id(sent[2]));
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 7));
+    ASSERT_EQ(4U, sent.size());
+    EXPECT_EQ(second, packet_msg_id(sent[3]));
+
+    // Both are late, each resend is given up once and reported
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 50));
+    EXPECT_EQ(4U, sent.size());
+    ASSERT_EQ(2U, received_status.size());
+    EXPECT_EQ(COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED, received_status[0]);
+    EXPECT_EQ(COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED, received_status[1]);
+    EXPECT_EQ(-2, sn_coap_protocol_delete_retransmission(handle, first));
+    EXPECT_EQ(-2, sn_coap_protocol_delete_retransmission(handle, second));
+}
+
+TEST_F(TestCoapProtocol, resend_queue_keeps_building_order_at_equal_time)
+{
+    uint16_t ids[4];
+    for (int i = 0; i < 4; i++) {
+        ids[i] = build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST);
+    }
+
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 2));
+    ASSERT_EQ(4U, sent.size());
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(ids[i], packet_msg_id(sent[i]));
+    }
+}
+
+TEST_F(TestCoapProtocol, ack_removes_only_the_matching_message)
+{
+    // Message IDs in the same hash bucket
+    uint16_t ids[3] = { 0x1001, 0x1009, 0x1011 };
+    for (int i = 0; i < 3; i++) {
+        build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST, ids[i]);
+    }
+
+    // From another port the ACK is not for us
+    addr.port++;
+    ack(ids[1]);
+    addr.port--;
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 2));
+    EXPECT_EQ(3U, sent.size());
+
+    ack(ids[1]);
+    sent.clear();
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 6));
+    ASSERT_EQ(2U, sent.size());
+    EXPECT_EQ(ids[0], packet_msg_id(sent[0]));
+    EXPECT_EQ(ids[2], packet_msg_id(sent[1]));
+
+    EXPECT_EQ(-2, sn_coap_protocol_delete_retransmission(handle, ids[1]));
+    EXPECT_EQ(0, sn_coap_protocol_delete_retransmission(handle, ids[2]));
+    EXPECT_EQ(0, sn_coap_protocol_delete_retransmission(handle, ids[0]));
+    EXPECT_EQ(-2, sn_coap_protocol_delete_retransmission(handle, ids[0]));
+}
+
+TEST_F(TestCoapProtocol, delete_retransmission_by_token)
+{
+    uint8_t tokens[6][4];
+    uint16_t ids[6];
+    for (int i = 0; i < 6; i++) {
+        memset(tokens[i], 0xA0, sizeof(tokens[i]));
+        tokens[i][3] = i * 8; // Every token is in the same hash bucket
+        ids[i] = build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, 0, tokens[i], 4);
+    }
+
+    uint8_t unknown[4] = { 0xA0, 0xA0, 0xA0, 0x01 };
+    EXPECT_EQ(-2, sn_coap_protocol_delete_retransmission_by_token(handle, unknown, 4));
+    EXPECT_EQ(-2, sn_coap_protocol_delete_retransmission_by_token(handle, tokens[0], 3));
+    EXPECT_EQ(-1, sn_coap_protocol_delete_retransmission_by_token(handle, NULL, 4));
+
+    EXPECT_EQ(0, sn_coap_protocol_delete_retransmission_by_token(handle, tokens[4], 4));
+    EXPECT_EQ(0, sn_coap_protocol_delete_retransmission_by_token(handle, tokens[1], 4));
+    EXPECT_EQ(-2, sn_coap_protocol_delete_retransmission_by_token(handle, tokens[1], 4));
+
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 2));
+    ASSERT_EQ(4U, sent.size());
+    EXPECT_EQ(ids[0], packet_msg_id(sent[0]));
+    EXPECT_EQ(ids[2], packet_msg_id(sent[1]));
+    EXPECT_EQ(ids[3], packet_msg_id(sent[2]));
+    EXPECT_EQ(ids[5], packet_msg_id(sent[3]));
+
+    // Removing by Message ID also drops the token
+    EXPECT_EQ(0, sn_coap_protocol_delete_retransmission(handle, ids[3]));
+    EXPECT_EQ(-2, sn_coap_protocol_delete_retransmission_by_token(handle, tokens[3], 4));
+}
+
+TEST_F(TestCoapProtocol, resend_queue_limits)
+{
+    for (int i = 0; i < 6; i++) {
+        build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST);
+    }
+    build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST, 0, NULL, 0, -4);
+
+    // Non-confirmable messages are not stored
+    build(COAP_MSG_TYPE_NON_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST);
+
+    sn_coap_protocol_clear_retransmission_buffer(handle);
+
+    // Byte limit, the stored size is returned on removal
+    EXPECT_EQ(0, sn_coap_protocol_set_retransmission_buffer(handle, 0, 10));
+    uint16_t first = build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST);
+    build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST);
+    build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST, 0, NULL, 0, -4);
+    ack(first);
+    build(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_POST);
+}
+
+TEST_F(TestCoapProtocol, duplicate_detection)
+{
+    sn_coap_hdr_s *header = parse(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, 0x2000);
+    ASSERT_TRUE(header != NULL);
+    EXPECT_EQ(COAP_STATUS_OK, header->coap_status);
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+
+    // Same Message ID from another port is a new message
+    addr.port++;
+    header = parse(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, 0x2000);
+    EXPECT_EQ(COAP_STATUS_OK, header->coap_status);
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+    addr.port--;
+
+    header = parse(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, 0x2000);
+    EXPECT_EQ(COAP_STATUS_PARSER_DUPLICATED_MSG, header->coap_status);
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+    EXPECT_TRUE(sent.empty());
+
+    // Once answered, the answer is sent again for duplicates
+    build(COAP_MSG_TYPE_ACKNOWLEDGEMENT, COAP_MSG_CODE_RESPONSE_CONTENT, 0x2000);
+    header = parse(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, 0x2000);
+    EXPECT_EQ(COAP_STATUS_PARSER_DUPLICATED_MSG, header->coap_status);
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+    ASSERT_EQ(1U, sent.size());
+    EXPECT_EQ(COAP_VERSION_1 | COAP_MSG_TYPE_ACKNOWLEDGEMENT, sent[0].data[0]);
+    EXPECT_EQ(0x2000, packet_msg_id(sent[0]));
+
+    sn_coap_protocol_linked_list_duplication_info_remove(handle, address, addr.port, 0x2000);
+    header = parse(COAP_MSG_TYPE_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, 0x2000);
+    EXPECT_EQ(COAP_STATUS_OK, header->coap_status);
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+}
+
+TEST_F(TestCoapProtocol, duplicate_detection_drops_oldest)
+{
+    // More than the buffer holds, all in the same hash bucket
+    uint16_t ids[5] = { 0x3000, 0x3008, 0x3010, 0x3018, 0x3020 };
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(0, sn_coap_protocol_exec(handle, 10 + i * 10));
+        sn_coap_hdr_s *header = parse(COAP_MSG_TYPE_NON_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, ids[i]);
+        EXPECT_EQ(COAP_STATUS_OK, header->coap_status);
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+    }
+
+    sn_coap_hdr_s *header = parse(COAP_MSG_TYPE_NON_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, ids[1]);
+    EXPECT_EQ(COAP_STATUS_PARSER_DUPLICATED_MSG, header->coap_status);
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+
+    // At 85 s the info stored at 20 s is too old
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 85));
+    header = parse(COAP_MSG_TYPE_NON_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, ids[2]);
+    EXPECT_EQ(COAP_STATUS_PARSER_DUPLICATED_MSG, header->coap_status);
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+    header = parse(COAP_MSG_TYPE_NON_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, ids[1]);
+    EXPECT_EQ(COAP_STATUS_OK, header->coap_status);
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+
+    // The oldest was dropped when the fifth message was stored
+    header = parse(COAP_MSG_TYPE_NON_CONFIRMABLE, COAP_MSG_CODE_REQUEST_GET, ids[0]);
+    EXPECT_EQ(COAP_STATUS_OK, header->coap_status);
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+}
+
+TEST_F(TestCoapProtocol, block1_send)
+{
+    uint8_t payload[40];
+    for (size_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = i * 3 + 1;
+    }
+    build_request(COAP_MSG_CODE_REQUEST_POST, payload, sizeof(payload));
+
+    // The server gets the blocks one at a time, each acknowledged with 2.31 Continue
+    std::vector<uint8_t> received;
+    for (uint32_t block_number = 0; block_number < 3; block_number++) {
+        ASSERT_EQ(1U, sent.size());
+        sent_packet request = sent[0];
+        sent.clear();
+
+        std::vector<uint8_t> data(request.data);
+        coap_version_e version;
+        sn_coap_hdr_s *parsed = sn_coap_parser(handle, data.size(), data.data(), &version);
+        ASSERT_TRUE(parsed != NULL);
+        ASSERT_TRUE(parsed->options_list_ptr != NULL);
+        bool more = block_number < 2;
+        EXPECT_EQ((int32_t)((block_number << 4) | (more ? 0x08 : 0)), parsed->options_list_ptr->block1);
+        EXPECT_EQ(std::string("res"), std::string((char *)parsed->uri_path_ptr, parsed->uri_path_len));
+        received.insert(received.end(), parsed->payload_ptr, parsed->payload_ptr + parsed->payload_len);
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, parsed);
+
+        sn_coap_hdr_s *header = respond(request, more ? COAP_MSG_CODE_RESPONSE_CONTINUE : COAP_MSG_CODE_RESPONSE_CHANGED,
+                                        (block_number << 4) | (more ? 0x08 : 0), COAP_OPTION_BLOCK_NONE, NULL, 0);
+        ASSERT_TRUE(header != NULL);
+        EXPECT_EQ(more ? COAP_STATUS_PARSER_BLOCKWISE_ACK : COAP_STATUS_OK, header->coap_status);
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, header);
+    }
+
+    EXPECT_TRUE(sent.empty());
+    ASSERT_EQ(sizeof(payload), received.size());
+    EXPECT_EQ(0, memcmp(payload, received.data(), sizeof(payload)));
+    EXPECT_TRUE(ns_list_is_empty(&handle->linked_list_blockwise_sent_msgs));
+
+    // Every block was acknowledged, nothing is resent
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, 30));
+    EXPECT_TRUE(sent.empty());
+}
+
+TEST_F(TestCoapProtocol, block2_receive)
+{
+    uint8_t resource[100];
+    for (size_t i = 0; i < sizeof(resource); i++) {
+        resource[i] = i * 7 + 3;
+    }
+    EXPECT_EQ(0, sn_coap_protocol_handle_block2_response_internally(handle, 1));
+
+    // Without Size2, one block is requested at a time even with a window
+    for (int window = 1; window <= 4; window += 3) {
+        EXPECT_EQ(0, sn_coap_protocol_set_block2_window(handle, window));
+        build_request(COAP_MSG_CODE_REQUEST_GET, NULL, 0);
+        size_t max_outstanding;
+        std::vector<uint8_t> payload = fetch_block2(resource, sizeof(resource), false, false, &max_outstanding);
+        EXPECT_EQ(1U, max_outstanding);
+        ASSERT_EQ(sizeof(resource), payload.size());
+        EXPECT_EQ(0, memcmp(resource, payload.data(), sizeof(resource)));
+        EXPECT_TRUE(ns_list_is_empty(&handle->linked_list_blockwise_sent_msgs));
+        EXPECT_TRUE(ns_list_is_empty(&handle->linked_list_blockwise_received_payloads));
+    }
+
+    // Completed transfers are not reported as failed later on
+    EXPECT_EQ(0, sn_coap_protocol_exec(handle, SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED + 1));
+    EXPECT_TRUE(received_status.empty());
+}
+
+TEST_F(TestCoapProtocol, block2_receive_with_window)
+{
+    uint8_t resource[100];
+    for (size_t i = 0; i < sizeof(resource); i++) {
+        resource[i] = i * 7 + 3;
+    }
+    EXPECT_EQ(0, sn_coap_protocol_handle_block2_response_internally(handle, 1));
+    EXPECT_EQ(-1, sn_coap_protocol_set_block2_window(handle, 0));
+    EXPECT_EQ(-1, sn_coap_protocol_set_block2_window(handle, SN_COAP_MAX_ALLOWED_BLOCKWISE_WINDOW_SIZE + 1));
+    EXPECT_EQ(0, sn_coap_protocol_set_block2_window(handle, 4));
+
+    // The responses of each round arrive in reverse order
+    build_request(COAP_MSG_CODE_REQUEST_GET, NULL, 0);
+    size_t max_outstanding;
+    std::vector<uint8_t> payload = fetch_block2(resource, sizeof(resource), true, true, &max_outstanding);
+    EXPECT_EQ(4U, max_outstanding);
+    ASSERT_EQ(sizeof(resource), payload.size());
+    EXPECT_EQ(0, memcmp(resource, payload.data(), sizeof(resource)));
+    EXPECT_TRUE(ns_list_is_empty(&handle->linked_list_blockwise_sent_msgs));
+    EXPECT_TRUE(ns_list_is_empty(&handle->linked_list_blockwise_received_payloads));
+
+    // Nothing past the end was requested
+    EXPECT_TRUE(sent.empty());
+}
+
+TEST_F(TestCoapProtocol, block2_receive_to_stream_callback)
+{
+    uint8_t resource[100];
+    for (size_t i = 0; i < sizeof(resource); i++) {
+        resource[i] = i * 7 + 3;
+    }
+    EXPECT_EQ(0, sn_coap_protocol_handle_block2_response_internally(handle, 1));
+    EXPECT_EQ(0, sn_coap_protocol_set_block2_stream_callback(handle, test_stream));
+
+    for (int window = 1; window <= 4; window += 3) {
+        streamed.clear();
+        streamed_offsets.clear();
+        EXPECT_EQ(0, sn_coap_protocol_set_block2_window(handle, window));
+        build_request(COAP_MSG_CODE_REQUEST_GET, NULL, 0);
+        size_t max_outstanding;
+        std::vector<uint8_t> payload = fetch_block2(resource, sizeof(resource), true, true, &max_outstanding);
+        EXPECT_EQ((size_t)window, max_outstanding);
+
+        // Blocks are given in order and the last message carries no payload
+        EXPECT_TRUE(payload.empty());
+        ASSERT_EQ(7U, streamed_offsets.size());
+        for (uint32_t i = 0; i < streamed_offsets.size(); i++) {
+            EXPECT_EQ(i * 16, streamed_offsets[i]);
+        }
+        ASSERT_EQ(sizeof(resource), streamed.size());
+        EXPECT_EQ(0, memcmp(resource, streamed.data(), sizeof(resource)));
+        EXPECT_TRUE(ns_list_is_empty(&handle->linked_list_blockwise_sent_msgs));
+        EXPECT_TRUE(ns_list_is_empty(&handle->linked_list_blockwise_received_payloads));
+    }
+}
@@ -0,0 +1,33 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Add test specific include paths
+set(unittest-includes ${unittest-includes}
+  ../features/frameworks/mbed-coap
+  ../features/frameworks/mbed-coap/source/include
+  ../features/frameworks/mbed-client-randlib/mbed-client-randlib
+)
+
+# Source files
+set(unittest-sources
+  ../features/frameworks/mbed-coap/source/sn_coap_builder.c
+  ../features/frameworks/mbed-coap/source/sn_coap_header_check.c
+  ../features/frameworks/mbed-coap/source/sn_coap_parser.c
+  ../features/frameworks/mbed-coap/source/sn_coap_protocol.c
+  ../features/frameworks/nanostack-libservice/source/libList/ns_list.c
+)
+
+# Test files
+set(unittest-test-sources
+  features/frameworks/mbed-coap/sn_coap_protocol/test_sn_coap_protocol.cpp
+  stubs/randLIB_stub.c
+)
+
+set(MBED_CLIENT_USER_CONFIG_FILE_PATH "\"../UNITTESTS/features/frameworks/mbed-coap/sn_coap_protocol/coap_test_config.h\"")
+set_source_files_properties(features/frameworks/mbed-coap/sn_coap_protocol/test_sn_coap_protocol.cpp PROPERTIES COMPILE_DEFINITIONS MBED_CLIENT_USER_CONFIG_FILE=${MBED_CLIENT_USER_CONFIG_FILE_PATH})
+set_source_files_properties(../features/frameworks/mbed-coap/source/sn_coap_builder.c PROPERTIES COMPILE_DEFINITIONS MBED_CLIENT_USER_CONFIG_FILE=${MBED_CLIENT_USER_CONFIG_FILE_PATH})
+set_source_files_properties(../features/frameworks/mbed-coap/source/sn_coap_header_check.c PROPERTIES COMPILE_DEFINITIONS MBED_CLIENT_USER_CONFIG_FILE=${MBED_CLIENT_USER_CONFIG_FILE_PATH})
+set_source_files_properties(../features/frameworks/mbed-coap/source/sn_coap_parser.c PROPERTIES COMPILE_DEFINITIONS MBED_CLIENT_USER_CONFIG_FILE=${MBED_CLIENT_USER_CONFIG_FILE_PATH})
+set_source_files_properties(../features/frameworks/mbed-coap/source/sn_coap_protocol.c PROPERTIES COMPILE_DEFINITIONS MBED_CLIENT_USER_CONFIG_FILE=${MBED_CLIENT_USER_CONFIG_FILE_PATH})
@@ -117,6 +117,62 @@ TEST_F(Test_LoRaMac, get_channel_plan)
     EXPECT_EQ(LORAWAN_STATUS_OK, object->get_channel_plan(plan));
 }
 
+TEST_F(Test_LoRaMac, get_session)
+{
+    my_phy phy;
+    object->bind_phy(phy);
+
+    loramac_session_t session;
+    LoRaPHY_stub::uint8_value = 8;
+    object->get_session(session);
+    EXPECT_EQ(0, session.nb_channels);
+}
+
+TEST_F(Test_LoRaMac, restore_session)
+{
+    my_phy phy;
+    object->bind_phy(phy);
+
+    loramac_session_t session;
+    memset(&session, 0, sizeof(session));
+    session.dev_addr = 1;
+    session.nb_channels = 1;
+
+    // Not prepared for joining
+    EXPECT_EQ(LORAWAN_STATUS_PARAMETER_INVALID, object->restore_session(session));
+
+    lorawan_connect_t conn;
+    memset(&conn, 0, sizeof(conn));
+    uint8_t key[16];
+    memset(key, 0, sizeof(key));
+    conn.connection_u.otaa.app_key = key;
+    conn.connection_u.otaa.app_eui = key;
+    conn.connection_u.otaa.dev_eui = key;
+    conn.connection_u.otaa.nb_trials = 2;
+    LoRaPHY_stub::bool_counter = 0;
+    LoRaPHY_stub::bool_table[0] = true;
+    object->prepare_join(&conn, true);
+
+    // Session of another device
+    session.dev_eui[0] = 1;
+    EXPECT_EQ(LORAWAN_STATUS_PARAMETER_INVALID, object->restore_session(session));
+    session.dev_eui[0] = 0;
+
+    session.nb_channels = LORA_MAX_NB_CHANNELS + 1;
+    EXPECT_EQ(LORAWAN_STATUS_PARAMETER_INVALID, object->restore_session(session));
+
+    session.nb_channels = 1;
+    LoRaPHY_stub::bool_counter = 0;
+    LoRaPHY_stub::bool_table[0] = true;
+    LoRaPHY_stub::bool_table[1] = true;
+    LoRaPHY_stub::bool_table[2] = true;
+    EXPECT_EQ(LORAWAN_STATUS_OK, object->restore_session(session));
+    EXPECT_TRUE(object->nwk_joined());
+
+    object->set_tx_ongoing(true);
+    EXPECT_EQ(LORAWAN_STATUS_BUSY, object->restore_session(session));
+}
+
 TEST_F(Test_LoRaMac, remove_single_channel)
 {
     EXPECT_EQ(LORAWAN_STATUS_OK, object->remove_single_channel(1));
@@ -344,7 +400,13 @@ TEST_F(Test_LoRaMac, on_radio_tx_timeout)
 
 TEST_F(Test_LoRaMac, on_radio_rx_timeout)
 {
-    object->on_radio_rx_timeout(true);
+    object->on_radio_rx_timeout(true, RX_SLOT_WIN_1);
+    object->on_radio_rx_timeout(false, RX_SLOT_WIN_2);
+}
+
+TEST_F(Test_LoRaMac, on_radio_rx_window_closed)
+{
+    EXPECT_EQ(RX_SLOT_WIN_1, object->on_radio_rx_window_closed());
 }
 
 TEST_F(Test_LoRaMac, continue_joining_process)
@@ -96,6 +96,12 @@ TEST_F(Test_LoRaMacCrypto, encrypt_payload)
     uint8_t enc[60];
     EXPECT_TRUE(-2 == object->encrypt_payload(buf, 20, NULL, 0, 0, 0, 0, enc));
 
+    // Key schedule is kept, only the two blocks are encrypted
+    aes_stub.int_zero_counter = 2;
+    aes_stub.int_value = -3;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 20, NULL, 0, 0, 0, 0, enc));
+
+    object->clear_keys();
     aes_stub.int_zero_counter = 2;
     aes_stub.int_value = -3;
     EXPECT_TRUE(-3 == object->encrypt_payload(buf, 20, NULL, 0, 0, 0, 0, enc));
@@ -176,3 +182,42 @@ TEST_F(Test_LoRaMacCrypto, compute_skeys_for_join_frame)
     aes_stub.int_value = 0;
     EXPECT_TRUE(0 == object->compute_skeys_for_join_frame(NULL, 0, nonce, 0, nwk_key, app_key));
 }
+
+TEST_F(Test_LoRaMacCrypto, key_schedules)
+{
+    uint8_t key1[16] = {1};
+    uint8_t key2[16] = {2};
+    uint8_t key3[16] = {3};
+    uint8_t buf[16];
+    uint8_t enc[16];
+
+    aes_stub.int_value = 0;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key1, 128, 0, 0, 0, enc));
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key2, 128, 0, 0, 0, enc));
+
+    // Both keys are expanded already, a failing setup isn't reached
+    aes_stub.int_zero_counter = 1;
+    aes_stub.int_value = -1;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key1, 128, 0, 0, 0, enc));
+    aes_stub.int_zero_counter = 1;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key2, 128, 0, 0, 0, enc));
+
+    // A third key replaces the oldest one
+    aes_stub.int_zero_counter = 2;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key3, 128, 0, 0, 0, enc));
+    aes_stub.int_zero_counter = 1;
+    EXPECT_TRUE(-1 == object->encrypt_payload(buf, 16, key1, 128, 0, 0, 0, enc));
+
+    // CMAC context is reset, not set up again
+    mbedtls_cipher_info_t info;
+    uint32_t mic;
+    cipher_stub.info_value = &info;
+    cipher_stub.int_value = 0;
+    cmac_stub.int_value = 0;
+    EXPECT_TRUE(0 == object->compute_join_frame_mic(buf, 16, key2, 128, &mic));
+    cipher_stub.int_value = -1;
+    EXPECT_TRUE(0 == object->compute_join_frame_mic(buf, 16, key2, 128, &mic));
+
+    object->clear_keys();
+    EXPECT_TRUE(-1 == object->compute_join_frame_mic(buf, 16, key2, 128, &mic));
+}
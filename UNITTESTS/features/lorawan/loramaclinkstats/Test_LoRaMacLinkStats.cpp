@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "LoRaMacLinkStats.h"
+#include "LoRaPHY_stub.h"
+#include "LoRaPHY.h"
+
+class my_LoRaPHY : public LoRaPHY {
+public:
+    my_LoRaPHY()
+    {
+    };
+
+    virtual ~my_LoRaPHY()
+    {
+    };
+};
+
+class Test_LoRaMacLinkStats : public testing::Test {
+protected:
+    LoRaMacLinkStats *object;
+    my_LoRaPHY phy;
+
+    virtual void SetUp()
+    {
+        object = new LoRaMacLinkStats();
+        object->activate_link_stats_subsystem(&phy);
+
+        LoRaPHY_stub::int8_value = 0;
+        LoRaPHY_stub::uint8_value = 0;
+        LoRaPHY_stub::bool_counter = 0;
+        memset(LoRaPHY_stub::bool_table, 0, sizeof(LoRaPHY_stub::bool_table));
+    }
+
+    virtual void TearDown()
+    {
+        delete object;
+    }
+};
+
+TEST_F(Test_LoRaMacLinkStats, constructor)
+{
+    EXPECT_TRUE(object);
+    EXPECT_FALSE(object->adr_policy_enabled());
+}
+
+TEST_F(Test_LoRaMacLinkStats, on_frame_sent)
+{
+    lorawan_link_stats_t stats;
+
+    object->on_frame_sent(1, 100);
+    object->on_frame_sent(1, 100);
+    object->on_frame_sent(200, 50);
+
+    object->get_link_stats(stats);
+    EXPECT_EQ(3, stats.tx_count);
+    EXPECT_EQ(250, stats.tx_airtime);
+
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->get_channel_stats(1, stats));
+    EXPECT_EQ(2, stats.tx_count);
+    EXPECT_EQ(200, stats.tx_airtime);
+
+    EXPECT_TRUE(LORAWAN_STATUS_PARAMETER_INVALID == object->get_channel_stats(200, stats));
+}
+
+TEST_F(Test_LoRaMacLinkStats, on_downlink)
+{
+    lorawan_link_stats_t stats;
+
+    LoRaPHY_stub::int8_value = -10;
+    object->on_downlink(2, 0, -80, 5);
+
+    object->get_link_stats(stats);
+    EXPECT_EQ(1, stats.rx_count);
+    EXPECT_EQ(-80, stats.rssi);
+    EXPECT_EQ(5, stats.snr);
+    EXPECT_EQ(15, stats.margin);
+
+    object->on_downlink(2, 0, -96, -3);
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->get_channel_stats(2, stats));
+    EXPECT_EQ(2, stats.rx_count);
+    EXPECT_EQ(-82, stats.rssi);
+    EXPECT_EQ(4, stats.snr);
+    EXPECT_EQ(14, stats.margin);
+}
+
+TEST_F(Test_LoRaMacLinkStats, on_uplink_done)
+{
+    lorawan_link_stats_t stats;
+
+    object->on_uplink_done(1, true, true);
+    object->on_uplink_done(1, true, false);
+    object->on_uplink_done(1, false, false);
+
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->get_channel_stats(1, stats));
+    EXPECT_EQ(2, stats.confirmed_count);
+    EXPECT_EQ(1, stats.ack_count);
+}
+
+TEST_F(Test_LoRaMacLinkStats, reset)
+{
+    lorawan_link_stats_t stats;
+
+    object->on_frame_sent(0, 100);
+    object->on_uplink_done(0, true, true);
+    object->reset();
+
+    object->get_link_stats(stats);
+    EXPECT_EQ(0, stats.tx_count);
+    EXPECT_EQ(0, stats.confirmed_count);
+}
+
+TEST_F(Test_LoRaMacLinkStats, get_next_ADR)
+{
+    int8_t dr = 0;
+    int8_t tx_power = 0;
+
+    object->enable_adr_policy(true);
+    EXPECT_TRUE(object->adr_policy_enabled());
+
+    // 20 dB of margin, 3 steps above the installation margin
+    LoRaPHY_stub::int8_value = -20;
+    object->on_downlink(0, 0, -100, 0);
+    object->on_downlink(0, 0, -100, 0);
+    EXPECT_FALSE(object->get_next_ADR(dr, tx_power));
+
+    object->on_downlink(0, 0, -100, 0);
+    LoRaPHY_stub::bool_table[0] = true;
+    LoRaPHY_stub::bool_table[1] = true;
+    LoRaPHY_stub::bool_table[2] = false;
+    LoRaPHY_stub::bool_table[3] = true;
+    EXPECT_TRUE(object->get_next_ADR(dr, tx_power));
+    EXPECT_EQ(2, dr);
+    EXPECT_EQ(1, tx_power);
+
+    // Acknowledgements lost, back to a lower datarate at full power
+    object->on_uplink_done(0, true, false);
+    object->on_uplink_done(0, true, false);
+    LoRaPHY_stub::int8_value = 1;
+    LoRaPHY_stub::uint8_value = 0;
+    EXPECT_TRUE(object->get_next_ADR(dr, tx_power));
+    EXPECT_EQ(1, dr);
+    EXPECT_EQ(0, tx_power);
+
+    EXPECT_FALSE(object->get_next_ADR(dr, tx_power));
+}
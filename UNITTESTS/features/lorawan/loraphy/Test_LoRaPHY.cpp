@@ -846,6 +846,14 @@ TEST_F(Test_LoRaPHY, get_max_payload)
     EXPECT_TRUE(8 == object->get_max_payload(0, true));
 }
 
+TEST_F(Test_LoRaPHY, get_demodulation_floor)
+{
+    uint8_t list[] = {12, 7};
+    object->get_phy_params().datarates.table = list;
+    EXPECT_EQ(-20, object->get_demodulation_floor(0));
+    EXPECT_EQ(-7, object->get_demodulation_floor(1));
+}
+
 TEST_F(Test_LoRaPHY, get_maximum_frame_counter_gap)
 {
     EXPECT_TRUE(0 == object->get_maximum_frame_counter_gap());
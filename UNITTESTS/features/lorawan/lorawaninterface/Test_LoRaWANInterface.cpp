@@ -170,6 +170,11 @@ TEST_F(Test_LoRaWANInterface, disconnect)
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->disconnect());
 }
 
+TEST_F(Test_LoRaWANInterface, forget_session)
+{
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->forget_session());
+}
+
 TEST_F(Test_LoRaWANInterface, add_link_check_request)
 {
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->add_link_check_request());
@@ -195,6 +200,16 @@ TEST_F(Test_LoRaWANInterface, disable_adaptive_datarate)
     object->disable_adaptive_datarate();
 }
 
+TEST_F(Test_LoRaWANInterface, enable_device_adr)
+{
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->enable_device_adr());
+}
+
+TEST_F(Test_LoRaWANInterface, disable_device_adr)
+{
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->disable_device_adr());
+}
+
 TEST_F(Test_LoRaWANInterface, set_confirmed_msg_retries)
 {
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->set_confirmed_msg_retries(1));
@@ -227,6 +242,15 @@ TEST_F(Test_LoRaWANInterface, send)
     EXPECT_TRUE(0 == object->send(1, NULL, 0, 0));
 }
 
+TEST_F(Test_LoRaWANInterface, send_aggregated)
+{
+    uint8_t data[4] = {0};
+    EXPECT_TRUE(0 == object->send_aggregated(1, data, sizeof(data), MSG_UNCONFIRMED_FLAG));
+
+    lorawan_aggregation_stats_t stats;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->get_aggregation_stats(stats));
+}
+
 TEST_F(Test_LoRaWANInterface, receive)
 {
     EXPECT_TRUE(0 == object->receive(1, NULL, 0, 0));
@@ -265,6 +289,14 @@ TEST_F(Test_LoRaWANInterface, get_backoff_metadata)
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->get_backoff_metadata(i));
 }
 
+TEST_F(Test_LoRaWANInterface, get_link_stats)
+{
+    lorawan_link_stats_t stats;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->get_link_stats(stats));
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->get_channel_stats(0, stats));
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->reset_link_stats());
+}
+
 TEST_F(Test_LoRaWANInterface, cancel_sending)
 {
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->cancel_sending());
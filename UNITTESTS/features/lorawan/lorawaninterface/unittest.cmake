@@ -38,6 +38,7 @@ set(unittest-test-sources
   stubs/mbed_assert_stub.c
   stubs/LoRaMacCrypto_stub.cpp
   stubs/LoRaMacChannelPlan_stub.cpp
+  stubs/LoRaMacLinkStats_stub.cpp
   stubs/LoRaWANTimer_stub.cpp
   stubs/LoRaMacCommand_stub.cpp
   stubs/LoRaPHYEU868_stub.cpp
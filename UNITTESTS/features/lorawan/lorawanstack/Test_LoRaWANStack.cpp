@@ -382,6 +382,32 @@ TEST_F(Test_LoRaWANStack, enable_adaptive_datarate)
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->enable_adaptive_datarate(false));
 }
 
+TEST_F(Test_LoRaWANStack, enable_device_adr)
+{
+    EXPECT_TRUE(LORAWAN_STATUS_NOT_INITIALIZED == object->enable_device_adr(true));
+
+    EventQueue queue;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->initialize_mac_layer(&queue));
+
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->enable_device_adr(true));
+}
+
+TEST_F(Test_LoRaWANStack, link_stats)
+{
+    lorawan_link_stats_t stats;
+    EXPECT_TRUE(LORAWAN_STATUS_NOT_INITIALIZED == object->acquire_link_stats(stats));
+    EXPECT_TRUE(LORAWAN_STATUS_NOT_INITIALIZED == object->acquire_channel_stats(0, stats));
+    EXPECT_TRUE(LORAWAN_STATUS_NOT_INITIALIZED == object->reset_link_stats());
+
+    EventQueue queue;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->initialize_mac_layer(&queue));
+
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->acquire_link_stats(stats));
+    LoRaMac_stub::status_value = LORAWAN_STATUS_PARAMETER_INVALID;
+    EXPECT_TRUE(LORAWAN_STATUS_PARAMETER_INVALID == object->acquire_channel_stats(200, stats));
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->reset_link_stats());
+}
+
 TEST_F(Test_LoRaWANStack, handle_tx)
 {
     EXPECT_TRUE(LORAWAN_STATUS_NOT_INITIALIZED == object->handle_tx(0, NULL, 0, 0, true, false));
@@ -431,6 +457,68 @@ TEST_F(Test_LoRaWANStack, handle_tx)
 
 }
 
+TEST_F(Test_LoRaWANStack, send_aggregated)
+{
+    uint8_t data[60] = {0};
+    lorawan_aggregation_stats_t stats;
+
+    EXPECT_TRUE(LORAWAN_STATUS_NOT_INITIALIZED == object->send_aggregated(1, data, 4, MSG_UNCONFIRMED_FLAG));
+    EXPECT_TRUE(LORAWAN_STATUS_NOT_INITIALIZED == object->acquire_aggregation_stats(stats));
+
+    EventQueue queue;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->initialize_mac_layer(&queue));
+
+    EXPECT_TRUE(LORAWAN_STATUS_PARAMETER_INVALID == object->send_aggregated(1, NULL, 4, MSG_UNCONFIRMED_FLAG));
+    EXPECT_TRUE(LORAWAN_STATUS_PARAMETER_INVALID == object->send_aggregated(1, data, 0, MSG_UNCONFIRMED_FLAG));
+    EXPECT_TRUE(LORAWAN_STATUS_NO_ACTIVE_SESSIONS == object->send_aggregated(1, data, 4, MSG_UNCONFIRMED_FLAG));
+
+    lorawan_connect_t conn;
+    conn.connect_type = LORAWAN_CONNECTION_ABP;
+    LoRaMac_stub::status_value = LORAWAN_STATUS_OK;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->connect(conn));
+
+    EXPECT_TRUE(LORAWAN_STATUS_PORT_INVALID == object->send_aggregated(0, data, 4, MSG_UNCONFIRMED_FLAG));
+    EXPECT_TRUE(LORAWAN_STATUS_PARAMETER_INVALID == object->send_aggregated(1, data, 4, MSG_PROPRIETARY_FLAG));
+
+    LoRaMac_stub::tx_size_value = 51;
+    EXPECT_TRUE(LORAWAN_STATUS_LENGTH_ERROR == object->send_aggregated(1, data, 51, MSG_UNCONFIRMED_FLAG));
+
+    // MAC busy, messages wait in the next frame
+    LoRaMac_stub::bool_value = true;
+    EXPECT_TRUE(20 == object->send_aggregated(1, data, 20, MSG_UNCONFIRMED_FLAG));
+    EXPECT_TRUE(20 == object->send_aggregated(1, data, 20, MSG_UNCONFIRMED_FLAG));
+    EXPECT_TRUE(LORAWAN_STATUS_WOULD_BLOCK == object->send_aggregated(2, data, 4, MSG_UNCONFIRMED_FLAG));
+    EXPECT_TRUE(LORAWAN_STATUS_WOULD_BLOCK == object->send_aggregated(1, data, 4, MSG_CONFIRMED_FLAG));
+    EXPECT_TRUE(LORAWAN_STATUS_WOULD_BLOCK == object->send_aggregated(1, data, 9, MSG_UNCONFIRMED_FLAG));
+    EXPECT_TRUE(8 == object->send_aggregated(1, data, 8, MSG_UNCONFIRMED_FLAG));
+
+    // Cancelling drops the queued messages
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->stop_sending());
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->acquire_aggregation_stats(stats));
+    EXPECT_TRUE(3 == stats.dropped);
+
+    // MAC free, the frame is handed over
+    LoRaMac_stub::bool_false_counter = 1;
+    EXPECT_TRUE(4 == object->send_aggregated(2, data, 4, MSG_UNCONFIRMED_FLAG));
+
+    // The frame waits for its backoff, it is cancelled and grown
+    LoRaMac_stub::bool_false_counter = 1;
+    EXPECT_TRUE(4 == object->send_aggregated(2, data, 4, MSG_UNCONFIRMED_FLAG));
+
+    // The frame cannot be cancelled, the message goes to the next frame
+    LoRaMac_stub::status_value = LORAWAN_STATUS_BUSY;
+    EXPECT_TRUE(40 == object->send_aggregated(2, data, 40, MSG_UNCONFIRMED_FLAG));
+    EXPECT_TRUE(LORAWAN_STATUS_BUSY == object->stop_sending());
+
+    LoRaMac_stub::status_value = LORAWAN_STATUS_OK;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->stop_sending());
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->acquire_aggregation_stats(stats));
+    EXPECT_TRUE(6 == stats.dropped);
+    EXPECT_TRUE(0 == stats.uplinks);
+
+    LoRaMac_stub::bool_value = false;
+}
+
 TEST_F(Test_LoRaWANStack, handle_rx)
 {
     uint8_t port;
@@ -729,6 +817,12 @@ TEST_F(Test_LoRaWANStack, stop_sending)
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->stop_sending());
 }
 
+TEST_F(Test_LoRaWANStack, forget_session)
+{
+    // lora.session-persistence is not enabled
+    EXPECT_TRUE(LORAWAN_STATUS_UNSUPPORTED == object->forget_session());
+}
+
 TEST_F(Test_LoRaWANStack, lock)
 {
     object->lock();
@@ -396,6 +396,16 @@ TEST_F(TestDTLSSocketWrapper, getsockopt)
 
 /* unsupported */
 
+TEST_F(TestDTLSSocketWrapper, set_connection_id_unsupported)
+{
+    const unsigned char cid[] = {1, 2, 3, 4};
+    EXPECT_EQ(wrapper->set_connection_id(cid, sizeof(cid)), NSAPI_ERROR_UNSUPPORTED);
+    transport->open((NetworkStack *)&stack);
+    const SocketAddress a("127.0.0.1", 1024);
+    stack.return_socketAddress = a;
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+}
+
 TEST_F(TestDTLSSocketWrapper, listen_unsupported)
 {
     EXPECT_EQ(wrapper->listen(1), NSAPI_ERROR_UNSUPPORTED);
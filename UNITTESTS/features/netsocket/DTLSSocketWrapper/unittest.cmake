@@ -7,7 +7,9 @@ set(unittest-sources
   ../features/netsocket/SocketAddress.cpp
   ../features/netsocket/NetworkStack.cpp
   ../features/netsocket/InternetSocket.cpp
+  ../features/netsocket/SocketSet.cpp
   ../features/netsocket/UDPSocket.cpp
+  ../features/netsocket/NetStackBuffer.cpp
   ../features/netsocket/DTLSSocketWrapper.cpp
   ../features/netsocket/TLSSocketWrapper.cpp
   ../features/frameworks/nanostack-libservice/source/libip4string/ip4tos.c
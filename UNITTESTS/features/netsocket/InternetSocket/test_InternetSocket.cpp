@@ -53,6 +53,16 @@ public:
     {
         return return_value;
     }
+    virtual nsapi_size_or_error_t sendmsg(const SocketAddress *address,
+                                          const nsapi_iovec_t *iov, unsigned iovcnt)
+    {
+        return return_value;
+    }
+    virtual nsapi_size_or_error_t recvmsg(SocketAddress *address,
+                                          nsapi_iovec_t *iov, unsigned iovcnt)
+    {
+        return return_value;
+    }
     virtual Socket *accept(nsapi_error_t *error = NULL)
     {
         return NULL;
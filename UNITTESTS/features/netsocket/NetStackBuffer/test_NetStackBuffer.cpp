@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "features/netsocket/NetStackBuffer.h"
+#include "features/netsocket/NetStackMemoryManager.h"
+#include <string.h>
+
+// Chain of fixed segments, counting frees
+struct test_segment {
+    const char *data;
+    uint32_t len;
+    test_segment *next;
+};
+
+class TestMemoryManager : public NetStackMemoryManager {
+public:
+    int freed;
+
+    TestMemoryManager() : freed(0) {}
+
+    virtual net_stack_mem_buf_t *alloc_heap(uint32_t size, uint32_t align)
+    {
+        return NULL;
+    }
+    virtual net_stack_mem_buf_t *alloc_pool(uint32_t size, uint32_t align)
+    {
+        return NULL;
+    }
+    virtual uint32_t get_pool_alloc_unit(uint32_t align) const
+    {
+        return 0;
+    }
+    virtual void free(net_stack_mem_buf_t *buf)
+    {
+        freed++;
+    }
+    virtual uint32_t get_total_len(const net_stack_mem_buf_t *buf) const
+    {
+        uint32_t len = 0;
+        for (const test_segment *seg = static_cast<const test_segment *>(buf); seg; seg = seg->next) {
+            len += seg->len;
+        }
+        return len;
+    }
+    virtual void copy(net_stack_mem_buf_t *to_buf, const net_stack_mem_buf_t *from_buf) {}
+    virtual void cat(net_stack_mem_buf_t *to_buf, net_stack_mem_buf_t *cat_buf) {}
+    virtual net_stack_mem_buf_t *get_next(const net_stack_mem_buf_t *buf) const
+    {
+        return static_cast<const test_segment *>(buf)->next;
+    }
+    virtual void *get_ptr(const net_stack_mem_buf_t *buf) const
+    {
+        return const_cast<char *>(static_cast<const test_segment *>(buf)->data);
+    }
+    virtual uint32_t get_len(const net_stack_mem_buf_t *buf) const
+    {
+        return static_cast<const test_segment *>(buf)->len;
+    }
+    virtual void set_len(net_stack_mem_buf_t *buf, uint32_t len) {}
+};
+
+class TestNetStackBuffer : public testing::Test {
+protected:
+    TestMemoryManager mm;
+    test_segment seg2;
+    test_segment seg1;
+
+    virtual void SetUp()
+    {
+        seg2 = { "World", 5, NULL };
+        seg1 = { "Hello ", 6, &seg2 };
+    }
+};
+
+TEST_F(TestNetStackBuffer, empty)
+{
+    NetStackBuffer buf;
+    EXPECT_EQ(buf.size(), 0);
+    EXPECT_EQ(buf.head(), static_cast<const net_stack_mem_buf_t *>(NULL));
+    buf.release();
+}
+
+TEST_F(TestNetStackBuffer, segments)
+{
+    NetStackBuffer buf;
+    buf.attach(&mm, &seg1);
+    EXPECT_EQ(buf.size(), 11);
+
+    const net_stack_mem_buf_t *seg = buf.head();
+    EXPECT_EQ(buf.data(seg).size(), 6);
+    EXPECT_EQ(memcmp(buf.data(seg).data(), "Hello ", 6), 0);
+    seg = buf.next(seg);
+    EXPECT_EQ(buf.data(seg).size(), 5);
+    EXPECT_EQ(memcmp(buf.data(seg).data(), "World", 5), 0);
+    EXPECT_EQ(buf.next(seg), static_cast<const net_stack_mem_buf_t *>(NULL));
+}
+
+TEST_F(TestNetStackBuffer, copy_across_segments)
+{
+    NetStackBuffer buf;
+    buf.attach(&mm, &seg1);
+
+    char out[12] = { 0 };
+    EXPECT_EQ(buf.copy(out, 4, 4), 4);
+    EXPECT_STREQ(out, "o Wo");
+
+    memset(out, 0, sizeof(out));
+    EXPECT_EQ(buf.copy(out, sizeof(out)), 11);
+    EXPECT_STREQ(out, "Hello World");
+
+    EXPECT_EQ(buf.copy(out, 4, 11), 0);
+}
+
+TEST_F(TestNetStackBuffer, release)
+{
+    {
+        NetStackBuffer buf;
+        buf.attach(&mm, &seg1);
+        buf.release();
+        EXPECT_EQ(mm.freed, 1);
+        EXPECT_EQ(buf.size(), 0);
+        buf.release();
+        EXPECT_EQ(mm.freed, 1);
+
+        buf.attach(&mm, &seg1);
+        buf.attach(&mm, &seg2);
+        EXPECT_EQ(mm.freed, 2);
+    }
+    // Destructor releases the held chain
+    EXPECT_EQ(mm.freed, 3);
+}
@@ -0,0 +1,19 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Unit test suite name
+set(TEST_SUITE_NAME "features_netsocket_NetStackBuffer")
+
+# Source files
+set(unittest-sources
+  ../features/netsocket/NetStackBuffer.cpp
+  ../features/netsocket/NetStackMemoryManager.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  features/netsocket/NetStackBuffer/test_NetStackBuffer.cpp
+  stubs/mbed_assert_stub.c
+)
@@ -79,7 +79,8 @@ class NetworkStackChild : public NetworkStack {
     virtual nsapi_size_or_error_t socket_send(nsapi_socket_t handle,
                                               const void *data, nsapi_size_t size)
     {
-        return NSAPI_ERROR_OK;
+        sent.append(static_cast<const char *>(data), size);
+        return size;
     }
     virtual nsapi_size_or_error_t socket_recv(nsapi_socket_t handle,
                                               void *data, nsapi_size_t size)
@@ -89,18 +90,34 @@ class NetworkStackChild : public NetworkStack {
     virtual nsapi_size_or_error_t socket_sendto(nsapi_socket_t handle, const SocketAddress &address,
                                                 const void *data, nsapi_size_t size)
     {
-        return NSAPI_ERROR_OK;
+        sent_packets++;
+        sent.append(static_cast<const char *>(data), size);
+        return size;
     }
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                                   void *buffer, nsapi_size_t size)
     {
-        return NSAPI_ERROR_OK;
+        size_t len = recv_data.size() < size ? recv_data.size() : size;
+        memcpy(buffer, recv_data.data(), len);
+        return recv_data.size();
     }
     virtual void socket_attach(nsapi_socket_t handle, void (*callback)(void *), void *data)
     {
     }
 public:
     std::string ip_address;
+    std::string sent;
+    int sent_packets = 0;
+    std::string recv_data;
+
+    nsapi_size_or_error_t sendmsg(const SocketAddress *address, const nsapi_iovec_t *iov, unsigned iovcnt)
+    {
+        return socket_sendmsg(NULL, address, iov, iovcnt);
+    }
+    nsapi_size_or_error_t recvmsg(SocketAddress *address, nsapi_iovec_t *iov, unsigned iovcnt)
+    {
+        return socket_recvmsg(NULL, address, iov, iovcnt);
+    }
     const char *get_ip_address()
     {
         return ip_address.c_str();
@@ -228,6 +245,41 @@ TEST_F(TestNetworkStack, gethostbyname_async_empty_host)
     EXPECT_EQ(stack->gethostbyname_async("", mbed::callback(my_callback), NSAPI_UNSPEC), NSAPI_ERROR_PARAMETER);
 }
 
+/* sendmsg/recvmsg fallbacks */
+TEST_F(TestNetworkStack, sendmsg_datagram_gathered)
+{
+    SocketAddress a("127.0.0.1", 1024);
+    char first[] = "ab";
+    char second[] = "cde";
+    nsapi_iovec_t iov[] = { { first, 2 }, { second, 3 } };
+    EXPECT_EQ(stack->sendmsg(&a, iov, 2), 5);
+    EXPECT_EQ(stack->sendmsg(&a, iov, 1), 2);
+    EXPECT_EQ(stack->sent_packets, 2);
+    EXPECT_EQ(stack->sent, "abcdeab");
+}
+
+TEST_F(TestNetworkStack, sendmsg_stream)
+{
+    char first[] = "ab";
+    char second[] = "cde";
+    nsapi_iovec_t iov[] = { { first, 2 }, { second, 3 } };
+    EXPECT_EQ(stack->sendmsg(NULL, iov, 2), 5);
+    EXPECT_EQ(stack->sent_packets, 0);
+    EXPECT_EQ(stack->sent, "abcde");
+}
+
+TEST_F(TestNetworkStack, recvmsg_datagram_scattered)
+{
+    SocketAddress a;
+    char first[2] = {};
+    char second[8] = {};
+    nsapi_iovec_t iov[] = { { first, sizeof first }, { second, sizeof second } };
+    stack->recv_data = "hello";
+    EXPECT_EQ(stack->recvmsg(&a, iov, 2), 5);
+    EXPECT_EQ(std::string(first, 2), "he");
+    EXPECT_EQ(std::string(second), "llo");
+}
+
 TEST_F(TestNetworkStack, getstackopt)
 {
     EXPECT_EQ(stack->getstackopt(0, 0, 0, 0), NSAPI_ERROR_UNSUPPORTED);
@@ -164,3 +164,25 @@ TEST_F(TestSocketAddress, bool_operator_ip6_true)
 
 
 
+
+TEST_F(TestSocketAddress, get_ip_address_buffer)
+{
+    char buf[NSAPI_IP_SIZE];
+    EXPECT_EQ(NULL, address->get_ip_address(buf));
+
+    SocketAddress addr("127.0.0.1", 80);
+    EXPECT_EQ(buf, addr.get_ip_address(buf));
+    EXPECT_EQ(std::string("127.0.0.1"), std::string(buf));
+}
+
+TEST_F(TestSocketAddress, set_addr_keeps_text_of_same_address)
+{
+    SocketAddress addr("127.0.0.1", 80);
+    const char *text = addr.get_ip_address();
+
+    addr.set_addr(SocketAddress("127.0.0.1").get_addr());
+    EXPECT_EQ(text, addr.get_ip_address());
+
+    addr.set_addr(SocketAddress("127.0.0.2").get_addr());
+    EXPECT_EQ(std::string("127.0.0.2"), std::string(addr.get_ip_address()));
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "features/netsocket/TCPSocket.h"
+#include "features/netsocket/SocketSet.h"
+#include "NetworkStack_stub.h"
+
+// Control the rtos EventFlags stub. See EventFlags_stub.cpp
+extern std::list<uint32_t> eventFlagsStubNextRetval;
+
+// To raise socket events
+class TCPSocketFriend : public TCPSocket {
+public:
+    using TCPSocket::event;
+};
+
+class TestSocketSet : public testing::Test {
+protected:
+    TCPSocketFriend socket1;
+    TCPSocketFriend socket2;
+    TCPSocketFriend socket3;
+    SocketSet set;
+    InternetSocket *ready[3];
+
+    virtual void TearDown()
+    {
+        eventFlagsStubNextRetval.clear();
+    }
+};
+
+TEST_F(TestSocketSet, add_remove)
+{
+    SocketSet other;
+
+    EXPECT_EQ(set.remove(&socket1), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(set.add(&socket1), NSAPI_ERROR_OK);
+    EXPECT_EQ(set.add(&socket1), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(other.add(&socket1), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(other.remove(&socket1), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(set.size(), 1);
+
+    EXPECT_EQ(set.remove(&socket1), NSAPI_ERROR_OK);
+    EXPECT_EQ(set.size(), 0);
+    EXPECT_EQ(other.add(&socket1), NSAPI_ERROR_OK);
+}
+
+TEST_F(TestSocketSet, full)
+{
+    TCPSocket sockets[SocketSet::MAX_SOCKETS];
+    for (unsigned i = 0; i < SocketSet::MAX_SOCKETS; i++) {
+        EXPECT_EQ(set.add(&sockets[i]), NSAPI_ERROR_OK);
+    }
+    EXPECT_EQ(set.add(&socket1), NSAPI_ERROR_NO_MEMORY);
+
+    for (unsigned i = 0; i < SocketSet::MAX_SOCKETS; i++) {
+        EXPECT_EQ(set.remove(&sockets[i]), NSAPI_ERROR_OK);
+    }
+}
+
+TEST_F(TestSocketSet, added_socket_reported)
+{
+    set.add(&socket1);
+    EXPECT_EQ(set.wait(ready, 3, 0), 1);
+    EXPECT_EQ(ready[0], &socket1);
+
+    EXPECT_EQ(set.wait(ready, 3, 0), 0);
+}
+
+TEST_F(TestSocketSet, event_reported)
+{
+    set.add(&socket1);
+    set.add(&socket2);
+    set.wait(ready, 3, 0);
+
+    socket2.event();
+    EXPECT_EQ(set.wait(ready, 3, -1), 1);
+    EXPECT_EQ(ready[0], &socket2);
+}
+
+TEST_F(TestSocketSet, reported_in_turn)
+{
+    set.add(&socket1);
+    set.add(&socket2);
+    set.add(&socket3);
+
+    EXPECT_EQ(set.wait(ready, 1, 0), 1);
+    EXPECT_EQ(ready[0], &socket1);
+    socket1.event();
+    EXPECT_EQ(set.wait(ready, 1, 0), 1);
+    EXPECT_EQ(ready[0], &socket2);
+    EXPECT_EQ(set.wait(ready, 1, 0), 1);
+    EXPECT_EQ(ready[0], &socket3);
+    EXPECT_EQ(set.wait(ready, 1, 0), 1);
+    EXPECT_EQ(ready[0], &socket1);
+
+    socket2.event();
+    socket3.event();
+    EXPECT_EQ(set.wait(ready, 3, 0), 2);
+    EXPECT_EQ(ready[0], &socket2);
+    EXPECT_EQ(ready[1], &socket3);
+}
+
+TEST_F(TestSocketSet, remove_keeps_events)
+{
+    set.add(&socket1);
+    set.add(&socket2);
+    set.add(&socket3);
+    set.wait(ready, 3, 0);
+
+    // socket3 is moved into the slot of socket1
+    socket3.event();
+    set.remove(&socket1);
+    EXPECT_EQ(set.wait(ready, 3, 0), 1);
+    EXPECT_EQ(ready[0], &socket3);
+
+    socket1.event();
+    EXPECT_EQ(set.wait(ready, 3, 0), 0);
+}
+
+TEST_F(TestSocketSet, timeout)
+{
+    set.add(&socket1);
+    set.wait(ready, 3, 0);
+
+    eventFlagsStubNextRetval.push_back(osFlagsErrorTimeout);
+    EXPECT_EQ(set.wait(ready, 3, -1), 0);
+}
+
+TEST_F(TestSocketSet, close_removes)
+{
+    NetworkStackstub stack;
+    socket1.open((NetworkStack *)&stack);
+    set.add(&socket1);
+
+    socket1.close();
+    EXPECT_EQ(set.size(), 0);
+}
+
+TEST_F(TestSocketSet, destructor_removes)
+{
+    {
+        SocketSet other;
+        other.add(&socket1);
+    }
+    EXPECT_EQ(set.add(&socket1), NSAPI_ERROR_OK);
+}
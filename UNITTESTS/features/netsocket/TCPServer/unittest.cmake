@@ -10,6 +10,7 @@ set(unittest-sources
   ../features/netsocket/SocketAddress.cpp
   ../features/netsocket/NetworkStack.cpp
   ../features/netsocket/InternetSocket.cpp
+  ../features/netsocket/SocketSet.cpp
   ../features/netsocket/TCPSocket.cpp
   ../features/netsocket/TCPServer.cpp
   ../features/frameworks/nanostack-libservice/source/libip4string/ip4tos.c
@@ -30,6 +31,7 @@ set(unittest-test-sources
   stubs/mbed_shared_queues_stub.cpp
   stubs/nsapi_dns_stub.cpp
   stubs/EventFlags_stub.cpp
+  stubs/Kernel_stub.cpp
   features/netsocket/TCPServer/test_TCPServer.cpp
   stubs/SocketStats_Stub.cpp
 )
@@ -152,6 +152,25 @@ TEST_F(TestTCPSocket, send_in_two_chunks)
     EXPECT_EQ(socket->send(dataBuf, dataSize), dataSize);
 }
 
+TEST_F(TestTCPSocket, sendmsg_two_buffers)
+{
+    nsapi_iovec_t iov[] = { { dataBuf, 4 }, { dataBuf + 4, dataSize - 4 } };
+    socket->open((NetworkStack *)&stack);
+    stack.return_values.push_back(4);
+    stack.return_values.push_back(dataSize - 4);
+    EXPECT_EQ(socket->sendmsg(NULL, iov, 2), dataSize);
+}
+
+TEST_F(TestTCPSocket, sendmsg_partial_buffer)
+{
+    nsapi_iovec_t iov[] = { { dataBuf, 4 }, { dataBuf + 4, dataSize - 4 } };
+    socket->open((NetworkStack *)&stack);
+    stack.return_values.push_back(2);
+    stack.return_values.push_back(2);
+    stack.return_values.push_back(dataSize - 4);
+    EXPECT_EQ(socket->sendmsg(NULL, iov, 2), dataSize);
+}
+
 TEST_F(TestTCPSocket, send_error_would_block)
 {
     socket->open((NetworkStack *)&stack);
@@ -206,6 +225,16 @@ TEST_F(TestTCPSocket, recv_less_than_expected)
     EXPECT_EQ(socket->recv(dataBuf, dataSize), lessThanDataSize);
 }
 
+TEST_F(TestTCPSocket, recv_buf_unsupported)
+{
+    NetStackBuffer buf;
+    EXPECT_EQ(socket->recv_buf(buf), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open((NetworkStack *)&stack);
+    EXPECT_EQ(socket->recv_buf(buf), NSAPI_ERROR_UNSUPPORTED);
+    EXPECT_EQ(buf.size(), 0);
+}
+
 TEST_F(TestTCPSocket, recv_would_block)
 {
     socket->open((NetworkStack *)&stack);
@@ -244,6 +273,15 @@ TEST_F(TestTCPSocket, recv_from_null)
 
 /* listen */
 
+TEST_F(TestTCPSocket, recvmsg_two_buffers)
+{
+    nsapi_iovec_t iov[] = { { dataBuf, 4 }, { dataBuf + 4, dataSize - 4 } };
+    socket->open((NetworkStack *)&stack);
+    stack.return_values.push_back(4);
+    stack.return_values.push_back(2);
+    EXPECT_EQ(socket->recvmsg(NULL, iov, 2), 6);
+}
+
 TEST_F(TestTCPSocket, listen_no_open)
 {
     stack.return_value = NSAPI_ERROR_OK;
@@ -280,6 +318,24 @@ TEST_F(TestTCPSocket, accept)
     }
 }
 
+TEST_F(TestTCPSocket, accept_into_socket)
+{
+    TCPSocket connection;
+    SocketAddress address;
+    EXPECT_EQ(socket->accept(connection, &address), NSAPI_ERROR_NO_SOCKET);
+
+    stack.return_value = NSAPI_ERROR_OK;
+    socket->open((NetworkStack *)&stack);
+    EXPECT_EQ(socket->accept(connection, &address), NSAPI_ERROR_OK);
+
+    // Only a closed socket can take a new connection
+    EXPECT_EQ(socket->accept(connection), NSAPI_ERROR_PARAMETER);
+
+    EXPECT_EQ(connection.close(), NSAPI_ERROR_OK);
+    EXPECT_EQ(socket->accept(connection), NSAPI_ERROR_OK);
+    EXPECT_EQ(connection.close(), NSAPI_ERROR_OK);
+}
+
 TEST_F(TestTCPSocket, accept_would_block)
 {
     nsapi_error_t error;
@@ -115,6 +115,41 @@ TEST_F(TestTLSSocketWrapper, connect)
     EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_IS_CONNECTED);
 }
 
+TEST_F(TestTLSSocketWrapper, set_max_fragment_length)
+{
+    EXPECT_EQ(wrapper->set_max_fragment_length(0), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->set_max_fragment_length(512), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->set_max_fragment_length(4096), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->set_max_fragment_length(1000), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(wrapper->set_max_fragment_length(16384), NSAPI_ERROR_PARAMETER);
+
+    mbedtls_stub.expected_int = MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    EXPECT_EQ(wrapper->set_max_fragment_length(1024), NSAPI_ERROR_PARAMETER);
+}
+
+TEST_F(TestTLSSocketWrapper, get_session)
+{
+    mbedtls_ssl_session session;
+    EXPECT_EQ(wrapper->get_session(&session), NSAPI_ERROR_NO_CONNECTION);
+
+    transport->open((NetworkStack *)&stack);
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->get_session(&session), NSAPI_ERROR_OK);
+
+    mbedtls_stub.expected_int = MBEDTLS_ERR_SSL_ALLOC_FAILED;
+    EXPECT_EQ(wrapper->get_session(&session), NSAPI_ERROR_NO_MEMORY);
+}
+
+TEST_F(TestTLSSocketWrapper, connect_set_session)
+{
+    mbedtls_ssl_session session;
+    wrapper->set_session(&session);
+    transport->open((NetworkStack *)&stack);
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+}
+
 /* connect: TCP-related errors */
 
 TEST_F(TestTLSSocketWrapper, connect_no_open)
@@ -76,6 +76,26 @@ TEST_F(TestUDPSocket, sendto_addr_port)
     EXPECT_EQ(socket->sendto("127.0.0.1", 0, 0, 0), 0);
 }
 
+TEST_F(TestUDPSocket, sendmsg)
+{
+    char header[] = "ab";
+    char payload[] = "cde";
+    nsapi_iovec_t iov[] = { { header, 2 }, { payload, 3 } };
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(socket->sendmsg(&a, iov, 2), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open((NetworkStack *)&stack);
+
+    // Not connected
+    EXPECT_EQ(socket->sendmsg(NULL, iov, 2), NSAPI_ERROR_NO_ADDRESS);
+
+    stack.return_value = 5;
+    EXPECT_EQ(socket->sendmsg(&a, iov, 2), 5);
+
+    EXPECT_EQ(socket->connect(a), NSAPI_ERROR_OK);
+    EXPECT_EQ(socket->sendmsg(NULL, iov, 2), 5);
+}
+
 TEST_F(TestUDPSocket, connect)
 {
     stack.return_value = NSAPI_ERROR_OK;
@@ -142,6 +162,91 @@ TEST_F(TestUDPSocket, recv_address_filtering)
     EXPECT_EQ(socket->recvfrom(&a1, &dataBuf, dataSize), 100);
 }
 
+TEST_F(TestUDPSocket, recvfrom_buf_unsupported)
+{
+    NetStackBuffer buf;
+    EXPECT_EQ(socket->recvfrom_buf(NULL, buf), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open((NetworkStack *)&stack);
+    EXPECT_EQ(socket->recvfrom_buf(NULL, buf), NSAPI_ERROR_UNSUPPORTED);
+    EXPECT_EQ(buf.head(), static_cast<const net_stack_mem_buf_t *>(NULL));
+}
+
+TEST_F(TestUDPSocket, sendto_batch)
+{
+    const SocketAddress a("127.0.0.1", 1024);
+    nsapi_msg_t msgs[3];
+    for (int i = 0; i < 3; i++) {
+        msgs[i].address = a;
+        msgs[i].data = dataBuf;
+        msgs[i].size = dataSize;
+    }
+    EXPECT_EQ(socket->sendto_batch(msgs, 3), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open((NetworkStack *)&stack);
+
+    stack.return_value = dataSize;
+    EXPECT_EQ(socket->sendto_batch(msgs, 3), 3);
+    EXPECT_EQ(msgs[2].result, dataSize);
+
+    stack.return_value = NSAPI_ERROR_NO_MEMORY;
+    EXPECT_EQ(socket->sendto_batch(msgs, 3), NSAPI_ERROR_NO_MEMORY);
+    EXPECT_EQ(msgs[0].result, NSAPI_ERROR_NO_MEMORY);
+}
+
+TEST_F(TestUDPSocket, recvfrom_batch)
+{
+    char bufs[3][10];
+    nsapi_msg_t msgs[3];
+    for (int i = 0; i < 3; i++) {
+        msgs[i].data = bufs[i];
+        msgs[i].size = sizeof(bufs[i]);
+    }
+    EXPECT_EQ(socket->recvfrom_batch(msgs, 3), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open((NetworkStack *)&stack);
+
+    // Stops at the first packet that isn't there
+    stack.return_values.push_back(4);
+    stack.return_values.push_back(6);
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(socket->recvfrom_batch(msgs, 3), 2);
+    EXPECT_EQ(msgs[0].result, 4);
+    EXPECT_EQ(msgs[1].result, 6);
+
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(0);
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->recvfrom_batch(msgs, 3), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestUDPSocket, recvfrom_batch_address_filtering)
+{
+    socket->open((NetworkStack *)&stack);
+    const nsapi_addr_t addr1 = {NSAPI_IPv4, {127, 0, 0, 1} };
+    const nsapi_addr_t addr2 = {NSAPI_IPv4, {127, 0, 0, 2} };
+    SocketAddress a1(addr1, 1024);
+    SocketAddress a2(addr2, 1024);
+
+    EXPECT_EQ(socket->connect(a1), NSAPI_ERROR_OK);
+
+    // The stub leaves the addresses as they are, the second one is dropped
+    char bufs[3][10] = { "first", "second", "third" };
+    nsapi_msg_t msgs[3];
+    for (int i = 0; i < 3; i++) {
+        msgs[i].address = i == 1 ? a2 : a1;
+        msgs[i].data = bufs[i];
+        msgs[i].size = sizeof(bufs[i]);
+    }
+    stack.return_values.push_back(6);
+    stack.return_values.push_back(7);
+    stack.return_values.push_back(6);
+    EXPECT_EQ(socket->recvfrom_batch(msgs, 3), 2);
+    EXPECT_EQ(msgs[1].address, a1);
+    EXPECT_EQ(msgs[1].result, 6);
+    EXPECT_STREQ(bufs[1], "third");
+}
+
 TEST_F(TestUDPSocket, unsupported_api)
 {
     nsapi_error_t error;
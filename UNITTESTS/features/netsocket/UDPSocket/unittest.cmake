@@ -7,7 +7,9 @@ set(unittest-sources
   ../features/netsocket/SocketAddress.cpp
   ../features/netsocket/NetworkStack.cpp
   ../features/netsocket/InternetSocket.cpp
+  ../features/netsocket/SocketSet.cpp
   ../features/netsocket/UDPSocket.cpp
+  ../features/netsocket/NetStackBuffer.cpp
   ../features/frameworks/nanostack-libservice/source/libip4string/ip4tos.c
   ../features/frameworks/nanostack-libservice/source/libip6string/ip6tos.c
   ../features/frameworks/nanostack-libservice/source/libip4string/stoip4.c
@@ -26,6 +28,7 @@ set(unittest-test-sources
   stubs/mbed_error.c
   stubs/mbed_shared_queues_stub.cpp
   stubs/EventFlags_stub.cpp
+  stubs/Kernel_stub.cpp
   stubs/nsapi_dns_stub.cpp
   stubs/stoip4_stub.c
   stubs/ip4tos_stub.c
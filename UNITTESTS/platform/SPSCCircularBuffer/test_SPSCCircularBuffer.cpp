@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/SPSCCircularBuffer.h"
+
+using mbed::Span;
+
+class TestSPSCCircularBuffer : public testing::Test {
+protected:
+    mbed::SPSCCircularBuffer<int, 10> *buf;
+
+    virtual void SetUp()
+    {
+        buf = new mbed::SPSCCircularBuffer<int, 10>;
+    }
+
+    virtual void TearDown()
+    {
+        delete buf;
+    }
+};
+
+TEST_F(TestSPSCCircularBuffer, constructor)
+{
+    EXPECT_TRUE(buf);
+    EXPECT_TRUE(buf->empty());
+    EXPECT_FALSE(buf->full());
+    EXPECT_EQ(0U, buf->size());
+}
+
+TEST_F(TestSPSCCircularBuffer, push_pop)
+{
+    int data;
+    EXPECT_FALSE(buf->pop(data));
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_TRUE(buf->push(i));
+    }
+    EXPECT_TRUE(buf->full());
+    EXPECT_FALSE(buf->push(10));
+
+    EXPECT_TRUE(buf->peek(data));
+    EXPECT_EQ(0, data);
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_TRUE(buf->pop(data));
+        EXPECT_EQ(i, data);
+    }
+    EXPECT_TRUE(buf->empty());
+}
+
+TEST_F(TestSPSCCircularBuffer, wrap_around)
+{
+    int data;
+    for (int i = 0; i < 100; i++) {
+        EXPECT_TRUE(buf->push(i));
+        EXPECT_TRUE(buf->push(i + 1000));
+        EXPECT_EQ(2U, buf->size());
+        EXPECT_TRUE(buf->pop(data));
+        EXPECT_EQ(i, data);
+        EXPECT_TRUE(buf->pop(data));
+        EXPECT_EQ(i + 1000, data);
+    }
+    EXPECT_TRUE(buf->empty());
+}
+
+TEST_F(TestSPSCCircularBuffer, bulk)
+{
+    int src[7] = {1, 2, 3, 4, 5, 6, 7};
+    int dst[7] = {0};
+
+    // Offset the indices so bulk copies straddle the end of the pool
+    for (int round = 0; round < 25; round++) {
+        EXPECT_EQ(7U, buf->push(Span<const int>(src, 7)));
+        EXPECT_EQ(3U, buf->push(Span<const int>(src, 7)));
+        EXPECT_TRUE(buf->full());
+        EXPECT_EQ(0U, buf->push(Span<const int>(src, 7)));
+
+        EXPECT_EQ(7U, buf->pop(Span<int>(dst, 7)));
+        for (int i = 0; i < 7; i++) {
+            EXPECT_EQ(src[i], dst[i]);
+        }
+
+        EXPECT_EQ(3U, buf->pop(Span<int>(dst, 7)));
+        for (int i = 0; i < 3; i++) {
+            EXPECT_EQ(src[i], dst[i]);
+        }
+        EXPECT_TRUE(buf->empty());
+
+        int data;
+        EXPECT_TRUE(buf->push(round));
+        EXPECT_TRUE(buf->pop(data));
+        EXPECT_EQ(round, data);
+    }
+}
+
+TEST_F(TestSPSCCircularBuffer, reset)
+{
+    EXPECT_TRUE(buf->push(1));
+    EXPECT_TRUE(buf->push(2));
+    buf->reset();
+    EXPECT_TRUE(buf->empty());
+
+    int data;
+    EXPECT_FALSE(buf->pop(data));
+}
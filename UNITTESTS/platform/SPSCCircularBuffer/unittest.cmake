@@ -0,0 +1,12 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  platform/SPSCCircularBuffer/test_SPSCCircularBuffer.cpp
+  stubs/mbed_assert_stub.c
+)
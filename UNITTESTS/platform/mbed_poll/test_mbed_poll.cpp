@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/FileHandle.h"
+#include "platform/mbed_poll.h"
+
+using namespace mbed;
+
+class TestFileHandle : public FileHandle {
+public:
+    short revents;
+    bool wakes;
+    mutable int polls;
+
+    TestFileHandle(bool wakes = true) : revents(0), wakes(wakes), polls(0) {}
+
+    virtual ssize_t read(void *buffer, size_t size)
+    {
+        return 0;
+    }
+    virtual ssize_t write(const void *buffer, size_t size)
+    {
+        return size;
+    }
+    virtual off_t seek(off_t offset, int whence = SEEK_SET)
+    {
+        return 0;
+    }
+    virtual int close()
+    {
+        return 0;
+    }
+    virtual short poll(short events) const
+    {
+        polls++;
+        return revents;
+    }
+    virtual bool wakes_poll() const
+    {
+        return wakes;
+    }
+};
+
+class TestPollSet : public testing::Test {
+protected:
+    TestFileHandle fh1;
+    TestFileHandle fh2;
+    TestFileHandle fh3;
+    PollSet::entry entries[3];
+    pollfh ready[3];
+};
+
+TEST(TestPoll, scan)
+{
+    TestFileHandle fh1, fh2;
+    pollfh fhs[3] = { { &fh1, POLLIN }, { &fh2, POLLIN }, { NULL, POLLIN } };
+
+    fh1.revents = POLLIN | POLLOUT;
+    EXPECT_EQ(poll(fhs, 3, 0), 2);
+    EXPECT_EQ(fhs[0].revents, POLLIN);
+    EXPECT_EQ(fhs[1].revents, 0);
+    EXPECT_EQ(fhs[2].revents, POLLNVAL);
+}
+
+TEST(TestPoll, timeout)
+{
+    TestFileHandle fh(false);
+    pollfh fhs[1] = { { &fh, POLLIN } };
+
+    EXPECT_EQ(poll(fhs, 1, 0), 0);
+    EXPECT_EQ(fh.polls, 1);
+
+    // Scans again after starting the timer
+    EXPECT_EQ(poll(fhs, 1, 10), 0);
+    EXPECT_GE(fh.polls, 3);
+}
+
+TEST_F(TestPollSet, add_remove)
+{
+    PollSet set(entries, 2);
+    EXPECT_EQ(set.remove(&fh1), -ENOENT);
+    EXPECT_EQ(set.modify(&fh1, POLLOUT), -ENOENT);
+
+    EXPECT_EQ(set.add(&fh1, POLLIN), 0);
+    EXPECT_EQ(set.add(&fh1, POLLIN), -EEXIST);
+    EXPECT_EQ(set.add(&fh2, POLLIN), 0);
+    EXPECT_EQ(set.add(&fh3, POLLIN), -ENOMEM);
+
+    EXPECT_EQ(set.remove(&fh1), 0);
+    EXPECT_EQ(set.add(&fh3, POLLIN), 0);
+    EXPECT_EQ(set.modify(&fh3, POLLOUT), 0);
+}
+
+TEST_F(TestPollSet, rescans_woken)
+{
+    PollSet set(entries, 3);
+    set.add(&fh1, POLLIN);
+    set.add(&fh2, POLLIN);
+
+    EXPECT_EQ(set.wait(ready, 3, 0), 0);
+    EXPECT_EQ(fh1.polls, 1);
+    EXPECT_EQ(fh2.polls, 1);
+
+    // Nothing woken, nothing scanned
+    EXPECT_EQ(set.wait(ready, 3, 0), 0);
+    EXPECT_EQ(fh1.polls + fh2.polls, 2);
+
+    fh2.revents = POLLIN;
+    poll_wake(&fh2);
+    EXPECT_EQ(set.wait(ready, 3, 0), 1);
+    EXPECT_EQ(ready[0].fh, &fh2);
+    EXPECT_EQ(ready[0].revents, POLLIN);
+    EXPECT_EQ(fh1.polls, 1);
+
+    // Reported until the events are gone
+    EXPECT_EQ(set.wait(ready, 3, 0), 1);
+    fh2.revents = 0;
+    EXPECT_EQ(set.wait(ready, 3, 0), 0);
+    EXPECT_EQ(fh2.polls, 4);
+}
+
+TEST_F(TestPollSet, rescans_not_waking)
+{
+    TestFileHandle fh(false);
+    PollSet set(entries, 3);
+    set.add(&fh, POLLIN);
+
+    EXPECT_EQ(set.wait(ready, 3, 0), 0);
+    EXPECT_EQ(set.wait(ready, 3, 0), 0);
+    EXPECT_EQ(fh.polls, 2);
+}
+
+TEST_F(TestPollSet, reports_in_turn)
+{
+    PollSet set(entries, 3);
+    set.add(&fh1, POLLIN);
+    set.add(&fh2, POLLIN);
+    set.add(&fh3, POLLIN);
+    fh1.revents = POLLIN;
+    fh2.revents = POLLIN;
+    fh3.revents = POLLIN;
+
+    EXPECT_EQ(set.wait(ready, 1, 0), 1);
+    EXPECT_EQ(ready[0].fh, &fh1);
+    EXPECT_EQ(set.wait(ready, 1, 0), 1);
+    EXPECT_EQ(ready[0].fh, &fh2);
+    EXPECT_EQ(set.wait(ready, 1, 0), 1);
+    EXPECT_EQ(ready[0].fh, &fh3);
+    EXPECT_EQ(set.wait(ready, 1, 0), 1);
+    EXPECT_EQ(ready[0].fh, &fh1);
+
+    EXPECT_EQ(set.wait(ready, 3, 0), 3);
+    EXPECT_EQ(ready[0].fh, &fh2);
+    EXPECT_EQ(ready[1].fh, &fh3);
+    EXPECT_EQ(ready[2].fh, &fh1);
+}
@@ -0,0 +1,15 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+  ../platform/mbed_poll.cpp
+)
+
+set(unittest-test-sources
+  platform/mbed_poll/test_mbed_poll.cpp
+  stubs/mbed_critical_stub.c
+  stubs/Timer_stub.cpp
+  stubs/FileHandle_stub.cpp
+)
@@ -16,6 +16,7 @@
  */
 
 #include <ctype.h>
+#include <string.h>
 #include "nsapi_types.h"
 #include "events/EventQueue.h"
 #include "ATHandler_stub.h"
@@ -87,9 +88,9 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, uint32_t timeout, const
     _queue(queue),
     _ref_count(1),
     _oob_string_max_length(0),
-    _oobs(NULL),
     _max_resp_length(MAX_RESP_LENGTH)
 {
+    memset(_oobs, 0, sizeof(_oobs));
     ATHandler_stub::process_oob_urc = false;
 }
 
@@ -334,6 +335,18 @@ size_t ATHandler::write_bytes(const uint8_t *param, size_t len)
     return ATHandler_stub::size_value;
 }
 
+size_t ATHandler::write_bytes_at_prompt(const char *prompt, const uint8_t *data, size_t len)
+{
+    if (ATHandler_stub::return_given_size) {
+        return len;
+    }
+    return ATHandler_stub::size_value;
+}
+
+void ATHandler::write_hex_string(const uint8_t *data, size_t len, bool useQuotations)
+{
+}
+
 void ATHandler::cmd_stop()
 {
 }
@@ -379,6 +392,11 @@ nsapi_error_t ATHandler::at_cmd_discard(const char *cmd, const char *cmd_chr,
     return ATHandler_stub::nsapi_error_value;
 }
 
+nsapi_error_t ATHandler::at_cmd_pipeline(const at_cmd_t *cmds, size_t count, bool concatenate)
+{
+    return ATHandler_stub::nsapi_error_value;
+}
+
 ATHandler *ATHandler::get_instance(FileHandle *fileHandle, events::EventQueue &queue, uint32_t timeout,
                                    const char *delimiter, uint16_t send_delay, bool debug_on)
 {
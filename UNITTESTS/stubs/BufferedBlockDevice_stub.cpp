@@ -26,7 +26,8 @@ static inline uint32_t align_down(bd_size_t val, bd_size_t size)
     return 0;
 }
 
-BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd)
+BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd, uint32_t write_cache_lines, bd_size_t read_ahead_size)
+    : _write_cache_lines(write_cache_lines), _read_ahead_size(read_ahead_size)
 {
 }
 
@@ -99,6 +100,11 @@ int BufferedBlockDevice::get_erase_value() const
     return 0;
 }
 
+const void *BufferedBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size)
+{
+    return NULL;
+}
+
 bd_size_t BufferedBlockDevice::size() const
 {
     return 0;
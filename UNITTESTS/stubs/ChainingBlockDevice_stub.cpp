@@ -19,7 +19,7 @@
 #include "mbed_critical.h"
 
 
-ChainingBlockDevice::ChainingBlockDevice(BlockDevice **bds, size_t bd_count)
+ChainingBlockDevice::ChainingBlockDevice(BlockDevice **bds, size_t bd_count, bd_size_t stripe_size)
 {
 }
 
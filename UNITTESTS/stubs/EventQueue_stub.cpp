@@ -26,7 +26,7 @@ unsigned EventQueue_stub::unsigned_value = 0;
 
 namespace events {
 
-EventQueue::EventQueue(unsigned event_size, unsigned char *event_pointer)
+EventQueue::EventQueue(unsigned event_size, unsigned char *event_pointer, unsigned flags)
 {
 }
 
@@ -38,6 +38,10 @@ void EventQueue::dispatch(int ms)
 {
 }
 
+void EventQueue::dispatch_worker(int ms)
+{
+}
+
 void EventQueue::break_dispatch()
 {
 }
@@ -56,6 +60,15 @@ int EventQueue::time_left(int id)
     return EventQueue_stub::int_value;
 }
 
+int EventQueue::get_stats(struct equeue_stats *stats)
+{
+    return EventQueue_stub::int_value;
+}
+
+void EventQueue::reset_stats()
+{
+}
+
 void EventQueue::background(Callback<void(int)> update)
 {
 }
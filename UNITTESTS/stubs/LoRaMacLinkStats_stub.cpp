@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LoRaMacLinkStats.h"
+
+LoRaMacLinkStats::LoRaMacLinkStats() : _lora_phy(NULL), _adr_policy(false)
+{
+}
+
+LoRaMacLinkStats::~LoRaMacLinkStats()
+{
+}
+
+void LoRaMacLinkStats::activate_link_stats_subsystem(LoRaPHY *phy)
+{
+}
+
+void LoRaMacLinkStats::reset()
+{
+}
+
+void LoRaMacLinkStats::on_frame_sent(uint8_t channel, uint32_t tx_toa)
+{
+}
+
+void LoRaMacLinkStats::on_downlink(uint8_t channel, uint8_t datarate,
+                                   int16_t rssi, int8_t snr)
+{
+}
+
+void LoRaMacLinkStats::on_uplink_done(uint8_t channel, bool confirmed, bool acked)
+{
+}
+
+void LoRaMacLinkStats::get_link_stats(lorawan_link_stats_t &stats) const
+{
+}
+
+lorawan_status_t LoRaMacLinkStats::get_channel_stats(uint8_t channel,
+                                                     lorawan_link_stats_t &stats) const
+{
+    return LORAWAN_STATUS_OK;
+}
+
+void LoRaMacLinkStats::enable_adr_policy(bool enable)
+{
+    _adr_policy = enable;
+}
+
+bool LoRaMacLinkStats::adr_policy_enabled() const
+{
+    return _adr_policy;
+}
+
+bool LoRaMacLinkStats::get_next_ADR(int8_t &dr_out, int8_t &tx_power_out)
+{
+    return false;
+}
@@ -27,6 +27,7 @@ int LoRaMac_stub::bool_true_counter = 0;
 bool LoRaMac_stub::bool_value = false;
 int LoRaMac_stub::int_value = 0;
 uint8_t LoRaMac_stub::uint8_value = 1;
+uint8_t LoRaMac_stub::tx_size_value = 51;
 rx_slot_t LoRaMac_stub::slot_value = RX_SLOT_WIN_1;
 lorawan_status_t LoRaMac_stub::status_value = LORAWAN_STATUS_OK;
 loramac_mcps_confirm_t *LoRaMac_stub::mcps_conf_ptr = NULL;
@@ -41,6 +42,7 @@ LoRaMac::LoRaMac()
       _lora_phy(NULL),
       _mac_commands(),
       _channel_plan(),
+      _link_stats(),
       _lora_crypto(),
       _ev_queue(NULL),
       _mcps_indication(),
@@ -94,6 +96,7 @@ void LoRaMac::post_process_mlme_ind()
 
 lorawan_time_t LoRaMac::get_current_time(void)
 {
+    return 0;
 }
 
 rx_slot_t LoRaMac::get_current_slot(void)
@@ -159,6 +162,10 @@ void LoRaMac::set_batterylevel_callback(mbed::Callback<uint8_t(void)> battery_le
 {
 }
 
+void LoRaMac::arm_rx_windows(lorawan_time_t timestamp)
+{
+}
+
 void LoRaMac::on_radio_tx_done(lorawan_time_t timestamp)
 {
 }
@@ -172,7 +179,12 @@ void LoRaMac::on_radio_tx_timeout(void)
 {
 }
 
-void LoRaMac::on_radio_rx_timeout(bool is_timeout)
+rx_slot_t LoRaMac::on_radio_rx_window_closed(void)
+{
+    return LoRaMac_stub::slot_value;
+}
+
+void LoRaMac::on_radio_rx_timeout(bool is_timeout, rx_slot_t slot)
 {
 }
 
@@ -287,6 +299,23 @@ void LoRaMac::enable_adaptive_datarate(bool adr_enabled)
 {
 }
 
+void LoRaMac::enable_device_adr(bool adr_enabled)
+{
+}
+
+void LoRaMac::get_link_stats(lorawan_link_stats_t &stats)
+{
+}
+
+lorawan_status_t LoRaMac::get_channel_stats(uint8_t channel, lorawan_link_stats_t &stats)
+{
+    return LoRaMac_stub::status_value;
+}
+
+void LoRaMac::reset_link_stats()
+{
+}
+
 lorawan_status_t LoRaMac::set_channel_data_rate(uint8_t data_rate)
 {
     return LoRaMac_stub::status_value;
@@ -399,6 +428,11 @@ void LoRaMac::disconnect()
 {
 }
 
+uint8_t LoRaMac::get_max_tx_payload_size()
+{
+    return LoRaMac_stub::tx_size_value;
+}
+
 uint8_t LoRaMac::get_max_possible_tx_size(uint8_t fopts_len)
 {
     return 0;
@@ -436,6 +470,15 @@ lorawan_status_t LoRaMac::get_channel_plan(lorawan_channelplan_t &plan)
     return LoRaMac_stub::status_value;
 }
 
+void LoRaMac::get_session(loramac_session_t &session)
+{
+}
+
+lorawan_status_t LoRaMac::restore_session(const loramac_session_t &session)
+{
+    return LoRaMac_stub::status_value;
+}
+
 lorawan_status_t LoRaMac::remove_single_channel(uint8_t id)
 {
     return LoRaMac_stub::status_value;
@@ -28,6 +28,7 @@ extern int bool_false_counter;
 extern int bool_true_counter;
 extern int int_value;
 extern uint8_t uint8_value;
+extern uint8_t tx_size_value;
 extern rx_slot_t slot_value;
 extern lorawan_status_t status_value;
 extern loramac_mcps_confirm_t *mcps_conf_ptr;
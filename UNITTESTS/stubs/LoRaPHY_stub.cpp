@@ -248,6 +248,11 @@ uint8_t LoRaPHY::get_max_payload(uint8_t datarate, bool use_repeater)
     return LoRaPHY_stub::uint8_value;
 }
 
+int8_t LoRaPHY::get_demodulation_floor(uint8_t datarate)
+{
+    return LoRaPHY_stub::int8_value;
+}
+
 uint16_t LoRaPHY::get_maximum_frame_counter_gap()
 {
     return LoRaPHY_stub::uint16_value;
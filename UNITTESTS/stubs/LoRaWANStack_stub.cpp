@@ -102,11 +102,21 @@ lorawan_status_t LoRaWANStack::enable_adaptive_datarate(bool adr_enabled)
     return LORAWAN_STATUS_OK;
 }
 
+lorawan_status_t LoRaWANStack::enable_device_adr(bool adr_enabled)
+{
+    return LORAWAN_STATUS_OK;
+}
+
 lorawan_status_t LoRaWANStack::stop_sending(void)
 {
     return LORAWAN_STATUS_OK;
 }
 
+lorawan_status_t LoRaWANStack::forget_session(void)
+{
+    return LORAWAN_STATUS_OK;
+}
+
 int16_t LoRaWANStack::handle_tx(const uint8_t port, const uint8_t *data,
                                 uint16_t length, uint8_t flags,
                                 bool null_allowed, bool allow_port_0)
@@ -153,6 +163,32 @@ lorawan_status_t LoRaWANStack::acquire_backoff_metadata(int &backoff)
     return LORAWAN_STATUS_OK;
 }
 
+int16_t LoRaWANStack::send_aggregated(const uint8_t port, const uint8_t *data,
+                                      uint16_t length, uint8_t flags)
+{
+    return 0;
+}
+
+lorawan_status_t LoRaWANStack::acquire_aggregation_stats(lorawan_aggregation_stats_t &stats)
+{
+    return LORAWAN_STATUS_OK;
+}
+
+lorawan_status_t LoRaWANStack::acquire_link_stats(lorawan_link_stats_t &stats)
+{
+    return LORAWAN_STATUS_OK;
+}
+
+lorawan_status_t LoRaWANStack::acquire_channel_stats(uint8_t channel, lorawan_link_stats_t &stats)
+{
+    return LORAWAN_STATUS_OK;
+}
+
+lorawan_status_t LoRaWANStack::reset_link_stats(void)
+{
+    return LORAWAN_STATUS_OK;
+}
+
 /*****************************************************************************
  * Interrupt handlers                                                        *
  ****************************************************************************/
@@ -204,7 +240,7 @@ void LoRaWANStack::process_reception(const uint8_t *const payload, uint16_t size
 {
 }
 
-void LoRaWANStack::process_reception_timeout(bool is_timeout)
+void LoRaWANStack::process_reception_timeout(bool is_timeout, rx_slot_t slot)
 {
 }
 
@@ -46,7 +46,8 @@ lorawan_time_t LoRaWANTimeHandler::get_elapsed_time(lorawan_time_t saved_time)
     return LoRaWANTimer_stub::time_value;
 }
 
-void LoRaWANTimeHandler::init(timer_event_t &obj, mbed::Callback<void()> callback)
+void LoRaWANTimeHandler::init(timer_event_t &obj, mbed::Callback<void()> callback,
+                              bool time_critical)
 {
     if (callback && LoRaWANTimer_stub::call_cb_immediately) {
         callback();
@@ -131,6 +131,11 @@ int MBRBlockDevice::get_erase_value() const
     return 0;
 }
 
+const void *MBRBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size)
+{
+    return NULL;
+}
+
 bd_size_t MBRBlockDevice::size() const
 {
     return 0;
@@ -18,7 +18,12 @@
 #include "ProfilingBlockDevice.h"
 
 
-ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd)
+ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd, uint32_t trace_depth, bool wear_map)
+    : _trace_depth(trace_depth), _wear_map_enabled(wear_map)
+{
+}
+
+ProfilingBlockDevice::~ProfilingBlockDevice()
 {
 }
 
@@ -84,6 +84,11 @@ int ReadOnlyBlockDevice::get_erase_value() const
     return 0;
 }
 
+const void *ReadOnlyBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size)
+{
+    return NULL;
+}
+
 bd_size_t ReadOnlyBlockDevice::size() const
 {
     return 0;
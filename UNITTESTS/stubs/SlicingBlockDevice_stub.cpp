@@ -78,6 +78,11 @@ int SlicingBlockDevice::get_erase_value() const
     return 0;
 }
 
+const void *SlicingBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size)
+{
+    return NULL;
+}
+
 bd_size_t SlicingBlockDevice::size() const
 {
     return 0;
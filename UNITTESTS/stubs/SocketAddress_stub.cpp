@@ -75,6 +75,11 @@ const char *SocketAddress::get_ip_address() const
     return NULL;
 }
 
+const char *SocketAddress::get_ip_address(char *buf) const
+{
+    return NULL;
+}
+
 const void *SocketAddress::get_ip_bytes() const
 {
     return NULL;
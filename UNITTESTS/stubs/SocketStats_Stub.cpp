@@ -61,3 +61,23 @@ void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size
 {
     return;
 }
+
+void SocketStats::stats_update_tcp_info(const Socket *const reference_id, NetworkStack *stack, nsapi_socket_t handle)
+{
+    return;
+}
+
+uint64_t SocketStats::stats_blocking_start()
+{
+    return 0;
+}
+
+void SocketStats::stats_update_send_blocked(const Socket *const reference_id, uint64_t start)
+{
+    return;
+}
+
+void SocketStats::stats_update_recv_blocked(const Socket *const reference_id, uint64_t start)
+{
+    return;
+}
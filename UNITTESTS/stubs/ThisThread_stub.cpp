@@ -27,4 +27,8 @@ void ThisThread::sleep_for(uint32_t millisec)
 {
 }
 
+void ThisThread::sleep_for(uint32_t millisec, uint32_t slack)
+{
+}
+
 }
@@ -38,6 +38,16 @@ ssize_t UARTSerial::write(const void *buffer, size_t length)
     return 0;
 }
 
+ssize_t UARTSerial::readv(const struct iovec *iov, int iovcnt)
+{
+    return 0;
+}
+
+ssize_t UARTSerial::writev(const struct iovec *iov, int iovcnt)
+{
+    return 0;
+}
+
 off_t UARTSerial::seek(off_t offset, int whence)
 {
     return -ESPIPE;
@@ -140,4 +150,11 @@ void UARTSerial::set_flow_control(mbed::SerialBase::Flow, PinName, PinName)
 
 }
 
+#if DEVICE_SERIAL_ASYNCH
+int UARTSerial::set_asynch(bool enabled, DMAUsage usage)
+{
+    return 0;
+}
+#endif
+
 }
@@ -32,6 +32,11 @@ int equeue_create_inplace(equeue_t *queue, size_t size, void *buffer)
     return 0;
 }
 
+int equeue_create_flags(equeue_t *queue, size_t size, void *buffer, unsigned flags)
+{
+    return 0;
+}
+
 void equeue_destroy(equeue_t *queue)
 {
 
@@ -42,6 +47,11 @@ void equeue_dispatch(equeue_t *queue, int ms)
 
 }
 
+void equeue_dispatch_worker(equeue_t *queue, int ms)
+{
+
+}
+
 void equeue_break(equeue_t *queue)
 {
 
@@ -82,6 +92,16 @@ void equeue_event_dtor(void *event, void (*dtor)(void *))
 
 }
 
+void equeue_event_key(void *event, uint16_t key)
+{
+
+}
+
+void equeue_event_slack(void *event, int ms)
+{
+
+}
+
 int equeue_post(equeue_t *queue, void (*cb)(void *), void *event)
 {
     struct equeue_event *e = (struct equeue_event *)event - 1;
@@ -92,11 +112,26 @@ int equeue_post(equeue_t *queue, void (*cb)(void *), void *event)
     return 0;
 }
 
+int equeue_post_isr(equeue_t *queue, void (*cb)(void *), void *event)
+{
+    return equeue_post(queue, cb, event);
+}
+
 void equeue_cancel(equeue_t *queue, int id)
 {
 
 }
 
+int equeue_stats(equeue_t *queue, struct equeue_stats *stats)
+{
+    return -1;
+}
+
+void equeue_stats_reset(equeue_t *queue)
+{
+
+}
+
 void equeue_background(equeue_t *queue,
                        void (*update)(void *timer, int ms), void *timer)
 {
@@ -57,7 +57,7 @@ void *randLIB_get_n_bytes_random(void *data_ptr, uint8_t count)
 
 uint16_t randLIB_get_random_in_range(uint16_t min, uint16_t max)
 {
-    return 0;
+    return min;
 }
 
 uint32_t randLIB_randomise_base(uint32_t base, uint16_t min_factor, uint16_t max_factor)
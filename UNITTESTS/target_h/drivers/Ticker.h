@@ -24,6 +24,8 @@ namespace mbed {
 
 /** mock Ticker
  *
+ *  Keeps the attached callback, so tests can run it with fire() when the time
+ *  would have elapsed. The ticker attached last is returned by last_attached().
  */
 class Ticker {
 
@@ -34,17 +36,58 @@ public:
 
     void attach_us(Callback<void()> func, us_timestamp_t t)
     {
-
+        _function = func;
+        _delay = t;
+        last_attached() = this;
     }
 
     void detach()
     {
+        _function = nullptr;
+        if (last_attached() == this) {
+            last_attached() = nullptr;
+        }
+    }
 
+    static Ticker *&last_attached()
+    {
+        static Ticker *ticker = nullptr;
+        return ticker;
+    }
+
+    /** Run the attached callback once, detaching it first
+     *
+     *  @return true if a callback was attached
+     */
+    bool fire()
+    {
+        Callback<void()> func = _function;
+        detach();
+        if (!func) {
+            return false;
+        }
+        func();
+        return true;
+    }
+
+    bool attached() const
+    {
+        return bool(_function);
+    }
+
+    us_timestamp_t delay() const
+    {
+        return _delay;
     }
 
     ~Ticker()
     {
+        detach();
     }
+
+private:
+    Callback<void()> _function;
+    us_timestamp_t _delay = 0;
 };
 
 } // namespace mbed
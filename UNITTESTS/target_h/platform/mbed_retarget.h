@@ -20,6 +20,7 @@
 
 #include <inttypes.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <stdio.h>
 
 #include <time.h>
@@ -65,6 +65,7 @@ public:
     virtual void rf_unregister();
     virtual void get_mac_address(uint8_t *mac);
     virtual void set_mac_address(uint8_t *mac);
+    virtual int get_stats(nanostack_rf_phy_stats_t *stats, bool reset = false);
 
 private:
     AT24Mac _mac;
@@ -32,6 +32,8 @@
 #include "SPI.h"
 #include "inttypes.h"
 #include "Timeout.h"
+#include "platform/mbed_critical.h"
+#include "hal/us_ticker_api.h"
 
 #define TRACE_GROUP "AtRF"
 
@@ -50,6 +52,9 @@
 
 #define RF_PHY_MODE OQPSK_SIN_250
 
+/*Frame buffer transfers shorter than this are not worth setting up an asynchronous transfer*/
+#define RF_SPI_ASYNC_MIN_LENGTH 16
+
 /*Radio RX and TX state definitions*/
 #define RFF_ON 0x01
 #define RFF_RX 0x02
@@ -110,6 +115,8 @@ static int8_t rf_radio_driver_id = -1;
 static phy_device_driver_s device_driver;
 static uint8_t mac_tx_handle = 0;
 static uint8_t xah_ctrl_1;
+static nanostack_rf_phy_stats_t rf_stats;
+static volatile uint32_t rf_irq_time;
 
 /* Channel configurations for 2.4 and sub-GHz */
 static const phy_rf_channel_configuration_s phy_24ghz = {.channel_0_center_frequency = 2405000000U, .channel_spacing = 5000000U, .datarate = 250000U, .number_of_channels = 16U, .modulation = M_OQPSK};
@@ -218,6 +225,8 @@ static uint8_t rf_if_read_part_num(void);
 static void rf_if_enable_irq(void);
 static void rf_if_disable_irq(void);
 static void rf_if_spi_exchange_n(const void *tx, size_t tx_len, void *rx, size_t rx_len);
+static void rf_if_spi_burst(const void *tx1, size_t tx1_len, void *rx1, size_t rx1_len,
+                            const void *tx2, size_t tx2_len, void *rx2, size_t rx2_len);
 
 static inline rf_trx_states_t rf_if_trx_status_from_full(uint8_t full_trx_status)
 {
@@ -268,6 +277,9 @@ public:
 #ifdef MBED_CONF_RTOS_PRESENT
     Thread irq_thread;
     Mutex mutex;
+#if DEVICE_SPI_ASYNCH
+    Semaphore spi_done;
+#endif
     void rf_if_irq_task();
 #endif
 };
@@ -284,6 +296,9 @@ RFBits::RFBits(PinName spi_mosi, PinName spi_miso,
     , irq_thread(osPriorityRealtime, MBED_CONF_ATMEL_RF_IRQ_THREAD_STACK_SIZE, NULL, "atmel_irq_thread")
 #endif
 {
+#if DEVICE_SPI_ASYNCH
+    spi.set_dma_usage(DMA_USAGE_ALWAYS);
+#endif
 #ifdef MBED_CONF_RTOS_PRESENT
     irq_thread.start(mbed::callback(this, &RFBits::rf_if_irq_task));
 #endif
@@ -736,18 +751,29 @@ static rf_trx_states_t rf_if_read_trx_state(void)
  */
 static uint16_t rf_if_read_packet(uint8_t data_out[RF_MTU], uint8_t *lqi_out, uint8_t *ed_out, bool *crc_good)
 {
+    uint32_t start = us_ticker_read();
     CS_SELECT();
     const uint8_t tx[1] = { 0x20 };
     uint8_t rx[3];
     rf_if_spi_exchange_n(tx, 1, rx, 2);
     uint8_t len = rx[1] & 0x7F;
-    rf_if_spi_exchange_n(NULL, 0, data_out, len);
-    rf_if_spi_exchange_n(NULL, 0, rx, 3);
+    /*Frame and LQI, ED and status in one burst*/
+    rf_if_spi_burst(NULL, 0, data_out, len, NULL, 0, rx, 3);
     *lqi_out = rx[0];
     *ed_out = rx[1];
     *crc_good = rx[2] & 0x80;
     CS_RELEASE();
 
+    uint32_t now = us_ticker_read();
+    rf_stats.rx_frames++;
+    if (now - start > rf_stats.rx_read_max) {
+        rf_stats.rx_read_max = now - start;
+    }
+    rf_stats.turnaround_last = now - rf_irq_time;
+    if (rf_stats.turnaround_last > rf_stats.turnaround_max) {
+        rf_stats.turnaround_max = rf_stats.turnaround_last;
+    }
+
     return len;
 }
 
@@ -859,11 +885,17 @@ static void rf_if_write_ieee_addr_registers(uint8_t *address)
 static void rf_if_write_frame_buffer(const uint8_t *ptr, uint8_t length)
 {
     const uint8_t cmd[2] = { 0x60, static_cast<uint8_t>(length + 2) };
+    uint32_t start = us_ticker_read();
 
     CS_SELECT();
-    rf_if_spi_exchange_n(cmd, 2, NULL, 0);
-    rf_if_spi_exchange_n(ptr, length, NULL, 0);
+    rf_if_spi_burst(cmd, 2, NULL, 0, ptr, length, NULL, 0);
     CS_RELEASE();
+
+    uint32_t time = us_ticker_read() - start;
+    rf_stats.tx_frames++;
+    if (time > rf_stats.tx_write_max) {
+        rf_stats.tx_write_max = time;
+    }
 }
 
 /*
@@ -979,6 +1011,7 @@ static void rf_if_disable_irq(void)
 #ifdef MBED_CONF_RTOS_PRESENT
 static void rf_if_interrupt_handler(void)
 {
+    rf_irq_time = us_ticker_read();
     rf->irq_thread.flags_set(SIG_RADIO);
 }
 
@@ -1070,6 +1103,39 @@ static void rf_if_spi_exchange_n(const void *tx, size_t tx_len, void *rx, size_t
 #endif
 }
 
+#if DEVICE_SPI_ASYNCH
+static void rf_if_spi_done(int event)
+{
+    (void)event;
+    rf->spi_done.release();
+}
+#endif
+
+/*
+ * \brief Function writes/read two consecutive exchanges in one burst
+ *
+ * Long bursts run as an asynchronous transfer, letting the SPI use DMA while
+ * the calling thread sleeps, unless called with interrupts disabled.
+ */
+static void rf_if_spi_burst(const void *tx1, size_t tx1_len, void *rx1, size_t rx1_len,
+                            const void *tx2, size_t tx2_len, void *rx2, size_t rx2_len)
+{
+#if DEVICE_SPI_ASYNCH
+    if (tx1_len + rx1_len + tx2_len + rx2_len >= RF_SPI_ASYNC_MIN_LENGTH && !core_util_in_critical_section() && !core_util_is_isr_active()) {
+        const spi_step_t steps[2] = {
+            { tx1, (int)tx1_len, rx1, (int)rx1_len, NULL, 0, 0 },
+            { tx2, (int)tx2_len, rx2, (int)rx2_len, NULL, 0, 0 }
+        };
+        if (rf->spi.transfer_list(steps, 2, rf_if_spi_done) == 0) {
+            rf->spi_done.acquire();
+            return;
+        }
+    }
+#endif
+    rf_if_spi_exchange_n(tx1, tx1_len, rx1, rx1_len);
+    rf_if_spi_exchange_n(tx2, tx2_len, rx2, rx2_len);
+}
+
 /*
  * \brief Function sets given RF flag on.
  *
@@ -2256,6 +2322,17 @@ void NanostackRfPhyAtmel::set_mac_address(uint8_t *mac)
     rf_if_unlock();
 }
 
+int NanostackRfPhyAtmel::get_stats(nanostack_rf_phy_stats_t *stats, bool reset)
+{
+    rf_if_lock();
+    *stats = rf_stats;
+    if (reset) {
+        memset(&rf_stats, 0, sizeof(rf_stats));
+    }
+    rf_if_unlock();
+    return 0;
+}
+
 #if MBED_CONF_ATMEL_RF_PROVIDE_DEFAULT
 
 NanostackRfPhy &NanostackRfPhy::get_default_instance()
@@ -56,6 +56,7 @@ public:
     virtual void rf_unregister();
     virtual void get_mac_address(uint8_t *mac);
     virtual void set_mac_address(uint8_t *mac);
+    virtual int get_stats(nanostack_rf_phy_stats_t *stats, bool reset = false);
 
 private:
     mbed::SPI _spi;
@@ -64,6 +65,9 @@ private:
     mbed::InterruptIn _rf_irq;
     mbed::DigitalIn _rf_irq_pin;
     rtos::Thread _irq_thread;
+#if DEVICE_SPI_ASYNCH
+    rtos::Semaphore _spi_done;
+#endif
 
     void _pins_set();
     void _pins_clear();
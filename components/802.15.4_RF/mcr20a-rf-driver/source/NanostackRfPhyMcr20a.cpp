@@ -23,6 +23,8 @@
 #include <string.h>
 #include "rtos.h"
 #include "mbed_interface.h"
+#include "platform/mbed_critical.h"
+#include "hal/us_ticker_api.h"
 
 using namespace mbed;
 using namespace rtos;
@@ -37,6 +39,9 @@ extern "C" {
 
 #define RF_BUFFER_SIZE 128
 
+/* SPI transfers shorter than this are not worth setting up an asynchronous transfer */
+#define RF_SPI_ASYNC_MIN_LENGTH 16
+
 /*Radio RX and TX state definitions*/
 #define RFF_ON 0x01
 #define RFF_RX 0x02
@@ -137,6 +142,12 @@ static DigitalOut *rst = NULL;
 static InterruptIn *irq = NULL;
 static DigitalIn *irq_pin = NULL;
 static Thread *irq_thread = NULL;
+#if DEVICE_SPI_ASYNCH
+static Semaphore *spi_done = NULL;
+#endif
+
+static nanostack_rf_phy_stats_t rf_stats;
+static volatile uint32_t rf_irq_time;
 
 /* Channel info */                 /* 2405    2410    2415    2420    2425    2430    2435    2440    2445    2450    2455    2460    2465    2470    2475    2480 */
 static const uint8_t  pll_int[16] =  {0x0B,   0x0B,   0x0B,   0x0B,   0x0B,   0x0B,   0x0C,   0x0C,   0x0C,   0x0C,   0x0C,   0x0C,   0x0D,   0x0D,   0x0D,   0x0D};
@@ -648,8 +659,14 @@ static int8_t rf_start_cca(uint8_t *data_ptr, uint16_t data_length, uint8_t tx_h
     rf_set_power_state(gXcvrRunState_d);
     /* Load data into XCVR */
     tx_len = data_length + 2;
+    uint32_t start = us_ticker_read();
     MCR20Drv_PB_SPIBurstWrite(data_ptr - 1, data_length + 1);
     MCR20Drv_PB_SPIByteWrite(0, tx_len);
+    uint32_t time = us_ticker_read() - start;
+    rf_stats.tx_frames++;
+    if (time > rf_stats.tx_write_max) {
+        rf_stats.tx_write_max = time;
+    }
 
     /* Set CCA mode 1 */
     ccaMode = (mStatusAndControlRegs[PHY_CTRL4] >> cPHY_CTRL4_CCATYPE_Shift_c) & cPHY_CTRL4_CCATYPE;
@@ -805,7 +822,17 @@ static void rf_handle_rx_end(void)
         rf_lqi  = rf_scale_lqi(rf_rssi);
 
         /*Read received packet*/
+        uint32_t start = us_ticker_read();
         MCR20Drv_PB_SPIBurstRead(rf_buffer, len);
+        uint32_t now = us_ticker_read();
+        rf_stats.rx_frames++;
+        if (now - start > rf_stats.rx_read_max) {
+            rf_stats.rx_read_max = now - start;
+        }
+        rf_stats.turnaround_last = now - rf_irq_time;
+        if (rf_stats.turnaround_last > rf_stats.turnaround_max) {
+            rf_stats.turnaround_max = rf_stats.turnaround_last;
+        }
         if (device_driver.phy_rx_cb) {
             device_driver.phy_rx_cb(rf_buffer, len, rf_lqi, rf_rssi, rf_radio_driver_id);
         }
@@ -1064,6 +1091,7 @@ static void rf_init_phy_mode(void)
  */
 static void PHY_InterruptHandler(void)
 {
+    rf_irq_time = us_ticker_read();
     MCR20Drv_IRQ_Disable();
     irq_thread->flags_set(1);
 }
@@ -1603,6 +1631,14 @@ extern "C" void xcvr_spi_configure_speed(uint32_t instance, uint32_t freq)
     spi->frequency(freq);
 }
 
+#if DEVICE_SPI_ASYNCH
+static void xcvr_spi_done(int event)
+{
+    (void)event;
+    spi_done->release();
+}
+#endif
+
 extern "C" void xcvr_spi_transfer(uint32_t instance,
                                   uint8_t *sendBuffer,
                                   uint8_t *receiveBuffer,
@@ -1610,7 +1646,6 @@ extern "C" void xcvr_spi_transfer(uint32_t instance,
 {
     MBED_ASSERT(spi != NULL);
     (void)instance;
-    volatile uint8_t dummy;
 
     if (!transferByteCount) {
         return;
@@ -1620,21 +1655,22 @@ extern "C" void xcvr_spi_transfer(uint32_t instance,
         return;
     }
 
-    while (transferByteCount--) {
-        if (sendBuffer) {
-            dummy = *sendBuffer;
-            sendBuffer++;
-        } else {
-            dummy = 0xFF;
-        }
-
-        dummy = spi->write(dummy);
+    int tx_length = sendBuffer ? transferByteCount : 0;
+    int rx_length = receiveBuffer ? transferByteCount : 0;
 
-        if (receiveBuffer) {
-            *receiveBuffer = dummy;
-            receiveBuffer++;
+#if DEVICE_SPI_ASYNCH
+    /* Packet buffer bursts run with DMA while the thread sleeps, unless interrupts are disabled */
+    if (transferByteCount >= RF_SPI_ASYNC_MIN_LENGTH && !core_util_in_critical_section() && !core_util_is_isr_active()) {
+        if (spi->transfer(sendBuffer, tx_length, receiveBuffer, rx_length, xcvr_spi_done) == 0) {
+            spi_done->acquire();
+            return;
         }
     }
+#endif
+
+    /* Bytes not sent from sendBuffer are the 0xFF fill character */
+    spi->write(reinterpret_cast<const char *>(sendBuffer), tx_length,
+               reinterpret_cast<char *>(receiveBuffer), rx_length);
 }
 
 /*****************************************************************************/
@@ -1667,6 +1703,10 @@ NanostackRfPhyMcr20a::NanostackRfPhyMcr20a(PinName spi_mosi, PinName spi_miso,
     MAC_address[5] = mac48[3];
     MAC_address[6] = mac48[4];
     MAC_address[7] = mac48[5];
+
+#if DEVICE_SPI_ASYNCH
+    _spi.set_dma_usage(DMA_USAGE_ALWAYS);
+#endif
 }
 
 NanostackRfPhyMcr20a::~NanostackRfPhyMcr20a()
@@ -1740,6 +1780,9 @@ void NanostackRfPhyMcr20a::set_mac_address(uint8_t *mac)
 void NanostackRfPhyMcr20a::_pins_set()
 {
     spi = &_spi;
+#if DEVICE_SPI_ASYNCH
+    spi_done = &_spi_done;
+#endif
     cs = &_rf_cs;
     rst = &_rf_rst;
     irq = &_rf_irq;
@@ -1750,6 +1793,9 @@ void NanostackRfPhyMcr20a::_pins_set()
 void NanostackRfPhyMcr20a::_pins_clear()
 {
     spi = NULL;
+#if DEVICE_SPI_ASYNCH
+    spi_done = NULL;
+#endif
     cs = NULL;
     rst = NULL;
     irq = NULL;
@@ -1757,6 +1803,17 @@ void NanostackRfPhyMcr20a::_pins_clear()
     irq_thread = NULL;
 }
 
+int NanostackRfPhyMcr20a::get_stats(nanostack_rf_phy_stats_t *stats, bool reset)
+{
+    rf_if_lock();
+    *stats = rf_stats;
+    if (reset) {
+        memset(&rf_stats, 0, sizeof(rf_stats));
+    }
+    rf_if_unlock();
+    return 0;
+}
+
 #if MBED_CONF_MCR20A_PROVIDE_DEFAULT || TARGET_KW24D
 
 NanostackRfPhy &NanostackRfPhy::get_default_instance()
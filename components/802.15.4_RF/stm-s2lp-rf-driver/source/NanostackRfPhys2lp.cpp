@@ -29,6 +29,8 @@
 #include "Timeout.h"
 #include "Thread.h"
 #include "mbed_wait_api.h"
+#include "platform/mbed_critical.h"
+#include "hal/us_ticker_api.h"
 
 using namespace mbed;
 using namespace rtos;
@@ -98,6 +100,9 @@ extern void (*fhss_bc_switch)(void);
 #define CS_SELECT()  {rf->CS = 0;}
 #define CS_RELEASE() {rf->CS = 1;}
 
+// FIFO transfers shorter than this are not worth setting up an asynchronous transfer
+#define RF_SPI_ASYNC_MIN_LENGTH 16
+
 typedef enum {
     RF_MODE_NORMAL = 0,
     RF_MODE_SNIFFER = 1
@@ -139,6 +144,9 @@ public:
     Timer tx_timer;
     Thread irq_thread;
     Mutex mutex;
+#if DEVICE_SPI_ASYNCH
+    Semaphore spi_done;
+#endif
     void rf_irq_task();
 };
 
@@ -165,6 +173,9 @@ RFPins::RFPins(PinName spi_sdi, PinName spi_sdo,
         RF_S2LP_GPIO3(spi_gpio3),
         irq_thread(osPriorityRealtime, 1024)
 {
+#if DEVICE_SPI_ASYNCH
+    spi.set_dma_usage(DMA_USAGE_ALWAYS);
+#endif
     irq_thread.start(mbed::callback(this, &RFPins::rf_irq_task));
 }
 
@@ -209,6 +220,8 @@ static rf_mode_e rf_mode = RF_MODE_NORMAL;
 static bool rf_update_config = false;
 static uint16_t cur_packet_len = 0xffff;
 static uint32_t receiver_ready_timestamp;
+static nanostack_rf_phy_stats_t rf_stats;
+static volatile uint32_t rf_irq_time;
 
 /* Channel configurations for sub-GHz */
 static phy_rf_channel_configuration_s phy_subghz = {
@@ -302,6 +315,39 @@ static void rf_spi_exchange(const void *tx, size_t tx_len, void *rx, size_t rx_l
     rf->spi.write(static_cast<const char *>(tx), tx_len, static_cast<char *>(rx), rx_len);
 }
 
+#if DEVICE_SPI_ASYNCH
+static void rf_spi_done(int event)
+{
+    (void)event;
+    rf->spi_done.release();
+}
+#endif
+
+/*
+ * \brief Function writes/read two consecutive exchanges in one burst
+ *
+ * Long bursts run as an asynchronous transfer, letting the SPI use DMA while
+ * the calling thread sleeps, unless called with interrupts disabled.
+ */
+static void rf_spi_burst(const void *tx1, size_t tx1_len, void *rx1, size_t rx1_len,
+                         const void *tx2, size_t tx2_len, void *rx2, size_t rx2_len)
+{
+#if DEVICE_SPI_ASYNCH
+    if (tx1_len + rx1_len + tx2_len + rx2_len >= RF_SPI_ASYNC_MIN_LENGTH && !core_util_in_critical_section() && !core_util_is_isr_active()) {
+        const spi_step_t steps[2] = {
+            { tx1, (int)tx1_len, rx1, (int)rx1_len, NULL, 0, 0 },
+            { tx2, (int)tx2_len, rx2, (int)rx2_len, NULL, 0, 0 }
+        };
+        if (rf->spi.transfer_list(steps, 2, rf_spi_done) == 0) {
+            rf->spi_done.acquire();
+            return;
+        }
+    }
+#endif
+    rf_spi_exchange(tx1, tx1_len, rx1, rx1_len);
+    rf_spi_exchange(tx2, tx2_len, rx2, rx2_len);
+}
+
 static uint8_t rf_read_register(uint8_t addr)
 {
     const uint8_t tx[2] = {SPI_RD_REG, addr};
@@ -442,10 +488,14 @@ static uint8_t rf_write_tx_fifo(uint8_t *ptr, uint16_t length)
     if (length > free_bytes_in_fifo) {
         written_length = free_bytes_in_fifo;
     }
+    uint32_t start = us_ticker_read();
     CS_SELECT();
-    rf_spi_exchange(spi_header, SPI_HEADER_LENGTH, NULL, 0);
-    rf_spi_exchange(ptr, written_length, NULL, 0);
+    rf_spi_burst(spi_header, SPI_HEADER_LENGTH, NULL, 0, ptr, written_length, NULL, 0);
     CS_RELEASE();
+    uint32_t time = us_ticker_read() - start;
+    if (time > rf_stats.tx_write_max) {
+        rf_stats.tx_write_max = time;
+    }
     return written_length;
 }
 
@@ -456,10 +506,14 @@ static int rf_read_rx_fifo(uint16_t rx_index, uint16_t length)
     }
     uint8_t *ptr = &rx_buffer[rx_index];
     const uint8_t spi_header[SPI_HEADER_LENGTH] = {SPI_RD_REG, RX_FIFO};
+    uint32_t start = us_ticker_read();
     CS_SELECT();
-    rf_spi_exchange(spi_header, SPI_HEADER_LENGTH, NULL, 0);
-    rf_spi_exchange(NULL, 0, ptr, length);
+    rf_spi_burst(spi_header, SPI_HEADER_LENGTH, NULL, 0, NULL, 0, ptr, length);
     CS_RELEASE();
+    uint32_t time = us_ticker_read() - start;
+    if (time > rf_stats.rx_read_max) {
+        rf_stats.rx_read_max = time;
+    }
     return length;
 }
 
@@ -839,6 +893,7 @@ static int8_t rf_start_cca(uint8_t *data_ptr, uint16_t data_length, uint8_t tx_h
         return -1;
     }
     rf_state = RF_CSMA_STARTED;
+    rf_stats.tx_frames++;
     uint8_t written_length = rf_write_tx_fifo(data_ptr, data_length);
     if (written_length < data_length) {
         tx_data_ptr = data_ptr + written_length;
@@ -909,6 +964,11 @@ static void rf_rx_ready_handler(void)
         return;
     }
     rx_data_length += rx_read_length;
+    rf_stats.rx_frames++;
+    rf_stats.turnaround_last = us_ticker_read() - rf_irq_time;
+    if (rf_stats.turnaround_last > rf_stats.turnaround_max) {
+        rf_stats.turnaround_max = rf_stats.turnaround_last;
+    }
     if (rf_mode != RF_MODE_SNIFFER) {
         rf_state = RF_IDLE;
         uint8_t version = ((rx_buffer[1] & VERSION_FIELD_MASK) >> SHIFT_VERSION_FIELD);
@@ -991,6 +1051,7 @@ static void rf_receive(uint8_t rx_channel)
 
 static void rf_interrupt_handler(void)
 {
+    rf_irq_time = us_ticker_read();
     rf->irq_thread.flags_set(SIG_RADIO);
 }
 
@@ -1171,6 +1232,17 @@ void NanostackRfPhys2lp::set_mac_address(uint8_t *mac)
     rf_unlock();
 }
 
+int NanostackRfPhys2lp::get_stats(nanostack_rf_phy_stats_t *stats, bool reset)
+{
+    rf_lock();
+    *stats = rf_stats;
+    if (reset) {
+        memset(&rf_stats, 0, sizeof(rf_stats));
+    }
+    rf_unlock();
+    return 0;
+}
+
 int8_t NanostackRfPhys2lp::rf_register()
 {
     if (NULL == _rf) {
@@ -128,6 +128,7 @@ public:
     virtual void rf_unregister();
     virtual void get_mac_address(uint8_t *mac);
     virtual void set_mac_address(uint8_t *mac);
+    virtual int get_stats(nanostack_rf_phy_stats_t *stats, bool reset = false);
 
 private:
 #ifdef AT24MAC
@@ -27,11 +27,20 @@
 
 #include "psa/client.h"
 
+/* Hash and MAC input shorter than this is gathered on the client side and
+ * sent to the crypto partition in one call, instead of one call per update.
+ */
+#ifndef PSA_CRYPTO_IPC_UPDATE_BATCH_SIZE
+#define PSA_CRYPTO_IPC_UPDATE_BATCH_SIZE 64
+#endif
+
 struct psa_hash_operation_s {
     psa_handle_t handle;
+    size_t batch_length;
+    uint8_t batch[PSA_CRYPTO_IPC_UPDATE_BATCH_SIZE];
 };
 
-#define PSA_HASH_OPERATION_INIT { PSA_NULL_HANDLE }
+#define PSA_HASH_OPERATION_INIT { PSA_NULL_HANDLE, 0, { 0 } }
 static inline struct psa_hash_operation_s psa_hash_operation_init(void)
 {
     const struct psa_hash_operation_s v = PSA_HASH_OPERATION_INIT;
@@ -40,9 +49,11 @@ static inline struct psa_hash_operation_s psa_hash_operation_init(void)
 
 struct psa_mac_operation_s {
     psa_handle_t handle;
+    size_t batch_length;
+    uint8_t batch[PSA_CRYPTO_IPC_UPDATE_BATCH_SIZE];
 };
 
-#define PSA_MAC_OPERATION_INIT { PSA_NULL_HANDLE }
+#define PSA_MAC_OPERATION_INIT { PSA_NULL_HANDLE, 0, { 0 } }
 static inline struct psa_mac_operation_s psa_mac_operation_init(void)
 {
     const struct psa_mac_operation_s v = PSA_MAC_OPERATION_INIT;
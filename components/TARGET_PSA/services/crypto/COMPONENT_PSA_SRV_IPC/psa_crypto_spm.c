@@ -86,6 +86,70 @@ static psa_status_t ipc_oneshot(uint32_t sid, psa_invec *in_vec, size_t in_vec_s
     return (status);
 }
 
+static psa_status_t ipc_update(psa_handle_t *handle, psa_sec_function_t func,
+                               const uint8_t *input, size_t input_length)
+{
+    psa_crypto_ipc_t psa_crypto_ipc = {
+        .func   = func,
+        .handle = 0,
+        .alg    = 0
+    };
+
+    psa_invec in_vec[2] = {
+        { &psa_crypto_ipc, sizeof(psa_crypto_ipc) },
+        { input, input_length }
+    };
+
+    psa_status_t status = ipc_call(handle, in_vec, 2, NULL, 0, false);
+    if (status != PSA_SUCCESS) {
+        ipc_close(handle);
+    }
+    return (status);
+}
+
+/* send what ipc_update_batched() has gathered, if anything */
+static psa_status_t ipc_update_flush(psa_handle_t *handle, psa_sec_function_t func,
+                                     uint8_t *batch, size_t *batch_length)
+{
+    if (*batch_length == 0) {
+        return (PSA_SUCCESS);
+    }
+
+    psa_status_t status = ipc_update(handle, func, batch, *batch_length);
+    *batch_length = 0;
+    return (status);
+}
+
+/* each update is a round trip to the secure side, so short input is
+ * gathered in the operation until it fills the batch buffer */
+static psa_status_t ipc_update_batched(psa_handle_t *handle, psa_sec_function_t func,
+                                       uint8_t *batch, size_t *batch_length,
+                                       const uint8_t *input, size_t input_length)
+{
+    if (*handle <= PSA_NULL_HANDLE) {
+        return (PSA_ERROR_BAD_STATE);
+    }
+
+    if (input_length <= PSA_CRYPTO_IPC_UPDATE_BATCH_SIZE - *batch_length) {
+        memcpy(batch + *batch_length, input, input_length);
+        *batch_length += input_length;
+        return (PSA_SUCCESS);
+    }
+
+    psa_status_t status = ipc_update_flush(handle, func, batch, batch_length);
+    if (status != PSA_SUCCESS) {
+        return (status);
+    }
+
+    if (input_length < PSA_CRYPTO_IPC_UPDATE_BATCH_SIZE) {
+        memcpy(batch, input, input_length);
+        *batch_length = input_length;
+        return (PSA_SUCCESS);
+    }
+
+    return (ipc_update(handle, func, input, input_length));
+}
+
 /****************************************************************/
 /* MODULE SETUP/TEARDOWN */
 /****************************************************************/
@@ -105,6 +169,7 @@ void mbedtls_psa_crypto_free(void)
 /****************************************************************/
 psa_status_t psa_mac_abort(psa_mac_operation_t *operation)
 {
+    operation->batch_length = 0;
     if (operation->handle <= PSA_NULL_HANDLE) {
         return (PSA_SUCCESS);
     }
@@ -138,6 +203,7 @@ static psa_status_t psa_mac_setup(psa_mac_operation_t *operation,
 
     psa_invec in_vec = { &psa_crypto_ipc, sizeof(psa_crypto_ipc) };
 
+    operation->batch_length = 0;
     psa_status_t status = ipc_connect(PSA_MAC_ID, &operation->handle);
     if (status != PSA_SUCCESS) {
         return (status);
@@ -169,21 +235,9 @@ psa_status_t psa_mac_update(psa_mac_operation_t *operation,
                             const uint8_t *input,
                             size_t input_length)
 {
-    psa_crypto_ipc_t psa_crypto_ipc = {
-        .func   = PSA_MAC_UPDATE,
-        .handle = 0,
-        .alg    = 0
-    };
-
-    psa_invec in_vec[2] = {
-        { &psa_crypto_ipc, sizeof(psa_crypto_ipc) },
-        { input, input_length }
-    };
-
-    psa_status_t status = ipc_call(&operation->handle, in_vec, 2, NULL, 0, false);
-    if (status != PSA_SUCCESS) {
-        ipc_close(&operation->handle);
-    }
+    psa_status_t status = ipc_update_batched(&operation->handle, PSA_MAC_UPDATE,
+                                             operation->batch, &operation->batch_length,
+                                             input, input_length);
     return (status);
 }
 
@@ -192,6 +246,12 @@ psa_status_t psa_mac_sign_finish(psa_mac_operation_t *operation,
                                  size_t mac_size,
                                  size_t *mac_length)
 {
+    psa_status_t status = ipc_update_flush(&operation->handle, PSA_MAC_UPDATE,
+                                           operation->batch, &operation->batch_length);
+    if (status != PSA_SUCCESS) {
+        return (status);
+    }
+
     psa_crypto_ipc_t psa_crypto_ipc = {
         .func   = PSA_MAC_SIGN_FINISH,
         .handle = 0,
@@ -208,7 +268,7 @@ psa_status_t psa_mac_sign_finish(psa_mac_operation_t *operation,
         { mac_length, sizeof(*mac_length) }
     };
 
-    psa_status_t status = ipc_call(&operation->handle, in_vec, 2, out_vec, 2, true);
+    status = ipc_call(&operation->handle, in_vec, 2, out_vec, 2, true);
     return (status);
 }
 
@@ -216,6 +276,12 @@ psa_status_t psa_mac_verify_finish(psa_mac_operation_t *operation,
                                    const uint8_t *mac,
                                    size_t mac_length)
 {
+    psa_status_t status = ipc_update_flush(&operation->handle, PSA_MAC_UPDATE,
+                                           operation->batch, &operation->batch_length);
+    if (status != PSA_SUCCESS) {
+        return (status);
+    }
+
     psa_crypto_ipc_t psa_crypto_ipc = {
         .func   = PSA_MAC_VERIFY_FINISH,
         .handle = 0,
@@ -228,7 +294,7 @@ psa_status_t psa_mac_verify_finish(psa_mac_operation_t *operation,
         { mac, mac_length }
     };
 
-    psa_status_t status = ipc_call(&operation->handle, in_vec, 3, NULL, 0, true);
+    status = ipc_call(&operation->handle, in_vec, 3, NULL, 0, true);
     return (status);
 }
 
@@ -237,6 +303,7 @@ psa_status_t psa_mac_verify_finish(psa_mac_operation_t *operation,
 /****************************************************************/
 psa_status_t psa_hash_abort(psa_hash_operation_t *operation)
 {
+    operation->batch_length = 0;
     if (operation->handle <= PSA_NULL_HANDLE) {
         return (PSA_SUCCESS);
     }
@@ -268,6 +335,7 @@ psa_status_t psa_hash_setup(psa_hash_operation_t *operation,
 
     psa_invec in_vec = { &psa_crypto_ipc, sizeof(psa_crypto_ipc) };
 
+    operation->batch_length = 0;
     psa_status_t status = ipc_connect(PSA_HASH_ID, &operation->handle);
     if (status != PSA_SUCCESS) {
         return (status);
@@ -283,21 +351,9 @@ psa_status_t psa_hash_update(psa_hash_operation_t *operation,
                              const uint8_t *input,
                              size_t input_length)
 {
-    psa_crypto_ipc_t psa_crypto_ipc = {
-        .func   = PSA_HASH_UPDATE,
-        .handle = 0,
-        .alg    = 0
-    };
-
-    psa_invec in_vec[2] = {
-        { &psa_crypto_ipc, sizeof(psa_crypto_ipc) },
-        { input, input_length }
-    };
-
-    psa_status_t status = ipc_call(&operation->handle, in_vec, 2, NULL, 0, false);
-    if (status != PSA_SUCCESS) {
-        ipc_close(&operation->handle);
-    }
+    psa_status_t status = ipc_update_batched(&operation->handle, PSA_HASH_UPDATE,
+                                             operation->batch, &operation->batch_length,
+                                             input, input_length);
     return (status);
 }
 
@@ -306,6 +362,12 @@ psa_status_t psa_hash_finish(psa_hash_operation_t *operation,
                              size_t hash_size,
                              size_t *hash_length)
 {
+    psa_status_t status = ipc_update_flush(&operation->handle, PSA_HASH_UPDATE,
+                                           operation->batch, &operation->batch_length);
+    if (status != PSA_SUCCESS) {
+        return (status);
+    }
+
     psa_crypto_ipc_t psa_crypto_ipc = {
         .func   = PSA_HASH_FINISH,
         .handle = 0,
@@ -322,7 +384,7 @@ psa_status_t psa_hash_finish(psa_hash_operation_t *operation,
         { hash_length, sizeof(*hash_length) }
     };
 
-    psa_status_t status = ipc_call(&operation->handle, in_vec, 2, out_vec, 2, true);
+    status = ipc_call(&operation->handle, in_vec, 2, out_vec, 2, true);
     return (status);
 }
 
@@ -330,6 +392,12 @@ psa_status_t psa_hash_verify(psa_hash_operation_t *operation,
                              const uint8_t *hash,
                              size_t hash_length)
 {
+    psa_status_t status = ipc_update_flush(&operation->handle, PSA_HASH_UPDATE,
+                                           operation->batch, &operation->batch_length);
+    if (status != PSA_SUCCESS) {
+        return (status);
+    }
+
     psa_crypto_ipc_t psa_crypto_ipc = {
         .func   = PSA_HASH_VERIFY,
         .handle = 0,
@@ -342,7 +410,7 @@ psa_status_t psa_hash_verify(psa_hash_operation_t *operation,
         { hash, hash_length }
     };
 
-    psa_status_t status = ipc_call(&operation->handle, in_vec, 3, NULL, 0, true);
+    status = ipc_call(&operation->handle, in_vec, 3, NULL, 0, true);
     return (status);
 }
 
@@ -381,6 +449,11 @@ psa_status_t psa_hash_clone(const psa_hash_operation_t *source_operation,
 
     psa_crypto_ipc.func = PSA_HASH_CLONE_END;
     status = ipc_call(&target_operation->handle, in_vec, 2, NULL, 0, false);
+    if (status == PSA_SUCCESS) {
+        /* input the source has not sent yet belongs to the clone too */
+        memcpy(target_operation->batch, source_operation->batch, source_operation->batch_length);
+        target_operation->batch_length = source_operation->batch_length;
+    }
 
 exit:
     if (status != PSA_SUCCESS) {
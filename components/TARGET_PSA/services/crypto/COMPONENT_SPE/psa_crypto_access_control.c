@@ -30,9 +30,15 @@ typedef struct psa_crypto_access_control_s {
 
 static psa_crypto_access_control_t crypto_access_control_arr[PSA_KEY_SLOT_COUNT];
 
+/* a client tends to use the same key for a run of calls (a setup, then
+ * several operations), so the entry of the last permitted handle is tried
+ * before walking the table */
+static size_t crypto_access_control_last;
+
 static inline void psa_crypto_access_control_reset()
 {
     memset(crypto_access_control_arr, 0, sizeof(crypto_access_control_arr));
+    crypto_access_control_last = 0;
 }
 
 void psa_crypto_access_control_init(void)
@@ -74,9 +80,16 @@ void psa_crypto_access_control_unregister_handle(psa_key_handle_t key_handle)
 
 uint8_t psa_crypto_access_control_is_handle_permitted(psa_key_handle_t key_handle, int32_t partition_id)
 {
+    if (key_handle != 0 &&
+            crypto_access_control_arr[crypto_access_control_last].key_handle == key_handle &&
+            crypto_access_control_arr[crypto_access_control_last].partition_id == partition_id) {
+        return 1;
+    }
+
     for (size_t i = 0; i < PSA_KEY_SLOT_COUNT; i++) {
         if (crypto_access_control_arr[i].key_handle == key_handle &&
                 crypto_access_control_arr[i].partition_id == partition_id) {
+            crypto_access_control_last = i;
             return 1;
         }
     }
@@ -42,6 +42,10 @@ the data will be read in chunks of size */
 #define MAX_DATA_CHUNK_SIZE_IN_BYTES 400
 #endif
 
+/* messages are handled one at a time by crypto_main(), so hash and mac
+updates share one chunk buffer rather than allocating one per call */
+static uint8_t psa_spm_data_chunk[MAX_DATA_CHUNK_SIZE_IN_BYTES];
+
 #ifndef MAX_CONCURRENT_HASH_CLONES
 #define MAX_CONCURRENT_HASH_CLONES 2
 #endif
@@ -259,37 +263,26 @@ static void psa_mac_operation(void)
                 }
 
                 case PSA_MAC_UPDATE: {
-                    uint8_t *input_buffer = NULL;
                     size_t data_remaining = msg.in_size[1];
-                    size_t allocation_size = MIN(data_remaining, MAX_DATA_CHUNK_SIZE_IN_BYTES);
                     size_t size_to_read = 0;
 
-                    if (allocation_size > 0) {
-                        input_buffer = mbedtls_calloc(1, allocation_size);
-                        if (input_buffer == NULL) {
-                            psa_mac_abort(msg.rhandle);
-                            status = PSA_ERROR_INSUFFICIENT_MEMORY;
-                        } else {
-                            while (data_remaining > 0) {
-                                size_to_read = MIN(data_remaining, MAX_DATA_CHUNK_SIZE_IN_BYTES);
-
-                                bytes_read = psa_read(msg.handle, 1, input_buffer, size_to_read);
-                                if (bytes_read != size_to_read) {
-                                    SPM_PANIC("SPM read length mismatch");
-                                }
-
-                                status = psa_mac_update(msg.rhandle, input_buffer, bytes_read);
-                                // stop on error
-                                if (status != PSA_SUCCESS) {
-                                    break;
-                                }
-                                data_remaining = data_remaining - bytes_read;
-                            }
+                    if (data_remaining == 0) {
+                        status = psa_mac_update(msg.rhandle, NULL, 0);
+                    }
+                    while (data_remaining > 0) {
+                        size_to_read = MIN(data_remaining, MAX_DATA_CHUNK_SIZE_IN_BYTES);
 
-                            mbedtls_free(input_buffer);
+                        bytes_read = psa_read(msg.handle, 1, psa_spm_data_chunk, size_to_read);
+                        if (bytes_read != size_to_read) {
+                            SPM_PANIC("SPM read length mismatch");
                         }
-                    } else {
-                        status = psa_mac_update(msg.rhandle, input_buffer, allocation_size);
+
+                        status = psa_mac_update(msg.rhandle, psa_spm_data_chunk, bytes_read);
+                        // stop on error
+                        if (status != PSA_SUCCESS) {
+                            break;
+                        }
+                        data_remaining = data_remaining - bytes_read;
                     }
 
                     if (status != PSA_SUCCESS) {
@@ -441,37 +434,26 @@ static void psa_hash_operation(void)
                 }
 
                 case PSA_HASH_UPDATE: {
-                    uint8_t *input_buffer = NULL;
                     size_t data_remaining = msg.in_size[1];
                     size_t size_to_read = 0;
-                    size_t allocation_size = MIN(data_remaining, MAX_DATA_CHUNK_SIZE_IN_BYTES);
 
-                    if (allocation_size > 0) {
-                        input_buffer = mbedtls_calloc(1, allocation_size);
-                        if (input_buffer == NULL) {
-                            psa_hash_abort(msg.rhandle);
-                            status = PSA_ERROR_INSUFFICIENT_MEMORY;
-                        } else {
-                            while (data_remaining > 0) {
-                                size_to_read = MIN(data_remaining, MAX_DATA_CHUNK_SIZE_IN_BYTES);
-
-                                bytes_read = psa_read(msg.handle, 1, input_buffer, size_to_read);
-                                if (bytes_read != size_to_read) {
-                                    SPM_PANIC("SPM read length mismatch");
-                                }
-
-                                status = psa_hash_update(msg.rhandle, input_buffer, bytes_read);
-                                // stop on error
-                                if (status != PSA_SUCCESS) {
-                                    break;
-                                }
-                                data_remaining = data_remaining - bytes_read;
-                            }
+                    if (data_remaining == 0) {
+                        status = psa_hash_update(msg.rhandle, NULL, 0);
+                    }
+                    while (data_remaining > 0) {
+                        size_to_read = MIN(data_remaining, MAX_DATA_CHUNK_SIZE_IN_BYTES);
 
-                            mbedtls_free(input_buffer);
+                        bytes_read = psa_read(msg.handle, 1, psa_spm_data_chunk, size_to_read);
+                        if (bytes_read != size_to_read) {
+                            SPM_PANIC("SPM read length mismatch");
                         }
-                    } else {
-                        status = psa_hash_update(msg.rhandle, input_buffer, allocation_size);
+
+                        status = psa_hash_update(msg.rhandle, psa_spm_data_chunk, bytes_read);
+                        // stop on error
+                        if (status != PSA_SUCCESS) {
+                            break;
+                        }
+                        data_remaining = data_remaining - bytes_read;
                     }
 
                     if (status != PSA_SUCCESS) {
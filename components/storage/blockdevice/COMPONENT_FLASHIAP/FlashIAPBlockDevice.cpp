@@ -243,6 +243,15 @@ int FlashIAPBlockDevice::get_erase_value() const
     return erase_val;
 }
 
+const void *FlashIAPBlockDevice::get_mapped_address(bd_addr_t virtual_address, bd_size_t size)
+{
+    if (!_is_initialized || (virtual_address + size > _size)) {
+        return NULL;
+    }
+
+    return _flash.get_mapped_address(_base + virtual_address);
+}
+
 
 bd_size_t FlashIAPBlockDevice::size() const
 {
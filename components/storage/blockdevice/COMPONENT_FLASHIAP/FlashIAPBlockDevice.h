@@ -115,6 +115,14 @@ public:
      */
     virtual int get_erase_value() const;
 
+    /** Get a pointer through which a region can be read in place
+     *
+     *  @param addr     Address of the region
+     *  @param size     Size of the region in bytes
+     *  @return         Pointer to the region, or NULL if internal flash is not memory mapped
+     */
+    virtual const void *get_mapped_address(mbed::bd_addr_t addr, mbed::bd_size_t size);
+
     /** Get the total size of the underlying device
      *
      *  @return         Size of the underlying device in bytes
@@ -80,6 +80,14 @@ using namespace mbed;
 
 #define IS_MEM_READY_MAX_RETRIES 10000
 
+#ifndef MBED_CONF_QSPIF_QSPI_MEMORY_MAPPED
+#define MBED_CONF_QSPIF_QSPI_MEMORY_MAPPED 0
+#endif
+
+#ifndef MBED_CONF_QSPIF_QSPI_ASYNC_READ_THRESHOLD
+#define MBED_CONF_QSPIF_QSPI_ASYNC_READ_THRESHOLD 0
+#endif
+
 enum qspif_default_instructions {
     QSPIF_NOP  = 0x00, // No operation
     QSPIF_PP = 0x02, // Page Program data
@@ -112,7 +120,7 @@ PinName *QSPIFBlockDevice::_active_qspif_flash_csel_arr = generate_initialized_a
 QSPIFBlockDevice::QSPIFBlockDevice(PinName io0, PinName io1, PinName io2, PinName io3, PinName sclk, PinName csel,
                                    int clock_mode, int freq)
     : _qspi(io0, io1, io2, io3, sclk, csel, clock_mode), _csel(csel), _freq(freq), _device_size_bytes(0),
-      _init_ref_count(0),
+      _memory_map_base(NULL), _init_ref_count(0),
       _is_initialized(false)
 {
     _unique_device_status = add_new_csel_instance(csel);
@@ -301,6 +309,12 @@ int QSPIFBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
 
     _mutex.lock();
 
+    if (MBED_CONF_QSPIF_QSPI_MEMORY_MAPPED && _qspi_memory_map()) {
+        memcpy(buffer, _memory_map_base + addr, size);
+        _mutex.unlock();
+        return status;
+    }
+
     // Configure Bus for Reading
     _qspi_configure_format(_inst_width, _address_width, _address_size, QSPI_CFG_BUS_SINGLE,
                            QSPI_CFG_ALT_SIZE_8, _data_width, _dummy_and_mode_cycles);
@@ -1323,6 +1337,24 @@ qspi_status_t QSPIFBlockDevice::_qspi_send_read_command(unsigned int read_inst,
     // Send Read command to device driver
     size_t buf_len = size;
 
+    _qspi_memory_unmap();
+
+#if MBED_CONF_RTOS_PRESENT
+    if (MBED_CONF_QSPIF_QSPI_ASYNC_READ_THRESHOLD > 0 && size >= MBED_CONF_QSPIF_QSPI_ASYNC_READ_THRESHOLD) {
+        // Sleep while the data phase runs in the background so other threads get the CPU
+        if (_qspi.read_async(read_inst, -1, (unsigned int)addr, (char *)buffer, buf_len,
+                             mbed::callback(this, &QSPIFBlockDevice::_qspi_async_read_done)) == QSPI_STATUS_OK) {
+            _async_sem.acquire();
+            if (_async_status != QSPI_STATUS_OK) {
+                tr_error("Async read failed");
+                return QSPI_STATUS_ERROR;
+            }
+            return QSPI_STATUS_OK;
+        }
+        // Not supported by the target or for this buffer, use a blocking read
+    }
+#endif
+
     if (_qspi.read(read_inst, -1, (unsigned int)addr, (char *)buffer, &buf_len) != QSPI_STATUS_OK) {
         tr_error("Read failed");
         return QSPI_STATUS_ERROR;
@@ -1332,12 +1364,22 @@ qspi_status_t QSPIFBlockDevice::_qspi_send_read_command(unsigned int read_inst,
 
 }
 
+#if MBED_CONF_RTOS_PRESENT
+void QSPIFBlockDevice::_qspi_async_read_done(qspi_status_t status)
+{
+    _async_status = status;
+    _async_sem.release();
+}
+#endif
+
 qspi_status_t QSPIFBlockDevice::_qspi_send_program_command(unsigned int progInst, const void *buffer, bd_addr_t addr,
                                                            bd_size_t *size)
 {
     // Send Program (write) command to device driver
     qspi_status_t result = QSPI_STATUS_OK;
 
+    _qspi_memory_unmap();
+
     result = _qspi.write(progInst, -1, addr, (char *)buffer, (size_t *)size);
     if (result != QSPI_STATUS_OK) {
         tr_error("QSPI Write failed");
@@ -1351,6 +1393,8 @@ qspi_status_t QSPIFBlockDevice::_qspi_send_erase_command(unsigned int erase_inst
     // Send Erase Instruction command to driver
     qspi_status_t result = QSPI_STATUS_OK;
 
+    _qspi_memory_unmap();
+
     tr_debug("Inst: 0x%xh, addr: %llu, size: %llu", erase_inst, addr, size);
 
     result = _qspi.command_transfer(erase_inst, // command to send
@@ -1373,6 +1417,8 @@ qspi_status_t QSPIFBlockDevice::_qspi_send_general_command(unsigned int instruct
                                                            size_t tx_length, const char *rx_buffer, size_t rx_length)
 {
     // Send a general command Instruction to driver
+    _qspi_memory_unmap();
+
     qspi_status_t status = _qspi.command_transfer(instruction, (int)addr, tx_buffer, tx_length, rx_buffer, rx_length);
 
     if (QSPI_STATUS_OK != status) {
@@ -1387,12 +1433,53 @@ qspi_status_t QSPIFBlockDevice::_qspi_configure_format(qspi_bus_width_t inst_wid
                                                        int dummy_cycles)
 {
     // Configure QSPI driver Bus format
+    _qspi_memory_unmap();
+
     qspi_status_t status = _qspi.configure_format(inst_width, address_width, address_size, alt_width, alt_size, data_width,
                                                   dummy_cycles);
 
     return status;
 }
 
+bool QSPIFBlockDevice::_qspi_memory_map()
+{
+    if (_memory_map_base) {
+        return true;
+    }
+
+    // The peripheral keeps issuing the read command as configured here while mapped
+    _qspi_configure_format(_inst_width, _address_width, _address_size, QSPI_CFG_BUS_SINGLE,
+                           QSPI_CFG_ALT_SIZE_8, _data_width, _dummy_and_mode_cycles);
+
+    const void *base = NULL;
+    if (QSPI_STATUS_OK == _qspi.memory_map(_read_instruction, -1, &base)) {
+        tr_debug("Memory mapped at 0x%lxh", (uint32_t)base);
+        _memory_map_base = static_cast<const uint8_t *>(base);
+        return true;
+    }
+
+    // Not supported by the target, keep using indirect reads
+    _qspi_configure_format(QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_SINGLE, QSPI_CFG_ADDR_SIZE_24, QSPI_CFG_BUS_SINGLE,
+                           QSPI_CFG_ALT_SIZE_8, QSPI_CFG_BUS_SINGLE, 0);
+    return false;
+}
+
+void QSPIFBlockDevice::_qspi_memory_unmap()
+{
+    if (!_memory_map_base) {
+        return;
+    }
+
+    if (QSPI_STATUS_OK != _qspi.memory_unmap()) {
+        tr_error("Memory unmap failed");
+    }
+    // Cleared first, so configuring the format below doesn't recurse
+    _memory_map_base = NULL;
+
+    _qspi_configure_format(QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_SINGLE, QSPI_CFG_ADDR_SIZE_24, QSPI_CFG_BUS_SINGLE,
+                           QSPI_CFG_ALT_SIZE_8, QSPI_CFG_BUS_SINGLE, 0);
+}
+
 /*********************************************/
 /************** Local Functions **************/
 /*********************************************/
@@ -18,6 +18,9 @@
 
 #include "QSPI.h"
 #include "BlockDevice.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Semaphore.h"
+#endif
 
 /** Enum qspif standard error codes
  *
@@ -256,6 +259,17 @@ private:
     // Send set_frequency command to Driver
     qspi_status_t _qspi_set_frequency(int freq);
 
+    // Map the device for reads with the current read bus mode (no-op if already mapped)
+    bool _qspi_memory_map();
+
+    // Return the driver to indirect mode ahead of any other command (no-op if not mapped)
+    void _qspi_memory_unmap();
+
+#if MBED_CONF_RTOS_PRESENT
+    // Called from interrupt context when an asynchronous read ends
+    void _qspi_async_read_done(qspi_status_t status);
+#endif
+
     /*********************************/
     /* Flash Configuration Functions */
     /*********************************/
@@ -361,6 +375,15 @@ private:
     qspi_bus_width_t _data_width; //Bus width for Data phase
     int _dummy_and_mode_cycles; // Number of Dummy and Mode Bits required by Current Bus Mode
 
+    // Base of the memory-mapped device while reads are served by memcpy, NULL in indirect mode
+    const uint8_t *_memory_map_base;
+
+#if MBED_CONF_RTOS_PRESENT
+    // Signalled when an asynchronous read ends
+    rtos::Semaphore _async_sem;
+    volatile qspi_status_t _async_status;
+#endif
+
     uint32_t _init_ref_count;
     bool _is_initialized;
 };
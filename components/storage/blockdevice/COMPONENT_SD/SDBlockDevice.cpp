@@ -82,10 +82,16 @@
  * just always use the Standard Capacity cards with a block size of 512 bytes.
  * This is set with CMD16.
  *
- * You can read and write single blocks (CMD17, CMD25) or multiple blocks
- * (CMD18, CMD25). For simplicity, I'll just use single block accesses. When
- * the card gets a read command, it responds with a response token, and then
- * a data token or an error.
+ * You can read and write single blocks (CMD17, CMD24) or multiple blocks
+ * (CMD18, CMD25). Accesses of more than one block use the multiple block
+ * commands, with ACMD23 telling the card how many blocks to pre-erase before
+ * a multiple block write. When the card gets a read command, it responds with
+ * a response token, and then a data token or an error.
+ *
+ * On targets with asynchronous SPI, the data of each block can be moved with
+ * SPI::transfer, so DMA does the transfer while the CRC of the block is
+ * computed (on write) or the CRC of the previous block is checked (on read).
+ * This is enabled with the sd.SPI_DMA_TRANSFER configuration option.
  *
  * SPI Command Format
  * ------------------
@@ -146,6 +152,7 @@
 #endif
 #include <inttypes.h>
 #include <errno.h>
+#include <string.h>
 
 using namespace mbed;
 
@@ -269,6 +276,11 @@ SDBlockDevice::SDBlockDevice(PinName mosi, PinName miso, PinName sclk, PinName c
     _transfer_sck = hz;
 
     _erase_size = BLOCK_SIZE_HC;
+
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_SPI_DMA_TRANSFER
+    _transfer_busy = false;
+    _transfer_event = 0;
+#endif
 }
 
 SDBlockDevice::~SDBlockDevice()
@@ -553,6 +565,10 @@ int SDBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
         return status;
     }
 
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_SPI_DMA_TRANSFER
+    // receive the data : one block at a time, checking each block while the next one arrives
+    status = _read_blocks(buffer, blockCnt);
+#else
     // receive the data : one block at a time
     while (blockCnt) {
         if (0 != _read(buffer, _block_size)) {
@@ -562,6 +578,7 @@ int SDBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
         buffer += _block_size;
         --blockCnt;
     }
+#endif
     _deselect();
 
     // Send CMD12(0x00000000) to stop the transmission for multi-block transfer
@@ -948,17 +965,111 @@ int SDBlockDevice::_read(uint8_t *buffer, uint32_t length)
     return 0;
 }
 
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_SPI_DMA_TRANSFER
+int SDBlockDevice::_read_blocks(uint8_t *buffer, uint32_t count)
+{
+    uint8_t *prev_buffer = NULL;
+    uint16_t prev_crc = 0;
+    uint16_t crc;
+    int status = BD_ERROR_OK;
+
+    while (count) {
+        // read until start byte (0xFE)
+        if (false == _wait_token(SPI_START_BLOCK)) {
+            debug_if(SD_DBG, "Read timeout\n");
+            status = SD_BLOCK_DEVICE_ERROR_NO_RESPONSE;
+            break;
+        }
+
+        // The buffer is also sent, so the card sees the fill character on MOSI
+        memset(buffer, SPI_FILL_CHAR, _block_size);
+        _transfer_start(buffer, buffer, _block_size);
+
+        // Check the previous block while this one is received
+        if (prev_buffer) {
+            status = _check_crc(prev_buffer, _block_size, prev_crc);
+        }
+
+        if (0 != _transfer_wait()) {
+            return SD_BLOCK_DEVICE_ERROR_NO_RESPONSE;
+        }
+        if (BD_ERROR_OK != status) {
+            return status;
+        }
+
+        // Read the CRC16 checksum for the data block
+        crc = (_spi.write(SPI_FILL_CHAR) << 8);
+        crc |= _spi.write(SPI_FILL_CHAR);
+
+        prev_buffer = buffer;
+        prev_crc = crc;
+        buffer += _block_size;
+        --count;
+    }
+
+    if (prev_buffer && (BD_ERROR_OK == status)) {
+        status = _check_crc(prev_buffer, _block_size, prev_crc);
+    }
+    return status;
+}
+
+int SDBlockDevice::_check_crc(const uint8_t *buffer, uint32_t length, uint16_t crc)
+{
+#if MBED_CONF_SD_CRC_ENABLED
+    if (_crc_on) {
+        uint32_t crc_result;
+        // Compute and verify checksum
+        _crc16.compute((void *)buffer, length, &crc_result);
+        if ((uint16_t)crc_result != crc) {
+            debug_if(SD_DBG, "_read_blocks: Invalid CRC received 0x%" PRIx16 " result of computation 0x%" PRIx16 "\n",
+                     crc, (uint16_t)crc_result);
+            return SD_BLOCK_DEVICE_ERROR_CRC;
+        }
+    }
+#endif
+    return BD_ERROR_OK;
+}
+
+void SDBlockDevice::_transfer_start(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t length)
+{
+    _transfer_busy = true;
+    if (0 != _spi.transfer(tx_buffer, length, rx_buffer, rx_buffer ? length : 0,
+                           mbed::callback(this, &SDBlockDevice::_transfer_done), SPI_EVENT_ALL)) {
+        _transfer_done(SPI_EVENT_ERROR);
+    }
+}
+
+void SDBlockDevice::_transfer_done(int event)
+{
+    _transfer_event = event;
+    _transfer_busy = false;
+}
+
+int SDBlockDevice::_transfer_wait()
+{
+    // A block at the transfer frequency takes less time than a context switch would save
+    while (_transfer_busy) {
+    }
+    return (_transfer_event & SPI_EVENT_COMPLETE) ? BD_ERROR_OK : BD_ERROR_DEVICE_ERROR;
+}
+#endif
+
 uint8_t SDBlockDevice::_write(const uint8_t *buffer, uint8_t token, uint32_t length)
 {
 
     uint32_t crc = (~0);
     uint8_t response = 0xFF;
+    bool transfer_failed = false;
 
     // indicate start of block
     _spi.write(token);
 
     // write the data
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_SPI_DMA_TRANSFER
+    _transfer_start(buffer, NULL, length);
+#else
     _spi.write((char *)buffer, length, NULL, 0);
+#endif
 
 #if MBED_CONF_SD_CRC_ENABLED
     if (_crc_on) {
@@ -967,6 +1078,14 @@ uint8_t SDBlockDevice::_write(const uint8_t *buffer, uint8_t token, uint32_t len
     }
 #endif
 
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_SPI_DMA_TRANSFER
+    // CRC is computed while the data is sent
+    if (0 != _transfer_wait()) {
+        debug_if(SD_DBG, "Block transfer failed\n");
+        transfer_failed = true;
+    }
+#endif
+
     // write the checksum CRC16
     _spi.write(crc >> 8);
     _spi.write(crc);
@@ -980,6 +1099,9 @@ uint8_t SDBlockDevice::_write(const uint8_t *buffer, uint8_t token, uint32_t len
         debug_if(SD_DBG, "Card not ready yet \n");
     }
 
+    if (transfer_failed) {
+        return SPI_DATA_WRITE_ERROR;
+    }
     return (response & SPI_DATA_RESPONSE_MASK);
 }
 
@@ -1107,6 +1229,9 @@ void SDBlockDevice::_spi_init()
     _spi.frequency(_init_sck);
     _spi.format(8, 0);
     _spi.set_default_write_value(SPI_FILL_CHAR);
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_SPI_DMA_TRANSFER
+    _spi.set_dma_usage(DMA_USAGE_ALWAYS);
+#endif
     // Initial 74 cycles required for few cards, before selecting SPI mode
     _cs = 1;
     _spi_wait(10);
@@ -230,6 +230,17 @@ private:
     int _read(uint8_t *buffer, uint32_t length);
     int _read_bytes(uint8_t *buffer, uint32_t length);
     uint8_t _write(const uint8_t *buffer, uint8_t token, uint32_t length);
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_SPI_DMA_TRANSFER
+    int _read_blocks(uint8_t *buffer, uint32_t count);
+    int _check_crc(const uint8_t *buffer, uint32_t length, uint16_t crc);
+
+    /* Asynchronous block transfer, only one in flight at a time */
+    void _transfer_start(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t length);
+    void _transfer_done(int event);
+    int _transfer_wait();
+    volatile bool _transfer_busy;   /**< Set while an asynchronous transfer is in flight */
+    int _transfer_event;            /**< SPI event the last asynchronous transfer completed with */
+#endif
     int _freq(void);
 
     /* Chip Select and SPI mode select */
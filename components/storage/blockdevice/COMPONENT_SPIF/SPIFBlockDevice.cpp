@@ -80,6 +80,7 @@ enum spif_default_instructions {
     SPIF_NOP = 0x00, // No operation
     SPIF_PP = 0x02, // Page Program data
     SPIF_READ = 0x03, // Read data
+    SPIF_FAST_READ = 0x0b, // Read data with 8 dummy cycles, allows full bus frequency
     SPIF_SE   = 0x20, // 4KB Sector Erase
     SPIF_SFDP = 0x5a, // Read SFDP
     SPIF_WRSR = 0x01, // Write Status/Configuration Register
@@ -122,6 +123,9 @@ SPIFBlockDevice::SPIFBlockDevice(
     if (SPIF_BD_ERROR_OK != _spi_set_frequency(freq)) {
         tr_error("SPI Set Frequency Failed");
     }
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_SPI_DMA_TRANSFER
+    _spi.set_dma_usage(DMA_USAGE_ALWAYS);
+#endif
 
     _cs = 1;
 }
@@ -504,13 +508,11 @@ spif_bd_error SPIFBlockDevice::_spi_send_read_command(int read_inst, uint8_t *bu
     }
 
     // Read Data
-    for (bd_size_t i = 0; i < size; i++) {
-        buffer[i] = _spi.write(0);
-    }
+    int status = _spi_transfer_data(NULL, buffer, size);
 
     // csel back to high
     _cs = 1;
-    return SPIF_BD_ERROR_OK;
+    return (status == 0) ? SPIF_BD_ERROR_OK : SPIF_BD_ERROR_DEVICE_ERROR;
 }
 
 spif_bd_error SPIFBlockDevice::_spi_send_program_command(int prog_inst, const void *buffer, bd_addr_t addr,
@@ -538,15 +540,41 @@ spif_bd_error SPIFBlockDevice::_spi_send_program_command(int prog_inst, const vo
     }
 
     // Write Data
-    for (bd_size_t i = 0; i < size; i++) {
-        _spi.write(data[i]);
-    }
+    int status = _spi_transfer_data(data, NULL, size);
 
     // csel back to high
     _cs = 1;
 
-    return SPIF_BD_ERROR_OK;
+    return (status == 0) ? SPIF_BD_ERROR_OK : SPIF_BD_ERROR_DEVICE_ERROR;
+}
+
+int SPIFBlockDevice::_spi_transfer_data(const uint8_t *tx_buffer, uint8_t *rx_buffer, bd_size_t size)
+{
+    // Data phase as a single block transfer rather than a byte per call
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_SPI_DMA_TRANSFER
+    _transfer_busy = true;
+    if (0 != _spi.transfer(tx_buffer, tx_buffer ? (int)size : 0, rx_buffer, rx_buffer ? (int)size : 0,
+                           mbed::callback(this, &SPIFBlockDevice::_transfer_done), SPI_EVENT_ALL)) {
+        _transfer_done(SPI_EVENT_ERROR);
+    }
+
+    // A page at the transfer frequency takes less time than a context switch would save
+    while (_transfer_busy) {
+    }
+    return (_transfer_event & SPI_EVENT_COMPLETE) ? 0 : -1;
+#else
+    _spi.write((const char *)tx_buffer, tx_buffer ? (int)size : 0, (char *)rx_buffer, rx_buffer ? (int)size : 0);
+    return 0;
+#endif
+}
+
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_SPI_DMA_TRANSFER
+void SPIFBlockDevice::_transfer_done(int event)
+{
+    _transfer_event = event;
+    _transfer_busy = false;
 }
+#endif
 
 spif_bd_error SPIFBlockDevice::_spi_send_erase_command(int erase_inst, bd_addr_t addr, bd_size_t size)
 {
@@ -831,6 +859,9 @@ int SPIFBlockDevice::_sfdp_detect_best_bus_read_mode(uint8_t *basic_param_table_
     do {
 
         // TBD - SPIF Dual Read Modes Require SPI driver support
+        // mbed::SPI drives a single data line, so the best mode available is 1-1-1 Fast Read,
+        // which JESD216 requires of every SFDP device and which is specified up to the full bus
+        // frequency, unlike legacy Read (0x03)
         /*
         uint8_t examined_byte;
 
@@ -860,7 +891,8 @@ int SPIFBlockDevice::_sfdp_detect_best_bus_read_mode(uint8_t *basic_param_table_
             break;
         }
          */
-        _read_dummy_and_mode_cycles = 0;
+        read_inst = SPIF_FAST_READ;
+        _read_dummy_and_mode_cycles = 8;
     } while (false);
 
     return 0;
@@ -993,17 +1025,20 @@ int SPIFBlockDevice::_utils_iterate_next_largest_erase_type(uint8_t &bitfield, i
     for (i_ind = 3; i_ind >= 0; i_ind--) {
         if (bitfield & type_mask) {
             largest_erase_type = i_ind;
-            if ((size > (int)(_erase_type_size_arr[largest_erase_type])) &&
-                    ((boundry - offset) > (int)(_erase_type_size_arr[largest_erase_type]))) {
+            int type_size = (int)_erase_type_size_arr[largest_erase_type];
+            // The type must cover whole aligned blocks only, anything else would erase data around the range
+            if ((size >= type_size) && ((boundry - offset) >= (type_size - 1)) && ((offset % type_size) == 0)) {
                 break;
-            } else {
+            }
+            if (size < type_size) {
+                // Remaining size only shrinks, this type will not fit again
                 bitfield &= ~type_mask;
             }
         }
         type_mask = type_mask >> 1;
     }
 
-    if (i_ind == 4) {
+    if (i_ind < 0) {
         tr_error("no erase type was found for current region addr");
     }
     return largest_erase_type;
@@ -252,6 +252,12 @@ private:
 
     // Send set_frequency command to Driver
     spif_bd_error _spi_set_frequency(int freq);
+
+    // Transfer the data phase of a command as one block (DMA when enabled)
+    int _spi_transfer_data(const uint8_t *tx_buffer, uint8_t *rx_buffer, mbed::bd_size_t size);
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_SPI_DMA_TRANSFER
+    void _transfer_done(int event);
+#endif
     /********************************/
 
     // Soft Reset Flash Memory
@@ -301,6 +307,11 @@ private:
     unsigned int _dummy_and_mode_cycles; // Number of Dummy and Mode Bits required by Current Bus Mode
     uint32_t _init_ref_count;
     bool _is_initialized;
+
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_SPI_DMA_TRANSFER
+    volatile bool _transfer_busy; // Set while an asynchronous transfer is in flight
+    int _transfer_event; // SPI event the last asynchronous transfer completed with
+#endif
 };
 
 #endif  /* MBED_SPIF_BLOCK_DEVICE_H */
@@ -69,10 +69,18 @@ ESP8266::ESP8266(PinName tx, PinName rx, bool debug, PinName rts, PinName cts)
     //https://www.espressif.com/sites/default/files/documentation/4a-esp8266_at_instruction_set_en.pdf
     //Also seems that ERROR is not sent, but FAIL instead
     _parser.oob("0,CLOSED", callback(this, &ESP8266::_oob_socket0_closed));
+#if MBED_CONF_ESP8266_SOCKET_COUNT > 1
     _parser.oob("1,CLOSED", callback(this, &ESP8266::_oob_socket1_closed));
+#endif
+#if MBED_CONF_ESP8266_SOCKET_COUNT > 2
     _parser.oob("2,CLOSED", callback(this, &ESP8266::_oob_socket2_closed));
+#endif
+#if MBED_CONF_ESP8266_SOCKET_COUNT > 3
     _parser.oob("3,CLOSED", callback(this, &ESP8266::_oob_socket3_closed));
+#endif
+#if MBED_CONF_ESP8266_SOCKET_COUNT > 4
     _parser.oob("4,CLOSED", callback(this, &ESP8266::_oob_socket4_closed));
+#endif
     _parser.oob("+CWJAP:", callback(this, &ESP8266::_oob_connect_err));
     _parser.oob("WIFI ", callback(this, &ESP8266::_oob_connection_status));
     _parser.oob("UNLINK", callback(this, &ESP8266::_oob_socket_close_err));
@@ -308,7 +316,7 @@ bool ESP8266::cond_enable_tcp_passive_mode()
 {
     bool done = true;
 
-    if (FW_AT_LEAST_VERSION(_at_v.major, _at_v.minor, _at_v.patch, 0, ESP8266_AT_VERSION_TCP_PASSIVE_MODE)) {
+    if (MBED_CONF_ESP8266_TCP_PASSIVE_MODE && FW_AT_LEAST_VERSION(_at_v.major, _at_v.minor, _at_v.patch, 0, ESP8266_AT_VERSION_TCP_PASSIVE_MODE)) {
         _smutex.lock();
         done = _parser.send("AT+CIPRECVMODE=1")
                && _parser.recv("OK\n");
@@ -665,7 +673,7 @@ void ESP8266::_oob_packet_hdlr()
     int pdu_len;
 
     // Get socket id
-    if (!_parser.recv(",%d,", &id)) {
+    if (!_parser.recv(",%d,", &id) || id < 0 || id >= SOCKET_COUNT) {
         return;
     }
 
@@ -914,7 +922,7 @@ void ESP8266::_clear_socket_packets(int id)
         }
     }
     if (id == ESP8266_ALL_SOCKET_IDS) {
-        for (int id = 0; id < 5; id++) {
+        for (int id = 0; id < SOCKET_COUNT; id++) {
             _sock_i[id].tcp_data_avbl = 0;
         }
     } else {
@@ -1124,39 +1132,37 @@ void ESP8266::_oob_socket_close_err()
     _closed = true; // Not possible to pinpoint to a certain socket
 }
 
+void ESP8266::_oob_socket_closed(int id)
+{
+    if (id < SOCKET_COUNT) {
+        _sock_i[id].open = false;
+        tr_debug("socket %d closed", id);
+    }
+}
+
 void ESP8266::_oob_socket0_closed()
 {
-    static const int id = 0;
-    _sock_i[id].open = false;
-    tr_debug("socket %d closed", id);
+    _oob_socket_closed(0);
 }
 
 void ESP8266::_oob_socket1_closed()
 {
-    static const int id = 1;
-    _sock_i[id].open = false;
-    tr_debug("socket %d closed", id);
+    _oob_socket_closed(1);
 }
 
 void ESP8266::_oob_socket2_closed()
 {
-    static const int id = 2;
-    _sock_i[id].open = false;
-    tr_debug("socket %d closed", id);
+    _oob_socket_closed(2);
 }
 
 void ESP8266::_oob_socket3_closed()
 {
-    static const int id = 3;
-    _sock_i[id].open = false;
-    tr_debug("socket %d closed", id);
+    _oob_socket_closed(3);
 }
 
 void ESP8266::_oob_socket4_closed()
 {
-    static const int id = 4;
-    _sock_i[id].open = false;
-    tr_debug("socket %d closed", id);
+    _oob_socket_closed(4);
 }
 
 void ESP8266::_oob_connection_status()
@@ -26,6 +26,7 @@
 #include "PinNames.h"
 #include "platform/ATCmdParser.h"
 #include "platform/Callback.h"
+#include "platform/mbed_assert.h"
 #include "platform/mbed_error.h"
 #include "rtos/ConditionVariable.h"
 #include "rtos/Mutex.h"
@@ -44,6 +45,17 @@
 #define ESP8266_MISC_TIMEOUT    2000
 #endif
 
+// Link IDs the AT firmware multiplexes, at most 5
+#ifndef MBED_CONF_ESP8266_SOCKET_COUNT
+#define MBED_CONF_ESP8266_SOCKET_COUNT 5
+#endif
+MBED_STATIC_ASSERT(MBED_CONF_ESP8266_SOCKET_COUNT >= 1 && MBED_CONF_ESP8266_SOCKET_COUNT <= 5,
+                   "esp8266.socket-count must be between 1 and 5");
+
+#ifndef MBED_CONF_ESP8266_TCP_PASSIVE_MODE
+#define MBED_CONF_ESP8266_TCP_PASSIVE_MODE 1
+#endif
+
 #define ESP8266_SCAN_TIME_MIN 0     // [ms]
 #define ESP8266_SCAN_TIME_MAX 1500  // [ms]
 #define ESP8266_SCAN_TIME_MIN_DEFAULT 120 // [ms]
@@ -403,7 +415,7 @@ public:
     static const int8_t WIFIMODE_STATION = 1;
     static const int8_t WIFIMODE_SOFTAP = 2;
     static const int8_t WIFIMODE_STATION_SOFTAP = 3;
-    static const int8_t SOCKET_COUNT = 5;
+    static const int8_t SOCKET_COUNT = MBED_CONF_ESP8266_SOCKET_COUNT;
 
 private:
     // FW version
@@ -455,6 +467,7 @@ private:
     void _oob_socket2_closed();
     void _oob_socket3_closed();
     void _oob_socket4_closed();
+    void _oob_socket_closed(int id);
     void _oob_connection_status();
     void _oob_socket_close_err();
     void _oob_watchdog_reset();
@@ -33,7 +33,7 @@
 #include "rtos/ConditionVariable.h"
 #include "rtos/Mutex.h"
 
-#define ESP8266_SOCKET_COUNT 5
+#define ESP8266_SOCKET_COUNT MBED_CONF_ESP8266_SOCKET_COUNT
 
 #define ESP8266_INTERFACE_CONNECT_INTERVAL_MS (5000)
 #define ESP8266_INTERFACE_CONNECT_TIMEOUT_MS (2 * ESP8266_CONNECT_TIMEOUT + ESP8266_INTERFACE_CONNECT_INTERVAL_MS)
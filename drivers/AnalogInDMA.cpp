@@ -0,0 +1,116 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/AnalogInDMA.h"
+#include "platform/mbed_power_mgmt.h"
+
+#if DEVICE_ANALOGIN_DMA
+
+namespace mbed {
+
+AnalogInDMA::AnalogInDMA(PinName pin) : _channels(1), _rate(0), _buffer(NULL), _length(0), _running(false)
+{
+    lock();
+    analogin_dma_init(&_adc, &pin, 1);
+    unlock();
+}
+
+AnalogInDMA::AnalogInDMA(const PinName *pins, uint8_t channels) : _channels(channels), _rate(0), _buffer(NULL), _length(0), _running(false)
+{
+    lock();
+    analogin_dma_init(&_adc, pins, channels);
+    unlock();
+}
+
+AnalogInDMA::~AnalogInDMA()
+{
+    stop();
+    lock();
+    analogin_dma_free(&_adc);
+    unlock();
+}
+
+uint32_t AnalogInDMA::set_sample_rate(uint32_t hz)
+{
+    lock();
+    _rate = analogin_dma_set_rate(&_adc, hz);
+    uint32_t rate = _rate;
+    unlock();
+    return rate;
+}
+
+int AnalogInDMA::start(uint16_t *buffer, size_t length, Callback<void(const uint16_t *, size_t, int)> func)
+{
+    if (!buffer || !length || length % (2 * _channels) != 0) {
+        return -1;
+    }
+
+    lock();
+    if (_running || !_rate) {
+        unlock();
+        return -1;
+    }
+
+    _buffer = buffer;
+    _length = length;
+    _callback = func;
+    _running = true;
+    // The trigger timer and DMA need their clocks while sampling
+    sleep_manager_lock_deep_sleep();
+    if (analogin_dma_start(&_adc, buffer, length, &AnalogInDMA::_irq_handler, (uint32_t)this) != 0) {
+        _running = false;
+        sleep_manager_unlock_deep_sleep();
+        unlock();
+        return -1;
+    }
+    unlock();
+    return 0;
+}
+
+void AnalogInDMA::stop()
+{
+    lock();
+    if (_running) {
+        analogin_dma_stop(&_adc);
+        _running = false;
+        sleep_manager_unlock_deep_sleep();
+    }
+    unlock();
+}
+
+void AnalogInDMA::_irq_handler(uint32_t id, uint32_t event)
+{
+    AnalogInDMA *handler = (AnalogInDMA *)id;
+    if (!handler->_callback) {
+        return;
+    }
+
+    size_t half = handler->_length / 2;
+    if (event & ANALOGIN_DMA_EVENT_HALF) {
+        handler->_callback(handler->_buffer, half, ANALOGIN_DMA_EVENT_HALF);
+    }
+    if (event & ANALOGIN_DMA_EVENT_FULL) {
+        handler->_callback(handler->_buffer + half, half, ANALOGIN_DMA_EVENT_FULL);
+    }
+    if (event & ANALOGIN_DMA_EVENT_ERROR) {
+        handler->_callback(NULL, 0, ANALOGIN_DMA_EVENT_ERROR);
+    }
+}
+
+} // namespace mbed
+
+#endif
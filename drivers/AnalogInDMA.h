@@ -0,0 +1,142 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGIN_DMA_H
+#define MBED_ANALOGIN_DMA_H
+
+#include "platform/platform.h"
+
+#if DEVICE_ANALOGIN_DMA || defined(DOXYGEN_ONLY)
+
+#include "hal/analogin_dma_api.h"
+#include "platform/Callback.h"
+#include "platform/PlatformMutex.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Continuous sampling of one or more analog inputs
+ *
+ * Conversions are triggered by a hardware timer and stored by DMA into a
+ * circular buffer, so sampling does not jitter with interrupt latency. The
+ * buffer is used as a double buffer: the callback is called from interrupt
+ * context each time one half is filled, while the other half is being written.
+ * With several pins, each half holds interleaved samples in pin order.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * static uint16_t samples[512];
+ * static EventQueue queue;
+ *
+ * void process(const uint16_t *data, size_t count)
+ * {
+ *     // runs in thread context
+ * }
+ *
+ * void on_samples(const uint16_t *data, size_t count, int event)
+ * {
+ *     queue.call(process, data, count);
+ * }
+ *
+ * int main() {
+ *     AnalogInDMA vibration(A0);
+ *     vibration.set_sample_rate(20000);
+ *     vibration.start(samples, 512, on_samples);
+ *     queue.dispatch_forever();
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class AnalogInDMA : private NonCopyable<AnalogInDMA> {
+
+public:
+
+    /** Create an AnalogInDMA sampling a single pin
+     *
+     * @param pin AnalogIn pin to connect to
+     */
+    AnalogInDMA(PinName pin);
+
+    /** Create an AnalogInDMA sampling several pins of the same converter
+     *
+     * @param pins      Array of AnalogIn pins, sampled in this order
+     * @param channels  Number of pins in the array
+     */
+    AnalogInDMA(const PinName *pins, uint8_t channels);
+
+    ~AnalogInDMA();
+
+    /** Set the sampling rate, applied from the next call to start
+     *
+     * @param hz    Requested number of samples per second on each pin
+     * @return      The rate actually used, 0 if the rate cannot be achieved
+     */
+    uint32_t set_sample_rate(uint32_t hz);
+
+    /** Start continuous sampling
+     *
+     * The callback receives the half of the buffer that was just filled, the number
+     * of samples in it and the event (ANALOGIN_DMA_EVENT_HALF or ANALOGIN_DMA_EVENT_FULL).
+     * On ANALOGIN_DMA_EVENT_ERROR sampling has stopped and no samples are passed,
+     * call stop before starting again.
+     * The samples must be consumed before the same half is written again.
+     *
+     * @param buffer    Buffer the samples are stored in, must stay valid until stop
+     * @param length    Number of samples the buffer holds, a multiple of twice the number of pins
+     * @param func      Function called from interrupt context when a half is filled
+     * @return          0 on success, -1 on failure
+     */
+    int start(uint16_t *buffer, size_t length, Callback<void(const uint16_t *, size_t, int)> func);
+
+    /** Stop sampling
+     */
+    void stop();
+
+protected:
+#if !defined(DOXYGEN_ONLY)
+    static void _irq_handler(uint32_t id, uint32_t event);
+
+    virtual void lock()
+    {
+        _mutex.lock();
+    }
+
+    virtual void unlock()
+    {
+        _mutex.unlock();
+    }
+
+    analogin_dma_t _adc;
+    uint8_t _channels;
+    uint32_t _rate;
+    uint16_t *_buffer;
+    size_t _length;
+    bool _running;
+    Callback<void(const uint16_t *, size_t, int)> _callback;
+    PlatformMutex _mutex;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -19,10 +19,11 @@
 #if DEVICE_CAN
 
 #include "platform/mbed_power_mgmt.h"
+#include "platform/mbed_critical.h"
 
 namespace mbed {
 
-CAN::CAN(PinName rd, PinName td) : _can(), _irq()
+CAN::CAN(PinName rd, PinName td) : _can(), _irq(), _rx_filter_count(0), _rx_buffers(NULL), _rx_dropped(0)
 {
     // No lock needed in constructor
 
@@ -34,7 +35,7 @@ CAN::CAN(PinName rd, PinName td) : _can(), _irq()
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
 }
 
-CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq()
+CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq(), _rx_filter_count(0), _rx_buffers(NULL), _rx_dropped(0)
 {
     // No lock needed in constructor
 
@@ -51,6 +52,7 @@ CAN::~CAN()
     // No lock needed in destructor
 
     // Detaching interrupts releases the sleep lock if it was locked
+    set_rx_buffered(false);
     for (int irq = 0; irq < IrqCnt; irq++) {
         attach(NULL, (IrqType)irq);
     }
@@ -76,10 +78,63 @@ int CAN::write(CANMessage msg)
 
 int CAN::read(CANMessage &msg, int handle)
 {
+    return read(&msg, 1, handle);
+}
+
+int CAN::read(CANMessage *msgs, int count, int handle)
+{
+    int i = 0;
     lock();
-    int ret = can_read(&_can, &msg, handle);
+    if (_rx_buffers) {
+        int slot = _rx_slot(handle);
+        if (slot >= 0) {
+            for (; i < count; i++) {
+                // Pop one message at a time to keep interrupt latency low
+                core_util_critical_section_enter();
+                bool popped = _rx_buffers[slot].pop(msgs[i]);
+                core_util_critical_section_exit();
+                if (!popped) {
+                    break;
+                }
+            }
+        }
+    } else {
+        while (i < count && can_read(&_can, &msgs[i], handle)) {
+            i++;
+        }
+    }
     unlock();
-    return ret;
+    return i;
+}
+
+void CAN::set_rx_buffered(bool enable)
+{
+    lock();
+    if (enable && !_rx_buffers) {
+        rx_buffer_t *buffers = new rx_buffer_t[MBED_CONF_DRIVERS_CAN_RX_BUFFER_FILTERS + 1];
+        _rx_dropped = 0;
+        core_util_critical_section_enter();
+        _rx_buffers = buffers;
+        core_util_critical_section_exit();
+        sleep_manager_lock_deep_sleep();
+        can_irq_set(&_can, IRQ_RX, 1);
+    } else if (!enable && _rx_buffers) {
+        if (!_irq[IRQ_RX]) {
+            can_irq_set(&_can, IRQ_RX, 0);
+        }
+        sleep_manager_unlock_deep_sleep();
+        core_util_critical_section_enter();
+        rx_buffer_t *buffers = _rx_buffers;
+        _rx_buffers = NULL;
+        core_util_critical_section_exit();
+        delete[] buffers;
+    }
+    unlock();
+}
+
+unsigned int CAN::rx_dropped()
+{
+    return _rx_dropped;
 }
 
 void CAN::reset()
@@ -124,6 +179,24 @@ int CAN::filter(unsigned int id, unsigned int mask, CANFormat format, int handle
 {
     lock();
     int ret = can_filter(&_can, id, mask, format, handle);
+    if (ret && handle != 0) {
+        // Remember the filter to route buffered messages the same way the hardware does
+        int i = 0;
+        while (i < _rx_filter_count && _rx_filters[i].handle != handle) {
+            i++;
+        }
+        if (i < MBED_CONF_DRIVERS_CAN_RX_BUFFER_FILTERS) {
+            core_util_critical_section_enter();
+            _rx_filters[i].id = id;
+            _rx_filters[i].mask = mask;
+            _rx_filters[i].format = format;
+            _rx_filters[i].handle = handle;
+            if (i == _rx_filter_count) {
+                _rx_filter_count++;
+            }
+            core_util_critical_section_exit();
+        }
+    }
     unlock();
     return ret;
 }
@@ -144,7 +217,10 @@ void CAN::attach(Callback<void()> func, IrqType type)
             sleep_manager_unlock_deep_sleep();
         }
         _irq[(CanIrqType)type] = NULL;
-        can_irq_set(&_can, (CanIrqType)type, 0);
+        // Buffered reception keeps the receive interrupt enabled
+        if (!((CanIrqType)type == IRQ_RX && _rx_buffers)) {
+            can_irq_set(&_can, (CanIrqType)type, 0);
+        }
     }
     unlock();
 }
@@ -152,11 +228,47 @@ void CAN::attach(Callback<void()> func, IrqType type)
 void CAN::_irq_handler(uint32_t id, CanIrqType type)
 {
     CAN *handler = (CAN *)id;
+    if (type == IRQ_RX && handler->_rx_buffers) {
+        handler->_rx_drain();
+    }
     if (handler->_irq[type]) {
         handler->_irq[type].call();
     }
 }
 
+int CAN::_rx_slot(int handle)
+{
+    if (handle == 0) {
+        return 0;
+    }
+    for (int i = 0; i < _rx_filter_count; i++) {
+        if (_rx_filters[i].handle == handle) {
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+void CAN::_rx_drain()
+{
+    CANMessage msg;
+    while (can_read(&_can, &msg, 0)) {
+        int slot = 0;
+        for (int i = 0; i < _rx_filter_count; i++) {
+            const rx_filter_t &f = _rx_filters[i];
+            if ((f.format == CANAny || f.format == msg.format) && ((msg.id ^ f.id) & f.mask) == 0) {
+                slot = i + 1;
+                break;
+            }
+        }
+        if (_rx_buffers[slot].full()) {
+            _rx_dropped++;
+        } else {
+            _rx_buffers[slot].push(msg);
+        }
+    }
+}
+
 void CAN::lock()
 {
     _mutex.lock();
@@ -24,8 +24,17 @@
 #include "hal/can_api.h"
 #include "platform/Callback.h"
 #include "platform/PlatformMutex.h"
+#include "platform/CircularBuffer.h"
 #include "platform/NonCopyable.h"
 
+#ifndef MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE
+#define MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE 32
+#endif
+
+#ifndef MBED_CONF_DRIVERS_CAN_RX_BUFFER_FILTERS
+#define MBED_CONF_DRIVERS_CAN_RX_BUFFER_FILTERS 4
+#endif
+
 namespace mbed {
 /** \addtogroup drivers */
 
@@ -179,6 +188,8 @@ public:
     int write(CANMessage msg);
 
     /** Read a CANMessage from the bus.
+     *
+     *  In buffered mode the message is taken from the receive buffer of the filter.
      *
      *  @param msg A CANMessage to read to.
      *  @param handle message filter handle (0 for any message)
@@ -189,6 +200,42 @@ public:
      */
     int read(CANMessage &msg, int handle = 0);
 
+    /** Read several CANMessages from the bus.
+     *
+     *  In buffered mode the messages are taken from the receive buffer of the filter.
+     *
+     *  @param msgs Array of CANMessages to read to.
+     *  @param count Number of messages the array can hold
+     *  @param handle message filter handle (0 for any message)
+     *
+     *  @returns
+     *    number of messages read
+     */
+    int read(CANMessage *msgs, int count, int handle = 0);
+
+    /** Enable or disable buffered reception
+     *
+     *  In buffered mode the receive interrupt drains the hardware FIFO into
+     *  software ring buffers of drivers.can-rx-buffer-size messages, so
+     *  messages are not lost when the reading thread falls behind. Each
+     *  filter set with a non zero handle (up to drivers.can-rx-buffer-filters
+     *  of them) gets its own buffer, messages are stored in the buffer of the
+     *  first filter they match; read() with handle 0 returns the others.
+     *  A callback attached to RxIrq is still called after the FIFO is drained.
+     *
+     *  This function locks the deep sleep while buffered mode is enabled.
+     *
+     *  @param enable true to enable buffered reception, false to disable it
+     *                and discard the buffered messages
+     */
+    void set_rx_buffered(bool enable);
+
+    /** Get the number of messages dropped because a receive buffer was full
+     *
+     *  @returns number of messages dropped since buffered reception was enabled
+     */
+    unsigned int rx_dropped();
+
     /** Reset CAN interface.
      *
      * To use after error overflow.
@@ -221,6 +268,10 @@ public:
     int mode(Mode mode);
 
     /** Filter out incoming messages
+     *
+     *  The handle selects the hardware filter bank to configure, so that
+     *  several filters can be active at the same time on targets which
+     *  support it.
      *
      *  @param id the id to filter on
      *  @param mask the mask applied to the id
@@ -318,6 +369,24 @@ protected:
     can_t               _can;
     Callback<void()>    _irq[IrqCnt];
     PlatformMutex       _mutex;
+
+private:
+    struct rx_filter_t {
+        unsigned int id;
+        unsigned int mask;
+        CANFormat format;
+        int handle;
+    };
+    typedef CircularBuffer<CANMessage, MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE> rx_buffer_t;
+
+    int _rx_slot(int handle);
+    void _rx_drain();
+
+    rx_filter_t         _rx_filters[MBED_CONF_DRIVERS_CAN_RX_BUFFER_FILTERS];
+    int                 _rx_filter_count;
+    // One buffer per filter plus one for handle 0, NULL when not buffered
+    rx_buffer_t        *_rx_buffers;
+    unsigned int        _rx_dropped;
 #endif
 };
 
@@ -0,0 +1,114 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FASTDIGITALIN_H
+#define MBED_FASTDIGITALIN_H
+
+#include "platform/platform.h"
+#include "hal/gpio_fast_api.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** A digital input for bit-banging
+ *
+ * Like DigitalIn, but read() is a single load from a register of the
+ * target's fast GPIO API, see hal/gpio_fast_api.h. On targets without one
+ * it is a gpio_read call.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * FastDigitalIn miso(D12);
+ * FastDigitalOut sck(D13, 0);
+ *
+ * int read_bit() {
+ *     sck.set();
+ *     int bit = miso.read();
+ *     sck.clear();
+ *     return bit;
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class FastDigitalIn {
+
+public:
+    /** Create a FastDigitalIn connected to the specified pin
+     *
+     *  @param pin FastDigitalIn pin to connect to
+     */
+    FastDigitalIn(PinName pin) : gpio()
+    {
+        // No lock needed in the constructor
+        gpio_init_in(&gpio, pin);
+    }
+
+    /** Create a FastDigitalIn connected to the specified pin
+     *
+     *  @param pin FastDigitalIn pin to connect to
+     *  @param mode the initial mode of the pin
+     */
+    FastDigitalIn(PinName pin, PinMode mode) : gpio()
+    {
+        // No lock needed in the constructor
+        gpio_init_in_ex(&gpio, pin, mode);
+    }
+
+    /** Read the input, represented as 0 or 1 (int)
+     *
+     *  @returns
+     *    An integer representing the state of the input pin,
+     *    0 for logical 0, 1 for logical 1
+     */
+    int read()
+    {
+        // Single register read
+        return gpio_fast_read(&gpio);
+    }
+
+    /** Return the output setting, represented as 0 or 1 (int)
+     *
+     *  @returns
+     *    Non zero value if pin is connected to uc GPIO
+     *    0 if gpio object was initialized with NC
+     */
+    int is_connected()
+    {
+        // Thread safe / atomic HAL call
+        return gpio_is_connected(&gpio);
+    }
+
+    /** An operator shorthand for read()
+     * \sa FastDigitalIn::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+
+protected:
+#if !defined(DOXYGEN_ONLY)
+    gpio_t gpio;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+} // namespace mbed
+
+#endif
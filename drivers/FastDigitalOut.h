@@ -0,0 +1,151 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FASTDIGITALOUT_H
+#define MBED_FASTDIGITALOUT_H
+
+#include "platform/platform.h"
+#include "hal/gpio_fast_api.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** A digital output for bit-banging and chip selects
+ *
+ * Like DigitalOut, but set() and clear() are each a single store to a
+ * register of the target's fast GPIO API, see hal/gpio_fast_api.h. On
+ * targets without one they are gpio_write calls.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * FastDigitalOut cs(D10, 1);
+ *
+ * void transfer(SPI &spi, const char *tx, char *rx, int len) {
+ *     cs.clear();
+ *     spi.write(tx, len, rx, len);
+ *     cs.set();
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class FastDigitalOut {
+
+public:
+    /** Create a FastDigitalOut connected to the specified pin
+     *
+     *  @param pin FastDigitalOut pin to connect to
+     */
+    FastDigitalOut(PinName pin) : gpio()
+    {
+        // No lock needed in the constructor
+        gpio_init_out(&gpio, pin);
+    }
+
+    /** Create a FastDigitalOut connected to the specified pin
+     *
+     *  @param pin FastDigitalOut pin to connect to
+     *  @param value the initial pin value
+     */
+    FastDigitalOut(PinName pin, int value) : gpio()
+    {
+        // No lock needed in the constructor
+        gpio_init_out_ex(&gpio, pin, value);
+    }
+
+    /** Set the output to 1
+     */
+    void set()
+    {
+        // Single register write
+        gpio_fast_set(&gpio);
+    }
+
+    /** Set the output to 0
+     */
+    void clear()
+    {
+        // Single register write
+        gpio_fast_clear(&gpio);
+    }
+
+    /** Set the output, specified as 0 or 1 (int)
+     *
+     *  @param value An integer specifying the pin output value,
+     *      0 for logical 0, 1 (or any other non-zero value) for logical 1
+     */
+    void write(int value)
+    {
+        if (value) {
+            set();
+        } else {
+            clear();
+        }
+    }
+
+    /** Return the state of the pin, represented as 0 or 1 (int)
+     *
+     *  @returns
+     *    an integer representing the state of the pin,
+     *    0 for logical 0, 1 for logical 1
+     */
+    int read()
+    {
+        // Single register read
+        return gpio_fast_read(&gpio);
+    }
+
+    /** A shorthand for write()
+     * \sa FastDigitalOut::write()
+     */
+    FastDigitalOut &operator= (int value)
+    {
+        write(value);
+        return *this;
+    }
+
+    /** Return the output setting, represented as 0 or 1 (int)
+     *
+     *  @returns
+     *    Non zero value if pin is connected to uc GPIO
+     *    0 if gpio object was initialized with NC
+     */
+    int is_connected()
+    {
+        // Thread safe / atomic HAL call
+        return gpio_is_connected(&gpio);
+    }
+
+    /** A shorthand for read()
+     * \sa FastDigitalOut::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+
+protected:
+#if !defined(DOXYGEN_ONLY)
+    gpio_t gpio;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+} // namespace mbed
+
+#endif
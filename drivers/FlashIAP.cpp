@@ -25,6 +25,7 @@
 #include <algorithm>
 #include "FlashIAP.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_mpu_mgmt.h"
 #include "platform/ScopedRamExecutionLock.h"
 #include "platform/ScopedRomWriteLock.h"
 
@@ -36,6 +37,7 @@ namespace mbed {
 const unsigned int num_write_retries = 16;
 
 SingletonPtr<PlatformMutex> FlashIAP::_mutex;
+FlashIAP *FlashIAP::_async_owner = NULL;
 
 static inline bool is_aligned(uint32_t number, uint32_t alignment)
 {
@@ -46,7 +48,7 @@ static inline bool is_aligned(uint32_t number, uint32_t alignment)
     }
 }
 
-FlashIAP::FlashIAP()
+FlashIAP::FlashIAP() : _async_buffer(NULL), _async_addr(0), _async_size(0), _async_step_size(0)
 {
 
 }
@@ -78,6 +80,10 @@ int FlashIAP::deinit()
 {
     int ret = 0;
     _mutex->lock();
+    if (_async_owner == this) {
+        _mutex->unlock();
+        return -1;
+    }
     {
         ScopedRamExecutionLock make_ram_executable;
         ScopedRomWriteLock make_rom_writable;
@@ -121,6 +127,9 @@ int FlashIAP::program(const void *buffer, uint32_t addr, uint32_t size)
 
     int ret = 0;
     _mutex->lock();
+    if (_async_owner) {
+        ret = -1;
+    }
     while (size && !ret) {
         uint32_t current_sector_size = flash_get_sector_size(&_flash, addr);
         bool unaligned_src = (((size_t) buf / sizeof(uint32_t) * sizeof(uint32_t)) != (size_t) buf);
@@ -176,25 +185,37 @@ bool FlashIAP::is_aligned_to_sector(uint32_t addr, uint32_t size)
     }
 }
 
-int FlashIAP::erase(uint32_t addr, uint32_t size)
+bool FlashIAP::is_erase_range_valid(uint32_t addr, uint32_t size)
 {
-    uint32_t current_sector_size;
     uint32_t flash_size = flash_get_size(&_flash);
     uint32_t flash_start_addr = flash_get_start_address(&_flash);
     uint32_t flash_end_addr = flash_start_addr + flash_size;
     uint32_t erase_end_addr = addr + size;
 
     if (erase_end_addr > flash_end_addr) {
-        return -1;
+        return false;
     } else if (erase_end_addr < flash_end_addr) {
         uint32_t following_sector_size = flash_get_sector_size(&_flash, erase_end_addr);
         if (!is_aligned(erase_end_addr, following_sector_size)) {
-            return -1;
+            return false;
         }
     }
+    return true;
+}
+
+int FlashIAP::erase(uint32_t addr, uint32_t size)
+{
+    uint32_t current_sector_size;
+
+    if (!is_erase_range_valid(addr, size)) {
+        return -1;
+    }
 
     int32_t ret = 0;
     _mutex->lock();
+    if (_async_owner) {
+        ret = -1;
+    }
     while (size && !ret) {
         // Few boards may fail the erase actions due to HW limitations (like critical drivers that
         // disable flash operations). Just retry a few times until success.
@@ -216,6 +237,143 @@ int FlashIAP::erase(uint32_t addr, uint32_t size)
     return ret;
 }
 
+int FlashIAP::program_async(const void *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    uint32_t page_size = get_page_size();
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+
+    // The buffer is programmed in place, so it must suit the target as it is
+    if (!buffer || !is_aligned((size_t) buffer, sizeof(uint32_t)) || !size ||
+            !is_aligned(addr, page_size) || !is_aligned(size, page_size) ||
+            (addr < flash_start_addr) || ((addr + size) > (flash_start_addr + flash_size))) {
+        return -1;
+    }
+
+    return start_async((const uint8_t *) buffer, addr, size, callback);
+}
+
+int FlashIAP::erase_async(uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    if (!size || !is_aligned(addr, flash_get_sector_size(&_flash, addr)) || !is_erase_range_valid(addr, size)) {
+        return -1;
+    }
+
+    return start_async(NULL, addr, size, callback);
+}
+
+int FlashIAP::start_async(const uint8_t *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    bool started = false;
+
+    _mutex->lock();
+    if (_async_owner) {
+        _mutex->unlock();
+        return -1;
+    }
+
+    _async_callback = callback;
+    _async_buffer = buffer;
+    _async_addr = addr;
+    _async_size = size;
+
+    // Held until the operation completes, released from the interrupt
+    mbed_mpu_manager_lock_ram_execution();
+    mbed_mpu_manager_lock_rom_write();
+    _async_owner = this;
+    if (async_step() == 0) {
+        started = true;
+    } else {
+        _async_owner = NULL;
+        mbed_mpu_manager_unlock_rom_write();
+        mbed_mpu_manager_unlock_ram_execution();
+    }
+    _mutex->unlock();
+
+    if (started) {
+        return 0;
+    }
+
+    // Asynchronous operation is not supported by the target or failed to
+    // start, do it the blocking way instead
+    int ret = buffer ? program(buffer, addr, size) : erase(addr, size);
+    if (ret == 0 && callback) {
+        callback(0);
+    }
+    return ret;
+}
+
+int32_t FlashIAP::async_step()
+{
+    uint32_t handler = (uint32_t) &FlashIAP::_irq_handler_asynch;
+    uint32_t current_sector_size = flash_get_sector_size(&_flash, _async_addr);
+
+    // The step size is set first, the interrupt may come before the HAL returns
+    if (!_async_buffer) {
+        _async_step_size = current_sector_size;
+        return flash_erase_sector_asynch(&_flash, _async_addr, handler);
+    }
+    _async_step_size = std::min(current_sector_size - (_async_addr % current_sector_size), _async_size);
+    return flash_program_page_asynch(&_flash, _async_addr, _async_buffer, _async_step_size, handler);
+}
+
+void FlashIAP::async_done(int ret)
+{
+    Callback<void(int)> callback = _async_callback;
+
+    mbed_mpu_manager_unlock_rom_write();
+    mbed_mpu_manager_unlock_ram_execution();
+    _async_owner = NULL;
+
+    if (callback) {
+        callback(ret);
+    }
+}
+
+void FlashIAP::_irq_handler_asynch(void)
+{
+    FlashIAP *obj = _async_owner;
+    int32_t event = flash_irq_handler_asynch(&obj->_flash);
+
+    if (event == 0) {
+        return;
+    }
+
+    if (event > 0) {
+        obj->_async_addr += obj->_async_step_size;
+        obj->_async_size -= obj->_async_step_size;
+        if (obj->_async_buffer) {
+            obj->_async_buffer += obj->_async_step_size;
+        }
+        if (obj->_async_size == 0) {
+            obj->async_done(0);
+            return;
+        }
+        if (obj->async_step() == 0) {
+            return;
+        }
+    }
+
+    obj->async_done(-1);
+}
+
+bool FlashIAP::is_background_writable(uint32_t addr) const
+{
+#if defined(FLASHIAP_APP_ROM_END_ADDR)
+#if defined(MBED_APP_START)
+    uint32_t app_start = MBED_APP_START;
+#else
+    uint32_t app_start = flash_get_start_address(&_flash);
+#endif
+    uint32_t app_last = FLASHIAP_APP_ROM_END_ADDR - 1;
+    uint32_t bank = flash_get_bank(&_flash, addr);
+
+    return (bank != flash_get_bank(&_flash, app_start)) && (bank != flash_get_bank(&_flash, app_last));
+#else
+    return false;
+#endif
+}
+
 uint32_t FlashIAP::get_page_size() const
 {
     return flash_get_page_size(&_flash);
@@ -241,6 +399,11 @@ uint8_t FlashIAP::get_erase_value() const
     return flash_get_erase_value(&_flash);
 }
 
+const void *FlashIAP::get_mapped_address(uint32_t addr) const
+{
+    return flash_get_mapped_address(&_flash, addr);
+}
+
 }
 
 #endif
@@ -28,6 +28,7 @@
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
+#include "platform/Callback.h"
 #include <algorithm>
 
 // Export ROM end address
@@ -106,6 +107,51 @@ public:
      */
     int erase(uint32_t addr, uint32_t size);
 
+    /** Start programming data to pages
+     *
+     *  Returns as soon as programming started. Code keeps running while the
+     *  pages are programmed if they are in another flash bank than the
+     *  application, see is_background_writable. Reading flash is allowed
+     *  meanwhile, program and erase fail until the operation completes.
+     *
+     *  Only one asynchronous operation can be in progress at a time. On targets
+     *  without asynchronous flash support the pages are programmed before this
+     *  returns.
+     *
+     *  @param buffer   Buffer of data to be written, must be word aligned and
+     *                  kept unchanged until the callback is called
+     *  @param addr     Address of a page to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of the page size
+     *  @param callback Called with 0 on success or a negative error code once
+     *                  the operation completed, from interrupt context
+     *  @return         0 if programming started, negative error code on failure,
+     *                  in which case the callback is not called
+     */
+    int program_async(const void *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback);
+
+    /** Start erasing sectors
+     *
+     *  Same as program_async, for erasing sectors.
+     *
+     *  @param addr     Address of a sector to begin erasing, must be a multiple of the sector size
+     *  @param size     Size to erase in bytes, must be a multiple of the sector size
+     *  @param callback Called with 0 on success or a negative error code once
+     *                  the operation completed, from interrupt context
+     *  @return         0 if erasing started, negative error code on failure,
+     *                  in which case the callback is not called
+     */
+    int erase_async(uint32_t addr, uint32_t size, Callback<void(int)> callback);
+
+    /** Check if flash can be written without stalling the application
+     *
+     *  On targets with several flash banks, code keeps running from one bank
+     *  while another one is erased or programmed.
+     *
+     *  @param addr Flash address
+     *  @return     true if addr is in another bank than the application code
+     */
+    bool is_background_writable(uint32_t addr) const;
+
     /** Get the sector size at the defined address
      *
      *  Sector size might differ at address ranges.
@@ -142,6 +188,13 @@ public:
      */
     uint8_t get_erase_value() const;
 
+    /** Get a pointer through which flash can be read in place
+     *
+     *  @param addr Flash address
+     *  @return Pointer to the flash contents at addr, or NULL if flash is not memory mapped
+     */
+    const void *get_mapped_address(uint32_t addr) const;
+
 #if !defined(DOXYGEN_ONLY)
 private:
 
@@ -153,9 +206,30 @@ private:
      */
     bool is_aligned_to_sector(uint32_t addr, uint32_t size);
 
+    /* Check the range of an erase
+     *
+     *  @param addr Address of the first sector
+     *  @param size Size to erase in bytes
+     *  @return true if the range ends on a sector boundary within flash
+     */
+    bool is_erase_range_valid(uint32_t addr, uint32_t size);
+
+    int start_async(const uint8_t *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback);
+    int32_t async_step();
+    void async_done(int ret);
+    static void _irq_handler_asynch(void);
+
     flash_t _flash;
     uint8_t *_page_buf;
     static SingletonPtr<PlatformMutex> _mutex;
+
+    /* Only one asynchronous operation at a time, the flash interrupt is shared */
+    static FlashIAP *_async_owner;
+    Callback<void(int)> _async_callback;
+    const uint8_t *_async_buffer;
+    uint32_t _async_addr;
+    uint32_t _async_size;
+    uint32_t _async_step_size;
 #endif
 };
 
@@ -47,6 +47,23 @@ I2C::I2C(PinName sda, PinName scl) :
     unlock();
 }
 
+I2C::I2C(const i2c_pinmap_t &static_pinmap) :
+#if DEVICE_I2C_ASYNCH
+    _irq(this), _usage(DMA_USAGE_NEVER), _deep_sleep_locked(false),
+#endif
+    _i2c(), _hz(100000)
+{
+    lock();
+    // The init function also set the frequency to 100000
+    _sda = static_pinmap.sda_pin;
+    _scl = static_pinmap.scl_pin;
+    recover(_sda, _scl);
+    i2c_init_direct(&_i2c, &static_pinmap);
+    // Used to avoid unnecessary frequency updates
+    _owner = this;
+    unlock();
+}
+
 void I2C::frequency(int hz)
 {
     lock();
@@ -218,13 +235,14 @@ void I2C::abort_transfer(void)
 void I2C::irq_handler_asynch(void)
 {
     int event = i2c_irq_handler_asynch(&_i2c);
-    if (_callback && event) {
-        _callback.call(event);
-    }
-
+    // Unlock first so a transfer started from the callback keeps deep sleep locked
     if (event) {
         unlock_deep_sleep();
     }
+
+    if (_callback && event) {
+        _callback.call(event);
+    }
 }
 
 void I2C::lock_deep_sleep()
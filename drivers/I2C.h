@@ -23,6 +23,7 @@
 #if DEVICE_I2C || defined(DOXYGEN_ONLY)
 
 #include "hal/i2c_api.h"
+#include "hal/static_pinmap.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
@@ -94,6 +95,15 @@ public:
      */
     I2C(PinName sda, PinName scl);
 
+    /** Create an I2C Master interface from a pinmap resolved at compile time
+     *
+     *  The peripheral is initialized with i2c_init_direct, without looking
+     *  up the pins at run time on targets providing static pinmaps.
+     *
+     *  @param static_pinmap Pins of the I2C peripheral, see get_i2c_pinmap
+     */
+    I2C(const i2c_pinmap_t &static_pinmap);
+
     /** Set the frequency of the I2C interface
      *
      *  @param hz The bus frequency in hertz
@@ -0,0 +1,126 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/I2CBus.h"
+#include "platform/mbed_critical.h"
+
+#if DEVICE_I2C && DEVICE_I2C_ASYNCH
+
+namespace mbed {
+
+I2CBus::I2CBus(PinName sda, PinName scl) : I2C(sda, scl), _current(), _busy(false)
+{
+    _callback = event_callback_t(this, &I2CBus::transfer_done);
+    _irq.callback(&I2CBus::irq_handler_asynch);
+}
+
+I2CBus::~I2CBus()
+{
+    abort_all_transfers();
+}
+
+void I2CBus::frequency(int hz)
+{
+    core_util_critical_section_enter();
+    _hz = hz;
+    // Forces start_next() to update the frequency
+    _owner = NULL;
+    core_util_critical_section_exit();
+}
+
+int I2CBus::transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length,
+                     const event_callback_t &callback, int event)
+{
+    transfer_t t;
+    t.tx_buffer = tx_buffer;
+    t.rx_buffer = rx_buffer;
+    t.tx_length = tx_length;
+    t.rx_length = rx_length;
+    t.address = address;
+    t.event = event;
+    t.callback = callback;
+
+    core_util_critical_section_enter();
+    if (_queue.full()) {
+        core_util_critical_section_exit();
+        return -1;
+    }
+    _queue.push(t);
+    if (!_busy) {
+        start_next();
+    }
+    core_util_critical_section_exit();
+    return 0;
+}
+
+int I2CBus::pending()
+{
+    core_util_critical_section_enter();
+    int count = _queue.size() + (_busy ? 1 : 0);
+    core_util_critical_section_exit();
+    return count;
+}
+
+void I2CBus::abort_all_transfers()
+{
+    core_util_critical_section_enter();
+    _queue.reset();
+    if (_busy) {
+        i2c_abort_asynch(&_i2c);
+        unlock_deep_sleep();
+        _busy = false;
+    }
+    core_util_critical_section_exit();
+}
+
+// Called in a critical section or from the transfer interrupt
+void I2CBus::start_next()
+{
+    if (!_queue.pop(_current)) {
+        _busy = false;
+        return;
+    }
+    _busy = true;
+
+    // Same as I2C::aquire() without the mutex, the owner is shared with all I2C objects
+    if (_owner != this) {
+        i2c_frequency(&_i2c, _hz);
+        _owner = this;
+    }
+
+    lock_deep_sleep();
+    // All events are requested so that every transaction ends the same way
+    i2c_transfer_asynch(&_i2c, (void *)_current.tx_buffer, _current.tx_length, _current.rx_buffer, _current.rx_length,
+                        _current.address, 1, _irq.entry(), I2C_EVENT_ALL, _usage);
+}
+
+void I2CBus::transfer_done(int event)
+{
+    transfer_t done = _current;
+
+    // Keep the bus busy while the callback runs
+    start_next();
+
+    event &= done.event;
+    if (done.callback && event) {
+        done.callback.call(event);
+    }
+}
+
+} // namespace mbed
+
+#endif
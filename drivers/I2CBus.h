@@ -0,0 +1,146 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_I2C_BUS_H
+#define MBED_I2C_BUS_H
+
+#include "platform/platform.h"
+
+#if (DEVICE_I2C && DEVICE_I2C_ASYNCH) || defined(DOXYGEN_ONLY)
+
+#include "drivers/I2C.h"
+#include "platform/CircularBuffer.h"
+#include "platform/NonCopyable.h"
+
+#ifndef MBED_CONF_DRIVERS_I2C_BUS_QUEUE_SIZE
+#define MBED_CONF_DRIVERS_I2C_BUS_QUEUE_SIZE 16
+#endif
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** An I2C Master which queues asynchronous transactions
+ *
+ * Transactions from any number of drivers sharing the bus are queued and
+ * executed one after the other from the transfer completion interrupt, so
+ * no thread has to wait for the bus. Each transaction is a write followed
+ * by a read with a repeated start and ends with a stop; either part may be
+ * empty. Its callback is called once, from interrupt context, when it
+ * completes or fails, and a failed transaction does not affect the ones
+ * queued behind it.
+ *
+ * Blocking access to the same bus through an I2C object must not be mixed
+ * with queued transactions.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * I2CBus bus(I2C_SDA, I2C_SCL);
+ * const char reg = 0x00;
+ * char temp[2];
+ *
+ * void temp_done(int event)
+ * {
+ *     if (event & I2C_EVENT_TRANSFER_COMPLETE) {
+ *         // temp holds the LM75 temperature register
+ *     }
+ * }
+ *
+ * int main() {
+ *     bus.transfer(0x90, &reg, 1, temp, 2, temp_done);
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class I2CBus : private I2C, private NonCopyable<I2CBus> {
+
+public:
+    /** Create an I2C bus master, connected to the specified pins
+     *
+     *  @param sda I2C data line pin
+     *  @param scl I2C clock line pin
+     */
+    I2CBus(PinName sda, PinName scl);
+
+    virtual ~I2CBus();
+
+    /** Set the frequency of the I2C interface
+     *
+     *  Takes effect from the next transaction started.
+     *
+     *  @param hz The bus frequency in hertz
+     */
+    void frequency(int hz);
+
+    /** Queue a write-then-read transaction
+     *
+     * The transaction starts at once if the bus is idle. The buffers must stay
+     * valid until the callback has been called.
+     *
+     * @param address   8/10 bit I2C slave address
+     * @param tx_buffer The TX buffer with data to be transferred
+     * @param tx_length The length of TX buffer in bytes
+     * @param rx_buffer The RX buffer, which is used for received data
+     * @param rx_length The length of RX buffer in bytes
+     * @param callback  The event callback function, called from interrupt context
+     * @param event     The logical OR of events the callback is called for
+     *
+     * @returns Zero if the transaction was queued, or -1 if the queue is full
+     */
+    int transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length,
+                 const event_callback_t &callback, int event = I2C_EVENT_ALL);
+
+    /** Get the number of transactions queued or in progress
+     *
+     * @returns Number of transactions not completed yet
+     */
+    int pending();
+
+    /** Abort the transaction in progress and drop the queued ones
+     *
+     * No callbacks are called for the aborted transactions.
+     */
+    void abort_all_transfers();
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    struct transfer_t {
+        const char *tx_buffer;
+        char *rx_buffer;
+        int tx_length;
+        int rx_length;
+        int address;
+        int event;
+        event_callback_t callback;
+    };
+
+    void start_next();
+    void transfer_done(int event);
+
+    CircularBuffer<transfer_t, MBED_CONF_DRIVERS_I2C_BUS_QUEUE_SIZE> _queue;
+    transfer_t _current;
+    bool _busy;
+#endif
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -15,12 +15,14 @@
  * limitations under the License.
  */
 #include "drivers/I2CSlave.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
 
 #if DEVICE_I2CSLAVE
 
 namespace mbed {
 
-I2CSlave::I2CSlave(PinName sda, PinName scl) : _i2c()
+I2CSlave::I2CSlave(PinName sda, PinName scl) : _i2c(), _async_active(false)
 {
     i2c_init(&_i2c, sda, scl);
     i2c_frequency(&_i2c, 100000);
@@ -68,6 +70,53 @@ void I2CSlave::stop(void)
     i2c_stop(&_i2c);
 }
 
+int I2CSlave::transfer_async(const char *tx_buffer, size_t tx_length, char *rx_buffer, size_t rx_length, const Callback<void(int, size_t)> &callback)
+{
+    if (!callback || (tx_buffer == NULL && tx_length) || (rx_buffer == NULL && rx_length)) {
+        return -1;
+    }
+
+    core_util_critical_section_enter();
+    bool busy = _async_active;
+    _async_active = true;
+    core_util_critical_section_exit();
+    if (busy) {
+        return -1;
+    }
+
+    _async_callback = callback;
+    sleep_manager_lock_deep_sleep();
+    int ret = i2c_slave_transfer_async(&_i2c, tx_buffer, tx_length, rx_buffer, rx_length, &I2CSlave::_async_handler, (uint32_t)this);
+    if (ret != 0) {
+        _async_active = false;
+        sleep_manager_unlock_deep_sleep();
+    }
+
+    return ret;
+}
+
+void I2CSlave::abort_async()
+{
+    core_util_critical_section_enter();
+    bool active = _async_active;
+    if (active) {
+        i2c_slave_abort_async(&_i2c);
+        _async_active = false;
+    }
+    core_util_critical_section_exit();
+    if (active) {
+        sleep_manager_unlock_deep_sleep();
+    }
+}
+
+void I2CSlave::_async_handler(uint32_t id, int event, size_t count)
+{
+    I2CSlave *handler = (I2CSlave *)id;
+    handler->_async_active = false;
+    sleep_manager_unlock_deep_sleep();
+    handler->_async_callback.call(event, count);
+}
+
 }
 
 #endif
@@ -18,6 +18,7 @@
 #define MBED_I2C_SLAVE_H
 
 #include "platform/platform.h"
+#include "platform/Callback.h"
 
 #if DEVICE_I2CSLAVE || defined(DOXYGEN_ONLY)
 
@@ -151,11 +152,41 @@ public:
      */
     void stop(void);
 
+    /** Serve the next transaction from the master in the background
+     *
+     *  A read by the master is answered from the TX buffer and a write by the master is
+     *  stored in the RX buffer by the interrupt handler, without polling receive. Only one
+     *  transaction is served per call. This function locks the deep sleep until the
+     *  transaction has finished.
+     *
+     *  @param tx_buffer Data to answer a read with, may be NULL, must stay valid until the callback is called
+     *  @param tx_length Number of bytes in the TX buffer
+     *  @param rx_buffer Buffer for the data written by the master, may be NULL, must stay valid until the callback is called
+     *  @param rx_length Size of the RX buffer in bytes
+     *  @param callback Function called from interrupt context when the transaction has finished, with
+     *                  I2C_SLAVE_EVENT_READ_DONE, I2C_SLAVE_EVENT_WRITE_DONE or I2C_SLAVE_EVENT_ERROR
+     *                  and the number of bytes transferred. The next transaction may be started from it.
+     *
+     *  @returns
+     *    0 if the transfer has started, -1 if a transfer is in progress, the target does not
+     *    support asynchronous slave transfers or on failure.
+     */
+    int transfer_async(const char *tx_buffer, size_t tx_length, char *rx_buffer, size_t rx_length, const Callback<void(int, size_t)> &callback);
+
+    /** Abort the transfer started by transfer_async, the callback is not called
+     */
+    void abort_async();
+
 #if !defined(DOXYGEN_ONLY)
 
 protected:
+    static void _async_handler(uint32_t id, int event, size_t count);
+
     /* Internal i2c object identifying the resources */
     i2c_t _i2c;
+    /* Asynchronous transfer in progress */
+    volatile bool _async_active;
+    Callback<void(int, size_t)> _async_callback;
 
 #endif //!defined(DOXYGEN_ONLY)
 };
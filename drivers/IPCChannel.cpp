@@ -0,0 +1,422 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/IPCChannel.h"
+
+#if DEVICE_IPC
+
+#include <string.h>
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_poll.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Kernel.h"
+#else
+#include "platform/mbed_wait_api.h"
+#endif
+
+// Set once the sending core has initialized the ring
+#define IPC_RING_MAGIC  0x49504352
+
+// Header of a message that does not fit before the end of the ring, which continues at the start
+#define IPC_RECORD_WRAP 0xFFFFFFFF
+
+#define IPC_RECORD_SIZE(length) (sizeof(uint32_t) + (((length) + 3) & ~3))
+
+namespace mbed {
+
+static IPCChannel *ipc_channels[MBED_CONF_DRIVERS_IPC_CHANNELS];
+static bool ipc_initialized;
+
+IPCChannel::IPCChannel(uint32_t channel, void *tx_buffer, size_t tx_size, void *rx_buffer)
+    : _channel(channel), _tx(static_cast<Ring *>(tx_buffer)), _tx_skip(0), _rx(static_cast<Ring *>(rx_buffer)),
+      _rx_msg(NULL), _rx_len(0), _rx_pos(0), _rx_record(0), _blocking(true)
+#if MBED_CONF_RTOS_PRESENT
+    , _tx_event(0, 1), _rx_event(0, 1)
+#endif
+{
+    MBED_ASSERT(channel < MBED_CONF_DRIVERS_IPC_CHANNELS && tx_size >= sizeof(Ring) + 2 * sizeof(uint32_t));
+
+    // Largest power of two after the indexes, so the free running indexes wrap with the ring
+    _tx_size = 1;
+    while (_tx_size * 2 <= tx_size - sizeof(Ring)) {
+        _tx_size *= 2;
+    }
+    _tx_data = reinterpret_cast<uint8_t *>(_tx + 1);
+
+    // The other core ignores the ring until the magic is written back
+    core_util_atomic_store_u32(&_tx->magic, 0);
+    _tx->size = _tx_size;
+    _tx->head = 0;
+    _tx->tail = 0;
+    _tx->waiting = 0;
+    core_util_atomic_store_u32(&_tx->magic, IPC_RING_MAGIC);
+
+    MBED_ASSERT(channel < ipc_get_channel_count());
+
+    core_util_critical_section_enter();
+    MBED_ASSERT(!ipc_channels[channel]);
+    ipc_channels[channel] = this;
+    if (!ipc_initialized) {
+        ipc_init(&IPCChannel::irq);
+        ipc_initialized = true;
+    }
+    core_util_critical_section_exit();
+}
+
+IPCChannel::~IPCChannel()
+{
+    core_util_critical_section_enter();
+    ipc_channels[_channel] = NULL;
+    core_util_critical_section_exit();
+
+    core_util_atomic_store_u32(&_tx->magic, 0);
+}
+
+size_t IPCChannel::max_message_size() const
+{
+    // A message up to half the ring always fits once the ring is empty, wherever it starts
+    return _tx_size / 2 - sizeof(uint32_t);
+}
+
+uint32_t IPCChannel::tx_skip(uint32_t head, uint32_t record) const
+{
+    uint32_t offset = head & (_tx_size - 1);
+    return (_tx_size - offset < record) ? _tx_size - offset : 0;
+}
+
+bool IPCChannel::tx_space(uint32_t record) const
+{
+    uint32_t head = _tx->head;
+    uint32_t tail = core_util_atomic_load_u32(&_tx->tail);
+    return _tx_size - (head - tail) >= tx_skip(head, record) + record;
+}
+
+void *IPCChannel::reserve(size_t size)
+{
+    if (!size || size > max_message_size()) {
+        return NULL;
+    }
+
+    _tx_mutex.lock();
+
+    uint32_t record = IPC_RECORD_SIZE(size);
+    if (!tx_space(record)) {
+        _tx_mutex.unlock();
+        return NULL;
+    }
+
+    uint32_t head = _tx->head;
+    _tx_skip = tx_skip(head, record);
+    if (_tx_skip) {
+        *reinterpret_cast<uint32_t *>(_tx_data + (head & (_tx_size - 1))) = IPC_RECORD_WRAP;
+    }
+    return _tx_data + ((head + _tx_skip) & (_tx_size - 1)) + sizeof(uint32_t);
+}
+
+void IPCChannel::commit(size_t size)
+{
+    uint32_t head = _tx->head + _tx_skip;
+    *reinterpret_cast<uint32_t *>(_tx_data + (head & (_tx_size - 1))) = size;
+
+    // The store barrier publishes the message before the index
+    core_util_atomic_store_u32(&_tx->head, head + IPC_RECORD_SIZE(size));
+
+    _tx_mutex.unlock();
+
+    ipc_notify(_channel);
+}
+
+bool IPCChannel::rx_fetch()
+{
+    if (_rx_msg && _rx_pos == _rx_len) {
+        rx_release();
+    }
+    if (_rx_msg) {
+        return true;
+    }
+
+    if (core_util_atomic_load_u32(&_rx->magic) != IPC_RING_MAGIC) {
+        return false;
+    }
+    uint32_t tail = _rx->tail;
+    if (core_util_atomic_load_u32(&_rx->head) == tail) {
+        return false;
+    }
+
+    uint32_t mask = _rx->size - 1;
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(_rx + 1);
+    uint32_t offset = tail & mask;
+    uint32_t skip = 0;
+    uint32_t length = *reinterpret_cast<const uint32_t *>(data + offset);
+    if (length == IPC_RECORD_WRAP) {
+        skip = _rx->size - offset;
+        offset = 0;
+        length = *reinterpret_cast<const uint32_t *>(data);
+    }
+
+    _rx_msg = data + offset + sizeof(uint32_t);
+    _rx_len = length;
+    _rx_pos = 0;
+    _rx_record = skip + IPC_RECORD_SIZE(length);
+    return true;
+}
+
+void IPCChannel::rx_release()
+{
+    _rx_msg = NULL;
+
+    // The store barrier completes the reads of the message before the space is given back
+    core_util_atomic_store_u32(&_rx->tail, _rx->tail + _rx_record);
+
+    // Read after the index is stored, so a sender starting to wait is either seen or sees the space
+    if (core_util_atomic_load_u32(&_rx->waiting)) {
+        core_util_atomic_store_u32(&_rx->waiting, 0);
+        ipc_notify(_channel);
+    }
+}
+
+const void *IPCChannel::peek(size_t *size)
+{
+    _rx_mutex.lock();
+
+    if (!rx_fetch()) {
+        _rx_mutex.unlock();
+        return NULL;
+    }
+
+    *size = _rx_len - _rx_pos;
+    return _rx_msg + _rx_pos;
+}
+
+void IPCChannel::consume()
+{
+    rx_release();
+
+    _rx_mutex.unlock();
+}
+
+bool IPCChannel::wait_event(bool rx, uint32_t &millisec)
+{
+    if (!millisec) {
+        return false;
+    }
+
+#if MBED_CONF_RTOS_PRESENT
+    rtos::Semaphore &event = rx ? _rx_event : _tx_event;
+    if (millisec == wait_forever) {
+        event.acquire();
+        return true;
+    }
+
+    uint64_t start = rtos::Kernel::get_ms_count();
+    bool notified = event.try_acquire_for(millisec);
+    uint64_t elapsed = rtos::Kernel::get_ms_count() - start;
+    millisec = elapsed < millisec ? millisec - elapsed : 0;
+    return notified;
+#else
+    // Without an RTOS, poll like UARTSerial
+    wait_ms(1);
+    if (millisec != wait_forever) {
+        millisec--;
+    }
+    return true;
+#endif
+}
+
+ssize_t IPCChannel::send(const void *data, size_t size, uint32_t millisec)
+{
+    if (!size) {
+        return 0;
+    }
+    if (size > max_message_size()) {
+        return -EMSGSIZE;
+    }
+
+    _tx_mutex.lock();
+
+    void *buffer;
+    while (!(buffer = reserve(size))) {
+        // Ask for a notification, then check again in case the space was freed meanwhile
+        core_util_atomic_store_u32(&_tx->waiting, 1);
+        if ((buffer = reserve(size))) {
+            break;
+        }
+        if (!wait_event(false, millisec)) {
+            _tx_mutex.unlock();
+            return -EAGAIN;
+        }
+    }
+
+    memcpy(buffer, data, size);
+    commit(size);
+
+    _tx_mutex.unlock();
+
+    return size;
+}
+
+ssize_t IPCChannel::receive(void *data, size_t size, uint32_t millisec)
+{
+    _rx_mutex.lock();
+
+    while (!rx_fetch()) {
+        if (!wait_event(true, millisec)) {
+            _rx_mutex.unlock();
+            return -EAGAIN;
+        }
+    }
+
+    size_t length = _rx_len - _rx_pos;
+    if (length > size) {
+        length = size;
+    }
+    memcpy(data, _rx_msg + _rx_pos, length);
+    rx_release();
+
+    _rx_mutex.unlock();
+
+    return length;
+}
+
+ssize_t IPCChannel::write(const void *buffer, size_t length)
+{
+    const uint8_t *ptr = static_cast<const uint8_t *>(buffer);
+    size_t written = 0;
+
+    while (written < length) {
+        size_t chunk = length - written;
+        if (chunk > max_message_size()) {
+            chunk = max_message_size();
+        }
+        ssize_t sent = send(ptr + written, chunk, _blocking ? wait_forever : 0);
+        if (sent < 0) {
+            break;
+        }
+        written += sent;
+    }
+
+    return (written || !length) ? (ssize_t)written : -EAGAIN;
+}
+
+ssize_t IPCChannel::read(void *buffer, size_t length)
+{
+    const void *data;
+    ssize_t got = read_in_place(&data, length);
+    if (got > 0) {
+        memcpy(buffer, data, got);
+
+        // Copied, so the space can be given back now rather than on the next read
+        _rx_mutex.lock();
+        if (_rx_msg && _rx_pos == _rx_len) {
+            rx_release();
+        }
+        _rx_mutex.unlock();
+    }
+    return got;
+}
+
+ssize_t IPCChannel::read_in_place(const void **data, size_t length)
+{
+    if (!length) {
+        return 0;
+    }
+
+    _rx_mutex.lock();
+
+    uint32_t millisec = _blocking ? wait_forever : 0;
+    while (!rx_fetch()) {
+        if (!wait_event(true, millisec)) {
+            _rx_mutex.unlock();
+            return -EAGAIN;
+        }
+    }
+
+    // The message is released by the next read, once the caller is done with it
+    size_t got = _rx_len - _rx_pos;
+    if (got > length) {
+        got = length;
+    }
+    *data = _rx_msg + _rx_pos;
+    _rx_pos += got;
+
+    _rx_mutex.unlock();
+
+    return got;
+}
+
+off_t IPCChannel::seek(off_t offset, int whence)
+{
+    return -ESPIPE;
+}
+
+int IPCChannel::close()
+{
+    return 0;
+}
+
+short IPCChannel::poll(short events) const
+{
+    short revents = 0;
+
+    if ((_rx_msg && _rx_pos < _rx_len) ||
+            (core_util_atomic_load_u32(&_rx->magic) == IPC_RING_MAGIC &&
+             core_util_atomic_load_u32(&_rx->head) != _rx->tail)) {
+        revents |= POLLIN;
+    }
+    if (tx_space(IPC_RECORD_SIZE(1))) {
+        revents |= POLLOUT;
+    }
+
+    return revents & events;
+}
+
+void IPCChannel::sigio(Callback<void()> func)
+{
+    core_util_critical_section_enter();
+    _sigio_cb = func;
+    if (_sigio_cb) {
+        short current_events = poll(0x7FFF);
+        if (current_events) {
+            _sigio_cb();
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+void IPCChannel::wake()
+{
+#if MBED_CONF_RTOS_PRESENT
+    _tx_event.release();
+    _rx_event.release();
+#endif
+    poll_wake(this);
+    if (_sigio_cb) {
+        _sigio_cb();
+    }
+}
+
+void IPCChannel::irq(uint32_t channel)
+{
+    if (channel < MBED_CONF_DRIVERS_IPC_CHANNELS && ipc_channels[channel]) {
+        ipc_channels[channel]->wake();
+    }
+}
+
+} // namespace mbed
+
+#endif
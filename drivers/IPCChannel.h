@@ -0,0 +1,283 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_IPC_CHANNEL_H
+#define MBED_IPC_CHANNEL_H
+
+#include "platform/platform.h"
+
+#if DEVICE_IPC || defined(DOXYGEN_ONLY)
+
+#include "hal/ipc_api.h"
+#include "platform/FileHandle.h"
+#include "platform/PlatformMutex.h"
+#include "platform/NonCopyable.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Semaphore.h"
+#endif
+
+#ifndef MBED_CONF_DRIVERS_IPC_CHANNELS
+#define MBED_CONF_DRIVERS_IPC_CHANNELS 4
+#endif
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Message channel between the cores of a multi-core device
+ *
+ * Each direction is a ring of variable length messages in memory shared by
+ * the cores: the sending core owns the ring it writes, the receiving core
+ * only moves its read index. A core notifies the other through the IPC
+ * interrupt when it adds a message, and when it frees space the other core
+ * is waiting for. Each ring has a single writer and a single reader, so no
+ * lock is shared between the cores.
+ *
+ * Messages can be written and read in place in the shared memory, with
+ * reserve()/commit() and peek()/consume(), or copied with send() and
+ * receive(). As a FileHandle the channel is a byte stream: writes are cut
+ * into messages and reads return the bytes of consecutive messages.
+ *
+ * Both cores create the channel with the same number and with the two
+ * buffers swapped. The buffers must be in the memory returned by
+ * ipc_get_shared_memory.
+ *
+ * @note Synchronization level: Thread safe, not for use from interrupts
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * // Same code on both cores, CORE_ID is 0 on one and 1 on the other
+ * size_t shared_size;
+ * uint8_t *shared = (uint8_t *)ipc_get_shared_memory(&shared_size);
+ * uint8_t *rings[2] = { shared, shared + shared_size / 2 };
+ *
+ * IPCChannel channel(0, rings[CORE_ID], shared_size / 2, rings[!CORE_ID]);
+ *
+ * int main() {
+ *     packet_t *packet = (packet_t *)channel.reserve(sizeof(packet_t));
+ *     if (packet) {
+ *         fill_packet(packet);
+ *         channel.commit(sizeof(packet_t));
+ *     }
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class IPCChannel : public FileHandle, private NonCopyable<IPCChannel> {
+
+public:
+    /** Timeout waiting until the operation can complete */
+    static const uint32_t wait_forever = 0xFFFFFFFF;
+
+    /** Create an IPCChannel
+     *
+     * @param channel   IPC channel notified, below ipc_get_channel_count and
+     *                  drivers.ipc-channels
+     * @param tx_buffer Shared memory of the ring this core sends through,
+     *                  aligned to 32 bytes
+     * @param tx_size   Size of tx_buffer, 64 bytes of which hold the indexes
+     * @param rx_buffer Shared memory of the ring the other core sends through
+     */
+    IPCChannel(uint32_t channel, void *tx_buffer, size_t tx_size, void *rx_buffer);
+
+    virtual ~IPCChannel();
+
+    /** Get the size of the largest message, half of the ring less its header
+     *
+     * @return The largest message size in bytes
+     */
+    size_t max_message_size() const;
+
+    /** Reserve space for a message in the shared memory
+     *
+     * The sending side is locked until commit() is called.
+     *
+     * @param size Size of the message
+     * @return     Where to write the message, NULL if the ring is full or
+     *             size is 0 or above max_message_size
+     */
+    void *reserve(size_t size);
+
+    /** Send the message written in the space returned by reserve()
+     *
+     * @param size Size of the message, at most the size reserved
+     */
+    void commit(size_t size);
+
+    /** Get the next message in the shared memory
+     *
+     * The receiving side is locked until consume() is called.
+     *
+     * @param size Returned size of the message
+     * @return     Start of the message, NULL if there is none
+     */
+    const void *peek(size_t *size);
+
+    /** Free the message returned by peek() for the other core to reuse
+     */
+    void consume();
+
+    /** Send a copy of a message
+     *
+     * @param data     Message to send
+     * @param size     Size of the message
+     * @param millisec Time to wait for space in the ring
+     * @return         size on success, -EMSGSIZE if size is above
+     *                 max_message_size, -EAGAIN on timeout
+     */
+    ssize_t send(const void *data, size_t size, uint32_t millisec = 0);
+
+    /** Receive a copy of the next message
+     *
+     * The part of the message that does not fit in the buffer is dropped.
+     *
+     * @param data     Buffer to copy the message to
+     * @param size     Size of the buffer
+     * @param millisec Time to wait for a message
+     * @return         Number of bytes copied, -EAGAIN on timeout
+     */
+    ssize_t receive(void *data, size_t size, uint32_t millisec = wait_forever);
+
+    /** Write bytes, as messages of at most max_message_size
+     *
+     *  @param buffer   The buffer to write from
+     *  @param length   The number of bytes to write
+     *  @return         The number of bytes written, -EAGAIN if non-blocking and the ring is full
+     */
+    virtual ssize_t write(const void *buffer, size_t length);
+
+    /** Read bytes of the received messages
+     *
+     *  @param buffer   The buffer to read in to
+     *  @param length   The number of bytes to read
+     *  @return         The number of bytes read, -EAGAIN if non-blocking and there is no message
+     */
+    virtual ssize_t read(void *buffer, size_t length);
+
+    /** Read bytes of the received messages in place in the shared memory
+     *
+     *  The bytes stay valid until the next read from the channel, and at most
+     *  the rest of the current message is returned.
+     *
+     *  @param data     Set to the start of the bytes read
+     *  @param length   The maximum number of bytes to read
+     *  @return         The number of bytes at data, -EAGAIN if non-blocking and there is no message
+     */
+    virtual ssize_t read_in_place(const void **data, size_t length);
+
+    /** Not seekable
+     *
+     *  @return -ESPIPE
+     */
+    virtual off_t seek(off_t offset, int whence = SEEK_SET);
+
+    /** Close the channel, it stays usable
+     *
+     *  @return 0
+     */
+    virtual int close();
+
+    /** Set blocking or non-blocking mode, blocking by default
+     *
+     *  @param blocking true for blocking mode, false for non-blocking mode.
+     *  @return 0
+     */
+    virtual int set_blocking(bool blocking)
+    {
+        _blocking = blocking;
+        return 0;
+    }
+
+    /** Check current blocking or non-blocking mode
+     *
+     *  @return true for blocking mode, false for non-blocking mode.
+     */
+    virtual bool is_blocking() const
+    {
+        return _blocking;
+    }
+
+    /** Check for POLLIN and POLLOUT
+     *
+     *  @param events bitmask of poll events we're interested in
+     *  @return bitmask of poll events that have occurred
+     */
+    virtual short poll(short events) const;
+
+    /** Check whether the file handle wakes up poll()
+     *
+     *  @return true, the IPC interrupt wakes mbed::poll()
+     */
+    virtual bool wakes_poll() const
+    {
+        return true;
+    }
+
+    /** Register a callback on state change of the channel
+     *
+     *  The callback is called from interrupt context when the other core
+     *  adds or frees messages.
+     *
+     *  @param func Function to call on state change
+     */
+    virtual void sigio(Callback<void()> func);
+
+private:
+    // Indexes and data of one direction, the indexes on separate cache lines
+    struct Ring {
+        uint32_t magic;
+        uint32_t size;
+        uint32_t head;
+        uint32_t reserved0[5];
+        uint32_t tail;
+        uint32_t waiting;
+        uint32_t reserved1[6];
+    };
+
+    static void irq(uint32_t channel);
+    void wake();
+    bool wait_event(bool rx, uint32_t &millisec);
+    uint32_t tx_skip(uint32_t head, uint32_t record) const;
+    bool tx_space(uint32_t record) const;
+    bool rx_fetch();
+    void rx_release();
+
+    uint32_t _channel;
+    Ring *_tx;
+    uint8_t *_tx_data;
+    uint32_t _tx_size;
+    uint32_t _tx_skip;
+    Ring *_rx;
+    const uint8_t *_rx_msg;
+    uint32_t _rx_len;
+    uint32_t _rx_pos;
+    uint32_t _rx_record;
+    bool _blocking;
+    Callback<void()> _sigio_cb;
+    PlatformMutex _tx_mutex;
+    PlatformMutex _rx_mutex;
+#if MBED_CONF_RTOS_PRESENT
+    rtos::Semaphore _tx_event;
+    rtos::Semaphore _rx_event;
+#endif
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_IPC_QUEUE_H
+#define MBED_IPC_QUEUE_H
+
+#include "platform/platform.h"
+
+#if DEVICE_IPC || defined(DOXYGEN_ONLY)
+
+#include "drivers/IPCChannel.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Queue of fixed size items between the cores of a multi-core device
+ *
+ * Like rtos::Queue, but items are copied through an IPCChannel to the other
+ * core. Items are copied byte for byte, so they must not point to memory
+ * the other core can't see. One core puts and the other gets.
+ *
+ * @note Synchronization level: Thread safe, not for use from interrupts
+ *
+ * Example:
+ * @code
+ * IPCChannel channel(1, rings[CORE_ID], RING_SIZE, rings[!CORE_ID]);
+ * IPCQueue<sensor_sample_t> samples(channel);
+ *
+ * void network_core()
+ * {
+ *     sensor_sample_t sample;
+ *     while (samples.get(&sample)) {
+ *         publish(sample);
+ *     }
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+template<typename T>
+class IPCQueue : private NonCopyable<IPCQueue<T> > {
+public:
+    /** Create a queue over a channel
+     *
+     * @param channel Channel the items are sent through, used for nothing else
+     */
+    IPCQueue(IPCChannel &channel) : _channel(channel)
+    {
+        MBED_STATIC_ASSERT(sizeof(T) > 0, "Items must not be empty");
+    }
+
+    /** Check if the queue is empty
+     *
+     * @return True if there is no item to get
+     */
+    bool empty() const
+    {
+        return !(_channel.poll(POLLIN) & POLLIN);
+    }
+
+    /** Put an item into the queue
+     *
+     * @param data     Item to copy into the queue
+     * @param millisec Time to wait for space in the queue (default: 0)
+     * @return         True if the item was queued
+     */
+    bool put(const T &data, uint32_t millisec = 0)
+    {
+        return _channel.send(&data, sizeof(T), millisec) == (ssize_t)sizeof(T);
+    }
+
+    /** Get an item from the queue
+     *
+     * @param data     Returned item
+     * @param millisec Time to wait for an item (default: IPCChannel::wait_forever)
+     * @return         True if an item was returned
+     */
+    bool get(T *data, uint32_t millisec = IPCChannel::wait_forever)
+    {
+        return _channel.receive(data, sizeof(T), millisec) == (ssize_t)sizeof(T);
+    }
+
+private:
+    IPCChannel &_channel;
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
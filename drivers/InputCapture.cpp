@@ -0,0 +1,125 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/InputCapture.h"
+#include "platform/mbed_power_mgmt.h"
+
+#if DEVICE_CAPTURE
+
+namespace mbed {
+
+InputCapture::InputCapture(PinName pin) : _frequency(0), _buffer(NULL), _length(0), _running(false)
+{
+    lock();
+    capture_init(&_capture, pin);
+    unlock();
+}
+
+InputCapture::~InputCapture()
+{
+    stop();
+    lock();
+    capture_free(&_capture);
+    unlock();
+}
+
+uint32_t InputCapture::set_frequency(uint32_t hz)
+{
+    lock();
+    _frequency = capture_set_frequency(&_capture, hz);
+    uint32_t frequency = _frequency;
+    unlock();
+    return frequency;
+}
+
+uint32_t InputCapture::set_debounce(uint32_t ns)
+{
+    lock();
+    uint32_t length = capture_set_filter(&_capture, ns);
+    unlock();
+    return length;
+}
+
+int InputCapture::start(uint32_t *buffer, size_t length, capture_edge_t edge, Callback<void(const uint32_t *, size_t, int)> func)
+{
+    if (!buffer || !length || length % 2 != 0) {
+        return -1;
+    }
+
+    lock();
+    if (_running || !_frequency) {
+        unlock();
+        return -1;
+    }
+
+    _buffer = buffer;
+    _length = length;
+    _callback = func;
+    _running = true;
+    // The capture timer and DMA need their clocks while running
+    sleep_manager_lock_deep_sleep();
+    if (capture_start(&_capture, edge, buffer, length, &InputCapture::_irq_handler, (uint32_t)this) != 0) {
+        _running = false;
+        sleep_manager_unlock_deep_sleep();
+        unlock();
+        return -1;
+    }
+    unlock();
+    return 0;
+}
+
+size_t InputCapture::position()
+{
+    lock();
+    size_t index = _running ? capture_get_position(&_capture) : 0;
+    unlock();
+    return index;
+}
+
+void InputCapture::stop()
+{
+    lock();
+    if (_running) {
+        capture_stop(&_capture);
+        _running = false;
+        sleep_manager_unlock_deep_sleep();
+    }
+    unlock();
+}
+
+void InputCapture::_irq_handler(uint32_t id, uint32_t event)
+{
+    InputCapture *handler = (InputCapture *)id;
+    if (!handler->_callback) {
+        return;
+    }
+
+    size_t half = handler->_length / 2;
+    if (event & CAPTURE_EVENT_HALF) {
+        handler->_callback(handler->_buffer, half, CAPTURE_EVENT_HALF);
+    }
+    if (event & CAPTURE_EVENT_FULL) {
+        handler->_callback(handler->_buffer + half, half, CAPTURE_EVENT_FULL);
+    }
+    if (event & CAPTURE_EVENT_ERROR) {
+        handler->_callback(NULL, 0, CAPTURE_EVENT_ERROR);
+    }
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,154 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INPUT_CAPTURE_H
+#define MBED_INPUT_CAPTURE_H
+
+#include "platform/platform.h"
+
+#if DEVICE_CAPTURE || defined(DOXYGEN_ONLY)
+
+#include "hal/capture_api.h"
+#include "platform/Callback.h"
+#include "platform/PlatformMutex.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Hardware timestamping of the edges of a digital input
+ *
+ * Unlike InterruptIn, each edge is timestamped by a timer capture channel
+ * and the timestamp is stored by DMA into a circular buffer, so timestamps
+ * do not jitter with interrupt latency and high edge rates cost no CPU time
+ * per edge. The buffer is used as a double buffer: the callback is called from
+ * interrupt context each time one half is filled, while the other half is being
+ * written. Timestamps are raw counts of a free running timer that wraps at 2^32,
+ * so intervals are obtained by unsigned subtraction.
+ *
+ * An input filter can be set to debounce the input in hardware.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * static uint32_t edges[64];
+ * static volatile uint32_t period;
+ *
+ * void on_edges(const uint32_t *data, size_t count, int event)
+ * {
+ *     // Average period over the last half buffer, in timer ticks
+ *     period = (data[count - 1] - data[0]) / (count - 1);
+ * }
+ *
+ * int main() {
+ *     InputCapture flow(D3);
+ *     flow.set_frequency(1000000);
+ *     flow.set_debounce(10000);
+ *     flow.start(edges, 64, CAPTURE_EDGE_RISING, on_edges);
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class InputCapture : private NonCopyable<InputCapture> {
+
+public:
+
+    /** Create an InputCapture connected to the specified pin
+     *
+     * @param pin Timer capture input pin
+     */
+    InputCapture(PinName pin);
+
+    ~InputCapture();
+
+    /** Set the rate the timestamps count at, applied from the next call to start
+     *
+     * @param hz    Requested timer frequency
+     * @return      The frequency actually used, 0 if it cannot be achieved
+     */
+    uint32_t set_frequency(uint32_t hz);
+
+    /** Set the hardware debounce filter, applied from the next call to start
+     *
+     * The input must be stable for the filter length before an edge is
+     * captured, timestamps are delayed by that length.
+     *
+     * @param ns    Minimum length in nanoseconds of the pulses to capture, 0 to disable
+     * @return      The filter length actually used in nanoseconds
+     */
+    uint32_t set_debounce(uint32_t ns);
+
+    /** Start timestamping edges
+     *
+     * The callback receives the half of the buffer that was just filled, the number
+     * of timestamps in it and the event (CAPTURE_EVENT_HALF or CAPTURE_EVENT_FULL).
+     * On CAPTURE_EVENT_ERROR capture has stopped and no timestamps are passed,
+     * call stop before starting again.
+     * The timestamps must be consumed before the same half is written again.
+     *
+     * @param buffer    Buffer the timestamps are stored in, must stay valid until stop
+     * @param length    Number of timestamps the buffer holds, a multiple of two
+     * @param edge      The edges to timestamp
+     * @param func      Function called from interrupt context when a half is filled
+     * @return          0 on success, -1 on failure
+     */
+    int start(uint32_t *buffer, size_t length, capture_edge_t edge, Callback<void(const uint32_t *, size_t, int)> func);
+
+    /** Get the index in the buffer the next timestamp will be stored at
+     *
+     * Allows reading timestamps before a half of the buffer is filled, for
+     * inputs with a low edge rate.
+     *
+     * @return      The index in the buffer of the next timestamp
+     */
+    size_t position();
+
+    /** Stop timestamping edges
+     */
+    void stop();
+
+protected:
+#if !defined(DOXYGEN_ONLY)
+    static void _irq_handler(uint32_t id, uint32_t event);
+
+    virtual void lock()
+    {
+        _mutex.lock();
+    }
+
+    virtual void unlock()
+    {
+        _mutex.unlock();
+    }
+
+    capture_t _capture;
+    uint32_t _frequency;
+    uint32_t *_buffer;
+    size_t _length;
+    bool _running;
+    Callback<void(const uint32_t *, size_t, int)> _callback;
+    PlatformMutex _mutex;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
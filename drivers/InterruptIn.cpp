@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "drivers/InterruptIn.h"
+#include "platform/mbed_sched_trace.h"
 
 #if DEVICE_INTERRUPTIN
 
@@ -98,6 +99,7 @@ void InterruptIn::fall(Callback<void()> func)
 void InterruptIn::_irq_handler(uint32_t id, gpio_irq_event event)
 {
     InterruptIn *handler = (InterruptIn *)id;
+    MBED_SCHED_TRACE_ISR_ENTER();
     switch (event) {
         case IRQ_RISE:
             if (handler->_rise) {
@@ -112,6 +114,7 @@ void InterruptIn::_irq_handler(uint32_t id, gpio_irq_event event)
         case IRQ_NONE:
             break;
     }
+    MBED_SCHED_TRACE_ISR_EXIT();
 }
 
 void InterruptIn::enable_irq()
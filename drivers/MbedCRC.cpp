@@ -75,6 +75,40 @@ MbedCRC<POLY_8BIT_CCITT, 8>::MbedCRC():
     mbed_crc_ctor();
 }
 
+/* Slicing tables for the reflected 32-bit polynomials
+*/
+template<>
+MbedCRC<POLY_32BIT_ANSI, 32, 4>::MbedCRC():
+    _initial_value(~(0x0)), _final_xor(~(0x0)), _reflect_data(true), _reflect_remainder(true),
+    _crc_table((uint32_t *)Table_CRC_32bit_Rev_ANSI_Slice4)
+{
+    mbed_crc_ctor();
+}
+
+template<>
+MbedCRC<POLY_32BIT_ANSI, 32, 8>::MbedCRC():
+    _initial_value(~(0x0)), _final_xor(~(0x0)), _reflect_data(true), _reflect_remainder(true),
+    _crc_table((uint32_t *)Table_CRC_32bit_Rev_ANSI_Slice4)
+{
+    mbed_crc_ctor();
+}
+
+template<>
+MbedCRC<POLY_32BIT_REV_ANSI, 32, 4>::MbedCRC():
+    _initial_value(~(0x0)), _final_xor(~(0x0)), _reflect_data(false), _reflect_remainder(false),
+    _crc_table((uint32_t *)Table_CRC_32bit_Rev_ANSI_Slice4)
+{
+    mbed_crc_ctor();
+}
+
+template<>
+MbedCRC<POLY_32BIT_REV_ANSI, 32, 8>::MbedCRC():
+    _initial_value(~(0x0)), _final_xor(~(0x0)), _reflect_data(false), _reflect_remainder(false),
+    _crc_table((uint32_t *)Table_CRC_32bit_Rev_ANSI_Slice4)
+{
+    mbed_crc_ctor();
+}
+
 /** @}*/
 } // namespace mbed
 
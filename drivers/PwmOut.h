@@ -21,8 +21,10 @@
 
 #if DEVICE_PWMOUT || defined(DOXYGEN_ONLY)
 #include "hal/pwmout_api.h"
+#include "hal/static_pinmap.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_power_mgmt.h"
+#include "platform/Callback.h"
 
 namespace mbed {
 /** \addtogroup drivers */
@@ -65,9 +67,24 @@ public:
         core_util_critical_section_exit();
     }
 
+    /** Create a PwmOut from a pinmap entry resolved at compile time
+     *
+     *  The peripheral is initialized with pwmout_init_direct, without looking
+     *  up the pin at run time on targets providing static pinmaps.
+     *
+     *  @param pinmap Pin of the PwmOut, see get_pwm_pinmap
+     */
+    PwmOut(const PinMap &pinmap) : _deep_sleep_locked(false)
+    {
+        core_util_critical_section_enter();
+        pwmout_init_direct(&_pwm, &pinmap);
+        core_util_critical_section_exit();
+    }
+
     ~PwmOut()
     {
         core_util_critical_section_enter();
+        pwmout_sequence_stop(&_pwm);
         pwmout_free(&_pwm);
         unlock_deep_sleep();
         core_util_critical_section_exit();
@@ -199,6 +216,55 @@ public:
         return read();
     }
 
+    /** Get the sequence value for a 100% duty cycle at the current period
+     *
+     *  @returns
+     *    The largest value accepted by play(), 0 if the target cannot play sequences
+     */
+    uint32_t sequence_max()
+    {
+        core_util_critical_section_enter();
+        uint32_t max = pwmout_sequence_max(&_pwm);
+        core_util_critical_section_exit();
+        return max;
+    }
+
+    /** Play a sequence of duty cycles, one per period
+     *
+     *  The values are loaded by DMA at the start of each period, so the CPU is
+     *  free during playback. They range from 0 to sequence_max() at the current
+     *  period. Once a sequence that does not loop has been played, or when
+     *  playback is stopped, the output keeps the duty cycle of the last value.
+     *  Calling write() or changing the period or pulsewidth ends playback.
+     *
+     *  @param values Duty cycles, may be converted in place to the peripheral's format,
+     *                must stay valid until playback ends
+     *  @param count  Number of values
+     *  @param loop   Play the sequence again each time it ends, until stop() is called
+     *  @param func   Function called from interrupt context each time the sequence has
+     *                been played, with PWMOUT_SEQUENCE_EVENT_COMPLETE or PWMOUT_SEQUENCE_EVENT_ERROR
+     *  @returns
+     *    0 if playback has started, -1 if the target cannot play this sequence
+     */
+    int play(uint16_t *values, size_t count, bool loop = false, const Callback<void(int)> &func = NULL)
+    {
+        core_util_critical_section_enter();
+        lock_deep_sleep();
+        _sequence_callback = func;
+        int ret = pwmout_sequence_start(&_pwm, values, count, loop, &PwmOut::_sequence_handler, (uint32_t)this);
+        core_util_critical_section_exit();
+        return ret;
+    }
+
+    /** Stop playing a sequence, the output keeps the duty cycle of its last value
+     */
+    void stop()
+    {
+        core_util_critical_section_enter();
+        pwmout_sequence_stop(&_pwm);
+        core_util_critical_section_exit();
+    }
+
 #if !(DOXYGEN_ONLY)
 protected:
     /** Lock deep sleep only if it is not yet locked */
@@ -219,8 +285,17 @@ protected:
         }
     }
 
+    static void _sequence_handler(uint32_t id, uint32_t event)
+    {
+        PwmOut *handler = (PwmOut *)id;
+        if (handler->_sequence_callback) {
+            handler->_sequence_callback(event);
+        }
+    }
+
     pwmout_t _pwm;
     bool _deep_sleep_locked;
+    Callback<void(int)> _sequence_callback;
 #endif
 };
 
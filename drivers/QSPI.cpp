@@ -17,6 +17,7 @@
 
 #include "drivers/QSPI.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
 #include <string.h>
 
 #if DEVICE_QSPI
@@ -25,6 +26,7 @@ namespace mbed {
 
 QSPI *QSPI::_owner = NULL;
 SingletonPtr<PlatformMutex> QSPI::_mutex;
+QSPI *volatile QSPI::_async_owner = NULL;
 
 QSPI::QSPI(PinName io0, PinName io1, PinName io2, PinName io3, PinName sclk, PinName ssel, int mode) : _qspi()
 {
@@ -206,6 +208,106 @@ qspi_status_t QSPI::command_transfer(int instruction, int address, const char *t
     return ret_status;
 }
 
+qspi_status_t QSPI::memory_map(int instruction, int alt, const void **address)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        if (address != NULL) {
+            lock();
+            if (true == _acquire()) {
+                _build_qspi_command(instruction, 0, alt);
+                ret_status = qspi_memory_map(&_qspi, &_qspi_command, address);
+            }
+            unlock();
+        } else {
+            ret_status = QSPI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return ret_status;
+}
+
+qspi_status_t QSPI::memory_unmap()
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        lock();
+        if (true == _acquire()) {
+            ret_status = qspi_memory_unmap(&_qspi);
+        }
+        unlock();
+    }
+
+    return ret_status;
+}
+
+qspi_status_t QSPI::read_async(int instruction, int alt, int address, char *rx_buffer, size_t rx_length, const Callback<void(qspi_status_t)> &callback)
+{
+    return _start_async(instruction, alt, address, rx_buffer, rx_length, false, callback);
+}
+
+qspi_status_t QSPI::write_async(int instruction, int alt, int address, const char *tx_buffer, size_t tx_length, const Callback<void(qspi_status_t)> &callback)
+{
+    return _start_async(instruction, alt, address, const_cast<char *>(tx_buffer), tx_length, true, callback);
+}
+
+void QSPI::abort_async()
+{
+    lock();
+    core_util_critical_section_enter();
+    bool active = (_async_owner == this);
+    if (active) {
+        qspi_abort_async(&_qspi);
+        _async_owner = NULL;
+    }
+    core_util_critical_section_exit();
+    if (active) {
+        sleep_manager_unlock_deep_sleep();
+    }
+    unlock();
+}
+
+qspi_status_t QSPI::_start_async(int instruction, int alt, int address, void *buffer, size_t length, bool write, const Callback<void(qspi_status_t)> &callback)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        if ((buffer != NULL) && (length != 0) && callback) {
+            lock();
+            if (true == _acquire()) {
+                _build_qspi_command(instruction, address, alt);
+                _async_callback = callback;
+                _async_owner = this;
+                sleep_manager_lock_deep_sleep();
+                if (write) {
+                    ret_status = qspi_write_async(&_qspi, &_qspi_command, buffer, length, &QSPI::_async_handler, (uint32_t)this);
+                } else {
+                    ret_status = qspi_read_async(&_qspi, &_qspi_command, buffer, length, &QSPI::_async_handler, (uint32_t)this);
+                }
+                if (ret_status != QSPI_STATUS_OK) {
+                    _async_owner = NULL;
+                    sleep_manager_unlock_deep_sleep();
+                }
+            }
+            unlock();
+        } else {
+            ret_status = QSPI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return ret_status;
+}
+
+void QSPI::_async_handler(uint32_t id, qspi_status_t status)
+{
+    QSPI *handler = (QSPI *)id;
+    _async_owner = NULL;
+    sleep_manager_unlock_deep_sleep();
+    handler->_async_callback.call(status);
+}
+
 void QSPI::lock()
 {
     _mutex->lock();
@@ -237,6 +339,11 @@ bool QSPI::_initialize()
 // Note: Private function with no locking
 bool QSPI::_acquire()
 {
+    // The peripheral is shared, nothing else can run during an asynchronous transfer
+    if (_async_owner != NULL) {
+        return false;
+    }
+
     if (_owner != this) {
         //This will set freq as well
         _initialize();
@@ -24,6 +24,7 @@
 #include "hal/qspi_api.h"
 #include "platform/PlatformMutex.h"
 #include "platform/SingletonPtr.h"
+#include "platform/Callback.h"
 #include "platform/NonCopyable.h"
 
 #define ONE_MHZ     1000000
@@ -183,6 +184,68 @@ public:
      */
     qspi_status_t command_transfer(int instruction, int address, const char *tx_buffer, size_t tx_length, const char *rx_buffer, size_t rx_length);
 
+    /** Map the QSPI peripheral into the address space for reads
+     *
+     *  The read instruction, alt value and current format are issued on every access to the
+     *  returned region, where the offset into the region is the address in the peripheral.
+     *  Not all targets support this, and no other transfers may be issued until memory_unmap is called.
+     *
+     *  @param instruction Instruction value to be used in instruction phase
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param address Pointer to a variable which is set to the base address of the mapped region
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS if the peripheral has been mapped and QSPI_STATUS_ERROR otherwise.
+     */
+    qspi_status_t memory_map(int instruction, int alt, const void **address);
+
+    /** Return the QSPI peripheral from memory-mapped mode to normal transfers
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS on success and QSPI_STATUS_ERROR on failure.
+     */
+    qspi_status_t memory_unmap();
+
+    /** Start reading from QSPI peripheral in the background using custom read instruction, alt values
+     *
+     *  The data phase uses DMA on targets which support it. No other QSPI operation can be
+     *  issued until the callback has been called or abort_async has returned. This function
+     *  locks the deep sleep until the transfer has finished.
+     *
+     *  @param instruction Instruction value to be used in instruction phase
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param address Address to be accessed in QSPI peripheral
+     *  @param rx_buffer Buffer for data to be read from the peripheral, must stay valid until the callback is called
+     *  @param rx_length Number of bytes to read
+     *  @param callback Function called from interrupt context with the transfer status when the transfer has finished
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_OK if the transfer has started and QSPI_STATUS_ERROR if the target does not support
+     *    asynchronous transfers or on failure.
+     */
+    qspi_status_t read_async(int instruction, int alt, int address, char *rx_buffer, size_t rx_length, const Callback<void(qspi_status_t)> &callback);
+
+    /** Start writing to QSPI peripheral in the background using custom write instruction, alt values
+     *
+     *  Same as read_async for the transmit direction.
+     *
+     *  @param instruction Instruction value to be used in instruction phase
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param address Address to be accessed in QSPI peripheral
+     *  @param tx_buffer Buffer containing data to be sent to peripheral, must stay valid until the callback is called
+     *  @param tx_length Number of bytes to write
+     *  @param callback Function called from interrupt context with the transfer status when the transfer has finished
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_OK if the transfer has started and QSPI_STATUS_ERROR if the target does not support
+     *    asynchronous transfers or on failure.
+     */
+    qspi_status_t write_async(int instruction, int alt, int address, const char *tx_buffer, size_t tx_length, const Callback<void(qspi_status_t)> &callback);
+
+    /** Abort the transfer started by read_async or write_async, the callback is not called
+     */
+    void abort_async();
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     /** Acquire exclusive access to this SPI bus
@@ -198,6 +261,8 @@ protected:
     bool acquire(void);
     static QSPI *_owner;
     static SingletonPtr<PlatformMutex> _mutex;
+    static QSPI *volatile _async_owner; //Object with an asynchronous transfer in progress
+    Callback<void(qspi_status_t)> _async_callback;
     qspi_bus_width_t _inst_width; //Bus width for Instruction phase
     qspi_bus_width_t _address_width; //Bus width for Address phase
     qspi_address_size_t _address_size;
@@ -218,6 +283,9 @@ private:
     bool _acquire(void);
     bool _initialize();
 
+    qspi_status_t _start_async(int instruction, int alt, int address, void *buffer, size_t length, bool write, const Callback<void(qspi_status_t)> &callback);
+    static void _async_handler(uint32_t id, qspi_status_t status);
+
     /*
      * This function builds the qspi command struct to be send to Hal
      */
@@ -31,6 +31,11 @@ RawSerial::RawSerial(PinName tx, PinName rx, int baud) : SerialBase(tx, rx, baud
     // No lock needed in the constructor
 }
 
+RawSerial::RawSerial(const serial_pinmap_t &static_pinmap, int baud) : SerialBase(static_pinmap, baud)
+{
+    // No lock needed in the constructor
+}
+
 int RawSerial::getc()
 {
     lock();
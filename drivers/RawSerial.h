@@ -67,6 +67,16 @@ public:
      */
     RawSerial(PinName tx, PinName rx, int baud = MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE);
 
+    /** Create a RawSerial port from a pinmap resolved at compile time, with the specified baud.
+     *
+     *  The peripheral is initialized with serial_init_direct, without looking
+     *  up the pins at run time on targets providing static pinmaps.
+     *
+     *  @param static_pinmap Pins of the serial peripheral, see get_uart_pinmap
+     *  @param baud The baud rate of the serial port (optional, defaults to MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE)
+     */
+    RawSerial(const serial_pinmap_t &static_pinmap, int baud = MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE);
+
     /** Write a char to the serial port
      *
      * @param c The char to write
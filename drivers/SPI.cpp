@@ -19,6 +19,7 @@
 
 #if DEVICE_SPI_ASYNCH
 #include "platform/mbed_power_mgmt.h"
+#include "platform/mbed_wait_api.h"
 #endif
 
 #if DEVICE_SPI
@@ -36,7 +37,9 @@ SPI::SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel) :
     _miso(miso),
     _sclk(sclk),
     _hw_ssel(ssel),
-    _sw_ssel(NC)
+    _sw_ssel(NC),
+    _static_pinmap(NULL),
+    _init_func(_do_init)
 {
     _do_construct();
 }
@@ -49,7 +52,39 @@ SPI::SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel, use_gpio_ssel_t
     _miso(miso),
     _sclk(sclk),
     _hw_ssel(NC),
-    _sw_ssel(ssel, 1)
+    _sw_ssel(ssel, 1),
+    _static_pinmap(NULL),
+    _init_func(_do_init)
+{
+    _do_construct();
+}
+
+SPI::SPI(const spi_pinmap_t &static_pinmap) :
+#if DEVICE_SPI_ASYNCH
+    _irq(this),
+#endif
+    _mosi(static_pinmap.mosi_pin),
+    _miso(static_pinmap.miso_pin),
+    _sclk(static_pinmap.sclk_pin),
+    _hw_ssel(static_pinmap.ssel_pin),
+    _sw_ssel(NC),
+    _static_pinmap(&static_pinmap),
+    _init_func(_do_init_direct)
+{
+    _do_construct();
+}
+
+SPI::SPI(const spi_pinmap_t &static_pinmap, PinName ssel) :
+#if DEVICE_SPI_ASYNCH
+    _irq(this),
+#endif
+    _mosi(static_pinmap.mosi_pin),
+    _miso(static_pinmap.miso_pin),
+    _sclk(static_pinmap.sclk_pin),
+    _hw_ssel(NC),
+    _sw_ssel(ssel, 1),
+    _static_pinmap(&static_pinmap),
+    _init_func(_do_init_direct)
 {
     _do_construct();
 }
@@ -60,6 +95,9 @@ void SPI::_do_construct()
 #if DEVICE_SPI_ASYNCH
     _usage = DMA_USAGE_NEVER;
     _deep_sleep_locked = false;
+    _steps = NULL;
+    _steps_left = 0;
+    _list_event = 0;
 #endif
     _select_count = 0;
     _bits = 8;
@@ -69,7 +107,13 @@ void SPI::_do_construct()
 
     // Need backwards compatibility with HALs not providing API
 #ifdef DEVICE_SPI_COUNT
-    SPIName name = spi_get_peripheral_name(_mosi, _miso, _sclk);
+    SPIName name;
+    if (_static_pinmap && _static_pinmap->peripheral != (int)NC) {
+        // Static pinmaps carry the SPIName the pins resolve to
+        name = (SPIName)_static_pinmap->peripheral;
+    } else {
+        name = spi_get_peripheral_name(_mosi, _miso, _sclk);
+    }
 #else
     SPIName name = GlobalSPI;
 #endif
@@ -158,13 +202,31 @@ void SPI::frequency(int hz)
 void SPI::_acquire()
 {
     if (_peripheral->owner != this) {
-        spi_init(&_peripheral->spi, _mosi, _miso, _sclk, _hw_ssel);
+        _init_func(this);
         spi_format(&_peripheral->spi, _bits, _mode, 0);
         spi_frequency(&_peripheral->spi, _hz);
         _peripheral->owner = this;
     }
 }
 
+void SPI::_do_init(SPI *obj)
+{
+    spi_init(&obj->_peripheral->spi, obj->_mosi, obj->_miso, obj->_sclk, obj->_hw_ssel);
+}
+
+void SPI::_do_init_direct(SPI *obj)
+{
+    if (obj->_hw_ssel == NC && obj->_static_pinmap->ssel_pin != NC) {
+        // SSEL is driven as GPIO, leave it out of the peripheral
+        spi_pinmap_t pinmap = *obj->_static_pinmap;
+        pinmap.ssel_pin = NC;
+        pinmap.ssel_function = (int)NC;
+        spi_init_direct(&obj->_peripheral->spi, &pinmap);
+    } else {
+        spi_init_direct(&obj->_peripheral->spi, obj->_static_pinmap);
+    }
+}
+
 int SPI::write(int value)
 {
     select();
@@ -234,9 +296,45 @@ int SPI::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_
     return 0;
 }
 
+int SPI::transfer_list(const spi_step_t *steps, int count, const event_callback_t &callback, int event)
+{
+    if (count <= 0) {
+        return -1;
+    }
+
+    core_util_critical_section_enter();
+    if (spi_active(&_peripheral->spi) || _steps_left) {
+        core_util_critical_section_exit();
+        return -1;
+    }
+    lock_deep_sleep();
+    _acquire();
+    _steps = steps;
+    _steps_left = count;
+    _list_event = event;
+    _callback = callback;
+    _irq.callback(&SPI::irq_handler_asynch);
+    bool started = start_step();
+    core_util_critical_section_exit();
+
+    if (!started) {
+        // Only steps without data, nothing will interrupt
+        unlock_deep_sleep();
+        if (_callback && (event & SPI_EVENT_COMPLETE)) {
+            _callback.call(SPI_EVENT_COMPLETE);
+        }
+    }
+    return 0;
+}
+
 void SPI::abort_transfer()
 {
     spi_abort_asynch(&_peripheral->spi);
+    if (_steps_left) {
+        // Leave no slave selected
+        _set_step_ssel(_steps, 1);
+        _steps_left = 0;
+    }
     unlock_deep_sleep();
 #if TRANSACTION_QUEUE_SIZE_SPI
     dequeue_transaction();
@@ -321,6 +419,47 @@ void SPI::unlock_deep_sleep()
     }
 }
 
+void SPI::_set_step_ssel(const spi_step_t *step, int val)
+{
+    if (step->ssel) {
+        *step->ssel = val;
+    } else {
+        _set_ssel(val);
+    }
+}
+
+bool SPI::start_step()
+{
+    while (_steps_left) {
+        const spi_step_t *step = _steps;
+        if (step->flags & SPI_STEP_SELECT) {
+            _set_step_ssel(step, 0);
+        }
+        if (step->tx_length || step->rx_length) {
+            unsigned char width = _bits <= 8 ? 8 : (_bits <= 16 ? 16 : 32);
+            // Errors always end the list, even when not reported to the callback
+            spi_master_transfer(&_peripheral->spi, step->tx_buffer, step->tx_length, step->rx_buffer, step->rx_length,
+                                width, _irq.entry(), _list_event | SPI_EVENT_COMPLETE | SPI_EVENT_ERROR, _usage);
+            return true;
+        }
+        end_step();
+    }
+    return false;
+}
+
+void SPI::end_step()
+{
+    const spi_step_t *step = _steps;
+    if (step->delay_us) {
+        wait_us(step->delay_us);
+    }
+    if (step->flags & SPI_STEP_DESELECT) {
+        _set_step_ssel(step, 1);
+    }
+    _steps++;
+    _steps_left--;
+}
+
 #if TRANSACTION_QUEUE_SIZE_SPI
 
 void SPI::start_transaction(transaction_t *data)
@@ -343,6 +482,27 @@ void SPI::dequeue_transaction()
 void SPI::irq_handler_asynch(void)
 {
     int event = spi_irq_handler_asynch(&_peripheral->spi);
+    if (_steps_left && (event & (SPI_EVENT_ALL | SPI_EVENT_INTERNAL_TRANSFER_COMPLETE))) {
+        if (!(event & SPI_EVENT_ERROR)) {
+            end_step();
+            if (start_step()) {
+                return;
+            }
+        } else {
+            // Leave no slave selected
+            _set_step_ssel(_steps, 1);
+        }
+        _steps_left = 0;
+        unlock_deep_sleep();
+        event &= _list_event;
+        if (_callback && (event & SPI_EVENT_ALL)) {
+            _callback.call(event & SPI_EVENT_ALL);
+        }
+#if TRANSACTION_QUEUE_SIZE_SPI
+        dequeue_transaction();
+#endif
+        return;
+    }
     if (_callback && (event & SPI_EVENT_ALL)) {
         _set_ssel(1);
         unlock_deep_sleep();
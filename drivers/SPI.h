@@ -23,6 +23,7 @@
 
 #include "platform/PlatformMutex.h"
 #include "hal/spi_api.h"
+#include "hal/static_pinmap.h"
 #include "drivers/DigitalOut.h"
 #include "platform/SingletonPtr.h"
 #include "platform/NonCopyable.h"
@@ -50,6 +51,34 @@ namespace mbed {
 struct use_gpio_ssel_t { };
 const use_gpio_ssel_t use_gpio_ssel;
 
+#if DEVICE_SPI_ASYNCH
+/** Step flag: assert the slave select before the step's data */
+#define SPI_STEP_SELECT     (1 << 0)
+/** Step flag: deassert the slave select after the step's data and delay */
+#define SPI_STEP_DESELECT   (1 << 1)
+
+/** One step of a descriptor list transfer, see SPI::transfer_list
+ *
+ * A step without data only applies its slave select flags and delay.
+ */
+struct spi_step_t {
+    /** Data to send, NULL to send the default write value */
+    const void *tx_buffer;
+    /** Length of the data to send in bytes */
+    int tx_length;
+    /** Buffer for received data, NULL to ignore it */
+    void *rx_buffer;
+    /** Length of the receive buffer in bytes */
+    int rx_length;
+    /** Slave select to drive, NULL for the SPI's own GPIO slave select */
+    DigitalOut *ssel;
+    /** Combination of SPI_STEP_SELECT and SPI_STEP_DESELECT */
+    uint8_t flags;
+    /** Delay in microseconds after the step, busy-waited in interrupt context */
+    uint16_t delay_us;
+};
+#endif
+
 /** A SPI Master, used for communicating with SPI slave devices.
  *
  * The default format is set to 8-bits, mode 0, and a clock frequency of 1MHz.
@@ -128,6 +157,33 @@ public:
      */
     SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel, use_gpio_ssel_t);
 
+    /** Create a SPI master from a pinmap resolved at compile time.
+     *
+     *  The peripheral is initialized with spi_init_direct, so on targets
+     *  providing static pinmaps neither the pins are looked up at run time
+     *  nor the PinMap tables are linked in for this SPI.
+     *
+     *  @code
+     *  constexpr spi_pinmap_t spi_pinmap = get_spi_pinmap(SPI_MOSI, SPI_MISO, SPI_SCLK, SPI_CS);
+     *  SPI device(spi_pinmap);
+     *  @endcode
+     *
+     *  @param static_pinmap Pins of the SPI peripheral, see get_spi_pinmap.
+     *      It is used until the SPI is destroyed, so it must not be a temporary.
+     */
+    SPI(const spi_pinmap_t &static_pinmap);
+    SPI(const spi_pinmap_t &&) = delete;
+
+    /** Create a SPI master from a pinmap resolved at compile time,
+     *  using GPIO for SSEL.
+     *
+     *  @param static_pinmap Pins of the SPI peripheral, see get_spi_pinmap.
+     *      It is used until the SPI is destroyed, so it must not be a temporary.
+     *  @param ssel SPI Chip Select pin.
+     */
+    SPI(const spi_pinmap_t &static_pinmap, PinName ssel);
+    SPI(const spi_pinmap_t &&, PinName) = delete;
+
     virtual ~SPI();
 
     /** Configure the data transmission format.
@@ -233,6 +289,28 @@ public:
         return 0;
     }
 
+    /** Start a non-blocking descriptor list transfer.
+     *
+     * The steps are executed back-to-back from the transfer completion interrupt,
+     * each one optionally asserting a slave select, transferring data, waiting and
+     * deasserting the slave select, so several transactions with one or more
+     * devices on the bus run without returning to thread context. The callback is
+     * called once, when the last step completes or a step fails.
+     *
+     * Buffers hold words of the size set with format(). This function locks the deep
+     * sleep until the list completes.
+     *
+     * @param steps     Array of steps, must stay valid until the callback is called
+     * @param count     Number of steps
+     * @param callback  The event callback function.
+     * @param event     The event mask of events to modify. @see spi_api.h for SPI events.
+     *
+     * @return Operation result.
+     * @retval 0 If the transfer has started.
+     * @retval -1 If SPI peripheral is busy or the list is empty.
+     */
+    int transfer_list(const spi_step_t *steps, int count, const event_callback_t &callback, int event = SPI_EVENT_COMPLETE);
+
     /** Abort the on-going SPI transfer, and continue with transfers in the queue, if any.
      */
     void abort_transfer();
@@ -313,6 +391,18 @@ protected:
     void start_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length, unsigned char bit_width, const event_callback_t &callback, int event);
 
 private:
+    /** Run the current step of a descriptor list, skipping steps without data.
+     *
+     * @return true if a step's data transfer was started, false if the list is done
+     */
+    bool start_step();
+
+    /** Finish the current step of a descriptor list */
+    void end_step();
+
+    /** Drive the slave select used by a descriptor list step */
+    void _set_step_ssel(const spi_step_t *step, int val);
+
     /** Lock deep sleep only if it is not yet locked */
     void lock_deep_sleep();
 
@@ -378,6 +468,12 @@ protected:
     DMAUsage _usage;
     /* Current sate of the sleep manager */
     bool _deep_sleep_locked;
+    /* Descriptor list being run by the interrupt handler */
+    const spi_step_t *_steps;
+    /* Number of steps left in the list, including the current one */
+    int _steps_left;
+    /* Event mask of the descriptor list */
+    int _list_event;
 #endif // DEVICE_SPI_ASYNCH
 
     // Configuration.
@@ -389,6 +485,11 @@ protected:
     // The Slave Select GPIO if we're doing it ourselves.
     DigitalOut _sw_ssel;
 
+    /* Pinmap passed to the constructor, NULL if constructed from pins */
+    const spi_pinmap_t *_static_pinmap;
+    /* Initializes the peripheral, keeps spi_init out of images using only pinmaps */
+    void (*_init_func)(SPI *);
+
     /* Size of the SPI frame */
     int _bits;
     /* Clock polairy and phase */
@@ -403,6 +504,9 @@ protected:
 private:
     void _do_construct();
 
+    static void _do_init(SPI *obj);
+    static void _do_init_direct(SPI *obj);
+
     /** Private acquire function without locking/unlocking.
      *  Implemented in order to avoid duplicate locking and boost performance.
      */
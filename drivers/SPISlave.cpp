@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 #include "drivers/SPISlave.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
 
 #if DEVICE_SPISLAVE
 
@@ -24,7 +26,8 @@ SPISlave::SPISlave(PinName mosi, PinName miso, PinName sclk, PinName ssel) :
     _spi(),
     _bits(8),
     _mode(0),
-    _hz(1000000)
+    _hz(1000000),
+    _async_active(false)
 {
     spi_init(&_spi, mosi, miso, sclk, ssel);
     spi_format(&_spi, _bits, _mode, 1);
@@ -59,6 +62,53 @@ void SPISlave::reply(int value)
     spi_slave_write(&_spi, value);
 }
 
+int SPISlave::transfer_async(const void *tx_buffer, size_t tx_length, void *rx_buffer, size_t rx_length, const Callback<void(int, size_t)> &callback)
+{
+    if (!callback || (tx_buffer == NULL && tx_length) || (rx_buffer == NULL && rx_length)) {
+        return -1;
+    }
+
+    core_util_critical_section_enter();
+    bool busy = _async_active;
+    _async_active = true;
+    core_util_critical_section_exit();
+    if (busy) {
+        return -1;
+    }
+
+    _async_callback = callback;
+    sleep_manager_lock_deep_sleep();
+    int ret = spi_slave_transfer_async(&_spi, tx_buffer, tx_length, rx_buffer, rx_length, &SPISlave::_async_handler, (uint32_t)this);
+    if (ret != 0) {
+        _async_active = false;
+        sleep_manager_unlock_deep_sleep();
+    }
+
+    return ret;
+}
+
+void SPISlave::abort_async()
+{
+    core_util_critical_section_enter();
+    bool active = _async_active;
+    if (active) {
+        spi_slave_abort_async(&_spi);
+        _async_active = false;
+    }
+    core_util_critical_section_exit();
+    if (active) {
+        sleep_manager_unlock_deep_sleep();
+    }
+}
+
+void SPISlave::_async_handler(uint32_t id, int event, size_t rx_count)
+{
+    SPISlave *handler = (SPISlave *)id;
+    handler->_async_active = false;
+    sleep_manager_unlock_deep_sleep();
+    handler->_async_callback.call(event, rx_count);
+}
+
 } // namespace mbed
 
 #endif
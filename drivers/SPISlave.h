@@ -19,6 +19,7 @@
 
 #include "platform/platform.h"
 #include "platform/NonCopyable.h"
+#include "platform/Callback.h"
 
 #if DEVICE_SPISLAVE || defined(DOXYGEN_ONLY)
 
@@ -111,9 +112,37 @@ public:
      */
     void reply(int value);
 
+    /** Exchange buffers with the master in the background
+     *
+     *  The TX buffer is loaded before the master starts clocking and the received data is
+     *  written to the RX buffer, using DMA on targets which support it, so the slave does not
+     *  have to keep up with the master byte by byte. The transfer ends when both buffers have
+     *  been used up or when the master deasserts chip select. This function locks the deep
+     *  sleep until the transfer has finished.
+     *
+     *  @param tx_buffer Data to send, may be NULL, must stay valid until the callback is called
+     *  @param tx_length Number of bytes to send
+     *  @param rx_buffer Buffer for the received data, may be NULL, must stay valid until the callback is called
+     *  @param rx_length Size of the receive buffer in bytes
+     *  @param callback Function called from interrupt context when the transfer has finished, with
+     *                  SPI_SLAVE_EVENT_COMPLETE, SPI_SLAVE_EVENT_DESELECT or SPI_SLAVE_EVENT_ERROR
+     *                  and the number of bytes received. A new transfer may be started from it.
+     *
+     *  @returns
+     *    0 if the transfer has started, -1 if a transfer is in progress, the target does not
+     *    support asynchronous slave transfers or on failure.
+     */
+    int transfer_async(const void *tx_buffer, size_t tx_length, void *rx_buffer, size_t rx_length, const Callback<void(int, size_t)> &callback);
+
+    /** Abort the transfer started by transfer_async, the callback is not called
+     */
+    void abort_async();
+
 #if !defined(DOXYGEN_ONLY)
 
 protected:
+    static void _async_handler(uint32_t id, int event, size_t rx_count);
+
     /* Internal SPI object identifying the resources */
     spi_t _spi;
 
@@ -123,6 +152,9 @@ protected:
     int _mode;
     /* Clock frequency */
     int _hz;
+    /* Asynchronous transfer in progress */
+    volatile bool _async_active;
+    Callback<void(int, size_t)> _async_callback;
 
 #endif //!defined(DOXYGEN_ONLY)
 };
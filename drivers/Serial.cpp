@@ -29,6 +29,14 @@ Serial::Serial(PinName tx, PinName rx, int baud): SerialBase(tx, rx, baud), Stre
 {
 }
 
+Serial::Serial(const serial_pinmap_t &static_pinmap, const char *name, int baud) : SerialBase(static_pinmap, baud), Stream(name)
+{
+}
+
+Serial::Serial(const serial_pinmap_t &static_pinmap, int baud): SerialBase(static_pinmap, baud), Stream(NULL)
+{
+}
+
 int Serial::_getc()
 {
     // Mutex is already held
@@ -83,6 +83,24 @@ public:
      */
     Serial(PinName tx, PinName rx, int baud);
 
+    /** Create a Serial port from a pinmap resolved at compile time
+     *
+     *  The peripheral is initialized with serial_init_direct, without looking
+     *  up the pins at run time on targets providing static pinmaps.
+     *
+     *  @param static_pinmap Pins of the serial peripheral, see get_uart_pinmap
+     *  @param name The name of the stream associated with this serial port (optional)
+     *  @param baud The baud rate of the serial port (optional, defaults to MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE or 9600)
+     */
+    Serial(const serial_pinmap_t &static_pinmap, const char *name = NULL, int baud = MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE);
+
+    /** Create a Serial port from a pinmap resolved at compile time, with the specified baud
+     *
+     *  @param static_pinmap Pins of the serial peripheral, see get_uart_pinmap
+     *  @param baud The baud rate of the serial port
+     */
+    Serial(const serial_pinmap_t &static_pinmap, int baud);
+
     /* Stream gives us a FileHandle with non-functional poll()/readable()/writable. Pass through
      * the calls from the SerialBase instead for backwards compatibility. This problem is
      * part of why Stream and Serial should be deprecated.
@@ -18,6 +18,7 @@
 #include "platform/mbed_wait_api.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_power_mgmt.h"
+#include "platform/mbed_sched_trace.h"
 
 #if DEVICE_SERIAL
 
@@ -43,6 +44,26 @@ SerialBase::SerialBase(PinName tx, PinName rx, int baud) :
     serial_irq_handler(&_serial, SerialBase::_irq_handler, (uint32_t)this);
 }
 
+SerialBase::SerialBase(const serial_pinmap_t &static_pinmap, int baud) :
+#if DEVICE_SERIAL_ASYNCH
+    _thunk_irq(this), _tx_usage(DMA_USAGE_NEVER),
+    _rx_usage(DMA_USAGE_NEVER), _tx_callback(NULL),
+    _rx_callback(NULL), _tx_asynch_set(false),
+    _rx_asynch_set(false),
+#endif
+    _serial(), _baud(baud)
+{
+    // No lock needed in the constructor
+
+    for (size_t i = 0; i < sizeof _irq / sizeof _irq[0]; i++) {
+        _irq[i] = NULL;
+    }
+
+    serial_init_direct(&_serial, &static_pinmap);
+    serial_baud(&_serial, _baud);
+    serial_irq_handler(&_serial, SerialBase::_irq_handler, (uint32_t)this);
+}
+
 void SerialBase::baud(int baudrate)
 {
     lock();
@@ -102,9 +123,11 @@ void SerialBase::attach(Callback<void()> func, IrqType type)
 void SerialBase::_irq_handler(uint32_t id, SerialIrq irq_type)
 {
     SerialBase *handler = (SerialBase *)id;
+    MBED_SCHED_TRACE_ISR_ENTER();
     if (handler->_irq[irq_type]) {
         handler->_irq[irq_type]();
     }
+    MBED_SCHED_TRACE_ISR_EXIT();
 }
 
 int SerialBase::_base_getc()
@@ -23,6 +23,7 @@
 
 #include "platform/Callback.h"
 #include "hal/serial_api.h"
+#include "hal/static_pinmap.h"
 #include "platform/mbed_toolchain.h"
 #include "platform/NonCopyable.h"
 
@@ -286,6 +287,7 @@ protected:
 #if !defined(DOXYGEN_ONLY)
 protected:
     SerialBase(PinName tx, PinName rx, int baud);
+    SerialBase(const serial_pinmap_t &static_pinmap, int baud);
     virtual ~SerialBase();
 
     int _base_getc();
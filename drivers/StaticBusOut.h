@@ -0,0 +1,237 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_STATIC_BUS_OUT_H
+#define MBED_STATIC_BUS_OUT_H
+
+#include "platform/platform.h"
+#include "hal/gpio_api.h"
+#include "hal/port_api.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include "platform/NonCopyable.h"
+
+#if DEVICE_PORTOUT && defined(PINNAME_TO_PORT) && defined(PINNAME_TO_PORT_PIN)
+#define MBED_STATIC_BUS_OUT_PORTS 1
+#else
+#define MBED_STATIC_BUS_OUT_PORTS 0
+#endif
+
+namespace mbed {
+/** \addtogroup drivers */
+
+namespace impl {
+#if MBED_STATIC_BUS_OUT_PORTS
+/* Compile time grouping of the StaticBusOut pins by port. Kept out of the
+ * class so the number of ports can size its members.
+ */
+template <PinName... Pins>
+struct static_bus_out_map {
+    static constexpr int width = sizeof...(Pins);
+    static constexpr PinName pins[sizeof...(Pins)] = {Pins...};
+
+    static constexpr int port_of(int i)
+    {
+        return PINNAME_TO_PORT(pins[i]);
+    }
+
+    static constexpr uint32_t port_bit(int i)
+    {
+        return 1UL << PINNAME_TO_PORT_PIN(pins[i]);
+    }
+
+    // True if pin i is the first of the bus on its port
+    static constexpr bool leads(int i, int j = 0)
+    {
+        return j >= i ? true : (port_of(j) != port_of(i) && leads(i, j + 1));
+    }
+
+    static constexpr int count_ports(int i = 0)
+    {
+        return i >= width ? 0 : (leads(i) ? 1 : 0) + count_ports(i + 1);
+    }
+
+    // Port bits of the pins on the same port as pin i, from pin j on
+    static constexpr uint32_t group_mask(int i, int j = 0)
+    {
+        return j >= width ? 0 : ((port_of(j) == port_of(i) ? port_bit(j) : 0) | group_mask(i, j + 1));
+    }
+
+    // Port value for the pins on the same port as pin i
+    static constexpr uint32_t port_value(int i, int value, int j = 0)
+    {
+        return j >= width ? 0 :
+               ((port_of(j) == port_of(i) && ((value >> j) & 1) ? port_bit(j) : 0) | port_value(i, value, j + 1));
+    }
+
+    // Bus value of the pins on the same port as pin i
+    static constexpr int bus_value(int i, int port, int j = 0)
+    {
+        return j >= width ? 0 :
+               ((port_of(j) == port_of(i) && (port & port_bit(j)) ? (1 << j) : 0) | bus_value(i, port, j + 1));
+    }
+};
+
+template <PinName... Pins>
+constexpr PinName static_bus_out_map<Pins...>::pins[sizeof...(Pins)];
+#else
+template <PinName... Pins>
+struct static_bus_out_map {
+};
+#endif
+} // namespace impl
+
+/** A digital output bus whose pins are fixed at compile time
+ *
+ * Unlike BusOut, which sets its pins one after the other, the pins sharing a
+ * port are grouped at compile time and written with a single masked port write,
+ * so they change together and a write costs one store per port used. Targets
+ * that do not provide the compile time pin to port mapping described in
+ * port_api.h fall back to writing each pin.
+ *
+ * Pin i of the template argument list is bit i of the bus.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * // Drive the 4-bit data bus of a character LCD
+ * #include "mbed.h"
+ *
+ * StaticBusOut<PB_4, PB_5, PB_6, PB_7> data;
+ *
+ * int main() {
+ *     data = 0x3;
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+template <PinName... Pins>
+class StaticBusOut : private NonCopyable<StaticBusOut<Pins...> > {
+    static constexpr int width = sizeof...(Pins);
+    MBED_STRUCT_STATIC_ASSERT(width > 0 && width <= 32, "StaticBusOut needs 1 to 32 pins");
+
+public:
+    /** Create a StaticBusOut and configure its pins as outputs
+     */
+    StaticBusOut()
+    {
+        core_util_critical_section_enter();
+#if MBED_STATIC_BUS_OUT_PORTS
+        for (int i = 0, group = 0; i < width; i++) {
+            MBED_ASSERT(_pins[i] != NC);
+            if (map::leads(i)) {
+                port_init(&_port[group++], (PortName)map::port_of(i), map::group_mask(i), PIN_OUTPUT);
+            }
+        }
+#else
+        for (int i = 0; i < width; i++) {
+            gpio_init_out(&_gpio[i], _pins[i]);
+        }
+#endif
+        core_util_critical_section_exit();
+    }
+
+    /** Write the value to the output bus
+     *
+     *  @param value An integer specifying a bit to write for every corresponding pin
+     */
+    void write(int value)
+    {
+        core_util_critical_section_enter();
+#if MBED_STATIC_BUS_OUT_PORTS
+        for (int i = 0, group = 0; i < width; i++) {
+            if (map::leads(i)) {
+                port_write(&_port[group++], map::port_value(i, value));
+            }
+        }
+#else
+        for (int i = 0; i < width; i++) {
+            gpio_write(&_gpio[i], (value >> i) & 1);
+        }
+#endif
+        core_util_critical_section_exit();
+    }
+
+    /** Read the value currently output on the bus
+     *
+     *  @returns
+     *    An integer with each bit corresponding to associated pin value
+     */
+    int read()
+    {
+        int value = 0;
+        core_util_critical_section_enter();
+#if MBED_STATIC_BUS_OUT_PORTS
+        for (int i = 0, group = 0; i < width; i++) {
+            if (map::leads(i)) {
+                value |= map::bus_value(i, port_read(&_port[group++]));
+            }
+        }
+#else
+        for (int i = 0; i < width; i++) {
+            value |= gpio_read(&_gpio[i]) << i;
+        }
+#endif
+        core_util_critical_section_exit();
+        return value;
+    }
+
+    /** Binary mask of the bus pins
+     */
+    int mask()
+    {
+        return (int)(0xFFFFFFFFUL >> (32 - width));
+    }
+
+    /** A shorthand for write()
+     * \sa StaticBusOut::write()
+     */
+    StaticBusOut &operator= (int v)
+    {
+        write(v);
+        return *this;
+    }
+
+    /** A shorthand for read()
+     * \sa StaticBusOut::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    typedef impl::static_bus_out_map<Pins...> map;
+    static constexpr PinName _pins[sizeof...(Pins)] = {Pins...};
+
+#if MBED_STATIC_BUS_OUT_PORTS
+    port_t _port[map::count_ports()];
+#else
+    gpio_t _gpio[width];
+#endif
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+#if !defined(DOXYGEN_ONLY)
+template <PinName... Pins>
+constexpr PinName StaticBusOut<Pins...>::_pins[sizeof...(Pins)];
+#endif
+
+} // namespace mbed
+
+#endif
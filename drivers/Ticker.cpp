@@ -41,13 +41,15 @@ void Ticker::setup(us_timestamp_t t)
     core_util_critical_section_enter();
     remove();
     _delay = t;
-    insert_absolute(_delay + ticker_read_us(_ticker_data));
+    _next = _delay + ticker_read_us(_ticker_data);
+    insert_absolute(_next, _slack);
     core_util_critical_section_exit();
 }
 
 void Ticker::handler()
 {
-    insert_absolute(event.timestamp + _delay);
+    _next += _delay;
+    insert_absolute(_next, _slack);
     if (_function) {
         _function();
     }
@@ -67,12 +67,12 @@ namespace mbed {
 class Ticker : public TimerEvent, private NonCopyable<Ticker> {
 
 public:
-    Ticker() : TimerEvent(), _function(0), _lock_deepsleep(true)
+    Ticker() : TimerEvent(), _slack(0), _function(0), _lock_deepsleep(true)
     {
     }
 
     // When low power ticker is in use, then do not disable deep sleep.
-    Ticker(const ticker_data_t *data) : TimerEvent(data), _function(0), _lock_deepsleep(!data->interface->runs_in_deep_sleep)
+    Ticker(const ticker_data_t *data) : TimerEvent(data), _slack(0), _function(0), _lock_deepsleep(!data->interface->runs_in_deep_sleep)
     {
     }
 
@@ -134,6 +134,22 @@ public:
         attach_us(Callback<void()>(obj, method), t);
     }
 
+    /** Allow calls to run late so they can share wake-ups with other timers
+     *
+     *  Each call may be delayed by up to @a slack microseconds, which lets the
+     *  ticker group it with other events due within that window and reduces
+     *  how often the system wakes from sleep. The period is still kept on
+     *  average, the delay does not accumulate.
+     *
+     *  @param slack how late, in microseconds, a call may run, 0 by default
+     *
+     *  @note Takes effect from the next time a call is scheduled.
+     */
+    void set_slack_us(uint32_t slack)
+    {
+        _slack = slack;
+    }
+
     virtual ~Ticker()
     {
         detach();
@@ -150,6 +166,8 @@ protected:
 
 protected:
     us_timestamp_t         _delay;  /**< Time delay (in microseconds) for resetting the multishot callback. */
+    us_timestamp_t          _next;  /**< Time the next callback is due, before slack is applied. */
+    uint32_t               _slack;  /**< Time (in microseconds) callbacks may be delayed to coalesce wake-ups. */
     Callback<void()>    _function;  /**< Callback. */
     bool          _lock_deepsleep;  /**< Flag which indicates if deep sleep should be disabled. */
 #endif
@@ -51,7 +51,7 @@ void Timer::start()
         if (_lock_deepsleep) {
             sleep_manager_lock_deep_sleep();
         }
-        _start = ticker_read_us(_ticker_data);
+        _start = ticker_read_us_lock_free(_ticker_data);
         _running = 1;
     }
     core_util_critical_section_exit();
@@ -87,8 +87,15 @@ int Timer::read_ms()
 
 us_timestamp_t Timer::read_high_resolution_us()
 {
+    // Ticker read outside the critical section, which only guards the timer state
+    us_timestamp_t now = ticker_read_us_lock_free(_ticker_data);
+
     core_util_critical_section_enter();
-    us_timestamp_t time = _time + slicetime();
+    us_timestamp_t time = _time;
+    // An interrupt may have restarted the timer after the ticker was read
+    if (_running && now > _start) {
+        time += now - _start;
+    }
     core_util_critical_section_exit();
     return time;
 }
@@ -98,7 +105,7 @@ us_timestamp_t Timer::slicetime()
     us_timestamp_t ret = 0;
     core_util_critical_section_enter();
     if (_running) {
-        ret = ticker_read_us(_ticker_data) - _start;
+        ret = ticker_read_us_lock_free(_ticker_data) - _start;
     }
     core_util_critical_section_exit();
     return ret;
@@ -54,6 +54,11 @@ void TimerEvent::insert_absolute(us_timestamp_t timestamp)
     ticker_insert_event_us(_ticker_data, &event, timestamp, (uint32_t)this);
 }
 
+void TimerEvent::insert_absolute(us_timestamp_t timestamp, uint32_t slack)
+{
+    ticker_insert_event_us_slack(_ticker_data, &event, timestamp, slack, (uint32_t)this);
+}
+
 void TimerEvent::remove()
 {
     ticker_remove_event(_ticker_data, &event);
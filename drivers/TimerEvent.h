@@ -72,6 +72,17 @@ protected:
      */
     void insert_absolute(us_timestamp_t timestamp);
 
+    /** Set absolute timestamp of the internal event, allowing it to run late.
+     * @param   timestamp   event's earliest us timestamp
+     * @param   slack       how late, in us, the event may run so that it can
+     *                      share a wake-up with other events
+     *
+     * @warning
+     * Do not insert more than one timestamp.
+     * The same @a event object is used for every @a insert/insert_absolute call.
+     */
+    void insert_absolute(us_timestamp_t timestamp, uint32_t slack);
+
     /** Remove timestamp.
      */
     void remove();
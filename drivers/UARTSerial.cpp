@@ -19,6 +19,7 @@
 #if (DEVICE_SERIAL && DEVICE_INTERRUPTIN)
 
 #include "platform/mbed_poll.h"
+#include <algorithm>
 
 #if MBED_CONF_RTOS_PRESENT
 #include "rtos/ThisThread.h"
@@ -31,11 +32,22 @@ namespace mbed {
 UARTSerial::UARTSerial(PinName tx, PinName rx, int baud) :
     SerialBase(tx, rx, baud),
     _blocking(true),
+    _tx_drop(false),
+    _tx_dropped(0),
     _tx_irq_enabled(false),
     _rx_irq_enabled(false),
     _tx_enabled(true),
     _rx_enabled(true),
     _dcd_irq(NULL)
+#if DEVICE_SERIAL_ASYNCH
+    , _asynch(false),
+    _rx_asynch_active(false),
+    _rx_asynch_idle(true),
+    _rx_asynch_partial(false),
+    _tx_asynch_active(false),
+    _rx_asynch_index(0),
+    _rx_asynch_length(0)
+#endif
 {
     /* Attatch IRQ routines to the serial device. */
     enable_rx_irq();
@@ -43,6 +55,9 @@ UARTSerial::UARTSerial(PinName tx, PinName rx, int baud) :
 
 UARTSerial::~UARTSerial()
 {
+#if DEVICE_SERIAL_ASYNCH
+    set_asynch(false);
+#endif
     delete _dcd_irq;
 }
 
@@ -111,7 +126,11 @@ int UARTSerial::sync()
 {
     api_lock();
 
-    while (!_txbuf.empty()) {
+    while (!_txbuf.empty()
+#if DEVICE_SERIAL_ASYNCH
+            || _tx_asynch_active
+#endif
+          ) {
         api_unlock();
         // Doing better than wait would require TxIRQ to also do wake() when becoming empty. Worth it?
         wait_ms(1);
@@ -141,6 +160,14 @@ void UARTSerial::sigio(Callback<void()> func)
  */
 ssize_t UARTSerial::write_unbuffered(const char *buf_ptr, size_t length)
 {
+#if DEVICE_SERIAL_ASYNCH
+    // the chunk in flight can't complete from critical section
+    if (_tx_asynch_active) {
+        SerialBase::abort_write();
+        _tx_asynch_active = false;
+    }
+#endif
+
     while (!_txbuf.empty()) {
         tx_irq();
     }
@@ -152,20 +179,9 @@ ssize_t UARTSerial::write_unbuffered(const char *buf_ptr, size_t length)
     return length;
 }
 
-ssize_t UARTSerial::write(const void *buffer, size_t length)
+size_t UARTSerial::write_locked(const char *buf_ptr, size_t length)
 {
     size_t data_written = 0;
-    const char *buf_ptr = static_cast<const char *>(buffer);
-
-    if (length == 0) {
-        return 0;
-    }
-
-    if (core_util_in_critical_section()) {
-        return write_unbuffered(buf_ptr, length);
-    }
-
-    api_lock();
 
     // Unlike read, we should write the whole thing if blocking. POSIX only
     // allows partial as a side-effect of signal handling; it normally tries to
@@ -173,6 +189,11 @@ ssize_t UARTSerial::write(const void *buffer, size_t length)
     while (data_written < length) {
 
         if (_txbuf.full()) {
+            if (_tx_drop) {
+                _tx_dropped += length - data_written;
+                data_written = length;
+                break;
+            }
             if (!_blocking) {
                 break;
             }
@@ -183,21 +204,78 @@ ssize_t UARTSerial::write(const void *buffer, size_t length)
             } while (_txbuf.full());
         }
 
-        while (data_written < length && !_txbuf.full()) {
-            _txbuf.push(*buf_ptr++);
-            data_written++;
-        }
+        size_t pushed = _txbuf.push(Span<const char>(buf_ptr, length - data_written));
+        buf_ptr += pushed;
+        data_written += pushed;
 
         core_util_critical_section_enter();
-        if (_tx_enabled && !_tx_irq_enabled) {
-            UARTSerial::tx_irq();                // only write to hardware in one place
-            if (!_txbuf.empty()) {
-                enable_tx_irq();
+#if DEVICE_SERIAL_ASYNCH
+        if (_asynch) {
+            tx_asynch_start();
+        } else
+#endif
+            if (_tx_enabled && !_tx_irq_enabled) {
+                UARTSerial::tx_irq();                // only write to hardware in one place
+                if (!_txbuf.empty()) {
+                    enable_tx_irq();
+                }
             }
-        }
         core_util_critical_section_exit();
     }
 
+    return data_written;
+}
+
+ssize_t UARTSerial::write(const void *buffer, size_t length)
+{
+    const char *buf_ptr = static_cast<const char *>(buffer);
+
+    if (length == 0) {
+        return 0;
+    }
+
+    if (core_util_in_critical_section()) {
+        return write_unbuffered(buf_ptr, length);
+    }
+
+    api_lock();
+
+    size_t data_written = write_locked(buf_ptr, length);
+
+    api_unlock();
+
+    return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
+}
+
+ssize_t UARTSerial::writev(const struct iovec *iov, int iovcnt)
+{
+    size_t length = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        length += iov[i].iov_len;
+    }
+
+    if (length == 0) {
+        return 0;
+    }
+
+    if (core_util_in_critical_section()) {
+        for (int i = 0; i < iovcnt; i++) {
+            write_unbuffered(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+        }
+        return length;
+    }
+
+    api_lock();
+
+    size_t data_written = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        size_t written = write_locked(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+        data_written += written;
+        if (written < iov[i].iov_len) {
+            break;
+        }
+    }
+
     api_unlock();
 
     return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
@@ -205,9 +283,16 @@ ssize_t UARTSerial::write(const void *buffer, size_t length)
 
 ssize_t UARTSerial::read(void *buffer, size_t length)
 {
-    size_t data_read = 0;
+    struct iovec iov = { buffer, length };
+    return readv(&iov, 1);
+}
 
-    char *ptr = static_cast<char *>(buffer);
+ssize_t UARTSerial::readv(const struct iovec *iov, int iovcnt)
+{
+    size_t length = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        length += iov[i].iov_len;
+    }
 
     if (length == 0) {
         return 0;
@@ -225,18 +310,23 @@ ssize_t UARTSerial::read(void *buffer, size_t length)
         api_lock();
     }
 
-    while (data_read < length && !_rxbuf.empty()) {
-        _rxbuf.pop(*ptr++);
-        data_read++;
+    size_t data_read = 0;
+    for (int i = 0; i < iovcnt && !_rxbuf.empty(); i++) {
+        data_read += _rxbuf.pop(Span<char>(static_cast<char *>(iov[i].iov_base), iov[i].iov_len));
     }
 
     core_util_critical_section_enter();
-    if (_rx_enabled && !_rx_irq_enabled) {
-        UARTSerial::rx_irq();               // only read from hardware in one place
-        if (!_rxbuf.full()) {
-            enable_rx_irq();
+#if DEVICE_SERIAL_ASYNCH
+    if (_asynch) {
+        rx_asynch_start(0);
+    } else
+#endif
+        if (_rx_enabled && !_rx_irq_enabled) {
+            UARTSerial::rx_irq();               // only read from hardware in one place
+            if (!_rxbuf.full()) {
+                enable_rx_irq();
+            }
         }
-    }
     core_util_critical_section_exit();
 
     api_unlock();
@@ -251,6 +341,7 @@ bool UARTSerial::hup() const
 
 void UARTSerial::wake()
 {
+    poll_wake(this);
     if (_sigio_cb) {
         _sigio_cb();
     }
@@ -373,15 +464,27 @@ int UARTSerial::enable_input(bool enabled)
 {
     core_util_critical_section_enter();
     if (_rx_enabled != enabled) {
-        if (enabled) {
-            UARTSerial::rx_irq();
-            if (!_rxbuf.full()) {
-                enable_rx_irq();
+#if DEVICE_SERIAL_ASYNCH
+        if (_asynch) {
+            _rx_enabled = enabled;
+            if (enabled) {
+                rx_asynch_start(0);
+            } else {
+                rx_asynch_stop();
             }
-        } else {
-            disable_rx_irq();
+        } else
+#endif
+        {
+            if (enabled) {
+                UARTSerial::rx_irq();
+                if (!_rxbuf.full()) {
+                    enable_rx_irq();
+                }
+            } else {
+                disable_rx_irq();
+            }
+            _rx_enabled = enabled;
         }
-        _rx_enabled = enabled;
     }
     core_util_critical_section_exit();
 
@@ -392,21 +495,192 @@ int UARTSerial::enable_output(bool enabled)
 {
     core_util_critical_section_enter();
     if (_tx_enabled != enabled) {
+#if DEVICE_SERIAL_ASYNCH
+        if (_asynch) {
+            // a chunk in flight completes, no new chunk is started
+            _tx_enabled = enabled;
+            if (enabled) {
+                tx_asynch_start();
+            }
+        } else
+#endif
+        {
+            if (enabled) {
+                UARTSerial::tx_irq();
+                if (!_txbuf.empty()) {
+                    enable_tx_irq();
+                }
+            } else {
+                disable_tx_irq();
+            }
+            _tx_enabled = enabled;
+        }
+    }
+    core_util_critical_section_exit();
+
+    return 0;
+}
+
+#if DEVICE_SERIAL_ASYNCH
+int UARTSerial::set_asynch(bool enabled, DMAUsage usage)
+{
+    api_lock();
+    core_util_critical_section_enter();
+    if (_asynch != enabled) {
         if (enabled) {
-            UARTSerial::tx_irq();
-            if (!_txbuf.empty()) {
-                enable_tx_irq();
+            if (_rx_irq_enabled) {
+                disable_rx_irq();
             }
+            if (_tx_irq_enabled) {
+                disable_tx_irq();
+            }
+            SerialBase::set_dma_usage_rx(usage);
+            SerialBase::set_dma_usage_tx(usage);
+
+            _asynch = true;
+            _rx_asynch_idle = true;
+            _rx_asynch_partial = serial_rx_asynch_received(&_serial) >= 0;
+            rx_asynch_start(0);
+            tx_asynch_start();
         } else {
-            disable_tx_irq();
+            rx_asynch_stop();
+            if (_tx_asynch_active) {
+                SerialBase::abort_write();
+                _tx_asynch_active = false;
+            }
+            _asynch = false;
+
+            if (_rx_enabled) {
+                UARTSerial::rx_irq();
+                if (!_rxbuf.full()) {
+                    enable_rx_irq();
+                }
+            }
+            if (_tx_enabled) {
+                UARTSerial::tx_irq();
+                if (!_txbuf.empty()) {
+                    enable_tx_irq();
+                }
+            }
         }
-        _tx_enabled = enabled;
     }
     core_util_critical_section_exit();
+    api_unlock();
 
     return 0;
 }
 
+/* These are all called from critical section or interrupt */
+void UARTSerial::rx_asynch_start(size_t pending)
+{
+    if (!_asynch || !_rx_enabled || _rx_asynch_active) {
+        return;
+    }
+
+    // only receive what fits in the buffer, restarted by read otherwise
+    size_t space = MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE - _rxbuf.size() - pending;
+    if (!space) {
+        return;
+    }
+
+    // wait for line activity with a single byte, then receive chunks
+    _rx_asynch_length = _rx_asynch_idle ? 1 :
+                        std::min(space, (size_t) MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE);
+    _rx_asynch_index ^= 1;
+    _rx_asynch_active = true;
+    SerialBase::read(_rx_asynch_buf[_rx_asynch_index], _rx_asynch_length,
+                     callback(this, &UARTSerial::rx_asynch_done), SERIAL_EVENT_RX_ALL & ~SERIAL_EVENT_RX_CHARACTER_MATCH);
+
+    if (!_rx_asynch_idle) {
+        // cut the chunk short if not filled in the time it takes to receive it
+        us_timestamp_t chunk_us = (us_timestamp_t)(_rx_asynch_length + 1) * 10 * 1000000 / _baud;
+        _rx_asynch_flush.attach_us(callback(this, &UARTSerial::rx_asynch_flush), chunk_us);
+    }
+}
+
+// Abort the ongoing transfer keeping the characters already received
+size_t UARTSerial::rx_asynch_stop(void)
+{
+    if (!_rx_asynch_active) {
+        return 0;
+    }
+
+    _rx_asynch_flush.detach();
+    SerialBase::abort_read();
+    _rx_asynch_active = false;
+
+    int received = serial_rx_asynch_received(&_serial);
+    size_t length = received > 0 ? std::min((size_t) received, _rx_asynch_length) : 0;
+    rx_asynch_push(_rx_asynch_buf[_rx_asynch_index], length);
+    return length;
+}
+
+void UARTSerial::rx_asynch_push(const uint8_t *data, size_t length)
+{
+    bool was_empty = _rxbuf.empty();
+
+    _rxbuf.push(Span<const char>((const char *) data, length));
+
+    /* Report the File handler that data is ready to be read from the buffer. */
+    if (was_empty && !_rxbuf.empty()) {
+        wake();
+    }
+}
+
+void UARTSerial::rx_asynch_done(int event)
+{
+    _rx_asynch_flush.detach();
+    _rx_asynch_active = false;
+
+    // characters of a transfer ended by an error are dropped
+    const uint8_t *data = _rx_asynch_buf[_rx_asynch_index];
+    size_t length = (event & SERIAL_EVENT_RX_COMPLETE) ? _rx_asynch_length : 0;
+    if (length && _rx_asynch_partial) {
+        // chunks can only be cut short if the target counts partial transfers
+        _rx_asynch_idle = false;
+    }
+
+    rx_asynch_start(length);
+    rx_asynch_push(data, length);
+}
+
+void UARTSerial::rx_asynch_flush(void)
+{
+    // nothing received in a chunk time means the line is idle
+    _rx_asynch_idle = !rx_asynch_stop();
+    rx_asynch_start(0);
+}
+
+void UARTSerial::tx_asynch_start(void)
+{
+    if (!_asynch || !_tx_enabled || _tx_asynch_active) {
+        return;
+    }
+
+    bool was_full = _txbuf.full();
+    size_t length = _txbuf.pop(Span<char>((char *) _tx_asynch_buf, MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE));
+
+    if (!length) {
+        return;
+    }
+
+    _tx_asynch_active = true;
+    SerialBase::write(_tx_asynch_buf, length,
+                      callback(this, &UARTSerial::tx_asynch_done), SERIAL_EVENT_TX_COMPLETE);
+
+    /* Report the File handler that data can be written to peripheral. */
+    if (was_full && !hup()) {
+        wake();
+    }
+}
+
+void UARTSerial::tx_asynch_done(int event)
+{
+    _tx_asynch_active = false;
+    tx_asynch_start();
+}
+#endif
+
 void UARTSerial::wait_ms(uint32_t millisec)
 {
     /* wait_ms implementation for RTOS spins until exact microseconds - we
@@ -27,8 +27,12 @@
 #include "InterruptIn.h"
 #include "platform/PlatformMutex.h"
 #include "hal/serial_api.h"
-#include "platform/CircularBuffer.h"
+#include "platform/SPSCCircularBuffer.h"
 #include "platform/NonCopyable.h"
+#include "platform/Buffer.h"
+#if DEVICE_SERIAL_ASYNCH
+#include "Timeout.h"
+#endif
 
 #ifndef MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE
 #define MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE  256
@@ -38,6 +42,10 @@
 #define MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE  256
 #endif
 
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE  32
+#endif
+
 namespace mbed {
 
 /** \addtogroup drivers */
@@ -64,6 +72,15 @@ public:
      */
     virtual short poll(short events) const;
 
+    /** Check whether the file handle wakes up poll(). Derived from FileHandle.
+     *
+     *  @return true, as UARTSerial wakes mbed::poll() on state changes
+     */
+    virtual bool wakes_poll() const
+    {
+        return true;
+    }
+
     /* Resolve ambiguities versus our private SerialBase
      * (for writable, spelling differs, but just in case)
      */
@@ -78,12 +95,39 @@ public:
      * * if no data can be written, and non-blocking set, return -EAGAIN
      * * if some data can be written, and non-blocking set, write partial
      *
+     *  Unless set_tx_overflow_drop is enabled, then what doesn't fit in the
+     *  transmit buffer is dropped and the whole length reported written.
+     *
      *  @param buffer   The buffer to write from
      *  @param length   The number of bytes to write
      *  @return         The number of bytes written, negative error on failure
      */
     virtual ssize_t write(const void *buffer, size_t length);
 
+    /** Write the data viewed by a pooled buffer
+     *
+     *  Same as write(const void *, size_t), without copying the data out of
+     *  the buffer first.
+     *
+     *  @param buffer   The buffer to write from
+     *  @return         The number of bytes written, negative error on failure
+     */
+    ssize_t write(const Buffer &buffer)
+    {
+        return write(buffer.data(), buffer.size());
+    }
+
+    /** Write the contents of several buffers to a file
+     *
+     *  Same as write(const void *, size_t) with the buffers written one after
+     *  the other, without the writes of other threads in between.
+     *
+     *  @param iov      The buffers to write from
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t writev(const struct iovec *iov, int iovcnt);
+
     /** Read the contents of a file into a buffer
      *
      *  Follows POSIX semantics:
@@ -98,6 +142,17 @@ public:
      */
     virtual ssize_t read(void *buffer, size_t length);
 
+    /** Read the contents of a file into several buffers
+     *
+     *  Same as read(void *, size_t), the buffers are filled in order with
+     *  the data available.
+     *
+     *  @param iov      The buffers to read in to
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t readv(const struct iovec *iov, int iovcnt);
+
     /** Close a file
      *
      *  @return         0 on success, negative error code on failure
@@ -152,6 +207,29 @@ public:
         return _blocking;
     }
 
+    /** Set whether writes drop data when the transmit buffer is full
+     *
+     * By default a blocking write waits for space in the transmit buffer.
+     * When dropping, data that doesn't fit is discarded instead and counted,
+     * so a write never waits for the line. This suits logging from threads
+     * which must not be stalled by the serial port.
+     *
+     *  @param drop         true to drop data, false to wait for space.
+     */
+    void set_tx_overflow_drop(bool drop)
+    {
+        _tx_drop = drop;
+    }
+
+    /** Get the number of bytes dropped by writes
+     *
+     *  @return             Bytes dropped since the port was created, see set_tx_overflow_drop
+     */
+    uint32_t get_tx_dropped() const
+    {
+        return _tx_dropped;
+    }
+
     /** Enable or disable input
      *
      * Control enabling of device for input. This is primarily intended
@@ -253,6 +331,33 @@ public:
     void set_flow_control(Flow type, PinName flow1 = NC, PinName flow2 = NC);
 #endif
 
+#if DEVICE_SERIAL_ASYNCH
+    /** Enable or disable asynchronous mode
+     *
+     * In asynchronous mode data is moved between the software buffers and the
+     * peripheral in chunks using the asynchronous serial API, with DMA if the
+     * target supports it, instead of one interrupt per character. Chunks are
+     * MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE bytes.
+     *
+     * As the serial HAL has no idle line event, reception uses single byte
+     * transfers while the line is idle, and chunks once data is flowing. A
+     * chunk that isn't filled within the time it takes to receive it is cut
+     * short, so data is delivered with at most one chunk time of latency.
+     * Cutting short relies on the target reporting the count of characters
+     * received so far through serial_rx_asynch_received; targets that can't
+     * keep using single byte transfers.
+     *
+     * Data being transmitted is lost when disabling, call sync first.
+     *
+     *  @param enabled      true to enable asynchronous mode, false to disable.
+     *  @param usage        DMA usage hint for the transfers
+     *
+     *  @return             0 on success
+     *  @return             Negative error code on failure
+     */
+    int set_asynch(bool enabled, DMAUsage usage = DMA_USAGE_OPPORTUNISTIC);
+#endif
+
 private:
 
     void wait_ms(uint32_t millisec);
@@ -272,6 +377,9 @@ private:
     /** Unbuffered write - invoked when write called from critical section */
     ssize_t write_unbuffered(const char *buf_ptr, size_t length);
 
+    /** Buffered write - invoked with the API lock held, partial only if non-blocking */
+    size_t write_locked(const char *buf_ptr, size_t length);
+
     void enable_rx_irq();
     void disable_rx_irq();
     void enable_tx_irq();
@@ -279,15 +387,20 @@ private:
 
     /** Software serial buffers
      *  By default buffer size is 256 for TX and 256 for RX. Configurable through mbed_app.json
+     *  Each buffer is filled by one side and drained by the other, the API
+     *  side serialized by the mutex and the interrupt side by the interrupt
+     *  or critical section, so they're lock-free.
      */
-    CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE> _rxbuf;
-    CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE> _txbuf;
+    SPSCCircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE> _rxbuf;
+    SPSCCircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE> _txbuf;
 
     PlatformMutex _mutex;
 
     Callback<void()> _sigio_cb;
 
     bool _blocking;
+    bool _tx_drop;
+    uint32_t _tx_dropped;
     bool _tx_irq_enabled;
     bool _rx_irq_enabled;
     bool _tx_enabled;
@@ -313,6 +426,31 @@ private:
 
     void dcd_irq(void);
 
+#if DEVICE_SERIAL_ASYNCH
+    /** Asynchronous mode
+     *  Transfers are started and completed from critical section or
+     *  interrupt. Reception uses two chunk buffers, so the next transfer is
+     *  started before the completed chunk is copied into the receive buffer.
+     */
+    void rx_asynch_start(size_t pending);
+    size_t rx_asynch_stop(void);
+    void rx_asynch_push(const uint8_t *data, size_t length);
+    void rx_asynch_done(int event);
+    void rx_asynch_flush(void);
+    void tx_asynch_start(void);
+    void tx_asynch_done(int event);
+
+    bool _asynch;
+    bool _rx_asynch_active;
+    bool _rx_asynch_idle;
+    bool _rx_asynch_partial;
+    bool _tx_asynch_active;
+    uint8_t _rx_asynch_index;
+    size_t _rx_asynch_length;
+    Timeout _rx_asynch_flush;
+    uint8_t _rx_asynch_buf[2][MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE];
+    uint8_t _tx_asynch_buf[MBED_CONF_DRIVERS_UART_SERIAL_ASYNCH_CHUNK_SIZE];
+#endif
 };
 } //namespace mbed
 
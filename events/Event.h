@@ -59,6 +59,8 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->key = 0;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -127,6 +129,38 @@ public:
         }
     }
 
+    /** Configure the ordering key of an event
+     *
+     *  Events with the same non-zero key never run concurrently when the
+     *  queue is dispatched by several workers, see
+     *  EventQueue::dispatch_worker.
+     *
+     *  @param key      Ordering key, 0 for no ordering (default to 0)
+     */
+    void key(uint16_t key)
+    {
+        if (_event) {
+            _event->key = key;
+        }
+    }
+
+    /** Configure the slack of an event
+     *
+     *  The event may be dispatched up to slack milliseconds late, which lets
+     *  the queue run it together with other events due in that window
+     *  instead of waking up separately for each. Periodic events keep their
+     *  period on average.
+     *
+     *  @param slack    Millisecond tolerance on the dispatch time, up to
+     *                  65535 (default to 0)
+     */
+    void slack(int slack)
+    {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -201,6 +235,8 @@ private:
 
         int delay;
         int period;
+        int slack;
+        uint16_t key;
 
         int (*post)(struct event *);
         void (*dtor)(struct event *);
@@ -221,6 +257,8 @@ private:
         new (p) C(*(F *)(e + 1));
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_key(p, e->key);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -511,6 +549,8 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->key = 0;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -579,6 +619,38 @@ public:
         }
     }
 
+    /** Configure the ordering key of an event
+     *
+     *  Events with the same non-zero key never run concurrently when the
+     *  queue is dispatched by several workers, see
+     *  EventQueue::dispatch_worker.
+     *
+     *  @param key      Ordering key, 0 for no ordering (default to 0)
+     */
+    void key(uint16_t key)
+    {
+        if (_event) {
+            _event->key = key;
+        }
+    }
+
+    /** Configure the slack of an event
+     *
+     *  The event may be dispatched up to slack milliseconds late, which lets
+     *  the queue run it together with other events due in that window
+     *  instead of waking up separately for each. Periodic events keep their
+     *  period on average.
+     *
+     *  @param slack    Millisecond tolerance on the dispatch time, up to
+     *                  65535 (default to 0)
+     */
+    void slack(int slack)
+    {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -657,6 +729,8 @@ private:
 
         int delay;
         int period;
+        int slack;
+        uint16_t key;
 
         int (*post)(struct event *, A0 a0);
         void (*dtor)(struct event *);
@@ -677,6 +751,8 @@ private:
         new (p) C(*(F *)(e + 1), a0);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_key(p, e->key);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -967,6 +1043,8 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->key = 0;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -1035,6 +1113,38 @@ public:
         }
     }
 
+    /** Configure the ordering key of an event
+     *
+     *  Events with the same non-zero key never run concurrently when the
+     *  queue is dispatched by several workers, see
+     *  EventQueue::dispatch_worker.
+     *
+     *  @param key      Ordering key, 0 for no ordering (default to 0)
+     */
+    void key(uint16_t key)
+    {
+        if (_event) {
+            _event->key = key;
+        }
+    }
+
+    /** Configure the slack of an event
+     *
+     *  The event may be dispatched up to slack milliseconds late, which lets
+     *  the queue run it together with other events due in that window
+     *  instead of waking up separately for each. Periodic events keep their
+     *  period on average.
+     *
+     *  @param slack    Millisecond tolerance on the dispatch time, up to
+     *                  65535 (default to 0)
+     */
+    void slack(int slack)
+    {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -1113,6 +1223,8 @@ private:
 
         int delay;
         int period;
+        int slack;
+        uint16_t key;
 
         int (*post)(struct event *, A0 a0, A1 a1);
         void (*dtor)(struct event *);
@@ -1133,6 +1245,8 @@ private:
         new (p) C(*(F *)(e + 1), a0, a1);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_key(p, e->key);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -1423,6 +1537,8 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->key = 0;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -1491,6 +1607,38 @@ public:
         }
     }
 
+    /** Configure the ordering key of an event
+     *
+     *  Events with the same non-zero key never run concurrently when the
+     *  queue is dispatched by several workers, see
+     *  EventQueue::dispatch_worker.
+     *
+     *  @param key      Ordering key, 0 for no ordering (default to 0)
+     */
+    void key(uint16_t key)
+    {
+        if (_event) {
+            _event->key = key;
+        }
+    }
+
+    /** Configure the slack of an event
+     *
+     *  The event may be dispatched up to slack milliseconds late, which lets
+     *  the queue run it together with other events due in that window
+     *  instead of waking up separately for each. Periodic events keep their
+     *  period on average.
+     *
+     *  @param slack    Millisecond tolerance on the dispatch time, up to
+     *                  65535 (default to 0)
+     */
+    void slack(int slack)
+    {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -1569,6 +1717,8 @@ private:
 
         int delay;
         int period;
+        int slack;
+        uint16_t key;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2);
         void (*dtor)(struct event *);
@@ -1589,6 +1739,8 @@ private:
         new (p) C(*(F *)(e + 1), a0, a1, a2);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_key(p, e->key);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -1879,6 +2031,8 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->key = 0;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -1947,6 +2101,38 @@ public:
         }
     }
 
+    /** Configure the ordering key of an event
+     *
+     *  Events with the same non-zero key never run concurrently when the
+     *  queue is dispatched by several workers, see
+     *  EventQueue::dispatch_worker.
+     *
+     *  @param key      Ordering key, 0 for no ordering (default to 0)
+     */
+    void key(uint16_t key)
+    {
+        if (_event) {
+            _event->key = key;
+        }
+    }
+
+    /** Configure the slack of an event
+     *
+     *  The event may be dispatched up to slack milliseconds late, which lets
+     *  the queue run it together with other events due in that window
+     *  instead of waking up separately for each. Periodic events keep their
+     *  period on average.
+     *
+     *  @param slack    Millisecond tolerance on the dispatch time, up to
+     *                  65535 (default to 0)
+     */
+    void slack(int slack)
+    {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -2025,6 +2211,8 @@ private:
 
         int delay;
         int period;
+        int slack;
+        uint16_t key;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2, A3 a3);
         void (*dtor)(struct event *);
@@ -2045,6 +2233,8 @@ private:
         new (p) C(*(F *)(e + 1), a0, a1, a2, a3);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_key(p, e->key);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -2336,6 +2526,8 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->key = 0;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -2404,6 +2596,38 @@ public:
         }
     }
 
+    /** Configure the ordering key of an event
+     *
+     *  Events with the same non-zero key never run concurrently when the
+     *  queue is dispatched by several workers, see
+     *  EventQueue::dispatch_worker.
+     *
+     *  @param key      Ordering key, 0 for no ordering (default to 0)
+     */
+    void key(uint16_t key)
+    {
+        if (_event) {
+            _event->key = key;
+        }
+    }
+
+    /** Configure the slack of an event
+     *
+     *  The event may be dispatched up to slack milliseconds late, which lets
+     *  the queue run it together with other events due in that window
+     *  instead of waking up separately for each. Periodic events keep their
+     *  period on average.
+     *
+     *  @param slack    Millisecond tolerance on the dispatch time, up to
+     *                  65535 (default to 0)
+     */
+    void slack(int slack)
+    {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -2482,6 +2706,8 @@ private:
 
         int delay;
         int period;
+        int slack;
+        uint16_t key;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4);
         void (*dtor)(struct event *);
@@ -2502,6 +2728,8 @@ private:
         new (p) C(*(F *)(e + 1), a0, a1, a2, a3, a4);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_key(p, e->key);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -21,13 +21,9 @@ using mbed::Callback;
 
 namespace events {
 
-EventQueue::EventQueue(unsigned event_size, unsigned char *event_pointer)
+EventQueue::EventQueue(unsigned event_size, unsigned char *event_pointer, unsigned flags)
 {
-    if (!event_pointer) {
-        equeue_create(&_equeue, event_size);
-    } else {
-        equeue_create_inplace(&_equeue, event_size, event_pointer);
-    }
+    equeue_create_flags(&_equeue, event_size, event_pointer, flags);
 }
 
 EventQueue::~EventQueue()
@@ -40,6 +36,11 @@ void EventQueue::dispatch(int ms)
     return equeue_dispatch(&_equeue, ms);
 }
 
+void EventQueue::dispatch_worker(int ms)
+{
+    return equeue_dispatch_worker(&_equeue, ms);
+}
+
 void EventQueue::break_dispatch()
 {
     return equeue_break(&_equeue);
@@ -60,6 +61,16 @@ int EventQueue::time_left(int id)
     return equeue_timeleft(&_equeue, id);
 }
 
+int EventQueue::get_stats(struct equeue_stats *stats)
+{
+    return equeue_stats(&_equeue, stats);
+}
+
+void EventQueue::reset_stats()
+{
+    equeue_stats_reset(&_equeue);
+}
+
 void EventQueue::background(Callback<void(int)> update)
 {
     _update = update;
@@ -60,8 +60,10 @@ public:
      *                  (default to EVENTS_QUEUE_SIZE)
      *  @param buffer   Pointer to buffer to use for events
      *                  (default to NULL)
+     *  @param flags    EQUEUE_FLAG_* flags, such as EQUEUE_FLAG_TREE to keep
+     *                  many pending timers efficiently (default to 0)
      */
-    EventQueue(unsigned size = EVENTS_QUEUE_SIZE, unsigned char *buffer = NULL);
+    EventQueue(unsigned size = EVENTS_QUEUE_SIZE, unsigned char *buffer = NULL, unsigned flags = 0);
 
     /** Destroy an EventQueue
      */
@@ -95,10 +97,42 @@ public:
         dispatch();
     }
 
+    /** Dispatch events as one of several workers
+     *
+     *  Same as EventQueue::dispatch, but any number of threads may call
+     *  dispatch_worker on the same queue concurrently to form a pool. Each
+     *  worker runs one event at a time, so a slow callback only holds up its
+     *  own worker. Events posted with the same non-zero key (see Event::key)
+     *  never run concurrently and run in the order they expire, other events
+     *  may run in any order.
+     *
+     *  A queue dispatched by workers must not also be dispatched with
+     *  EventQueue::dispatch, chained or backgrounded. break_dispatch stops
+     *  all workers.
+     *
+     *  @param ms       Time to wait for events in milliseconds, a negative
+     *                  value will dispatch events indefinitely
+     *                  (default to -1)
+     */
+    void dispatch_worker(int ms = -1);
+
+    /** Dispatch events as one of several workers without a timeout
+     *
+     *  This is equivalent to EventQueue::dispatch_worker with no arguments,
+     *  but avoids overload ambiguities when passed as a callback.
+     *
+     *  @see EventQueue::dispatch_worker
+     */
+    void dispatch_worker_forever()
+    {
+        dispatch_worker();
+    }
+
     /** Break out of a running event loop
      *
      *  Forces the specified event queue's dispatch loop to terminate. Pending
      *  events may finish executing, but no new events will be executed.
+     *  All workers of a queue dispatched with dispatch_worker terminate.
      */
     void break_dispatch();
 
@@ -149,6 +183,27 @@ public:
      */
     int time_left(int id);
 
+    /** Get runtime statistics of the event queue
+     *
+     *  Statistics include the queue depth and allocation high-water marks,
+     *  and histograms of dispatch lateness and callback execution time.
+     *  They are only collected if events stats are enabled through the
+     *  `platform.events-stats-enabled` or `platform.all-stats-enabled`
+     *  configuration options.
+     *
+     *  @param stats    Structure to fill with the statistics
+     *
+     *  @return         0 on success or
+     *                  negative error code if statistics are not enabled
+     */
+    int get_stats(struct equeue_stats *stats);
+
+    /** Reset runtime statistics of the event queue
+     *
+     *  Clears counters, histograms and high-water marks.
+     */
+    void reset_stats();
+
     /** Background an event queue onto a single-shot timer-interrupt
      *
      *  When updated, the event queue will call the provided update function
@@ -36,6 +36,19 @@ static inline int equeue_clampdiff(unsigned a, unsigned b)
     return ~(diff >> (8 * sizeof(int) -1)) & diff;
 }
 
+// Find the histogram bucket of a duration in ms
+#ifdef EQUEUE_STATS
+static inline unsigned equeue_stats_bucket(int ms)
+{
+    unsigned bucket = 0;
+    while (ms > 0 && bucket < EQUEUE_STATS_BUCKETS - 1) {
+        ms >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+#endif
+
 // Increment the unique id in an event, hiding the event from cancel
 static inline void equeue_incid(equeue_t *q, struct equeue_event *e)
 {
@@ -49,37 +62,46 @@ static inline void equeue_incid(equeue_t *q, struct equeue_event *e)
 // equeue lifetime management
 int equeue_create(equeue_t *q, size_t size)
 {
-    // dynamically allocate the specified buffer
-    void *buffer = malloc(size);
-    if (!buffer) {
-        return -1;
-    }
-
-    int err = equeue_create_inplace(q, size, buffer);
-    q->allocated = buffer;
-    return err;
+    return equeue_create_flags(q, size, 0, 0);
 }
 
 int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
 {
+    return equeue_create_flags(q, size, buffer, 0);
+}
+
+int equeue_create_flags(equeue_t *q, size_t size, void *buffer, unsigned flags)
+{
+    void *allocated = 0;
+    if (!buffer) {
+        // dynamically allocate the specified buffer
+        allocated = malloc(size);
+        if (!allocated) {
+            return -1;
+        }
+        buffer = allocated;
+    }
+
     // setup queue around provided buffer
     // ensure buffer and size are aligned
     q->buffer = (void *)(((uintptr_t) buffer + sizeof(void *) -1) & ~(sizeof(void *) -1));
     size -= (char *) q->buffer - (char *) buffer;
     size &= ~(sizeof(void *) -1);
 
-    q->allocated = 0;
+    q->allocated = allocated;
 
     q->npw2 = 0;
     for (unsigned s = size; s; s >>= 1) {
         q->npw2++;
     }
 
+    q->isr_queue = 0;
     q->chunks = 0;
     q->slab.size = size;
     q->slab.data = q->buffer;
 
     q->queue = 0;
+    q->flags = flags;
     q->tick = equeue_tick();
     q->generation = 0;
     q->break_requested = false;
@@ -88,6 +110,14 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     q->background.update = 0;
     q->background.timer = 0;
 
+    q->pool.ready = 0;
+    q->pool.ready_tail = &q->pool.ready;
+    q->pool.workers = 0;
+
+#ifdef EQUEUE_STATS
+    memset(&q->stats, 0, sizeof(q->stats));
+#endif
+
     // initialize platform resources
     int err;
     err = equeue_sema_create(&q->eventsema);
@@ -108,8 +138,14 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     return 0;
 }
 
+static struct equeue_event *equeue_tree_flatten(struct equeue_event *t);
+
 void equeue_destroy(equeue_t *q)
 {
+    if (q->flags & EQUEUE_FLAG_TREE) {
+        q->queue = equeue_tree_flatten(q->queue);
+    }
+
     // call destructors on pending events
     for (struct equeue_event *es = q->queue; es; es = es->next) {
         for (struct equeue_event *e = es->sibling; e; e = e->sibling) {
@@ -121,6 +157,16 @@ void equeue_destroy(equeue_t *q)
             es->dtor(es + 1);
         }
     }
+    for (struct equeue_event *e = q->isr_queue; e; e = e->next) {
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+    for (struct equeue_event *e = q->pool.ready; e; e = e->next) {
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
     // notify background timer
     if (q->background.update) {
         q->background.update(q->background.timer, -1);
@@ -154,6 +200,12 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
                 *p = e->next;
             }
 
+#ifdef EQUEUE_STATS
+            q->stats.alloc_size += e->size;
+            if (q->stats.alloc_size > q->stats.max_alloc_size) {
+                q->stats.max_alloc_size = q->stats.alloc_size;
+            }
+#endif
             equeue_mutex_unlock(&q->memlock);
             return e;
         }
@@ -167,6 +219,12 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
         e->size = size;
         e->id = 1;
 
+#ifdef EQUEUE_STATS
+        q->stats.alloc_size += e->size;
+        if (q->stats.alloc_size > q->stats.max_alloc_size) {
+            q->stats.max_alloc_size = q->stats.alloc_size;
+        }
+#endif
         equeue_mutex_unlock(&q->memlock);
         return e;
     }
@@ -194,6 +252,9 @@ static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e)
     }
     *p = e;
 
+#ifdef EQUEUE_STATS
+    q->stats.alloc_size -= e->size;
+#endif
     equeue_mutex_unlock(&q->memlock);
 }
 
@@ -206,7 +267,10 @@ void *equeue_alloc(equeue_t *q, size_t size)
 
     e->target = 0;
     e->period = -1;
+    e->slack = 0;
+    e->shift = 0;
     e->dtor = 0;
+    e->key = 0;
 
     return e + 1;
 }
@@ -223,6 +287,248 @@ void equeue_dealloc(equeue_t *q, void *p)
 }
 
 
+// equeue timer tree functions
+//
+// With EQUEUE_FLAG_TREE, time slots are kept in a top-down splay tree keyed
+// by target, using next as the left child and right as the right child.
+// Events sharing a slot are still chained through sibling, with ref pointing
+// back to the previous event. Slots in the tree instead have ref pointing to
+// the queue root, telling them apart from siblings.
+
+// splay the slot with the given target, or its neighbour, to the root
+static struct equeue_event *equeue_tree_splay(struct equeue_event *t,
+                                              unsigned target)
+{
+    if (!t) {
+        return 0;
+    }
+
+    struct equeue_event n;
+    struct equeue_event *l = &n;
+    struct equeue_event *r = &n;
+    n.next = 0;
+    n.right = 0;
+
+    while (1) {
+        int diff = equeue_tickdiff(target, t->target);
+        if (diff < 0) {
+            if (!t->next) {
+                break;
+            }
+
+            if (equeue_tickdiff(target, t->next->target) < 0) {
+                // rotate right
+                struct equeue_event *y = t->next;
+                t->next = y->right;
+                y->right = t;
+                t = y;
+                if (!t->next) {
+                    break;
+                }
+            }
+
+            // link right
+            r->next = t;
+            r = t;
+            t = t->next;
+        } else if (diff > 0) {
+            if (!t->right) {
+                break;
+            }
+
+            if (equeue_tickdiff(target, t->right->target) > 0) {
+                // rotate left
+                struct equeue_event *y = t->right;
+                t->right = y->next;
+                y->next = t;
+                t = y;
+                if (!t->right) {
+                    break;
+                }
+            }
+
+            // link left
+            l->right = t;
+            l = t;
+            t = t->right;
+        } else {
+            break;
+        }
+    }
+
+    l->right = t->next;
+    r->next = t->right;
+    t->next = n.right;
+    t->right = n.next;
+    return t;
+}
+
+// flatten a tree into a list of slots in target order, linked through next
+static struct equeue_event *equeue_tree_flatten(struct equeue_event *t)
+{
+    struct equeue_event *head = 0;
+    struct equeue_event **p = &head;
+    while (t) {
+        if (t->next) {
+            // rotate right until there is no left child
+            struct equeue_event *l = t->next;
+            t->next = l->right;
+            l->right = t;
+            t = l;
+        } else {
+            *p = t;
+            p = &t->next;
+            t = t->right;
+        }
+    }
+
+    *p = 0;
+    return head;
+}
+
+// find the earliest slot, must be called with queuelock held
+static struct equeue_event *equeue_first(equeue_t *q)
+{
+    if (!(q->flags & EQUEUE_FLAG_TREE) || !q->queue) {
+        return q->queue;
+    }
+
+    struct equeue_event *e = q->queue;
+    while (e->next) {
+        e = e->next;
+    }
+
+    q->queue = equeue_tree_splay(q->queue, e->target);
+    return q->queue;
+}
+
+static void equeue_tree_insert(equeue_t *q, struct equeue_event *e)
+{
+    struct equeue_event *t = equeue_tree_splay(q->queue, e->target);
+
+    if (t && t->target == e->target) {
+        // insert at head in slot
+        e->next = t->next;
+        e->right = t->right;
+        e->sibling = t;
+        t->next = 0;
+        t->ref = &e->sibling;
+    } else {
+        if (!t) {
+            e->next = 0;
+            e->right = 0;
+        } else if (equeue_tickdiff(e->target, t->target) < 0) {
+            e->next = t->next;
+            e->right = t;
+            t->next = 0;
+        } else {
+            e->next = t;
+            e->right = t->right;
+            t->right = 0;
+        }
+        e->sibling = 0;
+    }
+
+    q->queue = e;
+    e->ref = &q->queue;
+}
+
+static void equeue_tree_remove(equeue_t *q, struct equeue_event *e)
+{
+    if (e->ref != &q->queue) {
+        // sibling in a slot, same as in list
+        *e->ref = e->sibling;
+        if (e->sibling) {
+            e->sibling->ref = e->ref;
+        }
+        return;
+    }
+
+    struct equeue_event *t = equeue_tree_splay(q->queue, e->target);
+    if (e->sibling) {
+        // promote sibling to slot
+        e->sibling->next = t->next;
+        e->sibling->right = t->right;
+        e->sibling->ref = &q->queue;
+        q->queue = e->sibling;
+    } else if (!t->next) {
+        q->queue = t->right;
+    } else {
+        // all of left subtree is earlier, so its new root has no right child
+        q->queue = equeue_tree_splay(t->next, e->target);
+        q->queue->right = t->right;
+    }
+}
+
+// remove expired slots from tree, returning them in target order
+static struct equeue_event *equeue_tree_expire(equeue_t *q, unsigned target)
+{
+    struct equeue_event *t = equeue_tree_splay(q->queue, target);
+    if (!t) {
+        return 0;
+    }
+
+    struct equeue_event *expired;
+    if (equeue_tickdiff(t->target, target) <= 0) {
+        q->queue = t->right;
+        t->right = 0;
+        expired = t;
+    } else {
+        q->queue = t;
+        expired = t->next;
+        t->next = 0;
+    }
+
+    return equeue_tree_flatten(expired);
+}
+
+
+// find the earliest slot at or after target, must be called with queuelock held
+static struct equeue_event *equeue_slot_after(equeue_t *q, unsigned target)
+{
+    if (!(q->flags & EQUEUE_FLAG_TREE)) {
+        struct equeue_event *p = q->queue;
+        while (p && equeue_tickdiff(p->target, target) < 0) {
+            p = p->next;
+        }
+        return p;
+    }
+
+    q->queue = equeue_tree_splay(q->queue, target);
+    struct equeue_event *t = q->queue;
+    if (t && equeue_tickdiff(t->target, target) < 0) {
+        // root is the predecessor, successor is leftmost on the right
+        t = t->right;
+        while (t && t->next) {
+            t = t->next;
+        }
+    }
+    return t;
+}
+
+// delay an event with slack onto a common wake-up, must be called with
+// queuelock held. The earliest slot inside the slack window is joined if
+// there is one, otherwise the target is rounded up to a multiple of the
+// largest power of two not above the slack, so that unrelated events with
+// similar slack meet on the same ticks
+static void equeue_coalesce(equeue_t *q, struct equeue_event *e)
+{
+    unsigned target = e->target;
+    struct equeue_event *s = equeue_slot_after(q, target);
+    if (s && equeue_tickdiff(s->target, target) <= e->slack) {
+        e->target = s->target;
+    } else {
+        unsigned grain = 1;
+        while (grain <= e->slack / 2u) {
+            grain <<= 1;
+        }
+        e->target = (target + grain - 1) & ~(grain - 1);
+    }
+
+    // remember how far we moved, so periods run from the requested target
+    e->shift = e->target - target;
+}
+
 // equeue scheduling functions
 static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
 {
@@ -233,6 +539,32 @@ static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
 
     equeue_mutex_lock(&q->queuelock);
 
+    e->shift = 0;
+    if (e->slack) {
+        equeue_coalesce(q, e);
+    }
+
+#ifdef EQUEUE_STATS
+    q->stats.depth += 1;
+    if (q->stats.depth > q->stats.max_depth) {
+        q->stats.max_depth = q->stats.depth;
+    }
+#endif
+
+    if (q->flags & EQUEUE_FLAG_TREE) {
+        equeue_tree_insert(q, e);
+
+        // notify background timer
+        if ((q->background.update && q->background.active) &&
+                (!e->sibling && equeue_first(q) == e)) {
+            q->background.update(q->background.timer,
+                                 equeue_clampdiff(e->target, tick));
+        }
+
+        equeue_mutex_unlock(&q->queuelock);
+        return id;
+    }
+
     // find the event slot
     struct equeue_event **p = &q->queue;
     while (*p && equeue_tickdiff((*p)->target, e->target) < 0) {
@@ -288,6 +620,13 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id)
     e->cb = 0;
     e->period = -1;
 
+    // events posted from irq and not yet moved into the queue can't be
+    // disentangled, the dispatch loop skips and deallocates them instead
+    if (!e->ref) {
+        equeue_mutex_unlock(&q->queuelock);
+        return 0;
+    }
+
     int diff = equeue_tickdiff(e->target, q->tick);
     if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
         equeue_mutex_unlock(&q->queuelock);
@@ -295,7 +634,9 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id)
     }
 
     // disentangle from queue
-    if (e->sibling) {
+    if (q->flags & EQUEUE_FLAG_TREE) {
+        equeue_tree_remove(q, e);
+    } else if (e->sibling) {
         e->sibling->next = e->next;
         if (e->sibling->next) {
             e->sibling->next->ref = &e->sibling->next;
@@ -311,6 +652,9 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id)
     }
 
     equeue_incid(q, e);
+#ifdef EQUEUE_STATS
+    q->stats.depth -= 1;
+#endif
     equeue_mutex_unlock(&q->queuelock);
 
     return e;
@@ -326,18 +670,23 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
         q->tick = target;
     }
 
-    struct equeue_event *head = q->queue;
-    struct equeue_event **p = &head;
-    while (*p && equeue_tickdiff((*p)->target, target) <= 0) {
-        p = &(*p)->next;
-    }
+    struct equeue_event *head;
+    if (q->flags & EQUEUE_FLAG_TREE) {
+        head = equeue_tree_expire(q, target);
+    } else {
+        head = q->queue;
+        struct equeue_event **p = &head;
+        while (*p && equeue_tickdiff((*p)->target, target) <= 0) {
+            p = &(*p)->next;
+        }
 
-    q->queue = *p;
-    if (q->queue) {
-        q->queue->ref = &q->queue;
-    }
+        q->queue = *p;
+        if (q->queue) {
+            q->queue->ref = &q->queue;
+        }
 
-    *p = 0;
+        *p = 0;
+    }
 
     equeue_mutex_unlock(&q->queuelock);
 
@@ -358,6 +707,17 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
         tail = &es->next;
     }
 
+#ifdef EQUEUE_STATS
+    unsigned count = 0;
+    for (struct equeue_event *e = head; e; e = e->next) {
+        count++;
+    }
+
+    equeue_mutex_lock(&q->queuelock);
+    q->stats.depth -= count;
+    equeue_mutex_unlock(&q->queuelock);
+#endif
+
     return head;
 }
 
@@ -373,6 +733,48 @@ int equeue_post(equeue_t *q, void (*cb)(void *), void *p)
     return id;
 }
 
+int equeue_post_isr(equeue_t *q, void (*cb)(void *), void *p)
+{
+    if (q->background.update) {
+        return equeue_post(q, cb, p);
+    }
+
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    e->cb = cb;
+    e->target = equeue_tick() + e->target;
+    e->ref = 0;
+
+    int id = (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
+
+    void *head = q->isr_queue;
+    do {
+        e->next = head;
+    } while (!equeue_atomic_cas_ptr((void *volatile *)&q->isr_queue, &head, e));
+
+    equeue_sema_signal(&q->eventsema);
+    return id;
+}
+
+// move events posted from irq into the queue, in posting order
+static void equeue_isr_drain(equeue_t *q, unsigned tick)
+{
+    struct equeue_event *es = equeue_atomic_exchange_ptr((void *volatile *)&q->isr_queue, 0);
+
+    struct equeue_event *prev = 0;
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+        e->next = prev;
+        prev = e;
+    }
+
+    while (prev) {
+        struct equeue_event *e = prev;
+        prev = e->next;
+        equeue_enqueue(q, e, tick);
+    }
+}
+
 void equeue_cancel(equeue_t *q, int id)
 {
     if (!id) {
@@ -413,6 +815,45 @@ void equeue_break(equeue_t *q)
     equeue_sema_signal(&q->eventsema);
 }
 
+// dispatch a single event, then reenqueue periodic events or deallocate
+static void equeue_run(equeue_t *q, struct equeue_event *e, bool lockstats)
+{
+    // actually dispatch the callbacks
+    void (*cb)(void *) = e->cb;
+    if (cb) {
+#ifdef EQUEUE_STATS
+        unsigned start = equeue_tick();
+        cb(e + 1);
+        int runtime = equeue_tickdiff(equeue_tick(), start);
+
+        if (lockstats) {
+            equeue_mutex_lock(&q->queuelock);
+        }
+        q->stats.dispatched += 1;
+        q->stats.lateness[equeue_stats_bucket(equeue_tickdiff(start, e->target))] += 1;
+        q->stats.runtime[equeue_stats_bucket(runtime)] += 1;
+        if (runtime >= (int)q->stats.max_runtime) {
+            q->stats.max_runtime = runtime;
+            q->stats.max_runtime_cb = cb;
+        }
+        if (lockstats) {
+            equeue_mutex_unlock(&q->queuelock);
+        }
+#else
+        (void)lockstats;
+        cb(e + 1);
+#endif
+    }
+
+    if (e->period >= 0) {
+        e->target += e->period - e->shift;
+        equeue_enqueue(q, e, equeue_tick());
+    } else {
+        equeue_incid(q, e);
+        equeue_dealloc(q, e + 1);
+    }
+}
+
 void equeue_dispatch(equeue_t *q, int ms)
 {
     unsigned tick = equeue_tick();
@@ -420,6 +861,11 @@ void equeue_dispatch(equeue_t *q, int ms)
     q->background.active = false;
 
     while (1) {
+        // move in events posted from irq
+        if (q->isr_queue) {
+            equeue_isr_drain(q, tick);
+        }
+
         // collect all the available events and next deadline
         struct equeue_event *es = equeue_dequeue(q, tick);
 
@@ -428,20 +874,8 @@ void equeue_dispatch(equeue_t *q, int ms)
             struct equeue_event *e = es;
             es = e->next;
 
-            // actually dispatch the callbacks
-            void (*cb)(void *) = e->cb;
-            if (cb) {
-                cb(e + 1);
-            }
-
-            // reenqueue periodic events or deallocate
-            if (e->period >= 0) {
-                e->target += e->period;
-                equeue_enqueue(q, e, equeue_tick());
-            } else {
-                equeue_incid(q, e);
-                equeue_dealloc(q, e + 1);
-            }
+            // only the dispatch loop writes stats, no need to lock
+            equeue_run(q, e, false);
         }
 
         int deadline = -1;
@@ -454,9 +888,10 @@ void equeue_dispatch(equeue_t *q, int ms)
                 // update background timer if necessary
                 if (q->background.update) {
                     equeue_mutex_lock(&q->queuelock);
-                    if (q->background.update && q->queue) {
+                    struct equeue_event *first = equeue_first(q);
+                    if (q->background.update && first) {
                         q->background.update(q->background.timer,
-                                             equeue_clampdiff(q->queue->target, tick));
+                                             equeue_clampdiff(first->target, tick));
                     }
                     q->background.active = true;
                     equeue_mutex_unlock(&q->queuelock);
@@ -468,8 +903,9 @@ void equeue_dispatch(equeue_t *q, int ms)
 
         // find closest deadline
         equeue_mutex_lock(&q->queuelock);
-        if (q->queue) {
-            int diff = equeue_clampdiff(q->queue->target, tick);
+        struct equeue_event *first = equeue_first(q);
+        if (first) {
+            int diff = equeue_clampdiff(first->target, tick);
             if ((unsigned)diff < (unsigned)deadline) {
                 deadline = diff;
             }
@@ -496,6 +932,174 @@ void equeue_dispatch(equeue_t *q, int ms)
 }
 
 
+// worker dispatching a queue with equeue_dispatch_worker, lives on the
+// worker's stack while registered with the queue
+struct equeue_worker {
+    struct equeue_worker *next;
+    uint16_t key;
+    struct equeue_event *backlog;
+    struct equeue_event **backlog_tail;
+};
+
+// take the next event the worker may run off the ready list, must be
+// called with queuelock held. Events with a key held by another worker are
+// handed over to that worker's backlog to keep them in order
+static struct equeue_event *equeue_pool_take(equeue_t *q,
+                                             struct equeue_worker *w)
+{
+    while (q->pool.ready) {
+        struct equeue_event *e = q->pool.ready;
+        q->pool.ready = e->next;
+        if (!q->pool.ready) {
+            q->pool.ready_tail = &q->pool.ready;
+        }
+        e->next = 0;
+
+        struct equeue_worker *o = 0;
+        if (e->key) {
+            for (o = q->pool.workers; o && o->key != e->key; o = o->next) {
+            }
+        }
+
+        if (!o) {
+            w->key = e->key;
+            return e;
+        }
+
+        *o->backlog_tail = e;
+        o->backlog_tail = &e->next;
+    }
+
+    return 0;
+}
+
+void equeue_dispatch_worker(equeue_t *q, int ms)
+{
+    struct equeue_worker w;
+    w.key = 0;
+    w.backlog = 0;
+    w.backlog_tail = &w.backlog;
+
+    equeue_mutex_lock(&q->queuelock);
+    w.next = q->pool.workers;
+    q->pool.workers = &w;
+    equeue_mutex_unlock(&q->queuelock);
+
+    unsigned tick = equeue_tick();
+    unsigned timeout = tick + ms;
+
+    while (1) {
+        // move in events posted from irq
+        if (q->isr_queue) {
+            equeue_isr_drain(q, tick);
+        }
+
+        // move the available events onto the ready list shared by workers
+        struct equeue_event *es = equeue_dequeue(q, tick);
+        if (es) {
+            equeue_mutex_lock(&q->queuelock);
+            *q->pool.ready_tail = es;
+            while (es->next) {
+                es = es->next;
+            }
+            q->pool.ready_tail = &es->next;
+            equeue_mutex_unlock(&q->queuelock);
+        }
+
+        // dispatch events until the ready list is drained
+        bool dispatched = false;
+        while (1) {
+            equeue_mutex_lock(&q->queuelock);
+            struct equeue_event *e = equeue_pool_take(q, &w);
+            bool more = q->pool.ready;
+            equeue_mutex_unlock(&q->queuelock);
+
+            // wake up another worker to share the remaining events
+            if (more) {
+                equeue_sema_signal(&q->eventsema);
+            }
+
+            if (!e) {
+                break;
+            }
+
+            // run the event and any events handed over behind its key
+            while (e) {
+                equeue_run(q, e, true);
+
+                equeue_mutex_lock(&q->queuelock);
+                e = w.backlog;
+                if (e) {
+                    w.backlog = e->next;
+                    if (!w.backlog) {
+                        w.backlog_tail = &w.backlog;
+                    }
+                } else {
+                    w.key = 0;
+                }
+                equeue_mutex_unlock(&q->queuelock);
+            }
+
+            dispatched = true;
+        }
+
+        int deadline = -1;
+        tick = equeue_tick();
+
+        // check if we should stop dispatching soon
+        if (ms >= 0) {
+            deadline = equeue_tickdiff(timeout, tick);
+            if (deadline <= 0) {
+                break;
+            }
+        }
+
+        if (!dispatched) {
+            // find closest deadline
+            equeue_mutex_lock(&q->queuelock);
+            struct equeue_event *first = equeue_first(q);
+            if (first) {
+                int diff = equeue_clampdiff(first->target, tick);
+                if ((unsigned)diff < (unsigned)deadline) {
+                    deadline = diff;
+                }
+            }
+            equeue_mutex_unlock(&q->queuelock);
+
+            // wait for events
+            equeue_sema_wait(&q->eventsema, deadline);
+
+            // update tick for next iteration
+            tick = equeue_tick();
+        }
+
+        // check if we were notified to break out of dispatch
+        if (q->break_requested) {
+            break;
+        }
+    }
+
+    // leave the queue, the last worker clears any break request
+    equeue_mutex_lock(&q->queuelock);
+    for (struct equeue_worker **p = &q->pool.workers; *p; p = &(*p)->next) {
+        if (*p == &w) {
+            *p = w.next;
+            break;
+        }
+    }
+
+    if (!q->pool.workers) {
+        q->break_requested = false;
+    }
+    bool breaking = q->break_requested;
+    equeue_mutex_unlock(&q->queuelock);
+
+    // pass the break on to the remaining workers
+    if (breaking) {
+        equeue_sema_signal(&q->eventsema);
+    }
+}
+
 // event functions
 void equeue_event_delay(void *p, int ms)
 {
@@ -509,12 +1113,24 @@ void equeue_event_period(void *p, int ms)
     e->period = ms;
 }
 
+void equeue_event_slack(void *p, int ms)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    e->slack = ms < 0 ? 0 : ms > UINT16_MAX ? UINT16_MAX : ms;
+}
+
 void equeue_event_dtor(void *p, void (*dtor)(void *))
 {
     struct equeue_event *e = (struct equeue_event *)p - 1;
     e->dtor = dtor;
 }
 
+void equeue_event_key(void *p, uint16_t key)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    e->key = key;
+}
+
 
 // simple callbacks
 struct ecallback {
@@ -568,6 +1184,45 @@ int equeue_call_every(equeue_t *q, int ms, void (*cb)(void *), void *data)
 }
 
 
+// runtime statistics
+int equeue_stats(equeue_t *q, struct equeue_stats *stats)
+{
+#ifdef EQUEUE_STATS
+    equeue_mutex_lock(&q->queuelock);
+    *stats = q->stats;
+    equeue_mutex_unlock(&q->queuelock);
+
+    equeue_mutex_lock(&q->memlock);
+    stats->alloc_size = q->stats.alloc_size;
+    stats->max_alloc_size = q->stats.max_alloc_size;
+    stats->slab_size = q->slab.size;
+    equeue_mutex_unlock(&q->memlock);
+    return 0;
+#else
+    memset(stats, 0, sizeof(*stats));
+    return -1;
+#endif
+}
+
+void equeue_stats_reset(equeue_t *q)
+{
+#ifdef EQUEUE_STATS
+    equeue_mutex_lock(&q->queuelock);
+    q->stats.max_depth = q->stats.depth;
+    q->stats.dispatched = 0;
+    memset(q->stats.lateness, 0, sizeof(q->stats.lateness));
+    memset(q->stats.runtime, 0, sizeof(q->stats.runtime));
+    q->stats.max_runtime = 0;
+    q->stats.max_runtime_cb = 0;
+    equeue_mutex_unlock(&q->queuelock);
+
+    equeue_mutex_lock(&q->memlock);
+    q->stats.max_alloc_size = q->stats.alloc_size;
+    equeue_mutex_unlock(&q->memlock);
+#endif
+}
+
+
 // backgrounding
 void equeue_background(equeue_t *q,
                        void (*update)(void *timer, int ms), void *timer)
@@ -580,9 +1235,10 @@ void equeue_background(equeue_t *q,
     q->background.update = update;
     q->background.timer = timer;
 
-    if (q->background.update && q->queue) {
+    struct equeue_event *first = equeue_first(q);
+    if (q->background.update && first) {
         q->background.update(q->background.timer,
-                             equeue_clampdiff(q->queue->target, equeue_tick()));
+                             equeue_clampdiff(first->target, equeue_tick()));
     }
     q->background.active = true;
     equeue_mutex_unlock(&q->queuelock);
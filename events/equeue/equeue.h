@@ -41,22 +41,56 @@ struct equeue_event {
     unsigned size;
     uint8_t id;
     uint8_t generation;
+    uint16_t key;
 
     struct equeue_event *next;
     struct equeue_event *sibling;
     struct equeue_event **ref;
+    struct equeue_event *right;
 
     unsigned target;
     int period;
+    uint16_t slack;
+    uint16_t shift;
     void (*dtor)(void *);
 
     void (*cb)(void *);
     // data follows
 };
 
+// Event queue flags
+//
+// EQUEUE_FLAG_TREE - Keep pending events in a splay tree instead of a sorted
+//                    list. Posting and cancelling delayed events becomes
+//                    amortized logarithmic in the number of pending time
+//                    slots instead of linear, at the cost of some constant
+//                    overhead. Useful with many timers pending at once.
+#define EQUEUE_FLAG_TREE 0x1
+
+// Number of buckets in statistics histograms
+//
+// Bucket 0 counts 0 ms, bucket n counts [2^(n-1), 2^n) ms, and the last
+// bucket counts everything longer.
+#define EQUEUE_STATS_BUCKETS 8
+
+// Event queue runtime statistics, collected if EQUEUE_STATS is defined
+struct equeue_stats {
+    unsigned depth;                         // events currently pending
+    unsigned max_depth;                     // high-water mark of pending events
+    size_t alloc_size;                      // bytes currently allocated for events
+    size_t max_alloc_size;                  // high-water mark of allocated bytes
+    size_t slab_size;                       // bytes never allocated yet from slab
+    unsigned dispatched;                    // events dispatched
+    unsigned lateness[EQUEUE_STATS_BUCKETS];// ms from target to dispatch
+    unsigned runtime[EQUEUE_STATS_BUCKETS]; // ms spent in callback
+    unsigned max_runtime;                   // longest callback execution in ms
+    void (*max_runtime_cb)(void *);         // callback of longest execution
+};
+
 // Event queue structure
 typedef struct equeue {
     struct equeue_event *queue;
+    unsigned flags;
     unsigned tick;
     bool break_requested;
     uint8_t generation;
@@ -65,6 +99,8 @@ typedef struct equeue {
     unsigned npw2;
     void *allocated;
 
+    struct equeue_event *volatile isr_queue;
+
     struct equeue_event *chunks;
     struct equeue_slab {
         size_t size;
@@ -77,9 +113,19 @@ typedef struct equeue {
         void *timer;
     } background;
 
+    struct equeue_pool {
+        struct equeue_event *ready;
+        struct equeue_event **ready_tail;
+        struct equeue_worker *workers;
+    } pool;
+
     equeue_sema_t eventsema;
     equeue_mutex_t queuelock;
     equeue_mutex_t memlock;
+
+#ifdef EQUEUE_STATS
+    struct equeue_stats stats;
+#endif
 } equeue_t;
 
 
@@ -95,6 +141,13 @@ int equeue_create(equeue_t *queue, size_t size);
 int equeue_create_inplace(equeue_t *queue, size_t size, void *buffer);
 void equeue_destroy(equeue_t *queue);
 
+// Create an event queue with flags
+//
+// Same as equeue_create if buffer is null, otherwise same as
+// equeue_create_inplace, with the specified EQUEUE_FLAG_* flags.
+int equeue_create_flags(equeue_t *queue, size_t size, void *buffer,
+                        unsigned flags);
+
 // Dispatch events
 //
 // Executes events until the specified milliseconds have passed. If ms is
@@ -106,6 +159,20 @@ void equeue_destroy(equeue_t *queue);
 // equeue_dispatch does not wait and is irq safe.
 void equeue_dispatch(equeue_t *queue, int ms);
 
+// Dispatch events as one of several workers
+//
+// Same as equeue_dispatch, but any number of threads may call
+// equeue_dispatch_worker on the same queue concurrently. Each worker runs
+// one event at a time, so a slow callback only holds up its own worker.
+// Events with the same non-zero ordering key (see equeue_event_key) are
+// never run concurrently and run in the order they expire. Events without
+// a key may run in any order relative to each other.
+//
+// A queue dispatched by workers must not also be dispatched with
+// equeue_dispatch, chained, or backgrounded. equeue_break stops all
+// workers currently dispatching the queue.
+void equeue_dispatch_worker(equeue_t *queue, int ms);
+
 // Break out of a running event loop
 //
 // Forces the specified event queue's dispatch loop to terminate. Pending
@@ -156,9 +223,15 @@ void equeue_dealloc(equeue_t *queue, void *event);
 // equeue_event_delay  - Millisecond delay before dispatching an event
 // equeue_event_period - Millisecond period for repeating dispatching an event
 // equeue_event_dtor   - Destructor to run when the event is deallocated
+// equeue_event_key    - Ordering key serializing events under
+//                       equeue_dispatch_worker, 0 for no ordering
+// equeue_event_slack  - Milliseconds an event may be dispatched late so it
+//                       can share a wake-up with other events, up to 65535
 void equeue_event_delay(void *event, int ms);
 void equeue_event_period(void *event, int ms);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
+void equeue_event_key(void *event, uint16_t key);
+void equeue_event_slack(void *event, int ms);
 
 // Post an event onto the event queue
 //
@@ -174,6 +247,24 @@ void equeue_event_dtor(void *event, void (*dtor)(void *));
 // be passed to equeue_cancel.
 int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 
+// Post an event onto the event queue from an interrupt, without locking
+//
+// The equeue_post_isr function behaves like equeue_post, but the event is
+// pushed onto a lock-free list with a single atomic operation instead of
+// being inserted into the queue under the queue lock. The dispatch loop
+// moves these events into the queue before dispatching. This keeps interrupt
+// latency low when posting from high-rate interrupt handlers.
+//
+// The event must have been allocated beforehand, for example in thread
+// context with equeue_alloc, so no allocator lock is taken either.
+//
+// If the event queue is backgrounded or chained, equeue_post_isr falls back
+// to equeue_post, so background timers are still updated.
+//
+// The return value is a unique id that represents the posted event and can
+// be passed to equeue_cancel.
+int equeue_post_isr(equeue_t *queue, void (*cb)(void *), void *event);
+
 // Cancel an in-flight event
 //
 // Attempts to cancel an event referenced by the unique id returned from
@@ -196,6 +287,17 @@ void equeue_cancel(equeue_t *queue, int id);
 //
 int equeue_timeleft(equeue_t *q, int id);
 
+// Query event queue runtime statistics
+//
+// Fills stats with the statistics collected since the queue was created or
+// since the last equeue_stats_reset. Reset clears the high-water marks,
+// counters and histograms, but not the current depth or allocation size.
+//
+// If EQUEUE_STATS is not defined, no statistics are collected, and
+// equeue_stats returns a negative error code and zeroes stats.
+int equeue_stats(equeue_t *queue, struct equeue_stats *stats);
+void equeue_stats_reset(equeue_t *queue);
+
 // Background an event queue onto a single-shot timer
 //
 // The provided update function will be called to indicate when the queue
@@ -46,6 +46,12 @@ extern "C" {
 #endif
 #endif
 
+// Enable runtime statistics on mbed if events stats are enabled
+#if defined(EQUEUE_PLATFORM_MBED) && !defined(EQUEUE_STATS) && \
+    (defined(MBED_EVENTS_STATS_ENABLED) || defined(MBED_ALL_STATS_ENABLED))
+#define EQUEUE_STATS
+#endif
+
 // Platform includes
 #if defined(EQUEUE_PLATFORM_POSIX)
 #include <pthread.h>
@@ -143,6 +149,21 @@ void equeue_sema_signal(equeue_sema_t *sema);
 bool equeue_sema_wait(equeue_sema_t *sema, int ms);
 
 
+// Platform atomic operations
+//
+// The equeue library requires lock-free pointer operations that are safe
+// in interrupt contexts for the irq post path.
+//
+// The equeue_atomic_cas_ptr compares *ptr with *expected and, if equal,
+// stores desired into *ptr and returns true. Otherwise the current value of
+// *ptr is stored into *expected and false is returned.
+//
+// The equeue_atomic_exchange_ptr stores desired into *ptr and returns the
+// previous value.
+bool equeue_atomic_cas_ptr(void *volatile *ptr, void **expected, void *desired);
+void *equeue_atomic_exchange_ptr(void *volatile *ptr, void *desired);
+
+
 #ifdef __cplusplus
 }
 #endif
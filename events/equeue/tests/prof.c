@@ -262,6 +262,70 @@ void equeue_post_future_many_prof(int count)
     equeue_destroy(&q);
 }
 
+static void equeue_post_spread_flags_prof(int count, unsigned flags)
+{
+    struct equeue q;
+    equeue_create_flags(&q, count * EQUEUE_EVENT_SIZE, 0, flags);
+
+    // pending events in distinct time slots
+    for (int i = 0; i < count - 1; i++) {
+        equeue_call_in(&q, 1000 + i, no_func, 0);
+    }
+
+    prof_loop() {
+        void *e = equeue_alloc(&q, 0);
+        equeue_event_delay(e, 1000 + count);
+
+        prof_start();
+        int id = equeue_post(&q, no_func, e);
+        prof_stop();
+
+        equeue_cancel(&q, id);
+    }
+
+    equeue_destroy(&q);
+}
+
+void equeue_post_spread_many_prof(int count)
+{
+    equeue_post_spread_flags_prof(count, 0);
+}
+
+void equeue_post_spread_many_tree_prof(int count)
+{
+    equeue_post_spread_flags_prof(count, EQUEUE_FLAG_TREE);
+}
+
+static void equeue_cancel_spread_flags_prof(int count, unsigned flags)
+{
+    struct equeue q;
+    equeue_create_flags(&q, count * EQUEUE_EVENT_SIZE, 0, flags);
+
+    for (int i = 0; i < count - 1; i++) {
+        equeue_call_in(&q, 1000 + i, no_func, 0);
+    }
+
+    prof_loop() {
+        int id = equeue_call_in(&q, 1000 + count, no_func, 0);
+
+        prof_start();
+        equeue_cancel(&q, id);
+        prof_stop();
+    }
+
+    equeue_destroy(&q);
+}
+
+void equeue_cancel_spread_many_prof(int count)
+{
+    equeue_cancel_spread_flags_prof(count, 0);
+}
+
+void equeue_cancel_spread_many_tree_prof(int count)
+{
+    equeue_cancel_spread_flags_prof(count, EQUEUE_FLAG_TREE);
+}
+
 void equeue_dispatch_prof(void)
 {
     struct equeue q;
@@ -416,6 +480,11 @@ int main()
     prof_measure(equeue_dispatch_many_prof, 100);
     prof_measure(equeue_cancel_many_prof, 100);
 
+    prof_measure(equeue_post_spread_many_prof, 1000);
+    prof_measure(equeue_post_spread_many_tree_prof, 1000);
+    prof_measure(equeue_cancel_spread_many_prof, 1000);
+    prof_measure(equeue_cancel_spread_many_tree_prof, 1000);
+
     prof_measure(equeue_alloc_size_prof);
     prof_measure(equeue_alloc_many_size_prof, 1000);
     prof_measure(equeue_alloc_fragmented_size_prof, 1000);
@@ -50,6 +50,12 @@ static int test_failure;
 })
 
 
+// Flags all test queues are created with
+static unsigned test_flags;
+
+#define equeue_create(q, size) equeue_create_flags(q, size, 0, test_flags)
+
+
 // Test functions
 void pass_func(void *eh)
 {
@@ -208,6 +214,106 @@ void simple_post_test(void)
     equeue_destroy(&q);
 }
 
+struct order {
+    int *count;
+    int expected;
+};
+
+void order_func(void *p)
+{
+    struct order *o = (struct order *)p;
+    test_assert(*o->count == o->expected);
+    (*o->count)++;
+}
+
+void isr_post_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int count = 0;
+    int ids[8];
+    for (int i = 0; i < 8; i++) {
+        struct order *o = equeue_alloc(&q, sizeof(struct order));
+        test_assert(o);
+
+        o->count = &count;
+        o->expected = i < 4 ? i : i - 1;
+        ids[i] = equeue_post_isr(&q, order_func, o);
+        test_assert(ids[i]);
+    }
+
+    // cancel an event still waiting to be moved into the queue
+    equeue_cancel(&q, ids[4]);
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == 7);
+
+    equeue_destroy(&q);
+}
+
+struct isr_poster {
+    pthread_t thread;
+    equeue_t *q;
+    void **events;
+    int n;
+};
+
+static void *isr_poster_thread(void *p)
+{
+    struct isr_poster *t = (struct isr_poster *)p;
+    for (int i = 0; i < t->n; i++) {
+        int id = equeue_post_isr(t->q, simple_func, t->events[i]);
+        test_assert(id);
+    }
+    return 0;
+}
+
+void multithreaded_isr_post_test(int N)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 4 * N * EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    struct isr_poster t[4];
+    int count[4] = {0};
+    for (int j = 0; j < 4; j++) {
+        t[j].q = &q;
+        t[j].n = N;
+        t[j].events = malloc(N * sizeof(void *));
+        for (int i = 0; i < N; i++) {
+            int *e = equeue_alloc(&q, sizeof(int));
+            test_assert(e);
+            *e = 0;
+            t[j].events[i] = e;
+        }
+    }
+
+    for (int j = 0; j < 4; j++) {
+        err = pthread_create(&t[j].thread, 0, isr_poster_thread, &t[j]);
+        test_assert(!err);
+    }
+
+    for (int j = 0; j < 4; j++) {
+        err = pthread_join(t[j].thread, 0);
+        test_assert(!err);
+    }
+
+    equeue_dispatch(&q, 0);
+
+    // every event must be dispatched exactly once
+    for (int j = 0; j < 4; j++) {
+        for (int i = 0; i < N; i++) {
+            count[j] += *(int *)t[j].events[i];
+        }
+        test_assert(count[j] == N);
+        free(t[j].events);
+    }
+
+    equeue_destroy(&q);
+}
+
 // Misc tests
 void destructor_test(void)
 {
@@ -536,6 +642,144 @@ void multithread_test(void)
     equeue_destroy(&q);
 }
 
+void *worker_thread(void *p)
+{
+    equeue_t *q = (equeue_t *)p;
+    equeue_dispatch_worker(q, -1);
+    return 0;
+}
+
+struct worker_slow {
+    int *fast;
+    int seen;
+};
+
+void worker_slow_func(void *p)
+{
+    struct worker_slow *slow = (struct worker_slow *)p;
+    usleep(50000);
+    slow->seen = __atomic_load_n(slow->fast, __ATOMIC_SEQ_CST);
+}
+
+void worker_fast_func(void *p)
+{
+    __atomic_add_fetch((int *)p, 1, __ATOMIC_SEQ_CST);
+}
+
+void worker_test(int N)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int fast = 0;
+    struct worker_slow slow = {&fast, -1};
+    int id = equeue_call(&q, worker_slow_func, &slow);
+    test_assert(id);
+
+    for (int i = 0; i < 20; i++) {
+        id = equeue_call(&q, worker_fast_func, &fast);
+        test_assert(id);
+    }
+
+    pthread_t threads[N];
+    for (int i = 0; i < N; i++) {
+        err = pthread_create(&threads[i], 0, worker_thread, &q);
+        test_assert(!err);
+    }
+
+    usleep(100000);
+    equeue_break(&q);
+    for (int i = 0; i < N; i++) {
+        err = pthread_join(threads[i], 0);
+        test_assert(!err);
+    }
+
+    // fast events did not wait behind the slow one
+    test_assert(fast == 20);
+    test_assert(slow.seen == 20);
+
+    // break does not wind up once all workers are gone
+    int touched = 0;
+    id = equeue_call(&q, simple_func, &touched);
+    test_assert(id);
+    equeue_dispatch_worker(&q, 0);
+    test_assert(touched == 1);
+
+    equeue_destroy(&q);
+}
+
+struct worker_keyed {
+    int *running;
+    int *next;
+    int *failed;
+    int index;
+};
+
+void worker_keyed_func(void *p)
+{
+    struct worker_keyed *k = (struct worker_keyed *)p;
+
+    if (__atomic_exchange_n(k->running, 1, __ATOMIC_SEQ_CST)) {
+        *k->failed = true;
+    }
+
+    if (*k->next != k->index) {
+        *k->failed = true;
+    }
+    *k->next += 1;
+
+    usleep(100);
+    __atomic_store_n(k->running, 0, __ATOMIC_SEQ_CST);
+}
+
+void worker_key_test(int N)
+{
+    equeue_t q;
+    int err = equeue_create(&q, N * 4 * EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    int running[2] = {0, 0};
+    int next[2] = {0, 0};
+    int failed = false;
+    int fast = 0;
+
+    for (int i = 0; i < N; i++) {
+        struct worker_keyed *k = equeue_alloc(&q, sizeof(struct worker_keyed));
+        test_assert(k);
+
+        k->running = &running[i % 2];
+        k->next = &next[i % 2];
+        k->failed = &failed;
+        k->index = i / 2;
+        equeue_event_key(k, 1 + i % 2);
+        equeue_post(&q, worker_keyed_func, k);
+
+        int id = equeue_call(&q, worker_fast_func, &fast);
+        test_assert(id);
+    }
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        err = pthread_create(&threads[i], 0, worker_thread, &q);
+        test_assert(!err);
+    }
+
+    usleep(N * 100 + 50000);
+    equeue_break(&q);
+    for (int i = 0; i < 4; i++) {
+        err = pthread_join(threads[i], 0);
+        test_assert(!err);
+    }
+
+    test_assert(!failed);
+    test_assert(next[0] == (N + 1) / 2);
+    test_assert(next[1] == N / 2);
+    test_assert(fast == N);
+
+    equeue_destroy(&q);
+}
+
 void background_func(void *p, int ms)
 {
     *(unsigned *)p = ms;
@@ -802,14 +1046,179 @@ void sibling_test(void)
     equeue_destroy(&q);
 }
 
-int main()
+struct slacked {
+    int *count;
+};
+
+void slacked_func(void *p)
 {
-    printf("beginning tests...\n");
+    struct slacked *s = (struct slacked *)p;
+    (*s->count)++;
+}
+
+struct slacked *slacked_post(equeue_t *q, int delay, int period, int slack, int *count)
+{
+    struct slacked *s = equeue_alloc(q, sizeof(struct slacked));
+    test_assert(s);
+    s->count = count;
+    equeue_event_delay(s, delay);
+    equeue_event_period(s, period);
+    equeue_event_slack(s, slack);
+    test_assert(equeue_post(q, slacked_func, s));
+    return s;
+}
+
+void slack_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // an event with slack joins a later wake-up inside its window
+    int count = 0;
+    struct slacked *s0 = slacked_post(&q, 20, -1, 0, &count);
+    struct slacked *s1 = slacked_post(&q, 15, -1, 10, &count);
+    test_assert(((struct equeue_event *)s1 - 1)->target ==
+                ((struct equeue_event *)s0 - 1)->target);
+
+    // but never one outside of it
+    struct slacked *s2 = slacked_post(&q, 5, -1, 3, &count);
+    test_assert((int)(((struct equeue_event *)s2 - 1)->target -
+                      ((struct equeue_event *)s0 - 1)->target) < 0);
+
+    equeue_dispatch(&q, 30);
+    test_assert(count == 3);
+
+    // periodic events keep their period on average
+    count = 0;
+    slacked_post(&q, 10, 10, 7, &count);
+    equeue_dispatch(&q, 105);
+    test_assert(count == 10);
+
+    equeue_destroy(&q);
+}
+
+struct ordered {
+    unsigned target;
+    int index;
+    struct ordered **last;
+    int *count;
+};
+
+void ordered_func(void *p)
+{
+    struct ordered *o = (struct ordered *)p;
+    struct ordered *last = *o->last;
+    if (last) {
+        // targets in order, with ties in posting order
+        int diff = (int)(o->target - last->target);
+        test_assert(diff > 0 || (diff == 0 && o->index > last->index));
+    }
+    *o->last = o;
+    (*o->count)++;
+}
+
+void ordering_test(int N)
+{
+    equeue_t q;
+    int err = equeue_create(&q, N * (EQUEUE_EVENT_SIZE + sizeof(struct ordered)));
+    test_assert(!err);
+
+    struct ordered *last = 0;
+    int count = 0;
+    int *ids = malloc(N * sizeof(int));
+    srand(1);
+
+    for (int i = 0; i < N; i++) {
+        struct ordered *o = equeue_alloc(&q, sizeof(struct ordered));
+        test_assert(o);
+
+        o->index = i;
+        o->last = &last;
+        o->count = &count;
+        equeue_event_delay(o, rand() % 20);
+        ids[i] = equeue_post(&q, ordered_func, o);
+        test_assert(ids[i]);
+        o->target = ((struct equeue_event *)o - 1)->target;
+    }
+
+    // cancel every third event
+    for (int i = 0; i < N; i += 3) {
+        equeue_cancel(&q, ids[i]);
+    }
+
+    free(ids);
+    equeue_dispatch(&q, 40);
+    test_assert(count == N - (N + 2) / 3);
+    equeue_destroy(&q);
+}
+
+void stats_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    struct equeue_stats stats;
+    err = equeue_stats(&q, &stats);
+#ifndef EQUEUE_STATS
+    test_assert(err < 0);
+    equeue_destroy(&q);
+    return;
+#endif
+    test_assert(!err);
+    test_assert(stats.depth == 0 && stats.alloc_size == 0);
+    test_assert(stats.slab_size > 0);
 
+    int count = 0;
+    for (int i = 0; i < 4; i++) {
+        equeue_call(&q, sloth_func, &count);
+    }
+    int id = equeue_call_in(&q, 1000, simple_func, &count);
+
+    err = equeue_stats(&q, &stats);
+    test_assert(!err);
+    test_assert(stats.depth == 5 && stats.max_depth == 5);
+    test_assert(stats.alloc_size > 0 && stats.alloc_size == stats.max_alloc_size);
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == 4);
+
+    err = equeue_stats(&q, &stats);
+    test_assert(!err);
+    test_assert(stats.depth == 1 && stats.max_depth == 5);
+    test_assert(stats.dispatched == 4);
+    test_assert(stats.max_runtime >= 10 && stats.max_runtime_cb);
+
+    // sloth callbacks take 10ms each, so the last one ran at least 30ms late
+    unsigned total = 0, late = 0;
+    for (int i = 0; i < EQUEUE_STATS_BUCKETS; i++) {
+        total += stats.lateness[i];
+        if (i >= 5) {
+            late += stats.lateness[i];
+        }
+    }
+    test_assert(total == 4 && late >= 1);
+
+    equeue_cancel(&q, id);
+    equeue_stats_reset(&q);
+    err = equeue_stats(&q, &stats);
+    test_assert(!err);
+    test_assert(stats.depth == 0 && stats.max_depth == 0);
+    test_assert(stats.dispatched == 0 && stats.max_runtime == 0);
+    test_assert(stats.alloc_size == 0 && stats.max_alloc_size == 0);
+
+    equeue_destroy(&q);
+}
+
+static void run_tests(void)
+{
     test_run(simple_call_test);
     test_run(simple_call_in_test);
     test_run(simple_call_every_test);
     test_run(simple_post_test);
+    test_run(isr_post_test);
+    test_run(multithreaded_isr_post_test, 100);
     test_run(destructor_test);
     test_run(allocation_failure_test);
     test_run(cancel_test, 20);
@@ -825,11 +1234,27 @@ int main()
     test_run(chain_test);
     test_run(unchain_test);
     test_run(multithread_test);
+    test_run(worker_test, 4);
+    test_run(worker_key_test, 100);
     test_run(simple_barrage_test, 20);
     test_run(fragmenting_barrage_test, 20);
     test_run(multithreaded_barrage_test, 20);
     test_run(break_request_cleared_on_timeout);
     test_run(sibling_test);
+    test_run(slack_test);
+    test_run(ordering_test, 200);
+    test_run(stats_test);
+}
+
+int main()
+{
+    printf("beginning tests...\n");
+    run_tests();
+
+    printf("beginning tests with timer tree...\n");
+    test_flags = EQUEUE_FLAG_TREE;
+    run_tests();
+
     printf("done!\n");
     return test_failure;
 }
@@ -15,6 +15,10 @@
  */
 
 #include "events/mbed_shared_queues.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_stats.h"
+#include <string.h>
+#include <new>
 
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "rtos/Thread.h"
@@ -25,6 +29,9 @@ using namespace events;
 
 namespace mbed {
 
+// Shared event queue, once created, for mbed_stats_events_get
+static EventQueue *shared_queue;
+
 #ifdef MBED_CONF_RTOS_PRESENT
 /* Create an event queue, and start the thread that dispatches it. Static
  * variables mean this happens once the first time each template instantiation
@@ -60,9 +67,11 @@ EventQueue *mbed_event_queue()
     static unsigned char queue_buffer[MBED_CONF_EVENTS_SHARED_EVENTSIZE];
     static EventQueue queue(sizeof queue_buffer, queue_buffer);
 
+    shared_queue = &queue;
     return &queue;
 #else
-    return do_shared_event_queue_with_thread<osPriorityNormal, MBED_CONF_EVENTS_SHARED_EVENTSIZE, MBED_CONF_EVENTS_SHARED_STACKSIZE>("shared_event_queue");
+    shared_queue = do_shared_event_queue_with_thread<osPriorityNormal, MBED_CONF_EVENTS_SHARED_EVENTSIZE, MBED_CONF_EVENTS_SHARED_STACKSIZE>("shared_event_queue");
+    return shared_queue;
 #endif
 }
 
@@ -71,6 +80,70 @@ EventQueue *mbed_highprio_event_queue()
 {
     return do_shared_event_queue_with_thread<osPriorityHigh, MBED_CONF_EVENTS_SHARED_HIGHPRIO_EVENTSIZE, MBED_CONF_EVENTS_SHARED_HIGHPRIO_STACKSIZE>("shared_highprio_event_queue");
 }
+
+/* Start the worker threads of the pooled queue. Thread isn't default
+ * constructible with a static stack, so the threads are constructed in
+ * static storage.
+ */
+static bool start_pool_workers(EventQueue *queue)
+{
+    static uint64_t stacks[MBED_CONF_EVENTS_SHARED_POOL_WORKERS][MBED_CONF_EVENTS_SHARED_POOL_STACKSIZE / sizeof(uint64_t)];
+    static uint64_t threads[MBED_CONF_EVENTS_SHARED_POOL_WORKERS][(sizeof(Thread) + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+
+    for (int i = 0; i < MBED_CONF_EVENTS_SHARED_POOL_WORKERS; i++) {
+        Thread *thread = new (threads[i]) Thread(osPriorityNormal, MBED_CONF_EVENTS_SHARED_POOL_STACKSIZE,
+                                                 (unsigned char *) stacks[i], "shared_pool_worker");
+        osStatus status = thread->start(callback(queue, &EventQueue::dispatch_worker_forever));
+        MBED_ASSERT(status == osOK);
+        if (status != osOK) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+EventQueue *mbed_pooled_event_queue()
+{
+    static uint64_t queue_buffer[MBED_CONF_EVENTS_SHARED_POOL_EVENTSIZE / sizeof(uint64_t)];
+    static EventQueue queue(sizeof queue_buffer, (unsigned char *) queue_buffer);
+
+    static bool started = start_pool_workers(&queue);
+    if (!started) {
+        return NULL;
+    }
+
+    return &queue;
+}
 #endif
 
 }
+
+extern "C" void mbed_stats_events_get(mbed_stats_events_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_events_t));
+
+#ifdef MBED_EVENTS_STATS_ENABLED
+    MBED_STATIC_ASSERT(MBED_STATS_EVENTS_BUCKETS == EQUEUE_STATS_BUCKETS,
+                       "Event queue histograms must match mbed_stats_events_t");
+
+    struct equeue_stats es;
+    if (!mbed::shared_queue || mbed::shared_queue->get_stats(&es)) {
+        return;
+    }
+
+    stats->depth = es.depth;
+    stats->max_depth = es.max_depth;
+    stats->alloc_size = es.alloc_size;
+    stats->max_alloc_size = es.max_alloc_size;
+    stats->slab_size = es.slab_size;
+    stats->dispatched = es.dispatched;
+    for (int i = 0; i < MBED_STATS_EVENTS_BUCKETS; i++) {
+        stats->lateness[i] = es.lateness[i];
+        stats->runtime[i] = es.runtime[i];
+    }
+    stats->max_runtime = es.max_runtime;
+    stats->max_runtime_cb = es.max_runtime_cb;
+#endif
+}
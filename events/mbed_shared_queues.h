@@ -83,6 +83,34 @@ events::EventQueue *mbed_event_queue();
 
 events::EventQueue *mbed_highprio_event_queue();
 
+/**
+ * Return a pointer to an EventQueue dispatched by a pool of worker threads,
+ * on which independent, possibly slow, tasks can be queued.
+ *
+ * All calls to this return the same EventQueue - it and its worker threads
+ * are created on the first call to this function. There are
+ * `events.shared-pool-workers` workers, running at default priority
+ * (currently osPriorityNormal), each dispatching one event at a time with
+ * EventQueue::dispatch_worker.
+ *
+ * Events on the pooled event queue may run concurrently and in any order,
+ * so a slow event only holds up its own worker. Events which must not run
+ * concurrently, such as those sharing state, can be given the same ordering
+ * key with Event::key, and then run one at a time in the order they expire.
+ *
+ * The EventQueue returned may be used to call() Events, but must not be
+ * chained to another EventQueue.
+ *
+ * @note
+ * mbed_pooled_event_queue is not itself IRQ safe. To use the
+ * mbed_pooled_event_queue in interrupt context, you must first call
+ * `mbed_pooled_event_queue()` in threaded context and store the pointer for
+ * later use.
+ *
+ * @return pointer to pooled event queue
+ */
+events::EventQueue *mbed_pooled_event_queue();
+
 #endif // MBED_CONF_RTOS_PRESENT
 
 };
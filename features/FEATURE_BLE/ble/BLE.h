@@ -24,6 +24,7 @@
 #include "ble/GattServer.h"
 #include "ble/GattClient.h"
 #include "ble/SecurityManager.h"
+#include "ble/L2cap.h"
 
 #include "ble/FunctionPointerWithContext.h"
 
@@ -412,6 +413,15 @@ public:
     const SecurityManager &securityManager() const;
 #endif // BLE_FEATURE_SECURITY
 
+#if BLE_FEATURE_L2CAP_COC
+    /**
+     * Accessor to the L2CAP connection oriented channels.
+     *
+     * @return A reference to the L2cap object associated to this BLE instance.
+     */
+    ble::L2cap &l2cap();
+#endif // BLE_FEATURE_L2CAP_COC
+
     /**
      * Translate error code into a printable string.
      *
@@ -26,6 +26,7 @@
 #include "ble/SecurityManager.h"
 #include "ble/GattServer.h"
 #include "ble/GattClient.h"
+#include "ble/L2cap.h"
 
 
 
@@ -240,6 +241,21 @@ public:
     virtual const SecurityManager &getSecurityManager(void) const = 0;
 #endif // BLE_FEATURE_SECURITY
 
+#if BLE_FEATURE_L2CAP_COC
+    /**
+     * Accessor to the vendor implementation of the L2cap interface.
+     *
+     * The default implementation returns an L2cap object which does not
+     * support any operation.
+     *
+     * @return A reference to an L2cap object associated to this
+     * BLEInstanceBase instance.
+     *
+     * @see BLE::l2cap() ble::L2cap
+     */
+    virtual ble::L2cap &getL2cap(void);
+#endif // BLE_FEATURE_L2CAP_COC
+
     /**
      * Process pending events present in the vendor subsystem; then, put the MCU
      * to sleep until an external source wakes it up.
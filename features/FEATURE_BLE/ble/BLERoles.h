@@ -73,4 +73,10 @@
     #endif
 #endif // BLE_FEATURE_GATT_SERVER
 
+#if BLE_FEATURE_L2CAP_COC
+    #if !(BLE_FEATURE_CONNECTABLE)
+        #error "BLE feature 'L2CAP COC' requires 'PERIPHERAL' or 'CENTRAL' role"
+    #endif
+#endif // BLE_FEATURE_L2CAP_COC
+
 #endif // MBED_BLE_ROLES_H__
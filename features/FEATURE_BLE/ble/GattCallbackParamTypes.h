@@ -381,6 +381,33 @@ struct GattHVXCallbackParams {
 
 };
 
+/**
+ * Data sent event.
+ *
+ * The GattServer generates this type of event for every notification or
+ * indication handed to the link layer, or dropped by the stack.
+ *
+ * The event is passed to GattServer::EventHandler::onDataSent().
+ */
+struct GattDataSentCallbackParams {
+    /**
+     * The handle of the connection the update was sent to.
+     */
+    ble::connection_handle_t connHandle;
+
+    /**
+     * Handle of the characteristic value updated.
+     */
+    GattAttribute::Handle_t attHandle;
+
+    /**
+     * BLE_ERROR_NONE if the update has been sent, BLE_STACK_BUSY if it has
+     * been dropped because the link layer buffers of the connection were
+     * full, or another error if the connection was lost.
+     */
+    ble_error_t status;
+};
+
 /**
  * @}
  * @}
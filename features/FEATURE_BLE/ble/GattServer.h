@@ -120,6 +120,22 @@ public:
         )
         {
         }
+
+        /**
+         * Function invoked for every notification or indication once it has
+         * been handed to the link layer or dropped.
+         *
+         * Updates are queued by the stack until the link layer has buffers
+         * for them; a connection accepts a limited number of them while its
+         * buffers are full and drops the others. An application streaming
+         * updates can keep the link layer busy without losing any by sending
+         * the next update to a connection from this event.
+         *
+         * @param params Connection, attribute and outcome of the update.
+         */
+        virtual void onDataSent(const GattDataSentCallbackParams &params)
+        {
+        }
     };
 
     /**
@@ -133,6 +149,28 @@ public:
         eventHandler = handler;
     }
 
+    /**
+     * New value of an attribute, used to update several attributes at once.
+     *
+     * @see write(const AttributeUpdate *, size_t, bool).
+     */
+    struct AttributeUpdate {
+        /**
+         * Handle of the attribute to write.
+         */
+        GattAttribute::Handle_t handle;
+
+        /**
+         * Pointer to the new value.
+         */
+        const uint8_t *value;
+
+        /**
+         * Size of the new value in bytes.
+         */
+        uint16_t size;
+    };
+
     /**
      * Event handler invoked when the server has sent data to a client.
      *
@@ -342,6 +380,34 @@ public:
         bool localOnly = false
     );
 
+    /**
+     * Update the value of several attributes present in the local GATT server.
+     *
+     * All the values are updated first, then the notifications and
+     * indications of every updated characteristic are queued for all the
+     * subscribed clients before control returns to the stack, which sends
+     * them back to back.
+     *
+     * This is the efficient way to push the same data to many connections
+     * or several characteristics at a fixed rate; pair it with
+     * EventHandler::onDataSent() to learn when updates are dropped.
+     *
+     * @param[in] updates Array of attribute updates. Handles of CCCDs are
+     * not accepted.
+     * @param[in] count Number of updates in the array.
+     * @param[in] localOnly If this flag is true, no notification or
+     * indication is sent.
+     *
+     * @return BLE_ERROR_NONE if all the attribute values have been updated.
+     * In case of error, the updates preceding the faulty one may have been
+     * applied.
+     */
+    ble_error_t write(
+        const AttributeUpdate *updates,
+        size_t count,
+        bool localOnly = false
+    );
+
     /**
      * Determine if one of the connected clients has subscribed to notifications
      * or indications of the characteristic in input.
@@ -769,6 +835,12 @@ protected:
         bool localOnly
     );
 
+    ble_error_t writeUpdates_(
+        const AttributeUpdate *updates,
+        size_t count,
+        bool localOnly
+    );
+
     ble_error_t areUpdatesEnabled_(
         const GattCharacteristic &characteristic,
         bool *enabledP
@@ -0,0 +1,227 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_BLE_L2CAP_H__
+#define MBED_BLE_L2CAP_H__
+
+#include "ble/BLETypes.h"
+#include "ble/blecommon.h"
+
+namespace ble {
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup l2cap
+ * @{
+ */
+
+/**
+ * L2CAP connection oriented channels using LE credit based flow control.
+ *
+ * A channel carries a stream of service data units (SDU) between two
+ * applications over an existing connection without the ATT overhead of
+ * GATT procedures. Channels are opened to a protocol service multiplexer
+ * (PSM) the peer listens on.
+ *
+ * @par Sending data
+ *
+ * send() accepts a buffer of any size. The buffer is split into SDUs no larger
+ * than the MTU of the peer, which the stack segments into link layer packets
+ * and transmits as the peer grants credits. Only one buffer per channel is
+ * sent at a time, EventHandler::onDataSent reports when it is done and the
+ * next one can be sent.
+ *
+ * @par Receiving data
+ *
+ * Each SDU received is passed to EventHandler::onDataReceived. Credits are
+ * returned to the peer automatically once the SDU has been handled.
+ *
+ * @note Channels are closed when the connection they belong to is closed.
+ */
+class L2cap {
+public:
+    /**
+     * Events of the connection oriented channels.
+     */
+    struct EventHandler {
+        /**
+         * Called when a channel has been opened, locally or by the peer.
+         *
+         * @param connectionHandle Connection the channel belongs to.
+         * @param channel Local identifier of the channel.
+         * @param psm PSM of the channel.
+         * @param peerMtu Largest SDU the peer accepts.
+         */
+        virtual void onChannelConnected(
+            connection_handle_t connectionHandle,
+            uint16_t channel,
+            uint16_t psm,
+            uint16_t peerMtu
+        )
+        {
+        }
+
+        /**
+         * Called when a channel has been closed, or could not be opened.
+         *
+         * @param connectionHandle Connection the channel belonged to.
+         * @param channel Local identifier of the channel.
+         */
+        virtual void onChannelDisconnected(
+            connection_handle_t connectionHandle,
+            uint16_t channel
+        )
+        {
+        }
+
+        /**
+         * Called when an SDU has been received.
+         *
+         * @param channel Local identifier of the channel.
+         * @param data SDU received, only valid during the call.
+         * @param size Size of the SDU.
+         */
+        virtual void onDataReceived(
+            uint16_t channel,
+            const uint8_t *data,
+            uint16_t size
+        )
+        {
+        }
+
+        /**
+         * Called when a buffer given to send() has been transmitted or the
+         * transmission has failed.
+         *
+         * @param channel Local identifier of the channel.
+         * @param status BLE_ERROR_NONE if all the data has been sent or an
+         * appropriate error code.
+         */
+        virtual void onDataSent(uint16_t channel, ble_error_t status)
+        {
+        }
+
+    protected:
+        /**
+         * Prevent polymorphic deletion and avoid unnecessary virtual destructor
+         * as the L2cap class will never delete the instance it contains.
+         */
+        ~EventHandler()
+        {
+        }
+    };
+
+    /**
+     * Assign the event handler implementation that will be used by the L2CAP
+     * module to signal events back to the application.
+     *
+     * @param handler Application implementation of an EventHandler.
+     */
+    void setEventHandler(EventHandler *handler)
+    {
+        _eventHandler = handler;
+    }
+
+    /**
+     * Accept channels opened by peers to a PSM.
+     *
+     * @param psm PSM to listen on, between 0x0001 and 0x00FF.
+     *
+     * @return BLE_ERROR_NONE on success, BLE_ERROR_NO_MEM if no more PSM can
+     * be registered or an appropriate error code.
+     */
+    virtual ble_error_t listen(uint16_t psm)
+    {
+        return BLE_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /**
+     * Open a channel to a PSM of the peer.
+     *
+     * EventHandler::onChannelConnected is called once the peer has accepted
+     * the channel, EventHandler::onChannelDisconnected if it has refused it.
+     *
+     * @param connectionHandle Connection to open the channel on.
+     * @param psm PSM of the peer.
+     * @param channel Set to the local identifier of the channel.
+     *
+     * @return BLE_ERROR_NONE if the request has been sent or an appropriate
+     * error code.
+     */
+    virtual ble_error_t connect(
+        connection_handle_t connectionHandle,
+        uint16_t psm,
+        uint16_t *channel
+    )
+    {
+        return BLE_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /**
+     * Close a channel.
+     *
+     * @param channel Local identifier of the channel.
+     *
+     * @return BLE_ERROR_NONE if the request has been sent or an appropriate
+     * error code.
+     */
+    virtual ble_error_t disconnect(uint16_t channel)
+    {
+        return BLE_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /**
+     * Send data over a channel.
+     *
+     * @param channel Local identifier of the channel.
+     * @param data Data to send, must stay valid until EventHandler::onDataSent
+     * is called.
+     * @param size Number of bytes to send.
+     *
+     * @return BLE_ERROR_NONE if the transmission has started,
+     * BLE_STACK_BUSY if the previous buffer has not been sent yet or an
+     * appropriate error code.
+     */
+    virtual ble_error_t send(uint16_t channel, const uint8_t *data, uint32_t size)
+    {
+        return BLE_ERROR_NOT_IMPLEMENTED;
+    }
+
+protected:
+    L2cap() : _eventHandler(NULL)
+    {
+    }
+
+    /**
+     * Prevent polymorphic deletion, instances are owned by the BLE instance.
+     */
+    ~L2cap()
+    {
+    }
+
+    EventHandler *_eventHandler;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+} // namespace ble
+
+#endif // MBED_BLE_L2CAP_H__
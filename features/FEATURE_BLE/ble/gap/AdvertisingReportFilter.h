@@ -0,0 +1,226 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_GAP_ADVERTISING_REPORT_FILTER_H__
+#define MBED_GAP_ADVERTISING_REPORT_FILTER_H__
+
+#include <stdint.h>
+#include <string.h>
+#include "ble/blecommon.h"
+#include "BLETypes.h"
+#include "ble/gap/Types.h"
+#include "ble/gap/AdvertisingDataTypes.h"
+
+namespace ble {
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup gap
+ * @{
+ */
+
+/**
+ * Selection of the advertising reports forwarded to the application.
+ *
+ * The filter is applied by the host to every report received while scanning,
+ * before EventHandler::onAdvertisingReport is called:
+ *   - Reports with an RSSI below the minimum set are dropped.
+ *   - If patterns have been added, a report is kept only if one of its
+ *     advertising data elements matches one of them. A pattern matches an
+ *     element of the same type whose value starts with the pattern bytes.
+ *   - If a duplicate window is set, a report with the same address and the
+ *     same data as a report forwarded less than the window ago is dropped.
+ *
+ * @code
+ * // Only report iBeacons, at most once per second each
+ * const uint8_t ibeacon_prefix[] = { 0x4C, 0x00, 0x02, 0x15 };
+ * AdvertisingReportFilter filter;
+ * filter.addPattern(adv_data_type_t::MANUFACTURER_SPECIFIC_DATA, ibeacon_prefix);
+ * filter.setDuplicateWindow(millisecond_t(1000));
+ * gap.setAdvertisingReportFilter(&filter);
+ * @endcode
+ *
+ * @see Gap::setAdvertisingReportFilter
+ */
+class AdvertisingReportFilter {
+public:
+    /**
+     * Maximum number of patterns in a filter.
+     */
+    static const size_t MAX_PATTERNS = 4;
+
+    /**
+     * Maximum number of bytes of a pattern.
+     */
+    static const size_t MAX_PATTERN_SIZE = 16;
+
+    /**
+     * Construct a filter accepting all reports.
+     */
+    AdvertisingReportFilter() :
+        _pattern_count(0),
+        _min_rssi(-127),
+        _duplicate_window(0)
+    {
+    }
+
+    /**
+     * Add a pattern advertising data must match.
+     *
+     * @param type Type of the advertising data element to match.
+     * @param value Bytes the value of the element starts with; an empty value
+     * matches any element of the type.
+     *
+     * @return BLE_ERROR_NONE on success, BLE_ERROR_NO_MEM if MAX_PATTERNS
+     * patterns have already been added or BLE_ERROR_INVALID_PARAM if value is
+     * larger than MAX_PATTERN_SIZE.
+     */
+    ble_error_t addPattern(adv_data_type_t type, mbed::Span<const uint8_t> value)
+    {
+        if (_pattern_count == MAX_PATTERNS) {
+            return BLE_ERROR_NO_MEM;
+        }
+
+        if (value.size() > (ptrdiff_t) MAX_PATTERN_SIZE) {
+            return BLE_ERROR_INVALID_PARAM;
+        }
+
+        pattern_t &pattern = _patterns[_pattern_count++];
+        pattern.type = type.value();
+        pattern.size = value.size();
+        memcpy(pattern.value, value.data(), value.size());
+        return BLE_ERROR_NONE;
+    }
+
+    /**
+     * Remove all the patterns.
+     */
+    void clearPatterns()
+    {
+        _pattern_count = 0;
+    }
+
+    /**
+     * Set the minimum RSSI of the reports forwarded.
+     *
+     * @param rssi Minimum RSSI in dBm.
+     *
+     * @return A reference to this object.
+     */
+    AdvertisingReportFilter &setMinimumRssi(rssi_t rssi)
+    {
+        _min_rssi = rssi;
+        return *this;
+    }
+
+    /**
+     * Get the minimum RSSI of the reports forwarded.
+     */
+    rssi_t getMinimumRssi() const
+    {
+        return _min_rssi;
+    }
+
+    /**
+     * Set the time during which identical reports from the same address are
+     * dropped.
+     *
+     * @param window Duration of the window, 0 to forward all reports.
+     *
+     * @return A reference to this object.
+     */
+    AdvertisingReportFilter &setDuplicateWindow(millisecond_t window)
+    {
+        _duplicate_window = window;
+        return *this;
+    }
+
+    /**
+     * Get the time during which identical reports are dropped.
+     */
+    millisecond_t getDuplicateWindow() const
+    {
+        return _duplicate_window;
+    }
+
+    /**
+     * Check the RSSI and the patterns of the filter against a report.
+     *
+     * @param rssi RSSI of the report.
+     * @param data Advertising data of the report.
+     *
+     * @return true if the report passes the filter, duplicates aside.
+     */
+    bool matches(rssi_t rssi, mbed::Span<const uint8_t> data) const
+    {
+        if (rssi < _min_rssi) {
+            return false;
+        }
+
+        if (_pattern_count == 0) {
+            return true;
+        }
+
+        // The data comes from the air, element lengths are not trusted
+        ptrdiff_t position = 0;
+        while (position + 1 < data.size()) {
+            uint8_t length = data[position];
+            if (length == 0 || position + 1 + length > data.size()) {
+                break;
+            }
+
+            uint8_t type = data[position + 1];
+            const uint8_t *value = data.data() + position + 2;
+            uint8_t value_size = length - 1;
+
+            for (size_t i = 0; i < _pattern_count; ++i) {
+                const pattern_t &pattern = _patterns[i];
+                if (pattern.type == type &&
+                    pattern.size <= value_size &&
+                    memcmp(pattern.value, value, pattern.size) == 0) {
+                    return true;
+                }
+            }
+
+            position += 1 + length;
+        }
+
+        return false;
+    }
+
+private:
+    struct pattern_t {
+        uint8_t type;
+        uint8_t size;
+        uint8_t value[MAX_PATTERN_SIZE];
+    };
+
+    pattern_t _patterns[MAX_PATTERNS];
+    size_t _pattern_count;
+    rssi_t _min_rssi;
+    millisecond_t _duplicate_window;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+} // namespace ble
+
+#endif //MBED_GAP_ADVERTISING_REPORT_FILTER_H__
@@ -25,6 +25,7 @@
 #include "ble/gap/AdvertisingDataSimpleBuilder.h"
 #include "ble/gap/ConnectionParameters.h"
 #include "ble/gap/ScanParameters.h"
+#include "ble/gap/AdvertisingReportFilter.h"
 #include "ble/gap/AdvertisingParameters.h"
 #include "ble/gap/Events.h"
 
@@ -801,6 +802,27 @@ public:
      * @retval BLE_ERROR_NONE if successfully stopped scanning procedure.
      */
     ble_error_t stopScan();
+
+    /**
+     * Select the advertising reports forwarded to the application.
+     *
+     * Reports rejected by the filter are dropped by the host and never reach
+     * EventHandler::onAdvertisingReport. The filter applies to legacy and
+     * extended advertising reports and takes effect immediately, even while
+     * scanning.
+     *
+     * @param filter Filter to apply, it is copied and can be discarded after
+     * the call. NULL forwards all the reports again.
+     *
+     * @return BLE_ERROR_NONE on success.
+     *
+     * @note Duplicates are tracked in a cache of
+     * MBED_CONF_BLE_GAP_REPORT_CACHE_SIZE peers, the oldest entry is replaced
+     * when it is full. The cache is cleared when scanning starts.
+     *
+     * @see AdvertisingReportFilter
+     */
+    ble_error_t setAdvertisingReportFilter(const AdvertisingReportFilter *filter);
 #endif // BLE_ROLE_OBSERVER
 
 #if BLE_ROLE_OBSERVER
@@ -1084,6 +1106,54 @@ public:
         connection_handle_t connectionHandle,
         local_disconnection_reason_t reason
     );
+
+    /**
+     * Configure a connection for bulk data transfers.
+     *
+     * The controller is asked to use the longest link layer packets it
+     * supports (data length extension) and to move both directions of the
+     * connection to the LE 2M PHY if it supports it. Each change is negotiated
+     * with the peer and reported through EventHandler::onDataLengthChange and
+     * EventHandler::onPhyUpdateComplete.
+     *
+     * A high throughput link also needs a large ATT MTU, negotiated with
+     * GattClient::negotiateAttMtu, and connection events as long as the
+     * connection interval, requested by updateConnectionParameters with
+     * maxConnectionEventLength set to the connection interval.
+     *
+     * Use getPayloadPerConnectionEvent() to estimate the result once these
+     * procedures have completed.
+     *
+     * @param connectionHandle Handle of the connection to configure.
+     *
+     * @return BLE_ERROR_NONE if the procedures have been started,
+     * BLE_ERROR_NOT_IMPLEMENTED if the controller supports neither data length
+     * extension nor the LE 2M PHY or an appropriate error code.
+     */
+    ble_error_t requestHighThroughput(connection_handle_t connectionHandle);
+
+    /**
+     * Estimate the amount of attribute data sent in one connection event.
+     *
+     * The estimate assumes Write Without Response commands or notifications
+     * carrying attMtu - 3 bytes each, sent back to back in packets of txOctets
+     * and acknowledged by empty packets from the peer.
+     *
+     * @param attMtu ATT MTU of the connection.
+     * @param txOctets Maximum payload of a link layer packet, reported by
+     * EventHandler::onDataLengthChange; 27 without data length extension.
+     * @param phy PHY used by the transmitter.
+     * @param eventLength Duration of the connection event, at most the
+     * connection interval.
+     *
+     * @return Number of bytes of attribute values sent per connection event.
+     */
+    static uint32_t getPayloadPerConnectionEvent(
+        uint16_t attMtu,
+        uint16_t txOctets,
+        phy_t phy,
+        conn_event_length_t eventLength
+    );
 #endif // BLE_FEATURE_CONNECTABLE
 #if BLE_FEATURE_PHY_MANAGEMENT
     /**
@@ -1324,6 +1394,7 @@ protected:
         scan_period_t period
     );
     ble_error_t stopScan_();
+    ble_error_t setAdvertisingReportFilter_(const AdvertisingReportFilter *filter);
     ble_error_t createSync_(
         peer_address_type_t peerAddressType,
         const address_t &peerAddress,
@@ -1383,6 +1454,7 @@ protected:
         connection_handle_t connectionHandle,
         local_disconnection_reason_t reason
     );
+    ble_error_t requestHighThroughput_(connection_handle_t connectionHandle);
     ble_error_t readPhy_(connection_handle_t connection);
     ble_error_t setPreferredPhys_(
         const phy_set_t *txPhys,
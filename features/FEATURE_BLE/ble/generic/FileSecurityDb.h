@@ -21,20 +21,35 @@
 
 #include <stdio.h>
 
+#ifndef MBED_CONF_BLE_SECURITY_DB_MAX_ENTRIES
+#define MBED_CONF_BLE_SECURITY_DB_MAX_ENTRIES 5
+#endif
+
 namespace ble {
 namespace generic {
 
-/** Filesystem implementation */
+/**
+ * Filesystem implementation.
+ *
+ * The flags, sign counter and identity of every entry are kept in RAM so that
+ * lookups by address never touch the file. Changes to them are written when
+ * the entry is synced, keys are written as soon as they are set.
+ */
 class FileSecurityDb : public SecurityDb {
 private:
 
     struct entry_t {
         SecurityDistributionFlags_t flags;
         sign_count_t peer_sign_counter;
+        SecurityEntryIdentity_t peer_identity;
+        /* flags as they are in the file */
+        SecurityDistributionFlags_t synced_flags;
+        /* sign counter or identity not written yet */
+        bool dirty;
         size_t file_offset;
     };
 
-    static const size_t MAX_ENTRIES = 5;
+    static const size_t MAX_ENTRIES = MBED_CONF_BLE_SECURITY_DB_MAX_ENTRIES;
 
     static entry_t* as_entry(entry_handle_t db_handle) {
         return reinterpret_cast<entry_t*>(db_handle);
@@ -32,8 +32,13 @@
 
 #include "drivers/LowPowerTimeout.h"
 #include "drivers/LowPowerTicker.h"
+#include "drivers/LowPowerTimer.h"
 #include "platform/mbed_error.h"
 
+#ifndef MBED_CONF_BLE_GAP_REPORT_CACHE_SIZE
+#define MBED_CONF_BLE_GAP_REPORT_CACHE_SIZE 16
+#endif
+
 namespace ble {
 namespace generic {
 /**
@@ -339,6 +344,11 @@ public:
      */
     ble_error_t stopScan_();
 
+    /**
+     * @see Gap::setAdvertisingReportFilter
+     */
+    ble_error_t setAdvertisingReportFilter_(const AdvertisingReportFilter *filter);
+
     /**
      * @see Gap::connect
      */
@@ -401,6 +411,11 @@ public:
         connection_handle_t connectionHandle
     );
 
+    /**
+     * @see Gap::requestHighThroughput
+     */
+    ble_error_t requestHighThroughput_(connection_handle_t connectionHandle);
+
     /**
      * @see Gap::readPhy
      */
@@ -641,6 +656,22 @@ private:
 
     void on_advertising_report(const pal::GapAdvertisingReportEvent &e);
 
+    bool accept_advertising_report(
+        peer_address_type_t address_type,
+        const ble::address_t &address,
+        rssi_t rssi,
+        mbed::Span<const uint8_t> data
+    );
+
+    void clear_report_cache();
+
+#if BLE_FEATURE_PRIVACY
+    bool resolve_advertising_address(
+        peer_address_type_t &address_type,
+        ble::address_t &address
+    );
+#endif // BLE_FEATURE_PRIVACY
+
     void on_connection_complete(const pal::GapConnectionCompleteEvent &e);
 
     void on_disconnection_complete(const pal::GapDisconnectionCompleteEvent &e);
@@ -864,6 +895,21 @@ private:
     mutable bool _non_deprecated_scan_api_used : 1;
     bool _user_manage_connection_parameter_requests : 1;
 
+    // Advertising report filtering
+    struct report_cache_entry_t {
+        ble::address_t address;
+        uint8_t address_type;
+        uint32_t data_hash;
+        uint32_t time;
+        bool used;
+    };
+
+    AdvertisingReportFilter _report_filter;
+    bool _report_filter_enabled;
+    mbed::LowPowerTimer _report_filter_timer;
+    report_cache_entry_t _report_cache[MBED_CONF_BLE_GAP_REPORT_CACHE_SIZE];
+    size_t _report_cache_next;
+
 private:
     ble_error_t setExtendedAdvertisingParameters(
         advertising_handle_t handle,
@@ -27,6 +27,10 @@
 #include "ble/generic/GenericGap.h"
 #include "ble/pal/PalSecurityManager.h"
 
+#ifndef MBED_CONF_BLE_PRIVATE_ADDRESS_CACHE_SIZE
+#define MBED_CONF_BLE_PRIVATE_ADDRESS_CACHE_SIZE 8
+#endif
+
 namespace ble {
 namespace generic {
 
@@ -280,7 +284,8 @@ public:
         _default_key_distribution(pal::KeyDistribution::KEY_DISTRIBUTION_ALL),
         _pairing_authorisation_required(false),
         _legacy_pairing_allowed(true),
-        _master_sends_keys(false) {
+        _master_sends_keys(false),
+        _resolution_cache_next(0) {
         _pal.set_event_handler(this);
 
         /* We create a fake value for oob to allow creation of the next oob which needs
@@ -476,6 +481,34 @@ private:
         size_t count
     );
 
+    /**
+     * Find the identity of a bonded peer from a resolvable private address
+     * the LE subsystem could not resolve. Called by GAP.
+     *
+     * Results, including failures, are cached so that a peer advertising
+     * repeatedly with the same address costs a single resolution.
+     *
+     * @param[in] address Resolvable private address.
+     * @param[out] identity_address_is_public Type of the identity address.
+     * @param[out] identity_address Identity address of the peer.
+     * @return true if the address belongs to a bonded peer.
+     */
+    bool resolve_private_address_(
+        const address_t &address,
+        bool &identity_address_is_public,
+        address_t &identity_address
+    );
+
+    /**
+     * Check if a resolvable private address has been generated from an IRK.
+     */
+    static bool private_address_resolves(const address_t &address, const irk_t &irk);
+
+    /**
+     * Forget the addresses resolved, to call when the IRKs stored change.
+     */
+    void clear_resolution_cache();
+
 private:
     struct ControlBlock_t {
         ControlBlock_t();
@@ -548,6 +581,18 @@ private:
     static const size_t MAX_CONTROL_BLOCKS = 5;
     ControlBlock_t _control_blocks[MAX_CONTROL_BLOCKS];
 
+    struct resolution_cache_entry_t {
+        resolution_cache_entry_t() : identity_address_is_public(false), resolved(false), used(false) { }
+        address_t private_address;
+        address_t identity_address;
+        bool identity_address_is_public;
+        bool resolved;
+        bool used;
+    };
+
+    resolution_cache_entry_t _resolution_cache[MBED_CONF_BLE_PRIVATE_ADDRESS_CACHE_SIZE];
+    size_t _resolution_cache_next;
+
     /* implements ble::pal::SecurityManager::EventHandler */
 public:
     ////////////////////////////////////////////////////////////////////////////
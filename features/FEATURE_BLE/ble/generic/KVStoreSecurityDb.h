@@ -0,0 +1,167 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GENERIC_KVSTORE_SECURITY_DB_H_
+#define GENERIC_KVSTORE_SECURITY_DB_H_
+
+#if MBED_CONF_BLE_SECURITY_DB_KVSTORE
+
+#include "SecurityDb.h"
+
+#ifndef MBED_CONF_BLE_SECURITY_DB_MAX_ENTRIES
+#define MBED_CONF_BLE_SECURITY_DB_MAX_ENTRIES 5
+#endif
+
+namespace ble {
+namespace generic {
+
+/**
+ * KVStore implementation.
+ *
+ * Entries are held in RAM and each one is stored under its own key of the
+ * global KVStore. Changes are only written when an entry is synced, with a
+ * single write per modified entry.
+ */
+class KVStoreSecurityDb : public SecurityDb {
+private:
+    struct entry_t {
+        entry_t() : dirty(false) { };
+        SecurityDistributionFlags_t flags;
+        SecurityEntryKeys_t local_keys;
+        SecurityEntryKeys_t peer_keys;
+        SecurityEntryIdentity_t peer_identity;
+        SecurityEntrySigning_t peer_signing;
+        /* flags as they are in the store */
+        SecurityDistributionFlags_t synced_flags;
+        /* keys, identity or sign counter not written yet */
+        bool dirty;
+    };
+
+    struct local_store_t {
+        uint16_t version;
+        bool restore;
+        SecurityEntryIdentity_t identity;
+        csrk_t csrk;
+        sign_count_t sign_counter;
+    };
+
+    static const size_t MAX_ENTRIES = MBED_CONF_BLE_SECURITY_DB_MAX_ENTRIES;
+
+    static entry_t* as_entry(entry_handle_t db_handle)
+    {
+        return reinterpret_cast<entry_t*>(db_handle);
+    }
+
+public:
+    KVStoreSecurityDb();
+    virtual ~KVStoreSecurityDb();
+
+    virtual SecurityDistributionFlags_t* get_distribution_flags(
+        entry_handle_t db_handle
+    );
+
+    /* local keys */
+
+    /* set */
+    virtual void set_entry_local_ltk(
+        entry_handle_t db_handle,
+        const ltk_t &ltk
+    );
+
+    virtual void set_entry_local_ediv_rand(
+        entry_handle_t db_handle,
+        const ediv_t &ediv,
+        const rand_t &rand
+    );
+
+    /* peer's keys */
+
+    /* set */
+
+    virtual void set_entry_peer_ltk(
+        entry_handle_t db_handle,
+        const ltk_t &ltk
+    );
+
+    virtual void set_entry_peer_ediv_rand(
+        entry_handle_t db_handle,
+        const ediv_t &ediv,
+        const rand_t &rand
+    );
+
+    virtual void set_entry_peer_irk(
+        entry_handle_t db_handle,
+        const irk_t &irk
+    );
+
+    virtual void set_entry_peer_bdaddr(
+        entry_handle_t db_handle,
+        bool address_is_public,
+        const address_t &peer_address
+    );
+
+    virtual void set_entry_peer_csrk(
+        entry_handle_t db_handle,
+        const csrk_t &csrk
+    );
+
+    virtual void set_entry_peer_sign_counter(
+        entry_handle_t db_handle,
+        sign_count_t sign_counter
+    );
+
+    /* local csrk */
+
+    virtual void set_local_csrk(const csrk_t &csrk);
+
+    virtual void set_local_sign_counter(sign_count_t sign_counter);
+
+    /* saving and loading from nvm */
+
+    virtual void restore();
+
+    virtual void sync(entry_handle_t db_handle);
+
+    virtual void set_restore(bool reload);
+
+private:
+    virtual uint8_t get_entry_count();
+
+    virtual SecurityDistributionFlags_t* get_entry_handle_by_index(uint8_t index);
+
+    virtual void reset_entry(entry_handle_t db_handle);
+
+    virtual SecurityEntryIdentity_t* read_in_entry_peer_identity(entry_handle_t db_handle);
+    virtual SecurityEntryKeys_t* read_in_entry_peer_keys(entry_handle_t db_handle);
+    virtual SecurityEntryKeys_t* read_in_entry_local_keys(entry_handle_t db_handle);
+    virtual SecurityEntrySigning_t* read_in_entry_peer_signing(entry_handle_t db_handle);
+
+    void write_local();
+
+    static void get_entry_key(char *key, size_t index);
+
+private:
+    entry_t _entries[MAX_ENTRIES];
+    bool _restore;
+    bool _local_dirty;
+};
+
+} /* namespace generic */
+} /* namespace ble */
+
+#endif // MBED_CONF_BLE_SECURITY_DB_KVSTORE
+
+#endif /*GENERIC_KVSTORE_SECURITY_DB_H_*/
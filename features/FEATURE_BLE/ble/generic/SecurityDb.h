@@ -513,6 +513,37 @@ public:
         return NULL;
     }
 
+    /**
+     * Find the identity of a peer from a resolvable private address.
+     *
+     * @param[in] address resolvable private address.
+     * @param[in] resolves function checking if an address has been generated
+     * with an IRK.
+     *
+     * @return The identity of the peer or NULL if no IRK stored resolves
+     * the address.
+     */
+    virtual SecurityEntryIdentity_t* find_identity_by_private_address(
+        const address_t &address,
+        bool (*resolves)(const address_t &address, const irk_t &irk)
+    ) {
+        for (size_t i = 0; i < get_entry_count(); i++) {
+            entry_handle_t db_handle = get_entry_handle_by_index(i);
+            SecurityDistributionFlags_t* flags = get_distribution_flags(db_handle);
+
+            if (!flags || !flags->irk_stored) {
+                continue;
+            }
+
+            SecurityEntryIdentity_t* identity = read_in_entry_peer_identity(db_handle);
+            if (identity && resolves(address, identity->irk)) {
+                return identity;
+            }
+        }
+
+        return NULL;
+    }
+
     /**
      * Close a connection entry.
      *
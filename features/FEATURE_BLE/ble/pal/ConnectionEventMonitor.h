@@ -81,6 +81,28 @@ public:
     ) {
         self()->on_disconnected_(connection, reason);
     }
+
+    /**
+     * Find the identity of a peer advertising with a resolvable private
+     * address the LE subsystem could not resolve. Called by GAP.
+     *
+     * @param[in] address Resolvable private address.
+     * @param[out] identity_address_is_public Type of the identity address.
+     * @param[out] identity_address Identity address of the peer.
+     *
+     * @return true if the address belongs to a bonded peer.
+     */
+    bool resolve_private_address(
+        const address_t &address,
+        bool &identity_address_is_public,
+        address_t &identity_address
+    ) {
+        return self()->resolve_private_address_(
+            address,
+            identity_address_is_public,
+            identity_address
+        );
+    }
 };
 
 
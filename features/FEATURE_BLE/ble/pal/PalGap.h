@@ -1957,6 +1957,31 @@ public:
         );
     }
 
+    /**
+     * Suggest the maximum transmission payload and time for a connection.
+     *
+     * The controller negotiates the values with the peer, the result is
+     * reported by EventHandler::on_data_length_change.
+     *
+     * @param connection Handle of the connection to update.
+     * @param tx_octets Preferred maximum number of payload octets in a packet,
+     * from 27 to 251.
+     * @param tx_time Preferred maximum transmission time of a packet in
+     * microseconds, from 328 to 17040.
+     *
+     * @return BLE_ERROR_NONE if the request has been successfully sent or the
+     * appropriate error otherwise.
+     *
+     * @note: See Bluetooth 5 Vol 2 PartE: 7.8.33 LE Set Data Length command.
+     */
+    ble_error_t set_data_length(
+        connection_handle_t connection,
+        uint16_t tx_octets,
+        uint16_t tx_time
+    ) {
+        return impl()->set_data_length_(connection, tx_octets, tx_time);
+    }
+
     /**
      * Register a callback which will handle Gap events.
      *
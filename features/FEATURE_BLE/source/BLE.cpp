@@ -281,6 +281,19 @@ SecurityManager& BLE::securityManager()
 
 #endif // BLE_FEATURE_SECURITY
 
+#if BLE_FEATURE_L2CAP_COC
+
+ble::L2cap& BLE::l2cap()
+{
+    if (!transport) {
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_BLE, MBED_ERROR_CODE_BLE_BACKEND_NOT_INITIALIZED), "bad handle to underlying transport");
+    }
+
+    return transport->getL2cap();
+}
+
+#endif // BLE_FEATURE_L2CAP_COC
+
 void BLE::waitForEvent(void)
 {
     if (!transport) {
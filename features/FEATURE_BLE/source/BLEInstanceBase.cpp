@@ -26,3 +26,16 @@ void BLEInstanceBase::signalEventsToProcess(BLE::InstanceID_t id)
 {
     BLE::Instance(id).signalEventsToProcess();
 }
+
+#if BLE_FEATURE_L2CAP_COC
+namespace {
+class UnsupportedL2cap : public ble::L2cap {
+};
+}
+
+ble::L2cap &BLEInstanceBase::getL2cap(void)
+{
+    static UnsupportedL2cap l2cap;
+    return l2cap;
+}
+#endif // BLE_FEATURE_L2CAP_COC
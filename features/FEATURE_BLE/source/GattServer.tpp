@@ -85,6 +85,15 @@ ble_error_t GattServer<Impl>::write(
     );
 }
 
+template<class Impl>
+ble_error_t GattServer<Impl>::write(
+    const AttributeUpdate *updates,
+    size_t count,
+    bool localOnly
+) {
+    return impl()->writeUpdates_(updates, count, localOnly);
+}
+
 template<class Impl>
 ble_error_t GattServer<Impl>::areUpdatesEnabled(
     const GattCharacteristic &characteristic,
@@ -182,6 +191,27 @@ ble_error_t GattServer<Impl>::write_(
     return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+template<class Impl>
+ble_error_t GattServer<Impl>::writeUpdates_(
+    const AttributeUpdate *updates,
+    size_t count,
+    bool localOnly
+) {
+    // Ports without a batched implementation write the attributes one by one
+    for (size_t i = 0; i < count; i++) {
+        ble_error_t err = impl()->write_(
+            updates[i].handle,
+            updates[i].value,
+            updates[i].size,
+            localOnly
+        );
+        if (err != BLE_ERROR_NONE) {
+            return err;
+        }
+    }
+    return BLE_ERROR_NONE;
+}
+
 template<class Impl>
 ble_error_t GattServer<Impl>::areUpdatesEnabled_(
     const GattCharacteristic &characteristic,
@@ -210,6 +210,12 @@ ble_error_t Gap<Impl>::stopScan()
 {
     return impl()->stopScan_();
 }
+
+template<class Impl>
+ble_error_t Gap<Impl>::setAdvertisingReportFilter(const AdvertisingReportFilter *filter)
+{
+    return impl()->setAdvertisingReportFilter_(filter);
+}
 #endif // BLE_ROLE_OBSERVER
 #if BLE_FEATURE_PERIODIC_ADVERTISING
 template<class Impl>
@@ -383,6 +389,47 @@ ble_error_t Gap<Impl>::disconnect(
 {
     return impl()->disconnect_(connectionHandle, reason);
 }
+
+template<class Impl>
+ble_error_t Gap<Impl>::requestHighThroughput(connection_handle_t connectionHandle)
+{
+    return impl()->requestHighThroughput_(connectionHandle);
+}
+
+template<class Impl>
+uint32_t Gap<Impl>::getPayloadPerConnectionEvent(
+    uint16_t attMtu,
+    uint16_t txOctets,
+    phy_t phy,
+    conn_event_length_t eventLength
+)
+{
+    if (attMtu <= 3 || txOctets == 0) {
+        return 0;
+    }
+
+    // Air time of a packet in us: fixed part (preamble, access address,
+    // header, MIC and CRC) plus the time per payload octet. The coded PHY
+    // figures are for S=8.
+    uint32_t fixed_time = 14 * 8;
+    uint32_t octet_time = 8;
+    if (phy == phy_t::LE_2M) {
+        fixed_time = 15 * 4;
+        octet_time = 4;
+    } else if (phy == phy_t::LE_CODED) {
+        fixed_time = 976;
+        octet_time = 64;
+    }
+
+    // Data packet, inter frame space, empty acknowledgement, inter frame space
+    uint32_t exchange_time = fixed_time + octet_time * txOctets + 150 + fixed_time + 150;
+    uint32_t packets = ((uint32_t) eventLength.value() * conn_event_length_t::TIME_BASE) / exchange_time;
+
+    // Each ATT PDU is carried in an L2CAP frame with a 4 bytes header
+    uint32_t packets_per_pdu = (attMtu + 4 + txOctets - 1) / txOctets;
+
+    return (packets / packets_per_pdu) * (attMtu - 3);
+}
 #endif // BLE_FEATURE_CONNECTABLE
 
 #if BLE_FEATURE_PHY_MANAGEMENT
@@ -652,6 +699,12 @@ ble_error_t Gap<Impl>::stopScan_()
     return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+template<class Impl>
+ble_error_t Gap<Impl>::setAdvertisingReportFilter_(const AdvertisingReportFilter *filter)
+{
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
 template<class Impl>
 ble_error_t Gap<Impl>::createSync_(
     peer_address_type_t peerAddressType,
@@ -787,6 +840,12 @@ ble_error_t Gap<Impl>::disconnect_(
     return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+template<class Impl>
+ble_error_t Gap<Impl>::requestHighThroughput_(connection_handle_t connectionHandle)
+{
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
 template<class Impl>
 ble_error_t Gap<Impl>::readPhy_(connection_handle_t connection)
 {
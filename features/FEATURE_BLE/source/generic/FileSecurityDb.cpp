@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <string.h>
 #include "FileSecurityDb.h"
 
 namespace ble {
@@ -72,6 +73,9 @@ FileSecurityDb::FileSecurityDb(FILE *db_file)
       _db_file(db_file) {
     /* init the offset in entries so they point to file positions */
     for (size_t i = 0; i < get_entry_count(); i++) {
+        _entries[i].peer_sign_counter = 0;
+        _entries[i].peer_identity = SecurityEntryIdentity_t();
+        _entries[i].dirty = false;
         _entries[i].file_offset = DB_OFFSET_STORES + i * DB_SIZE_STORE;
     }
 }
@@ -223,8 +227,8 @@ void FileSecurityDb::set_entry_peer_irk(
     }
 
     entry->flags.irk_stored = true;
-
-    db_write(&irk, entry->file_offset + DB_STORE_OFFSET_PEER_IDENTITY_IRK);
+    entry->peer_identity.irk = irk;
+    entry->dirty = true;
 }
 
 void FileSecurityDb::set_entry_peer_bdaddr(
@@ -237,8 +241,9 @@ void FileSecurityDb::set_entry_peer_bdaddr(
         return;
     }
 
-    db_write(&peer_address, entry->file_offset + DB_STORE_OFFSET_PEER_IDENTITY_ADDRESS);
-    db_write(&address_is_public, entry->file_offset + DB_STORE_OFFSET_PEER_IDENTITY_ADDRESS_IS_PUBLIC);
+    entry->peer_identity.identity_address = peer_address;
+    entry->peer_identity.identity_address_is_public = address_is_public;
+    entry->dirty = true;
 }
 
 void FileSecurityDb::set_entry_peer_csrk(
@@ -262,6 +267,7 @@ void FileSecurityDb::set_entry_peer_sign_counter(
     entry_t *entry = as_entry(db_handle);
     if (entry) {
         entry->peer_sign_counter = sign_counter;
+        entry->dirty = true;
     }
 }
 
@@ -283,10 +289,14 @@ void FileSecurityDb::restore() {
     db_read(&_local_csrk, DB_OFFSET_LOCAL_CSRK);
     db_read(&_local_sign_counter, DB_OFFSET_LOCAL_SIGN_COUNT);
 
-    /* read flags and sign counters */
+    /* read flags, sign counters and identities */
     for (size_t i = 0; i < get_entry_count(); i++) {
-        db_read(&_entries[i].flags, _entries[i].file_offset + DB_STORE_OFFSET_FLAGS);
-        db_read(&_entries[i].peer_sign_counter, _entries[i].file_offset + DB_STORE_OFFSET_PEER_SIGNING_COUNT);
+        entry_t &entry = _entries[i];
+        db_read(&entry.flags, entry.file_offset + DB_STORE_OFFSET_FLAGS);
+        db_read(&entry.peer_sign_counter, entry.file_offset + DB_STORE_OFFSET_PEER_SIGNING_COUNT);
+        db_read(&entry.peer_identity, entry.file_offset + DB_STORE_OFFSET_PEER_IDENTITY);
+        entry.synced_flags = entry.flags;
+        entry.dirty = false;
     }
 
 }
@@ -297,8 +307,25 @@ void FileSecurityDb::sync(entry_handle_t db_handle) {
         return;
     }
 
-    db_write(&entry->peer_sign_counter, entry->file_offset + DB_STORE_OFFSET_PEER_SIGNING_COUNT);
+    /* flags are modified in place by the security manager, compare them
+     * with the file content to avoid rewriting an unchanged entry */
+    bool flags_changed = memcmp(
+        &entry->flags, &entry->synced_flags, sizeof(SecurityDistributionFlags_t)
+    ) != 0;
+
+    if (!entry->dirty && !flags_changed) {
+        return;
+    }
+
+    if (entry->dirty) {
+        db_write(&entry->peer_identity, entry->file_offset + DB_STORE_OFFSET_PEER_IDENTITY);
+        db_write(&entry->peer_sign_counter, entry->file_offset + DB_STORE_OFFSET_PEER_SIGNING_COUNT);
+    }
     db_write(&entry->flags, entry->file_offset + DB_STORE_OFFSET_FLAGS);
+    fflush(_db_file);
+
+    entry->synced_flags = entry->flags;
+    entry->dirty = false;
 }
 
 void FileSecurityDb::set_restore(bool reload) {
@@ -334,6 +361,9 @@ void FileSecurityDb::reset_entry(entry_handle_t db_entry) {
 
     entry->flags = SecurityDistributionFlags_t();
     entry->peer_sign_counter = 0;
+    entry->peer_identity = SecurityEntryIdentity_t();
+    entry->synced_flags = entry->flags;
+    entry->dirty = false;
 }
 
 SecurityEntryIdentity_t* FileSecurityDb::read_in_entry_peer_identity(entry_handle_t db_entry) {
@@ -342,10 +372,7 @@ SecurityEntryIdentity_t* FileSecurityDb::read_in_entry_peer_identity(entry_handl
         return NULL;
     }
 
-    SecurityEntryIdentity_t* identity = reinterpret_cast<SecurityEntryIdentity_t*>(_buffer);
-    db_read(identity, entry->file_offset + DB_STORE_OFFSET_PEER_IDENTITY);
-
-    return identity;
+    return &entry->peer_identity;
 };
 
 SecurityEntryKeys_t* FileSecurityDb::read_in_entry_peer_keys(entry_handle_t db_entry) {
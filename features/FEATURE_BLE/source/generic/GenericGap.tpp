@@ -444,7 +444,12 @@ GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::
     _scan_timeout(),
     _deprecated_scan_api_used(false),
     _non_deprecated_scan_api_used(false),
-    _user_manage_connection_parameter_requests(false)
+    _user_manage_connection_parameter_requests(false),
+    _report_filter(),
+    _report_filter_enabled(false),
+    _report_filter_timer(),
+    _report_cache(),
+    _report_cache_next(0)
 {
     _pal_gap.initialize();
 
@@ -598,6 +603,92 @@ ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEve
     return BLE_ERROR_NONE;
 }
 
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::setAdvertisingReportFilter_(
+    const AdvertisingReportFilter *filter
+)
+{
+    if (filter) {
+        _report_filter = *filter;
+        _report_filter_enabled = true;
+        _report_filter_timer.start();
+    } else {
+        _report_filter_enabled = false;
+        _report_filter_timer.stop();
+    }
+
+    clear_report_cache();
+
+    return BLE_ERROR_NONE;
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::clear_report_cache()
+{
+    for (size_t i = 0; i < MBED_CONF_BLE_GAP_REPORT_CACHE_SIZE; ++i) {
+        _report_cache[i].used = false;
+    }
+    _report_cache_next = 0;
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+bool GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::accept_advertising_report(
+    peer_address_type_t address_type,
+    const ble::address_t &address,
+    rssi_t rssi,
+    mbed::Span<const uint8_t> data
+)
+{
+    if (!_report_filter_enabled) {
+        return true;
+    }
+
+    if (!_report_filter.matches(rssi, data)) {
+        return false;
+    }
+
+    uint32_t window = _report_filter.getDuplicateWindow().value();
+    if (window == 0) {
+        return true;
+    }
+
+    // FNV-1a, collisions only cost a dropped report
+    uint32_t hash = 2166136261UL;
+    for (ptrdiff_t i = 0; i < data.size(); ++i) {
+        hash = (hash ^ data[i]) * 16777619UL;
+    }
+
+    uint32_t now = _report_filter_timer.read_ms();
+
+    for (size_t i = 0; i < MBED_CONF_BLE_GAP_REPORT_CACHE_SIZE; ++i) {
+        report_cache_entry_t &entry = _report_cache[i];
+        if (!entry.used ||
+            entry.address_type != address_type.value() ||
+            entry.address != address) {
+            continue;
+        }
+
+        if (entry.data_hash == hash && (uint32_t)(now - entry.time) < window) {
+            return false;
+        }
+
+        entry.data_hash = hash;
+        entry.time = now;
+        return true;
+    }
+
+    // Unknown peer, replace the oldest entry
+    report_cache_entry_t &entry = _report_cache[_report_cache_next];
+    _report_cache_next = (_report_cache_next + 1) % MBED_CONF_BLE_GAP_REPORT_CACHE_SIZE;
+    entry.address = address;
+    entry.address_type = address_type.value();
+    entry.data_hash = hash;
+    entry.time = now;
+    entry.used = true;
+
+    return true;
+}
+
 template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
 ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::connect_(
     const BLEProtocol::AddressBytes_t peerAddr,
@@ -828,6 +919,47 @@ ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEve
     return _pal_gap.cancel_connection_creation();
 }
 
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::requestHighThroughput_(
+    connection_handle_t connectionHandle
+)
+{
+    bool data_length_extension = _pal_gap.is_feature_supported(
+        controller_supported_features_t::LE_DATA_PACKET_LENGTH_EXTENSION
+    );
+    bool phy_2m = false;
+#if BLE_FEATURE_PHY_MANAGEMENT
+    phy_2m = _pal_gap.is_feature_supported(controller_supported_features_t::LE_2M_PHY);
+#endif
+
+    if (!data_length_extension && !phy_2m) {
+        return BLE_ERROR_NOT_IMPLEMENTED;
+    }
+
+    if (data_length_extension) {
+        // Longest packet and the time it takes at 1M, the controller
+        // shortens the time if the PHY is faster.
+        ble_error_t err = _pal_gap.set_data_length(connectionHandle, 251, 2120);
+        if (err) {
+            return err;
+        }
+    }
+
+#if BLE_FEATURE_PHY_MANAGEMENT
+    if (phy_2m) {
+        phy_set_t phys(phy_t::LE_2M);
+        return _pal_gap.set_phy(
+            connectionHandle,
+            phys,
+            phys,
+            coded_symbol_per_bit_t::UNDEFINED
+        );
+    }
+#endif
+
+    return BLE_ERROR_NONE;
+}
+
 template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
 ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::readPhy_(Handle_t connection)
 {
@@ -1713,22 +1845,26 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
     for (size_t i = 0; i < e.size(); ++i) {
         pal::GapAdvertisingReportEvent::advertising_t advertising = e[i];
 
+        // note 1-to-1 conversion between connection_peer_address_type_t and
+        // peer_address_type_t
+        peer_address_type_t peer_address_type =
+            static_cast<peer_address_type_t::type>(advertising.address_type.value());
+
 #if BLE_FEATURE_PRIVACY
-        // Check if the address hasn't been resolved
-        if (_privacy_enabled &&
-            _central_privacy_configuration.resolution_strategy == CentralPrivacyConfiguration_t::RESOLVE_AND_FILTER &&
-            advertising.address_type == pal::connection_peer_address_type_t::RANDOM_ADDRESS &&
-            is_random_private_resolvable_address(advertising.address.data())
-            ) {
+        if (!resolve_advertising_address(peer_address_type, advertising.address)) {
             // Filter it out
             continue;
         }
 #endif // BLE_FEATURE_PRIVACY
 
-        // note 1-to-1 conversion between connection_peer_address_type_t and
-        // peer_address_type_t
-        peer_address_type_t peer_address_type =
-            static_cast<peer_address_type_t::type>(advertising.address_type.value());
+        if (!accept_advertising_report(
+            peer_address_type,
+            advertising.address,
+            advertising.rssi,
+            Span<const uint8_t>(advertising.data.data(), advertising.data.size())
+        )) {
+            continue;
+        }
 
         // report in new event handler
         if (_eventHandler) {
@@ -2085,6 +2221,43 @@ ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEve
     return _pal_gap.set_address_resolution(enable);
 }
 
+#if BLE_FEATURE_PRIVACY
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+bool GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::resolve_advertising_address(
+    peer_address_type_t &address_type,
+    ble::address_t &address
+)
+{
+    // Addresses resolved by the controller are reported as identities
+    if (!_privacy_enabled ||
+        _central_privacy_configuration.resolution_strategy == CentralPrivacyConfiguration_t::DO_NOT_RESOLVE ||
+        address_type != peer_address_type_t::RANDOM ||
+        !is_random_private_resolvable_address(address.data())
+    ) {
+        return true;
+    }
+
+    // Bonds which do not fit in the resolving list are resolved by the host
+    bool identity_address_is_public = false;
+    ble::address_t identity_address;
+    if (_connection_event_handler &&
+        _connection_event_handler->resolve_private_address(
+            address,
+            identity_address_is_public,
+            identity_address
+        )
+    ) {
+        address_type = identity_address_is_public ?
+            peer_address_type_t::PUBLIC_IDENTITY :
+            peer_address_type_t::RANDOM_STATIC_IDENTITY;
+        address = identity_address;
+        return true;
+    }
+
+    return _central_privacy_configuration.resolution_strategy != CentralPrivacyConfiguration_t::RESOLVE_AND_FILTER;
+}
+#endif // BLE_FEATURE_PRIVACY
+
 template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
 void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::set_random_address_rotation(bool enable)
 {
@@ -2940,18 +3113,26 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
     const uint8_t *data
 )
 {
+    peer_address_type_t peer_address_type = address_type ?
+        (peer_address_type_t::type) address_type->value() :
+        peer_address_type_t::ANONYMOUS;
+    ble::address_t peer_address = address;
+
 #if BLE_FEATURE_PRIVACY
-    // Check if the address hasn't been resolved
-    if (_privacy_enabled &&
-        _central_privacy_configuration.resolution_strategy == CentralPrivacyConfiguration_t::RESOLVE_AND_FILTER &&
-        address_type != NULL &&
-        *address_type == pal::connection_peer_address_type_t::RANDOM_ADDRESS &&
-        is_random_private_resolvable_address(address.data())
-    ) {
+    if (!resolve_advertising_address(peer_address_type, peer_address)) {
         return;
     }
 #endif // BLE_FEATURE_PRIVACY
 
+    if (!accept_advertising_report(
+        peer_address_type,
+        peer_address,
+        rssi,
+        make_Span(data, data_length)
+    )) {
+        return;
+    }
+
     if (_deprecated_scan_api_used == false) {
         // report in new event handler
         if (!_eventHandler) {
@@ -2960,10 +3141,8 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
         _eventHandler->onAdvertisingReport(
             AdvertisingReportEvent(
                 event_type,
-                address_type ?
-                    (peer_address_type_t::type) address_type->value() :
-                    peer_address_type_t::ANONYMOUS,
-                (BLEProtocol::AddressBytes_t &) address,
+                peer_address_type,
+                (BLEProtocol::AddressBytes_t &) peer_address,
                 primary_phy,
                 secondary_phy ? *secondary_phy : phy_t::NONE,
                 advertising_sid,
@@ -3001,13 +3180,13 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
         // and use extended scan with V1 API.
         BLE_DEPRECATED_API_USE_BEGIN()
         LegacyGap::processAdvertisementReport(
-            address.data(),
+            peer_address.data(),
             rssi,
             event_type.scan_response(),
             advertising_type,
             data_length,
             data,
-            (peer_address_type_t::type) address_type->value()
+            peer_address_type
         );
         BLE_DEPRECATED_API_USE_END()
     }
@@ -3242,6 +3421,9 @@ ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEve
 {
     useVersionTwoAPI();
 
+    // Reports received during the previous scan are not duplicates
+    clear_report_cache();
+
 #if BLE_FEATURE_PRIVACY
     if (_privacy_enabled && _central_privacy_configuration.use_non_resolvable_random_address) {
         set_random_address_rotation(true);
@@ -30,6 +30,14 @@
 #include "ble/BLEInstanceBase.h"
 #include <algorithm>
 
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+#include <string.h>
+#include "kvstore_global_api.h"
+
+#define GATT_CLIENT_CACHE_STR_EXPAND(tok) #tok
+#define GATT_CLIENT_CACHE_STR(tok) GATT_CLIENT_CACHE_STR_EXPAND(tok)
+#endif
+
 using ble::pal::AttServerMessage;
 using ble::pal::AttReadResponse;
 using ble::pal::AttReadBlobResponse;
@@ -49,6 +57,8 @@ using ble::pal::AttFindInformationResponse;
 #define WRITE_HEADER_LENGTH 3
 #define CMAC_LENGTH 8
 #define MAC_COUNTER_LENGTH 4
+#define DATABASE_HASH_CHARACTERISTIC_UUID 0x2B2A
+#define DATABASE_HASH_LENGTH 16
 
 namespace ble {
 namespace generic {
@@ -117,7 +127,15 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		matching_service_uuid(matching_service_uuid),
 		matching_characteristic_uuid(matching_characteristic_uuid),
 		services_discovered(NULL),
-		done(false) {
+		done(false)
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+		, reading_hash(false),
+		recording(false),
+		records(NULL),
+		record_count(0),
+		record_capacity(0)
+#endif
+	{
 	}
 
 	virtual ~DiscoveryControlBlock() {
@@ -126,6 +144,42 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 			delete services_discovered;
 			services_discovered = tmp;
 		}
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+		free(records);
+#endif
+	}
+
+	/*
+	 * Send the first request of the procedure.
+	 */
+	ble_error_t start(GenericGattClient* client) {
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+		// The Database Hash changes with the attribute layout of the server,
+		// read it first to find out if the discovery can be restored.
+		reading_hash = true;
+		return client->_pal_client->read_using_characteristic_uuid(
+			connection_handle,
+			attribute_handle_range(0x0001, 0xFFFF),
+			UUID(DATABASE_HASH_CHARACTERISTIC_UUID)
+		);
+#else
+		return start_service_discovery(client);
+#endif
+	}
+
+	ble_error_t start_service_discovery(GenericGattClient* client) {
+		if (matching_service_uuid == UUID()) {
+			return client->_pal_client->discover_primary_service(
+				connection_handle,
+				0x0001
+			);
+		} else {
+			return client->_pal_client->discover_primary_service_by_service_uuid(
+				connection_handle,
+				0x0001,
+				matching_service_uuid
+			);
+		}
 	}
 
 	virtual void handle_timeout_error(GenericGattClient* client) {
@@ -143,6 +197,13 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 			return;
 		}
 
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+		if (reading_hash) {
+			handle_database_hash(client, message);
+			return;
+		}
+#endif
+
 		switch(message.opcode) {
 			case AttributeOpcode::READ_BY_GROUP_TYPE_RESPONSE:
 				handle_service_discovered(
@@ -250,6 +311,10 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 			service_callback(&discovered_service);
 		}
 
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+		record_service(services_discovered);
+#endif
+
 		last_characteristic = characteristic_t();
 		client->_pal_client->discover_characteristics_of_a_service(
 			connection_handle,
@@ -264,6 +329,9 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		for (size_t i = 0; i < response.size(); ++i) {
 			if (last_characteristic.is_valid() == false) {
 				last_characteristic.set_last_handle(response[i].handle - 1);
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+				record_characteristic(last_characteristic);
+#endif
 				if (matching_characteristic_uuid == UUID()
 				|| last_characteristic.getUUID() == matching_characteristic_uuid) {
 					characteristic_callback(&last_characteristic);
@@ -295,9 +363,12 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 
 	void handle_all_characteristics_discovered(GenericGattClient* client) {
 		if (last_characteristic.is_valid() == false) {
+			last_characteristic.set_last_handle(services_discovered->end);
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+			record_characteristic(last_characteristic);
+#endif
 			if (matching_characteristic_uuid == UUID()
 				|| matching_characteristic_uuid == last_characteristic.getUUID()) {
-				last_characteristic.set_last_handle(services_discovered->end);
 				characteristic_callback(&last_characteristic);
 			}
 		}
@@ -307,6 +378,9 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		delete old;
 
 		if (!services_discovered) {
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+			store_records();
+#endif
 			terminate(client);
 		} else {
 			start_characteristic_discovery(client);
@@ -358,11 +432,76 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		service_t* next;
 	};
 
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+	/*
+	 * Service or characteristic as stored in the attribute cache.
+	 */
+	struct cache_entry_t {
+		enum {
+			SERVICE,
+			CHARACTERISTIC
+		};
+
+		uint8_t type;
+		uint8_t properties;
+		uint16_t begin;
+		uint16_t end;
+		uint16_t value_handle;
+		uint8_t uuid_length;
+		uint8_t uuid[UUID::LENGTH_OF_LONG_UUID];
+
+		void set_uuid(const UUID& value) {
+			if (value.shortOrLong() == UUID::UUID_TYPE_SHORT) {
+				uuid[0] = value.getShortUUID() & 0xFF;
+				uuid[1] = value.getShortUUID() >> 8;
+				uuid_length = sizeof(UUID::ShortUUIDBytes_t);
+			} else {
+				memcpy(uuid, value.getBaseUUID(), UUID::LENGTH_OF_LONG_UUID);
+				uuid_length = UUID::LENGTH_OF_LONG_UUID;
+			}
+		}
+
+		UUID get_uuid() const {
+			if (uuid_length == sizeof(UUID::ShortUUIDBytes_t)) {
+				return UUID(uuid[0] | (uuid[1] << 8));
+			} else {
+				return UUID(uuid, UUID::MSB);
+			}
+		}
+	};
+#endif
+
 	struct characteristic_t : DiscoveredCharacteristic {
 		characteristic_t() : DiscoveredCharacteristic() {
 			lastHandle = 0x0001;
 		}
 
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+		characteristic_t(
+			GattClient* client,
+			connection_handle_t connection_handle,
+			const cache_entry_t& entry
+		) : DiscoveredCharacteristic() {
+			gattc = client;
+			uuid = entry.get_uuid();
+			props = get_properties(entry.properties);
+			declHandle = entry.begin;
+			valueHandle = entry.value_handle;
+			lastHandle = entry.end;
+			connHandle = connection_handle;
+		}
+
+		uint8_t get_raw_properties() const {
+			return (props.broadcast() << 0) |
+				(props.read() << 1) |
+				(props.writeWoResp() << 2) |
+				(props.write() << 3) |
+				(props.notify() << 4) |
+				(props.indicate() << 5) |
+				(props.authSignedWrite() << 6);
+		}
+#endif
+
 		characteristic_t(
 			GattClient* client,
 			connection_handle_t connection_handle,
@@ -387,7 +526,10 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		}
 
 		static DiscoveredCharacteristic::Properties_t get_properties(const Span<const uint8_t>& value) {
-			uint8_t raw_properties = value[0];
+			return get_properties(value[0]);
+		}
+
+		static DiscoveredCharacteristic::Properties_t get_properties(uint8_t raw_properties) {
 			DiscoveredCharacteristic::Properties_t result;
 			result._broadcast = (raw_properties & (1 << 0)) ? true : false;
 			result._read = (raw_properties & (1 << 1)) ? true : false;
@@ -425,6 +567,156 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		current->next = service;
 	}
 
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+	void handle_database_hash(GenericGattClient* client, const AttServerMessage& message) {
+		reading_hash = false;
+
+		if (message.opcode == AttributeOpcode(AttributeOpcode::READ_BY_TYPE_RESPONSE)) {
+			const AttReadByTypeResponse& response =
+				static_cast<const AttReadByTypeResponse&>(message);
+			if (response.size() == 1 &&
+				response[0].value.size() == DATABASE_HASH_LENGTH) {
+				memcpy(database_hash, response[0].value.data(), DATABASE_HASH_LENGTH);
+
+				if (restore_records(client)) {
+					return;
+				}
+
+				// Only a complete discovery can be replayed for any request
+				if (characteristic_callback &&
+					matching_service_uuid == UUID() &&
+					matching_characteristic_uuid == UUID()) {
+					recording = true;
+				}
+			}
+		}
+
+		// servers without a Database Hash are discovered every time
+		if (start_service_discovery(client)) {
+			terminate(client);
+		}
+	}
+
+	/*
+	 * Report the services and characteristics stored for the database hash
+	 * read. Return false if there is no usable cache entry.
+	 */
+	bool restore_records(GenericGattClient* client) {
+		char key[cache_key_size];
+		get_cache_key(key);
+
+		kv_info_t info;
+		if (kv_get_info(key, &info) != MBED_SUCCESS ||
+			info.size == 0 ||
+			(info.size % sizeof(cache_entry_t))) {
+			return false;
+		}
+
+		cache_entry_t* entries = (cache_entry_t*) malloc(info.size);
+		if (entries == NULL) {
+			return false;
+		}
+
+		size_t size = 0;
+		if (kv_get(key, entries, info.size, &size) != MBED_SUCCESS || size != info.size) {
+			free(entries);
+			return false;
+		}
+
+		bool service_matched = false;
+		for (size_t i = 0; i < (size / sizeof(cache_entry_t)) && !done; ++i) {
+			const cache_entry_t& entry = entries[i];
+			if (entry.type == cache_entry_t::SERVICE) {
+				UUID uuid = entry.get_uuid();
+				service_matched = matching_service_uuid == UUID() ||
+					matching_service_uuid == uuid;
+				if (service_matched && service_callback) {
+					DiscoveredService discovered_service;
+					discovered_service.setup(uuid, entry.begin, entry.end);
+					service_callback(&discovered_service);
+				}
+			} else if (service_matched && characteristic_callback) {
+				characteristic_t characteristic(client, connection_handle, entry);
+				if (matching_characteristic_uuid == UUID()
+					|| matching_characteristic_uuid == characteristic.getUUID()) {
+					characteristic_callback(&characteristic);
+				}
+			}
+		}
+
+		free(entries);
+		terminate(client);
+		return true;
+	}
+
+	void record_service(const service_t* service) {
+		cache_entry_t entry;
+		memset(&entry, 0, sizeof(entry));
+		entry.type = cache_entry_t::SERVICE;
+		entry.begin = service->begin;
+		entry.end = service->end;
+		entry.set_uuid(service->uuid);
+		record(entry);
+	}
+
+	void record_characteristic(const characteristic_t& characteristic) {
+		cache_entry_t entry;
+		memset(&entry, 0, sizeof(entry));
+		entry.type = cache_entry_t::CHARACTERISTIC;
+		entry.properties = characteristic.get_raw_properties();
+		entry.begin = characteristic.getDeclHandle();
+		entry.end = characteristic.getLastHandle();
+		entry.value_handle = characteristic.getValueHandle();
+		entry.set_uuid(characteristic.getUUID());
+		record(entry);
+	}
+
+	void record(const cache_entry_t& entry) {
+		if (!recording) {
+			return;
+		}
+
+		if (record_count == record_capacity) {
+			size_t capacity = record_capacity ? record_capacity * 2 : 16;
+			cache_entry_t* new_records = (cache_entry_t*) realloc(
+				records, capacity * sizeof(cache_entry_t)
+			);
+			if (new_records == NULL) {
+				// the discovery goes on, it is just not cached
+				recording = false;
+				return;
+			}
+			records = new_records;
+			record_capacity = capacity;
+		}
+
+		records[record_count++] = entry;
+	}
+
+	void store_records() {
+		if (!recording || !record_count) {
+			return;
+		}
+
+		char key[cache_key_size];
+		get_cache_key(key);
+		kv_set(key, records, record_count * sizeof(cache_entry_t), 0);
+	}
+
+	void get_cache_key(char* key) {
+		int length = snprintf(
+			key,
+			cache_key_size,
+			"/" GATT_CLIENT_CACHE_STR(MBED_CONF_STORAGE_DEFAULT_KV) "/ble_db_"
+		);
+		for (size_t i = 0; i < DATABASE_HASH_LENGTH; ++i) {
+			length += snprintf(key + length, cache_key_size - length, "%02x", database_hash[i]);
+		}
+	}
+
+	static const size_t cache_key_size = 64;
+#endif
+
 	ServiceDiscovery::ServiceCallback_t service_callback;
 	ServiceDiscovery::CharacteristicCallback_t characteristic_callback;
 	UUID matching_service_uuid;
@@ -432,6 +724,14 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 	service_t* services_discovered;
 	characteristic_t last_characteristic;
 	bool done;
+#if MBED_CONF_BLE_GATT_CLIENT_CACHE
+	bool reading_hash;
+	bool recording;
+	uint8_t database_hash[DATABASE_HASH_LENGTH];
+	cache_entry_t* records;
+	size_t record_count;
+	size_t record_capacity;
+#endif
 };
 
 
@@ -1005,19 +1305,7 @@ ble_error_t GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::launc
 	insert_control_block(discovery_pcb);
 
 	// launch the request
-	ble_error_t err = BLE_ERROR_UNSPECIFIED;
-	if (matching_service_uuid == UUID()) {
-		err = _pal_client->discover_primary_service(
-			connection_handle,
-			0x0001
-		);
-	} else {
-		err = _pal_client->discover_primary_service_by_service_uuid(
-			connection_handle,
-			0x0001,
-			matching_service_uuid
-		);
-	}
+	ble_error_t err = discovery_pcb->start(this);
 
 	if (err) {
 		remove_control_block(discovery_pcb);
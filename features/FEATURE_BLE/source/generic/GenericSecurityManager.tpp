@@ -21,6 +21,19 @@
 #include "ble/generic/GenericSecurityManager.h"
 #include "ble/generic/MemorySecurityDb.h"
 #include "ble/generic/FileSecurityDb.h"
+#include "ble/generic/KVStoreSecurityDb.h"
+
+#if BLE_FEATURE_PRIVACY
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_AES_C)
+#include "mbedtls/aes.h"
+#endif
+#endif // BLE_FEATURE_PRIVACY
 
 using ble::pal::advertising_peer_address_type_t;
 using ble::pal::AuthenticationMask;
@@ -158,6 +171,7 @@ template<template<class> class TPalSecurityManager, template<class> class Signin
 ble_error_t GenericSecurityManager<TPalSecurityManager, SigningMonitor>::purgeAllBondingState_(void) {
     if (!_db) return BLE_ERROR_INITIALIZATION_INCOMPLETE;
     _db->clear_entries();
+    clear_resolution_cache();
     return BLE_ERROR_NONE;
 }
 
@@ -839,7 +853,11 @@ ble_error_t GenericSecurityManager<TPalSecurityManager, SigningMonitor>::init_da
     if (db_file) {
         _db = new (std::nothrow) FileSecurityDb(db_file);
     } else {
+#if MBED_CONF_BLE_SECURITY_DB_KVSTORE
+        _db = new (std::nothrow) KVStoreSecurityDb();
+#else
         _db = new (std::nothrow) MemorySecurityDb();
+#endif
     }
 
     if (!_db) {
@@ -847,6 +865,7 @@ ble_error_t GenericSecurityManager<TPalSecurityManager, SigningMonitor>::init_da
     }
 
     _db->restore();
+    clear_resolution_cache();
 
     return BLE_ERROR_NONE;
 }
@@ -1175,6 +1194,9 @@ void GenericSecurityManager<TPalSecurityManager, SigningMonitor>::on_security_en
 
     typedef advertising_peer_address_type_t address_type_t;
 #if BLE_FEATURE_PRIVACY
+    /* addresses of the new bond may have been cached as unresolved */
+    clear_resolution_cache();
+
     _pal.add_device_to_resolving_list(
         identity->identity_address_is_public ?
             address_type_t::PUBLIC :
@@ -1206,6 +1228,96 @@ void GenericSecurityManager<TPalSecurityManager, SigningMonitor>::on_identity_li
     delete [] identity_list.data();
 }
 
+template<template<class> class TPalSecurityManager, template<class> class SigningMonitor>
+bool GenericSecurityManager<TPalSecurityManager, SigningMonitor>::resolve_private_address_(
+    const address_t &address,
+    bool &identity_address_is_public,
+    address_t &identity_address
+) {
+#if BLE_FEATURE_PRIVACY
+    if (!_db) {
+        return false;
+    }
+
+    for (size_t i = 0; i < MBED_CONF_BLE_PRIVATE_ADDRESS_CACHE_SIZE; ++i) {
+        const resolution_cache_entry_t &entry = _resolution_cache[i];
+        if (entry.used && entry.private_address == address) {
+            if (entry.resolved) {
+                identity_address_is_public = entry.identity_address_is_public;
+                identity_address = entry.identity_address;
+            }
+            return entry.resolved;
+        }
+    }
+
+    /* peers in the resolving list never reach this point, only bonds which
+     * did not fit in it are tried in software */
+    SecurityEntryIdentity_t *identity = _db->find_identity_by_private_address(
+        address,
+        &GenericSecurityManager::private_address_resolves
+    );
+
+    resolution_cache_entry_t &entry = _resolution_cache[_resolution_cache_next];
+    _resolution_cache_next = (_resolution_cache_next + 1) % MBED_CONF_BLE_PRIVATE_ADDRESS_CACHE_SIZE;
+    entry.private_address = address;
+    entry.resolved = (identity != NULL);
+    entry.used = true;
+
+    if (identity) {
+        entry.identity_address = identity->identity_address;
+        entry.identity_address_is_public = identity->identity_address_is_public;
+        identity_address = identity->identity_address;
+        identity_address_is_public = identity->identity_address_is_public;
+    }
+
+    return entry.resolved;
+#else
+    return false;
+#endif // BLE_FEATURE_PRIVACY
+}
+
+template<template<class> class TPalSecurityManager, template<class> class SigningMonitor>
+bool GenericSecurityManager<TPalSecurityManager, SigningMonitor>::private_address_resolves(
+    const address_t &address,
+    const irk_t &irk
+) {
+#if BLE_FEATURE_PRIVACY && defined(MBEDTLS_AES_C)
+    /* ah(irk, prand) = e(irk, padding || prand) mod 2^24, the address holds
+     * the hash in its 3 least significant bytes and prand in the others.
+     * Values are little endian while e works on big endian blocks. */
+    uint8_t key[16];
+    uint8_t block[16] = { 0 };
+    for (size_t i = 0; i < sizeof(key); ++i) {
+        key[i] = irk[sizeof(key) - 1 - i];
+    }
+    block[13] = address[5];
+    block[14] = address[4];
+    block[15] = address[3];
+
+    mbedtls_aes_context context;
+    mbedtls_aes_init(&context);
+    bool resolves =
+        mbedtls_aes_setkey_enc(&context, key, 128) == 0 &&
+        mbedtls_aes_crypt_ecb(&context, MBEDTLS_AES_ENCRYPT, block, block) == 0 &&
+        block[15] == address[0] &&
+        block[14] == address[1] &&
+        block[13] == address[2];
+    mbedtls_aes_free(&context);
+
+    return resolves;
+#else
+    return false;
+#endif
+}
+
+template<template<class> class TPalSecurityManager, template<class> class SigningMonitor>
+void GenericSecurityManager<TPalSecurityManager, SigningMonitor>::clear_resolution_cache() {
+    for (size_t i = 0; i < MBED_CONF_BLE_PRIVATE_ADDRESS_CACHE_SIZE; ++i) {
+        _resolution_cache[i].used = false;
+    }
+    _resolution_cache_next = 0;
+}
+
 /* Implements ble::pal::SecurityManagerEventHandler */
 
 ////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,337 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "KVStoreSecurityDb.h"
+
+#if MBED_CONF_BLE_SECURITY_DB_KVSTORE
+
+#include <stdio.h>
+#include <string.h>
+#include "kvstore_global_api.h"
+
+#define DB_STR_EXPAND(tok) #tok
+#define DB_STR(tok) DB_STR_EXPAND(tok)
+
+#define DB_PREFIX "/" DB_STR(MBED_CONF_STORAGE_DEFAULT_KV) "/ble_sec_"
+#define DB_KEY_LOCAL DB_PREFIX "local"
+#define DB_KEY_SIZE 32
+
+namespace ble {
+namespace generic {
+
+const uint16_t DB_VERSION = 1;
+
+/* content of an entry in the store */
+struct entry_store_t {
+    SecurityDistributionFlags_t flags;
+    SecurityEntryKeys_t local_keys;
+    SecurityEntryKeys_t peer_keys;
+    SecurityEntryIdentity_t peer_identity;
+    SecurityEntrySigning_t peer_signing;
+};
+
+typedef SecurityDb::entry_handle_t entry_handle_t;
+
+KVStoreSecurityDb::KVStoreSecurityDb()
+    : SecurityDb(),
+      _restore(false),
+      _local_dirty(false) {
+}
+
+KVStoreSecurityDb::~KVStoreSecurityDb() {
+}
+
+SecurityDistributionFlags_t* KVStoreSecurityDb::get_distribution_flags(
+    entry_handle_t db_handle
+) {
+    return reinterpret_cast<SecurityDistributionFlags_t*>(db_handle);
+}
+
+/* local keys */
+
+/* set */
+void KVStoreSecurityDb::set_entry_local_ltk(
+    entry_handle_t db_handle,
+    const ltk_t &ltk
+) {
+    entry_t *entry = as_entry(db_handle);
+    if (entry) {
+        entry->flags.ltk_sent = true;
+        entry->local_keys.ltk = ltk;
+        entry->dirty = true;
+    }
+}
+
+void KVStoreSecurityDb::set_entry_local_ediv_rand(
+    entry_handle_t db_handle,
+    const ediv_t &ediv,
+    const rand_t &rand
+) {
+    entry_t *entry = as_entry(db_handle);
+    if (entry) {
+        entry->local_keys.ediv = ediv;
+        entry->local_keys.rand = rand;
+        entry->dirty = true;
+    }
+}
+
+/* peer's keys */
+
+/* set */
+
+void KVStoreSecurityDb::set_entry_peer_ltk(
+    entry_handle_t db_handle,
+    const ltk_t &ltk
+) {
+    entry_t *entry = as_entry(db_handle);
+    if (entry) {
+        entry->peer_keys.ltk = ltk;
+        entry->flags.ltk_stored = true;
+        entry->dirty = true;
+    }
+}
+
+void KVStoreSecurityDb::set_entry_peer_ediv_rand(
+    entry_handle_t db_handle,
+    const ediv_t &ediv,
+    const rand_t &rand
+) {
+    entry_t *entry = as_entry(db_handle);
+    if (entry) {
+        entry->peer_keys.ediv = ediv;
+        entry->peer_keys.rand = rand;
+        entry->dirty = true;
+    }
+}
+
+void KVStoreSecurityDb::set_entry_peer_irk(
+    entry_handle_t db_handle,
+    const irk_t &irk
+) {
+    entry_t *entry = as_entry(db_handle);
+    if (entry) {
+        entry->peer_identity.irk = irk;
+        entry->flags.irk_stored = true;
+        entry->dirty = true;
+    }
+}
+
+void KVStoreSecurityDb::set_entry_peer_bdaddr(
+    entry_handle_t db_handle,
+    bool address_is_public,
+    const address_t &peer_address
+) {
+    entry_t *entry = as_entry(db_handle);
+    if (entry) {
+        entry->peer_identity.identity_address = peer_address;
+        entry->peer_identity.identity_address_is_public = address_is_public;
+        entry->dirty = true;
+    }
+}
+
+void KVStoreSecurityDb::set_entry_peer_csrk(
+    entry_handle_t db_handle,
+    const csrk_t &csrk
+) {
+    entry_t *entry = as_entry(db_handle);
+    if (entry) {
+        entry->flags.csrk_stored = true;
+        entry->peer_signing.csrk = csrk;
+        entry->dirty = true;
+    }
+}
+
+void KVStoreSecurityDb::set_entry_peer_sign_counter(
+    entry_handle_t db_handle,
+    sign_count_t sign_counter
+) {
+    entry_t *entry = as_entry(db_handle);
+    if (entry) {
+        entry->peer_signing.counter = sign_counter;
+        entry->dirty = true;
+    }
+}
+
+/* local csrk */
+
+void KVStoreSecurityDb::set_local_csrk(const csrk_t &csrk) {
+    _local_csrk = csrk;
+    _local_dirty = true;
+}
+
+void KVStoreSecurityDb::set_local_sign_counter(sign_count_t sign_counter) {
+    _local_sign_counter = sign_counter;
+    _local_dirty = true;
+}
+
+/* saving and loading from nvm */
+
+void KVStoreSecurityDb::restore() {
+    local_store_t local;
+    size_t size = 0;
+
+    /* restore if requested */
+    if (kv_get(DB_KEY_LOCAL, &local, sizeof(local), &size) != MBED_SUCCESS ||
+        size != sizeof(local) ||
+        local.version != DB_VERSION ||
+        !local.restore) {
+        char key[DB_KEY_SIZE];
+        for (size_t i = 0; i < get_entry_count(); i++) {
+            get_entry_key(key, i);
+            kv_remove(key);
+        }
+        _restore = false;
+        write_local();
+        return;
+    }
+
+    _restore = true;
+    _local_identity = local.identity;
+    _local_csrk = local.csrk;
+    _local_sign_counter = local.sign_counter;
+    _local_dirty = false;
+
+    entry_store_t store;
+    char key[DB_KEY_SIZE];
+    for (size_t i = 0; i < get_entry_count(); i++) {
+        entry_t &entry = _entries[i];
+        entry = entry_t();
+
+        get_entry_key(key, i);
+        if (kv_get(key, &store, sizeof(store), &size) != MBED_SUCCESS ||
+            size != sizeof(store)) {
+            continue;
+        }
+
+        entry.flags = store.flags;
+        entry.local_keys = store.local_keys;
+        entry.peer_keys = store.peer_keys;
+        entry.peer_identity = store.peer_identity;
+        entry.peer_signing = store.peer_signing;
+        entry.synced_flags = entry.flags;
+    }
+}
+
+void KVStoreSecurityDb::sync(entry_handle_t db_handle) {
+    if (_local_dirty) {
+        write_local();
+    }
+
+    entry_t *entry = as_entry(db_handle);
+    if (!entry) {
+        return;
+    }
+
+    /* flags are modified in place by the security manager, compare them
+     * with the stored ones to avoid rewriting an unchanged entry */
+    bool flags_changed = memcmp(
+        &entry->flags, &entry->synced_flags, sizeof(SecurityDistributionFlags_t)
+    ) != 0;
+
+    if (!entry->dirty && !flags_changed) {
+        return;
+    }
+
+    entry_store_t store;
+    store.flags = entry->flags;
+    store.local_keys = entry->local_keys;
+    store.peer_keys = entry->peer_keys;
+    store.peer_identity = entry->peer_identity;
+    store.peer_signing = entry->peer_signing;
+
+    char key[DB_KEY_SIZE];
+    get_entry_key(key, entry - _entries);
+    if (kv_set(key, &store, sizeof(store), 0) != MBED_SUCCESS) {
+        return;
+    }
+
+    entry->synced_flags = entry->flags;
+    entry->dirty = false;
+}
+
+void KVStoreSecurityDb::set_restore(bool reload) {
+    _restore = reload;
+    write_local();
+}
+
+/* helper functions */
+
+uint8_t KVStoreSecurityDb::get_entry_count() {
+    return MAX_ENTRIES;
+}
+
+SecurityDistributionFlags_t* KVStoreSecurityDb::get_entry_handle_by_index(uint8_t index) {
+    if (index < MAX_ENTRIES) {
+        return &_entries[index].flags;
+    } else {
+        return NULL;
+    }
+}
+
+void KVStoreSecurityDb::reset_entry(entry_handle_t db_entry) {
+    entry_t *entry = as_entry(db_entry);
+    if (!entry) {
+        return;
+    }
+
+    char key[DB_KEY_SIZE];
+    get_entry_key(key, entry - _entries);
+    kv_remove(key);
+
+    *entry = entry_t();
+}
+
+SecurityEntryIdentity_t* KVStoreSecurityDb::read_in_entry_peer_identity(entry_handle_t db_entry) {
+    entry_t *entry = as_entry(db_entry);
+    return entry ? &entry->peer_identity : NULL;
+}
+
+SecurityEntryKeys_t* KVStoreSecurityDb::read_in_entry_peer_keys(entry_handle_t db_entry) {
+    entry_t *entry = as_entry(db_entry);
+    return entry ? &entry->peer_keys : NULL;
+}
+
+SecurityEntryKeys_t* KVStoreSecurityDb::read_in_entry_local_keys(entry_handle_t db_entry) {
+    entry_t *entry = as_entry(db_entry);
+    return entry ? &entry->local_keys : NULL;
+}
+
+SecurityEntrySigning_t* KVStoreSecurityDb::read_in_entry_peer_signing(entry_handle_t db_entry) {
+    entry_t *entry = as_entry(db_entry);
+    return entry ? &entry->peer_signing : NULL;
+}
+
+void KVStoreSecurityDb::write_local() {
+    local_store_t local = local_store_t();
+    local.version = DB_VERSION;
+    local.restore = _restore;
+    local.identity = _local_identity;
+    local.csrk = _local_csrk;
+    local.sign_counter = _local_sign_counter;
+
+    if (kv_set(DB_KEY_LOCAL, &local, sizeof(local), 0) == MBED_SUCCESS) {
+        _local_dirty = false;
+    }
+}
+
+void KVStoreSecurityDb::get_entry_key(char *key, size_t index) {
+    snprintf(key, DB_KEY_SIZE, DB_PREFIX "%u", (unsigned int) index);
+}
+
+} /* namespace generic */
+} /* namespace ble */
+
+#endif // MBED_CONF_BLE_SECURITY_DB_KVSTORE
@@ -34,6 +34,7 @@
 #include "drivers/LowPowerTimer.h"
 #include "SigningMonitorProxy.h"
 #include "CordioPalSecurityManager.h"
+#include "CordioL2cap.h"
 #include "BleImplementationForward.h"
 
 namespace ble {
@@ -134,6 +135,13 @@ public:
 
 #endif // BLE_FEATURE_SECURITY
 
+#if BLE_FEATURE_L2CAP_COC
+    /**
+     * @see BLEInstanceBase::getL2cap
+     */
+    virtual ::ble::L2cap &getL2cap();
+#endif // BLE_FEATURE_L2CAP_COC
+
     /**
      * @see BLEInstanceBase::waitForEvent
      */
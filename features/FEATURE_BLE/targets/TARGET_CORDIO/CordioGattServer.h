@@ -118,6 +118,15 @@ public:
         bool localOnly = false
     );
 
+    /**
+     * @see ::GattServer::write
+     */
+    ble_error_t writeUpdates_(
+        const AttributeUpdate *updates,
+        size_t count,
+        bool localOnly = false
+    );
+
     /**
      * @see ::GattServer::areUpdatesEnabled
      */
@@ -231,10 +240,21 @@ private:
     void add_generic_access_service();
     void add_generic_attribute_service();
     void* alloc_block(size_t block_size);
+    void build_handle_table();
+    void add_group_to_handle_table(const attsGroup_t &group);
+    attsAttr_t* get_attribute(GattAttribute::Handle_t handle) const;
+    uint8_t set_attribute_value(GattAttribute::Handle_t handle, uint16_t len, const uint8_t *value);
     GattCharacteristic* get_auth_char(uint16_t value_handle);
     bool get_cccd_index_by_cccd_handle(GattAttribute::Handle_t cccd_handle, uint8_t& idx) const;
     bool get_cccd_index_by_value_handle(GattAttribute::Handle_t char_handle, uint8_t& idx) const;
     bool is_update_authorized(connection_handle_t connection, GattAttribute::Handle_t value_handle);
+    void send_update(
+        connection_handle_t connection,
+        GattAttribute::Handle_t value_handle,
+        uint8_t cccd_index,
+        const uint8_t *value,
+        uint16_t len
+    );
 
     struct alloc_block_t {
         alloc_block_t* next;
@@ -246,6 +266,14 @@ private:
         internal_service_t *next;
     };
 
+    // Entry of the handle table, indexes are NO_INDEX when not applicable
+    struct handle_entry_t {
+        attsAttr_t *attribute;
+        uint8_t cccd_index;         // the handle is the CCCD at this index
+        uint8_t value_cccd_index;   // the handle is the value of the characteristic of this CCCD
+        uint8_t auth_char_index;    // the handle is the value of this characteristic in _auth_char
+    };
+
     impl::SigningEventHandler *_signing_event_handler;
 
     attsCccSet_t cccds[MAX_CCCD_CNT];
@@ -256,6 +284,12 @@ private:
     GattCharacteristic *_auth_char[MAX_CHARACTERISTIC_AUTHORIZATION_CNT];
     uint8_t _auth_char_count;
 
+    // Attributes and their CCCD and authorization lookups indexed by handle - 1,
+    // rebuilt when a service is added. Handles past the table are looked up
+    // in the stack and the arrays above.
+    handle_entry_t *_handle_table;
+    uint16_t _handle_table_size;
+
     struct {
         attsGroup_t service;
         attsAttr_t attributes[7];
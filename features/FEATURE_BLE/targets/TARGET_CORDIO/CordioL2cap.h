@@ -0,0 +1,109 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CORDIO_L2CAP_H_
+#define CORDIO_L2CAP_H_
+
+#include "ble/BLERoles.h"
+
+#if BLE_FEATURE_L2CAP_COC
+
+#include "ble/L2cap.h"
+#include "wsf_types.h"
+#include "l2c_api.h"
+#include "cfg_stack.h"
+
+namespace ble {
+namespace vendor {
+namespace cordio {
+
+/**
+ * Cordio implementation of ::ble::L2cap
+ */
+class L2cap : public ::ble::L2cap {
+public:
+    /**
+     * Return the singleton of the Cordio implementation of ::ble::L2cap.
+     */
+    static L2cap &getInstance();
+
+    /**
+     * @see ::ble::L2cap::listen
+     */
+    virtual ble_error_t listen(uint16_t psm);
+
+    /**
+     * @see ::ble::L2cap::connect
+     */
+    virtual ble_error_t connect(
+        connection_handle_t connectionHandle,
+        uint16_t psm,
+        uint16_t *channel
+    );
+
+    /**
+     * @see ::ble::L2cap::disconnect
+     */
+    virtual ble_error_t disconnect(uint16_t channel);
+
+    /**
+     * @see ::ble::L2cap::send
+     */
+    virtual ble_error_t send(uint16_t channel, const uint8_t *data, uint32_t size);
+
+    /**
+     * Release the registrations and forget the channels.
+     */
+    void reset();
+
+private:
+    struct channel_t {
+        uint16_t cid;
+        uint16_t peer_mtu;
+        const uint8_t *tx_data;
+        uint32_t tx_size;
+        uint32_t tx_offset;
+        uint16_t tx_sdu;
+    };
+
+    L2cap();
+
+    ble_error_t register_psm(uint16_t psm, uint8_t role, l2cCocRegId_t *id);
+    channel_t *get_channel(uint16_t cid);
+    channel_t *add_channel(uint16_t cid);
+    void send_sdu(channel_t *channel);
+    void end_transmission(channel_t *channel, ble_error_t status);
+
+    void on_connect(const l2cCocConnectInd_t &evt);
+    void on_disconnect(const l2cCocDisconnectInd_t &evt);
+    void on_data_sent(const l2cCocDataCnf_t &evt);
+
+    static void coc_cb(l2cCocEvt_t *evt);
+
+    l2cCocRegId_t _registrations[L2C_COC_REG_MAX];
+    uint16_t _psms[L2C_COC_REG_MAX];
+    l2cCocRegId_t _initiator;
+    channel_t _channels[L2C_COC_CHAN_MAX];
+};
+
+} // namespace cordio
+} // namespace vendor
+} // namespace ble
+
+#endif // BLE_FEATURE_L2CAP_COC
+
+#endif /* CORDIO_L2CAP_H_ */
@@ -24,6 +24,10 @@
 #include "smp_defs.h"
 #include "cfg_stack.h"
 
+#ifndef MBED_CONF_CORDIO_LESC_KEY_REUSE
+#define MBED_CONF_CORDIO_LESC_KEY_REUSE 1
+#endif
+
 namespace ble {
 namespace pal {
 namespace vendor {
@@ -364,9 +368,21 @@ private:
 
     void cleanup_peer_csrks();
 
+    // Request a new LESC key pair from the controller unless one is on its way
+    // or a pairing still needs the current one
+    void generate_lesc_keys();
+
+    // Count a pairing against the LESC key reuse policy and renew the key
+    // pair once it is used up
+    void on_pairing_end(bool lesc_key_used);
+
+    static bool is_pairing_in_progress();
+
     bool _use_default_passkey;
     passkey_num_t _default_passkey;
     bool _lesc_keys_generated;
+    bool _lesc_keys_requested;
+    uint16_t _lesc_key_uses;
     uint8_t _public_key_x[SEC_ECC_KEY_LEN];
 
     PrivacyControlBlock* _pending_privacy_control_blocks;
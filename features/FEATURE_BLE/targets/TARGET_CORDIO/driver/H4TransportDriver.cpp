@@ -16,14 +16,37 @@
 
 #if DEVICE_SERIAL && DEVICE_SERIAL_FC
 
+#include <algorithm>
 #include "H4TransportDriver.h"
 
 namespace ble {
 namespace vendor {
 namespace cordio {
 
+#if DEVICE_SERIAL_ASYNCH
+// H4 packet indicators and the length of the header following them
+#define H4_CMD_TYPE         0x01
+#define H4_ACL_TYPE         0x02
+#define H4_EVT_TYPE         0x04
+#define H4_CMD_HEADER_LEN   3
+#define H4_ACL_HEADER_LEN   4
+#define H4_EVT_HEADER_LEN   2
+
+#define H4_RX_EVENTS        (SERIAL_EVENT_RX_ALL & ~SERIAL_EVENT_RX_CHARACTER_MATCH)
+
+MBED_STATIC_ASSERT(MBED_CONF_CORDIO_H4_RX_BUFFER_SIZE > H4_ACL_HEADER_LEN,
+                   "cordio.h4-rx-buffer-size must hold the type and header of a packet");
+#endif
+
 H4TransportDriver::H4TransportDriver(PinName tx, PinName rx, PinName cts, PinName rts, int baud) :
-    uart(tx, rx, baud), cts(cts), rts(rts) { }
+    uart(tx, rx, baud), cts(cts), rts(rts)
+#if DEVICE_SERIAL_ASYNCH
+    , _rx_length(0), _rx_request(0), _rx_remaining(0), _rx_state(RX_TYPE)
+#ifdef MBED_CONF_RTOS_PRESENT
+    , _tx_type(0), _tx_payload(NULL), _tx_length(0), _tx_done(0)
+#endif
+#endif
+{ }
 
 void H4TransportDriver::initialize()
 {
@@ -39,16 +62,44 @@ void H4TransportDriver::initialize()
         /* cts */ cts
     );
 
+#if DEVICE_SERIAL_ASYNCH
+    uart.set_dma_usage_rx(DMA_USAGE_ALWAYS);
+    uart.set_dma_usage_tx(DMA_USAGE_ALWAYS);
+
+    _rx_length = 0;
+    _rx_state = RX_TYPE;
+    start_read(1);
+#else
     uart.attach(
         callback(this, &H4TransportDriver::on_controller_irq),
         SerialBase::RxIrq
     );
+#endif
 }
 
-void H4TransportDriver::terminate() {  }
+void H4TransportDriver::terminate()
+{
+#if DEVICE_SERIAL_ASYNCH
+    uart.abort_read();
+#endif
+}
 
 uint16_t H4TransportDriver::write(uint8_t type, uint16_t len, uint8_t *pData)
 {
+#if DEVICE_SERIAL_ASYNCH && defined(MBED_CONF_RTOS_PRESENT)
+    // The type is sent first and the payload chained from its completion, the
+    // thread sleeps until the payload is out as the stack frees it on return
+    if (len && !core_util_in_critical_section() && !core_util_is_isr_active()) {
+        _tx_type = type;
+        _tx_payload = pData;
+        _tx_length = len;
+        if (uart.write(&_tx_type, 1, callback(this, &H4TransportDriver::on_write_done)) == 0) {
+            _tx_done.acquire();
+            return len;
+        }
+    }
+#endif
+
     uint16_t i = 0;
     while (i < len + 1) {
         uint8_t to_write = i == 0 ? type : pData[i - 1];
@@ -67,6 +118,108 @@ void H4TransportDriver::on_controller_irq()
     }
 }
 
+#if DEVICE_SERIAL_ASYNCH
+void H4TransportDriver::start_read(uint16_t length)
+{
+    _rx_request = length;
+    uart.read(
+        _rx_buffer + _rx_length,
+        length,
+        callback(this, &H4TransportDriver::on_read_done),
+        H4_RX_EVENTS
+    );
+}
+
+void H4TransportDriver::on_read_done(int event)
+{
+    if (!(event & SERIAL_EVENT_RX_COMPLETE)) {
+        // Framing, parity or overrun error, the rest of the packet is dropped
+        // and the next byte is taken as a packet type
+        _rx_length = 0;
+        _rx_state = RX_TYPE;
+        start_read(1);
+        return;
+    }
+
+    _rx_length += _rx_request;
+
+    switch (_rx_state) {
+        case RX_TYPE: {
+            uint16_t header_length = 0;
+            switch (_rx_buffer[0]) {
+                case H4_CMD_TYPE:
+                    header_length = H4_CMD_HEADER_LEN;
+                    break;
+                case H4_ACL_TYPE:
+                    header_length = H4_ACL_HEADER_LEN;
+                    break;
+                case H4_EVT_TYPE:
+                    header_length = H4_EVT_HEADER_LEN;
+                    break;
+                default:
+                    break;
+            }
+            if (header_length) {
+                _rx_state = RX_HEADER;
+                start_read(header_length);
+                return;
+            }
+            // Unknown type, left to the stack to report
+            _rx_remaining = 0;
+            break;
+        }
+
+        case RX_HEADER: {
+            const uint8_t *header = _rx_buffer + 1;
+            switch (_rx_buffer[0]) {
+                case H4_CMD_TYPE:
+                    _rx_remaining = header[2];
+                    break;
+                case H4_ACL_TYPE:
+                    _rx_remaining = header[2] | (header[3] << 8);
+                    break;
+                default:
+                    _rx_remaining = header[1];
+                    break;
+            }
+            break;
+        }
+
+        case RX_PAYLOAD:
+            _rx_remaining -= _rx_request;
+            break;
+    }
+
+    if (!_rx_remaining || _rx_length == sizeof(_rx_buffer)) {
+        on_data_received(_rx_buffer, _rx_length);
+        _rx_length = 0;
+    }
+
+    if (_rx_remaining) {
+        _rx_state = RX_PAYLOAD;
+        start_read(std::min(_rx_remaining, (uint16_t)(sizeof(_rx_buffer) - _rx_length)));
+    } else {
+        _rx_state = RX_TYPE;
+        start_read(1);
+    }
+}
+
+#ifdef MBED_CONF_RTOS_PRESENT
+void H4TransportDriver::on_write_done(int event)
+{
+    (void)event;
+    if (_tx_payload) {
+        const uint8_t *payload = _tx_payload;
+        _tx_payload = NULL;
+        if (uart.write(payload, _tx_length, callback(this, &H4TransportDriver::on_write_done)) == 0) {
+            return;
+        }
+    }
+    _tx_done.release();
+}
+#endif
+#endif
+
 } // namespace cordio
 } // namespace vendor
 } // namespace ble
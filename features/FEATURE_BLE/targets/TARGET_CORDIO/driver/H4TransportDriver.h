@@ -23,6 +23,10 @@
 #include "mbed.h"
 #include "CordioHCITransportDriver.h"
 
+#ifndef MBED_CONF_CORDIO_H4_RX_BUFFER_SIZE
+#define MBED_CONF_CORDIO_H4_RX_BUFFER_SIZE 260
+#endif
+
 namespace ble {
 namespace vendor {
 namespace cordio {
@@ -30,6 +34,11 @@ namespace cordio {
 /**
  * Implementation of the H4 driver.
  *
+ * On targets with asynchronous serial, packets are received with transfers
+ * sized from the H4 header and handed to the stack whole, and packets are sent
+ * with asynchronous writes the calling thread waits on. Other targets receive
+ * and send one byte at a time.
+ *
  * @note This HCI transport implementation is not accessible to devices that do
  * not expose serial flow control.
  */
@@ -69,6 +78,20 @@ public:
 private:
     void on_controller_irq();
 
+#if DEVICE_SERIAL_ASYNCH
+    enum rx_state_t {
+        RX_TYPE,
+        RX_HEADER,
+        RX_PAYLOAD
+    };
+
+    void start_read(uint16_t length);
+    void on_read_done(int event);
+#ifdef MBED_CONF_RTOS_PRESENT
+    void on_write_done(int event);
+#endif
+#endif
+
     // Use RawSerial as opposed to Serial as we don't require the locking primitives
     // provided by the Serial class (access to the UART should be exclusive to this driver)
     // Furthermore, we access the peripheral in interrupt context which would clash
@@ -76,6 +99,21 @@ private:
     RawSerial uart;
     PinName cts;
     PinName rts;
+
+#if DEVICE_SERIAL_ASYNCH
+    // Packet being received, handed over in pieces if larger than the buffer
+    uint8_t _rx_buffer[MBED_CONF_CORDIO_H4_RX_BUFFER_SIZE];
+    uint16_t _rx_length;
+    uint16_t _rx_request;
+    uint16_t _rx_remaining;
+    rx_state_t _rx_state;
+#ifdef MBED_CONF_RTOS_PRESENT
+    uint8_t _tx_type;
+    const uint8_t *_tx_payload;
+    uint16_t _tx_length;
+    rtos::Semaphore _tx_done;
+#endif
+#endif
 };
 
 } // namespace cordio
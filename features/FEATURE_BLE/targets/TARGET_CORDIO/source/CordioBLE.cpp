@@ -167,6 +167,10 @@ ble_error_t BLE::shutdown()
     getGattClient().reset();
 #endif // BLE_FEATURE_GATT_CLIENT
 
+#if BLE_FEATURE_L2CAP_COC
+    vendor::cordio::L2cap::getInstance().reset();
+#endif
+
     getGap().reset();
     _event_queue.clear();
 
@@ -248,6 +252,13 @@ const SecurityManager& BLE::getSecurityManager() const
 }
 #endif // BLE_FEATURE_SECURITY
 
+#if BLE_FEATURE_L2CAP_COC
+::ble::L2cap& BLE::getL2cap()
+{
+    return vendor::cordio::L2cap::getInstance();
+}
+#endif // BLE_FEATURE_L2CAP_COC
+
 void BLE::waitForEvent()
 {
     static Timeout nextTimeout;
@@ -464,6 +475,12 @@ void BLE::stack_setup()
     L2cMasterInit();
 #endif
 
+#if BLE_FEATURE_L2CAP_COC
+    handlerId = WsfOsSetNextHandler(L2cCocHandler);
+    L2cCocHandlerInit(handlerId);
+    L2cCocInit();
+#endif
+
 #if BLE_FEATURE_ATT
     handlerId = WsfOsSetNextHandler(AttHandler);
     AttHandlerInit(handlerId);
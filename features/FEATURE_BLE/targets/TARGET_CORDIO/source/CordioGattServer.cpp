@@ -21,6 +21,7 @@
 #include "source/GattServer.tpp"
 #include "mbed.h"
 #include "wsf_types.h"
+#include "wsf_os.h"
 #include "att_api.h"
 
 template class ble::interface::GattServer<ble::vendor::cordio::GattServer>;
@@ -58,6 +59,8 @@ static const uint8_t UPDATE_PROPERTIES =
 
 static const uint16_t CONNECTION_ID_LIMIT = 0x100;
 
+static const uint8_t NO_INDEX = 0xFF;
+
 } // end of anonymous namespace
 
 GattServer &GattServer::getInstance()
@@ -72,6 +75,7 @@ void GattServer::initialize()
     AttsAuthorRegister(atts_auth_cb);
 #endif
     add_default_services();
+    build_handle_table();
 }
 
 void GattServer::add_default_services()
@@ -140,6 +144,7 @@ ble_error_t GattServer::addService_(GattService &service)
     // register services and update cccds
     AttsAddGroup(&att_service->attGroup);
     AttsCccRegister(cccd_cnt, (attsCccSet_t*)cccds, cccd_cb);
+    build_handle_table();
     return BLE_ERROR_NONE;
 }
 
@@ -596,7 +601,11 @@ ble_error_t GattServer::read_(
     uint16_t att_length = 0;
     uint8_t* att_value = NULL;
 
-    if (AttsGetAttr(att_handle, &att_length, &att_value) != ATT_SUCCESS) {
+    attsAttr_t* attribute = get_attribute(att_handle);
+    if (attribute) {
+        att_length = *attribute->pLen;
+        att_value = attribute->pValue;
+    } else if (AttsGetAttr(att_handle, &att_length, &att_value) != ATT_SUCCESS) {
         return BLE_ERROR_PARAM_OUT_OF_RANGE;
     }
 
@@ -663,7 +672,7 @@ ble_error_t GattServer::write_(
     }
 
     // write the value to the attribute handle
-    if (AttsSetAttr(att_handle, len, (uint8_t*)buffer) != ATT_SUCCESS) {
+    if (set_attribute_value(att_handle, len, buffer) != ATT_SUCCESS) {
         return BLE_ERROR_PARAM_OUT_OF_RANGE;
     }
 
@@ -673,27 +682,12 @@ ble_error_t GattServer::write_(
     }
 
     // This characteristic has a CCCD attribute. Handle notifications and
-    // indications for all active connections if the authentication is
-    // successful
-    size_t updates_sent = 0;
-
-#if BLE_FEATURE_SECURITY
+    // indications for all active connections
     for (dmConnId_t conn_id = DM_CONN_MAX; conn_id > DM_CONN_ID_NONE; --conn_id) {
         if (DmConnInUse(conn_id) == true) {
-            if (is_update_authorized(conn_id, att_handle)) {
-                uint16_t cccd_config = AttsCccEnabled(conn_id, cccd_index);
-                if (cccd_config & ATT_CLIENT_CFG_NOTIFY) {
-                    AttsHandleValueNtf(conn_id, att_handle, len, (uint8_t*)buffer);
-                    updates_sent++;
-                }
-                if (cccd_config & ATT_CLIENT_CFG_INDICATE) {
-                    AttsHandleValueInd(conn_id, att_handle, len, (uint8_t*)buffer);
-                    updates_sent++;
-                }
-            }
+            send_update(conn_id, att_handle, cccd_index, buffer, len);
         }
     }
-#endif // BLE_FEATURE_SECURITY
 
     return BLE_ERROR_NONE;
 }
@@ -719,7 +713,7 @@ ble_error_t GattServer::write_(
     }
 
     // write the value to the attribute handle
-    if (AttsSetAttr(att_handle, len, (uint8_t*)buffer) != ATT_SUCCESS) {
+    if (set_attribute_value(att_handle, len, buffer) != ATT_SUCCESS) {
         return BLE_ERROR_PARAM_OUT_OF_RANGE;
     }
 
@@ -729,25 +723,71 @@ ble_error_t GattServer::write_(
     }
 
     // This characteristic has a CCCD attribute. Handle notifications and indications.
-    size_t updates_sent = 0;
+    send_update(connection, att_handle, cccd_index, buffer, len);
 
-#if BLE_FEATURE_SECURITY
-    if (is_update_authorized(connection, att_handle)) {
-        uint16_t cccEnabled = AttsCccEnabled(connection, cccd_index);
-        if (cccEnabled & ATT_CLIENT_CFG_NOTIFY) {
-            AttsHandleValueNtf(connection, att_handle, len, (uint8_t*)buffer);
-            updates_sent++;
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t GattServer::writeUpdates_(
+    const AttributeUpdate *updates,
+    size_t count,
+    bool local_only
+) {
+    // Update all the values before any notification is queued so that every
+    // client receives a consistent set
+    for (size_t i = 0; i < count; i++) {
+        uint8_t cccd_index;
+        if (get_cccd_index_by_cccd_handle(updates[i].handle, cccd_index)) {
+            return BLE_ERROR_INVALID_PARAM;
         }
-        if (cccEnabled & ATT_CLIENT_CFG_INDICATE) {
-            AttsHandleValueInd(connection, att_handle, len, (uint8_t*)buffer);
-            updates_sent++;
+        if (AttsSetAttr(updates[i].handle, updates[i].size, (uint8_t*)updates[i].value) != ATT_SUCCESS) {
+            return BLE_ERROR_PARAM_OUT_OF_RANGE;
+        }
+    }
+
+    if (local_only) {
+        return BLE_ERROR_NONE;
+    }
+
+    // The stack only sends the PDUs once it gets control back, queue them
+    // all now; each CCCD is looked up once for all connections
+    for (size_t i = 0; i < count; i++) {
+        uint8_t cccd_index;
+        if (!get_cccd_index_by_value_handle(updates[i].handle, cccd_index)) {
+            continue;
+        }
+        for (dmConnId_t conn_id = DM_CONN_MAX; conn_id > DM_CONN_ID_NONE; --conn_id) {
+            if (DmConnInUse(conn_id) == true) {
+                send_update(conn_id, updates[i].handle, cccd_index, updates[i].value, updates[i].size);
+            }
         }
     }
-#endif // BLE_FEATURE_SECURITY
 
     return BLE_ERROR_NONE;
 }
 
+void GattServer::send_update(
+    connection_handle_t connection,
+    GattAttribute::Handle_t value_handle,
+    uint8_t cccd_index,
+    const uint8_t *value,
+    uint16_t len
+) {
+#if BLE_FEATURE_SECURITY
+    if (!is_update_authorized(connection, value_handle)) {
+        return;
+    }
+#endif // BLE_FEATURE_SECURITY
+
+    uint16_t cccd_config = AttsCccEnabled(connection, cccd_index);
+    if (cccd_config & ATT_CLIENT_CFG_NOTIFY) {
+        AttsHandleValueNtf(connection, value_handle, len, (uint8_t*)value);
+    }
+    if (cccd_config & ATT_CLIENT_CFG_INDICATE) {
+        AttsHandleValueInd(connection, value_handle, len, (uint8_t*)value);
+    }
+}
+
 ble_error_t GattServer::areUpdatesEnabled_(
     const GattCharacteristic &characteristic,
     bool *enabled
@@ -885,6 +925,10 @@ ble_error_t GattServer::reset_(void)
 
     _auth_char_count = 0;
 
+    free(_handle_table);
+    _handle_table = NULL;
+    _handle_table_size = 0;
+
     AttsCccRegister(cccd_cnt, (attsCccSet_t*)cccds, cccd_cb);
 
     return BLE_ERROR_NONE;
@@ -907,8 +951,25 @@ void GattServer::att_cb(const attEvt_t *evt)
         if (handler) {
             handler->onAttMtuChange(evt->hdr.param, evt->mtu);
         }
-    } else if (evt->hdr.status == ATT_SUCCESS && evt->hdr.event == ATTS_HANDLE_VALUE_CNF) {
-        getInstance().handleEvent(GattServerEvents::GATT_EVENT_DATA_SENT, evt->handle);
+    } else if (evt->hdr.event == ATTS_HANDLE_VALUE_CNF) {
+        if (evt->hdr.status == ATT_SUCCESS) {
+            getInstance().handleEvent(GattServerEvents::GATT_EVENT_DATA_SENT, evt->handle);
+        }
+
+        ::GattServer::EventHandler *handler = getInstance().getEventHandler();
+        if (handler) {
+            GattDataSentCallbackParams params = {
+                evt->hdr.param,
+                evt->handle,
+                BLE_ERROR_NONE
+            };
+            if (evt->hdr.status == ATT_ERR_OVERFLOW) {
+                params.status = BLE_STACK_BUSY;
+            } else if (evt->hdr.status != ATT_SUCCESS) {
+                params.status = BLE_ERROR_UNSPECIFIED;
+            }
+            handler->onDataSent(params);
+        }
     }
 }
 
@@ -964,7 +1025,7 @@ uint8_t GattServer::atts_write_cb(
     uint8_t err;
 
     /* TODO: offset is not handled properly */
-    if ((err = AttsSetAttr(handle, len, pValue)) != ATT_SUCCESS) {
+    if ((err = getInstance().set_attribute_value(handle, len, pValue)) != ATT_SUCCESS) {
         return err;
     }
 
@@ -1254,8 +1315,104 @@ void* GattServer::alloc_block(size_t block_size) {
     return block->data;
 }
 
+void GattServer::build_handle_table()
+{
+    handle_entry_t* table = (handle_entry_t*) realloc(
+        _handle_table,
+        currentHandle * sizeof(handle_entry_t)
+    );
+    if (table == NULL) {
+        // lookups fall back to the stack and the linear searches
+        free(_handle_table);
+        _handle_table = NULL;
+        _handle_table_size = 0;
+        return;
+    }
+    _handle_table = table;
+    _handle_table_size = currentHandle;
+
+    for (uint16_t i = 0; i < _handle_table_size; ++i) {
+        _handle_table[i].attribute = NULL;
+        _handle_table[i].cccd_index = NO_INDEX;
+        _handle_table[i].value_cccd_index = NO_INDEX;
+        _handle_table[i].auth_char_index = NO_INDEX;
+    }
+
+    if (default_services_added) {
+        add_group_to_handle_table(generic_access_service.service);
+        add_group_to_handle_table(generic_attribute_service.service);
+    }
+    for (internal_service_t* s = registered_service; s; s = s->next) {
+        add_group_to_handle_table(s->attGroup);
+    }
+
+    for (uint8_t idx = 0; idx < cccd_cnt; ++idx) {
+        if (cccds[idx].handle && cccds[idx].handle <= _handle_table_size) {
+            _handle_table[cccds[idx].handle - 1].cccd_index = idx;
+        }
+        if (cccd_handles[idx] && cccd_handles[idx] <= _handle_table_size) {
+            _handle_table[cccd_handles[idx] - 1].value_cccd_index = idx;
+        }
+    }
+
+    for (uint8_t idx = 0; idx < _auth_char_count; ++idx) {
+        GattAttribute::Handle_t handle = _auth_char[idx]->getValueHandle();
+        if (handle && handle <= _handle_table_size) {
+            _handle_table[handle - 1].auth_char_index = idx;
+        }
+    }
+}
+
+void GattServer::add_group_to_handle_table(const attsGroup_t &group)
+{
+    for (uint16_t handle = group.startHandle;
+        handle && handle <= group.endHandle && handle <= _handle_table_size;
+        ++handle
+    ) {
+        _handle_table[handle - 1].attribute = &group.pAttr[handle - group.startHandle];
+    }
+}
+
+attsAttr_t* GattServer::get_attribute(GattAttribute::Handle_t handle) const
+{
+    if (handle == 0 || handle > _handle_table_size) {
+        return NULL;
+    }
+    return _handle_table[handle - 1].attribute;
+}
+
+uint8_t GattServer::set_attribute_value(
+    GattAttribute::Handle_t handle,
+    uint16_t len,
+    const uint8_t *value
+) {
+    attsAttr_t* attribute = get_attribute(handle);
+    if (attribute == NULL) {
+        return AttsSetAttr(handle, len, (uint8_t*) value);
+    }
+
+    // same as AttsSetAttr without the search through the attribute groups
+    if (len > attribute->maxLen) {
+        return ATT_ERR_LENGTH;
+    }
+
+    WsfTaskLock();
+    memcpy(attribute->pValue, value, len);
+    if (attribute->settings & ATTS_SET_VARIABLE_LEN) {
+        *(attribute->pLen) = len;
+    }
+    WsfTaskUnlock();
+
+    return ATT_SUCCESS;
+}
+
 GattCharacteristic* GattServer::get_auth_char(uint16_t value_handle)
 {
+    if (value_handle && value_handle <= _handle_table_size) {
+        uint8_t idx = _handle_table[value_handle - 1].auth_char_index;
+        return idx == NO_INDEX ? NULL : _auth_char[idx];
+    }
+
     for (size_t i = 0; i < _auth_char_count; ++i) {
         if (_auth_char[i]->getValueHandle() == value_handle) {
             return _auth_char[i];
@@ -1266,6 +1423,11 @@ GattCharacteristic* GattServer::get_auth_char(uint16_t value_handle)
 
 bool GattServer::get_cccd_index_by_cccd_handle(GattAttribute::Handle_t cccd_handle, uint8_t& idx) const
 {
+    if (cccd_handle && cccd_handle <= _handle_table_size) {
+        idx = _handle_table[cccd_handle - 1].cccd_index;
+        return idx != NO_INDEX;
+    }
+
     for (idx = 0; idx < cccd_cnt; idx++) {
         if (cccd_handle == cccds[idx].handle) {
             return true;
@@ -1276,6 +1438,11 @@ bool GattServer::get_cccd_index_by_cccd_handle(GattAttribute::Handle_t cccd_hand
 
 bool GattServer::get_cccd_index_by_value_handle(GattAttribute::Handle_t char_handle, uint8_t& idx) const
 {
+    if (char_handle && char_handle <= _handle_table_size) {
+        idx = _handle_table[char_handle - 1].value_cccd_index;
+        return idx != NO_INDEX;
+    }
+
     for (idx = 0; idx < cccd_cnt; ++idx) {
         if (char_handle == cccd_handles[idx]) {
             return true;
@@ -1343,6 +1510,8 @@ GattServer::GattServer() :
     cccd_cnt(0),
     _auth_char(),
     _auth_char_count(0),
+    _handle_table(NULL),
+    _handle_table_size(0),
     generic_access_service(),
     generic_attribute_service(),
     registered_service(NULL),
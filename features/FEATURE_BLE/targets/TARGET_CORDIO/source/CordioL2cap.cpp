@@ -0,0 +1,328 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CordioL2cap.h"
+
+#if BLE_FEATURE_L2CAP_COC
+
+#include <string.h>
+#include "dm_api.h"
+#include "l2c_defs.h"
+
+#ifndef MBED_CONF_CORDIO_L2CAP_COC_MTU
+#define MBED_CONF_CORDIO_L2CAP_COC_MTU 512
+#endif
+
+#ifndef MBED_CONF_CORDIO_L2CAP_COC_CREDITS
+#define MBED_CONF_CORDIO_L2CAP_COC_CREDITS 8
+#endif
+
+namespace ble {
+namespace vendor {
+namespace cordio {
+
+L2cap &L2cap::getInstance()
+{
+    static L2cap m_instance;
+    return m_instance;
+}
+
+L2cap::L2cap() : _initiator(L2C_COC_REG_ID_NONE)
+{
+    for (size_t i = 0; i < L2C_COC_REG_MAX; ++i) {
+        _registrations[i] = L2C_COC_REG_ID_NONE;
+        _psms[i] = 0;
+    }
+    memset(_channels, 0, sizeof(_channels));
+}
+
+ble_error_t L2cap::listen(uint16_t psm)
+{
+    if (psm == 0) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    for (size_t i = 0; i < L2C_COC_REG_MAX; ++i) {
+        if (_registrations[i] != L2C_COC_REG_ID_NONE && _psms[i] == psm) {
+            return BLE_ERROR_NONE;
+        }
+    }
+
+    l2cCocRegId_t id;
+    ble_error_t err = register_psm(
+        psm, L2C_COC_ROLE_ACCEPTOR | L2C_COC_ROLE_INITIATOR, &id
+    );
+    if (err) {
+        return err;
+    }
+
+    if (_initiator == L2C_COC_REG_ID_NONE) {
+        _initiator = id;
+    }
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t L2cap::connect(
+    connection_handle_t connectionHandle,
+    uint16_t psm,
+    uint16_t *channel
+)
+{
+    if (psm == 0 || channel == NULL) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    // Channels are opened with the first registration able to initiate them
+    if (_initiator == L2C_COC_REG_ID_NONE) {
+        ble_error_t err = register_psm(0, L2C_COC_ROLE_INITIATOR, &_initiator);
+        if (err) {
+            return err;
+        }
+    }
+
+    uint16_t cid = L2cCocConnectReq(connectionHandle, _initiator, psm);
+    if (cid == L2C_COC_CID_NONE) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    if (add_channel(cid) == NULL) {
+        L2cCocDisconnectReq(cid);
+        return BLE_ERROR_NO_MEM;
+    }
+
+    *channel = cid;
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t L2cap::disconnect(uint16_t channel)
+{
+    if (get_channel(channel) == NULL) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    L2cCocDisconnectReq(channel);
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t L2cap::send(uint16_t channel, const uint8_t *data, uint32_t size)
+{
+    channel_t *c = get_channel(channel);
+    if (c == NULL || data == NULL || size == 0) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    if (c->peer_mtu == 0) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    if (c->tx_data) {
+        return BLE_STACK_BUSY;
+    }
+
+    c->tx_data = data;
+    c->tx_size = size;
+    c->tx_offset = 0;
+    send_sdu(c);
+    return BLE_ERROR_NONE;
+}
+
+void L2cap::reset()
+{
+    for (size_t i = 0; i < L2C_COC_REG_MAX; ++i) {
+        if (_registrations[i] != L2C_COC_REG_ID_NONE) {
+            L2cCocDeregister(_registrations[i]);
+            _registrations[i] = L2C_COC_REG_ID_NONE;
+        }
+    }
+    _initiator = L2C_COC_REG_ID_NONE;
+    memset(_channels, 0, sizeof(_channels));
+    _eventHandler = NULL;
+}
+
+ble_error_t L2cap::register_psm(uint16_t psm, uint8_t role, l2cCocRegId_t *id)
+{
+    size_t i = 0;
+    while (i < L2C_COC_REG_MAX && _registrations[i] != L2C_COC_REG_ID_NONE) {
+        ++i;
+    }
+    if (i == L2C_COC_REG_MAX) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    // The largest PDU received is bounded by the ACL reassembly buffer
+    l2cCocReg_t reg;
+    reg.psm = psm;
+    reg.mps = MBED_CONF_CORDIO_RX_ACL_BUFFER_SIZE - L2C_HDR_LEN;
+    reg.mtu = MBED_CONF_CORDIO_L2CAP_COC_MTU;
+    reg.credits = MBED_CONF_CORDIO_L2CAP_COC_CREDITS;
+    reg.authoriz = FALSE;
+    reg.secLevel = DM_SEC_LEVEL_NONE;
+    reg.role = role;
+
+    *id = L2cCocRegister(coc_cb, &reg);
+    if (*id == L2C_COC_REG_ID_NONE) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    _registrations[i] = *id;
+    _psms[i] = psm;
+    return BLE_ERROR_NONE;
+}
+
+L2cap::channel_t *L2cap::get_channel(uint16_t cid)
+{
+    for (size_t i = 0; i < L2C_COC_CHAN_MAX; ++i) {
+        if (_channels[i].cid == cid && cid != L2C_COC_CID_NONE) {
+            return &_channels[i];
+        }
+    }
+    return NULL;
+}
+
+L2cap::channel_t *L2cap::add_channel(uint16_t cid)
+{
+    channel_t *c = NULL;
+    for (size_t i = 0; i < L2C_COC_CHAN_MAX && c == NULL; ++i) {
+        if (_channels[i].cid == L2C_COC_CID_NONE) {
+            c = &_channels[i];
+        }
+    }
+    if (c) {
+        memset(c, 0, sizeof(*c));
+        c->cid = cid;
+    }
+    return c;
+}
+
+void L2cap::send_sdu(channel_t *channel)
+{
+    uint32_t remaining = channel->tx_size - channel->tx_offset;
+    channel->tx_sdu = remaining < channel->peer_mtu ? remaining : channel->peer_mtu;
+
+    // The stack copies the SDU before returning
+    L2cCocDataReq(
+        channel->cid,
+        channel->tx_sdu,
+        const_cast<uint8_t *>(channel->tx_data + channel->tx_offset)
+    );
+}
+
+void L2cap::end_transmission(channel_t *channel, ble_error_t status)
+{
+    if (!channel->tx_data) {
+        return;
+    }
+
+    channel->tx_data = NULL;
+    if (_eventHandler) {
+        _eventHandler->onDataSent(channel->cid, status);
+    }
+}
+
+void L2cap::on_connect(const l2cCocConnectInd_t &evt)
+{
+    // Channels opened by the peer are not known yet
+    channel_t *c = get_channel(evt.cid);
+    if (c == NULL) {
+        c = add_channel(evt.cid);
+        if (c == NULL) {
+            L2cCocDisconnectReq(evt.cid);
+            return;
+        }
+    }
+    c->peer_mtu = evt.peerMtu;
+
+    if (_eventHandler) {
+        _eventHandler->onChannelConnected(evt.hdr.param, evt.cid, evt.psm, evt.peerMtu);
+    }
+}
+
+void L2cap::on_disconnect(const l2cCocDisconnectInd_t &evt)
+{
+    channel_t *c = get_channel(evt.cid);
+    if (c == NULL) {
+        return;
+    }
+
+    end_transmission(c, BLE_ERROR_INVALID_STATE);
+    c->cid = L2C_COC_CID_NONE;
+
+    if (_eventHandler) {
+        _eventHandler->onChannelDisconnected(evt.hdr.param, evt.cid);
+    }
+}
+
+void L2cap::on_data_sent(const l2cCocDataCnf_t &evt)
+{
+    channel_t *c = get_channel(evt.cid);
+    if (c == NULL || !c->tx_data) {
+        return;
+    }
+
+    if (evt.hdr.status != L2C_COC_DATA_SUCCESS) {
+        end_transmission(
+            c,
+            evt.hdr.status == L2C_COC_DATA_ERR_MEMORY ? BLE_ERROR_NO_MEM : BLE_ERROR_UNSPECIFIED
+        );
+        return;
+    }
+
+    c->tx_offset += c->tx_sdu;
+    if (c->tx_offset == c->tx_size) {
+        end_transmission(c, BLE_ERROR_NONE);
+    } else {
+        send_sdu(c);
+    }
+}
+
+void L2cap::coc_cb(l2cCocEvt_t *evt)
+{
+    L2cap &self = getInstance();
+
+    switch (evt->hdr.event) {
+        case L2C_COC_CONNECT_IND:
+            self.on_connect(evt->connectInd);
+            break;
+
+        case L2C_COC_DISCONNECT_IND:
+            self.on_disconnect(evt->disconnectInd);
+            break;
+
+        case L2C_COC_DATA_IND:
+            if (self._eventHandler) {
+                self._eventHandler->onDataReceived(
+                    evt->dataInd.cid,
+                    evt->dataInd.pData,
+                    evt->dataInd.dataLen
+                );
+            }
+            break;
+
+        case L2C_COC_DATA_CNF:
+            self.on_data_sent(evt->dataCnf);
+            break;
+
+        default:
+            break;
+    }
+}
+
+} // namespace cordio
+} // namespace vendor
+} // namespace ble
+
+#endif // BLE_FEATURE_L2CAP_COC
@@ -475,6 +475,18 @@ ble_error_t Gap<EventHandler>::set_phy_(
     return BLE_ERROR_NONE;
 }
 
+template<class EventHandler>
+ble_error_t Gap<EventHandler>::set_data_length_(
+    connection_handle_t connection,
+    uint16_t tx_octets,
+    uint16_t tx_time
+)
+{
+    DmConnSetDataLen(connection, tx_octets, tx_time);
+
+    return BLE_ERROR_NONE;
+}
+
 // singleton of the ARM Cordio client
 template<class EventHandler>
 Gap<EventHandler> &Gap<EventHandler>::get_gap()
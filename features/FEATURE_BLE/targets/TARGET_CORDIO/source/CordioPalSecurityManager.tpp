@@ -18,10 +18,13 @@
 
 #include <string.h>
 
+#include "mbed_assert.h"
+
 #include "CordioPalSecurityManager.h"
 #include "dm_api.h"
 #include "att_api.h"
 #include "smp_api.h"
+#include "smp_main.h"
 #include "wsf_os.h"
 #include "hci_core.h"
 
@@ -35,6 +38,8 @@ CordioSecurityManager<EventHandler>::CordioSecurityManager() :
     _use_default_passkey(false),
     _default_passkey(0),
     _lesc_keys_generated(false),
+    _lesc_keys_requested(false),
+    _lesc_key_uses(0),
     _public_key_x(),
     _pending_privacy_control_blocks(NULL),
     _processing_privacy_control_block(false),
@@ -61,15 +66,15 @@ ble_error_t CordioSecurityManager<EventHandler>::initialize_()
     _use_default_passkey = false;
     _default_passkey = 0;
     _lesc_keys_generated = false;
+    _lesc_keys_requested = false;
+    _lesc_key_uses = 0;
 #if BLE_FEATURE_SIGNING
     memset(_peer_csrks, 0, sizeof(_peer_csrks));
 #endif
 
-#if 0
-    // FIXME: need help from the stack or local calculation
-    // generate a new set of keys
-    DmSecGenerateEccKeyReq();
-#endif
+    // Generate the first key pair ahead of the first pairing, the controller
+    // works on it while the application carries on
+    generate_lesc_keys();
 
     return BLE_ERROR_NONE;
 }
@@ -564,6 +569,53 @@ ble_error_t CordioSecurityManager<EventHandler>::secure_connections_oob_request_
     return BLE_ERROR_NONE;
 }
 
+template <class EventHandler>
+void CordioSecurityManager<EventHandler>::generate_lesc_keys()
+{
+#if BLE_FEATURE_SECURE_CONNECTIONS
+    // The controller replaces its private key when asked for a new public key,
+    // a pairing past the public key exchange would fail its DHKey check
+    if (_lesc_keys_requested || is_pairing_in_progress()) {
+        return;
+    }
+    _lesc_keys_requested = true;
+    DmSecGenerateEccKeyReq();
+#endif // BLE_FEATURE_SECURE_CONNECTIONS
+}
+
+template <class EventHandler>
+void CordioSecurityManager<EventHandler>::on_pairing_end(bool lesc_key_used)
+{
+#if BLE_FEATURE_SECURE_CONNECTIONS
+    if (lesc_key_used && _lesc_key_uses < 0xFFFF) {
+        _lesc_key_uses++;
+    }
+    // A new key pair deferred by a pairing in progress is requested at the end
+    // of the next one. A reuse count of 0 keeps the key pair until the
+    // security manager is reset.
+    if (!_lesc_keys_generated ||
+        (MBED_CONF_CORDIO_LESC_KEY_REUSE && _lesc_key_uses >= MBED_CONF_CORDIO_LESC_KEY_REUSE)) {
+        generate_lesc_keys();
+    }
+#endif // BLE_FEATURE_SECURE_CONNECTIONS
+}
+
+template <class EventHandler>
+bool CordioSecurityManager<EventHandler>::is_pairing_in_progress()
+{
+    // Legacy and secure connections state machines of both roles share the
+    // state of the connection control block, idle is 0 in all of them
+    MBED_STATIC_ASSERT(SMPI_SM_ST_IDLE == 0 && SMPR_SM_ST_IDLE == 0, "SMP idle state must be 0");
+    MBED_STATIC_ASSERT(SMPI_SC_SM_ST_IDLE == 0 && SMPR_SC_SM_ST_IDLE == 0, "SMP idle state must be 0");
+
+    for (size_t i = 0; i < DM_CONN_MAX; i++) {
+        if (smpCb.ccb[i].state != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 template <class EventHandler>
 CordioSecurityManager<EventHandler>& CordioSecurityManager<EventHandler>::get_security_manager()
 {
@@ -584,6 +636,7 @@ bool CordioSecurityManager<EventHandler>::sm_handler(const wsfMsgHdr_t* msg) {
         case DM_SEC_PAIR_CMPL_IND: {
             dmSecPairCmplIndEvt_t* evt = (dmSecPairCmplIndEvt_t*) msg;
             // Note: authentication and bonding flags present in the auth field
+            self.on_pairing_end(evt->auth & DM_AUTH_SC_FLAG);
             handler->on_pairing_completed(evt->hdr.param);
             return true;
         }
@@ -592,6 +645,9 @@ bool CordioSecurityManager<EventHandler>::sm_handler(const wsfMsgHdr_t* msg) {
             connection_handle_t connection = msg->param;
             uint8_t status = msg->status;
 
+            // The public key may have been sent before the failure
+            self.on_pairing_end(true);
+
             if (status >= pairing_failure_t::PASSKEY_ENTRY_FAILED &&
                 status <= pairing_failure_t::CROSS_TRANSPORT_KEY_DERIVATION_OR_GENERATION_NOT_ALLOWED) {
                 handler->on_pairing_error(
@@ -778,9 +834,16 @@ bool CordioSecurityManager<EventHandler>::sm_handler(const wsfMsgHdr_t* msg) {
 #if BLE_FEATURE_SECURE_CONNECTIONS
         case DM_SEC_ECC_KEY_IND: {
             secEccMsg_t* evt = (secEccMsg_t*) msg;
+            self._lesc_keys_requested = false;
+            // The controller computes the key pair and the DHKey, a controller
+            // without LE Secure Connections rejects the request
+            if (evt->hdr.status != HCI_SUCCESS) {
+                return true;
+            }
             DmSecSetEccKey(&evt->data.key);
             memcpy(self._public_key_x, evt->data.key.pubKey_x, sizeof(self._public_key_x));
             self._lesc_keys_generated = true;
+            self._lesc_key_uses = 0;
             return true;
         }
 #endif // BLE_FEATURE_SECURE_CONNECTIONS
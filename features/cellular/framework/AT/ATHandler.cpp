@@ -167,7 +167,6 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, uint32_t timeout, const
     _last_err(NSAPI_ERROR_OK),
     _last_3gpp_error(0),
     _oob_string_max_length(0),
-    _oobs(NULL),
     _at_timeout(timeout),
     _previous_at_timeout(timeout),
     _at_send_delay(send_delay),
@@ -195,6 +194,8 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, uint32_t timeout, const
         _output_delimiter = NULL;
     }
 
+    memset(_oobs, 0, sizeof(_oobs));
+
     reset_buffer();
     memset(_recv_buff, 0, sizeof(_recv_buff));
     memset(_info_resp_prefix, 0, sizeof(_info_resp_prefix));
@@ -221,10 +222,12 @@ ATHandler::~ATHandler()
 {
     set_file_handle(NULL);
 
-    while (_oobs) {
-        struct oob_t *oob = _oobs;
-        _oobs = oob->next;
-        delete oob;
+    for (int i = 0; i <= AT_HANDLER_OOB_BUCKETS; i++) {
+        while (_oobs[i]) {
+            struct oob_t *oob = _oobs[i];
+            _oobs[i] = oob->next;
+            delete oob;
+        }
     }
     if (_output_delimiter) {
         delete [] _output_delimiter;
@@ -300,20 +303,23 @@ void ATHandler::set_urc_handler(const char *prefix, Callback<void()> callback)
     oob->prefix = prefix;
     oob->prefix_len = prefix_len;
     oob->cb = callback;
-    oob->next = _oobs;
-    _oobs = oob;
+
+    int bucket = oob_bucket(prefix, prefix_len);
+    oob->next = _oobs[bucket];
+    _oobs[bucket] = oob;
 }
 
 void ATHandler::remove_urc_handler(const char *prefix)
 {
-    struct oob_t *current = _oobs;
+    int bucket = oob_bucket(prefix, strlen(prefix));
+    struct oob_t *current = _oobs[bucket];
     struct oob_t *prev = NULL;
     while (current) {
         if (strcmp(prefix, current->prefix) == 0) {
             if (prev) {
                 prev->next = current->next;
             } else {
-                _oobs = current->next;
+                _oobs[bucket] = current->next;
             }
             delete current;
             break;
@@ -325,7 +331,7 @@ void ATHandler::remove_urc_handler(const char *prefix)
 
 bool ATHandler::find_urc_handler(const char *prefix)
 {
-    struct oob_t *oob = _oobs;
+    struct oob_t *oob = _oobs[oob_bucket(prefix, strlen(prefix))];
     while (oob) {
         if (strcmp(prefix, oob->prefix) == 0) {
             return true;
@@ -471,20 +477,30 @@ bool ATHandler::fill_buffer(bool wait_for_timeout)
         reset_buffer();
     }
 
+    size_t len = read_fh(_recv_buff + _recv_len, sizeof(_recv_buff) - _recv_len, wait_for_timeout);
+    if (len) {
+        _recv_len += len;
+        return true;
+    }
+
+    return false;
+}
+
+size_t ATHandler::read_fh(void *buf, size_t len, bool wait_for_timeout)
+{
     pollfh fhs;
     fhs.fh = _fileHandle;
     fhs.events = POLLIN;
     int count = poll(&fhs, 1, poll_timeout(wait_for_timeout));
     if (count > 0 && (fhs.revents & POLLIN)) {
-        ssize_t len = _fileHandle->read(_recv_buff + _recv_len, sizeof(_recv_buff) - _recv_len);
-        if (len > 0) {
-            debug_print(_recv_buff + _recv_len, len, AT_RX);
-            _recv_len += len;
-            return true;
+        ssize_t ret = _fileHandle->read(buf, len);
+        if (ret > 0) {
+            debug_print((char *)buf, ret, AT_RX);
+            return ret;
         }
     }
 
-    return false;
+    return 0;
 }
 
 int ATHandler::get_char()
@@ -558,17 +574,41 @@ ssize_t ATHandler::read_bytes(uint8_t *buf, size_t len)
 
     bool debug_on = _debug_on;
     size_t read_len = 0;
-    for (; read_len < len; read_len++) {
-        int c = get_char();
-        if (c == -1) {
-            set_error(NSAPI_ERROR_DEVICE_ERROR);
-            _debug_on = debug_on;
-            return -1;
+    while (read_len < len) {
+        // copy what is already buffered
+        size_t copy_len = _recv_len - _recv_pos;
+        if (copy_len > len - read_len) {
+            copy_len = len - read_len;
         }
-        buf[read_len] = c;
+        memcpy(buf + read_len, _recv_buff + _recv_pos, copy_len);
+        _recv_pos += copy_len;
+        read_len += copy_len;
+
         if (_debug_on && read_len >= DEBUG_MAXLEN) {
             _debug_on = false;
         }
+
+        if (read_len == len) {
+            break;
+        }
+
+        // bulk data bypasses the receive buffer, anything smaller fills it
+        // to also pick up what follows
+        size_t fh_len;
+        if (len - read_len >= sizeof(_recv_buff)) {
+            fh_len = read_fh(buf + read_len, len - read_len, true);
+            read_len += fh_len;
+        } else {
+            reset_buffer();
+            fh_len = fill_buffer() ? 1 : 0;
+        }
+
+        if (!fh_len) {
+            tr_warn("AT timeout");
+            set_error(NSAPI_ERROR_DEVICE_ERROR);
+            _debug_on = debug_on;
+            return -1;
+        }
     }
     _debug_on = debug_on;
     return read_len;
@@ -660,6 +700,36 @@ ssize_t ATHandler::read_hex_string(char *buf, size_t size)
 
     bool debug_on = _debug_on;
     for (; read_idx < size * 2 + match_pos; read_idx++) {
+        if (!match_pos && !(read_idx % 2) && _recv_pos == _recv_len &&
+                size - read_idx / 2 >= sizeof(_recv_buff)) {
+            // Receive buffer is drained, read hex straight into caller memory and decode in place
+            char *hex = buf + read_idx / 2;
+            size_t len = read_fh(hex, sizeof(_recv_buff), true);
+            if (!len) {
+                set_error(NSAPI_ERROR_DEVICE_ERROR);
+                return -1;
+            }
+            size_t hex_len = 0;
+            while (hex_len < len && isxdigit((unsigned char)hex[hex_len])) {
+                hex_len++;
+            }
+            hex_len &= ~1;
+
+            // Whatever follows the hex pairs is parsed through the receive buffer
+            reset_buffer();
+            memcpy(_recv_buff, hex + hex_len, len - hex_len);
+            _recv_len = len - hex_len;
+
+            hex_str_to_char_str(hex, hex_len, hex);
+            read_idx += hex_len;
+            buf_idx = read_idx / 2 - 1;
+            if (_debug_on && read_idx >= DEBUG_MAXLEN) {
+                _debug_on = false;
+            }
+            read_idx--;
+            continue;
+        }
+
         int c = get_char();
 
         if (_debug_on && read_idx >= DEBUG_MAXLEN) {
@@ -807,11 +877,36 @@ bool ATHandler::match(const char *str, size_t size)
     return false;
 }
 
+int ATHandler::oob_bucket(const char *prefix, size_t prefix_len)
+{
+    if (prefix_len < AT_HANDLER_OOB_KEY_LENGTH) {
+        return AT_HANDLER_OOB_BUCKETS;
+    }
+
+    unsigned key = 0;
+    for (int i = 0; i < AT_HANDLER_OOB_KEY_LENGTH; i++) {
+        key = key * 31 + (uint8_t)prefix[i];
+    }
+    return key % AT_HANDLER_OOB_BUCKETS;
+}
+
 bool ATHandler::match_urc()
 {
     rewind_buffer();
+
+    // only URCs keyed by the start of the buffer can match, besides short ones
+    if (_recv_len >= AT_HANDLER_OOB_KEY_LENGTH &&
+            match_urc(_oobs[oob_bucket(_recv_buff, _recv_len)])) {
+        return true;
+    }
+
+    return match_urc(_oobs[AT_HANDLER_OOB_BUCKETS]);
+}
+
+bool ATHandler::match_urc(oob_t *oob)
+{
     size_t prefix_len = 0;
-    for (struct oob_t *oob = _oobs; oob; oob = oob->next) {
+    for (; oob; oob = oob->next) {
         prefix_len = oob->prefix_len;
         if (_recv_len >= prefix_len) {
             if (match(oob->prefix, prefix_len)) {
@@ -1343,6 +1438,69 @@ nsapi_error_t ATHandler::at_cmd_discard(const char *cmd, const char *cmd_chr, co
     return unlock_return_error();
 }
 
+nsapi_error_t ATHandler::at_cmd_pipeline(const at_cmd_t *cmds, size_t count, bool concatenate)
+{
+    lock();
+
+    const bool temp_state = get_debug();
+    size_t i = 0;
+    while (i < count && ok_to_proceed()) {
+        // Take as many commands as fit on the command line, at least one
+        size_t line_len = 2;
+        size_t n = 0;
+        do {
+            size_t cmd_len = strlen(cmds[i + n].cmd) + strlen(cmds[i + n].cmd_chr) + 1;
+            if (n && line_len + cmd_len > MBED_CONF_CELLULAR_AT_HANDLER_CMD_LINE_MAX) {
+                break;
+            }
+            line_len += cmd_len;
+            n++;
+        } while (concatenate && i + n < count);
+
+        set_debug(true);
+        cmd_start("AT");
+        for (size_t j = i; j < i + n; j++) {
+            // Extended commands need a separator before the next command, basic ones don't
+            if (j > i && cmds[j - 1].cmd[0] == '+') {
+                (void)write(";", 1);
+            }
+            (void)write(cmds[j].cmd, strlen(cmds[j].cmd));
+            (void)write(cmds[j].cmd_chr, strlen(cmds[j].cmd_chr));
+        }
+        cmd_stop();
+        set_debug(temp_state);
+
+        // Information responses come in command order before the final result
+        bool resp_started = false;
+        for (size_t j = i; j < i + n && ok_to_proceed(); j++) {
+            if (!cmds[j].parser) {
+                continue;
+            }
+            char prefix[BUFF_SIZE];
+            size_t len = strlen(cmds[j].cmd);
+            MBED_ASSERT(len + 2 <= sizeof(prefix));
+            memcpy(prefix, cmds[j].cmd, len);
+            prefix[len] = ':';
+            prefix[len + 1] = '\0';
+            resp_start(prefix);
+            resp_started = true;
+            if (get_scope() != InfoType) {
+                // final result already read, no more information responses on this line
+                break;
+            }
+            cmds[j].parser(*this);
+        }
+        if (!resp_started) {
+            resp_start();
+        }
+        resp_stop();
+
+        i += n;
+    }
+
+    return unlock_return_error();
+}
+
 void ATHandler::write_int(int32_t param)
 {
     // do common checks before sending subparameter
@@ -1404,6 +1562,49 @@ size_t ATHandler::write_bytes(const uint8_t *data, size_t len)
     return write(data, len);
 }
 
+size_t ATHandler::write_bytes_at_prompt(const char *prompt, const uint8_t *data, size_t len)
+{
+    resp_start(prompt, true);
+    if (!ok_to_proceed()) {
+        return 0;
+    }
+    if (!_prefix_matched) {
+        // got a final response instead, the modem is not waiting for data
+        set_error(NSAPI_ERROR_DEVICE_ERROR);
+        return 0;
+    }
+    _prefix_matched = false;
+
+    return write(data, len);
+}
+
+void ATHandler::write_hex_string(const uint8_t *data, size_t len, bool useQuotations)
+{
+    // do common checks before sending subparameter
+    if (check_cmd_send() == false) {
+        return;
+    }
+
+    if (useQuotations && write("\"", 1) != 1) {
+        return;
+    }
+
+    char hex[64];
+    while (len) {
+        size_t chunk = len < sizeof(hex) / 2 ? len : sizeof(hex) / 2;
+        int hex_len = char_str_to_hex_str((const char *)data, chunk, hex);
+        if (write(hex, hex_len) != (size_t)hex_len) {
+            return;
+        }
+        data += chunk;
+        len -= chunk;
+    }
+
+    if (useQuotations) {
+        (void)write("\"", 1);
+    }
+}
+
 size_t ATHandler::write(const void *data, size_t len)
 {
     pollfh fhs;
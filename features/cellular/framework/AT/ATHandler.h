@@ -45,6 +45,21 @@ extern const char *CRLF;
 
 #define BUFF_SIZE 32
 
+/** Size of the receive window, bulk reads of at least this size bypass it */
+#ifndef MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE
+#define MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE 32
+#endif
+
+/** URC handlers are kept in buckets by the first AT_HANDLER_OOB_KEY_LENGTH
+ *  characters of their prefix, plus one bucket for shorter prefixes */
+#define AT_HANDLER_OOB_BUCKETS 7
+#define AT_HANDLER_OOB_KEY_LENGTH 3
+
+/** Maximum length of a command line when concatenating commands in at_cmd_pipeline() */
+#ifndef MBED_CONF_CELLULAR_AT_HANDLER_CMD_LINE_MAX
+#define MBED_CONF_CELLULAR_AT_HANDLER_CMD_LINE_MAX 128
+#endif
+
 /* AT Error types enumeration */
 enum DeviceErrorType {
     DeviceErrorTypeNoError = 0,
@@ -122,7 +137,7 @@ public:
 
     /** Set callback function for URC
      *
-     *  @param prefix   URC text to look for, e.g. "+CMTI:". Maximum length is BUFF_SIZE.
+     *  @param prefix   URC text to look for, e.g. "+CMTI:". Maximum length is MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE.
      *  @param callback function to call on prefix, or 0 to remove callback
      */
     void set_urc_handler(const char *prefix, Callback<void()> callback);
@@ -238,7 +253,7 @@ private:
         Callback<void()> cb;
         oob_t *next;
     };
-    oob_t *_oobs;
+    oob_t *_oobs[AT_HANDLER_OOB_BUCKETS + 1];
     uint32_t _at_timeout;
     uint32_t _previous_at_timeout;
 
@@ -306,6 +321,33 @@ public:
      */
     nsapi_error_t at_cmd_discard(const char *cmd, const char *cmd_chr, const char *format = "", ...);
 
+    /** AT command queued to at_cmd_pipeline()
+     */
+    struct at_cmd_t {
+        /** AT command in form +<CMD>, or a basic command such as E0 */
+        const char *cmd;
+        /** Chars added to the AT command, e.g. "?" or "=1" */
+        const char *cmd_chr;
+        /** Reads the information response elements after the <CMD>: prefix is matched, NULL to discard the response */
+        mbed::Callback<void(ATHandler &)> parser;
+    };
+
+    /**
+     * @brief at_cmd_pipeline Send independent AT commands and read their responses. Locks and unlocks ATHandler for operation.
+     *        When concatenate is set, the commands are sent back-to-back on as few command lines as fit
+     *        MBED_CONF_CELLULAR_AT_HANDLER_CMD_LINE_MAX, e.g. "ATE0+CMEE=1;+CFUN=1", and the modem replies with a single
+     *        final result per line instead of one round trip per command. Otherwise the commands are sent one by one.
+     *        NOTE: A failing command aborts the rest of its command line, so the failure can't be attributed to a single command.
+     *        A command given a parser must have an information response, otherwise the responses of the commands
+     *        following it on the same line are discarded.
+     *
+     * @param cmds AT commands in the order they are sent; responses are parsed in the same order
+     * @param count number of commands
+     * @param concatenate true if modem supports command concatenation, see AT_CellularBase::PROPERTY_AT_CMD_CONCATENATION
+     * @return last error that happened when parsing AT responses
+     */
+    nsapi_error_t at_cmd_pipeline(const at_cmd_t *cmds, size_t count, bool concatenate = true);
+
 public:
 
     /** Writes integer type AT command subparameter. Starts with the delimiter if not the first param after cmd_start.
@@ -343,6 +385,31 @@ public:
      */
     size_t write_bytes(const uint8_t *data, size_t len);
 
+    /** Waits for the data prompt of a send command, such as "> " after AT+QISEND=<id>,<len>, and writes
+     *  the data after it. Modems that take socket data this way need half the bytes over the serial line
+     *  compared to hex encoded data, so prefer this to write_hex_string whenever the modem supports it.
+     *  The response to the data is read with resp_start() as usual.
+     *  If the prompt is not received, nothing is written and the last error is set.
+     *
+     *  @param prompt   data prompt sent by the modem
+     *  @param data     bytes to be written to modem
+     *  @param len      length of data
+     *
+     *  @return         number of bytes successfully written
+     */
+    size_t write_bytes_at_prompt(const char *prompt, const uint8_t *data, size_t len);
+
+    /** Writes bytes as a hex string subparameter, for example "AV" as "4156", for modems that take
+     *  socket data only in hex. Starts with the delimiter if not the first param after cmd_start.
+     *  Encodes in pieces while writing, without a buffer for the whole string.
+     *  In case of failure when writing, the last error is set to NSAPI_ERROR_DEVICE_ERROR.
+     *
+     *  @param data     bytes to be written to modem
+     *  @param len      length of data
+     *  @param useQuotations flag indicating whether the string should be included in quotation marks
+     */
+    void write_hex_string(const uint8_t *data, size_t len, bool useQuotations = false);
+
     /** Sets the stop tag for the current scope (response/information response/element)
      *  Parameter's reading routines will stop the reading when such tag is found and will set the found flag.
      *  Consume routines will read everything until such tag is found.
@@ -495,7 +562,7 @@ public: // just for debugging
 private:
 
     // should fit any prefix and int
-    char _recv_buff[BUFF_SIZE];
+    char _recv_buff[MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE];
     // reading position
     size_t _recv_len;
     // reading length
@@ -572,6 +639,9 @@ private:
     // Reads from serial to receiving buffer.
     // Returns true on successful read OR false on timeout.
     bool fill_buffer(bool wait_for_timeout = true);
+    // Reads from serial straight to buf, waiting for data if wait_for_timeout.
+    // Returns number of bytes read OR 0 on timeout.
+    size_t read_fh(void *buf, size_t len, bool wait_for_timeout);
 
     void set_tag(tag_t *tag_dest, const char *tag_seq);
 
@@ -581,6 +651,10 @@ private:
     // If URC match sets the scope to information response and after urc's cb returns
     // finishes the information response scope(consumes to CRLF).
     bool match_urc();
+    // Matches URCs of one bucket, see match_urc.
+    bool match_urc(oob_t *oob);
+    // Bucket of the URC handlers for a prefix.
+    static int oob_bucket(const char *prefix, size_t prefix_len);
     // Checks if any of the error strings are matching the receiving buffer content.
     bool match_error();
     // Checks if current char in buffer matches ch and consumes it,
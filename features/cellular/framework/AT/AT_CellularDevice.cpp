@@ -424,13 +424,16 @@ void AT_CellularDevice::modem_debug_on(bool on)
 
 nsapi_error_t AT_CellularDevice::init()
 {
+    const ATHandler::at_cmd_t cmds[] = {
+        { "E0", "", NULL },
+        { "+CMEE", "=1", NULL },
+        { "+CFUN", "=1", NULL },
+    };
+
     _at->lock();
     _at->flush();
-    _at->at_cmd_discard("E0", "");
-
-    _at->at_cmd_discard("+CMEE", "=1");
-
-    _at->at_cmd_discard("+CFUN", "=1");
+    _at->at_cmd_pipeline(cmds, sizeof(cmds) / sizeof(cmds[0]),
+                         AT_CellularBase::get_property(AT_CellularBase::PROPERTY_AT_CMD_CONCATENATION));
 
     return _at->unlock_return_error();
 }
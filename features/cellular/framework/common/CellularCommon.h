@@ -68,6 +68,9 @@ typedef enum cellular_event_status {
     CellularDeviceTimeout                   = NSAPI_EVENT_CELLULAR_STATUS_BASE + 10,/* cell_callback_data_t.error contain an error or NSAPI_ERROR_OK,
                                                                                        cell_callback_data_t.status_data contains the current cellular_connection_status_t,
                                                                                        cellular_event_status.data contains new timeout value in milliseconds */
+    CellularStateTime                       = NSAPI_EVENT_CELLULAR_STATUS_BASE + 11,/* Sent when the state machine has completed a state. cell_callback_data_t.status_data contains the state:
+                                                                                       0 init, 1 power on, 2 device ready, 3 SIM pin, 4 signal quality, 5 registering network, 6 attaching network.
+                                                                                       cellular_event_status.data points to an int with the time spent in the state, retries included, in milliseconds */
 } cellular_connection_status_t;
 
 #endif // CELLULAR_COMMON_
@@ -0,0 +1,711 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "CellularMux.h"
+#include "mbed_poll.h"
+#include "Kernel.h"
+#include "CellularLog.h"
+
+using namespace mbed;
+
+// Frame delimiter of the basic option
+#define MUX_FLAG            0xF9
+
+// Address field: EA bit, C/R bit and DLCI
+#define MUX_EA              0x01
+#define MUX_CR              0x02
+#define MUX_COMMAND(dlci)   (((dlci) << 2) | MUX_CR | MUX_EA)
+#define MUX_RESPONSE(dlci)  (((dlci) << 2) | MUX_EA)
+
+// Control field frame types, P/F bit cleared
+#define MUX_SABM            0x2F
+#define MUX_UA              0x63
+#define MUX_DM              0x0F
+#define MUX_DISC            0x43
+#define MUX_UIH             0xEF
+#define MUX_UI              0x03
+#define MUX_PF              0x10
+
+// Control channel message types, with EA bit and without C/R bit
+#define MUX_MSG_CLD         0xC1
+#define MUX_MSG_TEST        0x21
+#define MUX_MSG_MSC         0xE1
+#define MUX_MSG_NSC         0x11
+
+// V.24 signals of a modem status command: EA, RTC, RTR and DV set, FC as needed
+#define MUX_V24_SIGNALS     0x8D
+#define MUX_V24_FC          0x02
+
+// FCS of a frame checked together with its received FCS
+#define MUX_FCS_GOOD        0xCF
+
+enum channel_state {
+    CHANNEL_CLOSED,
+    CHANNEL_OPENING,
+    CHANNEL_OPEN,
+    CHANNEL_CLOSING
+};
+
+// CRC-8 of TS 27.010, reversed polynomial x^8 + x^2 + x + 1
+static uint8_t fcs_update(uint8_t fcs, uint8_t byte)
+{
+    fcs ^= byte;
+    for (int i = 0; i < 8; i++) {
+        fcs = (fcs & 1) ? (fcs >> 1) ^ 0xE0 : fcs >> 1;
+    }
+    return fcs;
+}
+
+CellularMux::Channel::Channel() : _mux(NULL), _dlci(0), _state(CHANNEL_CLOSED), _blocking(true),
+    _throttled(false), _head(0), _count(0)
+{
+}
+
+ssize_t CellularMux::Channel::read(void *buffer, size_t size)
+{
+    return _mux->channel_read(this, buffer, size);
+}
+
+ssize_t CellularMux::Channel::write(const void *buffer, size_t size)
+{
+    return _mux->channel_write(this, buffer, size);
+}
+
+off_t CellularMux::Channel::seek(off_t offset, int whence)
+{
+    return -ESPIPE;
+}
+
+int CellularMux::Channel::close()
+{
+    return _mux->channel_close(this);
+}
+
+int CellularMux::Channel::set_blocking(bool blocking)
+{
+    _blocking = blocking;
+    return 0;
+}
+
+bool CellularMux::Channel::is_blocking() const
+{
+    return _blocking;
+}
+
+short CellularMux::Channel::poll(short events) const
+{
+    return _mux->channel_poll(this, events);
+}
+
+bool CellularMux::Channel::wakes_poll() const
+{
+    return _mux->_fh->wakes_poll();
+}
+
+void CellularMux::Channel::sigio(Callback<void()> func)
+{
+    _sigio = func;
+    if (_sigio) {
+        _sigio();
+    }
+}
+
+CellularMux::CellularMux(FileHandle *fh) : _fh(fh), _control_state(CHANNEL_CLOSED), _started(false),
+    _dropped(0), _rx_state(RX_FLAG), _rx_address(0), _rx_control(0), _rx_length(0), _rx_pos(0), _rx_fcs(0)
+{
+    for (int i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNELS; i++) {
+        _channels[i]._mux = this;
+    }
+}
+
+CellularMux::~CellularMux()
+{
+    if (_started) {
+        stop();
+    }
+}
+
+nsapi_error_t CellularMux::start(bool send_cmux)
+{
+    if (_started) {
+        return NSAPI_ERROR_OK;
+    }
+
+    _fh->set_blocking(false);
+    _rx_state = RX_FLAG;
+    _dropped = 0;
+
+    if (send_cmux) {
+        char cmd[32];
+        int len = snprintf(cmd, sizeof(cmd), "AT+CMUX=0,0,5,%d\r", MBED_CONF_CELLULAR_MUX_FRAME_SIZE);
+        nsapi_error_t err = write_all((const uint8_t *)cmd, len);
+        if (err == NSAPI_ERROR_OK) {
+            err = wait_ok();
+        }
+        if (err != NSAPI_ERROR_OK) {
+            tr_error("CMUX: AT+CMUX failed %d", err);
+            _fh->set_blocking(true);
+            return err;
+        }
+    }
+
+    _fh->sigio(Callback<void()>(this, &CellularMux::serial_event));
+
+    _control_state = CHANNEL_OPENING;
+    nsapi_error_t err = send_frame(MUX_COMMAND(0), MUX_SABM | MUX_PF, NULL, 0);
+    if (err == NSAPI_ERROR_OK) {
+        err = wait_state(&_control_state, CHANNEL_OPENING);
+    }
+    if (err == NSAPI_ERROR_OK && _control_state != CHANNEL_OPEN) {
+        err = NSAPI_ERROR_DEVICE_ERROR;
+    }
+    if (err != NSAPI_ERROR_OK) {
+        tr_error("CMUX: control channel failed %d", err);
+        _control_state = CHANNEL_CLOSED;
+        _fh->sigio(NULL);
+        _fh->set_blocking(true);
+        return err;
+    }
+
+    _started = true;
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t CellularMux::stop()
+{
+    if (!_started) {
+        return NSAPI_ERROR_OK;
+    }
+
+    for (int i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNELS; i++) {
+        if (_channels[i]._state != CHANNEL_CLOSED) {
+            channel_close(&_channels[i]);
+        }
+    }
+
+    // Close down: the modem answers and returns to AT command mode
+    const uint8_t cld[] = { MUX_MSG_CLD | MUX_CR, MUX_EA };
+    _control_state = CHANNEL_CLOSING;
+    nsapi_error_t err = send_frame(MUX_COMMAND(0), MUX_UIH, cld, sizeof(cld));
+    if (err == NSAPI_ERROR_OK) {
+        err = wait_state(&_control_state, CHANNEL_CLOSING);
+    }
+
+    _control_state = CHANNEL_CLOSED;
+    _started = false;
+    _fh->sigio(NULL);
+    _fh->set_blocking(true);
+    return err;
+}
+
+FileHandle *CellularMux::open_channel(int dlci)
+{
+    if (!_started || dlci < 1 || dlci > 63) {
+        return NULL;
+    }
+
+    _rx_mutex.lock();
+    Channel *ch = find_channel(dlci);
+    if (ch) {
+        // Already open
+        _rx_mutex.unlock();
+        return NULL;
+    }
+    for (int i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNELS; i++) {
+        if (_channels[i]._state == CHANNEL_CLOSED) {
+            ch = &_channels[i];
+            break;
+        }
+    }
+    if (!ch) {
+        _rx_mutex.unlock();
+        return NULL;
+    }
+    ch->_dlci = dlci;
+    ch->_head = 0;
+    ch->_count = 0;
+    ch->_throttled = false;
+    ch->_state = CHANNEL_OPENING;
+    _rx_mutex.unlock();
+
+    nsapi_error_t err = send_frame(MUX_COMMAND(dlci), MUX_SABM | MUX_PF, NULL, 0);
+    if (err == NSAPI_ERROR_OK) {
+        err = wait_state(&ch->_state, CHANNEL_OPENING);
+    }
+    if (err == NSAPI_ERROR_OK && ch->_state == CHANNEL_OPEN) {
+        // Modems hold back data until the V.24 signals of the channel are set
+        err = send_msc(dlci, false);
+    }
+    if (err != NSAPI_ERROR_OK || ch->_state != CHANNEL_OPEN) {
+        tr_error("CMUX: channel %d failed %d", dlci, err);
+        ch->_state = CHANNEL_CLOSED;
+        return NULL;
+    }
+
+    return ch;
+}
+
+uint32_t CellularMux::get_dropped_bytes() const
+{
+    return _dropped;
+}
+
+void CellularMux::serial_event()
+{
+    // Frames are decoded by the readers, only tell them there's something
+    for (int i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNELS; i++) {
+        if (_channels[i]._state != CHANNEL_CLOSED) {
+            wake(&_channels[i]);
+        }
+    }
+}
+
+void CellularMux::wake(Channel *ch)
+{
+    poll_wake(ch);
+    if (ch->_sigio) {
+        ch->_sigio();
+    }
+}
+
+CellularMux::Channel *CellularMux::find_channel(uint8_t dlci)
+{
+    for (int i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNELS; i++) {
+        if (_channels[i]._state != CHANNEL_CLOSED && _channels[i]._dlci == dlci) {
+            return &_channels[i];
+        }
+    }
+    return NULL;
+}
+
+// Called with _rx_mutex held
+void CellularMux::process()
+{
+    uint8_t buf[64];
+    ssize_t len;
+
+    while ((len = _fh->read(buf, sizeof(buf))) > 0) {
+        for (ssize_t i = 0; i < len; i++) {
+            uint8_t byte = buf[i];
+
+            switch (_rx_state) {
+                case RX_FLAG:
+                    if (byte == MUX_FLAG) {
+                        _rx_state = RX_ADDRESS;
+                    }
+                    break;
+                case RX_ADDRESS:
+                    // Repeated flags between frames are skipped
+                    if (byte != MUX_FLAG) {
+                        _rx_address = byte;
+                        _rx_fcs = fcs_update(0xFF, byte);
+                        _rx_state = RX_CONTROL;
+                    }
+                    break;
+                case RX_CONTROL:
+                    _rx_control = byte;
+                    _rx_fcs = fcs_update(_rx_fcs, byte);
+                    _rx_state = RX_LENGTH;
+                    break;
+                case RX_LENGTH:
+                    _rx_fcs = fcs_update(_rx_fcs, byte);
+                    _rx_length = byte >> 1;
+                    _rx_pos = 0;
+                    if (!(byte & MUX_EA)) {
+                        _rx_state = RX_LENGTH2;
+                    } else if (_rx_length > MBED_CONF_CELLULAR_MUX_FRAME_SIZE) {
+                        _rx_state = RX_FLAG;
+                    } else {
+                        _rx_state = _rx_length ? RX_DATA : RX_FCS;
+                    }
+                    break;
+                case RX_LENGTH2:
+                    _rx_fcs = fcs_update(_rx_fcs, byte);
+                    _rx_length |= byte << 7;
+                    if (_rx_length > MBED_CONF_CELLULAR_MUX_FRAME_SIZE) {
+                        _rx_state = RX_FLAG;
+                    } else {
+                        _rx_state = _rx_length ? RX_DATA : RX_FCS;
+                    }
+                    break;
+                case RX_DATA:
+                    _rx_frame[_rx_pos++] = byte;
+                    if (_rx_pos == _rx_length) {
+                        _rx_state = RX_FCS;
+                    }
+                    break;
+                case RX_FCS:
+                    // The FCS of UIH frames only covers the header
+                    if (fcs_update(_rx_fcs, byte) == MUX_FCS_GOOD) {
+                        _rx_state = RX_END;
+                    } else {
+                        tr_warn("CMUX: bad FCS");
+                        _rx_state = RX_FLAG;
+                    }
+                    break;
+                case RX_END:
+                    if (byte == MUX_FLAG) {
+                        process_frame();
+                        // The closing flag may also open the next frame
+                        _rx_state = RX_ADDRESS;
+                    } else {
+                        _rx_state = RX_FLAG;
+                    }
+                    break;
+            }
+        }
+    }
+}
+
+// Called with _rx_mutex held
+void CellularMux::process_frame()
+{
+    uint8_t dlci = _rx_address >> 2;
+    uint8_t type = _rx_control & ~MUX_PF;
+
+    if (type == MUX_UIH || type == MUX_UI) {
+        if (dlci == 0) {
+            process_control(_rx_frame, _rx_length);
+        } else {
+            Channel *ch = find_channel(dlci);
+            if (ch && ch->_state == CHANNEL_OPEN) {
+                deliver(ch, _rx_frame, _rx_length);
+            }
+        }
+        return;
+    }
+
+    Channel *ch = dlci ? find_channel(dlci) : NULL;
+    volatile uint8_t *state = dlci ? (ch ? &ch->_state : NULL) : &_control_state;
+
+    switch (type) {
+        case MUX_UA:
+            if (state && *state == CHANNEL_OPENING) {
+                *state = CHANNEL_OPEN;
+            } else if (state && *state == CHANNEL_CLOSING) {
+                *state = CHANNEL_CLOSED;
+            }
+            break;
+        case MUX_DM:
+            if (state) {
+                *state = CHANNEL_CLOSED;
+            }
+            break;
+        case MUX_DISC:
+            // Closed by the modem, readers see a hang-up
+            send_frame(MUX_RESPONSE(dlci), MUX_UA | MUX_PF, NULL, 0);
+            if (state) {
+                *state = CHANNEL_CLOSED;
+            }
+            break;
+        case MUX_SABM:
+            // Channels are only opened from this end
+            send_frame(MUX_RESPONSE(dlci), MUX_DM | MUX_PF, NULL, 0);
+            return;
+        default:
+            return;
+    }
+
+    if (ch) {
+        wake(ch);
+    }
+}
+
+// Called with _rx_mutex held
+void CellularMux::process_control(const uint8_t *data, uint16_t len)
+{
+    if (len < 2) {
+        return;
+    }
+
+    uint8_t msg = data[0] & ~MUX_CR;
+    bool command = data[0] & MUX_CR;
+
+    if (!command) {
+        if (msg == MUX_MSG_CLD && _control_state == CHANNEL_CLOSING) {
+            _control_state = CHANNEL_CLOSED;
+        }
+        return;
+    }
+
+    if (msg == MUX_MSG_MSC || msg == MUX_MSG_TEST) {
+        // Acknowledged by sending the message back as a response
+        uint8_t response[MBED_CONF_CELLULAR_MUX_FRAME_SIZE];
+        memcpy(response, data, len);
+        response[0] = msg;
+        send_frame(MUX_COMMAND(0), MUX_UIH, response, len);
+    } else {
+        const uint8_t nsc[] = { MUX_MSG_NSC, (1 << 1) | MUX_EA, data[0] };
+        send_frame(MUX_COMMAND(0), MUX_UIH, nsc, sizeof(nsc));
+    }
+}
+
+// Called with _rx_mutex held
+void CellularMux::deliver(Channel *ch, const uint8_t *data, uint16_t len)
+{
+    const uint16_t size = sizeof(ch->_buffer);
+    uint16_t space = size - ch->_count;
+
+    if (len > space) {
+        _dropped += len - space;
+        len = space;
+    }
+    for (uint16_t i = 0; i < len; i++) {
+        ch->_buffer[(ch->_head + ch->_count + i) % size] = data[i];
+    }
+    ch->_count += len;
+
+    // Pause the channel while less than two frames fit
+    if (!ch->_throttled && size - ch->_count < 2 * MBED_CONF_CELLULAR_MUX_FRAME_SIZE) {
+        ch->_throttled = true;
+        send_msc(ch->_dlci, true);
+    }
+
+    if (len) {
+        wake(ch);
+    }
+}
+
+ssize_t CellularMux::channel_read(Channel *ch, void *buffer, size_t size)
+{
+    while (true) {
+        _rx_mutex.lock();
+        process();
+
+        const uint16_t buffer_size = sizeof(ch->_buffer);
+        size_t len = size < ch->_count ? size : ch->_count;
+        for (size_t i = 0; i < len; i++) {
+            ((uint8_t *)buffer)[i] = ch->_buffer[ch->_head];
+            ch->_head = (ch->_head + 1) % buffer_size;
+        }
+        ch->_count -= len;
+
+        if (ch->_throttled && ch->_count <= buffer_size / 2) {
+            ch->_throttled = false;
+            send_msc(ch->_dlci, false);
+        }
+
+        uint8_t state = ch->_state;
+        _rx_mutex.unlock();
+
+        if (len) {
+            return len;
+        } else if (state != CHANNEL_OPEN) {
+            return 0;
+        } else if (!ch->_blocking) {
+            return -EAGAIN;
+        }
+
+        pollfh fhs;
+        fhs.fh = ch;
+        fhs.events = POLLIN;
+        poll(&fhs, 1, -1);
+    }
+}
+
+ssize_t CellularMux::channel_write(Channel *ch, const void *buffer, size_t size)
+{
+    const uint8_t *data = (const uint8_t *)buffer;
+    size_t written = 0;
+
+    while (written < size) {
+        if (ch->_state != CHANNEL_OPEN) {
+            return written ? (ssize_t)written : -EPIPE;
+        }
+
+        uint16_t len = size - written;
+        if (len > MBED_CONF_CELLULAR_MUX_FRAME_SIZE) {
+            len = MBED_CONF_CELLULAR_MUX_FRAME_SIZE;
+        }
+        if (send_frame(MUX_COMMAND(ch->_dlci), MUX_UIH, data + written, len) != NSAPI_ERROR_OK) {
+            return written ? (ssize_t)written : -EIO;
+        }
+        written += len;
+    }
+
+    return written;
+}
+
+int CellularMux::channel_close(Channel *ch)
+{
+    if (ch->_state != CHANNEL_OPEN) {
+        ch->_state = CHANNEL_CLOSED;
+        return 0;
+    }
+
+    ch->_state = CHANNEL_CLOSING;
+    nsapi_error_t err = send_frame(MUX_COMMAND(ch->_dlci), MUX_DISC | MUX_PF, NULL, 0);
+    if (err == NSAPI_ERROR_OK) {
+        err = wait_state(&ch->_state, CHANNEL_CLOSING);
+    }
+
+    _rx_mutex.lock();
+    ch->_state = CHANNEL_CLOSED;
+    ch->_count = 0;
+    _rx_mutex.unlock();
+    wake(ch);
+
+    return err == NSAPI_ERROR_OK ? 0 : -EIO;
+}
+
+short CellularMux::channel_poll(const Channel *ch, short events)
+{
+    short revents = 0;
+
+    _rx_mutex.lock();
+    process();
+    if (ch->_count) {
+        revents |= POLLIN;
+    }
+    if (ch->_state != CHANNEL_OPEN) {
+        revents |= POLLHUP;
+    }
+    _rx_mutex.unlock();
+
+    if ((events & POLLOUT) && (_fh->poll(POLLOUT) & POLLOUT)) {
+        revents |= POLLOUT;
+    }
+
+    return revents;
+}
+
+nsapi_error_t CellularMux::send_frame(uint8_t address, uint8_t control, const uint8_t *data, uint16_t len)
+{
+    uint8_t header[5];
+    uint8_t header_len = 0;
+
+    header[header_len++] = MUX_FLAG;
+    header[header_len++] = address;
+    header[header_len++] = control;
+    if (len > 127) {
+        header[header_len++] = len << 1;
+        header[header_len++] = len >> 7;
+    } else {
+        header[header_len++] = (len << 1) | MUX_EA;
+    }
+
+    uint8_t fcs = 0xFF;
+    for (uint8_t i = 1; i < header_len; i++) {
+        fcs = fcs_update(fcs, header[i]);
+    }
+    const uint8_t trailer[2] = { (uint8_t)(0xFF - fcs), MUX_FLAG };
+
+    _tx_mutex.lock();
+    nsapi_error_t err = write_all(header, header_len);
+    if (err == NSAPI_ERROR_OK && len) {
+        err = write_all(data, len);
+    }
+    if (err == NSAPI_ERROR_OK) {
+        err = write_all(trailer, sizeof(trailer));
+    }
+    _tx_mutex.unlock();
+
+    return err;
+}
+
+nsapi_error_t CellularMux::send_msc(uint8_t dlci, bool flow_off)
+{
+    const uint8_t msc[] = { MUX_MSG_MSC | MUX_CR, (2 << 1) | MUX_EA, (uint8_t)((dlci << 2) | MUX_CR | MUX_EA),
+                            (uint8_t)(MUX_V24_SIGNALS | (flow_off ? MUX_V24_FC : 0))
+                          };
+    return send_frame(MUX_COMMAND(0), MUX_UIH, msc, sizeof(msc));
+}
+
+nsapi_error_t CellularMux::write_all(const uint8_t *data, size_t len)
+{
+    while (len) {
+        ssize_t ret = _fh->write(data, len);
+        if (ret == -EAGAIN) {
+            pollfh fhs;
+            fhs.fh = _fh;
+            fhs.events = POLLOUT;
+            poll(&fhs, 1, -1);
+            continue;
+        } else if (ret < 0) {
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
+        data += ret;
+        len -= ret;
+    }
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t CellularMux::wait_state(volatile uint8_t *state, uint8_t pending)
+{
+    uint64_t start = rtos::Kernel::get_ms_count();
+
+    while (true) {
+        _rx_mutex.lock();
+        process();
+        _rx_mutex.unlock();
+        if (*state != pending) {
+            return NSAPI_ERROR_OK;
+        }
+
+        // Frames may also be decoded by readers of other channels meanwhile
+        int64_t remaining = MBED_CONF_CELLULAR_MUX_TIMEOUT - (int64_t)(rtos::Kernel::get_ms_count() - start);
+        if (remaining <= 0) {
+            return NSAPI_ERROR_TIMEOUT;
+        }
+        pollfh fhs;
+        fhs.fh = _fh;
+        fhs.events = POLLIN;
+        if (poll(&fhs, 1, remaining < 10 ? remaining : 10) < 0) {
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
+    }
+}
+
+nsapi_error_t CellularMux::wait_ok()
+{
+    uint64_t start = rtos::Kernel::get_ms_count();
+    char line[16];
+    size_t len = 0;
+
+    while (true) {
+        char c;
+        if (_fh->read(&c, 1) == 1) {
+            if (c != '\r' && c != '\n') {
+                if (len < sizeof(line) - 1) {
+                    line[len++] = c;
+                }
+                continue;
+            }
+            line[len] = '\0';
+            len = 0;
+            if (strcmp(line, "OK") == 0) {
+                return NSAPI_ERROR_OK;
+            } else if (strncmp(line, "ERROR", 5) == 0 || strncmp(line, "+CME ERROR", 10) == 0) {
+                return NSAPI_ERROR_DEVICE_ERROR;
+            }
+            continue;
+        }
+
+        int64_t remaining = MBED_CONF_CELLULAR_MUX_TIMEOUT - (int64_t)(rtos::Kernel::get_ms_count() - start);
+        if (remaining <= 0) {
+            return NSAPI_ERROR_TIMEOUT;
+        }
+        pollfh fhs;
+        fhs.fh = _fh;
+        fhs.events = POLLIN;
+        if (poll(&fhs, 1, remaining) <= 0) {
+            return NSAPI_ERROR_TIMEOUT;
+        }
+    }
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELLULAR_MUX_H_
+#define CELLULAR_MUX_H_
+
+#include "FileHandle.h"
+#include "PlatformMutex.h"
+#include "NonCopyable.h"
+#include "nsapi_types.h"
+
+/** Number of channels that can be open at once, besides the control channel */
+#ifndef MBED_CONF_CELLULAR_MUX_CHANNELS
+#define MBED_CONF_CELLULAR_MUX_CHANNELS 2
+#endif
+
+/** Maximum information field length of a frame, N1 of 3GPP TS 27.010 */
+#ifndef MBED_CONF_CELLULAR_MUX_FRAME_SIZE
+#define MBED_CONF_CELLULAR_MUX_FRAME_SIZE 127
+#endif
+
+/** Receive buffer size of each channel */
+#ifndef MBED_CONF_CELLULAR_MUX_BUFFER_SIZE
+#define MBED_CONF_CELLULAR_MUX_BUFFER_SIZE 1024
+#endif
+
+/** Time to wait for the modem to answer a mux command, in milliseconds */
+#ifndef MBED_CONF_CELLULAR_MUX_TIMEOUT
+#define MBED_CONF_CELLULAR_MUX_TIMEOUT 3000
+#endif
+
+namespace mbed {
+
+/** Class CellularMux
+ *
+ *  3GPP TS 27.010 basic option multiplexer. Presents several virtual
+ *  FileHandle channels over the one serial line to the modem, so that for
+ *  example a PPP data session and AT commands can run at the same time:
+ *
+ *  @code
+ *  UARTSerial serial(MDMTXD, MDMRXD);
+ *  CellularMux mux(&serial);
+ *  mux.start();
+ *  FileHandle *at = mux.open_channel(1);
+ *  FileHandle *data = mux.open_channel(2);
+ *  CellularDevice *device = new QUECTEL_BG96(at);
+ *  CellularContext *context = device->create_context(data);
+ *  @endcode
+ *
+ *  Received frames are decoded by whichever thread reads or polls a
+ *  channel, no thread of its own is needed. Writes are sent as whole frames
+ *  and wait for the serial line even on non-blocking channels. A channel
+ *  whose receive buffer fills up is paused with flow control until it is
+ *  read.
+ */
+class CellularMux : private NonCopyable<CellularMux> {
+public:
+    /** Constructor
+     *
+     *  @param fh   serial line to the modem, put in non-blocking mode while the mux runs
+     */
+    CellularMux(FileHandle *fh);
+    ~CellularMux();
+
+    /** Switch the modem to mux mode and open the control channel
+     *
+     *  @param send_cmux    send AT+CMUX=0,0,5,<frame size> first. Use false if the
+     *                      modem was already told to start muxing, for example
+     *                      with modem specific parameters
+     *  @return             NSAPI_ERROR_OK on success
+     *                      NSAPI_ERROR_DEVICE_ERROR if the modem refused
+     *                      NSAPI_ERROR_TIMEOUT if the modem did not answer
+     */
+    nsapi_error_t start(bool send_cmux = true);
+
+    /** Close all channels and switch the modem back to AT command mode
+     *
+     *  @return NSAPI_ERROR_OK on success, NSAPI_ERROR_TIMEOUT if the modem did not answer
+     */
+    nsapi_error_t stop();
+
+    /** Open a channel
+     *
+     *  The returned FileHandle stays owned by the mux. Closing it closes the
+     *  channel, after which it can be opened again.
+     *
+     *  @param dlci     data link connection identifier, 1 to 63
+     *  @return         channel, or NULL if the mux is not started, no
+     *                  channel is free or the modem refused it
+     */
+    FileHandle *open_channel(int dlci);
+
+    /** Get the number of received bytes dropped because a channel buffer was full
+     *
+     *  @return number of dropped bytes since start()
+     */
+    uint32_t get_dropped_bytes() const;
+
+private:
+    class Channel : public FileHandle {
+    public:
+        Channel();
+        virtual ssize_t read(void *buffer, size_t size);
+        virtual ssize_t write(const void *buffer, size_t size);
+        virtual off_t seek(off_t offset, int whence = SEEK_SET);
+        virtual int close();
+        virtual int set_blocking(bool blocking);
+        virtual bool is_blocking() const;
+        virtual short poll(short events) const;
+        virtual bool wakes_poll() const;
+        virtual void sigio(Callback<void()> func);
+
+        CellularMux *_mux;
+        Callback<void()> _sigio;
+        uint8_t _dlci;
+        volatile uint8_t _state;
+        bool _blocking;
+        bool _throttled;
+        uint16_t _head;
+        uint16_t _count;
+        uint8_t _buffer[MBED_CONF_CELLULAR_MUX_BUFFER_SIZE];
+    };
+
+    enum rx_state {
+        RX_FLAG,
+        RX_ADDRESS,
+        RX_CONTROL,
+        RX_LENGTH,
+        RX_LENGTH2,
+        RX_DATA,
+        RX_FCS,
+        RX_END
+    };
+
+    void serial_event();
+    void process();
+    void process_frame();
+    void process_control(const uint8_t *data, uint16_t len);
+    void deliver(Channel *ch, const uint8_t *data, uint16_t len);
+    void wake(Channel *ch);
+    Channel *find_channel(uint8_t dlci);
+    ssize_t channel_read(Channel *ch, void *buffer, size_t size);
+    ssize_t channel_write(Channel *ch, const void *buffer, size_t size);
+    int channel_close(Channel *ch);
+    short channel_poll(const Channel *ch, short events);
+
+    nsapi_error_t send_frame(uint8_t address, uint8_t control, const uint8_t *data, uint16_t len);
+    nsapi_error_t send_msc(uint8_t dlci, bool flow_off);
+    nsapi_error_t write_all(const uint8_t *data, size_t len);
+    nsapi_error_t wait_state(volatile uint8_t *state, uint8_t pending);
+    nsapi_error_t wait_ok();
+
+    FileHandle *_fh;
+    PlatformMutex _rx_mutex;
+    PlatformMutex _tx_mutex;
+    Channel _channels[MBED_CONF_CELLULAR_MUX_CHANNELS];
+    volatile uint8_t _control_state;
+    bool _started;
+    uint32_t _dropped;
+
+    rx_state _rx_state;
+    uint8_t _rx_address;
+    uint8_t _rx_control;
+    uint16_t _rx_length;
+    uint16_t _rx_pos;
+    uint8_t _rx_fcs;
+    uint8_t _rx_frame[MBED_CONF_CELLULAR_MUX_FRAME_SIZE];
+};
+
+} // namespace mbed
+
+#endif // CELLULAR_MUX_H_
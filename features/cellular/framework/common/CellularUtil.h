@@ -89,7 +89,7 @@ int hex_str_to_int(const char *hex_string, int hex_string_length);
  *
  *  @param str hex string that is converted to char string to buf
  *  @param len length of the param str/how many hex are converted
- *  @param buf preallocated buffer where result conversion is stored
+ *  @param buf preallocated buffer where result conversion is stored, may be str to convert in place
  *  @return    length of the buf
  */
 int hex_str_to_char_str(const char *str, uint16_t len, char *buf);
@@ -19,6 +19,17 @@
 #include "CellularDevice.h"
 #include "CellularLog.h"
 #include "Thread.h"
+#include "Kernel.h"
+
+#if MBED_CONF_CELLULAR_FAST_RECONNECT
+#include <string.h>
+#include "kvstore_global_api.h"
+#include "mbed_error.h"
+
+#define STM_STR_EXPAND(tok) #tok
+#define STM_STR(tok) STM_STR_EXPAND(tok)
+#define STM_CACHE_KEY "/" STM_STR(MBED_CONF_STORAGE_DEFAULT_KV) "/cellular_stm"
+#endif // MBED_CONF_CELLULAR_FAST_RECONNECT
 
 #ifndef MBED_TRACE_MAX_LEVEL
 #define MBED_TRACE_MAX_LEVEL TRACE_LEVEL_INFO
@@ -47,13 +58,25 @@ const int ACTIVE_PDP_CONTEXT = 0x01;
 const int ATTACHED_TO_NETWORK = 0x02;
 const int DEVICE_READY = 0x04;
 
+#if MBED_CONF_CELLULAR_FAST_RECONNECT
+const uint16_t STM_CACHE_VERSION = 1;
+
+// network state kept over resets
+struct stm_cache_t {
+    uint16_t version;
+    uint8_t attached;
+    char plmn[8];
+};
+#endif // MBED_CONF_CELLULAR_FAST_RECONNECT
+
 namespace mbed {
 
 CellularStateMachine::CellularStateMachine(CellularDevice &device, events::EventQueue &queue, CellularNetwork &nw) :
     _cellularDevice(device), _state(STATE_INIT), _next_state(_state), _target_state(_state),
     _event_status_cb(0), _network(nw), _queue(queue), _queue_thread(0), _sim_pin(0),
     _retry_count(0), _event_timeout(-1), _event_id(-1), _plmn(0), _command_success(false),
-    _is_retry(false), _cb_data(), _current_event(CellularDeviceReady), _status(0)
+    _is_retry(false), _cb_data(), _current_event(CellularDeviceReady), _status(0), _fast_reconnect(false),
+    _state_start_time(0)
 {
 #if MBED_CONF_CELLULAR_RANDOM_MAX_START_DELAY == 0
     _start_time = 0;
@@ -95,6 +118,7 @@ void CellularStateMachine::reset()
     _event_id = -1;
     _is_retry = false;
     _status = 0;
+    _fast_reconnect = false;
     _target_state = STATE_INIT;
     enter_to_state(STATE_INIT);
 }
@@ -165,7 +189,8 @@ bool CellularStateMachine::open_sim()
 
     bool sim_ready = state == CellularDevice::SimStateReady;
 
-    if (sim_ready) {
+    // with a retained registration there's nothing to set, see state_sim_pin
+    if (sim_ready && !_fast_reconnect) {
         _cb_data.error = _network.set_registration(_plmn);
         tr_debug("STM: set_registration: %d, plmn: %s", _cb_data.error, _plmn ? _plmn : "NULL");
         if (_cb_data.error) {
@@ -259,6 +284,7 @@ void CellularStateMachine::report_failure(const char *msg)
     _event_id = -1;
     _cb_data.final_try = true;
     send_event_cb(_current_event);
+    save_cached_state(false);
 
     tr_error("CellularStateMachine target state %s, current state %s", get_state_string(_target_state), get_state_string(_state));
 }
@@ -307,9 +333,14 @@ void CellularStateMachine::state_init()
 {
     change_timeout(_state_timeout_power_on);
     tr_info("Start connecting (timeout %d ms)", _state_timeout_power_on);
+    load_cached_state();
     _cb_data.error = _cellularDevice.is_ready();
     _status = _cb_data.error ? 0 : DEVICE_READY;
-    if (_cb_data.error != NSAPI_ERROR_OK) {
+    if (_cb_data.error != NSAPI_ERROR_OK && _fast_reconnect) {
+        // modem was left attached and is likely sleeping in PSM, wake it up instead of power cycling it
+        tr_info("Waking up modem");
+        enter_to_state(STATE_DEVICE_READY);
+    } else if (_cb_data.error != NSAPI_ERROR_OK) {
         _event_timeout = _start_time;
         if (_start_time > 0) {
             tr_info("Startup delay %d ms", _start_time);
@@ -368,7 +399,13 @@ void CellularStateMachine::state_device_ready()
             }
         }
     }
-    if (_cb_data.error != NSAPI_ERROR_OK) {
+    if (_cb_data.error != NSAPI_ERROR_OK && _fast_reconnect && !(_status & DEVICE_READY)) {
+        // cached state was stale, modem needs to be powered on after all
+        tr_info("Modem did not wake up, powering on");
+        _fast_reconnect = false;
+        enter_to_state(STATE_POWER_ON);
+        _is_retry = true;
+    } else if (_cb_data.error != NSAPI_ERROR_OK) {
         if (_retry_count == 0) {
             _cellularDevice.set_ready_cb(callback(this, &CellularStateMachine::device_ready_cb));
         }
@@ -404,6 +441,16 @@ void CellularStateMachine::state_sim_pin()
             tr_debug("Cellular already attached.");
         }
 
+        if (_fast_reconnect && !(_status & ATTACHED_TO_NETWORK)) {
+            tr_info("Network state not retained, registering");
+            _fast_reconnect = false;
+            _cb_data.error = _network.set_registration(_plmn);
+            if (_cb_data.error) {
+                retry_state_or_fail();
+                return;
+            }
+        }
+
         // if packet domain event reporting is not set it's not a stopper. We might lack some events when we are
         // dropped from the network.
         _cb_data.error = _network.set_packet_domain_event_reporting(true);
@@ -457,7 +504,7 @@ void CellularStateMachine::state_registering()
 
 void CellularStateMachine::state_attaching()
 {
-    if (_status != ATTACHED_TO_NETWORK) {
+    if (!(_status & ATTACHED_TO_NETWORK)) {
         change_timeout(_state_timeout_connect);
         tr_info("Attaching network (timeout %d ms)", _state_timeout_connect);
         _cb_data.error = _network.set_attach();
@@ -465,6 +512,7 @@ void CellularStateMachine::state_attaching()
     if (_cb_data.error == NSAPI_ERROR_OK) {
         _cb_data.status_data = CellularNetwork::Attached;
         send_event_cb(_current_event);
+        save_cached_state(true);
     } else {
         retry_state_or_fail();
     }
@@ -475,6 +523,7 @@ void CellularStateMachine::continue_from_state(CellularState state)
     _mutex.lock();
     tr_info("%s => %s", get_state_string((CellularStateMachine::CellularState)_state),
             get_state_string((CellularStateMachine::CellularState)state));
+    report_state_time(_state);
     _state = state;
     enter_to_state(state);
     _event_id = _queue.call_in(0, this, &CellularStateMachine::event);
@@ -519,6 +568,7 @@ void CellularStateMachine::pre_event(CellularState state)
             _state = _next_state;
         }
         enter_to_state(_next_state);
+        _state_start_time = rtos::Kernel::get_ms_count();
         _event_id = _queue.call_in(0, this, &CellularStateMachine::event);
         if (!_event_id) {
             _event_id = -1;
@@ -562,6 +612,7 @@ void CellularStateMachine::event()
 
     _event_timeout = -1;
     _is_retry = false;
+    CellularState state = _state;
 
     switch (_state) {
         case STATE_INIT:
@@ -598,6 +649,7 @@ void CellularStateMachine::event()
     }
 
     if (check_is_target_reached()) {
+        report_state_time(state);
         _event_id = -1;
         return;
     }
@@ -606,6 +658,7 @@ void CellularStateMachine::event()
         if (_next_state != _state) { // state exit condition
             tr_debug("%s => %s", get_state_string((CellularStateMachine::CellularState)_state),
                      get_state_string((CellularStateMachine::CellularState)_next_state));
+            report_state_time(_state);
         } else {
             tr_info("Continue after %d seconds", _event_timeout);
         }
@@ -658,6 +711,64 @@ void CellularStateMachine::change_timeout(const int &timeout)
     send_event_cb(CellularDeviceTimeout);
 }
 
+void CellularStateMachine::report_state_time(CellularState state)
+{
+    uint64_t now = rtos::Kernel::get_ms_count();
+    int elapsed = now - _state_start_time;
+    _state_start_time = now;
+    tr_debug("%s took %d ms", get_state_string(state), elapsed);
+
+    // own data so that the result of the state itself stays in _cb_data
+    cell_callback_data_t data;
+    data.status_data = state;
+    data.data = &elapsed;
+    if (_event_status_cb) {
+        _event_status_cb((nsapi_event_t)CellularStateTime, (intptr_t)&data);
+    }
+}
+
+void CellularStateMachine::load_cached_state()
+{
+    _fast_reconnect = false;
+#if MBED_CONF_CELLULAR_FAST_RECONNECT
+    stm_cache_t cache;
+    size_t size = 0;
+    if (kv_get(STM_CACHE_KEY, &cache, sizeof(cache), &size) == MBED_SUCCESS && size == sizeof(cache) &&
+            cache.version == STM_CACHE_VERSION && cache.attached) {
+        // only valid if registering to the same network
+        cache.plmn[sizeof(cache.plmn) - 1] = '\0';
+        _fast_reconnect = strcmp(cache.plmn, _plmn ? _plmn : "") == 0;
+    }
+    tr_debug("Cached network state %s", _fast_reconnect ? "found" : "not found");
+#endif // MBED_CONF_CELLULAR_FAST_RECONNECT
+}
+
+void CellularStateMachine::save_cached_state(bool attached)
+{
+#if MBED_CONF_CELLULAR_FAST_RECONNECT
+    stm_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    cache.version = STM_CACHE_VERSION;
+    cache.attached = attached;
+    if (attached && _plmn) {
+        strncpy(cache.plmn, _plmn, sizeof(cache.plmn) - 1);
+    }
+
+    // write flash only when the state has changed
+    stm_cache_t stored;
+    size_t size = 0;
+    if (kv_get(STM_CACHE_KEY, &stored, sizeof(stored), &size) == MBED_SUCCESS && size == sizeof(stored) &&
+            memcmp(&stored, &cache, sizeof(cache)) == 0) {
+        return;
+    }
+    if (kv_set(STM_CACHE_KEY, &cache, sizeof(cache), 0) != MBED_SUCCESS) {
+        tr_warn("Failed to store network state");
+    }
+#else
+    (void)attached;
+#endif // MBED_CONF_CELLULAR_FAST_RECONNECT
+}
+
 bool CellularStateMachine::check_is_target_reached()
 {
     if (((_target_state == _state || _target_state < _next_state) && _cb_data.error == NSAPI_ERROR_OK && !_is_retry) ||
@@ -22,6 +22,12 @@
 #include "CellularCommon.h"
 #include "PlatformMutex.h"
 
+/** Persist the network state in KVStore so that a modem left attached, for example sleeping in PSM,
+ *  is woken up rather than power cycled and does not register again */
+#ifndef MBED_CONF_CELLULAR_FAST_RECONNECT
+#define MBED_CONF_CELLULAR_FAST_RECONNECT 0
+#endif
+
 namespace rtos {
 class Thread;
 }
@@ -158,6 +164,9 @@ private:
     bool check_is_target_reached();
     void send_event_cb(cellular_connection_status_t status);
     void change_timeout(const int &timeout);
+    void report_state_time(CellularState state);
+    void load_cached_state();
+    void save_cached_state(bool attached);
 
     CellularDevice &_cellularDevice;
     CellularState _state;
@@ -184,6 +193,9 @@ private:
     cell_callback_data_t _cb_data;
     cellular_connection_status_t _current_event;
     int _status;
+    // cached state says the modem was left attached, see MBED_CONF_CELLULAR_FAST_RECONNECT
+    bool _fast_reconnect;
+    uint64_t _state_start_time;
     PlatformMutex _mutex;
 
     // Cellular state timeouts
@@ -242,8 +242,7 @@ nsapi_size_or_error_t QUECTEL_BG96_CellularStack::socket_sendto_impl(CellularSoc
         _at.cmd_start_stop("+QISEND", "=", "%d%d", socket->id, size);
     }
 
-    _at.resp_start(">");
-    _at.write_bytes((uint8_t *)data, size);
+    _at.write_bytes_at_prompt(">", (uint8_t *)data, size);
     _at.resp_start();
     _at.set_stop_tag("\r\n");
     _at.resp_stop();
@@ -499,8 +499,7 @@ nsapi_size_or_error_t QUECTEL_M26_CellularStack::socket_sendto_impl(CellularSock
     _at.write_int(sent_len);
     _at.cmd_stop();
 
-    _at.resp_start(">");
-    _at.write_bytes((uint8_t *)data, sent_len);
+    _at.write_bytes_at_prompt(">", (uint8_t *)data, sent_len);
     _at.resp_start();
     _at.resp_stop();
 
@@ -123,18 +123,14 @@ nsapi_size_or_error_t UBLOX_N2XX_CellularStack::socket_sendto_impl(CellularSocke
     }
 
     int sent_len = 0;
-    char *dataStr = new char [(size * 2) + 1]();
-    if (!dataStr) {
-        return NSAPI_ERROR_NO_MEMORY;
-    }
-    char_str_to_hex_str((const char *)data, size, dataStr);
 
     _at.cmd_start("AT+NSOST=");
     _at.write_int(socket->id);
     _at.write_string(address.get_ip_address());
     _at.write_int(address.get_port());
     _at.write_int(size);
-    _at.write_string(dataStr);
+    // SARA-N2 takes socket data only in hex
+    _at.write_hex_string((const uint8_t *)data, size, true);
     _at.cmd_stop();
 
     _at.resp_start();
@@ -142,7 +138,6 @@ nsapi_size_or_error_t UBLOX_N2XX_CellularStack::socket_sendto_impl(CellularSocke
     sent_len = _at.read_int();
     _at.resp_stop();
 
-    delete[] dataStr;
     if ((_at.get_last_error() == NSAPI_ERROR_OK)) {
         return sent_len;
     }
@@ -25,6 +25,10 @@
 #include "crys_ecpki_error.h"
 #include "crys_ec_mont_edw_error.h"
 #include "mbedtls/platform.h"
+#include <string.h>
+#if defined(MBED_CONF_RTOS_PRESENT)
+#include "cmsis_os2.h"
+#endif
 
 CRYS_ECPKI_DomainID_t convert_mbedtls_grp_id_to_crys_domain_id( mbedtls_ecp_group_id grp_id )
 {
@@ -154,3 +158,63 @@ int convert_CrysError_to_mbedtls_err( CRYSError_t Crys_err )
 
 
 }
+
+int cc_hash_update( CRYS_HASHUserContext_t *hash_ctx, unsigned char *buffer,
+                    size_t *buffer_len, const unsigned char *input, size_t ilen )
+{
+    size_t fill;
+    size_t chunk;
+
+    /* Complete the pending partial block first */
+    if( *buffer_len > 0 )
+    {
+        fill = CC_HASH_BLOCK_SIZE - *buffer_len;
+        if( ilen < fill )
+        {
+            memcpy( buffer + *buffer_len, input, ilen );
+            *buffer_len += ilen;
+            return ( 0 );
+        }
+        memcpy( buffer + *buffer_len, input, fill );
+        if( CRYS_HASH_Update( hash_ctx, buffer, CC_HASH_BLOCK_SIZE ) != CRYS_OK )
+            return ( MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED );
+        *buffer_len = 0;
+        input += fill;
+        ilen -= fill;
+    }
+
+    /* Whole blocks straight from the input */
+    while( ilen >= CC_HASH_BLOCK_SIZE )
+    {
+        chunk = ilen - ( ilen % CC_HASH_BLOCK_SIZE );
+        if( chunk > CC_HASH_UPDATE_CHUNK_SIZE )
+            chunk = CC_HASH_UPDATE_CHUNK_SIZE;
+
+        if( CRYS_HASH_Update( hash_ctx, (uint8_t*)input, chunk ) != CRYS_OK )
+            return ( MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED );
+        input += chunk;
+        ilen -= chunk;
+
+#if defined(MBED_CONF_RTOS_PRESENT)
+        /* Let other threads of the same priority run between chunks */
+        if( ilen >= CC_HASH_BLOCK_SIZE )
+            osThreadYield();
+#endif
+    }
+
+    memcpy( buffer, input, ilen );
+    *buffer_len = ilen;
+    return ( 0 );
+}
+
+int cc_hash_finish_buffer( CRYS_HASHUserContext_t *hash_ctx, unsigned char *buffer,
+                           size_t *buffer_len )
+{
+    if( *buffer_len > 0 )
+    {
+        if( CRYS_HASH_Update( hash_ctx, buffer, *buffer_len ) != CRYS_OK )
+            return ( MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED );
+        *buffer_len = 0;
+    }
+    return ( 0 );
+}
@@ -25,12 +25,22 @@
 #define __CC_INTERNAL_H__
 #include "crys_ecpki_types.h"
 #include "crys_ec_mont_api.h"
+#include "crys_hash.h"
 #include "mbedtls/ecp.h"
 #include <stddef.h>
 #include <stdint.h>
 
 #define CURVE_25519_KEY_SIZE    32
 
+/* Block size of SHA-1 and SHA-256 */
+#define CC_HASH_BLOCK_SIZE      64
+
+/* Long hash updates are fed to the CryptoCell in chunks of this size,
+ * a multiple of CC_HASH_BLOCK_SIZE, yielding to other threads in between */
+#ifndef CC_HASH_UPDATE_CHUNK_SIZE
+#define CC_HASH_UPDATE_CHUNK_SIZE   4096
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -126,6 +136,42 @@ uint32_t convert_mbedtls_to_cc_rand( void* mbedtls_rand, uint16_t outSizeBytes,
  */
 int convert_CrysError_to_mbedtls_err( CRYSError_t Crys_err );
 
+/**
+ * \brief      This function feeds data to a Cryptocell hash.
+ *
+ *             CRYS_HASH_Update only accepts a size that isn't a multiple
+ *             of the block size as its last call, so partial blocks are
+ *             kept in \p buffer until completed or until
+ *             cc_hash_finish_buffer. Data is fed in chunks of at most
+ *             CC_HASH_UPDATE_CHUNK_SIZE, the calling thread yields between
+ *             them.
+ *
+ * \param hash_ctx         The Cryptocell hash context
+ * \param buffer           Buffer of CC_HASH_BLOCK_SIZE bytes for a partial block
+ * \param buffer_len       Number of bytes in \p buffer
+ * \param input            The data to hash
+ * \param ilen             The length of the data
+ *
+ * \return     \c 0 on success,
+ *             MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED on failure.
+ */
+int cc_hash_update( CRYS_HASHUserContext_t *hash_ctx, unsigned char *buffer,
+                    size_t *buffer_len, const unsigned char *input, size_t ilen );
+
+/**
+ * \brief      This function feeds the partial block kept by
+ *             cc_hash_update to the Cryptocell, before CRYS_HASH_Finish.
+ *
+ * \param hash_ctx         The Cryptocell hash context
+ * \param buffer           Buffer of the partial block
+ * \param buffer_len       Number of bytes in \p buffer
+ *
+ * \return     \c 0 on success,
+ *             MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED on failure.
+ */
+int cc_hash_finish_buffer( CRYS_HASHUserContext_t *hash_ctx, unsigned char *buffer,
+                           size_t *buffer_len );
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 #if defined(MBEDTLS_SHA256_ALT)
 #include <string.h>
 #include "mbedtls/platform.h"
+#include "cc_internal.h"
 
 void mbedtls_sha256_init( mbedtls_sha256_context *ctx )
 {
@@ -61,9 +62,8 @@ int mbedtls_sha256_update_ret( mbedtls_sha256_context *ctx,
                                const unsigned char *input,
                                size_t ilen )
 {
-    if( CRYS_HASH_Update( &ctx->crys_hash_ctx, (uint8_t*)input, ilen ) != CRYS_OK )
-        return ( MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED );
-    return ( 0 );
+    return ( cc_hash_update( &ctx->crys_hash_ctx, ctx->buffer, &ctx->buffer_len,
+                             input, ilen ) );
 }
 
 int mbedtls_sha256_finish_ret( mbedtls_sha256_context *ctx,
@@ -71,6 +71,8 @@ int mbedtls_sha256_finish_ret( mbedtls_sha256_context *ctx,
 {
     CRYSError_t crys_err = CRYS_OK;
     CRYS_HASH_Result_t crys_result = {0};
+    if( cc_hash_finish_buffer( &ctx->crys_hash_ctx, ctx->buffer, &ctx->buffer_len ) != 0 )
+        return ( MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED );
     crys_err = CRYS_HASH_Finish( &ctx->crys_hash_ctx, crys_result );
     if( crys_err == CRYS_OK )
     {
@@ -31,6 +31,8 @@
 typedef struct
 {
     CRYS_HASHUserContext_t crys_hash_ctx;
+    unsigned char buffer[64];   /*!< Partial block not fed to the Cryptocell yet */
+    size_t buffer_len;          /*!< Number of bytes in buffer */
 } mbedtls_sha256_context;
 
 #endif // MBEDTLS_SHA256_ALT__
@@ -0,0 +1,167 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FirmwareUpdate.h"
+#include "HeapBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#include <algorithm>
+#include <stdlib.h>
+
+using namespace utest::v1;
+using namespace mbed;
+
+#if !FIRMWARE_UPDATE_ENABLED
+#error [NOT_SUPPORTED] FirmwareUpdate needs SHA-256 to be enabled for this test
+#endif
+
+#define IMAGE_SIZE  (5000 + 7)
+#define SLOT_ADDR   4096
+#define SLOT_SIZE   (16 * 1024)
+
+static uint8_t image[IMAGE_SIZE];
+static uint8_t image_digest[FIRMWARE_UPDATE_DIGEST_SIZE];
+
+/* Image source handing out a few bytes per read, like a socket does */
+class ImageFile : public FileHandle {
+public:
+    ImageFile(size_t size) : _pos(0), _size(size) {}
+    virtual ssize_t read(void *buffer, size_t size)
+    {
+        size = std::min(std::min(size, _size - _pos), (size_t)333);
+        memcpy(buffer, image + _pos, size);
+        _pos += size;
+        return size;
+    }
+    virtual ssize_t write(const void *buffer, size_t size)
+    {
+        return -1;
+    }
+    virtual off_t seek(off_t offset, int whence = SEEK_SET)
+    {
+        return -1;
+    }
+    virtual int close()
+    {
+        return 0;
+    }
+private:
+    size_t _pos;
+    size_t _size;
+};
+
+static void make_image()
+{
+    for (size_t i = 0; i < IMAGE_SIZE; i++) {
+        image[i] = rand();
+    }
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_ret(image, IMAGE_SIZE, image_digest, 0));
+}
+
+static void check_slot(BlockDevice *bd)
+{
+    uint8_t buffer[64];
+    for (size_t offset = 0; offset < IMAGE_SIZE; offset += sizeof(buffer)) {
+        size_t size = std::min(sizeof(buffer), (size_t)(IMAGE_SIZE - offset));
+        TEST_ASSERT_EQUAL(0, bd->read(buffer, SLOT_ADDR + offset, sizeof(buffer)));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(image + offset, buffer, size);
+    }
+}
+
+void firmware_update_file_test()
+{
+    HeapBlockDevice heap(32 * 1024, 1, 4, 4096);
+    FlashSimBlockDevice bd(&heap);
+    TEST_ASSERT_EQUAL(0, bd.init());
+    make_image();
+
+    FirmwareUpdate update(&bd, SLOT_ADDR, SLOT_SIZE);
+    ImageFile file(IMAGE_SIZE);
+    TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_SUCCESS, update.update(&file, IMAGE_SIZE, image_digest));
+    TEST_ASSERT_EQUAL(IMAGE_SIZE, update.get_written());
+    check_slot(&bd);
+
+    uint8_t digest[FIRMWARE_UPDATE_DIGEST_SIZE];
+    update.get_digest(digest);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(image_digest, digest, FIRMWARE_UPDATE_DIGEST_SIZE);
+
+    TEST_ASSERT_EQUAL(0, bd.deinit());
+}
+
+void firmware_update_write_test()
+{
+    HeapBlockDevice bd(32 * 1024, 1, 4, 4096);
+    TEST_ASSERT_EQUAL(0, bd.init());
+    make_image();
+
+    FirmwareUpdate update(&bd, SLOT_ADDR, SLOT_SIZE);
+    TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_SUCCESS, update.begin(IMAGE_SIZE));
+    for (size_t offset = 0; offset < IMAGE_SIZE; offset += 100) {
+        size_t size = std::min((size_t)100, (size_t)(IMAGE_SIZE - offset));
+        TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_SUCCESS, update.write(image + offset, size));
+    }
+    TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_SUCCESS, update.finish(image_digest));
+    check_slot(&bd);
+
+    TEST_ASSERT_EQUAL(0, bd.deinit());
+}
+
+void firmware_update_errors_test()
+{
+    HeapBlockDevice bd(32 * 1024, 1, 4, 4096);
+    TEST_ASSERT_EQUAL(0, bd.init());
+    make_image();
+
+    FirmwareUpdate update(&bd, SLOT_ADDR, SLOT_SIZE);
+    TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_NOT_STARTED, update.write(image, 1));
+    TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_TOO_LARGE, update.begin(SLOT_SIZE + 1));
+
+    uint8_t wrong_digest[FIRMWARE_UPDATE_DIGEST_SIZE];
+    memcpy(wrong_digest, image_digest, sizeof(wrong_digest));
+    wrong_digest[0] ^= 1;
+    ImageFile file(IMAGE_SIZE);
+    TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_DIGEST_MISMATCH, update.update(&file, IMAGE_SIZE, wrong_digest));
+
+    ImageFile short_file(IMAGE_SIZE / 2);
+    TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_SOURCE_FAILED, update.update(&short_file, IMAGE_SIZE));
+
+    TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_SUCCESS, update.begin(IMAGE_SIZE));
+    TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_SUCCESS, update.write(image, 10));
+    TEST_ASSERT_EQUAL(FIRMWARE_UPDATE_INCOMPLETE, update.finish());
+
+    TEST_ASSERT_EQUAL(0, bd.deinit());
+}
+
+Case cases[] = {
+    Case("FirmwareUpdate - image from file", firmware_update_file_test),
+    Case("FirmwareUpdate - image written in parts", firmware_update_write_test),
+    Case("FirmwareUpdate - errors", firmware_update_errors_test),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
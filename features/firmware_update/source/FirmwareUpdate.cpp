@@ -0,0 +1,407 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FirmwareUpdate.h"
+
+#if FIRMWARE_UPDATE_ENABLED
+
+#include "netsocket/Socket.h"
+#include "platform/Callback.h"
+#include <algorithm>
+#include <new>
+#include <string.h>
+
+#ifndef MBED_CONF_FIRMWARE_UPDATE_BUFFER_SIZE
+#define MBED_CONF_FIRMWARE_UPDATE_BUFFER_SIZE 1024
+#endif
+
+#ifndef MBED_CONF_FIRMWARE_UPDATE_VERIFY_WRITES
+#define MBED_CONF_FIRMWARE_UPDATE_VERIFY_WRITES 1
+#endif
+
+namespace mbed {
+
+// Read back programmed data in pieces of this size when flash is not memory mapped
+#define VERIFY_CHUNK_SIZE 32
+
+static ssize_t file_read(void *source, void *buffer, size_t size)
+{
+    return static_cast<FileHandle *>(source)->read(buffer, size);
+}
+
+static ssize_t socket_recv(void *source, void *buffer, size_t size)
+{
+    return static_cast<Socket *>(source)->recv(buffer, size);
+}
+
+FirmwareUpdate::FirmwareUpdate(BlockDevice *slot, bd_addr_t addr, bd_size_t size)
+    : _bd(slot),
+#if DEVICE_FLASH
+      _flash(NULL),
+#endif
+      _addr(addr), _size(size), _program_size(slot->get_program_size()),
+      _buffer(NULL), _buffer_size(0), _buffered(0), _written(0), _image_size(0),
+      _erased_end(0), _started(false), _erase_started(false), _erase_result(0)
+{
+    int erase_value = slot->get_erase_value();
+
+    if (!_size) {
+        _size = slot->size() - addr;
+    }
+    // Devices without an erase value can be programmed without erasing first
+    _needs_erase = (erase_value >= 0);
+    _erase_value = _needs_erase ? erase_value : 0xFF;
+}
+
+#if DEVICE_FLASH
+FirmwareUpdate::FirmwareUpdate(FlashIAP *slot, uint32_t addr, uint32_t size)
+    : _bd(NULL), _flash(slot), _addr(addr), _size(size), _program_size(slot->get_page_size()),
+      _erase_value(slot->get_erase_value()), _needs_erase(true),
+      _buffer(NULL), _buffer_size(0), _buffered(0), _written(0), _image_size(0),
+      _erased_end(0), _started(false), _erase_started(false), _erase_result(0)
+{
+}
+#endif
+
+FirmwareUpdate::~FirmwareUpdate()
+{
+    end();
+}
+
+int FirmwareUpdate::begin(size_t image_size)
+{
+    end();
+
+    if (!image_size) {
+        return FIRMWARE_UPDATE_INVALID_PARAM;
+    }
+    if (image_size > _size) {
+        return FIRMWARE_UPDATE_TOO_LARGE;
+    }
+
+    // Whole program units, so full buffers are programmed as they are
+    _buffer_size = std::max<uint32_t>(MBED_CONF_FIRMWARE_UPDATE_BUFFER_SIZE / _program_size, 1) * _program_size;
+    _buffer = new (std::nothrow) uint8_t[_buffer_size];
+    if (!_buffer) {
+        return FIRMWARE_UPDATE_NO_MEMORY;
+    }
+
+    mbedtls_sha256_init(&_sha);
+    if (mbedtls_sha256_starts_ret(&_sha, 0) != 0) {
+        end();
+        return FIRMWARE_UPDATE_INVALID_PARAM;
+    }
+
+    _image_size = image_size;
+    _written = 0;
+    _buffered = 0;
+    _erased_end = _addr;
+    _started = true;
+
+    // The first sector is erased while the first data arrives
+    erase_ahead();
+
+    return FIRMWARE_UPDATE_SUCCESS;
+}
+
+int FirmwareUpdate::write(const void *data, size_t size)
+{
+    const uint8_t *src = static_cast<const uint8_t *>(data);
+
+    if (!_started) {
+        return FIRMWARE_UPDATE_NOT_STARTED;
+    }
+    if (size > _image_size - _written) {
+        return FIRMWARE_UPDATE_TOO_LARGE;
+    }
+
+    while (size) {
+        uint32_t chunk = std::min<size_t>(size, _buffer_size - _buffered);
+        memcpy(_buffer + _buffered, src, chunk);
+        int err = accept(chunk);
+        if (err) {
+            return err;
+        }
+        src += chunk;
+        size -= chunk;
+    }
+
+    return FIRMWARE_UPDATE_SUCCESS;
+}
+
+int FirmwareUpdate::finish(const uint8_t *expected_digest)
+{
+    if (!_started) {
+        return FIRMWARE_UPDATE_NOT_STARTED;
+    }
+    if (_written != _image_size) {
+        end();
+        return FIRMWARE_UPDATE_INCOMPLETE;
+    }
+
+    int err = flush(true);
+    if (err) {
+        return err;
+    }
+
+    err = mbedtls_sha256_finish_ret(&_sha, _digest);
+    end();
+    if (err) {
+        return FIRMWARE_UPDATE_INVALID_PARAM;
+    }
+
+    if (expected_digest && memcmp(expected_digest, _digest, FIRMWARE_UPDATE_DIGEST_SIZE) != 0) {
+        return FIRMWARE_UPDATE_DIGEST_MISMATCH;
+    }
+
+    return FIRMWARE_UPDATE_SUCCESS;
+}
+
+int FirmwareUpdate::update(FileHandle *source, size_t image_size, const uint8_t *expected_digest)
+{
+    return update(file_read, source, image_size, expected_digest);
+}
+
+int FirmwareUpdate::update(Socket *source, size_t image_size, const uint8_t *expected_digest)
+{
+    return update(socket_recv, source, image_size, expected_digest);
+}
+
+int FirmwareUpdate::update(ssize_t (*read)(void *, void *, size_t), void *source, size_t image_size,
+                           const uint8_t *expected_digest)
+{
+    int err = begin(image_size);
+    if (err) {
+        return err;
+    }
+
+    while (_written < _image_size) {
+        size_t chunk = std::min<uint64_t>(_buffer_size - _buffered, _image_size - _written);
+        ssize_t received = read(source, _buffer + _buffered, chunk);
+        if (received <= 0) {
+            end();
+            return FIRMWARE_UPDATE_SOURCE_FAILED;
+        }
+        err = accept(received);
+        if (err) {
+            return err;
+        }
+    }
+
+    return finish(expected_digest);
+}
+
+void FirmwareUpdate::get_digest(uint8_t *digest) const
+{
+    memcpy(digest, _digest, FIRMWARE_UPDATE_DIGEST_SIZE);
+}
+
+size_t FirmwareUpdate::get_written() const
+{
+    return _written;
+}
+
+int FirmwareUpdate::accept(size_t size)
+{
+    if (mbedtls_sha256_update_ret(&_sha, _buffer + _buffered, size) != 0) {
+        end();
+        return FIRMWARE_UPDATE_INVALID_PARAM;
+    }
+    _buffered += size;
+    _written += size;
+
+    if (_buffered == _buffer_size) {
+        return flush(false);
+    }
+    return FIRMWARE_UPDATE_SUCCESS;
+}
+
+int FirmwareUpdate::flush(bool last)
+{
+    uint64_t addr = _addr + _written - _buffered;
+    uint32_t size = _buffered;
+
+    if (!size) {
+        return FIRMWARE_UPDATE_SUCCESS;
+    }
+
+    if (last && (size % _program_size)) {
+        uint32_t padded = (size / _program_size + 1) * _program_size;
+        memset(_buffer + size, _erase_value, padded - size);
+        size = padded;
+    }
+
+    int err = prepare(addr + size);
+    if (!err) {
+        err = program(addr, _buffer, size);
+    }
+    if (err) {
+        end();
+        return err;
+    }
+    _buffered = 0;
+
+    erase_ahead();
+
+    return FIRMWARE_UPDATE_SUCCESS;
+}
+
+int FirmwareUpdate::prepare(uint64_t end)
+{
+    if (wait_erase() != 0) {
+        return FIRMWARE_UPDATE_ERASE_FAILED;
+    }
+
+    if (!_needs_erase) {
+        return FIRMWARE_UPDATE_SUCCESS;
+    }
+
+    while (_erased_end < end) {
+        uint64_t size;
+        int ret;
+#if DEVICE_FLASH
+        if (_flash) {
+            size = _flash->get_sector_size(_erased_end);
+            ret = _flash->erase(_erased_end, size);
+        } else
+#endif
+        {
+            size = _bd->get_erase_size(_erased_end);
+            ret = _bd->erase(_erased_end, size);
+        }
+        if (ret) {
+            return FIRMWARE_UPDATE_ERASE_FAILED;
+        }
+        _erased_end += size;
+    }
+
+    return FIRMWARE_UPDATE_SUCCESS;
+}
+
+int FirmwareUpdate::program(uint64_t addr, const uint8_t *data, uint32_t size)
+{
+    int ret;
+#if DEVICE_FLASH
+    if (_flash) {
+        ret = _flash->program(data, addr, size);
+    } else
+#endif
+    {
+        ret = _bd->program(data, addr, size);
+    }
+    if (ret) {
+        return FIRMWARE_UPDATE_PROGRAM_FAILED;
+    }
+
+#if MBED_CONF_FIRMWARE_UPDATE_VERIFY_WRITES
+    return verify(addr, data, size);
+#else
+    return FIRMWARE_UPDATE_SUCCESS;
+#endif
+}
+
+int FirmwareUpdate::verify(uint64_t addr, const uint8_t *data, uint32_t size)
+{
+    uint8_t chunk[VERIFY_CHUNK_SIZE];
+    uint32_t chunk_size = VERIFY_CHUNK_SIZE;
+
+#if DEVICE_FLASH
+    if (_flash) {
+        const void *mapped = _flash->get_mapped_address(addr);
+        if (mapped) {
+            return memcmp(mapped, data, size) ? FIRMWARE_UPDATE_VERIFY_FAILED : FIRMWARE_UPDATE_SUCCESS;
+        }
+    } else
+#endif
+    {
+        // Block devices reading whole blocks only, like SD cards, are not read back
+        bd_size_t read_size = _bd->get_read_size();
+        if (read_size > VERIFY_CHUNK_SIZE || (size % read_size)) {
+            return FIRMWARE_UPDATE_SUCCESS;
+        }
+        chunk_size = VERIFY_CHUNK_SIZE / read_size * read_size;
+    }
+
+    while (size) {
+        uint32_t len = std::min(size, chunk_size);
+        int ret;
+#if DEVICE_FLASH
+        if (_flash) {
+            ret = _flash->read(chunk, addr, len);
+        } else
+#endif
+        {
+            ret = _bd->read(chunk, addr, len);
+        }
+        if (ret || memcmp(chunk, data, len)) {
+            return FIRMWARE_UPDATE_VERIFY_FAILED;
+        }
+        addr += len;
+        data += len;
+        size -= len;
+    }
+
+    return FIRMWARE_UPDATE_SUCCESS;
+}
+
+void FirmwareUpdate::erase_ahead()
+{
+#if DEVICE_FLASH
+    // Erase the next sector while the next part of the image is received
+    if (!_flash || _erase_started || _erased_end >= _addr + _image_size) {
+        return;
+    }
+
+    uint32_t size = _flash->get_sector_size(_erased_end);
+    if (_flash->erase_async(_erased_end, size, callback(this, &FirmwareUpdate::erase_done)) == 0) {
+        _erase_started = true;
+        _erased_end += size;
+    }
+#endif
+}
+
+int FirmwareUpdate::wait_erase()
+{
+    if (!_erase_started) {
+        return 0;
+    }
+    _erase_sem.acquire();
+    _erase_started = false;
+    return _erase_result;
+}
+
+void FirmwareUpdate::erase_done(int result)
+{
+    _erase_result = result;
+    _erase_sem.release();
+}
+
+void FirmwareUpdate::end()
+{
+    // The erase callback must not outlive the pipeline
+    wait_erase();
+
+    if (_started) {
+        mbedtls_sha256_free(&_sha);
+        _started = false;
+    }
+    delete[] _buffer;
+    _buffer = NULL;
+}
+
+} // namespace mbed
+
+#endif // FIRMWARE_UPDATE_ENABLED
@@ -0,0 +1,209 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FIRMWARE_UPDATE_H
+#define MBED_FIRMWARE_UPDATE_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#define FIRMWARE_UPDATE_ENABLED 1
+
+// Whole class is not supported if SHA-256 is not enabled in mbed TLS
+#if !defined(MBEDTLS_SHA256_C)
+#undef FIRMWARE_UPDATE_ENABLED
+#define FIRMWARE_UPDATE_ENABLED 0
+#endif
+
+#if (FIRMWARE_UPDATE_ENABLED) || defined(DOXYGEN_ONLY)
+
+#include <stddef.h>
+#include <stdint.h>
+#include "mbedtls/sha256.h"
+#include "BlockDevice.h"
+#include "platform/FileHandle.h"
+#include "platform/NonCopyable.h"
+#include "rtos/Semaphore.h"
+#include "drivers/FlashIAP.h"
+
+class Socket;
+
+namespace mbed {
+
+/** Size of a SHA-256 digest in bytes */
+#define FIRMWARE_UPDATE_DIGEST_SIZE 32
+
+enum FirmwareUpdateStatus {
+    FIRMWARE_UPDATE_SUCCESS               =  0,
+    FIRMWARE_UPDATE_INVALID_PARAM         = -1,
+    FIRMWARE_UPDATE_NOT_STARTED           = -2,
+    FIRMWARE_UPDATE_TOO_LARGE             = -3,
+    FIRMWARE_UPDATE_NO_MEMORY             = -4,
+    FIRMWARE_UPDATE_ERASE_FAILED          = -5,
+    FIRMWARE_UPDATE_PROGRAM_FAILED        = -6,
+    FIRMWARE_UPDATE_VERIFY_FAILED         = -7,
+    FIRMWARE_UPDATE_SOURCE_FAILED         = -8,
+    FIRMWARE_UPDATE_DIGEST_MISMATCH       = -9,
+    FIRMWARE_UPDATE_INCOMPLETE            = -10,
+};
+
+/** Write a firmware image to an update slot as it is received
+ *
+ *  The image is hashed with SHA-256 as it passes through and programmed
+ *  one buffer at a time, so nothing but that buffer is held in RAM. Each
+ *  erase unit of the slot is erased just before the image reaches it. With
+ *  a FlashIAP slot the next sector is erased in the background while the
+ *  next part of the image is received, see FlashIAP::erase_async.
+ *
+ *  The SHA-256 of mbed TLS is used, so targets with a hardware accelerated
+ *  SHA-256 (MBEDTLS_SHA256_ALT) hash in hardware.
+ *
+ *  @code
+ *  FlashIAPBlockDevice slot(MBED_CONF_APP_UPDATE_SLOT, MBED_CONF_APP_UPDATE_SIZE);
+ *  FirmwareUpdate update(&slot);
+ *  int err = update.update(&socket, image_size, expected_digest);
+ *  if (err == FIRMWARE_UPDATE_SUCCESS) {
+ *      // tell the bootloader, then mbed_start_application() or reset
+ *  }
+ *  @endcode
+ *
+ *  @note Synchronization level: Not protected
+ */
+class FirmwareUpdate : private NonCopyable<FirmwareUpdate> {
+public:
+    /** Create an update pipeline writing to a block device
+     *
+     *  @param slot Initialized block device to write the image to
+     *  @param addr Start of the slot on the block device, must be erase aligned
+     *  @param size Size of the slot, 0 for the rest of the block device
+     */
+    FirmwareUpdate(BlockDevice *slot, bd_addr_t addr = 0, bd_size_t size = 0);
+
+#if DEVICE_FLASH || defined(DOXYGEN_ONLY)
+    /** Create an update pipeline writing to internal flash
+     *
+     *  @param slot Initialized flash to write the image to
+     *  @param addr Start of the slot in flash, must be sector aligned
+     *  @param size Size of the slot
+     */
+    FirmwareUpdate(FlashIAP *slot, uint32_t addr, uint32_t size);
+#endif
+
+    ~FirmwareUpdate();
+
+    /** Start writing an image
+     *
+     *  @param image_size Size of the image in bytes
+     *  @return 0 on success, negative error code on failure
+     */
+    int begin(size_t image_size);
+
+    /** Write the next part of the image
+     *
+     *  @param data Image data
+     *  @param size Size of the data in bytes
+     *  @return 0 on success, negative error code on failure
+     */
+    int write(const void *data, size_t size);
+
+    /** Write the rest of the image and check its digest
+     *
+     *  @param expected_digest SHA-256 the image must have, or NULL not to check it
+     *  @return 0 on success, FIRMWARE_UPDATE_DIGEST_MISMATCH, FIRMWARE_UPDATE_INCOMPLETE
+     *          if less than image_size bytes were written, or another negative
+     *          error code on failure
+     */
+    int finish(const uint8_t *expected_digest = NULL);
+
+    /** Write a whole image read from a file
+     *
+     *  Data is read straight into the program buffer.
+     *
+     *  @param source          File positioned at the start of the image
+     *  @param image_size      Size of the image in bytes
+     *  @param expected_digest SHA-256 the image must have, or NULL not to check it
+     *  @return 0 on success, negative error code on failure
+     */
+    int update(FileHandle *source, size_t image_size, const uint8_t *expected_digest = NULL);
+
+    /** Write a whole image received from a socket
+     *
+     *  Data is received straight into the program buffer.
+     *
+     *  @param source          Connected socket, the image is the next image_size bytes received
+     *  @param image_size      Size of the image in bytes
+     *  @param expected_digest SHA-256 the image must have, or NULL not to check it
+     *  @return 0 on success, negative error code on failure
+     */
+    int update(Socket *source, size_t image_size, const uint8_t *expected_digest = NULL);
+
+    /** Get the SHA-256 of the image written by the last successful finish
+     *
+     *  @param digest Buffer of FIRMWARE_UPDATE_DIGEST_SIZE bytes
+     */
+    void get_digest(uint8_t *digest) const;
+
+    /** Get the number of image bytes written so far
+     *
+     *  @return Number of bytes passed to the pipeline since begin
+     */
+    size_t get_written() const;
+
+private:
+    int update(ssize_t (*read)(void *, void *, size_t), void *source, size_t image_size,
+               const uint8_t *expected_digest);
+    int accept(size_t size);
+    int flush(bool last);
+    int prepare(uint64_t end);
+    int program(uint64_t addr, const uint8_t *data, uint32_t size);
+    int verify(uint64_t addr, const uint8_t *data, uint32_t size);
+    void erase_ahead();
+    int wait_erase();
+    void erase_done(int result);
+    void end();
+
+    BlockDevice *_bd;
+#if DEVICE_FLASH
+    FlashIAP *_flash;
+#endif
+    uint64_t _addr;
+    uint64_t _size;
+    uint32_t _program_size;
+    uint8_t _erase_value;
+    bool _needs_erase;
+
+    mbedtls_sha256_context _sha;
+    uint8_t _digest[FIRMWARE_UPDATE_DIGEST_SIZE];
+    uint8_t *_buffer;
+    uint32_t _buffer_size;
+    uint32_t _buffered;
+    uint64_t _written;
+    uint64_t _image_size;
+    uint64_t _erased_end;
+    bool _started;
+
+    rtos::Semaphore _erase_sem;
+    bool _erase_started;
+    volatile int _erase_result;
+};
+
+} // namespace mbed
+
+#endif // FIRMWARE_UPDATE_ENABLED
+
+#endif
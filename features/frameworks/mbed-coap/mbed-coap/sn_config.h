@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2011-2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SN_CONFIG_H
+#define SN_CONFIG_H
+
+#ifdef MBED_CLIENT_USER_CONFIG_FILE
+#include MBED_CLIENT_USER_CONFIG_FILE
+#endif
+
+/**
+ * \def SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+ * \brief For Message duplication detection
+ * Init value for the maximum count of messages to be stored for duplication detection
+ * Setting of this value to 0 will disable duplication check, also reduce use of ROM memory
+ * Default is set to 0.
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+#define SN_COAP_DUPLICATION_MAX_MSGS_COUNT MBED_CONF_MBED_CLIENT_SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+#endif
+
+#ifndef SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+#define SN_COAP_DUPLICATION_MAX_MSGS_COUNT              0
+#endif
+
+/**
+ * \def SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+ * \brief For Message blockwising
+ * Init value for the maximum payload size to be sent and received at one blockwise message
+ * Setting of this value to 0 will disable this feature, and also reduce use of ROM memory
+ * Note: This define is common for both received and sent Blockwise messages
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+#define SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+#endif
+
+#ifndef SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+#define SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE              0  /**< Must be 2^x and x is at least 4. Suitable values: 0, 16, 32, 64, 128, 256, 512 and 1024 */
+#endif
+
+/**
+ * \def SN_COAP_BLOCKWISE_ENABLED
+ * \brief Enables the blockwise functionality in CoAP library also when blockwise payload
+ * size is set to '0' in SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE.
+ */
+#ifndef SN_COAP_BLOCKWISE_ENABLED
+#define SN_COAP_BLOCKWISE_ENABLED                       0  /**< Enable blockwise */
+#endif
+
+/**
+ * \def SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED
+ * \brief Sets the CoAP re-send interval in seconds.
+ * Maximum time in seconds how long blockwise messages and payloads are stored.
+ */
+#ifndef SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED
+#define SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED          60 /**< Maximum time in seconds of data (messages and payload) to be stored for blockwising */
+#endif
+
+/**
+ * \def SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE
+ * \brief Maximum size of blockwise message that can be received.
+ * The library refuses a transfer that announces a larger Size1.
+ */
+#ifndef SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE
+#define SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE         UINT16_MAX
+#endif
+
+/**
+ * \def SN_COAP_MAX_NONBLOCKWISE_PAYLOAD_SIZE
+ * \brief Payloads larger than this are sent using blockwise transfer.
+ * Defaults to the blockwise payload size.
+ */
+#ifndef SN_COAP_MAX_NONBLOCKWISE_PAYLOAD_SIZE
+#define SN_COAP_MAX_NONBLOCKWISE_PAYLOAD_SIZE           SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+#endif
+
+/**
+ * \def ENABLE_RESENDINGS
+ * \brief Disables resending feature. Resending feature should not be needed
+ * when using CoAP with TCP transport for example. By default resendings are
+ * enabled. Set to 0 to disable.
+ */
+#ifdef MBED_CONF_MBED_CLIENT_ENABLE_RESENDINGS
+#define ENABLE_RESENDINGS MBED_CONF_MBED_CLIENT_ENABLE_RESENDINGS
+#endif
+
+#ifndef ENABLE_RESENDINGS
+#define ENABLE_RESENDINGS                               1  /**< Enable / Disable resending from library in building */
+#endif
+
+/**
+ * \def SN_COAP_RESENDING_QUEUE_SIZE_MSGS
+ * \brief Sets the number of messages stored
+ * in the resending queue. Default is 2
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_RESENDING_QUEUE_SIZE_MSGS
+#define SN_COAP_RESENDING_QUEUE_SIZE_MSGS MBED_CONF_MBED_CLIENT_SN_COAP_RESENDING_QUEUE_SIZE_MSGS
+#endif
+
+#ifndef SN_COAP_RESENDING_QUEUE_SIZE_MSGS
+#define SN_COAP_RESENDING_QUEUE_SIZE_MSGS               2  /**< Default re-sending queue size - defines how many messages can be stored. Setting this to 0 disables feature */
+#endif
+
+/**
+ * \def SN_COAP_RESENDING_QUEUE_SIZE_BYTES
+ * \brief Sets the size of the re-sending buffer.
+ * Setting this to 0 disables this feature.
+ * By default, this feature is disabled.
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_RESENDING_QUEUE_SIZE_BYTES
+#define SN_COAP_RESENDING_QUEUE_SIZE_BYTES MBED_CONF_MBED_CLIENT_SN_COAP_RESENDING_QUEUE_SIZE_BYTES
+#endif
+
+#ifndef SN_COAP_RESENDING_QUEUE_SIZE_BYTES
+#define SN_COAP_RESENDING_QUEUE_SIZE_BYTES              0  /**< Default re-sending queue size - defines size of the re-sending buffer. Setting this to 0 disables feature */
+#endif
+
+/**
+ * \def DEFAULT_RESPONSE_TIMEOUT
+ * \brief Sets the CoAP re-send interval in seconds.
+ * By default is 10 seconds.
+ */
+#ifndef DEFAULT_RESPONSE_TIMEOUT
+#define DEFAULT_RESPONSE_TIMEOUT                        10  /**< Default re-sending timeout as seconds */
+#endif
+
+/**
+ * \def SN_COAP_RESENDING_MAX_COUNT
+ * \brief Defines how many times CoAP library tries to re-send the CoAP packet.
+ * By default value is 3.
+ */
+#ifndef SN_COAP_RESENDING_MAX_COUNT
+#define SN_COAP_RESENDING_MAX_COUNT                     3
+#endif
+
+/**
+ * \def SN_COAP_MAX_ALLOWED_RESENDING_COUNT
+ * \brief Maximum allowed count of re-sending
+ */
+#ifndef SN_COAP_MAX_ALLOWED_RESENDING_COUNT
+#define SN_COAP_MAX_ALLOWED_RESENDING_COUNT             6
+#endif
+
+/**
+ * \def SN_COAP_MAX_ALLOWED_RESPONSE_TIMEOUT
+ * \brief Maximum allowed re-send interval in seconds
+ */
+#ifndef SN_COAP_MAX_ALLOWED_RESPONSE_TIMEOUT
+#define SN_COAP_MAX_ALLOWED_RESPONSE_TIMEOUT            40
+#endif
+
+/**
+ * \def SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS
+ * \brief Maximum allowed count of messages that can be stored into resending buffer
+ */
+#ifndef SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS
+#define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS    6
+#endif
+
+/**
+ * \def SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES
+ * \brief Maximum allowed size of re-sending buffer
+ */
+#ifndef SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES
+#define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES   512
+#endif
+
+/**
+ * \def SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT
+ * \brief Maximum allowed number of saved messages for message duplicate searching
+ */
+#ifndef SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT
+#define SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT   6
+#endif
+
+/**
+ * \def SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED
+ * \brief Maximum time in seconds of messages to be stored for duplication detection
+ */
+#ifndef SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED
+#define SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED        60
+#endif
+
+#endif // SN_CONFIG_H
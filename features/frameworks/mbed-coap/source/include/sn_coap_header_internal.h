@@ -71,6 +71,28 @@ typedef struct sn_nsdl_transmit_ {
 /* * * * * * * * * * * * * * * * * * * * * * */
 extern int8_t           sn_coap_header_validity_check(sn_coap_hdr_s *src_coap_msg_ptr, coap_version_e coap_version);
 
+/**
+ * \brief Parses a CoAP message in place, without any memory allocation
+ *
+ * Token, option values and payload of the parsed message point into the Packet data, so the
+ * message is valid as long as the Packet data is. Several Uri-Path, Uri-Query, Location-Path,
+ * Location-Query or ETag options are joined in the Packet data with the separators used by
+ * sn_coap_parser(), which modifies their option headers.
+ *
+ * The message must not be released with sn_coap_parser_release_allocated_coap_msg_mem().
+ *
+ * \param packet_data_len is length of the Packet data
+ * \param *packet_data_ptr is the Packet data, modified by the parsing
+ * \param *dst_coap_msg_ptr is destination for parsed CoAP message
+ * \param *dst_options_ptr is storage for the options of the message, used only if it has options
+ * \param *coap_version_ptr is destination for parsed CoAP specification version
+ *
+ * \return Return value is 0 in ok case and -1 in failure case, when the status of the message is
+ *         COAP_STATUS_PARSER_ERROR_IN_HEADER if the Packet data was invalid
+ */
+extern int8_t           sn_coap_parser_view(uint16_t packet_data_len, uint8_t *packet_data_ptr, sn_coap_hdr_s *dst_coap_msg_ptr,
+                                            sn_coap_options_list_s *dst_options_ptr, coap_version_e *coap_version_ptr);
+
 #endif /* SN_COAP_HEADER_INTERNAL_H_ */
 
 #ifdef __cplusplus
@@ -41,8 +41,67 @@ struct sn_coap_hdr_;
 #define COAP_OPTION_URI_PORT_NONE                   (-1) /**< Internal value to represent no Uri-Port option */
 #define COAP_OPTION_BLOCK_NONE                      (-1) /**< Internal value to represent no Block1/2 option */
 
+/* * For lookup of stored messages * */
+#ifndef SN_COAP_RESENDING_HASH_SIZE
+#define SN_COAP_RESENDING_HASH_SIZE                 8 /**< Buckets of the resending message hashes, must be a power of 2 */
+#endif
+#ifndef SN_COAP_DUPLICATION_HASH_SIZE
+#define SN_COAP_DUPLICATION_HASH_SIZE               8 /**< Buckets of the duplication info hash, must be a power of 2 */
+#endif
+
+/* * For Block2 transfers handled internally * */
+#ifndef SN_COAP_BLOCKWISE_WINDOW_SIZE
+#define SN_COAP_BLOCKWISE_WINDOW_SIZE               1 /**< Default count of Block2 requests outstanding at the same time */
+#endif
+#ifndef SN_COAP_MAX_ALLOWED_BLOCKWISE_WINDOW_SIZE
+#define SN_COAP_MAX_ALLOWED_BLOCKWISE_WINDOW_SIZE   8 /**< Maximum count of Block2 requests outstanding at the same time */
+#endif
+
+/**
+ * \brief Callback receiving the payload of a Block2 transfer in order, block by block
+ *
+ * \param *coap_msg_ptr Response carrying the block, or the one completing the transfer
+ * \param offset Offset of the block in the whole payload
+ * \param *payload_ptr Payload of the block
+ * \param payload_len Length of the block
+ * \param *param Parameter given with the request
+ */
+typedef void sn_coap_block2_stream_cb(const sn_coap_hdr_s *coap_msg_ptr, uint32_t offset, const uint8_t *payload_ptr, uint16_t payload_len, void *param);
+
 int8_t prepare_blockwise_message(struct coap_s *handle, struct sn_coap_hdr_ *coap_hdr_ptr);
 
+/**
+ * \fn int8_t sn_coap_protocol_set_block2_window(struct coap_s *handle, uint8_t window)
+ *
+ * \brief Sets the count of Block2 requests sent without waiting for the previous responses
+ *
+ * Only used when Block2 responses are handled internally. The following blocks are requested
+ * ahead once the size of the transfer is known from the Size2 option; without it, blocks
+ * are requested one at a time.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param window Requests outstanding at the same time, 1 to SN_COAP_MAX_ALLOWED_BLOCKWISE_WINDOW_SIZE
+ *
+ * \return 0 = success, -1 = failure
+ */
+int8_t sn_coap_protocol_set_block2_window(struct coap_s *handle, uint8_t window);
+
+/**
+ * \fn int8_t sn_coap_protocol_set_block2_stream_callback(struct coap_s *handle, sn_coap_block2_stream_cb *callback)
+ *
+ * \brief Sets the callback receiving Block2 payloads handled internally
+ *
+ * With a callback, each block is given to it in order and dropped, instead of being kept
+ * until the whole payload is gathered. The message completing the transfer is then returned
+ * with COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED status and no payload.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param *callback Callback, NULL to gather the whole payload
+ *
+ * \return 0 = success, -1 = failure
+ */
+int8_t sn_coap_protocol_set_block2_stream_callback(struct coap_s *handle, sn_coap_block2_stream_cb *callback);
+
 /* Structure which is stored to Linked list for message sending purposes */
 typedef struct coap_send_msg_ {
     uint8_t             resending_counter;  /* Tells how many times message is still tried to resend */
@@ -53,10 +112,14 @@ typedef struct coap_send_msg_ {
     struct coap_s       *coap;              /* CoAP library handle */
     void                *param;             /* Extra parameter that will be passed to TX/RX callback functions */
 
-    ns_list_link_t      link;
+    ns_list_link_t      link;               /* Resending queue, ordered by resending time */
+    ns_list_link_t      msg_id_link;        /* Message ID hash bucket */
+    ns_list_link_t      token_link;         /* Token hash bucket */
 } coap_send_msg_s;
 
 typedef NS_LIST_HEAD(coap_send_msg_s, link) coap_send_msg_list_t;
+typedef NS_LIST_HEAD(coap_send_msg_s, msg_id_link) coap_send_msg_id_bucket_t;
+typedef NS_LIST_HEAD(coap_send_msg_s, token_link) coap_send_msg_token_bucket_t;
 
 /* Structure which is stored to Linked list for message duplication detection purposes */
 typedef struct coap_duplication_info_ {
@@ -67,10 +130,12 @@ typedef struct coap_duplication_info_ {
     struct coap_s       *coap;  /* CoAP library handle */
     sn_nsdl_addr_s      *address;
     void                *param;
-    ns_list_link_t      link;
+    ns_list_link_t      link;       /* Duplication info list, oldest first */
+    ns_list_link_t      hash_link;  /* Address and Message ID hash bucket */
 } coap_duplication_info_s;
 
 typedef NS_LIST_HEAD(coap_duplication_info_s, link) coap_duplication_info_list_t;
+typedef NS_LIST_HEAD(coap_duplication_info_s, hash_link) coap_duplication_info_bucket_t;
 
 /* Structure which is stored to Linked list for blockwise messages sending purposes */
 typedef struct coap_blockwise_msg_ {
@@ -82,6 +147,9 @@ typedef struct coap_blockwise_msg_ {
     void                *param;
     uint16_t            msg_id;
 
+    uint32_t            block2_count; /* Blocks of the Block2 transfer requested, 0 if not known yet */
+    uint32_t            block2_next;  /* Next Block2 block given to the stream callback */
+
     ns_list_link_t      link;
 } coap_blockwise_msg_s;
 
@@ -116,17 +184,23 @@ struct coap_s {
 
     #if ENABLE_RESENDINGS /* If Message resending is not used at all, this part of code will not be compiled */
         coap_send_msg_list_t linked_list_resent_msgs; /* Active resending messages are stored to this Linked list */
+        coap_send_msg_id_bucket_t resent_msgs_by_msg_id[SN_COAP_RESENDING_HASH_SIZE];
+        coap_send_msg_token_bucket_t resent_msgs_by_token[SN_COAP_RESENDING_HASH_SIZE];
         uint16_t count_resent_msgs;
+        uint32_t size_resent_msgs; /* Total packet length of active resending messages */
     #endif
 
     #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
         coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list */
+        coap_duplication_info_bucket_t duplication_msgs_by_msg_id[SN_COAP_DUPLICATION_HASH_SIZE];
         uint16_t                      count_duplication_msgs;
     #endif
 
     #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwise is not enabled, this part of code will not be compiled */
         coap_blockwise_msg_list_t     linked_list_blockwise_sent_msgs; /* Blockwise message to to be sent is stored to this Linked list */
         coap_blockwise_payload_list_t linked_list_blockwise_received_payloads; /* Blockwise payload to to be received is stored to this Linked list */
+        sn_coap_block2_stream_cb      *sn_coap_block2_stream_callback; /* If set, Block2 payloads are given to this callback instead of being gathered */
+        uint8_t                       sn_coap_block2_window; /* Block2 requests outstanding at the same time */
     #endif
 
     uint32_t system_time;    /* System time seconds */
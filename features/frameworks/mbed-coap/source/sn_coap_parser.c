@@ -43,8 +43,10 @@
 /* * * * * * * * * * * * * * * * * * * * */
 
 static void     sn_coap_parser_header_parse(uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, coap_version_e *coap_version_ptr);
-static int8_t   sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len);
-static int8_t   sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len);
+static int8_t   sn_coap_parser_parse(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, sn_coap_hdr_s *dst_coap_msg_ptr, sn_coap_options_list_s *view_options_ptr, coap_version_e *coap_version_ptr);
+static sn_coap_options_list_s *sn_coap_parser_init_options(sn_coap_options_list_s *options_ptr);
+static int8_t   sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len, sn_coap_options_list_s *view_options_ptr);
+static int8_t   sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len, bool in_place);
 static int16_t  sn_coap_parser_options_count_needed_memory_multiple_option(uint8_t *packet_data_ptr, uint16_t packet_left_len, sn_coap_option_numbers_e option, uint16_t option_number_len);
 static int8_t   sn_coap_parser_payload_parse(uint16_t packet_data_len, uint8_t *packet_data_start_ptr, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr);
 
@@ -99,22 +101,35 @@ sn_coap_options_list_s *sn_coap_parser_alloc_options(struct coap_s *handle, sn_c
         return NULL;
     }
 
+    return sn_coap_parser_init_options(coap_msg_ptr->options_list_ptr);
+}
+
+/**
+ * \fn static sn_coap_options_list_s *sn_coap_parser_init_options(sn_coap_options_list_s *options_ptr)
+ *
+ * \brief Initializes options with default values
+ *
+ * \param *options_ptr is pointer to initialized options
+ *
+ * \return Return value is options_ptr
+ */
+static sn_coap_options_list_s *sn_coap_parser_init_options(sn_coap_options_list_s *options_ptr)
+{
     /* XXX not technically legal to memset pointers to 0 */
-    memset(coap_msg_ptr->options_list_ptr, 0x00, sizeof(sn_coap_options_list_s));
+    memset(options_ptr, 0x00, sizeof(sn_coap_options_list_s));
 
-    coap_msg_ptr->options_list_ptr->max_age = 0;
-    coap_msg_ptr->options_list_ptr->uri_port = COAP_OPTION_URI_PORT_NONE;
-    coap_msg_ptr->options_list_ptr->observe = COAP_OBSERVE_NONE;
-    coap_msg_ptr->options_list_ptr->accept = COAP_CT_NONE;
-    coap_msg_ptr->options_list_ptr->block2 = COAP_OPTION_BLOCK_NONE;
-    coap_msg_ptr->options_list_ptr->block1 = COAP_OPTION_BLOCK_NONE;
+    options_ptr->max_age = 0;
+    options_ptr->uri_port = COAP_OPTION_URI_PORT_NONE;
+    options_ptr->observe = COAP_OBSERVE_NONE;
+    options_ptr->accept = COAP_CT_NONE;
+    options_ptr->block2 = COAP_OPTION_BLOCK_NONE;
+    options_ptr->block1 = COAP_OPTION_BLOCK_NONE;
 
-    return coap_msg_ptr->options_list_ptr;
+    return options_ptr;
 }
 
 sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
 {
-    uint8_t       *data_temp_ptr                    = packet_data_ptr;
     sn_coap_hdr_s *parsed_and_returned_coap_msg_ptr = NULL;
 
     /* * * * Check given pointer * * * */
@@ -130,23 +145,59 @@ sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, u
         return NULL;
     }
 
+    /* * * * Parse CoAP message, errors are returned in its status * * * */
+    sn_coap_parser_parse(handle, packet_data_len, packet_data_ptr, parsed_and_returned_coap_msg_ptr, NULL, coap_version_ptr);
+
+    /* * * * Return parsed CoAP message  * * * * */
+    return parsed_and_returned_coap_msg_ptr;
+}
+
+int8_t sn_coap_parser_view(uint16_t packet_data_len, uint8_t *packet_data_ptr, sn_coap_hdr_s *dst_coap_msg_ptr,
+                           sn_coap_options_list_s *dst_options_ptr, coap_version_e *coap_version_ptr)
+{
+    /* * * * Check given pointers * * * */
+    if (packet_data_ptr == NULL || packet_data_len < 4 || dst_coap_msg_ptr == NULL || dst_options_ptr == NULL) {
+        return -1;
+    }
+
+    sn_coap_parser_init_message(dst_coap_msg_ptr);
+
+    return sn_coap_parser_parse(NULL, packet_data_len, packet_data_ptr, dst_coap_msg_ptr, dst_options_ptr, coap_version_ptr);
+}
+
+/**
+ * \fn static int8_t sn_coap_parser_parse(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, sn_coap_hdr_s *dst_coap_msg_ptr, sn_coap_options_list_s *view_options_ptr, coap_version_e *coap_version_ptr)
+ *
+ * \brief Parses CoAP message from given Packet data
+ *
+ * \param *dst_coap_msg_ptr is destination for parsed CoAP message
+ *
+ * \param *view_options_ptr is NULL to copy token and option values to allocated memory, or storage
+ *        for the options of a message parsed in place
+ *
+ * \return Return value is 0 in ok case and -1 in failure case, when the status of the message is also set
+ */
+static int8_t sn_coap_parser_parse(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, sn_coap_hdr_s *dst_coap_msg_ptr,
+                                   sn_coap_options_list_s *view_options_ptr, coap_version_e *coap_version_ptr)
+{
+    uint8_t *data_temp_ptr = packet_data_ptr;
+
     /* * * * Header parsing, move pointer over the header...  * * * */
-    sn_coap_parser_header_parse(&data_temp_ptr, parsed_and_returned_coap_msg_ptr, coap_version_ptr);
+    sn_coap_parser_header_parse(&data_temp_ptr, dst_coap_msg_ptr, coap_version_ptr);
 
     /* * * * Options parsing, move pointer over the options... * * * */
-    if (sn_coap_parser_options_parse(handle, &data_temp_ptr, parsed_and_returned_coap_msg_ptr, packet_data_ptr, packet_data_len) != 0) {
-        parsed_and_returned_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_ERROR_IN_HEADER;
-        return parsed_and_returned_coap_msg_ptr;
+    if (sn_coap_parser_options_parse(handle, &data_temp_ptr, dst_coap_msg_ptr, packet_data_ptr, packet_data_len, view_options_ptr) != 0) {
+        dst_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_ERROR_IN_HEADER;
+        return -1;
     }
 
     /* * * * Payload parsing * * * */
-    if (sn_coap_parser_payload_parse(packet_data_len, packet_data_ptr, &data_temp_ptr, parsed_and_returned_coap_msg_ptr) == -1) {
-        parsed_and_returned_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_ERROR_IN_HEADER;
-        return parsed_and_returned_coap_msg_ptr;
+    if (sn_coap_parser_payload_parse(packet_data_len, packet_data_ptr, &data_temp_ptr, dst_coap_msg_ptr) == -1) {
+        dst_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_ERROR_IN_HEADER;
+        return -1;
     }
 
-    /* * * * Return parsed CoAP message  * * * * */
-    return parsed_and_returned_coap_msg_ptr;
+    return 0;
 }
 
 void sn_coap_parser_release_allocated_coap_msg_mem(struct coap_s *handle, sn_coap_hdr_s *freed_coap_msg_ptr)
@@ -250,10 +301,11 @@ static uint32_t sn_coap_parser_options_parse_uint(uint8_t **packet_data_pptr, ui
  *
  * \param **packet_data_pptr is source of Packet data to be parsed to CoAP message
  * \param *dst_coap_msg_ptr is destination for parsed CoAP message
+ * \param *view_options_ptr is storage for the options when the message is parsed in place, else NULL
  *
  * \return Return value is 0 in ok case and -1 in failure case
  */
-static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len)
+static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len, sn_coap_options_list_s *view_options_ptr)
 {
     uint8_t previous_option_number = 0;
     uint8_t i                      = 0;
@@ -264,19 +316,24 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
     dst_coap_msg_ptr->token_len = *packet_data_start_ptr & COAP_HEADER_TOKEN_LENGTH_MASK;
 
     if (dst_coap_msg_ptr->token_len) {
-        if ((dst_coap_msg_ptr->token_len > 8) || dst_coap_msg_ptr->token_ptr) {
+        if ((dst_coap_msg_ptr->token_len > 8) || dst_coap_msg_ptr->token_ptr ||
+                (dst_coap_msg_ptr->token_len > packet_len - COAP_HEADER_LENGTH)) {
             tr_error("sn_coap_parser_options_parse - token not valid!");
             return -1;
         }
 
-        dst_coap_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(dst_coap_msg_ptr->token_len);
+        if (view_options_ptr) {
+            dst_coap_msg_ptr->token_ptr = *packet_data_pptr;
+        } else {
+            dst_coap_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(dst_coap_msg_ptr->token_len);
 
-        if (dst_coap_msg_ptr->token_ptr == NULL) {
-            tr_error("sn_coap_parser_options_parse - failed to allocate token!");
-            return -1;
-        }
+            if (dst_coap_msg_ptr->token_ptr == NULL) {
+                tr_error("sn_coap_parser_options_parse - failed to allocate token!");
+                return -1;
+            }
 
-        memcpy(dst_coap_msg_ptr->token_ptr, *packet_data_pptr, dst_coap_msg_ptr->token_len);
+            memcpy(dst_coap_msg_ptr->token_ptr, *packet_data_pptr, dst_coap_msg_ptr->token_len);
+        }
         (*packet_data_pptr) += dst_coap_msg_ptr->token_len;
     }
 
@@ -292,9 +349,17 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
         uint16_t  option_number = (**packet_data_pptr >> COAP_OPTIONS_OPTION_NUMBER_SHIFT);
 
         if (option_number == 13) {
+            if (message_left < 2) {
+                tr_error("sn_coap_parser_options_parse - option delta truncated!");
+                return -1;
+            }
             option_number = *(*packet_data_pptr + 1) + 13;
             (*packet_data_pptr)++;
         } else if (option_number == 14) {
+            if (message_left < 3) {
+                tr_error("sn_coap_parser_options_parse - option delta truncated!");
+                return -1;
+            }
             option_number = *(*packet_data_pptr + 2);
             option_number += (*(*packet_data_pptr + 1) << 8) + 269;
             (*packet_data_pptr) += 2;
@@ -308,11 +373,21 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
         /* Add previous option to option delta and get option number */
         option_number += previous_option_number;
 
+        message_left = packet_len - (*packet_data_pptr - packet_data_start_ptr);
+
         /* Add possible option length extension to resolve full length of the option */
         if (option_len == 13) {
+            if (message_left < 2) {
+                tr_error("sn_coap_parser_options_parse - option length truncated!");
+                return -1;
+            }
             option_len = *(*packet_data_pptr + 1) + 13;
             (*packet_data_pptr)++;
         } else if (option_len == 14) {
+            if (message_left < 3) {
+                tr_error("sn_coap_parser_options_parse - option length truncated!");
+                return -1;
+            }
             option_len = *(*packet_data_pptr + 2);
             option_len += (*(*packet_data_pptr + 1) << 8) + 269;
             (*packet_data_pptr) += 2;
@@ -325,6 +400,12 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
 
         message_left = packet_len - (*packet_data_pptr - packet_data_start_ptr);
 
+        /* Option value follows the last byte of the option header */
+        if (option_len > message_left - 1) {
+            tr_error("sn_coap_parser_options_parse - option value truncated!");
+            return -1;
+        }
+
         /* * * Parse option itself * * */
         /* Some options are handled independently in own functions */
         previous_option_number = option_number;
@@ -344,7 +425,11 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             case COAP_OPTION_ACCEPT:
             case COAP_OPTION_SIZE1:
             case COAP_OPTION_SIZE2:
-                if (sn_coap_parser_alloc_options(handle, dst_coap_msg_ptr) == NULL) {
+                if (view_options_ptr) {
+                    if (dst_coap_msg_ptr->options_list_ptr == NULL) {
+                        dst_coap_msg_ptr->options_list_ptr = sn_coap_parser_init_options(view_options_ptr);
+                    }
+                } else if (sn_coap_parser_alloc_options(handle, dst_coap_msg_ptr) == NULL) {
                     tr_error("sn_coap_parser_options_parse - failed to allocate options!");
                     return -1;
                 }
@@ -379,33 +464,41 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 dst_coap_msg_ptr->options_list_ptr->proxy_uri_len = option_len;
                 (*packet_data_pptr)++;
 
-                dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = handle->sn_coap_protocol_malloc(option_len);
+                if (view_options_ptr) {
+                    dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = *packet_data_pptr;
+                } else {
+                    dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = handle->sn_coap_protocol_malloc(option_len);
 
-                if (dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr == NULL) {
-                    tr_error("sn_coap_parser_options_parse - COAP_OPTION_PROXY_URI allocation failed!");
-                    return -1;
-                }
+                    if (dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr == NULL) {
+                        tr_error("sn_coap_parser_options_parse - COAP_OPTION_PROXY_URI allocation failed!");
+                        return -1;
+                    }
 
-                memcpy(dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr, *packet_data_pptr, option_len);
+                    memcpy(dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr, *packet_data_pptr, option_len);
+                }
                 (*packet_data_pptr) += option_len;
 
                 break;
 
-            case COAP_OPTION_ETAG:
+            case COAP_OPTION_ETAG: {
                 /* This is managed independently because User gives this option in one character table */
+                /* etag_len is only 8 bits, the joined length is checked before storing it */
+                uint16_t etag_len = 0;
 
                 ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr,
                              message_left,
                              &dst_coap_msg_ptr->options_list_ptr->etag_ptr,
-                             (uint16_t *)&dst_coap_msg_ptr->options_list_ptr->etag_len,
-                             COAP_OPTION_ETAG, option_len);
-                if (ret_status >= 0) {
+                             &etag_len,
+                             COAP_OPTION_ETAG, option_len, view_options_ptr != NULL);
+                if (ret_status >= 0 && etag_len <= UINT8_MAX) {
+                    dst_coap_msg_ptr->options_list_ptr->etag_len = etag_len;
                     i += (ret_status - 1); /* i += is because possible several Options are handled by sn_coap_parser_options_parse_multiple_options() */
                 } else {
                     tr_error("sn_coap_parser_options_parse - COAP_OPTION_ETAG not valid!");
                     return -1;
                 }
                 break;
+            }
 
             case COAP_OPTION_URI_HOST:
                 if ((option_len > 255) || (option_len < 1) || dst_coap_msg_ptr->options_list_ptr->uri_host_ptr) {
@@ -415,13 +508,17 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 dst_coap_msg_ptr->options_list_ptr->uri_host_len = option_len;
                 (*packet_data_pptr)++;
 
-                dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = handle->sn_coap_protocol_malloc(option_len);
+                if (view_options_ptr) {
+                    dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = *packet_data_pptr;
+                } else {
+                    dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = handle->sn_coap_protocol_malloc(option_len);
 
-                if (dst_coap_msg_ptr->options_list_ptr->uri_host_ptr == NULL) {
-                    tr_error("sn_coap_parser_options_parse - COAP_OPTION_URI_HOST allocation failed!");
-                    return -1;
+                    if (dst_coap_msg_ptr->options_list_ptr->uri_host_ptr == NULL) {
+                        tr_error("sn_coap_parser_options_parse - COAP_OPTION_URI_HOST allocation failed!");
+                        return -1;
+                    }
+                    memcpy(dst_coap_msg_ptr->options_list_ptr->uri_host_ptr, *packet_data_pptr, option_len);
                 }
-                memcpy(dst_coap_msg_ptr->options_list_ptr->uri_host_ptr, *packet_data_pptr, option_len);
                 (*packet_data_pptr) += option_len;
 
                 break;
@@ -434,7 +531,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 /* This is managed independently because User gives this option in one character table */
                 ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->options_list_ptr->location_path_ptr, &dst_coap_msg_ptr->options_list_ptr->location_path_len,
-                             COAP_OPTION_LOCATION_PATH, option_len);
+                             COAP_OPTION_LOCATION_PATH, option_len, view_options_ptr != NULL);
                 if (ret_status >= 0) {
                     i += (ret_status - 1); /* i += is because possible several Options are handled by sn_coap_parser_options_parse_multiple_options() */
                 } else {
@@ -458,7 +555,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             case COAP_OPTION_LOCATION_QUERY:
                 ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->options_list_ptr->location_query_ptr, &dst_coap_msg_ptr->options_list_ptr->location_query_len,
-                             COAP_OPTION_LOCATION_QUERY, option_len);
+                             COAP_OPTION_LOCATION_QUERY, option_len, view_options_ptr != NULL);
                 if (ret_status >= 0) {
                     i += (ret_status - 1); /* i += is because possible several Options are handled by sn_coap_parser_options_parse_multiple_options() */
                 } else {
@@ -471,7 +568,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             case COAP_OPTION_URI_PATH:
                 ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->uri_path_ptr, &dst_coap_msg_ptr->uri_path_len,
-                             COAP_OPTION_URI_PATH, option_len);
+                             COAP_OPTION_URI_PATH, option_len, view_options_ptr != NULL);
                 if (ret_status >= 0) {
                     i += (ret_status - 1); /* i += is because possible several Options are handled by sn_coap_parser_options_parse_multiple_options() */
                 } else {
@@ -496,7 +593,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             case COAP_OPTION_URI_QUERY:
                 ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->options_list_ptr->uri_query_ptr, &dst_coap_msg_ptr->options_list_ptr->uri_query_len,
-                             COAP_OPTION_URI_QUERY, option_len);
+                             COAP_OPTION_URI_QUERY, option_len, view_options_ptr != NULL);
                 if (ret_status >= 0) {
                     i += (ret_status - 1); /* i += is because possible several Options are handled by sn_coap_parser_options_parse_multiple_options() */
                 } else {
@@ -591,9 +688,12 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
  *
  * \param *previous_option_number_ptr is pointer to used and returned previous Option number
  *
+ * \param in_place tells to join the option parts in the Packet data instead of allocated memory. The
+ *        separators and parts are moved over the option headers, which are always at least as long.
+ *
  * \return Return value is count of Uri-query optios parsed. In failure case -1 is returned.
 */
-static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len)
+static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len, bool in_place)
 {
     int16_t     uri_query_needed_heap       = sn_coap_parser_options_count_needed_memory_multiple_option(*packet_data_pptr, packet_left_len, option, option_number_len);
     uint8_t    *temp_parsed_uri_query_ptr   = NULL;
@@ -603,7 +703,10 @@ static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handl
         return -1;
     }
 
-    if (uri_query_needed_heap) {
+    if (uri_query_needed_heap && in_place) {
+        /* First part starts after the option header */
+        *dst_pptr = *packet_data_pptr + 1;
+    } else if (uri_query_needed_heap) {
         *dst_pptr = (uint8_t *) handle->sn_coap_protocol_malloc(uri_query_needed_heap);
 
         if (*dst_pptr == NULL) {
@@ -639,7 +742,8 @@ static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handl
             return -1;
         }
 
-        memcpy(temp_parsed_uri_query_ptr, *packet_data_pptr, option_number_len);
+        /* Parts overlap the Packet data when parsed in place */
+        memmove(temp_parsed_uri_query_ptr, *packet_data_pptr, option_number_len);
 
         (*packet_data_pptr) += option_number_len;
         temp_parsed_uri_query_ptr += option_number_len;
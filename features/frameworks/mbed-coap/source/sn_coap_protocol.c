@@ -43,6 +43,10 @@
 #include "mbed-trace/mbed_trace.h"
 
 #define TRACE_GROUP "coap"
+
+/* Duplication info hash bucket of Address port and Message ID */
+#define SN_COAP_DUPLICATION_HASH(port, msg_id) (((port) ^ (msg_id)) & (SN_COAP_DUPLICATION_HASH_SIZE - 1))
+
 /* * * * * * * * * * * * * * * * * * * * */
 /* * * * LOCAL FUNCTION PROTOTYPES * * * */
 /* * * * * * * * * * * * * * * * * * * * */
@@ -51,6 +55,7 @@
 static void                  sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id, void *param);
 static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle, const sn_nsdl_addr_s *scr_addr_ptr, const uint16_t msg_id);
 static void                  sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle);
+static void                  sn_coap_protocol_linked_list_duplication_info_release(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr);
 static bool                  sn_coap_protocol_update_duplicate_package_data(const struct coap_s *handle, const sn_nsdl_addr_s *dst_addr_ptr, const sn_coap_hdr_s *coap_msg_ptr, const int16_t data_size, const uint8_t *dst_packet_data_ptr);
 #endif
 
@@ -64,6 +69,9 @@ static void                  sn_coap_protocol_linked_list_blockwise_payload_remo
 static uint32_t              sn_coap_protocol_linked_list_blockwise_payloads_get_len(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint8_t *token_ptr, uint8_t token_len);
 static void                  sn_coap_protocol_handle_blockwise_timout(struct coap_s *handle);
 static sn_coap_hdr_s        *sn_coap_handle_blockwise_message(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param);
+static coap_blockwise_msg_s *sn_coap_protocol_send_block2_request(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, const sn_coap_hdr_s *previous_coap_msg_ptr, uint32_t block_number, uint8_t block_temp, void *param);
+static int8_t                sn_coap_protocol_linked_list_blockwise_payload_gather(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr);
+static sn_coap_hdr_s        *sn_coap_handle_block2_response(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param);
 static sn_coap_hdr_s        *sn_coap_protocol_copy_header(struct coap_s *handle, sn_coap_hdr_s *source_header_ptr);
 #endif
 
@@ -73,7 +81,11 @@ static sn_nsdl_transmit_s   *sn_coap_protocol_linked_list_send_msg_search(struct
 static void                  sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
 static coap_send_msg_s      *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t packet_data_len);
 static void                  sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handle, coap_send_msg_s *freed_send_msg_ptr);
-static uint16_t              sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr);
+static void                  sn_coap_protocol_linked_list_send_msg_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+static void                  sn_coap_protocol_linked_list_send_msg_queue(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+static void                  sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+static uint16_t              sn_coap_protocol_send_msg_id(const coap_send_msg_s *stored_msg_ptr);
+static uint8_t               sn_coap_protocol_token_hash(const uint8_t *token_ptr, uint8_t token_len);
 static uint32_t              sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint8_t interval, const uint8_t counter);
 #endif
 
@@ -96,22 +108,7 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     ns_list_foreach_safe(coap_duplication_info_s, tmp, &handle->linked_list_duplication_msgs) {
         if (tmp->coap == handle) {
-            if (tmp->address) {
-                if (tmp->address->addr_ptr) {
-                    handle->sn_coap_protocol_free(tmp->address->addr_ptr);
-                    tmp->address->addr_ptr = 0;
-                }
-                handle->sn_coap_protocol_free(tmp->address);
-                tmp->address = 0;
-            }
-            if (tmp->packet_ptr) {
-                handle->sn_coap_protocol_free(tmp->packet_ptr);
-                tmp->packet_ptr = 0;
-            }
-            ns_list_remove(&handle->linked_list_duplication_msgs, tmp);
-            handle->count_duplication_msgs--;
-            handle->sn_coap_protocol_free(tmp);
-            tmp = 0;
+            sn_coap_protocol_linked_list_duplication_info_release(handle, tmp);
         }
     }
 
@@ -175,6 +172,10 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 #if ENABLE_RESENDINGS  /* If Message resending is not used at all, this part of code will not be compiled */
     /* * * * Create Linked list for storing active resending messages  * * * */
     ns_list_init(&handle->linked_list_resent_msgs);
+    for (uint8_t i = 0; i < SN_COAP_RESENDING_HASH_SIZE; i++) {
+        ns_list_init(&handle->resent_msgs_by_msg_id[i]);
+        ns_list_init(&handle->resent_msgs_by_token[i]);
+    }
     handle->sn_coap_resending_queue_msgs = SN_COAP_RESENDING_QUEUE_SIZE_MSGS;
     handle->sn_coap_resending_queue_bytes = SN_COAP_RESENDING_QUEUE_SIZE_BYTES;
     handle->sn_coap_resending_intervall = DEFAULT_RESPONSE_TIMEOUT;
@@ -186,6 +187,9 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     /* * * * Create Linked list for storing Duplication info * * * */
     ns_list_init(&handle->linked_list_duplication_msgs);
+    for (uint8_t i = 0; i < SN_COAP_DUPLICATION_HASH_SIZE; i++) {
+        ns_list_init(&handle->duplication_msgs_by_msg_id[i]);
+    }
     handle->sn_coap_duplication_buffer_size = SN_COAP_DUPLICATION_MAX_MSGS_COUNT;
 #endif
 
@@ -194,6 +198,7 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
     ns_list_init(&handle->linked_list_blockwise_sent_msgs);
     ns_list_init(&handle->linked_list_blockwise_received_payloads);
     handle->sn_coap_block_data_size = SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE;
+    handle->sn_coap_block2_window = SN_COAP_BLOCKWISE_WINDOW_SIZE;
 
 #endif /* ENABLE_RESENDINGS */
 
@@ -274,6 +279,37 @@ void sn_coap_protocol_clear_received_blockwise_messages(struct coap_s *handle)
 #endif
 }
 
+int8_t sn_coap_protocol_set_block2_window(struct coap_s *handle, uint8_t window)
+{
+    (void) handle;
+    (void) window;
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    if (handle == NULL) {
+        return -1;
+    }
+    if (window > 0 && window <= SN_COAP_MAX_ALLOWED_BLOCKWISE_WINDOW_SIZE) {
+        handle->sn_coap_block2_window = window;
+        return 0;
+    }
+#endif
+    return -1;
+}
+
+int8_t sn_coap_protocol_set_block2_stream_callback(struct coap_s *handle, sn_coap_block2_stream_cb *callback)
+{
+    (void) handle;
+    (void) callback;
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    if (handle == NULL) {
+        return -1;
+    }
+    handle->sn_coap_block2_stream_callback = callback;
+    return 0;
+#else
+    return -1;
+#endif
+}
+
 int8_t sn_coap_protocol_set_duplicate_buffer_size(struct coap_s *handle, uint8_t message_count)
 {
     (void) handle;
@@ -338,9 +374,8 @@ void sn_coap_protocol_clear_retransmission_buffer(struct coap_s *handle)
         return;
     }
     ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        ns_list_remove(&handle->linked_list_resent_msgs, tmp);
+        sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
         sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-        --handle->count_resent_msgs;
     }
 #endif
 }
@@ -351,16 +386,11 @@ int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint16_t ms
     if (handle == NULL) {
         return -1;
     }
-    ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        if (tmp->send_msg_ptr && tmp->send_msg_ptr->packet_ptr ) {
-            uint16_t temp_msg_id = (tmp->send_msg_ptr->packet_ptr[2] << 8);
-            temp_msg_id += (uint16_t)tmp->send_msg_ptr->packet_ptr[3];
-            if(temp_msg_id == msg_id){
-                ns_list_remove(&handle->linked_list_resent_msgs, tmp);
-                --handle->count_resent_msgs;
-                sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-                return 0;
-            }
+    ns_list_foreach(coap_send_msg_s, tmp, &handle->resent_msgs_by_msg_id[msg_id & (SN_COAP_RESENDING_HASH_SIZE - 1)]) {
+        if (sn_coap_protocol_send_msg_id(tmp) == msg_id) {
+            sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
+            sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
+            return 0;
         }
     }
 #endif
@@ -375,17 +405,13 @@ int8_t sn_coap_protocol_delete_retransmission_by_token(struct coap_s *handle, ui
         return -1;
     }
 
-    ns_list_foreach(coap_send_msg_s, stored_msg, &handle->linked_list_resent_msgs) {
+    uint8_t token_hash = sn_coap_protocol_token_hash(token, token_len);
+    ns_list_foreach(coap_send_msg_s, stored_msg, &handle->resent_msgs_by_token[token_hash]) {
         uint8_t stored_token_len =  (stored_msg->send_msg_ptr->packet_ptr[0] & 0x0F);
         if (stored_token_len == token_len) {
-            uint8_t stored_token[8];
-            memcpy(stored_token, &stored_msg->send_msg_ptr->packet_ptr[4], stored_token_len);
-            if (memcmp(stored_token, token, stored_token_len) == 0) {
-                uint16_t temp_msg_id = (stored_msg->send_msg_ptr->packet_ptr[2] << 8);
-                temp_msg_id += (uint16_t)stored_msg->send_msg_ptr->packet_ptr[3];
-                tr_debug("sn_coap_protocol_delete_retransmission_by_token - removed msg_id: %d", temp_msg_id);
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg);
-                --handle->count_resent_msgs;
+            if (memcmp(&stored_msg->send_msg_ptr->packet_ptr[4], token, stored_token_len) == 0) {
+                tr_debug("sn_coap_protocol_delete_retransmission_by_token - removed msg_id: %d", sn_coap_protocol_send_msg_id(stored_msg));
+                sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg);
 
                 /* Free memory of stored message */
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg);
@@ -699,10 +725,7 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
                 coap_duplication_info_s *stored_duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs);
 
                 /* Remove oldest stored duplication message for getting room for new duplication message */
-                sn_coap_protocol_linked_list_duplication_info_remove(handle,
-                                                                     stored_duplication_info_ptr->address->addr_ptr,
-                                                                     stored_duplication_info_ptr->address->port,
-                                                                     stored_duplication_info_ptr->msg_id);
+                sn_coap_protocol_linked_list_duplication_info_release(handle, stored_duplication_info_ptr);
             }
 
             /* Store Duplication info to Linked list */
@@ -850,13 +873,8 @@ rescan:
                 if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
                     coap_version_e coap_version = COAP_VERSION_UNKNOWN;
 
-                    /* Get message ID from stored sending message */
-                    uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-                    temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
                     /* Remove message from Linked list */
-                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                    --handle->count_resent_msgs;
+                    sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
 
                     /* If RX callback have been defined.. */
                     if (stored_msg_ptr->coap->sn_coap_rx_callback != 0) {
@@ -883,11 +901,18 @@ rescan:
                     stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
                                                                                        handle->sn_coap_resending_intervall,
                                                                                        stored_msg_ptr->resending_counter);
+
+                    /* Move message to its new place in the queue */
+                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+                    sn_coap_protocol_linked_list_send_msg_queue(handle, stored_msg_ptr);
                 }
                 /* Callback routine could have wiped the list (eg as a response to sending failed) */
                 /* Be super cautious and rescan from the start */
                 goto rescan;
             }
+
+            /* Queue is ordered by resending time, the rest are not due either */
+            break;
         }
     }
 
@@ -936,7 +961,7 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
 
     /* Count resending queue size, if buffer size is defined */
     if (handle->sn_coap_resending_queue_bytes > 0) {
-        if ((sn_coap_count_linked_list_size(&handle->linked_list_resent_msgs) + send_packet_data_len) > handle->sn_coap_resending_queue_bytes) {
+        if ((handle->size_resent_msgs + send_packet_data_len) > handle->sn_coap_resending_queue_bytes) {
             tr_error("sn_coap_protocol_linked_list_send_msg_store - resend buffer size reached!");
             return 0;
         }
@@ -969,11 +994,115 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
     stored_msg_ptr->param = param;
 
     /* Storing Resending message to Linked list */
-    ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
-    ++handle->count_resent_msgs;
+    sn_coap_protocol_linked_list_send_msg_add(handle, stored_msg_ptr);
     return 1;
 }
 
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Adds resending message to the queue and to the Message ID and token hashes
+ *
+ * \param *stored_msg_ptr is pointer to added resending message
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    const uint8_t *packet_ptr = stored_msg_ptr->send_msg_ptr->packet_ptr;
+    uint8_t token_len = packet_ptr ? (packet_ptr[0] & 0x0F) : 0;
+    uint8_t token_hash = 0;
+
+    if (stored_msg_ptr->send_msg_ptr->packet_len >= 4 + token_len) {
+        token_hash = sn_coap_protocol_token_hash(packet_ptr + 4, token_len);
+    }
+
+    sn_coap_protocol_linked_list_send_msg_queue(handle, stored_msg_ptr);
+    ns_list_add_to_end(&handle->resent_msgs_by_msg_id[sn_coap_protocol_send_msg_id(stored_msg_ptr) & (SN_COAP_RESENDING_HASH_SIZE - 1)], stored_msg_ptr);
+    ns_list_add_to_end(&handle->resent_msgs_by_token[token_hash], stored_msg_ptr);
+    ++handle->count_resent_msgs;
+    handle->size_resent_msgs += stored_msg_ptr->send_msg_ptr->packet_len;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_queue(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Inserts resending message to the queue, which is ordered by resending time
+ *
+ * \param *stored_msg_ptr is pointer to inserted resending message
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_queue(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    /* New and resent messages are usually due last, search the place from the end */
+    ns_list_foreach_reverse(coap_send_msg_s, queued_msg_ptr, &handle->linked_list_resent_msgs) {
+        if (queued_msg_ptr->resending_time <= stored_msg_ptr->resending_time) {
+            ns_list_add_after(&handle->linked_list_resent_msgs, queued_msg_ptr, stored_msg_ptr);
+            return;
+        }
+    }
+
+    ns_list_add_to_start(&handle->linked_list_resent_msgs, stored_msg_ptr);
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Removes resending message from the queue and from the hashes, without freeing it
+ *
+ * \param *stored_msg_ptr is pointer to removed resending message
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    const uint8_t *packet_ptr = stored_msg_ptr->send_msg_ptr->packet_ptr;
+    uint8_t token_len = packet_ptr ? (packet_ptr[0] & 0x0F) : 0;
+    uint8_t token_hash = 0;
+
+    if (stored_msg_ptr->send_msg_ptr->packet_len >= 4 + token_len) {
+        token_hash = sn_coap_protocol_token_hash(packet_ptr + 4, token_len);
+    }
+
+    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    ns_list_remove(&handle->resent_msgs_by_msg_id[sn_coap_protocol_send_msg_id(stored_msg_ptr) & (SN_COAP_RESENDING_HASH_SIZE - 1)], stored_msg_ptr);
+    ns_list_remove(&handle->resent_msgs_by_token[token_hash], stored_msg_ptr);
+    --handle->count_resent_msgs;
+    handle->size_resent_msgs -= stored_msg_ptr->send_msg_ptr->packet_len;
+}
+
+/**************************************************************************//**
+ * \fn static uint16_t sn_coap_protocol_send_msg_id(const coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Gets Message ID of stored resending message
+ *****************************************************************************/
+
+static uint16_t sn_coap_protocol_send_msg_id(const coap_send_msg_s *stored_msg_ptr)
+{
+    const sn_nsdl_transmit_s *send_msg_ptr = stored_msg_ptr->send_msg_ptr;
+
+    if (send_msg_ptr->packet_ptr == NULL || send_msg_ptr->packet_len < 4) {
+        return 0;
+    }
+
+    return (send_msg_ptr->packet_ptr[2] << 8) | send_msg_ptr->packet_ptr[3];
+}
+
+/**************************************************************************//**
+ * \fn static uint8_t sn_coap_protocol_token_hash(const uint8_t *token_ptr, uint8_t token_len)
+ *
+ * \brief Calculates token hash bucket of resending messages
+ *****************************************************************************/
+
+static uint8_t sn_coap_protocol_token_hash(const uint8_t *token_ptr, uint8_t token_len)
+{
+    uint8_t hash = 0;
+
+    for (uint8_t i = 0; i < token_len; i++) {
+        hash = (hash << 1 | hash >> 7) ^ token_ptr[i];
+    }
+
+    return hash & (SN_COAP_RESENDING_HASH_SIZE - 1);
+}
+
 /**************************************************************************//**
  * \fn static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
  *
@@ -990,11 +1119,10 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
 static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle,
         sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
+    /* Loop stored resending messages with the same Message ID hash */
+    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->resent_msgs_by_msg_id[msg_id & (SN_COAP_RESENDING_HASH_SIZE - 1)]) {
         /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-        temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
+        uint16_t temp_msg_id = sn_coap_protocol_send_msg_id(stored_msg_ptr);
 
         /* If message's Message ID is same than is searched */
         if (temp_msg_id == msg_id) {
@@ -1023,11 +1151,10 @@ static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(struct c
 
 static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages in Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
+    /* Loop stored resending messages with the same Message ID hash */
+    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->resent_msgs_by_msg_id[msg_id & (SN_COAP_RESENDING_HASH_SIZE - 1)]) {
         /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-        temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
+        uint16_t temp_msg_id = sn_coap_protocol_send_msg_id(stored_msg_ptr);
 
         /* If message's Message ID is same than is searched */
         if (temp_msg_id == msg_id) {
@@ -1038,8 +1165,7 @@ static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle,
                     /* * * Message found * * */
 
                     /* Remove message from Linked list */
-                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                    --handle->count_resent_msgs;
+                    sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
 
                     /* Free memory of stored message */
                     sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
@@ -1146,6 +1272,7 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
     /* * * * Storing Duplication info to Linked list * * * */
 
     ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
+    ns_list_add_to_end(&handle->duplication_msgs_by_msg_id[SN_COAP_DUPLICATION_HASH(addr_ptr->port, msg_id)], stored_duplication_info_ptr);
     ++handle->count_duplication_msgs;
 }
 
@@ -1163,8 +1290,8 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
 static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle,
         const sn_nsdl_addr_s *addr_ptr, const uint16_t msg_id)
 {
-    /* Loop all nodes in Linked list for searching Message ID */
-    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+    /* Loop nodes with the same Address and Message ID hash */
+    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->duplication_msgs_by_msg_id[SN_COAP_DUPLICATION_HASH(addr_ptr->port, msg_id)]) {
         /* If message's Message ID is same than is searched */
         if (stored_duplication_info_ptr->msg_id == msg_id) {
             /* If message's Source address is same than is searched */
@@ -1190,33 +1317,51 @@ static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_se
 
 static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle)
 {
-    /* Loop all stored duplication messages in Linked list */
+    /* Loop stored duplication messages in Linked list, oldest first */
     ns_list_foreach_safe(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        if ((handle->system_time - removed_duplication_info_ptr->timestamp)  > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
-            /* * * * Old Duplication info found, remove it from Linked list * * * */
-            ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-            --handle->count_duplication_msgs;
-
-            /* Free memory of stored Duplication info */
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
-            removed_duplication_info_ptr->address->addr_ptr = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
-            removed_duplication_info_ptr->address = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
-            removed_duplication_info_ptr->packet_ptr = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr);
-            removed_duplication_info_ptr = 0;
+        if ((handle->system_time - removed_duplication_info_ptr->timestamp) <= SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
+            /* The rest are newer */
+            break;
         }
+
+        /* * * * Old Duplication info found, remove it from Linked list * * * */
+        sn_coap_protocol_linked_list_duplication_info_release(handle, removed_duplication_info_ptr);
     }
 }
 
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_duplication_info_release(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr)
+ *
+ * \brief Removes Duplication info from Linked list and hash, and frees it
+ *
+ * \param *removed_duplication_info_ptr is pointer to removed Duplication info
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_duplication_info_release(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr)
+{
+    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
+    ns_list_remove(&handle->duplication_msgs_by_msg_id[SN_COAP_DUPLICATION_HASH(removed_duplication_info_ptr->address->port,
+                                                                                removed_duplication_info_ptr->msg_id)],
+                   removed_duplication_info_ptr);
+    --handle->count_duplication_msgs;
+
+    /* Free memory of stored Duplication info */
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
+    removed_duplication_info_ptr->address->addr_ptr = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
+    removed_duplication_info_ptr->address = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
+    removed_duplication_info_ptr->packet_ptr = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr);
+}
+
 #endif /* SN_COAP_DUPLICATION_MAX_MSGS_COUNT */
 
 void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, const uint8_t *scr_addr_ptr, const uint16_t port, const uint16_t msg_id)
 {
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
-    /* Loop all stored duplication messages in Linked list */
-    ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+    /* Loop stored duplication messages with the same Address and Message ID hash */
+    ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->duplication_msgs_by_msg_id[SN_COAP_DUPLICATION_HASH(port, msg_id)]) {
         /* If message's Address is same than is searched */
         if (handle == removed_duplication_info_ptr->coap && 0 == memcmp(scr_addr_ptr,
                                                                         removed_duplication_info_ptr->address->addr_ptr,
@@ -1227,18 +1372,7 @@ void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle,
                 if (removed_duplication_info_ptr->msg_id == msg_id) {
                     /* * * * Correct Duplication info found, remove it from Linked list * * * */
                     tr_info("sn_coap_protocol_linked_list_duplication_info_remove - message id %d removed", msg_id);
-                    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-                    --handle->count_duplication_msgs;
-
-                    /* Free memory of stored Duplication info */
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
-                    removed_duplication_info_ptr->address->addr_ptr = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
-                    removed_duplication_info_ptr->address = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
-                    removed_duplication_info_ptr->packet_ptr = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr);
-                    removed_duplication_info_ptr = 0;
+                    sn_coap_protocol_linked_list_duplication_info_release(handle, removed_duplication_info_ptr);
                     return;
                 }
             }
@@ -1301,6 +1435,9 @@ static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *
         return;
     }
 
+    /* Payloads of a message are kept in block number order, as blocks can be received out of order */
+    coap_blockwise_payload_s *next_payload_ptr = NULL;
+
     // Do not add duplicates to list, this could happen if server needs to retransmit block message again
     ns_list_foreach(coap_blockwise_payload_s, payload_info_ptr, &handle->linked_list_blockwise_received_payloads) {
         if ((0 == memcmp(addr_ptr->addr_ptr, payload_info_ptr->addr_ptr, addr_ptr->addr_len)) && (payload_info_ptr->port == addr_ptr->port)) {
@@ -1314,6 +1451,9 @@ static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *
             if (payload_info_ptr->block_number == block_number) {
                 return;
             }
+            if (payload_info_ptr->block_number > block_number && !next_payload_ptr) {
+                next_payload_ptr = payload_info_ptr;
+            }
         }
     }
 
@@ -1386,7 +1526,11 @@ static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *
     stored_blockwise_payload_ptr->block_number = block_number;
 
     /* * * * Storing Payload to Linked list  * * * */
-    ns_list_add_to_end(&handle->linked_list_blockwise_received_payloads, stored_blockwise_payload_ptr);
+    if (next_payload_ptr) {
+        ns_list_add_before(&handle->linked_list_blockwise_received_payloads, next_payload_ptr, stored_blockwise_payload_ptr);
+    } else {
+        ns_list_add_to_end(&handle->linked_list_blockwise_received_payloads, stored_blockwise_payload_ptr);
+    }
 }
 
 /**************************************************************************//**
@@ -1672,26 +1816,6 @@ static void sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handl
     }
 }
 
-/**************************************************************************//**
- * \fn static uint16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr)
- *
- * \brief Counts total message size of all messages in linked list
- *
- * \param const coap_send_msg_list_t *linked_list_ptr pointer to linked list
- *****************************************************************************/
-static uint16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr)
-{
-    uint16_t total_size = 0;
-
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, linked_list_ptr) {
-        if (stored_msg_ptr->send_msg_ptr) {
-            total_size += stored_msg_ptr->send_msg_ptr->packet_len;
-        }
-    }
-
-    return total_size;
-}
-
 #endif
 
 #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
@@ -2068,11 +2192,11 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
     else {
         //This is response to request we made
         if (received_coap_msg_ptr->msg_code > COAP_MSG_CODE_REQUEST_DELETE) {
-            if (handle->sn_coap_internal_block2_resp_handling) {
-                uint32_t block_number = 0;
-
+            if (handle->sn_coap_internal_block2_resp_handling &&
+                (handle->sn_coap_block2_window > 1 || handle->sn_coap_block2_stream_callback)) {
+                return sn_coap_handle_block2_response(handle, src_addr_ptr, received_coap_msg_ptr, param);
+            } else if (handle->sn_coap_internal_block2_resp_handling) {
                 /* Store blockwise payload to Linked list */
-                //todo: add block number to stored values - just to make sure all packets are in order
                 sn_coap_protocol_linked_list_blockwise_payload_store(handle,
                                                                      src_addr_ptr,
                                                                      received_coap_msg_ptr->payload_len,
@@ -2099,164 +2223,33 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                         return 0;
                     }
 
-                    src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
-                    if (src_coap_blockwise_ack_msg_ptr == NULL) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate message!");
-                        return 0;
-                    }
-
-                    /* * * Then build CoAP Acknowledgement message * * */
-
-                    if (sn_coap_parser_alloc_options(handle, src_coap_blockwise_ack_msg_ptr) == NULL) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate options!");
-                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                        src_coap_blockwise_ack_msg_ptr = 0;
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                        return NULL;
-                    }
-
-                    src_coap_blockwise_ack_msg_ptr->msg_id = message_id++;
-                    if (message_id == 0) {
-                        message_id = 1;
-                    }
-
-                    /* Update block option */
+                    /* Request the next block */
                     block_temp = received_coap_msg_ptr->options_list_ptr->block2 & 0x07;
-
-                    block_number = received_coap_msg_ptr->options_list_ptr->block2 >> 4;
-                    block_number ++;
-
-                    src_coap_blockwise_ack_msg_ptr->options_list_ptr->block2 = (block_number << 4) | block_temp;
-
-
-                    /* Set BLOCK2 (subsequent) GET msg code and copy uri path from previous msg*/
-                    src_coap_blockwise_ack_msg_ptr->msg_code = previous_blockwise_msg_ptr->coap_msg_ptr->msg_code;
-                    if (previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_ptr) {
-                        src_coap_blockwise_ack_msg_ptr->uri_path_len = previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_len;
-                        src_coap_blockwise_ack_msg_ptr->uri_path_ptr = handle->sn_coap_protocol_malloc(previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_len);
-                        if (!src_coap_blockwise_ack_msg_ptr->uri_path_ptr) {
-                            sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
-                            tr_error("sn_coap_handle_blockwise_message - failed to allocate for uri path ptr!");
-                            return NULL;
-                        }
-                        memcpy(src_coap_blockwise_ack_msg_ptr->uri_path_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_len);
-                    }
-                    if (previous_blockwise_msg_ptr->coap_msg_ptr->token_ptr) {
-                        src_coap_blockwise_ack_msg_ptr->token_len = previous_blockwise_msg_ptr->coap_msg_ptr->token_len;
-                        src_coap_blockwise_ack_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(previous_blockwise_msg_ptr->coap_msg_ptr->token_len);
-                        if (!src_coap_blockwise_ack_msg_ptr->token_ptr) {
-                            sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
-                            tr_error("sn_coap_handle_blockwise_message - failed to allocate for token ptr!");
-                            return NULL;
-                        }
-                        memcpy(src_coap_blockwise_ack_msg_ptr->token_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->token_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->token_len);
-                    }
-
-                    ns_list_remove(&handle->linked_list_blockwise_sent_msgs, previous_blockwise_msg_ptr);
-                    if (previous_blockwise_msg_ptr->coap_msg_ptr) {
-                        if (previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr) {
-                            handle->sn_coap_protocol_free(previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr);
-                            previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr = 0;
-                        }
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, previous_blockwise_msg_ptr->coap_msg_ptr);
-                        previous_blockwise_msg_ptr->coap_msg_ptr = 0;
-                    }
-                    handle->sn_coap_protocol_free(previous_blockwise_msg_ptr);
-                    previous_blockwise_msg_ptr = 0;
-
-                    /* Then get needed memory count for Packet data */
-                    dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr ,handle->sn_coap_block_data_size);
-
-                    /* Then allocate memory for Packet data */
-                    dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
-
-                    if (dst_ack_packet_data_ptr == NULL) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate packet!");
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+                    if (!sn_coap_protocol_send_block2_request(handle, src_addr_ptr, previous_blockwise_msg_ptr->coap_msg_ptr,
+                                                              (received_coap_msg_ptr->options_list_ptr->block2 >> 4) + 1, block_temp, param)) {
                         sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
                         return NULL;
                     }
-                    memset(dst_ack_packet_data_ptr, 0, dst_packed_data_needed_mem);
-
-                    /* * * Then build Acknowledgement message to Packed data * * */
-                    if ((sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size)) < 0) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) builder failed!");
-                        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
-                        dst_ack_packet_data_ptr = 0;
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                        return NULL;
-                    }
-
-                    /* * * Save to linked list * * */
-                    coap_blockwise_msg_s *stored_blockwise_msg_ptr;
-
-                    stored_blockwise_msg_ptr = handle->sn_coap_protocol_malloc(sizeof(coap_blockwise_msg_s));
-                    if (!stored_blockwise_msg_ptr) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate blockwise message!");
-                        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
-                        dst_ack_packet_data_ptr = 0;
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                        return 0;
-                    }
-                    memset(stored_blockwise_msg_ptr, 0, sizeof(coap_blockwise_msg_s));
-
-                    stored_blockwise_msg_ptr->timestamp = handle->system_time;
-
-                    stored_blockwise_msg_ptr->coap_msg_ptr = src_coap_blockwise_ack_msg_ptr;
-                    stored_blockwise_msg_ptr->coap = handle;
-                    stored_blockwise_msg_ptr->param = param;
-                    stored_blockwise_msg_ptr->msg_id = stored_blockwise_msg_ptr->coap_msg_ptr->msg_id;
-                    ns_list_add_to_end(&handle->linked_list_blockwise_sent_msgs, stored_blockwise_msg_ptr);
 
-                    /* * * Then release memory of CoAP Acknowledgement message * * */
-                    handle->sn_coap_tx_callback(dst_ack_packet_data_ptr,
-                                                dst_packed_data_needed_mem, src_addr_ptr, param);
-
-#if ENABLE_RESENDINGS
-                    uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
-                    sn_coap_protocol_linked_list_send_msg_store(handle, src_addr_ptr,
-                            dst_packed_data_needed_mem,
-                            dst_ack_packet_data_ptr,
-                            resend_time, param);
-#endif
-                    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
-                    dst_ack_packet_data_ptr = 0;
+                    sn_coap_protocol_linked_list_blockwise_msg_remove(handle, previous_blockwise_msg_ptr);
                 }
 
                 //Last block received
                 else {
                     /* * * This is the last block when whole Blockwise payload from received * * */
                     /* * * blockwise messages is gathered and returned to User               * * */
-
-                    /* Store last Blockwise payload to Linked list */
-                    uint16_t payload_len            = 0;
-                    uint8_t *payload_ptr            = sn_coap_protocol_linked_list_blockwise_payload_search(handle, src_addr_ptr, &payload_len, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
-                    uint16_t whole_payload_len      = sn_coap_protocol_linked_list_blockwise_payloads_get_len(handle, src_addr_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
-                    uint8_t *temp_whole_payload_ptr = NULL;
-
-                    temp_whole_payload_ptr = handle->sn_coap_protocol_malloc(whole_payload_len);
-                    if (!temp_whole_payload_ptr) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate whole payload!");
+                    if (sn_coap_protocol_linked_list_blockwise_payload_gather(handle, src_addr_ptr, received_coap_msg_ptr) < 0) {
                         return 0;
                     }
-
-                    received_coap_msg_ptr->payload_ptr = temp_whole_payload_ptr;
-                    received_coap_msg_ptr->payload_len = whole_payload_len;
-
-                    /* Copy stored Blockwise payloads to returned whole Blockwise payload pointer */
-                    while (payload_ptr != NULL) {
-                        memcpy(temp_whole_payload_ptr, payload_ptr, payload_len);
-
-                        temp_whole_payload_ptr += payload_len;
-
-                        sn_coap_protocol_linked_list_blockwise_payload_remove_oldest(handle, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
-                        payload_ptr = sn_coap_protocol_linked_list_blockwise_payload_search(handle, src_addr_ptr, &payload_len, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
-                    }
                     received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED;
 
-                    //todo: remove previous msg from list
+                    /* The request of the last block is answered, it would otherwise time out and be reported as failed */
+                    ns_list_foreach(coap_blockwise_msg_s, msg, &handle->linked_list_blockwise_sent_msgs) {
+                        if (msg->coap_msg_ptr && received_coap_msg_ptr->msg_id == msg->coap_msg_ptr->msg_id) {
+                            sn_coap_protocol_linked_list_blockwise_msg_remove(handle, msg);
+                            break;
+                        }
+                    }
                 }
             }
         }
@@ -2368,6 +2361,326 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
     return received_coap_msg_ptr;
 }
 
+/**************************************************************************//**
+ * \fn static coap_blockwise_msg_s *sn_coap_protocol_send_block2_request(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, const sn_coap_hdr_s *previous_coap_msg_ptr, uint32_t block_number, uint8_t block_temp, void *param)
+ *
+ * \brief Requests a block of a Block2 transfer and stores the request to Linked list
+ *
+ * \param *dst_addr_ptr pointer to destination address information struct
+ * \param *previous_coap_msg_ptr previous request of the transfer, Uri-Path, token and code are copied from it
+ * \param block_number number of the block requested
+ * \param block_temp SZX of the block requested
+ *
+ * \return Stored request, or NULL if failed
+ *****************************************************************************/
+static coap_blockwise_msg_s *sn_coap_protocol_send_block2_request(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, const sn_coap_hdr_s *previous_coap_msg_ptr, uint32_t block_number, uint8_t block_temp, void *param)
+{
+    sn_coap_hdr_s *src_coap_blockwise_ack_msg_ptr = NULL;
+    uint16_t dst_packed_data_needed_mem = 0;
+    uint8_t *dst_ack_packet_data_ptr = NULL;
+    coap_blockwise_msg_s *stored_blockwise_msg_ptr = NULL;
+
+    src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
+    if (src_coap_blockwise_ack_msg_ptr == NULL) {
+        tr_error("sn_coap_protocol_send_block2_request - failed to allocate message!");
+        return NULL;
+    }
+
+    if (sn_coap_parser_alloc_options(handle, src_coap_blockwise_ack_msg_ptr) == NULL) {
+        tr_error("sn_coap_protocol_send_block2_request - failed to allocate options!");
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+        return NULL;
+    }
+
+    src_coap_blockwise_ack_msg_ptr->msg_id = message_id++;
+    if (message_id == 0) {
+        message_id = 1;
+    }
+
+    /* Update block option */
+    src_coap_blockwise_ack_msg_ptr->options_list_ptr->block2 = (block_number << 4) | block_temp;
+
+    /* Set BLOCK2 (subsequent) GET msg code and copy uri path from previous msg*/
+    src_coap_blockwise_ack_msg_ptr->msg_code = previous_coap_msg_ptr->msg_code;
+    if (previous_coap_msg_ptr->uri_path_ptr) {
+        src_coap_blockwise_ack_msg_ptr->uri_path_len = previous_coap_msg_ptr->uri_path_len;
+        src_coap_blockwise_ack_msg_ptr->uri_path_ptr = handle->sn_coap_protocol_malloc(previous_coap_msg_ptr->uri_path_len);
+        if (!src_coap_blockwise_ack_msg_ptr->uri_path_ptr) {
+            sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+            tr_error("sn_coap_protocol_send_block2_request - failed to allocate for uri path ptr!");
+            return NULL;
+        }
+        memcpy(src_coap_blockwise_ack_msg_ptr->uri_path_ptr, previous_coap_msg_ptr->uri_path_ptr, previous_coap_msg_ptr->uri_path_len);
+    }
+    if (previous_coap_msg_ptr->token_ptr) {
+        src_coap_blockwise_ack_msg_ptr->token_len = previous_coap_msg_ptr->token_len;
+        src_coap_blockwise_ack_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(previous_coap_msg_ptr->token_len);
+        if (!src_coap_blockwise_ack_msg_ptr->token_ptr) {
+            sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+            tr_error("sn_coap_protocol_send_block2_request - failed to allocate for token ptr!");
+            return NULL;
+        }
+        memcpy(src_coap_blockwise_ack_msg_ptr->token_ptr, previous_coap_msg_ptr->token_ptr, previous_coap_msg_ptr->token_len);
+    }
+
+    /* Then get needed memory count for Packet data */
+    dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr ,handle->sn_coap_block_data_size);
+
+    /* Then allocate memory for Packet data */
+    dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
+
+    if (dst_ack_packet_data_ptr == NULL) {
+        tr_error("sn_coap_protocol_send_block2_request - failed to allocate packet!");
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+        return NULL;
+    }
+    memset(dst_ack_packet_data_ptr, 0, dst_packed_data_needed_mem);
+
+    /* * * Then build the request to Packed data * * */
+    if ((sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size)) < 0) {
+        tr_error("sn_coap_protocol_send_block2_request - builder failed!");
+        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+        return NULL;
+    }
+
+    /* * * Save to linked list * * */
+    stored_blockwise_msg_ptr = handle->sn_coap_protocol_malloc(sizeof(coap_blockwise_msg_s));
+    if (!stored_blockwise_msg_ptr) {
+        tr_error("sn_coap_protocol_send_block2_request - failed to allocate blockwise message!");
+        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+        return NULL;
+    }
+    memset(stored_blockwise_msg_ptr, 0, sizeof(coap_blockwise_msg_s));
+
+    stored_blockwise_msg_ptr->timestamp = handle->system_time;
+
+    stored_blockwise_msg_ptr->coap_msg_ptr = src_coap_blockwise_ack_msg_ptr;
+    stored_blockwise_msg_ptr->coap = handle;
+    stored_blockwise_msg_ptr->param = param;
+    stored_blockwise_msg_ptr->msg_id = stored_blockwise_msg_ptr->coap_msg_ptr->msg_id;
+    ns_list_add_to_end(&handle->linked_list_blockwise_sent_msgs, stored_blockwise_msg_ptr);
+
+    handle->sn_coap_tx_callback(dst_ack_packet_data_ptr,
+                                dst_packed_data_needed_mem, dst_addr_ptr, param);
+
+#if ENABLE_RESENDINGS
+    uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
+    sn_coap_protocol_linked_list_send_msg_store(handle, dst_addr_ptr,
+            dst_packed_data_needed_mem,
+            dst_ack_packet_data_ptr,
+            resend_time, param);
+#endif
+    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+
+    return stored_blockwise_msg_ptr;
+}
+
+/**************************************************************************//**
+ * \fn static int8_t sn_coap_protocol_linked_list_blockwise_payload_gather(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr)
+ *
+ * \brief Moves the stored payloads of a Block2 transfer to the payload of its last message
+ *
+ * \param *src_addr_ptr pointer to source address information struct
+ * \param *received_coap_msg_ptr last message of the transfer
+ *
+ * \return 0 = success, -1 = failed to allocate the whole payload
+ *****************************************************************************/
+static int8_t sn_coap_protocol_linked_list_blockwise_payload_gather(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr)
+{
+    uint16_t payload_len            = 0;
+    uint8_t *payload_ptr            = sn_coap_protocol_linked_list_blockwise_payload_search(handle, src_addr_ptr, &payload_len, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+    uint16_t whole_payload_len      = sn_coap_protocol_linked_list_blockwise_payloads_get_len(handle, src_addr_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+    uint8_t *temp_whole_payload_ptr = NULL;
+
+    temp_whole_payload_ptr = handle->sn_coap_protocol_malloc(whole_payload_len);
+    if (!temp_whole_payload_ptr) {
+        tr_error("sn_coap_protocol_linked_list_blockwise_payload_gather - failed to allocate whole payload!");
+        return -1;
+    }
+
+    received_coap_msg_ptr->payload_ptr = temp_whole_payload_ptr;
+    received_coap_msg_ptr->payload_len = whole_payload_len;
+
+    /* Copy stored Blockwise payloads to returned whole Blockwise payload pointer */
+    while (payload_ptr != NULL) {
+        memcpy(temp_whole_payload_ptr, payload_ptr, payload_len);
+
+        temp_whole_payload_ptr += payload_len;
+
+        sn_coap_protocol_linked_list_blockwise_payload_remove_oldest(handle, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+        payload_ptr = sn_coap_protocol_linked_list_blockwise_payload_search(handle, src_addr_ptr, &payload_len, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+    }
+
+    return 0;
+}
+
+/**************************************************************************//**
+ * \fn static sn_coap_hdr_s *sn_coap_handle_block2_response(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param)
+ *
+ * \brief Handles a Block2 response with several requests outstanding or with the stream callback
+ *
+ * Once the size of the transfer is known from the Size2 option, the following blocks are
+ * requested up to sn_coap_block2_window requests outstanding. Without Size2 or token, blocks
+ * are requested one at a time. Blocks are given in order to the stream callback, the ones
+ * received ahead being stored until the missing ones arrive. Without stream callback, blocks
+ * are stored and gathered to the payload of the message completing the transfer.
+ *
+ * \param *src_addr_ptr pointer to source address information struct
+ * \param *received_coap_msg_ptr pointer to parsed CoAP message structure
+ *****************************************************************************/
+static sn_coap_hdr_s *sn_coap_handle_block2_response(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param)
+{
+    sn_coap_options_list_s *options_list_ptr = received_coap_msg_ptr->options_list_ptr;
+    uint32_t block_number = options_list_ptr->block2 >> 4;
+    uint8_t block_temp = options_list_ptr->block2 & 0x07;
+    uint16_t block_size = 1u << (block_temp + 4);
+    coap_blockwise_msg_s *previous_blockwise_msg_ptr = NULL;
+    uint32_t block_count;
+    uint32_t next_block;
+    bool complete;
+
+    ns_list_foreach(coap_blockwise_msg_s, msg, &handle->linked_list_blockwise_sent_msgs) {
+        if (msg->coap_msg_ptr && received_coap_msg_ptr->msg_id == msg->coap_msg_ptr->msg_id) {
+            previous_blockwise_msg_ptr = msg;
+            break;
+        }
+    }
+
+    if (!previous_blockwise_msg_ptr) {
+        tr_error("sn_coap_handle_block2_response - previous message null!");
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
+        return NULL;
+    }
+
+    block_count = previous_blockwise_msg_ptr->block2_count;
+    next_block = previous_blockwise_msg_ptr->block2_next;
+    if (!(options_list_ptr->block2 & 0x08)) {
+        block_count = block_number + 1;
+    } else if (options_list_ptr->use_size2 && options_list_ptr->size2) {
+        block_count = (options_list_ptr->size2 + block_size - 1) / block_size;
+    }
+
+    if (handle->sn_coap_block2_stream_callback) {
+        if (block_number == next_block) {
+            handle->sn_coap_block2_stream_callback(received_coap_msg_ptr, block_number * block_size,
+                                                   received_coap_msg_ptr->payload_ptr, received_coap_msg_ptr->payload_len,
+                                                   previous_blockwise_msg_ptr->param);
+            next_block++;
+
+            /* Then the blocks received ahead, stored in block number order, first one being the lowest */
+            uint16_t payload_len = 0;
+            uint8_t *payload_ptr;
+            while ((payload_ptr = sn_coap_protocol_linked_list_blockwise_payload_search(handle, src_addr_ptr, &payload_len, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len)) != NULL &&
+                   sn_coap_protocol_linked_list_blockwise_payload_compare_block_number(handle, src_addr_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len, next_block + 1)) {
+                handle->sn_coap_block2_stream_callback(received_coap_msg_ptr, next_block * block_size,
+                                                       payload_ptr, payload_len,
+                                                       previous_blockwise_msg_ptr->param);
+                sn_coap_protocol_linked_list_blockwise_payload_remove_oldest(handle, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+                next_block++;
+            }
+        } else if (block_number > next_block) {
+            sn_coap_protocol_linked_list_blockwise_payload_store(handle, src_addr_ptr,
+                                                                 received_coap_msg_ptr->payload_len,
+                                                                 received_coap_msg_ptr->payload_ptr,
+                                                                 received_coap_msg_ptr->token_ptr,
+                                                                 received_coap_msg_ptr->token_len,
+                                                                 block_number);
+        }
+        complete = block_count && next_block >= block_count;
+    } else {
+        uint32_t stored_count = 0;
+
+        sn_coap_protocol_linked_list_blockwise_payload_store(handle, src_addr_ptr,
+                                                             received_coap_msg_ptr->payload_len,
+                                                             received_coap_msg_ptr->payload_ptr,
+                                                             received_coap_msg_ptr->token_ptr,
+                                                             received_coap_msg_ptr->token_len,
+                                                             block_number);
+        ns_list_foreach(coap_blockwise_payload_s, payload_info_ptr, &handle->linked_list_blockwise_received_payloads) {
+            if (payload_info_ptr->port == src_addr_ptr->port &&
+                0 == memcmp(src_addr_ptr->addr_ptr, payload_info_ptr->addr_ptr, src_addr_ptr->addr_len) &&
+                payload_info_ptr->token_len == received_coap_msg_ptr->token_len &&
+                (!payload_info_ptr->token_len || 0 == memcmp(payload_info_ptr->token_ptr, received_coap_msg_ptr->token_ptr, payload_info_ptr->token_len))) {
+                stored_count++;
+            }
+        }
+        /* An empty single block is not stored */
+        complete = block_count == 1 || (block_count && stored_count >= block_count);
+    }
+
+    if (complete) {
+        if (handle->sn_coap_block2_stream_callback) {
+            received_coap_msg_ptr->payload_ptr = NULL;
+            received_coap_msg_ptr->payload_len = 0;
+        } else if (sn_coap_protocol_linked_list_blockwise_payload_gather(handle, src_addr_ptr, received_coap_msg_ptr) < 0) {
+            return 0;
+        }
+        received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED;
+        sn_coap_protocol_linked_list_blockwise_msg_remove(handle, previous_blockwise_msg_ptr);
+        return received_coap_msg_ptr;
+    }
+
+    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
+
+    /* Requests of the transfer still outstanding share its token */
+    uint8_t window = 1;
+    uint8_t outstanding = 0;
+    uint32_t last_requested = block_number;
+
+    if (block_count && received_coap_msg_ptr->token_ptr) {
+        window = handle->sn_coap_block2_window;
+        ns_list_foreach(coap_blockwise_msg_s, msg, &handle->linked_list_blockwise_sent_msgs) {
+            if (msg == previous_blockwise_msg_ptr || !msg->coap_msg_ptr || !msg->coap_msg_ptr->options_list_ptr ||
+                msg->coap_msg_ptr->token_len != received_coap_msg_ptr->token_len ||
+                memcmp(msg->coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len)) {
+                continue;
+            }
+            if (msg->coap_msg_ptr->options_list_ptr->block2 != COAP_OPTION_BLOCK_NONE &&
+                (uint32_t)(msg->coap_msg_ptr->options_list_ptr->block2 >> 4) > last_requested) {
+                last_requested = msg->coap_msg_ptr->options_list_ptr->block2 >> 4;
+            }
+            msg->block2_count = block_count;
+            msg->block2_next = next_block;
+            outstanding++;
+        }
+        /* Blocks stored ahead have been requested too */
+        ns_list_foreach(coap_blockwise_payload_s, payload_info_ptr, &handle->linked_list_blockwise_received_payloads) {
+            if (payload_info_ptr->block_number > last_requested &&
+                payload_info_ptr->port == src_addr_ptr->port &&
+                0 == memcmp(src_addr_ptr->addr_ptr, payload_info_ptr->addr_ptr, src_addr_ptr->addr_len) &&
+                payload_info_ptr->token_len == received_coap_msg_ptr->token_len &&
+                0 == memcmp(payload_info_ptr->token_ptr, received_coap_msg_ptr->token_ptr, payload_info_ptr->token_len)) {
+                last_requested = payload_info_ptr->block_number;
+            }
+        }
+    }
+
+    while (outstanding < window && (!block_count || last_requested + 1 < block_count)) {
+        coap_blockwise_msg_s *stored_blockwise_msg_ptr;
+
+        last_requested++;
+        stored_blockwise_msg_ptr = sn_coap_protocol_send_block2_request(handle, src_addr_ptr, previous_blockwise_msg_ptr->coap_msg_ptr,
+                                                                        last_requested, block_temp, param);
+        if (!stored_blockwise_msg_ptr) {
+            break;
+        }
+        stored_blockwise_msg_ptr->block2_count = block_count;
+        stored_blockwise_msg_ptr->block2_next = next_block;
+        outstanding++;
+    }
+
+    if (!outstanding) {
+        sn_coap_protocol_linked_list_blockwise_msg_remove(handle, previous_blockwise_msg_ptr);
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
+        return NULL;
+    }
+
+    sn_coap_protocol_linked_list_blockwise_msg_remove(handle, previous_blockwise_msg_ptr);
+    return received_coap_msg_ptr;
+}
+
 int8_t sn_coap_convert_block_size(uint16_t block_size)
 {
     if (block_size == 16) {
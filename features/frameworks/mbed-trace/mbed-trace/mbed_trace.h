@@ -191,6 +191,34 @@ void mbed_trace_free(void);
  * @param tmpLength     new maximum length for trace tmp buffer (used for trace_array, etc) (0 = do no resize)
  */
 void mbed_trace_buffer_sizes(int lineLength, int tmpLength);
+/**
+ * Set deferred trace buffer size
+ *
+ * When the buffer is set, traces are not formatted when called. The level, the
+ * addresses of the format and group strings and the raw arguments are recorded
+ * to the buffer instead, which is much cheaper than formatting in the caller's
+ * context. On Mbed OS each record is also stamped with the microsecond ticker. The records are read with mbed_trace_deferred_read(), typically from a
+ * low priority thread writing them to a serial port or SWO, and formatted on the
+ * host by tools/mbed_trace_decode.py using the ELF file of the application.
+ *
+ * String arguments are copied to the record. Records which do not fit the buffer
+ * are dropped and counted. Formats with conversions not known to the recorder,
+ * and tr_cmdline(), are formatted and printed as usual.
+ * Default size can be set with compiler flag MBED_TRACE_DEFERRED_BUFFER_LENGTH.
+ *
+ * @param length    buffer length in bytes, 0 = format traces when called
+ */
+void mbed_trace_deferred_buffer_size(int length);
+/**
+ * Read deferred trace records
+ *
+ * Records are read as a byte stream and may be split between calls.
+ *
+ * @param buf       buffer for the records
+ * @param length    buffer length in bytes
+ * @return number of bytes read, 0 when there are no records
+ */
+int mbed_trace_deferred_read(uint8_t *buf, int length);
 /**
  *  Set trace configurations
  *  Possible parameters:
@@ -386,6 +414,8 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #undef mbed_trace_init
 #undef mbed_trace_free
 #undef mbed_trace_buffer_sizes
+#undef mbed_trace_deferred_buffer_size
+#undef mbed_trace_deferred_read
 #undef mbed_trace_config_set
 #undef mbed_trace_config_get
 #undef mbed_trace_prefix_function_set
@@ -411,6 +441,8 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #define mbed_trace_init(...)                        ((int) 0)
 #define mbed_trace_free(...)                        ((void) 0)
 #define mbed_trace_buffer_sizes(...)                ((void) 0)
+#define mbed_trace_deferred_buffer_size(...)        ((void) 0)
+#define mbed_trace_deferred_read(...)               ((int) 0)
 #define mbed_trace_config_set(...)                  ((void) 0)
 #define mbed_trace_config_get(...)                  ((uint8_t) 0)
 #define mbed_trace_prefix_function_set(...)         ((void) 0)
@@ -92,10 +92,29 @@
 #define DEFAULT_TRACE_CONFIG              TRACE_MODE_COLOR | TRACE_ACTIVE_LEVEL_ALL | TRACE_CARRIAGE_RETURN
 #endif
 
+/** default deferred trace buffer size in bytes, 0 = traces are formatted when called */
+#ifdef MBED_TRACE_DEFERRED_BUFFER_LENGTH
+#define DEFAULT_TRACE_DEFERRED_LENGTH     MBED_TRACE_DEFERRED_BUFFER_LENGTH
+#else
+#define DEFAULT_TRACE_DEFERRED_LENGTH     0
+#endif
+
+/** maximum length of a deferred trace record, its length is stored in one byte */
+#define TRACE_DEFERRED_RECORD_LENGTH      255
+
+/** deferred trace record timestamp, microseconds read without a critical section on Mbed OS */
+#if defined(__MBED__) && DEVICE_USTICKER
+#include "hal/us_ticker_api.h"
+#define TRACE_DEFERRED_TIME()             ((uint32_t) ticker_read_us_lock_free(get_us_ticker_data()))
+#else
+#define TRACE_DEFERRED_TIME()             0
+#endif
+
 /** default print function, just redirect str to printf */
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length);
 static void mbed_trace_default_print(const char *str);
 static void mbed_trace_reset_tmp(void);
+static int mbed_trace_deferred_store(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
 
 typedef struct trace_s {
     /** trace configuration bits */
@@ -131,6 +150,16 @@ typedef struct trace_s {
     void (*mutex_release_f)(void);
     /** number of times the mutex has been locked */
     int mutex_lock_count;
+    /** deferred trace records ring buffer */
+    uint8_t *deferred;
+    /** deferred trace buffer length */
+    int deferred_length;
+    /** deferred trace buffer write index */
+    int deferred_head;
+    /** deferred trace buffer read index */
+    int deferred_tail;
+    /** deferred trace records dropped since the last one stored */
+    uint32_t deferred_dropped;
 } trace_t;
 
 static trace_t m_trace = {
@@ -149,7 +178,12 @@ static trace_t m_trace = {
     .cmd_printf = 0,
     .mutex_wait_f = 0,
     .mutex_release_f = 0,
-    .mutex_lock_count = 0
+    .mutex_lock_count = 0,
+    .deferred = 0,
+    .deferred_length = DEFAULT_TRACE_DEFERRED_LENGTH,
+    .deferred_head = 0,
+    .deferred_tail = 0,
+    .deferred_dropped = 0
 };
 
 int mbed_trace_init(void)
@@ -169,11 +203,15 @@ int mbed_trace_init(void)
     if (m_trace.filters_include == NULL) {
         m_trace.filters_include = MBED_TRACE_MEM_ALLOC(m_trace.filters_length);
     }
+    if (m_trace.deferred == NULL && m_trace.deferred_length > 0) {
+        m_trace.deferred = MBED_TRACE_MEM_ALLOC(m_trace.deferred_length);
+    }
 
     if (m_trace.line == NULL ||
             m_trace.tmp_data == NULL ||
             m_trace.filters_exclude == NULL  ||
-            m_trace.filters_include == NULL) {
+            m_trace.filters_include == NULL ||
+            (m_trace.deferred == NULL && m_trace.deferred_length > 0)) {
         //memory allocation fail
         mbed_trace_free();
         return -1;
@@ -182,6 +220,9 @@ int mbed_trace_init(void)
     memset(m_trace.filters_exclude, 0, m_trace.filters_length);
     memset(m_trace.filters_include, 0, m_trace.filters_length);
     memset(m_trace.line, 0, m_trace.line_length);
+    m_trace.deferred_head = 0;
+    m_trace.deferred_tail = 0;
+    m_trace.deferred_dropped = 0;
 
     return 0;
 }
@@ -192,6 +233,7 @@ void mbed_trace_free(void)
     MBED_TRACE_MEM_FREE(m_trace.tmp_data);
     MBED_TRACE_MEM_FREE(m_trace.filters_exclude);
     MBED_TRACE_MEM_FREE(m_trace.filters_include);
+    MBED_TRACE_MEM_FREE(m_trace.deferred);
 
     // reset to default values
     m_trace.trace_config = DEFAULT_TRACE_CONFIG;
@@ -209,6 +251,11 @@ void mbed_trace_free(void)
     m_trace.mutex_wait_f = 0;
     m_trace.mutex_release_f = 0;
     m_trace.mutex_lock_count = 0;
+    m_trace.deferred = 0;
+    m_trace.deferred_length = DEFAULT_TRACE_DEFERRED_LENGTH;
+    m_trace.deferred_head = 0;
+    m_trace.deferred_tail = 0;
+    m_trace.deferred_dropped = 0;
 }
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length)
 {
@@ -226,6 +273,51 @@ void mbed_trace_buffer_sizes(int lineLength, int tmpLength)
         mbed_trace_reset_tmp();
     }
 }
+void mbed_trace_deferred_buffer_size(int length)
+{
+    if (m_trace.mutex_wait_f) {
+        m_trace.mutex_wait_f();
+    }
+    MBED_TRACE_MEM_FREE(m_trace.deferred);
+    m_trace.deferred = 0;
+    m_trace.deferred_length = 0;
+    if (length > 0) {
+        m_trace.deferred = MBED_TRACE_MEM_ALLOC(length);
+        if (m_trace.deferred) {
+            m_trace.deferred_length = length;
+        }
+    }
+    m_trace.deferred_head = 0;
+    m_trace.deferred_tail = 0;
+    m_trace.deferred_dropped = 0;
+    if (m_trace.mutex_release_f) {
+        m_trace.mutex_release_f();
+    }
+}
+int mbed_trace_deferred_read(uint8_t *buf, int length)
+{
+    int count = 0;
+
+    if (m_trace.mutex_wait_f) {
+        m_trace.mutex_wait_f();
+    }
+    while (m_trace.deferred && count < length && m_trace.deferred_tail != m_trace.deferred_head) {
+        int chunk = (m_trace.deferred_head > m_trace.deferred_tail ? m_trace.deferred_head : m_trace.deferred_length) - m_trace.deferred_tail;
+        if (chunk > length - count) {
+            chunk = length - count;
+        }
+        memcpy(buf + count, m_trace.deferred + m_trace.deferred_tail, chunk);
+        count += chunk;
+        m_trace.deferred_tail += chunk;
+        if (m_trace.deferred_tail == m_trace.deferred_length) {
+            m_trace.deferred_tail = 0;
+        }
+    }
+    if (m_trace.mutex_release_f) {
+        m_trace.mutex_release_f();
+    }
+    return count;
+}
 void mbed_trace_config_set(uint8_t config)
 {
     m_trace.trace_config = config;
@@ -331,6 +423,13 @@ void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
         goto end;
     }
     if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
+        if (m_trace.deferred && dlevel != TRACE_LEVEL_CMD &&
+                mbed_trace_deferred_store(dlevel, grp, fmt, ap) == 0) {
+            //return tmp data pointer back to the beginning
+            mbed_trace_reset_tmp();
+            goto end;
+        }
+
         bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
         bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
         bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
@@ -494,6 +593,177 @@ end:
         } while (--count > 0);
     }
 }
+/* Appends bytes to a deferred trace record, returns the new position or -1 if they do not fit */
+static int mbed_trace_deferred_put(uint8_t *record, int pos, const void *data, int size)
+{
+    if (pos < 0 || pos + size > TRACE_DEFERRED_RECORD_LENGTH) {
+        return -1;
+    }
+    memcpy(record + pos, data, size);
+    return pos + size;
+}
+static void mbed_trace_deferred_write(const uint8_t *data, int size)
+{
+    while (size > 0) {
+        int chunk = m_trace.deferred_length - m_trace.deferred_head;
+        if (chunk > size) {
+            chunk = size;
+        }
+        memcpy(m_trace.deferred + m_trace.deferred_head, data, chunk);
+        data += chunk;
+        size -= chunk;
+        m_trace.deferred_head += chunk;
+        if (m_trace.deferred_head == m_trace.deferred_length) {
+            m_trace.deferred_head = 0;
+        }
+    }
+}
+/* Records the format and group addresses and the raw arguments to the deferred trace buffer.
+ * Record: length byte, level byte, format and group pointers, then each argument in
+ * native size, strings as a length byte and their characters. A record with level 0
+ * carries the count of records dropped before it as uint32_t.
+ * Returns -1 if the format can not be recorded, the trace is then formatted as usual. */
+static int mbed_trace_deferred_store(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    uint8_t record[TRACE_DEFERRED_RECORD_LENGTH];
+    const char *fmt_ptr = fmt;
+    int pos = 1;
+    va_list ap2;
+    uint32_t timestamp = TRACE_DEFERRED_TIME();
+
+    record[pos++] = dlevel;
+    pos = mbed_trace_deferred_put(record, pos, &timestamp, sizeof(timestamp));
+    pos = mbed_trace_deferred_put(record, pos, &fmt, sizeof(fmt));
+    pos = mbed_trace_deferred_put(record, pos, &grp, sizeof(grp));
+
+    va_copy(ap2, ap);
+    while (pos > 0 && *fmt_ptr) {
+        char length = 0;
+
+        if (*fmt_ptr++ != '%') {
+            continue;
+        }
+        //flags, width and precision
+        while (*fmt_ptr && strchr("-+ #0", *fmt_ptr)) {
+            fmt_ptr++;
+        }
+        for (int i = 0; i < 2 && pos > 0; i++) {
+            if (*fmt_ptr == '*') {
+                int value = va_arg(ap2, int);
+                pos = mbed_trace_deferred_put(record, pos, &value, sizeof(value));
+                fmt_ptr++;
+            }
+            while (*fmt_ptr >= '0' && *fmt_ptr <= '9') {
+                fmt_ptr++;
+            }
+            if (i > 0 || *fmt_ptr != '.') {
+                break;
+            }
+            fmt_ptr++;
+        }
+        //length modifier, 'H' for hh and 'q' for ll
+        if (*fmt_ptr && strchr("hljztL", *fmt_ptr)) {
+            length = *fmt_ptr++;
+            if ((length == 'h' || length == 'l') && *fmt_ptr == length) {
+                length = length == 'h' ? 'H' : 'q';
+                fmt_ptr++;
+            }
+        }
+        switch (*fmt_ptr) {
+            case '%':
+                break;
+            case 'd':
+            case 'i':
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'c':
+                if (length == 'l') {
+                    long value = va_arg(ap2, long);
+                    pos = mbed_trace_deferred_put(record, pos, &value, sizeof(value));
+                } else if (length == 'q' || length == 'L') {
+                    long long value = va_arg(ap2, long long);
+                    pos = mbed_trace_deferred_put(record, pos, &value, sizeof(value));
+                } else if (length == 'j') {
+                    intmax_t value = va_arg(ap2, intmax_t);
+                    pos = mbed_trace_deferred_put(record, pos, &value, sizeof(value));
+                } else if (length == 'z' || length == 't') {
+                    size_t value = va_arg(ap2, size_t);
+                    pos = mbed_trace_deferred_put(record, pos, &value, sizeof(value));
+                } else {
+                    int value = va_arg(ap2, int);
+                    pos = mbed_trace_deferred_put(record, pos, &value, sizeof(value));
+                }
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                double value = length == 'L' ? (double) va_arg(ap2, long double) : va_arg(ap2, double);
+                pos = mbed_trace_deferred_put(record, pos, &value, sizeof(value));
+                break;
+            }
+            case 'p': {
+                void *value = va_arg(ap2, void *);
+                pos = mbed_trace_deferred_put(record, pos, &value, sizeof(value));
+                break;
+            }
+            case 's': {
+                //strings may be temporary, e.g. from mbed_trace_array(), so they are copied
+                const char *value = va_arg(ap2, const char *);
+                size_t len;
+                if (!value) {
+                    value = "(null)";
+                }
+                len = strlen(value);
+                if (len > (size_t)(TRACE_DEFERRED_RECORD_LENGTH - 1 - pos)) {
+                    len = pos < TRACE_DEFERRED_RECORD_LENGTH - 1 ? TRACE_DEFERRED_RECORD_LENGTH - 1 - pos : 0;
+                }
+                record[pos] = len;
+                pos = mbed_trace_deferred_put(record, pos + 1, value, len);
+                break;
+            }
+            default:
+                pos = -1;
+                break;
+        }
+        if (*fmt_ptr) {
+            fmt_ptr++;
+        }
+    }
+    va_end(ap2);
+
+    if (pos < 0) {
+        return -1;
+    }
+    record[0] = pos;
+
+    int used = m_trace.deferred_head - m_trace.deferred_tail;
+    if (used < 0) {
+        used += m_trace.deferred_length;
+    }
+    int left = m_trace.deferred_length - 1 - used;
+    if (m_trace.deferred_dropped) {
+        uint8_t dropped[2 + sizeof(uint32_t)] = { sizeof(dropped), 0 };
+        if (left < (int) sizeof(dropped) + pos) {
+            m_trace.deferred_dropped++;
+            return 0;
+        }
+        memcpy(dropped + 2, &m_trace.deferred_dropped, sizeof(uint32_t));
+        mbed_trace_deferred_write(dropped, sizeof(dropped));
+        m_trace.deferred_dropped = 0;
+    } else if (left < pos) {
+        m_trace.deferred_dropped++;
+        return 0;
+    }
+    mbed_trace_deferred_write(record, pos);
+    return 0;
+}
 static void mbed_trace_reset_tmp(void)
 {
     m_trace.tmp_data_ptr = m_trace.tmp_data;
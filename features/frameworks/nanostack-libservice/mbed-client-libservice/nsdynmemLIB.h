@@ -32,7 +32,7 @@ extern "C" {
 #include "ns_types.h"
 
 // Added to maintain backward compatibility with older implementation of ns_dyn_mem APIs
-#define NSDYNMEMLIB_API_VERSION 3
+#define NSDYNMEMLIB_API_VERSION 4
 
 typedef size_t ns_mem_block_size_t; //external interface unsigned heap block size type
 typedef size_t ns_mem_heap_size_t; //total heap size type.
@@ -50,6 +50,21 @@ typedef enum {
     NS_DYN_MEM_HEAP_SECTOR_UNITIALIZED /**< ns_dyn_mem_free(), ns_dyn_mem_temporary_alloc() or ns_dyn_mem_alloc() called before ns_dyn_mem_init() */
 } heap_fail_t;
 
+/** Number of size classes of the segregated free lists, see ns_mem_set_size_class_mode() */
+#define NS_DYN_MEM_SIZE_CLASS_COUNT 8
+
+/**
+ * /struct mem_size_class_stat_t
+ * /brief Struct for the statistics of a size class
+ */
+typedef struct mem_size_class_stat_t {
+    ns_mem_block_size_t block_size;             /**< Data size of the blocks of the class in bytes. */
+    uint32_t alloc_cnt;                         /**< Blocks of the class in use. */
+    uint32_t cached_cnt;                        /**< Free blocks kept in the free list of the class. */
+    uint32_t hit_cnt;                           /**< Allocations served from the free list. */
+    uint32_t miss_cnt;                          /**< Allocations carved from the heap because the free list was empty. */
+} mem_size_class_stat_t;
+
 /**
  * /struct mem_stat_t
  * /brief Struct for Memory stats Buffer structure
@@ -62,6 +77,7 @@ typedef struct mem_stat_t {
     ns_mem_heap_size_t heap_sector_allocated_bytes_max;    /**< Reserved Heap data in bytes max value. */
     uint32_t heap_alloc_total_bytes;            /**< Total Heap allocated bytes. */
     uint32_t heap_alloc_fail_cnt;               /**< Counter for Heap allocation fail. */
+    mem_size_class_stat_t size_class[NS_DYN_MEM_SIZE_CLASS_COUNT]; /**< Size class statistics, smallest class first. */
 } mem_stat_t;
 
 
@@ -152,6 +168,17 @@ extern const mem_stat_t *ns_dyn_mem_get_mem_stat(void);
   */
 extern int ns_dyn_mem_set_temporary_alloc_free_heap_threshold(uint8_t free_heap_percentage, ns_mem_heap_size_t free_heap_amount);
 
+/**
+  * \brief Enable or disable segregated free lists for small allocations.
+  *
+  * See ns_mem_set_size_class_mode().
+  *
+  * \param enable true to enable the size classes, false to disable them.
+  *
+  * \return 0 on success, <0 otherwise
+  */
+extern int ns_dyn_mem_set_size_class_mode(bool enable);
+
 /**
   * \brief Init and set Dynamical heap pointer and length.
   *
@@ -244,6 +271,25 @@ extern const mem_stat_t *ns_mem_get_mem_stat(ns_mem_book_t *book);
   */
 extern int ns_mem_set_temporary_alloc_free_heap_threshold(ns_mem_book_t *book, uint8_t free_heap_percentage, ns_mem_heap_size_t free_heap_amount);
 
+/**
+  * \brief Enable or disable segregated free lists for small allocations.
+  *
+  * When enabled, allocations up to the largest size class are rounded up to
+  * their class size. A freed block of a class is kept in a free list of its
+  * class instead of being merged back into the heap, and the next allocation
+  * of the class takes it back in constant time without walking the heap.
+  * Blocks kept in the free lists are returned to the heap when an allocation
+  * cannot be satisfied otherwise, or when the mode is disabled.
+  *
+  * Allocations larger than the largest class, 256 bytes, use the heap as usual.
+  *
+  * \param book Address of book keeping structure
+  * \param enable true to enable the size classes, false to disable them.
+  *
+  * \return 0 on success, <0 otherwise
+  */
+extern int ns_mem_set_size_class_mode(ns_mem_book_t *book, bool enable);
+
 #ifdef __cplusplus
 }
 #endif
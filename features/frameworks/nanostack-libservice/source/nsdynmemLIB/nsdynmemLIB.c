@@ -31,11 +31,17 @@ typedef struct {
     ns_list_link_t link;
 } hole_t;
 
+typedef struct cached_block {
+    struct cached_block *next;
+} cached_block_t;
+
 typedef int ns_mem_word_size_t; // internal signed heap block size type
 
 // Amount of memory regions
 #define REGION_COUNT 3
 
+#define SIZE_CLASS_COUNT NS_DYN_MEM_SIZE_CLASS_COUNT
+
 /* struct for book keeping variables */
 struct ns_mem_book {
     ns_mem_word_size_t     *heap_main[REGION_COUNT];
@@ -45,6 +51,8 @@ struct ns_mem_book {
     NS_LIST_HEAD(hole_t, link) holes_list;
     ns_mem_heap_size_t heap_size;
     ns_mem_heap_size_t temporary_alloc_heap_limit;   /* Amount of reserved heap temporary alloc can't exceed */
+    bool size_classes;
+    cached_block_t *class_free[SIZE_CLASS_COUNT];     /* Free blocks of each size class, not merged into the heap */
 };
 
 static ns_mem_book_t *default_book; // heap pointer for original "ns_" API use
@@ -54,6 +62,13 @@ static ns_mem_book_t *default_book; // heap pointer for original "ns_" API use
 
 #define TEMPORARY_ALLOC_FREE_HEAP_THRESHOLD 5  /* temporary allocations must leave 5% of the heap free */
 
+/* Data sizes of the size classes in bytes, multiples of the word size able to hold a cached_block_t */
+static const uint16_t size_class_bytes[SIZE_CLASS_COUNT] = { 8, 16, 32, 48, 64, 96, 128, 256 };
+
+// A block in a class free list keeps a positive size, so that adjacent holes
+// do not merge with it, but its end marker is flagged to catch double frees.
+#define CACHED_BLOCK_FLAG ((ns_mem_word_size_t) 1 << (sizeof(ns_mem_word_size_t) * 8 - 2))
+
 static NS_INLINE hole_t *hole_from_block_start(ns_mem_word_size_t *start)
 {
     return (hole_t *)(start + 1);
@@ -64,6 +79,18 @@ static NS_INLINE ns_mem_word_size_t *block_start_from_hole(hole_t *start)
     return ((ns_mem_word_size_t *)start) - 1;
 }
 
+static NS_INLINE cached_block_t *cached_from_block_start(ns_mem_word_size_t *start)
+{
+    return (cached_block_t *)(start + 1);
+}
+
+static NS_INLINE ns_mem_word_size_t *block_start_from_cached(cached_block_t *start)
+{
+    return ((ns_mem_word_size_t *)start) - 1;
+}
+
+static bool size_class_flush(ns_mem_book_t *book);
+
 static void heap_failure(ns_mem_book_t *book, heap_fail_t reason)
 {
     if (book->heap_failure_callback) {
@@ -87,6 +114,17 @@ static int ns_dyn_mem_region_find(ns_mem_book_t *book, ns_mem_word_size_t *block
     return -1;
 }
 
+static int size_class_find(ns_mem_word_size_t data_size)
+{
+    for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+        if (data_size <= (ns_mem_word_size_t)(size_class_bytes[i] / sizeof(ns_mem_word_size_t))) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
 static int ns_dyn_mem_region_save(ns_mem_book_t *book, ns_mem_word_size_t *region_start_ptr, ns_mem_word_size_t region_size)
 {
     for (int i = 1; i < REGION_COUNT; i++) {
@@ -167,7 +205,12 @@ ns_mem_book_t *ns_mem_init(void *heap, ns_mem_heap_size_t h_size,
     if (info_ptr) {
         memset(book->mem_stat_info_ptr, 0, sizeof(mem_stat_t));
         book->mem_stat_info_ptr->heap_sector_size = book->heap_size;
+        for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+            book->mem_stat_info_ptr->size_class[i].block_size = size_class_bytes[i];
+        }
     }
+    book->size_classes = false;
+    memset(book->class_free, 0, sizeof(book->class_free));
     book->temporary_alloc_heap_limit = book->heap_size / 100 * (100 - TEMPORARY_ALLOC_FREE_HEAP_THRESHOLD);
 #endif
     //There really is no support to standard malloc in this library anymore
@@ -301,6 +344,34 @@ extern int ns_dyn_mem_set_temporary_alloc_free_heap_threshold(uint8_t free_heap_
     return ns_mem_set_temporary_alloc_free_heap_threshold(default_book, free_heap_percentage, free_heap_amount);
 }
 
+int ns_mem_set_size_class_mode(ns_mem_book_t *book, bool enable)
+{
+#ifndef STANDARD_MALLOC
+    if (!book) {
+        return -1;
+    }
+
+    platform_enter_critical();
+    if (!enable) {
+        size_class_flush(book);
+    }
+    book->size_classes = enable;
+    platform_exit_critical();
+
+    return 0;
+#else
+    (void) book;
+    (void) enable;
+
+    return -3;
+#endif
+}
+
+int ns_dyn_mem_set_size_class_mode(bool enable)
+{
+    return ns_mem_set_size_class_mode(default_book, enable);
+}
+
 #ifndef STANDARD_MALLOC
 static void dev_stat_update(mem_stat_t *mem_stat_info_ptr, mem_stat_update_t type, ns_mem_block_size_t size)
 {
@@ -353,6 +424,33 @@ static int8_t ns_mem_block_validate(ns_mem_word_size_t *block_start)
 }
 #endif
 
+#ifndef STANDARD_MALLOC
+// For direction, use 1 for direction up and -1 for down
+static ns_mem_word_size_t *ns_mem_hole_find(ns_mem_book_t *book, ns_mem_word_size_t data_size, int direction)
+{
+    // ns_list_foreach, either forwards or backwards, result to ptr
+    for (hole_t *cur_hole = direction > 0 ? ns_list_get_first(&book->holes_list)
+                            : ns_list_get_last(&book->holes_list);
+            cur_hole;
+            cur_hole = direction > 0 ? ns_list_get_next(&book->holes_list, cur_hole)
+                       : ns_list_get_previous(&book->holes_list, cur_hole)
+        ) {
+        ns_mem_word_size_t *p = block_start_from_hole(cur_hole);
+        if (ns_mem_block_validate(p) != 0 || *p >= 0) {
+            //Validation failed, or this supposed hole has positive (allocated) size
+            heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+            break;
+        }
+        if (-*p >= data_size) {
+            // Found a big enough block
+            return p;
+        }
+    }
+
+    return NULL;
+}
+#endif
+
 // For direction, use 1 for direction up and -1 for down
 static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_t alloc_size, int direction)
 {
@@ -380,26 +478,37 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
         goto done;
     }
 
-    // ns_list_foreach, either forwards or backwards, result to ptr
-    for (hole_t *cur_hole = direction > 0 ? ns_list_get_first(&book->holes_list)
-                            : ns_list_get_last(&book->holes_list);
-            cur_hole;
-            cur_hole = direction > 0 ? ns_list_get_next(&book->holes_list, cur_hole)
-                       : ns_list_get_previous(&book->holes_list, cur_hole)
-        ) {
-        ns_mem_word_size_t *p = block_start_from_hole(cur_hole);
-        if (ns_mem_block_validate(p) != 0 || *p >= 0) {
-            //Validation failed, or this supposed hole has positive (allocated) size
-            heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
-            break;
+    // Separate declarations from initialization to keep IAR happy as the gotos skip them.
+    int class_index;
+    ns_mem_word_size_t class_size;
+    class_index = book->size_classes ? size_class_find(data_size) : -1;
+    class_size = 0;
+    if (class_index >= 0) {
+        class_size = size_class_bytes[class_index] / sizeof(ns_mem_word_size_t);
+        data_size = class_size;
+        cached_block_t *cached = book->class_free[class_index];
+        if (cached) {
+            book->class_free[class_index] = cached->next;
+            block_ptr = block_start_from_cached(cached);
+            block_ptr[1 + data_size] = data_size;
+            if (book->mem_stat_info_ptr) {
+                book->mem_stat_info_ptr->size_class[class_index].cached_cnt--;
+                book->mem_stat_info_ptr->size_class[class_index].alloc_cnt++;
+                book->mem_stat_info_ptr->size_class[class_index].hit_cnt++;
+            }
+            goto done;
         }
-        if (-*p >= data_size) {
-            // Found a big enough block
-            block_ptr = p;
-            break;
+        if (book->mem_stat_info_ptr) {
+            book->mem_stat_info_ptr->size_class[class_index].miss_cnt++;
         }
     }
 
+    block_ptr = ns_mem_hole_find(book, data_size, direction);
+    if (!block_ptr && size_class_flush(book)) {
+        // Blocks kept for the size classes may have merged into a big enough hole
+        block_ptr = ns_mem_hole_find(book, data_size, direction);
+    }
+
     if (!block_ptr) {
         goto done;
     }
@@ -440,6 +549,10 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
     block_ptr[0] = data_size;
     block_ptr[1 + data_size] = data_size;
 
+    if (data_size == class_size && book->mem_stat_info_ptr) {
+        book->mem_stat_info_ptr->size_class[class_index].alloc_cnt++;
+    }
+
 done:
     if (book->mem_stat_info_ptr) {
         if (block_ptr) {
@@ -583,6 +696,43 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
     *start = -merged_data_size;
     *end = -merged_data_size;
 }
+
+static void size_class_push(ns_mem_book_t *book, int class_index, ns_mem_word_size_t *cur_block, ns_mem_word_size_t data_size)
+{
+    cached_block_t *cached = cached_from_block_start(cur_block);
+    cached->next = book->class_free[class_index];
+    book->class_free[class_index] = cached;
+    cur_block[1 + data_size] = data_size | CACHED_BLOCK_FLAG;
+
+    if (book->mem_stat_info_ptr) {
+        if (book->mem_stat_info_ptr->size_class[class_index].alloc_cnt) {
+            book->mem_stat_info_ptr->size_class[class_index].alloc_cnt--;
+        }
+        book->mem_stat_info_ptr->size_class[class_index].cached_cnt++;
+    }
+}
+
+// Returns the blocks of the size class free lists to the heap
+static bool size_class_flush(ns_mem_book_t *book)
+{
+    bool flushed = false;
+
+    for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+        while (book->class_free[i]) {
+            cached_block_t *cached = book->class_free[i];
+            ns_mem_word_size_t *block = block_start_from_cached(cached);
+            book->class_free[i] = cached->next;
+            block[1 + block[0]] = block[0];
+            ns_mem_free_and_merge_with_adjacent_blocks(book, block, block[0]);
+            flushed = true;
+        }
+        if (book->mem_stat_info_ptr) {
+            book->mem_stat_info_ptr->size_class[i].cached_cnt = 0;
+        }
+    }
+
+    return flushed;
+}
 #endif
 
 static bool pointer_address_validate(ns_mem_book_t *book, ns_mem_word_size_t *ptr, ns_mem_word_size_t size)
@@ -612,11 +762,18 @@ void ns_mem_free(ns_mem_book_t *book, void *block)
     size = *ptr;
     if (!pointer_address_validate(book, ptr, size)) {
         heap_failure(book, NS_DYN_MEM_POINTER_NOT_VALID);
-    } else if (size < 0) {
+    } else if (size < 0 || ptr[1 + size] == (size | CACHED_BLOCK_FLAG)) {
         heap_failure(book, NS_DYN_MEM_DOUBLE_FREE);
     } else {
+        int class_index = book->size_classes ? size_class_find(size) : -1;
         if (ns_mem_block_validate(ptr) != 0) {
             heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+        } else if (class_index >= 0 &&
+                   size == (ns_mem_word_size_t)(size_class_bytes[class_index] / sizeof(ns_mem_word_size_t))) {
+            size_class_push(book, class_index, ptr, size);
+            if (book->mem_stat_info_ptr) {
+                dev_stat_update(book->mem_stat_info_ptr, DEV_HEAP_FREE, (size + 2) * sizeof(ns_mem_word_size_t));
+            }
         } else {
             ns_mem_free_and_merge_with_adjacent_blocks(book, ptr, size);
             if (book->mem_stat_info_ptr) {
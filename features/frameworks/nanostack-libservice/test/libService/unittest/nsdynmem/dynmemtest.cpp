@@ -23,7 +23,7 @@
 // hardcoded amount of regions, keep in sync with nsdynmemlib "REGION_COUNT"
 #define NS_MEM_REGION_CNT  (3)
 // size of nsdynmemlib book keeping data ns_mem_book_t
-#define NS_MEM_BOOK_SIZE (64 + (NS_MEM_REGION_CNT-1)*2*sizeof(ns_mem_heap_size_t))
+#define NS_MEM_BOOK_SIZE (64 + (NS_MEM_REGION_CNT-1)*2*sizeof(ns_mem_heap_size_t) + (1 + NS_DYN_MEM_SIZE_CLASS_COUNT)*sizeof(void *))
 #define NS_MEM_BOOK_SIZE_WITH_HOLE (NS_MEM_BOOK_SIZE + 2*sizeof(ns_mem_heap_size_t))
 
 int ret_val;
@@ -750,6 +750,81 @@ TEST(dynmem, test_free_corrupted_next_block)
     free(heap);
 }
 
+TEST(dynmem, size_class_reuse)
+{
+    uint16_t size = 1000;
+    mem_stat_t info;
+    uint8_t *heap = (uint8_t *)malloc(size);
+    CHECK(NULL != heap);
+    reset_heap_error();
+    CHECK(0 != ns_mem_set_size_class_mode(NULL, true));
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    CHECK(info.size_class[0].block_size == 8);
+    CHECK(info.size_class[NS_DYN_MEM_SIZE_CLASS_COUNT - 1].block_size == 256);
+    CHECK(0 == ns_dyn_mem_set_size_class_mode(true));
+
+    // 20 and 30 bytes both fall in the 32 bytes class
+    void *p = ns_dyn_mem_alloc(20);
+    CHECK(NULL != p);
+    CHECK(info.size_class[2].miss_cnt == 1);
+    CHECK(info.size_class[2].alloc_cnt == 1);
+    ns_dyn_mem_free(p);
+    CHECK(info.size_class[2].alloc_cnt == 0);
+    CHECK(info.size_class[2].cached_cnt == 1);
+    CHECK(info.heap_sector_alloc_cnt == 0);
+
+    void *p2 = ns_dyn_mem_temporary_alloc(30);
+    CHECK(p == p2);
+    CHECK(info.size_class[2].hit_cnt == 1);
+    CHECK(info.size_class[2].cached_cnt == 0);
+
+    // Larger than the largest class
+    void *p3 = ns_dyn_mem_alloc(300);
+    CHECK(NULL != p3);
+    ns_dyn_mem_free(p3);
+    CHECK(info.size_class[NS_DYN_MEM_SIZE_CLASS_COUNT - 1].cached_cnt == 0);
+
+    ns_dyn_mem_free(p2);
+    ns_dyn_mem_free(p2);
+    CHECK(NS_DYN_MEM_DOUBLE_FREE == current_heap_error);
+
+    reset_heap_error();
+    CHECK(0 == ns_dyn_mem_set_size_class_mode(false));
+    CHECK(info.size_class[2].cached_cnt == 0);
+    CHECK(!heap_have_failed());
+    free(heap);
+}
+
+TEST(dynmem, size_class_flush_on_failure)
+{
+    uint16_t size = 1000;
+    mem_stat_t info;
+    void *ptr[200];
+    int count = 0;
+    uint8_t *heap = (uint8_t *)malloc(size);
+    CHECK(NULL != heap);
+    reset_heap_error();
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    CHECK(0 == ns_dyn_mem_set_size_class_mode(true));
+
+    while (count < 200 && (ptr[count] = ns_dyn_mem_alloc(8)) != NULL) {
+        count++;
+    }
+    CHECK(count > 0 && count < 200);
+    for (int i = 0; i < count; i++) {
+        ns_dyn_mem_free(ptr[i]);
+    }
+    CHECK(info.size_class[0].cached_cnt > 0);
+
+    // The whole heap is kept by the 8 bytes class, it is given back
+    void *p = ns_dyn_mem_alloc(size / 2);
+    CHECK(NULL != p);
+    CHECK(info.size_class[0].cached_cnt == 0);
+    ns_dyn_mem_free(p);
+    CHECK(!heap_have_failed());
+    free(heap);
+}
+
 //NOTE! This test must be last!
 TEST(dynmem, uninitialized_test)
 {
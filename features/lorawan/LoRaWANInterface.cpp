@@ -71,6 +71,12 @@ lorawan_status_t LoRaWANInterface::disconnect()
     return _lw_stack.shutdown();
 }
 
+lorawan_status_t LoRaWANInterface::forget_session()
+{
+    Lock lock(*this);
+    return _lw_stack.forget_session();
+}
+
 lorawan_status_t LoRaWANInterface::add_link_check_request()
 {
     Lock lock(*this);
@@ -107,6 +113,18 @@ lorawan_status_t LoRaWANInterface::disable_adaptive_datarate()
     return _lw_stack.enable_adaptive_datarate(false);
 }
 
+lorawan_status_t LoRaWANInterface::enable_device_adr()
+{
+    Lock lock(*this);
+    return _lw_stack.enable_device_adr(true);
+}
+
+lorawan_status_t LoRaWANInterface::disable_device_adr()
+{
+    Lock lock(*this);
+    return _lw_stack.enable_device_adr(false);
+}
+
 lorawan_status_t LoRaWANInterface::set_channel_plan(const lorawan_channelplan_t &channel_plan)
 {
     Lock lock(*this);
@@ -137,6 +155,18 @@ int16_t LoRaWANInterface::send(uint8_t port, const uint8_t *data, uint16_t lengt
     return _lw_stack.handle_tx(port, data, length, flags);
 }
 
+int16_t LoRaWANInterface::send_aggregated(uint8_t port, const uint8_t *data, uint16_t length, int flags)
+{
+    Lock lock(*this);
+    return _lw_stack.send_aggregated(port, data, length, flags);
+}
+
+lorawan_status_t LoRaWANInterface::get_aggregation_stats(lorawan_aggregation_stats_t &stats)
+{
+    Lock lock(*this);
+    return _lw_stack.acquire_aggregation_stats(stats);
+}
+
 lorawan_status_t LoRaWANInterface::cancel_sending(void)
 {
     Lock lock(*this);
@@ -161,6 +191,24 @@ lorawan_status_t LoRaWANInterface::get_backoff_metadata(int &backoff)
     return _lw_stack.acquire_backoff_metadata(backoff);
 }
 
+lorawan_status_t LoRaWANInterface::get_link_stats(lorawan_link_stats_t &stats)
+{
+    Lock lock(*this);
+    return _lw_stack.acquire_link_stats(stats);
+}
+
+lorawan_status_t LoRaWANInterface::get_channel_stats(uint8_t channel, lorawan_link_stats_t &stats)
+{
+    Lock lock(*this);
+    return _lw_stack.acquire_channel_stats(channel, stats);
+}
+
+lorawan_status_t LoRaWANInterface::reset_link_stats()
+{
+    Lock lock(*this);
+    return _lw_stack.reset_link_stats();
+}
+
 int16_t LoRaWANInterface::receive(uint8_t port, uint8_t *data, uint16_t length, int flags)
 {
     Lock lock(*this);
@@ -90,9 +90,9 @@ public:
      * relaxed as compared to the Join (default) channels only.
      *
      * **NOTES ON RECONNECTION:**
-     * Currently, the Mbed OS LoRaWAN implementation does not support non-volatile memory storage.
-     * Therefore, the state and frame counters cannot be restored after a power cycle. However,
-     * if you use the `disconnect()` API to shut down the LoRaWAN protocol, the state and frame
+     * Unless `lora.session-persistence` is enabled, the state and frame counters cannot be restored
+     * after a power cycle. With it, the session of an OTAA join is stored in the default KVStore and
+     * connecting after a reset resumes it without a JoinRequest, see forget_session(). If you use the `disconnect()` API to shut down the LoRaWAN protocol, the state and frame
      * counters are saved. Connecting again restores the previous session. According to the LoRaWAN
      * 1.0.2 specification, the frame counters are always reset to 0 for OTAA, and a new Join request
      * lets the network server know that the counters need a reset. The same is said about the ABP,
@@ -112,6 +112,8 @@ public:
      *                      (if the previous request for connection is still underway) or
      *                      LORAWAN_STATUS_ALREADY_CONNECTED (if a network was already joined successfully).
      *                      A 'CONNECTED' event is sent to the application when the JoinAccept is received.
+     *                      When a stored session is resumed, LORAWAN_STATUS_OK is returned followed by
+     *                      a 'CONNECTED' event as for ABP.
      */
     lorawan_status_t connect();
 
@@ -133,9 +135,9 @@ public:
      * duty cycle becomes much more relaxed as compared to the Join (default) channels only.
      *
      * **NOTES ON RECONNECTION:**
-     * Currently, the Mbed OS LoRaWAN implementation does not support non-volatile memory storage.
-     * Therefore, the state and frame counters cannot be restored after a power cycle. However,
-     * if you use the `disconnect()` API to shut down the LoRaWAN protocol, the state and frame
+     * Unless `lora.session-persistence` is enabled, the state and frame counters cannot be restored
+     * after a power cycle. With it, the session of an OTAA join is stored in the default KVStore and
+     * connecting after a reset resumes it without a JoinRequest, see forget_session(). If you use the `disconnect()` API to shut down the LoRaWAN protocol, the state and frame
      * counters are saved. Connecting again restores the previous session. According to the LoRaWAN
      * 1.0.2 specification, the frame counters are always reset to zero for OTAA, and a new Join
      * request lets the network server know that the counters need a reset. The same is said about
@@ -157,6 +159,8 @@ public:
      *                      (if the previous request for connection is still underway) or LORAWAN_STATUS_ALREADY_CONNECTED
      *                      (if a network was already joined successfully).
      *                      A 'CONNECTED' event is sent to the application when the JoinAccept is received.
+     *                      When a stored session is resumed, LORAWAN_STATUS_OK is returned followed by
+     *                      a 'CONNECTED' event as for ABP.
      */
     lorawan_status_t connect(const lorawan_connect_t &connect);
 
@@ -167,6 +171,19 @@ public:
      */
     lorawan_status_t disconnect();
 
+    /** Forget the stored session.
+     *
+     * With `lora.session-persistence` enabled, connect() resumes the session stored after the
+     * last OTAA join. Forgetting it makes the next connect() join again, for example when the
+     * network server does not answer the resumed session anymore. The current session, if any,
+     * stays connected but is not stored anymore.
+     *
+     * @return         LORAWAN_STATUS_OK on success, a negative error code on failure:
+     *                 LORAWAN_STATUS_UNSUPPORTED if `lora.session-persistence` is not enabled,
+     *                 LORAWAN_STATUS_NO_OP if the stored session could not be removed.
+     */
+    lorawan_status_t forget_session();
+
     /** Validate the connectivity with the network.
      *
      * Application may use this API to submit a request to the stack for validation of its connectivity
@@ -232,6 +249,32 @@ public:
      */
     lorawan_status_t disable_adaptive_datarate();
 
+    /** Enables the device side adaptive data rate policy
+     *
+     * The stack selects the data rate and TX power itself from the link
+     * statistics: the highest data rate and then the lowest TX power which keep
+     * the SNR margin of the downlinks above lora.device-adr-margin, so that the
+     * least airtime and energy is spent per delivered frame. The data rate is
+     * lowered and the TX power raised to the maximum when CONFIRMED messages
+     * stop being acknowledged.
+     *
+     * The policy only adapts when downlinks are received and is meant for
+     * networks which do not run ADR. Enabling it disables network ADR.
+     *
+     * @return             LORAWAN_STATUS_OK on success, negative error code on failure:
+     *                     LORAWAN_STATUS_NOT_INITIALIZED if system is not initialized with initialize()
+     */
+    lorawan_status_t enable_device_adr();
+
+    /** Disables the device side adaptive data rate policy
+     *
+     * The data rate and TX power selected last stay in use.
+     *
+     * @return             LORAWAN_STATUS_OK on success, negative error code on failure:
+     *                     LORAWAN_STATUS_NOT_INITIALIZED if system is not initialized with initialize()
+     */
+    lorawan_status_t disable_device_adr();
+
     /** Sets up the retry counter for confirmed messages.
      *
      * Valid for confirmed messages only.
@@ -352,6 +395,52 @@ public:
      */
     int16_t send(uint8_t port, const uint8_t *data, uint16_t length, int flags);
 
+    /** Send a small message aggregated with others
+     *
+     * Messages are packed into a single frame, each one prefixed with a byte
+     * giving its length, so the application server can split them. A frame is
+     * handed to the stack as soon as no other transmission is ongoing and is
+     * transmitted at the earliest time the duty cycle allows. While it waits
+     * for its backoff, following messages are merged into it as long as they
+     * fit in the maximum payload of the current data rate. Messages arriving
+     * once the frame is on air are sent with the next frame, right after the
+     * current TX cycle.
+     *
+     * A TX_DONE event, or an error event, is sent for each frame rather than
+     * for each message. Use get_aggregation_stats() to know how many messages
+     * were delivered and how long they waited.
+     *
+     * @param port          The application port number. All the messages of a
+     *                      frame use the same port.
+     *
+     * @param data          A pointer to the data being sent. The data is copied
+     *                      to the internal buffers.
+     *
+     * @param length        The size of data in bytes.
+     *
+     * @param flags         MSG_UNCONFIRMED_FLAG or MSG_CONFIRMED_FLAG. All the
+     *                      messages of a frame use the same flag.
+     *
+     * @return              The number of bytes queued, or a negative error code on failure:
+     *                      LORAWAN_STATUS_NOT_INITIALIZED   if system is not initialized with initialize(),
+     *                      LORAWAN_STATUS_NO_ACTIVE_SESSIONS if connection is not open,
+     *                      LORAWAN_STATUS_WOULD_BLOCK       if the next frame is full or uses another port or flag,
+     *                      LORAWAN_STATUS_LENGTH_ERROR      if the message does not fit in a frame at the current data rate,
+     *                      LORAWAN_STATUS_PORT_INVALID      if trying to send to an invalid port (e.g. to 0)
+     *                      LORAWAN_STATUS_PARAMETER_INVALID if NULL data pointer or zero length is given or flags are invalid.
+     */
+    int16_t send_aggregated(uint8_t port, const uint8_t *data, uint16_t length, int flags);
+
+    /** Get statistics of the messages sent with send_aggregated()
+     *
+     * @param  stats        A reference to a lorawan_aggregation_stats_t
+     *                      structure filled with the statistics.
+     *
+     * @return              LORAWAN_STATUS_OK on success, otherwise other negative error code:
+     *                      LORAWAN_STATUS_NOT_INITIALIZED if system is not initialized with initialize()
+     */
+    lorawan_status_t get_aggregation_stats(lorawan_aggregation_stats_t &stats);
+
     /** Receives a message from the Network Server on a specific port.
      *
      * @param port          The application port number. Port numbers 0 and 224 are reserved,
@@ -518,6 +607,40 @@ public:
      */
     lorawan_status_t get_backoff_metadata(int &backoff);
 
+    /** Get hold of link statistics
+     *
+     * Use this method to get the transmission, acknowledgement and downlink
+     * quality statistics of all channels since initialization or the last call
+     * to reset_link_stats().
+     *
+     * @param    stats      the inbound structure that will be filled with the statistics.
+     *
+     * @return              LORAWAN_STATUS_OK on success, otherwise other negative error code:
+     *                      LORAWAN_STATUS_NOT_INITIALIZED if system is not initialized with initialize()
+     */
+    lorawan_status_t get_link_stats(lorawan_link_stats_t &stats);
+
+    /** Get hold of link statistics of a channel
+     *
+     * Same as get_link_stats() for a single uplink channel. Channels are tracked
+     * up to index lora.link-stats-channels - 1.
+     *
+     * @param    channel    the uplink channel index.
+     * @param    stats      the inbound structure that will be filled with the statistics.
+     *
+     * @return              LORAWAN_STATUS_OK on success, otherwise other negative error code:
+     *                      LORAWAN_STATUS_NOT_INITIALIZED if system is not initialized with initialize(),
+     *                      LORAWAN_STATUS_PARAMETER_INVALID if the channel is not tracked
+     */
+    lorawan_status_t get_channel_stats(uint8_t channel, lorawan_link_stats_t &stats);
+
+    /** Clear link statistics
+     *
+     * @return              LORAWAN_STATUS_OK on success, otherwise other negative error code:
+     *                      LORAWAN_STATUS_NOT_INITIALIZED if system is not initialized with initialize()
+     */
+    lorawan_status_t reset_link_stats();
+
     /** Cancel outgoing transmission
      *
      * This API is used to cancel any outstanding transmission in the TX pipe.
@@ -525,6 +648,7 @@ public:
      * the system can cancel the outstanding outgoing packet. Otherwise, the system is
      * busy sending and can't be held back. The system will not try to resend if the
      * outgoing message was a CONFIRMED message even if the ack is not received.
+     * Messages queued with send_aggregated() are discarded along with the frame.
      *
      * @return              LORAWAN_STATUS_OK if the sending is canceled, otherwise
      *                      other negative error code if request failed:
@@ -33,6 +33,23 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "mbed-trace/mbed_trace.h"
 #define TRACE_GROUP "LSTK"
 
+#if MBED_CONF_LORA_SESSION_PERSISTENCE
+#include "kvstore_global_api.h"
+#include "mbed_error.h"
+
+#define LSTK_STR_EXPAND(tok) #tok
+#define LSTK_STR(tok) LSTK_STR_EXPAND(tok)
+#define SESSION_KEY "/" LSTK_STR(MBED_CONF_STORAGE_DEFAULT_KV) "/lora_session"
+
+const uint16_t SESSION_VERSION = 1;
+
+// session kept over resets
+struct stored_session_t {
+    uint16_t version;
+    loramac_session_t session;
+};
+#endif // MBED_CONF_LORA_SESSION_PERSISTENCE
+
 #define INVALID_PORT                0xFF
 #define MAX_CONFIRMED_MSG_RETRIES   255
 #define COMPLIANCE_TESTING_PORT     224
@@ -46,6 +63,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #define USING_OTAA_FLAG             0x00000008
 #define TX_DONE_FLAG                0x00000010
 #define CONN_IN_PROGRESS_FLAG       0x00000020
+#define SESSION_STORED_FLAG         0x00000040
 
 using namespace mbed;
 using namespace events;
@@ -73,7 +91,21 @@ LoRaWANStack::LoRaWANStack()
       _app_port(INVALID_PORT),
       _link_check_requested(false),
       _automatic_uplink_ongoing(false),
-      _queue(NULL)
+      _queue(NULL),
+      _aggr_len(0),
+      _aggr_frame_len(0),
+      _aggr_count(0),
+      _aggr_frame_count(0),
+      _aggr_port(INVALID_PORT),
+      _aggr_flags(0),
+      _aggr_on_air(false),
+      _aggr_queued_time(0),
+      _aggr_frame_time(0),
+      _aggr_tx_time(0),
+      _aggr_stats()
+#if MBED_CONF_LORA_SESSION_PERSISTENCE
+    , _stored_session()
+#endif
 {
     _tx_metadata.stale = true;
     _rx_metadata.stale = true;
@@ -267,12 +299,38 @@ lorawan_status_t LoRaWANStack::enable_adaptive_datarate(bool adr_enabled)
     return LORAWAN_STATUS_OK;
 }
 
+lorawan_status_t LoRaWANStack::enable_device_adr(bool adr_enabled)
+{
+    if (_device_current_state == DEVICE_STATE_NOT_INITIALIZED) {
+        return LORAWAN_STATUS_NOT_INITIALIZED;
+    }
+
+    _loramac.enable_device_adr(adr_enabled);
+    return LORAWAN_STATUS_OK;
+}
+
 lorawan_status_t LoRaWANStack::stop_sending(void)
 {
     if (_device_current_state == DEVICE_STATE_NOT_INITIALIZED) {
         return LORAWAN_STATUS_NOT_INITIALIZED;
     }
 
+    lorawan_status_t status = cancel_tx();
+
+    if (status == LORAWAN_STATUS_OK && _aggr_count > 0) {
+        // the application gives up the aggregated messages too
+        _aggr_stats.dropped += _aggr_count;
+        _aggr_len = 0;
+        _aggr_frame_len = 0;
+        _aggr_count = 0;
+        _aggr_frame_count = 0;
+    }
+
+    return status;
+}
+
+lorawan_status_t LoRaWANStack::cancel_tx(void)
+{
     lorawan_status_t status = _loramac.clear_tx_pipe();
 
     if (status == LORAWAN_STATUS_OK) {
@@ -347,6 +405,91 @@ int16_t LoRaWANStack::handle_tx(const uint8_t port, const uint8_t *data,
     return (status == LORAWAN_STATUS_OK) ? len : (int16_t) status;
 }
 
+int16_t LoRaWANStack::send_aggregated(const uint8_t port, const uint8_t *data,
+                                      uint16_t length, uint8_t flags)
+{
+    if (_device_current_state == DEVICE_STATE_NOT_INITIALIZED) {
+        return LORAWAN_STATUS_NOT_INITIALIZED;
+    }
+
+    if (!data || length == 0) {
+        return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    if (!_lw_session.active) {
+        return LORAWAN_STATUS_NO_ACTIVE_SESSIONS;
+    }
+
+    if (!is_port_valid(port)) {
+        return LORAWAN_STATUS_PORT_INVALID;
+    }
+
+    // Proprietary frames have no port telling the receiver how to split them
+    if (flags != MSG_UNCONFIRMED_FLAG && flags != MSG_CONFIRMED_FLAG) {
+        return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    if (_aggr_count > 0 && (port != _aggr_port || flags != _aggr_flags)) {
+        return LORAWAN_STATUS_WOULD_BLOCK;
+    }
+
+    const uint16_t record_len = length + 1;
+    const uint8_t max_size = _loramac.get_max_tx_payload_size();
+
+    if (record_len > max_size) {
+        return LORAWAN_STATUS_LENGTH_ERROR;
+    }
+
+    // A frame still waiting for its duty cycle backoff can be taken back and
+    // grown, it will not leave any later than it would have.
+    if (_aggr_frame_len > 0 && !_aggr_on_air
+            && _aggr_len + record_len <= max_size
+            && cancel_tx() == LORAWAN_STATUS_OK) {
+        tr_debug("Aggregated frame cancelled to append %d bytes", length);
+        _aggr_frame_len = 0;
+        _aggr_frame_count = 0;
+        _aggr_queued_time = _aggr_frame_time;
+    }
+
+    if (_aggr_len - _aggr_frame_len + record_len > max_size
+            || _aggr_len + record_len > sizeof(_aggr_buffer)) {
+        return LORAWAN_STATUS_WOULD_BLOCK;
+    }
+
+    if (_aggr_len == _aggr_frame_len) {
+        _aggr_queued_time = _loramac.get_current_time();
+    }
+
+    _aggr_buffer[_aggr_len] = length;
+    memcpy(_aggr_buffer + _aggr_len + 1, data, length);
+    _aggr_len += record_len;
+    _aggr_count++;
+    _aggr_port = port;
+    _aggr_flags = flags;
+
+    if (_aggr_frame_len == 0) {
+        lorawan_status_t status = submit_aggregated_tx();
+        if (status != LORAWAN_STATUS_OK && status != LORAWAN_STATUS_WOULD_BLOCK
+                && status != LORAWAN_STATUS_BUSY) {
+            _aggr_len -= record_len;
+            _aggr_count--;
+            return status;
+        }
+    }
+
+    return length;
+}
+
+lorawan_status_t LoRaWANStack::acquire_aggregation_stats(lorawan_aggregation_stats_t &stats)
+{
+    if (_device_current_state == DEVICE_STATE_NOT_INITIALIZED) {
+        return LORAWAN_STATUS_NOT_INITIALIZED;
+    }
+
+    stats = _aggr_stats;
+    return LORAWAN_STATUS_OK;
+}
+
 int16_t LoRaWANStack::handle_rx(uint8_t *data, uint16_t length, uint8_t &port, int &flags, bool validate_params)
 {
     if (_device_current_state == DEVICE_STATE_NOT_INITIALIZED) {
@@ -505,12 +648,42 @@ lorawan_status_t LoRaWANStack::acquire_backoff_metadata(int &backoff)
     return LORAWAN_STATUS_METADATA_NOT_AVAILABLE;
 }
 
+lorawan_status_t LoRaWANStack::acquire_link_stats(lorawan_link_stats_t &stats)
+{
+    if (DEVICE_STATE_NOT_INITIALIZED == _device_current_state) {
+        return LORAWAN_STATUS_NOT_INITIALIZED;
+    }
+
+    _loramac.get_link_stats(stats);
+    return LORAWAN_STATUS_OK;
+}
+
+lorawan_status_t LoRaWANStack::acquire_channel_stats(uint8_t channel, lorawan_link_stats_t &stats)
+{
+    if (DEVICE_STATE_NOT_INITIALIZED == _device_current_state) {
+        return LORAWAN_STATUS_NOT_INITIALIZED;
+    }
+
+    return _loramac.get_channel_stats(channel, stats);
+}
+
+lorawan_status_t LoRaWANStack::reset_link_stats(void)
+{
+    if (DEVICE_STATE_NOT_INITIALIZED == _device_current_state) {
+        return LORAWAN_STATUS_NOT_INITIALIZED;
+    }
+
+    _loramac.reset_link_stats();
+    return LORAWAN_STATUS_OK;
+}
+
 /*****************************************************************************
  * Interrupt handlers                                                        *
  ****************************************************************************/
 void LoRaWANStack::tx_interrupt_handler(void)
 {
     _tx_timestamp = _loramac.get_current_time();
+    _loramac.arm_rx_windows(_tx_timestamp);
     const int ret = _queue->call(this, &LoRaWANStack::process_transmission);
     MBED_ASSERT(ret != 0);
     (void)ret;
@@ -534,8 +707,9 @@ void LoRaWANStack::rx_interrupt_handler(const uint8_t *payload, uint16_t size,
 
 void LoRaWANStack::rx_error_interrupt_handler(void)
 {
+    const rx_slot_t slot = _loramac.on_radio_rx_window_closed();
     const int ret = _queue->call(this, &LoRaWANStack::process_reception_timeout,
-                                 false);
+                                 false, slot);
     MBED_ASSERT(ret != 0);
     (void)ret;
 }
@@ -549,8 +723,9 @@ void LoRaWANStack::tx_timeout_interrupt_handler(void)
 
 void LoRaWANStack::rx_timeout_interrupt_handler(void)
 {
+    const rx_slot_t slot = _loramac.on_radio_rx_window_closed();
     const int ret = _queue->call(this, &LoRaWANStack::process_reception_timeout,
-                                 true);
+                                 true, slot);
     MBED_ASSERT(ret != 0);
     (void)ret;
 }
@@ -588,9 +763,87 @@ void LoRaWANStack::process_transmission(void)
         }
     }
 
+    if (_aggr_frame_len > 0 && !_aggr_on_air) {
+        _aggr_on_air = true;
+        _aggr_tx_time = _tx_timestamp;
+    }
+
     _loramac.on_radio_tx_done(_tx_timestamp);
 }
 
+lorawan_status_t LoRaWANStack::submit_aggregated_tx()
+{
+    // Take whole messages only. The capacity may have dropped since they were
+    // queued, if the data rate went down or MAC commands are pending.
+    const uint8_t max_size = _loramac.get_max_tx_payload_size();
+    uint16_t frame_len = 0;
+    uint8_t frame_count = 0;
+
+    while (frame_len < _aggr_len
+            && frame_len + 1 + _aggr_buffer[frame_len] <= max_size) {
+        frame_len += 1 + _aggr_buffer[frame_len];
+        frame_count++;
+    }
+
+    if (frame_count == 0) {
+        tr_error("Aggregated message of %d bytes does not fit, dropped",
+                 _aggr_buffer[0]);
+        frame_len = 1 + _aggr_buffer[0];
+        _aggr_len -= frame_len;
+        _aggr_count--;
+        _aggr_stats.dropped++;
+        memmove(_aggr_buffer, _aggr_buffer + frame_len, _aggr_len);
+        return LORAWAN_STATUS_LENGTH_ERROR;
+    }
+
+    int16_t ret = handle_tx(_aggr_port, _aggr_buffer, frame_len, _aggr_flags);
+    if (ret < 0) {
+        return (lorawan_status_t) ret;
+    }
+
+    _aggr_frame_len = frame_len;
+    _aggr_frame_count = frame_count;
+    _aggr_frame_time = _aggr_queued_time;
+    _aggr_on_air = false;
+
+    return LORAWAN_STATUS_OK;
+}
+
+void LoRaWANStack::resume_aggregated_tx()
+{
+    Lock lock(*this);
+
+    if (_aggr_frame_len == 0 && _aggr_len > 0 && !_loramac.tx_ongoing()) {
+        lorawan_status_t status = submit_aggregated_tx();
+        if (status != LORAWAN_STATUS_OK) {
+            tr_error("Aggregated frame not sent: %d", status);
+        }
+    }
+}
+
+void LoRaWANStack::complete_aggregated_tx(bool delivered)
+{
+    if (delivered && _aggr_on_air) {
+        const uint32_t latency = _aggr_tx_time - _aggr_frame_time;
+        _aggr_stats.uplinks++;
+        _aggr_stats.messages += _aggr_frame_count;
+        _aggr_stats.bytes += _aggr_frame_len - _aggr_frame_count;
+        _aggr_stats.last_latency = latency;
+        if (latency > _aggr_stats.max_latency) {
+            _aggr_stats.max_latency = latency;
+        }
+    } else {
+        _aggr_stats.dropped += _aggr_frame_count;
+    }
+
+    _aggr_len -= _aggr_frame_len;
+    _aggr_count -= _aggr_frame_count;
+    memmove(_aggr_buffer, _aggr_buffer + _aggr_frame_len, _aggr_len);
+    _aggr_frame_len = 0;
+    _aggr_frame_count = 0;
+    _aggr_on_air = false;
+}
+
 void LoRaWANStack::post_process_tx_with_reception()
 {
     if (_loramac.get_mcps_confirmation()->req_type == MCPS_CONFIRMED) {
@@ -746,14 +999,12 @@ void LoRaWANStack::process_reception(const uint8_t *const payload, uint16_t size
     core_util_atomic_flag_clear(&_rx_payload_in_use);
 }
 
-void LoRaWANStack::process_reception_timeout(bool is_timeout)
+void LoRaWANStack::process_reception_timeout(bool is_timeout, rx_slot_t slot)
 {
-    rx_slot_t slot = _loramac.get_current_slot();
-
     // when is_timeout == false, a CRC error took place in the received frame
     // we treat that erroneous frame as no frame received at all, hence handle
     // it exactly as we would handle timeout
-    _loramac.on_radio_rx_timeout(is_timeout);
+    _loramac.on_radio_rx_timeout(is_timeout, slot);
 
     if (slot == RX_SLOT_WIN_2 && !_loramac.nwk_joined()) {
         state_controller(DEVICE_STATE_JOINING);
@@ -891,7 +1142,13 @@ lorawan_status_t LoRaWANStack::handle_connect(bool is_otaa)
 {
     _ctrl_flags |= CONN_IN_PROGRESS_FLAG;
 
-    if (is_otaa) {
+    if (is_otaa && restore_session()) {
+        // Connects like ABP with the keys and counters of the stored session
+        tr_debug("Resuming stored session");
+        tr_debug("Frame Counters. UpCnt=%lu, DownCnt=%lu",
+                 _lw_session.uplink_counter, _lw_session.downlink_counter);
+        _ctrl_flags &= ~USING_OTAA_FLAG;
+    } else if (is_otaa) {
         tr_debug("Initiating OTAA");
 
         // In 1.0.2 spec, counters are always set to zero for new connection.
@@ -919,6 +1176,94 @@ lorawan_status_t LoRaWANStack::handle_connect(bool is_otaa)
     return state_controller(DEVICE_STATE_CONNECTING);
 }
 
+bool LoRaWANStack::restore_session()
+{
+#if MBED_CONF_LORA_SESSION_PERSISTENCE
+    stored_session_t stored;
+    size_t size = 0;
+    if (kv_get(SESSION_KEY, &stored, sizeof(stored), &size) != MBED_SUCCESS || size != sizeof(stored) ||
+            stored.version != SESSION_VERSION) {
+        return false;
+    }
+
+    // not resumed if joined with other EUIs
+    if (_loramac.restore_session(stored.session) != LORAWAN_STATUS_OK) {
+        tr_debug("Stored session not usable");
+        return false;
+    }
+
+    _stored_session = stored.session;
+    _lw_session.uplink_counter = stored.session.ul_frame_counter;
+    _lw_session.downlink_counter = stored.session.dl_frame_counter;
+
+    // Frames may be sent up to the stored uplink counter, which must not be
+    // used again after another reset
+    _ctrl_flags |= SESSION_STORED_FLAG;
+    save_session(true);
+    return true;
+#else
+    return false;
+#endif // MBED_CONF_LORA_SESSION_PERSISTENCE
+}
+
+void LoRaWANStack::save_session(bool force)
+{
+#if MBED_CONF_LORA_SESSION_PERSISTENCE
+    if (!(_ctrl_flags & SESSION_STORED_FLAG)) {
+        return;
+    }
+
+    stored_session_t stored;
+    memset(&stored, 0, sizeof(stored));
+    stored.version = SESSION_VERSION;
+    loramac_session_t &session = stored.session;
+    _loramac.get_session(session);
+
+    const uint32_t ul_frame_counter = session.ul_frame_counter;
+    const uint32_t dl_frame_counter = session.dl_frame_counter;
+
+    // Counters are written once they have advanced by a step, anything else
+    // as soon as it changes
+    if (!force && ul_frame_counter < _stored_session.ul_frame_counter &&
+            dl_frame_counter - _stored_session.dl_frame_counter < MBED_CONF_LORA_SESSION_COUNTER_STEP) {
+        session.ul_frame_counter = _stored_session.ul_frame_counter;
+        session.dl_frame_counter = _stored_session.dl_frame_counter;
+        if (memcmp(&session, &_stored_session, sizeof(session)) == 0) {
+            return;
+        }
+        session.dl_frame_counter = dl_frame_counter;
+    }
+
+    // A reset resumes from the stored uplink counter, never below a used one
+    session.ul_frame_counter = ul_frame_counter + MBED_CONF_LORA_SESSION_COUNTER_STEP;
+
+    if (kv_set(SESSION_KEY, &stored, sizeof(stored), 0) != MBED_SUCCESS) {
+        tr_warn("Failed to store the session");
+        return;
+    }
+    _stored_session = session;
+#else
+    (void)force;
+#endif // MBED_CONF_LORA_SESSION_PERSISTENCE
+}
+
+lorawan_status_t LoRaWANStack::forget_session()
+{
+#if MBED_CONF_LORA_SESSION_PERSISTENCE
+    _ctrl_flags &= ~SESSION_STORED_FLAG;
+
+    int ret = kv_remove(SESSION_KEY);
+    if (ret != MBED_SUCCESS && ret != MBED_ERROR_ITEM_NOT_FOUND) {
+        tr_warn("Failed to remove the stored session");
+        return LORAWAN_STATUS_NO_OP;
+    }
+
+    return LORAWAN_STATUS_OK;
+#else
+    return LORAWAN_STATUS_UNSUPPORTED;
+#endif // MBED_CONF_LORA_SESSION_PERSISTENCE
+}
+
 void LoRaWANStack::mlme_indication_handler()
 {
     if (_loramac.get_mlme_indication()->indication_type == MLME_SCHEDULE_UPLINK) {
@@ -960,6 +1305,8 @@ void LoRaWANStack::mlme_confirm_handler()
 
         switch (_loramac.get_mlme_confirmation()->status) {
             case LORAMAC_EVENT_INFO_STATUS_OK:
+                _ctrl_flags |= SESSION_STORED_FLAG;
+                save_session(true);
                 state_controller(DEVICE_STATE_CONNECTED);
                 break;
 
@@ -987,6 +1334,13 @@ void LoRaWANStack::mlme_confirm_handler()
 
 void LoRaWANStack::mcps_confirm_handler()
 {
+    if (_aggr_frame_len > 0) {
+        complete_aggregated_tx(_loramac.get_mcps_confirmation()->status
+                               == LORAMAC_EVENT_INFO_STATUS_OK);
+    }
+
+    save_session();
+
     switch (_loramac.get_mcps_confirmation()->status) {
 
         case LORAMAC_EVENT_INFO_STATUS_OK:
@@ -1019,6 +1373,7 @@ void LoRaWANStack::mcps_indication_handler()
     }
 
     _lw_session.downlink_counter = mcps_indication->dl_frame_counter;
+    save_session();
 
     /**
      * Check port, if it's compliance testing port and the compliance testing is
@@ -1126,6 +1481,11 @@ void LoRaWANStack::process_shutdown_state(lorawan_status_t &op_status)
     _device_current_state = DEVICE_STATE_SHUTDOWN;
     op_status = LORAWAN_STATUS_DEVICE_OFF;
     _ctrl_flags = 0;
+    _aggr_stats.dropped += _aggr_count;
+    _aggr_len = 0;
+    _aggr_frame_len = 0;
+    _aggr_count = 0;
+    _aggr_frame_count = 0;
     send_event_to_application(DISCONNECTED);
 }
 
@@ -1167,6 +1527,13 @@ void LoRaWANStack::process_status_check_state()
             mcps_indication_handler();
         }
     }
+
+    // Aggregated messages waiting for the end of this TX cycle
+    if (_aggr_frame_len == 0 && _aggr_len > 0 && !_loramac.tx_ongoing()) {
+        const int ret = _queue->call(this, &LoRaWANStack::resume_aggregated_tx);
+        MBED_ASSERT(ret != 0);
+        (void)ret;
+    }
 }
 
 void LoRaWANStack::process_scheduling_state(lorawan_status_t &op_status)
@@ -202,6 +202,15 @@ public:
      */
     lorawan_status_t enable_adaptive_datarate(bool adr_enabled);
 
+    /** Enables device side ADR.
+     *
+     * @param adr_enabled       0 policy disabled, 1 policy enabled.
+     *
+     * @return                  LORAWAN_STATUS_OK on success, a negative error
+     *                          code on failure.
+     */
+    lorawan_status_t enable_device_adr(bool adr_enabled);
+
     /** Send message to gateway
      *
      * @param port              The application port number. Port numbers 0 and 224
@@ -244,6 +253,28 @@ public:
                       uint16_t length, uint8_t flags,
                       bool null_allowed = false, bool allow_port_0 = false);
 
+    /** Queue a message to be sent aggregated with others
+     *
+     * The message is appended, prefixed with its length byte, to the frame
+     * being built for the port. The frame is handed to the MAC as soon as the
+     * MAC is free, and is transmitted at the earliest time the duty cycle
+     * allows. Messages queued while the frame waits for its backoff are merged
+     * into it, others are sent in the next frame.
+     *
+     * @param port              The application port number.
+     * @param data              A pointer to the data being sent. The data is
+     *                          copied to the internal buffers.
+     * @param length            The size of data in bytes.
+     * @param flags             MSG_UNCONFIRMED_FLAG or MSG_CONFIRMED_FLAG.
+     *
+     * @return                  The number of bytes queued, or
+     *                          LORAWAN_STATUS_WOULD_BLOCK if the next frame is
+     *                          full or built for another port or type, or a
+     *                          negative error code on failure.
+     */
+    int16_t send_aggregated(uint8_t port, const uint8_t *data,
+                            uint16_t length, uint8_t flags);
+
     /** Receives a message from the Network Server.
      *
      * @param data              A pointer to buffer where the received data will be
@@ -374,6 +405,46 @@ public:
      */
     lorawan_status_t acquire_backoff_metadata(int &backoff);
 
+    /** Acquire link statistics
+     *
+     * @param    stats       A reference to the inbound structure which will be
+     *                       filled with the statistics of all channels.
+     *
+     * @return               LORAWAN_STATUS_OK if successful,
+     *                       LORAWAN_STATUS_NOT_INITIALIZED otherwise
+     */
+    lorawan_status_t acquire_link_stats(lorawan_link_stats_t &stats);
+
+    /** Acquire link statistics of a channel
+     *
+     * @param    channel     Uplink channel index.
+     * @param    stats       A reference to the inbound structure which will be
+     *                       filled with the statistics of the channel.
+     *
+     * @return               LORAWAN_STATUS_OK if successful,
+     *                       LORAWAN_STATUS_PARAMETER_INVALID if the channel
+     *                       is not tracked, LORAWAN_STATUS_NOT_INITIALIZED
+     *                       otherwise
+     */
+    lorawan_status_t acquire_channel_stats(uint8_t channel, lorawan_link_stats_t &stats);
+
+    /** Clear link statistics
+     *
+     * @return               LORAWAN_STATUS_OK if successful,
+     *                       LORAWAN_STATUS_NOT_INITIALIZED otherwise
+     */
+    lorawan_status_t reset_link_stats(void);
+
+    /** Acquire statistics of the aggregated uplinks
+     *
+     * @param    stats       A reference to the inbound structure which will be
+     *                       filled with the statistics.
+     *
+     * @return               LORAWAN_STATUS_OK if successful,
+     *                       LORAWAN_STATUS_NOT_INITIALIZED otherwise
+     */
+    lorawan_status_t acquire_aggregation_stats(lorawan_aggregation_stats_t &stats);
+
     /** Stops sending
      *
      * Stop sending any outstanding messages if they are not yet queued for
@@ -384,6 +455,19 @@ public:
      */
     lorawan_status_t stop_sending(void);
 
+    /** Forgets the stored session
+     *
+     * The next connect() joins again instead of resuming the session stored
+     * after the last OTAA join. The current session, if any, is not stored
+     * anymore.
+     *
+     * @return               LORAWAN_STATUS_OK if no session is stored anymore,
+     *                       LORAWAN_STATUS_UNSUPPORTED if lora.session-persistence
+     *                       is not enabled, LORAWAN_STATUS_NO_OP if the
+     *                       session could not be removed
+     */
+    lorawan_status_t forget_session(void);
+
     void lock(void)
     {
         _loramac.lock();
@@ -448,6 +532,17 @@ private:
      */
     lorawan_status_t handle_connect(bool is_otaa);
 
+    /**
+     * Resumes the session stored after an OTAA join, returns true if resumed
+     */
+    bool restore_session(void);
+
+    /**
+     * Stores the session if it has changed, the frame counters only once they
+     * have advanced by lora.session-counter-step
+     */
+    void save_session(bool force = false);
+
 
     /** Send event to application.
      *
@@ -480,7 +575,7 @@ private:
     void rx_error_interrupt_handler(void);
     void process_reception(const uint8_t *payload, uint16_t size, int16_t rssi,
                            int8_t snr);
-    void process_reception_timeout(bool is_timeout);
+    void process_reception_timeout(bool is_timeout, rx_slot_t slot);
 
     int convert_to_msg_flag(const mcps_type_t type);
 
@@ -492,6 +587,12 @@ private:
     void post_process_tx_with_reception(void);
     void post_process_tx_no_reception(void);
 
+    lorawan_status_t cancel_tx(void);
+
+    lorawan_status_t submit_aggregated_tx(void);
+    void resume_aggregated_tx(void);
+    void complete_aggregated_tx(bool delivered);
+
 private:
     LoRaMac _loramac;
     radio_events_t radio_events;
@@ -512,6 +613,30 @@ private:
     uint8_t _rx_payload[LORAMAC_PHY_MAXPAYLOAD];
     events::EventQueue *_queue;
     lorawan_time_t _tx_timestamp;
+
+    /**
+     * Messages queued by send_aggregated(), each prefixed with its length.
+     * The first _aggr_frame_len bytes are the frame handed to the MAC.
+     */
+    uint8_t _aggr_buffer[MBED_CONF_LORA_TX_MAX_SIZE];
+    uint16_t _aggr_len;
+    uint16_t _aggr_frame_len;
+    uint8_t _aggr_count;
+    uint8_t _aggr_frame_count;
+    uint8_t _aggr_port;
+    uint8_t _aggr_flags;
+    bool _aggr_on_air;
+    lorawan_time_t _aggr_queued_time;
+    lorawan_time_t _aggr_frame_time;
+    lorawan_time_t _aggr_tx_time;
+    lorawan_aggregation_stats_t _aggr_stats;
+
+#if MBED_CONF_LORA_SESSION_PERSISTENCE
+    /**
+     * Session as last stored, the uplink counter is the one it resumes from
+     */
+    loramac_session_t _stored_session;
+#endif
 };
 
 #endif /* LORAWANSTACK_H_ */
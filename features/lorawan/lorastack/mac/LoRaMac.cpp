@@ -70,6 +70,7 @@ LoRaMac::LoRaMac()
       _lora_phy(NULL),
       _mac_commands(),
       _channel_plan(),
+      _link_stats(),
       _lora_crypto(),
       _ev_queue(NULL),
       _mcps_indication(),
@@ -81,7 +82,8 @@ LoRaMac::LoRaMac()
       _continuous_rx2_window_open(false),
       _device_class(CLASS_A),
       _prev_qos_level(LORAWAN_DEFAULT_QOS),
-      _demod_ongoing(false)
+      _demod_ongoing(false),
+      _rx_windows_armed(false)
 {
     memset(&_params, 0, sizeof(_params));
     _params.keys.dev_eui = NULL;
@@ -157,6 +159,20 @@ void LoRaMac::post_process_mlme_request()
 
 void LoRaMac::post_process_mcps_req()
 {
+    _link_stats.on_uplink_done(_mcps_confirmation.channel,
+                               _mcps_confirmation.req_type == MCPS_CONFIRMED,
+                               _mcps_confirmation.ack_received);
+
+    if (!_params.sys_params.adr_on && _link_stats.adr_policy_enabled()) {
+        int8_t datarate = _params.sys_params.channel_data_rate;
+        int8_t tx_power = _params.sys_params.channel_tx_power;
+        if (_link_stats.get_next_ADR(datarate, tx_power)) {
+            tr_debug("Device ADR: DR %d, TX power %d", datarate, tx_power);
+            _params.sys_params.channel_data_rate = datarate;
+            _params.sys_params.channel_tx_power = tx_power;
+        }
+    }
+
     _params.is_last_tx_join_request = false;
     _mcps_confirmation.status = LORAMAC_EVENT_INFO_STATUS_OK;
     if (_mcps_confirmation.req_type == MCPS_CONFIRMED) {
@@ -237,6 +253,8 @@ void LoRaMac::handle_join_accept_frame(const uint8_t *payload, uint16_t size)
 
     if (mic_rx == mic) {
         _lora_time.stop(_params.timers.rx_window2_timer);
+        // Expanded schedules of the previous session keys are not needed anymore
+        _lora_crypto.clear_keys();
         if (_lora_crypto.compute_skeys_for_join_frame(_params.keys.app_key,
                                                       APPKEY_KEY_LENGTH,
                                                       _params.rx_buffer + 1,
@@ -529,6 +547,11 @@ void LoRaMac::handle_data_frame(const uint8_t *const payload,
     _mcps_indication.rssi = rssi;
     _mcps_indication.snr = snr;
 
+    if (!is_multicast) {
+        _link_stats.on_downlink(_params.channel, _mcps_indication.rx_datarate,
+                                rssi, snr);
+    }
+
     _mcps_confirmation.status = LORAMAC_EVENT_INFO_STATUS_OK;
 
     _params.adr_ack_counter = 0;
@@ -644,13 +667,31 @@ void LoRaMac::set_batterylevel_callback(mbed::Callback<uint8_t(void)> battery_le
     _mac_commands.set_batterylevel_callback(battery_level);
 }
 
+void LoRaMac::arm_rx_windows(lorawan_time_t timestamp)
+{
+    if (_device_class == CLASS_C || !_params.is_rx_window_enabled) {
+        return;
+    }
+
+    lorawan_time_t time_diff = _lora_time.get_current_time() - timestamp;
+    _lora_time.start(_params.timers.rx_window1_timer,
+                     _params.rx_window1_delay - time_diff);
+    _lora_time.start(_params.timers.rx_window2_timer,
+                     _params.rx_window2_delay - time_diff);
+    _rx_windows_armed = true;
+}
+
 void LoRaMac::on_radio_tx_done(lorawan_time_t timestamp)
 {
     if (_device_class == CLASS_C) {
         // this will open a continuous RX2 window until time==RECV_DELAY1
         open_rx2_window();
     } else {
-        _lora_phy->put_radio_to_sleep();
+        Lock lock(*this);
+        // RX1 may already be open if the windows were armed from the interrupt
+        if (!_rx_windows_armed || _params.timers.rx_window1_timer.timer_id != 0) {
+            _lora_phy->put_radio_to_sleep();
+        }
     }
 
     if ((_mcps_confirmation.req_type == MCPS_UNCONFIRMED)
@@ -661,13 +702,16 @@ void LoRaMac::on_radio_tx_done(lorawan_time_t timestamp)
 
     if (_params.is_rx_window_enabled == true) {
         lorawan_time_t time_diff = _lora_time.get_current_time() - timestamp;
-        // start timer after which rx1_window will get opened
-        _lora_time.start(_params.timers.rx_window1_timer,
-                         _params.rx_window1_delay - time_diff);
-
-        // start timer after which rx2_window will get opened
-        _lora_time.start(_params.timers.rx_window2_timer,
-                         _params.rx_window2_delay - time_diff);
+        if (!_rx_windows_armed) {
+            // start timer after which rx1_window will get opened
+            _lora_time.start(_params.timers.rx_window1_timer,
+                             _params.rx_window1_delay - time_diff);
+
+            // start timer after which rx2_window will get opened
+            _lora_time.start(_params.timers.rx_window2_timer,
+                             _params.rx_window2_delay - time_diff);
+        }
+        _rx_windows_armed = false;
 
         // If class C and an Unconfirmed messgae is outgoing,
         // this will start a timer which will invoke rx2 would be
@@ -692,6 +736,8 @@ void LoRaMac::on_radio_tx_done(lorawan_time_t timestamp)
 
     _params.last_channel_idx = _params.channel;
 
+    _link_stats.on_frame_sent(_params.channel, _params.timers.tx_toa);
+
     _lora_phy->set_last_tx_done(_params.channel, _is_nwk_joined, timestamp);
 
     _params.timers.aggregated_last_tx_time = timestamp;
@@ -748,6 +794,7 @@ void LoRaMac::on_radio_tx_timeout(void)
     _lora_time.stop(_params.timers.rx_window2_timer);
     _lora_time.stop(_rx2_closure_timer_for_class_c);
     _lora_time.stop(_params.timers.ack_timeout_timer);
+    _rx_windows_armed = false;
 
     if (_device_class == CLASS_C) {
         open_rx2_window();
@@ -770,14 +817,21 @@ void LoRaMac::on_radio_tx_timeout(void)
     _mcps_confirmation.tx_toa = 0;
 }
 
-void LoRaMac::on_radio_rx_timeout(bool is_timeout)
+rx_slot_t LoRaMac::on_radio_rx_window_closed(void)
+{
+    _demod_ongoing = false;
+    return _params.rx_slot;
+}
+
+void LoRaMac::on_radio_rx_timeout(bool is_timeout, rx_slot_t slot)
 {
     _demod_ongoing = false;
-    if (_device_class == CLASS_A) {
+    // Leave the radio alone if RX2 has been opened since the window timed out
+    if (_device_class == CLASS_A && slot == _params.rx_slot) {
         _lora_phy->put_radio_to_sleep();
     }
 
-    if (_params.rx_slot == RX_SLOT_WIN_1) {
+    if (slot == RX_SLOT_WIN_1) {
         if (_params.is_node_ack_requested == true) {
             _mcps_confirmation.status = is_timeout ?
                                         LORAMAC_EVENT_INFO_STATUS_RX1_TIMEOUT :
@@ -787,7 +841,7 @@ void LoRaMac::on_radio_rx_timeout(bool is_timeout)
                                     LORAMAC_EVENT_INFO_STATUS_RX1_TIMEOUT :
                                     LORAMAC_EVENT_INFO_STATUS_RX1_ERROR;
 
-        if (_device_class != CLASS_C) {
+        if (_device_class != CLASS_C && _params.rx_slot == RX_SLOT_WIN_1) {
             if (_lora_time.get_elapsed_time(_params.timers.aggregated_last_tx_time) >= _params.rx_window2_delay) {
                 _lora_time.stop(_params.timers.rx_window2_timer);
             }
@@ -1269,6 +1323,7 @@ void LoRaMac::reset_mac_parameters(void)
     _params.last_channel_idx = _params.channel;
 
     _demod_ongoing = false;
+    _rx_windows_armed = false;
 }
 
 uint8_t LoRaMac::get_default_tx_datarate()
@@ -1279,11 +1334,37 @@ uint8_t LoRaMac::get_default_tx_datarate()
 void LoRaMac::enable_adaptive_datarate(bool adr_enabled)
 {
     _params.sys_params.adr_on = adr_enabled;
+    if (adr_enabled) {
+        _link_stats.enable_adr_policy(false);
+    }
+}
+
+void LoRaMac::enable_device_adr(bool adr_enabled)
+{
+    if (adr_enabled) {
+        _params.sys_params.adr_on = false;
+    }
+    _link_stats.enable_adr_policy(adr_enabled);
+}
+
+void LoRaMac::get_link_stats(lorawan_link_stats_t &stats)
+{
+    _link_stats.get_link_stats(stats);
+}
+
+lorawan_status_t LoRaMac::get_channel_stats(uint8_t channel, lorawan_link_stats_t &stats)
+{
+    return _link_stats.get_channel_stats(channel, stats);
+}
+
+void LoRaMac::reset_link_stats()
+{
+    _link_stats.reset();
 }
 
 lorawan_status_t LoRaMac::set_channel_data_rate(uint8_t data_rate)
 {
-    if (_params.sys_params.adr_on) {
+    if (_params.sys_params.adr_on || _link_stats.adr_policy_enabled()) {
         tr_error("Cannot set data rate. Please turn off ADR first.");
         return LORAWAN_STATUS_PARAMETER_INVALID;
     }
@@ -1503,6 +1584,7 @@ lorawan_status_t LoRaMac::prepare_join(const lorawan_connect_t *params, bool is_
             _params.net_id = params->connection_u.abp.nwk_id;
             _params.dev_addr = params->connection_u.abp.dev_addr;
 
+            _lora_crypto.clear_keys();
             memcpy(_params.keys.nwk_skey, params->connection_u.abp.nwk_skey,
                    sizeof(_params.keys.nwk_skey));
 
@@ -1802,6 +1884,7 @@ lorawan_status_t LoRaMac::initialize(EventQueue *queue,
     _rx2_closure_timer_for_class_c.timer_id = -1;
 
     _channel_plan.activate_channelplan_subsystem(_lora_phy);
+    _link_stats.activate_link_stats_subsystem(_lora_phy);
 
     _device_class = CLASS_A;
 
@@ -1826,9 +1909,9 @@ lorawan_status_t LoRaMac::initialize(EventQueue *queue,
     _lora_time.init(_params.timers.backoff_timer,
                     mbed::callback(this, &LoRaMac::on_backoff_timer_expiry));
     _lora_time.init(_params.timers.rx_window1_timer,
-                    mbed::callback(this, &LoRaMac::open_rx1_window));
+                    mbed::callback(this, &LoRaMac::open_rx1_window), true);
     _lora_time.init(_params.timers.rx_window2_timer,
-                    mbed::callback(this, &LoRaMac::open_rx2_window));
+                    mbed::callback(this, &LoRaMac::open_rx2_window), true);
     _lora_time.init(_params.timers.ack_timeout_timer,
                     mbed::callback(this, &LoRaMac::on_ack_timeout_timer_event));
 
@@ -1863,6 +1946,18 @@ void LoRaMac::disconnect()
     reset_mcps_indication();
 }
 
+uint8_t LoRaMac::get_max_tx_payload_size()
+{
+    uint8_t max_size = get_max_possible_tx_size(_mac_commands.get_mac_cmd_length()
+                                                + _mac_commands.get_repeat_commands_length());
+
+    if (max_size > MBED_CONF_LORA_TX_MAX_SIZE) {
+        max_size = MBED_CONF_LORA_TX_MAX_SIZE;
+    }
+
+    return max_size;
+}
+
 uint8_t LoRaMac::get_max_possible_tx_size(uint8_t fopts_len)
 {
     uint8_t max_possible_payload_size = 0;
@@ -1925,6 +2020,89 @@ lorawan_status_t LoRaMac::get_channel_plan(lorawan_channelplan_t &plan)
     return _channel_plan.get_plan(plan, _lora_phy->get_phy_channels());
 }
 
+void LoRaMac::get_session(loramac_session_t &session)
+{
+    memset(&session, 0, sizeof(session));
+
+    if (_params.keys.dev_eui) {
+        memcpy(session.dev_eui, _params.keys.dev_eui, sizeof(session.dev_eui));
+    }
+    if (_params.keys.app_eui) {
+        memcpy(session.app_eui, _params.keys.app_eui, sizeof(session.app_eui));
+    }
+    session.dev_addr = _params.dev_addr;
+    session.net_id = _params.net_id;
+    memcpy(session.nwk_skey, _params.keys.nwk_skey, sizeof(session.nwk_skey));
+    memcpy(session.app_skey, _params.keys.app_skey, sizeof(session.app_skey));
+    session.ul_frame_counter = _params.ul_frame_counter;
+    session.dl_frame_counter = _params.dl_frame_counter;
+    session.recv_delay1 = _params.sys_params.recv_delay1;
+    session.recv_delay2 = _params.sys_params.recv_delay2;
+    session.rx2_channel = _params.sys_params.rx2_channel;
+    session.rx1_dr_offset = _params.sys_params.rx1_dr_offset;
+    session.channel_data_rate = _params.sys_params.channel_data_rate;
+    session.channel_tx_power = _params.sys_params.channel_tx_power;
+
+    // Channels of a join accept or NewChannelReq, regions with fixed channels
+    // come back with their defaults
+    if (_lora_phy->get_max_nb_channels() <= LORA_MAX_NB_CHANNELS) {
+        lorawan_channelplan_t plan;
+        plan.nb_channels = 0;
+        plan.channels = session.channels;
+        if (get_channel_plan(plan) == LORAWAN_STATUS_OK) {
+            session.nb_channels = plan.nb_channels;
+        }
+    }
+}
+
+lorawan_status_t LoRaMac::restore_session(const loramac_session_t &session)
+{
+    if (tx_ongoing()) {
+        return LORAWAN_STATUS_BUSY;
+    }
+
+    // Only a session of the device and application being connected
+    if (!_params.keys.dev_eui || !_params.keys.app_eui
+            || memcmp(session.dev_eui, _params.keys.dev_eui, sizeof(session.dev_eui)) != 0
+            || memcmp(session.app_eui, _params.keys.app_eui, sizeof(session.app_eui)) != 0
+            || session.dev_addr == 0
+            || session.nb_channels > LORA_MAX_NB_CHANNELS
+            || !_lora_phy->verify_rx_datarate(session.rx2_channel.datarate)
+            || !_lora_phy->verify_tx_datarate(session.channel_data_rate, false)
+            || !_lora_phy->verify_tx_power(session.channel_tx_power)) {
+        return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    if (session.nb_channels > 0) {
+        lorawan_channelplan_t plan;
+        plan.nb_channels = session.nb_channels;
+        plan.channels = const_cast<loramac_channel_t *>(session.channels);
+        lorawan_status_t status = _channel_plan.set_plan(plan);
+        if (status != LORAWAN_STATUS_OK) {
+            _lora_phy->restore_default_channels();
+            return status;
+        }
+    }
+
+    _params.dev_addr = session.dev_addr;
+    _params.net_id = session.net_id;
+    _lora_crypto.clear_keys();
+    memcpy(_params.keys.nwk_skey, session.nwk_skey, sizeof(_params.keys.nwk_skey));
+    memcpy(_params.keys.app_skey, session.app_skey, sizeof(_params.keys.app_skey));
+    _params.ul_frame_counter = session.ul_frame_counter;
+    _params.dl_frame_counter = session.dl_frame_counter;
+    _params.sys_params.recv_delay1 = session.recv_delay1;
+    _params.sys_params.recv_delay2 = session.recv_delay2;
+    _params.sys_params.rx2_channel = session.rx2_channel;
+    _params.sys_params.rx1_dr_offset = session.rx1_dr_offset;
+    _params.sys_params.channel_data_rate = session.channel_data_rate;
+    _params.sys_params.channel_tx_power = session.channel_tx_power;
+
+    set_nwk_joined(true);
+
+    return LORAWAN_STATUS_OK;
+}
+
 lorawan_status_t LoRaMac::remove_single_channel(uint8_t id)
 {
     if (tx_ongoing()) {
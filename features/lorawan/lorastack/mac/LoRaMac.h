@@ -50,6 +50,7 @@
 #include "LoRaMacChannelPlan.h"
 #include "LoRaMacCommand.h"
 #include "LoRaMacCrypto.h"
+#include "LoRaMacLinkStats.h"
 #if MBED_CONF_RTOS_PRESENT
 #include "rtos/Mutex.h"
 #endif
@@ -154,6 +155,32 @@ public:
      */
     lorawan_status_t get_channel_plan(lorawan_channelplan_t &plan);
 
+    /**
+     * @brief   Gets the state of the current session.
+     *
+     * @details Provides what is needed to resume the session after a reset
+     *          with restore_session(), without joining again.
+     *
+     * @param   session [out]    Filled with the session.
+     */
+    void get_session(loramac_session_t &session);
+
+    /**
+     * @brief   Resumes a session taken with get_session().
+     *
+     * @details The device is considered joined afterwards. Must be called
+     *          after prepare_join() as that resets the MAC parameters, and
+     *          the session must have been joined with the EUIs given to it.
+     *
+     * @param   session [in]    The session to resume.
+     *
+     * @return  `lorawan_status_t` The status of the operation. The possible values are:
+     *          \ref LORAWAN_STATUS_OK
+     *          \ref LORAWAN_STATUS_BUSY
+     *          \ref LORAWAN_STATUS_PARAMETER_INVALID
+     */
+    lorawan_status_t restore_session(const loramac_session_t &session);
+
     /**
      * @brief   Remove a given channel from the active plan.
      *
@@ -232,6 +259,40 @@ public:
      */
     void enable_adaptive_datarate(bool adr_enabled);
 
+    /**
+     * @brief enable_device_adr Enables or disables the device side ADR policy.
+     *        Enabling it disables network ADR and vice versa.
+     * @param adr_enabled Flag indicating is the policy enabled or disabled.
+     */
+    void enable_device_adr(bool adr_enabled);
+
+    /**
+     * @brief get_link_stats Gets the link statistics of all channels.
+     * @param stats Filled with the statistics.
+     */
+    void get_link_stats(lorawan_link_stats_t &stats);
+
+    /**
+     * @brief get_channel_stats Gets the link statistics of an uplink channel.
+     * @param channel Uplink channel.
+     * @param stats Filled with the statistics.
+     * @return LORAWAN_STATUS_OK, or LORAWAN_STATUS_PARAMETER_INVALID if the
+     *         channel is not tracked.
+     */
+    lorawan_status_t get_channel_stats(uint8_t channel, lorawan_link_stats_t &stats);
+
+    /**
+     * @brief reset_link_stats Clears the link statistics.
+     */
+    void reset_link_stats();
+
+    /**
+     * @brief get_max_tx_payload_size Gets the largest application payload the
+     *        next data frame can carry, the pending MAC commands accounted.
+     * @return Size in bytes, at most MBED_CONF_LORA_TX_MAX_SIZE.
+     */
+    uint8_t get_max_tx_payload_size();
+
     /** Sets up the data rate.
      *
      * `set_datarate()` first verifies whether the data rate given is valid or not.
@@ -326,6 +387,17 @@ public:
      */
     lorawan_status_t join(bool is_otaa);
 
+    /**
+     * Starts the timers opening the RX windows of class A and B.
+     *
+     * Meant to be called from the TX done interrupt so that the windows are
+     * scheduled from the end of the transmission rather than from the time
+     * the deferred TX done event gets dispatched.
+     *
+     * @param timestamp Time at which the transmission ended
+     */
+    void arm_rx_windows(lorawan_time_t timestamp);
+
     /**
      * MAC operations upon successful transmission
      */
@@ -342,15 +414,25 @@ public:
      */
     void on_radio_tx_timeout(void);
 
+    /**
+     * Marks the current RX window as closed.
+     *
+     * Meant to be called from the RX timeout and error interrupts so that RX2
+     * can open on time even if the deferred timeout event is late.
+     *
+     * @return the RX slot that was closed
+     */
+    rx_slot_t on_radio_rx_window_closed(void);
+
     /**
      * MAC operations upon empty reception slots
      *
      * @param is_timeout false when radio encountered an error
      *                   true when the an RX slot went empty
-     *
-     * @return current RX slot
+     * @param slot       RX slot that went empty, as returned by
+     *                   on_radio_rx_window_closed()
      */
-    void on_radio_rx_timeout(bool is_timeout);
+    void on_radio_rx_timeout(bool is_timeout, rx_slot_t slot);
 
     /**
      * Handles retransmissions of Join requests if an Accept
@@ -630,6 +712,11 @@ private:
      */
     LoRaMacChannelPlan _channel_plan;
 
+    /**
+     * Link statistics subsystem
+     */
+    LoRaMacLinkStats _link_stats;
+
     /**
      * Crypto handling subsystem
      */
@@ -701,6 +788,8 @@ private:
     uint8_t _prev_qos_level;
 
     bool _demod_ongoing;
+
+    bool _rx_windows_armed;
 };
 
 #endif // MBED_LORAWAN_MAC_H__
@@ -25,6 +25,7 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "LoRaMacCrypto.h"
 #include "system/lorawan_data_structures.h"
@@ -34,6 +35,7 @@
 #if defined(MBEDTLS_CMAC_C) && defined(MBEDTLS_AES_C) && defined(MBEDTLS_CIPHER_C)
 
 LoRaMacCrypto::LoRaMacCrypto()
+    : _next_schedule(0)
 {
 #if defined(MBEDTLS_PLATFORM_C)
     int ret = mbedtls_platform_setup(NULL);
@@ -41,15 +43,124 @@ LoRaMacCrypto::LoRaMacCrypto()
         MBED_ASSERT(0 && "LoRaMacCrypto: Fail in mbedtls_platform_setup.");
     }
 #endif /* MBEDTLS_PLATFORM_C */
+
+    for (int i = 0; i < MBED_CONF_LORA_CRYPTO_KEY_SCHEDULES; i++) {
+        _schedules[i].used = false;
+    }
 }
 
 LoRaMacCrypto::~LoRaMacCrypto()
 {
+    clear_keys();
+
 #if defined(MBEDTLS_PLATFORM_C)
     mbedtls_platform_teardown(NULL);
 #endif /* MBEDTLS_PLATFORM_C */
 }
 
+void LoRaMacCrypto::free_schedule(key_schedule_t *schedule)
+{
+    if (schedule->used) {
+        mbedtls_aes_free(&schedule->aes_ctx);
+        mbedtls_cipher_free(&schedule->cmac_ctx);
+        memset(schedule->key, 0, sizeof(schedule->key));
+        schedule->used = false;
+    }
+}
+
+void LoRaMacCrypto::clear_keys()
+{
+    for (int i = 0; i < MBED_CONF_LORA_CRYPTO_KEY_SCHEDULES; i++) {
+        free_schedule(&_schedules[i]);
+    }
+    _next_schedule = 0;
+}
+
+LoRaMacCrypto::key_schedule_t *LoRaMacCrypto::get_schedule(const uint8_t *key, uint32_t key_length)
+{
+    uint32_t key_bytes = key_length / 8;
+
+    if (key_bytes > sizeof(_schedules[0].key)) {
+        return NULL;
+    }
+
+    for (int i = 0; i < MBED_CONF_LORA_CRYPTO_KEY_SCHEDULES; i++) {
+        key_schedule_t *schedule = &_schedules[i];
+        if (schedule->used && schedule->key_length == key_length
+                && memcmp(schedule->key, key, key_bytes) == 0) {
+            return schedule;
+        }
+    }
+
+    key_schedule_t *schedule = &_schedules[_next_schedule];
+    _next_schedule = (_next_schedule + 1) % MBED_CONF_LORA_CRYPTO_KEY_SCHEDULES;
+
+    free_schedule(schedule);
+    memcpy(schedule->key, key, key_bytes);
+    schedule->key_length = key_length;
+    schedule->aes_ready = false;
+    schedule->cmac_ready = false;
+    mbedtls_aes_init(&schedule->aes_ctx);
+    mbedtls_cipher_init(&schedule->cmac_ctx);
+    schedule->used = true;
+
+    return schedule;
+}
+
+int LoRaMacCrypto::get_aes(const uint8_t *key, uint32_t key_length, mbedtls_aes_context **ctx)
+{
+    key_schedule_t *schedule = get_schedule(key, key_length);
+    if (!schedule) {
+        return MBEDTLS_ERR_AES_INVALID_KEY_LENGTH;
+    }
+
+    if (!schedule->aes_ready) {
+        int ret = mbedtls_aes_setkey_enc(&schedule->aes_ctx, key, key_length);
+        if (0 != ret) {
+            return ret;
+        }
+        schedule->aes_ready = true;
+    }
+
+    *ctx = &schedule->aes_ctx;
+    return 0;
+}
+
+int LoRaMacCrypto::get_cmac(const uint8_t *key, uint32_t key_length, mbedtls_cipher_context_t **ctx)
+{
+    int ret = 0;
+
+    key_schedule_t *schedule = get_schedule(key, key_length);
+    if (!schedule) {
+        return MBEDTLS_ERR_CIPHER_BAD_INPUT_DATA;
+    }
+
+    if (schedule->cmac_ready) {
+        // Keeps the expanded key, only the message state is cleared
+        ret = mbedtls_cipher_cmac_reset(&schedule->cmac_ctx);
+    } else {
+        const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
+        if (NULL == cipher_info) {
+            return MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+        }
+
+        ret = mbedtls_cipher_setup(&schedule->cmac_ctx, cipher_info);
+        if (0 == ret) {
+            ret = mbedtls_cipher_cmac_starts(&schedule->cmac_ctx, key, key_length);
+        }
+        if (0 != ret) {
+            // Set up again from scratch next time
+            mbedtls_cipher_free(&schedule->cmac_ctx);
+            mbedtls_cipher_init(&schedule->cmac_ctx);
+            return ret;
+        }
+        schedule->cmac_ready = true;
+    }
+
+    *ctx = &schedule->cmac_ctx;
+    return ret;
+}
+
 int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
                                const uint8_t *key, const uint32_t key_length,
                                uint32_t address, uint8_t dir, uint32_t seq_counter,
@@ -57,6 +168,7 @@ int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
 {
     uint8_t computed_mic[16] = {};
     uint8_t mic_block_b0[16] = {};
+    mbedtls_cipher_context_t *cmac_ctx;
     int ret = 0;
 
     mic_block_b0[0] = 0x49;
@@ -75,46 +187,30 @@ int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
 
     mic_block_b0[15] = size & 0xFF;
 
-    mbedtls_cipher_init(aes_cmac_ctx);
-
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
-
-    if (NULL != cipher_info) {
-        ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, key_length);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, mic_block_b0, sizeof(mic_block_b0));
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = get_cmac(key, key_length, &cmac_ctx);
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(cmac_ctx, mic_block_b0, sizeof(mic_block_b0));
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(cmac_ctx, buffer, size & 0xFF);
+    if (0 != ret) {
+        return ret;
+    }
 
-        *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
-                          | (uint32_t) computed_mic[2] << 16
-                          | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
-    } else {
-        ret = MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    ret = mbedtls_cipher_cmac_finish(cmac_ctx, computed_mic);
+    if (0 != ret) {
+        return ret;
     }
 
-exit:
-    mbedtls_cipher_free(aes_cmac_ctx);
-    return ret;
+    *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
+                      | (uint32_t) computed_mic[2] << 16
+                      | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
+    return 0;
 }
 
 int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
@@ -128,11 +224,11 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
     int ret = 0;
     uint8_t a_block[16] = {};
     uint8_t s_block[16] = {};
+    mbedtls_aes_context *aes_ctx;
 
-    mbedtls_aes_init(&aes_ctx);
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    ret = get_aes(key, key_length, &aes_ctx);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     a_block[0] = 0x01;
@@ -151,7 +247,7 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
     while (size >= 16) {
         a_block[15] = ((ctr) & 0xFF);
         ctr++;
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
+        ret = mbedtls_aes_crypt_ecb(aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
                                     s_block);
         if (0 != ret) {
             goto exit;
@@ -166,7 +262,7 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
 
     if (size > 0) {
         a_block[15] = ((ctr) & 0xFF);
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
+        ret = mbedtls_aes_crypt_ecb(aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
                                     s_block);
         if (0 != ret) {
             goto exit;
@@ -178,7 +274,8 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
     }
 
 exit:
-    mbedtls_aes_free(&aes_ctx);
+    // Key stream is derived from the key, don't leave it on the stack
+    memset(s_block, 0, sizeof(s_block));
     return ret;
 }
 
@@ -196,71 +293,54 @@ int LoRaMacCrypto::compute_join_frame_mic(const uint8_t *buffer, uint16_t size,
                                           uint32_t *mic)
 {
     uint8_t computed_mic[16] = {};
+    mbedtls_cipher_context_t *cmac_ctx;
     int ret = 0;
 
-    mbedtls_cipher_init(aes_cmac_ctx);
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
-
-    if (NULL != cipher_info) {
-        ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, key_length);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = get_cmac(key, key_length, &cmac_ctx);
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(cmac_ctx, buffer, size & 0xFF);
+    if (0 != ret) {
+        return ret;
+    }
 
-        *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
-                          | (uint32_t) computed_mic[2] << 16
-                          | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
-    } else {
-        ret = MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    ret = mbedtls_cipher_cmac_finish(cmac_ctx, computed_mic);
+    if (0 != ret) {
+        return ret;
     }
 
-exit:
-    mbedtls_cipher_free(aes_cmac_ctx);
-    return ret;
+    *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
+                      | (uint32_t) computed_mic[2] << 16
+                      | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
+    return 0;
 }
 
 int LoRaMacCrypto::decrypt_join_frame(const uint8_t *buffer, uint16_t size,
                                       const uint8_t *key, uint32_t key_length,
                                       uint8_t *dec_buffer)
 {
+    mbedtls_aes_context *aes_ctx;
     int ret = 0;
 
-    mbedtls_aes_init(&aes_ctx);
-
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    ret = get_aes(key, key_length, &aes_ctx);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
-    ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, buffer,
+    ret = mbedtls_aes_crypt_ecb(aes_ctx, MBEDTLS_AES_ENCRYPT, buffer,
                                 dec_buffer);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     // Check if optional CFList is included
     if (size >= 16) {
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, buffer + 16,
+        ret = mbedtls_aes_crypt_ecb(aes_ctx, MBEDTLS_AES_ENCRYPT, buffer + 16,
                                     dec_buffer + 16);
     }
 
-exit:
-    mbedtls_aes_free(&aes_ctx);
     return ret;
 }
 
@@ -270,33 +350,28 @@ int LoRaMacCrypto::compute_skeys_for_join_frame(const uint8_t *key, uint32_t key
 {
     uint8_t nonce[16];
     uint8_t *p_dev_nonce = (uint8_t *) &dev_nonce;
+    mbedtls_aes_context *aes_ctx;
     int ret = 0;
 
-    mbedtls_aes_init(&aes_ctx);
-
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    ret = get_aes(key, key_length, &aes_ctx);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     memset(nonce, 0, sizeof(nonce));
     nonce[0] = 0x01;
     memcpy(nonce + 1, app_nonce, 6);
     memcpy(nonce + 7, p_dev_nonce, 2);
-    ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, nwk_skey);
+    ret = mbedtls_aes_crypt_ecb(aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, nwk_skey);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     memset(nonce, 0, sizeof(nonce));
     nonce[0] = 0x02;
     memcpy(nonce + 1, app_nonce, 6);
     memcpy(nonce + 7, p_dev_nonce, 2);
-    ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, app_skey);
-
-exit:
-    mbedtls_aes_free(&aes_ctx);
-    return ret;
+    return mbedtls_aes_crypt_ecb(aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, app_skey);
 }
 #else
 
@@ -365,4 +440,8 @@ int LoRaMacCrypto::compute_skeys_for_join_frame(const uint8_t *, uint32_t, const
     return LORAWAN_STATUS_CRYPTO_FAIL;
 }
 
+void LoRaMacCrypto::clear_keys()
+{
+}
+
 #endif
@@ -34,6 +34,10 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "mbedtls/aes.h"
 #include "mbedtls/cmac.h"
 
+#ifndef MBED_CONF_LORA_CRYPTO_KEY_SCHEDULES
+#define MBED_CONF_LORA_CRYPTO_KEY_SCHEDULES 2
+#endif
+
 
 class LoRaMacCrypto {
 public:
@@ -151,16 +155,62 @@ public:
                                      const uint8_t *app_nonce, uint16_t dev_nonce,
                                      uint8_t *nwk_skey, uint8_t *app_skey);
 
+    /**
+     * Drops the cached key schedules
+     *
+     * Keys are recognised by their value, so this is not needed for
+     * correctness. It wipes the expanded old session keys from memory when
+     * new ones are installed.
+     */
+    void clear_keys();
+
 private:
     /**
-     * AES computation context variable
+     * Key with its expanded AES key schedule and CMAC context, set up on first use
+     */
+    struct key_schedule_t {
+        uint8_t key[16];
+        uint32_t key_length;
+        bool used;
+        bool aes_ready;
+        bool cmac_ready;
+        mbedtls_aes_context aes_ctx;
+        mbedtls_cipher_context_t cmac_ctx;
+    };
+
+    /**
+     * Finds the cached schedule of a key, or replaces the least recently added one
+     *
+     * @return                        Key schedule, or NULL if the key is too long
      */
-    mbedtls_aes_context aes_ctx;
+    key_schedule_t *get_schedule(const uint8_t *key, uint32_t key_length);
+
+    /**
+     * Gets the AES context of a key, expanding the key on first use
+     *
+     * @param [out] ctx             - AES encryption context
+     *
+     * @return                        0 if successful, or a cipher specific error code
+     */
+    int get_aes(const uint8_t *key, uint32_t key_length, mbedtls_aes_context **ctx);
+
+    /**
+     * Gets the CMAC context of a key, ready for a new message
+     *
+     * @param [out] ctx             - CMAC context
+     *
+     * @return                        0 if successful, or a cipher specific error code
+     */
+    int get_cmac(const uint8_t *key, uint32_t key_length, mbedtls_cipher_context_t **ctx);
+
+    void free_schedule(key_schedule_t *schedule);
+
+    key_schedule_t _schedules[MBED_CONF_LORA_CRYPTO_KEY_SCHEDULES];
 
     /**
-     * CMAC computation context variable
+     * Index of the schedule replaced on the next miss
      */
-    mbedtls_cipher_context_t aes_cmac_ctx[1];
+    uint8_t _next_schedule;
 };
 
 #endif // MBED_LORAWAN_MAC_LORAMAC_CRYPTO_H__
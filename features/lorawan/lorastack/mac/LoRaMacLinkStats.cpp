@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "LoRaMacLinkStats.h"
+
+/**
+ * Weight of a new sample in the averages, as a power of 2
+ */
+#define AVERAGE_WEIGHT_SHIFT    3
+
+/**
+ * Number of downlinks the policy looks at before changing the datarate or
+ * the TX power
+ */
+#define ADR_HISTORY             3
+
+/**
+ * Margin in dB gained by each datarate or TX power step
+ */
+#define ADR_STEP_DB             3
+
+/**
+ * Number of CONFIRMED messages not acknowledged in a row after which the
+ * link is considered lost
+ */
+#define ADR_MISSED_ACK_LIMIT    2
+
+LoRaMacLinkStats::LoRaMacLinkStats()
+    : _lora_phy(NULL),
+      _adr_policy(false)
+{
+    reset();
+}
+
+LoRaMacLinkStats::~LoRaMacLinkStats()
+{
+}
+
+void LoRaMacLinkStats::activate_link_stats_subsystem(LoRaPHY *phy)
+{
+    _lora_phy = phy;
+}
+
+void LoRaMacLinkStats::reset()
+{
+    memset(&_total, 0, sizeof(_total));
+    memset(_channels, 0, sizeof(_channels));
+    _best_margin = INT8_MIN;
+    _margin_samples = 0;
+    _missed_acks = 0;
+}
+
+void LoRaMacLinkStats::on_frame_sent(uint8_t channel, uint32_t tx_toa)
+{
+    add_frame(_total, tx_toa);
+    if (channel < MBED_CONF_LORA_LINK_STATS_CHANNELS) {
+        add_frame(_channels[channel], tx_toa);
+    }
+}
+
+void LoRaMacLinkStats::on_downlink(uint8_t channel, uint8_t datarate,
+                                   int16_t rssi, int8_t snr)
+{
+    int16_t margin = snr - _lora_phy->get_demodulation_floor(datarate);
+    if (margin > INT8_MAX) {
+        margin = INT8_MAX;
+    }
+
+    add_downlink(_total, rssi, snr, margin);
+    if (channel < MBED_CONF_LORA_LINK_STATS_CHANNELS) {
+        add_downlink(_channels[channel], rssi, snr, margin);
+    }
+
+    if (margin > _best_margin) {
+        _best_margin = margin;
+    }
+    _margin_samples++;
+}
+
+void LoRaMacLinkStats::on_uplink_done(uint8_t channel, bool confirmed, bool acked)
+{
+    add_uplink(_total, confirmed, acked);
+    if (channel < MBED_CONF_LORA_LINK_STATS_CHANNELS) {
+        add_uplink(_channels[channel], confirmed, acked);
+    }
+
+    if (confirmed) {
+        _missed_acks = acked ? 0 : _missed_acks + 1;
+    }
+}
+
+void LoRaMacLinkStats::get_link_stats(lorawan_link_stats_t &stats) const
+{
+    stats = _total;
+}
+
+lorawan_status_t LoRaMacLinkStats::get_channel_stats(uint8_t channel,
+                                                     lorawan_link_stats_t &stats) const
+{
+    if (channel >= MBED_CONF_LORA_LINK_STATS_CHANNELS) {
+        return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    stats = _channels[channel];
+    return LORAWAN_STATUS_OK;
+}
+
+void LoRaMacLinkStats::enable_adr_policy(bool enable)
+{
+    _adr_policy = enable;
+    _best_margin = INT8_MIN;
+    _margin_samples = 0;
+    _missed_acks = 0;
+}
+
+bool LoRaMacLinkStats::adr_policy_enabled() const
+{
+    return _adr_policy;
+}
+
+bool LoRaMacLinkStats::get_next_ADR(int8_t &dr_out, int8_t &tx_power_out)
+{
+    int8_t dr = dr_out;
+    int8_t tx_power = tx_power_out;
+
+    if (_missed_acks >= ADR_MISSED_ACK_LIMIT) {
+        // The link is lost, fall back to a more robust datarate at full power
+        dr = _lora_phy->get_next_lower_tx_datarate(dr);
+        tx_power = _lora_phy->get_default_tx_power();
+        _missed_acks = 0;
+    } else if (_margin_samples >= ADR_HISTORY) {
+        int16_t steps = (_best_margin - MBED_CONF_LORA_DEVICE_ADR_MARGIN) / ADR_STEP_DB;
+
+        // Spare margin goes to airtime first, then to TX power. Lower TX
+        // power indexes mean higher power.
+        while (steps > 0 && _lora_phy->verify_tx_datarate(dr + 1)) {
+            dr++;
+            steps--;
+        }
+        while (steps > 0 && _lora_phy->verify_tx_power(tx_power + 1)) {
+            tx_power++;
+            steps--;
+        }
+        while (steps < 0 && tx_power > 0 && _lora_phy->verify_tx_power(tx_power - 1)) {
+            tx_power--;
+            steps++;
+        }
+        while (steps < 0 && dr > _lora_phy->get_minimum_tx_datarate()) {
+            dr = _lora_phy->get_next_lower_tx_datarate(dr);
+            steps++;
+        }
+
+        _best_margin = INT8_MIN;
+        _margin_samples = 0;
+    }
+
+    if (dr == dr_out && tx_power == tx_power_out) {
+        return false;
+    }
+
+    dr_out = dr;
+    tx_power_out = tx_power;
+    _best_margin = INT8_MIN;
+    _margin_samples = 0;
+    return true;
+}
+
+void LoRaMacLinkStats::add_frame(lorawan_link_stats_t &stats, uint32_t tx_toa)
+{
+    stats.tx_count++;
+    stats.tx_airtime += tx_toa;
+}
+
+void LoRaMacLinkStats::add_downlink(lorawan_link_stats_t &stats, int16_t rssi,
+                                    int8_t snr, int8_t margin)
+{
+    if (stats.rx_count++ == 0) {
+        stats.rssi = rssi;
+        stats.snr = snr;
+        stats.margin = margin;
+        return;
+    }
+
+    stats.rssi += (rssi - stats.rssi) / (1 << AVERAGE_WEIGHT_SHIFT);
+    stats.snr += (snr - stats.snr) / (1 << AVERAGE_WEIGHT_SHIFT);
+    stats.margin += (margin - stats.margin) / (1 << AVERAGE_WEIGHT_SHIFT);
+}
+
+void LoRaMacLinkStats::add_uplink(lorawan_link_stats_t &stats, bool confirmed,
+                                  bool acked)
+{
+    if (confirmed) {
+        stats.confirmed_count++;
+        if (acked) {
+            stats.ack_count++;
+        }
+    }
+}
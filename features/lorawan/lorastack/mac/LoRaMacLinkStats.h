@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_LORAWAN_LORAMACLINKSTATS_H_
+#define MBED_LORAWAN_LORAMACLINKSTATS_H_
+
+#include "system/lorawan_data_structures.h"
+#include "lorastack/phy/LoRaPHY.h"
+
+#ifndef MBED_CONF_LORA_LINK_STATS_CHANNELS
+#define MBED_CONF_LORA_LINK_STATS_CHANNELS 16
+#endif
+
+#ifndef MBED_CONF_LORA_DEVICE_ADR_MARGIN
+#define MBED_CONF_LORA_DEVICE_ADR_MARGIN 10
+#endif
+
+/**
+ * Link statistics and device side ADR policy
+ *
+ * Keeps per uplink channel counters of transmissions, airtime, acknowledgements
+ * and downlink quality. The device side ADR policy uses the SNR margin of the
+ * downlinks to select the highest data rate, then the lowest TX power, which
+ * keep the link above the demodulation floor plus an installation margin. This
+ * minimizes the time on air, then the energy, spent per delivered frame.
+ *
+ * The downlink margin stands for the uplink one which only the network knows,
+ * so the policy only moves when downlinks are received (acknowledgements of
+ * CONFIRMED messages, link check answers or application data).
+ */
+class LoRaMacLinkStats {
+
+public:
+
+    /** Constructor
+     *
+     * Sets local handles to NULL. These handles will be set when the subsystem
+     * is activated by the MAC layer.
+     */
+    LoRaMacLinkStats();
+
+    /** Destructor
+     *
+     * Does nothing
+     */
+    ~LoRaMacLinkStats();
+
+    /** Activates link statistics subsystem
+     *
+     * Stores pointers to PHY layer MIB subsystem
+     *
+     * @param phy    pointer to PHY layer
+     */
+    void activate_link_stats_subsystem(LoRaPHY *phy);
+
+    /** Clears all the statistics
+     */
+    void reset();
+
+    /** Accounts a transmitted frame
+     *
+     * @param channel   uplink channel used
+     * @param tx_toa    time on air of the frame in ms
+     */
+    void on_frame_sent(uint8_t channel, uint32_t tx_toa);
+
+    /** Accounts a received downlink
+     *
+     * @param channel   uplink channel the downlink replies to
+     * @param datarate  datarate of the downlink
+     * @param rssi      RSSI of the downlink
+     * @param snr       SNR of the downlink
+     */
+    void on_downlink(uint8_t channel, uint8_t datarate, int16_t rssi, int8_t snr);
+
+    /** Accounts a completed uplink message
+     *
+     * @param channel   uplink channel used last
+     * @param confirmed true for a CONFIRMED message
+     * @param acked     true if the message has been acknowledged
+     */
+    void on_uplink_done(uint8_t channel, bool confirmed, bool acked);
+
+    /** Statistics of all channels
+     *
+     * @param stats     filled with the statistics
+     */
+    void get_link_stats(lorawan_link_stats_t &stats) const;
+
+    /** Statistics of an uplink channel
+     *
+     * @param channel   uplink channel
+     * @param stats     filled with the statistics
+     *
+     * @return          LORAWAN_STATUS_OK, or LORAWAN_STATUS_PARAMETER_INVALID
+     *                  if the channel is not tracked.
+     */
+    lorawan_status_t get_channel_stats(uint8_t channel,
+                                       lorawan_link_stats_t &stats) const;
+
+    /** Enables or disables the device side ADR policy
+     *
+     * @param enable    true to enable the policy
+     */
+    void enable_adr_policy(bool enable);
+
+    /** Checks if the device side ADR policy is enabled
+     */
+    bool adr_policy_enabled() const;
+
+    /** Calculates the datarate and TX power of the next uplink
+     *
+     * Called after each completed uplink message.
+     *
+     * @param dr_out        current datarate, updated with the next one
+     * @param tx_power_out  current TX power, updated with the next one
+     *
+     * @return true if the datarate or the TX power has changed
+     */
+    bool get_next_ADR(int8_t &dr_out, int8_t &tx_power_out);
+
+private:
+    static void add_frame(lorawan_link_stats_t &stats, uint32_t tx_toa);
+    static void add_downlink(lorawan_link_stats_t &stats, int16_t rssi,
+                             int8_t snr, int8_t margin);
+    static void add_uplink(lorawan_link_stats_t &stats, bool confirmed,
+                           bool acked);
+
+    /**
+     * Pointer to PHY layer
+     */
+    LoRaPHY *_lora_phy;
+
+    lorawan_link_stats_t _total;
+
+    lorawan_link_stats_t _channels[MBED_CONF_LORA_LINK_STATS_CHANNELS];
+
+    bool _adr_policy;
+
+    /**
+     * Best downlink margin since the last datarate or TX power change
+     */
+    int8_t _best_margin;
+
+    /**
+     * Downlinks received since the last datarate or TX power change
+     */
+    uint8_t _margin_samples;
+
+    /**
+     * CONFIRMED messages not acknowledged in a row
+     */
+    uint8_t _missed_acks;
+};
+
+#endif // MBED_LORAWAN_LORAMACLINKSTATS_H_
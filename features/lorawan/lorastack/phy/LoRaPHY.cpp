@@ -622,6 +622,17 @@ uint8_t LoRaPHY::get_max_payload(uint8_t datarate, bool use_repeater)
     return payload_table[datarate];
 }
 
+int8_t LoRaPHY::get_demodulation_floor(uint8_t datarate)
+{
+    if (phy_params.fsk_supported && datarate == phy_params.max_rx_datarate) {
+        return 0;
+    }
+
+    // LoRa demodulator floor: -7.5 dB at SF7, 2.5 dB lower for each SF above
+    uint8_t spreading_factor = ((uint8_t *)phy_params.datarates.table)[datarate];
+    return -(5 * (spreading_factor - 4)) / 2;
+}
+
 uint16_t LoRaPHY::get_maximum_frame_counter_gap()
 {
     return phy_params.max_fcnt_gap;
@@ -471,6 +471,14 @@ public:
      */
     uint8_t get_max_payload(uint8_t datarate, bool use_repeater = false);
 
+    /**
+     * @brief get_demodulation_floor Gets the lowest SNR at which a frame sent
+     *        with the given datarate can be demodulated
+     * @param datarate A datarate
+     * @return Demodulation floor in dB
+     */
+    int8_t get_demodulation_floor(uint8_t datarate);
+
     /**
      * @brief get_maximum_frame_counter_gap Gets maximum frame counter gap
      * @return Maximum frame counter gap
@@ -676,4 +676,77 @@ typedef struct {
     uint32_t rx_toa;
 } lorawan_rx_metadata;
 
+/**
+ * Link statistics, for an uplink channel or for all channels
+ *
+ * Downlink figures are accounted to the uplink channel they reply to.
+ */
+typedef struct {
+    /**
+     * Number of frames transmitted, retransmissions included
+     */
+    uint32_t tx_count;
+    /**
+     * Total time on air of the transmitted frames, in milliseconds
+     */
+    uint32_t tx_airtime;
+    /**
+     * Number of CONFIRMED messages completed
+     */
+    uint32_t confirmed_count;
+    /**
+     * Number of CONFIRMED messages acknowledged by the network
+     */
+    uint32_t ack_count;
+    /**
+     * Number of downlinks received
+     */
+    uint32_t rx_count;
+    /**
+     * Average RSSI of the downlinks, in dBm
+     */
+    int16_t rssi;
+    /**
+     * Average SNR of the downlinks, in dB
+     */
+    int8_t snr;
+    /**
+     * Average SNR margin of the downlinks above the demodulation floor of
+     * their data rate, in dB
+     */
+    int8_t margin;
+} lorawan_link_stats_t;
+
+/**
+ * Statistics of the uplinks carrying messages sent with
+ * LoRaWANInterface::send_aggregated()
+ */
+typedef struct {
+    /**
+     * Number of uplinks completed successfully
+     */
+    uint32_t uplinks;
+    /**
+     * Number of messages delivered by these uplinks
+     */
+    uint32_t messages;
+    /**
+     * Number of application bytes delivered, length prefixes excluded
+     */
+    uint32_t bytes;
+    /**
+     * Number of messages lost with uplinks which failed
+     */
+    uint32_t dropped;
+    /**
+     * Time the oldest message of the last uplink spent queued before the
+     * uplink was transmitted, in milliseconds
+     */
+    uint32_t last_latency;
+    /**
+     * Highest queueing latency seen, in milliseconds
+     */
+    uint32_t max_latency;
+} lorawan_aggregation_stats_t;
+
 #endif /* MBED_LORAWAN_TYPES_H_ */
@@ -19,9 +19,11 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 
 #include "LoRaWANTimer.h"
+#include "events/mbed_shared_queues.h"
 
 LoRaWANTimeHandler::LoRaWANTimeHandler()
-    : _queue(NULL)
+    : _queue(NULL),
+      _time_critical_queue(NULL)
 {
 }
 
@@ -32,6 +34,12 @@ LoRaWANTimeHandler::~LoRaWANTimeHandler()
 void LoRaWANTimeHandler::activate_timer_subsystem(events::EventQueue *queue)
 {
     _queue = queue;
+#if MBED_CONF_LORA_RX_WINDOW_HIGHPRIO_QUEUE && MBED_CONF_RTOS_PRESENT
+    // Not IRQ safe, must be fetched here as timers may be started from interrupts
+    _time_critical_queue = mbed::mbed_highprio_event_queue();
+#else
+    _time_critical_queue = queue;
+#endif
 }
 
 lorawan_time_t LoRaWANTimeHandler::get_current_time(void)
@@ -45,20 +53,27 @@ lorawan_time_t LoRaWANTimeHandler::get_elapsed_time(lorawan_time_t saved_time)
     return get_current_time() - saved_time;
 }
 
-void LoRaWANTimeHandler::init(timer_event_t &obj, mbed::Callback<void()> callback)
+void LoRaWANTimeHandler::init(timer_event_t &obj, mbed::Callback<void()> callback,
+                              bool time_critical)
 {
     obj.callback = callback;
     obj.timer_id = 0;
+    obj.time_critical = time_critical;
 }
 
 void LoRaWANTimeHandler::start(timer_event_t &obj, const uint32_t timeout)
 {
-    obj.timer_id = _queue->call_in(timeout, obj.callback);
+    obj.timer_id = queue_of(obj)->call_in(timeout, obj.callback);
     MBED_ASSERT(obj.timer_id != 0);
 }
 
 void LoRaWANTimeHandler::stop(timer_event_t &obj)
 {
-    _queue->cancel(obj.timer_id);
+    queue_of(obj)->cancel(obj.timer_id);
     obj.timer_id = 0;
 }
+
+events::EventQueue *LoRaWANTimeHandler::queue_of(const timer_event_t &obj)
+{
+    return obj.time_critical ? _time_critical_queue : _queue;
+}
@@ -36,6 +36,10 @@ public:
      * Embeds EventQueue object to timer subsystem which is subsequently
      * used to extract timer information.
      *
+     * Time critical timers run from the shared high priority event queue when
+     * lora.rx-window-highprio-queue is enabled, so that they do not wait for
+     * the events of the application sharing the stack queue.
+     *
      * @param [in] queue  Handle to EventQueue object
      */
     void activate_timer_subsystem(events::EventQueue *queue);
@@ -58,10 +62,13 @@ public:
      * @remark The TimerSetValue function must be called before starting the timer.
      *         This function initializes the time-stamp and reloads the value at 0.
      *
-     * @param [in] obj          The structure containing the timer object parameters.
-     * @param [in] callback     The function callback called at the end of the timeout.
+     * @param [in] obj           The structure containing the timer object parameters.
+     * @param [in] callback      The function callback called at the end of the timeout.
+     * @param [in] time_critical True if the callback must run on time regardless
+     *                           of the load of the stack queue.
      */
-    void init(timer_event_t &obj, mbed::Callback<void()> callback);
+    void init(timer_event_t &obj, mbed::Callback<void()> callback,
+              bool time_critical = false);
 
     /** Starts and adds the timer object to the list of timer events.
      *
@@ -77,7 +84,10 @@ public:
     void stop(timer_event_t &obj);
 
 private:
+    events::EventQueue *queue_of(const timer_event_t &obj);
+
     events::EventQueue *_queue;
+    events::EventQueue *_time_critical_queue;
 };
 
 #endif // MBED_LORAWAN_SYS_TIMER_H__
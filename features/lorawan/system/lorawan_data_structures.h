@@ -990,6 +990,78 @@ typedef struct lorawan_session {
     uint32_t downlink_counter;
 } lorawan_session_t;
 
+/** loramac_session_t
+ *
+ * The state of the MAC needed to resume a session without joining again.
+ */
+typedef struct {
+    /*!
+     * Device EUI the session was joined with.
+     */
+    uint8_t dev_eui[8];
+    /*!
+     * Application EUI the session was joined with.
+     */
+    uint8_t app_eui[8];
+    /*!
+     * Device address given by the network.
+     */
+    uint32_t dev_addr;
+    /*!
+     * Network ID.
+     */
+    uint32_t net_id;
+    /*!
+     * Network session key.
+     */
+    uint8_t nwk_skey[16];
+    /*!
+     * Application session key.
+     */
+    uint8_t app_skey[16];
+    /*!
+     * Uplink frame counter.
+     */
+    uint32_t ul_frame_counter;
+    /*!
+     * Downlink frame counter.
+     */
+    uint32_t dl_frame_counter;
+    /*!
+     * Delay of the 1st reception window in ms.
+     */
+    uint32_t recv_delay1;
+    /*!
+     * Delay of the 2nd reception window in ms.
+     */
+    uint32_t recv_delay2;
+    /*!
+     * 2nd reception window settings.
+     */
+    rx2_channel_params rx2_channel;
+    /*!
+     * Data rate offset of the 1st reception window.
+     */
+    uint8_t rx1_dr_offset;
+    /*!
+     * Data rate of the uplinks.
+     */
+    int8_t channel_data_rate;
+    /*!
+     * TX power index of the uplinks.
+     */
+    int8_t channel_tx_power;
+    /*!
+     * Number of channels in the channel plan, 0 if the region has no custom
+     * channel plans.
+     */
+    uint8_t nb_channels;
+    /*!
+     * Enabled channels.
+     */
+    loramac_channel_t channels[LORA_MAX_NB_CHANNELS];
+} loramac_session_t;
+
 /*!
  * The parameter structure for the function for regional rx configuration.
  */
@@ -1054,6 +1126,10 @@ typedef struct {
 typedef struct {
     mbed::Callback<void()> callback;
     int timer_id;
+    /*!
+     * Run from the timing critical queue rather than the stack queue
+     */
+    bool time_critical;
 } timer_event_t;
 
 /*!
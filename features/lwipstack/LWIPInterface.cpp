@@ -353,6 +353,9 @@ LWIP::Interface::Interface() :
     hw(NULL), has_addr_state(0),
     connected(NSAPI_STATUS_DISCONNECTED),
     dhcp_started(false), dhcp_has_to_be_set(false), blocking(true), ppp(false)
+#if LWIP_ETHERNET && MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE
+    , input_msg(NULL), input_head(0), input_count(0), input_posted(false)
+#endif
 {
     memset(&netif, 0, sizeof netif);
 
@@ -37,10 +37,81 @@ err_t LWIP::Interface::emac_low_level_output(struct netif *netif, struct pbuf *p
     return ret ? ERR_OK : ERR_IF;
 }
 
+#if MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE
+#if MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE > 255
+#error "lwip.emac-input-batch-size must not exceed 255"
+#endif
+
+/* Runs in the TCPIP thread, processing the frames queued by emac_input */
+void LWIP::Interface::emac_input_batch(void *ctx)
+{
+    LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(ctx);
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    /* Frames arriving meanwhile are left for a new wake-up, so a flood
+       doesn't starve other messages to the TCPIP thread */
+    for (int i = 0; i < MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE; i++) {
+        SYS_ARCH_PROTECT(lev);
+        if (!mbed_if->input_count) {
+            mbed_if->input_posted = false;
+            SYS_ARCH_UNPROTECT(lev);
+            return;
+        }
+        struct pbuf *p = mbed_if->input_batch[mbed_if->input_head];
+        mbed_if->input_head = (mbed_if->input_head + 1) % MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE;
+        mbed_if->input_count--;
+        SYS_ARCH_UNPROTECT(lev);
+
+        if (ethernet_input(p, &mbed_if->netif) != ERR_OK) {
+            LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: IP input error\n"));
+
+            pbuf_free(p);
+        }
+    }
+
+    if (tcpip_callbackmsg_trycallback(mbed_if->input_msg) != ERR_OK) {
+        /* Retried by the next frame received */
+        SYS_ARCH_PROTECT(lev);
+        mbed_if->input_posted = false;
+        SYS_ARCH_UNPROTECT(lev);
+    }
+}
+#endif
+
 void LWIP::Interface::emac_input(emac_mem_buf_t *buf)
 {
     struct pbuf *p = static_cast<struct pbuf *>(buf);
 
+#if MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE
+    if (input_msg) {
+        bool queued = false;
+        bool post = false;
+        SYS_ARCH_DECL_PROTECT(lev);
+        SYS_ARCH_PROTECT(lev);
+        if (input_count < MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE) {
+            input_batch[(input_head + input_count) % MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE] = p;
+            input_count++;
+            queued = true;
+        }
+        if (!input_posted) {
+            input_posted = true;
+            post = true;
+        }
+        SYS_ARCH_UNPROTECT(lev);
+
+        /* Only the first frame of a batch wakes the TCPIP thread */
+        if (post && tcpip_callbackmsg_trycallback(input_msg) != ERR_OK) {
+            SYS_ARCH_PROTECT(lev);
+            input_posted = false;
+            SYS_ARCH_UNPROTECT(lev);
+        }
+        if (queued) {
+            return;
+        }
+        /* Batch full, posted on its own */
+    }
+#endif
+
     /* pass all packets to ethernet_input, which decides what packets it supports */
     if (netif.input(p, &netif) != ERR_OK) {
         LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: IP input error\n"));
@@ -138,12 +209,28 @@ err_t LWIP::Interface::emac_if_init(struct netif *netif)
     LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(netif->state);
 
     mbed_if->emac->set_memory_manager(*mbed_if->memory_manager);
+#if MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE
+    if (!mbed_if->input_msg) {
+        /* If allocation fails, frames are posted one by one */
+        mbed_if->input_msg = tcpip_callbackmsg_new(&LWIP::Interface::emac_input_batch, mbed_if);
+    }
+#endif
     mbed_if->emac->set_link_input_cb(mbed::callback(mbed_if, &LWIP::Interface::emac_input));
     mbed_if->emac->set_link_state_cb(mbed::callback(mbed_if, &LWIP::Interface::emac_state_change));
 
     /* Interface capabilities */
     netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET;
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    /* EMAC offload flags share lwIP's NETIF_CHECKSUM_* values */
+    MBED_STATIC_ASSERT(EMAC::CHECKSUM_OFFLOAD_GEN_IP == NETIF_CHECKSUM_GEN_IP &&
+                       EMAC::CHECKSUM_OFFLOAD_GEN_ICMP6 == NETIF_CHECKSUM_GEN_ICMP6 &&
+                       EMAC::CHECKSUM_OFFLOAD_CHECK_IP == NETIF_CHECKSUM_CHECK_IP &&
+                       EMAC::CHECKSUM_OFFLOAD_CHECK_ICMP6 == NETIF_CHECKSUM_CHECK_ICMP6,
+                       "EMAC checksum offload flags must match lwIP");
+    NETIF_SET_CHECKSUM_CTRL(netif, NETIF_CHECKSUM_ENABLE_ALL & ~mbed_if->emac->get_checksum_offload());
+#endif
+
     if (!mbed_if->emac->power_up()) {
         err = ERR_IF;
     }
@@ -28,17 +28,21 @@
 #include "lwip/dhcp.h"
 #include "lwip/tcpip.h"
 #include "lwip/tcp.h"
+#include "lwip/priv/tcp_priv.h"
 #include "lwip/ip.h"
 #include "lwip/mld6.h"
 #include "lwip/igmp.h"
 #include "lwip/dns.h"
 #include "lwip/udp.h"
 #include "lwip/raw.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
 #include "lwip/netif.h"
 #include "lwip/lwip_errno.h"
 #include "lwip-sys/arch/sys_arch.h"
 
 #include "LWIPStack.h"
+#include "mbed_stats.h"
 
 #ifndef LWIP_SOCKET_MAX_MEMBERSHIPS
 #define LWIP_SOCKET_MAX_MEMBERSHIPS 4
@@ -453,7 +457,20 @@ nsapi_size_or_error_t LWIP::socket_send(nsapi_socket_t handle, const void *data,
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
     size_t bytes_written = 0;
 
-    err_t err = netconn_write_partly(s->conn, data, size, NETCONN_COPY, &bytes_written);
+#if LWIP_TCP
+    if (s->sndbuf || s->sndbuf_auto) {
+        u32_t pending;
+        u32_t limit = tcp_sndbuf_limit(s, &pending);
+        if (limit) {
+            if (pending >= limit) {
+                return NSAPI_ERROR_WOULD_BLOCK;
+            }
+            size = LWIP_MIN(size, limit - pending);
+        }
+    }
+#endif
+
+    err_t err = netconn_write_partly(s->conn, data, size, s->nocopy ? NETCONN_NOCOPY : NETCONN_COPY, &bytes_written);
     if (err != ERR_OK) {
         return err_remap(err);
     }
@@ -461,6 +478,33 @@ nsapi_size_or_error_t LWIP::socket_send(nsapi_socket_t handle, const void *data,
     return (nsapi_size_or_error_t)bytes_written;
 }
 
+#if LWIP_TCP
+u32_t LWIP::tcp_sndbuf_limit(struct mbed_lwip_socket *s, u32_t *pending)
+{
+    u32_t limit = s->sndbuf;
+
+    *pending = 0;
+    LOCK_TCPIP_CORE();
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    if (pcb) {
+        *pending = TCP_SND_BUF - tcp_sndbuf(pcb);
+        if (s->sndbuf_auto) {
+            // Twice the data in flight, which follows the observed RTT as the
+            // congestion window grows, within a share of the lwIP heap
+            limit = 2 * (u32_t)LWIP_MIN(pcb->cwnd, pcb->snd_wnd);
+            limit = LWIP_MAX(limit, 2 * TCP_MSS);
+            limit = LWIP_MIN(limit, LWIP_MIN(TCP_SND_BUF, MEM_SIZE / 2));
+        }
+    } else {
+        // Not connected, left to netconn to report
+        limit = 0;
+    }
+    UNLOCK_TCPIP_CORE();
+
+    return limit;
+}
+#endif
+
 nsapi_size_or_error_t LWIP::socket_recv(nsapi_socket_t handle, void *data, nsapi_size_t size)
 {
 #if LWIP_TCP
@@ -492,10 +536,25 @@ nsapi_size_or_error_t LWIP::socket_recv(nsapi_socket_t handle, void *data, nsapi
 nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAddress &address, const void *data, nsapi_size_t size)
 {
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct netbuf *buf = netbuf_new();
+
+    err_t err = netbuf_ref(buf, data, (u16_t)size);
+    if (err != ERR_OK) {
+        netbuf_free(buf);
+        return err_remap(err);
+    }
+
+    return socket_sendto_netbuf(s, address, buf, size);
+}
+
+nsapi_size_or_error_t LWIP::socket_sendto_netbuf(struct mbed_lwip_socket *s, const SocketAddress &address,
+                                                 struct netbuf *buf, nsapi_size_t size)
+{
     ip_addr_t ip_addr;
 
     nsapi_addr_t addr = address.get_addr();
     if (!convert_mbed_addr_to_lwip(&ip_addr, &addr)) {
+        netbuf_delete(buf);
         return NSAPI_ERROR_PARAMETER;
     }
     struct netif *netif_ = netif_get_by_index(s->conn->pcb.ip->netif_idx);
@@ -505,24 +564,150 @@ nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAdd
     if (netif_) {
         if ((addr.version == NSAPI_IPv4 && !get_ipv4_addr(netif_)) ||
                 (addr.version == NSAPI_IPv6 && !get_ipv6_addr(netif_))) {
+            netbuf_delete(buf);
             return NSAPI_ERROR_PARAMETER;
         }
     }
-    struct netbuf *buf = netbuf_new();
 
-    err_t err = netbuf_ref(buf, data, (u16_t)size);
+    err_t err = netconn_sendto(s->conn, buf, &ip_addr, address.get_port());
+    netbuf_delete(buf);
     if (err != ERR_OK) {
-        netbuf_free(buf);
         return err_remap(err);
     }
 
-    err = netconn_sendto(s->conn, buf, &ip_addr, address.get_port());
-    netbuf_delete(buf);
+    return size;
+}
+
+nsapi_size_or_error_t LWIP::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                           const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (iovcnt == 1) {
+        return address ? socket_sendto(handle, *address, iov[0].iov_base, iov[0].iov_len)
+               : socket_send(handle, iov[0].iov_base, iov[0].iov_len);
+    }
+
+#if LWIP_TCP
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        // Vectors are written in batches, all data of a batch is copied to the send buffer at once
+        struct netvector vectors[8];
+        size_t sent = 0;
+
+        for (unsigned i = 0; i < iovcnt;) {
+            u16_t count = 0;
+            size_t batch = 0;
+            for (; i < iovcnt && count < sizeof vectors / sizeof vectors[0]; i++, count++) {
+                vectors[count].ptr = iov[i].iov_base;
+                vectors[count].len = iov[i].iov_len;
+                batch += iov[i].iov_len;
+            }
+
+            size_t bytes_written = 0;
+            err_t err = netconn_write_vectors_partly(s->conn, vectors, count, s->nocopy ? NETCONN_NOCOPY : NETCONN_COPY, &bytes_written);
+            if (err != ERR_OK) {
+                // Reports the error only if nothing was sent
+                return sent ? (nsapi_size_or_error_t)sent : err_remap(err);
+            }
+
+            sent += bytes_written;
+            if (bytes_written < batch) {
+                break;
+            }
+        }
+
+        return (nsapi_size_or_error_t)sent;
+    }
+#endif
+
+    if (!address) {
+        return NSAPI_ERROR_NO_ADDRESS;
+    }
+
+    // Chains a pbuf referencing each buffer, the stack copies them when the packet is sent
+    struct netbuf *buf = netbuf_new();
+    if (!buf) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    nsapi_size_t size = 0;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        if (!iov[i].iov_len && buf->p) {
+            continue;
+        }
+
+        if (size + iov[i].iov_len > 0xFFFF) {
+            netbuf_delete(buf);
+            return NSAPI_ERROR_PARAMETER;
+        }
+
+        if (!buf->p) {
+            err_t err = netbuf_ref(buf, iov[i].iov_base, (u16_t)iov[i].iov_len);
+            if (err != ERR_OK) {
+                netbuf_delete(buf);
+                return err_remap(err);
+            }
+        } else {
+            struct pbuf *p = pbuf_alloc(PBUF_RAW, (u16_t)iov[i].iov_len, PBUF_REF);
+            if (!p) {
+                netbuf_delete(buf);
+                return NSAPI_ERROR_NO_MEMORY;
+            }
+            p->payload = iov[i].iov_base;
+            pbuf_cat(buf->p, p);
+        }
+        size += iov[i].iov_len;
+    }
+
+    if (!buf->p) {
+        // No buffers, sends an empty datagram
+        err_t err = netbuf_ref(buf, NULL, 0);
+        if (err != ERR_OK) {
+            netbuf_delete(buf);
+            return err_remap(err);
+        }
+    }
+
+    return socket_sendto_netbuf(s, *address, buf, size);
+}
+
+nsapi_size_or_error_t LWIP::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                           nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+#if LWIP_TCP
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        // Data is already copied out of the pbufs buffer by buffer
+        return NetworkStack::socket_recvmsg(handle, NULL, iov, iovcnt);
+    }
+#endif
+
+    if (iovcnt == 1) {
+        return socket_recvfrom(handle, address, iov[0].iov_base, iov[0].iov_len);
+    }
+
+    struct netbuf *buf;
+
+    err_t err = netconn_recv(s->conn, &buf);
     if (err != ERR_OK) {
         return err_remap(err);
     }
 
-    return size;
+    if (address) {
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(buf));
+        address->set_addr(addr);
+        address->set_port(netbuf_fromport(buf));
+    }
+
+    u16_t recv = 0;
+    for (unsigned i = 0; i < iovcnt && recv < netbuf_len(buf); i++) {
+        recv += netbuf_copy_partial(buf, iov[i].iov_base, (u16_t)iov[i].iov_len, recv);
+    }
+    netbuf_delete(buf);
+
+    return recv;
 }
 
 nsapi_size_or_error_t LWIP::socket_recvfrom(nsapi_socket_t handle, SocketAddress *address, void *data, nsapi_size_t size)
@@ -548,6 +733,80 @@ nsapi_size_or_error_t LWIP::socket_recvfrom(nsapi_socket_t handle, SocketAddress
     return recv;
 }
 
+nsapi_size_or_error_t LWIP::socket_recvfrom_batch(nsapi_socket_t handle, nsapi_msg_t *msgs, unsigned count)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    unsigned recv = 0;
+
+    // Socket netconns are non-blocking, so each receive only polls the mailbox
+    for (; recv < count; recv++) {
+        struct netbuf *buf;
+        err_t err = netconn_recv(s->conn, &buf);
+        if (err != ERR_OK) {
+            // Reports the error only if nothing was received
+            return recv ? (nsapi_size_or_error_t)recv : err_remap(err);
+        }
+
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(buf));
+        msgs[recv].address.set_addr(addr);
+        msgs[recv].address.set_port(netbuf_fromport(buf));
+        msgs[recv].result = netbuf_copy(buf, msgs[recv].data, (u16_t)msgs[recv].size);
+        netbuf_delete(buf);
+    }
+
+    return recv;
+}
+
+nsapi_size_or_error_t LWIP::socket_recv_buf(nsapi_socket_t handle, SocketAddress *address,
+                                            NetStackBuffer &buf)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct pbuf *p;
+
+#if LWIP_TCP
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        if (s->buf) {
+            // Hands over the rest of a chain partially read by socket_recv
+            p = pbuf_free_header(s->buf, s->offset);
+            s->buf = 0;
+            s->offset = 0;
+        } else {
+            err_t err = netconn_recv_tcp_pbuf(s->conn, &p);
+            if (err != ERR_OK) {
+                return err_remap(err);
+            }
+        }
+
+        buf.attach(&memory_manager, p);
+        return p->tot_len;
+    }
+#endif
+
+    struct netbuf *nbuf;
+
+    err_t err = netconn_recv(s->conn, &nbuf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    if (address) {
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(nbuf));
+        address->set_addr(addr);
+        address->set_port(netbuf_fromport(nbuf));
+    }
+
+    // Detaches the chain so deleting the netbuf doesn't free it
+    p = nbuf->p;
+    nbuf->p = NULL;
+    nbuf->ptr = NULL;
+    netbuf_delete(nbuf);
+
+    buf.attach(&memory_manager, p);
+    return p->tot_len;
+}
+
 int32_t LWIP::find_multicast_member(const struct mbed_lwip_socket *s, const nsapi_ip_mreq_t *imr)
 {
     uint32_t count = 0;
@@ -604,6 +863,29 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
             s->conn->pcb.tcp->keep_intvl = *(int *)optval;
             return 0;
+
+        case NSAPI_SEND_NOCOPY:
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            s->nocopy = *(int *)optval;
+            return 0;
+
+        case NSAPI_SNDBUF: {
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            // 0 sizes the buffer automatically, TCP_SND_BUF or more removes the limit
+            int size = *(int *)optval;
+            if (size < 0) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+            s->sndbuf_auto = size == 0;
+            s->sndbuf = size == 0 || size >= TCP_SND_BUF ? 0 : LWIP_MAX(size, TCP_MSS);
+            return 0;
+        }
 #endif
 
         case NSAPI_REUSEADDR:
@@ -722,7 +1004,88 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
 nsapi_error_t LWIP::getsockopt(nsapi_socket_t handle, int level, int optname, void *optval, unsigned *optlen)
 {
-    return NSAPI_ERROR_UNSUPPORTED;
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    switch (optname) {
+#if LWIP_TCP
+        case NSAPI_SEND_PENDING: {
+            if (*optlen < sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            int pending = 0;
+            LOCK_TCPIP_CORE();
+            if (s->conn->pcb.tcp) {
+                pending = TCP_SND_BUF - tcp_sndbuf(s->conn->pcb.tcp);
+                if (pending) {
+                    // Signals the socket again once the peer has acknowledged more data
+                    netconn_set_flags(s->conn, NETCONN_FLAG_CHECK_WRITESPACE);
+                }
+            }
+            UNLOCK_TCPIP_CORE();
+
+            *(int *)optval = pending;
+            *optlen = sizeof(int);
+            return 0;
+        }
+
+        case NSAPI_SNDBUF: {
+            if (*optlen < sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            // The current limit, which moves with the connection when automatic
+            u32_t pending;
+            u32_t limit = tcp_sndbuf_limit(s, &pending);
+
+            *(int *)optval = limit ? limit : TCP_SND_BUF;
+            *optlen = sizeof(int);
+            return 0;
+        }
+
+        case NSAPI_RCVBUF: {
+            if (*optlen < sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            // The receive window, which is only above 64 KiB with window scaling
+            int size = TCPWND_MIN16(TCP_WND);
+            LOCK_TCPIP_CORE();
+            if (s->conn->pcb.tcp && s->conn->pcb.tcp->state != LISTEN) {
+                size = TCP_WND_MAX(s->conn->pcb.tcp);
+            }
+            UNLOCK_TCPIP_CORE();
+
+            *(int *)optval = size;
+            *optlen = sizeof(int);
+            return 0;
+        }
+
+        case NSAPI_TCP_INFO: {
+            if (*optlen < sizeof(nsapi_tcp_info_t) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            nsapi_tcp_info_t *info = (nsapi_tcp_info_t *)optval;
+            memset(info, 0, sizeof(nsapi_tcp_info_t));
+            LOCK_TCPIP_CORE();
+            struct tcp_pcb *pcb = s->conn->pcb.tcp;
+            if (pcb) {
+                // sa is the average round trip time scaled by 8, in slow timer ticks
+                info->rtt_ms = (uint32_t)(pcb->sa >> 3) * TCP_SLOW_INTERVAL;
+                info->retransmits = pcb->nrtx;
+                info->send_pending = TCP_SND_BUF - tcp_sndbuf(pcb);
+            }
+            UNLOCK_TCPIP_CORE();
+
+            *optlen = sizeof(nsapi_tcp_info_t);
+            return 0;
+        }
+#endif
+
+        default:
+            return NSAPI_ERROR_UNSUPPORTED;
+    }
 }
 
 
@@ -734,6 +1097,43 @@ void LWIP::socket_attach(nsapi_socket_t handle, void (*callback)(void *), void *
     s->data = data;
 }
 
+#if MEM_STATS && MEMP_STATS
+// Pool names, in memp_t order
+static const char *const memp_names[] = {
+#define LWIP_MEMPOOL(name, num, size, desc) #name,
+#include "lwip/priv/memp_std.h"
+};
+
+static void copy_mem_stats(mbed_stats_network_pool_t *stats, const char *name, const struct stats_mem *mem)
+{
+    stats->name = name;
+    stats->size = mem->avail;
+    stats->used = mem->used;
+    stats->max_used = mem->max;
+    stats->failures = mem->err;
+}
+#endif
+
+extern "C" size_t mbed_stats_network_get(mbed_stats_network_pool_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_network_pool_t));
+
+    size_t i = 0;
+#if MEM_STATS && MEMP_STATS
+    SYS_ARCH_DECL_PROTECT(lev);
+    SYS_ARCH_PROTECT(lev);
+    if (i < count) {
+        copy_mem_stats(&stats[i++], "MEM", &lwip_stats.mem);
+    }
+    for (int pool = 0; pool < MEMP_MAX && i < count; pool++) {
+        copy_mem_stats(&stats[i++], memp_names[pool], lwip_stats.memp[pool]);
+    }
+    SYS_ARCH_UNPROTECT(lev);
+#endif
+    return i;
+}
+
 LWIP &LWIP::get_instance()
 {
     static LWIP lwip;
@@ -29,6 +29,10 @@
 #include "netsocket/OnboardNetworkStack.h"
 #include "LWIPMemoryManager.h"
 
+#ifndef MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE
+#define MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE 0
+#endif
+
 
 class LWIP : public OnboardNetworkStack, private mbed::NonCopyable<LWIP> {
 public:
@@ -138,6 +142,9 @@ public:
 #if LWIP_ETHERNET
         static err_t emac_low_level_output(struct netif *netif, struct pbuf *p);
         void emac_input(net_stack_mem_buf_t *buf);
+#if MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE
+        static void emac_input_batch(void *ctx);
+#endif
         void emac_state_change(bool up);
 #if LWIP_IGMP
         static err_t emac_igmp_mac_filter(struct netif *netif, const ip4_addr_t *group, enum netif_mac_filter_action action);
@@ -208,6 +215,15 @@ public:
         static Interface *list;
         Interface *next;
         LWIPMemoryManager *memory_manager;
+#if LWIP_ETHERNET && MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE
+        /* Frames received from the EMAC waiting for the TCPIP thread,
+         * which is woken once with input_msg to process all of them */
+        struct tcpip_callback_msg *input_msg;
+        struct pbuf *input_batch[MBED_CONF_LWIP_EMAC_INPUT_BATCH_SIZE];
+        uint8_t input_head;
+        uint8_t input_count;
+        bool input_posted;
+#endif
     };
 
     /** Register a network interface with the IP stack
@@ -443,6 +459,44 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                                   void *buffer, nsapi_size_t size);
 
+    /** Send data from several buffers over a socket
+     *
+     *  TCP data is written with a single vectored write. UDP buffers are
+     *  referenced by a pbuf chain and sent without copying.
+     *
+     *  @copydetails NetworkStack::socket_sendmsg
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                 const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data into several buffers over a socket
+     *
+     *  UDP packets are copied from the received pbufs straight into the buffers.
+     *
+     *  @copydetails NetworkStack::socket_recvmsg
+     */
+    virtual nsapi_size_or_error_t socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                 nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive several packets over a UDP socket
+     *
+     *  Drains the netconn receive mailbox with non-blocking fetches until it
+     *  is empty or the array is full.
+     *
+     *  @copydetails NetworkStack::socket_recvfrom_batch
+     */
+    virtual nsapi_size_or_error_t socket_recvfrom_batch(nsapi_socket_t handle, nsapi_msg_t *msgs, unsigned count);
+
+    /** Receive data over a socket without copying it
+     *
+     *  Lends the received pbuf chain. For TCP the part of a chain already
+     *  read by socket_recv is dropped from its head first.
+     *
+     *  @copydetails NetworkStack::socket_recv_buf
+     */
+    virtual nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle, SocketAddress *address,
+                                                  NetStackBuffer &buf);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -532,6 +586,13 @@ private:
         void (*cb)(void *);
         void *data;
 
+        // Data is sent by reference, see NSAPI_SEND_NOCOPY
+        bool nocopy;
+
+        // Limit of unacknowledged data, see NSAPI_SNDBUF. 0 for TCP_SND_BUF
+        u32_t sndbuf;
+        bool sndbuf_auto;
+
         // Track multicast addresses subscribed to by this socket
         nsapi_ip_mreq_t *multicast_memberships;
         uint32_t         multicast_memberships_count;
@@ -584,6 +645,17 @@ private:
     }
     static int32_t find_multicast_member(const struct mbed_lwip_socket *s, const nsapi_ip_mreq_t *imr);
 
+    /* Limit of unacknowledged data for a TCP socket, see NSAPI_SNDBUF
+     *
+     * @param s         Socket
+     * @param pending   Set to the data sent and not yet acknowledged
+     * @return          The limit in bytes, 0 when the socket is not limited
+     */
+    u32_t tcp_sndbuf_limit(struct mbed_lwip_socket *s, u32_t *pending);
+
+    nsapi_size_or_error_t socket_sendto_netbuf(struct mbed_lwip_socket *s, const SocketAddress &address,
+                                               struct netbuf *buf, nsapi_size_t size);
+
     static void socket_callback(struct netconn *nc, enum netconn_evt eh, u16_t len);
 
     static void tcpip_init_irq(void *handle);
@@ -391,6 +391,8 @@ err_t sys_mutex_new(sys_mutex_t *mutex) {
     mutex->attr.name = "lwip_mutex";
     mutex->attr.cb_mem = &mutex->data;
     mutex->attr.cb_size = sizeof(mutex->data);
+    // The tcpip core lock is taken by application threads of any priority
+    mutex->attr.attr_bits = osMutexPrioInherit;
     mutex->id = osMutexNew(&mutex->attr);
     if (mutex->id == NULL) {
         MBED_WARNING1(MBED_MAKE_ERROR(MBED_MODULE_NETWORK_STACK, MBED_ERROR_CODE_FAILED_OPERATION), "sys_mutex_new error\n", (u32_t)mutex);
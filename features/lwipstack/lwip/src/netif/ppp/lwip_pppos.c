@@ -706,6 +706,31 @@ pppos_input(ppp_pcb *ppp, u8_t *s, int l)
 
       /* update the frame check sequence number. */
       pppos->in_fcs = PPP_FCS(pppos->in_fcs, cur_char);
+
+      /* Copy the run of plain data characters that follows straight into
+       * the current pbuf, taking the protection once for the run instead
+       * of once per character. */
+      if (pppos->in_state == PDDATA && pppos->in_tail != NULL && l > 0) {
+        ext_accm accm;
+        u8_t *dst = (u8_t*)pppos->in_tail->payload + pppos->in_tail->len;
+        u16_t room = PBUF_POOL_BUFSIZE - pppos->in_tail->len;
+        u16_t fcs = pppos->in_fcs;
+        u16_t n = 0;
+
+        PPPOS_PROTECT(lev);
+        MEMCPY(accm, pppos->in_accm, sizeof(accm));
+        PPPOS_UNPROTECT(lev);
+
+        while (n < room && n < l && !ESCAPE_P(accm, s[n])) {
+          dst[n] = s[n];
+          fcs = PPP_FCS(fcs, s[n]);
+          n++;
+        }
+        pppos->in_tail->len += n;
+        pppos->in_fcs = fcs;
+        s += n;
+        l -= n;
+      }
     }
   } /* while (l-- > 0), all bytes processed */
 }
@@ -166,6 +166,7 @@ struct LWIP::mbed_lwip_socket *LWIP::arena_alloc()
             struct mbed_lwip_socket *s = &arena[i];
             memset(s, 0, sizeof(*s));
             s->in_use = true;
+            s->sndbuf_auto = MBED_CONF_LWIP_TCP_SND_BUF_AUTO;
             lwip.adaptation.unlock();
             return s;
         }
@@ -113,6 +113,24 @@
 
 #define TCPIP_THREAD_PRIO           (osPriorityNormal)
 
+// Socket calls take the core lock and run lwIP in the calling thread,
+// instead of posting a message to the tcpip thread and waiting for the reply
+#ifndef MBED_CONF_LWIP_TCPIP_CORE_LOCKING
+#define MBED_CONF_LWIP_TCPIP_CORE_LOCKING          1
+#endif
+
+#ifndef MBED_CONF_LWIP_TCPIP_CORE_LOCKING_INPUT
+#define MBED_CONF_LWIP_TCPIP_CORE_LOCKING_INPUT    0
+#endif
+
+#if MBED_CONF_LWIP_TCPIP_CORE_LOCKING
+#define LWIP_TCPIP_CORE_LOCKING         1
+#define LWIP_TCPIP_CORE_LOCKING_INPUT   MBED_CONF_LWIP_TCPIP_CORE_LOCKING_INPUT
+#else
+#define LWIP_TCPIP_CORE_LOCKING         0
+#define LWIP_TCPIP_CORE_LOCKING_INPUT   0
+#endif
+
 // Thread stack size for lwip system threads
 #ifndef MBED_CONF_LWIP_DEFAULT_THREAD_STACKSIZE
 #define MBED_CONF_LWIP_DEFAULT_THREAD_STACKSIZE    512
@@ -123,6 +141,11 @@
 #define MBED_CONF_LWIP_PPP_THREAD_STACKSIZE    768
 #endif
 
+// Buffer for data read from the serial stream by the PPP thread
+#ifndef MBED_CONF_LWIP_PPP_INPUT_BUFFER_SIZE
+#define MBED_CONF_LWIP_PPP_INPUT_BUFFER_SIZE   128
+#endif
+
 #ifdef LWIP_DEBUG
 #define DEFAULT_THREAD_STACKSIZE    LWIP_ALIGN_UP(MBED_CONF_LWIP_DEFAULT_THREAD_STACKSIZE*2, 8)
 #define PPP_THREAD_STACK_SIZE       LWIP_ALIGN_UP(MBED_CONF_LWIP_PPP_THREAD_STACKSIZE*2, 8)
@@ -162,6 +185,21 @@
 #define TCP_WND                     MBED_CONF_LWIP_TCP_WND
 #endif
 
+// TCP window scaling, so TCP_WND can exceed 64 KiB on high bandwidth-delay links
+#if MBED_CONF_LWIP_TCP_WND_SCALE
+#define LWIP_WND_SCALE              1
+#define TCP_RCV_SCALE               MBED_CONF_LWIP_TCP_WND_SCALE
+#endif
+
+// Selective acknowledgements of out-of-sequence segments received
+#if MBED_CONF_LWIP_TCP_SACK
+#define LWIP_TCP_SACK_OUT           1
+#endif
+
+#ifndef MBED_CONF_LWIP_TCP_SND_BUF_AUTO
+#define MBED_CONF_LWIP_TCP_SND_BUF_AUTO            0
+#endif
+
 #ifdef MBED_CONF_LWIP_TCP_MAXRTX
 #define TCP_MAXRTX                  MBED_CONF_LWIP_TCP_MAXRTX
 #endif
@@ -181,6 +219,10 @@
 #endif
 #endif
 
+#ifdef MBED_CONF_LWIP_PBUF_LINK_ENCAPSULATION_HLEN
+#define PBUF_LINK_ENCAPSULATION_HLEN    MBED_CONF_LWIP_PBUF_LINK_ENCAPSULATION_HLEN
+#endif
+
 #ifdef MBED_CONF_LWIP_PBUF_POOL_BUFSIZE
 #undef PBUF_POOL_BUFSIZE
 #define PBUF_POOL_BUFSIZE           LWIP_MEM_ALIGN_SIZE(MBED_CONF_LWIP_PBUF_POOL_BUFSIZE)
@@ -325,6 +367,24 @@
 #define MEMP_SANITY_CHECK           1
 #define LWIP_DBG_TYPES_ON           LWIP_DBG_ON
 #define LWIP_DBG_MIN_LEVEL          LWIP_DBG_LEVEL_ALL
+#elif defined(MBED_NETWORK_STATS_ENABLED) || defined(MBED_ALL_STATS_ENABLED)
+#define LWIP_NOASSERT               1
+// Only the memory statistics, for mbed_stats_network_get
+#define LWIP_STATS                  1
+#define LINK_STATS                  0
+#define ETHARP_STATS                0
+#define IP_STATS                    0
+#define IPFRAG_STATS                0
+#define ICMP_STATS                  0
+#define IGMP_STATS                  0
+#define UDP_STATS                   0
+#define TCP_STATS                   0
+#define SYS_STATS                   0
+#define IP6_STATS                   0
+#define ICMP6_STATS                 0
+#define IP6_FRAG_STATS              0
+#define MLD6_STATS                  0
+#define ND6_STATS                   0
 #else
 #define LWIP_NOASSERT               1
 #define LWIP_STATS                  0
@@ -387,6 +447,9 @@
 // Checksum-on-copy disabled due to https://savannah.nongnu.org/bugs/?50914
 #define LWIP_CHECKSUM_ON_COPY       0
 
+// Lets each EMAC interface turn off the checksums its hardware handles
+#define LWIP_CHECKSUM_CTRL_PER_NETIF 1
+
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETIF_STATUS_CALLBACK  1
 #define LWIP_NETIF_LINK_CALLBACK    1
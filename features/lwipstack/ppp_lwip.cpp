@@ -57,6 +57,9 @@ static const char *pwd;
 static sys_sem_t ppp_close_sem;
 static Callback<void(nsapi_event_t, intptr_t)> connection_status_cb;
 
+// Only touched by the PPP thread, static to keep it off its small stack
+static u8_t input_buffer[MBED_CONF_LWIP_PPP_INPUT_BUFFER_SIZE];
+
 static EventQueue *prepare_event_queue()
 {
     if (event_queue) {
@@ -94,14 +97,16 @@ static u32_t ppp_output(ppp_pcb *pcb, u8_t *data, u32_t len, void *ctx)
     // File handle will be in non-blocking mode, because of read events.
     // Therefore must use poll to achieve the necessary block for writing.
 
+    // lwIP hands over escaped frame data a pool buffer at a time, so try
+    // writing it all at once and only wait when the stream is full.
     uint32_t written = 0;
     while (len != 0) {
-        // Block forever until we're selected - don't care about reason we wake;
-        // return from write should tell us what's up.
-        poll(&fhs, 1, -1);
         // This write will be non-blocking, but blocking would be fine.
         ssize_t ret = stream->write(data, len);
         if (ret == -EAGAIN) {
+            // Block forever until we're selected - don't care about reason we wake;
+            // return from write should tell us what's up.
+            poll(&fhs, 1, -1);
             continue;
         } else if (ret < 0) {
             break;
@@ -255,15 +260,14 @@ static void ppp_input()
     // Infinite loop, but we assume that we can read faster than the
     // serial, so we will fairly rapidly hit -EAGAIN.
     for (;;) {
-        u8_t buffer[16];
-        ssize_t len = my_stream->read(buffer, sizeof buffer);
+        ssize_t len = my_stream->read(input_buffer, sizeof input_buffer);
         if (len == -EAGAIN) {
             break;
         } else if (len <= 0) {
             handle_modem_hangup();
             return;
         }
-        pppos_input(my_ppp_pcb, buffer, len);
+        pppos_input(my_ppp_pcb, input_buffer, len);
     }
     return;
 }
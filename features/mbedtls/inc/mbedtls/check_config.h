@@ -130,6 +130,13 @@
 #error "MBEDTLS_ECP_RESTARTABLE defined, but not MBEDTLS_ECDH_LEGACY_CONTEXT"
 #endif
 
+#if defined(MBEDTLS_ECP_SECP256R1_COMB_TABLE)    && \
+    ( !defined(MBEDTLS_ECP_C)                    || \
+      !defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED) || \
+      defined(MBEDTLS_ECP_ALT) )
+#error "MBEDTLS_ECP_SECP256R1_COMB_TABLE defined, but not all prerequisites"
+#endif
+
 #if defined(MBEDTLS_ECDSA_DETERMINISTIC) && !defined(MBEDTLS_HMAC_DRBG_C)
 #error "MBEDTLS_ECDSA_DETERMINISTIC defined, but not all prerequisites"
 #endif
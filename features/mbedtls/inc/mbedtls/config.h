@@ -756,6 +756,26 @@
  */
 #define MBEDTLS_ECP_NIST_OPTIM
 
+/**
+ * \def MBEDTLS_ECP_SECP256R1_COMB_TABLE
+ *
+ * Use a precomputed table of multiples of the secp256r1 base point, stored
+ * as constant data, for fixed-point multiplication (key generation, ECDSA
+ * signing, the first half of ECDH).
+ *
+ * Without it, the comb table is computed at run time the first time the base
+ * point is multiplied in a group, and is computed again for every group that
+ * is loaded, which in TLS means once per handshake. With it, that work is
+ * skipped and the table (about 1 KiB) lives in flash instead of on the heap.
+ *
+ * Only used when MBEDTLS_ECP_FIXED_POINT_OPTIM is 1 (the default).
+ *
+ * Requires: MBEDTLS_ECP_C, MBEDTLS_ECP_DP_SECP256R1_ENABLED
+ *
+ * Uncomment this macro to use the precomputed secp256r1 table.
+ */
+//#define MBEDTLS_ECP_SECP256R1_COMB_TABLE
+
 /**
  * \def MBEDTLS_ECP_RESTARTABLE
  *
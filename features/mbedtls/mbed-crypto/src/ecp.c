@@ -603,7 +603,8 @@ void mbedtls_ecp_group_free( mbedtls_ecp_group *grp )
         mbedtls_mpi_free( &grp->N );
     }
 
-    if( grp->T != NULL )
+    /* T_size == 0 marks a constant table that comes with the curve */
+    if( grp->T != NULL && grp->T_size != 0 )
     {
         for( i = 0; i < grp->T_size; i++ )
             mbedtls_ecp_point_free( &grp->T[i] );
@@ -2003,8 +2004,11 @@ static unsigned char ecp_pick_window_size( const mbedtls_ecp_group *grp,
     /*
      * Make sure w is within bounds.
      * (The last test is useful only for very small curves in the test suite.)
+     * A constant table for the base point was built for this w, so it is
+     * not subject to MBEDTLS_ECP_WINDOW_SIZE.
      */
-    if( w > MBEDTLS_ECP_WINDOW_SIZE )
+    if( w > MBEDTLS_ECP_WINDOW_SIZE &&
+        !( p_eq_g && grp->T != NULL && grp->T_size == 0 ) )
         w = MBEDTLS_ECP_WINDOW_SIZE;
     if( w >= grp->nbits )
         w = 2;
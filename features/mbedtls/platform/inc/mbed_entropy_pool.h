@@ -0,0 +1,95 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ENTROPY_POOL_H
+#define MBED_ENTROPY_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "device.h"
+
+#if DEVICE_TRNG || defined(DOXYGEN_ONLY)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Health test of the TRNG output that failed, see NIST SP 800-90B section 4.4 */
+typedef enum {
+    MBED_ENTROPY_HEALTH_OK = 0,
+    MBED_ENTROPY_HEALTH_REPETITION,     /**< Repetition count test: the same byte repeated too many times in a row */
+    MBED_ENTROPY_HEALTH_PROPORTION      /**< Adaptive proportion test: the same byte too often in a window */
+} mbed_entropy_health_t;
+
+/** Entropy pool statistics */
+typedef struct {
+    uint32_t bytes_served;              /**< Bytes returned by mbed_entropy_pool_get */
+    uint32_t pool_misses;               /**< Requests the pool couldn't serve in full, which polled the TRNG */
+    uint32_t health_failures;           /**< Batches of TRNG output thrown away by the health tests */
+    mbed_entropy_health_t last_failure; /**< Last health test that failed */
+} mbed_entropy_pool_stats_t;
+
+/** Get random bytes from the entropy pool
+ *
+ *  Bytes are taken from the pool, the rest are polled from the TRNG. Once
+ *  the pool is half empty it is refilled from the shared event queue, so
+ *  the next requests, like the ones of a TLS handshake, don't wait for the
+ *  TRNG. The pool size is set by entropy-pool.size, 0 polls the TRNG on
+ *  every request.
+ *
+ *  Everything read from the TRNG goes through the repetition count and
+ *  adaptive proportion health tests, assuming at least 4 bits of
+ *  min-entropy per byte. A failing batch is thrown away and reported.
+ *
+ *  This is the mbedtls_hardware_poll of Mbed OS.
+ *
+ *  @param output           Buffer for the random bytes
+ *  @param length           Number of bytes wanted
+ *  @param output_length    Number of bytes returned
+ *  @return 0 on success, -1 if the TRNG failed or its output failed a health test
+ */
+int mbed_entropy_pool_get(uint8_t *output, size_t length, size_t *output_length);
+
+/** Fill the entropy pool now
+ *
+ *  Called from the shared event queue when the pool runs low. Can also be
+ *  called at startup or from idle time, like on targets without the
+ *  events library.
+ */
+void mbed_entropy_pool_refill(void);
+
+/** Get the entropy pool statistics
+ *
+ *  @param stats Statistics to fill in
+ */
+void mbed_entropy_pool_get_stats(mbed_entropy_pool_stats_t *stats);
+
+/** Attach a function called when TRNG output fails a health test
+ *
+ *  The function is called with the pool locked, from the thread that read
+ *  the TRNG, and must not request entropy. Failures are also reported by
+ *  MBED_WARNING.
+ *
+ *  @param handler Function taking the failed test, NULL to detach
+ */
+void mbed_entropy_pool_attach_health_failure(void (*handler)(mbed_entropy_health_t failure));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_TRNG
+
+#endif
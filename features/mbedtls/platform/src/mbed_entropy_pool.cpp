@@ -0,0 +1,203 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if DEVICE_TRNG
+
+#include "mbed_entropy_pool.h"
+#include "hal/trng_api.h"
+#include "platform/SingletonPtr.h"
+#include "platform/PlatformMutex.h"
+#include "platform/mbed_error.h"
+#if MBED_CONF_EVENTS_PRESENT
+#include "events/mbed_shared_queues.h"
+#endif
+#include <string.h>
+
+#ifndef MBED_CONF_ENTROPY_POOL_SIZE
+#define MBED_CONF_ENTROPY_POOL_SIZE 0
+#endif
+
+// Health test cutoffs of NIST SP 800-90B 4.4 for a false positive rate of
+// 2^-20, assuming at least 4 bits of min-entropy per byte
+#define REPETITION_CUTOFF   6
+#define PROPORTION_WINDOW   512
+#define PROPORTION_CUTOFF   63
+
+extern SingletonPtr<PlatformMutex> mbedtls_mutex;
+
+#if MBED_CONF_ENTROPY_POOL_SIZE
+static uint8_t pool[MBED_CONF_ENTROPY_POOL_SIZE];
+static size_t pool_level;
+static bool refill_pending;
+#endif
+
+static mbed_entropy_pool_stats_t stats;
+static void (*health_failure_handler)(mbed_entropy_health_t failure);
+
+static uint8_t repetition_value;
+static uint32_t repetition_count;
+static uint8_t proportion_value;
+static uint32_t proportion_count;
+static uint32_t proportion_index;
+
+static mbed_entropy_health_t health_test(const uint8_t *data, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        uint8_t sample = data[i];
+
+        if (repetition_count && sample == repetition_value) {
+            if (++repetition_count >= REPETITION_CUTOFF) {
+                return MBED_ENTROPY_HEALTH_REPETITION;
+            }
+        } else {
+            repetition_value = sample;
+            repetition_count = 1;
+        }
+
+        if (proportion_index == 0) {
+            proportion_value = sample;
+            proportion_count = 1;
+        } else if (sample == proportion_value) {
+            if (++proportion_count >= PROPORTION_CUTOFF) {
+                return MBED_ENTROPY_HEALTH_PROPORTION;
+            }
+        }
+        if (++proportion_index == PROPORTION_WINDOW) {
+            proportion_index = 0;
+        }
+    }
+
+    return MBED_ENTROPY_HEALTH_OK;
+}
+
+static void health_failure(mbed_entropy_health_t failure)
+{
+    // Start over with the next batch
+    repetition_count = 0;
+    proportion_index = 0;
+
+    stats.health_failures++;
+    stats.last_failure = failure;
+    MBED_WARNING1(MBED_MAKE_ERROR(MBED_MODULE_HAL, MBED_ERROR_CODE_FAILED_OPERATION), "TRNG health test failed", failure);
+    if (health_failure_handler) {
+        health_failure_handler(failure);
+    }
+}
+
+// Read and test TRNG output, called with the pool locked
+static int poll_trng(uint8_t *output, size_t length, size_t *output_length)
+{
+    trng_t trng_obj;
+    size_t total = 0;
+    int ret = 0;
+
+    trng_init(&trng_obj);
+    while (total < length) {
+        size_t got = 0;
+        ret = trng_get_bytes(&trng_obj, output + total, length - total, &got);
+        if (ret != 0 || got == 0) {
+            break;
+        }
+
+        mbed_entropy_health_t failure = health_test(output + total, got);
+        if (failure != MBED_ENTROPY_HEALTH_OK) {
+            memset(output + total, 0, got);
+            health_failure(failure);
+            ret = -1;
+            break;
+        }
+        total += got;
+    }
+    trng_free(&trng_obj);
+
+    *output_length = total;
+    return ret;
+}
+
+#if MBED_CONF_ENTROPY_POOL_SIZE
+static void schedule_refill()
+{
+    if (refill_pending || pool_level > MBED_CONF_ENTROPY_POOL_SIZE / 2) {
+        return;
+    }
+#if MBED_CONF_EVENTS_PRESENT
+    refill_pending = (mbed::mbed_event_queue()->call(mbed_entropy_pool_refill) != 0);
+#endif
+}
+#endif
+
+int mbed_entropy_pool_get(uint8_t *output, size_t length, size_t *output_length)
+{
+    size_t served = 0;
+    int ret = 0;
+
+    mbedtls_mutex->lock();
+
+#if MBED_CONF_ENTROPY_POOL_SIZE
+    // Take from the top of the pool, leaving nothing behind
+    served = (length < pool_level) ? length : pool_level;
+    pool_level -= served;
+    memcpy(output, pool + pool_level, served);
+    memset(pool + pool_level, 0, served);
+#endif
+
+    if (served < length) {
+        size_t polled;
+        stats.pool_misses++;
+        ret = poll_trng(output + served, length - served, &polled);
+        served += polled;
+    }
+
+#if MBED_CONF_ENTROPY_POOL_SIZE
+    schedule_refill();
+#endif
+
+    stats.bytes_served += served;
+    *output_length = served;
+
+    mbedtls_mutex->unlock();
+
+    return ret;
+}
+
+void mbed_entropy_pool_refill(void)
+{
+#if MBED_CONF_ENTROPY_POOL_SIZE
+    size_t polled;
+
+    mbedtls_mutex->lock();
+    refill_pending = false;
+    poll_trng(pool + pool_level, MBED_CONF_ENTROPY_POOL_SIZE - pool_level, &polled);
+    pool_level += polled;
+    mbedtls_mutex->unlock();
+#endif
+}
+
+void mbed_entropy_pool_get_stats(mbed_entropy_pool_stats_t *pool_stats)
+{
+    mbedtls_mutex->lock();
+    *pool_stats = stats;
+    mbedtls_mutex->unlock();
+}
+
+void mbed_entropy_pool_attach_health_failure(void (*handler)(mbed_entropy_health_t failure))
+{
+    mbedtls_mutex->lock();
+    health_failure_handler = handler;
+    mbedtls_mutex->unlock();
+}
+
+#endif // DEVICE_TRNG
@@ -16,7 +16,7 @@
 
 #if DEVICE_TRNG
 
-#include "hal/trng_api.h"
+#include "mbed_entropy_pool.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 
@@ -24,13 +24,7 @@ SingletonPtr<PlatformMutex> mbedtls_mutex;
 
 extern "C"
 int mbedtls_hardware_poll( void *data, unsigned char *output, size_t len, size_t *olen ) {
-    trng_t trng_obj;
-    mbedtls_mutex->lock();
-    trng_init(&trng_obj);
-    int ret = trng_get_bytes(&trng_obj, output, len, olen);
-    trng_free(&trng_obj);
-    mbedtls_mutex->unlock();
-    return ret;
+    return mbed_entropy_pool_get(output, len, olen);
 }
 
 #endif
@@ -378,6 +378,39 @@ int mbedtls_aes_crypt_ctr(mbedtls_aes_context *ctx,
     int c, i;
     size_t n = *nc_off;
 
+    /* Use up the current stream block */
+    while (n != 0 && length > 0) {
+        c = *input++;
+        *output++ = (unsigned char)(c ^ stream_block[n]);
+        n = (n + 1) & 0x0F;
+        length--;
+    }
+
+    /* Whole blocks in the CRYP processor, in runs that don't wrap its
+     * 32-bit counter. The carry is propagated here. */
+    while (length >= 16) {
+        uint32_t low = ((uint32_t)nonce_counter[12] << 24) | ((uint32_t)nonce_counter[13] << 16) |
+                       ((uint32_t)nonce_counter[14] << 8) | (uint32_t)nonce_counter[15];
+        uint64_t room = ((uint64_t)1 << 32) - low;
+        size_t blocks = length / 16;
+
+        if (blocks > room) {
+            blocks = (size_t)room;
+        }
+        if (st_aes_crypt_ctr32(ctx, blocks, nonce_counter, input, output) != 0) {
+            return ST_ERR_AES_BUSY;
+        }
+        if (blocks == room) {
+            for (i = 12; i > 0; i--)
+                if (++nonce_counter[i - 1] != 0) {
+                    break;
+                }
+        }
+        input += blocks * 16;
+        output += blocks * 16;
+        length -= blocks * 16;
+    }
+
     while (length--) {
         if (n == 0) {
             if (mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, nonce_counter, stream_block) != 0) {
@@ -401,6 +434,46 @@ int mbedtls_aes_crypt_ctr(mbedtls_aes_context *ctx,
 }
 #endif /* MBEDTLS_CIPHER_MODE_CTR */
 
+int st_aes_crypt_ctr32(mbedtls_aes_context *ctx,
+                       size_t blocks,
+                       unsigned char counter[16],
+                       const unsigned char *input,
+                       unsigned char *output)
+{
+    while (blocks > 0) {
+        uint32_t low = ((uint32_t)counter[12] << 24) | ((uint32_t)counter[13] << 16) |
+                       ((uint32_t)counter[14] << 8) | (uint32_t)counter[15];
+        size_t run = (blocks < ST_AES_CTR_MAX_BLOCKS) ? blocks : ST_AES_CTR_MAX_BLOCKS;
+
+        /* Stop where the counter wraps, continuing from 0 below */
+        if (low != 0 && run > (size_t)(0 - low)) {
+            run = (size_t)(0 - low);
+        }
+
+        /* allow multi-instance of CRYP use: restore context for CRYP hw module */
+        ctx->hcryp_aes.Instance->CR = ctx->ctx_save_cr;
+        ctx->hcryp_aes.Phase = HAL_CRYP_PHASE_READY;
+        ctx->hcryp_aes.Init.DataType = CRYP_DATATYPE_8B;
+        ctx->hcryp_aes.Init.pKey = ctx->aes_key;
+        ctx->hcryp_aes.Init.pInitVect = counter;
+
+        if (HAL_CRYP_AESCTR_Encrypt(&ctx->hcryp_aes, (uint8_t *)input, (uint16_t)(run * 16), output, 10) != HAL_OK) {
+            return ST_ERR_AES_BUSY;
+        }
+
+        low += (uint32_t)run;
+        counter[12] = (unsigned char)(low >> 24);
+        counter[13] = (unsigned char)(low >> 16);
+        counter[14] = (unsigned char)(low >> 8);
+        counter[15] = (unsigned char)low;
+
+        input += run * 16;
+        output += run * 16;
+        blocks -= run;
+    }
+    return 0;
+}
+
 int mbedtls_internal_aes_encrypt(mbedtls_aes_context *ctx,
                                  const unsigned char input[16],
                                  unsigned char output[16])
@@ -33,6 +33,7 @@ extern "C" {
 
 #define ST_AES_TIMEOUT    ((uint32_t) 0xFF) /* 255 ms timeout for the crypto processor */
 #define ST_ERR_AES_BUSY   (-0x0023)      /* Crypto processor is busy, timeout occured */
+#define ST_AES_CTR_MAX_BLOCKS ((size_t) 0x0FFF) /* HAL transfer sizes are 16 bits */
 /**
  * \brief          AES context structure
  *
@@ -230,6 +231,28 @@ int mbedtls_aes_crypt_ctr(mbedtls_aes_context *ctx,
                           unsigned char *output);
 #endif /* MBEDTLS_CIPHER_MODE_CTR */
 
+/**
+ * \brief           Counter mode over whole blocks in the CRYP processor
+ *
+ * The processor increments the low 32 bits of the counter block only, so
+ * does this function (as GCM does). Blocks are processed in runs of at
+ * most ST_AES_CTR_MAX_BLOCKS.
+ *
+ * \param ctx       AES context
+ * \param blocks    Number of 16-byte blocks
+ * \param counter   Counter block of the first block, updated to the
+ *                  counter block following the last one
+ * \param input     Input data
+ * \param output    Output data
+ *
+ * \return          0 if successful, ST_ERR_AES_BUSY on timeout
+ */
+int st_aes_crypt_ctr32(mbedtls_aes_context *ctx,
+                       size_t blocks,
+                       unsigned char counter[16],
+                       const unsigned char *input,
+                       unsigned char *output);
+
 /**
  * \brief           Internal AES block encryption function
  *                  (Only exposed to allow overriding it,
@@ -208,6 +208,37 @@ int mbedtls_ssl_set_hostname(mbedtls_ssl_context *ssl, const char *hostname)
     return 0;
 }
 
+int mbedtls_ssl_conf_max_frag_len(mbedtls_ssl_config *conf, unsigned char mfl_code)
+{
+    return mbedtls_stub.expected_int;
+}
+
+int mbedtls_ssl_get_session(const mbedtls_ssl_context *ssl, mbedtls_ssl_session *session)
+{
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
+int mbedtls_ssl_set_session(mbedtls_ssl_context *ssl, const mbedtls_ssl_session *session)
+{
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
+void mbedtls_ssl_session_init(mbedtls_ssl_session *session)
+{
+
+}
+
+void mbedtls_ssl_session_free(mbedtls_ssl_session *session)
+{
+
+}
+
 const mbedtls_x509_crt *mbedtls_ssl_get_peer_cert(const mbedtls_ssl_context *ssl)
 {
     return NULL;
@@ -23,6 +23,8 @@
 #include "Nanostack.h"
 #include "mesh_interface_types.h"
 
+struct nwk_stats_t;
+
 class Nanostack::Interface : public OnboardNetworkStack::Interface, private mbed::NonCopyable<Nanostack::Interface> {
 public:
     virtual char *get_ip_address(char *buf, nsapi_size_t buflen);
@@ -137,6 +139,16 @@ public:
         return _interface->get_interface_id();
     }
 
+    /** Enable the collection of network statistics
+     *
+     *  The statistics, including 6LoWPAN reassembly errors, timeouts and
+     *  evictions, are shared by all the Nanostack interfaces.
+     *
+     *  @param stats    structure updated by the stack, which must remain valid
+     *                  while enabled, or NULL to stop the collection
+     */
+    void set_network_statistics(nwk_stats_t *stats);
+
 protected:
     InterfaceNanostack();
     virtual Nanostack *get_stack(void);
@@ -19,6 +19,7 @@
 #include "NanostackLockGuard.h"
 #include "mesh_system.h"
 #include "nanostack/net_interface.h"
+#include "nanostack/nwk_stats_api.h"
 #include "thread_management_if.h"
 #include "ip6string.h"
 #include "mbed_error.h"
@@ -217,6 +218,17 @@ nsapi_error_t InterfaceNanostack::set_blocking(bool blocking)
     return NSAPI_ERROR_OK;
 }
 
+void InterfaceNanostack::set_network_statistics(nwk_stats_t *stats)
+{
+    NanostackLockGuard lock;
+    if (stats) {
+        protocol_stats_start(stats);
+        protocol_stats_reset();
+    } else {
+        protocol_stats_stop();
+    }
+}
+
 #if !DEVICE_802_15_4_PHY
 MBED_WEAK MeshInterface *MeshInterface::get_target_default_instance()
 {
@@ -20,6 +20,16 @@
 
 #include "NanostackPhy.h"
 
+/** Frame buffer transfer statistics of a radio driver, times in microseconds */
+typedef struct {
+    uint32_t rx_frames;         /**< Frames read from the radio */
+    uint32_t tx_frames;         /**< Frames written to the radio */
+    uint32_t rx_read_max;       /**< Longest frame buffer read */
+    uint32_t tx_write_max;      /**< Longest frame buffer write */
+    uint32_t turnaround_last;   /**< Radio interrupt to the received frame read out, for the last frame */
+    uint32_t turnaround_max;    /**< Longest radio interrupt to received frame read out */
+} nanostack_rf_phy_stats_t;
+
 /** Radio PHY driver class for Nanostack */
 class NanostackRfPhy : public NanostackPhy {
 public:
@@ -60,6 +70,22 @@ public:
     {
         rf_unregister();
     }
+
+    /** Get the frame buffer transfer statistics
+     *
+     *  The turnaround time bounds how late an ACK can be handled, and includes
+     *  the scheduling of the driver's interrupt thread and the SPI transfers.
+     *
+     *  @param stats    Returned statistics
+     *  @param reset    Clear the statistics once read
+     *  @return         0 on success, -1 if the driver doesn't collect statistics
+     */
+    virtual int get_stats(nanostack_rf_phy_stats_t *stats, bool reset = false)
+    {
+        (void)stats;
+        (void)reset;
+        return -1;
+    }
 };
 
 #endif /* NANOSTACK_RF_PHY_H_ */
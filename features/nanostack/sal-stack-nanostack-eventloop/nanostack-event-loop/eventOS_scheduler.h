@@ -26,6 +26,16 @@ extern "C" {
 #define NS_NORETURN
 #endif
 
+/**
+ * \struct eventOS_tasklet_stats_t
+ * \brief Events dispatched to a tasklet and time spent handling them.
+ */
+typedef struct eventOS_tasklet_stats {
+    uint32_t event_count;   /**< Events dispatched */
+    uint32_t run_time;      /**< Total time in the handler, in profiling clock units */
+    uint32_t max_run_time;  /**< Longest time in the handler for one event, in profiling clock units */
+} eventOS_tasklet_stats_t;
+
 /**
  * \brief Initialise event scheduler.
  *
@@ -45,6 +55,30 @@ bool eventOS_scheduler_dispatch_event(void);
  */
 extern void eventOS_scheduler_run_until_idle(void);
 
+/**
+ * \brief Set the clock used to measure tasklet execution time.
+ *
+ * Event counts are always collected. Execution time is only measured once a
+ * clock is set, for example a free running microsecond counter.
+ *
+ * \param clock Function returning the current time, NULL to stop measuring.
+ */
+extern void eventOS_scheduler_profiling_clock_set(uint32_t (*clock)(void));
+
+/**
+ * \brief Read the statistics of a tasklet.
+ *
+ * \param tasklet_id Tasklet ID.
+ * \param stats Filled with the statistics of the tasklet.
+ * \return 0 on success, -1 if the tasklet does not exist.
+ */
+extern int8_t eventOS_scheduler_tasklet_stats_get(int8_t tasklet_id, eventOS_tasklet_stats_t *stats);
+
+/**
+ * \brief Clear the statistics of all tasklets.
+ */
+extern void eventOS_scheduler_tasklet_stats_reset(void);
+
 /**
  * \brief Start Event scheduler.
  * Loops forever processing events from the queue.
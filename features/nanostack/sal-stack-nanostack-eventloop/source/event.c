@@ -28,13 +28,26 @@
 typedef struct arm_core_tasklet {
     int8_t id; /**< Event handler Tasklet ID */
     void (*func_ptr)(arm_event_s *);
+    eventOS_tasklet_stats_t stats;
     ns_list_link_t link;
 } arm_core_tasklet_t;
 
+#define EVENT_PRIORITY_COUNT (ARM_LIB_LOW_PRIORITY_EVENT + 1)
+
+typedef NS_LIST_HEAD(arm_event_storage_t, link) event_queue_t;
+
 static NS_LIST_DEFINE(arm_core_tasklet_list, arm_core_tasklet_t, link);
-static NS_LIST_DEFINE(event_queue_active, arm_event_storage_t, link);
+// One FIFO per priority, so queueing an event does not walk the queue
+static event_queue_t event_queue_active[EVENT_PRIORITY_COUNT] = {
+    NS_LIST_INIT(event_queue_active[ARM_LIB_HIGH_PRIORITY_EVENT]),
+    NS_LIST_INIT(event_queue_active[ARM_LIB_MED_PRIORITY_EVENT]),
+    NS_LIST_INIT(event_queue_active[ARM_LIB_LOW_PRIORITY_EVENT]),
+};
 static NS_LIST_DEFINE(free_event_entry, arm_event_storage_t, link);
 
+// Clock measuring tasklet execution time, if profiling
+static uint32_t (*profiling_clock)(void);
+
 // Statically allocate initial pool of events.
 #define STARTUP_EVENT_POOL_SIZE 10
 static arm_event_storage_t startup_event_pool[STARTUP_EVENT_POOL_SIZE];
@@ -48,6 +61,15 @@ static arm_event_storage_t *event_dynamically_allocate(void);
 static arm_event_storage_t *event_core_get(void);
 static void event_core_write(arm_event_storage_t *event);
 
+static event_queue_t *event_queue_get(const arm_event_storage_t *event)
+{
+    // Unknown priorities are handled as the lowest one
+    if (event->data.priority > ARM_LIB_LOW_PRIORITY_EVENT) {
+        return &event_queue_active[ARM_LIB_LOW_PRIORITY_EVENT];
+    }
+    return &event_queue_active[event->data.priority];
+}
+
 static arm_core_tasklet_t *event_tasklet_handler_get(uint8_t tasklet_id)
 {
     ns_list_foreach(arm_core_tasklet_t, cur, &arm_core_tasklet_list) {
@@ -103,6 +125,7 @@ int8_t eventOS_event_handler_create(void (*handler_func_ptr)(arm_event_s *), uin
     //Fill in tasklet; add to list
     new->id = tasklet_get_free_id();
     new->func_ptr = handler_func_ptr;
+    memset(&new->stats, 0, sizeof(new->stats));
     ns_list_add_to_end(&arm_core_tasklet_list, new);
 
     //Queue "init" event for the new task
@@ -142,7 +165,7 @@ void eventOS_event_send_timer_allocated(arm_event_storage_t *event)
 
 void eventOS_event_cancel_critical(arm_event_storage_t *event)
 {
-    ns_list_remove(&event_queue_active, event);
+    ns_list_remove(event_queue_get(event), event);
 }
 
 static arm_event_storage_t *event_dynamically_allocate(void)
@@ -206,11 +229,15 @@ void event_core_free_push(arm_event_storage_t *free)
 
 static arm_event_storage_t *event_core_read(void)
 {
+    arm_event_storage_t *event = NULL;
     platform_enter_critical();
-    arm_event_storage_t *event = ns_list_get_first(&event_queue_active);
-    if (event) {
-        event->state = ARM_LIB_EVENT_RUNNING;
-        ns_list_remove(&event_queue_active, event);
+    for (uint_fast8_t i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+        event = ns_list_get_first(&event_queue_active[i]);
+        if (event) {
+            event->state = ARM_LIB_EVENT_RUNNING;
+            ns_list_remove(&event_queue_active[i], event);
+            break;
+        }
     }
     platform_exit_critical();
     return event;
@@ -219,18 +246,7 @@ static arm_event_storage_t *event_core_read(void)
 void event_core_write(arm_event_storage_t *event)
 {
     platform_enter_critical();
-    bool added = false;
-    ns_list_foreach(arm_event_storage_t, event_tmp, &event_queue_active) {
-        // note enum ordering means we're checking if event_tmp is LOWER priority than event
-        if (event_tmp->data.priority > event->data.priority) {
-            ns_list_add_before(&event_queue_active, event_tmp, event);
-            added = true;
-            break;
-        }
-    }
-    if (!added) {
-        ns_list_add_to_end(&event_queue_active, event);
-    }
+    ns_list_add_to_end(event_queue_get(event), event);
     event->state = ARM_LIB_EVENT_QUEUED;
 
     /* Wake From Idle */
@@ -241,9 +257,11 @@ void event_core_write(arm_event_storage_t *event)
 // Requires lock to be held
 arm_event_storage_t *eventOS_event_find_by_id_critical(uint8_t tasklet_id, uint8_t event_id)
 {
-    ns_list_foreach(arm_event_storage_t, cur, &event_queue_active) {
-        if (cur->data.receiver == tasklet_id && cur->data.event_id == event_id) {
-            return cur;
+    for (uint_fast8_t i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+        ns_list_foreach(arm_event_storage_t, cur, &event_queue_active[i]) {
+            if (cur->data.receiver == tasklet_id && cur->data.event_id == event_id) {
+                return cur;
+            }
         }
     }
 
@@ -261,7 +279,9 @@ void eventOS_scheduler_init(void)
 {
     /* Reset Event List variables */
     ns_list_init(&free_event_entry);
-    ns_list_init(&event_queue_active);
+    for (unsigned i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+        ns_list_init(&event_queue_active[i]);
+    }
     ns_list_init(&arm_core_tasklet_list);
 
     //Add first 10 entries to "free" list
@@ -338,7 +358,18 @@ bool eventOS_scheduler_dispatch_event(void)
      */
 
     /* Tasklet Scheduler Call */
-    tasklet->func_ptr(&cur_event->data);
+    tasklet->stats.event_count++;
+    if (profiling_clock) {
+        uint32_t start = profiling_clock();
+        tasklet->func_ptr(&cur_event->data);
+        uint32_t run_time = profiling_clock() - start;
+        tasklet->stats.run_time += run_time;
+        if (run_time > tasklet->stats.max_run_time) {
+            tasklet->stats.max_run_time = run_time;
+        }
+    } else {
+        tasklet->func_ptr(&cur_event->data);
+    }
     event_core_free_push(cur_event);
 
     /* Set Current Tasklet to Idle state */
@@ -347,6 +378,28 @@ bool eventOS_scheduler_dispatch_event(void)
     return true;
 }
 
+void eventOS_scheduler_profiling_clock_set(uint32_t (*clock)(void))
+{
+    profiling_clock = clock;
+}
+
+int8_t eventOS_scheduler_tasklet_stats_get(int8_t tasklet_id, eventOS_tasklet_stats_t *stats)
+{
+    arm_core_tasklet_t *tasklet = event_tasklet_handler_get(tasklet_id);
+    if (!tasklet || !stats) {
+        return -1;
+    }
+    *stats = tasklet->stats;
+    return 0;
+}
+
+void eventOS_scheduler_tasklet_stats_reset(void)
+{
+    ns_list_foreach(arm_core_tasklet_t, cur, &arm_core_tasklet_list) {
+        memset(&cur->stats, 0, sizeof(cur->stats));
+    }
+}
+
 void eventOS_scheduler_run_until_idle(void)
 {
     while (eventOS_scheduler_dispatch_event());
@@ -40,8 +40,21 @@ NS_STATIC_ASSERT(1000 % EVENTOS_EVENT_TIMER_HZ == 0, "Need whole number of ms pe
 // atomicity on 16-bit platforms
 static volatile uint32_t timer_sys_ticks;
 
+/* Timers due in less than TIMER_WHEEL_SLOTS ticks are kept in the slot of
+ * their launch tick, so adding them and expiring them does not walk a list.
+ * Later timers are kept in a sorted list and move to the wheel when they come
+ * into range. Must be a power of 2.
+ */
+#ifndef TIMER_WHEEL_SLOTS
+#define TIMER_WHEEL_SLOTS           32
+#endif
+NS_STATIC_ASSERT((TIMER_WHEEL_SLOTS & (TIMER_WHEEL_SLOTS - 1)) == 0, "Timer wheel size must be a power of 2")
+
+typedef NS_LIST_HEAD(sys_timer_struct_s, event.link) sys_timer_list_t;
+
 static NS_LIST_DEFINE(system_timer_free, sys_timer_struct_s, event.link);
-static NS_LIST_DEFINE(system_timer_list, sys_timer_struct_s, event.link);
+static sys_timer_list_t NS_LIST_NAME_INIT(system_timer_list);
+static sys_timer_list_t system_timer_wheel[TIMER_WHEEL_SLOTS];
 
 
 static sys_timer_struct_s *sys_timer_dynamically_allocate(void);
@@ -93,6 +106,9 @@ void timer_sys_init(void)
     for (uint8_t i = 0; i < ST_MAX; i++) {
         ns_list_add_to_start(&system_timer_free, &startup_sys_timer_pool[i]);
     }
+    for (uint_fast8_t i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        ns_list_init(&system_timer_wheel[i]);
+    }
 
     platform_tick_timer_register(timer_sys_interrupt);
     platform_tick_timer_start(TIMER_SYS_TICK_PERIOD);
@@ -124,6 +140,15 @@ static void timer_sys_interrupt(void)
 
 /* * * * * * * * * */
 
+/* Called internally with lock held - list holding a pending timer */
+static sys_timer_list_t *timer_sys_list(uint32_t launch_time)
+{
+    if (launch_time - timer_sys_ticks < TIMER_WHEEL_SLOTS) {
+        return &system_timer_wheel[launch_time & (TIMER_WHEEL_SLOTS - 1)];
+    }
+    return &system_timer_list;
+}
+
 static sys_timer_struct_s *sys_timer_dynamically_allocate(void)
 {
     return ns_dyn_mem_alloc(sizeof(sys_timer_struct_s));
@@ -170,7 +195,7 @@ void timer_sys_event_cancel_critical(struct arm_event_storage *event)
     timer->period = 0;
     // If its unqueued it is on my timer list, otherwise it is in event-loop.
     if (event->state == ARM_LIB_EVENT_UNQUEUED) {
-        ns_list_remove(&system_timer_list, timer);
+        ns_list_remove(timer_sys_list(timer->launch_time), timer);
     }
 }
 
@@ -189,6 +214,13 @@ uint32_t eventOS_event_timer_ticks(void)
 static void timer_sys_add(sys_timer_struct_s *timer)
 {
     uint32_t at = timer->launch_time;
+    sys_timer_list_t *list = timer_sys_list(at);
+
+    // All timers of a wheel slot have the same launch time
+    if (list != &system_timer_list) {
+        ns_list_add_to_end(list, timer);
+        return;
+    }
 
     // Find first timer scheduled to run after us, and insert before it.
     // (This means timers scheduled for same time run in order of request)
@@ -307,6 +339,14 @@ int8_t eventOS_event_timer_cancel(uint8_t event_id, int8_t tasklet_id)
     platform_enter_critical();
 
     /* First check pending timers */
+    for (uint_fast8_t i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        ns_list_foreach(sys_timer_struct_s, cur, &system_timer_wheel[i]) {
+            if (cur->event.data.receiver == tasklet_id && cur->event.data.event_id == event_id) {
+                eventOS_cancel(&cur->event);
+                goto done;
+            }
+        }
+    }
     ns_list_foreach(sys_timer_struct_s, cur, &system_timer_list) {
         if (cur->event.data.receiver == tasklet_id && cur->event.data.event_id == event_id) {
             eventOS_cancel(&cur->event);
@@ -335,7 +375,13 @@ uint32_t eventOS_event_timer_shortest_active_timer(void)
     uint32_t ret_val = 0;
 
     platform_enter_critical();
-    sys_timer_struct_s *first = ns_list_get_first(&system_timer_list);
+    sys_timer_struct_s *first = NULL;
+    for (uint_fast8_t i = 1; i < TIMER_WHEEL_SLOTS && !first; i++) {
+        first = ns_list_get_first(&system_timer_wheel[(timer_sys_ticks + i) & (TIMER_WHEEL_SLOTS - 1)]);
+    }
+    if (!first) {
+        first = ns_list_get_first(&system_timer_list);
+    }
     if (first == NULL) {
         // Weird API has 0 for "no events"
         ret_val = 0;
@@ -354,14 +400,33 @@ void system_timer_tick_update(uint32_t ticks)
 {
     platform_enter_critical();
     //Keep runtime time
+    uint32_t slot = timer_sys_ticks;
     timer_sys_ticks += ticks;
-    ns_list_foreach_safe(sys_timer_struct_s, cur, &system_timer_list) {
-        if (TICKS_BEFORE_OR_AT(cur->launch_time, timer_sys_ticks)) {
+
+    // Wheel slots between the old and the new time are all due, and earlier
+    // than any timer of the sorted list
+    if (ticks > TIMER_WHEEL_SLOTS) {
+        ticks = TIMER_WHEEL_SLOTS;
+    }
+    while (ticks--) {
+        sys_timer_list_t *list = &system_timer_wheel[++slot & (TIMER_WHEEL_SLOTS - 1)];
+        ns_list_foreach_safe(sys_timer_struct_s, cur, list) {
             // Unthread from our list
-            ns_list_remove(&system_timer_list, cur);
+            ns_list_remove(list, cur);
             // Make it an event (can't fail - no allocation)
             // event system will call our timer_sys_event_free on event delivery.
             eventOS_event_send_timer_allocated(&cur->event);
+        }
+    }
+
+    ns_list_foreach_safe(sys_timer_struct_s, cur, &system_timer_list) {
+        if (TICKS_BEFORE_OR_AT(cur->launch_time, timer_sys_ticks)) {
+            ns_list_remove(&system_timer_list, cur);
+            eventOS_event_send_timer_allocated(&cur->event);
+        } else if (cur->launch_time - timer_sys_ticks < TIMER_WHEEL_SLOTS) {
+            // Now in range of the wheel
+            ns_list_remove(&system_timer_list, cur);
+            ns_list_add_to_end(&system_timer_wheel[cur->launch_time & (TIMER_WHEEL_SLOTS - 1)], cur);
         } else {
             // List is ordered, so as soon as we see a later event, we're done.
             break;
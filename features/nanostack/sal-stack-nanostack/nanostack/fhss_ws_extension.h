@@ -56,6 +56,24 @@ typedef struct broadcast_timing_info {
     uint32_t bt_rx_timestamp;                   /**< BT-IE reception timestamp */
 } broadcast_timing_info_t;
 
+#ifndef FHSS_WS_UC_CHANNEL_CACHE_SIZE
+#define FHSS_WS_UC_CHANNEL_CACHE_SIZE 8         /**< Number of upcoming unicast channels cached per neighbor */
+#endif
+
+/**
+ * @brief fhss_ws_uc_channel_cache Upcoming unicast channels of a neighbor.
+ *
+ * Filled by FHSS when a frame is sent to the neighbor, starting from the slot of the frame,
+ * and recomputed when the slot is past the cached ones or the unicast schedule has changed.
+ * Empty when zeroed.
+ */
+typedef struct fhss_ws_uc_channel_cache {
+    uint16_t first_slot;                        /**< Unicast slot of the first cached channel */
+    uint16_t number_of_channels;                /**< Number of channels the cache was computed with, 0 when empty */
+    uint8_t channel_function;                   /**< Channel function the cache was computed with */
+    uint8_t channels[FHSS_WS_UC_CHANNEL_CACHE_SIZE]; /**< Channels of consecutive unicast slots */
+} fhss_ws_uc_channel_cache_t;
+
 /**
  * @brief fhss_ws_neighbor_timing_info Neighbor timing/hopping schedule information structure.
  */
@@ -65,6 +83,7 @@ typedef struct fhss_ws_neighbor_timing_info {
     unicast_timing_info_t uc_timing_info;       /**< Neighbor unicast timing info */
     broadcast_timing_info_t bc_timing_info;     /**< Neighbor broadcast timing info */
     uint32_t *excluded_channels;                /**< Neighbor excluded channels (bit mask) */
+    fhss_ws_uc_channel_cache_t uc_channel_cache; /**< Neighbor upcoming unicast channels, maintained by FHSS */
 } fhss_ws_neighbor_timing_info_t;
 
 /**
@@ -51,6 +51,8 @@ typedef struct nwk_stats_t {
     /* Fragments */
     uint32_t frag_rx_errors;        /**< Fragmentation RX error count. */
     uint32_t frag_tx_errors;        /**< Fragmentation TX error count. */
+    uint32_t frag_rx_timeouts;      /**< Reassemblies timed out, also counted as RX errors. */
+    uint32_t frag_rx_evicted;       /**< Reassemblies evicted for a new datagram, also counted as RX errors. */
     /*RPL stats*/
     uint32_t rpl_route_routecost_better_change; /**< RPL parent change count. */
     uint32_t ip_routeloop_detect;               /**< RPL route loop detection count. */
@@ -67,6 +69,7 @@ typedef struct nwk_stats_t {
     uint32_t buf_headroom_realloc;  /**< Buffer headroom realloc count. */
     uint32_t buf_headroom_shuffle;  /**< Buffer headroom shuffle count. */
     uint32_t buf_headroom_fail;     /**< Buffer headroom failure count. */
+    uint32_t buf_pool_hit;          /**< Buffer allocations served by recycled buffers. */
     /* ETX */
     uint16_t etx_1st_parent;        /**< Primary parent ETX. */
     uint16_t etx_2nd_parent;        /**< Secondary parent ETX. */
@@ -584,7 +584,7 @@ int8_t protocol_6lowpan_neighbor_address_state_synch(protocol_interface_info_ent
         if (memcmp(iid, ADDR_SHORT_ADR_SUFFIC, 6) == 0) {
             iid += 6;
             //Set Short Address to MLE
-            entry->mac16 = common_read_16_bit(iid);
+            mac_neighbor_table_mac16_set(mac_neighbor_info(cur), entry, common_read_16_bit(iid));
         }
         if (!entry->ffd_device) {
             if (entry->connected_device) {
@@ -575,20 +575,20 @@ static void mle_neigh_time_and_mode_update(mac_neighbor_table_entry_t *entry_tem
     mac_neighbor_table_neighbor_refresh(mac_neighbor_info(cur), entry_temp, timeout_tlv);
 }
 
-static void mle_neigh_entry_update_by_mle_tlv_list(int8_t interface_id, mac_neighbor_table_entry_t *entry_temp, uint8_t *tlv_ptr, uint16_t tlv_length, uint8_t *mac64, uint16_t short_address)
+static void mle_neigh_entry_update_by_mle_tlv_list(protocol_interface_info_entry_t *cur, mac_neighbor_table_entry_t *entry_temp, uint8_t *tlv_ptr, uint16_t tlv_length, uint8_t *mac64, uint16_t short_address)
 {
     mle_tlv_info_t mle_tlv_info;
 
     if (tlv_length) {
         if (mle_tlv_option_discover(tlv_ptr, tlv_length, MLE_TYPE_SRC_ADDRESS, &mle_tlv_info) > 0) {
-            entry_temp->mac16 = common_read_16_bit(mle_tlv_info.dataPtr);
+            mac_neighbor_table_mac16_set(mac_neighbor_info(cur), entry_temp, common_read_16_bit(mle_tlv_info.dataPtr));
         }
 
         if (mle_tlv_option_discover(tlv_ptr, tlv_length, MLE_TYPE_LINK_QUALITY, &mle_tlv_info) > 0) {
             uint8_t link_idr;
             uint8_t iop_flags;
             if (mle_link_quality_tlv_parse(mac64, short_address, mle_tlv_info.dataPtr, mle_tlv_info.tlvLen, &iop_flags, &link_idr)) {
-                etx_remote_incoming_idr_update(interface_id, link_idr, entry_temp->index);
+                etx_remote_incoming_idr_update(cur->id, link_idr, entry_temp->index);
 
                 if ((iop_flags & MLE_NEIGHBOR_PRIORITY_LINK) == MLE_NEIGHBOR_PRIORITY_LINK) {
                     entry_temp->link_role = CHILD_NEIGHBOUR;
@@ -1058,7 +1058,7 @@ void mle_6lowpan_message_handler(int8_t interface_id, mle_message_t *mle_msg, ml
                 entry_temp = mac_neighbor_entry_get_by_ll64(mac_neighbor_info(cur), mle_msg->packet_src_address, false, NULL);
                 if (entry_temp) {
                     mle_neigh_time_and_mode_update(entry_temp, mle_msg);
-                    mle_neigh_entry_update_by_mle_tlv_list(interface_id, entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur->mac, own_mac16);
+                    mle_neigh_entry_update_by_mle_tlv_list(cur, entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur->mac, own_mac16);
                     mle_neigh_entry_frame_counter_update(entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur, security_headers->KeyIndex);
                 } else {
                     if (!mle_6lowpan_neighbor_limit_check(mle_msg, false)) {
@@ -1121,12 +1121,12 @@ void mle_6lowpan_message_handler(int8_t interface_id, mle_message_t *mle_msg, ml
                     entry_temp->link_role = PRIORITY_PARENT_NEIGHBOUR;
                 }
 
-                mle_neigh_entry_update_by_mle_tlv_list(cur->id, entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur->mac, own_mac16);
+                mle_neigh_entry_update_by_mle_tlv_list(cur, entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur->mac, own_mac16);
                 incoming_idr = mle_calculate_idr(cur->id, mle_msg, entry_temp);
                 uint8_t priority = (entry_temp->link_role == PRIORITY_PARENT_NEIGHBOUR);
                 mle_router_accept_request_build(cur, mle_msg, mle_challenge.dataPtr, mle_challenge.tlvLen, MLE_COMMAND_ACCEPT, incoming_idr, priority);
             } else {
-                mle_neigh_entry_update_by_mle_tlv_list(cur->id, entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur->mac, own_mac16);
+                mle_neigh_entry_update_by_mle_tlv_list(cur, entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur->mac, own_mac16);
                 incoming_idr = mle_calculate_idr(cur->id, mle_msg, entry_temp);
             }
             mle_neigh_entry_frame_counter_update(entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur, security_headers->KeyIndex);
@@ -1199,7 +1199,7 @@ void mle_6lowpan_message_handler(int8_t interface_id, mle_message_t *mle_msg, ml
                 }
 
                 //UPDATE
-                mle_neigh_entry_update_by_mle_tlv_list(cur->id, entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur->mac, own_mac16);
+                mle_neigh_entry_update_by_mle_tlv_list(cur, entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur->mac, own_mac16);
                 mle_neigh_entry_frame_counter_update(entry_temp, mle_msg->data_ptr, mle_msg->data_length, cur, security_headers->KeyIndex);
                 if (entry_temp->connected_device) {
                     mac_neighbor_table_neighbor_refresh(mac_neighbor_info(cur), entry_temp, entry_temp->link_lifetime);
@@ -249,7 +249,17 @@ static reassembly_entry_t *lowpan_adaptation_reassembly_get(reassembly_interface
 {
     reassembly_entry_t *entry = ns_list_get_first(&interface_ptr->free_list);
     if (!entry) {
-        return NULL;
+        /* All sessions busy - the list is kept in order of activity, so the
+         * last one is the most likely to have lost a fragment */
+        entry = ns_list_get_last(&interface_ptr->rx_list);
+        if (!entry) {
+            return NULL;
+        }
+        protocol_stats_update(STATS_FRAG_RX_EVICT, 1);
+        tr_debug("Reassembly evict: src %s size %u",
+                 trace_sockaddr(&entry->buf->src_sa, true),
+                 entry->size);
+        reassembly_entry_free(interface_ptr, entry);
     }
 
     ns_list_remove(&interface_ptr->free_list, entry);
@@ -330,6 +340,10 @@ buffer_t *cipv6_frag_reassembly(int8_t interface_id, buffer_t *buf)
         frag_ptr->offset = 0xffff;
         create_hole(reassembly_buffer, 0, datagram_size - 1, &frag_ptr->offset);
         frag_ptr->buf = reassembly_buffer;
+    } else if (frag_ptr != ns_list_get_first(&interface_ptr->rx_list)) {
+        /* Keep the most recently active reassembly first */
+        ns_list_remove(&interface_ptr->rx_list, frag_ptr);
+        ns_list_add_to_start(&interface_ptr->rx_list, frag_ptr);
     }
 
     /* For the first link fragment, work out and remember the "pattern"
@@ -456,7 +470,7 @@ static void reassembly_entry_timer_update(reassembly_interface_t *interface_ptr,
         if (reassembly_entry->ttl > seconds) {
             reassembly_entry->ttl -= seconds;
         } else {
-            protocol_stats_update(STATS_FRAG_RX_ERROR, 1);
+            protocol_stats_update(STATS_FRAG_RX_TIMEOUT, 1);
             tr_debug("Reassembly TO: src %s size %u",
                      trace_sockaddr(&reassembly_entry->buf->src_sa, true),
                      reassembly_entry->size);
@@ -17,6 +17,17 @@
 #ifndef CIPV6_FRAGMENTER_H
 #define CIPV6_FRAGMENTER_H
 
+/* Concurrent reassemblies per interface. When all are in use, the least
+ * recently active one is evicted to start a new datagram.
+ */
+#ifndef LOWPAN_REASSEMBLY_SESSION_LIMIT
+#define LOWPAN_REASSEMBLY_SESSION_LIMIT 8
+#endif
+
+#ifndef LOWPAN_REASSEMBLY_TIMEOUT
+#define LOWPAN_REASSEMBLY_TIMEOUT 5
+#endif
+
 struct buffer;
 int8_t reassembly_interface_reset(int8_t interface_id);
 int8_t reassembly_interface_init(int8_t interface_id, uint8_t reassembly_session_limit, uint16_t reassembly_timeout);
@@ -277,7 +277,7 @@ int mac_pairwise_key_add(int8_t interface_id, uint32_t valid_life_time, const ui
     }
 
     mac_neighbor_table_trusted_neighbor(mac_neighbor_info(interface), mac_entry, true);
-    mac_entry->mac16 = 0xffff;
+    mac_neighbor_table_mac16_set(mac_neighbor_info(interface), mac_entry, 0xffff);
 
     //Allocate key description
 
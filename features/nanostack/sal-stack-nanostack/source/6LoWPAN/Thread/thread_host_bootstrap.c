@@ -166,7 +166,7 @@ static bool thread_parent_discover_timeout_cb(int8_t interface_id, uint16_t msgI
         thread_neighbor_class_update_link(&cur->thread_info->neighbor_class, entry_temp->index, parent->linkMarginToParent, new_entry_created);
         thread_neighbor_last_communication_time_update(&cur->thread_info->neighbor_class, entry_temp->index);
 
-        entry_temp->mac16 = parent->shortAddress;
+        mac_neighbor_table_mac16_set(mac_neighbor_info(cur), entry_temp, parent->shortAddress);
         entry_temp->link_role = PRIORITY_PARENT_NEIGHBOUR;
 
         mle_service_frame_counter_entry_add(interface_id, entry_temp->index, parent->mleFrameCounter);
@@ -371,7 +371,7 @@ static int thread_end_device_synch_response_validate(protocol_interface_info_ent
     /*
 
     */
-    entry_temp->mac16 = srcAddress;
+    mac_neighbor_table_mac16_set(mac_neighbor_info(cur), entry_temp, srcAddress);
     entry_temp->connected_device = 1;
     entry_temp->link_role = PRIORITY_PARENT_NEIGHBOUR; // Make this our parent
     common_write_16_bit(entry_temp->mac16, shortAddress);
@@ -984,7 +984,7 @@ void thread_endevice_synch_start(protocol_interface_info_entry_t *cur)
             thread_neighbor_class_update_link(&cur->thread_info->neighbor_class, mac_entry->index, 64, new_entry_created);
             thread_neighbor_last_communication_time_update(&cur->thread_info->neighbor_class, mac_entry->index);
 
-            mac_entry->mac16 = cur->thread_info->thread_endnode_parent->shortAddress;
+            mac_neighbor_table_mac16_set(mac_neighbor_info(cur), mac_entry, cur->thread_info->thread_endnode_parent->shortAddress);
             mac_entry->connected_device = 1;
 
             // In case we don't get response to sync; use temporary timeout here,
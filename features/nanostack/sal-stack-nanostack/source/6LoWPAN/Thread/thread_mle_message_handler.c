@@ -288,7 +288,7 @@ static void thread_update_mle_entry(protocol_interface_info_entry_t *cur, mle_me
             thread_dynamic_storage_child_info_clear(cur->id, entry_temp);
             protocol_6lowpan_release_short_link_address_from_neighcache(cur, entry_temp->mac16);
         }
-        entry_temp->mac16 = short_address;
+        mac_neighbor_table_mac16_set(mac_neighbor_info(cur), entry_temp, short_address);
         /* throw MLME_GET request, short address is changed automatically in get request callback */
         mlme_get_t get_req;
         get_req.attr = macDeviceTable;
@@ -458,7 +458,7 @@ static void thread_parse_accept(protocol_interface_info_entry_t *cur, mle_messag
         mleFrameCounter = llFrameCounter;
     }
 
-    entry_temp->mac16 = shortAddress;
+    mac_neighbor_table_mac16_set(mac_neighbor_info(cur), entry_temp, shortAddress);
     mle_service_frame_counter_entry_add(cur->id, entry_temp->index, mleFrameCounter);
     // Set full data as REED needs full data and SED will not make links
     thread_neighbor_class_request_full_data_setup_set(&cur->thread_info->neighbor_class, entry_temp->index, true);
@@ -271,7 +271,7 @@ void thread_dynamic_storage_build_mle_table(int8_t interface_id)
         mac_neighbor_table_entry_t *mac_entry = mac_neighbor_entry_get_by_mac64(mac_neighbor_info(cur), mac64, true, &new_entry_created);
         if (mac_entry) {
 
-            mac_entry->mac16 = storeEntry->networ_dynamic_data_parameters.children[i].short_addr;
+            mac_neighbor_table_mac16_set(mac_neighbor_info(cur), mac_entry, storeEntry->networ_dynamic_data_parameters.children[i].short_addr);
             mle_service_frame_counter_entry_add(interface_id, mac_entry->index, storeEntry->networ_dynamic_data_parameters.children[i].mle_frame_counter);
             mle_mode_parse_to_mac_entry(mac_entry, storeEntry->networ_dynamic_data_parameters.children[i].mode);
 
@@ -358,7 +358,7 @@ static void thread_router_synch_receive_cb(int8_t interface_id, mle_message_t *m
 
             //Free Response
             mle_service_msg_free(messageId);
-            entry_temp->mac16 = shortAddress;
+            mac_neighbor_table_mac16_set(mac_neighbor_info(cur), entry_temp, shortAddress);
 
             //when allocating neighbour entry, use MLE Frame counter if present to validate further advertisements from the neighbour
             mle_service_frame_counter_entry_add(cur->id, entry_temp->index, mleFrameCounter);
@@ -1286,7 +1286,7 @@ static bool thread_child_id_request(protocol_interface_info_entry_t *cur, struct
 
     //allocate child address if current is router, 0xffff or not our child
     if (!thread_addr_is_child(mac_helper_mac16_address_get(cur), entry_temp->mac16)) {
-        entry_temp->mac16 = thread_router_bootstrap_child_address_generate(cur);
+        mac_neighbor_table_mac16_set(mac_neighbor_info(cur), entry_temp, thread_router_bootstrap_child_address_generate(cur));
     }
 
     if (entry_temp->mac16 >= 0xfffe) {
@@ -1822,7 +1822,7 @@ void thread_router_bootstrap_mle_receive_cb(int8_t interface_id, mle_message_t *
                     protocol_6lowpan_release_short_link_address_from_neighcache(cur, entry_temp->mac16);
                 }
                 update_mac_mib = true;
-                entry_temp->mac16 = shortAddress; // short address refreshed
+                mac_neighbor_table_mac16_set(mac_neighbor_info(cur), entry_temp, shortAddress); // short address refreshed
 
                 if (thread_is_router_addr(shortAddress)) {
                     // Set full data as REED/Router needs full data (SED will not make links)
@@ -1920,7 +1920,7 @@ void thread_router_bootstrap_mle_receive_cb(int8_t interface_id, mle_message_t *
                     thread_management_key_synch_req(cur->id, common_read_32_bit(security_headers->Keysource));
                 }
 
-                entry_temp->mac16 = shortAddress;
+                mac_neighbor_table_mac16_set(mac_neighbor_info(cur), entry_temp, shortAddress);
                 mlme_device_descriptor_t device_desc;
                 mac_helper_device_description_write(cur, &device_desc, entry_temp->mac64, entry_temp->mac16, llFrameCounter, false);
                 mac_helper_devicetable_set(&device_desc, cur, entry_temp->index, security_headers->KeyIndex, new_entry);
@@ -32,6 +32,57 @@
 
 volatile unsigned int buffer_count = 0;
 
+#if BUFFER_POOL_COUNT
+/* Freed buffers of BUFFER_POOL_DATA_SIZE, kept to save a heap allocation and
+ * a free for each frame received and forwarded */
+static NS_LIST_DEFINE(buffer_pool, buffer_t, link);
+static uint8_t buffer_pool_count;
+#endif
+
+/* Allocate a buffer_t with total_size bytes of data, total_size being
+ * updated if rounded up to the pool size */
+static buffer_t *buffer_alloc(uint16_t *total_size)
+{
+#if BUFFER_POOL_COUNT
+    if (*total_size >= BUFFER_DEFAULT_MIN_SIZE && *total_size <= BUFFER_POOL_DATA_SIZE) {
+        *total_size = BUFFER_POOL_DATA_SIZE;
+
+        platform_enter_critical();
+        buffer_t *buf = ns_list_get_first(&buffer_pool);
+        if (buf) {
+            ns_list_remove(&buffer_pool, buf);
+            buffer_pool_count--;
+        }
+        platform_exit_critical();
+
+        if (buf) {
+            protocol_stats_update(STATS_BUFFER_POOL_HIT, 1);
+            return buf;
+        }
+    }
+#endif
+
+    return ns_dyn_mem_temporary_alloc(sizeof(buffer_t) + *total_size);
+}
+
+/* Release the memory of a buffer_t, its metadata pointers already freed */
+static void buffer_release(buffer_t *buf)
+{
+#if BUFFER_POOL_COUNT
+    if (buf->size == BUFFER_POOL_DATA_SIZE) {
+        platform_enter_critical();
+        if (buffer_pool_count < BUFFER_POOL_COUNT) {
+            ns_list_add_to_start(&buffer_pool, buf);
+            buffer_pool_count++;
+            buf = NULL;
+        }
+        platform_exit_critical();
+    }
+#endif
+
+    ns_dyn_mem_free(buf);
+}
+
 uint8_t *(buffer_corrupt_check)(buffer_t *buf)
 {
     if (buf == NULL) {
@@ -86,7 +137,7 @@ buffer_t *buffer_get_specific(uint16_t headroom, uint16_t size, uint16_t minspac
     // Note - as well as this alloc+init, buffers can also be "realloced"
     // in buffer_headroom()
 
-    buf = ns_dyn_mem_temporary_alloc(sizeof(buffer_t) + total_size);
+    buf = buffer_alloc(&total_size);
     if (buf) {
         platform_enter_critical();
         buffer_count++;
@@ -133,7 +184,7 @@ buffer_t *buffer_headroom(buffer_t *buf, uint16_t size)
         /* This buffer isn't big enough at all - allocate a new block */
         // TODO - should we be giving them extra? probably
         uint16_t new_total = (curr_len + size + 3) & ~ 3;
-        buffer_t *restrict new_buf = ns_dyn_mem_temporary_alloc(sizeof(buffer_t) + new_total);
+        buffer_t *restrict new_buf = buffer_alloc(&new_total);
         if (new_buf) {
             // Copy the buffer_t header
             *new_buf = *buf;
@@ -144,7 +195,7 @@ buffer_t *buffer_headroom(buffer_t *buf, uint16_t size)
             // Copy the current data
             memcpy(buffer_data_pointer(new_buf), buffer_data_pointer(buf), curr_len);
             protocol_stats_update(STATS_BUFFER_HEADROOM_REALLOC, 1);
-            ns_dyn_mem_free(buf);
+            buffer_release(buf);
             buf = new_buf;
         } else {
             tr_error("HeadRoom Fail");
@@ -200,7 +251,7 @@ buffer_t *buffer_free(buffer_t *buf)
         socket_dereference(buf->socket);
         ns_dyn_mem_free(buf->predecessor);
         ns_dyn_mem_free(buf->rpl_option);
-        ns_dyn_mem_free(buf);
+        buffer_release(buf);
 
     } else {
         tr_error("nullp F");
@@ -61,6 +61,22 @@
  */
 #define BUFFER_DEFAULT_MIN_SIZE     127
 
+/*
+ * data size of the freed buffers kept for reuse, enough for a default buffer
+ * holding an IEEE 802.15.4 frame. Buffers with a size from
+ * BUFFER_DEFAULT_MIN_SIZE up to this are rounded up to it.
+ */
+#ifndef BUFFER_POOL_DATA_SIZE
+#define BUFFER_POOL_DATA_SIZE       ((BUFFER_DEFAULT_HEADROOM + BUFFER_DEFAULT_MIN_SIZE + 3) & ~3)
+#endif
+
+/*
+ * maximum number of freed buffers kept for reuse, 0 to disable the pool.
+ */
+#ifndef BUFFER_POOL_COUNT
+#define BUFFER_POOL_COUNT           4
+#endif
+
 /* The new, really-configurable default hop limit (RFC 4861 CurHopLimit);
  * this can be overridden at compile-time, or changed on a per-socket basis
  * with socket_setsockopt. It can also be overridden by Router Advertisements.
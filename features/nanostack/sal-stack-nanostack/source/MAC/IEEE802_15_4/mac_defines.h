@@ -29,6 +29,11 @@ struct mlme_key_descriptor_s;
 struct arm_device_driver_list;
 struct fhss_api;
 
+/* Indirect frames are queued per child address hash, must be a power of 2 */
+#ifndef MAC_INDIRECT_QUEUE_BUCKETS
+#define MAC_INDIRECT_QUEUE_BUCKETS 8
+#endif
+
 typedef enum mac_event_t {
     MAC_STATE_IDLE = 0,
     MAC_TX_DONE,
@@ -223,9 +228,10 @@ typedef struct protocol_interface_rf_mac_setup {
     uint8_t number_of_csma_ca_periods;  /**< Number of CSMA-CA periods */
     uint16_t multi_cca_interval;        /**< Length of the additional CSMA-CA period(s) in microseconds */
     /* Indirect queue parameters */
-    struct mac_pre_build_frame *indirect_pd_data_request_queue;
+    struct mac_pre_build_frame *indirect_pd_data_request_queue[MAC_INDIRECT_QUEUE_BUCKETS];
     arm_event_t mac_mcps_timer_event;
     uint16_t indirect_pending_bytes;
+    uint16_t indirect_frame_count;
     arm_nwk_mlme_event_type_e mac_mlme_event;
     mac_event_t timer_mac_event;
     mac_event_t mac_tx_result;
@@ -41,6 +41,40 @@
 #define TRACE_GROUP_MAC_INDIR "mInD"
 #define TRACE_GROUP "mInD"
 
+static uint8_t mac_indirect_queue_bucket(uint8_t addr_mode, const uint8_t *address)
+{
+    uint8_t len = addr_mode == MAC_ADDR_MODE_16_BIT ? 2 : 8;
+    uint8_t hash = 0;
+    while (len--) {
+        hash ^= *address++;
+    }
+    return hash & (MAC_INDIRECT_QUEUE_BUCKETS - 1);
+}
+
+/* Returns the link to the oldest frame queued for the address, or NULL */
+static mac_pre_build_frame_t **mac_indirect_queue_find(protocol_interface_rf_mac_setup_s *mac_ptr, uint8_t addr_mode, const uint8_t *address)
+{
+    uint8_t len = addr_mode == MAC_ADDR_MODE_16_BIT ? 2 : 8;
+    mac_pre_build_frame_t **link = &mac_ptr->indirect_pd_data_request_queue[mac_indirect_queue_bucket(addr_mode, address)];
+    while (*link) {
+        if ((*link)->fcf_dsn.DstAddrMode == addr_mode && memcmp((*link)->DstAddr, address, len) == 0) {
+            return link;
+        }
+        link = &(*link)->next;
+    }
+    return NULL;
+}
+
+static mac_pre_build_frame_t *mac_indirect_queue_unlink(protocol_interface_rf_mac_setup_s *mac_ptr, mac_pre_build_frame_t **link)
+{
+    mac_pre_build_frame_t *b = *link;
+    *link = b->next;
+    b->next = NULL;
+    mac_ptr->indirect_pending_bytes -= b->mac_payload_length;
+    mac_ptr->indirect_frame_count--;
+    return b;
+}
+
 void mac_indirect_data_ttl_handle(protocol_interface_rf_mac_setup_s *cur, uint16_t tick_value)
 {
     if (!cur || !cur->dev_driver) {
@@ -50,7 +84,7 @@ void mac_indirect_data_ttl_handle(protocol_interface_rf_mac_setup_s *cur, uint16
     memset(&confirm, 0, sizeof(mcps_data_conf_t));
 
     phy_device_driver_s *dev_driver = cur->dev_driver->phy_driver;
-    if (!cur->indirect_pd_data_request_queue) {
+    if (!cur->indirect_frame_count) {
         uint8_t value = 0;
         if (dev_driver && dev_driver->extension) {
             dev_driver->extension(PHY_EXTENSION_CTRL_PENDING_BIT, &value);
@@ -58,42 +92,34 @@ void mac_indirect_data_ttl_handle(protocol_interface_rf_mac_setup_s *cur, uint16
         cur->mac_frame_pending = false;
         return;
     }
-    mac_pre_build_frame_t *buf, *buf_prev = 0, *buf_temp = 0;
 
     mac_api_t *api = get_sw_mac_api(cur);
     if (!api) {
         return;
     }
 
-    buf = cur->indirect_pd_data_request_queue;
-
     tick_value /= 20; //Covert time ms
     if (tick_value == 0) {
         tick_value = 1;
     }
 
-    while (buf) {
-        if (buf->buffer_ttl > tick_value) {
-            buf->buffer_ttl -= tick_value;
-            buf_prev = buf;
-            buf = buf->next;
-        } else {
-            buf->buffer_ttl = 0;
-            if (buf_prev) {
-                buf_prev->next = buf->next;
-            } else {
-                cur->indirect_pd_data_request_queue = buf->next;
+    for (uint8_t i = 0; i < MAC_INDIRECT_QUEUE_BUCKETS; i++) {
+        mac_pre_build_frame_t **link = &cur->indirect_pd_data_request_queue[i];
+        while (*link) {
+            mac_pre_build_frame_t *buf = *link;
+            if (buf->buffer_ttl > tick_value) {
+                buf->buffer_ttl -= tick_value;
+                link = &buf->next;
+                continue;
             }
 
-            confirm.msduHandle = buf->msduHandle;
-            buf_temp = buf;
-            buf = buf->next;
-            buf_temp->next = NULL;
-            cur->indirect_pending_bytes -= buf_temp->mac_payload_length;
+            buf->buffer_ttl = 0;
+            mac_indirect_queue_unlink(cur, link);
 
+            confirm.msduHandle = buf->msduHandle;
             confirm.status = MLME_TRANSACTION_EXPIRED;
 
-            mcps_sap_prebuild_frame_buffer_free(buf_temp);
+            mcps_sap_prebuild_frame_buffer_free(buf);
 
             if (cur->mac_extension_enabled) {
                 mcps_data_conf_payload_t data_conf;
@@ -149,64 +175,36 @@ uint8_t mac_indirect_data_req_handle(mac_pre_parsed_frame_t *buf, protocol_inter
     /* If the Ack we sent for the Data Request didn't have frame pending set, we shouldn't transmit - child may have slept */
     if (!buf->ack_pendinfg_status) {
         //tr_debug("Drop by pending");
-        if (mac_ptr->indirect_pd_data_request_queue) {
+        if (mac_ptr->indirect_frame_count) {
             tr_error("Wrongly dropped");
         }
         //Free Buffer
         return 1;
     }
 
-    uint8_t address_cmp_ok = 0;
-    uint8_t len;
-    mac_pre_build_frame_t *b_prev = NULL;
-
-    if (buf->fcf_dsn.SrcAddrMode == MAC_ADDR_MODE_16_BIT) {
-        len = 2;
+    mac_pre_build_frame_t **link;
+    if (buf->neigh_info) {
+        /* Frames can be addressed to either address of a known child */
+        uint8_t short_address[2];
+        common_write_16_bit(buf->neigh_info->ShortAddress, short_address);
+        link = mac_indirect_queue_find(mac_ptr, MAC_ADDR_MODE_16_BIT, short_address);
+        mac_pre_build_frame_t **ext_link = mac_indirect_queue_find(mac_ptr, MAC_ADDR_MODE_64_BIT, buf->neigh_info->ExtAddress);
+        /* TTL counts down from the same value, so the oldest frame has the lowest */
+        if (!link || (ext_link && (*ext_link)->buffer_ttl < (*link)->buffer_ttl)) {
+            link = ext_link;
+        }
     } else {
-        len = 8;
+        link = mac_indirect_queue_find(mac_ptr, buf->fcf_dsn.SrcAddrMode, srcAddress);
     }
 
-    mac_pre_build_frame_t *b = mac_ptr->indirect_pd_data_request_queue;
-    while (b) {
-
-        if (buf->neigh_info) {
-            uint16_t compare_short;
-            if (b->fcf_dsn.DstAddrMode == MAC_ADDR_MODE_16_BIT) {
-
-                compare_short = common_read_16_bit(b->DstAddr);
-                if (compare_short == buf->neigh_info->ShortAddress) {
-                    address_cmp_ok = 1;
-                }
-            } else {
-                if (memcmp(b->DstAddr, buf->neigh_info->ExtAddress, 8) == 0) {
-                    address_cmp_ok = 1;
-                }
-            }
-        } else {
-            if (b->fcf_dsn.DstAddrMode == buf->fcf_dsn.SrcAddrMode) {
-                if (memcmp(b->DstAddr, srcAddress, len) == 0) {
-                    address_cmp_ok = 1;
-                }
-            }
-        }
-
-        if (address_cmp_ok) {
-            if (b_prev) {
-                b_prev->next = b->next;
-
-            } else {
-                mac_ptr->indirect_pd_data_request_queue = b->next;
-            }
-            b->next = NULL;
-            b->priority = MAC_PD_DATA_MEDIUM_PRIORITY;
-            mcps_sap_pd_req_queue_write(mac_ptr, b);
-            return 1;
-        } else {
-            b_prev = b;
-            b = b->next;
-        }
+    if (!link) {
+        return 0;
     }
-    return 0;
+
+    mac_pre_build_frame_t *b = mac_indirect_queue_unlink(mac_ptr, link);
+    b->priority = MAC_PD_DATA_MEDIUM_PRIORITY;
+    mcps_sap_pd_req_queue_write(mac_ptr, b);
+    return 1;
 }
 
 void mac_indirect_queue_write(protocol_interface_rf_mac_setup_s *rf_mac_setup, mac_pre_build_frame_t *buffer)
@@ -218,8 +216,7 @@ void mac_indirect_queue_write(protocol_interface_rf_mac_setup_s *rf_mac_setup, m
     buffer->next = NULL;
     buffer->buffer_ttl = 7100;
     //Push to queue
-    if (!rf_mac_setup->indirect_pd_data_request_queue) {
-        rf_mac_setup->indirect_pd_data_request_queue = buffer;
+    if (!rf_mac_setup->indirect_frame_count++) {
         //Trig timer and set pending flag to radio
         eventOS_callback_timer_stop(rf_mac_setup->mac_mcps_timer);
         eventOS_callback_timer_start(rf_mac_setup->mac_mcps_timer, MAC_INDIRECT_TICK_IN_MS * 20);
@@ -228,16 +225,36 @@ void mac_indirect_queue_write(protocol_interface_rf_mac_setup_s *rf_mac_setup, m
             uint8_t value = 1;
             rf_mac_setup->dev_driver->phy_driver->extension(PHY_EXTENSION_CTRL_PENDING_BIT, &value);
         }
-        return;
     }
 
-    mac_pre_build_frame_t *cur = rf_mac_setup->indirect_pd_data_request_queue;
-    while (cur) {
-        if (cur->next == NULL) {
-            cur->next = buffer;
-            cur = NULL;
-        } else {
-            cur = cur->next;
+    mac_pre_build_frame_t **link = &rf_mac_setup->indirect_pd_data_request_queue[mac_indirect_queue_bucket(buffer->fcf_dsn.DstAddrMode, buffer->DstAddr)];
+    while (*link) {
+        link = &(*link)->next;
+    }
+    *link = buffer;
+}
+
+bool mac_indirect_queue_purge(protocol_interface_rf_mac_setup_s *rf_mac_setup, uint8_t msduhandle)
+{
+    for (uint8_t i = 0; i < MAC_INDIRECT_QUEUE_BUCKETS; i++) {
+        mac_pre_build_frame_t **link = &rf_mac_setup->indirect_pd_data_request_queue[i];
+        while (*link) {
+            if ((*link)->fcf_dsn.frametype == MAC_FRAME_DATA && (*link)->msduHandle == msduhandle) {
+                mcps_sap_prebuild_frame_buffer_free(mac_indirect_queue_unlink(rf_mac_setup, link));
+                return true;
+            }
+            link = &(*link)->next;
+        }
+    }
+    return false;
+}
+
+void mac_indirect_queue_free(protocol_interface_rf_mac_setup_s *rf_mac_setup)
+{
+    for (uint8_t i = 0; i < MAC_INDIRECT_QUEUE_BUCKETS; i++) {
+        mac_pre_build_frame_t **link = &rf_mac_setup->indirect_pd_data_request_queue[i];
+        while (*link) {
+            mcps_sap_prebuild_frame_buffer_free(mac_indirect_queue_unlink(rf_mac_setup, link));
         }
     }
 }
@@ -26,6 +26,8 @@ typedef enum {
     STATS_IP_CKSUM_ERROR,
     STATS_FRAG_RX_ERROR,
     STATS_FRAG_TX_ERROR,
+    STATS_FRAG_RX_TIMEOUT,
+    STATS_FRAG_RX_EVICT,
     STATS_RPL_PARENT_CHANGE,
     STATS_RPL_ROUTELOOP,
     // RFC 6550 S18.5 stats
@@ -42,6 +44,7 @@ typedef enum {
     STATS_BUFFER_HEADROOM_REALLOC,
     STATS_BUFFER_HEADROOM_SHUFFLE,
     STATS_BUFFER_HEADROOM_FAIL,
+    STATS_BUFFER_POOL_HIT,
     STATS_ETX_1ST_PARENT,
     STATS_ETX_2ND_PARENT,
 
@@ -579,7 +579,7 @@ static protocol_interface_info_entry_t *protocol_core_interface_6lowpan_entry_ge
         goto interface_failure;
     }
 
-    if (reassembly_interface_init(entry->id, 8, 5) != 0) {
+    if (reassembly_interface_init(entry->id, LOWPAN_REASSEMBLY_SESSION_LIMIT, LOWPAN_REASSEMBLY_TIMEOUT) != 0) {
         goto interface_failure;
     }
 
@@ -75,6 +75,16 @@ void protocol_stats_update(nwk_stats_type_t type, uint16_t update_val)
                 nwk_stats_ptr->frag_tx_errors++;
                 break;
 
+            case STATS_FRAG_RX_TIMEOUT:
+                nwk_stats_ptr->frag_rx_timeouts++;
+                nwk_stats_ptr->frag_rx_errors++;
+                break;
+
+            case STATS_FRAG_RX_EVICT:
+                nwk_stats_ptr->frag_rx_evicted++;
+                nwk_stats_ptr->frag_rx_errors++;
+                break;
+
             case STATS_RPL_PARENT_CHANGE:
                 nwk_stats_ptr->rpl_route_routecost_better_change++;
                 break;
@@ -139,6 +149,10 @@ void protocol_stats_update(nwk_stats_type_t type, uint16_t update_val)
                 nwk_stats_ptr->buf_headroom_fail++;
                 break;
 
+            case STATS_BUFFER_POOL_HIT:
+                nwk_stats_ptr->buf_pool_hit++;
+                break;
+
             case STATS_ETX_1ST_PARENT:
                 nwk_stats_ptr->etx_1st_parent = update_val;
                 break;
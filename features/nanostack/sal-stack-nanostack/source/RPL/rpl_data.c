@@ -51,15 +51,26 @@
 
 #define RPL_DATA_SR_INIT_SIZE (16*4)
 
+/* Number of source routes remembered by the root, indexed by a hash of the
+ * final destination. Must be a power of 2.
+ */
+#ifndef RPL_DATA_SR_CACHE_SIZE
+#define RPL_DATA_SR_CACHE_SIZE 16
+#endif
+
 #ifdef HAVE_RPL_ROOT
 typedef struct rpl_data_sr {
     rpl_dao_target_t *target;   /* Target - note may be a prefix */
     uint16_t iaddr_size;
     uint8_t ihops;          /* Number of intermediate hops (= addresses in SRH) */
-    uint8_t final_dest[16]; /* Final destination (used only temporarily during header construction) */
+    uint8_t final_dest[16]; /* Final destination (cache key while target is set) */
     uint8_t iaddr[];        /* Intermediate address list is built backwards, contiguous with final_dest */
 } rpl_data_sr_t;
 
+/* Source routes computed since the last change of the paths */
+static rpl_data_sr_t *rpl_data_sr_cache[RPL_DATA_SR_CACHE_SIZE];
+
+/* Entry of the last rpl_data_compute_source_route() call */
 static rpl_data_sr_t *rpl_data_sr;
 #endif
 
@@ -682,16 +693,30 @@ not_forwarding_error:
 
 #ifdef HAVE_RPL_ROOT
 /* TODO - every target involved here should be non-External. Add checks */
+static uint_fast8_t rpl_data_sr_cache_index(const uint8_t *final_dest)
+{
+    /* Nodes of a DODAG usually share the prefix, so hash the IID */
+    uint8_t hash = 0;
+    for (uint_fast8_t i = 8; i < 16; i++) {
+        hash = (hash * 31) ^ final_dest[i];
+    }
+    return (hash ^ (hash >> 4)) & (RPL_DATA_SR_CACHE_SIZE - 1);
+}
+
 static bool rpl_data_compute_source_route(const uint8_t *final_dest, rpl_dao_target_t *const target)
 {
-    if (!rpl_data_sr) {
-        rpl_data_sr = rpl_alloc(sizeof(rpl_data_sr_t) + RPL_DATA_SR_INIT_SIZE);
-        if (!rpl_data_sr) {
+    rpl_data_sr_t **slot = &rpl_data_sr_cache[rpl_data_sr_cache_index(final_dest)];
+
+    if (!*slot) {
+        *slot = rpl_alloc(sizeof(rpl_data_sr_t) + RPL_DATA_SR_INIT_SIZE);
+        if (!*slot) {
             return false;
         }
-        rpl_data_sr->iaddr_size = RPL_DATA_SR_INIT_SIZE;
-        rpl_data_sr->target = NULL;
-    } else if (rpl_data_sr->target == target && addr_ipv6_equal(rpl_data_sr->final_dest, final_dest)) {
+        (*slot)->iaddr_size = RPL_DATA_SR_INIT_SIZE;
+        (*slot)->target = NULL;
+    }
+    rpl_data_sr = *slot;
+    if (rpl_data_sr->target == target && addr_ipv6_equal(rpl_data_sr->final_dest, final_dest)) {
         return true;
     }
 
@@ -739,10 +764,11 @@ static bool rpl_data_compute_source_route(const uint8_t *final_dest, rpl_dao_tar
         }
         /* Increase size of table if necessary */
         if (16 * (rpl_data_sr->ihops + 1) > rpl_data_sr->iaddr_size) {
-            rpl_data_sr = rpl_realloc(rpl_data_sr, sizeof(rpl_data_sr_t) + rpl_data_sr->iaddr_size, sizeof(rpl_data_sr_t) + 2 * rpl_data_sr->iaddr_size);
-            if (!rpl_data_sr) {
+            rpl_data_sr_t *sr = rpl_realloc(rpl_data_sr, sizeof(rpl_data_sr_t) + rpl_data_sr->iaddr_size, sizeof(rpl_data_sr_t) + 2 * rpl_data_sr->iaddr_size);
+            if (!sr) {
                 return false;
             }
+            *slot = rpl_data_sr = sr;
             rpl_data_sr->iaddr_size *= 2;
         }
         memcpy(rpl_data_sr->iaddr + 16 * rpl_data_sr->ihops, transit->transit, 16);
@@ -784,9 +810,11 @@ static bool rpl_data_route_next_hop(const uint8_t *dest, ipv6_route_info_t *rout
 
 void rpl_data_sr_invalidate(void)
 {
-    if (rpl_data_sr) {
-        rpl_data_sr->target = NULL;
-        rpl_data_sr->ihops = 0;
+    for (uint_fast8_t i = 0; i < RPL_DATA_SR_CACHE_SIZE; i++) {
+        if (rpl_data_sr_cache[i]) {
+            rpl_data_sr_cache[i]->target = NULL;
+            rpl_data_sr_cache[i]->ihops = 0;
+        }
     }
     /* We could invalidate the next hops remembered in the system routing table.
      * but it's not necessary - recomputation happens every time. Does mean that
@@ -44,6 +44,17 @@ int tr51_init_channel_table(int16_t *channel_table, int16_t number_of_channels);
  */
 int32_t tr51_get_uc_channel_index(int16_t *channel_table, uint8_t *output_table, uint16_t slot_number, uint8_t *mac, int16_t number_of_channels, uint32_t *excluded_channels);
 
+/**
+ * @brief Compute the whole unicast hopping sequence using tr51 channel function.
+ * @param channel_table Channel table.
+ * @param output_table Output hopping sequence, one channel per slot.
+ * @param mac MAC address of the node for which the sequence is calculated.
+ * @param number_of_channels Number of channels.
+ * @param excluded_channels Excluded channels.
+ * @return Number of channels in sequence.
+ */
+uint16_t tr51_get_uc_channel_sequence(int16_t *channel_table, uint8_t *output_table, uint8_t *mac, int16_t number_of_channels, uint32_t *excluded_channels);
+
 /**
  * @brief Compute the broadcast schedule channel index using tr51 channel function.
  * @param channel_table Channel table.
@@ -448,6 +448,42 @@ static void fhss_ws_update_uc_channel_callback(fhss_structure_t *fhss_structure)
 #endif /*FHSS_CHANNEL_DEBUG_CBS*/
 }
 
+static int32_t fhss_ws_get_neighbor_uc_channel(fhss_structure_t *fhss_structure, fhss_ws_neighbor_timing_info_t *neighbor_timing_info, uint8_t *destination_address, uint16_t destination_slot)
+{
+    unicast_timing_info_t *uc_timing_info = &neighbor_timing_info->uc_timing_info;
+    fhss_ws_uc_channel_cache_t *cache = &neighbor_timing_info->uc_channel_cache;
+    // TR51 sequence repeats after number of channels, DH1CF after 0x10000 slots
+    uint16_t offset = destination_slot - cache->first_slot;
+    if ((uc_timing_info->unicast_channel_function == WS_TR51CF) && (destination_slot < cache->first_slot)) {
+        offset += uc_timing_info->unicast_number_of_channels;
+    }
+    if ((cache->number_of_channels == uc_timing_info->unicast_number_of_channels) && (cache->channel_function == uc_timing_info->unicast_channel_function) && (offset < FHSS_WS_UC_CHANNEL_CACHE_SIZE)) {
+        return cache->channels[offset];
+    }
+    // Cached channels are 8-bit like the TR51 hopping sequence
+    if (uc_timing_info->unicast_number_of_channels > 0x100) {
+        if (uc_timing_info->unicast_channel_function == WS_TR51CF) {
+            return tr51_get_uc_channel_index(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, destination_slot, destination_address, uc_timing_info->unicast_number_of_channels, NULL);
+        }
+        return dh1cf_get_uc_channel_index(destination_slot, destination_address, uc_timing_info->unicast_number_of_channels);
+    }
+    // Recompute the upcoming channels from the destination slot
+    if (uc_timing_info->unicast_channel_function == WS_TR51CF) {
+        tr51_get_uc_channel_sequence(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, destination_address, uc_timing_info->unicast_number_of_channels, NULL);
+        for (uint8_t i = 0; i < FHSS_WS_UC_CHANNEL_CACHE_SIZE; i++) {
+            cache->channels[i] = fhss_structure->ws->tr51_output_table[(destination_slot + i) % uc_timing_info->unicast_number_of_channels];
+        }
+    } else {
+        for (uint8_t i = 0; i < FHSS_WS_UC_CHANNEL_CACHE_SIZE; i++) {
+            cache->channels[i] = dh1cf_get_uc_channel_index((uint16_t)(destination_slot + i), destination_address, uc_timing_info->unicast_number_of_channels);
+        }
+    }
+    cache->first_slot = destination_slot;
+    cache->number_of_channels = uc_timing_info->unicast_number_of_channels;
+    cache->channel_function = uc_timing_info->unicast_channel_function;
+    return cache->channels[0];
+}
+
 static int fhss_ws_tx_handle_callback(const fhss_api_t *api, bool is_broadcast_addr, uint8_t *destination_address, int frame_type, uint16_t frame_length, uint8_t phy_header_length, uint8_t phy_tail_length, uint32_t tx_time)
 {
     (void) frame_type;
@@ -480,10 +516,8 @@ static int fhss_ws_tx_handle_callback(const fhss_api_t *api, bool is_broadcast_a
         }
         uint16_t destination_slot = fhss_ws_calculate_destination_slot(neighbor_timing_info, tx_time);
         int32_t tx_channel = neighbor_timing_info->uc_timing_info.fixed_channel;
-        if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_TR51CF) {
-            tx_channel = tr51_get_uc_channel_index(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, destination_slot, destination_address, neighbor_timing_info->uc_timing_info.unicast_number_of_channels, NULL);
-        } else if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_DH1CF) {
-            tx_channel = dh1cf_get_uc_channel_index(destination_slot, destination_address, neighbor_timing_info->uc_timing_info.unicast_number_of_channels);
+        if ((neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_TR51CF) || (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_DH1CF)) {
+            tx_channel = fhss_ws_get_neighbor_uc_channel(fhss_structure, neighbor_timing_info, destination_address, destination_slot);
         } else if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_VENDOR_DEF_CF) {
             if (fhss_structure->ws->fhss_configuration.vendor_defined_cf) {
                 tx_channel = fhss_structure->ws->fhss_configuration.vendor_defined_cf(fhss_structure->fhss_api, fhss_structure->ws->bc_slot, destination_address, fhss_structure->ws->fhss_configuration.bsi, neighbor_timing_info->uc_timing_info.unicast_number_of_channels);
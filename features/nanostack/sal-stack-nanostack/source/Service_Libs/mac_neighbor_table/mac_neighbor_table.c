@@ -28,14 +28,60 @@
 
 #define TRACE_GROUP "mnei"
 
+#define MAC_NEIGHBOR_HASH_END 0xff
+#define MAC_NEIGHBOR_HASH_MAX_BUCKETS 128
+
+static uint8_t mac_neighbor_table_mac64_hash(const mac_neighbor_table_t *table_class, const uint8_t *mac64)
+{
+    uint32_t hash = common_read_32_bit(mac64) ^ common_read_32_bit(mac64 + 4);
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash & table_class->address_hash_mask;
+}
+
+static uint8_t mac_neighbor_table_mac16_hash(const mac_neighbor_table_t *table_class, uint16_t mac16)
+{
+    return (mac16 ^ (mac16 >> 8)) & table_class->address_hash_mask;
+}
+
+static void mac_neighbor_table_hash_add(uint8_t *bucket, uint8_t *next, uint8_t index)
+{
+    next[index] = *bucket;
+    *bucket = index;
+}
+
+static void mac_neighbor_table_hash_remove(uint8_t *bucket, uint8_t *next, uint8_t index)
+{
+    while (*bucket != MAC_NEIGHBOR_HASH_END) {
+        if (*bucket == index) {
+            *bucket = next[index];
+            return;
+        }
+        bucket = &next[*bucket];
+    }
+}
+
 mac_neighbor_table_t *mac_neighbor_table_create(uint8_t table_size, neighbor_entry_remove_notify *remove_cb, neighbor_entry_nud_notify *nud_cb, void *user_indentifier)
 {
-    mac_neighbor_table_t *table_class = ns_dyn_mem_alloc(sizeof(mac_neighbor_table_t) + sizeof(mac_neighbor_table_entry_t) * table_size);
+    // Address hashes chain entry indexes, table_size is below MAC_NEIGHBOR_HASH_END so it is never an index
+    uint16_t hash_size = 1;
+    while (hash_size < table_size && hash_size < MAC_NEIGHBOR_HASH_MAX_BUCKETS) {
+        hash_size <<= 1;
+    }
+
+    mac_neighbor_table_t *table_class = ns_dyn_mem_alloc(sizeof(mac_neighbor_table_t) + sizeof(mac_neighbor_table_entry_t) * table_size + 2 * (hash_size + table_size));
     if (!table_class) {
         return NULL;
     }
     memset(table_class, 0, sizeof(mac_neighbor_table_t));
 
+    table_class->address_hash_mask = hash_size - 1;
+    table_class->mac64_hash = (uint8_t *) &table_class->neighbor_entry_buffer[table_size];
+    table_class->mac16_hash = table_class->mac64_hash + hash_size;
+    table_class->mac64_hash_next = table_class->mac16_hash + hash_size;
+    table_class->mac16_hash_next = table_class->mac64_hash_next + table_size;
+    memset(table_class->mac64_hash, MAC_NEIGHBOR_HASH_END, 2 * hash_size);
+
     mac_neighbor_table_entry_t *cur_ptr = &table_class->neighbor_entry_buffer[0];
     table_class->list_total_size = table_size;
     table_class->table_user_identifier = user_indentifier;
@@ -75,8 +121,11 @@ static void neighbor_table_class_remove_entry(mac_neighbor_table_t *table_class,
     }
     topo_trace(TOPOLOGY_MLE, entry->mac64, TOPO_REMOVE);
 
-
     uint8_t index = entry->index;
+    mac_neighbor_table_hash_remove(&table_class->mac64_hash[mac_neighbor_table_mac64_hash(table_class, entry->mac64)], table_class->mac64_hash_next, index);
+    if (entry->mac16 != 0xffff) {
+        mac_neighbor_table_hash_remove(&table_class->mac16_hash[mac_neighbor_table_mac16_hash(table_class, entry->mac16)], table_class->mac16_hash_next, index);
+    }
     memset(entry, 0, sizeof(mac_neighbor_table_entry_t));
     entry->index = index;
     ns_list_add_to_end(&table_class->free_list, entry);
@@ -137,6 +186,7 @@ mac_neighbor_table_entry_t *mac_neighbor_table_entry_allocate(mac_neighbor_table
     ns_list_add_to_end(&table_class->neighbour_list, entry);
     table_class->neighbour_list_size++;
     memcpy(entry->mac64, mac64, 8);
+    mac_neighbor_table_hash_add(&table_class->mac64_hash[mac_neighbor_table_mac64_hash(table_class, mac64)], table_class->mac64_hash_next, entry->index);
     entry->mac16 = 0xffff;
     entry->rx_on_idle = true;
     entry->ffd_device = true;
@@ -198,29 +248,47 @@ void mac_neighbor_table_trusted_neighbor(mac_neighbor_table_t *table_class, mac_
     neighbor_entry->trusted_device = trusted_device;
 }
 
+void mac_neighbor_table_mac16_set(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *neighbor_entry, uint16_t mac16)
+{
+    if (neighbor_entry->mac16 == mac16) {
+        return;
+    }
+    if (neighbor_entry->mac16 != 0xffff) {
+        mac_neighbor_table_hash_remove(&table_class->mac16_hash[mac_neighbor_table_mac16_hash(table_class, neighbor_entry->mac16)], table_class->mac16_hash_next, neighbor_entry->index);
+    }
+    neighbor_entry->mac16 = mac16;
+    if (mac16 != 0xffff) {
+        mac_neighbor_table_hash_add(&table_class->mac16_hash[mac_neighbor_table_mac16_hash(table_class, mac16)], table_class->mac16_hash_next, neighbor_entry->index);
+    }
+}
+
 mac_neighbor_table_entry_t *mac_neighbor_table_address_discover(mac_neighbor_table_t *table_class, const uint8_t *address, uint8_t address_type)
 {
     if (!table_class) {
         return NULL;
     }
-    uint16_t short_address;
+    uint8_t index;
     if (address_type == ADDR_802_15_4_SHORT) {
-        short_address = common_read_16_bit(address);
-    } else if (address_type == ADDR_802_15_4_LONG) {
-
-    } else {
-        return NULL;
-    }
-
-    ns_list_foreach(mac_neighbor_table_entry_t, cur, &table_class->neighbour_list) {
-        if (address_type == ADDR_802_15_4_SHORT) {
-            if (cur->mac16 != 0xffff && cur->mac16 == short_address) {
+        uint16_t short_address = common_read_16_bit(address);
+        if (short_address == 0xffff) {
+            return NULL;
+        }
+        index = table_class->mac16_hash[mac_neighbor_table_mac16_hash(table_class, short_address)];
+        while (index != MAC_NEIGHBOR_HASH_END) {
+            mac_neighbor_table_entry_t *cur = &table_class->neighbor_entry_buffer[index];
+            if (cur->mac16 == short_address) {
                 return cur;
             }
-        } else {
+            index = table_class->mac16_hash_next[index];
+        }
+    } else if (address_type == ADDR_802_15_4_LONG) {
+        index = table_class->mac64_hash[mac_neighbor_table_mac64_hash(table_class, address)];
+        while (index != MAC_NEIGHBOR_HASH_END) {
+            mac_neighbor_table_entry_t *cur = &table_class->neighbor_entry_buffer[index];
             if (memcmp(cur->mac64, address, 8) == 0) {
                 return cur;
             }
+            index = table_class->mac64_hash_next[index];
         }
     }
 
@@ -82,6 +82,11 @@ typedef struct mac_neighbor_table_class {
     uint8_t list_total_size;                                /*!< Total number allocated neighbor entries */
     uint8_t active_nud_process;                             /*!< Indicate Active NUD Process */
     uint8_t neighbour_list_size;                            /*!< Active Neighbor list size */
+    uint8_t address_hash_mask;                              /*!< Number of address hash buckets - 1 */
+    uint8_t *mac64_hash;                                    /*!< First entry index of each 64-bit address hash bucket */
+    uint8_t *mac64_hash_next;                               /*!< Next entry index in the 64-bit address hash bucket, by entry index */
+    uint8_t *mac16_hash;                                    /*!< First entry index of each 16-bit address hash bucket */
+    uint8_t *mac16_hash_next;                               /*!< Next entry index in the 16-bit address hash bucket, by entry index */
     void *table_user_identifier;                            /*!< Table user identifier like interface pointer */
     neighbor_entry_remove_notify *user_remove_notify_cb;    /*!< Neighbor Remove Callback notify */
     neighbor_entry_nud_notify *user_nud_notify_cb;          /*!< Trig NUD process for neighbor */
@@ -177,6 +182,17 @@ void mac_neighbor_table_neighbor_connected(mac_neighbor_table_t *table_class, ma
  */
 void mac_neighbor_table_trusted_neighbor(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *neighbor_entry, bool trusted_device);
 
+/**
+ * mac_neighbor_table_mac16_set Set neighbor 16-bit MAC address
+ *
+ * Entry mac16 must be only changed with this function to keep it discoverable by mac_neighbor_table_address_discover
+ *
+ * \param table_class pointer to table class
+ * \param neighbor_entry pointer to neighbor entry
+ * \param mac16 16-bit MAC address, 0xffff when neighbor does not have one
+ */
+void mac_neighbor_table_mac16_set(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *neighbor_entry, uint16_t mac16);
+
 /**
  * mac_neighbor_table_address_discover Discover neighbor from list by address
  *
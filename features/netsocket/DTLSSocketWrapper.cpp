@@ -20,6 +20,7 @@
 #include "drivers/Timer.h"
 #include "events/mbed_events.h"
 #include "rtos/Kernel.h"
+#include <string.h>
 
 #if defined(MBEDTLS_SSL_CLI_C)
 
@@ -27,12 +28,47 @@ DTLSSocketWrapper::DTLSSocketWrapper(Socket *transport, const char *hostname, co
     TLSSocketWrapper(transport, hostname, control),
     _int_ms_tick(0),
     _timer_event_id(0),
-    _timer_expired(false)
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    _cid_len(0),
+#endif
+    _timer_expired(false),
+    _cid_enabled(false)
 {
     mbedtls_ssl_conf_transport(get_ssl_config(), MBEDTLS_SSL_TRANSPORT_DATAGRAM);
     mbedtls_ssl_set_timer_cb(get_ssl_context(), this, timing_set_delay, timing_get_delay);
 }
 
+nsapi_error_t DTLSSocketWrapper::set_connection_id(const void *cid, size_t cid_len)
+{
+#if !defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    return NSAPI_ERROR_UNSUPPORTED;
+#else
+    if (cid_len > sizeof(_cid)) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    // Unexpected CIDs are ignored so stray records don't tear down the connection
+    if (mbedtls_ssl_conf_cid(get_ssl_config(), cid_len, MBEDTLS_SSL_UNEXPECTED_CID_IGNORE) != 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    memcpy(_cid, cid, cid_len);
+    _cid_len = cid_len;
+    _cid_enabled = true;
+    return NSAPI_ERROR_OK;
+#endif
+}
+
+int DTLSSocketWrapper::ssl_setup_complete()
+{
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    if (_cid_enabled) {
+        return mbedtls_ssl_set_cid(get_ssl_context(), MBEDTLS_SSL_CID_ENABLED, _cid, _cid_len);
+    }
+#endif
+    return 0;
+}
+
 void DTLSSocketWrapper::timing_set_delay(void *ctx, uint32_t int_ms, uint32_t fin_ms)
 {
     DTLSSocketWrapper *context = static_cast<DTLSSocketWrapper *>(ctx);
@@ -39,13 +39,45 @@ public:
      * @param control      Transport control mode. See @ref control_transport.
      */
     DTLSSocketWrapper(Socket *transport, const char *hostname = NULL, control_transport control = TRANSPORT_CONNECT_AND_CLOSE);
+
+    /** Use the DTLS Connection ID extension.
+     *
+     *  With a connection ID, records are matched to the connection by the ID
+     *  instead of the address and port. The connection survives NAT rebinding,
+     *  so a device that wakes up can keep sending without a new handshake.
+     *  The extension is only used if the peer supports it too.
+     *
+     *  For resuming sessions after the connection is closed, see
+     *  TLSSocketWrapper::get_session() and TLSSocketWrapper::set_session().
+     *
+     *  @note Must be called before calling connect(). Requires Mbed TLS with
+     *        MBEDTLS_SSL_DTLS_CONNECTION_ID. A configuration given with
+     *        set_ssl_config() afterwards must have a matching CID length.
+     *
+     *  @param cid     Connection ID the peer uses for records sent to this end, may be empty.
+     *  @param cid_len Length of the connection ID.
+     *  @return        NSAPI_ERROR_OK on success, NSAPI_ERROR_PARAMETER if the connection ID is too long,
+     *                 NSAPI_ERROR_UNSUPPORTED if Mbed TLS doesn't support connection IDs.
+     */
+    nsapi_error_t set_connection_id(const void *cid, size_t cid_len);
+
+protected:
+#ifndef DOXYGEN_ONLY
+    virtual int ssl_setup_complete();
+#endif
+
 private:
     static void timing_set_delay(void *ctx, uint32_t int_ms, uint32_t fin_ms);
     static int timing_get_delay(void *ctx);
     void timer_event();
     uint64_t _int_ms_tick;
     int _timer_event_id;
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    unsigned char _cid[MBEDTLS_SSL_CID_IN_LEN_MAX];
+    size_t _cid_len;
+#endif
     bool _timer_expired : 1;
+    bool _cid_enabled : 1;
 };
 
 #endif
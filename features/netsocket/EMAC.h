@@ -55,6 +55,24 @@ public:
     //typedef void (*emac_link_state_change_fn)(void *data, bool up);
     typedef mbed::Callback<void (bool up)> emac_link_state_change_cb_t;
 
+    /** Checksums the EMAC device can generate or check in hardware
+     *
+     * Flags returned by @a get_checksum_offload.
+     */
+    enum checksum_offload_t {
+        CHECKSUM_OFFLOAD_NONE        = 0x0000, /**< Every checksum done by the stack */
+        CHECKSUM_OFFLOAD_GEN_IP      = 0x0001, /**< IPv4 header checksum inserted on transmit */
+        CHECKSUM_OFFLOAD_GEN_UDP     = 0x0002, /**< UDP checksum inserted on transmit */
+        CHECKSUM_OFFLOAD_GEN_TCP     = 0x0004, /**< TCP checksum inserted on transmit */
+        CHECKSUM_OFFLOAD_GEN_ICMP    = 0x0008, /**< ICMP checksum inserted on transmit */
+        CHECKSUM_OFFLOAD_GEN_ICMP6   = 0x0010, /**< ICMPv6 checksum inserted on transmit */
+        CHECKSUM_OFFLOAD_CHECK_IP    = 0x0100, /**< Received frames with a bad IPv4 header checksum are dropped */
+        CHECKSUM_OFFLOAD_CHECK_UDP   = 0x0200, /**< Received frames with a bad UDP checksum are dropped */
+        CHECKSUM_OFFLOAD_CHECK_TCP   = 0x0400, /**< Received frames with a bad TCP checksum are dropped */
+        CHECKSUM_OFFLOAD_CHECK_ICMP  = 0x0800, /**< Received frames with a bad ICMP checksum are dropped */
+        CHECKSUM_OFFLOAD_CHECK_ICMP6 = 0x1000, /**< Received frames with a bad ICMPv6 checksum are dropped */
+    };
+
     /**
      * Return maximum transmission unit
      *
@@ -72,6 +90,20 @@ public:
      */
     virtual uint32_t get_align_preference() const = 0;
 
+    /**
+     * Return checksum offload capabilities
+     *
+     * The stack skips generating, on transmit, and checking, on receive, the
+     * checksums the EMAC device handles in hardware. Read once, when the
+     * interface is brought up.
+     *
+     * @return     Bitmask of @a checksum_offload_t flags, CHECKSUM_OFFLOAD_NONE by default
+     */
+    virtual uint32_t get_checksum_offload() const
+    {
+        return CHECKSUM_OFFLOAD_NONE;
+    }
+
     /**
      * Return interface name
      *
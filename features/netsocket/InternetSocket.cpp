@@ -15,6 +15,7 @@
  */
 
 #include "InternetSocket.h"
+#include "SocketSet.h"
 #include "platform/mbed_critical.h"
 #include "platform/Callback.h"
 
@@ -24,7 +25,8 @@ InternetSocket::InternetSocket()
     : _stack(0), _socket(0), _timeout(osWaitForever),
       _remote_peer(),
       _readers(0), _writers(0),
-      _factory_allocated(false)
+      _factory_allocated(false),
+      _set(NULL), _set_index(0)
 {
     core_util_atomic_flag_clear(&_pending);
     _socket_stats.stats_new_socket_entry(this);
@@ -78,6 +80,9 @@ nsapi_error_t InternetSocket::close()
     ret = _stack->socket_close(socket);
     _stack = 0; // Invalidate the stack pointer - otherwise open() fails.
     _socket_stats.stats_update_socket_state(this, SOCK_CLOSED);
+    if (_set) {
+        _set->remove(this);
+    }
     // Wakeup anything in a blocking operation
     // on this socket
     event();
@@ -205,6 +210,12 @@ void InternetSocket::event()
 {
     _event_flag.set(READ_FLAG | WRITE_FLAG);
 
+    core_util_critical_section_enter();
+    if (_set) {
+        _set->signal(_set_index);
+    }
+    core_util_critical_section_exit();
+
     if (_callback && !core_util_atomic_flag_test_and_set(&_pending)) {
         _callback();
     }
@@ -29,6 +29,8 @@
 #include "mbed_toolchain.h"
 #include "SocketStats.h"
 
+class SocketSet;
+
 /** Socket implementation that uses IP network stack.
  * Not to be directly used by applications. Cannot be directly instantiated.
  */
@@ -123,6 +125,40 @@ public:
      */
     virtual nsapi_error_t getpeername(SocketAddress *address);
 
+    /** Send data from several buffers without first copying them together.
+     *
+     *  Datagram sockets send the buffers as one datagram to address, or to
+     *  the connected peer if address is NULL. Stream sockets ignore address
+     *  and send the buffers in order.
+     *
+     *  Blocks in the same way as sendto().
+     *
+     *  @param address  The SocketAddress of the remote host or NULL.
+     *  @param iov      Array of buffers to send.
+     *  @param iovcnt   Number of buffers in the array.
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure.
+     */
+    virtual nsapi_size_or_error_t sendmsg(const SocketAddress *address,
+                                          const nsapi_iovec_t *iov, unsigned iovcnt) = 0;
+
+    /** Receive data into several buffers.
+     *
+     *  Datagram sockets scatter one datagram over the buffers. Stream sockets
+     *  fill the buffers in order with the data available. The source address
+     *  is stored in address if it's not NULL.
+     *
+     *  Blocks in the same way as recvfrom().
+     *
+     *  @param address  Destination for the source address or NULL.
+     *  @param iov      Array of buffers to receive into.
+     *  @param iovcnt   Number of buffers in the array.
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure.
+     */
+    virtual nsapi_size_or_error_t recvmsg(SocketAddress *address,
+                                          nsapi_iovec_t *iov, unsigned iovcnt) = 0;
+
     /** Register a callback on state change of the socket.
      *
      *  @see Socket::sigio
@@ -180,6 +216,11 @@ protected:
     friend class DTLSSocket;  // Allow DTLSSocket::connect() to do name resolution on the _stack
     SocketStats _socket_stats;
 
+    // Set the socket belongs to, guarded by critical section
+    friend class SocketSet;
+    SocketSet *_set;
+    uint8_t _set_index;
+
 #endif //!defined(DOXYGEN_ONLY)
 };
 
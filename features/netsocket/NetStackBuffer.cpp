@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NetStackBuffer.h"
+#include "NetStackMemoryManager.h"
+#include <string.h>
+
+NetStackBuffer::NetStackBuffer() : _memory_manager(NULL), _buf(NULL)
+{
+}
+
+NetStackBuffer::~NetStackBuffer()
+{
+    release();
+}
+
+void NetStackBuffer::release()
+{
+    if (_buf) {
+        _memory_manager->free(_buf);
+        _buf = NULL;
+    }
+}
+
+void NetStackBuffer::attach(NetStackMemoryManager *memory_manager, net_stack_mem_buf_t *buf)
+{
+    release();
+    _memory_manager = memory_manager;
+    _buf = buf;
+}
+
+uint32_t NetStackBuffer::size() const
+{
+    return _buf ? _memory_manager->get_total_len(_buf) : 0;
+}
+
+const net_stack_mem_buf_t *NetStackBuffer::next(const net_stack_mem_buf_t *seg) const
+{
+    return _memory_manager->get_next(seg);
+}
+
+mbed::Span<const uint8_t> NetStackBuffer::data(const net_stack_mem_buf_t *seg) const
+{
+    return mbed::Span<const uint8_t>(static_cast<const uint8_t *>(_memory_manager->get_ptr(seg)),
+                                     _memory_manager->get_len(seg));
+}
+
+uint32_t NetStackBuffer::copy(void *dest, uint32_t size, uint32_t offset) const
+{
+    uint32_t copied = 0;
+
+    for (const net_stack_mem_buf_t *seg = _buf; seg && copied < size; seg = next(seg)) {
+        uint32_t len = _memory_manager->get_len(seg);
+        if (offset >= len) {
+            offset -= len;
+            continue;
+        }
+
+        len -= offset;
+        if (len > size - copied) {
+            len = size - copied;
+        }
+        memcpy(static_cast<uint8_t *>(dest) + copied, static_cast<const uint8_t *>(_memory_manager->get_ptr(seg)) + offset, len);
+        copied += len;
+        offset = 0;
+    }
+
+    return copied;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file NetStackBuffer.h Handle for received data borrowed from the network stack */
+/** @addtogroup netsocket
+ * @{ */
+
+#ifndef NET_STACK_BUFFER_H
+#define NET_STACK_BUFFER_H
+
+#include <stdint.h>
+#include "platform/NonCopyable.h"
+#include "platform/Span.h"
+
+class NetStackMemoryManager;
+typedef void net_stack_mem_buf_t;
+
+/** Received data borrowed from the network stack
+ *
+ *  Holds a memory buffer chain of the stack, so data can be parsed where the
+ *  stack received it instead of being copied to a separate buffer. Filled by
+ *  TCPSocket::recv_buf() or UDPSocket::recvfrom_buf(), the chain is iterated
+ *  segment by segment:
+ *
+ *  @code
+ *  NetStackBuffer buf;
+ *  if (socket.recv_buf(buf) > 0) {
+ *      for (const net_stack_mem_buf_t *seg = buf.head(); seg; seg = buf.next(seg)) {
+ *          parse(buf.data(seg));
+ *      }
+ *      buf.release();
+ *  }
+ *  @endcode
+ *
+ *  The memory comes from the stack's receive pool, so the buffer should be
+ *  released as soon as the data is consumed. It is released at the latest
+ *  when the handle is destroyed or filled again.
+ */
+class NetStackBuffer : private mbed::NonCopyable<NetStackBuffer> {
+public:
+    NetStackBuffer();
+
+    ~NetStackBuffer();
+
+    /** Release the buffer chain back to the network stack
+     *
+     *  Does nothing if no buffer is held.
+     */
+    void release();
+
+    /** Attach a buffer chain, releasing any previously held
+     *
+     *  Used by the network stack when filling the handle. Ownership of the
+     *  chain is transferred to the handle.
+     *
+     *  @param memory_manager   Memory manager the chain is freed with
+     *  @param buf              Memory buffer chain, or NULL
+     */
+    void attach(NetStackMemoryManager *memory_manager, net_stack_mem_buf_t *buf);
+
+    /** Total size of the held data in bytes, 0 if no buffer is held */
+    uint32_t size() const;
+
+    /** First buffer of the chain, or NULL if no buffer is held */
+    const net_stack_mem_buf_t *head() const
+    {
+        return _buf;
+    }
+
+    /** Buffer following the given one in the chain, or NULL if last */
+    const net_stack_mem_buf_t *next(const net_stack_mem_buf_t *seg) const;
+
+    /** Contiguous data of one buffer of the chain */
+    mbed::Span<const uint8_t> data(const net_stack_mem_buf_t *seg) const;
+
+    /** Copy data out of the chain
+     *
+     *  For the parts of a stream that have to be contiguous, for example a
+     *  header split between two buffers.
+     *
+     *  @param dest     Destination buffer
+     *  @param size     Number of bytes to copy at most
+     *  @param offset   Offset from the start of the held data
+     *  @return         Number of bytes copied
+     */
+    uint32_t copy(void *dest, uint32_t size, uint32_t offset = 0) const;
+
+private:
+    NetStackMemoryManager *_memory_manager;
+    net_stack_mem_buf_t *_buf;
+};
+
+#endif
+
+/** @}*/
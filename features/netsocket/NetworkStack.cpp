@@ -18,6 +18,8 @@
 #include "nsapi_dns.h"
 #include "stddef.h"
 #include <new>
+#include <stdlib.h>
+#include <string.h>
 #include "events/EventQueue.h"
 #include "mbed_shared_queues.h"
 #include "platform/mbed_error.h"
@@ -129,6 +131,131 @@ nsapi_error_t NetworkStack::getsockopt(void *handle, int level, int optname, voi
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                   const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (address && iovcnt != 1) {
+        // Packet must be sent at once, gather it
+        nsapi_size_t size = 0;
+        for (unsigned i = 0; i < iovcnt; i++) {
+            size += iov[i].iov_len;
+        }
+
+        uint8_t *buffer = (uint8_t *)malloc(size ? size : 1);
+        if (!buffer) {
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+
+        nsapi_size_t offset = 0;
+        for (unsigned i = 0; i < iovcnt; i++) {
+            memcpy(buffer + offset, iov[i].iov_base, iov[i].iov_len);
+            offset += iov[i].iov_len;
+        }
+
+        nsapi_size_or_error_t ret = socket_sendto(handle, *address, buffer, size);
+        free(buffer);
+        return ret;
+    } else if (address) {
+        return socket_sendto(handle, *address, iov[0].iov_base, iov[0].iov_len);
+    }
+
+    nsapi_size_t sent = 0;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        nsapi_size_or_error_t ret = socket_send(handle, iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            // Reports the error only if nothing was sent
+            return sent ? (nsapi_size_or_error_t)sent : ret;
+        }
+
+        sent += ret;
+        if ((nsapi_size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+    return sent;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                   nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (address && iovcnt != 1) {
+        // Packet must be received at once, scatter it afterwards
+        nsapi_size_t size = 0;
+        for (unsigned i = 0; i < iovcnt; i++) {
+            size += iov[i].iov_len;
+        }
+
+        uint8_t *buffer = (uint8_t *)malloc(size ? size : 1);
+        if (!buffer) {
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+
+        nsapi_size_or_error_t ret = socket_recvfrom(handle, address, buffer, size);
+
+        nsapi_size_t offset = 0;
+        for (unsigned i = 0; i < iovcnt && ret > 0 && offset < (nsapi_size_t)ret; i++) {
+            nsapi_size_t len = iov[i].iov_len;
+            if (len > (nsapi_size_t)ret - offset) {
+                len = ret - offset;
+            }
+            memcpy(iov[i].iov_base, buffer + offset, len);
+            offset += len;
+        }
+
+        free(buffer);
+        return ret;
+    } else if (address) {
+        return socket_recvfrom(handle, address, iov[0].iov_base, iov[0].iov_len);
+    }
+
+    nsapi_size_t recv = 0;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        nsapi_size_or_error_t ret = socket_recv(handle, iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            // Reports the error only if nothing was received
+            return recv ? (nsapi_size_or_error_t)recv : ret;
+        }
+
+        recv += ret;
+        if ((nsapi_size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+    return recv;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_sendto_batch(nsapi_socket_t handle, nsapi_msg_t *msgs, unsigned count)
+{
+    unsigned sent = 0;
+    for (; sent < count; sent++) {
+        msgs[sent].result = socket_sendto(handle, msgs[sent].address, msgs[sent].data, msgs[sent].size);
+        if (msgs[sent].result < 0) {
+            // Reports the error only if nothing was sent
+            return sent ? (nsapi_size_or_error_t)sent : msgs[sent].result;
+        }
+    }
+    return sent;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvfrom_batch(nsapi_socket_t handle, nsapi_msg_t *msgs, unsigned count)
+{
+    unsigned recv = 0;
+    for (; recv < count; recv++) {
+        msgs[recv].result = socket_recvfrom(handle, &msgs[recv].address, msgs[recv].data, msgs[recv].size);
+        if (msgs[recv].result < 0) {
+            // Reports the error only if nothing was received
+            return recv ? (nsapi_size_or_error_t)recv : msgs[recv].result;
+        }
+    }
+    return recv;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recv_buf(nsapi_socket_t handle, SocketAddress *address,
+                                                    NetStackBuffer &buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 nsapi_error_t NetworkStack::call_in(int delay, mbed::Callback<void()> func)
 {
     static events::EventQueue *event_queue = mbed::mbed_event_queue();
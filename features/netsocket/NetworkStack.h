@@ -29,6 +29,19 @@
 
 // Predeclared classes
 class OnboardNetworkStack;
+class NetStackBuffer;
+
+/** Datagram of a batched send or receive
+ *
+ *  @see NetworkStack::socket_sendto_batch
+ *  @see NetworkStack::socket_recvfrom_batch
+ */
+struct nsapi_msg_t {
+    SocketAddress address;          /**< Remote address to send to, or source address received from */
+    void *data;                     /**< Data to send, or buffer to receive into */
+    nsapi_size_t size;              /**< Size of the data or buffer in bytes */
+    nsapi_size_or_error_t result;   /**< Number of bytes sent or received, or negative error code */
+};
 
 /** NetworkStack class
  *
@@ -186,6 +199,7 @@ protected:
     friend class UDPSocket;
     friend class TCPSocket;
     friend class TCPServer;
+    friend class SocketStats;
 
     /** Opens a socket
      *
@@ -336,6 +350,116 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                                   void *buffer, nsapi_size_t size) = 0;
 
+    /** Send data from several buffers over a socket
+     *
+     *  If address is given, the buffers are sent as one packet to it, as with
+     *  socket_sendto. Otherwise the socket must be connected and the buffers
+     *  are sent in order, as with socket_send. Returns the number of bytes sent.
+     *
+     *  This call is non-blocking. If send would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation copies several buffers into a temporary one
+     *  for packets, and sends each buffer in turn otherwise. Stacks that can
+     *  send directly from the buffers should override it.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host, or NULL for a connected socket
+     *  @param iov      Array of buffers to send
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                 const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data into several buffers over a socket
+     *
+     *  If address is given, one packet is received and scattered over the
+     *  buffers, and its source address is stored in address, as with
+     *  socket_recvfrom. Otherwise the socket must be connected and the
+     *  buffers are filled in order, as with socket_recv. Returns the number
+     *  of bytes received.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation receives packets through a temporary
+     *  buffer when given several buffers, and receives into each buffer in
+     *  turn otherwise.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address, or NULL for a connected socket
+     *  @param iov      Array of buffers to receive into
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                 nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Send several packets over a UDP socket
+     *
+     *  Sends each message to its address in order, as with socket_sendto,
+     *  and stores the number of bytes sent in its result. Stops at the
+     *  first message that fails, storing the error in its result.
+     *
+     *  This call is non-blocking. If the first message would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation calls socket_sendto for each message.
+     *
+     *  @param handle   Socket handle
+     *  @param msgs     Array of messages to send
+     *  @param count    Number of messages in the array
+     *  @return         Number of messages sent if any were, otherwise
+     *                  negative error code of the first message
+     */
+    virtual nsapi_size_or_error_t socket_sendto_batch(nsapi_socket_t handle, nsapi_msg_t *msgs, unsigned count);
+
+    /** Receive several packets over a UDP socket
+     *
+     *  Receives packets already queued on the socket into the messages in
+     *  order, as with socket_recvfrom, storing each source address and
+     *  number of bytes received. Stops when no more packets are queued or
+     *  the array is full.
+     *
+     *  This call is non-blocking. If no packet is queued,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation calls socket_recvfrom for each message.
+     *
+     *  @param handle   Socket handle
+     *  @param msgs     Array of messages to receive into
+     *  @param count    Number of messages in the array
+     *  @return         Number of messages received if any were, otherwise
+     *                  negative error code
+     */
+    virtual nsapi_size_or_error_t socket_recvfrom_batch(nsapi_socket_t handle, nsapi_msg_t *msgs, unsigned count);
+
+    /** Receive data over a socket without copying it
+     *
+     *  Passes the stack's own memory buffer chain holding the received data
+     *  to the caller, who releases it through the handle. If address is
+     *  given, one packet is received and its source address is stored in
+     *  address, as with socket_recvfrom. Otherwise the socket must be
+     *  connected and all data received so far is returned, as with
+     *  socket_recv. Returns the number of bytes received.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation returns NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address, or NULL for a connected socket
+     *  @param buf      Handle to fill with the received buffer chain
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle, SocketAddress *address,
+                                                  NetStackBuffer &buf);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
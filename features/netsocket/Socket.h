@@ -24,6 +24,8 @@
 
 #include "netsocket/SocketAddress.h"
 #include "Callback.h"
+#include "platform/Buffer.h"
+#include "platform/mbed_splice.h"
 
 /** Socket interface.
  *
@@ -89,6 +91,40 @@ public:
      */
     virtual nsapi_size_or_error_t send(const void *data, nsapi_size_t size) = 0;
 
+    /** Send the data viewed by a pooled buffer on a socket
+     *
+     *  Same as send(const void *, nsapi_size_t), without copying the data
+     *  out of the buffer first.
+     *
+     *  @param buffer   Buffer of data to send to the host.
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure.
+     */
+    nsapi_size_or_error_t send(const mbed::Buffer &buffer)
+    {
+        return send(buffer.data(), buffer.size());
+    }
+
+    /** Send the contents of a file on a socket.
+     *
+     *  Files on memory-mapped storage are sent straight from storage,
+     *  others are read through a small buffer shared by all transfers,
+     *  see mbed::splice.
+     *
+     *  @param file     File to send from.
+     *  @param offset   Position in the file to send from, updated past the
+     *                  bytes sent, leaving the file position unchanged.
+     *                  NULL to send from, and advance, the file position.
+     *  @param length   Number of bytes to send.
+     *  @return         Number of sent bytes, less than length at end of file
+     *                  or when a non-blocking socket can take no more.
+     *                  Negative error code if nothing was sent.
+     */
+    nsapi_size_or_error_t sendfile(mbed::FileHandle *file, off_t *offset, nsapi_size_t length)
+    {
+        return mbed::splice(mbed::callback(send_file_data, this), file, offset, length);
+    }
+
     /** Receive data from a socket.
      *
      *  Receive data from connected socket, or in the case of connectionless socket,
@@ -279,6 +315,12 @@ public:
      *  @return         NSAPI_ERROR_OK on success, negative error code on failure.
      */
     virtual nsapi_error_t getpeername(SocketAddress *address) = 0;
+
+private:
+    static ssize_t send_file_data(Socket *socket, const void *data, size_t size)
+    {
+        return socket->send(data, size);
+    }
 };
 
 
@@ -23,13 +23,21 @@
 #include "ip6string.h"
 
 
+static bool addr_equal(const nsapi_addr_t &a, const nsapi_addr_t &b)
+{
+    if (a.version != b.version) {
+        return false;
+    } else if (a.version == NSAPI_IPv4) {
+        return memcmp(a.bytes, b.bytes, NSAPI_IPv4_BYTES) == 0;
+    } else if (a.version == NSAPI_IPv6) {
+        return memcmp(a.bytes, b.bytes, NSAPI_IPv6_BYTES) == 0;
+    }
+    return true;
+}
 
 SocketAddress::SocketAddress(nsapi_addr_t addr, uint16_t port)
+    : _ip_address(NULL), _addr(addr), _port(port)
 {
-    mem_init();
-    _ip_address = NULL;
-    set_addr(addr);
-    set_port(port);
 }
 
 SocketAddress::SocketAddress(const char *addr, uint16_t port)
@@ -49,11 +57,8 @@ SocketAddress::SocketAddress(const void *bytes, nsapi_version_t version, uint16_
 }
 
 SocketAddress::SocketAddress(const SocketAddress &addr)
+    : _ip_address(NULL), _addr(addr._addr), _port(addr._port)
 {
-    mem_init();
-    _ip_address = NULL;
-    set_addr(addr.get_addr());
-    set_port(addr.get_port());
 }
 
 void SocketAddress::mem_init(void)
@@ -96,8 +101,12 @@ void SocketAddress::set_ip_bytes(const void *bytes, nsapi_version_t version)
 
 void SocketAddress::set_addr(nsapi_addr_t addr)
 {
-    delete[] _ip_address;
-    _ip_address = NULL;
+    // The formatted address stays valid while the same address is set
+    // again, as it is for consecutive packets from one peer
+    if (_ip_address && !addr_equal(_addr, addr)) {
+        delete[] _ip_address;
+        _ip_address = NULL;
+    }
     _addr = addr;
 }
 
@@ -114,16 +123,25 @@ const char *SocketAddress::get_ip_address() const
 
     if (!_ip_address) {
         _ip_address = new char[NSAPI_IP_SIZE];
-        if (_addr.version == NSAPI_IPv4) {
-            ip4tos(_addr.bytes, _ip_address);
-        } else if (_addr.version == NSAPI_IPv6) {
-            ip6tos(_addr.bytes, _ip_address);
-        }
+        get_ip_address(_ip_address);
     }
 
     return _ip_address;
 }
 
+const char *SocketAddress::get_ip_address(char *buf) const
+{
+    if (_addr.version == NSAPI_IPv4) {
+        ip4tos(_addr.bytes, buf);
+    } else if (_addr.version == NSAPI_IPv6) {
+        ip6tos(_addr.bytes, buf);
+    } else {
+        return NULL;
+    }
+
+    return buf;
+}
+
 const void *SocketAddress::get_ip_bytes() const
 {
     return _addr.bytes;
@@ -169,10 +187,8 @@ SocketAddress::operator bool() const
 
 SocketAddress &SocketAddress::operator=(const SocketAddress &addr)
 {
-    delete[] _ip_address;
-    _ip_address = NULL;
-    set_addr(addr.get_addr());
-    set_port(addr.get_port());
+    set_addr(addr._addr);
+    _port = addr._port;
     return *this;
 }
 
@@ -121,12 +121,25 @@ public:
     /** Get the human-readable IP address
      *
      *  Allocates memory for a string and converts binary address to
-     *  human-readable format. String is freed in the destructor.
+     *  human-readable format. String is freed in the destructor, or when
+     *  a different address is set.
      *
      *  @return         Null-terminated representation of the IP Address
      */
     const char *get_ip_address() const;
 
+    /** Get the human-readable IP address into a buffer
+     *
+     *  Converts binary address to human-readable format without allocating
+     *  memory, for addresses that change often such as the source of each
+     *  received packet.
+     *
+     *  @param buf      Buffer of at least NSAPI_IP_SIZE bytes
+     *  @return         buf holding the null-terminated representation of
+     *                  the IP address, or NULL if no address is set
+     */
+    const char *get_ip_address(char *buf) const;
+
     /** Get the raw IP bytes
      *
      *  @return         Raw IP address in big-endian order
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SocketSet.h"
+#include "InternetSocket.h"
+#include "platform/mbed_critical.h"
+#include "rtos/Kernel.h"
+
+#define SIGNAL_FLAG 0x1u
+
+SocketSet::SocketSet() : _count(0), _scan(0), _ready(0)
+{
+}
+
+SocketSet::~SocketSet()
+{
+    while (_count) {
+        remove(_sockets[_count - 1]);
+    }
+}
+
+nsapi_error_t SocketSet::add(InternetSocket *socket)
+{
+    nsapi_error_t ret = NSAPI_ERROR_OK;
+
+    // Socket events read the membership in a critical section
+    core_util_critical_section_enter();
+    if (socket->_set) {
+        ret = NSAPI_ERROR_PARAMETER;
+    } else if (_count == MAX_SOCKETS) {
+        ret = NSAPI_ERROR_NO_MEMORY;
+    } else {
+        _sockets[_count] = socket;
+        socket->_set = this;
+        socket->_set_index = _count;
+        signal(_count);
+        _count++;
+    }
+    core_util_critical_section_exit();
+
+    return ret;
+}
+
+nsapi_error_t SocketSet::remove(InternetSocket *socket)
+{
+    nsapi_error_t ret = NSAPI_ERROR_OK;
+
+    core_util_critical_section_enter();
+    if (socket->_set != this) {
+        ret = NSAPI_ERROR_PARAMETER;
+    } else {
+        unsigned index = socket->_set_index;
+        unsigned last = --_count;
+        uint32_t ready = _ready & ~(1u << index);
+
+        // The last socket takes over the freed slot, with its event
+        if (index != last) {
+            _sockets[index] = _sockets[last];
+            _sockets[index]->_set_index = index;
+            if (ready & (1u << last)) {
+                ready |= 1u << index;
+            }
+        }
+        _ready = ready & ~(1u << last);
+        socket->_set = NULL;
+    }
+    core_util_critical_section_exit();
+
+    return ret;
+}
+
+void SocketSet::signal(unsigned index)
+{
+    _ready |= 1u << index;
+    _flags.set(SIGNAL_FLAG);
+}
+
+int SocketSet::wait(InternetSocket *ready[], unsigned nready, int timeout)
+{
+    uint64_t start = rtos::Kernel::get_ms_count();
+
+    while (true) {
+        int count = 0;
+
+        core_util_critical_section_enter();
+        unsigned start = _scan;
+        for (unsigned n = 0; n < _count && (unsigned)count < nready; n++) {
+            unsigned index = (start + n) % _count;
+            if (_ready & (1u << index)) {
+                _ready &= ~(1u << index);
+                ready[count++] = _sockets[index];
+                _scan = index + 1;
+            }
+        }
+        core_util_critical_section_exit();
+
+        if (count || timeout == 0) {
+            return count;
+        }
+
+        uint32_t millisec = osWaitForever;
+        if (timeout > 0) {
+            int64_t remaining = timeout - (int64_t)(rtos::Kernel::get_ms_count() - start);
+            if (remaining <= 0) {
+                return 0;
+            }
+            millisec = remaining;
+        }
+
+        // The flag is only a wake-up, events are kept in _ready
+        uint32_t flag = _flags.wait_any(SIGNAL_FLAG, millisec);
+        if (flag & osFlagsError) {
+            return 0;
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file SocketSet.h Waiting on several sockets from one thread */
+/** @addtogroup netsocket
+ * @{ */
+
+#ifndef SOCKETSET_H
+#define SOCKETSET_H
+
+#include <stddef.h>
+#include "netsocket/nsapi_types.h"
+#include "rtos/EventFlags.h"
+#include "platform/NonCopyable.h"
+
+class InternetSocket;
+
+/** Set of sockets a single thread waits on
+ *
+ *  Collects the state change events the network stack raises for each
+ *  socket in the set, so one thread can serve many non-blocking sockets
+ *  instead of blocking a thread on each of them. As with sigio(), an event
+ *  is a cue to retry the socket's calls: it may be spurious, and the
+ *  socket's calls must be repeated until they return
+ *  NSAPI_ERROR_WOULD_BLOCK before its next event can be relied on.
+ *
+ *  @code
+ *  SocketSet set;
+ *  set.add(&server);
+ *  while (true) {
+ *      InternetSocket *ready[4];
+ *      int count = set.wait(ready, 4, -1);
+ *      for (int i = 0; i < count; i++) {
+ *          // Drain ready[i] with non-blocking calls
+ *      }
+ *  }
+ *  @endcode
+ *
+ *  Adding a socket does not change its sigio() callback, both are called.
+ *  A socket can belong to one set at a time, and is removed when closed.
+ *
+ *  @note Synchronization level: add() and remove() are thread safe, wait()
+ *  must be called from one thread at a time.
+ */
+class SocketSet : private mbed::NonCopyable<SocketSet> {
+public:
+    /** Maximum number of sockets in a set */
+    static const unsigned MAX_SOCKETS = 32;
+
+    SocketSet();
+
+    /** Destroy the set, removing all its sockets */
+    ~SocketSet();
+
+    /** Add a socket to the set
+     *
+     *  The socket is reported by the next wait(), so its current state can
+     *  be checked.
+     *
+     *  @param socket   Socket to add
+     *  @return         NSAPI_ERROR_OK on success, NSAPI_ERROR_PARAMETER
+     *                  if the socket already belongs to a set,
+     *                  NSAPI_ERROR_NO_MEMORY if the set is full
+     */
+    nsapi_error_t add(InternetSocket *socket);
+
+    /** Remove a socket from the set
+     *
+     *  @param socket   Socket to remove
+     *  @return         NSAPI_ERROR_OK on success, NSAPI_ERROR_PARAMETER
+     *                  if the socket is not in this set
+     */
+    nsapi_error_t remove(InternetSocket *socket);
+
+    /** Number of sockets in the set */
+    unsigned size() const
+    {
+        return _count;
+    }
+
+    /** Wait for events on the sockets of the set
+     *
+     *  Sockets are reported in turn, so busy sockets don't starve the
+     *  others when ready has fewer entries than there are sockets with
+     *  events. Sockets not reported keep their events for the next call.
+     *
+     *  @param ready    Array filled with the sockets that had events
+     *  @param nready   Number of entries in ready
+     *  @param timeout  Timeout in milliseconds, or -1 to wait forever
+     *  @return         Number of sockets stored in ready, 0 if timed out
+     */
+    int wait(InternetSocket *ready[], unsigned nready, int timeout);
+
+#if !defined(DOXYGEN_ONLY)
+protected:
+    friend class InternetSocket;
+
+    /** Record an event of a socket, called in a critical section */
+    void signal(unsigned index);
+
+    InternetSocket *_sockets[MAX_SOCKETS];
+    unsigned _count;
+    unsigned _scan;
+    volatile uint32_t _ready;
+    rtos::EventFlags _flags;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+#endif
+
+/** @}*/
@@ -15,6 +15,7 @@
  */
 
 #include "SocketStats.h"
+#include "NetworkStack.h"
 #include "platform/mbed_error.h"
 #include "platform/mbed_assert.h"
 #ifdef MBED_CONF_RTOS_PRESENT
@@ -158,3 +159,58 @@ void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size
     _mutex->unlock();
 #endif
 }
+
+void SocketStats::stats_update_tcp_info(const Socket *const reference_id, NetworkStack *stack, nsapi_socket_t handle)
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
+    nsapi_tcp_info_t info;
+    unsigned len = sizeof(info);
+    // Queried before taking the mutex, the stack takes its own locks
+    if (stack->getsockopt(handle, NSAPI_SOCKET, NSAPI_TCP_INFO, &info, &len) != NSAPI_ERROR_OK) {
+        return;
+    }
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].rtt_ms = info.rtt_ms;
+        _stats[position].retransmits = info.retransmits;
+        _stats[position].send_pending = info.send_pending;
+    }
+    _mutex->unlock();
+#endif
+}
+
+uint64_t SocketStats::stats_blocking_start()
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED && defined(MBED_CONF_RTOS_PRESENT)
+    return rtos::Kernel::get_ms_count();
+#else
+    return 0;
+#endif
+}
+
+void SocketStats::stats_update_send_blocked(const Socket *const reference_id, uint64_t start)
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED && defined(MBED_CONF_RTOS_PRESENT)
+    uint32_t blocked = rtos::Kernel::get_ms_count() - start;
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].send_blocked_ms += blocked;
+    }
+    _mutex->unlock();
+#endif
+}
+
+void SocketStats::stats_update_recv_blocked(const Socket *const reference_id, uint64_t start)
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED && defined(MBED_CONF_RTOS_PRESENT)
+    uint32_t blocked = rtos::Kernel::get_ms_count() - start;
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].recv_blocked_ms += blocked;
+    }
+    _mutex->unlock();
+#endif
+}
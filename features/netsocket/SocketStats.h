@@ -23,6 +23,8 @@
 #include "SocketAddress.h"
 #include "hal/ticker_api.h"
 
+class NetworkStack;
+
 #ifndef MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT
 #define MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT      10
 #endif
@@ -50,6 +52,11 @@ typedef struct {
     size_t sent_bytes;              /**< Data sent through this socket */
     size_t recv_bytes;              /**< Data received through this socket */
     us_timestamp_t last_change_tick;/**< osKernelGetTick() when state last changed */
+    uint32_t rtt_ms;                /**< Round trip time estimate when last sampled, TCP only */
+    uint32_t retransmits;           /**< Consecutive retransmissions when last sampled, TCP only */
+    uint32_t send_pending;          /**< Bytes awaiting acknowledgement when last sampled, TCP only */
+    uint32_t send_blocked_ms;       /**< Total time spent blocked in send calls */
+    uint32_t recv_blocked_ms;       /**< Total time spent blocked in receive calls */
 } mbed_stats_socket_t;
 
 /**  SocketStats class
@@ -143,6 +150,45 @@ public:
      */
     void stats_update_recv_bytes(const Socket *const reference_id, size_t recv_bytes);
 
+    /** Sample the TCP connection state of the socket from the stack.
+     *  API used by socket (TCP) layers only, not to be used by application.
+     *
+     *  Records round trip time, retransmissions and unacknowledged bytes
+     *  if the stack supports the NSAPI_TCP_INFO socket option.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param stack  Stack owning the socket.
+     *  @param handle Stack handle of the socket.
+     *
+     */
+    void stats_update_tcp_info(const Socket *const reference_id, NetworkStack *stack, nsapi_socket_t handle);
+
+    /** Get the start time of a blocking wait, to pass to `stats_update_send_blocked`
+     *  or `stats_update_recv_blocked` once the wait is over.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @return Current time in milliseconds, 0 if statistics are disabled.
+     */
+    uint64_t stats_blocking_start();
+
+    /** Add the time since `start` to the time the socket spent blocked in send calls.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param start  Value returned by `stats_blocking_start` before blocking.
+     *
+     */
+    void stats_update_send_blocked(const Socket *const reference_id, uint64_t start);
+
+    /** Add the time since `start` to the time the socket spent blocked in receive calls.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param start  Value returned by `stats_blocking_start` before blocking.
+     *
+     */
+    void stats_update_recv_blocked(const Socket *const reference_id, uint64_t start);
+
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
 private:
     static mbed_stats_socket_t _stats[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
@@ -128,10 +128,21 @@ nsapi_error_t TCPSocket::connect(const char *host, uint16_t port)
 
 nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
 {
+    nsapi_iovec_t iov = { const_cast<void *>(data), size };
+    return sendmsg(NULL, &iov, 1);
+}
+
+nsapi_size_or_error_t TCPSocket::sendmsg(const SocketAddress *address, const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    (void)address;
     _lock.lock();
-    const uint8_t *data_ptr = static_cast<const uint8_t *>(data);
     nsapi_size_or_error_t ret;
     nsapi_size_t written = 0;
+    nsapi_size_t size = 0;
+
+    for (unsigned i = 0; i < iovcnt; i++) {
+        size += iov[i].iov_len;
+    }
 
     // If this assert is hit then there are two threads
     // performing a send at the same time which is undefined
@@ -148,8 +159,21 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
             break;
         }
 
+        // Skips buffers already written, a partially written one is continued on its own
+        unsigned index = 0;
+        nsapi_size_t offset = written;
+        while (offset && offset >= iov[index].iov_len) {
+            offset -= iov[index].iov_len;
+            index++;
+        }
+
         core_util_atomic_flag_clear(&_pending);
-        ret = _stack->socket_send(_socket, data_ptr + written, size - written);
+        if (offset) {
+            ret = _stack->socket_send(_socket, static_cast<const uint8_t *>(iov[index].iov_base) + offset,
+                                      iov[index].iov_len - offset);
+        } else {
+            ret = _stack->socket_sendmsg(_socket, NULL, iov + index, iovcnt - index);
+        }
         if (ret >= 0) {
             written += ret;
             if (written >= size) {
@@ -164,7 +188,9 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
+            uint64_t blocked = _socket_stats.stats_blocking_start();
             flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _socket_stats.stats_update_send_blocked(this, blocked);
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -176,6 +202,10 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
         }
     }
 
+    if (_socket && written > 0) {
+        _socket_stats.stats_update_tcp_info(this, _stack, _socket);
+    }
+
     _writers--;
     if (!_socket) {
         _event_flag.set(FINISHED_FLAG);
@@ -199,6 +229,70 @@ nsapi_size_or_error_t TCPSocket::sendto(const SocketAddress &address, const void
 }
 
 nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
+{
+    nsapi_iovec_t iov = { data, size };
+    return recvmsg(NULL, &iov, 1);
+}
+
+nsapi_size_or_error_t TCPSocket::recvmsg(SocketAddress *address, nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (address) {
+        *address = _remote_peer;
+    }
+
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_readers == 0);
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_recvmsg(_socket, NULL, iov, iovcnt);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            _socket_stats.stats_update_recv_bytes(this, ret);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            uint64_t blocked = _socket_stats.stats_blocking_start();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _socket_stats.stats_update_recv_blocked(this, blocked);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    if (_socket && ret > 0) {
+        _socket_stats.stats_update_tcp_info(this, _stack, _socket);
+    }
+
+    _readers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t TCPSocket::recv_buf(NetStackBuffer &buf)
 {
     _lock.lock();
     nsapi_size_or_error_t ret;
@@ -216,7 +310,7 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
         }
 
         core_util_atomic_flag_clear(&_pending);
-        ret = _stack->socket_recv(_socket, data, size);
+        ret = _stack->socket_recv_buf(_socket, NULL, buf);
         if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
             _socket_stats.stats_update_recv_bytes(this, ret);
             break;
@@ -226,7 +320,9 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
+            uint64_t blocked = _socket_stats.stats_blocking_start();
             flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _socket_stats.stats_update_recv_blocked(this, blocked);
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -237,6 +333,10 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
         }
     }
 
+    if (_socket && ret > 0) {
+        _socket_stats.stats_update_tcp_info(this, _stack, _socket);
+    }
+
     _readers--;
     if (!_socket) {
         _event_flag.set(FINISHED_FLAG);
@@ -254,6 +354,73 @@ nsapi_size_or_error_t TCPSocket::recvfrom(SocketAddress *address, void *data, ns
     return recv(data, size);
 }
 
+nsapi_error_t TCPSocket::accept(TCPSocket &connection, SocketAddress *address)
+{
+    _lock.lock();
+    nsapi_error_t ret;
+
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        void *socket;
+        SocketAddress peer;
+        connection._lock.lock();
+        if (connection._socket) {
+            connection._lock.unlock();
+            ret = NSAPI_ERROR_PARAMETER;
+            break;
+        }
+        ret = _stack->socket_accept(_socket, &socket, &peer);
+
+        if (0 == ret) {
+            connection._stack = _stack;
+            connection._socket = socket;
+            connection._remote_peer = peer;
+            connection._event = mbed::Callback<void()>(&connection, &TCPSocket::event);
+            _stack->socket_attach(socket, &mbed::Callback<void()>::thunk, &connection._event);
+            _socket_stats.stats_update_peer(&connection, peer);
+            _socket_stats.stats_update_socket_state(&connection, SOCK_CONNECTED);
+            connection._lock.unlock();
+            if (address) {
+                *address = peer;
+            }
+            break;
+        }
+        connection._lock.unlock();
+
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_error_t TCPSocket::listen(int backlog)
 {
     _lock.lock();
@@ -24,6 +24,7 @@
 #include "netsocket/InternetSocket.h"
 #include "netsocket/NetworkStack.h"
 #include "netsocket/NetworkInterface.h"
+#include "netsocket/NetStackBuffer.h"
 #include "rtos/EventFlags.h"
 
 
@@ -100,12 +101,19 @@ public:
      *  non-blocking or times out, a partial amount can be written.
      *  NSAPI_ERROR_WOULD_BLOCK is returned if no data was written.
      *
+     *  @note If the stack supports the NSAPI_SEND_NOCOPY socket option and it is
+     *  enabled, the data is sent by reference. The buffer must then not be modified
+     *  or released until the NSAPI_SEND_PENDING socket option reads 0; the sigio
+     *  callback is called as the peer acknowledges data. Intended for constant
+     *  data such as content of flash.
+     *
      *  @param data     Buffer of data to send to the host
      *  @param size     Size of the buffer in bytes
      *  @return         Number of sent bytes on success, negative error
      *                  code on failure
      */
     virtual nsapi_size_or_error_t send(const void *data, nsapi_size_t size);
+    using Socket::send;
 
     /** Receive data over a TCP socket
      *
@@ -160,6 +168,62 @@ public:
     virtual nsapi_size_or_error_t recvfrom(SocketAddress *address,
                                            void *data, nsapi_size_t size);
 
+    /** Send data from several buffers over a TCP socket
+     *
+     *  TCP socket is connection oriented protocol, so address is ignored.
+     *
+     *  By default, sendmsg blocks until all data is sent. If socket is set to
+     *  non-blocking or times out, a partial amount can be written.
+     *  NSAPI_ERROR_WOULD_BLOCK is returned if no data was written.
+     *
+     *  @param address  Remote address, ignored
+     *  @param iov      Array of buffers to send
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t sendmsg(const SocketAddress *address,
+                                          const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data into several buffers over a TCP socket
+     *
+     *  Buffers are filled in order. Stores the remote address in address
+     *  if address is not NULL.
+     *
+     *  By default, recvmsg blocks until some data is received. If socket is set to
+     *  non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK can be returned to
+     *  indicate no data.
+     *
+     *  @param address  Destination for the remote address or NULL
+     *  @param iov      Array of buffers to receive into
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure. If no data is available to be received
+     *                  and the peer has performed an orderly shutdown,
+     *                  recvmsg() returns 0.
+     */
+    virtual nsapi_size_or_error_t recvmsg(SocketAddress *address,
+                                          nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data over a TCP socket without copying it.
+     *
+     *  Fills buf with the network stack's buffers holding all data received
+     *  so far, releasing any buffers it held before. Data stays in the
+     *  stack's receive memory until buf is released.
+     *
+     *  By default, recv_buf blocks until some data is received. If socket is set to
+     *  non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK can be returned to
+     *  indicate no data.
+     *
+     *  @param buf      Handle to fill with the received data
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure. NSAPI_ERROR_UNSUPPORTED if the
+     *                  network stack can't lend its buffers. If no data is
+     *                  available to be received and the peer has performed
+     *                  an orderly shutdown, recv_buf() returns 0.
+     */
+    nsapi_size_or_error_t recv_buf(NetStackBuffer &buf);
+
     /** Accepts a connection on a socket.
      *
      *  The server socket must be bound and set to listen for connections.
@@ -175,6 +239,28 @@ public:
      */
     virtual TCPSocket *accept(nsapi_error_t *error = NULL);
 
+    /** Accepts a connection into a given socket.
+     *
+     *  The server socket must be bound and set to listen for connections.
+     *  On a new connection, connection is opened on it and address is set
+     *  to the peer address if given. Nothing is allocated, so servers can
+     *  keep a fixed pool of TCPSocket objects and accept into any of them
+     *  that is closed, with constant latency even under bursts of
+     *  connections. Closing the connection leaves the object ready for
+     *  reuse.
+     *
+     *  By default, accept blocks until incoming connection occurs. If socket is set to
+     *  non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is returned. A
+     *  callback registered with sigio() is called when a connection is
+     *  ready to be accepted.
+     *
+     *  @param connection Closed socket to open on the new connection
+     *  @param address    Destination for the peer address or NULL
+     *  @return           0 on success, NSAPI_ERROR_PARAMETER if connection
+     *                    is open, negative error code on other failures
+     */
+    nsapi_error_t accept(TCPSocket &connection, SocketAddress *address = NULL);
+
     /** Listen for incoming connections.
      *
      *  Marks the socket as a passive socket that can be used to accept
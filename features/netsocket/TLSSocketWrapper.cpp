@@ -26,10 +26,24 @@
 #include "mbedtls/platform.h"
 #include "mbed_error.h"
 #include "Kernel.h"
+#include "platform/SingletonPtr.h"
+#include "platform/PlatformMutex.h"
 
 // This class requires Mbed TLS SSL/TLS client code
 #if defined(MBEDTLS_SSL_CLI_C)
 
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0) && defined(MBEDTLS_X509_CRT_PARSE_C)
+struct TLS_SESSION_CACHE {
+    char *host;
+    mbedtls_ssl_session session;
+    uint64_t accessed;
+};
+
+static TLS_SESSION_CACHE *tls_session_cache[MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE];
+// Protects cache shared between sockets
+static SingletonPtr<PlatformMutex> tls_session_cache_mutex;
+#endif
+
 TLSSocketWrapper::TLSSocketWrapper(Socket *transport, const char *hostname, control_transport control) :
     _transport(transport),
     _timeout(-1),
@@ -38,6 +52,7 @@ TLSSocketWrapper::TLSSocketWrapper(Socket *transport, const char *hostname, cont
     _clicert(NULL),
 #endif
     _ssl_conf(NULL),
+    _session(NULL),
     _connect_transport(control == TRANSPORT_CONNECT || control == TRANSPORT_CONNECT_AND_CLOSE),
     _close_transport(control == TRANSPORT_CLOSE || control == TRANSPORT_CONNECT_AND_CLOSE),
     _tls_initialized(false),
@@ -205,6 +220,23 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
         return NSAPI_ERROR_AUTH_FAILURE;
     }
 
+    if ((ret = ssl_setup_complete()) != 0) {
+        print_mbedtls_error("ssl_setup_complete", ret);
+        return NSAPI_ERROR_AUTH_FAILURE;
+    }
+
+    if (_session) {
+        if ((ret = mbedtls_ssl_set_session(&_ssl, _session)) != 0) {
+            // Not fatal, handshake is just not abbreviated
+            print_mbedtls_error("mbedtls_ssl_set_session", ret);
+        }
+    }
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0) && defined(MBEDTLS_X509_CRT_PARSE_C)
+    else {
+        session_cache_load();
+    }
+#endif
+
     _transport->set_blocking(false);
     _transport->sigio(mbed::callback(this, &TLSSocketWrapper::event));
     mbedtls_ssl_set_bio(&_ssl, this, ssl_send, ssl_recv, NULL);
@@ -253,6 +285,10 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
         if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
             return NSAPI_ERROR_ALREADY;
         } else {
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0) && defined(MBEDTLS_X509_CRT_PARSE_C)
+            // Don't try to resume the session again in case it caused the failure
+            session_cache_remove();
+#endif
             return NSAPI_ERROR_AUTH_FAILURE;
         }
     }
@@ -284,10 +320,183 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
     delete[] buf;
 #endif
 
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0) && defined(MBEDTLS_X509_CRT_PARSE_C)
+    session_cache_store();
+#endif
+
     _handshake_completed = true;
     return NSAPI_ERROR_IS_CONNECTED;
 }
 
+nsapi_error_t TLSSocketWrapper::set_max_fragment_length(size_t length)
+{
+#if !defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    return NSAPI_ERROR_UNSUPPORTED;
+#else
+    unsigned char mfl_code;
+    switch (length) {
+        case 0:
+            mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_NONE;
+            break;
+        case 512:
+            mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_512;
+            break;
+        case 1024:
+            mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_1024;
+            break;
+        case 2048:
+            mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_2048;
+            break;
+        case 4096:
+            mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_4096;
+            break;
+        default:
+            return NSAPI_ERROR_PARAMETER;
+    }
+
+    int ret = mbedtls_ssl_conf_max_frag_len(get_ssl_config(), mfl_code);
+    if (ret != 0) {
+        print_mbedtls_error("mbedtls_ssl_conf_max_frag_len", ret);
+        return NSAPI_ERROR_PARAMETER;
+    }
+    return NSAPI_ERROR_OK;
+#endif
+}
+
+int TLSSocketWrapper::ssl_setup_complete()
+{
+    return 0;
+}
+
+nsapi_error_t TLSSocketWrapper::get_session(mbedtls_ssl_session *session)
+{
+    if (!_handshake_completed) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    int ret = mbedtls_ssl_get_session(&_ssl, session);
+    if (ret != 0) {
+        print_mbedtls_error("mbedtls_ssl_get_session", ret);
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    return NSAPI_ERROR_OK;
+}
+
+void TLSSocketWrapper::set_session(const mbedtls_ssl_session *session)
+{
+    _session = session;
+}
+
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0) && defined(MBEDTLS_X509_CRT_PARSE_C)
+void TLSSocketWrapper::session_cache_store()
+{
+    if (!_ssl.hostname) {
+        return;
+    }
+
+    tls_session_cache_mutex->lock();
+
+    int index = -1;
+    uint64_t accessed = UINT64_MAX;
+
+    // Finds entry of the host, free or last accessed entry
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i] && strcmp(tls_session_cache[i]->host, _ssl.hostname) == 0) {
+            index = i;
+            break;
+        } else if (!tls_session_cache[i]) {
+            accessed = 0;
+            index = i;
+        } else if (tls_session_cache[i]->accessed < accessed) {
+            accessed = tls_session_cache[i]->accessed;
+            index = i;
+        }
+    }
+
+    // Allocates in case entry is free, otherwise reuses
+    TLS_SESSION_CACHE *entry = tls_session_cache[index];
+    if (!entry) {
+        entry = new (std::nothrow) TLS_SESSION_CACHE;
+        if (!entry) {
+            tls_session_cache_mutex->unlock();
+            return;
+        }
+        entry->host = NULL;
+        mbedtls_ssl_session_init(&entry->session);
+        tls_session_cache[index] = entry;
+    } else {
+        mbedtls_ssl_session_free(&entry->session);
+        mbedtls_ssl_session_init(&entry->session);
+    }
+
+    if (!entry->host || strcmp(entry->host, _ssl.hostname) != 0) {
+        delete[] entry->host;
+        entry->host = new (std::nothrow) char[strlen(_ssl.hostname) + 1];
+    }
+
+    int ret = -1;
+    if (entry->host) {
+        strcpy(entry->host, _ssl.hostname);
+        ret = mbedtls_ssl_get_session(&_ssl, &entry->session);
+    }
+    if (ret != 0) {
+        mbedtls_ssl_session_free(&entry->session);
+        delete[] entry->host;
+        delete entry;
+        tls_session_cache[index] = NULL;
+    } else {
+        entry->accessed = rtos::Kernel::get_ms_count();
+    }
+
+    tls_session_cache_mutex->unlock();
+}
+
+void TLSSocketWrapper::session_cache_load()
+{
+    if (!_ssl.hostname) {
+        return;
+    }
+
+    tls_session_cache_mutex->lock();
+
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i] && strcmp(tls_session_cache[i]->host, _ssl.hostname) == 0) {
+            int ret = mbedtls_ssl_set_session(&_ssl, &tls_session_cache[i]->session);
+            if (ret != 0) {
+                print_mbedtls_error("mbedtls_ssl_set_session", ret);
+            } else {
+                tr_debug("Resuming TLS session with %s", _ssl.hostname);
+                tls_session_cache[i]->accessed = rtos::Kernel::get_ms_count();
+            }
+            break;
+        }
+    }
+
+    tls_session_cache_mutex->unlock();
+}
+
+void TLSSocketWrapper::session_cache_remove()
+{
+    if (!_ssl.hostname) {
+        return;
+    }
+
+    tls_session_cache_mutex->lock();
+
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i] && strcmp(tls_session_cache[i]->host, _ssl.hostname) == 0) {
+            mbedtls_ssl_session_free(&tls_session_cache[i]->session);
+            delete[] tls_session_cache[i]->host;
+            delete tls_session_cache[i];
+            tls_session_cache[i] = NULL;
+            break;
+        }
+    }
+
+    tls_session_cache_mutex->unlock();
+}
+#endif
+
 
 nsapi_error_t TLSSocketWrapper::send(const void *data, nsapi_size_t size)
 {
@@ -122,6 +122,7 @@ public:
      *  @return         Number of sent bytes on success, negative error code on failure.
      */
     virtual nsapi_error_t send(const void *data, nsapi_size_t size);
+    using Socket::send;
 
     /** Receive data over a TLS socket.
      *
@@ -202,6 +203,48 @@ public:
      */
     mbedtls_ssl_context *get_ssl_context();
 
+    /** Set maximum fragment length to negotiate with the server.
+     *
+     * Limits the size of records the server sends, so that Mbed TLS can be built
+     * with record buffers smaller than the 16 kB maximum, see MBEDTLS_SSL_IN_CONTENT_LEN
+     * and MBEDTLS_SSL_OUT_CONTENT_LEN. Outgoing records are limited to the same length.
+     * If the server doesn't support the extension, it uses full size records.
+     *
+     * @note Must be called before calling connect(). Applies to the configuration
+     *       returned by get_ssl_config(), which may be shared with other sockets.
+     *
+     * @param length Maximum fragment length: 512, 1024, 2048 or 4096 bytes,
+     *               0 to not negotiate the length.
+     * @return NSAPI_ERROR_OK on success, NSAPI_ERROR_PARAMETER if the length isn't supported,
+     *         NSAPI_ERROR_UNSUPPORTED if Mbed TLS is built without MBEDTLS_SSL_MAX_FRAGMENT_LENGTH.
+     */
+    nsapi_error_t set_max_fragment_length(size_t length);
+
+    /** Get TLS session of the established connection.
+     *
+     * The session can be given to set_session() of a later connection to the
+     * same server to resume it with an abbreviated handshake.
+     *
+     * @param session Session initialized with mbedtls_ssl_session_init(), the caller
+     *                frees it with mbedtls_ssl_session_free().
+     * @return NSAPI_ERROR_OK on success, NSAPI_ERROR_NO_CONNECTION if the handshake
+     *         is not completed, NSAPI_ERROR_NO_MEMORY if the session can't be copied.
+     */
+    nsapi_error_t get_session(mbedtls_ssl_session *session);
+
+    /** Set TLS session to resume.
+     *
+     * If the server still knows the session, the handshake is abbreviated. Otherwise
+     * Mbed TLS falls back to a full handshake. A session set here takes precedence
+     * over the session cache (see nsapi.tls-session-cache-size).
+     *
+     * @note Must be called before calling connect(). The session is copied when the
+     *       handshake starts, so it must stay valid until then.
+     *
+     * @param session Session from get_session(), or NULL to not resume a session.
+     */
+    void set_session(const mbedtls_ssl_session *session);
+
 protected:
 #ifndef DOXYGEN_ONLY
     /** Initiates TLS Handshake.
@@ -224,6 +267,15 @@ protected:
     bool is_handshake_started() const;
 
     void event();
+
+    /** Completes setup of the SSL context before the handshake starts.
+     *
+     *  Called after mbedtls_ssl_setup(), derived classes can override this
+     *  to configure the SSL context further.
+     *
+     *  @return 0 on success, negative Mbed TLS error code on failure
+     */
+    virtual int ssl_setup_complete();
 #endif
 
 
@@ -252,6 +304,23 @@ private:
 
 #endif /* MBED_CONF_TLS_SOCKET_DEBUG_LEVEL > 0 */
 
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0) && defined(MBEDTLS_X509_CRT_PARSE_C)
+    /**
+     * Stores session of the completed handshake to the cache by hostname
+     */
+    void session_cache_store();
+
+    /**
+     * Sets the session cached for the hostname to be resumed
+     */
+    void session_cache_load();
+
+    /**
+     * Removes session cached for the hostname
+     */
+    void session_cache_remove();
+#endif
+
     /**
      * Receive callback for Mbed TLS
      */
@@ -279,6 +348,7 @@ private:
     mbedtls_x509_crt *_clicert;
 #endif
     mbedtls_ssl_config *_ssl_conf;
+    const mbedtls_ssl_session *_session;
 
     bool _connect_transport: 1;
     bool _close_transport: 1;
@@ -63,13 +63,26 @@ nsapi_size_or_error_t UDPSocket::sendto(const char *host, uint16_t port, const v
 
 nsapi_size_or_error_t UDPSocket::sendto(const SocketAddress &address, const void *data, nsapi_size_t size)
 {
+    nsapi_iovec_t iov = { const_cast<void *>(data), size };
+    return sendmsg(&address, &iov, 1);
+}
+
+nsapi_size_or_error_t UDPSocket::sendmsg(const SocketAddress *address, const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (!address) {
+        if (!_remote_peer) {
+            return NSAPI_ERROR_NO_ADDRESS;
+        }
+        address = &_remote_peer;
+    }
+
     _lock.lock();
     nsapi_size_or_error_t ret;
 
     _writers++;
     if (_socket) {
         _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
-        _socket_stats.stats_update_peer(this, address);
+        _socket_stats.stats_update_peer(this, *address);
     }
     while (true) {
         if (!_socket) {
@@ -78,7 +91,7 @@ nsapi_size_or_error_t UDPSocket::sendto(const SocketAddress &address, const void
         }
 
         core_util_atomic_flag_clear(&_pending);
-        nsapi_size_or_error_t sent = _stack->socket_sendto(_socket, address, data, size);
+        nsapi_size_or_error_t sent = _stack->socket_sendmsg(_socket, address, iov, iovcnt);
         if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
             _socket_stats.stats_update_sent_bytes(this, sent);
             ret = sent;
@@ -89,7 +102,9 @@ nsapi_size_or_error_t UDPSocket::sendto(const SocketAddress &address, const void
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
+            uint64_t blocked = _socket_stats.stats_blocking_start();
             flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _socket_stats.stats_update_send_blocked(this, blocked);
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -117,6 +132,12 @@ nsapi_size_or_error_t UDPSocket::send(const void *data, nsapi_size_t size)
 }
 
 nsapi_size_or_error_t UDPSocket::recvfrom(SocketAddress *address, void *buffer, nsapi_size_t size)
+{
+    nsapi_iovec_t iov = { buffer, size };
+    return recvmsg(address, &iov, 1);
+}
+
+nsapi_size_or_error_t UDPSocket::recvmsg(SocketAddress *address, nsapi_iovec_t *iov, unsigned iovcnt)
 {
     _lock.lock();
     nsapi_size_or_error_t ret;
@@ -138,7 +159,7 @@ nsapi_size_or_error_t UDPSocket::recvfrom(SocketAddress *address, void *buffer,
         }
 
         core_util_atomic_flag_clear(&_pending);
-        nsapi_size_or_error_t recv = _stack->socket_recvfrom(_socket, address, buffer, size);
+        nsapi_size_or_error_t recv = _stack->socket_recvmsg(_socket, address, iov, iovcnt);
 
         // Filter incomming packets using connected peer address
         if (recv >= 0 && _remote_peer && _remote_peer != *address) {
@@ -157,7 +178,202 @@ nsapi_size_or_error_t UDPSocket::recvfrom(SocketAddress *address, void *buffer,
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
+            uint64_t blocked = _socket_stats.stats_blocking_start();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _socket_stats.stats_update_recv_blocked(this, blocked);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t UDPSocket::recvfrom_buf(SocketAddress *address, NetStackBuffer &buf)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    SocketAddress ignored;
+
+    if (!address) {
+        address = &ignored;
+    }
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t recv = _stack->socket_recv_buf(_socket, address, buf);
+
+        // Filter incomming packets using connected peer address
+        if (recv >= 0 && _remote_peer && _remote_peer != *address) {
+            buf.release();
+            continue;
+        }
+
+        _socket_stats.stats_update_peer(this, _remote_peer);
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            _socket_stats.stats_update_recv_bytes(this, recv);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            uint64_t blocked = _socket_stats.stats_blocking_start();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _socket_stats.stats_update_recv_blocked(this, blocked);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t UDPSocket::sendto_batch(nsapi_msg_t *msgs, unsigned count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    _writers++;
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t sent = _stack->socket_sendto_batch(_socket, msgs, count);
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
+            for (nsapi_size_or_error_t i = 0; i < sent; i++) {
+                _socket_stats.stats_update_peer(this, msgs[i].address);
+                _socket_stats.stats_update_sent_bytes(this, msgs[i].result);
+            }
+            ret = sent;
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            uint64_t blocked = _socket_stats.stats_blocking_start();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _socket_stats.stats_update_send_blocked(this, blocked);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t UDPSocket::recvfrom_batch(nsapi_msg_t *msgs, unsigned count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t recv = _stack->socket_recvfrom_batch(_socket, msgs, count);
+
+        // Filter incomming packets using connected peer address, keeping
+        // the accepted ones at the start of the array
+        if (recv > 0 && _remote_peer) {
+            nsapi_size_or_error_t kept = 0;
+            for (nsapi_size_or_error_t i = 0; i < recv; i++) {
+                if (_remote_peer != msgs[i].address) {
+                    continue;
+                }
+                if (kept != i) {
+                    // Received data has to move to the buffer of its new slot
+                    nsapi_size_t len = msgs[i].result < (nsapi_size_or_error_t)msgs[kept].size ? msgs[i].result : msgs[kept].size;
+                    memcpy(msgs[kept].data, msgs[i].data, len);
+                    msgs[kept].address = msgs[i].address;
+                    msgs[kept].result = len;
+                }
+                kept++;
+            }
+            if (!kept) {
+                continue;
+            }
+            recv = kept;
+        }
+
+        _socket_stats.stats_update_peer(this, _remote_peer);
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            for (nsapi_size_or_error_t i = 0; i < recv; i++) {
+                _socket_stats.stats_update_recv_bytes(this, msgs[i].result);
+            }
+            ret = recv;
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            uint64_t blocked = _socket_stats.stats_blocking_start();
             flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _socket_stats.stats_update_recv_blocked(this, blocked);
             _lock.lock();
 
             if (flag & osFlagsError) {
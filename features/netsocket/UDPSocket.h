@@ -23,6 +23,7 @@
 #include "netsocket/InternetSocket.h"
 #include "netsocket/NetworkStack.h"
 #include "netsocket/NetworkInterface.h"
+#include "netsocket/NetStackBuffer.h"
 #include "rtos/EventFlags.h"
 
 
@@ -135,6 +136,7 @@ public:
      *                  code on failure.
      */
     virtual nsapi_size_or_error_t send(const void *data, nsapi_size_t size);
+    using Socket::send;
 
     /** Receive data from a socket.
      *
@@ -156,6 +158,89 @@ public:
      */
     virtual nsapi_size_or_error_t recv(void *data, nsapi_size_t size);
 
+    /** Send a datagram gathered from several buffers.
+     *
+     *  @note If address is NULL, the datagram is sent to the connected remote address.
+     *
+     *  @copydetails InternetSocket::sendmsg
+     */
+    virtual nsapi_size_or_error_t sendmsg(const SocketAddress *address,
+                                          const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive a datagram scattered over several buffers.
+     *
+     *  @note If the datagram is larger than the buffers, the excess data is silently discarded.
+     *
+     *  @note If socket is connected, only packets coming from connected peer address
+     *  are accepted.
+     *
+     *  @copydetails InternetSocket::recvmsg
+     */
+    virtual nsapi_size_or_error_t recvmsg(SocketAddress *address,
+                                          nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive a datagram without copying it.
+     *
+     *  Fills buf with the network stack's buffers holding one datagram,
+     *  releasing any buffers it held before. Data stays in the stack's
+     *  receive memory until buf is released.
+     *
+     *  By default, recvfrom_buf blocks until a datagram is received. If socket is set to
+     *  non-blocking or times out with no data, NSAPI_ERROR_WOULD_BLOCK
+     *  is returned.
+     *
+     *  @note If socket is connected, only packets coming from connected peer address
+     *  are accepted.
+     *
+     *  @param address  Destination for the source address or NULL
+     *  @param buf      Handle to fill with the received datagram
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure. NSAPI_ERROR_UNSUPPORTED if the
+     *                  network stack can't lend its buffers.
+     */
+    nsapi_size_or_error_t recvfrom_buf(SocketAddress *address, NetStackBuffer &buf);
+
+    /** Send several datagrams.
+     *
+     *  Sends each message to its address in order and stores the number of
+     *  bytes sent in its result. Sending stops at the first message that
+     *  fails, which has the error stored in its result.
+     *
+     *  By default, sendto_batch blocks until the first message is sent. Later
+     *  messages are sent only as far as the stack accepts them without
+     *  blocking. If socket is set to nonblocking or times out before the
+     *  first message is sent, NSAPI_ERROR_WOULD_BLOCK is returned.
+     *
+     *  @param msgs     Array of messages to send.
+     *  @param count    Number of messages in the array.
+     *  @return         Number of messages sent if any were, otherwise
+     *                  negative error code.
+     */
+    nsapi_size_or_error_t sendto_batch(nsapi_msg_t *msgs, unsigned count);
+
+    /** Receive several datagrams.
+     *
+     *  Fills the messages in order with the datagrams received so far,
+     *  storing each source address and number of bytes received, which
+     *  saves a call into the network stack per datagram at high packet rates.
+     *
+     *  By default, recvfrom_batch blocks until a datagram is received, then
+     *  returns it together with any others already queued. If socket is set
+     *  to nonblocking or times out with no datagram, NSAPI_ERROR_WOULD_BLOCK
+     *  is returned.
+     *
+     *  @note If a datagram is larger than its buffer, the excess data is silently discarded.
+     *
+     *  @note If socket is connected, only packets coming from connected peer address
+     *  are accepted.
+     *
+     *  @param msgs     Array of messages to receive into.
+     *  @param count    Number of messages in the array.
+     *  @return         Number of messages received on success, negative
+     *                  error code on failure.
+     */
+    nsapi_size_or_error_t recvfrom_batch(nsapi_msg_t *msgs, unsigned count);
+
     /** Not implemented for UDP.
      *
      *  @param error      Not used.
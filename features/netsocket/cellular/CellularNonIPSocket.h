@@ -86,6 +86,7 @@ public:
     *                  code on failure.
     */
     virtual nsapi_size_or_error_t send(const void *data, nsapi_size_t size);
+    using Socket::send;
 
     /** Receive data from a socket.
     *
@@ -29,6 +29,7 @@
 
 /* \brief Flags for worker thread */
 #define FLAG_RX                 1
+#define FLAG_TX                 2
 
 /** \brief  Driver thread priority */
 #define THREAD_PRIORITY         (osPriorityHigh)
@@ -40,6 +41,14 @@
 #define STM_ETH_MTU_SIZE        1500
 #define STM_ETH_IF_NAME         "st"
 
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+/* Keep DMA buffers on their own cache lines, so invalidating one doesn't
+ * discard data belonging to its neighbours */
+#define STM_ETH_DMA_ALIGN       __SCB_DCACHE_LINE_SIZE
+#else
+#define STM_ETH_DMA_ALIGN       4
+#endif
+
 #if defined (__ICCARM__)   /*!< IAR Compiler */
 #pragma data_alignment=4
 #endif
@@ -50,6 +59,7 @@ __ALIGN_BEGIN ETH_DMADescTypeDef DMARxDscrTab[ETH_RXBUFNB] __ALIGN_END; /* Ether
 #endif
 __ALIGN_BEGIN ETH_DMADescTypeDef DMATxDscrTab[ETH_TXBUFNB] __ALIGN_END; /* Ethernet Tx DMA Descriptor */
 
+#if !MBED_CONF_STM32_EMAC_ZERO_COPY
 #if defined (__ICCARM__)   /*!< IAR Compiler */
 #pragma data_alignment=4
 #endif
@@ -59,6 +69,7 @@ __ALIGN_BEGIN uint8_t Rx_Buff[ETH_RXBUFNB][ETH_RX_BUF_SIZE] __ALIGN_END; /* Ethe
 #pragma data_alignment=4
 #endif
 __ALIGN_BEGIN uint8_t Tx_Buff[ETH_TXBUFNB][ETH_TX_BUF_SIZE] __ALIGN_END; /* Ethernet Transmit Buffer */
+#endif
 
 __weak uint8_t mbed_otp_mac_address(char *mac);
 void mbed_default_mac_address(char *mac);
@@ -69,6 +80,9 @@ extern "C" {
 
 void _eth_config_mac(ETH_HandleTypeDef *heth);
 void HAL_ETH_RxCpltCallback(ETH_HandleTypeDef *heth);
+#if MBED_CONF_STM32_EMAC_ZERO_COPY
+void HAL_ETH_TxCpltCallback(ETH_HandleTypeDef *heth);
+#endif
 void ETH_IRQHandler(void);
 
 #ifdef __cplusplus
@@ -89,6 +103,22 @@ void HAL_ETH_RxCpltCallback(ETH_HandleTypeDef *heth)
     }
 }
 
+#if MBED_CONF_STM32_EMAC_ZERO_COPY
+/**
+ * Ethernet Tx Transfer completed callback
+ *
+ * @param  heth: ETH handle
+ * @retval None
+ */
+void HAL_ETH_TxCpltCallback(ETH_HandleTypeDef *heth)
+{
+    STM32_EMAC &emac = STM32_EMAC::get_instance();
+    if (emac.thread) {
+        osThreadFlagsSet(emac.thread, FLAG_TX);
+    }
+}
+#endif
+
 /**
  * Ethernet IRQ Handler
  *
@@ -142,15 +172,35 @@ bool STM32_EMAC::low_level_init_successful()
 #endif
     EthHandle.Init.MACAddr = &MACAddr[0];
     EthHandle.Init.RxMode = ETH_RXINTERRUPT_MODE;
+#if MBED_CONF_STM32_EMAC_CHECKSUM_OFFLOAD
+    EthHandle.Init.ChecksumMode = ETH_CHECKSUM_BY_HARDWARE;
+#else
     EthHandle.Init.ChecksumMode = ETH_CHECKSUM_BY_SOFTWARE;
+#endif
     EthHandle.Init.MediaInterface = ETH_MEDIA_INTERFACE_RMII;
     HAL_ETH_Init(&EthHandle);
 
+#if MBED_CONF_STM32_EMAC_ZERO_COPY
+    /* Initialize Tx Descriptors list: Chain Mode. Buffer addresses are
+     * filled in per frame by link_out */
+    HAL_ETH_DMATxDescListInit(&EthHandle, DMATxDscrTab, NULL, ETH_TXBUFNB);
+    memset(tx_buf, 0, sizeof(tx_buf));
+    tx_head = 0;
+    tx_tail = 0;
+    tx_used = 0;
+
+    /* Initialize Rx Descriptors list: Chain Mode, then bind them to pool buffers */
+    HAL_ETH_DMARxDescListInit(&EthHandle, DMARxDscrTab, NULL, ETH_RXBUFNB);
+    if (!rx_buffers_init()) {
+        return false;
+    }
+#else
     /* Initialize Tx Descriptors list: Chain Mode */
     HAL_ETH_DMATxDescListInit(&EthHandle, DMATxDscrTab, &Tx_Buff[0][0], ETH_TXBUFNB);
 
     /* Initialize Rx Descriptors list: Chain Mode  */
     HAL_ETH_DMARxDescListInit(&EthHandle, DMARxDscrTab, &Rx_Buff[0][0], ETH_RXBUFNB);
+#endif
 
     /* Configure MAC */
     _eth_config_mac(&EthHandle);
@@ -158,9 +208,88 @@ bool STM32_EMAC::low_level_init_successful()
     /* Enable MAC and DMA transmission and reception */
     HAL_ETH_Start(&EthHandle);
 
+#if MBED_CONF_STM32_EMAC_ZERO_COPY
+    /* Transmitted frames are handed back to the memory manager from the thread */
+    __HAL_ETH_DMA_ENABLE_IT(&EthHandle, ETH_DMA_IT_T);
+#endif
+
     return true;
 }
 
+#if MBED_CONF_STM32_EMAC_ZERO_COPY
+/**
+ * Allocates a pool buffer for every Rx descriptor and gives them to the DMA.
+ *
+ * Each buffer is a single pool unit, so a frame larger than the pool
+ * unit is received across several descriptors.
+ *
+ * @return true if every descriptor got a buffer
+ */
+bool STM32_EMAC::rx_buffers_init()
+{
+    rx_buf_size = memory_manager->get_pool_alloc_unit(STM_ETH_DMA_ALIGN) & ~(STM_ETH_DMA_ALIGN - 1);
+    if (rx_buf_size > ETH_DMARXDESC_RBS1) {
+        rx_buf_size = ETH_DMARXDESC_RBS1 & ~(STM_ETH_DMA_ALIGN - 1);
+    }
+
+    for (uint32_t i = 0; i < ETH_RXBUFNB; i++) {
+        rx_buf[i] = memory_manager->alloc_pool(rx_buf_size, STM_ETH_DMA_ALIGN);
+        if (rx_buf[i] && memory_manager->get_next(rx_buf[i])) {
+            memory_manager->free(rx_buf[i]);
+            rx_buf[i] = NULL;
+        }
+        if (!rx_buf[i]) {
+            while (i > 0) {
+                memory_manager->free(rx_buf[--i]);
+                rx_buf[i] = NULL;
+            }
+            return false;
+        }
+        rx_descriptor_arm(i);
+    }
+
+    return true;
+}
+
+/**
+ * Points an Rx descriptor at its pool buffer and gives it back to the DMA.
+ *
+ * @param index Index of the descriptor in DMARxDscrTab
+ */
+void STM32_EMAC::rx_descriptor_arm(uint32_t index)
+{
+    ETH_DMADescTypeDef *dmarxdesc = &DMARxDscrTab[index];
+    void *ptr = memory_manager->get_ptr(rx_buf[index]);
+
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    /* Drop any lines of the buffer still cached, so they can't be evicted over the received data */
+    SCB_InvalidateDCache_by_Addr(ptr, rx_buf_size);
+#endif
+
+    dmarxdesc->Buffer1Addr = reinterpret_cast<uint32_t>(ptr);
+    dmarxdesc->ControlBufferSize = ETH_DMARXDESC_RCH | rx_buf_size;
+    __DMB();
+    dmarxdesc->Status = ETH_DMARXDESC_OWN;
+}
+
+/**
+ * Hands frames the DMA has finished transmitting back to the memory manager.
+ *
+ * Must be called with TXLockMutex held.
+ */
+void STM32_EMAC::tx_reclaim()
+{
+    while (tx_used && !(DMATxDscrTab[tx_tail].Status & ETH_DMATXDESC_OWN)) {
+        if (tx_buf[tx_tail]) {
+            memory_manager->free(tx_buf[tx_tail]);
+            tx_buf[tx_tail] = NULL;
+        }
+        tx_tail = (tx_tail + 1) % ETH_TXBUFNB;
+        tx_used--;
+    }
+}
+#endif
+
 /**
  * This function should do the actual transmission of the packet. The packet is
  * contained in the memory buffer chain that is passed to the function.
@@ -174,6 +303,120 @@ bool STM32_EMAC::low_level_init_successful()
  *       to become availale since the stack doesn't retry to send a packet
  *       dropped because of memory failure (except for the TCP timers).
  */
+#if MBED_CONF_STM32_EMAC_ZERO_COPY
+bool STM32_EMAC::link_out(emac_mem_buf_t *buf)
+{
+    bool success = false;
+    emac_mem_buf_t *q;
+    uint32_t segcount = 0;
+
+    /* Get exclusive access */
+    TXLockMutex.lock();
+
+    tx_reclaim();
+
+    for (q = buf; q != NULL; q = memory_manager->get_next(q)) {
+        if (memory_manager->get_len(q)) {
+            segcount++;
+        }
+    }
+
+    /* A chain longer than the descriptor ring can never be sent in place, flatten it */
+    if (segcount > ETH_TXBUFNB) {
+        uint32_t framelength = memory_manager->get_total_len(buf);
+        emac_mem_buf_t *flat = memory_manager->alloc_heap(framelength, 0);
+        if (flat == NULL) {
+            memory_manager->free(buf);
+            goto error;
+        }
+        memory_manager->copy_from_buf(memory_manager->get_ptr(flat), framelength, buf);
+        memory_manager->free(buf);
+        buf = flat;
+        segcount = 1;
+    }
+
+    /* Are enough descriptors available? If not, goto error */
+    if (segcount == 0 || segcount > ETH_TXBUFNB - tx_used) {
+        memory_manager->free(buf);
+        goto error;
+    }
+
+    {
+        /* Point one descriptor at each segment, the buffer chain is held by
+         * the last one until the DMA has sent the frame */
+        ETH_DMADescTypeDef *first = &DMATxDscrTab[tx_head];
+        uint32_t seg = 0;
+
+        for (q = buf; q != NULL; q = memory_manager->get_next(q)) {
+            uint32_t len = memory_manager->get_len(q);
+            if (len == 0) {
+                continue;
+            }
+
+            ETH_DMADescTypeDef *dmatxdesc = &DMATxDscrTab[tx_head];
+            void *ptr = memory_manager->get_ptr(q);
+
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+            SCB_CleanDCache_by_Addr(static_cast<uint32_t *>(ptr), len);
+#endif
+
+            uint32_t status = ETH_DMATXDESC_TCH;
+#if MBED_CONF_STM32_EMAC_CHECKSUM_OFFLOAD
+            status |= ETH_DMATXDESC_CHECKSUMTCPUDPICMPFULL;
+#endif
+            if (seg == 0) {
+                status |= ETH_DMATXDESC_FS;
+            }
+            if (++seg == segcount) {
+                status |= ETH_DMATXDESC_LS | ETH_DMATXDESC_IC;
+                tx_buf[tx_head] = buf;
+            }
+            /* The first descriptor is given to the DMA last, once the whole frame is in place */
+            if (dmatxdesc != first) {
+                status |= ETH_DMATXDESC_OWN;
+            }
+
+            dmatxdesc->Buffer1Addr = reinterpret_cast<uint32_t>(ptr);
+            dmatxdesc->ControlBufferSize = len & ETH_DMATXDESC_TBS1;
+            dmatxdesc->Status = status;
+
+            tx_head = (tx_head + 1) % ETH_TXBUFNB;
+        }
+        tx_used += segcount;
+
+        __DMB();
+        first->Status |= ETH_DMATXDESC_OWN;
+        __DSB();
+    }
+
+    /* When Tx Buffer unavailable flag is set: clear it and resume transmission */
+    if ((EthHandle.Instance->DMASR & ETH_DMASR_TBUS) != (uint32_t)RESET) {
+        /* Clear TBUS ETHERNET DMA flag */
+        EthHandle.Instance->DMASR = ETH_DMASR_TBUS;
+
+        /* Resume DMA transmission*/
+        EthHandle.Instance->DMATPDR = 0;
+    }
+
+    success = true;
+
+error:
+
+    /* When Transmit Underflow flag is set, clear it and issue a Transmit Poll Demand to resume transmission */
+    if ((EthHandle.Instance->DMASR & ETH_DMASR_TUS) != (uint32_t)RESET) {
+        /* Clear TUS ETHERNET DMA flag */
+        EthHandle.Instance->DMASR = ETH_DMASR_TUS;
+
+        /* Resume DMA transmission*/
+        EthHandle.Instance->DMATPDR = 0;
+    }
+
+    /* Restore access */
+    TXLockMutex.unlock();
+
+    return success;
+}
+#else
 bool STM32_EMAC::link_out(emac_mem_buf_t *buf)
 {
     bool success;
@@ -252,6 +495,7 @@ error:
 
     return success;
 }
+#endif
 
 /**
  * Should allocate a contiguous memory buffer and transfer the bytes of the incoming
@@ -262,6 +506,89 @@ error:
  * @return negative value when no more frames,
  *         zero when frame is received
  */
+#if MBED_CONF_STM32_EMAC_ZERO_COPY
+int STM32_EMAC::low_level_input(emac_mem_buf_t **buf)
+{
+    emac_mem_buf_t *fresh[ETH_RXBUFNB];
+    uint32_t first;
+    uint32_t index;
+    uint32_t i;
+
+    /* get received frame */
+    if (HAL_ETH_GetReceivedFrame_IT(&EthHandle) != HAL_OK) {
+        return -1;
+    }
+
+    first = EthHandle.RxFrameInfos.FSRxDesc - DMARxDscrTab;
+
+    /* Replacement buffers for every descriptor of the frame. If the pool is
+     * short, the frame is dropped and the descriptors keep their buffers */
+    for (i = 0; i < EthHandle.RxFrameInfos.SegCount; i++) {
+        fresh[i] = memory_manager->alloc_pool(rx_buf_size, STM_ETH_DMA_ALIGN);
+        if (fresh[i] && memory_manager->get_next(fresh[i])) {
+            memory_manager->free(fresh[i]);
+            fresh[i] = NULL;
+        }
+        if (!fresh[i]) {
+            break;
+        }
+    }
+
+    if (i == EthHandle.RxFrameInfos.SegCount) {
+        uint32_t byteslefttotake = EthHandle.RxFrameInfos.length;
+
+        /* Chain the filled buffers into the frame, trimming the last one to
+         * the frame length. A trailing buffer holding only CRC is freed */
+        index = first;
+        for (i = 0; i < EthHandle.RxFrameInfos.SegCount; i++) {
+            emac_mem_buf_t *q = rx_buf[index];
+            uint32_t len = byteslefttotake < rx_buf_size ? byteslefttotake : rx_buf_size;
+
+            rx_buf[index] = fresh[i];
+
+            if (len) {
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+                SCB_InvalidateDCache_by_Addr(memory_manager->get_ptr(q), len);
+#endif
+                memory_manager->set_len(q, len);
+                if (*buf == NULL) {
+                    *buf = q;
+                } else {
+                    memory_manager->cat(*buf, q);
+                }
+                byteslefttotake -= len;
+            } else {
+                memory_manager->free(q);
+            }
+
+            index = (index + 1) % ETH_RXBUFNB;
+        }
+    } else {
+        while (i > 0) {
+            memory_manager->free(fresh[--i]);
+        }
+    }
+
+    /* Release descriptors to DMA */
+    index = first;
+    for (i = 0; i < EthHandle.RxFrameInfos.SegCount; i++) {
+        rx_descriptor_arm(index);
+        index = (index + 1) % ETH_RXBUFNB;
+    }
+
+    /* Clear Segment_Count */
+    EthHandle.RxFrameInfos.SegCount = 0;
+
+    /* When Rx Buffer unavailable flag is set: clear it and resume reception */
+    if ((EthHandle.Instance->DMASR & ETH_DMASR_RBUS) != (uint32_t)RESET) {
+        /* Clear RBUS ETHERNET DMA flag */
+        EthHandle.Instance->DMASR = ETH_DMASR_RBUS;
+        /* Resume DMA reception */
+        EthHandle.Instance->DMARPDR = 0;
+    }
+    return 0;
+}
+#else
 int STM32_EMAC::low_level_input(emac_mem_buf_t **buf)
 {
     uint16_t len = 0;
@@ -336,6 +663,7 @@ int STM32_EMAC::low_level_input(emac_mem_buf_t **buf)
     }
     return 0;
 }
+#endif
 
 
 /** \brief  Attempt to read a packet from the EMAC interface.
@@ -366,11 +694,19 @@ void STM32_EMAC::thread_function(void *pvParameters)
     static struct STM32_EMAC *stm32_enet = static_cast<STM32_EMAC *>(pvParameters);
 
     for (;;) {
-        uint32_t flags = osThreadFlagsWait(FLAG_RX, osFlagsWaitAny, osWaitForever);
+        uint32_t flags = osThreadFlagsWait(FLAG_RX | FLAG_TX, osFlagsWaitAny, osWaitForever);
 
         if (flags & FLAG_RX) {
             stm32_enet->packet_rx();
         }
+
+#if MBED_CONF_STM32_EMAC_ZERO_COPY
+        if (flags & FLAG_TX) {
+            stm32_enet->TXLockMutex.lock();
+            stm32_enet->tx_reclaim();
+            stm32_enet->TXLockMutex.unlock();
+        }
+#endif
     }
 }
 
@@ -526,6 +862,17 @@ uint32_t STM32_EMAC::get_align_preference() const
     return 0;
 }
 
+uint32_t STM32_EMAC::get_checksum_offload() const
+{
+#if MBED_CONF_STM32_EMAC_CHECKSUM_OFFLOAD
+    /* ICMPv6 is left to the stack */
+    return CHECKSUM_OFFLOAD_GEN_IP | CHECKSUM_OFFLOAD_GEN_UDP | CHECKSUM_OFFLOAD_GEN_TCP | CHECKSUM_OFFLOAD_GEN_ICMP |
+           CHECKSUM_OFFLOAD_CHECK_IP | CHECKSUM_OFFLOAD_CHECK_UDP | CHECKSUM_OFFLOAD_CHECK_TCP | CHECKSUM_OFFLOAD_CHECK_ICMP;
+#else
+    return CHECKSUM_OFFLOAD_NONE;
+#endif
+}
+
 void STM32_EMAC::get_ifname(char *name, uint8_t size) const
 {
     memcpy(name, STM_ETH_IF_NAME, (size < sizeof(STM_ETH_IF_NAME)) ? size : sizeof(STM_ETH_IF_NAME));
@@ -18,6 +18,7 @@
 
 #include "EMAC.h"
 #include "rtos/Mutex.h"
+#include "stm32xx_emac_config.h"
 
 class STM32_EMAC : public EMAC {
 public:
@@ -42,6 +43,13 @@ public:
      */
     virtual uint32_t get_align_preference() const;
 
+    /**
+     * Return checksum offload capabilities
+     *
+     * @return     Bitmask of checksums generated and checked in hardware
+     */
+    virtual uint32_t get_checksum_offload() const;
+
     /**
      * Return interface name
      *
@@ -154,6 +162,11 @@ private:
     bool low_level_init_successful();
     void packet_rx();
     int low_level_input(emac_mem_buf_t **buf);
+#if MBED_CONF_STM32_EMAC_ZERO_COPY
+    bool rx_buffers_init();
+    void rx_descriptor_arm(uint32_t index);
+    void tx_reclaim();
+#endif
     static void thread_function(void *pvParameters);
     static void rmii_watchdog_thread_function(void *pvParameters);
     void phy_task();
@@ -171,6 +184,15 @@ private:
     emac_link_state_change_cb_t emac_link_state_cb; /**< Link state change callback */
     EMACMemoryManager *memory_manager; /**< Memory manager */
 
+#if MBED_CONF_STM32_EMAC_ZERO_COPY
+    emac_mem_buf_t *rx_buf[ETH_RXBUFNB]; /**< Pool buffer bound to each Rx descriptor */
+    emac_mem_buf_t *tx_buf[ETH_TXBUFNB]; /**< Frame held by the last Tx descriptor it uses */
+    uint32_t rx_buf_size; /**< Usable length of each Rx pool buffer */
+    uint32_t tx_head; /**< Next Tx descriptor to fill */
+    uint32_t tx_tail; /**< Oldest Tx descriptor not yet reclaimed */
+    uint32_t tx_used; /**< Tx descriptors between tail and head */
+#endif
+
     uint32_t phy_status;
     int phy_task_handle; /**< Handle for phy task event */
 };
@@ -19,4 +19,12 @@
 
 #define THREAD_STACKSIZE              512
 
+#ifndef MBED_CONF_STM32_EMAC_CHECKSUM_OFFLOAD
+#define MBED_CONF_STM32_EMAC_CHECKSUM_OFFLOAD 0
+#endif
+
+#ifndef MBED_CONF_STM32_EMAC_ZERO_COPY
+#define MBED_CONF_STM32_EMAC_ZERO_COPY 0
+#endif
+
 #endif // #define STM32XX_EMAC_CONFIG_H__
@@ -153,6 +153,23 @@ bool WHD_EMAC::link_out(emac_mem_buf_t *buf)
 
     uint16_t size = memory_manager->get_total_len(buf);
 
+    // WHD buffers are the stack's own buffers, so a frame held in a single
+    // aligned buffer with room in front for the bus headers is handed over
+    // as it is. The reference passed to link_out goes to WHD, which
+    // releases it once sent. See lwip.pbuf-link-encapsulation-hlen
+    whd_buffer_t frame = buf;
+    if (memory_manager->get_next(buf) == NULL &&
+            ((uintptr_t)memory_manager->get_ptr(buf) & 3) == 0 &&
+            whd_buffer_add_remove_at_front(drvp, &frame, -(int32_t)offset) == WHD_SUCCESS) {
+        whd_buffer_add_remove_at_front(drvp, &frame, offset);
+
+        if (activity_cb) {
+            activity_cb(true);
+        }
+        whd_network_send_ethernet_data(ifp, frame);
+        return true;
+    }
+
     whd_result_t res = whd_host_buffer_get(drvp, &buffer, WHD_NETWORK_TX, size + offset, WHD_TRUE);
     if (res != WHD_SUCCESS) {
         memory_manager->free(buf);
@@ -40,6 +40,7 @@
 #include "netsocket/UDPSocket.h"
 #include "netsocket/TCPSocket.h"
 #include "netsocket/TCPServer.h"
+#include "netsocket/SocketSet.h"
 #include "netsocket/TLSSocketWrapper.h"
 #include "netsocket/DTLSSocketWrapper.h"
 #include "netsocket/TLSSocket.h"
@@ -43,11 +43,28 @@
 #define DNS_QUERY_QUEUE_SIZE 5
 #define DNS_HOST_NAME_MAX_LEN 255
 #define DNS_TIMER_TIMEOUT 100
+#define DNS_RCODE_NXDOMAIN 3
+#define DNS_SERVER_DEMOTED 2
+#define DNS_SERVER_PENALTY_MAX 8
+
+#ifndef MBED_CONF_NSAPI_DNS_CACHE_NEGATIVE_TTL
+#define MBED_CONF_NSAPI_DNS_CACHE_NEGATIVE_TTL 0
+#endif
+
+#ifndef MBED_CONF_NSAPI_DNS_CACHE_PREFETCH
+#define MBED_CONF_NSAPI_DNS_CACHE_PREFETCH 0
+#endif
+
+#ifndef MBED_CONF_NSAPI_DNS_PARALLEL_SERVERS
+#define MBED_CONF_NSAPI_DNS_PARALLEL_SERVERS 1
+#endif
 
 struct DNS_CACHE {
-    nsapi_addr_t address;
+    nsapi_addr_t address;  /*!< NSAPI_UNSPEC for a cached non-existent host name */
     char *host;
+    uint32_t hash;         /*!< hash of the host name */
     uint64_t expires;      /*!< time to live in milliseconds */
+    uint64_t prefetch;     /*!< refresh from asynchronous queries after this time */
     uint64_t accessed;     /*!< last accessed */
 };
 
@@ -76,10 +93,13 @@ struct DNS_QUERY {
     SOCKET_CB_DATA *socket_cb_data;
     nsapi_addr_t *addrs;
     uint32_t ttl;
+    bool nxdomain;
     uint32_t total_timeout;
     uint32_t socket_timeout;
     uint16_t dns_message_id;
+    uint16_t dns_servers_pending; /*!< servers queried on this round that have not replied */
     uint8_t dns_server;
+    uint8_t dns_server_next;
     uint8_t retries;
     uint8_t total_attempts;
     uint8_t send_success;
@@ -88,10 +108,14 @@ struct DNS_QUERY {
 };
 
 static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl);
-static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address);
+static void nsapi_dns_cache_add_nxdomain(const char *host);
+static nsapi_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address, bool *prefetch = NULL);
 
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr, const char *interface_name);
 
+static nsapi_value_or_error_t nsapi_dns_query_async_queue(NetworkStack *stack, const char *host,
+                                                          NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
+                                                          call_in_callback_cb_t call_in_cb, const char *interface_name, nsapi_version_t version);
 static void nsapi_dns_query_async_create(void *ptr);
 static nsapi_error_t nsapi_dns_query_async_delete(int unique_id);
 static void nsapi_dns_query_async_send(void *ptr);
@@ -127,6 +151,8 @@ static DNS_QUERY *dns_query_queue[DNS_QUERY_QUEUE_SIZE];
 static SingletonPtr<PlatformMutex> dns_mutex;
 static SingletonPtr<call_in_callback_cb_t> dns_call_in;
 static bool dns_timer_running = false;
+// Health of DNS servers used by asynchronous queries, servers that time out are skipped for a while
+static uint8_t dns_server_penalty[DNS_STACK_SERVERS_NUM + DNS_SERVERS_SIZE];
 
 // DNS server configuration
 extern "C" nsapi_error_t nsapi_dns_add_server(nsapi_addr_t addr, const char *interface_name)
@@ -214,10 +240,12 @@ static int dns_append_question(uint8_t *ptr, uint16_t id, const char *host, nsap
     return *p - s_ptr;
 }
 
-static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl, nsapi_addr_t *addr, unsigned addr_count)
+static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl, bool *nxdomain, nsapi_addr_t *addr, unsigned addr_count)
 {
     const uint8_t **p = &ptr;
 
+    *nxdomain = false;
+
     // scan header
     uint16_t id    = dns_scan_word(p);
     uint16_t flags = dns_scan_word(p);
@@ -236,6 +264,7 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl,
     }
 
     if (rcode != 0) {
+        *nxdomain = rcode == DNS_RCODE_NXDOMAIN;
         return 0;
     }
 
@@ -256,6 +285,7 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl,
 
     // scan each response
     unsigned count = 0;
+    *ttl = INT32_MAX;
 
     for (int i = 0; i < ancount && count < addr_count; i++) {
         while (true) {
@@ -275,11 +305,8 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl,
         uint32_t ttl_val  = dns_scan_word32(p);  // ttl
         uint16_t rdlength = dns_scan_word(p);    // rdlength
 
-        if (i == 0) {
-            // Is interested only on first address that is stored to cache
-            if (ttl_val > INT32_MAX) {
-                ttl_val = INT32_MAX;
-            }
+        // Cached entry is valid as long as all records of a CNAME chain are
+        if (ttl_val < *ttl) {
             *ttl = ttl_val;
         }
 
@@ -310,27 +337,38 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl,
     return count;
 }
 
-static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl)
-{
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
-    // RFC 1034: if TTL is zero, entry is not added to cache
-    if (ttl == 0) {
-        return;
+static uint32_t nsapi_dns_cache_hash(const char *host)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261U;
+    while (*host) {
+        hash ^= (uint8_t) *host++;
+        hash *= 16777619U;
     }
+    return hash;
+}
 
-    // Checks if already cached
-    if (nsapi_dns_cache_find(host, address->version, NULL) == NSAPI_ERROR_OK) {
-        return;
-    }
+static void nsapi_dns_cache_store(const char *host, const nsapi_addr_t *address, uint32_t ttl)
+{
+    uint32_t hash = nsapi_dns_cache_hash(host);
+    uint64_t ms_count = rtos::Kernel::get_ms_count();
 
     dns_cache_mutex->lock();
 
     int index = -1;
     uint64_t accessed = UINT64_MAX;
 
-    // Finds free or last accessed entry
+    // Finds entry of the same host name (and address family), otherwise free or least recently used entry
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
         if (!dns_cache[i]) {
+            if (accessed) {
+                index = i;
+                accessed = 0;
+            }
+        } else if (dns_cache[i]->hash == hash && strcmp(dns_cache[i]->host, host) == 0 &&
+                   (address->version == NSAPI_UNSPEC || dns_cache[i]->address.version == NSAPI_UNSPEC ||
+                    dns_cache[i]->address.version == address->version)) {
             index = i;
             break;
         } else if (dns_cache[i]->accessed <= accessed) {
@@ -347,45 +385,94 @@ static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_
     // Allocates in case entry is free, otherwise reuses
     if (!dns_cache[index]) {
         dns_cache[index] = new (std::nothrow) DNS_CACHE;
-    } else {
-        delete dns_cache[index]->host;
+        if (dns_cache[index]) {
+            dns_cache[index]->host = NULL;
+        }
     }
 
     if (dns_cache[index]) {
+        if (!dns_cache[index]->host || strcmp(dns_cache[index]->host, host) != 0) {
+            delete[] dns_cache[index]->host;
+            dns_cache[index]->host = new (std::nothrow) char[strlen(host) + 1];
+            if (!dns_cache[index]->host) {
+                delete dns_cache[index];
+                dns_cache[index] = NULL;
+                dns_cache_mutex->unlock();
+                return;
+            }
+            strcpy(dns_cache[index]->host, host);
+        }
         dns_cache[index]->address = *address;
-        dns_cache[index]->host = new (std::nothrow) char[strlen(host) + 1];
-        strcpy(dns_cache[index]->host, host);
-        uint64_t ms_count = rtos::Kernel::get_ms_count();
+        dns_cache[index]->hash = hash;
         dns_cache[index]->expires = ms_count + (uint64_t) ttl * 1000;
+        // Refreshes entry when it is in the last eighth of its lifetime
+        dns_cache[index]->prefetch = dns_cache[index]->expires - (uint64_t) ttl * 1000 / 8;
         dns_cache[index]->accessed = ms_count;
     }
 
     dns_cache_mutex->unlock();
+}
+#endif
+
+static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl)
+{
+#if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+    // RFC 1034: if TTL is zero, entry is not added to cache
+    if (ttl == 0) {
+        return;
+    }
+
+    nsapi_dns_cache_store(host, address, ttl);
+#endif
+}
+
+static void nsapi_dns_cache_add_nxdomain(const char *host)
+{
+#if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0) && (MBED_CONF_NSAPI_DNS_CACHE_NEGATIVE_TTL > 0)
+    nsapi_addr_t address = {};
+    address.version = NSAPI_UNSPEC;
+
+    nsapi_dns_cache_store(host, &address, MBED_CONF_NSAPI_DNS_CACHE_NEGATIVE_TTL);
 #endif
 }
 
-static nsapi_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address)
+static nsapi_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address, bool *prefetch)
 {
     nsapi_error_t ret_val = NSAPI_ERROR_NO_ADDRESS;
 
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+    uint32_t hash = nsapi_dns_cache_hash(host);
+
     dns_cache_mutex->lock();
 
+    uint64_t ms_count = rtos::Kernel::get_ms_count();
+
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
         if (dns_cache[i]) {
-            uint64_t ms_count = rtos::Kernel::get_ms_count();
             // Checks all entries for expired entries
             if (ms_count > dns_cache[i]->expires) {
-                delete dns_cache[i]->host;
+                delete[] dns_cache[i]->host;
                 delete dns_cache[i];
                 dns_cache[i] = NULL;
-            } else if ((version == NSAPI_UNSPEC || version == dns_cache[i]->address.version) &&
+            } else if (ret_val == NSAPI_ERROR_NO_ADDRESS && dns_cache[i]->hash == hash &&
                        strcmp(dns_cache[i]->host, host) == 0) {
-                if (address) {
-                    *address = dns_cache[i]->address;
+                if (dns_cache[i]->address.version == NSAPI_UNSPEC) {
+                    // Host name is known not to exist
+                    ret_val = NSAPI_ERROR_DNS_FAILURE;
+                } else if (version == NSAPI_UNSPEC || version == dns_cache[i]->address.version) {
+                    if (address) {
+                        *address = dns_cache[i]->address;
+                    }
+                    ret_val = NSAPI_ERROR_OK;
+                } else {
+                    continue;
+                }
+                if (prefetch && ms_count > dns_cache[i]->prefetch) {
+                    // Only one refresh per entry, next one is scheduled when the entry is stored again
+                    *prefetch = true;
+                    dns_cache[i]->prefetch = dns_cache[i]->expires;
                 }
                 dns_cache[i]->accessed = ms_count;
-                ret_val = NSAPI_ERROR_OK;
             }
         }
     }
@@ -443,8 +530,11 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
     }
 
     // check cache
-    if (nsapi_dns_cache_find(host, version, addr) == NSAPI_ERROR_OK) {
+    nsapi_error_t cached = nsapi_dns_cache_find(host, version, addr);
+    if (cached == NSAPI_ERROR_OK) {
         return 1;
+    } else if (cached == NSAPI_ERROR_DNS_FAILURE) {
+        return NSAPI_ERROR_DNS_FAILURE;
     }
 
     // create a udp socket
@@ -517,12 +607,15 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
 
         const uint8_t *response = packet;
         uint32_t ttl;
-        int resp = dns_scan_response(response, 1, &ttl, addr, addr_count);
+        bool nxdomain;
+        int resp = dns_scan_response(response, 1, &ttl, &nxdomain, addr, addr_count);
         if (resp > 0) {
             nsapi_dns_cache_add(host, addr, ttl);
             result = resp;
         } else if (resp < 0) {
             continue;
+        } else if (nxdomain) {
+            nsapi_dns_cache_add_nxdomain(host);
         }
 
         /* The DNS response is final, no need to check other servers */
@@ -621,16 +714,23 @@ nsapi_error_t nsapi_dns_call_in(call_in_callback_cb_t cb, int delay, mbed::Callb
     return NSAPI_ERROR_OK;
 }
 
+#if MBED_CONF_NSAPI_DNS_CACHE_PREFETCH
+static void nsapi_dns_query_async_prefetch_cb(nsapi_error_t result, SocketAddress *address)
+{
+    // Cache is updated by the query itself
+}
+#endif
+
 nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const char *host,
                                                       NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
                                                       call_in_callback_cb_t call_in_cb, const char *interface_name, nsapi_version_t version)
 {
-    dns_mutex->lock();
-
     if (!stack) {
         return NSAPI_ERROR_PARAMETER;
     }
 
+    dns_mutex->lock();
+
     // check for valid host name
     int host_len = host ? strlen(host) : 0;
     if (host_len > DNS_HOST_NAME_MAX_LEN || host_len == 0) {
@@ -639,13 +739,38 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     }
 
     nsapi_addr address;
-    if (nsapi_dns_cache_find(host, version, &address) == NSAPI_ERROR_OK) {
-        SocketAddress addr(address);
+    bool prefetch = false;
+    nsapi_error_t cached = nsapi_dns_cache_find(host, version, &address, &prefetch);
+    if (cached == NSAPI_ERROR_OK || cached == NSAPI_ERROR_DNS_FAILURE) {
+#if MBED_CONF_NSAPI_DNS_CACHE_PREFETCH
+        // Entry is about to expire, refreshes it in background so that next lookups still hit the cache
+        if (prefetch) {
+            nsapi_dns_query_async_queue(stack, host, mbed::callback(nsapi_dns_query_async_prefetch_cb), 0,
+                                        call_in_cb, interface_name, version);
+        }
+#endif
         dns_mutex->unlock();
-        callback(NSAPI_ERROR_OK, &addr);
+        if (cached == NSAPI_ERROR_OK) {
+            SocketAddress addr(address);
+            callback(NSAPI_ERROR_OK, &addr);
+        } else {
+            callback(NSAPI_ERROR_DNS_FAILURE, NULL);
+        }
         return NSAPI_ERROR_OK;
     }
 
+    nsapi_value_or_error_t ret = nsapi_dns_query_async_queue(stack, host, callback, addr_count, call_in_cb, interface_name, version);
+
+    dns_mutex->unlock();
+
+    return ret;
+}
+
+// Creates and queues a new query, called with dns_mutex locked
+static nsapi_value_or_error_t nsapi_dns_query_async_queue(NetworkStack *stack, const char *host,
+                                                          NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
+                                                          call_in_callback_cb_t call_in_cb, const char *interface_name, nsapi_version_t version)
+{
     int index = -1;
 
     for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
@@ -656,21 +781,18 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     }
 
     if (index < 0) {
-        dns_mutex->unlock();
         return NSAPI_ERROR_NO_MEMORY;
     }
 
     DNS_QUERY *query = new (std::nothrow) DNS_QUERY;
 
     if (!query) {
-        dns_mutex->unlock();
         return NSAPI_ERROR_NO_MEMORY;
     }
 
-    query->host = new (std::nothrow) char[host_len + 1];
+    query->host = new (std::nothrow) char[strlen(host) + 1];
     if (!query->host) {
         delete query;
-        dns_mutex->unlock();
         return NSAPI_ERROR_NO_MEMORY;
     }
     strcpy(query->host, host);
@@ -683,7 +805,10 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     query->socket = NULL;
     query->socket_cb_data = NULL;
     query->addrs = NULL;
+    query->nxdomain = false;
     query->dns_server = 0;
+    query->dns_server_next = 0;
+    query->dns_servers_pending = 0;
     query->retries = MBED_CONF_NSAPI_DNS_RETRIES + 1;
     query->total_attempts =  MBED_CONF_NSAPI_DNS_TOTAL_ATTEMPTS;
     query->send_success = 0;
@@ -719,7 +844,6 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
         if (nsapi_dns_call_in(query->call_in_cb, DNS_TIMER_TIMEOUT, mbed::callback(nsapi_dns_query_async_timeout)) != NSAPI_ERROR_OK) {
             delete query->host;
             delete query;
-            dns_mutex->unlock();
             return NSAPI_ERROR_NO_MEMORY;
         }
         dns_timer_running = true;
@@ -728,11 +852,57 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     // Initiates query
     nsapi_dns_query_async_initiate_next();
 
-    dns_mutex->unlock();
-
     return query->unique_id;
 }
 
+static bool nsapi_dns_server_addr(NetworkStack *stack, uint8_t index, SocketAddress *dns_addr, const char *interface_name)
+{
+    if (index < DNS_STACK_SERVERS_NUM) {
+        return stack->get_dns_server(index, dns_addr, interface_name) >= 0;
+    }
+
+    dns_addr->set_addr(dns_servers[index - DNS_STACK_SERVERS_NUM]);
+    return true;
+}
+
+static bool nsapi_dns_server_demoted(uint8_t index)
+{
+    if (dns_server_penalty[index] >= DNS_SERVER_DEMOTED) {
+        // Decays on every skip, so the server is tried again later
+        dns_server_penalty[index]--;
+        return true;
+    }
+    return false;
+}
+
+static void nsapi_dns_server_timeout(DNS_QUERY *query)
+{
+    for (int i = 0; i < DNS_STACK_SERVERS_NUM + DNS_SERVERS_SIZE; i++) {
+        if (query->dns_servers_pending & (1 << i)) {
+            // Skipped on next queries, for longer every time the server fails to respond
+            uint8_t penalty = dns_server_penalty[i] * 2 + DNS_SERVER_DEMOTED;
+            dns_server_penalty[i] = penalty < DNS_SERVER_PENALTY_MAX ? penalty : DNS_SERVER_PENALTY_MAX;
+        }
+    }
+    query->dns_servers_pending = 0;
+}
+
+// Returns true if other servers queried on this round have not yet replied
+static bool nsapi_dns_server_reply(DNS_QUERY *query, const SocketAddress &source)
+{
+    for (int i = 0; i < DNS_STACK_SERVERS_NUM + DNS_SERVERS_SIZE; i++) {
+        if (query->dns_servers_pending & (1 << i)) {
+            SocketAddress dns_addr;
+            if (nsapi_dns_server_addr(query->stack, i, &dns_addr, query->interface_name) && dns_addr == source) {
+                dns_server_penalty[i] = 0;
+                query->dns_servers_pending &= ~(1 << i);
+                break;
+            }
+        }
+    }
+    return query->dns_servers_pending != 0;
+}
+
 static void nsapi_dns_query_async_initiate_next(void)
 {
     int id = INT32_MAX;
@@ -791,6 +961,7 @@ static void nsapi_dns_query_async_timeout(void)
                 } else {
                     // Retries
                     dns_query_queue[i]->socket_timeout = 0;
+                    nsapi_dns_server_timeout(dns_query_queue[i]);
                     nsapi_dns_call_in(dns_query_queue[i]->call_in_cb, 0,
                                       mbed::callback(nsapi_dns_query_async_send, reinterpret_cast<void *>(dns_query_queue[i]->unique_id)));
                 }
@@ -844,7 +1015,7 @@ static void nsapi_dns_query_async_create(void *ptr)
 {
     dns_mutex->lock();
 
-    int unique_id = reinterpret_cast<int>(ptr);
+    int unique_id = static_cast<int>(reinterpret_cast<intptr_t>(ptr));
 
     DNS_QUERY *query = NULL;
 
@@ -970,7 +1141,7 @@ static void nsapi_dns_query_async_send(void *ptr)
 {
     dns_mutex->lock();
 
-    int unique_id = reinterpret_cast<int>(ptr);
+    int unique_id = static_cast<int>(reinterpret_cast<intptr_t>(ptr));
 
     DNS_QUERY *query = NULL;
 
@@ -990,7 +1161,7 @@ static void nsapi_dns_query_async_send(void *ptr)
     if (query->retries) {
         query->retries--;
     } else {
-        query->dns_server++;
+        query->dns_server = query->dns_server_next;
         query->retries = MBED_CONF_NSAPI_DNS_RETRIES;
     }
 
@@ -1009,28 +1180,57 @@ static void nsapi_dns_query_async_send(void *ptr)
     // send the question
     int len = dns_append_question(packet, query->dns_message_id, query->host, query->version);
 
-    while (true) {
+    // Sends the same question to up to MBED_CONF_NSAPI_DNS_PARALLEL_SERVERS servers, first valid answer is used
+    uint8_t index = query->dns_server;
+    uint8_t sent = 0;
+    bool skip_demoted = true;
+    query->dns_servers_pending = 0;
+
+    while (sent < MBED_CONF_NSAPI_DNS_PARALLEL_SERVERS) {
         SocketAddress dns_addr;
-        nsapi_size_or_error_t err = nsapi_dns_get_server_addr(query->stack, &(query->dns_server), &(query->total_attempts), &(query->send_success), &dns_addr, query->interface_name);
+        nsapi_size_or_error_t err = nsapi_dns_get_server_addr(query->stack, &index, &(query->total_attempts), &(query->send_success), &dns_addr, query->interface_name);
         if (err != NSAPI_ERROR_OK) {
+            if (sent) {
+                break;
+            } else if (skip_demoted) {
+                // All remaining servers are demoted, tries them anyway
+                index = query->dns_server;
+                skip_demoted = false;
+                continue;
+            }
             nsapi_dns_query_async_resp(query, NSAPI_ERROR_TIMEOUT, NULL);
             free(packet);
             return;
         }
 
+        if (skip_demoted && nsapi_dns_server_demoted(index)) {
+            index++;
+            continue;
+        }
+
         err = query->socket->sendto(dns_addr, packet, len);
 
         if (err < 0) {
             if (err == NSAPI_ERROR_WOULD_BLOCK) {
+                if (sent) {
+                    break;
+                }
                 nsapi_dns_call_in(query->call_in_cb, DNS_TIMER_TIMEOUT, mbed::callback(nsapi_dns_query_async_send, ptr));
                 free(packet);
                 dns_mutex->unlock();
                 return; // Timeout handler will retry the connection if possible
             } else {
-                query->dns_server++;
+                index++;
             }
         } else {
-            break;
+            if (!sent) {
+                // Retries start from first server that was sent to
+                query->dns_server = index;
+            }
+            query->dns_servers_pending |= 1 << index;
+            query->dns_server_next = index + 1;
+            sent++;
+            index++;
         }
     }
 
@@ -1079,7 +1279,8 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
 
         while (true) {
             // recv the response
-            nsapi_size_or_error_t size = socket->recvfrom(NULL, packet, DNS_BUFFER_SIZE);
+            SocketAddress source;
+            nsapi_size_or_error_t size = socket->recvfrom(&source, packet, DNS_BUFFER_SIZE);
 
             if (size < DNS_RESPONSE_MIN_SIZE) {
                 break;
@@ -1097,10 +1298,13 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
                 }
             }
 
-            if (!query || query->state != DNS_INITIATED) {
+            // Ignores replies of other servers once one has answered
+            if (!query || query->state != DNS_INITIATED || query->status != NSAPI_ERROR_TIMEOUT) {
                 continue;
             }
 
+            bool servers_pending = nsapi_dns_server_reply(query, source);
+
             int requested_count = 1;
             if (query->addr_count > 1) {
                 requested_count = query->addr_count;
@@ -1108,10 +1312,10 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
 
             query->addrs = new (std::nothrow) nsapi_addr_t[requested_count];
 
-            int resp = dns_scan_response(packet, id, &(query->ttl), query->addrs, requested_count);
+            int resp = dns_scan_response(packet, id, &(query->ttl), &(query->nxdomain), query->addrs, requested_count);
 
-            // Ignore invalid responses
-            if (resp < 0) {
+            // Ignore invalid responses, and failures while other servers may still answer
+            if (resp < 0 || (MBED_CONF_NSAPI_DNS_PARALLEL_SERVERS > 1 && resp == 0 && !query->nxdomain && servers_pending)) {
                 delete[] query->addrs;
                 query->addrs = 0;
             } else {
@@ -1132,7 +1336,7 @@ static void nsapi_dns_query_async_response(void *ptr)
 {
     dns_mutex->lock();
 
-    int unique_id = reinterpret_cast<int>(ptr);
+    int unique_id = static_cast<int>(reinterpret_cast<intptr_t>(ptr));
 
     DNS_QUERY *query = NULL;
 
@@ -1161,6 +1365,8 @@ static void nsapi_dns_query_async_response(void *ptr)
             if (query->addr_count > 0) {
                 status = query->count;
             }
+        } else if (query->nxdomain) {
+            nsapi_dns_cache_add_nxdomain(query->host);
         }
 
         nsapi_dns_query_async_resp(query, status, addresses);
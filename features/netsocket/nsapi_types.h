@@ -266,6 +266,9 @@ typedef enum nsapi_socket_option {
     NSAPI_ADD_MEMBERSHIP,    /*!< Add membership to multicast address */
     NSAPI_DROP_MEMBERSHIP,   /*!< Drop membership to multicast address */
     NSAPI_BIND_TO_DEVICE,        /*!< Bind socket network interface name*/
+    NSAPI_SEND_NOCOPY,       /*!< Send data by reference, buffers must not change until no longer pending */
+    NSAPI_SEND_PENDING,      /*!< Gets number of sent bytes not yet acknowledged by the peer */
+    NSAPI_TCP_INFO,          /*!< Gets TCP connection statistics as nsapi_tcp_info_t */
 } nsapi_socket_option_t;
 
 /** Supported IP protocol versions of IP stack
@@ -324,6 +327,25 @@ typedef struct nsapi_ip_mreq {
     nsapi_addr_t imr_interface; /* local IP address of interface */
 } nsapi_ip_mreq_t;
 
+/** nsapi_tcp_info structure
+ *
+ *  Snapshot of a TCP connection, read with the NSAPI_TCP_INFO socket option.
+ */
+typedef struct nsapi_tcp_info {
+    uint32_t rtt_ms;        /* Smoothed round trip time estimate in milliseconds, 0 until measured */
+    uint32_t retransmits;   /* Consecutive retransmissions of the oldest unacknowledged data */
+    uint32_t send_pending;  /* Bytes sent but not yet acknowledged by the peer */
+} nsapi_tcp_info_t;
+
+/** nsapi_iovec structure
+ *
+ *  Describes one buffer of a scatter-gather send or receive.
+ */
+typedef struct nsapi_iovec {
+    void *iov_base;       /* start of the buffer */
+    nsapi_size_t iov_len; /* size of the buffer in bytes */
+} nsapi_iovec_t;
+
 /** nsapi_stack_api structure
  *
  *  Common api structure for network stack operations. A network stack
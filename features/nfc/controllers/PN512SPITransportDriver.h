@@ -27,6 +27,12 @@
 #include "drivers/DigitalOut.h"
 #include "drivers/InterruptIn.h"
 
+// Size of the PN512 FIFO, the largest chunk the stack reads or writes at once
+#define PN512_SPI_BURST_SIZE 64
+
+// Transfers shorter than this (register accesses) stay on the blocking path
+#define PN512_SPI_BURST_THRESHOLD 8
+
 namespace mbed {
 namespace nfc {
 
@@ -45,6 +51,16 @@ private:
     static void s_transport_write(uint8_t address, const uint8_t *outBuf, size_t outLen, void *pUser);
     static void s_transport_read(uint8_t address, uint8_t *inBuf, size_t inLen, void *pUser);
 
+#if DEVICE_SPI_ASYNCH
+    // FIFO bursts go out as one asynchronous (DMA where available) transfer, address byte included
+    void burst(size_t len);
+    void burst_done(int event);
+
+    uint8_t _tx_buf[PN512_SPI_BURST_SIZE + 1];
+    uint8_t _rx_buf[PN512_SPI_BURST_SIZE + 1];
+    volatile bool _burst_busy;
+#endif
+
     nfc_transport_t _nfc_transport;
     mbed::SPI _spi;
     mbed::DigitalOut _ssel;
@@ -23,6 +23,7 @@
 #include "NFCDefinitions.h"
 #include "NFCTarget.h"
 #include "NFCEEPROMDriver.h"
+#include "nfc/ndef/MessageStreamParser.h"
 
 namespace mbed {
 namespace nfc {
@@ -98,6 +99,20 @@ public:
      */
     void set_delegate(Delegate *delegate);
 
+    /**
+     * Set a parser that receives NDEF messages read from the EEPROM as they
+     * arrive.
+     *
+     * When a stream parser is set, the NDEF buffer passed at construction is
+     * only used as a window for driver reads: the message read is fed to the
+     * parser one window at a time and can be bigger than the buffer. The
+     * message isn't passed to NFCNDEFCapable::Delegate::parse_ndef_message.
+     *
+     * @param[in] parser the parser to feed, or NULL to parse whole messages
+     * from the NDEF buffer
+     */
+    void set_stream_parser(ndef::MessageStreamParser *parser);
+
     // Implementation of NFCTarget
     virtual void write_ndef_message();
     virtual void read_ndef_message();
@@ -151,6 +166,7 @@ private:
     size_t _ndef_buffer_read_sz;
     uint32_t _eeprom_address;
     nfc_err_t _operation_result;
+    ndef::MessageStreamParser *_stream_parser;
 };
 /** @}*/
 } // namespace nfc
@@ -0,0 +1,119 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NFC_NDEF_MESSAGESTREAMBUILDER_H_
+#define NFC_NDEF_MESSAGESTREAMBUILDER_H_
+
+#include <stdint.h>
+
+#include "platform/Span.h"
+
+#include "nfc/ndef/Record.h"
+
+namespace mbed {
+namespace nfc {
+namespace ndef {
+
+/** @addtogroup nfc
+ * @{
+ */
+
+/**
+ * Serialize a NDEF Message piece by piece.
+ *
+ * Unlike MessageBuilder, the message isn't built in a buffer sized for the
+ * whole message: the builder emits the header of each record in a small
+ * buffer, and the payload is then written by the application in as many
+ * pieces as it wants, straight to its destination.
+ */
+class MessageStreamBuilder {
+public:
+    /**
+     * Maximum size of the record header produced by begin_record: header,
+     * lengths, type and id.
+     */
+    static const size_t max_record_header_size = 1 + 1 + 4 + 1 + 255 + 255;
+
+    /**
+     * Construct a message stream builder.
+     */
+    MessageStreamBuilder();
+
+    /**
+     * Start a new record and serialize its header.
+     *
+     * @param record The record to start. Its payload is ignored.
+     * @param payload_size The size of the payload that will follow.
+     * @param header_buffer The buffer receiving the record header.
+     *
+     * @return The number of bytes written in header_buffer or 0 if the record
+     * can't be started: the message is already complete, the payload of the
+     * previous record hasn't been fully written, the record is invalid or
+     * header_buffer is too small.
+     */
+    size_t begin_record(
+        const Record &record,
+        uint32_t payload_size,
+        const Span<uint8_t> &header_buffer
+    );
+
+    /**
+     * Account for a piece of the payload of the current record written by the
+     * application.
+     *
+     * @param size Size of the piece of payload written.
+     *
+     * @return true if the piece fits in the payload announced and false
+     * otherwise.
+     */
+    bool append_payload(size_t size);
+
+    /**
+     * Compute the size of the header of a record.
+     *
+     * @param record The record used to compute the size.
+     * @param payload_size The size of the payload of the record.
+     *
+     * @return The size of the record without its payload.
+     */
+    static size_t compute_record_header_size(const Record &record, uint32_t payload_size);
+
+    /**
+     * Reset the builder state.
+     */
+    void reset();
+
+    /**
+     * Return true if the last record and its payload have been written.
+     *
+     * @return true if the message is complete or false.
+     */
+    bool is_message_complete() const;
+
+private:
+    static bool is_valid_record(const Record &record, uint32_t payload_size);
+
+    uint32_t _payload_remaining;
+    bool _message_started;
+    bool _message_ended;
+    bool _last_record;
+};
+/** @}*/
+} // namespace ndef
+} // namespace nfc
+} // namespace mbed
+
+#endif /* NFC_NDEF_MESSAGESTREAMBUILDER_H_ */
@@ -0,0 +1,168 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NFC_NDEF_MESSAGESTREAMPARSER_H_
+#define NFC_NDEF_MESSAGESTREAMPARSER_H_
+
+#include <stdint.h>
+#include "platform/Span.h"
+
+#include "nfc/ndef/Record.h"
+#include "nfc/ndef/MessageParser.h"
+
+namespace mbed {
+namespace nfc {
+namespace ndef {
+
+/** @addtogroup nfc
+ * @{
+ */
+
+/**
+ * Event driven NDEF Message parser fed with chunks of the message.
+ *
+ * Unlike MessageParser, the message doesn't have to be held in a contiguous
+ * buffer: data is pushed as it arrives and record payloads are reported in
+ * pieces. Only the type and id of the record being parsed are kept, so the
+ * RAM used doesn't depend on the size of the message.
+ */
+class MessageStreamParser {
+public:
+    /**
+     * Report parsing event to the application.
+     */
+    struct Delegate {
+        /**
+         * Invoked when parsing as started.
+         */
+        virtual void on_parsing_started() { }
+
+        /**
+         * Invoked when the header, type and id of a record have been parsed.
+         *
+         * @param record The record parsed, its payload is empty.
+         * @param payload_size Size of the payload that will follow.
+         */
+        virtual void on_record_started(const Record &record, uint32_t payload_size) { }
+
+        /**
+         * Invoked when a piece of the payload of the current record has been
+         * received.
+         *
+         * @param payload_chunk The piece of payload. It is only valid for the
+         * duration of the call.
+         */
+        virtual void on_record_payload(const Span<const uint8_t> &payload_chunk) { }
+
+        /**
+         * Invoked when the whole payload of the current record has been
+         * received.
+         */
+        virtual void on_record_terminated() { }
+
+        /**
+         * Invoked when parsing is over.
+         */
+        virtual void on_parsing_terminated() { }
+
+        /**
+         * Invoked when an error is present in the message.
+         * @param error The error present in the message.
+         */
+        virtual void on_parsing_error(MessageParser::error_t error) { }
+
+    protected:
+        /**
+         * Protected non virtual destructor.
+         * Delegate is not meant to be destroyed in a polymorphic manner.
+         */
+        ~Delegate() { }
+    };
+
+    /**
+     * Construct a message stream parser.
+     */
+    MessageStreamParser();
+
+    /**
+     * Set the handler that processes parsing events.
+     * @param delegate The parsing event handler.
+     */
+    void set_delegate(Delegate *delegate);
+
+    /**
+     * Start parsing a new message.
+     */
+    void begin();
+
+    /**
+     * Parse the next chunk of the message.
+     *
+     * Records and errors are reported to the delegate as soon as enough data
+     * is available. Data fed after an error or after the last record is
+     * ignored.
+     *
+     * @param chunk The next bytes of the NDEF message.
+     */
+    void feed(const Span<const uint8_t> &chunk);
+
+    /**
+     * Terminate parsing of the message.
+     *
+     * An error is reported if the message is incomplete.
+     */
+    void end();
+
+private:
+    enum state_t {
+        STATE_HEADER,
+        STATE_TYPE_LENGTH,
+        STATE_PAYLOAD_LENGTH,
+        STATE_ID_LENGTH,
+        STATE_TYPE,
+        STATE_ID,
+        STATE_PAYLOAD,
+        STATE_DONE,
+        STATE_ERROR
+    };
+
+    // parser
+    size_t parse_field(const uint8_t *data, size_t size);
+    bool validate_record();
+    void next_field();
+    void terminate_record();
+
+    // reporting
+    void report_parsing_error(MessageParser::error_t error);
+
+    Delegate *_delegate;
+    state_t _state;
+    uint8_t _header;
+    bool _first_record_parsed;
+    uint8_t _type_length;
+    uint8_t _id_length;
+    uint32_t _payload_length;
+    uint32_t _position;
+    uint8_t _type[255];
+    uint8_t _id[255];
+};
+/** @}*/
+} // namespace ndef
+} // namespace nfc
+} // namespace mbed
+
+
+#endif /* NFC_NDEF_MESSAGESTREAMPARSER_H_ */
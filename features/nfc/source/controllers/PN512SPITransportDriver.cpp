@@ -31,6 +31,9 @@ PN512SPITransportDriver::PN512SPITransportDriver(PinName mosi, PinName miso, Pin
     _ssel(ssel, 1),
     _irq(irq, PullNone),
     _rst(rst, 1)
+#if DEVICE_SPI_ASYNCH
+    , _burst_busy(false)
+#endif
 {
 
     // Use SPI mode 0
@@ -39,6 +42,10 @@ PN512SPITransportDriver::PN512SPITransportDriver(PinName mosi, PinName miso, Pin
     // The PN512 supports SPI clock frequencies up to 10MHz, so use this if we can
     _spi.frequency(10000000UL);
 
+#if DEVICE_SPI_ASYNCH
+    _spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
+
     // Initialize NFC transport
     nfc_transport_init(&_nfc_transport, &PN512SPITransportDriver::s_transport_write, &PN512SPITransportDriver::s_transport_read, this);
 }
@@ -72,6 +79,21 @@ void PN512SPITransportDriver::transport_write(uint8_t address, const uint8_t *ou
 
     // First byte is (address << 1) | 0x00 for a write
     address = (address << 1) | 0x00;
+
+#if DEVICE_SPI_ASYNCH
+    if (outLen >= PN512_SPI_BURST_THRESHOLD) {
+        while (outLen > 0) {
+            size_t chunk = outLen > PN512_SPI_BURST_SIZE ? PN512_SPI_BURST_SIZE : outLen;
+            _tx_buf[0] = address;
+            memcpy(&_tx_buf[1], outBuf, chunk);
+            burst(chunk + 1);
+            outBuf += chunk;
+            outLen -= chunk;
+        }
+        return;
+    }
+#endif
+
     _ssel = 0;
     _spi.write(address); // First write address byte
     _spi.write((const char *) outBuf, outLen, (char *) NULL, 0); // Ignore read bytes
@@ -88,6 +110,22 @@ void PN512SPITransportDriver::transport_read(uint8_t address, uint8_t *inBuf, si
     // This should be repeated accross the transfer, except for the last byte which should be 0
     address = (address << 1) | 0x80;
 
+#if DEVICE_SPI_ASYNCH
+    if (inLen >= PN512_SPI_BURST_THRESHOLD) {
+        while (inLen > 0) {
+            size_t chunk = inLen > PN512_SPI_BURST_SIZE ? PN512_SPI_BURST_SIZE : inLen;
+            memset(_tx_buf, address, chunk);
+            _tx_buf[chunk] = 0;
+            burst(chunk + 1);
+            // First byte was clocked in while the address went out
+            memcpy(inBuf, &_rx_buf[1], chunk);
+            inBuf += chunk;
+            inLen -= chunk;
+        }
+        return;
+    }
+#endif
+
     // Set this byte across inBuf so that it's repeated accross the transfer
     // Bit cheeky, but will work
     memset(inBuf, address, inLen - 1);
@@ -101,6 +139,31 @@ void PN512SPITransportDriver::transport_read(uint8_t address, uint8_t *inBuf, si
     _ssel = 1;
 }
 
+#if DEVICE_SPI_ASYNCH
+void PN512SPITransportDriver::burst(size_t len)
+{
+    _ssel = 0;
+    _burst_busy = true;
+    if (0 != _spi.transfer(_tx_buf, (int)len, _rx_buf, (int)len,
+                           mbed::callback(this, &PN512SPITransportDriver::burst_done), SPI_EVENT_ALL)) {
+        // SPI peripheral busy, fall back to a blocking transfer
+        _spi.write((const char *) _tx_buf, len, (char *) _rx_buf, len);
+        _burst_busy = false;
+    }
+
+    // A full FIFO at 10MHz takes ~50us, shorter than yielding to another thread would be worth
+    while (_burst_busy) {
+    }
+    _ssel = 1;
+}
+
+void PN512SPITransportDriver::burst_done(int event)
+{
+    (void) event;
+    _burst_busy = false;
+}
+#endif
+
 // Callbacks from munfc
 void PN512SPITransportDriver::s_transport_write(uint8_t address, const uint8_t *outBuf, size_t outLen, void *pUser)
 {
@@ -21,7 +21,7 @@ using namespace mbed;
 using namespace mbed::nfc;
 
 NFCEEPROM::NFCEEPROM(NFCEEPROMDriver *driver, events::EventQueue *queue, const Span<uint8_t> &ndef_buffer) : NFCTarget(ndef_buffer),
-    _delegate(NULL), _driver(driver), _event_queue(queue), _initialized(false), _current_op(nfc_eeprom_idle), _ndef_buffer_read_sz(0), _eeprom_address(0), _operation_result(NFC_ERR_UNKNOWN)
+    _delegate(NULL), _driver(driver), _event_queue(queue), _initialized(false), _current_op(nfc_eeprom_idle), _ndef_buffer_read_sz(0), _eeprom_address(0), _operation_result(NFC_ERR_UNKNOWN), _stream_parser(NULL)
 {
     _driver->set_delegate(this);
     _driver->set_event_queue(queue);
@@ -42,6 +42,11 @@ void NFCEEPROM::set_delegate(NFCEEPROM::Delegate *delegate)
     _delegate = delegate;
 }
 
+void NFCEEPROM::set_stream_parser(ndef::MessageStreamParser *parser)
+{
+    _stream_parser = parser;
+}
+
 void NFCEEPROM::write_ndef_message()
 {
     MBED_ASSERT(_initialized == true);
@@ -187,7 +192,11 @@ void NFCEEPROM::on_session_ended(bool success)
             _current_op = nfc_eeprom_idle;
 
             // Try to parse the NDEF message
-            ndef_msg_decode(ndef_message());
+            if (_stream_parser != NULL) {
+                _stream_parser->end();
+            } else {
+                ndef_msg_decode(ndef_message());
+            }
 
             if (_delegate != NULL) {
                 _delegate->on_ndef_message_read(_operation_result);
@@ -224,7 +233,13 @@ void NFCEEPROM::on_bytes_read(size_t count)
             // Discard bytes that were actually read and update address
             _eeprom_address += count;
             ac_buffer_builder_t *buffer_builder = ndef_msg_buffer_builder(ndef_message());
-            ac_buffer_builder_write_n_skip(buffer_builder, count);
+            if (_stream_parser != NULL) {
+                // Hand the window over to the parser, then reuse it for the next read
+                _stream_parser->feed(make_const_Span(ac_buffer_builder_write_position(buffer_builder), count));
+                ac_buffer_builder_reset(buffer_builder);
+            } else {
+                ac_buffer_builder_write_n_skip(buffer_builder, count);
+            }
 
             // Continue reading
             _event_queue->call(this, &NFCEEPROM::continue_read);
@@ -314,7 +329,9 @@ void NFCEEPROM::on_size_read(bool success, size_t size)
             ac_buffer_builder_reset(buffer_builder);
 
             // Check that we have a big enough buffer to read the message
-            if (size > ac_buffer_builder_writable(buffer_builder)) {
+            if (_stream_parser != NULL) {
+                _stream_parser->begin();
+            } else if (size > ac_buffer_builder_writable(buffer_builder)) {
                 // Not enough space, close session
                 _current_op = nfc_eeprom_read_end_session;
                 _operation_result = NFC_ERR_BUFFER_TOO_SMALL;
@@ -391,7 +408,12 @@ void NFCEEPROM::continue_read()
     if (_eeprom_address < _ndef_buffer_read_sz) {
         // Continue reading
         ac_buffer_builder_t *buffer_builder = ndef_msg_buffer_builder(ndef_message());
-        _driver->read_bytes(_eeprom_address, ac_buffer_builder_write_position(buffer_builder), _ndef_buffer_read_sz - _eeprom_address);
+        size_t len = _ndef_buffer_read_sz - _eeprom_address;
+        if (len > ac_buffer_builder_writable(buffer_builder)) {
+            // Streaming, the rest of the message is read in later windows
+            len = ac_buffer_builder_writable(buffer_builder);
+        }
+        _driver->read_bytes(_eeprom_address, ac_buffer_builder_write_position(buffer_builder), len);
     } else {
         // Done, close session
         _current_op = nfc_eeprom_read_end_session;
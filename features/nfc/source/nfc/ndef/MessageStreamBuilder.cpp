@@ -0,0 +1,172 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "nfc/ndef/MessageStreamBuilder.h"
+
+namespace mbed {
+namespace nfc {
+namespace ndef {
+
+MessageStreamBuilder::MessageStreamBuilder() :
+    _payload_remaining(0),
+    _message_started(false),
+    _message_ended(false),
+    _last_record(false)
+{ }
+
+size_t MessageStreamBuilder::begin_record(
+    const Record &record,
+    uint32_t payload_size,
+    const Span<uint8_t> &header_buffer
+)
+{
+    if (_message_ended || _payload_remaining) {
+        return 0;
+    }
+
+    if (!is_valid_record(record, payload_size)) {
+        return 0;
+    }
+
+    size_t header_size = compute_record_header_size(record, payload_size);
+    if (header_size > (size_t) header_buffer.size()) {
+        return 0;
+    }
+
+    uint8_t *out = header_buffer.data();
+    bool short_record = payload_size <= 255;
+
+    uint8_t header = record.type.tnf;
+    if (!_message_started) {
+        header |= Header::message_begin_bit;
+        _message_started = true;
+    }
+    if (record.last_record) {
+        header |= Header::message_end_bit;
+    }
+    if (short_record) {
+        header |= Header::short_record_bit;
+    }
+    if (!record.id.empty()) {
+        header |= Header::id_length_bit;
+    }
+    *out++ = header;
+
+    *out++ = record.type.value.size();
+
+    if (short_record) {
+        *out++ = payload_size;
+    } else {
+        *out++ = (payload_size >> 24) & 0xFF;
+        *out++ = (payload_size >> 16) & 0xFF;
+        *out++ = (payload_size >> 8) & 0xFF;
+        *out++ = payload_size & 0xFF;
+    }
+
+    if (!record.id.empty()) {
+        *out++ = record.id.size();
+    }
+
+    if (!record.type.value.empty()) {
+        memcpy(out, record.type.value.data(), record.type.value.size());
+        out += record.type.value.size();
+    }
+
+    if (!record.id.empty()) {
+        memcpy(out, record.id.data(), record.id.size());
+        out += record.id.size();
+    }
+
+    _payload_remaining = payload_size;
+    _last_record = record.last_record;
+    _message_ended = _last_record && !_payload_remaining;
+
+    return header_size;
+}
+
+bool MessageStreamBuilder::append_payload(size_t size)
+{
+    if (size > _payload_remaining) {
+        return false;
+    }
+
+    _payload_remaining -= size;
+    if (_last_record && !_payload_remaining) {
+        _message_ended = true;
+    }
+    return true;
+}
+
+size_t MessageStreamBuilder::compute_record_header_size(const Record &record, uint32_t payload_size)
+{
+    size_t header_size = 1; /* header */
+    header_size += 1; /* type length */
+    header_size += (payload_size <= 255) ? 1 : 4;
+
+    if (!record.id.empty()) {
+        header_size += 1;
+    }
+
+    header_size += record.type.value.size();
+    header_size += record.id.size();
+
+    return header_size;
+}
+
+void MessageStreamBuilder::reset()
+{
+    _payload_remaining = 0;
+    _message_started = false;
+    _message_ended = false;
+    _last_record = false;
+}
+
+bool MessageStreamBuilder::is_message_complete() const
+{
+    return _message_ended;
+}
+
+bool MessageStreamBuilder::is_valid_record(const Record &record, uint32_t payload_size)
+{
+    // chunked records are not supported by the parsers either
+    if (record.chunk) {
+        return false;
+    }
+
+    if (record.type.value.size() > 255 || record.id.size() > 255) {
+        return false;
+    }
+
+    switch (record.type.tnf) {
+        case RecordType::empty:
+            return record.type.value.empty() && record.id.empty() && !payload_size;
+        case RecordType::well_known_type:
+        case RecordType::media_type:
+        case RecordType::absolute_uri:
+        case RecordType::external_type:
+            return !record.type.value.empty();
+        case RecordType::unknown:
+            return record.type.value.empty();
+        default:
+            return false;
+    }
+}
+
+} // namespace ndef
+} // namespace nfc
+} // namespace mbed
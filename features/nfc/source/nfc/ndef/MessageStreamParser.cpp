@@ -0,0 +1,282 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "nfc/ndef/MessageStreamParser.h"
+
+namespace mbed {
+namespace nfc {
+namespace ndef {
+
+MessageStreamParser::MessageStreamParser() :
+    _delegate(NULL),
+    _state(STATE_DONE),
+    _header(0),
+    _first_record_parsed(false),
+    _type_length(0),
+    _id_length(0),
+    _payload_length(0),
+    _position(0)
+{ }
+
+void MessageStreamParser::set_delegate(Delegate *delegate)
+{
+    _delegate = delegate;
+}
+
+void MessageStreamParser::begin()
+{
+    _state = STATE_HEADER;
+    _first_record_parsed = false;
+    _position = 0;
+    if (_delegate) {
+        _delegate->on_parsing_started();
+    }
+}
+
+void MessageStreamParser::feed(const Span<const uint8_t> &chunk)
+{
+    const uint8_t *data = chunk.data();
+    size_t size = chunk.size();
+
+    while (size && _state != STATE_DONE && _state != STATE_ERROR) {
+        size_t consumed = parse_field(data, size);
+        data += consumed;
+        size -= consumed;
+    }
+}
+
+void MessageStreamParser::end()
+{
+    if (_state != STATE_DONE && _state != STATE_ERROR) {
+        // a record is cut or the last record hasn't been received
+        report_parsing_error(
+            _state == STATE_HEADER ?
+            MessageParser::MISSING_MESSAGE_END :
+            MessageParser::INSUFICIENT_DATA
+        );
+    }
+
+    if (_delegate) {
+        _delegate->on_parsing_terminated();
+    }
+}
+
+size_t MessageStreamParser::parse_field(const uint8_t *data, size_t size)
+{
+    switch (_state) {
+        case STATE_HEADER: {
+            _header = data[0];
+
+            // NOTE: report an error until the chunk parsing design is sorted out
+            if (_header & Header::chunk_flag_bit) {
+                report_parsing_error(MessageParser::CHUNK_RECORD_NOT_SUPPORTED);
+                return 1;
+            }
+
+            // only the first record can, and must, start the message
+            bool message_begin = _header & Header::message_begin_bit;
+            if (message_begin == _first_record_parsed) {
+                report_parsing_error(MessageParser::INVALID_MESSAGE_START);
+                return 1;
+            }
+            _first_record_parsed = true;
+
+            _state = STATE_TYPE_LENGTH;
+            return 1;
+        }
+
+        case STATE_TYPE_LENGTH:
+            _type_length = data[0];
+            _payload_length = 0;
+            _position = 0;
+            _state = STATE_PAYLOAD_LENGTH;
+            return 1;
+
+        case STATE_PAYLOAD_LENGTH:
+            // big endian, 1 or 4 bytes
+            _payload_length = (_payload_length << 8) | data[0];
+            _position++;
+            if ((_header & Header::short_record_bit) || _position == 4) {
+                _position = 0;
+                if (_header & Header::id_length_bit) {
+                    _state = STATE_ID_LENGTH;
+                } else {
+                    _id_length = 0;
+                    next_field();
+                }
+            }
+            return 1;
+
+        case STATE_ID_LENGTH:
+            _id_length = data[0];
+            next_field();
+            return 1;
+
+        case STATE_TYPE: {
+            size_t count = _type_length - _position;
+            if (count > size) {
+                count = size;
+            }
+            memcpy(_type + _position, data, count);
+            _position += count;
+            if (_position == _type_length) {
+                _position = 0;
+                next_field();
+            }
+            return count;
+        }
+
+        case STATE_ID: {
+            size_t count = _id_length - _position;
+            if (count > size) {
+                count = size;
+            }
+            memcpy(_id + _position, data, count);
+            _position += count;
+            if (_position == _id_length) {
+                _position = 0;
+                next_field();
+            }
+            return count;
+        }
+
+        case STATE_PAYLOAD: {
+            size_t count = _payload_length - _position;
+            if (count > size) {
+                count = size;
+            }
+            if (_delegate) {
+                _delegate->on_record_payload(make_const_Span(data, count));
+            }
+            _position += count;
+            if (_position == _payload_length) {
+                terminate_record();
+            }
+            return count;
+        }
+
+        default:
+            return size;
+    }
+}
+
+bool MessageStreamParser::validate_record()
+{
+    // validate the Type Name Format of the header
+    switch (_header & Header::tnf_bits) {
+        case RecordType::empty:
+            if (_type_length || _payload_length || _id_length) {
+                report_parsing_error(MessageParser::INVALID_EMPTY_RECORD);
+                return false;
+            }
+            break;
+        case RecordType::well_known_type:
+        case RecordType::media_type:
+        case RecordType::absolute_uri:
+        case RecordType::external_type:
+            if (!_type_length) {
+                report_parsing_error(MessageParser::MISSING_TYPE_VALUE);
+                return false;
+            }
+            break;
+        case RecordType::unknown:
+            if (_type_length) {
+                report_parsing_error(MessageParser::INVALID_UNKNOWN_TYPE_LENGTH);
+                return false;
+            }
+            break;
+        case RecordType::unchanged:
+            // shouldn't be handled outside of chunk handling
+            report_parsing_error(MessageParser::INVALID_UNCHANGED_TYPE);
+            return false;
+        default:
+            report_parsing_error(MessageParser::INVALID_TYPE_NAME_FORMAT);
+            return false;
+    }
+    return true;
+}
+
+void MessageStreamParser::next_field()
+{
+    // Called once all lengths are known and again after each of the type and
+    // id fields; move to the next field that still has data to receive.
+    switch (_state) {
+        case STATE_PAYLOAD_LENGTH:
+        case STATE_ID_LENGTH:
+            if (!validate_record()) {
+                return;
+            }
+            if (_type_length) {
+                _state = STATE_TYPE;
+                return;
+            }
+        // fall through
+        case STATE_TYPE:
+        case STATE_ID:
+            if (_id_length && _state != STATE_ID) {
+                _state = STATE_ID;
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+
+    Record record;
+    record.last_record = _header & Header::message_end_bit;
+    record.type.tnf = static_cast<RecordType::tnf_t>(_header & Header::tnf_bits);
+    if (_type_length) {
+        record.type.value = make_const_Span(_type, _type_length);
+    }
+    if (_id_length) {
+        record.id = make_const_Span(_id, _id_length);
+    }
+
+    if (_delegate) {
+        _delegate->on_record_started(record, _payload_length);
+    }
+
+    _position = 0;
+    if (_payload_length) {
+        _state = STATE_PAYLOAD;
+    } else {
+        terminate_record();
+    }
+}
+
+void MessageStreamParser::terminate_record()
+{
+    if (_delegate) {
+        _delegate->on_record_terminated();
+    }
+
+    _position = 0;
+    _state = (_header & Header::message_end_bit) ? STATE_DONE : STATE_HEADER;
+}
+
+void MessageStreamParser::report_parsing_error(MessageParser::error_t error)
+{
+    _state = STATE_ERROR;
+    if (_delegate) {
+        _delegate->on_parsing_error(error);
+    }
+}
+
+} // namespace ndef
+} // namespace nfc
+} // namespace mbed
@@ -0,0 +1,143 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#include "AsyncBlockDevice.h"
+#include "HeapBlockDevice.h"
+#include <stdlib.h>
+
+using namespace utest::v1;
+
+#if !MBED_CONF_RTOS_PRESENT
+#error [NOT_SUPPORTED] Async block device test requires RTOS
+#endif
+
+#define TEST_BLOCK_SIZE 128
+#define TEST_BLOCK_DEVICE_SIZE 32*TEST_BLOCK_SIZE
+#define TEST_BLOCK_COUNT 4
+
+static Semaphore done_sem;
+static int done_err;
+static osThreadId_t done_thread;
+
+static void done(int err)
+{
+    done_err = err;
+    done_thread = ThisThread::get_id();
+    done_sem.release();
+}
+
+static int wait_done()
+{
+    TEST_ASSERT_TRUE(done_sem.try_acquire_for(5000));
+    return done_err;
+}
+
+// Default implementation completes before returning
+void test_default_async()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[TEST_BLOCK_DEVICE_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    HeapBlockDevice bd(TEST_BLOCK_DEVICE_SIZE, TEST_BLOCK_SIZE);
+    uint8_t write_block[TEST_BLOCK_SIZE];
+    uint8_t read_block[TEST_BLOCK_SIZE];
+
+    TEST_ASSERT_EQUAL(0, bd.init());
+
+    for (int i = 0; i < TEST_BLOCK_SIZE; i++) {
+        write_block[i] = 0xff & rand();
+    }
+
+    TEST_ASSERT_EQUAL(0, bd.erase_async(0, TEST_BLOCK_SIZE, callback(done)));
+    TEST_ASSERT_EQUAL(0, wait_done());
+    TEST_ASSERT_EQUAL(0, bd.program_async(write_block, 0, TEST_BLOCK_SIZE, callback(done)));
+    TEST_ASSERT_EQUAL(0, wait_done());
+    TEST_ASSERT_EQUAL(0, bd.read_async(read_block, 0, TEST_BLOCK_SIZE, callback(done)));
+    TEST_ASSERT_EQUAL(0, wait_done());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, TEST_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(ThisThread::get_id(), done_thread);
+
+    TEST_ASSERT_EQUAL(0, bd.deinit());
+}
+
+// Operations queued back to back complete in order on the worker thread
+void test_queued_async()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[TEST_BLOCK_DEVICE_SIZE + 2 * TEST_BLOCK_COUNT * TEST_BLOCK_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    HeapBlockDevice heap(TEST_BLOCK_DEVICE_SIZE, TEST_BLOCK_SIZE);
+    AsyncBlockDevice bd(&heap);
+    uint8_t *write_block = new uint8_t[TEST_BLOCK_COUNT * TEST_BLOCK_SIZE];
+    uint8_t *read_block = new uint8_t[TEST_BLOCK_COUNT * TEST_BLOCK_SIZE];
+
+    TEST_ASSERT_EQUAL(0, bd.init());
+
+    for (int i = 0; i < TEST_BLOCK_COUNT * TEST_BLOCK_SIZE; i++) {
+        write_block[i] = 0xff & rand();
+    }
+
+    for (int b = 0; b < TEST_BLOCK_COUNT; b++) {
+        TEST_ASSERT_EQUAL(0, bd.erase_async(b * TEST_BLOCK_SIZE, TEST_BLOCK_SIZE, callback(done)));
+        TEST_ASSERT_EQUAL(0, bd.program_async(&write_block[b * TEST_BLOCK_SIZE], b * TEST_BLOCK_SIZE,
+                                              TEST_BLOCK_SIZE, callback(done)));
+        TEST_ASSERT_EQUAL(0, wait_done());
+        TEST_ASSERT_EQUAL(0, wait_done());
+        TEST_ASSERT_NOT_EQUAL(ThisThread::get_id(), done_thread);
+    }
+
+    TEST_ASSERT_EQUAL(0, bd.read_async(read_block, 0, TEST_BLOCK_COUNT * TEST_BLOCK_SIZE, callback(done)));
+    TEST_ASSERT_EQUAL(0, wait_done());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, TEST_BLOCK_COUNT * TEST_BLOCK_SIZE);
+
+    // Synchronous access still works alongside the worker
+    memset(read_block, 0, TEST_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, bd.read(read_block, 0, TEST_BLOCK_SIZE));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, TEST_BLOCK_SIZE);
+
+    TEST_ASSERT_EQUAL(0, bd.deinit());
+    TEST_ASSERT_NOT_EQUAL(0, bd.erase_async(0, TEST_BLOCK_SIZE, callback(done)));
+
+    delete[] write_block;
+    delete[] read_block;
+}
+
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Testing default async operations", test_default_async),
+    Case("Testing queued async operations", test_queued_async),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,273 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "BlockDevice.h"
+#include <stdlib.h>
+#include <algorithm>
+
+using namespace utest::v1;
+
+/* Throughput and latency of the default BlockDevice.
+ *
+ * The first BENCH_REGION_SIZE bytes of the device, rounded to erase units,
+ * are erased and rewritten. Results are printed and sent with
+ * greentea_send_kv: throughput in bytes per second, latencies in us.
+ */
+
+#ifndef BENCH_REGION_SIZE
+#define BENCH_REGION_SIZE   (64 * 1024)
+#endif
+
+#ifndef BENCH_CHUNK_SIZE
+#define BENCH_CHUNK_SIZE    512
+#endif
+
+#define BENCH_SAMPLES       64
+
+static BlockDevice *bd = BlockDevice::get_default_instance();
+static bd_size_t region_size;
+static bd_size_t chunk_size;
+static uint8_t *buffer;
+static uint32_t samples[BENCH_SAMPLES];
+
+static void report_throughput(const char *key, bd_size_t bytes, uint32_t elapsed_us)
+{
+    uint32_t bps = elapsed_us ? (uint32_t)((bytes * 1000000) / elapsed_us) : 0;
+    utest_printf("%s: %lu bytes/s\r\n", key, (unsigned long) bps);
+    greentea_send_kv(key, (int) bps);
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void report_latency(const char *key, uint32_t *values, int count)
+{
+    qsort(values, count, sizeof(values[0]), compare_u32);
+
+    uint32_t p50 = values[count / 2];
+    uint32_t p99 = values[std::min(count - 1, (count * 99) / 100)];
+    utest_printf("%s: min %lu us, p50 %lu us, p99 %lu us, max %lu us\r\n", key,
+                 (unsigned long) values[0], (unsigned long) p50,
+                 (unsigned long) p99, (unsigned long) values[count - 1]);
+
+    char kv_key[48];
+    snprintf(kv_key, sizeof(kv_key), "%s_p50_us", key);
+    greentea_send_kv(kv_key, (int) p50);
+    snprintf(kv_key, sizeof(kv_key), "%s_p99_us", key);
+    greentea_send_kv(kv_key, (int) p99);
+    snprintf(kv_key, sizeof(kv_key), "%s_max_us", key);
+    greentea_send_kv(kv_key, (int) values[count - 1]);
+}
+
+static void erase_region()
+{
+    TEST_ASSERT_EQUAL(0, bd->erase(0, region_size));
+}
+
+static void fill_buffer(uint32_t seed)
+{
+    srand(seed);
+    for (bd_size_t i = 0; i < chunk_size; i++) {
+        buffer[i] = rand() & 0xff;
+    }
+}
+
+void test_init()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL, "no block device found.");
+    TEST_ASSERT_EQUAL(0, bd->init());
+
+    // Whole erase units, starting at the beginning of the device
+    region_size = 0;
+    while (region_size < BENCH_REGION_SIZE && region_size < bd->size()) {
+        region_size += bd->get_erase_size(region_size);
+    }
+
+    chunk_size = std::max<bd_size_t>(BENCH_CHUNK_SIZE, bd->get_program_size());
+    chunk_size = std::max<bd_size_t>(chunk_size, bd->get_read_size());
+    chunk_size = ((chunk_size + bd->get_program_size() - 1) / bd->get_program_size()) * bd->get_program_size();
+
+    buffer = new (std::nothrow) uint8_t[chunk_size];
+    TEST_SKIP_UNLESS_MESSAGE(buffer != NULL, "Not enough memory for test");
+
+    utest_printf("%s: region %llu bytes, chunk %llu bytes, erase unit %llu bytes\r\n",
+                 bd->get_type(), region_size, chunk_size, bd->get_erase_size());
+}
+
+void test_sequential_erase()
+{
+    TEST_SKIP_UNLESS_MESSAGE(buffer != NULL, "no block device found.");
+
+    Timer timer;
+    int count = 0;
+    bd_size_t total = 0;
+
+    timer.start();
+    for (bd_addr_t addr = 0; addr < region_size;) {
+        bd_size_t unit = bd->get_erase_size(addr);
+        uint32_t start = timer.read_us();
+        TEST_ASSERT_EQUAL(0, bd->erase(addr, unit));
+        if (count < BENCH_SAMPLES) {
+            samples[count++] = timer.read_us() - start;
+        }
+        addr += unit;
+        total += unit;
+    }
+    timer.stop();
+
+    report_throughput("bd_seq_erase_bps", total, timer.read_us());
+    report_latency("bd_erase", samples, count);
+}
+
+void test_sequential_program()
+{
+    TEST_SKIP_UNLESS_MESSAGE(buffer != NULL, "no block device found.");
+
+    erase_region();
+    fill_buffer(1);
+
+    Timer timer;
+    int count = 0;
+
+    timer.start();
+    for (bd_addr_t addr = 0; addr + chunk_size <= region_size; addr += chunk_size) {
+        uint32_t start = timer.read_us();
+        TEST_ASSERT_EQUAL(0, bd->program(buffer, addr, chunk_size));
+        if (count < BENCH_SAMPLES) {
+            samples[count++] = timer.read_us() - start;
+        }
+    }
+    TEST_ASSERT_EQUAL(0, bd->sync());
+    timer.stop();
+
+    report_throughput("bd_seq_program_bps", (region_size / chunk_size) * chunk_size, timer.read_us());
+    report_latency("bd_program", samples, count);
+}
+
+void test_sequential_read()
+{
+    TEST_SKIP_UNLESS_MESSAGE(buffer != NULL, "no block device found.");
+
+    Timer timer;
+    int count = 0;
+
+    timer.start();
+    for (bd_addr_t addr = 0; addr + chunk_size <= region_size; addr += chunk_size) {
+        uint32_t start = timer.read_us();
+        TEST_ASSERT_EQUAL(0, bd->read(buffer, addr, chunk_size));
+        if (count < BENCH_SAMPLES) {
+            samples[count++] = timer.read_us() - start;
+        }
+    }
+    timer.stop();
+
+    report_throughput("bd_seq_read_bps", (region_size / chunk_size) * chunk_size, timer.read_us());
+    report_latency("bd_read", samples, count);
+}
+
+void test_random_program()
+{
+    TEST_SKIP_UNLESS_MESSAGE(buffer != NULL, "no block device found.");
+
+    erase_region();
+    fill_buffer(2);
+
+    // Each chunk is programmed once, in shuffled order
+    int chunks = std::min<bd_size_t>(region_size / chunk_size, BENCH_SAMPLES);
+    uint32_t order[BENCH_SAMPLES];
+    srand(3);
+    for (int i = 0; i < chunks; i++) {
+        order[i] = i;
+    }
+    for (int i = chunks - 1; i > 0; i--) {
+        std::swap(order[i], order[rand() % (i + 1)]);
+    }
+
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < chunks; i++) {
+        uint32_t start = timer.read_us();
+        TEST_ASSERT_EQUAL(0, bd->program(buffer, order[i] * chunk_size, chunk_size));
+        samples[i] = timer.read_us() - start;
+    }
+    TEST_ASSERT_EQUAL(0, bd->sync());
+    timer.stop();
+
+    report_throughput("bd_rand_program_bps", chunks * chunk_size, timer.read_us());
+    report_latency("bd_rand_program", samples, chunks);
+}
+
+void test_random_read()
+{
+    TEST_SKIP_UNLESS_MESSAGE(buffer != NULL, "no block device found.");
+
+    bd_size_t read_size = bd->get_read_size();
+    bd_size_t slots = region_size / read_size;
+
+    Timer timer;
+    srand(4);
+    timer.start();
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        bd_addr_t addr = (rand() % slots) * read_size;
+        uint32_t start = timer.read_us();
+        TEST_ASSERT_EQUAL(0, bd->read(buffer, addr, read_size));
+        samples[i] = timer.read_us() - start;
+    }
+    timer.stop();
+
+    report_throughput("bd_rand_read_bps", BENCH_SAMPLES * read_size, timer.read_us());
+    report_latency("bd_rand_read", samples, BENCH_SAMPLES);
+}
+
+void test_deinit()
+{
+    TEST_SKIP_UNLESS_MESSAGE(buffer != NULL, "no block device found.");
+
+    delete[] buffer;
+    buffer = NULL;
+    TEST_ASSERT_EQUAL(0, bd->deinit());
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(180, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark init", test_init),
+    Case("Benchmark sequential erase", test_sequential_erase),
+    Case("Benchmark sequential program", test_sequential_program),
+    Case("Benchmark sequential read", test_sequential_read),
+    Case("Benchmark random program", test_random_program),
+    Case("Benchmark random read", test_random_read),
+    Case("Benchmark deinit", test_deinit),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
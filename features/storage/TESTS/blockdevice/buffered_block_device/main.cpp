@@ -175,6 +175,76 @@ void functionality_test()
     }
 }
 
+void multi_line_test()
+{
+    const bd_size_t prog_size = 128;
+    uint8_t *read_buf = new (std::nothrow) uint8_t[heap_erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(read_buf, "Not enough memory for test");
+    uint8_t *write_buf = new (std::nothrow) uint8_t[heap_erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(write_buf, "Not enough memory for test");
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[num_blocks * heap_erase_size + 3 * prog_size + heap_erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    HeapBlockDevice heap_bd(num_blocks * heap_erase_size, 1, prog_size, heap_erase_size);
+    BufferedBlockDevice bd(&heap_bd, 2, heap_erase_size);
+
+    TEST_ASSERT_EQUAL(0, bd.init());
+
+    memset(write_buf, 0, heap_erase_size);
+    for (bd_size_t i = 0; i < num_blocks; i++) {
+        TEST_ASSERT_EQUAL(0, heap_bd.program(write_buf, i * heap_erase_size, heap_erase_size));
+    }
+
+    // Alternating partial programs to two units stay cached
+    for (int i = 0; i < 8; i++) {
+        uint8_t val = i + 1;
+        TEST_ASSERT_EQUAL(0, bd.program(&val, i, 1));
+        TEST_ASSERT_EQUAL(0, bd.program(&val, heap_erase_size + i, 1));
+    }
+
+    TEST_ASSERT_EQUAL(0, heap_bd.read(read_buf, 0, prog_size));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, prog_size);
+    TEST_ASSERT_EQUAL(0, heap_bd.read(read_buf, heap_erase_size, prog_size));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, prog_size);
+
+    for (int i = 0; i < 8; i++) {
+        write_buf[i] = i + 1;
+    }
+    TEST_ASSERT_EQUAL(0, bd.read(read_buf, 0, 8));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, 8);
+
+    // A third unit evicts the least recently used one
+    uint8_t val = 0x5A;
+    TEST_ASSERT_EQUAL(0, bd.program(&val, 2 * heap_erase_size, 1));
+    TEST_ASSERT_EQUAL(0, heap_bd.read(read_buf, 0, prog_size));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, prog_size);
+
+    // Sequential small reads, served from the read ahead buffer
+    TEST_ASSERT_EQUAL(0, bd.sync());
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(0, bd.read(read_buf, heap_erase_size + i, 1));
+        TEST_ASSERT_EQUAL(i + 1, read_buf[0]);
+    }
+
+    // Programs invalidate read ahead data
+    val = 0xA5;
+    TEST_ASSERT_EQUAL(0, bd.program(&val, heap_erase_size + 8, 1));
+    TEST_ASSERT_EQUAL(0, bd.read(read_buf, heap_erase_size + 8, 1));
+    TEST_ASSERT_EQUAL(0xA5, read_buf[0]);
+
+    TEST_ASSERT_EQUAL(0, bd.sync());
+    TEST_ASSERT_EQUAL(0, heap_bd.read(read_buf, heap_erase_size, prog_size));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, 8);
+    TEST_ASSERT_EQUAL(0xA5, read_buf[8]);
+
+    bd.deinit();
+
+    delete[] read_buf;
+    delete[] write_buf;
+}
+
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
@@ -184,6 +254,7 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 
 Case cases[] = {
     Case("BufferedBlockDevice functionality test", functionality_test),
+    Case("BufferedBlockDevice multi-line cache test", multi_line_test),
 };
 
 Specification specification(test_setup, cases);
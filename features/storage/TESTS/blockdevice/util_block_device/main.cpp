@@ -212,6 +212,67 @@ end:
     delete[] read_block;
 }
 
+// Simple test which read/writes blocks on block devices striped together
+void test_striping()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[BLOCK_COUNT * BLOCK_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    int err;
+
+    HeapBlockDevice bd1((BLOCK_COUNT / 2)*BLOCK_SIZE, 1, 1, BLOCK_SIZE);
+    HeapBlockDevice bd2((BLOCK_COUNT / 2)*BLOCK_SIZE, 1, 1, BLOCK_SIZE);
+
+    // Test with block devices striped a quarter block at a time
+    BlockDevice *bds[] = {&bd1, &bd2};
+    ChainingBlockDevice stripe(bds, 2, BLOCK_SIZE / 4);
+
+    uint8_t *write_block = new (std::nothrow) uint8_t[2 * BLOCK_SIZE];
+    uint8_t *read_block = new (std::nothrow) uint8_t[2 * BLOCK_SIZE];
+
+    if (!write_block || !read_block) {
+        printf("Not enough memory for test");
+        goto end;
+    }
+
+    err = stripe.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    TEST_ASSERT_EQUAL(2 * BLOCK_SIZE, stripe.get_erase_size());
+    TEST_ASSERT_EQUAL(2 * BLOCK_SIZE, stripe.get_erase_size((BLOCK_COUNT / 2)*BLOCK_SIZE + 1));
+    TEST_ASSERT_EQUAL(BLOCK_COUNT * BLOCK_SIZE, stripe.size());
+
+    // Fill with random sequence
+    srand(1);
+    for (int i = 0; i < 2 * BLOCK_SIZE; i++) {
+        write_block[i] = 0xff & rand();
+    }
+
+    err = stripe.erase(2 * BLOCK_SIZE, 2 * BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Write and read back from an address that is not stripe aligned
+    err = stripe.program(write_block, 2 * BLOCK_SIZE + 1, 2 * BLOCK_SIZE - 1);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = stripe.read(read_block, 2 * BLOCK_SIZE + 1, 2 * BLOCK_SIZE - 1);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, 2 * BLOCK_SIZE - 1);
+
+    // Second stripe is at the start of the erase block on the second block device
+    err = bd2.read(read_block, BLOCK_SIZE, BLOCK_SIZE / 4);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block + BLOCK_SIZE / 4 - 1, read_block, BLOCK_SIZE / 4);
+
+    err = stripe.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+end:
+    delete[] write_block;
+    delete[] read_block;
+}
+
 // Simple test which read/writes blocks on a chain of block devices
 void test_profiling()
 {
@@ -299,6 +360,7 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 Case cases[] = {
     Case("Testing slicing of a block device", test_slicing),
     Case("Testing chaining of block devices", test_chaining),
+    Case("Testing striping of block devices", test_striping),
     Case("Testing profiling of block devices", test_profiling),
 };
 
@@ -0,0 +1,224 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#include "WearLevelingBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "HeapBlockDevice.h"
+#include <stdlib.h>
+
+using namespace utest::v1;
+
+static const bd_size_t read_size = 1;
+static const bd_size_t prog_size = 8;
+static const bd_size_t erase_size = 2048;
+static const bd_size_t num_blocks = 16;
+static const bd_size_t page_size = 256;
+static const uint32_t reserved_blocks = 4;
+static const uint32_t wear_threshold = 8;
+
+static void fill_page(uint8_t *buf, uint32_t page, uint32_t version)
+{
+    srand(page * 1000 + version);
+    for (bd_size_t i = 0; i < page_size; i++) {
+        buf[i] = 0xff & rand();
+    }
+}
+
+// Simple test for all APIs
+void functionality_test()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[num_blocks * erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    HeapBlockDevice heap_bd(num_blocks * erase_size, read_size, prog_size, erase_size);
+    FlashSimBlockDevice sim_bd(&heap_bd);
+    WearLevelingBlockDevice bd(&sim_bd, page_size, reserved_blocks, wear_threshold);
+
+    int err = bd.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    TEST_ASSERT_EQUAL(page_size, bd.get_read_size());
+    TEST_ASSERT_EQUAL(page_size, bd.get_program_size());
+    TEST_ASSERT_EQUAL(page_size, bd.get_erase_size());
+    TEST_ASSERT_EQUAL(-1, bd.get_erase_value());
+    TEST_ASSERT(bd.size() > 0);
+    TEST_ASSERT(bd.size() < num_blocks * erase_size);
+
+    uint32_t num_pages = bd.size() / page_size;
+    uint8_t read_buf[page_size], write_buf[page_size];
+
+    // Pages can be rewritten without erasing them first
+    for (uint32_t version = 0; version < 3; version++) {
+        for (uint32_t page = 0; page < num_pages; page++) {
+            fill_page(write_buf, page, version);
+            err = bd.program(write_buf, page * page_size, page_size);
+            TEST_ASSERT_EQUAL(0, err);
+        }
+    }
+
+    err = bd.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = bd.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Make sure the latest data lives across inits
+    for (uint32_t page = 0; page < num_pages; page++) {
+        fill_page(write_buf, page, 2);
+        err = bd.read(read_buf, page * page_size, page_size);
+        TEST_ASSERT_EQUAL(0, err);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, page_size);
+    }
+
+    err = bd.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+// Hammering a few pages must spread erases over all blocks
+void wear_test()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[num_blocks * erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    HeapBlockDevice heap_bd(num_blocks * erase_size, read_size, prog_size, erase_size);
+    FlashSimBlockDevice sim_bd(&heap_bd);
+    WearLevelingBlockDevice bd(&sim_bd, page_size, reserved_blocks, wear_threshold);
+
+    int err = bd.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    uint32_t num_pages = bd.size() / page_size;
+    uint8_t read_buf[page_size], write_buf[page_size];
+
+    // Cold data filling the device
+    for (uint32_t page = 0; page < num_pages; page++) {
+        fill_page(write_buf, page, 0);
+        err = bd.program(write_buf, page * page_size, page_size);
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    for (uint32_t version = 1; version < 2000; version++) {
+        uint32_t page = version % 2;
+        fill_page(write_buf, page, version);
+        err = bd.program(write_buf, page * page_size, page_size);
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    uint32_t min_erases, max_erases, bad_blocks;
+    err = bd.get_wear_stats(&min_erases, &max_erases, &bad_blocks);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(0, bad_blocks);
+    TEST_ASSERT(min_erases > 0);
+    TEST_ASSERT(max_erases - min_erases <= 2 * wear_threshold);
+
+    for (uint32_t page = 2; page < num_pages; page++) {
+        fill_page(write_buf, page, 0);
+        err = bd.read(read_buf, page * page_size, page_size);
+        TEST_ASSERT_EQUAL(0, err);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, page_size);
+    }
+
+    err = bd.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+
+// Remounting while pages are rewritten and erased must not lose free space,
+// also on a device that leaves old content behind when erased
+void remount_test()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[num_blocks * erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    HeapBlockDevice heap_bd(num_blocks * erase_size, read_size, prog_size, erase_size);
+    WearLevelingBlockDevice bd(&heap_bd, page_size, reserved_blocks, wear_threshold);
+
+    int err = bd.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    uint32_t num_pages = bd.size() / page_size;
+    uint32_t pages_per_erase = bd.get_erase_size() / page_size;
+    uint8_t read_buf[page_size], write_buf[page_size];
+
+    // Version of the data last written to each page, 0 once erased
+    uint16_t *versions = new uint16_t[num_pages];
+    memset(versions, 0, num_pages * sizeof(uint16_t));
+
+    srand(1);
+    for (uint32_t op = 1; op < 2000; op++) {
+        uint32_t page = rand() % num_pages;
+        uint32_t action = rand() % 100;
+
+        if (action < 85) {
+            fill_page(write_buf, page, op);
+            err = bd.program(write_buf, page * page_size, page_size);
+            TEST_ASSERT_EQUAL(0, err);
+            versions[page] = op;
+        } else if (action < 95) {
+            page -= page % pages_per_erase;
+            err = bd.erase(page * page_size, bd.get_erase_size());
+            TEST_ASSERT_EQUAL(0, err);
+            memset(&versions[page], 0, pages_per_erase * sizeof(uint16_t));
+        } else {
+            err = bd.deinit();
+            TEST_ASSERT_EQUAL(0, err);
+            err = bd.init();
+            TEST_ASSERT_EQUAL(0, err);
+        }
+    }
+
+    for (uint32_t page = 0; page < num_pages; page++) {
+        if (!versions[page]) {
+            continue;
+        }
+        fill_page(write_buf, page, versions[page]);
+        err = bd.read(read_buf, page * page_size, page_size);
+        TEST_ASSERT_EQUAL(0, err);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, page_size);
+    }
+
+    delete[] versions;
+    err = bd.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("WearLevelingBlockDevice functionality test", functionality_test),
+    Case("WearLevelingBlockDevice wear test", wear_test),
+    Case("WearLevelingBlockDevice remount test", remount_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,226 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "BlockDevice.h"
+#include "LittleFileSystem.h"
+#include "FATFileSystem.h"
+#include <stdlib.h>
+#include <algorithm>
+
+using namespace utest::v1;
+using namespace mbed;
+
+/* File operation rates of LittleFileSystem and FATFileSystem, both formatted
+ * in turn on the default BlockDevice. Results are printed and sent with
+ * greentea_send_kv, prefixed with the file system name: operations and
+ * bytes per second, latencies in us.
+ */
+
+#ifndef BENCH_FILE_COUNT
+#define BENCH_FILE_COUNT    32
+#endif
+
+#ifndef BENCH_FILE_SIZE
+#define BENCH_FILE_SIZE     (32 * 1024)
+#endif
+
+#define BENCH_CHUNK_SIZE    512
+
+static BlockDevice *bd = BlockDevice::get_default_instance();
+static LittleFileSystem little_fs("lfs");
+static FATFileSystem fat_fs("fat");
+
+static uint8_t buffer[BENCH_CHUNK_SIZE];
+static uint32_t samples[BENCH_FILE_COUNT];
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char *fs_name, const char *key, int value, const char *unit)
+{
+    char kv_key[48];
+    snprintf(kv_key, sizeof(kv_key), "%s_%s", fs_name, key);
+    utest_printf("%s: %d %s\r\n", kv_key, value, unit);
+    greentea_send_kv(kv_key, value);
+}
+
+static void report_latency(const char *fs_name, const char *key, uint32_t *values, int count)
+{
+    qsort(values, count, sizeof(values[0]), compare_u32);
+
+    char kv_key[48];
+    snprintf(kv_key, sizeof(kv_key), "%s_p50_us", key);
+    report(fs_name, kv_key, values[count / 2], "us");
+    snprintf(kv_key, sizeof(kv_key), "%s_max_us", key);
+    report(fs_name, kv_key, values[count - 1], "us");
+}
+
+static int per_second(uint32_t count, uint32_t elapsed_us)
+{
+    return elapsed_us ? (int)(((uint64_t)count * 1000000) / elapsed_us) : 0;
+}
+
+template <typename T, T *FS>
+void test_format()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL, "no block device found.");
+    TEST_ASSERT_EQUAL(0, bd->init());
+
+    Timer timer;
+    timer.start();
+    TEST_ASSERT_EQUAL(0, FS->reformat(bd));
+    timer.stop();
+
+    report(FS->getName(), "format_us", timer.read_us(), "us");
+}
+
+template <typename T, T *FS>
+void test_create()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL, "no block device found.");
+
+    TEST_ASSERT_EQUAL(0, FS->mkdir("bench", 0777));
+
+    Timer timer;
+    char path[32];
+    File file;
+
+    timer.start();
+    for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+        snprintf(path, sizeof(path), "bench/f%03d", i);
+        uint32_t start = timer.read_us();
+        TEST_ASSERT_EQUAL(0, file.open(FS, path, O_WRONLY | O_CREAT));
+        TEST_ASSERT_EQUAL(0, file.close());
+        samples[i] = timer.read_us() - start;
+    }
+    timer.stop();
+
+    report(FS->getName(), "create_per_s", per_second(BENCH_FILE_COUNT, timer.read_us()), "files/s");
+    report_latency(FS->getName(), "create", samples, BENCH_FILE_COUNT);
+}
+
+template <typename T, T *FS>
+void test_append()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL, "no block device found.");
+
+    memset(buffer, 0x5a, sizeof(buffer));
+
+    // Reopen for every chunk, as a logger appending records would
+    Timer timer;
+    File file;
+
+    timer.start();
+    for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+        uint32_t start = timer.read_us();
+        TEST_ASSERT_EQUAL(0, file.open(FS, "bench/log", O_WRONLY | O_CREAT | O_APPEND));
+        TEST_ASSERT_EQUAL(sizeof(buffer), file.write(buffer, sizeof(buffer)));
+        TEST_ASSERT_EQUAL(0, file.close());
+        samples[i] = timer.read_us() - start;
+    }
+    timer.stop();
+
+    report(FS->getName(), "append_per_s", per_second(BENCH_FILE_COUNT, timer.read_us()), "appends/s");
+    report_latency(FS->getName(), "append", samples, BENCH_FILE_COUNT);
+}
+
+template <typename T, T *FS>
+void test_write()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL, "no block device found.");
+
+    memset(buffer, 0xa5, sizeof(buffer));
+
+    Timer timer;
+    File file;
+
+    timer.start();
+    TEST_ASSERT_EQUAL(0, file.open(FS, "bench/big", O_WRONLY | O_CREAT | O_TRUNC));
+    for (size_t written = 0; written < BENCH_FILE_SIZE; written += sizeof(buffer)) {
+        TEST_ASSERT_EQUAL(sizeof(buffer), file.write(buffer, sizeof(buffer)));
+    }
+    TEST_ASSERT_EQUAL(0, file.close());
+    timer.stop();
+
+    report(FS->getName(), "write_bps", per_second(BENCH_FILE_SIZE, timer.read_us()), "bytes/s");
+}
+
+template <typename T, T *FS>
+void test_read()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL, "no block device found.");
+
+    Timer timer;
+    File file;
+    size_t total = 0;
+    ssize_t res;
+
+    timer.start();
+    TEST_ASSERT_EQUAL(0, file.open(FS, "bench/big", O_RDONLY));
+    while ((res = file.read(buffer, sizeof(buffer))) > 0) {
+        total += res;
+    }
+    TEST_ASSERT_EQUAL(0, file.close());
+    timer.stop();
+
+    TEST_ASSERT_EQUAL(BENCH_FILE_SIZE, total);
+    report(FS->getName(), "read_bps", per_second(total, timer.read_us()), "bytes/s");
+}
+
+template <typename T, T *FS>
+void test_unmount()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL, "no block device found.");
+
+    TEST_ASSERT_EQUAL(0, FS->unmount());
+    TEST_ASSERT_EQUAL(0, bd->deinit());
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(300, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("LittleFileSystem format", test_format<LittleFileSystem, &little_fs>),
+    Case("LittleFileSystem create", test_create<LittleFileSystem, &little_fs>),
+    Case("LittleFileSystem append", test_append<LittleFileSystem, &little_fs>),
+    Case("LittleFileSystem write", test_write<LittleFileSystem, &little_fs>),
+    Case("LittleFileSystem read", test_read<LittleFileSystem, &little_fs>),
+    Case("LittleFileSystem unmount", test_unmount<LittleFileSystem, &little_fs>),
+    Case("FATFileSystem format", test_format<FATFileSystem, &fat_fs>),
+    Case("FATFileSystem create", test_create<FATFileSystem, &fat_fs>),
+    Case("FATFileSystem append", test_append<FATFileSystem, &fat_fs>),
+    Case("FATFileSystem write", test_write<FATFileSystem, &fat_fs>),
+    Case("FATFileSystem read", test_read<FATFileSystem, &fat_fs>),
+    Case("FATFileSystem unmount", test_unmount<FATFileSystem, &fat_fs>),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
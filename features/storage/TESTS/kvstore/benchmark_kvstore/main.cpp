@@ -0,0 +1,209 @@
+/*
+* Copyright (c) 2019 ARM Limited. All rights reserved.
+* SPDX-License-Identifier: Apache-2.0
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "TDBStore.h"
+#include "SecureStore.h"
+#include "mbed_error.h"
+#include "Timer.h"
+#include "HeapBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <algorithm>
+
+using namespace mbed;
+using namespace utest::v1;
+
+/* set/get latency and garbage collection cost of TDBStore and SecureStore
+ * at growing key counts, on a simulated flash in RAM so results depend on
+ * the store rather than on the storage. Results are printed and sent with
+ * greentea_send_kv, as <store>_<keys>_<operation>_<statistic>_us.
+ */
+
+#define BENCH_MAX_KEYS          128
+#define BENCH_DATA_SIZE         32
+#define BENCH_OVERWRITE_ROUNDS  4
+
+static const size_t bd_size = 16 * 4096;
+
+HeapBlockDevice bd(bd_size, 1, 1, 4096);
+FlashSimBlockDevice flash_bd(&bd);
+
+static TDBStore *tdbs;
+static KVStore *kvs;
+static const char *kvs_name;
+
+static uint32_t samples[BENCH_MAX_KEYS * BENCH_OVERWRITE_ROUNDS];
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void report_latency(int keys, const char *op, uint32_t *values, int count)
+{
+    qsort(values, count, sizeof(values[0]), compare_u32);
+
+    uint32_t stats[3] = { values[count / 2], values[std::min(count - 1, (count * 99) / 100)], values[count - 1] };
+    const char *names[3] = { "p50", "p99", "max" };
+
+    for (int i = 0; i < 3; i++) {
+        char kv_key[64];
+        snprintf(kv_key, sizeof(kv_key), "%s_%d_%s_%s_us", kvs_name, keys, op, names[i]);
+        printf("%s: %lu\n", kv_key, (unsigned long) stats[i]);
+        greentea_send_kv(kv_key, (int) stats[i]);
+    }
+}
+
+static void make_key(char *key, size_t size, int index)
+{
+    snprintf(key, size, "bench_key_%d", index);
+}
+
+template <int Keys>
+void test_kvstore_keys()
+{
+    TEST_SKIP_UNLESS_MESSAGE(kvs != NULL, "KVStore not available");
+
+    char key[32];
+    uint8_t data[BENCH_DATA_SIZE];
+    size_t actual_size;
+    Timer timer;
+
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, kvs->reset());
+    memset(data, 0x3c, sizeof(data));
+    timer.start();
+
+    // First set of each key adds a record
+    for (int i = 0; i < Keys; i++) {
+        make_key(key, sizeof(key), i);
+        uint32_t start = timer.read_us();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, kvs->set(key, data, sizeof(data), 0));
+        samples[i] = timer.read_us() - start;
+    }
+    report_latency(Keys, "set", samples, Keys);
+
+    for (int i = 0; i < Keys; i++) {
+        make_key(key, sizeof(key), i);
+        uint32_t start = timer.read_us();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, kvs->get(key, data, sizeof(data), &actual_size));
+        samples[i] = timer.read_us() - start;
+    }
+    report_latency(Keys, "get", samples, Keys);
+
+    // Overwriting fills the active area, so some of these sets include a
+    // garbage collection, which shows up in the tail
+    int count = 0;
+    for (int round = 0; round < BENCH_OVERWRITE_ROUNDS; round++) {
+        for (int i = 0; i < Keys; i++) {
+            make_key(key, sizeof(key), i);
+            data[0] = round;
+            uint32_t start = timer.read_us();
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, kvs->set(key, data, sizeof(data), 0));
+            samples[count++] = timer.read_us() - start;
+        }
+    }
+    report_latency(Keys, "overwrite", samples, count);
+
+    // Incremental garbage collection steps, where the store supports them
+    if (kvs == tdbs) {
+        count = 0;
+        for (int i = 0; i < Keys; i++) {
+            uint32_t start = timer.read_us();
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, tdbs->gc_step());
+            samples[count++] = timer.read_us() - start;
+        }
+        report_latency(Keys, "gc_step", samples, count);
+    }
+}
+
+void test_tdbstore_init()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[bd_size + 4096];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+    delete[] dummy;
+
+    tdbs = new TDBStore(&flash_bd);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, tdbs->init());
+    kvs = tdbs;
+    kvs_name = "tdbstore";
+}
+
+void test_securestore_init()
+{
+#if SECURESTORE_ENABLED
+    TEST_SKIP_UNLESS_MESSAGE(tdbs != NULL, "TDBStore not available");
+
+    SecureStore *sec_kv = new SecureStore(tdbs);
+    int result = sec_kv->init();
+    if (result != MBED_SUCCESS) {
+        // No device key can be derived on this target
+        delete sec_kv;
+        kvs = NULL;
+        TEST_SKIP_MESSAGE("SecureStore init failed");
+    }
+    kvs = sec_kv;
+    kvs_name = "securestore";
+#else
+    kvs = NULL;
+    TEST_SKIP_MESSAGE("SecureStore not enabled");
+#endif
+}
+
+void test_deinit()
+{
+    if (kvs != NULL && kvs != tdbs) {
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, kvs->deinit());
+        delete kvs;
+    }
+    kvs = NULL;
+    if (tdbs != NULL) {
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, tdbs->deinit());
+        delete tdbs;
+        tdbs = NULL;
+    }
+}
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(300, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("TDBStore init", test_tdbstore_init),
+    Case("TDBStore 16 keys", test_kvstore_keys<16>),
+    Case("TDBStore 64 keys", test_kvstore_keys<64>),
+    Case("TDBStore 128 keys", test_kvstore_keys<128>),
+    Case("SecureStore init", test_securestore_init),
+    Case("SecureStore 16 keys", test_kvstore_keys<16>),
+    Case("SecureStore 64 keys", test_kvstore_keys<64>),
+    Case("SecureStore 128 keys", test_kvstore_keys<128>),
+    Case("Deinit", test_deinit),
+};
+
+Specification specification(greentea_test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
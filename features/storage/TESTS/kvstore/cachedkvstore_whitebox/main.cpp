@@ -0,0 +1,184 @@
+/*
+* Copyright (c) 2019 ARM Limited. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "CachedKVStore.h"
+#include "TDBStore.h"
+#include "mbed_error.h"
+#include "HeapBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#if !defined(TARGET_K64F) && !defined(TARGET_ARM_FM)
+#error [NOT_SUPPORTED] Kvstore API tests run only on K64F devices and Fastmodels
+#endif
+
+using namespace mbed;
+using namespace utest::v1;
+
+static const size_t bd_size = 8 * 4096;
+
+static const int heap_alloc_threshold_size = 4096;
+
+static const size_t cache_entries = 2;
+static const size_t cache_max_value_size = 16;
+
+HeapBlockDevice bd(bd_size, 1, 1, 4096);
+FlashSimBlockDevice flash_bd(&bd);
+
+static const char *const key1      = "key1";
+static const char *const key1_val1 = "val1";
+static const char *const key1_val2 = "val2 of key1";
+static const char *const key2      = "name_of_key2";
+static const char *const key2_val1 = "val1 of key2";
+static const char *const key3      = "key3";
+static const char *const key3_val1 = "Value of key 3, too large to be cached";
+static const char *const key4      = "secret_key4";
+static const char *const key4_val1 = "val1 of key4";
+
+static void check_get(KVStore *kvs, const char *key, const char *val)
+{
+    char get_buf[64];
+    size_t actual_data_size;
+    int result;
+
+    result = kvs->get(key, get_buf, sizeof(get_buf), &actual_data_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(strlen(val), actual_data_size);
+    TEST_ASSERT_EQUAL_STRING_LEN(val, get_buf, actual_data_size);
+}
+
+static void white_box_test()
+{
+    char get_buf[64];
+    size_t actual_data_size;
+    int result;
+    KVStore::info_t info;
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+
+    // We need to skip the test if we don't have enough memory for the heap block device.
+    // However, this device allocates the erase units on the fly, so "erase" it via the flash
+    // simulator. A failure here means we haven't got enough memory.
+    flash_bd.init();
+    result = flash_bd.erase(0, flash_bd.size());
+    TEST_SKIP_UNLESS_MESSAGE(!result, "Not enough heap to run test");
+    flash_bd.deinit();
+
+    delete[] dummy;
+
+    TDBStore *tdbs = new TDBStore(&flash_bd);
+    CachedKVStore *kvs = new CachedKVStore(tdbs, cache_entries, cache_max_value_size, "secret_");
+
+    result = kvs->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = kvs->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    // Values are written through
+    result = kvs->set(key1, key1_val1, strlen(key1_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_get(tdbs, key1, key1_val1);
+    check_get(kvs, key1, key1_val1);
+
+    result = kvs->get(key1, get_buf, 2, &actual_data_size, 1);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(2, actual_data_size);
+    TEST_ASSERT_EQUAL_STRING_LEN(key1_val1 + 1, get_buf, 2);
+
+    result = kvs->get_info(key1, &info);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(strlen(key1_val1), info.size);
+
+    // Changing the underlying store behind the cache's back shows what's cached
+    result = tdbs->set(key1, key1_val2, strlen(key1_val2), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_get(kvs, key1, key1_val1);
+
+    result = kvs->set(key1, key1_val2, strlen(key1_val2), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_get(kvs, key1, key1_val2);
+
+    // Large and excluded values are never cached
+    result = kvs->set(key3, key3_val1, strlen(key3_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_get(kvs, key3, key3_val1);
+
+    result = kvs->set(key4, key4_val1, strlen(key4_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_get(kvs, key4, key4_val1);
+    result = tdbs->set(key4, key1_val1, strlen(key1_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_get(kvs, key4, key1_val1);
+
+    // Values read from the underlying store get cached, evicting the least recently used one
+    result = tdbs->set(key2, key2_val1, strlen(key2_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_get(kvs, key2, key2_val1);
+    check_get(kvs, key1, key1_val2);
+    result = tdbs->set(key2, key1_val1, strlen(key1_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_get(kvs, key2, key2_val1);
+
+    result = kvs->remove(key1);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = kvs->get(key1, get_buf, sizeof(get_buf), &actual_data_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+    result = kvs->get_info(key1, &info);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+
+    result = kvs->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = kvs->get(key2, get_buf, sizeof(get_buf), &actual_data_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+
+    result = kvs->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete kvs;
+    delete tdbs;
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("CachedKVStore: White box test",     white_box_test,    greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -492,6 +492,117 @@ void test_file_system_store_multi_threads()
     TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
 }
 
+void test_file_system_store_packed_values()
+{
+    utest_printf("\nTest FileSystemStore Packed Values..\n");
+    TEST_SKIP_UNLESS(bd != NULL);
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+    delete[] dummy;
+
+    char kv_key[16] = {0};
+    char kv_value[64] = {0};
+    char kv_buf[64] = {0};
+    size_t actual_size = 0;
+    int i_ind = 0;
+
+    int err = bd->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+
+    FileSystem *fs = FileSystem::get_default_instance();
+
+    err = fs->mount(bd);
+    if (err) {
+        err = fs->reformat(bd);
+        TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+    }
+
+    /* Values up to 32 bytes are packed */
+    FileSystemStore *fsst = new FileSystemStore(fs, 32);
+
+    err = fsst->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+
+    err = fsst->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+
+    /* Overwrite small values enough times to compact the log */
+    for (int round = 0; round < 20; round++) {
+        for (i_ind = 0; i_ind < 20; i_ind++) {
+            sprintf(kv_key, "pkey%d", i_ind);
+            sprintf(kv_value, "value%d_%d", i_ind, round);
+            err = fsst->set(kv_key, kv_value, strlen(kv_value) + 1, 0);
+            TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+        }
+    }
+
+    /* A large value gets its own file and replaces the packed one */
+    memset(kv_value, 'a', 63);
+    err = fsst->set("pkey3", kv_value, 64, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+
+    /* And the other way around */
+    err = fsst->set("bigkey", kv_value, 64, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+    err = fsst->set("bigkey", "small", 6, mbed::KVStore::WRITE_ONCE_FLAG);
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+    err = fsst->remove("bigkey");
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_WRITE_PROTECTED, err);
+
+    err = fsst->remove("pkey4");
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+
+    /* Everything is found again after init replays the log */
+    err = fsst->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+    err = fsst->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+
+    for (i_ind = 0; i_ind < 20; i_ind++) {
+        sprintf(kv_key, "pkey%d", i_ind);
+        sprintf(kv_value, "value%d_19", i_ind);
+        err = fsst->get(kv_key, kv_buf, 64, &actual_size, 0);
+        if (i_ind == 4) {
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, err);
+        } else if (i_ind == 3) {
+            TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+            TEST_ASSERT_EQUAL(64, actual_size);
+        } else {
+            TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+            TEST_ASSERT_EQUAL(0, strcmp(kv_value, kv_buf));
+        }
+    }
+
+    KVStore::info_t kv_info;
+    err = fsst->get_info("bigkey", &kv_info);
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+    TEST_ASSERT_EQUAL(6, kv_info.size);
+    TEST_ASSERT_EQUAL(mbed::KVStore::WRITE_ONCE_FLAG, kv_info.flags);
+
+    KVStore::iterator_t kv_it;
+    err = fsst->iterator_open(&kv_it, "pkey");
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+    i_ind = 0;
+    while (fsst->iterator_next(kv_it, kv_key, 16) != MBED_ERROR_ITEM_NOT_FOUND) {
+        i_ind++;
+    }
+    TEST_ASSERT_EQUAL(19, i_ind);
+    fsst->iterator_close(kv_it);
+
+    err = fsst->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+    err = fsst->get("pkey1", kv_buf, 64, &actual_size, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, err);
+
+    err = fsst->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+    delete fsst;
+
+    err = bd->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(0, err);
+}
+
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
 {
     greentea_case_failure_abort_handler(source, reason);
@@ -508,7 +619,8 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 Case cases[] = {
     Case("Testing functionality APIs unit test", test_file_system_store_functionality_unit_test, greentea_failure_handler),
     Case("Testing Edge Cases", test_file_system_store_edge_cases, greentea_failure_handler),
-    Case("Testing Multi Threads Set", test_file_system_store_multi_threads, greentea_failure_handler)
+    Case("Testing Multi Threads Set", test_file_system_store_multi_threads, greentea_failure_handler),
+    Case("Testing Packed Values", test_file_system_store_packed_values, greentea_failure_handler)
 };
 
 Specification specification(test_setup, cases);
@@ -269,6 +269,22 @@ static void white_box_test()
         TEST_ASSERT_EQUAL(7, actual_data_size);
         TEST_ASSERT_EQUAL_STRING_LEN(key4_val2 + 30, get_buf, 7);
 
+        // Streaming get, in chunks not aligned to encryption blocks
+        KVStore::get_handle_t get_handle;
+        size_t streamed_size = 0, data_size;
+        result = sec_kv->get_start(&get_handle, key4, &data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        TEST_ASSERT_EQUAL(strlen(key4_val2), data_size);
+        do {
+            result = sec_kv->get_data(get_handle, get_buf + streamed_size, 7, &actual_data_size);
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+            streamed_size += actual_data_size;
+        } while (actual_data_size);
+        result = sec_kv->get_finalize(get_handle);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        TEST_ASSERT_EQUAL(strlen(key4_val2), streamed_size);
+        TEST_ASSERT_EQUAL_STRING_LEN(key4_val2, get_buf, strlen(key4_val2));
+
         result = sec_kv->get(key5, get_buf, sizeof(get_buf), &actual_data_size);
         TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
         TEST_ASSERT_EQUAL(strlen(key5_val1), actual_data_size);
@@ -629,6 +629,55 @@ static void get_info_overwritten_key()
     TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
 }
 
+/*----------------key handle------------------*/
+
+//bad params : handle is null
+static void key_resolve_handle_null()
+{
+    TEST_SKIP_UNLESS(!init_res);
+    int res = kv_key_resolve(key, NULL);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_INVALID_ARGUMENT, res);
+}
+
+//resolve a key once and access it through the handle - valid flow
+static void key_handle_set_get_remove()
+{
+    TEST_SKIP_UNLESS(!init_res);
+    kv_key_handle_t handle;
+    char buffer[20] = {};
+    size_t actual_size = 0;
+
+    int res = kv_key_resolve(key, &handle);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+
+    res = kv_handle_set(handle, data, data_size, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+
+    res = kv_get(key, buffer, sizeof(buffer), &actual_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+    TEST_ASSERT_EQUAL(data_size, actual_size);
+    TEST_ASSERT_EQUAL_STRING_LEN(data, buffer, data_size);
+
+    memset(buffer, 0, sizeof(buffer));
+    res = kv_handle_get(handle, buffer, sizeof(buffer), &actual_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+    TEST_ASSERT_EQUAL(data_size, actual_size);
+    TEST_ASSERT_EQUAL_STRING_LEN(data, buffer, data_size);
+
+    res = kv_handle_get_info(handle, &info);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+    TEST_ASSERT_EQUAL(data_size, info.size);
+
+    res = kv_handle_remove(handle);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+
+    res = kv_handle_get(handle, buffer, sizeof(buffer), &actual_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, res);
+
+    res = kv_key_release(handle);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+}
+
 /*----------------iterator_open()------------------*/
 
 //bad params : it is null
@@ -959,6 +1008,9 @@ Case cases[] = {
     Case("get_info_existed_key", get_info_existed_key, greentea_failure_handler),
     Case("get_info_overwritten_key", get_info_overwritten_key, greentea_failure_handler),
 
+    Case("key_resolve_handle_null", key_resolve_handle_null, greentea_failure_handler),
+    Case("key_handle_set_get_remove", key_handle_set_get_remove, greentea_failure_handler),
+
     Case("iterator_open_it_null", iterator_open_it_null, greentea_failure_handler),
 
     Case("iterator_next_key_size_zero", iterator_next_key_size_zero, greentea_failure_handler),
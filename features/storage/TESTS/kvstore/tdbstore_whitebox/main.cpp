@@ -455,6 +455,291 @@ static void multi_set_test()
     delete tdbs;
 }
 
+static void set_batch_test()
+{
+    char get_buf[64];
+    size_t actual_data_size;
+    int result;
+
+    TDBStore *tdbs = new TDBStore(&flash_bd);
+
+    result = tdbs->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = tdbs->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = tdbs->set(key1, key1_val1, strlen(key1_val1), KVStore::WRITE_ONCE_FLAG);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    // A write once key in the batch fails it as a whole
+    KVStore::batch_item_t protected_items[] = {
+        {key2, key2_val1, strlen(key2_val1), 0},
+        {key1, key2_val2, strlen(key2_val2), 0},
+    };
+    result = tdbs->set_batch(protected_items, 2);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_WRITE_PROTECTED, result);
+
+    result = tdbs->get(key2, get_buf, sizeof(get_buf), &actual_data_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+
+    // Same key may appear twice - last one wins
+    KVStore::batch_item_t items[] = {
+        {key2, key2_val1, strlen(key2_val1), 0},
+        {key3, key3_val1, strlen(key3_val1), 0},
+        {key2, key2_val2, strlen(key2_val2), 0},
+    };
+    result = tdbs->set_batch(items, 3);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    for (int pass = 0; pass < 2; pass++) {
+        result = tdbs->get(key2, get_buf, sizeof(get_buf), &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        TEST_ASSERT_EQUAL(strlen(key2_val2), actual_data_size);
+        TEST_ASSERT_EQUAL_STRING_LEN(key2_val2, get_buf, actual_data_size);
+
+        result = tdbs->get(key3, get_buf, sizeof(get_buf), &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        TEST_ASSERT_EQUAL(strlen(key3_val1), actual_data_size);
+        TEST_ASSERT_EQUAL_STRING_LEN(key3_val1, get_buf, actual_data_size);
+
+        result = tdbs->deinit();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        result = tdbs->init();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    }
+
+    result = tdbs->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete tdbs;
+}
+
+static void streaming_get_test()
+{
+    uint8_t *get_buf, *set_buf;
+    size_t data_size = 1024;
+    size_t chunk_size = 100;
+    size_t streamed_size = 0, stream_data_size;
+    size_t actual_data_size;
+    KVStore::get_handle_t handle;
+    int result;
+    size_t i;
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+    delete[] dummy;
+
+    TDBStore *tdbs = new TDBStore(&flash_bd);
+
+    result = tdbs->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = tdbs->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    get_buf = new uint8_t[data_size];
+    set_buf = new uint8_t[data_size];
+    for (i = 0; i < data_size; i++) {
+        set_buf[i] = rand() % 256;
+    }
+
+    result = tdbs->set(key1, set_buf, data_size, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = tdbs->get_start(&handle, key1, &stream_data_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(data_size, stream_data_size);
+
+    do {
+        result = tdbs->get_data(handle, get_buf + streamed_size, chunk_size, &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        streamed_size += actual_data_size;
+
+        // Keep updating another key in between chunks, so garbage collection moves our record
+        for (i = 0; i < 16; i++) {
+            result = tdbs->set(key2, set_buf, chunk_size, 0);
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        }
+    } while (actual_data_size);
+
+    result = tdbs->get_finalize(handle);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(data_size, streamed_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(set_buf, get_buf, data_size);
+
+    // Value changed in the middle of the sequence
+    result = tdbs->get_start(&handle, key1);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = tdbs->set(key1, key1_val1, strlen(key1_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    for (i = 0; i < 200; i++) {
+        result = tdbs->set(key2, set_buf, chunk_size, 0);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    }
+
+    result = tdbs->get_data(handle, get_buf, chunk_size, &actual_data_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_INVALID_DATA_DETECTED, result);
+
+    result = tdbs->get_finalize(handle);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete[] get_buf;
+    delete[] set_buf;
+
+    result = tdbs->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete tdbs;
+}
+
+static void incremental_gc_test()
+{
+    char key[] = "key_0";
+    uint8_t *get_buf, *set_buf;
+    size_t data_size = 256;
+    size_t num_keys = 8;
+    size_t set_iters = 20;
+    size_t actual_data_size;
+    int result;
+    size_t i, key_ind;
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+    delete[] dummy;
+
+    TDBStore *tdbs = new TDBStore(&flash_bd);
+
+    result = tdbs->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = tdbs->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    get_buf = new uint8_t[data_size];
+    set_buf = new uint8_t[data_size];
+    memset(set_buf, 0, data_size);
+
+    // Keep modifying keys (including already migrated ones) while GC steps are in progress
+    for (i = 0; i < set_iters; i++) {
+        for (key_ind = 0; key_ind < num_keys; key_ind++) {
+            key[4] = '0' + key_ind;
+            set_buf[0] = key_ind;
+            set_buf[1] = i;
+            if ((key_ind == 3) && (i % 3 == 1)) {
+                result = tdbs->remove(key);
+            } else {
+                result = tdbs->set(key, set_buf, data_size, 0);
+            }
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+            result = tdbs->gc_step(1);
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        }
+    }
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (key_ind = 0; key_ind < num_keys; key_ind++) {
+            key[4] = '0' + key_ind;
+            set_buf[0] = key_ind;
+            set_buf[1] = set_iters - 1;
+            result = tdbs->get(key, get_buf, data_size, &actual_data_size);
+            if ((key_ind == 3) && ((set_iters - 1) % 3 == 1)) {
+                TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+                continue;
+            }
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+            TEST_ASSERT_EQUAL(data_size, actual_data_size);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(set_buf, get_buf, data_size);
+        }
+
+        // Make sure the migrated area is consistent after remount
+        result = tdbs->deinit();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        result = tdbs->init();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    }
+
+    result = tdbs->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete[] get_buf;
+    delete[] set_buf;
+
+    delete tdbs;
+}
+
+static void index_checkpoint_test()
+{
+    char key[] = "key_0";
+    uint8_t *get_buf, *set_buf;
+    size_t data_size = 256;
+    size_t num_keys = 8;
+    size_t set_iters = 40;
+    size_t actual_data_size;
+    int result;
+    size_t i, key_ind;
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+    delete[] dummy;
+
+    TDBStore *tdbs = new TDBStore(&flash_bd);
+
+    result = tdbs->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = tdbs->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    get_buf = new uint8_t[data_size];
+    set_buf = new uint8_t[data_size];
+    memset(set_buf, 0, data_size);
+
+    // Enough overwrites to garbage collect a few times, remounting in between so the index
+    // written by the last garbage collection is combined with the records appended since
+    for (i = 0; i < set_iters; i++) {
+        for (key_ind = 0; key_ind < num_keys; key_ind++) {
+            key[4] = '0' + key_ind;
+            set_buf[0] = key_ind;
+            set_buf[1] = i;
+            if ((key_ind == 5) && (i % 4 == 3)) {
+                result = tdbs->remove(key);
+            } else {
+                result = tdbs->set(key, set_buf, data_size, 0);
+            }
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        }
+
+        result = tdbs->deinit();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        result = tdbs->init();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+        for (key_ind = 0; key_ind < num_keys; key_ind++) {
+            key[4] = '0' + key_ind;
+            set_buf[0] = key_ind;
+            set_buf[1] = i;
+            result = tdbs->get(key, get_buf, data_size, &actual_data_size);
+            if ((key_ind == 5) && (i % 4 == 3)) {
+                TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+                continue;
+            }
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+            TEST_ASSERT_EQUAL(data_size, actual_data_size);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(set_buf, get_buf, data_size);
+        }
+    }
+
+    result = tdbs->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete[] get_buf;
+    delete[] set_buf;
+
+    delete tdbs;
+}
+
 static void error_inject_test()
 {
 
@@ -624,6 +909,10 @@ Case cases[] = {
     Case("TDBStore: White box test",     white_box_test,    greentea_failure_handler),
     Case("TDBStore: Multiple set test",  multi_set_test,    greentea_failure_handler),
     Case("TDBStore: Error inject test",  error_inject_test, greentea_failure_handler),
+    Case("TDBStore: Incremental GC test", incremental_gc_test, greentea_failure_handler),
+    Case("TDBStore: Index checkpoint test", index_checkpoint_test, greentea_failure_handler),
+    Case("TDBStore: Set batch test",     set_batch_test,    greentea_failure_handler),
+    Case("TDBStore: Streaming get test", streaming_get_test, greentea_failure_handler),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
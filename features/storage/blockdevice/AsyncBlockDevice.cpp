@@ -0,0 +1,196 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncBlockDevice.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+#include "rtos/ThisThread.h"
+#include <new>
+
+namespace mbed {
+
+AsyncBlockDevice::AsyncBlockDevice(BlockDevice *bd, uint32_t stack_size, unsigned queue_depth)
+    : _bd(bd), _stack_size(stack_size), _queue(queue_depth * EVENTS_EVENT_SIZE), _thread(NULL)
+{
+}
+
+AsyncBlockDevice::~AsyncBlockDevice()
+{
+    deinit();
+}
+
+int AsyncBlockDevice::init()
+{
+    if (_thread) {
+        return BD_ERROR_OK;
+    }
+
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    _thread = new (std::nothrow) rtos::Thread(osPriorityNormal, _stack_size, NULL, "async_bd");
+    if (!_thread) {
+        _bd->deinit();
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (_thread->start(callback(&_queue, &events::EventQueue::dispatch_forever)) != osOK) {
+        delete _thread;
+        _thread = NULL;
+        _bd->deinit();
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int AsyncBlockDevice::deinit()
+{
+    if (!_thread) {
+        return BD_ERROR_OK;
+    }
+
+    // Queued behind the pending operations, so they complete first
+    while (!_queue.call(&_queue, &events::EventQueue::break_dispatch)) {
+        rtos::ThisThread::sleep_for(1);
+    }
+    _thread->join();
+    delete _thread;
+    _thread = NULL;
+
+    return _bd->deinit();
+}
+
+int AsyncBlockDevice::sync()
+{
+    _mutex.lock();
+    int err = _bd->sync();
+    _mutex.unlock();
+    return err;
+}
+
+int AsyncBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    _mutex.lock();
+    int err = _bd->read(buffer, addr, size);
+    _mutex.unlock();
+    return err;
+}
+
+int AsyncBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    _mutex.lock();
+    int err = _bd->program(buffer, addr, size);
+    _mutex.unlock();
+    return err;
+}
+
+int AsyncBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    _mutex.lock();
+    int err = _bd->erase(addr, size);
+    _mutex.unlock();
+    return err;
+}
+
+int AsyncBlockDevice::read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done)
+{
+    if (!_thread || !_queue.call(this, &AsyncBlockDevice::run_read, buffer, addr, size, done)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int AsyncBlockDevice::program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done)
+{
+    if (!_thread || !_queue.call(this, &AsyncBlockDevice::run_program, buffer, addr, size, done)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int AsyncBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done)
+{
+    if (!_thread || !_queue.call(this, &AsyncBlockDevice::run_erase, addr, size, done)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return BD_ERROR_OK;
+}
+
+void AsyncBlockDevice::run_read(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done)
+{
+    done(read(buffer, addr, size));
+}
+
+void AsyncBlockDevice::run_program(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done)
+{
+    done(program(buffer, addr, size));
+}
+
+void AsyncBlockDevice::run_erase(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done)
+{
+    done(erase(addr, size));
+}
+
+bd_size_t AsyncBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t AsyncBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t AsyncBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t AsyncBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return _bd->get_erase_size(addr);
+}
+
+int AsyncBlockDevice::get_erase_value() const
+{
+    return _bd->get_erase_value();
+}
+
+bd_size_t AsyncBlockDevice::size() const
+{
+    return _bd->size();
+}
+
+const char *AsyncBlockDevice::get_type() const
+{
+    if (_bd != NULL) {
+        return _bd->get_type();
+    }
+
+    return NULL;
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,206 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_ASYNC_BLOCK_DEVICE_H
+#define MBED_ASYNC_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+#include "platform/PlatformMutex.h"
+#include "platform/NonCopyable.h"
+#include "events/EventQueue.h"
+#include "rtos/Thread.h"
+
+namespace mbed {
+
+/** Block device running the asynchronous operations of another block device on a worker thread
+ *
+ *  read_async, program_async and erase_async are queued to the worker thread, which
+ *  calls the completion callback when the operation finishes. Synchronous operations
+ *  are performed in the calling thread, serialized with the queued ones.
+ *
+ *  @code
+ *  AsyncBlockDevice async(&spif);
+ *  async.init();
+ *  // The radio thread keeps running while the sector is erased
+ *  async.erase_async(0, async.get_erase_size(), queue.event(erase_done));
+ *  @endcode
+ */
+class AsyncBlockDevice : public BlockDevice, private NonCopyable<AsyncBlockDevice> {
+public:
+    /** Lifetime of the block device
+     *
+     *  @param bd           Block device to run asynchronous operations on
+     *  @param stack_size   Stack size of the worker thread
+     *  @param queue_depth  Number of operations that can be queued at once
+     */
+    AsyncBlockDevice(BlockDevice *bd, uint32_t stack_size = OS_STACK_SIZE, unsigned queue_depth = 4);
+
+    /** Lifetime of the block device
+     */
+    virtual ~AsyncBlockDevice();
+
+    /** Initialize the block device and start the worker thread
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Finish queued operations, stop the worker thread and deinitialize the block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  The state of an erased block is undefined until it has been programmed
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Queue a read to the worker thread
+     *
+     *  @param buffer   Buffer to read blocks into, must stay valid until done is called
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param done     Called from the worker thread with the result of the read
+     *  @return         0 if queued, BD_ERROR_DEVICE_ERROR if not initialized or the queue is full
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done);
+
+    /** Queue a program to the worker thread
+     *
+     *  @param buffer   Buffer of data to write to blocks, must stay valid until done is called
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param done     Called from the worker thread with the result of the program
+     *  @return         0 if queued, BD_ERROR_DEVICE_ERROR if not initialized or the queue is full
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done);
+
+    /** Queue an erase to the worker thread
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param done     Called from the worker thread with the result of the erase
+     *  @return         0 if queued, BD_ERROR_DEVICE_ERROR if not initialized or the queue is full
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the size of an erasable block given address
+     *
+     *  @param addr     Address within the erasable block
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+
+    /** Get the value of storage when erased
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+    /** Get the BlockDevice class type.
+     *
+     *  @return         A string represent the BlockDevice class type.
+     */
+    virtual const char *get_type() const;
+
+private:
+    void run_read(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done);
+    void run_program(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done);
+    void run_erase(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done);
+
+    BlockDevice *_bd;
+    uint32_t _stack_size;
+    events::EventQueue _queue;
+    rtos::Thread *_thread;
+    PlatformMutex _mutex;
+};
+
+} // namespace mbed
+
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::AsyncBlockDevice;
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -20,7 +20,9 @@
 #ifndef MBED_BLOCK_DEVICE_H
 #define MBED_BLOCK_DEVICE_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include "platform/Callback.h"
 
 namespace mbed {
 
@@ -138,6 +140,75 @@ public:
         return 0;
     }
 
+    /** Read blocks from a block device without blocking the caller
+     *
+     *  The buffer must stay valid until the completion callback is called.
+     *  The default implementation reads synchronously and calls the callback
+     *  before returning; see AsyncBlockDevice for running any block device
+     *  on a worker thread.
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of the read block size
+     *  @param done     Called with 0 or a negative error code once the read completes
+     *  @return         0 if the read was started, in which case done is called,
+     *                  or a negative error code on failure
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done)
+    {
+        done(read(buffer, addr, size));
+        return 0;
+    }
+
+    /** Program blocks to a block device without blocking the caller
+     *
+     *  The buffer must stay valid until the completion callback is called.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of the program block size
+     *  @param done     Called with 0 or a negative error code once the program completes
+     *  @return         0 if the program was started, in which case done is called,
+     *                  or a negative error code on failure
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done)
+    {
+        done(program(buffer, addr, size));
+        return 0;
+    }
+
+    /** Erase blocks on a block device without blocking the caller
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of the erase block size
+     *  @param done     Called with 0 or a negative error code once the erase completes
+     *  @return         0 if the erase was started, in which case done is called,
+     *                  or a negative error code on failure
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> done)
+    {
+        done(erase(addr, size));
+        return 0;
+    }
+
+    /** Get a pointer through which a region can be read in place
+     *
+     *  Block devices backed by memory-mapped storage, such as internal flash,
+     *  return a pointer to the region so that it can be read, hashed or
+     *  verified without copying it into a buffer. The pointer stays valid
+     *  until the block device is deinitialized, and what it points to
+     *  changes with any later program or erase of the region. Block devices
+     *  that cache writes may program pending data of the region first.
+     *
+     *  @param addr     Address of the region
+     *  @param size     Size of the region in bytes
+     *  @return         Pointer to the region, or NULL if it can't be read in place
+     */
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size)
+    {
+        return NULL;
+    }
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -27,9 +27,11 @@ static inline uint32_t align_down(bd_size_t val, bd_size_t size)
     return val / size * size;
 }
 
-BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd)
-    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _write_cache_addr(0), _write_cache_valid(false),
-      _write_cache(0), _read_buf(0), _init_ref_count(0), _is_initialized(false)
+BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd, uint32_t write_cache_lines, bd_size_t read_ahead_size)
+    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _bd_size(0),
+      _write_cache_lines(write_cache_lines ? write_cache_lines : 1), _cache_lines(0), _write_cache(0), _cache_tick(0),
+      _read_ahead_size(read_ahead_size), _read_buf_capacity(0), _read_buf_addr(0), _read_buf_size(0), _next_read_addr(0),
+      _read_buf(0), _init_ref_count(0), _is_initialized(false)
 {
 }
 
@@ -56,14 +58,19 @@ int BufferedBlockDevice::init()
     _bd_size = _bd->size();
 
     if (!_write_cache) {
-        _write_cache = new uint8_t[_bd_program_size];
+        _cache_lines = new cache_line_t[_write_cache_lines];
+        _write_cache = new uint8_t[_write_cache_lines * _bd_program_size];
     }
 
     if (!_read_buf) {
-        _read_buf = new uint8_t[_bd_read_size];
+        // Read ahead whole read units, at least one
+        _read_buf_capacity = std::max<bd_size_t>(align_down(_read_ahead_size, _bd_read_size), _bd_read_size);
+        _read_buf = new uint8_t[_read_buf_capacity];
     }
 
     invalidate_write_cache();
+    _read_buf_size = 0;
+    _next_read_addr = 0;
 
     _is_initialized = true;
     return BD_ERROR_OK;
@@ -81,6 +88,8 @@ int BufferedBlockDevice::deinit()
         return BD_ERROR_OK;
     }
 
+    delete[] _cache_lines;
+    _cache_lines = 0;
     delete[] _write_cache;
     _write_cache = 0;
     delete[] _read_buf;
@@ -89,6 +98,27 @@ int BufferedBlockDevice::deinit()
     return _bd->deinit();
 }
 
+int BufferedBlockDevice::flush_line(uint32_t index)
+{
+    cache_line_t *line = &_cache_lines[index];
+    if (!line->dirty) {
+        return 0;
+    }
+
+    int ret = _bd->program(_write_cache + index * _bd_program_size, line->addr, _bd_program_size);
+    if (ret) {
+        return ret;
+    }
+
+    line->dirty = false;
+
+    // The read buffer may hold what was on the BD before
+    if (_read_buf_size && (_read_buf_addr < line->addr + _bd_program_size) && (_read_buf_addr + _read_buf_size > line->addr)) {
+        _read_buf_size = 0;
+    }
+    return 0;
+}
+
 int BufferedBlockDevice::flush()
 {
     MBED_ASSERT(_write_cache);
@@ -96,20 +126,72 @@ int BufferedBlockDevice::flush()
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if (_write_cache_valid) {
-        int ret = _bd->program(_write_cache, _write_cache_addr, _bd_program_size);
+    for (uint32_t i = 0; i < _write_cache_lines; i++) {
+        int ret = flush_line(i);
         if (ret) {
             return ret;
         }
-        invalidate_write_cache();
     }
     return 0;
 }
 
 void BufferedBlockDevice::invalidate_write_cache()
 {
-    _write_cache_addr = _bd_size;
-    _write_cache_valid = false;
+    for (uint32_t i = 0; i < _write_cache_lines; i++) {
+        _cache_lines[i].dirty = false;
+        _cache_lines[i].used = 0;
+    }
+}
+
+void BufferedBlockDevice::invalidate_range(bd_addr_t addr, bd_size_t size)
+{
+    for (uint32_t i = 0; i < _write_cache_lines; i++) {
+        cache_line_t *line = &_cache_lines[i];
+        if (line->used && (line->addr < addr + size) && (line->addr + _bd_program_size > addr)) {
+            line->dirty = false;
+            line->used = 0;
+        }
+    }
+
+    if (_read_buf_size && (_read_buf_addr < addr + size) && (_read_buf_addr + _read_buf_size > addr)) {
+        _read_buf_size = 0;
+    }
+}
+
+int BufferedBlockDevice::load_line(bd_addr_t addr, uint32_t *index)
+{
+    uint32_t victim = 0;
+    for (uint32_t i = 0; i < _write_cache_lines; i++) {
+        cache_line_t *line = &_cache_lines[i];
+        if (line->used && line->addr == addr) {
+            line->used = ++_cache_tick;
+            *index = i;
+            return 0;
+        }
+
+        if (line->used < _cache_lines[victim].used) {
+            victim = i;
+        }
+    }
+
+    // Need to flush the least recently used line to make room for another program unit
+    int ret = flush_line(victim);
+    if (ret) {
+        return ret;
+    }
+
+    cache_line_t *line = &_cache_lines[victim];
+    line->used = 0;
+    ret = _bd->read(_write_cache + victim * _bd_program_size, addr, _bd_program_size);
+    if (ret) {
+        return ret;
+    }
+
+    line->addr = addr;
+    line->dirty = false;
+    line->used = ++_cache_tick;
+    *index = victim;
+    return 0;
 }
 
 int BufferedBlockDevice::sync()
@@ -133,27 +215,36 @@ int BufferedBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
     }
 
     MBED_ASSERT(_write_cache && _read_buf);
-    // Common case - no need to involve write cache or read buffer
-    if (_bd->is_valid_read(addr, size) &&
-            ((addr + size <= _write_cache_addr) || (addr > _write_cache_addr + _bd_program_size))) {
-        return _bd->read(b, addr, size);
-    }
 
     uint8_t *buf = static_cast<uint8_t *>(b);
+    bool sequential = (addr == _next_read_addr);
+    _next_read_addr = addr + size;
 
-    // Read logic: Split read to chunks, according to whether we cross the write cache
+    // Read logic: Split read to chunks, according to whether we cross cache lines or the read buffer
     while (size) {
-        bd_size_t chunk;
+        bd_size_t chunk = size;
         bool read_from_bd = true;
-        if (addr < _write_cache_addr) {
-            chunk = std::min(size, _write_cache_addr - addr);
-        } else if ((addr >= _write_cache_addr) && (addr < _write_cache_addr + _bd_program_size)) {
-            // One case we need to take our data from cache
-            chunk = std::min(size, _bd_program_size - addr % _bd_program_size);
-            memcpy(buf, _write_cache + addr % _bd_program_size, chunk);
+        for (uint32_t i = 0; i < _write_cache_lines; i++) {
+            const cache_line_t *line = &_cache_lines[i];
+            if (!line->used || line->addr >= addr + chunk) {
+                continue;
+            }
+            if (line->addr > addr) {
+                // Stop the chunk where a cached line starts
+                chunk = line->addr - addr;
+            } else if (addr < line->addr + _bd_program_size) {
+                // One case we need to take our data from cache
+                chunk = std::min(size, line->addr + _bd_program_size - addr);
+                memcpy(buf, _write_cache + i * _bd_program_size + (addr - line->addr), chunk);
+                read_from_bd = false;
+                break;
+            }
+        }
+
+        if (read_from_bd && _read_buf_size && (addr >= _read_buf_addr) && (addr < _read_buf_addr + _read_buf_size)) {
+            chunk = std::min(chunk, _read_buf_addr + _read_buf_size - addr);
+            memcpy(buf, _read_buf + (addr - _read_buf_addr), chunk);
             read_from_bd = false;
-        } else {
-            chunk = size;
         }
 
         // Now, in case we read from the BD, make sure we are aligned with its read size.
@@ -162,8 +253,15 @@ int BufferedBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
             bd_size_t offs_in_read_buf = addr % _bd_read_size;
             int ret;
             if (offs_in_read_buf || (chunk < _bd_read_size)) {
-                chunk = std::min(chunk, _bd_read_size - offs_in_read_buf);
-                ret = _bd->read(_read_buf, addr - offs_in_read_buf, _bd_read_size);
+                bd_addr_t read_addr = addr - offs_in_read_buf;
+                bd_size_t read_size = sequential ? std::min(_read_buf_capacity, _bd_size - read_addr) : _bd_read_size;
+                _read_buf_size = 0;
+                ret = _bd->read(_read_buf, read_addr, read_size);
+                if (!ret) {
+                    _read_buf_addr = read_addr;
+                    _read_buf_size = read_size;
+                }
+                chunk = std::min(chunk, read_size - offs_in_read_buf);
                 memcpy(buf, _read_buf + offs_in_read_buf, chunk);
             } else {
                 chunk = align_down(chunk, _bd_read_size);
@@ -192,52 +290,24 @@ int BufferedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
     int ret;
 
-    bd_addr_t aligned_addr = align_down(addr, _bd_program_size);
-
     const uint8_t *buf = static_cast <const uint8_t *>(b);
 
-    // Need to flush if moved to another program unit
-    if (aligned_addr != _write_cache_addr) {
-        ret = flush();
-        if (ret) {
-            return ret;
-        }
-        _write_cache_addr = aligned_addr;
+    if (_read_buf_size && (_read_buf_addr < addr + size) && (_read_buf_addr + _read_buf_size > addr)) {
+        _read_buf_size = 0;
     }
 
     // Write logic: Keep data in cache as long as we don't reach the end of the program unit.
     // Otherwise, program to the underlying BD.
     while (size) {
-        _write_cache_addr = align_down(addr, _bd_program_size);
-        bd_addr_t offs_in_buf = addr - _write_cache_addr;
+        bd_addr_t unit_addr = align_down(addr, _bd_program_size);
+        bd_addr_t offs_in_buf = addr - unit_addr;
         bd_size_t chunk;
-        if (offs_in_buf) {
-            chunk = std::min(_bd_program_size - offs_in_buf, size);
-        } else if (size >= _bd_program_size) {
-            chunk = align_down(size, _bd_program_size);
-        } else {
-            chunk = size;
-        }
 
-        const uint8_t *prog_buf;
-        if (chunk < _bd_program_size) {
-            // If cache not valid, and program doesn't cover an entire unit, it means we need to
-            // read it from the underlying BD
-            if (!_write_cache_valid) {
-                ret = _bd->read(_write_cache, _write_cache_addr, _bd_program_size);
-                if (ret) {
-                    return ret;
-                }
-            }
-            memcpy(_write_cache + offs_in_buf, buf, chunk);
-            prog_buf = _write_cache;
-        } else {
-            prog_buf = buf;
-        }
-
-        // Only program if we reached the end of a program unit
-        if (!((offs_in_buf + chunk) % _bd_program_size)) {
-            ret = _bd->program(prog_buf, _write_cache_addr, std::max(chunk, _bd_program_size));
+        if (!offs_in_buf && (size >= _bd_program_size)) {
+            // Whole program units go straight to the underlying BD, superseding any cached copy
+            chunk = align_down(size, _bd_program_size);
+            invalidate_range(addr, chunk);
+            ret = _bd->program(buf, addr, chunk);
             if (ret) {
                 return ret;
             }
@@ -245,9 +315,30 @@ int BufferedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
             if (ret) {
                 return ret;
             }
-            invalidate_write_cache();
         } else {
-            _write_cache_valid = true;
+            chunk = std::min(_bd_program_size - offs_in_buf, size);
+
+            // If the unit isn't cached, and program doesn't cover an entire unit, it means we need to
+            // read it from the underlying BD
+            uint32_t index;
+            ret = load_line(unit_addr, &index);
+            if (ret) {
+                return ret;
+            }
+            memcpy(_write_cache + index * _bd_program_size + offs_in_buf, buf, chunk);
+            _cache_lines[index].dirty = true;
+
+            // Only program if we reached the end of a program unit
+            if (!((offs_in_buf + chunk) % _bd_program_size)) {
+                ret = flush_line(index);
+                if (ret) {
+                    return ret;
+                }
+                ret = _bd->sync();
+                if (ret) {
+                    return ret;
+                }
+            }
         }
 
         buf += chunk;
@@ -265,9 +356,7 @@ int BufferedBlockDevice::erase(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
-        invalidate_write_cache();
-    }
+    invalidate_range(addr, size);
     return _bd->erase(addr, size);
 }
 
@@ -278,9 +367,7 @@ int BufferedBlockDevice::trim(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
-        invalidate_write_cache();
-    }
+    invalidate_range(addr, size);
     return _bd->trim(addr, size);
 }
 
@@ -321,6 +408,29 @@ int BufferedBlockDevice::get_erase_value() const
     return _bd->get_erase_value();
 }
 
+const void *BufferedBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return NULL;
+    }
+
+    const void *mapped = _bd->get_mapped_address(addr, size);
+    if (!mapped) {
+        return NULL;
+    }
+
+    // The underlying BD must hold whatever was programmed to the range
+    for (uint32_t i = 0; i < _write_cache_lines; i++) {
+        cache_line_t *line = &_cache_lines[i];
+        if (line->dirty && (line->addr < addr + size) && (line->addr + _bd_program_size > addr)) {
+            if (flush_line(i)) {
+                return NULL;
+            }
+        }
+    }
+    return mapped;
+}
+
 bd_size_t BufferedBlockDevice::size() const
 {
     if (!_is_initialized) {
@@ -32,14 +32,25 @@ namespace mbed {
 
 /** Block device for allowing minimal read and program sizes (of 1) for the underlying BD,
  *  using a buffer on the heap.
+ *
+ *  Partial program units are kept in a write-back cache of one or more lines, each the
+ *  size of a program unit. Once all lines are in use, the least recently used line is
+ *  programmed to make room. Lines are programmed as soon as they are completely written,
+ *  at the latest on sync().
+ *
+ *  Small reads that continue where the previous read ended can read ahead into a buffer,
+ *  so sequential small reads don't each go to the underlying BD.
  */
 class BufferedBlockDevice : public BlockDevice {
 public:
     /** Lifetime of a memory-buffered block device wrapping an underlying block device
      *
-     *  @param bd        Block device to back the BufferedBlockDevice
+     *  @param bd                Block device to back the BufferedBlockDevice
+     *  @param write_cache_lines Number of program units cached for partial programs
+     *  @param read_ahead_size   Number of bytes read from the underlying BD for sequential
+     *                           small reads, 0 to read a single read unit
      */
-    BufferedBlockDevice(BlockDevice *bd);
+    BufferedBlockDevice(BlockDevice *bd, uint32_t write_cache_lines = 1, bd_size_t read_ahead_size = 0);
 
     /** Lifetime of the memory-buffered block device
      */
@@ -147,6 +158,14 @@ public:
      */
     virtual int get_erase_value() const;
 
+    /** Get a pointer through which a region can be read in place
+     *
+     *  @param addr     Address of the region
+     *  @param size     Size of the region in bytes
+     *  @return         Pointer to the region, or NULL if it can't be read in place
+     */
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size);
+
     /** Get the total size of the underlying device
      *
      *  @return         Size of the underlying device in bytes
@@ -164,10 +183,26 @@ protected:
     bd_size_t _bd_program_size;
     bd_size_t _bd_read_size;
     bd_size_t _bd_size;
-    bd_size_t _write_cache_addr;
-    bool _write_cache_valid;
+
+    // Write-back cache lines, one program unit each
+    struct cache_line_t {
+        bd_addr_t addr;
+        bool dirty;
+        uint32_t used; // zero if the line is empty
+    };
+    const uint32_t _write_cache_lines;
+    cache_line_t *_cache_lines;
     uint8_t *_write_cache;
+    uint32_t _cache_tick;
+
+    // Read buffer, holding _read_buf_size bytes of the underlying BD from _read_buf_addr
+    const bd_size_t _read_ahead_size;
+    bd_size_t _read_buf_capacity;
+    bd_addr_t _read_buf_addr;
+    bd_size_t _read_buf_size;
+    bd_addr_t _next_read_addr;
     uint8_t *_read_buf;
+
     uint32_t _init_ref_count;
     bool _is_initialized;
 
@@ -183,6 +218,28 @@ protected:
      *  @return         none
      */
     void invalidate_write_cache();
+
+    /** Drop cached data of a range, without programming it
+     *
+     *  @param addr     Start of the range
+     *  @param size     Size of the range
+     */
+    void invalidate_range(bd_addr_t addr, bd_size_t size);
+
+    /** Program a cache line if it holds unprogrammed data
+     *
+     *  @param index    Cache line to program
+     *  @return         0 on success or a negative error code on failure
+     */
+    int flush_line(uint32_t index);
+
+    /** Find or load the cache line of a program unit
+     *
+     *  @param addr     Program unit aligned address
+     *  @param index    Set to the cache line holding the unit
+     *  @return         0 on success or a negative error code on failure
+     */
+    int load_line(bd_addr_t addr, uint32_t *index);
 #endif //#if !(DOXYGEN_ONLY)
 };
 } // namespace mbed
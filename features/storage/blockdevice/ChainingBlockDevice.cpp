@@ -17,13 +17,19 @@
 #include "ChainingBlockDevice.h"
 #include "platform/mbed_atomic.h"
 #include "platform/mbed_assert.h"
+#include <algorithm>
 
 namespace mbed {
 
-ChainingBlockDevice::ChainingBlockDevice(BlockDevice **bds, size_t bd_count)
+ChainingBlockDevice::ChainingBlockDevice(BlockDevice **bds, size_t bd_count, bd_size_t stripe_size)
     : _bds(bds), _bd_count(bd_count)
     , _read_size(0), _program_size(0), _erase_size(0), _size(0)
     , _erase_value(-1), _init_ref_count(0), _is_initialized(false)
+    , _stripe_size(stripe_size)
+#if !MBED_CONF_RTOS_PRESENT
+    , _stripe_done(0)
+#endif
+    , _stripe_error(0)
 {
 }
 
@@ -88,6 +94,19 @@ int ChainingBlockDevice::init()
         _size += _bds[i]->size();
     }
 
+    if (_stripe_size) {
+        // Every block device holds the same number of whole erase blocks,
+        // an erase block of the striped device is one of each
+        MBED_ASSERT(is_aligned(_stripe_size, _program_size) && is_aligned(_stripe_size, _read_size));
+        MBED_ASSERT(is_aligned(_erase_size, _stripe_size));
+        bd_size_t bd_size = _bds[0]->size();
+        for (size_t i = 1; i < _bd_count; i++) {
+            bd_size = std::min(bd_size, _bds[i]->size());
+        }
+        _size = (bd_size / _erase_size) * _erase_size * _bd_count;
+        _erase_size *= _bd_count;
+    }
+
     _is_initialized = true;
     return BD_ERROR_OK;
 
@@ -145,6 +164,10 @@ int ChainingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 
     uint8_t *buffer = static_cast<uint8_t *>(b);
 
+    if (_stripe_size) {
+        return striped_transfer(STRIPE_READ, buffer, addr, size);
+    }
+
     // Find block devices containing blocks, may span multiple block devices
     for (size_t i = 0; i < _bd_count && size > 0; i++) {
         bd_size_t bdsize = _bds[i]->size();
@@ -180,6 +203,10 @@ int ChainingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
     const uint8_t *buffer = static_cast<const uint8_t *>(b);
 
+    if (_stripe_size) {
+        return striped_transfer(STRIPE_PROGRAM, const_cast<uint8_t *>(buffer), addr, size);
+    }
+
     // Find block devices containing blocks, may span multiple block devices
     for (size_t i = 0; i < _bd_count && size > 0; i++) {
         bd_size_t bdsize = _bds[i]->size();
@@ -213,6 +240,10 @@ int ChainingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
+    if (_stripe_size) {
+        return striped_erase(addr, size);
+    }
+
     // Find block devices containing blocks, may span multiple block devices
     for (size_t i = 0; i < _bd_count && size > 0; i++) {
         bd_size_t bdsize = _bds[i]->size();
@@ -238,6 +269,102 @@ int ChainingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return 0;
 }
 
+int ChainingBlockDevice::striped_transfer(stripe_op op, uint8_t *buffer, bd_addr_t addr, bd_size_t size)
+{
+    int err = 0;
+
+    _stripe_mutex.lock();
+    while (size > 0 && !err) {
+        // Consecutive stripes are on different block devices, start one
+        // stripe on each and wait for all of them
+        uint32_t started = 0;
+        _stripe_error = 0;
+        for (size_t i = 0; i < _bd_count && size > 0; i++) {
+            bd_addr_t stripe = addr / _stripe_size;
+            bd_size_t offset = addr % _stripe_size;
+            bd_size_t len = std::min(size, _stripe_size - offset);
+            BlockDevice *bd = _bds[stripe % _bd_count];
+            bd_addr_t bd_addr = (stripe / _bd_count) * _stripe_size + offset;
+            mbed::Callback<void(int)> done(this, &ChainingBlockDevice::stripe_done);
+
+            if (op == STRIPE_READ) {
+                err = bd->read_async(buffer, bd_addr, len, done);
+            } else {
+                err = bd->program_async(buffer, bd_addr, len, done);
+            }
+            if (err) {
+                break;
+            }
+            started++;
+
+            buffer += len;
+            addr += len;
+            size -= len;
+        }
+
+        stripe_wait(started);
+        if (!err) {
+            err = _stripe_error;
+        }
+    }
+    _stripe_mutex.unlock();
+
+    return err;
+}
+
+int ChainingBlockDevice::striped_erase(bd_addr_t addr, bd_size_t size)
+{
+    // Erase blocks are one erase block of each block device at the same address
+    bd_addr_t bd_addr = addr / _bd_count;
+    bd_size_t bd_size = size / _bd_count;
+    uint32_t started = 0;
+    int err = 0;
+
+    _stripe_mutex.lock();
+    _stripe_error = 0;
+    for (size_t i = 0; i < _bd_count; i++) {
+        err = _bds[i]->erase_async(bd_addr, bd_size, mbed::Callback<void(int)>(this, &ChainingBlockDevice::stripe_done));
+        if (err) {
+            break;
+        }
+        started++;
+    }
+
+    stripe_wait(started);
+    if (!err) {
+        err = _stripe_error;
+    }
+    _stripe_mutex.unlock();
+
+    return err;
+}
+
+void ChainingBlockDevice::stripe_wait(uint32_t started)
+{
+#if MBED_CONF_RTOS_PRESENT
+    for (uint32_t i = 0; i < started; i++) {
+        _stripe_done.acquire();
+    }
+#else
+    // Without an RTOS block devices complete from interrupts, or before returning
+    while (core_util_atomic_load_u32(&_stripe_done) < started) {
+    }
+    _stripe_done = 0;
+#endif
+}
+
+void ChainingBlockDevice::stripe_done(int err)
+{
+    if (err) {
+        _stripe_error = err;
+    }
+#if MBED_CONF_RTOS_PRESENT
+    _stripe_done.release();
+#else
+    core_util_atomic_incr_u32(&_stripe_done, 1);
+#endif
+}
+
 bd_size_t ChainingBlockDevice::get_read_size() const
 {
     return _read_size;
@@ -259,6 +386,10 @@ bd_size_t ChainingBlockDevice::get_erase_size(bd_addr_t addr) const
         return 0;
     }
 
+    if (_stripe_size) {
+        return _erase_size;
+    }
+
     bd_addr_t bd_start_addr = 0;
     for (size_t i = 0; i < _bd_count; i++) {
         bd_size_t bdsize = _bds[i]->size();
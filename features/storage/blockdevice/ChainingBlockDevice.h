@@ -28,6 +28,10 @@
 
 #include "BlockDevice.h"
 #include "platform/mbed_assert.h"
+#include "platform/PlatformMutex.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Semaphore.h"
+#endif
 #include <stdlib.h>
 
 namespace mbed {
@@ -50,6 +54,22 @@ namespace mbed {
  *  BlockDevice *bds[] = {&mem1, &mem2};
  *  ChainingBlockDevice chainmem(bds);
  *  @endcode
+ *
+ *  Given a stripe size, the block devices are striped instead: consecutive
+ *  stripes go to consecutive block devices, and the parts of a read, program
+ *  or erase on different block devices are started together through their
+ *  asynchronous interface. Wrap each block device in an AsyncBlockDevice
+ *  for them to run at the same time:
+ *
+ *  @code
+ *  AsyncBlockDevice flash1(&spif1);
+ *  AsyncBlockDevice flash2(&spif2);
+ *  BlockDevice *bds[] = {&flash1, &flash2};
+ *  ChainingBlockDevice striped(bds, 2, 256);
+ *  @endcode
+ *
+ *  A striped block device has the size of its smallest block device times the
+ *  number of block devices, and erase blocks made of one erase block of each.
  */
 class ChainingBlockDevice : public BlockDevice {
 public:
@@ -57,9 +77,12 @@ public:
      *
      *  @param bds         Array of block devices to chain with sequential block addresses
      *  @param bd_count    Number of block devices to chain
+     *  @param stripe_size Size of the stripes to interleave across the block devices,
+     *                     a multiple of their program size dividing their erase size,
+     *                     or 0 to chain them one after the other
      *  @note All block devices must have the same block size
      */
-    ChainingBlockDevice(BlockDevice **bds, size_t bd_count);
+    ChainingBlockDevice(BlockDevice **bds, size_t bd_count, bd_size_t stripe_size = 0);
 
     /** Lifetime of the memory block device
      *
@@ -69,7 +92,13 @@ public:
     template <size_t Size>
     ChainingBlockDevice(BlockDevice * (&bds)[Size])
         : _bds(bds), _bd_count(sizeof(bds) / sizeof(bds[0]))
-        , _read_size(0), _program_size(0), _erase_size(0), _size(0),  _init_ref_count(0)
+        , _read_size(0), _program_size(0), _erase_size(0), _size(0)
+        , _erase_value(-1), _init_ref_count(0), _is_initialized(false)
+        , _stripe_size(0)
+#if !MBED_CONF_RTOS_PRESENT
+        , _stripe_done(0)
+#endif
+        , _stripe_error(0)
     {
     }
 
@@ -179,6 +208,16 @@ public:
     virtual const char *get_type() const;
 
 protected:
+    enum stripe_op {
+        STRIPE_READ,
+        STRIPE_PROGRAM
+    };
+
+    int striped_transfer(stripe_op op, uint8_t *buffer, bd_addr_t addr, bd_size_t size);
+    int striped_erase(bd_addr_t addr, bd_size_t size);
+    void stripe_wait(uint32_t started);
+    void stripe_done(int err);
+
     BlockDevice **_bds;
     size_t _bd_count;
     bd_size_t _read_size;
@@ -188,6 +227,14 @@ protected:
     int _erase_value;
     uint32_t _init_ref_count;
     bool _is_initialized;
+    bd_size_t _stripe_size;
+    PlatformMutex _stripe_mutex;
+#if MBED_CONF_RTOS_PRESENT
+    rtos::Semaphore _stripe_done;
+#else
+    volatile uint32_t _stripe_done;
+#endif
+    volatile int _stripe_error;
 };
 
 } // namespace mbed
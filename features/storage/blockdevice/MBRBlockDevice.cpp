@@ -409,6 +409,15 @@ int MBRBlockDevice::get_erase_value() const
     return _bd->get_erase_value();
 }
 
+const void *MBRBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return NULL;
+    }
+
+    return _bd->get_mapped_address(addr + _offset, size);
+}
+
 bd_size_t MBRBlockDevice::size() const
 {
     return _size;
@@ -16,20 +16,63 @@
 
 #include "ProfilingBlockDevice.h"
 #include "stddef.h"
+#include <stdio.h>
+#include <string.h>
+#if DEVICE_USTICKER
+#include "hal/us_ticker_api.h"
+#endif
 
 namespace mbed {
 
-ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd)
+static const char *const operation_names[] = {
+    "read",
+    "program",
+    "erase",
+};
+
+ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd, uint32_t trace_depth, bool wear_map)
     : _bd(bd)
     , _read_count(0)
     , _program_count(0)
     , _erase_count(0)
+    , _trace_depth(trace_depth)
+    , _trace(NULL)
+    , _trace_next(0)
+    , _trace_used(0)
+    , _wear_map_enabled(wear_map)
+    , _wear_map(NULL)
+    , _wear_block_size(0)
+    , _wear_block_count(0)
+{
+    memset(_stats, 0, sizeof(_stats));
+    if (_trace_depth) {
+        _trace = new trace_entry_t[_trace_depth];
+    }
+}
+
+ProfilingBlockDevice::~ProfilingBlockDevice()
 {
+    delete[] _trace;
+    delete[] _wear_map;
 }
 
 int ProfilingBlockDevice::init()
 {
-    return _bd->init();
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    // The wear map needs the geometry of the underlying device
+    if (_wear_map_enabled && !_wear_map) {
+        _wear_block_size = _bd->get_erase_size();
+        if (_wear_block_size) {
+            _wear_block_count = _bd->size() / _wear_block_size;
+            _wear_map = new uint32_t[_wear_block_count];
+            memset(_wear_map, 0, _wear_block_count * sizeof(uint32_t));
+        }
+    }
+    return 0;
 }
 
 int ProfilingBlockDevice::deinit()
@@ -37,6 +80,50 @@ int ProfilingBlockDevice::deinit()
     return _bd->deinit();
 }
 
+uint32_t ProfilingBlockDevice::now_us() const
+{
+#if DEVICE_USTICKER
+    return ticker_read_us(get_us_ticker_data());
+#else
+    return 0;
+#endif
+}
+
+void ProfilingBlockDevice::record(operation_t op, uint32_t start, bd_addr_t addr, bd_size_t size, int err)
+{
+    uint32_t duration = now_us() - start;
+    operation_stats_t *stats = &_stats[op];
+
+    stats->count += 1;
+    if (err) {
+        stats->errors += 1;
+    }
+    stats->total_us += duration;
+    if (duration > stats->max_us) {
+        stats->max_us = duration;
+    }
+
+    int bucket = 0;
+    while (bucket < HISTOGRAM_BUCKETS - 1 && (duration >> bucket)) {
+        bucket++;
+    }
+    stats->histogram[bucket] += 1;
+
+    if (_trace) {
+        trace_entry_t *entry = &_trace[_trace_next];
+        entry->start_us = start;
+        entry->duration_us = duration;
+        entry->addr = addr;
+        entry->size = size;
+        entry->op = op;
+        entry->err = err;
+        _trace_next = (_trace_next + 1) % _trace_depth;
+        if (_trace_used < _trace_depth) {
+            _trace_used++;
+        }
+    }
+}
+
 int ProfilingBlockDevice::sync()
 {
     return _bd->sync();
@@ -44,7 +131,9 @@ int ProfilingBlockDevice::sync()
 
 int ProfilingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
+    uint32_t start = now_us();
     int err = _bd->read(b, addr, size);
+    record(OPERATION_READ, start, addr, size, err);
     if (!err) {
         _read_count += size;
     }
@@ -53,7 +142,9 @@ int ProfilingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 
 int ProfilingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
+    uint32_t start = now_us();
     int err = _bd->program(b, addr, size);
+    record(OPERATION_PROGRAM, start, addr, size, err);
     if (!err) {
         _program_count += size;
     }
@@ -62,9 +153,16 @@ int ProfilingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
 int ProfilingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
+    uint32_t start = now_us();
     int err = _bd->erase(addr, size);
+    record(OPERATION_ERASE, start, addr, size, err);
     if (!err) {
         _erase_count += size;
+        if (_wear_map) {
+            for (bd_addr_t a = addr; a < addr + size && a / _wear_block_size < _wear_block_count; a += _wear_block_size) {
+                _wear_map[a / _wear_block_size] += 1;
+            }
+        }
     }
     return err;
 }
@@ -104,6 +202,12 @@ void ProfilingBlockDevice::reset()
     _read_count = 0;
     _program_count = 0;
     _erase_count = 0;
+    memset(_stats, 0, sizeof(_stats));
+    _trace_next = 0;
+    _trace_used = 0;
+    if (_wear_map) {
+        memset(_wear_map, 0, _wear_block_count * sizeof(uint32_t));
+    }
 }
 
 bd_size_t ProfilingBlockDevice::get_read_count() const
@@ -121,6 +225,79 @@ bd_size_t ProfilingBlockDevice::get_erase_count() const
     return _erase_count;
 }
 
+const ProfilingBlockDevice::operation_stats_t &ProfilingBlockDevice::get_stats(operation_t op) const
+{
+    return _stats[op];
+}
+
+uint32_t ProfilingBlockDevice::get_block_erase_count(bd_addr_t addr) const
+{
+    if (!_wear_map || addr / _wear_block_size >= _wear_block_count) {
+        return 0;
+    }
+
+    return _wear_map[addr / _wear_block_size];
+}
+
+uint32_t ProfilingBlockDevice::get_trace(trace_entry_t *entries, uint32_t count) const
+{
+    if (count > _trace_used) {
+        count = _trace_used;
+    }
+    if (!count) {
+        return 0;
+    }
+
+    // Skip the oldest entries that don't fit
+    uint32_t index = (_trace_next + _trace_depth - count) % _trace_depth;
+    for (uint32_t i = 0; i < count; i++) {
+        entries[i] = _trace[index];
+        index = (index + 1) % _trace_depth;
+    }
+    return count;
+}
+
+void ProfilingBlockDevice::dump() const
+{
+    printf("read: %llu bytes, program: %llu bytes, erase: %llu bytes\n",
+           (unsigned long long)_read_count, (unsigned long long)_program_count,
+           (unsigned long long)_erase_count);
+
+    for (int op = 0; op < OPERATION_COUNT; op++) {
+        const operation_stats_t *stats = &_stats[op];
+        printf("%s: %lu ops, %lu errors, avg %lu us, max %lu us\n", operation_names[op],
+               (unsigned long)stats->count, (unsigned long)stats->errors,
+               (unsigned long)(stats->count ? stats->total_us / stats->count : 0),
+               (unsigned long)stats->max_us);
+        for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+            if (stats->histogram[bucket]) {
+                printf("  < %lu us: %lu\n", 1UL << bucket, (unsigned long)stats->histogram[bucket]);
+            }
+        }
+    }
+
+    if (_wear_map) {
+        printf("erases per block of %llu bytes:\n", (unsigned long long)_wear_block_size);
+        for (uint32_t i = 0; i < _wear_block_count; i++) {
+            if (_wear_map[i]) {
+                printf("  0x%llx: %lu\n", (unsigned long long)(i * _wear_block_size), (unsigned long)_wear_map[i]);
+            }
+        }
+    }
+
+    if (_trace_used) {
+        printf("last %lu operations:\n", (unsigned long)_trace_used);
+        uint32_t index = (_trace_next + _trace_depth - _trace_used) % _trace_depth;
+        for (uint32_t i = 0; i < _trace_used; i++) {
+            const trace_entry_t *entry = &_trace[index];
+            printf("  %10lu %-7s 0x%llx %lu bytes: %lu us, err %d\n",
+                   (unsigned long)entry->start_us, operation_names[entry->op], (unsigned long long)entry->addr,
+                   (unsigned long)entry->size, (unsigned long)entry->duration_us, entry->err);
+            index = (index + 1) % _trace_depth;
+        }
+    }
+}
+
 const char *ProfilingBlockDevice::get_type() const
 {
     if (_bd != NULL) {
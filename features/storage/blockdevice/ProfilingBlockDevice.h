@@ -32,18 +32,60 @@ namespace mbed {
 
 
 /** Block device for measuring storage operations of another block device
+ *
+ *  Besides byte counts, the latency of each read, program and erase is
+ *  recorded in a histogram per operation. Optionally, erase counts per erase
+ *  block and a trace of the most recent operations are kept as well.
+ *  Latencies need a microsecond ticker (DEVICE_USTICKER) and read as 0 otherwise.
  */
 class ProfilingBlockDevice : public BlockDevice {
 public:
+    /** Number of latency histogram buckets, bucket n counts operations
+     *  that took less than 2^n microseconds and not less than 2^(n-1)
+     */
+    static const int HISTOGRAM_BUCKETS = 24;
+
+    /** Profiled operations
+     */
+    enum operation_t {
+        OPERATION_READ,
+        OPERATION_PROGRAM,
+        OPERATION_ERASE,
+        OPERATION_COUNT
+    };
+
+    /** Timing statistics of one operation
+     */
+    struct operation_stats_t {
+        uint32_t count;                         /**< Number of operations */
+        uint32_t errors;                        /**< Number of failed operations */
+        uint64_t total_us;                      /**< Sum of all latencies */
+        uint32_t max_us;                        /**< Longest latency */
+        uint32_t histogram[HISTOGRAM_BUCKETS];  /**< Latency histogram, last bucket includes longer latencies */
+    };
+
+    /** Entry in the trace of recent operations
+     */
+    struct trace_entry_t {
+        uint32_t start_us;      /**< Microsecond ticker when the operation started */
+        uint32_t duration_us;   /**< Latency of the operation */
+        bd_addr_t addr;         /**< Address of the operation */
+        uint32_t size;          /**< Size of the operation */
+        uint8_t op;             /**< The operation_t */
+        int err;                /**< Result of the operation */
+    };
+
     /** Lifetime of the memory block device
      *
-     *  @param bd       Block device to back the ProfilingBlockDevice
+     *  @param bd           Block device to back the ProfilingBlockDevice
+     *  @param trace_depth  Number of recent operations to keep in the trace, 0 to disable tracing
+     *  @param wear_map     Count erases of each erase block, allocated on init
      */
-    ProfilingBlockDevice(BlockDevice *bd);
+    ProfilingBlockDevice(BlockDevice *bd, uint32_t trace_depth = 0, bool wear_map = false);
 
     /** Lifetime of a block device
      */
-    virtual ~ProfilingBlockDevice() {};
+    virtual ~ProfilingBlockDevice();
 
     /** Initialize a block device
      *
@@ -163,6 +205,32 @@ public:
      */
     bd_size_t get_erase_count() const;
 
+    /** Get the timing statistics of an operation
+     *
+     *  @param op       Operation to get statistics of
+     *  @return         Statistics since the last reset
+     */
+    const operation_stats_t &get_stats(operation_t op) const;
+
+    /** Get the number of times an erase block was erased
+     *
+     *  @param addr     Address within the erase block
+     *  @return         Number of erases since the last reset, 0 without a wear map
+     */
+    uint32_t get_block_erase_count(bd_addr_t addr) const;
+
+    /** Copy the most recent operations out of the trace
+     *
+     *  @param entries  Array to copy entries to, oldest first
+     *  @param count    Maximum number of entries to copy
+     *  @return         Number of entries copied
+     */
+    uint32_t get_trace(trace_entry_t *entries, uint32_t count) const;
+
+    /** Print the profile counts, timing statistics, wear map and trace with printf
+     */
+    void dump() const;
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
@@ -170,10 +238,24 @@ public:
     virtual const char *get_type() const;
 
 private:
+    uint32_t now_us() const;
+    void record(operation_t op, uint32_t start, bd_addr_t addr, bd_size_t size, int err);
+
     BlockDevice *_bd;
     bd_size_t _read_count;
     bd_size_t _program_count;
     bd_size_t _erase_count;
+    operation_stats_t _stats[OPERATION_COUNT];
+
+    const uint32_t _trace_depth;
+    trace_entry_t *_trace;
+    uint32_t _trace_next;
+    uint32_t _trace_used;
+
+    const bool _wear_map_enabled;
+    uint32_t *_wear_map;
+    bd_size_t _wear_block_size;
+    uint32_t _wear_block_count;
 };
 
 } // namespace mbed
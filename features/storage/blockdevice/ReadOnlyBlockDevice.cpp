@@ -96,6 +96,11 @@ int ReadOnlyBlockDevice::get_erase_value() const
     return _bd->get_erase_value();
 }
 
+const void *ReadOnlyBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size)
+{
+    return _bd->get_mapped_address(addr, size);
+}
+
 bd_size_t ReadOnlyBlockDevice::size() const
 {
     return _bd->size();
@@ -127,6 +127,14 @@ public:
      */
     virtual int get_erase_value() const;
 
+    /** Get a pointer through which a region can be read in place
+     *
+     *  @param addr     Address of the region
+     *  @param size     Size of the region in bytes
+     *  @return         Pointer to the region, or NULL if it can't be read in place
+     */
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size);
+
     /** Get the total size of the underlying device
      *
      *  @return         Size of the underlying device in bytes
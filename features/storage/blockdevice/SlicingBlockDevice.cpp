@@ -140,6 +140,11 @@ int SlicingBlockDevice::get_erase_value() const
     return _bd->get_erase_value();
 }
 
+const void *SlicingBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size)
+{
+    return _bd->get_mapped_address(addr + _start, size);
+}
+
 bd_size_t SlicingBlockDevice::size() const
 {
     return _stop - _start;
@@ -0,0 +1,770 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WearLevelingBlockDevice.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "MbedCRC.h"
+#include <algorithm>
+#include <stddef.h>
+#include <string.h>
+
+namespace mbed {
+
+// Each erase block starts with a header holding its erase count, followed by
+// a bad block marker (left erased on good blocks) and then by slots of one
+// logical page plus a tag identifying it. Header, marker and tag are each
+// padded to the read/program unit of the underlying device.
+// The header also holds the sequence number at the time the block was erased.
+// Tags with an older sequence number are left over from before the erase, on
+// devices where erasing does not clear the content.
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t page_size;
+    uint32_t erase_count;
+    uint32_t seq;
+    uint32_t crc;
+} wl_block_header_t;
+
+typedef struct {
+    uint32_t lba;
+    uint32_t seq;
+    uint32_t crc;
+} wl_page_tag_t;
+
+static const uint32_t header_magic = 0x4C574C46; // "FLWL"
+static const uint32_t bad_magic = 0x4B424C57;    // "WLBK"
+static const uint16_t header_version = 1;
+
+static const uint32_t no_block = 0xFFFFFFFF;
+static const uint32_t unmapped = 0xFFFFFFFF;
+
+enum {
+    BLOCK_DIRTY = 0,   // Content unknown, erase before use
+    BLOCK_CLEAN,       // Erased with a valid header, no slots used
+    BLOCK_ACTIVE,      // Open for appending pages
+    BLOCK_USED,        // Closed, reclaimed by garbage collection
+    BLOCK_BAD,         // Retired, may still hold live pages until relocated
+};
+
+static inline bd_size_t align_up(bd_size_t val, bd_size_t size)
+{
+    return (((val - 1) / size) + 1) * size;
+}
+
+static uint32_t calc_crc(const void *data_buf, uint32_t data_size)
+{
+    uint32_t crc;
+    MbedCRC<POLY_32BIT_ANSI, 32> ct(0xFFFFFFFF, 0x0, true, false);
+    ct.compute(const_cast<void *>(data_buf), data_size, &crc);
+    return crc;
+}
+
+WearLevelingBlockDevice::WearLevelingBlockDevice(BlockDevice *bd, bd_size_t page_size,
+                                                 uint32_t reserved_blocks, uint32_t wear_threshold) :
+    _bd(bd), _page_size(page_size), _reserved_blocks(reserved_blocks), _wear_threshold(wear_threshold),
+    _block_size(0), _hdr_size(0), _tag_size(0), _num_blocks(0), _pages_per_block(0), _logical_pages(0),
+    _seq(0), _active(no_block), _in_gc(false), _map(0), _blocks(0), _page_buf(0), _unit_buf(0),
+    _init_ref_count(0), _is_initialized(false)
+{
+    MBED_ASSERT(reserved_blocks >= 2);
+}
+
+WearLevelingBlockDevice::~WearLevelingBlockDevice()
+{
+    deinit();
+}
+
+int WearLevelingBlockDevice::init()
+{
+    int err;
+    bd_size_t unit;
+    bd_size_t slot_size;
+    uint32_t known = 0;
+    uint64_t total_erases = 0;
+    uint32_t val = core_util_atomic_incr_u32(&_init_ref_count, 1);
+
+    if (val != 1) {
+        return BD_ERROR_OK;
+    }
+
+    err = _bd->init();
+    if (err) {
+        goto fail;
+    }
+
+    _mutex.lock();
+
+    unit = std::max(_bd->get_read_size(), _bd->get_program_size());
+    _block_size = _bd->get_erase_size();
+    if ((unit % _bd->get_read_size()) || (unit % _bd->get_program_size()) ||
+            (_page_size % unit) || (_bd->size() % _block_size)) {
+        err = BD_ERROR_WL_INVALID_GEOMETRY;
+        goto fail_locked;
+    }
+
+    _hdr_size = align_up(sizeof(wl_block_header_t), unit);
+    _tag_size = align_up(sizeof(wl_page_tag_t), unit);
+    slot_size = _page_size + _tag_size;
+    _num_blocks = _bd->size() / _block_size;
+    _pages_per_block = (_block_size > 2 * _hdr_size) ? (_block_size - 2 * _hdr_size) / slot_size : 0;
+    if ((_pages_per_block < 2) || (_pages_per_block > 0xFFFF) || (_num_blocks <= _reserved_blocks)) {
+        err = BD_ERROR_WL_INVALID_GEOMETRY;
+        goto fail_locked;
+    }
+    _logical_pages = (_num_blocks - _reserved_blocks) * _pages_per_block;
+
+    _map = new uint32_t[_logical_pages];
+    _blocks = new block_info_t[_num_blocks];
+    _page_buf = new uint8_t[_page_size];
+    _unit_buf = new uint8_t[std::max(_hdr_size, _tag_size)];
+    memset(_map, 0xFF, _logical_pages * sizeof(uint32_t));
+    memset(_blocks, 0, _num_blocks * sizeof(block_info_t));
+    _seq = 0;
+    _active = no_block;
+    _in_gc = false;
+
+    for (uint32_t block = 0; block < _num_blocks; block++) {
+        err = _scan_block(block);
+        if (err) {
+            goto fail_locked;
+        }
+        if (_blocks[block].state != BLOCK_DIRTY) {
+            total_erases += _blocks[block].erase_count;
+            known++;
+        }
+    }
+
+    // Blocks without a valid header have lost their erase count, assume
+    // they are worn like an average block
+    for (uint32_t block = 0; block < _num_blocks; block++) {
+        if (_blocks[block].state == BLOCK_DIRTY) {
+            _blocks[block].erase_count = known ? (uint32_t)(total_erases / known) : 0;
+        }
+    }
+
+    // Closed blocks without live pages, including every erased block when the
+    // erase value is unknown, are free. They are erased again before use.
+    for (uint32_t block = 0; block < _num_blocks; block++) {
+        if ((_blocks[block].state == BLOCK_USED) && !_blocks[block].valid_pages) {
+            _blocks[block].state = BLOCK_DIRTY;
+        }
+    }
+
+    _is_initialized = true;
+    _mutex.unlock();
+    return BD_ERROR_OK;
+
+fail_locked:
+    delete[] _map;
+    delete[] _blocks;
+    delete[] _page_buf;
+    delete[] _unit_buf;
+    _map = 0;
+    _blocks = 0;
+    _page_buf = 0;
+    _unit_buf = 0;
+    _mutex.unlock();
+    _bd->deinit();
+fail:
+    _is_initialized = false;
+    _init_ref_count = 0;
+    return err;
+}
+
+int WearLevelingBlockDevice::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    uint32_t val = core_util_atomic_decr_u32(&_init_ref_count, 1);
+
+    if (val) {
+        return BD_ERROR_OK;
+    }
+
+    _mutex.lock();
+    delete[] _map;
+    delete[] _blocks;
+    delete[] _page_buf;
+    delete[] _unit_buf;
+    _map = 0;
+    _blocks = 0;
+    _page_buf = 0;
+    _unit_buf = 0;
+    _is_initialized = false;
+    _mutex.unlock();
+
+    return _bd->deinit();
+}
+
+int WearLevelingBlockDevice::sync()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->sync();
+}
+
+bd_addr_t WearLevelingBlockDevice::_block_addr(uint32_t block) const
+{
+    return (bd_addr_t) block * _block_size;
+}
+
+bd_addr_t WearLevelingBlockDevice::_data_addr(uint32_t phys) const
+{
+    uint32_t block = phys / _pages_per_block;
+    uint32_t slot = phys % _pages_per_block;
+    return _block_addr(block) + 2 * _hdr_size + slot * (_page_size + _tag_size);
+}
+
+bd_addr_t WearLevelingBlockDevice::_tag_addr(uint32_t phys) const
+{
+    return _data_addr(phys) + _page_size;
+}
+
+bool WearLevelingBlockDevice::_is_blank(const uint8_t *buf, bd_size_t size) const
+{
+    int erase_value = _bd->get_erase_value();
+    if (erase_value < 0) {
+        return false;
+    }
+
+    for (bd_size_t i = 0; i < size; i++) {
+        if (buf[i] != (uint8_t) erase_value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int WearLevelingBlockDevice::_read_tag(uint32_t phys, uint32_t *lba, uint32_t *seq)
+{
+    wl_page_tag_t tag;
+
+    int err = _bd->read(_unit_buf, _tag_addr(phys), _tag_size);
+    if (err) {
+        return err;
+    }
+
+    memcpy(&tag, _unit_buf, sizeof(tag));
+    if ((tag.crc != calc_crc(&tag, offsetof(wl_page_tag_t, crc))) || (tag.lba >= _logical_pages)) {
+        *lba = unmapped;
+        return BD_ERROR_OK;
+    }
+
+    *lba = tag.lba;
+    *seq = tag.seq;
+    return BD_ERROR_OK;
+}
+
+int WearLevelingBlockDevice::_scan_block(uint32_t block)
+{
+    wl_block_header_t header;
+    block_info_t &info = _blocks[block];
+    uint32_t first_seq;
+    int err;
+
+    err = _bd->read(_unit_buf, _block_addr(block), _hdr_size);
+    if (err) {
+        return err;
+    }
+
+    memcpy(&header, _unit_buf, sizeof(header));
+    if ((header.magic != header_magic) || (header.version != header_version) ||
+            (header.page_size != _page_size) ||
+            (header.crc != calc_crc(&header, offsetof(wl_block_header_t, crc)))) {
+        info.state = BLOCK_DIRTY;
+        return BD_ERROR_OK;
+    }
+    info.erase_count = header.erase_count;
+    info.state = BLOCK_CLEAN;
+    first_seq = header.seq;
+    if (first_seq > _seq) {
+        _seq = first_seq;
+    }
+
+    err = _bd->read(_unit_buf, _block_addr(block) + _hdr_size, _hdr_size);
+    if (err) {
+        return err;
+    }
+    memcpy(&header, _unit_buf, sizeof(header));
+    if ((header.magic == bad_magic) && (header.crc == calc_crc(&header, offsetof(wl_block_header_t, crc)))) {
+        info.state = BLOCK_BAD;
+    }
+
+    for (uint32_t slot = 0; slot < _pages_per_block; slot++) {
+        uint32_t phys = block * _pages_per_block + slot;
+        uint32_t lba, seq;
+
+        err = _read_tag(phys, &lba, &seq);
+        if (err) {
+            return err;
+        }
+        if ((lba != unmapped) && (seq < first_seq)) {
+            lba = unmapped;
+        }
+
+        if (lba == unmapped) {
+            if (!_is_blank(_unit_buf, _tag_size)) {
+                info.next_slot = slot + 1;
+            }
+            continue;
+        }
+        info.next_slot = slot + 1;
+
+        if (_map[lba] != unmapped) {
+            uint32_t old = _map[lba];
+            uint32_t old_lba, old_seq;
+            err = _read_tag(old, &old_lba, &old_seq);
+            if (err) {
+                return err;
+            }
+            if (seq < old_seq) {
+                continue;
+            }
+            _blocks[old / _pages_per_block].valid_pages--;
+        }
+        _map[lba] = phys;
+        info.valid_pages++;
+        if (seq >= _seq) {
+            _seq = seq + 1;
+        }
+    }
+
+    // Partially written blocks are not resumed, garbage collection reclaims
+    // them. Without a known erase value every block with a header is treated
+    // as written.
+    if ((info.state == BLOCK_CLEAN) && (info.next_slot || (_bd->get_erase_value() < 0))) {
+        info.state = BLOCK_USED;
+        info.next_slot = _pages_per_block;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int WearLevelingBlockDevice::_write_header(uint32_t block, uint32_t magic)
+{
+    wl_block_header_t header;
+    bd_addr_t addr = _block_addr(block);
+
+    header.magic = magic;
+    header.version = header_version;
+    header.reserved = 0;
+    header.page_size = _page_size;
+    header.erase_count = _blocks[block].erase_count;
+    header.seq = _seq;
+    header.crc = calc_crc(&header, offsetof(wl_block_header_t, crc));
+
+    if (magic == bad_magic) {
+        addr += _hdr_size;
+    }
+
+    memset(_unit_buf, _bd->get_erase_value() < 0 ? 0xFF : _bd->get_erase_value(), _hdr_size);
+    memcpy(_unit_buf, &header, sizeof(header));
+    return _bd->program(_unit_buf, addr, _hdr_size);
+}
+
+void WearLevelingBlockDevice::_mark_bad(uint32_t block)
+{
+    _blocks[block].state = BLOCK_BAD;
+    if (_active == block) {
+        _active = no_block;
+    }
+
+    // Best effort, a block that cannot hold the marker shows up as dirty
+    // on the next init and fails again when it is reused
+    _write_header(block, bad_magic);
+}
+
+int WearLevelingBlockDevice::_erase_block(uint32_t block)
+{
+    block_info_t &info = _blocks[block];
+
+    int err = _bd->erase(_block_addr(block), _block_size);
+    if (!err) {
+        info.erase_count++;
+        err = _write_header(block, header_magic);
+    }
+    if (err) {
+        _mark_bad(block);
+        return err;
+    }
+
+    info.state = BLOCK_CLEAN;
+    info.valid_pages = 0;
+    info.next_slot = 0;
+    return BD_ERROR_OK;
+}
+
+uint32_t WearLevelingBlockDevice::_free_blocks() const
+{
+    uint32_t count = 0;
+    for (uint32_t block = 0; block < _num_blocks; block++) {
+        if ((_blocks[block].state == BLOCK_CLEAN) || (_blocks[block].state == BLOCK_DIRTY)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int WearLevelingBlockDevice::_open_block()
+{
+    // Dynamic wear leveling, always open the least worn free block
+    while (true) {
+        uint32_t best = no_block;
+        for (uint32_t block = 0; block < _num_blocks; block++) {
+            uint8_t state = _blocks[block].state;
+            if (((state == BLOCK_CLEAN) || (state == BLOCK_DIRTY)) &&
+                    ((best == no_block) || (_blocks[block].erase_count < _blocks[best].erase_count))) {
+                best = block;
+            }
+        }
+
+        if (best == no_block) {
+            return BD_ERROR_WL_NO_SPACE;
+        }
+
+        if ((_blocks[best].state == BLOCK_DIRTY) && _erase_block(best)) {
+            continue;
+        }
+
+        _blocks[best].state = BLOCK_ACTIVE;
+        _active = best;
+        return BD_ERROR_OK;
+    }
+}
+
+int WearLevelingBlockDevice::_ensure_active()
+{
+    if ((_active != no_block) && (_blocks[_active].next_slot < _pages_per_block)) {
+        return BD_ERROR_OK;
+    }
+    _close_active();
+
+    if (!_in_gc) {
+        _in_gc = true;
+        int err = _reclaim();
+        _in_gc = false;
+        if (err) {
+            return err;
+        }
+
+        // Relocation may have opened a block with room to spare
+        if ((_active != no_block) && (_blocks[_active].next_slot < _pages_per_block)) {
+            return BD_ERROR_OK;
+        }
+        _close_active();
+    }
+
+    return _open_block();
+}
+
+void WearLevelingBlockDevice::_close_active()
+{
+    if (_active != no_block) {
+        _blocks[_active].state = BLOCK_USED;
+        _active = no_block;
+    }
+}
+
+int WearLevelingBlockDevice::_reclaim()
+{
+    int err;
+
+    // Keep one free block in reserve so relocation always has somewhere to go
+    for (uint32_t i = 0; (i < _num_blocks) && (_free_blocks() < 2); i++) {
+        uint32_t victim = no_block;
+        for (uint32_t block = 0; block < _num_blocks; block++) {
+            const block_info_t &info = _blocks[block];
+            if ((info.state == BLOCK_BAD) && info.valid_pages) {
+                victim = block;
+                break;
+            }
+            if ((info.state == BLOCK_USED) &&
+                    ((victim == no_block) || (info.valid_pages < _blocks[victim].valid_pages))) {
+                victim = block;
+            }
+        }
+
+        if ((victim == no_block) || (_blocks[victim].valid_pages == _pages_per_block)) {
+            break;
+        }
+
+        err = _relocate(victim);
+        if (err) {
+            return err;
+        }
+    }
+
+    if (_free_blocks() < 2) {
+        return BD_ERROR_OK;
+    }
+
+    // Static wear leveling, move cold data off the least worn block once
+    // the spread grows too large so that the block returns to circulation
+    uint32_t min_erases = 0xFFFFFFFF;
+    uint32_t max_erases = 0;
+    uint32_t coldest = no_block;
+    for (uint32_t block = 0; block < _num_blocks; block++) {
+        const block_info_t &info = _blocks[block];
+        if (info.state == BLOCK_BAD) {
+            continue;
+        }
+        min_erases = std::min(min_erases, info.erase_count);
+        max_erases = std::max(max_erases, info.erase_count);
+        if ((info.state == BLOCK_USED) &&
+                ((coldest == no_block) || (info.erase_count < _blocks[coldest].erase_count))) {
+            coldest = block;
+        }
+    }
+
+    if ((coldest != no_block) && (max_erases - _blocks[coldest].erase_count > _wear_threshold)) {
+        return _relocate(coldest);
+    }
+
+    return BD_ERROR_OK;
+}
+
+int WearLevelingBlockDevice::_relocate(uint32_t block)
+{
+    int err;
+
+    for (uint32_t slot = 0; slot < _pages_per_block && _blocks[block].valid_pages; slot++) {
+        uint32_t phys = block * _pages_per_block + slot;
+        uint32_t lba, seq;
+
+        err = _read_tag(phys, &lba, &seq);
+        if (err) {
+            return err;
+        }
+        if ((lba == unmapped) || (_map[lba] != phys)) {
+            continue;
+        }
+
+        err = _bd->read(_page_buf, _data_addr(phys), _page_size);
+        if (err) {
+            return err;
+        }
+        err = _write_page(lba, _page_buf);
+        if (err) {
+            return err;
+        }
+    }
+
+    if (_blocks[block].state == BLOCK_BAD) {
+        return BD_ERROR_OK;
+    }
+
+    // A failed erase retires the block, which is not an error for the caller
+    _erase_block(block);
+    return BD_ERROR_OK;
+}
+
+int WearLevelingBlockDevice::_write_page(uint32_t lba, const uint8_t *data)
+{
+    wl_page_tag_t tag;
+    int err;
+
+    for (uint32_t attempt = 0; attempt < _num_blocks; attempt++) {
+        err = _ensure_active();
+        if (err) {
+            return err;
+        }
+
+        // The slot is consumed even if programming fails half way
+        uint32_t phys = _active * _pages_per_block + _blocks[_active].next_slot++;
+
+        tag.lba = lba;
+        tag.seq = _seq;
+        tag.crc = calc_crc(&tag, offsetof(wl_page_tag_t, crc));
+        memset(_unit_buf, _bd->get_erase_value() < 0 ? 0xFF : _bd->get_erase_value(), _tag_size);
+        memcpy(_unit_buf, &tag, sizeof(tag));
+
+        // The tag goes last so a torn write never looks valid
+        err = _bd->program(data, _data_addr(phys), _page_size);
+        if (!err) {
+            err = _bd->program(_unit_buf, _tag_addr(phys), _tag_size);
+        }
+        if (err) {
+            _mark_bad(_active);
+            continue;
+        }
+
+        _seq++;
+        _unmap(lba);
+        _map[lba] = phys;
+        _blocks[phys / _pages_per_block].valid_pages++;
+        return BD_ERROR_OK;
+    }
+
+    return BD_ERROR_WL_NO_SPACE;
+}
+
+void WearLevelingBlockDevice::_unmap(uint32_t lba)
+{
+    if (_map[lba] != unmapped) {
+        _blocks[_map[lba] / _pages_per_block].valid_pages--;
+        _map[lba] = unmapped;
+    }
+}
+
+int WearLevelingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_read(addr, size));
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    uint8_t *buf = static_cast<uint8_t *>(b);
+    uint32_t lba = addr / _page_size;
+    int err = BD_ERROR_OK;
+
+    _mutex.lock();
+    for (bd_size_t done = 0; done < size; done += _page_size, lba++) {
+        if (_map[lba] == unmapped) {
+            memset(buf + done, 0xFF, _page_size);
+            continue;
+        }
+        err = _bd->read(buf + done, _data_addr(_map[lba]), _page_size);
+        if (err) {
+            break;
+        }
+    }
+    _mutex.unlock();
+
+    return err;
+}
+
+int WearLevelingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_program(addr, size));
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    const uint8_t *buf = static_cast<const uint8_t *>(b);
+    uint32_t lba = addr / _page_size;
+    int err = BD_ERROR_OK;
+
+    _mutex.lock();
+    for (bd_size_t done = 0; done < size; done += _page_size, lba++) {
+        err = _write_page(lba, buf + done);
+        if (err) {
+            break;
+        }
+    }
+    _mutex.unlock();
+
+    return err;
+}
+
+int WearLevelingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+
+    return trim(addr, size);
+}
+
+int WearLevelingBlockDevice::trim(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    uint32_t lba = addr / _page_size;
+
+    _mutex.lock();
+    for (bd_size_t done = 0; done < size; done += _page_size, lba++) {
+        _unmap(lba);
+    }
+    _mutex.unlock();
+
+    return BD_ERROR_OK;
+}
+
+bd_size_t WearLevelingBlockDevice::get_read_size() const
+{
+    return _page_size;
+}
+
+bd_size_t WearLevelingBlockDevice::get_program_size() const
+{
+    return _page_size;
+}
+
+bd_size_t WearLevelingBlockDevice::get_erase_size() const
+{
+    return _page_size;
+}
+
+bd_size_t WearLevelingBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return _page_size;
+}
+
+int WearLevelingBlockDevice::get_erase_value() const
+{
+    return -1;
+}
+
+bd_size_t WearLevelingBlockDevice::size() const
+{
+    if (!_is_initialized) {
+        return 0;
+    }
+
+    return (bd_size_t) _logical_pages * _page_size;
+}
+
+const char *WearLevelingBlockDevice::get_type() const
+{
+    if (_bd != NULL) {
+        return _bd->get_type();
+    }
+
+    return NULL;
+}
+
+int WearLevelingBlockDevice::get_wear_stats(uint32_t *min_erases, uint32_t *max_erases, uint32_t *bad_blocks)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.lock();
+    *min_erases = 0xFFFFFFFF;
+    *max_erases = 0;
+    *bad_blocks = 0;
+    for (uint32_t block = 0; block < _num_blocks; block++) {
+        if (_blocks[block].state == BLOCK_BAD) {
+            (*bad_blocks)++;
+            continue;
+        }
+        *min_erases = std::min(*min_erases, _blocks[block].erase_count);
+        *max_erases = std::max(*max_erases, _blocks[block].erase_count);
+    }
+    _mutex.unlock();
+
+    return BD_ERROR_OK;
+}
+
+} // namespace mbed
@@ -0,0 +1,249 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_WEAR_LEVELING_BLOCK_DEVICE_H
+#define MBED_WEAR_LEVELING_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+#include "platform/PlatformMutex.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+enum {
+    BD_ERROR_WL_NO_SPACE         = -3301,
+    BD_ERROR_WL_INVALID_GEOMETRY = -3302,
+};
+
+/** Wear leveling block device
+ *
+ *  Flash translation layer for consumers that are not wear aware, such as
+ *  FATFileSystem. Logical pages are never rewritten in place: every program
+ *  appends the page to the currently open erase block together with a small
+ *  tag (logical page number and sequence number), and a mapping table in RAM
+ *  points each logical page at its latest copy. Erase blocks are reclaimed by
+ *  garbage collection, which picks the block with the fewest live pages, and
+ *  cold data is periodically moved off the least worn blocks so that erases
+ *  spread evenly over the whole device. Blocks that fail to erase or program
+ *  are marked bad and retired.
+ *
+ *  The mapping table is rebuilt from the tags on init. It costs 4 bytes of
+ *  RAM per logical page plus 12 bytes per erase block.
+ *
+ *  Erasing or trimming a region only drops its mapping; the contents of an
+ *  erased region are undefined (get_erase_value() returns -1) and data that
+ *  was erased but not overwritten may reappear after the next init.
+ *
+ *  @code
+ *  SPIFBlockDevice spif(...);
+ *  WearLevelingBlockDevice wl(&spif);
+ *  FATFileSystem fs("fs", &wl);
+ *  @endcode
+ */
+class WearLevelingBlockDevice : public BlockDevice, private NonCopyable<WearLevelingBlockDevice> {
+public:
+
+    /** Constructor
+     *
+     *  @param bd               Block device to back the WearLevelingBlockDevice
+     *  @param page_size        Size of a logical page in bytes, must be a multiple of
+     *                          the read and program sizes of the underlying device
+     *  @param reserved_blocks  Number of erase blocks kept out of the logical address
+     *                          space, used as garbage collection headroom and to replace
+     *                          bad blocks. Must be at least 2.
+     *  @param wear_threshold   Difference in erase counts between the most and least
+     *                          worn blocks that triggers moving cold data
+     */
+    WearLevelingBlockDevice(BlockDevice *bd, bd_size_t page_size = 512,
+                            uint32_t reserved_blocks = 4, uint32_t wear_threshold = 64);
+    virtual ~WearLevelingBlockDevice();
+
+    /** Initialize a block device
+     *
+     *  Scans the underlying device and rebuilds the mapping table
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize the block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from the block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to the block device
+     *
+     *  Logical pages do not need to be erased before being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on the block device
+     *
+     *  Drops the mapping of the erased pages, the same as trim
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Mark blocks as no longer in use
+     *
+     *  @param addr     Address of block to mark as unused
+     *  @param size     Size to mark as unused in bytes, must be a multiple of the erase block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the size of an erasable block given address
+     *
+     *  @param addr     Address within the erasable block
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+
+    /** Get the value of storage when erased
+     *
+     *  @return         -1, erased contents are undefined
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the logical address space
+     *
+     *  @return         Size of the logical address space in bytes
+     */
+    virtual bd_size_t size() const;
+
+    /** Get the BlockDevice class type.
+     *
+     *  @return         A string represent the BlockDevice class type.
+     */
+    virtual const char *get_type() const;
+
+    /** Get wear statistics of the underlying device
+     *
+     *  @param min_erases   Lowest erase count of a good block
+     *  @param max_erases   Highest erase count of a good block
+     *  @param bad_blocks   Number of blocks retired as bad
+     *  @return             0 on success or a negative error code on failure
+     */
+    int get_wear_stats(uint32_t *min_erases, uint32_t *max_erases, uint32_t *bad_blocks);
+
+private:
+    struct block_info_t {
+        uint32_t erase_count;
+        uint16_t valid_pages;
+        uint16_t next_slot;
+        uint8_t state;
+    };
+
+    bd_addr_t _block_addr(uint32_t block) const;
+    bd_addr_t _data_addr(uint32_t phys) const;
+    bd_addr_t _tag_addr(uint32_t phys) const;
+    int _read_tag(uint32_t phys, uint32_t *lba, uint32_t *seq);
+    bool _is_blank(const uint8_t *buf, bd_size_t size) const;
+    int _scan_block(uint32_t block);
+    int _write_header(uint32_t block, uint32_t magic);
+    void _mark_bad(uint32_t block);
+    int _erase_block(uint32_t block);
+    uint32_t _free_blocks() const;
+    int _open_block();
+    void _close_active();
+    int _ensure_active();
+    int _reclaim();
+    int _relocate(uint32_t block);
+    int _write_page(uint32_t lba, const uint8_t *data);
+    void _unmap(uint32_t lba);
+
+    BlockDevice *_bd;
+    bd_size_t _page_size;
+    uint32_t _reserved_blocks;
+    uint32_t _wear_threshold;
+
+    bd_size_t _block_size;
+    bd_size_t _hdr_size;
+    bd_size_t _tag_size;
+    uint32_t _num_blocks;
+    uint32_t _pages_per_block;
+    uint32_t _logical_pages;
+    uint32_t _seq;
+    uint32_t _active;
+    bool _in_gc;
+
+    uint32_t *_map;
+    block_info_t *_blocks;
+    uint8_t *_page_buf;
+    uint8_t *_unit_buf;
+
+    PlatformMutex _mutex;
+    uint32_t _init_ref_count;
+    bool _is_initialized;
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::WearLevelingBlockDevice;
+#endif
+
+#endif
+
+/** @}*/
@@ -69,6 +69,14 @@ ssize_t Dir::read(struct dirent *ent)
     return _fs->dir_read(_dir, ent);
 }
 
+ssize_t Dir::read(struct dirent *ent, struct stat *st)
+{
+    MBED_ASSERT(_fs);
+    memset(ent, 0, sizeof(struct dirent));
+    memset(st, 0, sizeof(struct stat));
+    return _fs->dir_read_stat(_dir, ent, st);
+}
+
 void Dir::seek(off_t offset)
 {
     MBED_ASSERT(_fs);
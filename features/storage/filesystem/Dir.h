@@ -69,6 +69,20 @@ public:
      */
     virtual ssize_t read(struct dirent *ent);
 
+    /** Read the next directory entry along with its attributes
+     *
+     *  Cheaper than calling stat for each entry read, the attributes come
+     *  from the same directory metadata as the name.
+     *
+     *  @param ent      The directory entry to fill out
+     *  @param st       The attributes to fill out, st_mode, st_size and,
+     *                  if the file system records it, st_mtime
+     *  @return         1 on reading a filename, 0 at end of directory,
+     *                  -ENOSYS if not supported by the file system,
+     *                  negative error on failure
+     */
+    virtual ssize_t read(struct dirent *ent, struct stat *st);
+
     /** Set the current position of the directory
      *
      *  @param offset   Offset of the location to seek to,
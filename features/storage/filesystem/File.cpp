@@ -68,12 +68,30 @@ ssize_t File::read(void *buffer, size_t len)
     return _fs->file_read(_file, buffer, len);
 }
 
+ssize_t File::read_in_place(const void **data, size_t len)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_read_in_place(_file, data, len);
+}
+
+ssize_t File::readv(const struct iovec *iov, int iovcnt)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_readv(_file, iov, iovcnt);
+}
+
 ssize_t File::write(const void *buffer, size_t len)
 {
     MBED_ASSERT(_fs);
     return _fs->file_write(_file, buffer, len);
 }
 
+ssize_t File::writev(const struct iovec *iov, int iovcnt)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_writev(_file, iov, iovcnt);
+}
+
 int File::sync()
 {
     MBED_ASSERT(_fs);
@@ -116,4 +134,10 @@ int File::truncate(off_t length)
     return _fs->file_truncate(_file, length);
 }
 
+int File::reserve(off_t length)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_reserve(_file, length);
+}
+
 } // namespace mbed
@@ -77,6 +77,26 @@ public:
 
     virtual ssize_t read(void *buffer, size_t size);
 
+    /** Read the contents of a file in place
+     *
+     *  Supported when the file system can point into memory-mapped storage,
+     *  see BlockDevice::get_mapped_address.
+     *
+     *  @param data     Set to the start of the data read
+     *  @param size     The maximum number of bytes to read
+     *  @return         The number of bytes at data, 0 at end of file,
+     *                  -ENOSYS if the data can't be read in place
+     */
+    virtual ssize_t read_in_place(const void **data, size_t size);
+
+    /** Read the contents of a file into several buffers
+     *
+     *  @param iov      The buffers to read in to
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t readv(const struct iovec *iov, int iovcnt);
+
     /** Write the contents of a buffer to a file
      *
      *  @param buffer   The buffer to write from
@@ -85,6 +105,14 @@ public:
      */
     virtual ssize_t write(const void *buffer, size_t size);
 
+    /** Write the contents of several buffers to a file
+     *
+     *  @param iov      The buffers to write from
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t writev(const struct iovec *iov, int iovcnt);
+
     /** Flush any buffers associated with the file
      *
      *  @return         0 on success, negative error code on failure
@@ -138,6 +166,19 @@ public:
      */
     virtual int truncate(off_t length);
 
+    /** Preallocate storage for a file.
+     *
+     * Reserves length bytes of storage up front, so later writes don't have
+     * to allocate. What the reserved area contains and whether it counts
+     * towards the file's size depends on the file system.
+     *
+     *  @param length   The number of bytes to reserve
+     *
+     *  @return         Zero on success, -ENOSYS if not supported by the
+     *                  file system, negative error code on failure
+     */
+    virtual int reserve(off_t length);
+
 private:
     FileSystem *_fs;
     fs_file_t _file;
@@ -56,6 +56,47 @@ int FileSystem::statvfs(const char *path, struct statvfs *buf)
     return -ENOSYS;
 }
 
+ssize_t FileSystem::file_read_in_place(fs_file_t file, const void **data, size_t size)
+{
+    return -ENOSYS;
+}
+
+ssize_t FileSystem::file_readv(fs_file_t file, const struct iovec *iov, int iovcnt)
+{
+    ssize_t total = 0;
+
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t ret = file_read(file, iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            return total ? total : ret;
+        }
+        total += ret;
+        if ((size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+
+    return total;
+}
+
+ssize_t FileSystem::file_writev(fs_file_t file, const struct iovec *iov, int iovcnt)
+{
+    ssize_t total = 0;
+
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t ret = file_write(file, iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            return total ? total : ret;
+        }
+        total += ret;
+        if ((size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+
+    return total;
+}
+
 int FileSystem::file_sync(fs_file_t file)
 {
     return 0;
@@ -89,6 +130,11 @@ int FileSystem::file_truncate(fs_file_t file, off_t length)
     return -ENOSYS;
 }
 
+int FileSystem::file_reserve(fs_file_t file, off_t length)
+{
+    return -ENOSYS;
+}
+
 int FileSystem::dir_open(fs_dir_t *dir, const char *path)
 {
     return -ENOSYS;
@@ -104,6 +150,11 @@ ssize_t FileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
     return -ENOSYS;
 }
 
+ssize_t FileSystem::dir_read_stat(fs_dir_t dir, struct dirent *ent, struct stat *st)
+{
+    return -ENOSYS;
+}
+
 void FileSystem::dir_seek(fs_dir_t dir, off_t offset)
 {
 }
@@ -163,6 +163,25 @@ protected:
      */
     virtual ssize_t file_read(fs_file_t file, void *buffer, size_t size) = 0;
 
+    /** Read the contents of a file in place.
+     *
+     *  @param file     File handle.
+     *  @param data     Set to the start of the data read.
+     *  @param size     The maximum number of bytes to read.
+     *  @return         The number of bytes at data, 0 at the end of the file,
+     *                  -ENOSYS if the data can't be read in place.
+     */
+    virtual ssize_t file_read_in_place(fs_file_t file, const void **data, size_t size);
+
+    /** Read the contents of a file into several buffers.
+     *
+     *  @param file     File handle.
+     *  @param iov      The buffers to read in to.
+     *  @param iovcnt   The number of buffers.
+     *  @return         The number of bytes read, 0 at the end of the file, negative error on failure.
+     */
+    virtual ssize_t file_readv(fs_file_t file, const struct iovec *iov, int iovcnt);
+
     /** Write the contents of a buffer to a file.
      *
      *  @param file     File handle.
@@ -172,6 +191,15 @@ protected:
      */
     virtual ssize_t file_write(fs_file_t file, const void *buffer, size_t size) = 0;
 
+    /** Write the contents of several buffers to a file.
+     *
+     *  @param file     File handle.
+     *  @param iov      The buffers to write from.
+     *  @param iovcnt   The number of buffers.
+     *  @return         The number of bytes written, negative error on failure.
+     */
+    virtual ssize_t file_writev(fs_file_t file, const struct iovec *iov, int iovcnt);
+
     /** Flush any buffers associated with the file.
      *
      *  @param file     File handle.
@@ -233,6 +261,14 @@ protected:
      */
     virtual int file_truncate(fs_file_t file, off_t length);
 
+    /** Preallocate storage for a file.
+     *
+     *  @param file     File handle.
+     *  @param length   Number of bytes to reserve.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_reserve(fs_file_t file, off_t length);
+
     /** Open a directory on the file system.
      *
      *  @param dir      Destination for the handle to the directory.
@@ -256,6 +292,19 @@ protected:
      */
     virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ent);
 
+    /** Read the next directory entry along with its attributes.
+     *
+     *  Fills in st_mode, st_size and, where the file system records it,
+     *  st_mtime, without looking the entry up again as stat does.
+     *
+     *  @param dir      Dir handle.
+     *  @param ent      The directory entry to fill out.
+     *  @param st       The attributes of the entry to fill out.
+     *  @return         1 on reading a filename, 0 at the end of the directory,
+     *                  -ENOSYS if not supported, negative error on failure.
+     */
+    virtual ssize_t dir_read_stat(fs_dir_t dir, struct dirent *ent, struct stat *st);
+
     /** Set the current position of the directory.
      *
      *  @param dir      Dir handle.
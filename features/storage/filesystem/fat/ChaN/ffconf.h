@@ -48,7 +48,11 @@
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 
+#ifdef MBED_CONF_FAT_CHAN_FF_USE_EXPAND
+#define FF_USE_EXPAND	MBED_CONF_FAT_CHAN_FF_USE_EXPAND
+#else
 #define FF_USE_EXPAND	0
+#endif
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
 
@@ -219,7 +223,11 @@
 / System Configurations
 /---------------------------------------------------------------------------*/
 
+#ifdef MBED_CONF_FAT_CHAN_FF_FS_TINY
+#define FF_FS_TINY		MBED_CONF_FAT_CHAN_FF_FS_TINY
+#else
 #define FF_FS_TINY		1
+#endif
 /* This option switches tiny buffer configuration. (0:Normal or 1:Tiny)
 /  At the tiny configuration, size of file object (FIL) is shrinked FF_MAX_SS bytes.
 /  Instead of private sector buffer eliminated from the file object, common sector
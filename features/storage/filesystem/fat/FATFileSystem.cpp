@@ -502,6 +502,45 @@ int FATFileSystem::mkdir(const char *path, mode_t mode)
     return fat_error_remap(res);
 }
 
+static void fat_fill_stat(const FILINFO *f, struct stat *st)
+{
+    /* ARMCC doesnt support stat(), and these symbols are not defined by the toolchain. */
+#ifdef TOOLCHAIN_GCC
+    st->st_size = f->fsize;
+    st->st_mode = 0;
+    st->st_mode |= (f->fattrib & AM_DIR) ? S_IFDIR : S_IFREG;
+    st->st_mode |= (f->fattrib & AM_RDO) ?
+                   (S_IRUSR | S_IXUSR | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) :
+                   (S_IRWXU | S_IRWXG | S_IRWXO);
+
+    // Reverse of get_fattime
+    struct tm t;
+    memset(&t, 0, sizeof(t));
+    t.tm_year = (f->fdate >> 9) + 80;
+    t.tm_mon = ((f->fdate >> 5) & 0xf) - 1;
+    t.tm_mday = f->fdate & 0x1f;
+    t.tm_hour = f->ftime >> 11;
+    t.tm_min = (f->ftime >> 5) & 0x3f;
+    t.tm_sec = (f->ftime & 0x1f) * 2;
+    t.tm_isdst = -1;
+    st->st_mtime = f->fdate ? mktime(&t) : 0;
+#endif /* TOOLCHAIN_GCC */
+}
+
+static void fat_fill_dirent(const FILINFO *f, struct dirent *ent)
+{
+    ent->d_type = (f->fattrib & AM_DIR) ? DT_DIR : DT_REG;
+
+#if FF_USE_LFN
+    if (ent->d_name[0] == 0) {
+        // No long filename so use short filename.
+        strncpy(ent->d_name, f->fname, FF_LFN_BUF);
+    }
+#else
+    strncpy(ent->d_name, f->fname, FF_SFN_BUF);
+#endif
+}
+
 int FATFileSystem::stat(const char *path, struct stat *st)
 {
     Deferred<const char *> fpath = fat_path_prefix(_id, path);
@@ -516,15 +555,7 @@ int FATFileSystem::stat(const char *path, struct stat *st)
         return fat_error_remap(res);
     }
 
-    /* ARMCC doesnt support stat(), and these symbols are not defined by the toolchain. */
-#ifdef TOOLCHAIN_GCC
-    st->st_size = f.fsize;
-    st->st_mode = 0;
-    st->st_mode |= (f.fattrib & AM_DIR) ? S_IFDIR : S_IFREG;
-    st->st_mode |= (f.fattrib & AM_RDO) ?
-                   (S_IRUSR | S_IXUSR | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) :
-                   (S_IRWXU | S_IRWXG | S_IRWXO);
-#endif /* TOOLCHAIN_GCC */
+    fat_fill_stat(&f, st);
     unlock();
 
     return 0;
@@ -752,6 +783,24 @@ int FATFileSystem::file_truncate(fs_file_t file, off_t length)
     return 0;
 }
 
+int FATFileSystem::file_reserve(fs_file_t file, off_t length)
+{
+#if FF_USE_EXPAND
+    FIL *fh = static_cast<FIL *>(file);
+
+    lock();
+    FRESULT res = f_expand(fh, length, 1);
+    if (res) {
+        debug_if(FFS_DBG, "f_expand() failed: %d\n", res);
+    }
+    unlock();
+
+    return fat_error_remap(res);
+#else
+    return -ENOSYS;
+#endif
+}
+
 
 ////// Dir operations //////
 int FATFileSystem::dir_open(fs_dir_t *dir, const char *path)
@@ -800,17 +849,27 @@ ssize_t FATFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
         return 0;
     }
 
-    ent->d_type = (finfo.fattrib & AM_DIR) ? DT_DIR : DT_REG;
+    fat_fill_dirent(&finfo, ent);
+    return 1;
+}
 
-#if FF_USE_LFN
-    if (ent->d_name[0] == 0) {
-        // No long filename so use short filename.
-        strncpy(ent->d_name, finfo.fname, FF_LFN_BUF);
+ssize_t FATFileSystem::dir_read_stat(fs_dir_t dir, struct dirent *ent, struct stat *st)
+{
+    FATFS_DIR *dh = static_cast<FATFS_DIR *>(dir);
+    FILINFO finfo;
+
+    lock();
+    FRESULT res = f_readdir(dh, &finfo);
+    unlock();
+
+    if (res != FR_OK) {
+        return fat_error_remap(res);
+    } else if (finfo.fname[0] == 0) {
+        return 0;
     }
-#else
-    strncpy(ent->d_name, finfo.fname, FF_SFN_BUF);
-#endif
 
+    fat_fill_dirent(&finfo, ent);
+    fat_fill_stat(&finfo, st);
     return 1;
 }
 
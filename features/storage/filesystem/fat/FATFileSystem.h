@@ -236,6 +236,21 @@ protected:
      */
     virtual int file_truncate(mbed::fs_file_t file, off_t length);
 
+    /** Preallocate a contiguous cluster chain for a file.
+     *
+     * The file must be empty. Its size is set to length and the reserved
+     * area is not cleared, so write it from the start and truncate to the
+     * written length before closing. Writes and seeks within a contiguous
+     * file compute clusters directly instead of following the FAT.
+     * Requires the fat_chan.ff-use-expand option.
+     *
+     *  @param file     File handle.
+     *  @param length   The number of bytes to reserve.
+     *
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_reserve(mbed::fs_file_t file, off_t length);
+
     /** Open a directory on the file system.
      *
      *  @param dir      Destination for the handle to the directory.
@@ -259,6 +274,15 @@ protected:
      */
     virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ent);
 
+    /** Read the next directory entry along with its size, type and modification time.
+     *
+     *  @param dir      Dir handle.
+     *  @param ent      The directory entry to fill out.
+     *  @param st       The attributes of the entry to fill out.
+     *  @return         1 on reading a filename, 0 at the end of the directory, negative error on failure.
+     */
+    virtual ssize_t dir_read_stat(fs_dir_t dir, struct dirent *ent, struct stat *st);
+
     /** Set the current position of the directory.
      *
      *  @param dir      Dir handle.
@@ -138,17 +138,302 @@ static int lfs_bd_sync(const struct lfs_config *c)
 }
 
 
+////// Read cache operations //////
+
+// Lines are read_size aligned, so never span blocks. The cache is write
+// through, programs update cached lines and erases drop them, so a line
+// always matches the block device.
+void LittleFileSystem::cache_init()
+{
+    _cache_count = _read_cache_size / _config.read_size;
+    _cache_tick = 0;
+    _cache_hits = 0;
+    _cache_misses = 0;
+    if (!_cache_count) {
+        return;
+    }
+
+    _cache_lines = new cache_line_t[_cache_count];
+    _cache_buffer = new uint8_t[_cache_count * _config.read_size];
+    for (lfs_size_t i = 0; i < _cache_count; i++) {
+        _cache_lines[i].used = 0;
+    }
+
+    _config.context = this;
+    _config.read  = cache_read;
+    _config.prog  = cache_prog;
+    _config.erase = cache_erase;
+    _config.sync  = cache_sync;
+}
+
+void LittleFileSystem::cache_free()
+{
+    delete[] _cache_lines;
+    _cache_lines = NULL;
+    delete[] _cache_buffer;
+    _cache_buffer = NULL;
+    _cache_count = 0;
+}
+
+void LittleFileSystem::cache_invalidate(lfs_block_t block)
+{
+    for (lfs_size_t i = 0; i < _cache_count; i++) {
+        if (_cache_lines[i].block == block) {
+            _cache_lines[i].used = 0;
+        }
+    }
+}
+
+uint8_t *LittleFileSystem::cache_fetch(lfs_block_t block, lfs_off_t off, int *err)
+{
+    lfs_size_t victim = 0;
+    for (lfs_size_t i = 0; i < _cache_count; i++) {
+        cache_line_t *line = &_cache_lines[i];
+        if (line->used && line->block == block && line->off == off) {
+            line->used = ++_cache_tick;
+            _cache_hits++;
+            return &_cache_buffer[i * _config.read_size];
+        }
+
+        if (line->used < _cache_lines[victim].used) {
+            victim = i;
+        }
+    }
+
+    _cache_misses++;
+    uint8_t *data = &_cache_buffer[victim * _config.read_size];
+    _cache_lines[victim].used = 0;
+    *err = _bd->read(data, (bd_addr_t)block * _config.block_size + off, _config.read_size);
+    if (*err) {
+        return NULL;
+    }
+
+    _cache_lines[victim].block = block;
+    _cache_lines[victim].off = off;
+    _cache_lines[victim].used = ++_cache_tick;
+    return data;
+}
+
+int LittleFileSystem::cache_read(const struct lfs_config *c, lfs_block_t block,
+                                 lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    LittleFileSystem *fs = (LittleFileSystem *)c->context;
+    // Bulk file data would only evict metadata
+    if (size > c->read_size) {
+        return lfs_bd_read(c, block, off, buffer, size);
+    }
+
+    uint8_t *data = (uint8_t *)buffer;
+    while (size > 0) {
+        lfs_off_t line_off = off - off % c->read_size;
+        lfs_size_t diff = lfs_min(size, c->read_size - (off - line_off));
+        int err = 0;
+        uint8_t *line = fs->cache_fetch(block, line_off, &err);
+        if (!line) {
+            return err;
+        }
+
+        memcpy(data, &line[off - line_off], diff);
+        off += diff;
+        data += diff;
+        size -= diff;
+    }
+
+    return 0;
+}
+
+int LittleFileSystem::cache_prog(const struct lfs_config *c, lfs_block_t block,
+                                 lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    LittleFileSystem *fs = (LittleFileSystem *)c->context;
+    int err = fs->_bd->program(buffer, (bd_addr_t)block * c->block_size + off, size);
+    if (err) {
+        // Contents are unknown after a failed program
+        fs->cache_invalidate(block);
+        return err;
+    }
+
+    for (lfs_size_t i = 0; i < fs->_cache_count; i++) {
+        cache_line_t *line = &fs->_cache_lines[i];
+        if (!line->used || line->block != block ||
+                line->off >= off + size || line->off + c->read_size <= off) {
+            continue;
+        }
+
+        lfs_off_t start = lfs_max(off, line->off);
+        lfs_off_t end = lfs_min(off + size, line->off + c->read_size);
+        memcpy(&fs->_cache_buffer[i * c->read_size + (start - line->off)],
+               (const uint8_t *)buffer + (start - off), end - start);
+    }
+
+    return 0;
+}
+
+int LittleFileSystem::cache_erase(const struct lfs_config *c, lfs_block_t block)
+{
+    LittleFileSystem *fs = (LittleFileSystem *)c->context;
+    fs->cache_invalidate(block);
+    return fs->_bd->erase((bd_addr_t)block * c->block_size, c->block_size);
+}
+
+int LittleFileSystem::cache_sync(const struct lfs_config *c)
+{
+    LittleFileSystem *fs = (LittleFileSystem *)c->context;
+    return fs->_bd->sync();
+}
+
+
+////// Directory listing cache //////
+
+// The listing of one directory, as entries each followed by the name and
+// padded to a word. It is only written while no Dir reads from it, so a Dir
+// reading from the cache sees the listing as it was when opened or rewound.
+struct dir_cache_entry_t {
+    lfs_soff_t pos;     // position of the directory after this entry
+    lfs_size_t size;
+    uint8_t type;
+    uint8_t nlen;
+};
+
+#define DIR_CACHE_ENTRY_SIZE(nlen) ((sizeof(dir_cache_entry_t) + (nlen) + 3) & ~3)
+
+enum dir_cache_mode {
+    DIR_CACHE_NONE,
+    DIR_CACHE_FILL,
+    DIR_CACHE_READ
+};
+
+void LittleFileSystem::dir_cache_init()
+{
+    _dir_cache_used = 0;
+    _dir_cache_valid = false;
+    _dir_cache_filler = NULL;
+    _dir_cache_readers = 0;
+    if (_dir_cache_size) {
+        _dir_cache = new uint32_t[_dir_cache_size / sizeof(uint32_t)];
+    }
+}
+
+void LittleFileSystem::dir_cache_free()
+{
+    delete[] _dir_cache;
+    _dir_cache = NULL;
+}
+
+void LittleFileSystem::dir_cache_invalidate()
+{
+    // A Dir filling the cache carries on without it
+    _dir_cache_valid = false;
+    _dir_cache_filler = NULL;
+}
+
+// Called with the Dir at the start of its directory. The Dir reads from the
+// cache if it holds its directory, or fills it if no other Dir uses it.
+void LittleFileSystem::dir_cache_attach(dir_handle_t *d)
+{
+    d->cache_mode = DIR_CACHE_NONE;
+    if (!_dir_cache) {
+        return;
+    }
+
+    if (_dir_cache_valid && _dir_cache_pair[0] == d->dir.pair[0] && _dir_cache_pair[1] == d->dir.pair[1]) {
+        d->cache_mode = DIR_CACHE_READ;
+        d->cache_off = 0;
+        d->cache_pos = _dir_cache_start;
+        _dir_cache_readers++;
+    } else if (!_dir_cache_filler && !_dir_cache_readers) {
+        d->cache_mode = DIR_CACHE_FILL;
+        _dir_cache_valid = false;
+        _dir_cache_used = 0;
+        _dir_cache_pair[0] = d->dir.pair[0];
+        _dir_cache_pair[1] = d->dir.pair[1];
+        _dir_cache_start = lfs_dir_tell(&_lfs, &d->dir);
+        _dir_cache_filler = d;
+    }
+}
+
+void LittleFileSystem::dir_cache_detach(dir_handle_t *d)
+{
+    if (d->cache_mode == DIR_CACHE_READ) {
+        _dir_cache_readers--;
+    } else if (d->cache_mode == DIR_CACHE_FILL && _dir_cache_filler == d) {
+        _dir_cache_filler = NULL;
+    }
+    d->cache_mode = DIR_CACHE_NONE;
+}
+
+int LittleFileSystem::dir_read_info(dir_handle_t *d, struct lfs_info *info)
+{
+    if (d->cache_mode == DIR_CACHE_READ) {
+        if (d->cache_off >= _dir_cache_used) {
+            return 0;
+        }
+
+        const uint8_t *p = (const uint8_t *)_dir_cache + d->cache_off;
+        const dir_cache_entry_t *e = (const dir_cache_entry_t *)p;
+        info->type = e->type;
+        info->size = e->size;
+        memcpy(info->name, p + sizeof(dir_cache_entry_t), e->nlen);
+        info->name[e->nlen] = '\0';
+        d->cache_pos = e->pos;
+        d->cache_off += DIR_CACHE_ENTRY_SIZE(e->nlen);
+        return 1;
+    }
+
+    int res = lfs_dir_read(&_lfs, &d->dir, info);
+    if (d->cache_mode != DIR_CACHE_FILL) {
+        return res;
+    }
+
+    if (_dir_cache_filler != d) {
+        // Dropped by a change to the file system
+        d->cache_mode = DIR_CACHE_NONE;
+    } else if (res == 1) {
+        lfs_size_t nlen = strlen(info->name);
+        lfs_size_t size = DIR_CACHE_ENTRY_SIZE(nlen);
+        if (_dir_cache_used + size > _dir_cache_size) {
+            dir_cache_detach(d);
+        } else {
+            uint8_t *p = (uint8_t *)_dir_cache + _dir_cache_used;
+            dir_cache_entry_t *e = (dir_cache_entry_t *)p;
+            e->pos = lfs_dir_tell(&_lfs, &d->dir);
+            e->size = info->size;
+            e->type = info->type;
+            e->nlen = nlen;
+            memcpy(p + sizeof(dir_cache_entry_t), info->name, nlen);
+            _dir_cache_used += size;
+        }
+    } else {
+        // Complete at the end of the directory
+        _dir_cache_valid = (res == 0);
+        dir_cache_detach(d);
+    }
+
+    return res;
+}
+
+
 ////// Generic filesystem operations //////
 
 // Filesystem implementation (See LittleFileSystem.h)
 LittleFileSystem::LittleFileSystem(const char *name, BlockDevice *bd,
                                    lfs_size_t read_size, lfs_size_t prog_size,
-                                   lfs_size_t block_size, lfs_size_t lookahead)
+                                   lfs_size_t block_size, lfs_size_t lookahead,
+                                   lfs_size_t read_cache_size, lfs_size_t dir_cache_size)
     : FileSystem(name)
     , _read_size(read_size)
     , _prog_size(prog_size)
     , _block_size(block_size)
     , _lookahead(lookahead)
+    , _read_cache_size(read_cache_size)
+    , _cache_lines(NULL)
+    , _cache_buffer(NULL)
+    , _cache_count(0)
+    , _cache_tick(0)
+    , _cache_hits(0)
+    , _cache_misses(0)
+    , _dir_cache_size(dir_cache_size & ~(sizeof(uint32_t) - 1))
+    , _dir_cache(NULL)
 {
     if (bd) {
         mount(bd);
@@ -198,8 +483,13 @@ int LittleFileSystem::mount(BlockDevice *bd)
         _config.lookahead = _lookahead;
     }
 
+    cache_init();
+    dir_cache_init();
+
     err = lfs_mount(&_lfs, &_config);
     if (err) {
+        cache_free();
+        dir_cache_free();
         _bd = NULL;
         LFS_INFO("mount -> %d", lfs_toerror(err));
         _mutex.unlock();
@@ -227,6 +517,8 @@ int LittleFileSystem::unmount()
             res = err;
         }
 
+        cache_free();
+        dir_cache_free();
         _bd = NULL;
     }
 
@@ -337,6 +629,7 @@ int LittleFileSystem::remove(const char *filename)
 {
     _mutex.lock();
     LFS_INFO("remove(\"%s\")", filename);
+    dir_cache_invalidate();
     int err = lfs_remove(&_lfs, filename);
     LFS_INFO("remove -> %d", lfs_toerror(err));
     _mutex.unlock();
@@ -347,6 +640,7 @@ int LittleFileSystem::rename(const char *oldname, const char *newname)
 {
     _mutex.lock();
     LFS_INFO("rename(\"%s\", \"%s\")", oldname, newname);
+    dir_cache_invalidate();
     int err = lfs_rename(&_lfs, oldname, newname);
     LFS_INFO("rename -> %d", lfs_toerror(err));
     _mutex.unlock();
@@ -357,6 +651,7 @@ int LittleFileSystem::mkdir(const char *name, mode_t mode)
 {
     _mutex.lock();
     LFS_INFO("mkdir(\"%s\", 0x%lx)", name, mode);
+    dir_cache_invalidate();
     int err = lfs_mkdir(&_lfs, name);
     LFS_INFO("mkdir -> %d", lfs_toerror(err));
     _mutex.unlock();
@@ -405,12 +700,23 @@ int LittleFileSystem::statvfs(const char *name, struct statvfs *st)
     return 0;
 }
 
+void LittleFileSystem::read_cache_stats(uint32_t *hits, uint32_t *misses)
+{
+    _mutex.lock();
+    *hits = _cache_hits;
+    *misses = _cache_misses;
+    _mutex.unlock();
+}
+
 ////// File operations //////
 int LittleFileSystem::file_open(fs_file_t *file, const char *path, int flags)
 {
     lfs_file_t *f = new lfs_file_t;
     _mutex.lock();
     LFS_INFO("file_open(%p, \"%s\", 0x%x)", *file, path, flags);
+    if ((flags & O_ACCMODE) != O_RDONLY) {
+        dir_cache_invalidate();
+    }
     int err = lfs_file_open(&_lfs, f, path, lfs_fromflags(flags));
     LFS_INFO("file_open -> %d", lfs_toerror(err));
     _mutex.unlock();
@@ -427,6 +733,9 @@ int LittleFileSystem::file_close(fs_file_t file)
     lfs_file_t *f = (lfs_file_t *)file;
     _mutex.lock();
     LFS_INFO("file_close(%p)", file);
+    if ((f->flags & 3) != LFS_O_RDONLY) {
+        dir_cache_invalidate();
+    }
     int err = lfs_file_close(&_lfs, f);
     LFS_INFO("file_close -> %d", lfs_toerror(err));
     _mutex.unlock();
@@ -445,6 +754,57 @@ ssize_t LittleFileSystem::file_read(fs_file_t file, void *buffer, size_t len)
     return lfs_toerror(res);
 }
 
+ssize_t LittleFileSystem::file_read_in_place(fs_file_t file, const void **data, size_t len)
+{
+    lfs_file_t *f = (lfs_file_t *)file;
+    _mutex.lock();
+    LFS_INFO("file_read_in_place(%p, %p, %d)", file, data, len);
+    lfs_off_t pos = f->pos;
+    // Reading the first byte finds the block holding the data, the rest
+    // of that block is contiguous on the block device
+    uint8_t first;
+    ssize_t res = lfs_toerror(lfs_file_read(&_lfs, f, &first, len ? 1 : 0));
+    if (res == 1) {
+        lfs_off_t off = f->off - 1;
+        lfs_size_t size = lfs_min(len, lfs_min(f->size - pos, _config.block_size - off));
+        const void *mapped = _bd->get_mapped_address((bd_addr_t)f->block * _config.block_size + off, size);
+        if (mapped) {
+            f->pos += size - 1;
+            f->off += size - 1;
+            *data = mapped;
+            res = size;
+        } else {
+            lfs_file_seek(&_lfs, f, pos, LFS_SEEK_SET);
+            res = -ENOSYS;
+        }
+    }
+    LFS_INFO("file_read_in_place -> %d", res);
+    _mutex.unlock();
+    return res;
+}
+
+ssize_t LittleFileSystem::file_readv(fs_file_t file, const struct iovec *iov, int iovcnt)
+{
+    lfs_file_t *f = (lfs_file_t *)file;
+    _mutex.lock();
+    LFS_INFO("file_readv(%p, %p, %d)", file, iov, iovcnt);
+    lfs_ssize_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        lfs_ssize_t res = lfs_file_read(&_lfs, f, iov[i].iov_base, iov[i].iov_len);
+        if (res < 0) {
+            total = total ? total : res;
+            break;
+        }
+        total += res;
+        if ((lfs_size_t)res < iov[i].iov_len) {
+            break;
+        }
+    }
+    LFS_INFO("file_readv -> %d", lfs_toerror(total));
+    _mutex.unlock();
+    return lfs_toerror(total);
+}
+
 ssize_t LittleFileSystem::file_write(fs_file_t file, const void *buffer, size_t len)
 {
     lfs_file_t *f = (lfs_file_t *)file;
@@ -456,11 +816,34 @@ ssize_t LittleFileSystem::file_write(fs_file_t file, const void *buffer, size_t
     return lfs_toerror(res);
 }
 
+ssize_t LittleFileSystem::file_writev(fs_file_t file, const struct iovec *iov, int iovcnt)
+{
+    lfs_file_t *f = (lfs_file_t *)file;
+    _mutex.lock();
+    LFS_INFO("file_writev(%p, %p, %d)", file, iov, iovcnt);
+    lfs_ssize_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        lfs_ssize_t res = lfs_file_write(&_lfs, f, iov[i].iov_base, iov[i].iov_len);
+        if (res < 0) {
+            total = total ? total : res;
+            break;
+        }
+        total += res;
+        if ((lfs_size_t)res < iov[i].iov_len) {
+            break;
+        }
+    }
+    LFS_INFO("file_writev -> %d", lfs_toerror(total));
+    _mutex.unlock();
+    return lfs_toerror(total);
+}
+
 int LittleFileSystem::file_sync(fs_file_t file)
 {
     lfs_file_t *f = (lfs_file_t *)file;
     _mutex.lock();
     LFS_INFO("file_sync(%p)", file);
+    dir_cache_invalidate();
     int err = lfs_file_sync(&_lfs, f);
     LFS_INFO("file_sync -> %d", lfs_toerror(err));
     _mutex.unlock();
@@ -505,6 +888,7 @@ int LittleFileSystem::file_truncate(fs_file_t file, off_t length)
     lfs_file_t *f = (lfs_file_t *)file;
     _mutex.lock();
     LFS_INFO("file_truncate(%p)", file);
+    dir_cache_invalidate();
     int err = lfs_file_truncate(&_lfs, f, length);
     LFS_INFO("file_truncate -> %d", lfs_toerror(err));
     _mutex.unlock();
@@ -515,10 +899,13 @@ int LittleFileSystem::file_truncate(fs_file_t file, off_t length)
 ////// Dir operations //////
 int LittleFileSystem::dir_open(fs_dir_t *dir, const char *path)
 {
-    lfs_dir_t *d = new lfs_dir_t;
+    dir_handle_t *d = new dir_handle_t;
     _mutex.lock();
     LFS_INFO("dir_open(%p, \"%s\")", *dir, path);
-    int err = lfs_dir_open(&_lfs, d, path);
+    int err = lfs_dir_open(&_lfs, &d->dir, path);
+    if (!err) {
+        dir_cache_attach(d);
+    }
     LFS_INFO("dir_open -> %d", lfs_toerror(err));
     _mutex.unlock();
     if (!err) {
@@ -531,10 +918,11 @@ int LittleFileSystem::dir_open(fs_dir_t *dir, const char *path)
 
 int LittleFileSystem::dir_close(fs_dir_t dir)
 {
-    lfs_dir_t *d = (lfs_dir_t *)dir;
+    dir_handle_t *d = (dir_handle_t *)dir;
     _mutex.lock();
     LFS_INFO("dir_close(%p)", dir);
-    int err = lfs_dir_close(&_lfs, d);
+    dir_cache_detach(d);
+    int err = lfs_dir_close(&_lfs, &d->dir);
     LFS_INFO("dir_close -> %d", lfs_toerror(err));
     _mutex.unlock();
     delete d;
@@ -543,11 +931,11 @@ int LittleFileSystem::dir_close(fs_dir_t dir)
 
 ssize_t LittleFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
 {
-    lfs_dir_t *d = (lfs_dir_t *)dir;
+    dir_handle_t *d = (dir_handle_t *)dir;
     struct lfs_info info;
     _mutex.lock();
     LFS_INFO("dir_read(%p, %p)", dir, ent);
-    int res = lfs_dir_read(&_lfs, d, &info);
+    int res = dir_read_info(d, &info);
     LFS_INFO("dir_read -> %d", lfs_toerror(res));
     _mutex.unlock();
     if (res == 1) {
@@ -557,22 +945,67 @@ ssize_t LittleFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
     return lfs_toerror(res);
 }
 
+ssize_t LittleFileSystem::dir_read_stat(fs_dir_t dir, struct dirent *ent, struct stat *st)
+{
+    dir_handle_t *d = (dir_handle_t *)dir;
+    struct lfs_info info;
+    _mutex.lock();
+    LFS_INFO("dir_read_stat(%p, %p, %p)", dir, ent, st);
+    int res = dir_read_info(d, &info);
+    LFS_INFO("dir_read_stat -> %d", lfs_toerror(res));
+    _mutex.unlock();
+    if (res == 1) {
+        ent->d_type = lfs_totype(info.type);
+        strcpy(ent->d_name, info.name);
+        st->st_size = (info.type == LFS_TYPE_REG) ? info.size : 0;
+        st->st_mode = lfs_tomode(info.type);
+    }
+    return lfs_toerror(res);
+}
+
 void LittleFileSystem::dir_seek(fs_dir_t dir, off_t offset)
 {
-    lfs_dir_t *d = (lfs_dir_t *)dir;
+    dir_handle_t *d = (dir_handle_t *)dir;
     _mutex.lock();
     LFS_INFO("dir_seek(%p, %ld)", dir, offset);
-    lfs_dir_seek(&_lfs, d, offset);
+    if (d->cache_mode == DIR_CACHE_READ) {
+        // Positions are those of the directory, find the entry they follow
+        lfs_size_t off = 0;
+        if (offset != _dir_cache_start) {
+            while (off < _dir_cache_used) {
+                const dir_cache_entry_t *e = (const dir_cache_entry_t *)((const uint8_t *)_dir_cache + off);
+                off += DIR_CACHE_ENTRY_SIZE(e->nlen);
+                if (e->pos == offset) {
+                    break;
+                }
+            }
+        }
+        if (off < _dir_cache_used || offset == _dir_cache_start) {
+            d->cache_off = off;
+            d->cache_pos = offset;
+        } else {
+            dir_cache_detach(d);
+            lfs_dir_seek(&_lfs, &d->dir, offset);
+        }
+    } else {
+        dir_cache_detach(d);
+        lfs_dir_seek(&_lfs, &d->dir, offset);
+    }
     LFS_INFO("dir_seek -> %s", "void");
     _mutex.unlock();
 }
 
 off_t LittleFileSystem::dir_tell(fs_dir_t dir)
 {
-    lfs_dir_t *d = (lfs_dir_t *)dir;
+    dir_handle_t *d = (dir_handle_t *)dir;
     _mutex.lock();
     LFS_INFO("dir_tell(%p)", dir);
-    lfs_soff_t res = lfs_dir_tell(&_lfs, d);
+    lfs_soff_t res;
+    if (d->cache_mode == DIR_CACHE_READ) {
+        res = d->cache_pos;
+    } else {
+        res = lfs_dir_tell(&_lfs, &d->dir);
+    }
     LFS_INFO("dir_tell -> %d", lfs_toerror(res));
     _mutex.unlock();
     return lfs_toerror(res);
@@ -580,10 +1013,12 @@ off_t LittleFileSystem::dir_tell(fs_dir_t dir)
 
 void LittleFileSystem::dir_rewind(fs_dir_t dir)
 {
-    lfs_dir_t *d = (lfs_dir_t *)dir;
+    dir_handle_t *d = (dir_handle_t *)dir;
     _mutex.lock();
     LFS_INFO("dir_rewind(%p)", dir);
-    lfs_dir_rewind(&_lfs, d);
+    dir_cache_detach(d);
+    lfs_dir_rewind(&_lfs, &d->dir);
+    dir_cache_attach(d);
     LFS_INFO("dir_rewind -> %s", "void");
     _mutex.unlock();
 }
@@ -55,12 +55,23 @@ public:
      *      lookahead reduces the number of passes required to allocate a block.
      *      The lookahead buffer requires only 1 bit per block so it can be quite
      *      large with little ram impact. Should be a multiple of 32.
+     *  @param read_cache_size
+     *      Number of bytes of RAM used to cache reads from the block device
+     *      across blocks, in lines of read_size with least recently used
+     *      eviction. Zero disables the cache.
+     *  @param dir_cache_size
+     *      Number of bytes of RAM used to keep the listing of the last
+     *      directory read in full, so it can be listed again without reading
+     *      the block device. Any change to the file system drops the listing.
+     *      Zero disables the cache.
      */
     LittleFileSystem(const char *name = NULL, mbed::BlockDevice *bd = NULL,
                      lfs_size_t read_size = MBED_LFS_READ_SIZE,
                      lfs_size_t prog_size = MBED_LFS_PROG_SIZE,
                      lfs_size_t block_size = MBED_LFS_BLOCK_SIZE,
-                     lfs_size_t lookahead = MBED_LFS_LOOKAHEAD);
+                     lfs_size_t lookahead = MBED_LFS_LOOKAHEAD,
+                     lfs_size_t read_cache_size = MBED_LFS_READ_CACHE_SIZE,
+                     lfs_size_t dir_cache_size = MBED_LFS_DIR_CACHE_SIZE);
 
     virtual ~LittleFileSystem();
 
@@ -157,6 +168,13 @@ public:
      */
     virtual int statvfs(const char *path, struct statvfs *buf);
 
+    /** Get the read cache counters since the file system was mounted.
+     *
+     *  @param hits     Number of reads served from the read cache.
+     *  @param misses   Number of reads that had to fetch a line from the block device.
+     */
+    void read_cache_stats(uint32_t *hits, uint32_t *misses);
+
 protected:
 #if !(DOXYGEN_ONLY)
     /** Open a file on the file system.
@@ -185,6 +203,30 @@ protected:
      */
     virtual ssize_t file_read(mbed::fs_file_t file, void *buffer, size_t size);
 
+    /** Read the contents of a file in place
+     *
+     *  Supported when the block device is memory-mapped. Returns at most
+     *  the rest of the current block of the file.
+     *
+     *  @param file     File handle.
+     *  @param data     Set to the start of the data read.
+     *  @param size     The maximum number of bytes to read.
+     *  @return         The number of bytes at data, 0 at end of file,
+     *                  -ENOSYS if the data can't be read in place
+     */
+    virtual ssize_t file_read_in_place(mbed::fs_file_t file, const void **data, size_t size);
+
+    /** Read the contents of a file into several buffers
+     *
+     *  The buffers are read under one lock.
+     *
+     *  @param file     File handle.
+     *  @param iov      The buffers to read in to.
+     *  @param iovcnt   The number of buffers.
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t file_readv(mbed::fs_file_t file, const struct iovec *iov, int iovcnt);
+
     /** Write the contents of a buffer to a file
      *
      *  @param file     File handle.
@@ -194,6 +236,18 @@ protected:
      */
     virtual ssize_t file_write(mbed::fs_file_t file, const void *buffer, size_t size);
 
+    /** Write the contents of several buffers to a file
+     *
+     *  The buffers are written under one lock, so they are not interleaved
+     *  with other writes to the file.
+     *
+     *  @param file     File handle.
+     *  @param iov      The buffers to write from.
+     *  @param iovcnt   The number of buffers.
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t file_writev(mbed::fs_file_t file, const struct iovec *iov, int iovcnt);
+
     /** Flush any buffers associated with the file
      *
      *  @param file     File handle.
@@ -263,6 +317,15 @@ protected:
      */
     virtual ssize_t dir_read(mbed::fs_dir_t dir, struct dirent *ent);
 
+    /** Read the next directory entry along with its type and size
+     *
+     *  @param dir      Dir handle.
+     *  @param ent      The directory entry to fill out.
+     *  @param st       The attributes of the entry to fill out.
+     *  @return         1 on reading a filename, 0 at end of directory, negative error on failure
+     */
+    virtual ssize_t dir_read_stat(mbed::fs_dir_t dir, struct dirent *ent, struct stat *st);
+
     /** Set the current position of the directory
      *
      *  @param dir      Dir handle.
@@ -295,6 +358,54 @@ private:
     const lfs_size_t _prog_size;
     const lfs_size_t _block_size;
     const lfs_size_t _lookahead;
+    const lfs_size_t _read_cache_size;
+
+    // read cache between littlefs and the block device
+    struct cache_line_t {
+        lfs_block_t block;
+        lfs_off_t off;
+        uint32_t used; // zero if the line is empty
+    };
+    cache_line_t *_cache_lines;
+    uint8_t *_cache_buffer;
+    lfs_size_t _cache_count;
+    uint32_t _cache_tick;
+    uint32_t _cache_hits;
+    uint32_t _cache_misses;
+
+    void cache_init();
+    void cache_free();
+    void cache_invalidate(lfs_block_t block);
+    uint8_t *cache_fetch(lfs_block_t block, lfs_off_t off, int *err);
+    static int cache_read(const struct lfs_config *c, lfs_block_t block,
+                          lfs_off_t off, void *buffer, lfs_size_t size);
+    static int cache_prog(const struct lfs_config *c, lfs_block_t block,
+                          lfs_off_t off, const void *buffer, lfs_size_t size);
+    static int cache_erase(const struct lfs_config *c, lfs_block_t block);
+    static int cache_sync(const struct lfs_config *c);
+
+    // listing cache of a single directory
+    struct dir_handle_t {
+        lfs_dir_t dir;
+        uint8_t cache_mode;
+        lfs_size_t cache_off;
+        lfs_soff_t cache_pos;
+    };
+    const lfs_size_t _dir_cache_size;
+    uint32_t *_dir_cache;
+    lfs_size_t _dir_cache_used;
+    lfs_block_t _dir_cache_pair[2];
+    lfs_soff_t _dir_cache_start;
+    bool _dir_cache_valid;
+    dir_handle_t *_dir_cache_filler;
+    uint32_t _dir_cache_readers;
+
+    void dir_cache_init();
+    void dir_cache_free();
+    void dir_cache_invalidate();
+    void dir_cache_attach(dir_handle_t *d);
+    void dir_cache_detach(dir_handle_t *d);
+    int dir_read_info(dir_handle_t *d, struct lfs_info *info);
 
     // thread-safe locking
     PlatformMutex _mutex;
@@ -0,0 +1,544 @@
+/*
+ * Copyright (c) 2019 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ----------------------------------------------------------- Includes -----------------------------------------------------------
+
+#include "CachedKVStore.h"
+
+#include "mbed_error.h"
+#include <algorithm>
+#include <string.h>
+#include <stdio.h>
+
+using namespace mbed;
+
+// --------------------------------------------------------- Definitions ----------------------------------------------------------
+
+// cache entry (last_used of 0 marks an unused entry)
+typedef struct {
+    uint32_t hash;
+    uint32_t last_used;
+    uint32_t flags;
+    size_t size;
+    bool has_data;
+    char key[KVStore::MAX_KEY_SIZE + 1];
+    uint8_t *data;
+} cache_entry_t;
+
+// incremental set handle
+typedef struct {
+    KVStore::set_handle_t underlying_handle;
+    char key[KVStore::MAX_KEY_SIZE + 1];
+} inc_set_handle_t;
+
+// -------------------------------------------------- Functions Implementation ----------------------------------------------------
+
+static uint32_t key_name_hash(const char *key)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    while (*key) {
+        hash = (hash ^ static_cast<uint8_t>(*key++)) * 16777619UL;
+    }
+    return hash;
+}
+
+
+// Class member functions
+
+CachedKVStore::CachedKVStore(KVStore *underlying_kv, size_t num_entries, size_t max_value_size,
+                             const char *excluded_prefix) :
+    _is_initialized(false), _underlying_kv(underlying_kv), _num_entries(num_entries),
+    _max_value_size(max_value_size), _excluded_prefix(excluded_prefix), _cache(0), _cache_data(0),
+    _cache_tick(0)
+{
+}
+
+CachedKVStore::~CachedKVStore()
+{
+    deinit();
+}
+
+bool CachedKVStore::is_cacheable_key(const char *key)
+{
+    if (!_cache) {
+        return false;
+    }
+
+    if (_excluded_prefix && _excluded_prefix[0] && !strncmp(key, _excluded_prefix, strlen(_excluded_prefix))) {
+        return false;
+    }
+
+    return true;
+}
+
+void *CachedKVStore::get_entry(const char *key)
+{
+    cache_entry_t *cache = static_cast<cache_entry_t *>(_cache);
+    cache_entry_t *entry = 0;
+    uint32_t hash = key_name_hash(key);
+
+    // Look for key, or else for the least recently used entry
+    for (size_t i = 0; i < _num_entries; i++) {
+        if (cache[i].last_used && (cache[i].hash == hash) && !strcmp(cache[i].key, key)) {
+            entry = &cache[i];
+            break;
+        }
+        if (!entry || (cache[i].last_used < entry->last_used)) {
+            entry = &cache[i];
+        }
+    }
+
+    if (!entry->last_used || (entry->hash != hash) || strcmp(entry->key, key)) {
+        entry->last_used = 0;
+        entry->hash = hash;
+        entry->has_data = false;
+        strcpy(entry->key, key);
+    }
+
+    // Tick wrap can only make eviction order imperfect (just keep 0 for unused entries)
+    if (!++_cache_tick) {
+        _cache_tick = 1;
+    }
+    return entry;
+}
+
+int CachedKVStore::lookup(const char *key, void **entry)
+{
+    int ret;
+    info_t info;
+    size_t actual_size;
+    cache_entry_t *cache_entry = static_cast<cache_entry_t *>(get_entry(key));
+
+    if (!cache_entry->last_used) {
+        ret = _underlying_kv->get_info(key, &info);
+        if (ret) {
+            return ret;
+        }
+
+        cache_entry->size = info.size;
+        cache_entry->flags = info.flags;
+
+        // Only remember size and flags of values too large or secret to cache, so their gets
+        // go straight to the underlying KVStore
+        if ((info.size <= _max_value_size) && !(info.flags & REQUIRE_CONFIDENTIALITY_FLAG)) {
+            ret = _underlying_kv->get(key, cache_entry->data, _max_value_size, &actual_size);
+            if (ret) {
+                return ret;
+            }
+            if (actual_size != info.size) {
+                return MBED_ERROR_FAILED_OPERATION;
+            }
+            cache_entry->has_data = true;
+        }
+    }
+
+    cache_entry->last_used = _cache_tick;
+    *entry = cache_entry;
+    return MBED_SUCCESS;
+}
+
+void CachedKVStore::invalidate(const char *key)
+{
+    cache_entry_t *cache = static_cast<cache_entry_t *>(_cache);
+    uint32_t hash;
+
+    if (!cache) {
+        return;
+    }
+
+    hash = key_name_hash(key);
+    for (size_t i = 0; i < _num_entries; i++) {
+        if (cache[i].last_used && (cache[i].hash == hash) && !strcmp(cache[i].key, key)) {
+            cache[i].last_used = 0;
+            cache[i].has_data = false;
+            memset(cache[i].data, 0, _max_value_size);
+            break;
+        }
+    }
+}
+
+void CachedKVStore::clear_cache()
+{
+    cache_entry_t *cache = static_cast<cache_entry_t *>(_cache);
+
+    if (cache) {
+        for (size_t i = 0; i < _num_entries; i++) {
+            cache[i].last_used = 0;
+            cache[i].has_data = false;
+        }
+        memset(_cache_data, 0, _num_entries * _max_value_size);
+    }
+    _cache_tick = 0;
+}
+
+int CachedKVStore::init()
+{
+    int ret = MBED_SUCCESS;
+    cache_entry_t *cache;
+
+    _mutex.lock();
+
+    if (_is_initialized) {
+        goto end;
+    }
+
+    ret = _underlying_kv->init();
+    if (ret) {
+        goto end;
+    }
+
+    if (_num_entries && _max_value_size) {
+        cache = new cache_entry_t[_num_entries];
+        _cache_data = new uint8_t[_num_entries * _max_value_size];
+        for (size_t i = 0; i < _num_entries; i++) {
+            cache[i].data = _cache_data + i * _max_value_size;
+        }
+        _cache = cache;
+        clear_cache();
+    }
+
+    _is_initialized = true;
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int CachedKVStore::deinit()
+{
+    int ret = MBED_SUCCESS;
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        goto end;
+    }
+
+    clear_cache();
+    delete[] static_cast<cache_entry_t *>(_cache);
+    delete[] _cache_data;
+    _cache = 0;
+    _cache_data = 0;
+
+    ret = _underlying_kv->deinit();
+
+    _is_initialized = false;
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int CachedKVStore::reset()
+{
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+    clear_cache();
+    ret = _underlying_kv->reset();
+    _mutex.unlock();
+    return ret;
+}
+
+int CachedKVStore::set(const char *key, const void *buffer, size_t size, uint32_t create_flags)
+{
+    int ret;
+    cache_entry_t *entry;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    ret = _underlying_kv->set(key, buffer, size, create_flags);
+
+    if (!is_cacheable_key(key)) {
+        goto end;
+    }
+
+    if (ret) {
+        // Don't guess what the underlying KVStore is left with
+        invalidate(key);
+        goto end;
+    }
+
+    // Write through: the cache holds what was just written, unless it's too large or secret
+    entry = static_cast<cache_entry_t *>(get_entry(key));
+    entry->size = size;
+    entry->flags = create_flags;
+    entry->has_data = false;
+    if ((size <= _max_value_size) && !(create_flags & REQUIRE_CONFIDENTIALITY_FLAG)) {
+        if (size) {
+            memcpy(entry->data, buffer, size);
+        }
+        entry->has_data = true;
+    }
+    entry->last_used = _cache_tick;
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int CachedKVStore::get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size,
+                       size_t offset)
+{
+    int ret;
+    cache_entry_t *entry;
+    size_t copy_size;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    if (!is_cacheable_key(key)) {
+        ret = _underlying_kv->get(key, buffer, buffer_size, actual_size, offset);
+        goto end;
+    }
+
+    ret = lookup(key, reinterpret_cast<void **>(&entry));
+    if (ret) {
+        goto end;
+    }
+
+    if (!entry->has_data) {
+        ret = _underlying_kv->get(key, buffer, buffer_size, actual_size, offset);
+        goto end;
+    }
+
+    if (offset > entry->size) {
+        ret = MBED_ERROR_INVALID_SIZE;
+        goto end;
+    }
+
+    copy_size = std::min(buffer_size, entry->size - offset);
+    if (copy_size) {
+        if (!buffer) {
+            ret = MBED_ERROR_INVALID_ARGUMENT;
+            goto end;
+        }
+        memcpy(buffer, entry->data + offset, copy_size);
+    }
+    if (actual_size) {
+        *actual_size = copy_size;
+    }
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int CachedKVStore::get_info(const char *key, info_t *info)
+{
+    int ret;
+    cache_entry_t *entry;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    if (!is_cacheable_key(key)) {
+        ret = _underlying_kv->get_info(key, info);
+        goto end;
+    }
+
+    ret = lookup(key, reinterpret_cast<void **>(&entry));
+    if (ret) {
+        goto end;
+    }
+
+    if (info) {
+        info->size = entry->size;
+        info->flags = entry->flags;
+    }
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int CachedKVStore::remove(const char *key)
+{
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+    ret = _underlying_kv->remove(key);
+    invalidate(key);
+    _mutex.unlock();
+    return ret;
+}
+
+int CachedKVStore::set_batch(const batch_item_t *items, size_t num_items)
+{
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+
+    ret = _underlying_kv->set_batch(items, num_items);
+
+    // Some items may have been set even on failure
+    for (size_t i = 0; i < num_items; i++) {
+        if (is_valid_key(items[i].key)) {
+            invalidate(items[i].key);
+        }
+    }
+
+    _mutex.unlock();
+    return ret;
+}
+
+int CachedKVStore::set_start(set_handle_t *handle, const char *key, size_t final_data_size,
+                             uint32_t create_flags)
+{
+    int ret;
+    inc_set_handle_t *ih;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!handle || !is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    ih = new inc_set_handle_t;
+    strcpy(ih->key, key);
+
+    // Underlying KVStore may hold its own lock until set_finalize, so don't call it with ours held
+    _mutex.lock();
+    invalidate(key);
+    _mutex.unlock();
+
+    ret = _underlying_kv->set_start(&ih->underlying_handle, key, final_data_size, create_flags);
+    if (ret) {
+        delete ih;
+        return ret;
+    }
+
+    *handle = reinterpret_cast<set_handle_t>(ih);
+    return MBED_SUCCESS;
+}
+
+int CachedKVStore::set_add_data(set_handle_t handle, const void *value_data, size_t data_size)
+{
+    inc_set_handle_t *ih = reinterpret_cast<inc_set_handle_t *>(handle);
+
+    if (!ih) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    return _underlying_kv->set_add_data(ih->underlying_handle, value_data, data_size);
+}
+
+int CachedKVStore::set_finalize(set_handle_t handle)
+{
+    int ret;
+    inc_set_handle_t *ih = reinterpret_cast<inc_set_handle_t *>(handle);
+
+    if (!ih) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    ret = _underlying_kv->set_finalize(ih->underlying_handle);
+
+    // Drop anything read while the sequence was in progress
+    _mutex.lock();
+    invalidate(ih->key);
+    _mutex.unlock();
+
+    delete ih;
+    return ret;
+}
+
+int CachedKVStore::get_start(get_handle_t *handle, const char *key, size_t *data_size)
+{
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    return _underlying_kv->get_start(handle, key, data_size);
+}
+
+int CachedKVStore::get_data(get_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size)
+{
+    return _underlying_kv->get_data(handle, buffer, buffer_size, actual_size);
+}
+
+int CachedKVStore::get_finalize(get_handle_t handle)
+{
+    return _underlying_kv->get_finalize(handle);
+}
+
+int CachedKVStore::iterator_open(iterator_t *it, const char *prefix)
+{
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    return _underlying_kv->iterator_open(it, prefix);
+}
+
+int CachedKVStore::iterator_next(iterator_t it, char *key, size_t key_size)
+{
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    return _underlying_kv->iterator_next(it, key, key_size);
+}
+
+int CachedKVStore::iterator_close(iterator_t it)
+{
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    return _underlying_kv->iterator_close(it);
+}
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2019 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_CACHEDKVSTORE_H
+#define MBED_CACHEDKVSTORE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "KVStore.h"
+#include "PlatformMutex.h"
+
+namespace mbed {
+
+/** CachedKVStore class
+ *
+ *  RAM cache of small values over another KVStore.
+ *  Keeps the most recently read or written values in a bounded LRU, so repeated
+ *  gets of hot keys are served without going to the underlying store.
+ *  Writes go through to the underlying store, which stays the only persistent copy.
+ *  Values set with REQUIRE_CONFIDENTIALITY_FLAG and keys starting with the excluded
+ *  prefix are never held in RAM.
+ */
+
+class CachedKVStore : public KVStore {
+public:
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in]  underlying_kv        KVStore that will hold the data.
+     * @param[in]  num_entries          Number of cached values (0 disables the cache).
+     * @param[in]  max_value_size       Size of the largest value to cache.
+     * @param[in]  excluded_prefix      Prefix of keys that must not be cached (NULL for none).
+     *                                  String is not copied, so it must outlive the class.
+     *
+     * @returns none
+     */
+    CachedKVStore(KVStore *underlying_kv, size_t num_entries, size_t max_value_size,
+                  const char *excluded_prefix = NULL);
+
+    /**
+     * @brief Class destructor
+     *
+     * @returns none
+     */
+    virtual ~CachedKVStore();
+
+    /**
+     * @brief Initialize CachedKVStore class. It will also initialize the underlying KVStore.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int init();
+
+    /**
+     * @brief Deinitialize CachedKVStore class, free the cache.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int deinit();
+
+    /**
+     * @brief Reset KVStore contents (clear all keys) and the cache.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int reset();
+
+    /**
+     * @brief Set one KVStore item, given key and value. Written through to the underlying KVStore,
+     *        then cached if small enough.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  size                 Value data size.
+     * @param[in]  create_flags         Flag mask.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int set(const char *key, const void *buffer, size_t size, uint32_t create_flags);
+    using KVStore::set;
+
+    /**
+     * @brief Get one KVStore item, given key. Served from the cache when possible.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size.
+     * @param[in]  offset               Offset to read from in data.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL,
+                    size_t offset = 0);
+
+    /**
+     * @brief Get information of a given key. Served from the cache when possible.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] info                 Returned information structure containing size and flags.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int get_info(const char *key, info_t *info);
+
+    /**
+     * @brief Remove a KVStore item, given key, and drop it from the cache.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int remove(const char *key);
+
+    /**
+     * @brief Set a batch of KVStore items, dropping them from the cache.
+     *
+     * @param[in]  items                Array of items to set.
+     * @param[in]  num_items            Number of items.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int set_batch(const batch_item_t *items, size_t num_items);
+
+    /**
+     * @brief Start an incremental KVStore set sequence. Value is not cached,
+     *        the key is dropped from the cache when the sequence is finalized.
+     *
+     * @param[out] handle               Returned incremental set handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  final_data_size      Final value data size.
+     * @param[in]  create_flags         Flag mask.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int set_start(set_handle_t *handle, const char *key, size_t final_data_size, uint32_t create_flags);
+
+    /**
+     * @brief Add data to incremental KVStore set sequence.
+     *
+     * @param[in]  handle               Incremental set handle.
+     * @param[in]  value_data           value data to add.
+     * @param[in]  data_size            value data size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int set_add_data(set_handle_t handle, const void *value_data, size_t data_size);
+
+    /**
+     * @brief Finalize an incremental KVStore set sequence.
+     *
+     * @param[in]  handle               Incremental set handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int set_finalize(set_handle_t handle);
+
+    /**
+     * @brief Start a streaming KVStore get sequence on the underlying KVStore.
+     *
+     * @param[out] handle               Returned get handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] data_size            Value data size (NULL to pass nothing).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int get_start(get_handle_t *handle, const char *key, size_t *data_size = NULL);
+
+    /**
+     * @brief Read next data chunk in a streaming KVStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size (0 once all data was read).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int get_data(get_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size);
+
+    /**
+     * @brief Finalize a streaming KVStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int get_finalize(get_handle_t handle);
+
+    /**
+     * @brief Start an iteration over KVStore keys.
+     *
+     * @param[out] it                   Returned iterator handle.
+     * @param[in]  prefix               Key prefix (null for all keys).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int iterator_open(iterator_t *it, const char *prefix = NULL);
+
+    /**
+     * @brief Get next key in iteration.
+     *
+     * @param[in]  it                   Iterator handle.
+     * @param[in]  key                  Buffer for returned key.
+     * @param[in]  key_size             Key buffer size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int iterator_next(iterator_t it, char *key, size_t key_size);
+
+    /**
+     * @brief Close iteration.
+     *
+     * @param[in]  it                   Iterator handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int iterator_close(iterator_t it);
+
+#if !defined(DOXYGEN_ONLY)
+private:
+
+    PlatformMutex _mutex;
+    bool _is_initialized;
+    KVStore *_underlying_kv;
+    size_t _num_entries;
+    size_t _max_value_size;
+    const char *_excluded_prefix;
+    void *_cache;
+    uint8_t *_cache_data;
+    uint32_t _cache_tick;
+
+    /**
+     * @brief Check whether a key may be cached at all.
+     *
+     * @param[in]  key                  Key name.
+     *
+     * @returns true if key may be cached
+     */
+    bool is_cacheable_key(const char *key);
+
+    /**
+     * @brief Get cache entry for a key, either an existing one or the least recently used one
+     *        (cleared and given the key). Must be called with the mutex held.
+     *
+     * @param[in]  key                  Key name.
+     *
+     * @returns cache entry
+     */
+    void *get_entry(const char *key);
+
+    /**
+     * @brief Find cache entry of a key, or fetch it from the underlying KVStore.
+     *        Must be called with the mutex held.
+     *
+     * @param[in]  key                  Key name.
+     * @param[out] entry                Returned cache entry.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int lookup(const char *key, void **entry);
+
+    /**
+     * @brief Drop a key from the cache. Must be called with the mutex held.
+     *
+     * @param[in]  key                  Key name.
+     */
+    void invalidate(const char *key);
+
+    /**
+     * @brief Wipe the cache.
+     */
+    void clear_cache();
+#endif
+};
+/** @}*/
+
+} // namespace mbed
+
+#endif
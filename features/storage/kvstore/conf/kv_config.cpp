@@ -29,6 +29,8 @@
 #include "FlashSimBlockDevice.h"
 #include "mbed_trace.h"
 #include "SecureStore.h"
+#include "CachedKVStore.h"
+#include "platform/mbed_boot_timeline.h"
 #define TRACE_GROUP "KVCFG"
 
 #if COMPONENT_FLASHIAP
@@ -134,6 +136,17 @@ int _storage_config_FILESYSTEM_NO_RBP();
 int _storage_config_tdb_external_common();
 int _storage_config_filesystem_common();
 
+/**
+ * @brief This function puts a CachedKVStore in front of the main KVStore instance, so hot keys
+ *        are served from RAM. Does nothing unless the cache is configured.
+ *        The following is a list of configuration parameter:
+ *        MBED_CONF_KV_CONFIG_CACHE_ENTRIES - Number of cached values, 0 to disable the cache.
+ *        MBED_CONF_KV_CONFIG_CACHE_MAX_VALUE_SIZE - Size of the largest value to cache.
+ *        MBED_CONF_KV_CONFIG_CACHE_EXCLUDED_PREFIX - Prefix of keys never to cache, or NULL.
+ * @returns 0 on success or negative value on failure.
+ */
+int _storage_config_cache_main_instance();
+
 /**
  * @brief If block device out of Mbed OS tree is to support, please overwrite this
  *        function to provide it.
@@ -147,6 +160,18 @@ static const char *filesystemstore_folder_path = NULL;
 using namespace mbed;
 
 
+#ifndef MBED_CONF_KV_CONFIG_CACHE_ENTRIES
+#define MBED_CONF_KV_CONFIG_CACHE_ENTRIES 0
+#endif
+
+#ifndef MBED_CONF_KV_CONFIG_CACHE_MAX_VALUE_SIZE
+#define MBED_CONF_KV_CONFIG_CACHE_MAX_VALUE_SIZE 64
+#endif
+
+#ifndef MBED_CONF_KV_CONFIG_CACHE_EXCLUDED_PREFIX
+#define MBED_CONF_KV_CONFIG_CACHE_EXCLUDED_PREFIX NULL
+#endif
+
 static SingletonPtr<PlatformMutex> mutex;
 static bool is_kv_config_initialize = false;
 static kvstore_config_t kvstore_config;
@@ -744,6 +769,12 @@ int _storage_config_TDB_INTERNAL()
     kvstore_config.kvstore_main_instance =
         kvstore_config.internal_store;
 
+    ret = _storage_config_cache_main_instance();
+    if (ret != MBED_SUCCESS) {
+        tr_error("KV Config: Fail to init CachedKVStore.");
+        return ret;
+    }
+
     //Masking flag - Actually used to remove any KVStore flag which is not supported
     //in the chosen KVStore profile.
     kvstore_config.flags_mask = ~(KVStore::REQUIRE_CONFIDENTIALITY_FLAG |
@@ -913,6 +944,12 @@ int _storage_config_tdb_external_common()
 
     kvstore_config.kvstore_main_instance = &secst;
 
+    ret = _storage_config_cache_main_instance();
+    if (ret != MBED_SUCCESS) {
+        tr_error("KV Config: Fail to init CachedKVStore.");
+        return ret;
+    }
+
     //Init kv_map and add the configuration struct to KVStore map.
     KVMap &kv_map = KVMap::get_instance();
     ret = kv_map.init();
@@ -1095,6 +1132,12 @@ int _storage_config_filesystem_common()
 
     kvstore_config.kvstore_main_instance = &secst;
 
+    ret = _storage_config_cache_main_instance();
+    if (ret != MBED_SUCCESS) {
+        tr_error("KV Config: Fail to init CachedKVStore.");
+        return ret;
+    }
+
     //Init kv_map and add the configuration struct to KVStore map.
     KVMap &kv_map = KVMap::get_instance();
     ret = kv_map.init();
@@ -1115,6 +1158,24 @@ int _storage_config_filesystem_common()
 #endif
 }
 
+int _storage_config_cache_main_instance()
+{
+#if MBED_CONF_KV_CONFIG_CACHE_ENTRIES
+    static CachedKVStore cached_kv(kvstore_config.kvstore_main_instance,
+                                   MBED_CONF_KV_CONFIG_CACHE_ENTRIES,
+                                   MBED_CONF_KV_CONFIG_CACHE_MAX_VALUE_SIZE,
+                                   MBED_CONF_KV_CONFIG_CACHE_EXCLUDED_PREFIX);
+
+    int ret = cached_kv.init();
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    kvstore_config.kvstore_main_instance = &cached_kv;
+#endif
+    return MBED_SUCCESS;
+}
+
 int _storage_config_default()
 {
 #if COMPONENT_QSPIF || COMPONENT_SPIF || COMPONENT_DATAFLASH
@@ -1160,10 +1221,12 @@ MBED_WEAK int kv_init_storage_config()
 
     memset(&kvstore_config, 0, sizeof(kvstore_config_t));
 
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_KVSTORE_INIT_START);
     ret = _STORAGE_CONFIG(MBED_CONF_STORAGE_STORAGE_TYPE);
 
     if (ret == MBED_SUCCESS) {
         is_kv_config_initialize = true;
+        MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_KVSTORE_INIT_DONE);
     }
 
 exit:
@@ -22,6 +22,8 @@
 #include "File.h"
 #include "BlockDevice.h"
 #include "mbed_error.h"
+#include "MbedCRC.h"
+#include <algorithm>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -34,8 +36,22 @@
 
 #define FSST_DEFAULT_FOLDER_PATH "kvstore" //default FileSystemStore folder path on fs
 
+#define FSST_PACKED_MAGIC 0x46535350 // "FSSP" hex 'magic' signature
+#define FSST_PACKED_DELETE_FLAG 0x1
+
+// Packed value log and its copy while compacting, neither is a valid key
+#define FSST_PACKED_FILE_NAME "packed values"
+#define FSST_PACKED_TEMP_FILE_NAME "packed values.new"
+
+// Compact the log once it holds more replaced or removed records than live ones, and at least this much
+#define FSST_PACKED_MIN_GARBAGE 1024
+
 static const uint32_t supported_flags = mbed::KVStore::WRITE_ONCE_FLAG;
 
+static const uint32_t work_buf_size = 64;
+static const uint32_t initial_crc = 0xFFFFFFFF;
+static const uint32_t packed_index_grow_size = 16;
+
 using namespace mbed;
 
 namespace {
@@ -46,23 +62,52 @@ typedef struct {
     uint32_t create_flags;
     size_t data_size;
     File *file_handle;
+    uint8_t *packed_data; // value gathered for the packed value log, file_handle is NULL
 } inc_set_handle_t;
 
 // iterator handle
 typedef struct {
     void *dir_handle;
     char *prefix;
+    uint32_t packed_ind;
 } key_iterator_handle_t;
 
+// packed value log record, followed by the key and the value
+typedef struct {
+    uint32_t magic;
+    uint16_t header_size;
+    uint8_t key_size;
+    uint8_t record_flags;
+    uint32_t user_flags;
+    uint32_t data_size;
+    uint32_t crc;
+} packed_record_t;
+
+// packed value log RAM index entry
+typedef struct {
+    uint32_t hash;
+    uint32_t offset;
+} packed_index_entry_t;
+
 } // anonymous namespace
 
 // Local Functions
 static char *string_ndup(const char *src, size_t size);
 
+static uint32_t calc_crc(uint32_t init_crc, uint32_t data_size, const void *data_buf)
+{
+    uint32_t crc;
+    MbedCRC<POLY_32BIT_ANSI, 32> ct(init_crc, 0x0, true, false);
+    ct.compute(const_cast<void *>(data_buf), data_size, &crc);
+    return crc;
+}
+
 
 // Class Functions
-FileSystemStore::FileSystemStore(FileSystem *fs) : _fs(fs),
-    _is_initialized(false)
+FileSystemStore::FileSystemStore(FileSystem *fs, size_t packed_max_value_size) : _fs(fs),
+    _is_initialized(false), _packed_max_value_size(packed_max_value_size), _packed_active(false),
+    _packed_path(NULL), _packed_index(NULL), _packed_num_keys(0), _packed_max_keys(0),
+    _packed_size(0), _packed_live_size(0)
 {
 
 }
@@ -103,6 +148,12 @@ int FileSystemStore::init()
         }
     }
 
+    status = _packed_init();
+    if (status != MBED_SUCCESS) {
+        tr_error("KV Dir: %s, packed value log failed: %d", _cfg_fs_path, status);
+        goto exit_point;
+    }
+
     _is_initialized = true;
 exit_point:
 
@@ -116,6 +167,7 @@ int FileSystemStore::deinit()
 {
     _mutex.lock();
     _is_initialized = false;
+    _packed_deinit();
     delete[] _cfg_fs_path;
     delete[] _full_path_key;
     _mutex.unlock();
@@ -141,6 +193,9 @@ int FileSystemStore::reset()
         if (dir_ent.d_type != DT_REG) {
             continue;
         }
+        if (strcmp(dir_ent.d_name, FSST_PACKED_FILE_NAME) == 0) {
+            continue;
+        }
         // Build File's full path name and delete it (even if write-onced)
         _build_full_path_key(dir_ent.d_name);
         _fs->remove(_full_path_key);
@@ -148,6 +203,17 @@ int FileSystemStore::reset()
 
     kv_dir.close();
 
+    if (_packed_active) {
+        _packed_file.close();
+        if (_packed_file.open(_fs, _packed_path, O_RDWR | O_CREAT | O_TRUNC) != 0) {
+            _packed_active = false;
+            status = MBED_ERROR_FAILED_OPERATION;
+        }
+        _packed_num_keys = 0;
+        _packed_size = 0;
+        _packed_live_size = 0;
+    }
+
 exit_point:
     _mutex.unlock();
     return status;
@@ -207,6 +273,35 @@ int FileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size
         goto exit_point;
     }
 
+    if (_packed_active && is_valid_key(key)) {
+        packed_index_entry_t *index = (packed_index_entry_t *)_packed_index;
+        uint32_t index_ind, hash, data_size, user_flags, record_size, data_offset;
+
+        status = _packed_find(key, index_ind, hash, data_size, user_flags, record_size);
+        if (status == MBED_SUCCESS) {
+            if (offset > data_size) {
+                status = MBED_ERROR_INVALID_SIZE;
+                goto exit_point;
+            }
+            value_actual_size = std::min(buffer_size, (size_t)(data_size - offset));
+            if ((buffer == NULL) && (value_actual_size > 0)) {
+                status = MBED_ERROR_INVALID_DATA_DETECTED;
+                goto exit_point;
+            }
+            if (actual_size != NULL) {
+                *actual_size = value_actual_size;
+            }
+            data_offset = index[index_ind].offset + record_size - data_size + offset;
+            if ((_packed_file.seek(data_offset, SEEK_SET) != (off_t)data_offset) ||
+                    (_packed_file.read(buffer, value_actual_size) != (ssize_t)value_actual_size)) {
+                status = MBED_ERROR_FAILED_OPERATION;
+            }
+            goto exit_point;
+        } else if (status != MBED_ERROR_ITEM_NOT_FOUND) {
+            goto exit_point;
+        }
+    }
+
     key_metadata_t key_metadata;
 
     if ((status = _verify_key_file(key, &key_metadata, &kv_file)) != MBED_SUCCESS) {
@@ -259,6 +354,21 @@ int FileSystemStore::get_info(const char *key, info_t *info)
         goto exit_point;
     }
 
+    if (_packed_active && is_valid_key(key)) {
+        uint32_t index_ind, hash, data_size, user_flags, record_size;
+
+        status = _packed_find(key, index_ind, hash, data_size, user_flags, record_size);
+        if (status == MBED_SUCCESS) {
+            if (info != NULL) {
+                info->size = data_size;
+                info->flags = user_flags;
+            }
+            goto exit_point;
+        } else if (status != MBED_ERROR_ITEM_NOT_FOUND) {
+            goto exit_point;
+        }
+    }
+
     key_metadata_t key_metadata;
 
     if ((status = _verify_key_file(key, &key_metadata, &kv_file)) != MBED_SUCCESS) {
@@ -295,6 +405,23 @@ int FileSystemStore::remove(const char *key)
         goto exit_point;
     }
 
+    if (_packed_active && is_valid_key(key)) {
+        uint32_t index_ind, hash, data_size, user_flags, record_size;
+
+        status = _packed_find(key, index_ind, hash, data_size, user_flags, record_size);
+        if (status == MBED_SUCCESS) {
+            if (user_flags & KVStore::WRITE_ONCE_FLAG) {
+                tr_error("Key: %s, Exists but write protected", key);
+                status = MBED_ERROR_WRITE_PROTECTED;
+            } else {
+                status = _packed_append(key, NULL, 0, 0, FSST_PACKED_DELETE_FLAG);
+            }
+            goto exit_point;
+        } else if (status != MBED_ERROR_ITEM_NOT_FOUND) {
+            goto exit_point;
+        }
+    }
+
     /* If File Exists and is Valid, then check its Write Once Flag to verify its disabled before removing */
     /* If File exists and is not valid, or is Valid and not Write-Onced then remove it */
     if ((status = _verify_key_file(key, &key_metadata, &kv_file)) == MBED_SUCCESS) {
@@ -327,6 +454,10 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
     File *kv_file;
     key_metadata_t key_metadata;
     int key_len = 0;
+    bool key_file_exists;
+    bool packed_key_exists = false;
+    bool packed = false;
+    uint32_t index_ind, hash, data_size, user_flags, record_size;
 
     if (create_flags & ~supported_flags) {
         return MBED_ERROR_INVALID_ARGUMENT;
@@ -360,31 +491,72 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
     }
 
     /* For Success (not write_once) and for corrupted data close file before recreating it as a new file */
-    if (status != MBED_ERROR_ITEM_NOT_FOUND) {
+    key_file_exists = (status != MBED_ERROR_ITEM_NOT_FOUND);
+    if (key_file_exists) {
         kv_file->close();
     }
 
-    if ((status = kv_file->open(_fs, _full_path_key, O_WRONLY | O_CREAT | O_TRUNC)) != MBED_SUCCESS) {
-        tr_info("set_start failed to open: %s, for writing, err: %d", _full_path_key, status);
-        status = MBED_ERROR_FAILED_OPERATION ;
-        goto exit_point;
+    if (_packed_active) {
+        status = _packed_find(key, index_ind, hash, data_size, user_flags, record_size);
+        if (status == MBED_SUCCESS) {
+            if (user_flags & KVStore::WRITE_ONCE_FLAG) {
+                status = MBED_ERROR_WRITE_PROTECTED;
+                goto exit_point;
+            }
+            packed_key_exists = true;
+        } else if (status != MBED_ERROR_ITEM_NOT_FOUND) {
+            goto exit_point;
+        }
+        status = MBED_SUCCESS;
+        packed = _packed_max_value_size && (final_data_size <= _packed_max_value_size);
+    }
+
+    if (packed) {
+        /* Value is gathered in RAM and appended to the packed value log by set_finalize */
+        if (key_file_exists && (_fs->remove(_full_path_key) != 0)) {
+            status = MBED_ERROR_FAILED_OPERATION;
+            goto exit_point;
+        }
+    } else {
+        if (packed_key_exists) {
+            status = _packed_append(key, NULL, 0, 0, FSST_PACKED_DELETE_FLAG);
+            if (status != MBED_SUCCESS) {
+                goto exit_point;
+            }
+            /* Compacting the log may have used the key path */
+            _build_full_path_key(key);
+        }
+
+        if ((status = kv_file->open(_fs, _full_path_key, O_WRONLY | O_CREAT | O_TRUNC)) != MBED_SUCCESS) {
+            tr_info("set_start failed to open: %s, for writing, err: %d", _full_path_key, status);
+            status = MBED_ERROR_FAILED_OPERATION ;
+            goto exit_point;
+        }
     }
     _cur_inc_data_size = 0;
 
     set_handle = new inc_set_handle_t;
     set_handle->create_flags = create_flags;
     set_handle->data_size = final_data_size;
-    set_handle->file_handle = kv_file;
+    set_handle->file_handle = NULL;
+    set_handle->packed_data = NULL;
     key_len = strlen(key);
     set_handle->key = string_ndup(key, key_len);
     *handle = (set_handle_t)set_handle;
     _cur_inc_set_handle = *handle;
 
-    key_metadata.magic = FSST_MAGIC;
-    key_metadata.metadata_size = sizeof(key_metadata_t);
-    key_metadata.revision = FSST_REVISION;
-    key_metadata.user_flags = create_flags;
-    kv_file->write(&key_metadata, sizeof(key_metadata_t));
+    if (packed) {
+        set_handle->packed_data = new uint8_t[final_data_size];
+        delete kv_file;
+    } else {
+        set_handle->file_handle = kv_file;
+
+        key_metadata.magic = FSST_MAGIC;
+        key_metadata.metadata_size = sizeof(key_metadata_t);
+        key_metadata.revision = FSST_REVISION;
+        key_metadata.user_flags = create_flags;
+        kv_file->write(&key_metadata, sizeof(key_metadata_t));
+    }
 
 exit_point:
     if (status != MBED_SUCCESS) {
@@ -417,7 +589,14 @@ int FileSystemStore::set_add_data(set_handle_t handle, const void *value_data, s
 
     kv_file = set_handle->file_handle;
 
-    added_data = kv_file->write(value_data, data_size);
+    if (kv_file == NULL) {
+        if (data_size) {
+            memcpy(set_handle->packed_data + _cur_inc_data_size, value_data, data_size);
+        }
+        added_data = data_size;
+    } else {
+        added_data = kv_file->write(value_data, data_size);
+    }
     if (added_data != data_size) {
         status = MBED_ERROR_FAILED_OPERATION ;
     }
@@ -450,13 +629,21 @@ int FileSystemStore::set_finalize(set_handle_t handle)
             tr_error("Accumulated Data (%d) size doesn't match set_start final size (%d) - file: %s", _cur_inc_data_size,
                      set_handle->data_size, _full_path_key);
             status = MBED_ERROR_INVALID_SIZE;
-            _fs->remove(_full_path_key);
+            if (set_handle->file_handle != NULL) {
+                _fs->remove(_full_path_key);
+            }
+        } else if (set_handle->file_handle == NULL) {
+            status = _packed_append(set_handle->key, set_handle->packed_data, set_handle->data_size,
+                                    set_handle->create_flags, 0);
         }
         delete[] set_handle->key;
     }
 
-    set_handle->file_handle->close();
-    delete set_handle->file_handle;
+    if (set_handle->file_handle != NULL) {
+        set_handle->file_handle->close();
+        delete set_handle->file_handle;
+    }
+    delete[] set_handle->packed_data;
     delete set_handle;
     _cur_inc_data_size = 0;
     _cur_inc_set_handle = NULL;
@@ -487,6 +674,7 @@ int FileSystemStore::iterator_open(iterator_t *it, const char *prefix)
     key_it = new key_iterator_handle_t;
     key_it->dir_handle = NULL;
     key_it->prefix = NULL;
+    key_it->packed_ind = 0;
     if (prefix != NULL) {
         key_it->prefix = string_ndup(prefix, KVStore::MAX_KEY_SIZE);
     }
@@ -539,11 +727,39 @@ int FileSystemStore::iterator_next(iterator_t it, char *key, size_t key_size)
 
     kv_dir = (Dir *)key_it->dir_handle;
 
+    // Keys of the packed value log come first
+    while (key_it->packed_ind < _packed_num_keys) {
+        packed_index_entry_t *index = (packed_index_entry_t *)_packed_index;
+        char packed_key[KVStore::MAX_KEY_SIZE + 1];
+        uint32_t data_size, user_flags, record_flags, record_size;
+
+        if (_packed_read_record(index[key_it->packed_ind++].offset, packed_key, data_size, user_flags,
+                                record_flags, record_size) != MBED_SUCCESS) {
+            continue;
+        }
+
+        if ((key_it->prefix == NULL) ||
+                (strncmp(packed_key, key_it->prefix, strlen(key_it->prefix)) == 0)) {
+            if (key_name_size < strlen(packed_key)) {
+                status = MBED_ERROR_INVALID_SIZE;
+                goto exit_point;
+            }
+            strncpy(key, packed_key, key_name_size);
+            key[key_name_size - 1] = '\0';
+            status = MBED_SUCCESS;
+            goto exit_point;
+        }
+    }
+
     while (kv_dir->read(&kv_dir_ent) != 0) {
         if (kv_dir_ent.d_type != DT_REG) {
             continue;
         }
 
+        if (strncmp(kv_dir_ent.d_name, FSST_PACKED_FILE_NAME, strlen(FSST_PACKED_FILE_NAME)) == 0) {
+            continue;
+        }
+
         if ((key_it->prefix == NULL) ||
                 (strncmp(kv_dir_ent.d_name, key_it->prefix, strlen(key_it->prefix)) == 0)) {
             if (key_name_size < strlen(kv_dir_ent.d_name)) {
@@ -618,6 +834,329 @@ exit_point:
     return status;
 }
 
+int FileSystemStore::_packed_init()
+{
+    char key[KVStore::MAX_KEY_SIZE + 1];
+    uint32_t file_size, offset, data_size, user_flags, record_flags, record_size;
+    int ret;
+
+    _packed_path = new char[_cfg_fs_path_size + sizeof(FSST_PACKED_FILE_NAME) + 1];
+    sprintf(_packed_path, "%s/%s", _cfg_fs_path, FSST_PACKED_FILE_NAME);
+    _packed_num_keys = 0;
+    _packed_size = 0;
+    _packed_live_size = 0;
+
+    // A compaction cut short leaves its copy behind, which is complete
+    // only if the log was already removed to rename the copy over it
+    _build_full_path_key(FSST_PACKED_TEMP_FILE_NAME);
+    ret = _packed_file.open(_fs, _packed_path, O_RDWR);
+    if (ret == 0) {
+        _fs->remove(_full_path_key);
+    } else if (_fs->rename(_full_path_key, _packed_path) == 0) {
+        ret = _packed_file.open(_fs, _packed_path, O_RDWR);
+    }
+
+    if (ret != 0) {
+        // Values already in the log stay readable when packing is disabled
+        if (!_packed_max_value_size) {
+            return MBED_SUCCESS;
+        }
+        if (_packed_file.open(_fs, _packed_path, O_RDWR | O_CREAT) != 0) {
+            return MBED_ERROR_FAILED_OPERATION;
+        }
+    }
+
+    _packed_active = true;
+    _packed_max_keys = packed_index_grow_size;
+    _packed_index = new packed_index_entry_t[_packed_max_keys];
+
+    // Replay the log up to the first record a power loss cut short
+    file_size = _packed_file.size();
+    offset = 0;
+    while (offset < file_size) {
+        if (_packed_read_record(offset, key, data_size, user_flags, record_flags, record_size) != MBED_SUCCESS) {
+            break;
+        }
+        ret = _packed_update_index(key, offset, record_size, record_flags & FSST_PACKED_DELETE_FLAG);
+        if (ret != MBED_SUCCESS) {
+            return ret;
+        }
+        offset += record_size;
+    }
+    _packed_size = offset;
+
+    // Rewrite the log without the broken records, so appends can follow the last good one
+    if (_packed_size < file_size) {
+        tr_warning("KV packed value log: dropping %lu bytes of broken records", (unsigned long)(file_size - _packed_size));
+        ret = _packed_compact();
+        if (ret != MBED_SUCCESS) {
+            return ret;
+        }
+    }
+
+    tr_info("KV packed value log: %lu keys, %lu of %lu bytes live", (unsigned long)_packed_num_keys,
+            (unsigned long)_packed_live_size, (unsigned long)_packed_size);
+    return MBED_SUCCESS;
+}
+
+void FileSystemStore::_packed_deinit()
+{
+    if (_packed_active) {
+        _packed_file.close();
+        _packed_active = false;
+    }
+    delete[](packed_index_entry_t *)_packed_index;
+    _packed_index = NULL;
+    _packed_num_keys = 0;
+    _packed_max_keys = 0;
+    delete[] _packed_path;
+    _packed_path = NULL;
+}
+
+int FileSystemStore::_packed_read_record(uint32_t offset, char *key, uint32_t &data_size, uint32_t &user_flags,
+                                         uint32_t &record_flags, uint32_t &record_size)
+{
+    packed_record_t header;
+    uint8_t buf[work_buf_size];
+    uint32_t crc, remaining, chunk;
+
+    if ((_packed_file.seek(offset, SEEK_SET) != (off_t)offset) ||
+            (_packed_file.read(&header, sizeof(header)) != sizeof(header))) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    if ((header.magic != FSST_PACKED_MAGIC) || (header.header_size != sizeof(header)) ||
+            !header.key_size || (header.key_size > KVStore::MAX_KEY_SIZE)) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    if (_packed_file.read(key, header.key_size) != header.key_size) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+    key[header.key_size] = '\0';
+
+    crc = calc_crc(initial_crc, sizeof(header) - sizeof(header.crc), &header);
+    crc = calc_crc(crc, header.key_size, key);
+    remaining = header.data_size;
+    while (remaining) {
+        chunk = std::min(remaining, work_buf_size);
+        if (_packed_file.read(buf, chunk) != (ssize_t)chunk) {
+            return MBED_ERROR_FAILED_OPERATION;
+        }
+        crc = calc_crc(crc, chunk, buf);
+        remaining -= chunk;
+    }
+
+    if (crc != header.crc) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    data_size = header.data_size;
+    user_flags = header.user_flags;
+    record_flags = header.record_flags;
+    record_size = sizeof(header) + header.key_size + header.data_size;
+    return MBED_SUCCESS;
+}
+
+int FileSystemStore::_packed_find(const char *key, uint32_t &index_ind, uint32_t &hash, uint32_t &data_size,
+                                  uint32_t &user_flags, uint32_t &record_size)
+{
+    packed_index_entry_t *index = (packed_index_entry_t *)_packed_index;
+    char entry_key[KVStore::MAX_KEY_SIZE + 1];
+    uint32_t record_flags;
+    uint32_t low = 0, high = _packed_num_keys;
+    int ret;
+
+    hash = calc_crc(initial_crc, strlen(key), key);
+
+    // Index is kept sorted by hash, so binary search for the first entry whose
+    // hash isn't smaller than ours. This is also the insertion point if not found.
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+        if (index[mid].hash < hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    index_ind = low;
+
+    // Several keys may share the same hash - go over all of them
+    for (uint32_t ind = low; (ind < _packed_num_keys) && (index[ind].hash == hash); ind++) {
+        ret = _packed_read_record(index[ind].offset, entry_key, data_size, user_flags, record_flags, record_size);
+        if (ret != MBED_SUCCESS) {
+            return ret;
+        }
+        if (strcmp(entry_key, key) == 0) {
+            index_ind = ind;
+            return MBED_SUCCESS;
+        }
+    }
+
+    return MBED_ERROR_ITEM_NOT_FOUND;
+}
+
+int FileSystemStore::_packed_update_index(const char *key, uint32_t offset, uint32_t record_size, bool removed)
+{
+    packed_index_entry_t *index = (packed_index_entry_t *)_packed_index;
+    uint32_t index_ind, hash, data_size, user_flags, old_record_size;
+
+    int ret = _packed_find(key, index_ind, hash, data_size, user_flags, old_record_size);
+    if (ret == MBED_SUCCESS) {
+        _packed_live_size -= old_record_size;
+        if (removed) {
+            memmove(&index[index_ind], &index[index_ind + 1],
+                    sizeof(packed_index_entry_t) * (_packed_num_keys - index_ind - 1));
+            _packed_num_keys--;
+            return MBED_SUCCESS;
+        }
+    } else if (ret != MBED_ERROR_ITEM_NOT_FOUND) {
+        return ret;
+    } else if (removed) {
+        return MBED_SUCCESS;
+    } else {
+        if (_packed_num_keys == _packed_max_keys) {
+            packed_index_entry_t *new_index = new packed_index_entry_t[_packed_max_keys + packed_index_grow_size];
+            memcpy(new_index, index, sizeof(packed_index_entry_t) * _packed_num_keys);
+            delete[] index;
+            _packed_index = index = new_index;
+            _packed_max_keys += packed_index_grow_size;
+        }
+        memmove(&index[index_ind + 1], &index[index_ind],
+                sizeof(packed_index_entry_t) * (_packed_num_keys - index_ind));
+        _packed_num_keys++;
+        index[index_ind].hash = hash;
+    }
+
+    index[index_ind].offset = offset;
+    _packed_live_size += record_size;
+    return MBED_SUCCESS;
+}
+
+int FileSystemStore::_packed_append(const char *key, const void *data, uint32_t data_size, uint32_t user_flags,
+                                    uint32_t record_flags)
+{
+    packed_record_t header;
+    uint32_t key_size = strlen(key);
+    uint32_t offset = _packed_size;
+    uint32_t garbage;
+    int ret;
+
+    header.magic = FSST_PACKED_MAGIC;
+    header.header_size = sizeof(header);
+    header.key_size = key_size;
+    header.record_flags = record_flags;
+    header.user_flags = user_flags;
+    header.data_size = data_size;
+    header.crc = calc_crc(initial_crc, sizeof(header) - sizeof(header.crc), &header);
+    header.crc = calc_crc(header.crc, key_size, key);
+    if (data_size) {
+        header.crc = calc_crc(header.crc, data_size, data);
+    }
+
+    if ((_packed_file.seek(offset, SEEK_SET) != (off_t)offset) ||
+            (_packed_file.write(&header, sizeof(header)) != sizeof(header)) ||
+            (_packed_file.write(key, key_size) != (ssize_t)key_size) ||
+            (data_size && (_packed_file.write(data, data_size) != (ssize_t)data_size)) ||
+            (_packed_file.sync() != 0)) {
+        // The next record is written over what was written of this one
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+    _packed_size += sizeof(header) + key_size + data_size;
+
+    ret = _packed_update_index(key, offset, sizeof(header) + key_size + data_size,
+                               record_flags & FSST_PACKED_DELETE_FLAG);
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    garbage = _packed_size - _packed_live_size;
+    if ((garbage >= FSST_PACKED_MIN_GARBAGE) && (garbage > _packed_live_size)) {
+        // The record is in the log either way, so a failed compaction isn't an error
+        ret = _packed_compact();
+        if (ret != MBED_SUCCESS) {
+            tr_warning("KV packed value log: compaction failed: %d", ret);
+        }
+    }
+
+    return MBED_SUCCESS;
+}
+
+int FileSystemStore::_packed_compact()
+{
+    packed_index_entry_t *index = (packed_index_entry_t *)_packed_index;
+    uint32_t *new_offsets = new uint32_t[_packed_num_keys];
+    uint8_t buf[work_buf_size];
+    uint32_t new_offset = 0, remaining, chunk;
+    packed_record_t header;
+    File new_file;
+    bool replaced;
+    int ret = MBED_ERROR_FAILED_OPERATION;
+
+    _build_full_path_key(FSST_PACKED_TEMP_FILE_NAME);
+    if (new_file.open(_fs, _full_path_key, O_WRONLY | O_CREAT | O_TRUNC) != 0) {
+        goto exit_point;
+    }
+
+    // Copy the indexed records, which were all verified when read or written
+    for (uint32_t ind = 0; ind < _packed_num_keys; ind++) {
+        if ((_packed_file.seek(index[ind].offset, SEEK_SET) != (off_t)index[ind].offset) ||
+                (_packed_file.read(&header, sizeof(header)) != sizeof(header)) ||
+                (new_file.write(&header, sizeof(header)) != sizeof(header))) {
+            goto exit_point;
+        }
+        new_offsets[ind] = new_offset;
+        new_offset += sizeof(header) + header.key_size + header.data_size;
+
+        remaining = header.key_size + header.data_size;
+        while (remaining) {
+            chunk = std::min(remaining, work_buf_size);
+            if ((_packed_file.read(buf, chunk) != (ssize_t)chunk) ||
+                    (new_file.write(buf, chunk) != (ssize_t)chunk)) {
+                goto exit_point;
+            }
+            remaining -= chunk;
+        }
+    }
+
+    if (new_file.close() != 0) {
+        goto exit_point;
+    }
+
+    // Replace the log. File systems that can't rename over a file (FAT) need
+    // it removed first, init finishes the rename if power is lost in between.
+    _packed_file.close();
+    replaced = (_fs->rename(_full_path_key, _packed_path) == 0) ||
+               ((_fs->remove(_packed_path) == 0) && (_fs->rename(_full_path_key, _packed_path) == 0));
+    if (_packed_file.open(_fs, _packed_path, O_RDWR) != 0) {
+        // Nothing is lost on storage, init recovers the log
+        tr_error("KV packed value log: failed to reopen the log");
+        _packed_active = false;
+        _packed_num_keys = 0;
+        goto exit_point;
+    }
+    if (!replaced) {
+        goto exit_point;
+    }
+
+    for (uint32_t ind = 0; ind < _packed_num_keys; ind++) {
+        index[ind].offset = new_offsets[ind];
+    }
+    _packed_size = new_offset;
+    _packed_live_size = new_offset;
+    ret = MBED_SUCCESS;
+
+exit_point:
+    if (ret != MBED_SUCCESS) {
+        new_file.close();
+        if (_packed_active) {
+            _fs->remove(_full_path_key);
+        }
+    }
+    delete[] new_offsets;
+    return ret;
+}
+
 int FileSystemStore::_build_full_path_key(const char *key_src)
 {
     strncpy(&_full_path_key[_cfg_fs_path_size + 1/* for path's \ */], key_src, KVStore::MAX_KEY_SIZE);
@@ -20,6 +20,11 @@
 
 #include "KVStore.h"
 #include "FileSystem.h"
+#include "File.h"
+
+#ifndef MBED_CONF_FILESYSTEMSTORE_PACKED_MAX_VALUE_SIZE
+#define MBED_CONF_FILESYSTEMSTORE_PACKED_MAX_VALUE_SIZE 0
+#endif
 
 namespace mbed {
 
@@ -27,6 +32,12 @@ namespace mbed {
  *  This class implements the KVStore interface to
  *  create a key value store over FileSystem.
  *
+ *  Each key is stored in its own file, unless packed values are enabled:
+ *  values up to a given size are then appended to a single log file and
+ *  found through an index kept in RAM. Setting such a value is one append
+ *  instead of creating a file, and the log is compacted once most of it
+ *  holds replaced or removed values. Larger values keep their own file.
+ *
  *  @code
  *  ...
  *  @endcode
@@ -36,9 +47,11 @@ class FileSystemStore : public KVStore {
 public:
     /** Create FileSystemStore - A Key Value API on top of FS
      *
-     *  @param fs File system (FAT/LITTLE) on top of which FileSystemStore is adding KV API
+     *  @param fs                     File system (FAT/LITTLE) on top of which FileSystemStore is adding KV API
+     *  @param packed_max_value_size  Size of the largest value kept in the packed value log,
+     *                                0 stores every value in its own file
      */
-    FileSystemStore(FileSystem *fs);
+    FileSystemStore(FileSystem *fs, size_t packed_max_value_size = MBED_CONF_FILESYSTEMSTORE_PACKED_MAX_VALUE_SIZE);
 
     /** Destroy FileSystemStore instance
      *
@@ -86,6 +99,7 @@ public:
      *          MBED_ERROR_WRITE_PROTECTED          Already stored with "write once" flag.
      */
     virtual int set(const char *key, const void *buffer, size_t size, uint32_t create_flags);
+    using KVStore::set;
 
     /**
       * @brief Get one FileSystemStore item by given key.
@@ -253,6 +267,81 @@ private:
      */
     int _verify_key_file(const char *key, key_metadata_t *key_metadata, File *kv_file);
 
+    /**
+     * @brief Open the packed value log and build its RAM index
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _packed_init();
+
+    /**
+     * @brief Close the packed value log and free its RAM index
+     */
+    void _packed_deinit();
+
+    /**
+     * @brief Read a record of the packed value log, verifying it
+     *
+     * @param[in]  offset               Offset of the record in the log.
+     * @param[out] key                  Returned key, buffer of MAX_KEY_SIZE + 1 bytes.
+     * @param[out] data_size            Returned value size.
+     * @param[out] user_flags           Returned value flags.
+     * @param[out] record_flags         Returned record flags.
+     * @param[out] record_size          Returned size of the whole record.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _packed_read_record(uint32_t offset, char *key, uint32_t &data_size, uint32_t &user_flags,
+                            uint32_t &record_flags, uint32_t &record_size);
+
+    /**
+     * @brief Find a key in the packed value log
+     *
+     * @param[in]  key                  Key.
+     * @param[out] index_ind            Index entry of the key, or where to insert it if not found.
+     * @param[out] hash                 Returned hash of the key.
+     * @param[out] data_size            Returned value size.
+     * @param[out] user_flags           Returned value flags.
+     * @param[out] record_size          Returned size of the whole record.
+     *
+     * @returns 0 if found, MBED_ERROR_ITEM_NOT_FOUND or another negative error code on failure
+     */
+    int _packed_find(const char *key, uint32_t &index_ind, uint32_t &hash, uint32_t &data_size,
+                     uint32_t &user_flags, uint32_t &record_size);
+
+    /**
+     * @brief Point the RAM index at a record of the packed value log
+     *
+     * @param[in]  key                  Key of the record.
+     * @param[in]  offset               Offset of the record in the log.
+     * @param[in]  record_size          Size of the whole record.
+     * @param[in]  removed              Record removes the key.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _packed_update_index(const char *key, uint32_t offset, uint32_t record_size, bool removed);
+
+    /**
+     * @brief Append a value, or the removal of a key, to the packed value log and index it
+     *
+     * @param[in]  key                  Key.
+     * @param[in]  data                 Value data.
+     * @param[in]  data_size            Value size.
+     * @param[in]  user_flags           Value flags.
+     * @param[in]  record_flags         Record flags, marking a removal.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _packed_append(const char *key, const void *data, uint32_t data_size, uint32_t user_flags,
+                       uint32_t record_flags);
+
+    /**
+     * @brief Rewrite the packed value log with the indexed records only
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _packed_compact();
+
     FileSystem *_fs;
     PlatformMutex _mutex;
     PlatformMutex _inc_data_add_mutex;
@@ -263,6 +352,16 @@ private:
     char *_full_path_key; /* Full name of Key file currently working on */
     size_t _cur_inc_data_size; /* Amount of data added to Key file so far, during incremental add data */
     set_handle_t _cur_inc_set_handle; /* handle of currently key file under incremental set process */
+
+    size_t _packed_max_value_size; /* Largest value appended to the packed value log */
+    bool _packed_active; /* Packed value log exists and is open */
+    File _packed_file; /* Packed value log */
+    char *_packed_path; /* Full name of the packed value log */
+    void *_packed_index; /* RAM index of the packed value log, sorted by key hash */
+    uint32_t _packed_num_keys; /* Number of keys in the RAM index */
+    uint32_t _packed_max_keys; /* Capacity of the RAM index */
+    uint32_t _packed_size; /* End of the last valid record of the log */
+    uint32_t _packed_live_size; /* Size of the indexed records of the log */
 #endif
 };
 
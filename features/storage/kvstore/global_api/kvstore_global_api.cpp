@@ -30,6 +30,12 @@ struct _opaque_kv_key_iterator {
     char *path;
 };
 
+// resolved key handle
+struct _opaque_kv_key_handle {
+    kvstore_config_t *kv_config;
+    char key[KV_MAX_KEY_LENGTH + 1];
+};
+
 int kv_set(const char *full_name_key, const void *buffer, size_t size, uint32_t create_flags)
 {
     int ret = kv_init_storage_config();
@@ -181,6 +187,108 @@ int kv_iterator_close(kv_iterator_t it)
     return ret;
 }
 
+int kv_key_resolve(const char *full_name_key, kv_key_handle_t *handle)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    int ret = kv_init_storage_config();
+    if (MBED_SUCCESS != ret) {
+        return ret;
+    }
+
+    KVMap &kv_map = KVMap::get_instance();
+    kvstore_config_t *kv_config = NULL;
+    size_t key_index = 0;
+    ret = kv_map.lookup_config(full_name_key, &kv_config, &key_index);
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    if ((full_name_key == NULL) || (strlen(full_name_key + key_index) > KV_MAX_KEY_LENGTH)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    (*handle) = new _opaque_kv_key_handle;
+    (*handle)->kv_config = kv_config;
+    strcpy((*handle)->key, full_name_key + key_index);
+    return MBED_SUCCESS;
+}
+
+int kv_key_release(kv_key_handle_t handle)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    delete handle;
+    return MBED_SUCCESS;
+}
+
+int kv_handle_set(kv_key_handle_t handle, const void *buffer, size_t size, uint32_t create_flags)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    KVStore *kv_instance = handle->kv_config->kvstore_main_instance;
+    if (kv_instance == NULL) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    return kv_instance->set(handle->key, buffer, size, create_flags & handle->kv_config->flags_mask);
+}
+
+int kv_handle_get(kv_key_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    KVStore *kv_instance = handle->kv_config->kvstore_main_instance;
+    if (kv_instance == NULL) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    return kv_instance->get(handle->key, buffer, buffer_size, actual_size);
+}
+
+int kv_handle_get_info(kv_key_handle_t handle, kv_info_t *info)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    KVStore *kv_instance = handle->kv_config->kvstore_main_instance;
+    if (kv_instance == NULL) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    KVStore::info_t inner_info;
+    int ret = kv_instance->get_info(handle->key, &inner_info);
+    if (MBED_SUCCESS != ret) {
+        return ret;
+    }
+    info->flags = inner_info.flags;
+    info->size =  inner_info.size;
+    return ret;
+}
+
+int kv_handle_remove(kv_key_handle_t handle)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    KVStore *kv_instance = handle->kv_config->kvstore_main_instance;
+    if (kv_instance == NULL) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    return kv_instance->remove(handle->key);
+}
+
 int kv_reset(const char *kvstore_name)
 {
     int ret = kv_init_storage_config();
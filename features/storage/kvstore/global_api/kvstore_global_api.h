@@ -24,6 +24,7 @@ extern "C" {
 #endif
 
 typedef struct _opaque_kv_key_iterator *kv_iterator_t;
+typedef struct _opaque_kv_key_handle *kv_key_handle_t;
 
 #define KV_WRITE_ONCE_FLAG                      (1 << 0)
 #define KV_REQUIRE_CONFIDENTIALITY_FLAG         (1 << 1)
@@ -129,6 +130,72 @@ int kv_iterator_next(kv_iterator_t it, char *key, size_t key_size);
  */
 int kv_iterator_close(kv_iterator_t it);
 
+/**
+ * @brief Resolve a key path once, so its item can then be accessed by the kv_handle functions
+ *        without parsing the path and looking up the partition again.
+ *        The handle must be released before its partition is detached.
+ *
+ * @param[in]  full_name_key        /Partition_path/Key. Must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+ * @param[out] handle               Allocating key handle.
+ *                                  Do not forget to call kv_key_release
+ *                                  to deallocate the memory.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_key_resolve(const char *full_name_key, kv_key_handle_t *handle);
+
+/**
+ * @brief Deallocate a key handle.
+ *
+ * @param[in]  handle               Key handle.
+ *
+ * @returns MBED_SUCCESS on success or an error code
+ */
+int kv_key_release(kv_key_handle_t handle);
+
+/**
+ * @brief Set one KVStore item, given resolved key handle and value.
+ *
+ * @param[in]  handle               Key handle.
+ * @param[in]  buffer               Value data buffer.
+ * @param[in]  size                 Value data size.
+ * @param[in]  create_flags         Flag mask.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_handle_set(kv_key_handle_t handle, const void *buffer, size_t size, uint32_t create_flags);
+
+/**
+ * @brief Get one KVStore item by resolved key handle.
+ *
+ * @param[in]  handle               Key handle.
+ * @param[in]  buffer               Value data buffer.
+ * @param[in]  buffer_size          Value data buffer size.
+ * @param[out] actual_size          Actual read size.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_handle_get(kv_key_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size);
+
+/**
+ * @brief Get information of an item by resolved key handle. The returned info contains size and flags
+ *
+ * @param[in]  handle               Key handle.
+ * @param[out] info                 Returned information structure.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_handle_get_info(kv_key_handle_t handle, kv_info_t *info);
+
+/**
+ * @brief Remove a KVStore item by resolved key handle.
+ *
+ * @param[in]  handle               Key handle.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_handle_remove(kv_key_handle_t handle);
+
 /**
  * @brief Remove all keys and related data from a specified partition.
  *
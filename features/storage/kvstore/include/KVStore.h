@@ -20,6 +20,8 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include "mbed_error.h"
+#include "platform/Buffer.h"
 
 namespace mbed {
 
@@ -42,6 +44,8 @@ public:
 
     typedef struct _opaque_key_iterator *iterator_t;
 
+    typedef struct _opaque_get_handle *get_handle_t;
+
     /**
      * Holds key information
      */
@@ -59,6 +63,28 @@ public:
         uint32_t flags;
     } info_t;
 
+    /**
+     * Holds one item of a batch set
+     */
+    typedef struct batch_item {
+        /**
+         * The key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'
+         */
+        const char *key;
+        /**
+         * Value data buffer
+         */
+        const void *buffer;
+        /**
+         * Value data size
+         */
+        size_t size;
+        /**
+         * Flag mask
+         */
+        uint32_t create_flags;
+    } batch_item_t;
+
     virtual ~KVStore() {};
 
     /**
@@ -95,6 +121,20 @@ public:
      */
     virtual int set(const char *key, const void *buffer, size_t size, uint32_t create_flags) = 0;
 
+    /**
+     * @brief Set one KVStore item from the data viewed by a pooled buffer.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  create_flags         Flag mask.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    int set(const char *key, const Buffer &buffer, uint32_t create_flags)
+    {
+        return set(key, buffer.data(), buffer.size(), create_flags);
+    }
+
     /**
      * @brief Get one KVStore item, given key.
      *
@@ -127,6 +167,28 @@ public:
      */
     virtual int remove(const char *key) = 0;
 
+    /**
+     * @brief Set a batch of KVStore items.
+     *        Stores supporting it commit all items atomically (either all or none of them are set,
+     *        even on power loss). Default implementation sets the items one by one, stopping
+     *        at the first failure.
+     *
+     * @param[in]  items                Array of items to set.
+     * @param[in]  num_items            Number of items.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int set_batch(const batch_item_t *items, size_t num_items)
+    {
+        for (size_t i = 0; i < num_items; i++) {
+            int ret = set(items[i].key, items[i].buffer, items[i].size, items[i].create_flags);
+            if (ret) {
+                return ret;
+            }
+        }
+        return MBED_SUCCESS;
+    }
+
 
     /**
      * @brief Start an incremental KVStore set sequence.
@@ -160,6 +222,88 @@ public:
      */
     virtual int set_finalize(set_handle_t handle) = 0;
 
+    /**
+     * @brief Start a streaming KVStore get sequence.
+     *        Locates the item once, so its data can then be read chunk by chunk.
+     *        Default implementation reads the chunks using get with an offset.
+     *
+     * @param[out] handle               Returned get handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] data_size            Value data size (NULL to pass nothing).
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int get_start(get_handle_t *handle, const char *key, size_t *data_size = NULL)
+    {
+        info_t info;
+
+        if (!handle) {
+            return MBED_ERROR_INVALID_ARGUMENT;
+        }
+
+        int ret = get_info(key, &info);
+        if (ret) {
+            return ret;
+        }
+
+        default_get_handle_t *gh = new default_get_handle_t;
+        strcpy(gh->key, key);
+        gh->offset = 0;
+        gh->size = info.size;
+
+        if (data_size) {
+            *data_size = info.size;
+        }
+        *handle = reinterpret_cast<get_handle_t>(gh);
+        return MBED_SUCCESS;
+    }
+
+    /**
+     * @brief Read next data chunk in a streaming KVStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size (0 once all data was read).
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int get_data(get_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size)
+    {
+        default_get_handle_t *gh = reinterpret_cast<default_get_handle_t *>(handle);
+        size_t chunk_size = 0;
+
+        if (!gh || !actual_size) {
+            return MBED_ERROR_INVALID_ARGUMENT;
+        }
+
+        if (gh->offset < gh->size) {
+            int ret = get(gh->key, buffer, buffer_size, &chunk_size, gh->offset);
+            if (ret) {
+                return ret;
+            }
+        }
+        gh->offset += chunk_size;
+        *actual_size = chunk_size;
+        return MBED_SUCCESS;
+    }
+
+    /**
+     * @brief Finalize a streaming KVStore get sequence, releasing its handle.
+     *
+     * @param[in]  handle               Get handle.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int get_finalize(get_handle_t handle)
+    {
+        if (!handle) {
+            return MBED_ERROR_INVALID_ARGUMENT;
+        }
+        delete reinterpret_cast<default_get_handle_t *>(handle);
+        return MBED_SUCCESS;
+    }
+
     /**
      * @brief Start an iteration over KVStore keys.
      *
@@ -209,6 +353,15 @@ public:
         return true;
     }
 
+#if !defined(DOXYGEN_ONLY)
+private:
+    // Handle used by default streaming get implementation
+    typedef struct {
+        char key[MAX_KEY_SIZE + 1];
+        size_t offset;
+        size_t size;
+    } default_get_handle_t;
+#endif
 };
 /** @}*/
 
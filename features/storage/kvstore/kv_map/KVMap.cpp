@@ -23,6 +23,19 @@
 
 namespace mbed {
 
+// Hash of a partition name, which ends at a '/' or at the end of the string
+static uint32_t partition_name_hash(const char *name, size_t *name_len)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    size_t len = 0;
+    while (name[len] && (name[len] != '/')) {
+        hash = (hash ^ static_cast<uint8_t>(name[len++])) * 16777619UL;
+    }
+    *name_len = len;
+    return hash;
+}
+
 KVMap::~KVMap()
 {
     deinit();
@@ -65,10 +78,12 @@ int KVMap::attach(const char *partition_name, kvstore_config_t *kv_config)
         goto exit;
     }
 
-    kv_partition_name = new char[strlen(partition_name + 1)];
+    kv_partition_name = new char[strlen(partition_name) + 1];
     strcpy(kv_partition_name, partition_name);
     _kv_map_table[_kv_num_attached_kvs].partition_name = kv_partition_name;
     _kv_map_table[_kv_num_attached_kvs].kv_config = kv_config;
+    _kv_map_table[_kv_num_attached_kvs].partition_name_hash =
+        partition_name_hash(kv_partition_name, &_kv_map_table[_kv_num_attached_kvs].partition_name_len);
     _kv_num_attached_kvs++;
 
 exit:
@@ -167,7 +182,7 @@ exit:
 // Full name lookup and then break it into KVStore instance and key
 int KVMap::lookup(const char *full_name, KVStore **kv_instance, size_t *key_index, uint32_t *flags_mask)
 {
-    _mutex->lock();
+    _mutex->lock_shared();
 
     kvstore_config_t *kv_config;
     int ret = config_lookup(full_name, &kv_config, key_index);
@@ -181,7 +196,16 @@ int KVMap::lookup(const char *full_name, KVStore **kv_instance, size_t *key_inde
     }
 
 exit:
-    _mutex->unlock();
+    _mutex->unlock_shared();
+    return ret;
+}
+
+// Full name lookup and then break it into KVStore configuration struct and key
+int KVMap::lookup_config(const char *full_name, kvstore_config_t **kv_config, size_t *key_index)
+{
+    _mutex->lock_shared();
+    int ret = config_lookup(full_name, kv_config, key_index);
+    _mutex->unlock_shared();
     return ret;
 }
 
@@ -189,9 +213,9 @@ exit:
 int KVMap::config_lookup(const char *full_name, kvstore_config_t **kv_config, size_t *key_index)
 {
     int ret = MBED_SUCCESS;
-    int delimiter_index;
+    size_t name_len;
+    uint32_t hash;
     int i;
-    const char *delimiter_position;
 
     const char *temp_str = full_name;
 
@@ -200,30 +224,28 @@ int KVMap::config_lookup(const char *full_name, kvstore_config_t **kv_config, si
         goto exit;
     }
 
-    if (temp_str != NULL) {
-        *key_index = 0;
-        if (*temp_str == '/') {
-            temp_str++;
-            (*key_index)++;
-        }
-
-        delimiter_position = strchr(temp_str, '/');
-        if (delimiter_position == NULL) {  //delimiter not found
-            delimiter_index = -1;
-            *kv_config = _kv_map_table[0].kv_config;
-            goto exit;
-        }
-    } else {
-        delimiter_index = -1;
+    *key_index = 0;
+    if (temp_str == NULL) {
         *kv_config = _kv_map_table[0].kv_config;
         goto exit;
     }
 
+    if (*temp_str == '/') {
+        temp_str++;
+        (*key_index)++;
+    }
+
+    // Hash the partition name while looking for its delimiter
+    hash = partition_name_hash(temp_str, &name_len);
+    if (temp_str[name_len] != '/') {  //delimiter not found
+        *kv_config = _kv_map_table[0].kv_config;
+        goto exit;
+    }
 
-    delimiter_index = delimiter_position - temp_str;
     for (i = 0; i < _kv_num_attached_kvs; i++) {
 
-        if (strncmp(temp_str, _kv_map_table[i].partition_name, delimiter_index) != 0) {
+        if ((_kv_map_table[i].partition_name_hash != hash) || (_kv_map_table[i].partition_name_len != name_len) ||
+                (strncmp(temp_str, _kv_map_table[i].partition_name, name_len) != 0)) {
             continue;
         }
 
@@ -234,18 +256,18 @@ int KVMap::config_lookup(const char *full_name, kvstore_config_t **kv_config, si
         ret = MBED_ERROR_ITEM_NOT_FOUND;
         goto exit;
     }
+
+    //extract the key
+    *key_index += name_len + 1;
+
 exit:
-    if (ret == MBED_SUCCESS) {
-        //if success extract the key
-        *key_index = *key_index + delimiter_index + 1;
-    }
     return ret;
 }
 
 KVStore *KVMap::get_internal_kv_instance(const char *name)
 {
 
-    _mutex->lock();
+    _mutex->lock_shared();
 
     kvstore_config_t *kv_config;
     size_t key_index = 0;
@@ -255,7 +277,7 @@ KVStore *KVMap::get_internal_kv_instance(const char *name)
         goto exit;
     }
 exit:
-    _mutex->unlock();
+    _mutex->unlock_shared();
 
     return ret != MBED_SUCCESS ? NULL : kv_config->internal_store;
 }
@@ -263,7 +285,7 @@ exit:
 KVStore *KVMap::get_external_kv_instance(const char *name)
 {
 
-    _mutex->lock();
+    _mutex->lock_shared();
 
     kvstore_config_t *kv_config;
     size_t key_index = 0;
@@ -273,7 +295,7 @@ KVStore *KVMap::get_external_kv_instance(const char *name)
         goto exit;
     }
 exit:
-    _mutex->unlock();
+    _mutex->unlock_shared();
 
     return ret != MBED_SUCCESS ? NULL : kv_config->external_store;
 }
@@ -281,7 +303,7 @@ exit:
 KVStore *KVMap::get_main_kv_instance(const char *name)
 {
 
-    _mutex->lock();
+    _mutex->lock_shared();
 
     kvstore_config_t *kv_config;
     size_t key_index = 0;
@@ -291,7 +313,7 @@ KVStore *KVMap::get_main_kv_instance(const char *name)
         goto exit;
     }
 exit:
-    _mutex->unlock();
+    _mutex->unlock_shared();
 
     return ret != MBED_SUCCESS ? NULL : kv_config->kvstore_main_instance;
 }
@@ -299,7 +321,7 @@ exit:
 BlockDevice *KVMap::get_internal_blockdevice_instance(const char *name)
 {
 
-    _mutex->lock();
+    _mutex->lock_shared();
 
     kvstore_config_t *kv_config;
     size_t key_index = 0;
@@ -309,7 +331,7 @@ BlockDevice *KVMap::get_internal_blockdevice_instance(const char *name)
         goto exit;
     }
 exit:
-    _mutex->unlock();
+    _mutex->unlock_shared();
 
     return ret != MBED_SUCCESS ? NULL : kv_config->internal_bd;
 }
@@ -317,7 +339,7 @@ exit:
 BlockDevice *KVMap::get_external_blockdevice_instance(const char *name)
 {
 
-    _mutex->lock();
+    _mutex->lock_shared();
 
     kvstore_config_t *kv_config;
     size_t key_index = 0;
@@ -327,7 +349,7 @@ BlockDevice *KVMap::get_external_blockdevice_instance(const char *name)
         goto exit;
     }
 exit:
-    _mutex->unlock();
+    _mutex->unlock_shared();
 
     return ret != MBED_SUCCESS ? NULL : kv_config->external_bd;
 }
@@ -335,7 +357,7 @@ exit:
 FileSystem *KVMap::get_external_filesystem_instance(const char *name)
 {
 
-    _mutex->lock();
+    _mutex->lock_shared();
 
     kvstore_config_t *kv_config;
     size_t key_index = 0;
@@ -345,7 +367,7 @@ FileSystem *KVMap::get_external_filesystem_instance(const char *name)
         goto exit;
     }
 exit:
-    _mutex->unlock();
+    _mutex->unlock_shared();
 
     return ret != MBED_SUCCESS ? NULL : kv_config->external_fs;
 }
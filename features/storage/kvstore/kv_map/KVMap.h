@@ -17,7 +17,7 @@
 #define _KV_MAP
 
 #include "KVStore.h"
-#include "platform/PlatformMutex.h"
+#include "platform/PlatformRWMutex.h"
 #include "platform/SingletonPtr.h"
 #include "BlockDevice.h"
 #include "FileSystem.h"
@@ -81,6 +81,14 @@ typedef struct {
      * Configuration struct.
      */
     kvstore_config_t *kv_config;
+    /**
+      * Partition name length
+      */
+    size_t partition_name_len;
+    /**
+      * Partition name hash, computed at attach time so lookups only compare names on a hash match
+      */
+    uint32_t partition_name_hash;
 } kv_map_entry_t;
 
 /** KVMap class
@@ -153,6 +161,19 @@ public:
      */
     int lookup(const char *full_name, mbed::KVStore **kv_instance, size_t *key_index, uint32_t *flags_mask = NULL);
 
+    /**
+     * @brief Full name lookup, and then break it into partition configuration struct and key.
+     *        Lets callers accessing the same partition repeatedly resolve it once.
+     *        The configuration struct must not be used after its partition is detached.
+     *
+     * @param[in] full_name  String parameter contains the partition name to look for.
+     *                   The String should be formated as follow "/partition name/key". The key is optional.
+     * @param[out] kv_config Returns the configuration struct associated with the required partition name.
+     * @param[out] key_index Returns an index to the first character of the key.
+     * @return 0 on success, negative error code on failure
+     */
+    int lookup_config(const char *full_name, kvstore_config_t **kv_config, size_t *key_index);
+
     /**
      * @brief Getter for the internal KVStore instance.
      *
@@ -232,7 +253,7 @@ private:
     kv_map_entry_t _kv_map_table[MAX_ATTACHED_KVS];
     int _kv_num_attached_kvs;
     int _is_initialized;
-    SingletonPtr<PlatformMutex> _mutex;
+    SingletonPtr<PlatformRWMutex> _mutex;
 #endif
 };
 }
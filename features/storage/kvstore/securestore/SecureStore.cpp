@@ -23,6 +23,7 @@
 #include "aes.h"
 #include "cmac.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "entropy.h"
 #include "DeviceKey.h"
 #include "mbed_assert.h"
@@ -44,9 +45,19 @@ static const uint32_t iv_size           = 8;
 static const uint32_t scratch_buf_size  = 256;
 static const uint32_t derived_key_size  = 16;
 
+#ifndef MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE
+#define MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE 4
+#endif
+
+static const uint32_t derived_key_cache_size = MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE;
+
 static const char *const enc_prefix  = "ENC";
 static const char *const auth_prefix = "AUTH";
 
+// Derived key types (also index of derived keys in cache entry)
+static const int enc_key_type  = 0;
+static const int auth_key_type = 1;
+
 static const uint32_t security_flags = KVStore::REQUIRE_CONFIDENTIALITY_FLAG | KVStore::REQUIRE_REPLAY_PROTECTION_FLAG;
 
 namespace {
@@ -70,6 +81,30 @@ typedef struct {
     KVStore::set_handle_t underlying_handle;
 } inc_set_handle_t;
 
+// streaming get handle
+typedef struct {
+    record_metadata_t metadata;
+    uint32_t create_flags;
+    uint32_t offset_in_data;
+    size_t aes_offs;
+    uint8_t ctr_buf[enc_block_size];
+    uint8_t stream_block[enc_block_size];
+    bool rbp_key_exists;
+    uint8_t rbp_cmac[cmac_size];
+    mbedtls_aes_context enc_ctx;
+    mbedtls_cipher_context_t auth_ctx;
+    KVStore::get_handle_t underlying_handle;
+} inc_get_handle_t;
+
+// derived key cache entry (last_used of 0 marks an unused entry)
+typedef struct {
+    uint32_t hash;
+    uint32_t last_used;
+    uint8_t valid_keys;
+    char key[KVStore::MAX_KEY_SIZE + 1];
+    uint8_t derived_keys[2][derived_key_size];
+} derived_key_cache_entry_t;
+
 // iterator handle
 typedef struct {
     KVStore::iterator_t underlying_it;
@@ -82,21 +117,31 @@ typedef struct {
 
 // -------------------------------------------------- Functions Implementation ----------------------------------------------------
 
-int encrypt_decrypt_start(mbedtls_aes_context &enc_aes_ctx, uint8_t *iv, const char *key,
-                          uint8_t *ctr_buf, uint8_t *salt_buf, int salt_buf_size)
+int derive_key(const char *prefix, const char *key, uint8_t *derived_key,
+               uint8_t *salt_buf, int salt_buf_size)
 {
     DeviceKey &devkey = DeviceKey::get_instance();
     char *salt = reinterpret_cast<char *>(salt_buf);
-    uint8_t encrypt_key[derived_key_size];
-    strcpy(salt, enc_prefix);
-    int pos = strlen(enc_prefix);
+    strcpy(salt, prefix);
+    int pos = strlen(prefix);
     strncpy(salt + pos, key, salt_buf_size - pos - 1);
     salt_buf[salt_buf_size - 1] = 0;
-    int os_ret = devkey.generate_derived_key(salt_buf, strlen(salt), encrypt_key,  DEVICE_KEY_16BYTE);
-    if (os_ret) {
-        return os_ret;
+    return devkey.generate_derived_key(salt_buf, strlen(salt), derived_key, DEVICE_KEY_16BYTE);
+}
+
+uint32_t key_name_hash(const char *key)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    while (*key) {
+        hash = (hash ^ static_cast<uint8_t>(*key++)) * 16777619UL;
     }
+    return hash;
+}
 
+int encrypt_decrypt_start(mbedtls_aes_context &enc_aes_ctx, uint8_t *iv, const uint8_t *encrypt_key,
+                          uint8_t *ctr_buf)
+{
     mbedtls_aes_init(&enc_aes_ctx);
     mbedtls_aes_setkey_enc(&enc_aes_ctx, encrypt_key, enc_block_size * 8);
 
@@ -115,20 +160,9 @@ int encrypt_decrypt_data(mbedtls_aes_context &enc_aes_ctx, const uint8_t *in_buf
                                  stream_block, in_buf, out_buf);
 }
 
-int cmac_calc_start(mbedtls_cipher_context_t &auth_ctx, const char *key, uint8_t *salt_buf, int salt_buf_size)
+int cmac_calc_start(mbedtls_cipher_context_t &auth_ctx, const uint8_t *auth_key)
 {
-    DeviceKey &devkey = DeviceKey::get_instance();
-    char *salt = reinterpret_cast<char *>(salt_buf);
-    uint8_t auth_key[derived_key_size];
-    strcpy(salt, auth_prefix);
-    int pos = strlen(auth_prefix);
-    strncpy(salt + pos, key, salt_buf_size - pos - 1);
-    salt_buf[salt_buf_size - 1] = 0;
-    int os_ret = devkey.generate_derived_key(salt_buf, strlen(salt), auth_key, DEVICE_KEY_16BYTE);
-    if (os_ret) {
-        return os_ret;
-    }
-
+    int os_ret;
     const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
 
     mbedtls_cipher_init(&auth_ctx);
@@ -169,7 +203,7 @@ int cmac_calc_finish(mbedtls_cipher_context_t &auth_ctx, uint8_t *output)
 
 SecureStore::SecureStore(KVStore *underlying_kv, KVStore *rbp_kv) :
     _is_initialized(false), _underlying_kv(underlying_kv), _rbp_kv(rbp_kv), _entropy(0),
-    _inc_set_handle(0), _scratch_buf(0)
+    _inc_set_handle(0), _scratch_buf(0), _derived_key_cache(0), _derived_key_cache_tick(0)
 {
 }
 
@@ -179,12 +213,70 @@ SecureStore::~SecureStore()
 }
 
 
+int SecureStore::get_derived_key(const char *key, int key_type, uint8_t *derived_key)
+{
+    int os_ret;
+    uint32_t hash;
+    const char *prefix = (key_type == enc_key_type) ? enc_prefix : auth_prefix;
+    derived_key_cache_entry_t *cache = static_cast<derived_key_cache_entry_t *>(_derived_key_cache);
+    derived_key_cache_entry_t *entry = 0;
+
+    if (!derived_key_cache_size) {
+        return derive_key(prefix, key, derived_key, _scratch_buf, scratch_buf_size);
+    }
+
+    hash = key_name_hash(key);
+
+    // Look for key, or else for the least recently used entry
+    for (uint32_t i = 0; i < derived_key_cache_size; i++) {
+        if (cache[i].last_used && (cache[i].hash == hash) && !strcmp(cache[i].key, key)) {
+            entry = &cache[i];
+            break;
+        }
+        if (!entry || (cache[i].last_used < entry->last_used)) {
+            entry = &cache[i];
+        }
+    }
+
+    if (!entry->last_used || (entry->hash != hash) || strcmp(entry->key, key)) {
+        mbedtls_platform_zeroize(entry, sizeof(derived_key_cache_entry_t));
+        entry->hash = hash;
+        strcpy(entry->key, key);
+    }
+
+    if (!(entry->valid_keys & (1 << key_type))) {
+        os_ret = derive_key(prefix, key, entry->derived_keys[key_type], _scratch_buf, scratch_buf_size);
+        if (os_ret) {
+            mbedtls_platform_zeroize(entry, sizeof(derived_key_cache_entry_t));
+            return os_ret;
+        }
+        entry->valid_keys |= 1 << key_type;
+    }
+
+    // Tick wrap can only make eviction order imperfect (just keep 0 for unused entries)
+    if (!++_derived_key_cache_tick) {
+        _derived_key_cache_tick = 1;
+    }
+    entry->last_used = _derived_key_cache_tick;
+    memcpy(derived_key, entry->derived_keys[key_type], derived_key_size);
+    return 0;
+}
+
+void SecureStore::clear_derived_key_cache()
+{
+    if (_derived_key_cache) {
+        mbedtls_platform_zeroize(_derived_key_cache, derived_key_cache_size * sizeof(derived_key_cache_entry_t));
+    }
+    _derived_key_cache_tick = 0;
+}
+
 int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_data_size,
                            uint32_t create_flags)
 {
     int ret, os_ret;
     inc_set_handle_t *ih;
     info_t info;
+    uint8_t derived_key[derived_key_size];
     bool enc_started = false, auth_started = false;
 
     if (!_is_initialized) {
@@ -243,8 +335,11 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
             ret = MBED_ERROR_FAILED_OPERATION;
             goto fail;
         }
-        os_ret = encrypt_decrypt_start(ih->enc_ctx, ih->metadata.iv, key, ih->ctr_buf, _scratch_buf,
-                                       scratch_buf_size);
+        os_ret = get_derived_key(key, enc_key_type, derived_key);
+        if (!os_ret) {
+            os_ret = encrypt_decrypt_start(ih->enc_ctx, ih->metadata.iv, derived_key, ih->ctr_buf);
+        }
+        mbedtls_platform_zeroize(derived_key, derived_key_size);
         if (os_ret) {
             ret = MBED_ERROR_FAILED_OPERATION;
             goto fail;
@@ -254,7 +349,11 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
         memset(ih->metadata.iv, 0, iv_size);
     }
 
-    os_ret = cmac_calc_start(ih->auth_ctx, key, _scratch_buf, scratch_buf_size);
+    os_ret = get_derived_key(key, auth_key_type, derived_key);
+    if (!os_ret) {
+        os_ret = cmac_calc_start(ih->auth_ctx, derived_key);
+    }
+    mbedtls_platform_zeroize(derived_key, derived_key_size);
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto fail;
@@ -528,6 +627,7 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
     uint32_t chunk_size;
     uint32_t enc_lead_size;
     uint8_t *dest_buf;
+    uint8_t derived_key[derived_key_size];
     bool enc_started = false, auth_started = false;
     uint32_t create_flags;
 
@@ -569,7 +669,11 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
         goto end;
     }
 
-    os_ret = cmac_calc_start(ih->auth_ctx, key, _scratch_buf, scratch_buf_size);
+    os_ret = get_derived_key(key, auth_key_type, derived_key);
+    if (!os_ret) {
+        os_ret = cmac_calc_start(ih->auth_ctx, derived_key);
+    }
+    mbedtls_platform_zeroize(derived_key, derived_key_size);
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto end;
@@ -589,8 +693,11 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
     }
 
     if (create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
-        os_ret = encrypt_decrypt_start(ih->enc_ctx, ih->metadata.iv, key, ih->ctr_buf, _scratch_buf,
-                                       scratch_buf_size);
+        os_ret = get_derived_key(key, enc_key_type, derived_key);
+        if (!os_ret) {
+            os_ret = encrypt_decrypt_start(ih->enc_ctx, ih->metadata.iv, derived_key, ih->ctr_buf);
+        }
+        mbedtls_platform_zeroize(derived_key, derived_key_size);
         if (os_ret) {
             ret = MBED_ERROR_FAILED_OPERATION;
             goto end;
@@ -730,6 +837,256 @@ int SecureStore::get_info(const char *key, info_t *info)
     return ret;
 }
 
+int SecureStore::get_start(get_handle_t *handle, const char *key, size_t *data_size)
+{
+    int ret, os_ret;
+    size_t actual_size;
+    inc_get_handle_t *gh;
+    uint8_t derived_key[derived_key_size];
+    bool enc_started = false, auth_started = false, underlying_started = false;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!handle || !is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    gh = new inc_get_handle_t;
+    gh->rbp_key_exists = false;
+
+    _mutex.lock();
+
+    if (_rbp_kv) {
+        ret = _rbp_kv->get(key, gh->rbp_cmac, cmac_size, 0);
+        if (!ret) {
+            gh->rbp_key_exists = true;
+        } else if (ret != MBED_ERROR_ITEM_NOT_FOUND) {
+            goto fail;
+        }
+    }
+
+    ret = _underlying_kv->get_start(&gh->underlying_handle, key);
+    if (ret) {
+        // Same as in get - key in RBP KV but not in underlying KV may be an attack
+        if (gh->rbp_key_exists) {
+            ret = MBED_ERROR_RBP_AUTHENTICATION_FAILED;
+        }
+        goto fail;
+    }
+    underlying_started = true;
+
+    ret = _underlying_kv->get_data(gh->underlying_handle, &gh->metadata, sizeof(record_metadata_t),
+                                   &actual_size);
+    if (ret) {
+        goto fail;
+    }
+    if ((actual_size != sizeof(record_metadata_t)) ||
+            (gh->metadata.metadata_size < sizeof(record_metadata_t))) {
+        ret = MBED_ERROR_INVALID_DATA_DETECTED;
+        goto fail;
+    }
+
+    // Skip metadata fields of newer revisions we don't know of
+    for (uint32_t skip = gh->metadata.metadata_size - sizeof(record_metadata_t); skip; skip -= actual_size) {
+        ret = _underlying_kv->get_data(gh->underlying_handle, _scratch_buf, std::min(skip, scratch_buf_size),
+                                       &actual_size);
+        if (ret) {
+            goto fail;
+        }
+        if (!actual_size) {
+            ret = MBED_ERROR_INVALID_DATA_DETECTED;
+            goto fail;
+        }
+    }
+
+    gh->create_flags = gh->metadata.create_flags;
+    if (!_rbp_kv) {
+        gh->create_flags &= ~REQUIRE_REPLAY_PROTECTION_FLAG;
+    }
+
+    if (gh->rbp_key_exists && !(gh->create_flags & (REQUIRE_REPLAY_PROTECTION_FLAG |  WRITE_ONCE_FLAG))) {
+        ret = MBED_ERROR_RBP_AUTHENTICATION_FAILED;
+        goto fail;
+    }
+
+    os_ret = get_derived_key(key, auth_key_type, derived_key);
+    if (!os_ret) {
+        os_ret = cmac_calc_start(gh->auth_ctx, derived_key);
+    }
+    mbedtls_platform_zeroize(derived_key, derived_key_size);
+    if (os_ret) {
+        ret = MBED_ERROR_FAILED_OPERATION;
+        goto fail;
+    }
+    auth_started = true;
+
+    os_ret = cmac_calc_data(gh->auth_ctx, key, strlen(key));
+    if (os_ret) {
+        ret = MBED_ERROR_FAILED_OPERATION;
+        goto fail;
+    }
+    os_ret = cmac_calc_data(gh->auth_ctx, &gh->metadata, sizeof(record_metadata_t));
+    if (os_ret) {
+        ret = MBED_ERROR_FAILED_OPERATION;
+        goto fail;
+    }
+
+    if (gh->create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
+        os_ret = get_derived_key(key, enc_key_type, derived_key);
+        if (!os_ret) {
+            os_ret = encrypt_decrypt_start(gh->enc_ctx, gh->metadata.iv, derived_key, gh->ctr_buf);
+        }
+        mbedtls_platform_zeroize(derived_key, derived_key_size);
+        if (os_ret) {
+            ret = MBED_ERROR_FAILED_OPERATION;
+            goto fail;
+        }
+        enc_started = true;
+    }
+
+    gh->offset_in_data = 0;
+    gh->aes_offs = 0;
+
+    // Nothing to stream, so authenticate right away
+    if (!gh->metadata.data_size) {
+        ret = get_authenticate(gh);
+        if (ret) {
+            goto fail;
+        }
+    }
+
+    if (data_size) {
+        *data_size = gh->metadata.data_size;
+    }
+    *handle = reinterpret_cast<get_handle_t>(gh);
+    _mutex.unlock();
+    return MBED_SUCCESS;
+
+fail:
+    if (enc_started) {
+        mbedtls_aes_free(&gh->enc_ctx);
+    }
+
+    if (auth_started) {
+        mbedtls_cipher_free(&gh->auth_ctx);
+    }
+
+    if (underlying_started) {
+        _underlying_kv->get_finalize(gh->underlying_handle);
+    }
+
+    delete gh;
+    _mutex.unlock();
+    return ret;
+}
+
+int SecureStore::get_data(get_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size)
+{
+    int ret, os_ret;
+    size_t chunk_size;
+    inc_get_handle_t *gh = reinterpret_cast<inc_get_handle_t *>(handle);
+
+    if (!gh || (!buffer && buffer_size) || !actual_size) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    *actual_size = 0;
+    if (gh->offset_in_data == gh->metadata.data_size) {
+        return MBED_SUCCESS;
+    }
+
+    _mutex.lock();
+
+    chunk_size = std::min(buffer_size, (size_t)(gh->metadata.data_size - gh->offset_in_data));
+    ret = _underlying_kv->get_data(gh->underlying_handle, buffer, chunk_size, &chunk_size);
+    if (ret) {
+        goto end;
+    }
+
+    // Authentication is calculated on the encrypted data, so do it before decrypting in place
+    os_ret = cmac_calc_data(gh->auth_ctx, buffer, chunk_size);
+    if (os_ret) {
+        ret = MBED_ERROR_FAILED_OPERATION;
+        goto end;
+    }
+
+    if (gh->create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
+        os_ret = mbedtls_aes_crypt_ctr(&gh->enc_ctx, chunk_size, &gh->aes_offs, gh->ctr_buf,
+                                       gh->stream_block, static_cast<uint8_t *>(buffer),
+                                       static_cast<uint8_t *>(buffer));
+        if (os_ret) {
+            ret = MBED_ERROR_FAILED_OPERATION;
+            goto end;
+        }
+    }
+
+    gh->offset_in_data += chunk_size;
+    *actual_size = chunk_size;
+
+    if (gh->offset_in_data == gh->metadata.data_size) {
+        ret = get_authenticate(gh);
+    } else if (!chunk_size && buffer_size) {
+        // Underlying record is shorter than its metadata claims
+        ret = MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int SecureStore::get_finalize(get_handle_t handle)
+{
+    inc_get_handle_t *gh = reinterpret_cast<inc_get_handle_t *>(handle);
+
+    if (!gh) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    if (gh->create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
+        mbedtls_aes_free(&gh->enc_ctx);
+    }
+    mbedtls_cipher_free(&gh->auth_ctx);
+    _underlying_kv->get_finalize(gh->underlying_handle);
+    delete gh;
+
+    _mutex.unlock();
+    return MBED_SUCCESS;
+}
+
+int SecureStore::get_authenticate(void *handle)
+{
+    int ret, os_ret;
+    size_t actual_size;
+    uint8_t calc_cmac[cmac_size], read_cmac[cmac_size];
+    inc_get_handle_t *gh = static_cast<inc_get_handle_t *>(handle);
+
+    os_ret = cmac_calc_finish(gh->auth_ctx, calc_cmac);
+    if (os_ret) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    // Record CMAC follows the data
+    ret = _underlying_kv->get_data(gh->underlying_handle, read_cmac, cmac_size, &actual_size);
+    if (ret) {
+        return ret;
+    }
+    if ((actual_size != cmac_size) || memcmp(calc_cmac, read_cmac, cmac_size) != 0) {
+        return MBED_ERROR_AUTHENTICATION_FAILED;
+    }
+
+    if (_rbp_kv && (gh->create_flags & (REQUIRE_REPLAY_PROTECTION_FLAG | WRITE_ONCE_FLAG))) {
+        if (!gh->rbp_key_exists || memcmp(calc_cmac, gh->rbp_cmac, cmac_size) != 0) {
+            return MBED_ERROR_RBP_AUTHENTICATION_FAILED;
+        }
+    }
+
+    return MBED_SUCCESS;
+}
 
 int SecureStore::init()
 {
@@ -750,6 +1107,10 @@ int SecureStore::init()
 
     _scratch_buf = new uint8_t[scratch_buf_size];
     _inc_set_handle = new inc_set_handle_t;
+    if (derived_key_cache_size) {
+        _derived_key_cache = new derived_key_cache_entry_t[derived_key_cache_size];
+        clear_derived_key_cache();
+    }
 
     ret = _underlying_kv->init();
     if (ret) {
@@ -778,6 +1139,9 @@ int SecureStore::deinit()
         delete static_cast<mbedtls_entropy_context *>(_entropy);
         delete static_cast<inc_set_handle_t *>(_inc_set_handle);
         delete _scratch_buf;
+        clear_derived_key_cache();
+        delete[] static_cast<derived_key_cache_entry_t *>(_derived_key_cache);
+        _derived_key_cache = 0;
         // TODO: Deinit member KVs?
     }
 
@@ -800,6 +1164,8 @@ int SecureStore::reset()
     }
 
     _mutex.lock();
+    clear_derived_key_cache();
+
     ret = _underlying_kv->reset();
     if (ret) {
         goto end;
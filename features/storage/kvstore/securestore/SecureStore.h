@@ -114,6 +114,7 @@ public:
      *          or any other error from underlying KVStore instances.
      */
     virtual int set(const char *key, const void *buffer, size_t size, uint32_t create_flags);
+    using KVStore::set;
 
     /**
      * @brief Get one KVStore item, given key.
@@ -173,6 +174,59 @@ public:
      */
     virtual int remove(const char *key);
 
+    /**
+     * @brief Start a streaming SecureStore get sequence. Metadata is read and authentication
+     *        is set up once, then data is read, authenticated and decrypted chunk by chunk,
+     *        without blocking other operations between chunks.
+     *        Authentication is only complete once all data was read: the get_data call returning
+     *        the last chunk fails if it doesn't pass, so data must not be trusted before that.
+     *
+     * @param[out] handle               Returned get handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] data_size            Value data size (NULL to pass nothing).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_FAILED_OPERATION         Internal error.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     *          MBED_ERROR_AUTHENTICATION_FAILED    Data authentication failed (empty value).
+     *          MBED_ERROR_AUTHENTICATION_RBP_FAILED
+     *                                              Rollback protection data authentication failed.
+     *          or any other error from underlying KVStore instances.
+     */
+    virtual int get_start(get_handle_t *handle, const char *key, size_t *data_size = NULL);
+
+    /**
+     * @brief Read next data chunk in a streaming SecureStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size (0 once all data was read).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_FAILED_OPERATION         Internal error.
+     *          MBED_ERROR_AUTHENTICATION_FAILED    Data authentication failed.
+     *          MBED_ERROR_AUTHENTICATION_RBP_FAILED
+     *                                              Rollback protection data authentication failed.
+     *          or any other error from underlying KVStore instances.
+     */
+    virtual int get_data(get_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size);
+
+    /**
+     * @brief Finalize a streaming SecureStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int get_finalize(get_handle_t handle);
+
 
     /**
      * @brief Start an incremental KVStore set sequence. This operation is blocking other operations.
@@ -276,6 +330,8 @@ private:
     void *_entropy;
     void *_inc_set_handle;
     uint8_t *_scratch_buf;
+    void *_derived_key_cache;
+    uint32_t _derived_key_cache_tick;
 
     /**
      * @brief Actual get function, serving get and get_info APIs.
@@ -291,6 +347,31 @@ private:
      */
     int do_get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL,
                size_t offset = 0, info_t *info = 0);
+
+    /**
+     * @brief Complete authentication of a streaming get sequence, once all data was read.
+     *
+     * @param[in]  handle               Get handle.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int get_authenticate(void *handle);
+
+    /**
+     * @brief Get key derived from device key, either from derived key cache or by deriving it.
+     *
+     * @param[in]  key                  Key name.
+     * @param[in]  key_type             Derived key type (encryption or authentication).
+     * @param[out] derived_key          Derived key (caller should zeroize it after use).
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int get_derived_key(const char *key, int key_type, uint8_t *derived_key);
+
+    /**
+     * @brief Wipe derived key cache.
+     */
+    void clear_derived_key_cache();
 #endif
 };
 /** @}*/
@@ -34,6 +34,11 @@ using namespace mbed;
 // --------------------------------------------------------- Definitions ----------------------------------------------------------
 
 static const uint32_t delete_flag = (1UL << 31);
+// Record belongs to a batch, and is followed by further records of it (last one doesn't have this flag).
+// This flag is not covered by the record CRC.
+static const uint32_t batch_flag = (1UL << 30);
+// Index checkpoint record, written after garbage collection. It isn't a key, so never enters the RAM table.
+static const uint32_t index_flag = (1UL << 29);
 static const uint32_t internal_flags = delete_flag;
 static const uint32_t supported_flags = KVStore::WRITE_ONCE_FLAG;
 
@@ -52,19 +57,26 @@ typedef struct {
 
 typedef struct {
     uint32_t  hash;
+    uint32_t  gc_offset; // Offset of migrated copy in standby area (incremental GC only)
     bd_size_t bd_offset;
 } ram_table_entry_t;
 
 static const char *master_rec_key = "TDBS";
+static const char *index_rec_key = "TDBI";
 static const uint32_t tdbstore_magic = 0x54686683; // "TDBS" in ASCII
 static const uint32_t tdbstore_revision = 1;
 
 typedef struct {
     uint16_t version;
     uint16_t tdbstore_revision;
-    uint32_t reserved;
+    uint32_t index_offset; // Offset of index checkpoint record (0 if none)
 } master_record_data_t;
 
+typedef struct {
+    uint32_t hash;
+    uint32_t bd_offset;
+} index_entry_t;
+
 typedef enum {
     TDBSTORE_AREA_STATE_NONE = 0,
     TDBSTORE_AREA_STATE_EMPTY,
@@ -80,6 +92,26 @@ typedef struct {
 static const uint32_t work_buf_size = 64;
 static const uint32_t initial_crc = 0xFFFFFFFF;
 static const uint32_t initial_max_keys = 16;
+static const uint32_t ram_table_grow_size = 16;
+
+#ifndef MBED_CONF_TDBSTORE_GC_STEP_RECORDS
+#define MBED_CONF_TDBSTORE_GC_STEP_RECORDS 0
+#endif
+
+#ifndef MBED_CONF_TDBSTORE_GC_WATERMARK
+#define MBED_CONF_TDBSTORE_GC_WATERMARK 75
+#endif
+
+#ifndef MBED_CONF_TDBSTORE_BUFFER_CACHE_LINES
+#define MBED_CONF_TDBSTORE_BUFFER_CACHE_LINES 1
+#endif
+
+#ifndef MBED_CONF_TDBSTORE_BUFFER_READ_AHEAD
+#define MBED_CONF_TDBSTORE_BUFFER_READ_AHEAD 0
+#endif
+
+static const uint32_t gc_step_records = MBED_CONF_TDBSTORE_GC_STEP_RECORDS;
+static const uint32_t gc_watermark = MBED_CONF_TDBSTORE_GC_WATERMARK;
 
 // incremental set handle
 typedef struct {
@@ -92,6 +124,16 @@ typedef struct {
     bool new_key;
 } inc_set_handle_t;
 
+// streaming get handle
+typedef struct {
+    char *key;
+    uint32_t crc;
+    uint32_t data_offset;
+    uint32_t data_size;
+    uint32_t offset_in_data;
+    uint32_t generation;
+} get_handle_data_t;
+
 // iterator handle
 typedef struct {
     int iterator_num;
@@ -125,7 +167,9 @@ static uint32_t calc_crc(uint32_t init_crc, uint32_t data_size, const void *data
 TDBStore::TDBStore(BlockDevice *bd) : _ram_table(0), _max_keys(0),
     _num_keys(0), _bd(bd), _buff_bd(0),  _free_space_offset(0), _master_record_offset(0),
     _master_record_size(0), _is_initialized(false), _active_area(0), _active_area_version(0), _size(0),
-    _prog_size(0), _work_buf(0), _key_buf(0), _variant_bd_erase_unit_size(false), _inc_set_handle(0)
+    _prog_size(0), _work_buf(0), _key_buf(0), _variant_bd_erase_unit_size(false), _inc_set_handle(0),
+    _gc_in_progress(false), _gc_ram_table_ind(0), _gc_free_space_offset(0), _gc_trigger_offset(0),
+    _generation(0), _index_offset(0)
 {
 }
 
@@ -145,6 +189,11 @@ int TDBStore::read_area(uint8_t area, uint32_t offset, uint32_t size, void *buf)
     return MBED_SUCCESS;
 }
 
+const uint8_t *TDBStore::mapped_area(uint8_t area, uint32_t offset, uint32_t size)
+{
+    return static_cast<const uint8_t *>(_buff_bd->get_mapped_address(_area_params[area].address + offset, size));
+}
+
 int TDBStore::write_area(uint8_t area, uint32_t offset, uint32_t size, const void *buf)
 {
     int os_ret = _buff_bd->program(buf, _area_params[area].address + offset, size);
@@ -240,7 +289,7 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
         return MBED_ERROR_INVALID_DATA_DETECTED;
     }
 
-    if (offset + total_size >= _size) {
+    if (offset + total_size > _size) {
         return MBED_ERROR_INVALID_DATA_DETECTED;
     }
 
@@ -248,15 +297,17 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
         return MBED_ERROR_INVALID_SIZE;
     }
 
-    actual_data_size = std::min(data_buf_size, data_size - data_offset);
+    actual_data_size = std::min<size_t>(data_buf_size, data_size - data_offset);
 
     if (copy_data && actual_data_size && !data_buf) {
         return MBED_ERROR_INVALID_ARGUMENT;
     }
 
     if (validate) {
-        // Calculate CRC on header (excluding CRC itself)
-        crc = calc_crc(crc, sizeof(record_header_t) - sizeof(crc), &header);
+        // Calculate CRC on header (excluding CRC itself and batch flag)
+        record_header_t crc_header = header;
+        crc_header.flags &= ~batch_flag;
+        crc = calc_crc(crc, sizeof(record_header_t) - sizeof(crc), &crc_header);
         curr_data_offset = 0;
     } else {
         // Non validation case: No need to read the key, nor the parts before data_offset
@@ -292,7 +343,7 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
             // 3. After actual part is finished - read to work buffer
             // 4. Copy data flag not set - read to work buffer
             if (curr_data_offset < data_offset) {
-                chunk_size = std::min(work_buf_size, data_offset - curr_data_offset);
+                chunk_size = std::min<size_t>(work_buf_size, data_offset - curr_data_offset);
                 dest_buf = _work_buf;
             } else if (copy_data && (curr_data_offset < data_offset + actual_data_size)) {
                 chunk_size = actual_data_size;
@@ -302,26 +353,34 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
                 dest_buf = _work_buf;
             }
         }
-        ret = read_area(area, offset, chunk_size, dest_buf);
-        if (ret) {
-            goto end;
+        // Chunks that are only checked, not returned, are read in place when the BD allows it
+        const uint8_t *src_buf = NULL;
+        if (dest_buf == _work_buf) {
+            src_buf = mapped_area(area, offset, chunk_size);
+        }
+        if (!src_buf) {
+            ret = read_area(area, offset, chunk_size, dest_buf);
+            if (ret) {
+                goto end;
+            }
+            src_buf = dest_buf;
         }
 
         if (validate) {
             // calculate CRC on current read chunk
-            crc = calc_crc(crc, chunk_size, dest_buf);
+            crc = calc_crc(crc, chunk_size, src_buf);
         }
 
         if (key_size) {
             // We're on key part. May need to calculate hash or check whether key is the expected one
             if (check_expected_key) {
-                if (memcmp(user_key_ptr, dest_buf, chunk_size)) {
+                if (memcmp(user_key_ptr, src_buf, chunk_size)) {
                     ret = MBED_ERROR_ITEM_NOT_FOUND;
                 }
             }
 
             if (calc_hash) {
-                hash = calc_crc(hash, chunk_size, dest_buf);
+                hash = calc_crc(hash, chunk_size, src_buf);
             }
 
             user_key_ptr += chunk_size;
@@ -360,13 +419,23 @@ int TDBStore::find_record(uint8_t area, const char *key, uint32_t &offset,
 
     hash = calc_crc(initial_crc, strlen(key), key);
 
-    for (ram_table_ind = 0; ram_table_ind < _num_keys; ram_table_ind++) {
+    // RAM table is kept sorted by descending hash, so binary search for the first
+    // entry whose hash isn't greater than ours. This is also the insertion point if not found.
+    uint32_t low = 0, high = _num_keys;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (ram_table[mid].hash > hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    // Several keys may share the same hash - go over all of them
+    for (ram_table_ind = low; ram_table_ind < _num_keys; ram_table_ind++) {
         entry = &ram_table[ram_table_ind];
         offset = entry->bd_offset;
-        if (hash < entry->hash)  {
-            continue;
-        }
-        if (hash > entry->hash)  {
+        if (hash != entry->hash)  {
             return MBED_ERROR_ITEM_NOT_FOUND;
         }
         ret = read_record(_active_area, offset, const_cast<char *>(key), 0, 0, actual_data_size, 0,
@@ -562,8 +631,6 @@ int TDBStore::set_finalize(set_handle_t handle)
 {
     int os_ret, ret = MBED_SUCCESS;
     inc_set_handle_t *ih;
-    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
-    ram_table_entry_t *entry;
     bool need_gc = false;
     uint32_t actual_data_size, hash, flags, next_offset;
 
@@ -615,30 +682,12 @@ int TDBStore::set_finalize(set_handle_t handle)
         goto end;
     }
 
-    // Update RAM table
-    if (ih->header.flags & delete_flag) {
-        _num_keys--;
-        if (ih->ram_table_ind < _num_keys) {
-            memmove(&ram_table[ih->ram_table_ind], &ram_table[ih->ram_table_ind + 1],
-                    sizeof(ram_table_entry_t) * (_num_keys - ih->ram_table_ind));
-        }
-        update_all_iterators(false, ih->ram_table_ind);
-    } else {
-        if (ih->new_key) {
-            if (ih->ram_table_ind < _num_keys) {
-                memmove(&ram_table[ih->ram_table_ind + 1], &ram_table[ih->ram_table_ind],
-                        sizeof(ram_table_entry_t) * (_num_keys - ih->ram_table_ind));
-            }
-            _num_keys++;
-            update_all_iterators(true, ih->ram_table_ind);
-        }
-        entry = &ram_table[ih->ram_table_ind];
-        entry->hash = ih->hash;
-        entry->bd_offset = ih->bd_base_offset;
-    }
-
     _free_space_offset = align_up(ih->bd_curr_offset, _prog_size);
 
+    // Update RAM table
+    update_ram_table(ih->ram_table_ind, ih->hash, ih->bd_base_offset, ih->new_key,
+                     (ih->header.flags & delete_flag) != 0);
+
 end:
     if ((need_gc) && (ih->bd_base_offset != _master_record_offset)) {
         garbage_collection();
@@ -655,6 +704,222 @@ end:
     return ret;
 }
 
+void TDBStore::update_ram_table(uint32_t ram_table_ind, uint32_t hash, uint32_t bd_offset,
+                                bool new_key, bool deleted)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    ram_table_entry_t *entry;
+
+    if (deleted) {
+        _num_keys--;
+        if (ram_table_ind < _num_keys) {
+            memmove(&ram_table[ram_table_ind], &ram_table[ram_table_ind + 1],
+                    sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
+        }
+        update_all_iterators(false, ram_table_ind);
+    } else {
+        if (new_key) {
+            if (ram_table_ind < _num_keys) {
+                memmove(&ram_table[ram_table_ind + 1], &ram_table[ram_table_ind],
+                        sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
+            }
+            _num_keys++;
+            update_all_iterators(true, ram_table_ind);
+        }
+        entry = &ram_table[ram_table_ind];
+        entry->hash = hash;
+        entry->bd_offset = bd_offset;
+    }
+
+    if (_gc_in_progress) {
+        gc_track_update(ram_table_ind, bd_offset, new_key, deleted);
+    }
+}
+
+int TDBStore::write_record(const char *key, const void *data_buf, uint32_t data_size, uint32_t flags,
+                           uint32_t offset, uint32_t &next_offset)
+{
+    record_header_t header;
+    uint32_t key_size = strlen(key);
+    uint32_t header_size = align_up(sizeof(record_header_t), _prog_size);
+    int ret;
+
+    ret = check_erase_before_write(_active_area, offset, record_size(key, data_size));
+    if (ret) {
+        return ret;
+    }
+
+    // Batch flag isn't covered by CRC, so it can be cleared when the record is copied
+    header.magic = tdbstore_magic;
+    header.header_size = sizeof(record_header_t);
+    header.revision = tdbstore_revision;
+    header.flags = flags & ~batch_flag;
+    header.key_size = key_size;
+    header.reserved = 0;
+    header.data_size = data_size;
+    header.crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    header.flags = flags;
+    header.crc = calc_crc(header.crc, key_size, key);
+    header.crc = calc_crc(header.crc, data_size, data_buf);
+
+    // As in the incremental set, header is written last
+    ret = write_area(_active_area, offset + header_size, key_size, key);
+    if (ret) {
+        return ret;
+    }
+
+    ret = write_area(_active_area, offset + header_size + key_size, data_size, data_buf);
+    if (ret) {
+        return ret;
+    }
+
+    ret = write_area(_active_area, offset, sizeof(record_header_t), &header);
+    if (ret) {
+        return ret;
+    }
+
+    next_offset = align_up(offset + header_size + key_size + data_size, _prog_size);
+    return MBED_SUCCESS;
+}
+
+int TDBStore::set_batch(const batch_item_t *items, size_t num_items)
+{
+    int os_ret, ret = MBED_SUCCESS;
+    uint32_t offset, next_offset, batch_offset, batch_size = 0;
+    uint32_t hash, ram_table_ind, actual_data_size, flags;
+    bool need_gc = false;
+    size_t i;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!items && num_items) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    for (i = 0; i < num_items; i++) {
+        if (!is_valid_key(items[i].key) || !strcmp(items[i].key, master_rec_key)) {
+            return MBED_ERROR_INVALID_ARGUMENT;
+        }
+        if (items[i].create_flags & ~supported_flags) {
+            return MBED_ERROR_INVALID_ARGUMENT;
+        }
+        if (!items[i].buffer && items[i].size) {
+            return MBED_ERROR_INVALID_ARGUMENT;
+        }
+        batch_size += record_size(items[i].key, items[i].size);
+    }
+
+    if (!num_items) {
+        return MBED_SUCCESS;
+    }
+
+    _mutex.lock();
+
+    // If we have no room for the whole batch, perform garbage collection
+    if (_free_space_offset + batch_size > _size) {
+        ret = garbage_collection();
+        if (ret) {
+            goto end;
+        }
+    }
+
+    // If even after GC we have no room for the batch, return error
+    if (_free_space_offset + batch_size > _size) {
+        ret = MBED_ERROR_MEDIA_FULL;
+        goto end;
+    }
+
+    // Check all items before writing anything
+    for (i = 0; i < num_items; i++) {
+        ret = find_record(_active_area, items[i].key, offset, ram_table_ind, hash);
+        if (ret == MBED_SUCCESS) {
+            record_header_t header;
+            ret = read_area(_active_area, offset, sizeof(header), &header);
+            if (ret) {
+                goto end;
+            }
+            if (header.flags & WRITE_ONCE_FLAG) {
+                ret = MBED_ERROR_WRITE_PROTECTED;
+                goto end;
+            }
+        } else if (ret != MBED_ERROR_ITEM_NOT_FOUND) {
+            goto end;
+        }
+    }
+
+    // Write all records, all but the last one marked as a non-terminated batch part, so none of
+    // them is taken into account on init unless the last one is written as well.
+    batch_offset = _free_space_offset;
+    offset = batch_offset;
+    for (i = 0; i < num_items; i++) {
+        flags = items[i].create_flags;
+        if (i < num_items - 1) {
+            flags |= batch_flag;
+        }
+        ret = write_record(items[i].key, items[i].buffer, items[i].size, flags, offset, next_offset);
+        if (ret) {
+            need_gc = true;
+            goto end;
+        }
+        offset = next_offset;
+    }
+
+    os_ret = _buff_bd->sync();
+    if (os_ret) {
+        ret = MBED_ERROR_WRITE_FAILED;
+        need_gc = true;
+        goto end;
+    }
+
+    // Reread all records to ensure write success (using CRC calculation only)
+    offset = batch_offset;
+    for (i = 0; i < num_items; i++) {
+        ret = read_record(_active_area, offset, 0, 0, (uint32_t) -1,
+                          actual_data_size, 0, false, false, false, false,
+                          hash, flags, next_offset);
+        if (ret) {
+            need_gc = true;
+            goto end;
+        }
+        offset = next_offset;
+    }
+
+    _free_space_offset = offset;
+
+    // Batch is committed - update RAM table (finding records again, as the batch may hold the same key twice)
+    offset = batch_offset;
+    for (i = 0; i < num_items; i++) {
+        uint32_t dummy;
+        ret = find_record(_active_area, items[i].key, dummy, ram_table_ind, hash);
+        if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_ITEM_NOT_FOUND)) {
+            // Batch is safely written, so recover by rescanning the area
+            build_ram_table();
+            goto end;
+        }
+        if ((ret == MBED_ERROR_ITEM_NOT_FOUND) && (_num_keys >= _max_keys)) {
+            increment_max_keys();
+        }
+        update_ram_table(ram_table_ind, hash, offset, ret == MBED_ERROR_ITEM_NOT_FOUND, false);
+        offset += record_size(items[i].key, items[i].size);
+    }
+    ret = MBED_SUCCESS;
+
+    if (gc_step_records) {
+        do_gc_step(gc_step_records);
+    }
+
+end:
+    if (need_gc) {
+        // We may be left with a partially written batch. Garbage collection only keeps
+        // the records in RAM table, hence drops it.
+        garbage_collection();
+    }
+    _mutex.unlock();
+    return ret;
+}
+
 int TDBStore::set(const char *key, const void *buffer, size_t size, uint32_t create_flags)
 {
     int ret;
@@ -676,6 +941,17 @@ int TDBStore::set(const char *key, const void *buffer, size_t size, uint32_t cre
     }
 
     ret = set_finalize(handle);
+    if (ret) {
+        return ret;
+    }
+
+    if (gc_step_records && strcmp(key, master_rec_key)) {
+        // Amortize compaction over set operations. A failure here doesn't affect the set
+        // itself (GC will be recovered in full once space runs out).
+        _mutex.lock();
+        do_gc_step(gc_step_records);
+        _mutex.unlock();
+    }
     return ret;
 }
 
@@ -745,7 +1021,7 @@ int TDBStore::get_info(const char *key, info_t *info)
     }
 
     if (info) {
-        info->flags = flags;
+        info->flags = flags & ~batch_flag;
         info->size = actual_data_size;
     }
 
@@ -754,17 +1030,291 @@ end:
     return ret;
 }
 
+int TDBStore::get_start(get_handle_t *handle, const char *key, size_t *data_size)
+{
+    int ret;
+    record_header_t header;
+    get_handle_data_t *gh;
+    uint32_t bd_offset, next_bd_offset;
+    uint32_t flags, hash, ram_table_ind;
+    uint32_t actual_data_size;
+
+    if (!is_valid_key(key) || !handle) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+
+    ret = find_record(_active_area, key, bd_offset, ram_table_ind, hash);
+    if (ret) {
+        goto end;
+    }
+
+    // Validate the entire record now (data won't be copied anywhere), as data chunks are read
+    // directly later on
+    ret = read_record(_active_area, bd_offset, const_cast<char *>(key), 0, (uint32_t) -1,
+                      actual_data_size, 0, false, false, false, false, hash, flags,
+                      next_bd_offset);
+    if (ret) {
+        goto end;
+    }
+
+    ret = read_area(_active_area, bd_offset, sizeof(header), &header);
+    if (ret) {
+        goto end;
+    }
+
+    gh = new get_handle_data_t;
+    gh->key = new char[strlen(key) + 1];
+    strcpy(gh->key, key);
+    gh->crc = header.crc;
+    gh->data_offset = bd_offset + align_up(sizeof(record_header_t), _prog_size) + header.key_size;
+    gh->data_size = header.data_size;
+    gh->offset_in_data = 0;
+    gh->generation = _generation;
+
+    if (data_size) {
+        *data_size = header.data_size;
+    }
+    *handle = reinterpret_cast<get_handle_t>(gh);
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::get_data(get_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size)
+{
+    int ret = MBED_SUCCESS;
+    get_handle_data_t *gh = reinterpret_cast<get_handle_data_t *>(handle);
+    uint32_t chunk_size;
+
+    if (!gh || !actual_size || (!buffer && buffer_size)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+
+    // Garbage collection (or reset) moved the records since we located this one. Locate it again,
+    // and make sure it hasn't changed meanwhile.
+    if (gh->generation != _generation) {
+        record_header_t header;
+        uint32_t bd_offset, hash, ram_table_ind;
+        ret = find_record(_active_area, gh->key, bd_offset, ram_table_ind, hash);
+        if (ret) {
+            goto end;
+        }
+        ret = read_area(_active_area, bd_offset, sizeof(header), &header);
+        if (ret) {
+            goto end;
+        }
+        if (header.crc != gh->crc) {
+            ret = MBED_ERROR_INVALID_DATA_DETECTED;
+            goto end;
+        }
+        gh->data_offset = bd_offset + align_up(sizeof(record_header_t), _prog_size) + header.key_size;
+        gh->generation = _generation;
+    }
+
+    chunk_size = std::min((uint32_t) buffer_size, gh->data_size - gh->offset_in_data);
+    if (chunk_size) {
+        ret = read_area(_active_area, gh->data_offset + gh->offset_in_data, chunk_size, buffer);
+        if (ret) {
+            goto end;
+        }
+    }
+
+    gh->offset_in_data += chunk_size;
+    *actual_size = chunk_size;
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::get_finalize(get_handle_t handle)
+{
+    get_handle_data_t *gh = reinterpret_cast<get_handle_data_t *>(handle);
+
+    if (!gh) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    delete[] gh->key;
+    delete gh;
+    return MBED_SUCCESS;
+}
+
 int TDBStore::write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset)
 {
     master_record_data_t master_rec;
 
     master_rec.version = version;
     master_rec.tdbstore_revision = tdbstore_revision;
-    master_rec.reserved = 0;
+    master_rec.index_offset = _index_offset;
     next_offset = _master_record_offset + _master_record_size;
     return set(master_rec_key, &master_rec, sizeof(master_rec), 0);
 }
 
+int TDBStore::write_index_record(uint32_t offset, uint32_t &next_offset)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    index_entry_t *entries = reinterpret_cast<index_entry_t *>(_work_buf);
+    const uint32_t entries_per_chunk = work_buf_size / sizeof(index_entry_t);
+    record_header_t header;
+    uint32_t key_size = strlen(index_rec_key);
+    uint32_t data_size = _num_keys * sizeof(index_entry_t);
+    uint32_t header_size = align_up(sizeof(record_header_t), _prog_size);
+    uint32_t data_offset = offset + header_size + key_size;
+    int ret;
+
+    ret = check_erase_before_write(_active_area, offset, record_size(index_rec_key, data_size));
+    if (ret) {
+        return ret;
+    }
+
+    header.magic = tdbstore_magic;
+    header.header_size = sizeof(record_header_t);
+    header.revision = tdbstore_revision;
+    header.flags = index_flag;
+    header.key_size = key_size;
+    header.reserved = 0;
+    header.data_size = data_size;
+    header.crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    header.crc = calc_crc(header.crc, key_size, index_rec_key);
+
+    ret = write_area(_active_area, offset + header_size, key_size, index_rec_key);
+    if (ret) {
+        return ret;
+    }
+
+    // Entries are converted from the RAM table through the work buffer, a chunk at a time
+    for (uint32_t ind = 0; ind < _num_keys; ind += entries_per_chunk) {
+        uint32_t num_entries = std::min<uint32_t>(entries_per_chunk, _num_keys - ind);
+        uint32_t chunk_size = num_entries * sizeof(index_entry_t);
+        for (uint32_t i = 0; i < num_entries; i++) {
+            entries[i].hash = ram_table[ind + i].hash;
+            entries[i].bd_offset = ram_table[ind + i].bd_offset;
+        }
+        header.crc = calc_crc(header.crc, chunk_size, entries);
+        ret = write_area(_active_area, data_offset, chunk_size, entries);
+        if (ret) {
+            return ret;
+        }
+        data_offset += chunk_size;
+    }
+
+    // As in the incremental set, header is written last
+    ret = write_area(_active_area, offset, sizeof(record_header_t), &header);
+    if (ret) {
+        return ret;
+    }
+
+    next_offset = align_up(data_offset, _prog_size);
+    return MBED_SUCCESS;
+}
+
+int TDBStore::load_index_record(uint32_t &next_offset)
+{
+    ram_table_entry_t *ram_table;
+    index_entry_t *entries = reinterpret_cast<index_entry_t *>(_work_buf);
+    const uint32_t entries_per_chunk = work_buf_size / sizeof(index_entry_t);
+    record_header_t header;
+    uint32_t key_size = strlen(index_rec_key);
+    uint32_t offset = _index_offset;
+    uint32_t num_keys, ram_table_ind, hash, dummy;
+    uint32_t crc;
+    int ret;
+
+    // Index can only be found after the records it covers
+    if (offset < _master_record_offset + _master_record_size) {
+        return MBED_ERROR_ITEM_NOT_FOUND;
+    }
+
+    ret = read_area(_active_area, offset, sizeof(header), &header);
+    if (ret) {
+        return ret;
+    }
+
+    if ((header.magic != tdbstore_magic) || !(header.flags & index_flag) || (header.key_size != key_size) ||
+            (header.data_size % sizeof(index_entry_t)) ||
+            (offset + align_up(sizeof(record_header_t), _prog_size) + key_size + header.data_size > _size)) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    offset += align_up(sizeof(record_header_t), _prog_size);
+
+    ret = read_area(_active_area, offset, key_size, _work_buf);
+    if (ret) {
+        return ret;
+    }
+    if (memcmp(_work_buf, index_rec_key, key_size)) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+    crc = calc_crc(crc, key_size, _work_buf);
+    offset += key_size;
+
+    num_keys = header.data_size / sizeof(index_entry_t);
+    while (_max_keys < num_keys) {
+        increment_max_keys();
+    }
+    ram_table = (ram_table_entry_t *) _ram_table;
+
+    // Fill the RAM table in a single pass, it's only taken into use if the CRC matches.
+    // Entries must keep the RAM table order and point to records preceding the index.
+    for (uint32_t ind = 0; ind < num_keys; ind += entries_per_chunk) {
+        uint32_t num_entries = std::min(entries_per_chunk, num_keys - ind);
+        uint32_t chunk_size = num_entries * sizeof(index_entry_t);
+        ret = read_area(_active_area, offset, chunk_size, entries);
+        if (ret) {
+            return ret;
+        }
+        crc = calc_crc(crc, chunk_size, entries);
+        for (uint32_t i = 0; i < num_entries; i++) {
+            if ((entries[i].bd_offset < _master_record_offset) || (entries[i].bd_offset >= _index_offset) ||
+                    ((ind + i) && (entries[i].hash > ram_table[ind + i - 1].hash))) {
+                return MBED_ERROR_INVALID_DATA_DETECTED;
+            }
+            ram_table[ind + i].hash = entries[i].hash;
+            ram_table[ind + i].bd_offset = entries[i].bd_offset;
+        }
+        offset += chunk_size;
+    }
+
+    if (crc != header.crc) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    _num_keys = num_keys;
+
+    // A full scan takes the master record as a key as well. As it precedes all indexed
+    // records, it only counts if its key isn't in the index.
+    ret = find_record(_active_area, master_rec_key, dummy, ram_table_ind, hash);
+    if (ret == MBED_ERROR_ITEM_NOT_FOUND) {
+        if (_num_keys >= _max_keys) {
+            increment_max_keys();
+        }
+        update_ram_table(ram_table_ind, hash, _master_record_offset, true, false);
+        ret = MBED_SUCCESS;
+    }
+    if (ret) {
+        _num_keys = 0;
+        return ret;
+    }
+
+    next_offset = align_up(offset, _prog_size);
+    return MBED_SUCCESS;
+}
+
 int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_offset,
                           uint32_t &to_next_offset)
 {
@@ -781,12 +1331,18 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
     total_size = align_up(sizeof(record_header_t), _prog_size) +
                  align_up(header.key_size + header.data_size, _prog_size);;
 
+    if (to_offset + total_size > _size) {
+        return MBED_ERROR_MEDIA_FULL;
+    }
 
     ret = check_erase_before_write(1 - from_area, to_offset, total_size);
     if (ret) {
         return ret;
     }
 
+    // Copied records are committed ones, so clear the batch flag (not covered by CRC)
+    header.flags &= ~batch_flag;
+
     chunk_size = align_up(sizeof(record_header_t), _prog_size);
     ret = write_area(1 - from_area, to_offset, chunk_size, &header);
     if (ret) {
@@ -818,19 +1374,55 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
     return MBED_SUCCESS;
 }
 
-int TDBStore::garbage_collection()
+int TDBStore::gc_start()
 {
-    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
-    uint32_t to_offset, to_next_offset;
-    uint32_t chunk_size, reserved_size;
     int ret;
-    size_t ind;
 
     ret = check_erase_before_write(1 - _active_area, 0, _master_record_offset + _master_record_size);
     if (ret) {
         return ret;
     }
 
+    _gc_free_space_offset = _master_record_offset + _master_record_size;
+    _gc_ram_table_ind = 0;
+    _gc_in_progress = true;
+    return MBED_SUCCESS;
+}
+
+int TDBStore::gc_copy_records(uint32_t max_records)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    uint32_t to_next_offset;
+    int ret;
+
+    // Go over ram table and copy entries to opposite area (RAM table offsets
+    // keep pointing to the active area until GC is finished)
+    while (max_records && (_gc_ram_table_ind < _num_keys)) {
+        ret = copy_record(_active_area, ram_table[_gc_ram_table_ind].bd_offset, _gc_free_space_offset,
+                          to_next_offset);
+        if (ret) {
+            _gc_in_progress = false;
+            return ret;
+        }
+        ram_table[_gc_ram_table_ind].gc_offset = _gc_free_space_offset;
+        _gc_free_space_offset = to_next_offset;
+        _gc_ram_table_ind++;
+        max_records--;
+    }
+
+    return MBED_SUCCESS;
+}
+
+int TDBStore::gc_finish()
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    uint32_t to_offset;
+    uint32_t chunk_size, reserved_size;
+    int ret;
+    size_t ind;
+
+    _gc_in_progress = false;
+
     ret = do_reserved_data_get(0, RESERVED_AREA_SIZE);
 
     if (!ret) {
@@ -853,28 +1445,29 @@ int TDBStore::garbage_collection()
         }
     }
 
-    to_offset = _master_record_offset + _master_record_size;
-
-    // Initialize in case table is empty
-    to_next_offset = to_offset;
-
-    // Go over ram table and copy all entries to opposite area
+    // Update RAM table
     for (ind = 0; ind < _num_keys; ind++) {
-        uint32_t from_offset = ram_table[ind].bd_offset;
-        ret = copy_record(_active_area, from_offset, to_offset, to_next_offset);
-        if (ret) {
-            return ret;
-        }
-        // Update RAM table
-        ram_table[ind].bd_offset = to_offset;
-        to_offset = to_next_offset;
+        ram_table[ind].bd_offset = ram_table[ind].gc_offset;
     }
 
-    to_offset = to_next_offset;
-    _free_space_offset = to_next_offset;
+    to_offset = _gc_free_space_offset;
+    _free_space_offset = _gc_free_space_offset;
 
     // Now we can switch to the new active area
     _active_area = 1 - _active_area;
+    _generation++;
+
+    // Write an index checkpoint of the compacted records (if it fits), so that init doesn't
+    // need to scan them. It only takes effect once the master record pointing to it is written.
+    _index_offset = 0;
+    if (_free_space_offset + record_size(index_rec_key, _num_keys * sizeof(index_entry_t)) <= _size) {
+        ret = write_index_record(_free_space_offset, to_offset);
+        if (ret) {
+            return ret;
+        }
+        _index_offset = _free_space_offset;
+        _free_space_offset = to_offset;
+    }
 
     // Now write master record, with version incremented by 1.
     _active_area_version++;
@@ -889,9 +1482,123 @@ int TDBStore::garbage_collection()
         return ret;
     }
 
+    update_gc_trigger();
+
+    return MBED_SUCCESS;
+}
+
+int TDBStore::garbage_collection()
+{
+    int ret;
+
+    // Complete a pending incremental GC if we have one. Should this fail (e.g. standby area
+    // was filled with superseded records), start over.
+    if (_gc_in_progress) {
+        ret = gc_copy_records(_num_keys);
+        if (!ret) {
+            return gc_finish();
+        }
+    }
+
+    ret = gc_start();
+    if (ret) {
+        return ret;
+    }
+
+    ret = gc_copy_records(_num_keys);
+    if (ret) {
+        return ret;
+    }
+
+    return gc_finish();
+}
+
+int TDBStore::do_gc_step(uint32_t max_records)
+{
+    int ret;
+
+    if (!_gc_in_progress) {
+        if (_free_space_offset < _gc_trigger_offset) {
+            return MBED_SUCCESS;
+        }
+        ret = gc_start();
+        if (ret) {
+            return ret;
+        }
+    }
+
+    ret = gc_copy_records(max_records);
+    if (ret) {
+        return ret;
+    }
+
+    if (_gc_ram_table_ind == _num_keys) {
+        return gc_finish();
+    }
+
+    // Flush the standby area writes, so the active area is the only one buffered between steps
+    if (_buff_bd->sync()) {
+        _gc_in_progress = false;
+        return MBED_ERROR_WRITE_FAILED;
+    }
+
     return MBED_SUCCESS;
 }
 
+int TDBStore::gc_step(size_t max_records)
+{
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+    ret = do_gc_step(max_records ? max_records : (gc_step_records ? gc_step_records : 1));
+    _mutex.unlock();
+
+    return ret;
+}
+
+void TDBStore::gc_track_update(uint32_t ram_table_ind, uint32_t bd_offset, bool new_key, bool deleted)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    uint32_t to_next_offset;
+
+    // Keys not migrated yet will be picked up (with their new offset) by the following steps
+    if (ram_table_ind >= _gc_ram_table_ind) {
+        return;
+    }
+
+    // This is an already migrated key. Append the new record (or the deletion one) to the
+    // standby area, so it overrides the migrated copy. If it doesn't fit, abort this GC
+    // (it will restart on the next step, or be done in full when running out of space).
+    if (copy_record(_active_area, bd_offset, _gc_free_space_offset, to_next_offset)) {
+        _gc_in_progress = false;
+        return;
+    }
+
+    if (deleted) {
+        _gc_ram_table_ind--;
+    } else {
+        ram_table[ram_table_ind].gc_offset = _gc_free_space_offset;
+        if (new_key) {
+            _gc_ram_table_ind++;
+        }
+    }
+    _gc_free_space_offset = to_next_offset;
+}
+
+void TDBStore::update_gc_trigger()
+{
+    // Start incremental GC once the watermark is crossed, but make sure that
+    // at least half the remaining free space has been consumed since last compaction
+    // (no point compacting an area mostly holding live data).
+    uint32_t watermark_offset = (uint32_t)(((uint64_t) _size * gc_watermark) / 100);
+    uint32_t half_free_offset = _free_space_offset + (_size - _free_space_offset) / 2;
+    _gc_trigger_offset = std::max(watermark_offset, half_free_offset);
+}
+
 
 int TDBStore::build_ram_table()
 {
@@ -902,10 +1609,19 @@ int TDBStore::build_ram_table()
     uint32_t flags;
     uint32_t actual_data_size;
     uint32_t ram_table_ind;
+    uint32_t batch_start_offset = 0, batch_end_offset = 0;
+    bool in_batch = false;
 
     _num_keys = 0;
     offset = _master_record_offset;
 
+    // Records up to the index checkpoint are already covered by it, only scan the ones appended since.
+    // Should the index be missing or invalid, fall back to scanning all records.
+    if (_index_offset && (load_index_record(next_offset) == MBED_SUCCESS)) {
+        offset = next_offset;
+    }
+    ram_table = (ram_table_entry_t *) _ram_table;
+
     while (offset < _free_space_offset) {
         ret = read_record(_active_area, offset, _key_buf, 0, 0, actual_data_size, 0,
                           true, false, false, true, hash, flags, next_offset);
@@ -914,6 +1630,30 @@ int TDBStore::build_ram_table()
             goto end;
         }
 
+        // Index checkpoint isn't a key
+        if (flags & index_flag) {
+            offset = next_offset;
+            continue;
+        }
+
+        // Batch records only count once the batch is terminated. In this case,
+        // rescan the batch, now taking all its records into account.
+        if ((flags & batch_flag) && (offset >= batch_end_offset)) {
+            if (!in_batch) {
+                in_batch = true;
+                batch_start_offset = offset;
+            }
+            offset = next_offset;
+            continue;
+        }
+
+        if (in_batch) {
+            in_batch = false;
+            batch_end_offset = next_offset;
+            offset = batch_start_offset;
+            continue;
+        }
+
         ret = find_record(_active_area, _key_buf, dummy, ram_table_ind, hash);
 
         if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_ITEM_NOT_FOUND)) {
@@ -954,6 +1694,13 @@ int TDBStore::build_ram_table()
 
 end:
     _free_space_offset = next_offset;
+
+    if (in_batch && ((ret == MBED_SUCCESS) || (ret == MBED_ERROR_INVALID_DATA_DETECTED))) {
+        // Non terminated batch: Point free space to its start and treat it as corrupt data,
+        // so garbage collection drops it.
+        _free_space_offset = batch_start_offset;
+        ret = MBED_ERROR_INVALID_DATA_DETECTED;
+    }
     return ret;
 }
 
@@ -961,11 +1708,11 @@ int TDBStore::increment_max_keys(void **ram_table)
 {
     // Reallocate ram table with new size
     ram_table_entry_t *old_ram_table = (ram_table_entry_t *) _ram_table;
-    ram_table_entry_t *new_ram_table = new ram_table_entry_t[_max_keys + 1];
+    ram_table_entry_t *new_ram_table = new ram_table_entry_t[_max_keys + ram_table_grow_size];
 
     // Copy old content to new table
     memcpy(new_ram_table, old_ram_table, sizeof(ram_table_entry_t) * _max_keys);
-    _max_keys++;
+    _max_keys += ram_table_grow_size;
 
     _ram_table = new_ram_table;
     delete[] old_ram_table;
@@ -986,6 +1733,7 @@ int TDBStore::init()
     uint32_t actual_data_size;
     int os_ret, ret = MBED_SUCCESS, reserved_ret;
     uint16_t versions[_num_areas];
+    uint32_t index_offsets[_num_areas];
 
     _mutex.lock();
 
@@ -1006,6 +1754,7 @@ int TDBStore::init()
 #endif
 
     _max_keys = initial_max_keys;
+    _gc_in_progress = false;
 
     ram_table = new ram_table_entry_t[_max_keys];
     _ram_table = ram_table;
@@ -1013,7 +1762,7 @@ int TDBStore::init()
 
     _size = (size_t) -1;
 
-    _buff_bd = new BufferedBlockDevice(_bd);
+    _buff_bd = new BufferedBlockDevice(_bd, MBED_CONF_TDBSTORE_BUFFER_CACHE_LINES, MBED_CONF_TDBSTORE_BUFFER_READ_AHEAD);
     _buff_bd->init();
 
     // Underlying BD must have flash attributes, i.e. have an erase value
@@ -1036,6 +1785,7 @@ int TDBStore::init()
     for (uint8_t area = 0; area < _num_areas; area++) {
         area_state[area] = TDBSTORE_AREA_STATE_NONE;
         versions[area] = 0;
+        index_offsets[area] = 0;
 
         _size = std::min(_size, _area_params[area].size);
 
@@ -1059,6 +1809,7 @@ int TDBStore::init()
         }
 
         versions[area] = master_rec.version;
+        index_offsets[area] = master_rec.index_offset;
 
         area_state[area] = TDBSTORE_AREA_STATE_VALID;
 
@@ -1072,6 +1823,7 @@ int TDBStore::init()
     if ((area_state[0] == TDBSTORE_AREA_STATE_EMPTY) && (area_state[1] == TDBSTORE_AREA_STATE_EMPTY)) {
         _active_area = 0;
         _active_area_version = 1;
+        _index_offset = 0;
         ret = write_master_record(_active_area, _active_area_version, _free_space_offset);
         if (ret) {
             MBED_ERROR(ret, "TDBSTORE: Unable to write master record at init");
@@ -1098,6 +1850,7 @@ int TDBStore::init()
     // Currently set free space offset pointer to the end of free space.
     // Ram table build process needs it, but will update it.
     _free_space_offset = _size;
+    _index_offset = index_offsets[_active_area];
     ret = build_ram_table();
 
     if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_INVALID_DATA_DETECTED)) {
@@ -1132,6 +1885,7 @@ int TDBStore::init()
     }
 
 end:
+    update_gc_trigger();
     _is_initialized = true;
     _mutex.unlock();
     return ret;
@@ -1185,9 +1939,13 @@ int TDBStore::reset()
     _num_keys = 0;
     _free_space_offset = _master_record_offset;
     _active_area_version = 1;
+    _index_offset = 0;
+    _gc_in_progress = false;
+    _generation++;
 
     // Write an initial master record on active area
     ret = write_master_record(_active_area, _active_area_version, _free_space_offset);
+    update_gc_trigger();
 
 end:
     _mutex.unlock();
@@ -102,6 +102,7 @@ public:
      *          MBED_ERROR_WRITE_PROTECTED          Already stored with "write once" flag.
      */
     virtual int set(const char *key, const void *buffer, size_t size, uint32_t create_flags);
+    using KVStore::set;
 
     /**
      * @brief Get one TDBStore item by given key.
@@ -154,6 +155,24 @@ public:
      */
     virtual int remove(const char *key);
 
+    /**
+     * @brief Set a batch of TDBStore items atomically.
+     *        All items are committed together - either all of them or none are set, also in case of
+     *        a power failure during the operation.
+     *
+     * @param[in]  items                Array of items to set.
+     * @param[in]  num_items            Number of items.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_MEDIA_FULL               Not enough room on media.
+     *          MBED_ERROR_WRITE_PROTECTED          One of the items is already stored with "write once" flag.
+     */
+    virtual int set_batch(const batch_item_t *items, size_t num_items);
+
 
     /**
      * @brief Start an incremental TDBStore set sequence. This operation is blocking other operations.
@@ -203,6 +222,51 @@ public:
      */
     virtual int set_finalize(set_handle_t handle);
 
+    /**
+     * @brief Start a streaming TDBStore get sequence. The record is located and validated once,
+     *        and its data can then be read chunk by chunk, without blocking other operations
+     *        between chunks.
+     *
+     * @param[out] handle               Returned get handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] data_size            Value data size (NULL to pass nothing).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_DATA_DETECTED    Data is corrupt.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     */
+    virtual int get_start(get_handle_t *handle, const char *key, size_t *data_size = NULL);
+
+    /**
+     * @brief Read next data chunk in a streaming TDBStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size (0 once all data was read).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_DATA_DETECTED    Value was changed since sequence started.
+     *          MBED_ERROR_ITEM_NOT_FOUND           Key was removed since sequence started.
+     */
+    virtual int get_data(get_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size);
+
+    /**
+     * @brief Finalize a streaming TDBStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int get_finalize(get_handle_t handle);
+
     /**
      * @brief Start an iteration over KVStore keys.
      *        There are no issues with any other operations while iterator is open.
@@ -280,6 +344,24 @@ public:
     virtual int reserved_data_get(void *reserved_data, size_t reserved_data_buf_size,
                                   size_t *actual_data_size = 0);
 
+    /**
+     * @brief Perform one step of incremental garbage collection.
+     *        Once the used space crosses the "tdbstore.gc-watermark" configured level, each step
+     *        migrates up to the given number of records to the standby area, and the final step
+     *        switches areas. This allows spreading compaction latency over time, e.g. by calling
+     *        this from an idle thread or an EventQueue, instead of having a set operation perform
+     *        a full garbage collection when running out of space. Does nothing below the watermark.
+     *
+     * @param[in]  max_records          Maximum number of records to migrate in this step
+     *                                  (0 for the "tdbstore.gc-step-records" configured value).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     */
+    int gc_step(size_t max_records = 0);
+
 #if !defined(DOXYGEN_ONLY)
 private:
 
@@ -312,6 +394,12 @@ private:
     bool _variant_bd_erase_unit_size;
     void *_inc_set_handle;
     void *_iterator_table[_max_open_iterators];
+    bool _gc_in_progress;
+    uint32_t _gc_ram_table_ind;
+    uint32_t _gc_free_space_offset;
+    uint32_t _gc_trigger_offset;
+    uint32_t _generation;
+    uint32_t _index_offset;
 
     /**
      * @brief Read a block from an area.
@@ -325,6 +413,17 @@ private:
      */
     int read_area(uint8_t area, uint32_t offset, uint32_t size, void *buf);
 
+    /**
+     * @brief Get a pointer through which a block of an area can be read in place.
+     *
+     * @param[in]  area                   Area.
+     * @param[in]  offset                 Offset in area.
+     * @param[in]  size                   Number of bytes to read.
+     *
+     * @returns Pointer to the block, NULL if the block device is not memory mapped.
+     */
+    const uint8_t *mapped_area(uint8_t area, uint32_t offset, uint32_t size);
+
     /**
      * @brief Write a block to an area.
      *
@@ -387,6 +486,21 @@ private:
                     bool copy_data, bool check_expected_key, bool calc_hash,
                     uint32_t &hash, uint32_t &flags, uint32_t &next_offset);
 
+    /**
+     * @brief Write a full record to the active area.
+     *
+     * @param[in]  key                    Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  data_buf               Data buffer.
+     * @param[in]  data_size              Data size.
+     * @param[in]  flags                  Record flags.
+     * @param[in]  offset                 Offset of record in area.
+     * @param[out] next_offset            Offset of next record.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int write_record(const char *key, const void *data_buf, uint32_t data_size, uint32_t flags,
+                     uint32_t offset, uint32_t &next_offset);
+
     /**
      * @brief Write a master record of a given area.
      *
@@ -398,6 +512,25 @@ private:
      */
     int write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset);
 
+    /**
+     * @brief Write an index checkpoint record (hashes and offsets of the RAM table) to the active area.
+     *
+     * @param[in]  offset                 Offset of record in area.
+     * @param[out] next_offset            Offset of next record.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int write_index_record(uint32_t offset, uint32_t &next_offset);
+
+    /**
+     * @brief Load the RAM table from the index checkpoint record the master record points to.
+     *
+     * @param[out] next_offset            Offset of the record following the index.
+     *
+     * @returns 0 for success, nonzero for failure (no index or invalid one).
+     */
+    int load_index_record(uint32_t &next_offset);
+
     /**
      * @brief Copy a record from one area to the opposite one.
      *
@@ -413,11 +546,63 @@ private:
 
     /**
      * @brief Garbage collection (compact all records from active area to the standby one).
+     *        Completes a pending incremental garbage collection if there is one.
      *
      * @returns 0 for success, nonzero for failure.
      */
     int garbage_collection();
 
+    /**
+     * @brief Start garbage collection (prepare standby area).
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_start();
+
+    /**
+     * @brief Migrate records (in RAM table order) to the standby area.
+     *
+     * @param[in]  max_records            Maximum number of records to migrate.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_copy_records(uint32_t max_records);
+
+    /**
+     * @brief Finish garbage collection (switch to standby area once all records are migrated).
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_finish();
+
+    /**
+     * @brief Incremental garbage collection step - worker function.
+     *
+     * @param[in]  max_records            Maximum number of records to migrate.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int do_gc_step(uint32_t max_records);
+
+    /**
+     * @brief Keep a pending incremental garbage collection in sync with a set or remove operation.
+     *
+     * @param[in]  ram_table_ind          RAM table index of updated key.
+     * @param[in]  bd_offset              Offset of the new record in active area.
+     * @param[in]  new_key                Key was added.
+     * @param[in]  deleted                Key was deleted.
+     *
+     * @returns none
+     */
+    void gc_track_update(uint32_t ram_table_ind, uint32_t bd_offset, bool new_key, bool deleted);
+
+    /**
+     * @brief Calculate free space offset at which incremental garbage collection starts.
+     *
+     * @returns none
+     */
+    void update_gc_trigger();
+
     /**
      * @brief Return record size given key and data size.
      *
@@ -470,7 +655,22 @@ private:
     int do_set(const char *key, const void *data_buf, uint32_t data_buf_size, uint32_t flags);
 
     /**
-     * @brief Build RAM table and update _free_space_offset (scanning all the records in the area).
+     * @brief Update RAM table after a record is written.
+     *
+     * @param[in]  ram_table_ind        RAM table index.
+     * @param[in]  hash                 Key hash.
+     * @param[in]  bd_offset            Offset of record.
+     * @param[in]  new_key              Key was added.
+     * @param[in]  deleted              Key was deleted.
+     *
+     * @returns none
+     */
+    void update_ram_table(uint32_t ram_table_ind, uint32_t hash, uint32_t bd_offset,
+                          bool new_key, bool deleted);
+
+    /**
+     * @brief Build RAM table and update _free_space_offset (scanning all the records in the area,
+     *        or only the ones following the index checkpoint if there's a valid one).
      *
      * @returns 0 for success, nonzero for failure.
      */
@@ -79,6 +79,7 @@ static void nvstore_basic_functionality_test()
     NVStore &nvstore = NVStore::get_instance();
     uint16_t key;
     uint16_t max_possible_keys;
+    nvstore_init_stats_t init_stats;
 
     int result;
 
@@ -168,6 +169,13 @@ static void nvstore_basic_functionality_test()
     result = nvstore.init();
     TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
 
+    // set_max_keys ran a garbage collection, which left a key index for init to load
+    result = nvstore.get_init_stats(init_stats);
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    TEST_ASSERT_TRUE(init_stats.index_loaded);
+    printf("Init took %lu us, %lu records traversed\n", (unsigned long)init_stats.init_time_us,
+           (unsigned long)init_stats.replayed_records);
+
     result = nvstore.get(14, 20, nvstore_testing_buf_get, actual_len_bytes);
     TEST_ASSERT_EQUAL(NVSTORE_NOT_FOUND, result);
     result = nvstore.get(7, 0, NULL, actual_len_bytes);
@@ -26,6 +26,9 @@
 #include "mbed_assert.h"
 #include "mbed_error.h"
 #include "mbed_wait_api.h"
+#if DEVICE_USTICKER
+#include "hal/us_ticker_api.h"
+#endif
 #include <algorithm>
 #include <string.h>
 #include <stdio.h>
@@ -38,9 +41,10 @@ static const uint16_t delete_item_flag = 0x8000;
 static const uint16_t set_once_flag    = 0x4000;
 static const uint16_t header_flag_mask = 0xF000;
 
+static const uint16_t index_record_key  = 0xFFD;
 static const uint16_t master_record_key = 0xFFE;
 static const uint16_t no_key            = 0xFFF;
-static const uint16_t last_reserved_key = master_record_key;
+static const uint16_t last_reserved_key = index_record_key;
 
 typedef struct {
     uint16_t key_and_flags;
@@ -66,7 +70,7 @@ static const unsigned int owner_bit_pos = 12;
 typedef struct {
     uint16_t version;
     uint16_t max_keys;
-    uint32_t reserved;
+    uint32_t index_offset;      // Was reserved (0) before the key table index was introduced
 } master_record_data_t;
 
 static const uint32_t min_area_size = 4096;
@@ -144,10 +148,20 @@ static uint32_t crc32(uint32_t init_crc, uint32_t data_size, uint8_t *data_buf)
     return crc;
 }
 
+static uint32_t now_us()
+{
+#if DEVICE_USTICKER
+    return ticker_read_us(get_us_ticker_data());
+#else
+    return 0;
+#endif
+}
+
 NVStore::NVStore() : _init_done(0), _init_attempts(0), _active_area(0), _max_keys(NVSTORE_MAX_KEYS),
     _active_area_version(0), _free_space_offset(0), _size(0), _mutex(0), _offset_by_key(0), _flash(0),
     _min_prog_size(0), _page_buf(0)
 {
+    memset(&_init_stats, 0, sizeof(_init_stats));
 }
 
 NVStore::~NVStore()
@@ -356,7 +370,7 @@ int NVStore::read_record(uint8_t area, uint32_t offset, uint16_t buf_size, void
     flags = header.key_and_flags & header_flag_mask;
     owner = (header.size_and_owner & owner_mask) >> owner_bit_pos;
 
-    if ((key >= _max_keys) && (key != master_record_key)) {
+    if ((key >= _max_keys) && (key != master_record_key) && (key != index_record_key)) {
         valid = 0;
         return NVSTORE_SUCCESS;
     }
@@ -457,13 +471,13 @@ int NVStore::write_record(uint8_t area, uint32_t offset, uint16_t key, uint16_t
     return NVSTORE_SUCCESS;
 }
 
-int NVStore::write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset)
+int NVStore::write_master_record(uint8_t area, uint16_t version, uint32_t index_offset, uint32_t &next_offset)
 {
     master_record_data_t master_rec;
 
     master_rec.version = version;
     master_rec.max_keys = _max_keys;
-    master_rec.reserved = 0;
+    master_rec.index_offset = index_offset;
     return write_record(area, 0, master_record_key, 0, 0, sizeof(master_rec),
                         &master_rec, next_offset);
 }
@@ -536,9 +550,44 @@ int NVStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_of
     return NVSTORE_SUCCESS;
 }
 
+bool NVStore::load_index(uint8_t area, uint32_t index_offset, uint32_t &next_offset)
+{
+    uint16_t actual_size, key, flags;
+    uint8_t owner;
+    int valid;
+    int ret;
+
+    ret = read_record(area, index_offset, _max_keys * sizeof(uint32_t), _offset_by_key,
+                      actual_size, 0, valid, key, flags, owner, next_offset);
+    if ((ret != NVSTORE_SUCCESS) || !valid || (key != index_record_key) ||
+            (actual_size % sizeof(uint32_t))) {
+        memset(_offset_by_key, 0, _max_keys * sizeof(uint32_t));
+        return false;
+    }
+
+    // Every record in the index was copied ahead of it by the same garbage collection.
+    // Keys that were only allocated (and never set) are not kept, as in a full traversal.
+    memset((uint8_t *) _offset_by_key + actual_size, 0, _max_keys * sizeof(uint32_t) - actual_size);
+    for (key = 0; key < _max_keys; key++) {
+        uint32_t offset = _offset_by_key[key] & offs_by_key_offset_mask;
+        if (!offset) {
+            _offset_by_key[key] = 0;
+            continue;
+        }
+        if ((offset >= index_offset) ||
+                (((_offset_by_key[key] >> offs_by_key_area_bit_pos) & 1) != area)) {
+            memset(_offset_by_key, 0, _max_keys * sizeof(uint32_t));
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int NVStore::garbage_collection(uint16_t key, uint16_t flags, uint8_t owner, uint16_t buf_size, const void *buf, uint16_t num_keys)
 {
     uint32_t curr_offset, new_area_offset, next_offset, curr_owner;
+    uint32_t index_offset, index_size;
     int ret;
     uint8_t curr_area;
 
@@ -577,9 +626,24 @@ int NVStore::garbage_collection(uint16_t key, uint16_t flags, uint8_t owner, uin
         new_area_offset = next_offset;
     }
 
+    // Follow the records with a copy of the key table, so that init can load it in one read
+    // instead of traversing all of them. Skip it if it doesn't fit.
+    index_offset = 0;
+    index_size = num_keys * sizeof(uint32_t);
+    if ((index_size < max_data_size) &&
+            (new_area_offset + align_up(sizeof(nvstore_record_header_t) + index_size, _min_prog_size) < _size)) {
+        ret = write_record(1 - _active_area, new_area_offset, index_record_key, 0, 0,
+                           index_size, _offset_by_key, next_offset);
+        if (ret != NVSTORE_SUCCESS) {
+            return ret;
+        }
+        index_offset = new_area_offset;
+        new_area_offset = next_offset;
+    }
+
     // Now write master record, with version incremented by 1.
     _active_area_version++;
-    ret = write_master_record(1 - _active_area, _active_area_version, next_offset);
+    ret = write_master_record(1 - _active_area, _active_area_version, index_offset, next_offset);
     if (ret != NVSTORE_SUCCESS) {
         return ret;
     }
@@ -817,8 +881,10 @@ int NVStore::init()
     uint16_t flags;
     uint16_t versions[NVSTORE_NUM_AREAS];
     uint16_t keys[NVSTORE_NUM_AREAS];
+    uint32_t index_offsets[NVSTORE_NUM_AREAS];
     uint16_t actual_size;
     uint8_t owner;
+    uint32_t start_time;
 
     if (_init_done) {
         return NVSTORE_SUCCESS;
@@ -841,6 +907,9 @@ int NVStore::init()
         return NVSTORE_SUCCESS;
     }
 
+    start_time = now_us();
+    memset(&_init_stats, 0, sizeof(_init_stats));
+
     _mutex = new PlatformMutex;
     MBED_ASSERT(_mutex);
 
@@ -863,6 +932,7 @@ int NVStore::init()
         free_space_offset_of_area[area] =  0;
         versions[area] = 0;
         keys[area] = 0;
+        index_offsets[area] = 0;
 
         _size = std::min(_size, _flash_area_params[area].size);
 
@@ -897,6 +967,7 @@ int NVStore::init()
         }
         versions[area] = master_rec.version;
         keys[area] = master_rec.max_keys;
+        index_offsets[area] = master_rec.index_offset;
 
         // Place _free_space_offset after the master record (for the traversal,
         // which takes place after this loop).
@@ -923,8 +994,9 @@ int NVStore::init()
     // In case we have two empty areas, arbitrarily assign 0 to the active one.
     if ((area_state[0] == NVSTORE_AREA_STATE_EMPTY) && (area_state[1] == NVSTORE_AREA_STATE_EMPTY)) {
         _active_area = 0;
-        ret = write_master_record(_active_area, 1, _free_space_offset);
+        ret = write_master_record(_active_area, 1, 0, _free_space_offset);
         MBED_ASSERT(ret == NVSTORE_SUCCESS);
+        _init_stats.init_time_us = now_us() - start_time;
         _init_done = 1;
         return NVSTORE_SUCCESS;
     }
@@ -942,12 +1014,22 @@ int NVStore::init()
         MBED_ASSERT(!ret);
     }
 
+    // If the last garbage collection left an index of the keys, only the records written
+    // after it need to be traversed. Otherwise, start right after the master record.
+    if (index_offsets[_active_area] &&
+            (index_offsets[_active_area] < free_space_offset_of_area[_active_area]) &&
+            load_index(_active_area, index_offsets[_active_area], next_offset)) {
+        _free_space_offset = next_offset;
+        _init_stats.index_loaded = true;
+    }
+
     // Traverse area until reaching the empty space at the end or until reaching a faulty record
     while (_free_space_offset < free_space_offset_of_area[_active_area]) {
         ret = read_record(_active_area, _free_space_offset, 0, NULL,
                           actual_size, 1, valid,
                           key, flags, owner, next_offset);
         MBED_ASSERT(ret == NVSTORE_SUCCESS);
+        _init_stats.replayed_records++;
 
         // In case we have a faulty record, this probably means that the system crashed when written.
         // Perform a garbage collection, to make the other area valid.
@@ -955,6 +1037,11 @@ int NVStore::init()
             ret = garbage_collection(no_key, 0, 0, 0, NULL, _max_keys);
             break;
         }
+        // An index that couldn't be loaded holds nothing the records don't
+        if (key == index_record_key) {
+            _free_space_offset = next_offset;
+            continue;
+        }
         if (flags & delete_item_flag) {
             _offset_by_key[key] = 0;
         } else {
@@ -965,6 +1052,7 @@ int NVStore::init()
         _free_space_offset = next_offset;
     }
 
+    _init_stats.init_time_us = now_us() - start_time;
     _init_done = 1;
     return NVSTORE_SUCCESS;
 }
@@ -1027,6 +1115,16 @@ int NVStore::get_area_params(uint8_t area, uint32_t &address, size_t &size)
     return NVSTORE_SUCCESS;
 }
 
+int NVStore::get_init_stats(nvstore_init_stats_t &stats)
+{
+    if (!_init_done) {
+        init();
+    }
+
+    stats = _init_stats;
+    return NVSTORE_SUCCESS;
+}
+
 size_t NVStore::size()
 {
     if (!_init_done) {
@@ -68,6 +68,12 @@ typedef enum {
 // defines 2 areas - active and nonactive, not configurable
 #define NVSTORE_NUM_AREAS        2
 
+typedef struct {
+    uint32_t init_time_us;          // Duration of the last init, in microseconds
+    uint32_t replayed_records;      // Records traversed by the last init to build the key table
+    bool index_loaded;              // Key table was loaded from the index written by garbage collection
+} nvstore_init_stats_t;
+
 /** NVStore class
  *
  *  Class for storing data by keys in the internal flash
@@ -272,6 +278,15 @@ public:
      */
     int get_area_params(uint8_t area, uint32_t &address, size_t &size);
 
+    /**
+     * @brief Return statistics of the last initialization.
+     *
+     * @param[out] stats                  Init statistics.
+     *
+     * @returns NVSTORE_SUCCESS           Success.
+     */
+    int get_init_stats(nvstore_init_stats_t &stats);
+
 private:
     typedef struct {
         uint32_t address;
@@ -292,6 +307,7 @@ private:
     mbed::FlashIAP *_flash;
     uint32_t _min_prog_size;
     uint8_t *_page_buf;
+    nvstore_init_stats_t _init_stats;
 
     // Private constructor, as class is a singleton
     NVStore();
@@ -388,11 +404,23 @@ private:
      *
      * @param[in]  area                   Area.
      * @param[in]  version                Area version.
+     * @param[in]  index_offset           Offset of the key table index record (0 if none).
      * @param[out] next_offset            Offset of next record.
      *
      * @returns 0 for success, nonzero for failure.
      */
-    int write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset);
+    int write_master_record(uint8_t area, uint16_t version, uint32_t index_offset, uint32_t &next_offset);
+
+    /**
+     * @brief Load the key table from the index record written by garbage collection.
+     *
+     * @param[in]  area                   Area.
+     * @param[in]  index_offset           Offset of the index record in area.
+     * @param[out] next_offset            Offset of next record.
+     *
+     * @returns true if the key table was loaded, false if it needs to be rebuilt from the records.
+     */
+    bool load_index(uint8_t area, uint32_t index_offset, uint32_t &next_offset);
 
     /**
      * @brief Copy a record from one area to the other one.
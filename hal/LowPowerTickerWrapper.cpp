@@ -16,10 +16,15 @@
  */
 #include "hal/LowPowerTickerWrapper.h"
 #include "platform/Callback.h"
+#include <string.h>
 
-LowPowerTickerWrapper::LowPowerTickerWrapper(const ticker_data_t *data, const ticker_interface_t *interface, uint32_t min_cycles_between_writes, uint32_t min_cycles_until_match)
-    : _intf(data->interface), _min_count_between_writes(min_cycles_between_writes + 1), _min_count_until_match(min_cycles_until_match + 1), _suspended(false)
+LowPowerTickerWrapper::LowPowerTickerWrapper(const ticker_data_t *data, const ticker_interface_t *interface, uint32_t min_cycles_between_writes, uint32_t min_cycles_until_match,
+                                             uint32_t deferred_match_us, uint32_t read_cache_us)
+    : _intf(data->interface), _min_count_between_writes(min_cycles_between_writes + 1), _min_count_until_match(min_cycles_until_match + 1), _suspended(false),
+      _deferred_match_us(deferred_match_us), _read_cache_us(read_cache_us)
 {
+    memset(&_stats, 0, sizeof(_stats));
+
     core_util_critical_section_enter();
 
     this->data.interface = interface;
@@ -60,7 +65,7 @@ void LowPowerTickerWrapper::suspend()
 
     // Wait until rescheduling is allowed
     while (!_set_interrupt_allowed) {
-        timestamp_t current = _intf->read();
+        timestamp_t current = _read_hw();
         if (((current - _last_actual_set_interrupt) & _mask) >= _min_count_between_writes) {
             _set_interrupt_allowed  = true;
         }
@@ -78,7 +83,7 @@ void LowPowerTickerWrapper::resume()
 
     // Wait until rescheduling is allowed
     while (!_set_interrupt_allowed) {
-        timestamp_t current = _intf->read();
+        timestamp_t current = _read_hw();
         if (((current - _last_actual_set_interrupt) & _mask) >= _min_count_between_writes) {
             _set_interrupt_allowed  = true;
         }
@@ -89,6 +94,25 @@ void LowPowerTickerWrapper::resume()
     core_util_critical_section_exit();
 }
 
+void LowPowerTickerWrapper::invalidate()
+{
+    core_util_critical_section_enter();
+
+    _cache_valid = false;
+    _extrapolated = false;
+
+    core_util_critical_section_exit();
+}
+
+void LowPowerTickerWrapper::get_stats(lp_ticker_wrapper_stats_t *stats)
+{
+    core_util_critical_section_enter();
+
+    *stats = _stats;
+
+    core_util_critical_section_exit();
+}
+
 bool LowPowerTickerWrapper::timeout_pending()
 {
     core_util_critical_section_enter();
@@ -123,7 +147,7 @@ uint32_t LowPowerTickerWrapper::read()
 {
     core_util_critical_section_enter();
 
-    timestamp_t current = _intf->read();
+    timestamp_t current = _suspended ? _read_hw() : _read();
     if (!_suspended && _match_check(current)) {
         _intf->fire_interrupt();
     }
@@ -136,15 +160,25 @@ void LowPowerTickerWrapper::set_interrupt(timestamp_t timestamp)
 {
     core_util_critical_section_enter();
 
-    _last_set_interrupt = _intf->read();
+    _last_set_interrupt = _suspended ? _read_hw() : _read();
     _cur_match_time = timestamp;
     _pending_match = true;
-    if (!_suspended) {
-        _schedule_match(_last_set_interrupt);
-    } else {
-        _intf->set_interrupt(timestamp);
+    if (_suspended) {
+        _write(timestamp);
         _last_actual_set_interrupt = _last_set_interrupt;
         _set_interrupt_allowed = false;
+    } else if (_deferred_match_us &&
+               (uint64_t)((_cur_match_time - _last_set_interrupt) & _mask) * 1000000 / _frequency > 2 * (uint64_t)_deferred_match_us) {
+        // Far enough away to wait for the match to settle before writing it
+        if (_pending_timeout) {
+            // Written when the pending timeout fires, with any match set meanwhile
+            _stats.deferred_writes++;
+        } else {
+            _timeout.attach_us(mbed::callback(this, &LowPowerTickerWrapper::_timeout_handler), _deferred_match_us);
+            _pending_timeout = true;
+        }
+    } else {
+        _schedule_match(_last_set_interrupt);
     }
 
     core_util_critical_section_exit();
@@ -201,6 +235,9 @@ void LowPowerTickerWrapper::_reset()
     _cur_match_time = 0;
     _last_set_interrupt = 0;
     _last_actual_set_interrupt = 0;
+    _cache_valid = false;
+    _extrapolated = false;
+    _last_read = 0;
 
     const ticker_info_t *info = _intf->get_info();
     if (info->bits >= 32) {
@@ -211,6 +248,64 @@ void LowPowerTickerWrapper::_reset()
 
     // Round us_per_tick up
     _us_per_tick = (1000000 + info->frequency - 1) / info->frequency;
+    _frequency = info->frequency;
+}
+
+timestamp_t LowPowerTickerWrapper::_read()
+{
+    MBED_ASSERT(core_util_in_critical_section());
+
+    timestamp_t current;
+    bool extrapolated = false;
+
+    if (_cache_valid) {
+        us_timestamp_t elapsed_us = ticker_read_us_lock_free(get_us_ticker_data()) - _cache_time;
+        if (elapsed_us < _read_cache_us) {
+            // Rounded down, so only clock drift can take it ahead of the hardware
+            current = (_cache_count + elapsed_us * _frequency / 1000000) & _mask;
+            extrapolated = true;
+            _stats.cached_reads++;
+        }
+    }
+    if (!extrapolated) {
+        current = _read_hw();
+        _cache_valid = (_read_cache_us != 0);
+    }
+
+    // Never go back behind an extrapolated count, the ticker would see it as a wrap
+    if (_extrapolated) {
+        uint32_t behind = (_last_read - current) & _mask;
+        if (behind && behind <= (_mask >> 1)) {
+            current = _last_read;
+            extrapolated = true;
+        }
+    }
+    _extrapolated = extrapolated;
+    _last_read = current;
+    return current;
+}
+
+timestamp_t LowPowerTickerWrapper::_read_hw()
+{
+    us_timestamp_t start = ticker_read_us_lock_free(get_us_ticker_data());
+    timestamp_t current = _intf->read();
+    us_timestamp_t end = ticker_read_us_lock_free(get_us_ticker_data());
+
+    _stats.reads++;
+    _stats.sync_wait_us += end - start;
+    _cache_count = current;
+    _cache_time = end;
+    return current;
+}
+
+void LowPowerTickerWrapper::_write(timestamp_t timestamp)
+{
+    us_timestamp_t start = ticker_read_us_lock_free(get_us_ticker_data());
+    _intf->set_interrupt(timestamp);
+    us_timestamp_t end = ticker_read_us_lock_free(get_us_ticker_data());
+
+    _stats.writes++;
+    _stats.sync_wait_us += end - start;
 }
 
 void LowPowerTickerWrapper::_timeout_handler()
@@ -218,7 +313,7 @@ void LowPowerTickerWrapper::_timeout_handler()
     core_util_critical_section_enter();
     _pending_timeout = false;
 
-    timestamp_t current = _intf->read();
+    timestamp_t current = _read();
     /* Add extra check for '_last_set_interrupt == _cur_match_time'
      *
      * When '_last_set_interrupt == _cur_match_time', _ticker_match_interval_passed sees it as
@@ -286,8 +381,8 @@ void LowPowerTickerWrapper::_schedule_match(timestamp_t current)
     if (!too_close) {
 
         // Schedule LP ticker
-        _intf->set_interrupt(_cur_match_time);
-        current = _intf->read();
+        _write(_cur_match_time);
+        current = _read_hw();
         _last_actual_set_interrupt = current;
         _set_interrupt_allowed = false;
 
@@ -24,6 +24,7 @@
 
 #include "hal/ticker_api.h"
 #include "hal/us_ticker_api.h"
+#include "hal/mbed_lp_ticker_wrapper.h"
 #include "drivers/Timeout.h"
 
 
@@ -58,10 +59,16 @@ public:
      *          |                                   |
      *      set_interrupt              Earliest match timestamp allowed
      *
-     *
+     * @param deferred_match_us Time in microseconds match writes are deferred by, so
+     * a match set again meanwhile is written once. Only matches further away than
+     * twice this time are deferred. 0 writes every match when it is set.
+     * @param read_cache_us Time in microseconds a count read from the hardware is
+     * extrapolated with the microsecond ticker rather than read again. 0 reads the
+     * hardware every time.
      */
 
-    LowPowerTickerWrapper(const ticker_data_t *data, const ticker_interface_t *interface, uint32_t min_cycles_between_writes, uint32_t min_cycles_until_match);
+    LowPowerTickerWrapper(const ticker_data_t *data, const ticker_interface_t *interface, uint32_t min_cycles_between_writes, uint32_t min_cycles_until_match,
+                          uint32_t deferred_match_us = 0, uint32_t read_cache_us = 0);
 
     /**
      * Interrupt handler called by the underlying driver/hardware
@@ -86,6 +93,20 @@ public:
      */
     void resume();
 
+    /**
+     * Drop the cached count
+     *
+     * This must be called when the microsecond ticker may have stopped, e.g. after deep sleep.
+     */
+    void invalidate();
+
+    /**
+     * Get the hardware access statistics
+     *
+     * @param stats Returned statistics
+     */
+    void get_stats(lp_ticker_wrapper_stats_t *stats);
+
     /**
      * Check if a Timeout object is being used
      *
@@ -202,9 +223,69 @@ private:
      */
     uint32_t _us_per_tick;
 
+    /*
+     * Low power ticker frequency
+     */
+    uint32_t _frequency;
+
+    /*
+     * Time match writes are deferred by, 0 if not deferred
+     */
+    const uint32_t _deferred_match_us;
+
+    /*
+     * Time a count read from the hardware is extrapolated for, 0 if not cached
+     */
+    const uint32_t _read_cache_us;
+
+    /*
+     * _cache_count and _cache_time are valid
+     */
+    bool _cache_valid;
+
+    /*
+     * Last count read from the hardware
+     */
+    uint32_t _cache_count;
+
+    /*
+     * Microsecond ticker time of _cache_count
+     */
+    us_timestamp_t _cache_time;
+
+    /*
+     * Last count returned by _read, cached or not
+     */
+    uint32_t _last_read;
+
+    /*
+     * _last_read may be ahead of the hardware count
+     */
+    bool _extrapolated;
+
+    /*
+     * Hardware access statistics
+     */
+    lp_ticker_wrapper_stats_t _stats;
+
 
     void _reset();
 
+    /*
+     * Read the count, from the cache when it is recent enough
+     */
+    timestamp_t _read();
+
+    /*
+     * Read the count from the hardware, updating the cache
+     */
+    timestamp_t _read_hw();
+
+    /*
+     * Write the match to the hardware
+     */
+    void _write(timestamp_t timestamp);
+
     /**
      * Set the low power ticker match time when hardware is ready
      *
@@ -0,0 +1,125 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGIN_DMA_API_H
+#define MBED_ANALOGIN_DMA_API_H
+
+#include "device.h"
+#include "pinmap.h"
+#include <stddef.h>
+
+#if DEVICE_ANALOGIN_DMA
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Analogin DMA hal structure. analogin_dma_s is declared in the target's hal
+ */
+typedef struct analogin_dma_s analogin_dma_t;
+
+/**
+ * \defgroup hal_analogin_dma Analogin DMA hal functions
+ *
+ * Continuous, timer triggered sampling of one or more analog inputs into a
+ * circular buffer.
+ *
+ * # Defined behavior
+ * * Each trigger converts all configured channels once, samples are stored
+ *   interleaved in channel order
+ * * The buffer is filled continuously, ::ANALOGIN_DMA_EVENT_HALF is reported when
+ *   the first half is complete and ::ANALOGIN_DMA_EVENT_FULL when the second half is
+ *   complete, after which sampling wraps to the start of the buffer
+ * * Samples are unsigned and scaled to the same 16-bit range as ::analogin_read_u16
+ * * The handler is called from interrupt context
+ *
+ * # Undefined behavior
+ * * Using ::analogin_init on pins of the same converter while sampling is running
+ * * A buffer length that is not a multiple of twice the number of channels
+ * @{
+ */
+
+/** Events reported to the analogin DMA handler */
+typedef enum {
+    ANALOGIN_DMA_EVENT_HALF  = (1 << 0), /**< First half of the buffer is filled */
+    ANALOGIN_DMA_EVENT_FULL  = (1 << 1), /**< Second half of the buffer is filled */
+    ANALOGIN_DMA_EVENT_ERROR = (1 << 2)  /**< Conversion overrun or transfer error, sampling has stopped */
+} analogin_dma_event_t;
+
+/** Handler called when a half of the buffer is complete
+ *
+ * @param id    The id given to ::analogin_dma_start
+ * @param event One of ::analogin_dma_event_t
+ */
+typedef void (*analogin_dma_handler_t)(uint32_t id, uint32_t event);
+
+/** Initialize the analogin DMA peripheral
+ *
+ * All pins must belong to the same converter.
+ *
+ * @param obj      The analogin DMA object to initialize
+ * @param pins     Array of analogin pins, sampled in this order
+ * @param channels Number of pins in the array
+ */
+void analogin_dma_init(analogin_dma_t *obj, const PinName *pins, uint8_t channels);
+
+/** Release the analogin DMA peripheral, stopping sampling first
+ *
+ * @param obj The analogin DMA object
+ */
+void analogin_dma_free(analogin_dma_t *obj);
+
+/** Set the sampling rate
+ *
+ * Must be called while sampling is stopped.
+ *
+ * @param obj The analogin DMA object
+ * @param hz  Requested number of samples per second on each channel
+ * @return    The rate actually used, 0 if the rate cannot be achieved
+ */
+uint32_t analogin_dma_set_rate(analogin_dma_t *obj, uint32_t hz);
+
+/** Start continuous sampling
+ *
+ * @param obj     The analogin DMA object
+ * @param buffer  Circular buffer the samples are stored in
+ * @param length  Number of samples the buffer holds
+ * @param handler Function called when each half of the buffer is filled
+ * @param id      Argument passed to the handler
+ * @return        0 on success, -1 on failure
+ */
+int analogin_dma_start(analogin_dma_t *obj, uint16_t *buffer, size_t length, analogin_dma_handler_t handler, uint32_t id);
+
+/** Stop sampling
+ *
+ * @param obj The analogin DMA object
+ */
+void analogin_dma_stop(analogin_dma_t *obj);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,147 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CAPTURE_API_H
+#define MBED_CAPTURE_API_H
+
+#include "device.h"
+#include "pinmap.h"
+#include <stddef.h>
+
+#if DEVICE_CAPTURE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Capture hal structure. capture_s is declared in the target's hal
+ */
+typedef struct capture_s capture_t;
+
+/**
+ * \defgroup hal_capture Input capture hal functions
+ *
+ * Timestamping of the edges of an input by a hardware timer, the timestamps
+ * being stored into a circular buffer without software intervention.
+ *
+ * # Defined behavior
+ * * Each selected edge stores the value of a free running timer counter,
+ *   counting at the rate set by ::capture_set_frequency and wrapping at 2^32
+ * * The buffer is filled continuously, ::CAPTURE_EVENT_HALF is reported when
+ *   the first half is complete and ::CAPTURE_EVENT_FULL when the second half is
+ *   complete, after which capture wraps to the start of the buffer
+ * * Pulses shorter than the filter set by ::capture_set_filter are ignored
+ * * The handler is called from interrupt context
+ *
+ * # Undefined behavior
+ * * Changing the frequency or the filter while capture is running
+ * * A buffer length that is not a multiple of two
+ * @{
+ */
+
+/** Edges of the input that are timestamped */
+typedef enum {
+    CAPTURE_EDGE_RISING  = (1 << 0), /**< Rising edges */
+    CAPTURE_EDGE_FALLING = (1 << 1), /**< Falling edges */
+    CAPTURE_EDGE_BOTH    = CAPTURE_EDGE_RISING | CAPTURE_EDGE_FALLING /**< Both edges */
+} capture_edge_t;
+
+/** Events reported to the capture handler */
+typedef enum {
+    CAPTURE_EVENT_HALF  = (1 << 0), /**< First half of the buffer is filled */
+    CAPTURE_EVENT_FULL  = (1 << 1), /**< Second half of the buffer is filled */
+    CAPTURE_EVENT_ERROR = (1 << 2)  /**< Transfer error, capture has stopped */
+} capture_event_t;
+
+/** Handler called when a half of the buffer is complete
+ *
+ * @param id    The id given to ::capture_start
+ * @param event One of ::capture_event_t
+ */
+typedef void (*capture_handler_t)(uint32_t id, uint32_t event);
+
+/** Initialize the input capture peripheral
+ *
+ * @param obj The capture object to initialize
+ * @param pin Timer capture input pin
+ */
+void capture_init(capture_t *obj, PinName pin);
+
+/** Release the input capture peripheral, stopping capture first
+ *
+ * @param obj The capture object
+ */
+void capture_free(capture_t *obj);
+
+/** Set the rate the timestamps count at
+ *
+ * @param obj The capture object
+ * @param hz  Requested timer frequency
+ * @return    The frequency actually used, 0 if the frequency cannot be achieved
+ */
+uint32_t capture_set_frequency(capture_t *obj, uint32_t hz);
+
+/** Set the input filter debouncing the edges
+ *
+ * The input must be stable for the filter length before an edge is captured,
+ * which also delays the timestamps by that length.
+ *
+ * @param obj The capture object
+ * @param ns  Minimum length in nanoseconds of the pulses to capture, 0 to disable the filter
+ * @return    The filter length actually used in nanoseconds, the shortest one at least ns
+ *            or the longest one available
+ */
+uint32_t capture_set_filter(capture_t *obj, uint32_t ns);
+
+/** Start capturing edges
+ *
+ * @param obj     The capture object
+ * @param edge    The edges to timestamp
+ * @param buffer  Circular buffer the timestamps are stored in
+ * @param length  Number of timestamps the buffer holds
+ * @param handler Function called when each half of the buffer is filled
+ * @param id      Argument passed to the handler
+ * @return        0 on success, -1 on failure
+ */
+int capture_start(capture_t *obj, capture_edge_t edge, uint32_t *buffer, size_t length, capture_handler_t handler, uint32_t id);
+
+/** Get the index in the buffer the next timestamp is stored at
+ *
+ * @param obj The capture object
+ * @return    The index in the buffer of the next timestamp
+ */
+size_t capture_get_position(capture_t *obj);
+
+/** Stop capturing
+ *
+ * @param obj The capture object
+ */
+void capture_stop(capture_t *obj);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
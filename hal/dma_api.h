@@ -20,9 +20,15 @@
 #ifndef MBED_DMA_API_H
 #define MBED_DMA_API_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #define DMA_ERROR_OUT_OF_CHANNELS (-1)
+#define DMA_ERROR_UNSUPPORTED     (-2)
+#define DMA_ERROR_BUSY            (-3)
+#define DMA_ERROR_TRANSFER        (-4)
+#define DMA_ERROR_ABORTED         (-5)
 
 typedef enum {
     DMA_USAGE_NEVER,
@@ -32,16 +38,132 @@ typedef enum {
     DMA_USAGE_ALLOCATED
 } DMAUsage;
 
+/** Direction of a DMA transfer
+ */
+typedef enum {
+    DMA_DIRECTION_MEM_TO_MEM,    /**< Both addresses increment */
+    DMA_DIRECTION_MEM_TO_PERIPH, /**< Destination is a peripheral register */
+    DMA_DIRECTION_PERIPH_TO_MEM  /**< Source is a peripheral register */
+} dma_direction_t;
+
+/** Size of each element moved by a DMA transfer
+ */
+typedef enum {
+    DMA_WIDTH_8 = 1,
+    DMA_WIDTH_16 = 2,
+    DMA_WIDTH_32 = 4
+} dma_width_t;
+
+/** A DMA transfer, possibly chained to the next one
+ *
+ * Descriptors must stay valid until the transfer completes.
+ */
+typedef struct dma_desc_s {
+    dma_direction_t direction;    /**< Direction of the transfer */
+    dma_width_t width;            /**< Size of each element */
+    const volatile void *src;     /**< Source address */
+    volatile void *dst;           /**< Destination address */
+    uint32_t count;               /**< Number of elements */
+    uint32_t request;             /**< Target specific peripheral request, ignored for DMA_DIRECTION_MEM_TO_MEM */
+    const struct dma_desc_s *next; /**< Transfer started when this one is done, NULL for the last one */
+} dma_desc_t;
+
+/** Called from interrupt context when a chain of transfers ends
+ *
+ * @param context The context passed to ::dma_channel_start
+ * @param result  0 if all transfers completed, DMA_ERROR_TRANSFER or DMA_ERROR_ABORTED
+ */
+typedef void (*dma_handler_t)(void *context, int result);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * \defgroup hal_dma DMA hal functions
+ *
+ * Channels are shared by all drivers: a driver requests a channel with
+ * ::dma_channel_allocate and gives it back with ::dma_channel_free. The
+ * capabilities and peripheral requests are target specific.
+ *
+ * ::dma_channel_start, ::dma_channel_abort and ::dma_channel_busy run
+ * transfers on a channel. Targets implementing them keep the data cache
+ * coherent: source buffers are cleaned before a transfer and destination
+ * buffers invalidated before and after it, see ::dma_cache_clean and
+ * ::dma_cache_invalidate. Buffers written by DMA on a target with a data
+ * cache should be aligned to and a multiple of the cache line size, so no
+ * other data shares their cache lines.
+ *
+ * Targets not implementing transfers get defaults reporting
+ * DMA_ERROR_UNSUPPORTED, and targets without a DMA HAL get defaults
+ * reporting DMA_ERROR_OUT_OF_CHANNELS, so drivers can fall back to CPU
+ * copies.
+ *
+ * @{
+ */
+
 void dma_init(void);
 
+/** Request a channel
+ *
+ * @param capabilities Target specific capabilities the channel needs
+ * @return The channel, or DMA_ERROR_OUT_OF_CHANNELS
+ */
 int dma_channel_allocate(uint32_t capabilities);
 
+/** Release a channel
+ *
+ * @param channelid The channel from ::dma_channel_allocate
+ * @return 0
+ */
 int dma_channel_free(int channelid);
 
+/** Start a chain of transfers on a channel
+ *
+ * @param channelid The channel from ::dma_channel_allocate
+ * @param desc      The first transfer
+ * @param handler   Called when the chain ends, may be NULL
+ * @param context   Passed to the handler
+ * @return 0 on success, DMA_ERROR_BUSY if the channel is running a chain,
+ *         DMA_ERROR_UNSUPPORTED if the target or channel can't run it
+ */
+int dma_channel_start(int channelid, const dma_desc_t *desc, dma_handler_t handler, void *context);
+
+/** Stop the chain running on a channel
+ *
+ * The handler is called with DMA_ERROR_ABORTED if a chain was running.
+ *
+ * @param channelid The channel from ::dma_channel_allocate
+ */
+void dma_channel_abort(int channelid);
+
+/** Check if a chain is running on a channel
+ *
+ * @param channelid The channel from ::dma_channel_allocate
+ * @return true until the handler of the chain has been called
+ */
+bool dma_channel_busy(int channelid);
+
+/** Write back the data cache lines of a buffer a DMA transfer reads
+ *
+ * Does nothing on cores without a data cache.
+ *
+ * @param addr Start of the buffer
+ * @param size Size of the buffer in bytes
+ */
+void dma_cache_clean(const volatile void *addr, size_t size);
+
+/** Discard the data cache lines of a buffer a DMA transfer writes
+ *
+ * Does nothing on cores without a data cache.
+ *
+ * @param addr Start of the buffer
+ * @param size Size of the buffer in bytes
+ */
+void dma_cache_invalidate(volatile void *addr, size_t size);
+
+/**@}*/
+
 #ifdef __cplusplus
 }
 #endif
@@ -76,6 +76,17 @@ int32_t flash_erase_sector(flash_t *obj, uint32_t address);
  */
 int32_t flash_read(flash_t *obj, uint32_t address, uint8_t *data, uint32_t size);
 
+/** Get the address through which flash can be read in place
+ *
+ * This function has a WEAK implementation returning the address itself, which
+ * matches the WEAK flash_read. Targets whose flash_read does more than copy
+ * from the address space return NULL.
+ * @param obj The flash object
+ * @param address Flash address
+ * @return Pointer to the flash contents at address, or NULL if flash is not memory mapped
+ */
+const void *flash_get_mapped_address(const flash_t *obj, uint32_t address);
+
 /** Program pages starting at defined address
  *
  * The pages should not cross multiple sectors.
@@ -125,6 +136,50 @@ uint32_t flash_get_size(const flash_t *obj);
  */
 uint8_t flash_get_erase_value(const flash_t *obj);
 
+/** Get the bank a flash address belongs to
+ *
+ * Code can keep running from one bank while another bank is erased or
+ * programmed. This function has a WEAK implementation returning 0, for
+ * targets with a single bank.
+ * @param obj The flash object
+ * @param address Flash address
+ * @return Number of the bank, starting from 0
+ */
+uint32_t flash_get_bank(const flash_t *obj, uint32_t address);
+
+/** Start erasing a sector without waiting for it to complete
+ *
+ * The handler is installed as the flash interrupt vector and must call
+ * flash_irq_handler_asynch. This function has a WEAK implementation returning
+ * -1, callers then fall back to flash_erase_sector.
+ * @param obj The flash object
+ * @param address The sector starting address
+ * @param handler The flash interrupt handler
+ * @return 0 if the erase was started, -1 for error or if not supported
+ */
+int32_t flash_erase_sector_asynch(flash_t *obj, uint32_t address, uint32_t handler);
+
+/** Start programming pages without waiting for it to complete
+ *
+ * Same requirements as flash_program_page, and the data buffer must be kept
+ * until the operation completes. This function has a WEAK implementation
+ * returning -1, callers then fall back to flash_program_page.
+ * @param obj The flash object
+ * @param address The page starting address
+ * @param data The data buffer to be programmed
+ * @param size The number of bytes to program
+ * @param handler The flash interrupt handler
+ * @return 0 if programming was started, -1 for error or if not supported
+ */
+int32_t flash_program_page_asynch(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size, uint32_t handler);
+
+/** Handle the flash interrupt of an asynchronous erase or program
+ *
+ * @param obj The flash object
+ * @return 0 while the operation is ongoing, 1 once it completed, -1 if it failed
+ */
+int32_t flash_irq_handler_asynch(flash_t *obj);
+
 /**@}*/
 
 #ifdef __cplusplus
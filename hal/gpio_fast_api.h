@@ -0,0 +1,89 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_GPIO_FAST_API_H
+#define MBED_GPIO_FAST_API_H
+
+#include "hal/gpio_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_gpio_fast Fast GPIO HAL functions
+ *
+ * Set, clear and read a pin initialized by the GPIO HAL, each with a single
+ * access to a register whose address gpio_init cached in the gpio_t.
+ *
+ * A target provides them as static inline functions in its gpio_object.h,
+ * and defines GPIO_FAST_API there. Other targets get the functions below,
+ * which call ::gpio_write and ::gpio_read.
+ *
+ * # Defined behavior
+ * * ::gpio_fast_set and ::gpio_fast_clear have the effect of ::gpio_write with 1 and 0 - Verified by ::gpio_fast_test
+ * * ::gpio_fast_read returns what ::gpio_read returns - Verified by ::gpio_fast_test
+ *
+ * # Undefined behavior
+ * * Calling any of them on a gpio_t object that was initialized with NC.
+ *
+ * @{
+ */
+
+#if !defined(GPIO_FAST_API) || defined(DOXYGEN_ONLY)
+
+/** Set the output of a pin to 1
+ *
+ * @param obj The GPIO object
+ */
+static inline void gpio_fast_set(gpio_t *obj)
+{
+    gpio_write(obj, 1);
+}
+
+/** Set the output of a pin to 0
+ *
+ * @param obj The GPIO object
+ */
+static inline void gpio_fast_clear(gpio_t *obj)
+{
+    gpio_write(obj, 0);
+}
+
+/** Read the input value of a pin
+ *
+ * @param obj The GPIO object
+ * @return An integer value 1 or 0
+ */
+static inline int gpio_fast_read(gpio_t *obj)
+{
+    return gpio_read(obj);
+}
+
+#endif
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
@@ -59,6 +59,16 @@ typedef struct i2c_s i2c_t;
 
 #endif
 
+/** Pins and pin functions of an I2C peripheral, see hal/static_pinmap.h
+ */
+typedef struct {
+    int peripheral;   /**< Peripheral both pins map to */
+    PinName sda_pin;  /**< SDA pin */
+    int sda_function; /**< Function of the SDA pin */
+    PinName scl_pin;  /**< SCL pin */
+    int scl_function; /**< Function of the SCL pin */
+} i2c_pinmap_t;
+
 enum {
     I2C_ERROR_NO_SLAVE = -1,
     I2C_ERROR_BUS_BUSY = -2
@@ -82,6 +92,16 @@ extern "C" {
  */
 void i2c_init(i2c_t *obj, PinName sda, PinName scl);
 
+/** Initialize the I2C peripheral from a resolved pinmap
+ *
+ *  Like ::i2c_init, but without looking up the PinMap tables. The default
+ *  implementation calls ::i2c_init with the pins of the pinmap.
+ *
+ *  @param obj    The I2C object
+ *  @param pinmap Pins of the I2C peripheral, see ::get_i2c_pinmap
+ */
+void i2c_init_direct(i2c_t *obj, const i2c_pinmap_t *pinmap);
+
 /** Configure the I2C frequency
  *
  *  @param obj The I2C object
@@ -230,6 +250,50 @@ int  i2c_slave_write(i2c_t *obj, const char *data, int length);
  */
 void i2c_slave_address(i2c_t *obj, int idx, uint32_t address, uint32_t mask);
 
+/** The master has read from this slave, the transmit buffer was used */
+#define I2C_SLAVE_EVENT_READ_DONE  (1 << 0)
+/** The master has written to this slave, the receive buffer was used */
+#define I2C_SLAVE_EVENT_WRITE_DONE (1 << 1)
+/** The transaction failed, e.g. on a bus error */
+#define I2C_SLAVE_EVENT_ERROR      (1 << 2)
+
+/** Handler called when an asynchronous slave transaction has finished
+ *
+ * @param id    The id given when the transfer was started
+ * @param event I2C_SLAVE_EVENT_READ_DONE, I2C_SLAVE_EVENT_WRITE_DONE or I2C_SLAVE_EVENT_ERROR
+ * @param count Number of bytes sent for a read, received for a write
+ */
+typedef void (*i2c_slave_async_handler_t)(uint32_t id, int event, size_t count);
+
+/** Serve the next transaction addressed to this slave in the background
+ *
+ * A read by the master is answered from the TX buffer, a write by the master
+ * is stored in the RX buffer, without the slave having to poll
+ * ::i2c_slave_receive. The handler is called from interrupt context on the
+ * stop or repeated start ending the transaction, and may start the next one.
+ * Bytes written past the end of the RX buffer are not acknowledged.
+ *
+ * Optional, the default implementation returns -1.
+ *
+ * @param obj       The I2C object
+ * @param tx        TX buffer, may be NULL, must stay valid until the handler is called
+ * @param tx_length TX buffer length in bytes
+ * @param rx        RX buffer, may be NULL, must stay valid until the handler is called
+ * @param rx_length RX buffer length in bytes
+ * @param handler   Function called when the transaction ends
+ * @param id        Argument passed to the handler
+ * @return 0 if the transfer has started, -1 if not supported or on failure
+ */
+int i2c_slave_transfer_async(i2c_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, i2c_slave_async_handler_t handler, uint32_t id);
+
+/** Abort an asynchronous slave transfer, the handler is not called
+ *
+ * Optional, the default implementation does nothing.
+ *
+ * @param obj The I2C object
+ */
+void i2c_slave_abort_async(i2c_t *obj);
+
 #endif
 
 /**@}*/
@@ -0,0 +1,101 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_IPC_API_H
+#define MBED_IPC_API_H
+
+#include "device.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#if DEVICE_IPC
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_ipc Inter-core communication hal functions
+ *
+ * Signalling between the cores of a multi-core device, and the memory they
+ * share. Each core runs its own copy of the application and uses this API
+ * to interrupt the other core on one of a number of channels, typically with
+ * an IPC or hardware semaphore peripheral.
+ *
+ * # Defined behavior
+ * * ::ipc_notify raises an interrupt on the other core, which calls the
+ *   handler given to ::ipc_init there with the channel
+ * * Notifications of a channel sent before the other core handled the
+ *   previous one may be merged into one
+ * * Memory returned by ::ipc_get_shared_memory is at the same address on
+ *   both cores and is not cached, or kept coherent between the cores
+ * * The handler is called from interrupt context
+ *
+ * # Undefined behavior
+ * * Calling ::ipc_notify before ::ipc_init
+ * * A channel equal to or above ::ipc_get_channel_count
+ * @{
+ */
+
+/** Handler called when the other core notifies a channel
+ *
+ * @param channel The channel notified
+ */
+typedef void (*ipc_handler_t)(uint32_t channel);
+
+/** Initialize the inter-core signalling and enable its interrupt
+ *
+ * @param handler Function called when the other core notifies a channel
+ */
+void ipc_init(ipc_handler_t handler);
+
+/** Disable the inter-core interrupt
+ */
+void ipc_free(void);
+
+/** Get the number of channels the cores can notify each other on
+ *
+ * @return The number of channels
+ */
+uint32_t ipc_get_channel_count(void);
+
+/** Interrupt the other core on a channel
+ *
+ * @param channel The channel to notify
+ */
+void ipc_notify(uint32_t channel);
+
+/** Get the memory reserved for communication between the cores
+ *
+ * @param size Returned size of the memory in bytes
+ * @return     Start of the memory, aligned to 32 bytes, or NULL if there is none
+ */
+void *ipc_get_shared_memory(size_t *size);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,103 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cmsis.h"
+#include "hal/dma_api.h"
+#include "platform/mbed_toolchain.h"
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+#define DMA_CACHE_LINE_SIZE 32U
+
+/* Whole cache lines covering a buffer */
+static void dma_cache_lines(const volatile void *addr, size_t size, uint32_t **start, int32_t *length)
+{
+    uint32_t begin = (uint32_t)addr & ~(DMA_CACHE_LINE_SIZE - 1);
+    uint32_t end = ((uint32_t)addr + size + DMA_CACHE_LINE_SIZE - 1) & ~(DMA_CACHE_LINE_SIZE - 1);
+    *start = (uint32_t *)begin;
+    *length = (int32_t)(end - begin);
+}
+#endif
+
+void dma_cache_clean(const volatile void *addr, size_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    uint32_t *start;
+    int32_t length;
+    if (size && (SCB->CCR & SCB_CCR_DC_Msk)) {
+        dma_cache_lines(addr, size, &start, &length);
+        SCB_CleanDCache_by_Addr(start, length);
+    }
+#else
+    (void)addr;
+    (void)size;
+#endif
+}
+
+void dma_cache_invalidate(volatile void *addr, size_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    uint32_t *start;
+    int32_t length;
+    if (size && (SCB->CCR & SCB_CCR_DC_Msk)) {
+        dma_cache_lines(addr, size, &start, &length);
+        SCB_InvalidateDCache_by_Addr(start, length);
+    }
+#else
+    (void)addr;
+    (void)size;
+#endif
+}
+
+/* Defaults for targets without a DMA HAL */
+
+MBED_WEAK void dma_init(void)
+{
+}
+
+MBED_WEAK int dma_channel_allocate(uint32_t capabilities)
+{
+    (void)capabilities;
+    return DMA_ERROR_OUT_OF_CHANNELS;
+}
+
+MBED_WEAK int dma_channel_free(int channelid)
+{
+    (void)channelid;
+    return 0;
+}
+
+/* Defaults for targets whose DMA HAL only hands out channels */
+
+MBED_WEAK int dma_channel_start(int channelid, const dma_desc_t *desc, dma_handler_t handler, void *context)
+{
+    (void)channelid;
+    (void)desc;
+    (void)handler;
+    (void)context;
+    return DMA_ERROR_UNSUPPORTED;
+}
+
+MBED_WEAK void dma_channel_abort(int channelid)
+{
+    (void)channelid;
+}
+
+MBED_WEAK bool dma_channel_busy(int channelid)
+{
+    (void)channelid;
+    return false;
+}
@@ -28,4 +28,29 @@ MBED_WEAK int32_t flash_read(flash_t *obj, uint32_t address, uint8_t *data, uint
     return 0;
 }
 
+MBED_WEAK const void *flash_get_mapped_address(const flash_t *obj, uint32_t address)
+{
+    return (const void *)address;
+}
+
+MBED_WEAK uint32_t flash_get_bank(const flash_t *obj, uint32_t address)
+{
+    return 0;
+}
+
+MBED_WEAK int32_t flash_erase_sector_asynch(flash_t *obj, uint32_t address, uint32_t handler)
+{
+    return -1;
+}
+
+MBED_WEAK int32_t flash_program_page_asynch(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size, uint32_t handler)
+{
+    return -1;
+}
+
+MBED_WEAK int32_t flash_irq_handler_asynch(flash_t *obj)
+{
+    return -1;
+}
+
 #endif
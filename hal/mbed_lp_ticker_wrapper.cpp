@@ -20,6 +20,15 @@
 
 #include "hal/LowPowerTickerWrapper.h"
 #include "platform/mbed_critical.h"
+#include <string.h>
+
+#ifndef LPTICKER_DEFERRED_MATCH_US
+#define LPTICKER_DEFERRED_MATCH_US 0
+#endif
+
+#ifndef LPTICKER_READ_CACHE_US
+#define LPTICKER_READ_CACHE_US 0
+#endif
 
 // Do not use SingletonPtr since this must be initialized in a critical section
 static LowPowerTickerWrapper *ticker_wrapper;
@@ -97,7 +106,8 @@ const ticker_data_t *get_lp_ticker_wrapper_data(const ticker_data_t *data)
     core_util_critical_section_enter();
 
     if (!init) {
-        ticker_wrapper = new (ticker_wrapper_data) LowPowerTickerWrapper(data, &lp_interface, LPTICKER_DELAY_TICKS, LPTICKER_DELAY_TICKS);
+        ticker_wrapper = new (ticker_wrapper_data) LowPowerTickerWrapper(data, &lp_interface, LPTICKER_DELAY_TICKS, LPTICKER_DELAY_TICKS,
+                                                                            LPTICKER_DEFERRED_MATCH_US, LPTICKER_READ_CACHE_US);
         init = true;
     }
 
@@ -126,4 +136,33 @@ void lp_ticker_wrapper_resume()
     ticker_wrapper->resume();
 }
 
+void lp_ticker_wrapper_invalidate()
+{
+    // Nothing is cached before the ticker is initialized
+    if (init) {
+        ticker_wrapper->invalidate();
+    }
+}
+
+void lp_ticker_wrapper_get_stats(lp_ticker_wrapper_stats_t *stats)
+{
+    if (!init) {
+        // Force ticker to initialize
+        get_lp_ticker_data();
+    }
+
+    ticker_wrapper->get_stats(stats);
+}
+
+#elif DEVICE_LPTICKER
+
+void lp_ticker_wrapper_invalidate()
+{
+}
+
+void lp_ticker_wrapper_get_stats(lp_ticker_wrapper_stats_t *stats)
+{
+    memset(stats, 0, sizeof(lp_ticker_wrapper_stats_t));
+}
+
 #endif
@@ -33,6 +33,17 @@ extern "C" {
 
 typedef void (*ticker_irq_handler_type)(const ticker_data_t *const);
 
+/**
+ * Low power ticker hardware access statistics
+ */
+typedef struct {
+    uint32_t reads;             /**< Counts read from the hardware */
+    uint32_t cached_reads;      /**< Counts extrapolated from the last one read from the hardware */
+    uint32_t writes;            /**< Matches written to the hardware */
+    uint32_t deferred_writes;   /**< Matches set again before they were written, and not written */
+    uint64_t sync_wait_us;      /**< Time spent reading and writing the hardware, including synchronization waits */
+} lp_ticker_wrapper_stats_t;
+
 /**
  * Interrupt handler for the wrapped lp ticker
  *
@@ -69,6 +80,21 @@ void lp_ticker_wrapper_suspend(void);
  */
 void lp_ticker_wrapper_resume(void);
 
+/**
+ * Drop the count cached by the wrapper layer
+ *
+ * Called once the microsecond ticker the cached count is extrapolated
+ * with may have stopped, e.g. after deep sleep.
+ */
+void lp_ticker_wrapper_invalidate(void);
+
+/**
+ * Get the hardware access statistics of the wrapper layer
+ *
+ * @param stats Returned statistics
+ */
+void lp_ticker_wrapper_get_stats(lp_ticker_wrapper_stats_t *stats);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,33 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/spi_api.h"
+
+#if DEVICE_SPISLAVE
+
+#include "platform/mbed_toolchain.h"
+
+MBED_WEAK int spi_slave_transfer_async(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, spi_slave_async_handler_t handler, uint32_t id)
+{
+    return -1;
+}
+
+MBED_WEAK void spi_slave_abort_async(spi_t *obj)
+{
+}
+
+#endif
@@ -16,13 +16,30 @@
  */
 #include <stdio.h>
 #include <stddef.h>
+#include <string.h>
 #include "hal/ticker_api.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_atomic.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_sched_trace.h"
 
 static void schedule_interrupt(const ticker_data_t *const ticker);
 static void update_present_time(const ticker_data_t *const ticker);
 
+/*
+ * Mark the start and end of an update of the present time, for lock free readers.
+ * Updates are made in critical sections, so they are never interleaved.
+ */
+static void begin_update(ticker_event_queue_t *queue)
+{
+    core_util_atomic_store_u32(&queue->sequence, queue->sequence + 1);
+}
+
+static void end_update(ticker_event_queue_t *queue)
+{
+    core_util_atomic_store_u32(&queue->sequence, queue->sequence + 1);
+}
+
 /*
  * Initialize a ticker instance.
  */
@@ -63,6 +80,7 @@ static void initialize(const ticker_data_t *ticker)
     uint64_t max_delta_us =
         ((uint64_t)max_delta * 1000000 + frequency - 1) / frequency;
 
+    begin_update(ticker->queue);
     ticker->queue->event_handler = NULL;
     ticker->queue->head = NULL;
     ticker->queue->tick_last_read = ticker->interface->read();
@@ -75,7 +93,13 @@ static void initialize(const ticker_data_t *ticker)
     ticker->queue->present_time = 0;
     ticker->queue->dispatching = false;
     ticker->queue->suspended = false;
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+    memset(ticker->queue->wheel, 0, sizeof(ticker->queue->wheel));
+    memset(ticker->queue->wheel_pending, 0, sizeof(ticker->queue->wheel_pending));
+    ticker->queue->wheel_unit = 0;
+#endif
     ticker->queue->initialized = true;
+    end_update(ticker->queue);
 
     update_present_time(ticker);
     schedule_interrupt(ticker);
@@ -135,6 +159,8 @@ static void update_present_time(const ticker_data_t *const ticker)
         return;
     }
 
+    begin_update(queue);
+
     uint64_t elapsed_ticks = (ticker_time - queue->tick_last_read) & queue->bitmask;
     queue->tick_last_read = ticker_time;
 
@@ -170,6 +196,8 @@ static void update_present_time(const ticker_data_t *const ticker)
 
     // Update current time
     queue->present_time += elapsed_us;
+
+    end_update(queue);
 }
 
 /**
@@ -222,6 +250,232 @@ int _ticker_match_interval_passed(timestamp_t prev_tick, timestamp_t cur_tick, t
     }
 }
 
+/*
+ * Insert an event in the queue in timestamp order.
+ *
+ * Return true if the event is the new head of the queue.
+ */
+static bool insert_sorted(ticker_event_queue_t *queue, ticker_event_t *obj)
+{
+    /* Go through the list until we either reach the end, or find
+       an element this should come before (which is possibly the
+       head). */
+    ticker_event_t *prev = NULL, *p = queue->head;
+    while (p != NULL) {
+        /* check if we come before p */
+        if (obj->timestamp < p->timestamp) {
+            break;
+        }
+        /* go to the next element */
+        prev = p;
+        p = p->next;
+    }
+
+    /* if we're at the end p will be NULL, which is correct */
+    obj->next = p;
+
+    /* if prev is NULL we're at the head */
+    if (prev == NULL) {
+        queue->head = obj;
+    } else {
+        prev->next = obj;
+    }
+
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+    obj->pprev = (prev == NULL) ? &queue->head : &prev->next;
+    if (p != NULL) {
+        p->pprev = &obj->next;
+    }
+#endif
+
+    return prev == NULL;
+}
+
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+
+/*
+ * Hierarchical timer wheel
+ *
+ * Only the events due before the slot wheel_unit, in units of
+ * 2^TICKER_WHEEL_RESOLUTION_BITS us, are kept in the sorted list at
+ * queue->head. Later events are put in an unsorted slot of the wheel in
+ * constant time. Each level has TICKER_WHEEL_SLOTS slots, each slot of a
+ * level spanning a whole turn of the level below. An event goes to the lowest
+ * level that reaches it within one turn and moves down a level each time the
+ * wheel reaches its slot, so that it is handled at most TICKER_WHEEL_LEVELS
+ * times before being sorted into the head list when its lowest level slot is
+ * reached. Events further away than the top level can reach are put in its
+ * last slot and placed again from there.
+ */
+#define WHEEL_MASK (TICKER_WHEEL_SLOTS - 1)
+#define WHEEL_RANGE ((uint64_t)1 << (TICKER_WHEEL_SLOT_BITS * TICKER_WHEEL_LEVELS))
+
+static void unlink_event(ticker_event_queue_t *queue, ticker_event_t *obj)
+{
+    ticker_event_t **pprev = obj->pprev;
+    *pprev = obj->next;
+    if (obj->next != NULL) {
+        obj->next->pprev = pprev;
+    }
+    obj->pprev = NULL;
+
+    // Clear the pending bit of a wheel slot that is now empty
+    ticker_event_t **first = &queue->wheel[0][0];
+    if (pprev >= first && pprev < first + TICKER_WHEEL_LEVELS * TICKER_WHEEL_SLOTS && *pprev == NULL) {
+        size_t index = pprev - first;
+        queue->wheel_pending[index / TICKER_WHEEL_SLOTS] &= ~(1U << (index % TICKER_WHEEL_SLOTS));
+    }
+}
+
+/*
+ * Put an event due at or after the slot wheel_unit into the wheel.
+ */
+static void wheel_add(ticker_event_queue_t *queue, ticker_event_t *obj)
+{
+    uint64_t unit = obj->timestamp >> TICKER_WHEEL_RESOLUTION_BITS;
+    uint64_t delta = unit - queue->wheel_unit;
+    if (delta >= WHEEL_RANGE) {
+        unit = queue->wheel_unit + WHEEL_RANGE - 1;
+        delta = WHEEL_RANGE - 1;
+    }
+
+    unsigned level = 0;
+    while (delta >= ((uint64_t)1 << (TICKER_WHEEL_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    unsigned slot = (unit >> (TICKER_WHEEL_SLOT_BITS * level)) & WHEEL_MASK;
+
+    ticker_event_t **pprev = &queue->wheel[level][slot];
+    obj->next = *pprev;
+    if (obj->next != NULL) {
+        obj->next->pprev = &obj->next;
+    }
+    obj->pprev = pprev;
+    *pprev = obj;
+    queue->wheel_pending[level] |= 1U << slot;
+}
+
+/*
+ * Return the first slot, in units of the lowest level, at which the wheel
+ * has events to move, or UINT64_MAX if the wheel is empty.
+ *
+ * A slot of a level is reached when the lower bits of the unit, that index
+ * the levels below, are all zero.
+ */
+static uint64_t wheel_next_unit(const ticker_event_queue_t *queue)
+{
+    uint64_t next = UINT64_MAX;
+    for (unsigned level = 0; level < TICKER_WHEEL_LEVELS; level++) {
+        uint32_t pending = queue->wheel_pending[level];
+        if (pending == 0) {
+            continue;
+        }
+
+        unsigned shift = TICKER_WHEEL_SLOT_BITS * level;
+        uint64_t start = queue->wheel_unit >> shift;
+        if (queue->wheel_unit & (((uint64_t)1 << shift) - 1)) {
+            start++;
+        }
+        for (unsigned i = 0; i < TICKER_WHEEL_SLOTS; i++) {
+            if (pending & (1U << ((start + i) & WHEEL_MASK))) {
+                uint64_t unit = (start + i) << shift;
+                if (unit < next) {
+                    next = unit;
+                }
+                break;
+            }
+        }
+    }
+    return next;
+}
+
+static void wheel_move_slot(ticker_event_queue_t *queue, unsigned level, unsigned slot)
+{
+    ticker_event_t *p = queue->wheel[level][slot];
+    queue->wheel[level][slot] = NULL;
+    queue->wheel_pending[level] &= ~(1U << slot);
+    while (p != NULL) {
+        ticker_event_t *next = p->next;
+        if (level == 0) {
+            insert_sorted(queue, p);
+        } else {
+            wheel_add(queue, p);
+        }
+        p = next;
+    }
+}
+
+/*
+ * Move the events of the slots of the wheel at wheel_unit down one level,
+ * or to the head list for the lowest level, then step to the next slot.
+ */
+static void wheel_turn(ticker_event_queue_t *queue)
+{
+    uint64_t unit = queue->wheel_unit;
+
+    // Cascade the upper levels first, their events may be due in this slot
+    for (unsigned level = 1; level < TICKER_WHEEL_LEVELS; level++) {
+        unsigned shift = TICKER_WHEEL_SLOT_BITS * level;
+        if (unit & (((uint64_t)1 << shift) - 1)) {
+            break;
+        }
+        wheel_move_slot(queue, level, (unit >> shift) & WHEEL_MASK);
+    }
+    wheel_move_slot(queue, 0, unit & WHEEL_MASK);
+
+    queue->wheel_unit = unit + 1;
+}
+
+/*
+ * Turn the wheel up to the present time, so that every event already due is
+ * in the head list.
+ */
+static void wheel_advance(ticker_event_queue_t *queue)
+{
+    uint64_t present = queue->present_time >> TICKER_WHEEL_RESOLUTION_BITS;
+    while (true) {
+        uint64_t next = wheel_next_unit(queue);
+        if (next > present) {
+            break;
+        }
+        // Slots in between are empty and can be skipped
+        queue->wheel_unit = next;
+        wheel_turn(queue);
+    }
+    if (queue->wheel_unit <= present) {
+        queue->wheel_unit = present + 1;
+    }
+}
+
+#endif
+
+/*
+ * Get the time at which the queue needs attention next: the timestamp of
+ * the first event or, with the timer wheel, the time a slot has to be moved
+ * if that is earlier.
+ */
+static bool get_next_time(const ticker_event_queue_t *queue, us_timestamp_t *time)
+{
+    bool pending = false;
+    if (queue->head) {
+        *time = queue->head->timestamp;
+        pending = true;
+    }
+
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+    uint64_t unit = wheel_next_unit(queue);
+    if (unit != UINT64_MAX) {
+        us_timestamp_t wheel_time = unit << TICKER_WHEEL_RESOLUTION_BITS;
+        if (!pending || wheel_time < *time) {
+            *time = wheel_time;
+        }
+        pending = true;
+    }
+#endif
+
+    return pending;
+}
+
 /**
  * Compute the time when the interrupt has to be triggered and schedule it.
  *
@@ -246,9 +500,9 @@ static void schedule_interrupt(const ticker_data_t *const ticker)
 
     update_present_time(ticker);
 
-    if (ticker->queue->head) {
+    us_timestamp_t match_time;
+    if (get_next_time(queue, &match_time)) {
         us_timestamp_t present = ticker->queue->present_time;
-        us_timestamp_t match_time = ticker->queue->head->timestamp;
 
         // if the event at the head of the queue is in the past then schedule
         // it immediately.
@@ -287,17 +541,24 @@ void ticker_set_handler(const ticker_data_t *const ticker, ticker_event_handler
 
 void ticker_irq_handler(const ticker_data_t *const ticker)
 {
+    MBED_SCHED_TRACE_ISR_ENTER();
     core_util_critical_section_enter();
 
     ticker->interface->clear_interrupt();
     if (ticker->queue->suspended) {
         core_util_critical_section_exit();
+        MBED_SCHED_TRACE_ISR_EXIT();
         return;
     }
 
     /* Go through all the pending TimerEvents */
     ticker->queue->dispatching = true;
     while (1) {
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+        update_present_time(ticker);
+        wheel_advance(ticker->queue);
+#endif
+
         if (ticker->queue->head == NULL) {
             break;
         }
@@ -309,7 +570,11 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
             // This event was in the past:
             //      point to the following one and execute its handler
             ticker_event_t *p = ticker->queue->head;
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+            unlink_event(ticker->queue, p);
+#else
             ticker->queue->head = ticker->queue->head->next;
+#endif
             if (ticker->queue->event_handler != NULL) {
                 (*ticker->queue->event_handler)(p->id); // NOTE: the handler can set new events
             }
@@ -324,6 +589,7 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
     schedule_interrupt(ticker);
 
     core_util_critical_section_exit();
+    MBED_SCHED_TRACE_ISR_EXIT();
 }
 
 void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj, timestamp_t timestamp, uint32_t id)
@@ -347,41 +613,60 @@ void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
 }
 
 void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id)
+{
+    ticker_insert_event_us_slack(ticker, obj, timestamp, 0, id);
+}
+
+/*
+ * Move timestamp later by at most slack so that it shares an interrupt with
+ * other events. The earliest queued event inside the window is joined if
+ * there is one, otherwise the timestamp is rounded up to a multiple of the
+ * largest power of two not above slack, so that unrelated events with
+ * similar slack end up on the same timestamps.
+ */
+static us_timestamp_t coalesce_timestamp(const ticker_data_t *const ticker, us_timestamp_t timestamp, uint32_t slack)
+{
+    ticker_event_t *p = ticker->queue->head;
+    while (p != NULL && p->timestamp < timestamp) {
+        p = p->next;
+    }
+
+    if (p != NULL && p->timestamp - timestamp <= slack) {
+        return p->timestamp;
+    }
+
+    uint32_t grain = 1;
+    while (grain <= slack / 2) {
+        grain <<= 1;
+    }
+    return (timestamp + grain - 1) & ~(us_timestamp_t)(grain - 1);
+}
+
+void ticker_insert_event_us_slack(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t slack, uint32_t id)
 {
     core_util_critical_section_enter();
 
     // update the current timestamp
     update_present_time(ticker);
 
+    if (slack && timestamp > ticker->queue->present_time) {
+        timestamp = coalesce_timestamp(ticker, timestamp, slack);
+    }
+
     // initialise our data
     obj->timestamp = timestamp;
     obj->id = id;
 
-    /* Go through the list until we either reach the end, or find
-       an element this should come before (which is possibly the
-       head). */
-    ticker_event_t *prev = NULL, *p = ticker->queue->head;
-    while (p != NULL) {
-        /* check if we come before p */
-        if (timestamp < p->timestamp) {
-            break;
-        }
-        /* go to the next element */
-        prev = p;
-        p = p->next;
-    }
-
-    /* if we're at the end p will be NULL, which is correct */
-    obj->next = p;
-
-    /* if prev is NULL we're at the head */
-    if (prev == NULL) {
-        ticker->queue->head = obj;
-    } else {
-        prev->next = obj;
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+    if ((timestamp >> TICKER_WHEEL_RESOLUTION_BITS) >= ticker->queue->wheel_unit) {
+        wheel_add(ticker->queue, obj);
+        schedule_interrupt(ticker);
+        core_util_critical_section_exit();
+        return;
     }
+#endif
 
-    if (prev == NULL || timestamp <= ticker->queue->present_time) {
+    if (insert_sorted(ticker->queue, obj) || timestamp <= ticker->queue->present_time) {
         schedule_interrupt(ticker);
     }
 
@@ -392,6 +677,15 @@ void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
 {
     core_util_critical_section_enter();
 
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+    if (obj->pprev != NULL) {
+        bool first = ticker->queue->head == obj;
+        unlink_event(ticker->queue, obj);
+        if (first) {
+            schedule_interrupt(ticker);
+        }
+    }
+#else
     // remove this object from the list
     if (ticker->queue->head == obj) {
         // first in the list, so just drop me
@@ -408,6 +702,7 @@ void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
             p = p->next;
         }
     }
+#endif
 
     core_util_critical_section_exit();
 }
@@ -431,14 +726,48 @@ us_timestamp_t ticker_read_us(const ticker_data_t *const ticker)
     return ret;
 }
 
+us_timestamp_t ticker_read_us_lock_free(const ticker_data_t *const ticker)
+{
+    const ticker_event_queue_t *queue = ticker->queue;
+    uint32_t sequence;
+    us_timestamp_t present_time;
+    uint64_t elapsed_ticks;
+    uint64_t remainder;
+
+    do {
+        sequence = core_util_atomic_load_u32(&queue->sequence);
+        if (!queue->initialized || (sequence & 1)) {
+            // Not initialized yet or an update was interrupted, it can't finish while we wait
+            return ticker_read_us(ticker);
+        }
+        present_time = queue->present_time;
+        remainder = queue->tick_remainder;
+        if (queue->suspended) {
+            elapsed_ticks = 0;
+        } else {
+            elapsed_ticks = (ticker->interface->read() - queue->tick_last_read) & queue->bitmask;
+        }
+    } while (core_util_atomic_load_u32(&queue->sequence) != sequence);
+
+    // Same conversion as update_present_time, with the remainder carried in
+    if (1000000 == queue->frequency) {
+        return present_time + elapsed_ticks;
+    } else if (0 != queue->frequency_shifts) {
+        return present_time + ((elapsed_ticks * 1000000 + remainder) >> queue->frequency_shifts);
+    } else {
+        return present_time + (elapsed_ticks * 1000000 + remainder) / queue->frequency;
+    }
+}
+
 int ticker_get_next_timestamp(const ticker_data_t *const data, timestamp_t *timestamp)
 {
     int ret = 0;
+    us_timestamp_t next;
 
     /* if head is NULL, there are no pending events */
     core_util_critical_section_enter();
-    if (data->queue->head != NULL) {
-        *timestamp = data->queue->head->timestamp;
+    if (get_next_time(data->queue, &next)) {
+        *timestamp = next;
         ret = 1;
     }
     core_util_critical_section_exit();
@@ -461,7 +790,9 @@ void ticker_resume(const ticker_data_t *const ticker)
 
     ticker->queue->suspended = false;
     if (ticker->queue->initialized) {
+        begin_update(ticker->queue);
         ticker->queue->tick_last_read = ticker->interface->read();
+        end_update(ticker->queue);
 
         update_present_time(ticker);
         schedule_interrupt(ticker);
@@ -34,6 +34,11 @@ typedef struct port_s port_t;
 
 /**
  * \defgroup hal_port Port HAL functions
+ *
+ * Targets may also define the macros PINNAME_TO_PORT(pin) and
+ * PINNAME_TO_PORT_PIN(pin), giving the port name and the bit within the port
+ * of a pin as constant expressions. StaticBusOut uses them to group its pins by
+ * port at compile time and falls back to one gpio per pin without them.
  * @{
  */
 
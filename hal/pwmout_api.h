@@ -22,6 +22,8 @@
 
 #include "device.h"
 #include "pinmap.h"
+#include <stdbool.h>
+#include <stddef.h>
 
 #if DEVICE_PWMOUT
 
@@ -45,6 +47,16 @@ typedef struct pwmout_s pwmout_t;
  */
 void pwmout_init(pwmout_t *obj, PinName pin);
 
+/** Initialize the pwm out peripheral from a resolved pinmap entry
+ *
+ * Like ::pwmout_init, but without looking up the PinMap tables. The default
+ * implementation calls ::pwmout_init with the pin of the entry.
+ *
+ * @param obj    The pwmout object to initialize
+ * @param pinmap Pin, peripheral and function to use, see ::get_pwm_pinmap
+ */
+void pwmout_init_direct(pwmout_t *obj, const PinMap *pinmap);
+
 /** Deinitialize the pwmout object
  *
  * @param obj The pwmout object
@@ -118,6 +130,59 @@ void pwmout_pulsewidth_us(pwmout_t *obj, int us);
  */
 const PinMap *pwmout_pinmap(void);
 
+/** Events reported to the sequence handler */
+typedef enum {
+    PWMOUT_SEQUENCE_EVENT_COMPLETE = (1 << 0), /**< The sequence has been played once */
+    PWMOUT_SEQUENCE_EVENT_ERROR    = (1 << 1)  /**< Transfer error, playback has stopped */
+} pwmout_sequence_event_t;
+
+/** Handler called when a sequence has been played
+ *
+ * @param id    The id given to ::pwmout_sequence_start
+ * @param event One of ::pwmout_sequence_event_t
+ */
+typedef void (*pwmout_sequence_handler_t)(uint32_t id, uint32_t event);
+
+/** Get the sequence value for a 100% duty cycle at the current period
+ *
+ * Optional, the default implementation returns 0.
+ *
+ * @param obj The pwmout object
+ * @return    The largest sequence value, 0 if sequences are not supported
+ */
+uint32_t pwmout_sequence_max(pwmout_t *obj);
+
+/** Start playing a sequence of duty cycles
+ *
+ * Each value sets the duty cycle of one period, from 0 to ::pwmout_sequence_max,
+ * and is loaded by DMA without software intervention. Once a sequence that does
+ * not loop has been played, the output keeps the duty cycle of the last value.
+ * Playback starts within two periods.
+ * The values may be converted in place to the peripheral's format, which must
+ * leave them valid for another playback.
+ *
+ * Optional, the default implementation returns -1.
+ *
+ * @param obj     The pwmout object
+ * @param values  Duty cycles of the successive periods, must stay valid until playback ends
+ * @param count   Number of values
+ * @param loop    Play the sequence again each time it ends, until ::pwmout_sequence_stop
+ * @param handler Function called from interrupt context each time the sequence has been played
+ * @param id      Argument passed to the handler
+ * @return        0 on success, -1 on failure
+ */
+int pwmout_sequence_start(pwmout_t *obj, uint16_t *values, size_t count, bool loop, pwmout_sequence_handler_t handler, uint32_t id);
+
+/** Stop playing a sequence
+ *
+ * The output is left at the duty cycle of the last value of the sequence.
+ *
+ * Optional, the default implementation does nothing.
+ *
+ * @param obj The pwmout object
+ */
+void pwmout_sequence_stop(pwmout_t *obj);
+
 /**@}*/
 
 #ifdef __cplusplus
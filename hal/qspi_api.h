@@ -183,6 +183,89 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
  */
 qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length);
 
+/** Map the external memory into the address space for reads
+ *
+ * While mapped, the peripheral issues the given command on every access to
+ * the returned region, so the device can be read with plain loads. The
+ * address value of the command is ignored, the flash offset is the offset
+ * into the region. Other QSPI operations must not be performed until
+ * qspi_memory_unmap has been called.
+ *
+ * Optional, the default implementation returns QSPI_STATUS_ERROR.
+ *
+ * @param obj QSPI object
+ * @param command QSPI read command used for memory accesses
+ * @param[out] address Base address of the mapped region
+ * @return QSPI_STATUS_OK if the memory has been mapped
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR if not supported or on failure
+ */
+qspi_status_t qspi_memory_map(qspi_t *obj, const qspi_command_t *command, const void **address);
+
+/** Leave memory-mapped mode and return to indirect mode
+ *
+ * Optional, the default implementation returns QSPI_STATUS_ERROR.
+ *
+ * @param obj QSPI object
+ * @return QSPI_STATUS_OK if the peripheral is back in indirect mode
+           QSPI_STATUS_ERROR if not supported or on failure
+ */
+qspi_status_t qspi_memory_unmap(qspi_t *obj);
+
+/** Handler called when an asynchronous transfer has finished
+ *
+ * @param id     The id given when the transfer was started
+ * @param status QSPI_STATUS_OK if the transfer completed, QSPI_STATUS_ERROR otherwise
+ */
+typedef void (*qspi_async_handler_t)(uint32_t id, qspi_status_t status);
+
+/** Start an asynchronous receive command
+ *
+ * The data phase runs in the background, using DMA where the target supports
+ * it, and the handler is called from interrupt context when it ends. Other
+ * QSPI operations must not be performed until the handler has been called
+ * or ::qspi_abort_async has returned.
+ *
+ * Optional, the default implementation returns QSPI_STATUS_ERROR.
+ *
+ * @param obj QSPI object
+ * @param command QSPI command
+ * @param data RX buffer, must stay valid until the handler is called
+ * @param length RX buffer length in bytes
+ * @param handler Function called when the transfer ends
+ * @param id Argument passed to the handler
+ * @return QSPI_STATUS_OK if the transfer has started
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR if not supported or on failure
+ */
+qspi_status_t qspi_read_async(qspi_t *obj, const qspi_command_t *command, void *data, size_t length, qspi_async_handler_t handler, uint32_t id);
+
+/** Start an asynchronous transmit command
+ *
+ * Same as ::qspi_read_async for the transmit direction.
+ *
+ * Optional, the default implementation returns QSPI_STATUS_ERROR.
+ *
+ * @param obj QSPI object
+ * @param command QSPI command
+ * @param data TX buffer, must stay valid until the handler is called
+ * @param length TX buffer length in bytes
+ * @param handler Function called when the transfer ends
+ * @param id Argument passed to the handler
+ * @return QSPI_STATUS_OK if the transfer has started
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR if not supported or on failure
+ */
+qspi_status_t qspi_write_async(qspi_t *obj, const qspi_command_t *command, const void *data, size_t length, qspi_async_handler_t handler, uint32_t id);
+
+/** Abort an asynchronous transfer, the handler is not called
+ *
+ * Optional, the default implementation does nothing.
+ *
+ * @param obj QSPI object
+ */
+void qspi_abort_async(qspi_t *obj);
+
 /** Get the pins that support QSPI SCLK
  *
  * Return a PinMap array of pins that support QSPI SCLK in
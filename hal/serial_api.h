@@ -102,6 +102,16 @@ typedef struct serial_s serial_t;
 
 #endif
 
+/** Pins and pin functions of a serial peripheral, see hal/static_pinmap.h
+ */
+typedef struct {
+    int peripheral;  /**< Peripheral both pins map to */
+    PinName tx_pin;  /**< TX pin */
+    int tx_function; /**< Function of the TX pin */
+    PinName rx_pin;  /**< RX pin */
+    int rx_function; /**< Function of the RX pin */
+} serial_pinmap_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -120,6 +130,16 @@ extern "C" {
  */
 void serial_init(serial_t *obj, PinName tx, PinName rx);
 
+/** Initialize the serial peripheral from a resolved pinmap
+ *
+ *  Like ::serial_init, but without looking up the PinMap tables. The default
+ *  implementation calls ::serial_init with the pins of the pinmap.
+ *
+ * @param obj    The serial object
+ * @param pinmap Pins of the serial peripheral, see ::get_uart_pinmap
+ */
+void serial_init_direct(serial_t *obj, const serial_pinmap_t *pinmap);
+
 /** Release the serial peripheral, not currently invoked. It requires further
  *  resource management.
  *
@@ -330,6 +350,18 @@ void serial_tx_abort_asynch(serial_t *obj);
  */
 void serial_rx_abort_asynch(serial_t *obj);
 
+/** Get the number of characters received by the ongoing RX transaction, or by
+ *  the last one once aborted
+ *
+ * Lets a transfer be cut short without losing the characters already received,
+ * including those moved by DMA. Targets that can't count the characters moved
+ * by DMA before the transfer completes must return -1.
+ *
+ * @param obj The serial object
+ * @return The number of characters received, -1 if the target can't report it
+ */
+int serial_rx_asynch_received(serial_t *obj);
+
 /**@}*/
 
 #endif
@@ -53,6 +53,20 @@ typedef struct spi_s spi_t;
 
 #endif
 
+/** Pins and pin functions of an SPI peripheral, see hal/static_pinmap.h
+ */
+typedef struct {
+    int peripheral;    /**< Peripheral all the pins map to */
+    PinName mosi_pin;  /**< MOSI pin */
+    int mosi_function; /**< Function of the MOSI pin */
+    PinName miso_pin;  /**< MISO pin */
+    int miso_function; /**< Function of the MISO pin */
+    PinName sclk_pin;  /**< SCLK pin */
+    int sclk_function; /**< Function of the SCLK pin */
+    PinName ssel_pin;  /**< SSEL pin */
+    int ssel_function; /**< Function of the SSEL pin */
+} spi_pinmap_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -84,6 +98,17 @@ SPIName spi_get_peripheral_name(PinName mosi, PinName miso, PinName mclk);
  */
 void spi_init(spi_t *obj, PinName mosi, PinName miso, PinName sclk, PinName ssel);
 
+/** Initialize the SPI peripheral from a resolved pinmap
+ *
+ * Like ::spi_init, but the peripheral and pin functions are taken from the
+ * pinmap instead of being looked up in the PinMap tables, so a target
+ * implementing it doesn't need those tables at run time. The default
+ * implementation calls ::spi_init with the pins of the pinmap.
+ * @param[out] obj    The SPI object to initialize
+ * @param[in]  pinmap Pins of the SPI peripheral, see ::get_spi_pinmap
+ */
+void spi_init_direct(spi_t *obj, const spi_pinmap_t *pinmap);
+
 /** Release a SPI object
  *
  * TODO: spi_free is currently unimplemented
@@ -257,6 +282,56 @@ const PinMap *spi_slave_clk_pinmap(void);
  */
 const PinMap *spi_slave_cs_pinmap(void);
 
+#if DEVICE_SPISLAVE
+
+/** The buffers of the asynchronous slave transfer have been used up */
+#define SPI_SLAVE_EVENT_COMPLETE (1 << 0)
+/** The master deasserted chip select before the buffers were used up */
+#define SPI_SLAVE_EVENT_DESELECT (1 << 1)
+/** The transfer failed, e.g. on a receive overrun or transmit underrun */
+#define SPI_SLAVE_EVENT_ERROR    (1 << 2)
+
+/** Handler called when an asynchronous slave transfer has finished
+ *
+ * @param id       The id given when the transfer was started
+ * @param event    SPI_SLAVE_EVENT_COMPLETE, SPI_SLAVE_EVENT_DESELECT or SPI_SLAVE_EVENT_ERROR
+ * @param rx_count Number of bytes written into the receive buffer
+ */
+typedef void (*spi_slave_async_handler_t)(uint32_t id, int event, size_t rx_count);
+
+/** Start an asynchronous slave transfer
+ *
+ * The transmit buffer is clocked out and the receive buffer filled, using DMA
+ * where the target supports it, as the master drives the clock. Transmit data
+ * past the end of the TX buffer is the fill value, receive data past the end of
+ * the RX buffer is dropped. The transfer ends when both buffers have been used
+ * up or when chip select is deasserted, whichever comes first, and the handler
+ * is then called from interrupt context. A new transfer may be started from
+ * the handler.
+ *
+ * Optional, the default implementation returns -1.
+ *
+ * @param obj       The SPI slave object
+ * @param tx        TX buffer, may be NULL, must stay valid until the handler is called
+ * @param tx_length TX buffer length in bytes
+ * @param rx        RX buffer, may be NULL, must stay valid until the handler is called
+ * @param rx_length RX buffer length in bytes
+ * @param handler   Function called when the transfer ends
+ * @param id        Argument passed to the handler
+ * @return 0 if the transfer has started, -1 if not supported or on failure
+ */
+int spi_slave_transfer_async(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, spi_slave_async_handler_t handler, uint32_t id);
+
+/** Abort an asynchronous slave transfer, the handler is not called
+ *
+ * Optional, the default implementation does nothing.
+ *
+ * @param obj The SPI slave object
+ */
+void spi_slave_abort_async(spi_t *obj);
+
+#endif
+
 /**@}*/
 
 #if DEVICE_SPI_ASYNCH
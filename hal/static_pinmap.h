@@ -0,0 +1,213 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_STATIC_PINMAP_H
+#define MBED_STATIC_PINMAP_H
+
+#include "hal/pinmap.h"
+#include "hal/spi_api.h"
+#include "hal/i2c_api.h"
+#include "hal/serial_api.h"
+#include "hal/pwmout_api.h"
+
+/**
+ * \defgroup hal_static_pinmap Static pinmap functions
+ *
+ * Resolve the peripheral and pin functions of a set of pins at compile time,
+ * for the driver constructors taking a pinmap, e.g. SPI(const spi_pinmap_t &):
+ *
+ * @code
+ * constexpr spi_pinmap_t spi_pinmap = get_spi_pinmap(SPI_MOSI, SPI_MISO, SPI_SCLK, NC);
+ * SPI spi(spi_pinmap);
+ * @endcode
+ *
+ * A target supports this with the STATIC_PINMAP_READY label. It provides a
+ * PeripheralPinMaps.h defining its PinMap tables as constexpr arrays in C++,
+ * terminated by an entry with pin NC, and these macros naming them:
+ * PINMAP_SPI_MOSI, PINMAP_SPI_MISO, PINMAP_SPI_SCLK, PINMAP_SPI_SSEL,
+ * PINMAP_I2C_SDA, PINMAP_I2C_SCL, PINMAP_UART_TX, PINMAP_UART_RX and
+ * PINMAP_PWM. The peripheral of an SPI entry must be the SPIName
+ * ::spi_get_peripheral_name returns for its pins. It also implements the
+ * *_init_direct functions, so the pins are neither looked up at start up nor
+ * the tables linked in for peripherals constructed from a pinmap.
+ *
+ * On other targets the functions only record the pins, with the peripheral
+ * and functions set to NC, and the default *_init_direct functions pass them
+ * to the usual init functions.
+ *
+ * A peripheral of NC in a pinmap returned for a static pinmap target means
+ * the pins don't map to a single peripheral, which can be checked with
+ * static_assert.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+
+#if defined(TARGET_STATIC_PINMAP_READY)
+#include "PeripheralPinMaps.h"
+
+/* Peripheral of pins mapping to different peripherals, while merging */
+#define STATIC_PINMAP_CONFLICT ((int)NC - 1)
+
+/** Peripheral of a pin in a constexpr PinMap table, NC if not found
+ */
+constexpr int static_pinmap_peripheral(PinName pin, const PinMap *map)
+{
+    return (pin == NC || map->pin == NC) ? (int)NC :
+           (map->pin == pin) ? map->peripheral : static_pinmap_peripheral(pin, map + 1);
+}
+
+/** Function of a pin in a constexpr PinMap table, NC if not found
+ */
+constexpr int static_pinmap_function(PinName pin, const PinMap *map)
+{
+    return (pin == NC || map->pin == NC) ? (int)NC :
+           (map->pin == pin) ? map->function : static_pinmap_function(pin, map + 1);
+}
+
+/** Merge two peripherals, ignoring NC, like ::pinmap_merge
+ */
+constexpr int static_pinmap_merge(int a, int b)
+{
+    return (a == STATIC_PINMAP_CONFLICT || b == STATIC_PINMAP_CONFLICT) ? STATIC_PINMAP_CONFLICT :
+           (a == (int)NC) ? b :
+           (b == (int)NC || a == b) ? a : STATIC_PINMAP_CONFLICT;
+}
+
+/** Final peripheral of merged pins, NC if they conflicted
+ */
+constexpr int static_pinmap_result(int peripheral)
+{
+    return (peripheral == STATIC_PINMAP_CONFLICT) ? (int)NC : peripheral;
+}
+
+#if DEVICE_SPI
+/** Resolve the pins of an SPI peripheral
+ *
+ * @param mosi The pin to use for MOSI
+ * @param miso The pin to use for MISO
+ * @param sclk The pin to use for SCLK
+ * @param ssel The pin to use for SSEL
+ * @return The pinmap to construct an SPI from
+ */
+constexpr spi_pinmap_t get_spi_pinmap(const PinName mosi, const PinName miso, const PinName sclk, const PinName ssel)
+{
+    return spi_pinmap_t {
+        static_pinmap_result(static_pinmap_merge(
+            static_pinmap_merge(static_pinmap_peripheral(mosi, PINMAP_SPI_MOSI), static_pinmap_peripheral(miso, PINMAP_SPI_MISO)),
+            static_pinmap_merge(static_pinmap_peripheral(sclk, PINMAP_SPI_SCLK), static_pinmap_peripheral(ssel, PINMAP_SPI_SSEL)))),
+        mosi, static_pinmap_function(mosi, PINMAP_SPI_MOSI),
+        miso, static_pinmap_function(miso, PINMAP_SPI_MISO),
+        sclk, static_pinmap_function(sclk, PINMAP_SPI_SCLK),
+        ssel, static_pinmap_function(ssel, PINMAP_SPI_SSEL)
+    };
+}
+#endif
+
+#if DEVICE_I2C
+/** Resolve the pins of an I2C peripheral
+ *
+ * @param sda The sda pin
+ * @param scl The scl pin
+ * @return The pinmap to construct an I2C from
+ */
+constexpr i2c_pinmap_t get_i2c_pinmap(const PinName sda, const PinName scl)
+{
+    return i2c_pinmap_t {
+        static_pinmap_result(static_pinmap_merge(static_pinmap_peripheral(sda, PINMAP_I2C_SDA),
+                                                 static_pinmap_peripheral(scl, PINMAP_I2C_SCL))),
+        sda, static_pinmap_function(sda, PINMAP_I2C_SDA),
+        scl, static_pinmap_function(scl, PINMAP_I2C_SCL)
+    };
+}
+#endif
+
+#if DEVICE_SERIAL
+/** Resolve the pins of a serial peripheral
+ *
+ * @param tx The TX pin
+ * @param rx The RX pin
+ * @return The pinmap to construct a Serial or RawSerial from
+ */
+constexpr serial_pinmap_t get_uart_pinmap(const PinName tx, const PinName rx)
+{
+    return serial_pinmap_t {
+        static_pinmap_result(static_pinmap_merge(static_pinmap_peripheral(tx, PINMAP_UART_TX),
+                                                 static_pinmap_peripheral(rx, PINMAP_UART_RX))),
+        tx, static_pinmap_function(tx, PINMAP_UART_TX),
+        rx, static_pinmap_function(rx, PINMAP_UART_RX)
+    };
+}
+#endif
+
+#if DEVICE_PWMOUT
+/** Resolve the pin of a PwmOut
+ *
+ * @param pin The pwmout pin
+ * @return The pinmap entry to construct a PwmOut from
+ */
+constexpr PinMap get_pwm_pinmap(const PinName pin)
+{
+    return PinMap {
+        pin, static_pinmap_peripheral(pin, PINMAP_PWM), static_pinmap_function(pin, PINMAP_PWM)
+    };
+}
+#endif
+
+#else // TARGET_STATIC_PINMAP_READY
+
+#if DEVICE_SPI
+constexpr spi_pinmap_t get_spi_pinmap(const PinName mosi, const PinName miso, const PinName sclk, const PinName ssel)
+{
+    return spi_pinmap_t {(int)NC, mosi, (int)NC, miso, (int)NC, sclk, (int)NC, ssel, (int)NC};
+}
+#endif
+
+#if DEVICE_I2C
+constexpr i2c_pinmap_t get_i2c_pinmap(const PinName sda, const PinName scl)
+{
+    return i2c_pinmap_t {(int)NC, sda, (int)NC, scl, (int)NC};
+}
+#endif
+
+#if DEVICE_SERIAL
+constexpr serial_pinmap_t get_uart_pinmap(const PinName tx, const PinName rx)
+{
+    return serial_pinmap_t {(int)NC, tx, (int)NC, rx, (int)NC};
+}
+#endif
+
+#if DEVICE_PWMOUT
+constexpr PinMap get_pwm_pinmap(const PinName pin)
+{
+    return PinMap {pin, (int)NC, (int)NC};
+}
+#endif
+
+#endif // TARGET_STATIC_PINMAP_READY
+
+#endif // __cplusplus
+
+/**@}*/
+
+#endif
+
+/** @}*/
@@ -38,12 +38,25 @@ typedef uint32_t timestamp_t;
  */
 typedef uint64_t us_timestamp_t;
 
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+/** Number of levels of the timer wheel */
+#define TICKER_WHEEL_LEVELS             5
+/** Log2 of the number of slots in each level of the timer wheel */
+#define TICKER_WHEEL_SLOT_BITS          4
+#define TICKER_WHEEL_SLOTS              (1 << TICKER_WHEEL_SLOT_BITS)
+/** Log2 of the width in us of a slot of the lowest level, 1.024 ms */
+#define TICKER_WHEEL_RESOLUTION_BITS    10
+#endif
+
 /** Ticker's event structure
  */
 typedef struct ticker_event_s {
     us_timestamp_t         timestamp; /**< Event's timestamp */
     uint32_t               id;        /**< TimerEvent object */
     struct ticker_event_s *next;      /**< Next event in the queue */
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+    struct ticker_event_s **pprev;    /**< Link pointing to this event, NULL when not queued */
+#endif
 } ticker_event_t;
 
 typedef void (*ticker_event_handler)(uint32_t id);
@@ -82,10 +95,16 @@ typedef struct {
     uint32_t tick_last_read;            /**< Last tick read */
     uint64_t tick_remainder;            /**< Ticks that have not been added to base_time */
     us_timestamp_t present_time;        /**< Store the timestamp used for present time */
+    volatile uint32_t sequence;         /**< Incremented before and after present_time is updated, odd while updating */
     bool initialized;                   /**< Indicate if the instance is initialized */
     bool dispatching;                   /**< The function ticker_irq_handler is dispatching */
     bool suspended;                     /**< Indicate if the instance is suspended */
     uint8_t frequency_shifts;           /**< If frequency is a value of 2^n, this is n, otherwise 0 */
+#if defined(MBED_TICKER_WHEEL_ENABLED)
+    ticker_event_t *wheel[TICKER_WHEEL_LEVELS][TICKER_WHEEL_SLOTS]; /**< Events due after wheel_unit */
+    uint16_t wheel_pending[TICKER_WHEEL_LEVELS]; /**< Bitmap of the non empty slots of each level */
+    uint64_t wheel_unit;                /**< Next lowest level slot to move to head, events before it are in head */
+#endif
 } ticker_event_queue_t;
 
 /** Ticker's data structure
@@ -159,6 +178,24 @@ void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
  */
 void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id);
 
+/** Insert an event to the queue, allowing it to run late to save wake-ups
+ *
+ * The event will be executed between timestamp and timestamp + slack. It is
+ * moved onto the timestamp of an event already in the queue within that
+ * window if there is one, so that both are handled by the same interrupt.
+ * Otherwise the timestamp is rounded up to a boundary that other events
+ * inserted with a similar slack also use.
+ *
+ * @note With a slack of 0 this is the same as ticker_insert_event_us.
+ *
+ * @param ticker    The ticker object.
+ * @param obj       The event object to be inserted to the queue
+ * @param timestamp The event's earliest timestamp
+ * @param slack     How late, in microseconds, the event may run
+ * @param id        The event object
+ */
+void ticker_insert_event_us_slack(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t slack, uint32_t id);
+
 /** Read the current (relative) ticker's timestamp
  *
  * @warning Return a relative timestamp because the counter wrap every 4294
@@ -179,7 +216,26 @@ timestamp_t ticker_read(const ticker_data_t *const ticker);
  */
 us_timestamp_t ticker_read_us(const ticker_data_t *const ticker);
 
+/** Read the current ticker's timestamp without a critical section
+ *
+ * The time elapsed since the ticker's present time was last updated is added
+ * to it, without updating it. Updates are detected with a sequence count and the
+ * read is retried, so the timestamp is the same as ticker_read_us would return.
+ * Safe to call from any context, it only falls back to ticker_read_us when it
+ * interrupts an update or the ticker is not initialized yet.
+ *
+ * @note The present time is updated at least once per ticker interrupt, which is
+ * never scheduled more than half the counter's range ahead.
+ *
+ * @param ticker The ticker object.
+ * @return The current timestamp
+ */
+us_timestamp_t ticker_read_us_lock_free(const ticker_data_t *const ticker);
+
 /** Read the next event's timestamp
+ *
+ * @note With the timer wheel enabled this may be earlier than the next
+ * event, when events have to be moved out of the wheel before then.
  *
  * @param ticker        The ticker object.
  * @param timestamp     The timestamp object.
@@ -45,6 +45,7 @@
 
 // mbed Debug libraries
 #include "platform/mbed_error.h"
+#include "platform/mbed_error_log.h"
 #include "platform/mbed_interface.h"
 #include "platform/mbed_assert.h"
 #include "platform/mbed_debug.h"
@@ -52,25 +53,33 @@
 // mbed Peripheral components
 #include "drivers/DigitalIn.h"
 #include "drivers/DigitalOut.h"
+#include "drivers/FastDigitalIn.h"
+#include "drivers/FastDigitalOut.h"
 #include "drivers/DigitalInOut.h"
 #include "drivers/BusIn.h"
 #include "drivers/BusOut.h"
+#include "drivers/StaticBusOut.h"
 #include "drivers/BusInOut.h"
 #include "drivers/PortIn.h"
 #include "drivers/PortInOut.h"
 #include "drivers/PortOut.h"
 #include "drivers/AnalogIn.h"
+#include "drivers/AnalogInDMA.h"
 #include "drivers/AnalogOut.h"
 #include "drivers/PwmOut.h"
+#include "drivers/InputCapture.h"
 #include "drivers/Serial.h"
 #include "drivers/SPI.h"
 #include "drivers/SPISlave.h"
 #include "drivers/I2C.h"
 #include "drivers/I2CSlave.h"
+#include "drivers/I2CBus.h"
 #include "drivers/Ethernet.h"
 #include "drivers/CAN.h"
 #include "drivers/RawSerial.h"
 #include "drivers/UARTSerial.h"
+#include "drivers/IPCChannel.h"
+#include "drivers/IPCQueue.h"
 #include "drivers/FlashIAP.h"
 #include "drivers/MbedCRC.h"
 #include "drivers/QSPI.h"
@@ -92,7 +101,12 @@
 #include "platform/mbed_power_mgmt.h"
 #include "platform/mbed_rtc_time.h"
 #include "platform/mbed_poll.h"
+#include "platform/mbed_splice.h"
+#include "platform/AsyncMemcpy.h"
 #include "platform/ATCmdParser.h"
+#include "platform/CircularBuffer.h"
+#include "platform/SPSCCircularBuffer.h"
+#include "platform/Buffer.h"
 #include "platform/FileSystemHandle.h"
 #include "platform/FileHandle.h"
 #include "platform/DirHandle.h"
@@ -101,9 +115,14 @@
 #include "platform/ScopedRomWriteLock.h"
 #include "platform/ScopedRamExecutionLock.h"
 #include "platform/mbed_stats.h"
+#include "platform/mbed_sched_trace.h"
+#include "platform/mbed_boot_timeline.h"
+#include "platform/mbed_profiler.h"
+#include "platform/mbed_printf.h"
 
 // mbed Non-hardware components
 #include "platform/Callback.h"
+#include "platform/InlineCallback.h"
 #include "platform/FunctionPointer.h"
 #include "platform/ScopedLock.h"
 
@@ -96,12 +96,22 @@ int ATCmdParser::write(const char *data, int size)
 int ATCmdParser::read(char *data, int size)
 {
     int i = 0;
-    for (; i < size; i++) {
-        int c = getc();
-        if (c < 0) {
+    while (i < size) {
+        pollfh fhs;
+        fhs.fh = _fh;
+        fhs.events = POLLIN;
+
+        int count = poll(&fhs, 1, _timeout);
+        if (count <= 0 || !(fhs.revents & POLLIN)) {
             return -1;
         }
-        data[i] = c;
+
+        // Take everything the stream has buffered, not a byte per poll
+        ssize_t len = _fh->read(data + i, size - i);
+        if (len <= 0) {
+            return -1;
+        }
+        i += len;
     }
     return i;
 }
@@ -257,6 +267,7 @@ restart:
         // We keep trying the match until we succeed or some other error
         // derails us.
         int j = 0;
+        bool oob_possible = false;
 
         while (true) {
             // If just peeking for OOBs, and at start of line, check
@@ -286,8 +297,13 @@ restart:
             _buffer[offset + j++] = c;
             _buffer[offset + j] = 0;
 
-            // Check for oob data
-            for (struct oob *oob = _oobs; oob; oob = oob->next) {
+            // Check for oob data, only while the line starts like an oob
+            // and isn't longer than all of them
+            if (j == 1) {
+                unsigned char first = c;
+                oob_possible = _oob_first[first / 32] & (1UL << (first % 32));
+            }
+            for (struct oob *oob = _oobs; oob_possible && (unsigned)j <= _oob_max_len && oob; oob = oob->next) {
                 if ((unsigned)j == oob->len && memcmp(
                             oob->prefix, _buffer + offset, oob->len) == 0) {
                     debug_if(_dbg_on, "AT! %s\n", oob->prefix);
@@ -387,6 +403,14 @@ void ATCmdParser::oob(const char *prefix, Callback<void()> cb)
     oob->cb = cb;
     oob->next = _oobs;
     _oobs = oob;
+
+    if (oob->len) {
+        unsigned char first = prefix[0];
+        _oob_first[first / 32] |= 1UL << (first % 32);
+    }
+    if (oob->len > _oob_max_len) {
+        _oob_max_len = oob->len;
+    }
 }
 
 void ATCmdParser::abort()
@@ -80,6 +80,11 @@ private:
     };
     oob *_oobs;
 
+    // Bitmap of the first characters of the oob prefixes, and the longest
+    // prefix, so lines which can't be an oob are not compared with them
+    uint32_t _oob_first[256 / 32];
+    unsigned _oob_max_len;
+
 public:
 
     /**
@@ -93,7 +98,8 @@ public:
      */
     ATCmdParser(FileHandle *fh, const char *output_delimiter = "\r",
                 int buffer_size = 256, int timeout = 8000, bool debug = false)
-        : _fh(fh), _buffer_size(buffer_size), _oob_cb_count(0), _in_prev(0), _oobs(NULL)
+        : _fh(fh), _buffer_size(buffer_size), _oob_cb_count(0), _in_prev(0), _oobs(NULL),
+          _oob_first(), _oob_max_len(0)
     {
         _buffer = new char[buffer_size];
         set_timeout(timeout);
@@ -252,6 +258,9 @@ public:
     /**
      * Read an array of bytes from the underlying stream
      *
+     * Reads as many bytes as the stream has buffered at once, waiting up to
+     * the timeout whenever it has none.
+     *
      * @param data The buffer for filling the read bytes
      * @param size Number of bytes to read
      * @return number of bytes read or -1 on failure
@@ -0,0 +1,120 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "platform/AsyncMemcpy.h"
+
+#ifndef MBED_CONF_PLATFORM_MEMCPY_ASYNC_THRESHOLD
+#define MBED_CONF_PLATFORM_MEMCPY_ASYNC_THRESHOLD 256
+#endif
+
+namespace mbed {
+
+AsyncMemcpy::AsyncMemcpy() : _channel(DMA_ERROR_OUT_OF_CHANNELS)
+{
+}
+
+AsyncMemcpy::~AsyncMemcpy()
+{
+    if (_channel >= 0) {
+        abort();
+        dma_channel_free(_channel);
+    }
+}
+
+int AsyncMemcpy::copy(void *dst, const void *src, size_t size, Callback<void(int)> done)
+{
+    uint8_t *d = static_cast<uint8_t *>(dst);
+    const uint8_t *s = static_cast<const uint8_t *>(src);
+
+    if (busy()) {
+        return DMA_ERROR_BUSY;
+    }
+
+    if (size >= MBED_CONF_PLATFORM_MEMCPY_ASYNC_THRESHOLD && _channel == DMA_ERROR_OUT_OF_CHANNELS) {
+        _channel = dma_channel_allocate(0);
+    }
+
+    if (size < MBED_CONF_PLATFORM_MEMCPY_ASYNC_THRESHOLD || _channel < 0) {
+        memcpy(d, s, size);
+        if (done) {
+            done(0);
+        }
+        return 0;
+    }
+
+    _desc.direction = DMA_DIRECTION_MEM_TO_MEM;
+    _desc.request = 0;
+    _desc.next = NULL;
+    if (((uintptr_t) d & 3) == ((uintptr_t) s & 3)) {
+        // Bytes up to the first word boundary and after the last one by the CPU, words by DMA
+        size_t head = (4 - ((uintptr_t) d & 3)) & 3;
+        size_t tail = (size - head) & 3;
+        memcpy(d, s, head);
+        memcpy(d + size - tail, s + size - tail, tail);
+        _desc.width = DMA_WIDTH_32;
+        _desc.src = s + head;
+        _desc.dst = d + head;
+        _desc.count = (size - head) / 4;
+    } else {
+        _desc.width = DMA_WIDTH_8;
+        _desc.src = s;
+        _desc.dst = d;
+        _desc.count = size;
+    }
+
+    _done = done;
+    int err = dma_channel_start(_channel, &_desc, dma_done, this);
+    if (err == DMA_ERROR_UNSUPPORTED) {
+        // Channels only, don't ask again
+        dma_channel_free(_channel);
+        _channel = DMA_ERROR_UNSUPPORTED;
+    }
+    if (err) {
+        _done = NULL;
+        memcpy(d, s, size);
+        if (done) {
+            done(0);
+        }
+    }
+    return 0;
+}
+
+bool AsyncMemcpy::busy() const
+{
+    return _channel >= 0 && dma_channel_busy(_channel);
+}
+
+void AsyncMemcpy::abort()
+{
+    if (_channel >= 0) {
+        dma_channel_abort(_channel);
+    }
+}
+
+void AsyncMemcpy::dma_done(void *context, int result)
+{
+    AsyncMemcpy *self = static_cast<AsyncMemcpy *>(context);
+    Callback<void(int)> done = self->_done;
+    self->_done = NULL;
+    if (done) {
+        done(result);
+    }
+}
+
+} // namespace mbed
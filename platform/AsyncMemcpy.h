@@ -0,0 +1,109 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ASYNC_MEMCPY_H
+#define MBED_ASYNC_MEMCPY_H
+
+#include <stddef.h>
+
+#include "hal/dma_api.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_AsyncMemcpy AsyncMemcpy class
+ * @{
+ */
+
+/** Copy memory with a DMA channel while the CPU does something else.
+ *
+ * Copies smaller than platform.memcpy-async-threshold, and all copies on
+ * targets without memory to memory DMA or when no channel is free, are done
+ * by the CPU before copy() returns. The channel is requested on the first
+ * DMA copy and kept until the AsyncMemcpy is destroyed.
+ *
+ * @code
+ * AsyncMemcpy copier;
+ * EventFlags flags;
+ *
+ * void copied(int result)
+ * {
+ *     flags.set(1);
+ * }
+ *
+ * copier.copy(frame, camera_buffer, sizeof(frame), copied);
+ * // ... prepare the next frame ...
+ * flags.wait_any(1);
+ * @endcode
+ *
+ * @note Synchronization level: Not protected. The callback is called from
+ * interrupt context.
+ */
+class AsyncMemcpy : private NonCopyable<AsyncMemcpy> {
+public:
+    /** Create an AsyncMemcpy, without requesting a channel yet
+     */
+    AsyncMemcpy();
+
+    /** Abort the copy in progress and release the channel
+     */
+    ~AsyncMemcpy();
+
+    /** Start copying memory
+     *
+     * Neither buffer may be accessed until done is called. On targets with
+     * a data cache, dst should cover whole cache lines, see hal/dma_api.h.
+     *
+     * @param dst  Destination, must not overlap src
+     * @param src  Source
+     * @param size Number of bytes to copy
+     * @param done Called with 0 when the copy is complete, or with
+     *             DMA_ERROR_TRANSFER or DMA_ERROR_ABORTED
+     * @return 0 if the copy was started or done, DMA_ERROR_BUSY if a copy
+     *         is in progress
+     */
+    int copy(void *dst, const void *src, size_t size, Callback<void(int)> done);
+
+    /** Check if a copy is in progress
+     *
+     * @return true until the callback of the last copy has been called
+     */
+    bool busy() const;
+
+    /** Stop the copy in progress, its callback is called with DMA_ERROR_ABORTED
+     */
+    void abort();
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    static void dma_done(void *context, int result);
+
+    int _channel;
+    dma_desc_t _desc;
+    Callback<void(int)> _done;
+#endif
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif
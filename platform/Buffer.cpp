@@ -0,0 +1,171 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/Buffer.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+
+namespace mbed {
+
+Buffer::Buffer() : _block(NULL), _data(NULL), _size(0)
+{
+}
+
+Buffer::Buffer(void *block, uint8_t *data, size_t size) : _block(block), _data(data), _size(size)
+{
+}
+
+Buffer::Buffer(const Buffer &other) : _block(other._block), _data(other._data), _size(other._size)
+{
+    if (_block) {
+        core_util_atomic_incr_u32(&static_cast<BufferPool::block_t *>(_block)->ref_count, 1);
+    }
+}
+
+Buffer::Buffer(Buffer &&other) : _block(other._block), _data(other._data), _size(other._size)
+{
+    other._block = NULL;
+    other._data = NULL;
+    other._size = 0;
+}
+
+Buffer::~Buffer()
+{
+    release();
+}
+
+Buffer &Buffer::operator=(const Buffer &other)
+{
+    if (this != &other) {
+        // Take the new reference first in case both share the block
+        if (other._block) {
+            core_util_atomic_incr_u32(&static_cast<BufferPool::block_t *>(other._block)->ref_count, 1);
+        }
+        release();
+        _block = other._block;
+        _data = other._data;
+        _size = other._size;
+    }
+    return *this;
+}
+
+Buffer &Buffer::operator=(Buffer &&other)
+{
+    if (this != &other) {
+        release();
+        _block = other._block;
+        _data = other._data;
+        _size = other._size;
+        other._block = NULL;
+        other._data = NULL;
+        other._size = 0;
+    }
+    return *this;
+}
+
+Buffer Buffer::slice(size_t offset, size_t length) const
+{
+    if (!_block || offset > _size || length > _size - offset) {
+        return Buffer();
+    }
+
+    core_util_atomic_incr_u32(&static_cast<BufferPool::block_t *>(_block)->ref_count, 1);
+    return Buffer(_block, _data + offset, length);
+}
+
+uint32_t Buffer::use_count() const
+{
+    if (!_block) {
+        return 0;
+    }
+    return core_util_atomic_load_u32(&static_cast<BufferPool::block_t *>(_block)->ref_count);
+}
+
+void Buffer::release()
+{
+    BufferPool::block_t *block = static_cast<BufferPool::block_t *>(_block);
+    if (block && core_util_atomic_decr_u32(&block->ref_count, 1) == 0) {
+        block->pool->free(block);
+    }
+    _block = NULL;
+}
+
+BufferPool::BufferPool(void *arena, size_t arena_size, size_t block_size) :
+    _free_list(NULL), _block_size(block_size), _block_count(0), _free_count(0)
+{
+    MBED_STATIC_ASSERT(sizeof(block_t) <= MBED_BUFFER_POOL_HEADER_SIZE,
+                       "Buffer pool block header doesn't fit in MBED_BUFFER_POOL_HEADER_SIZE");
+    MBED_ASSERT(((uintptr_t) arena & 7) == 0);
+
+    size_t stride = MBED_BUFFER_POOL_BLOCK_STRIDE(block_size);
+    uint8_t *ptr = static_cast<uint8_t *>(arena);
+
+    // Thread the free list through the blocks, lowest address first
+    block_t **tail = &_free_list;
+    while (arena_size >= stride) {
+        block_t *block = reinterpret_cast<block_t *>(ptr);
+        block->next = NULL;
+        block->ref_count = 0;
+        block->pool = this;
+        *tail = block;
+        tail = &block->next;
+
+        ptr += stride;
+        arena_size -= stride;
+        _block_count++;
+    }
+    _free_count = _block_count;
+}
+
+Buffer BufferPool::alloc(size_t size)
+{
+    if (size > _block_size) {
+        return Buffer();
+    }
+
+    core_util_critical_section_enter();
+    block_t *block = _free_list;
+    if (block) {
+        _free_list = block->next;
+        _free_count--;
+    }
+    core_util_critical_section_exit();
+
+    if (!block) {
+        return Buffer();
+    }
+
+    block->ref_count = 1;
+    return Buffer(block, reinterpret_cast<uint8_t *>(block) + MBED_BUFFER_POOL_HEADER_SIZE, size);
+}
+
+size_t BufferPool::free_count() const
+{
+    return _free_count;
+}
+
+void BufferPool::free(block_t *block)
+{
+    core_util_critical_section_enter();
+    block->next = _free_list;
+    _free_list = block;
+    _free_count++;
+    core_util_critical_section_exit();
+}
+
+} // namespace mbed
@@ -0,0 +1,229 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PLATFORM_BUFFER_H
+#define MBED_PLATFORM_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform/Span.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_Buffer Buffer and BufferPool classes
+ * @{
+ */
+
+/** Space reserved at the start of each pool block for its bookkeeping */
+#define MBED_BUFFER_POOL_HEADER_SIZE ((2 * sizeof(void *) + sizeof(uint32_t) + 7) & ~7)
+
+/** Size taken in a pool arena by a block of the given data size */
+#define MBED_BUFFER_POOL_BLOCK_STRIDE(block_size) \
+    (MBED_BUFFER_POOL_HEADER_SIZE + (((block_size) + 7) & ~7))
+
+class BufferPool;
+
+/** Reference counted view of a block of a BufferPool.
+ *
+ * Copying a Buffer shares the block rather than the data, and slice() gives
+ * views of part of it, so the same bytes can be handed from layer to layer
+ * without being copied. The block goes back to its pool when the last Buffer
+ * referring to it is destroyed.
+ *
+ * @note Synchronization level: Reference counting is thread and interrupt
+ * safe, access to the data isn't.
+ */
+class Buffer {
+public:
+    /** Create an empty Buffer
+     */
+    Buffer();
+
+    /** Share the block of another Buffer
+     */
+    Buffer(const Buffer &other);
+
+    /** Take over the block of another Buffer, leaving it empty
+     */
+    Buffer(Buffer &&other);
+
+    /** Release the block
+     */
+    ~Buffer();
+
+    /** Share the block of another Buffer, releasing the current one
+     */
+    Buffer &operator=(const Buffer &other);
+
+    /** Take over the block of another Buffer, releasing the current one
+     */
+    Buffer &operator=(Buffer &&other);
+
+    /** Start of the data viewed
+     */
+    uint8_t *data() const
+    {
+        return _data;
+    }
+
+    /** Number of bytes viewed
+     */
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /** Test if the Buffer views nothing
+     */
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /** The data viewed as a Span
+     */
+    Span<uint8_t> span() const
+    {
+        return Span<uint8_t>(_data, _size);
+    }
+
+    /** Create a view of part of the data, sharing the same block
+     *
+     *  @param offset   Start of the slice in this view
+     *  @param length   Length of the slice
+     *  @return         The slice, or an empty Buffer if it doesn't fit in this view
+     */
+    Buffer slice(size_t offset, size_t length) const;
+
+    /** Number of Buffers sharing the block
+     */
+    uint32_t use_count() const;
+
+    /** Test if the Buffer refers to a block
+     */
+    operator bool() const
+    {
+        return _block != NULL;
+    }
+
+private:
+    friend class BufferPool;
+
+    Buffer(void *block, uint8_t *data, size_t size);
+    void release();
+
+    void *_block;
+    uint8_t *_data;
+    size_t _size;
+};
+
+/** Pool of fixed-size blocks handed out as Buffers.
+ *
+ * Blocks are carved from an arena provided by the application, usually
+ * static, so allocating and freeing never touches the heap. Allocation and
+ * release can be done from interrupt context.
+ *
+ * @code
+ * static StaticBufferPool<128, 8> pool;
+ *
+ * Buffer buf = pool.alloc(64);
+ * if (buf) {
+ *     memcpy(buf.data(), payload, 64);
+ *     socket.send(buf.slice(0, 32));
+ * }
+ * @endcode
+ */
+class BufferPool : private NonCopyable<BufferPool> {
+public:
+    /** Create a pool over an arena
+     *
+     *  @param arena        Memory the blocks are carved from, 8-byte aligned
+     *  @param arena_size   Size of the arena, MBED_BUFFER_POOL_BLOCK_STRIDE(block_size)
+     *                      times the number of blocks
+     *  @param block_size   Data size of each block
+     */
+    BufferPool(void *arena, size_t arena_size, size_t block_size);
+
+    /** Allocate a block
+     *
+     *  @param size     Size of the Buffer returned, up to the block size
+     *  @return         Buffer viewing the first size bytes of the block, or an
+     *                  empty Buffer if the pool is exhausted or size is too big
+     */
+    Buffer alloc(size_t size);
+
+    /** Data size of each block
+     */
+    size_t block_size() const
+    {
+        return _block_size;
+    }
+
+    /** Number of blocks in the pool
+     */
+    size_t block_count() const
+    {
+        return _block_count;
+    }
+
+    /** Number of blocks currently free
+     */
+    size_t free_count() const;
+
+private:
+    friend class Buffer;
+
+    struct block_t {
+        block_t *next;
+        volatile uint32_t ref_count;
+        BufferPool *pool;
+    };
+
+    void free(block_t *block);
+
+    block_t *_free_list;
+    size_t _block_size;
+    size_t _block_count;
+    size_t _free_count;
+};
+
+/** BufferPool with its own static arena
+ *
+ * @tparam BlockSize    Data size of each block
+ * @tparam BlockCount   Number of blocks
+ */
+template <size_t BlockSize, size_t BlockCount>
+class StaticBufferPool : public BufferPool {
+public:
+    StaticBufferPool() : BufferPool(_arena, sizeof(_arena), BlockSize)
+    {
+    }
+
+private:
+    uint64_t _arena[(MBED_BUFFER_POOL_BLOCK_STRIDE(BlockSize) * BlockCount) / sizeof(uint64_t)];
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif
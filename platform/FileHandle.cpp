@@ -34,4 +34,41 @@ off_t FileHandle::size()
     return size;
 }
 
+ssize_t FileHandle::readv(const struct iovec *iov, int iovcnt)
+{
+    ssize_t total = 0;
+
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t ret = read(iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            // the error is reported by the next call if some data was read
+            return total ? total : ret;
+        }
+        total += ret;
+        if ((size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+
+    return total;
+}
+
+ssize_t FileHandle::writev(const struct iovec *iov, int iovcnt)
+{
+    ssize_t total = 0;
+
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t ret = write(iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            return total ? total : ret;
+        }
+        total += ret;
+        if ((size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+
+    return total;
+}
+
 } // namespace mbed
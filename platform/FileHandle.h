@@ -61,6 +61,22 @@ public:
      */
     virtual ssize_t read(void *buffer, size_t size) = 0;
 
+    /** Read the contents of a file in place
+     *
+     *  Files on memory-mapped storage can give a pointer to their contents
+     *  instead of copying them. The file position moves past the bytes
+     *  returned, as with read.
+     *
+     *  @param data     Set to the start of the data read
+     *  @param size     The maximum number of bytes to read
+     *  @return         The number of bytes at data, 0 at end of file,
+     *                  -ENOSYS if the data can't be read in place
+     */
+    virtual ssize_t read_in_place(const void **data, size_t size)
+    {
+        return -ENOSYS;
+    }
+
     /** Write the contents of a buffer to a file
      *
      *  Devices acting as FileHandles should follow POSIX semantics:
@@ -75,6 +91,34 @@ public:
      */
     virtual ssize_t write(const void *buffer, size_t size) = 0;
 
+    /** Read the contents of a file into several buffers
+     *
+     *  The buffers are filled in order, as a read into a single buffer of
+     *  their total size would. The default implementation reads each buffer
+     *  in turn and stops at the first one not filled, so it may block once
+     *  per buffer. Devices should read all buffers under one lock and block
+     *  only until some data is available, as read does.
+     *
+     *  @param iov      The buffers to read in to
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t readv(const struct iovec *iov, int iovcnt);
+
+    /** Write the contents of several buffers to a file
+     *
+     *  The buffers are written in order, as a write of a single buffer
+     *  holding all of them would. The default implementation writes each
+     *  buffer in turn and stops at the first one not fully written. Devices
+     *  should write all buffers under one lock, so they are not interleaved
+     *  with the writes of other threads.
+     *
+     *  @param iov      The buffers to write from
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t writev(const struct iovec *iov, int iovcnt);
+
     /** Move the file position to a given offset from from a given location
      *
      *  @param offset   The offset from whence to move to
@@ -260,7 +304,8 @@ public:
      * You can use or ignore the input parameter. You can return all events
      * or check just the events listed in events.
      * Call is nonblocking - returns instantaneous state of events.
-     * Whenever an event occurs, the derived class should call the sigio() callback).
+     * Whenever an event occurs, the derived class should call the sigio() callback),
+     * and mbed::poll_wake() if it wakes poll.
      *
      * @param events        bitmask of poll events we're interested in - POLLIN/POLLOUT etc.
      *
@@ -272,6 +317,19 @@ public:
         return POLLIN | POLLOUT;
     }
 
+    /** Check whether the file handle wakes up poll()
+     *
+     *  File handles returning true call mbed::poll_wake() on every change of
+     *  their poll() events, so mbed::poll() can block on them until woken.
+     *  Other file handles are rescanned periodically.
+     *
+     *  @returns            true if the FileHandle calls mbed::poll_wake().
+     */
+    virtual bool wakes_poll() const
+    {
+        return false;
+    }
+
     /** Definition depends on the subclass implementing FileHandle.
      *  For example, if the FileHandle is of type Stream, writable() could return
      *  true when there is ample buffer space available for write() calls.
@@ -0,0 +1,240 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INLINECALLBACK_H
+#define MBED_INLINECALLBACK_H
+
+#include <stddef.h>
+#include <string.h>
+#include <new>
+#include "platform/mbed_assert.h"
+#include "platform/mbed_toolchain.h"
+#include "platform/mbed_cxxsupport.h"
+
+namespace mbed {
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_InlineCallback InlineCallback class
+ * @{
+ */
+
+/** Default number of bytes of state an InlineCallback can hold */
+#define MBED_INLINE_CALLBACK_DEFAULT_SIZE (4 * sizeof(void *))
+
+/** Callback with inline storage for function objects
+ *
+ * Unlike Callback, which holds at most a pointer's worth of function object,
+ * an InlineCallback stores function objects of up to Size bytes, such as
+ * lambdas capturing several values, without any allocation.
+ *
+ * The function object must be trivially copyable: it is copied and moved
+ * as raw bytes, and never destroyed. Sizes are checked at compile time.
+ *
+ * @code
+ * int a = 1, b = 2, c = 3;
+ * InlineCallback<int()> cb = [a, b, c]() { return a + b + c; };
+ * cb(); // returns 6
+ * @endcode
+ *
+ * @note Synchronization level: Not protected
+ */
+template <typename F, size_t Size = MBED_INLINE_CALLBACK_DEFAULT_SIZE>
+class InlineCallback;
+
+/** Callback with inline storage for function objects
+ *
+ * @tparam R    Return type
+ * @tparam ArgTs Argument types
+ * @tparam Size Bytes available to store the function object
+ *
+ * @note Synchronization level: Not protected
+ */
+template <typename R, typename... ArgTs, size_t Size>
+class InlineCallback<R(ArgTs...), Size> {
+    // Storage is aligned for any pointer, integer or floating point member
+    union storage_t {
+        void *p;
+        long long ll;
+        long double ld;
+        void (*fp)();
+        unsigned char data[Size];
+    };
+
+public:
+    /** Create an empty InlineCallback
+     */
+    InlineCallback() : _call(NULL)
+    {
+    }
+
+    /** Create an InlineCallback with a static function
+     *  @param func     Static function to attach
+     */
+    InlineCallback(R(*func)(ArgTs...)) : _call(NULL)
+    {
+        if (func) {
+            generate(func);
+        }
+    }
+
+    /** Create an InlineCallback with a function object
+     *  @param f    Trivially copyable function object to attach,
+     *              of at most Size bytes
+     */
+    template <typename F, typename std::enable_if<
+                  !std::is_same<typename std::decay<F>::type, InlineCallback>::value, int>::type = 0>
+    InlineCallback(const F &f) : _call(NULL)
+    {
+        generate(f);
+    }
+
+    /** Create an InlineCallback with a member function
+     *  @param obj      Pointer to object to invoke member function on
+     *  @param method   Member function to attach
+     */
+    template <typename T, typename U>
+    InlineCallback(U *obj, R(T::*method)(ArgTs...)) : _call(NULL)
+    {
+        generate(method_context<T, R(T::*)(ArgTs...)>(obj, method));
+    }
+
+    /** Create an InlineCallback with a member function
+     *  @param obj      Pointer to object to invoke member function on
+     *  @param method   Member function to attach
+     */
+    template <typename T, typename U>
+    InlineCallback(const U *obj, R(T::*method)(ArgTs...) const) : _call(NULL)
+    {
+        generate(method_context<const T, R(T::*)(ArgTs...) const>(obj, method));
+    }
+
+    /** Copy an InlineCallback
+     */
+    InlineCallback(const InlineCallback &that) : _call(that._call)
+    {
+        memcpy(&_storage, &that._storage, sizeof(_storage));
+    }
+
+    /** Move an InlineCallback, leaving the source empty
+     */
+    InlineCallback(InlineCallback &&that) : _call(that._call)
+    {
+        memcpy(&_storage, &that._storage, sizeof(_storage));
+        that._call = NULL;
+    }
+
+    /** Assign an InlineCallback
+     */
+    InlineCallback &operator=(const InlineCallback &that)
+    {
+        if (this != &that) {
+            memcpy(&_storage, &that._storage, sizeof(_storage));
+            _call = that._call;
+        }
+        return *this;
+    }
+
+    /** Move-assign an InlineCallback, leaving the source empty
+     */
+    InlineCallback &operator=(InlineCallback &&that)
+    {
+        if (this != &that) {
+            memcpy(&_storage, &that._storage, sizeof(_storage));
+            _call = that._call;
+            that._call = NULL;
+        }
+        return *this;
+    }
+
+    /** Call the attached function
+     */
+    R call(ArgTs... args) const
+    {
+        MBED_ASSERT(_call);
+        return _call(&_storage, args...);
+    }
+
+    /** Call the attached function
+     */
+    R operator()(ArgTs... args) const
+    {
+        return call(args...);
+    }
+
+    /** Test if function has been attached
+     */
+    operator bool() const
+    {
+        return _call != NULL;
+    }
+
+    /** Static thunk for passing as C-style function
+     *  @param func InlineCallback to call passed as void pointer
+     *  @param args Arguments to be called with function func
+     *  @return the value as determined by func which is of
+     *      type and determined by the signature of func
+     */
+    static R thunk(void *func, ArgTs... args)
+    {
+        return static_cast<InlineCallback *>(func)->call(args...);
+    }
+
+private:
+    storage_t _storage;
+    R(*_call)(const void *, ArgTs...);
+
+    template <typename F>
+    void generate(const F &f)
+    {
+        MBED_STATIC_ASSERT(sizeof(F) <= Size,
+                           "Function object must not exceed the InlineCallback storage size");
+        MBED_STATIC_ASSERT(alignof(F) <= alignof(storage_t),
+                           "Function object alignment is not supported by InlineCallback storage");
+        MBED_STATIC_ASSERT(std::is_trivially_copyable<F>::value,
+                           "Function object stored in InlineCallback must be trivially copyable");
+        new (&_storage) F(f);
+        _call = &InlineCallback::function_call<F>;
+    }
+
+    template <typename F>
+    static R function_call(const void *p, ArgTs... args)
+    {
+        return (*(const F *)p)(args...);
+    }
+
+    template <typename O, typename M>
+    struct method_context {
+        M method;
+        O *obj;
+
+        method_context(O *obj, M method)
+            : method(method), obj(obj) {}
+
+        R operator()(ArgTs... args) const
+        {
+            return (obj->*method)(args...);
+        }
+    };
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif
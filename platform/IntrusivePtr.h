@@ -0,0 +1,253 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_INTRUSIVEPTR_H
+#define MBED_INTRUSIVEPTR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "platform/mbed_atomic.h"
+
+namespace mbed {
+
+/** Base class of objects counting their own references.
+  *
+  * The reference counter lives in the object itself, so an object managed by
+  * IntrusivePtr costs a single allocation and no separate counter. The object
+  * is deleted when the last IntrusivePtr to it goes away.
+  *
+  * @tparam T The class deriving from RefCounted.
+  *
+  * @code
+  * struct Buffer : RefCounted<Buffer> {
+  *     uint8_t data[32];
+  * };
+  *
+  * IntrusivePtr<Buffer> ptr(new Buffer);
+  * IntrusivePtr<Buffer> ptr2(ptr); // Reference count is 2
+  * @endcode
+  */
+template <class T>
+class RefCounted {
+public:
+    /**
+     * @brief Take a reference to the object.
+     */
+    void add_ref() const
+    {
+        core_util_atomic_incr_u32(&_ref_count, 1);
+    }
+
+    /**
+     * @brief Release a reference to the object, deleting it with the last one.
+     */
+    void release() const
+    {
+        if (core_util_atomic_decr_u32(&_ref_count, 1) == 0) {
+            delete static_cast<const T *>(this);
+        }
+    }
+
+    /**
+     * @brief Reference count accessor.
+     * @return Reference count.
+     */
+    uint32_t use_count() const
+    {
+        return core_util_atomic_load_u32(&_ref_count);
+    }
+
+protected:
+    RefCounted() : _ref_count(0)
+    {
+    }
+
+    // Copies are new objects, with no reference yet
+    RefCounted(const RefCounted &) : _ref_count(0)
+    {
+    }
+
+    RefCounted &operator=(const RefCounted &)
+    {
+        return *this;
+    }
+
+    ~RefCounted()
+    {
+    }
+
+private:
+    mutable volatile uint32_t _ref_count;
+};
+
+/** Pointer to an object deriving from RefCounted.
+  *
+  * Copying the pointer takes a reference on the object, destroying it releases
+  * the reference. A raw pointer to the object can be turned back into an
+  * IntrusivePtr at any time, as the counter is part of the object.
+  *
+  * @tparam T The class pointed to, deriving from RefCounted<T>.
+  */
+template <class T>
+class IntrusivePtr {
+public:
+    /**
+     * @brief Create empty IntrusivePtr not pointing to anything.
+     */
+    IntrusivePtr(): _ptr(NULL)
+    {
+    }
+
+    /**
+     * @brief Create new IntrusivePtr taking a reference to ptr.
+     * @param ptr Pointer to the object.
+     */
+    IntrusivePtr(T *ptr): _ptr(ptr)
+    {
+        if (_ptr != NULL) {
+            _ptr->add_ref();
+        }
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param source Object being copied from.
+     */
+    IntrusivePtr(const IntrusivePtr &source): _ptr(source._ptr)
+    {
+        if (_ptr != NULL) {
+            _ptr->add_ref();
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param source Object being moved from, left empty.
+     */
+    IntrusivePtr(IntrusivePtr &&source): _ptr(source._ptr)
+    {
+        source._ptr = NULL;
+    }
+
+    /**
+     * @brief Destructor.
+     * @details Release the reference, deleting the object with the last one.
+     */
+    ~IntrusivePtr()
+    {
+        if (_ptr != NULL) {
+            _ptr->release();
+        }
+    }
+
+    /**
+     * @brief Assignment operator.
+     * @param source Object being assigned from.
+     * @return Object being assigned.
+     */
+    IntrusivePtr &operator=(const IntrusivePtr &source)
+    {
+        reset(source._ptr);
+        return *this;
+    }
+
+    /**
+     * @brief Replace the pointed object.
+     * @param ptr The new object to take a reference to, or NULL.
+     */
+    void reset(T *ptr = NULL)
+    {
+        // Take the new reference first in case ptr is the object pointed to
+        if (ptr != NULL) {
+            ptr->add_ref();
+        }
+        if (_ptr != NULL) {
+            _ptr->release();
+        }
+        _ptr = ptr;
+    }
+
+    /**
+     * @brief Raw pointer accessor.
+     * @return Pointer.
+     */
+    T *get() const
+    {
+        return _ptr;
+    }
+
+    /**
+     * @brief Reference count accessor.
+     * @return Reference count.
+     */
+    uint32_t use_count() const
+    {
+        return _ptr != NULL ? _ptr->use_count() : 0;
+    }
+
+    /**
+     * @brief Dereference object operator.
+     */
+    T &operator*() const
+    {
+        return *_ptr;
+    }
+
+    /**
+     * @brief Dereference object member operator.
+     */
+    T *operator->() const
+    {
+        return _ptr;
+    }
+
+    /**
+     * @brief Boolean conversion operator.
+     * @return Whether or not the pointer is NULL.
+     */
+    operator bool() const
+    {
+        return (_ptr != NULL);
+    }
+
+private:
+    T *_ptr;
+};
+
+/** Non-member relational operators.
+  */
+template <class T, class U>
+bool operator== (const IntrusivePtr<T> &lhs, const IntrusivePtr<U> &rhs)
+{
+    return (lhs.get() == rhs.get());
+}
+
+template <class T, class U>
+bool operator!= (const IntrusivePtr<T> &lhs, const IntrusivePtr<U> &rhs)
+{
+    return (lhs.get() != rhs.get());
+}
+
+} /* namespace mbed */
+
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::RefCounted;
+using mbed::IntrusivePtr;
+#endif
+
+#endif // MBED_INTRUSIVEPTR_H
@@ -0,0 +1,112 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PLATFORM_RWMUTEX_H
+#define PLATFORM_RWMUTEX_H
+
+#include "platform/NonCopyable.h"
+
+/** \addtogroup platform
+ * @{
+ */
+
+/** \defgroup platform_PlatformRWMutex PlatformRWMutex class
+ * @{
+ */
+
+/** The PlatformRWMutex class is a readers-writer lock for read-mostly data.
+ *
+ * Mbed drivers use the PlatformRWMutex class instead of rtos::RWMutex.
+ * This enables the use of drivers when the Mbed OS is compiled without the RTOS.
+ *
+ * @note
+ * - When the RTOS is present, the PlatformRWMutex becomes a typedef for rtos::RWMutex.
+ * - When the RTOS is absent, all methods are defined as noop.
+ */
+
+#ifdef MBED_CONF_RTOS_PRESENT
+
+#include "rtos/RWMutex.h"
+typedef rtos::RWMutex PlatformRWMutex;
+
+#else
+
+class PlatformRWMutex: private mbed::NonCopyable<PlatformRWMutex> {
+public:
+    /** Create a PlatformRWMutex object.
+     *
+     * @note When the RTOS is present, this is an alias for rtos::RWMutex::RWMutex().
+     */
+    PlatformRWMutex()
+    {
+    }
+
+    /** PlatformRWMutex destructor.
+     *
+     * @note When the RTOS is present, this is an alias for rtos::RWMutex::~RWMutex().
+     */
+    ~PlatformRWMutex()
+    {
+    }
+
+    /** Wait until the PlatformRWMutex can be held exclusively.
+     *
+     * @note
+     * - When the RTOS is present, this is an alias for rtos::RWMutex::lock().
+     * - When the RTOS is absent, this is a noop.
+     */
+    void lock()
+    {
+    }
+
+    /** Release an exclusive lock.
+     *
+     * @note
+     * - When the RTOS is present, this is an alias for rtos::RWMutex::unlock().
+     * - When the RTOS is absent, this is a noop.
+     */
+    void unlock()
+    {
+    }
+
+    /** Wait until the PlatformRWMutex can be held shared.
+     *
+     * @note
+     * - When the RTOS is present, this is an alias for rtos::RWMutex::lock_shared().
+     * - When the RTOS is absent, this is a noop.
+     */
+    void lock_shared()
+    {
+    }
+
+    /** Release a shared lock.
+     *
+     * @note
+     * - When the RTOS is present, this is an alias for rtos::RWMutex::unlock_shared().
+     * - When the RTOS is absent, this is a noop.
+     */
+    void unlock_shared()
+    {
+    }
+};
+
+#endif
+
+#endif
+
+/**@}*/
+
+/**@}*/
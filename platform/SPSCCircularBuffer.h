@@ -0,0 +1,231 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SPSCCIRCULARBUFFER_H
+#define MBED_SPSCCIRCULARBUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_assert.h"
+#include "platform/Span.h"
+
+namespace mbed {
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_SPSCCircularBuffer SPSCCircularBuffer functions
+ * @{
+ */
+
+/** Templated lock-free circular buffer for a single producer and a single consumer
+ *
+ *  Unlike CircularBuffer, pushing and popping doesn't enter a critical
+ *  section. The producer only writes the head index and the consumer only
+ *  writes the tail index, each published with release ordering and read
+ *  with acquire ordering, so one context can push while another pops, for
+ *  example an interrupt handler feeding a thread.
+ *
+ *  Pushing to a full buffer fails instead of overwriting the oldest
+ *  element, as that would require the producer to move the tail.
+ *
+ *  Bulk push and pop copy up to two contiguous regions.
+ *
+ *  @note Synchronization level: Interrupt safe for one producer and one
+ *        consumer. Multiple producers or consumers must be serialized,
+ *        for example with a mutex or critical section.
+ */
+template<typename T, uint32_t BufferSize>
+class SPSCCircularBuffer {
+public:
+    SPSCCircularBuffer() : _head(0), _tail(0)
+    {
+        MBED_STATIC_ASSERT(BufferSize > 0 && BufferSize < 0x80000000, "Invalid BufferSize");
+    }
+
+    /** Push an element to the buffer, producer only
+     *
+     * @param data Data to be pushed to the buffer
+     * @return True if the element was pushed, false if the buffer is full
+     */
+    bool push(const T &data)
+    {
+        uint32_t head = _head;
+        uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_acquire);
+        if (count(head, tail) == BufferSize) {
+            return false;
+        }
+
+        _pool[head % BufferSize] = data;
+        core_util_atomic_store_explicit_u32(&_head, advance(head, 1), mbed_memory_order_release);
+        return true;
+    }
+
+    /** Push as many elements as fit to the buffer, producer only
+     *
+     * @param src Elements to be pushed to the buffer
+     * @return Number of elements pushed
+     */
+    uint32_t push(const Span<const T> &src)
+    {
+        uint32_t head = _head;
+        uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_acquire);
+        uint32_t length = BufferSize - count(head, tail);
+        if ((uint32_t)src.size() < length) {
+            length = src.size();
+        }
+
+        uint32_t index = head % BufferSize;
+        uint32_t first = BufferSize - index < length ? BufferSize - index : length;
+        copy(&_pool[index], src.data(), first);
+        copy(&_pool[0], src.data() + first, length - first);
+
+        core_util_atomic_store_explicit_u32(&_head, advance(head, length), mbed_memory_order_release);
+        return length;
+    }
+
+    /** Pop an element from the buffer, consumer only
+     *
+     * @param data Data to be popped from the buffer
+     * @return True if the buffer is not empty and data contains an element, false otherwise
+     */
+    bool pop(T &data)
+    {
+        uint32_t tail = _tail;
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+
+        data = _pool[tail % BufferSize];
+        core_util_atomic_store_explicit_u32(&_tail, advance(tail, 1), mbed_memory_order_release);
+        return true;
+    }
+
+    /** Pop as many elements as available from the buffer, consumer only
+     *
+     * @param dst Buffer to pop elements into
+     * @return Number of elements popped
+     */
+    uint32_t pop(const Span<T> &dst)
+    {
+        uint32_t tail = _tail;
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_acquire);
+        uint32_t length = count(head, tail);
+        if ((uint32_t)dst.size() < length) {
+            length = dst.size();
+        }
+
+        uint32_t index = tail % BufferSize;
+        uint32_t first = BufferSize - index < length ? BufferSize - index : length;
+        copy(dst.data(), &_pool[index], first);
+        copy(dst.data() + first, &_pool[0], length - first);
+
+        core_util_atomic_store_explicit_u32(&_tail, advance(tail, length), mbed_memory_order_release);
+        return length;
+    }
+
+    /** Peek into the buffer without popping, consumer only
+     *
+     * @param data Data to be peeked from the buffer
+     * @return True if the buffer is not empty and data contains an element, false otherwise
+     */
+    bool peek(T &data) const
+    {
+        uint32_t tail = _tail;
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+
+        data = _pool[tail % BufferSize];
+        return true;
+    }
+
+    /** Check if the buffer is empty
+     *
+     * @return True if the buffer is empty, false if not
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /** Check if the buffer is full
+     *
+     * @return True if the buffer is full, false if not
+     */
+    bool full() const
+    {
+        return size() == BufferSize;
+    }
+
+    /** Get the number of elements currently stored in the buffer
+     *
+     *  Exact from the producer or consumer, a snapshot from anywhere else.
+     */
+    uint32_t size() const
+    {
+        uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_acquire);
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_acquire);
+        return count(head, tail);
+    }
+
+    /** Reset the buffer
+     *
+     *  Not safe against concurrent pushes or pops.
+     */
+    void reset()
+    {
+        core_util_atomic_store_u32(&_head, 0);
+        core_util_atomic_store_u32(&_tail, 0);
+    }
+
+private:
+    /* Indices run over twice the buffer size, so a full buffer can be told
+     * apart from an empty one without a flag shared by both sides.
+     */
+    static uint32_t advance(uint32_t index, uint32_t n)
+    {
+        index += n;
+        return index >= 2 * BufferSize ? index - 2 * BufferSize : index;
+    }
+
+    static uint32_t count(uint32_t head, uint32_t tail)
+    {
+        return head >= tail ? head - tail : head + 2 * BufferSize - tail;
+    }
+
+    static void copy(T *dst, const T *src, uint32_t n)
+    {
+        for (uint32_t i = 0; i < n; i++) {
+            dst[i] = src[i];
+        }
+    }
+
+    T _pool[BufferSize];
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif
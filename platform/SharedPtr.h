@@ -23,7 +23,10 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include <new>
+
 #include "platform/mbed_atomic.h"
+#include "platform/mbed_cxxsupport.h"
 
 namespace mbed {
 
@@ -52,7 +55,7 @@ namespace mbed {
   *
   *
   * It is similar to the std::shared_ptr class introduced in C++11;
-  * however, this is not a compatible implementation (no weak pointer, no make_shared, no custom deleters and so on.)
+  * however, this is not a compatible implementation (no custom deleters, no aliasing, no conversions and so on.)
   *
   * Usage: SharedPtr<Class> ptr(new Class())
   *
@@ -60,10 +63,133 @@ namespace mbed {
   * destructor manages the reference count of the raw pointer.
   * If the counter reaches zero, delete is called on the raw pointer.
   *
-  * To avoid loops, use "weak" references by calling the original
-  * pointer directly through ptr.get().
+  * To avoid loops, use WeakPtr, or "weak" references by calling the
+  * original pointer directly through ptr.get().
+  *
+  * Use make_shared_ptr<Class>(args...) to allocate the object and the reference
+  * counters together in a single allocation.
   */
 
+template <class T>
+class WeakPtr;
+
+namespace detail {
+
+/* Reference counts shared by all SharedPtr and WeakPtr to an object.
+ * weak_count counts weak pointers, plus one for all shared pointers together,
+ * so the block outlives the object as long as a weak pointer refers to it.
+ */
+class shared_ptr_control_block {
+public:
+    void acquire()
+    {
+        core_util_atomic_incr_u32(&use_count, 1);
+    }
+
+    bool acquire_if_alive()
+    {
+        uint32_t count = core_util_atomic_load_u32(&use_count);
+        while (count != 0) {
+            if (core_util_atomic_cas_u32(&use_count, &count, count + 1)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void release()
+    {
+        if (core_util_atomic_decr_u32(&use_count, 1) == 0) {
+            _destroy_object(this);
+            release_weak();
+        }
+    }
+
+    void acquire_weak()
+    {
+        core_util_atomic_incr_u32(&weak_count, 1);
+    }
+
+    void release_weak()
+    {
+        if (core_util_atomic_decr_u32(&weak_count, 1) == 0) {
+            _deallocate(this);
+        }
+    }
+
+    volatile uint32_t use_count;
+    volatile uint32_t weak_count;
+
+protected:
+    // Plain function pointers rather than virtual functions, like Callback,
+    // so blocks are deleted through their own type
+    typedef void (*operation_t)(shared_ptr_control_block *);
+
+    shared_ptr_control_block(operation_t destroy_object, operation_t deallocate) :
+        use_count(1), weak_count(1), _destroy_object(destroy_object), _deallocate(deallocate)
+    {
+    }
+
+private:
+    operation_t _destroy_object;
+    operation_t _deallocate;
+};
+
+/* Control block of an object allocated separately */
+template <class T>
+class shared_ptr_pointer_block : public shared_ptr_control_block {
+public:
+    shared_ptr_pointer_block(T *ptr) :
+        shared_ptr_control_block(&destroy_object, &deallocate), _ptr(ptr)
+    {
+    }
+
+private:
+    static void destroy_object(shared_ptr_control_block *block)
+    {
+        delete static_cast<shared_ptr_pointer_block *>(block)->_ptr;
+    }
+
+    static void deallocate(shared_ptr_control_block *block)
+    {
+        delete static_cast<shared_ptr_pointer_block *>(block);
+    }
+
+    T *_ptr;
+};
+
+/* Control block holding the object itself, see make_shared_ptr */
+template <class T>
+class shared_ptr_inplace_block : public shared_ptr_control_block {
+public:
+    template <typename... Args>
+    shared_ptr_inplace_block(Args &&... args) :
+        shared_ptr_control_block(&destroy_object, &deallocate)
+    {
+        new (&_storage) T(std::forward<Args>(args)...);
+    }
+
+    T *get()
+    {
+        return reinterpret_cast<T *>(&_storage);
+    }
+
+private:
+    static void destroy_object(shared_ptr_control_block *block)
+    {
+        static_cast<shared_ptr_inplace_block *>(block)->get()->~T();
+    }
+
+    static void deallocate(shared_ptr_control_block *block)
+    {
+        delete static_cast<shared_ptr_inplace_block *>(block);
+    }
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage;
+};
+
+} // namespace detail
+
 template <class T>
 class SharedPtr {
 public:
@@ -71,7 +197,7 @@ public:
      * @brief Create empty SharedPtr not pointing to anything.
      * @details Used for variable declaration.
      */
-    SharedPtr(): _ptr(NULL), _counter(NULL)
+    SharedPtr(): _ptr(NULL), _control(NULL)
     {
     }
 
@@ -79,12 +205,11 @@ public:
      * @brief Create new SharedPtr
      * @param ptr Pointer to take control over
      */
-    SharedPtr(T *ptr): _ptr(ptr), _counter(NULL)
+    SharedPtr(T *ptr): _ptr(ptr), _control(NULL)
     {
         // Allocate counter on the heap, so it can be shared
         if (_ptr != NULL) {
-            _counter = new uint32_t;
-            *_counter = 1;
+            _control = new detail::shared_ptr_pointer_block<T>(ptr);
         }
     }
 
@@ -103,14 +228,25 @@ public:
      *          copying pointer to original object and pointer to counter.
      * @param source Object being copied from.
      */
-    SharedPtr(const SharedPtr &source): _ptr(source._ptr), _counter(source._counter)
+    SharedPtr(const SharedPtr &source): _ptr(source._ptr), _control(source._control)
     {
         // Increment reference counter
         if (_ptr != NULL) {
-            core_util_atomic_incr_u32(_counter, 1);
+            _control->acquire();
         }
     }
 
+    /**
+     * @brief Move constructor.
+     * @details Take over the reference held by source, leaving it empty.
+     * @param source Object being moved from.
+     */
+    SharedPtr(SharedPtr &&source): _ptr(source._ptr), _control(source._control)
+    {
+        source._ptr = NULL;
+        source._control = NULL;
+    }
+
     /**
      * @brief Assignment operator.
      * @details Cleanup previous reference and assign new pointer and counter.
@@ -125,11 +261,11 @@ public:
 
             // Assign new values
             _ptr = source.get();
-            _counter = source.get_counter();
+            _control = source._control;
 
             // Increment new counter
             if (_ptr != NULL) {
-                core_util_atomic_incr_u32(_counter, 1);
+                _control->acquire();
             }
         }
 
@@ -148,10 +284,9 @@ public:
         _ptr = ptr;
         if (ptr != NULL) {
             // Allocate counter on the heap, so it can be shared
-            _counter = new uint32_t;
-            *_counter = 1;
+            _control = new detail::shared_ptr_pointer_block<T>(ptr);
         } else {
-            _counter = NULL;
+            _control = NULL;
         }
     }
 
@@ -180,7 +315,7 @@ public:
     uint32_t use_count() const
     {
         if (_ptr != NULL) {
-            return core_util_atomic_load_u32(_counter);
+            return core_util_atomic_load_u32(&_control->use_count);
         } else {
             return 0;
         }
@@ -214,28 +349,28 @@ public:
     }
 
 private:
+    template <class U, typename... Args>
+    friend SharedPtr<U> make_shared_ptr(Args &&... args);
+    friend class WeakPtr<T>;
+
     /**
-     * @brief Get pointer to reference counter.
-     * @return Pointer to reference counter.
+     * @brief Adopt a reference already taken on a control block.
      */
-    uint32_t *get_counter() const
+    SharedPtr(T *ptr, detail::shared_ptr_control_block *control): _ptr(ptr), _control(control)
     {
-        return _counter;
     }
 
     /**
      * @brief Decrement reference counter.
-     * @details If count reaches zero, free counter and delete object pointed to.
+     * @details If count reaches zero, delete object pointed to, and free the
+     * counter once no weak pointer refers to it.
      * Does not modify our own pointers - assumption is they will be overwritten
      * or destroyed immediately afterwards.
      */
     void decrement_counter()
     {
         if (_ptr != NULL) {
-            if (core_util_atomic_decr_u32(_counter, 1) == 0) {
-                delete _counter;
-                delete _ptr;
-            }
+            _control->release();
         }
     }
 
@@ -243,8 +378,164 @@ private:
     // Pointer to shared object
     T *_ptr;
 
-    // Pointer to shared reference counter
-    uint32_t *_counter;
+    // Pointer to shared reference counters
+    detail::shared_ptr_control_block *_control;
+};
+
+/** Create an object and a SharedPtr managing it with a single allocation.
+ *
+ * The reference counters and the object share one heap block, instead of
+ * the two allocations made by SharedPtr<T>(new T(...)). Named differently
+ * from std::make_shared so both can be used unqualified with mbed.h.
+ *
+ * @code
+ * SharedPtr<MyStruct> ptr = make_shared_ptr<MyStruct>(arg1, arg2);
+ * @endcode
+ *
+ * @param args Arguments forwarded to the constructor of T.
+ * @return SharedPtr managing the new object.
+ */
+template <class T, typename... Args>
+SharedPtr<T> make_shared_ptr(Args &&... args)
+{
+    detail::shared_ptr_inplace_block<T> *block =
+        new detail::shared_ptr_inplace_block<T>(std::forward<Args>(args)...);
+    return SharedPtr<T>(block->get(), block);
+}
+
+/** Weak pointer class.
+  *
+  * A weak pointer refers to an object managed by SharedPtr without keeping it
+  * alive. Use lock() to get a SharedPtr to the object if it still exists.
+  * This breaks reference loops between shared objects.
+  *
+  * @code
+  * SharedPtr<MyStruct> ptr = make_shared_ptr<MyStruct>();
+  * WeakPtr<MyStruct> weak(ptr);
+  *
+  * SharedPtr<MyStruct> locked = weak.lock(); // Points to the object
+  *
+  * ptr = NULL;
+  * locked = NULL; // The object is freed
+  *
+  * weak.expired(); // true, weak.lock() returns an empty SharedPtr
+  * @endcode
+  */
+template <class T>
+class WeakPtr {
+public:
+    /**
+     * @brief Create empty WeakPtr not pointing to anything.
+     */
+    WeakPtr(): _ptr(NULL), _control(NULL)
+    {
+    }
+
+    /**
+     * @brief Create a WeakPtr to the object managed by a SharedPtr.
+     * @param source Shared pointer to the object.
+     */
+    WeakPtr(const SharedPtr<T> &source): _ptr(source._ptr), _control(source._control)
+    {
+        if (_control != NULL) {
+            _control->acquire_weak();
+        }
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param source Object being copied from.
+     */
+    WeakPtr(const WeakPtr &source): _ptr(source._ptr), _control(source._control)
+    {
+        if (_control != NULL) {
+            _control->acquire_weak();
+        }
+    }
+
+    /**
+     * @brief Destructor.
+     * @details Release the counters, they are freed with the last reference.
+     */
+    ~WeakPtr()
+    {
+        if (_control != NULL) {
+            _control->release_weak();
+        }
+    }
+
+    /**
+     * @brief Assignment operator.
+     * @param source Object being assigned from.
+     * @return Object being assigned.
+     */
+    WeakPtr &operator=(const WeakPtr &source)
+    {
+        if (this != &source) {
+            if (source._control != NULL) {
+                source._control->acquire_weak();
+            }
+            if (_control != NULL) {
+                _control->release_weak();
+            }
+            _ptr = source._ptr;
+            _control = source._control;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Replace the reference with an empty one.
+     */
+    void reset()
+    {
+        if (_control != NULL) {
+            _control->release_weak();
+        }
+        _ptr = NULL;
+        _control = NULL;
+    }
+
+    /**
+     * @brief Reference count accessor.
+     * @return Number of SharedPtr pointing to the object.
+     */
+    uint32_t use_count() const
+    {
+        if (_control != NULL) {
+            return core_util_atomic_load_u32(&_control->use_count);
+        } else {
+            return 0;
+        }
+    }
+
+    /**
+     * @brief Check whether the object has been deleted.
+     * @return true if no SharedPtr points to the object anymore.
+     */
+    bool expired() const
+    {
+        return use_count() == 0;
+    }
+
+    /**
+     * @brief Get a SharedPtr to the object.
+     * @return SharedPtr to the object, or an empty SharedPtr if it has been deleted.
+     */
+    SharedPtr<T> lock() const
+    {
+        if (_control != NULL && _control->acquire_if_alive()) {
+            return SharedPtr<T>(_ptr, _control);
+        }
+        return SharedPtr<T>();
+    }
+
+private:
+    // Pointer to shared object, only valid while not expired
+    T *_ptr;
+
+    // Pointer to shared reference counters
+    detail::shared_ptr_control_block *_control;
 };
 
 /** Non-member relational operators.
@@ -291,6 +582,8 @@ bool operator!= (U lhs, const SharedPtr<T> &rhs)
 
 #ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
 using mbed::SharedPtr;
+using mbed::WeakPtr;
+using mbed::make_shared_ptr;
 #endif
 
 #endif // __SHAREDPTR_H__
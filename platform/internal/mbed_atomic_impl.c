@@ -113,7 +113,46 @@ bool core_util_atomic_flag_test_and_set(volatile core_util_atomic_flag *flagPtr)
 }
 #endif
 
-/* No architecture we support has LDREXD/STREXD, so must always disable IRQs for 64-bit operations */
+#if MBED_EXCLUSIVE_ACCESS_64
+/* LDREXD/STREXD make the 64-bit operations lock-free, the compiler generates the exclusive loops */
+#define DO_MBED_LOCKFREE_64_OP(name, builtin)                                   \
+uint64_t core_util_atomic_##name##_u64(volatile uint64_t *valuePtr, uint64_t arg) \
+{                                                                               \
+    return builtin(valuePtr, arg, __ATOMIC_SEQ_CST);                            \
+}
+
+uint64_t core_util_atomic_load_u64(const volatile uint64_t *valuePtr)
+{
+    return __atomic_load_n(valuePtr, __ATOMIC_SEQ_CST);
+}
+
+void core_util_atomic_store_u64(volatile uint64_t *valuePtr, uint64_t desiredValue)
+{
+    __atomic_store_n(valuePtr, desiredValue, __ATOMIC_SEQ_CST);
+}
+
+// *INDENT-OFF*
+DO_MBED_LOCKFREE_64_OP(exchange,  __atomic_exchange_n)
+DO_MBED_LOCKFREE_64_OP(incr,      __atomic_add_fetch)
+DO_MBED_LOCKFREE_64_OP(decr,      __atomic_sub_fetch)
+DO_MBED_LOCKFREE_64_OP(fetch_add, __atomic_fetch_add)
+DO_MBED_LOCKFREE_64_OP(fetch_sub, __atomic_fetch_sub)
+DO_MBED_LOCKFREE_64_OP(fetch_and, __atomic_fetch_and)
+DO_MBED_LOCKFREE_64_OP(fetch_or,  __atomic_fetch_or)
+DO_MBED_LOCKFREE_64_OP(fetch_xor, __atomic_fetch_xor)
+// *INDENT-ON*
+
+bool core_util_atomic_cas_u64(volatile uint64_t *ptr, uint64_t *expectedCurrentValue, uint64_t desiredValue)
+{
+    return __atomic_compare_exchange_n(ptr, expectedCurrentValue, desiredValue, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+bool core_util_atomic_compare_exchange_weak_u64(volatile uint64_t *ptr, uint64_t *expectedCurrentValue, uint64_t desiredValue)
+{
+    return __atomic_compare_exchange_n(ptr, expectedCurrentValue, desiredValue, true, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+#else
+/* M profile cores have no LDREXD/STREXD, so must disable IRQs for 64-bit operations */
 uint64_t core_util_atomic_load_u64(const volatile uint64_t *valuePtr)
 {
     core_util_critical_section_enter();
@@ -128,9 +167,14 @@ void core_util_atomic_store_u64(volatile uint64_t *valuePtr, uint64_t desiredVal
     *valuePtr = desiredValue;
     core_util_critical_section_exit();
 }
+#endif
 
 /* Now locked operations for whichever we don't have lock-free ones for */
-#if MBED_EXCLUSIVE_ACCESS
+#if MBED_EXCLUSIVE_ACCESS_64
+/* Nothing is locked */
+#define DO_MBED_LOCKED_OPS(name, OP, retValue)
+#define DO_MBED_LOCKED_CAS_OPS()
+#elif MBED_EXCLUSIVE_ACCESS
 /* Just need 64-bit locked operations */
 #define DO_MBED_LOCKED_OPS(name, OP, retValue) \
     DO_MBED_LOCKED_OP(name, OP, retValue, uint64_t, u64)
@@ -61,11 +61,276 @@ typedef struct  {
 #define MALLOC_HEAP_TOTAL_SIZE(p)   (((p)->size) & (~0x1))
 #endif
 
+/******************************************************************************/
+/* Implementation of the allocation site profiler                             */
+/******************************************************************************/
+
+/* When MBED_HEAP_PROFILE_ENABLED is set, every allocation is aggregated by the
+   address it was called from into a small open addressed hash table. This is
+   done under the heap stats lock, so it costs a few table probes per call.
+   Allocations from new call sites are only counted as dropped once the table
+   is full. */
+
+#ifdef MBED_HEAP_PROFILE_ENABLED
+#ifndef MBED_HEAP_STATS_ENABLED
+#error Heap profile requires heap statistics (MBED_HEAP_STATS_ENABLED).
+#endif
+
+#define HEAP_PROFILE_SITES      MBED_CONF_PLATFORM_HEAP_PROFILE_SITES
+
+static mbed_stats_heap_site_t heap_profile_sites[HEAP_PROFILE_SITES];
+static uint32_t heap_profile_site_cnt;
+static uint32_t heap_profile_dropped_cnt;
+
+/* Size of the largest block the toolchain heap can allocate, up to limit */
+static uint32_t heap_profile_largest_free(uint32_t limit);
+
+/* Must be called with malloc_stats_mutex held */
+static void heap_profile_record(void *caller, size_t size)
+{
+    uint32_t index = ((uintptr_t)caller >> 1) % HEAP_PROFILE_SITES;
+    for (uint32_t i = 0; i < HEAP_PROFILE_SITES; i++) {
+        mbed_stats_heap_site_t *site = &heap_profile_sites[index];
+        if (site->caller == caller || site->caller == NULL) {
+            if (site->caller == NULL) {
+                site->caller = caller;
+                heap_profile_site_cnt += 1;
+            }
+            site->alloc_cnt += 1;
+            site->alloc_size += size;
+            return;
+        }
+        index = (index + 1) % HEAP_PROFILE_SITES;
+    }
+    heap_profile_dropped_cnt += 1;
+}
+#endif
+
+/******************************************************************************/
+/* Implementation of the size-class pool front-end                            */
+/******************************************************************************/
+
+/* When MBED_CONF_PLATFORM_HEAP_POOL_ENABLED is set, small requests are served
+   from statically allocated pools of fixed-size blocks before falling back to
+   the toolchain heap. Short lived small allocations then never split heap
+   chunks, which keeps the heap from fragmenting over long uptimes.
+
+   Each size class keeps its free blocks on a lock-free LIFO list. The list
+   head packs the index of the first free block (plus one, zero meaning empty)
+   in the low half and a modification tag in the high half, so a stale head
+   can never be swapped back in (ABA). Blocks that have never been used are
+   handed out from a bump counter, so the pools need no initialization. */
+
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_assert.h"
+
+#define HEAP_POOL_BLOCK_COUNT       MBED_CONF_PLATFORM_HEAP_POOL_BLOCK_COUNT
+#define HEAP_POOL_INDEX_MASK        (0xFFFFUL)
+#define HEAP_POOL_TAG_INCREMENT     (0x10000UL)
+
+MBED_STATIC_ASSERT(HEAP_POOL_BLOCK_COUNT > 0 && HEAP_POOL_BLOCK_COUNT < HEAP_POOL_INDEX_MASK,
+                   "MBED_CONF_PLATFORM_HEAP_POOL_BLOCK_COUNT must be between 1 and 65534");
+
+typedef struct {
+    uint8_t *storage;
+    uint32_t block_size;
+    volatile uint32_t head;
+    volatile uint32_t unused;
+#ifdef MBED_HEAP_STATS_ENABLED
+    uint16_t *user_size;
+#endif
+} heap_pool_t;
+
+#define HEAP_POOL_STORAGE(size) \
+    MBED_ALIGN(8) static uint8_t heap_pool_storage_##size[HEAP_POOL_BLOCK_COUNT * size]
+
+HEAP_POOL_STORAGE(32);
+HEAP_POOL_STORAGE(64);
+HEAP_POOL_STORAGE(128);
+HEAP_POOL_STORAGE(256);
+
+#ifdef MBED_HEAP_STATS_ENABLED
+static uint16_t heap_pool_user_size[4][HEAP_POOL_BLOCK_COUNT];
+#define HEAP_POOL_CLASS(size, n)    { heap_pool_storage_##size, size, 0, 0, heap_pool_user_size[n] }
+#else
+#define HEAP_POOL_CLASS(size, n)    { heap_pool_storage_##size, size, 0, 0 }
+#endif
+
+static heap_pool_t heap_pools[] = {
+    HEAP_POOL_CLASS(32, 0),
+    HEAP_POOL_CLASS(64, 1),
+    HEAP_POOL_CLASS(128, 2),
+    HEAP_POOL_CLASS(256, 3),
+};
+
+#define HEAP_POOL_CLASSES           (sizeof(heap_pools) / sizeof(heap_pools[0]))
+#define HEAP_POOL_MAX_SIZE          (256)
+#define HEAP_POOL_RESERVED_SIZE     (HEAP_POOL_BLOCK_COUNT * (32 + 64 + 128 + 256))
+
+static heap_pool_t *heap_pool_find(const void *ptr)
+{
+    for (uint32_t i = 0; i < HEAP_POOL_CLASSES; i++) {
+        heap_pool_t *pool = &heap_pools[i];
+        const uint8_t *p = (const uint8_t *)ptr;
+        if (p >= pool->storage && p < pool->storage + HEAP_POOL_BLOCK_COUNT * pool->block_size) {
+            return pool;
+        }
+    }
+    return NULL;
+}
+
+static uint32_t heap_pool_pop(heap_pool_t *pool)
+{
+    uint32_t head = core_util_atomic_load_u32(&pool->head);
+    uint32_t index;
+    do {
+        index = head & HEAP_POOL_INDEX_MASK;
+        if (index == 0) {
+            break;
+        }
+        // The link may be stale if another thread popped the block meanwhile,
+        // in which case the tag has changed and the exchange below fails
+        uint32_t next = *(volatile uint32_t *)(pool->storage + (index - 1) * pool->block_size);
+        uint32_t new_head = ((head + HEAP_POOL_TAG_INCREMENT) & ~HEAP_POOL_INDEX_MASK) | next;
+        if (core_util_atomic_cas_u32(&pool->head, &head, new_head)) {
+            return index;
+        }
+    } while (true);
+
+    // Free list is empty, take a block that has never been used
+    uint32_t unused = core_util_atomic_load_u32(&pool->unused);
+    while (unused < HEAP_POOL_BLOCK_COUNT) {
+        if (core_util_atomic_cas_u32(&pool->unused, &unused, unused + 1)) {
+            return unused + 1;
+        }
+    }
+    return 0;
+}
+
+static void heap_pool_push(heap_pool_t *pool, uint32_t index)
+{
+    volatile uint32_t *link = (volatile uint32_t *)(pool->storage + (index - 1) * pool->block_size);
+    uint32_t head = core_util_atomic_load_u32(&pool->head);
+    do {
+        *link = head & HEAP_POOL_INDEX_MASK;
+    } while (!core_util_atomic_cas_u32(&pool->head, &head,
+                                       ((head + HEAP_POOL_TAG_INCREMENT) & ~HEAP_POOL_INDEX_MASK) | index));
+}
+
+/* Return a block of at least size bytes, or NULL if size is too large for
+   the pools or the matching pool is exhausted */
+static void *heap_pool_alloc(size_t size, void *caller)
+{
+    if (size > HEAP_POOL_MAX_SIZE) {
+        return NULL;
+    }
+
+    heap_pool_t *pool = heap_pools;
+    while (pool->block_size < size) {
+        pool++;
+    }
+
+    uint32_t index = heap_pool_pop(pool);
+    if (index == 0) {
+        return NULL;
+    }
+
+#ifdef MBED_HEAP_STATS_ENABLED
+    malloc_stats_mutex->lock();
+    pool->user_size[index - 1] = size;
+    heap_stats.current_size += size;
+    heap_stats.total_size += size;
+    heap_stats.alloc_cnt += 1;
+    if (heap_stats.current_size > heap_stats.max_size) {
+        heap_stats.max_size = heap_stats.current_size;
+    }
+    heap_stats.overhead_size += pool->block_size - size;
+#ifdef MBED_HEAP_PROFILE_ENABLED
+    heap_profile_record(caller, size);
+#endif
+    malloc_stats_mutex->unlock();
+#else
+    (void)caller;
+#endif
+    return pool->storage + (index - 1) * pool->block_size;
+}
+
+/* Release ptr if it is a pool block, return false otherwise */
+static bool heap_pool_free(void *ptr)
+{
+    heap_pool_t *pool = heap_pool_find(ptr);
+    if (pool == NULL) {
+        return false;
+    }
+
+    uint32_t offset = (uint8_t *)ptr - pool->storage;
+    MBED_ASSERT(offset % pool->block_size == 0);
+    uint32_t index = offset / pool->block_size + 1;
+
+#ifdef MBED_HEAP_STATS_ENABLED
+    malloc_stats_mutex->lock();
+    size_t user_size = pool->user_size[index - 1];
+    heap_stats.current_size -= user_size;
+    heap_stats.alloc_cnt -= 1;
+    heap_stats.overhead_size -= pool->block_size - user_size;
+    malloc_stats_mutex->unlock();
+#endif
+    heap_pool_push(pool, index);
+    return true;
+}
+
+/* Resize ptr if it is a pool block, return false otherwise. The block is kept
+   if the new size still fits, otherwise the data moves to a new allocation */
+static bool heap_pool_realloc(void *ptr, size_t size, void **new_ptr)
+{
+    heap_pool_t *pool = heap_pool_find(ptr);
+    if (pool == NULL) {
+        return false;
+    }
+
+#ifdef MBED_HEAP_STATS_ENABLED
+    uint32_t index = ((uint8_t *)ptr - pool->storage) / pool->block_size;
+    size_t old_size = pool->user_size[index];
+#else
+    size_t old_size = pool->block_size;
+#endif
+
+    if (size == 0) {
+        heap_pool_free(ptr);
+        *new_ptr = NULL;
+    } else if (size <= pool->block_size) {
+#ifdef MBED_HEAP_STATS_ENABLED
+        malloc_stats_mutex->lock();
+        pool->user_size[index] = size;
+        heap_stats.current_size = heap_stats.current_size - old_size + size;
+        heap_stats.total_size += size;
+        heap_stats.overhead_size = heap_stats.overhead_size + old_size - size;
+        if (heap_stats.current_size > heap_stats.max_size) {
+            heap_stats.max_size = heap_stats.current_size;
+        }
+        malloc_stats_mutex->unlock();
+#endif
+        *new_ptr = ptr;
+    } else {
+        *new_ptr = malloc(size);
+        if (*new_ptr != NULL) {
+            memcpy(*new_ptr, ptr, old_size);
+            heap_pool_free(ptr);
+        }
+    }
+    return true;
+}
+#endif // #if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+
 void mbed_stats_heap_get(mbed_stats_heap_t *stats)
 {
 #ifdef MBED_HEAP_STATS_ENABLED
     extern uint32_t mbed_heap_size;
     heap_stats.reserved_size = mbed_heap_size;
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+    heap_stats.reserved_size += HEAP_POOL_RESERVED_SIZE;
+#endif
 
     malloc_stats_mutex->lock();
     memcpy(stats, &heap_stats, sizeof(mbed_stats_heap_t));
@@ -75,6 +340,35 @@ void mbed_stats_heap_get(mbed_stats_heap_t *stats)
 #endif
 }
 
+size_t mbed_stats_heap_profile_get(mbed_stats_heap_profile_t *profile, mbed_stats_heap_site_t *sites, size_t count)
+{
+    memset(profile, 0, sizeof(mbed_stats_heap_profile_t));
+#ifdef MBED_HEAP_PROFILE_ENABLED
+    mbed_stats_heap_t stats;
+    size_t filled = 0;
+
+    mbed_stats_heap_get(&stats);
+    profile->free_size = stats.reserved_size - stats.current_size - stats.overhead_size;
+    profile->largest_free_size = heap_profile_largest_free(profile->free_size);
+    if (profile->free_size > 0) {
+        profile->fragmentation = 100 - (uint32_t)((uint64_t)profile->largest_free_size * 100 / profile->free_size);
+    }
+
+    malloc_stats_mutex->lock();
+    profile->site_cnt = heap_profile_site_cnt;
+    profile->dropped_cnt = heap_profile_dropped_cnt;
+    for (uint32_t i = 0; i < HEAP_PROFILE_SITES && filled < count; i++) {
+        if (heap_profile_sites[i].caller != NULL) {
+            sites[filled++] = heap_profile_sites[i];
+        }
+    }
+    malloc_stats_mutex->unlock();
+    return filled;
+#else
+    return 0;
+#endif
+}
+
 /******************************************************************************/
 /* GCC memory allocation wrappers                                             */
 /******************************************************************************/
@@ -91,6 +385,27 @@ extern "C" {
     void free_wrapper(struct _reent *r, void *ptr, void *caller);
 }
 
+#ifdef MBED_HEAP_PROFILE_ENABLED
+static uint32_t heap_profile_largest_free(uint32_t limit)
+{
+    // Binary search for the largest allocation that succeeds. The underlying
+    // allocator is called directly so probes do not show up in the stats.
+    uint32_t low = 0;
+    uint32_t high = limit;
+    while (low < high) {
+        uint32_t mid = low + (high - low + 1) / 2;
+        void *ptr = __real__malloc_r(_REENT, mid);
+        if (ptr != NULL) {
+            __real__free_r(_REENT, ptr);
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
+#endif
+
 
 extern "C" void *__wrap__malloc_r(struct _reent *r, size_t size)
 {
@@ -103,6 +418,16 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+    ptr = heap_pool_alloc(size, caller);
+    if (ptr != NULL) {
+#ifdef MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_malloc(ptr, size, caller);
+        mbed_mem_trace_unlock();
+#endif
+        return ptr;
+    }
+#endif
 #ifdef MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = (alloc_info_t *)__real__malloc_r(r, size + sizeof(alloc_info_t));
@@ -117,6 +442,9 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
             heap_stats.max_size = heap_stats.current_size;
         }
         heap_stats.overhead_size += MALLOC_HEAP_TOTAL_SIZE(MALLOC_HEADER_PTR(alloc_info)) - size;
+#ifdef MBED_HEAP_PROFILE_ENABLED
+        heap_profile_record(caller, size);
+#endif
     } else {
         heap_stats.alloc_fail_cnt += 1;
     }
@@ -137,6 +465,15 @@ extern "C" void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+    if (heap_pool_realloc(ptr, size, &new_ptr)) {
+#ifdef MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_realloc(new_ptr, ptr, size, MBED_CALLER_ADDR());
+        mbed_mem_trace_unlock();
+#endif
+        return new_ptr;
+    }
+#endif
 #ifdef MBED_HEAP_STATS_ENABLED
     // Implement realloc_r with malloc and free.
     // The function realloc_r can't be used here directly since
@@ -154,7 +491,7 @@ extern "C" void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size)
 
     // Allocate space
     if (size != 0) {
-        new_ptr = malloc(size);
+        new_ptr = malloc_wrapper(r, size, MBED_CALLER_ADDR());
     }
 
     // If the new buffer has been allocated copy the data to it
@@ -184,6 +521,15 @@ extern "C" void free_wrapper(struct _reent *r, void *ptr, void *caller)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+    if (heap_pool_free(ptr)) {
+#ifdef MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_free(ptr, caller);
+        mbed_mem_trace_unlock();
+#endif
+        return;
+    }
+#endif
 #ifdef MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = NULL;
@@ -218,10 +564,23 @@ extern "C" void *__wrap__calloc_r(struct _reent *r, size_t nmemb, size_t size)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+    if (size == 0 || nmemb <= HEAP_POOL_MAX_SIZE / size) {
+        ptr = heap_pool_alloc(nmemb * size, MBED_CALLER_ADDR());
+        if (ptr != NULL) {
+            memset(ptr, 0, nmemb * size);
+#ifdef MBED_MEM_TRACING_ENABLED
+            mbed_mem_trace_calloc(ptr, nmemb, size, MBED_CALLER_ADDR());
+            mbed_mem_trace_unlock();
+#endif
+            return ptr;
+        }
+    }
+#endif
 #ifdef MBED_HEAP_STATS_ENABLED
     // Note - no lock needed since malloc is thread safe
 
-    ptr = malloc(nmemb * size);
+    ptr = malloc_wrapper(r, nmemb * size, MBED_CALLER_ADDR());
     if (ptr != NULL) {
         memset(ptr, 0, nmemb * size);
     }
@@ -267,8 +626,8 @@ extern "C" void *__wrap__memalign_r(struct _reent *r, size_t alignment, size_t b
 #define SUB_FREE        $Sub$$__iar_dlfree
 #endif
 
-/* Enable hooking of memory function only if tracing is also enabled */
-#if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED)
+/* Enable hooking of memory function only if tracing, stats or pools are also enabled */
+#if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED) || MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
 
 extern "C" {
     void *SUPER_MALLOC(size_t size);
@@ -279,6 +638,27 @@ extern "C" {
     void free_wrapper(void *ptr, void *caller);
 }
 
+#ifdef MBED_HEAP_PROFILE_ENABLED
+static uint32_t heap_profile_largest_free(uint32_t limit)
+{
+    // Binary search for the largest allocation that succeeds. The underlying
+    // allocator is called directly so probes do not show up in the stats.
+    uint32_t low = 0;
+    uint32_t high = limit;
+    while (low < high) {
+        uint32_t mid = low + (high - low + 1) / 2;
+        void *ptr = SUPER_MALLOC(mid);
+        if (ptr != NULL) {
+            SUPER_FREE(ptr);
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
+#endif
+
 extern "C" void *SUB_MALLOC(size_t size)
 {
     return malloc_wrapper(size, MBED_CALLER_ADDR());
@@ -290,6 +670,16 @@ extern "C" void *malloc_wrapper(size_t size, void *caller)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+    ptr = heap_pool_alloc(size, caller);
+    if (ptr != NULL) {
+#ifdef MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_malloc(ptr, size, caller);
+        mbed_mem_trace_unlock();
+#endif
+        return ptr;
+    }
+#endif
 #ifdef MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = (alloc_info_t *)SUPER_MALLOC(size + sizeof(alloc_info_t));
@@ -304,6 +694,9 @@ extern "C" void *malloc_wrapper(size_t size, void *caller)
             heap_stats.max_size = heap_stats.current_size;
         }
         heap_stats.overhead_size += MALLOC_HEAP_TOTAL_SIZE(MALLOC_HEADER_PTR(alloc_info)) - size;
+#ifdef MBED_HEAP_PROFILE_ENABLED
+        heap_profile_record(caller, size);
+#endif
     } else {
         heap_stats.alloc_fail_cnt += 1;
     }
@@ -325,6 +718,15 @@ extern "C" void *SUB_REALLOC(void *ptr, size_t size)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+    if (heap_pool_realloc(ptr, size, &new_ptr)) {
+#ifdef MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_realloc(new_ptr, ptr, size, MBED_CALLER_ADDR());
+        mbed_mem_trace_unlock();
+#endif
+        return new_ptr;
+    }
+#endif
 #ifdef MBED_HEAP_STATS_ENABLED
     // Note - no lock needed since malloc and free are thread safe
 
@@ -337,7 +739,7 @@ extern "C" void *SUB_REALLOC(void *ptr, size_t size)
 
     // Allocate space
     if (size != 0) {
-        new_ptr = malloc(size);
+        new_ptr = malloc_wrapper(size, MBED_CALLER_ADDR());
     }
 
     // If the new buffer has been allocated copy the data to it
@@ -363,9 +765,22 @@ extern "C" void *SUB_CALLOC(size_t nmemb, size_t size)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+    if (size == 0 || nmemb <= HEAP_POOL_MAX_SIZE / size) {
+        ptr = heap_pool_alloc(nmemb * size, MBED_CALLER_ADDR());
+        if (ptr != NULL) {
+            memset(ptr, 0, nmemb * size);
+#ifdef MBED_MEM_TRACING_ENABLED
+            mbed_mem_trace_calloc(ptr, nmemb, size, MBED_CALLER_ADDR());
+            mbed_mem_trace_unlock();
+#endif
+            return ptr;
+        }
+    }
+#endif
 #ifdef MBED_HEAP_STATS_ENABLED
     // Note - no lock needed since malloc is thread safe
-    ptr = malloc(nmemb * size);
+    ptr = malloc_wrapper(nmemb * size, MBED_CALLER_ADDR());
     if (ptr != NULL) {
         memset(ptr, 0, nmemb * size);
     }
@@ -389,6 +804,15 @@ extern "C" void free_wrapper(void *ptr, void *caller)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+    if (heap_pool_free(ptr)) {
+#ifdef MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_free(ptr, caller);
+        mbed_mem_trace_unlock();
+#endif
+        return;
+    }
+#endif
 #ifdef MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = NULL;
@@ -417,7 +841,7 @@ extern "C" void free_wrapper(void *ptr, void *caller)
 #endif // #ifdef MBED_MEM_TRACING_ENABLED
 }
 
-#endif // #if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED)
+#endif // #if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED) || MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
 
 /******************************************************************************/
 /* Allocation wrappers for other toolchains are not supported yet             */
@@ -433,4 +857,8 @@ extern "C" void free_wrapper(void *ptr, void *caller)
 #error Heap statistics are not supported with the current toolchain.
 #endif
 
+#if MBED_CONF_PLATFORM_HEAP_POOL_ENABLED
+#error Heap pools are not supported with the current toolchain.
+#endif
+
 #endif // #if defined(TOOLCHAIN_GCC)
@@ -106,6 +106,15 @@ typedef enum mbed_memory_order {
 #define MBED_INLINE_IF_EX
 #endif
 
+// LDREXD/STREXD are only in the A profile, M profile cores disable interrupts for 64-bit operations
+#ifndef MBED_EXCLUSIVE_ACCESS_64
+#if MBED_EXCLUSIVE_ACCESS && (__ARM_ARCH_7A__ == 1U) && defined(__GNUC__)
+#define MBED_EXCLUSIVE_ACCESS_64   1U
+#else
+#define MBED_EXCLUSIVE_ACCESS_64   0U
+#endif
+#endif
+
 /**
  * A lock-free, primitive atomic flag.
  *
@@ -877,6 +886,56 @@ uint64_t core_util_atomic_fetch_xor_u64(volatile uint64_t *valuePtr, uint64_t ar
 /** \copydoc core_util_atomic_fetch_xor_explicit_u8 */
 MBED_FORCEINLINE uint64_t core_util_atomic_fetch_xor_explicit_u64(volatile uint64_t *valuePtr, uint64_t arg, mbed_memory_order order);
 
+/** Thread flag threads wait on in ::core_util_atomic_wait_u32 */
+#define MBED_ATOMIC_WAIT_FLAG   0x40000000U
+
+/**
+ * Block until a value differs from an expected one, or a timeout expires.
+ *
+ * The calling thread sleeps until ::core_util_atomic_notify_one or
+ * ::core_util_atomic_notify_all is called with the same address, so whoever
+ * changes the value must notify. The value is checked before sleeping in a
+ * way that cannot miss a change made and notified meanwhile.
+ *
+ * With the RTOS running, the thread waits on thread flag
+ * MBED_ATOMIC_WAIT_FLAG, which must not be used otherwise. Without it, the
+ * core sleeps until an interrupt changes the value, or polls if a timeout
+ * is given.
+ *
+ * @note Can return early with the value unchanged, e.g. after a notification
+ * for another value that changed back. Callers should check the value again.
+ *
+ * @note You cannot call this function from ISR context.
+ *
+ * @param  valuePtr      Target memory location.
+ * @param  expectedValue Value to wait for a change from.
+ * @param  millisec      Timeout in milliseconds, 0xFFFFFFFF to wait forever.
+ * @return               true if the value differs or a notification was received,
+ *                       false on timeout.
+ */
+bool core_util_atomic_wait_u32(const volatile uint32_t *valuePtr, uint32_t expectedValue, uint32_t millisec);
+
+/** \copydoc core_util_atomic_wait_u32 */
+bool core_util_atomic_wait_u64(const volatile uint64_t *valuePtr, uint64_t expectedValue, uint32_t millisec);
+
+/**
+ * Wake one thread waiting on a memory location.
+ *
+ * @note You may call this function from ISR context.
+ *
+ * @param  valuePtr      Memory location given to ::core_util_atomic_wait_u32.
+ */
+void core_util_atomic_notify_one(const volatile void *valuePtr);
+
+/**
+ * Wake all threads waiting on a memory location.
+ *
+ * @note You may call this function from ISR context.
+ *
+ * @param  valuePtr      Memory location given to ::core_util_atomic_wait_u32.
+ */
+void core_util_atomic_notify_all(const volatile void *valuePtr);
+
 #ifdef __cplusplus
 } // extern "C"
 
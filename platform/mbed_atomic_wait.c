@@ -0,0 +1,183 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
+#include "hal/us_ticker_api.h"
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "cmsis_os2.h"
+#endif
+
+// Waiting threads are listed by the hash of the address they wait on
+#define ATOMIC_WAIT_BUCKETS     8
+
+#define ATOMIC_WAIT_FOREVER     0xFFFFFFFFU
+
+#define ATOMIC_WAIT_BUCKET(ptr) ((((uintptr_t)(ptr)) >> 3) % ATOMIC_WAIT_BUCKETS)
+
+static bool atomic_unchanged(const volatile void *valuePtr, size_t size, uint64_t expectedValue)
+{
+    if (size == sizeof(uint64_t)) {
+        return core_util_atomic_load_u64((const volatile uint64_t *)valuePtr) == expectedValue;
+    }
+    return core_util_atomic_load_u32((const volatile uint32_t *)valuePtr) == (uint32_t)expectedValue;
+}
+
+#ifdef MBED_CONF_RTOS_PRESENT
+typedef struct atomic_waiter {
+    const volatile void *ptr;
+    osThreadId_t thread;
+    struct atomic_waiter *next;
+} atomic_waiter_t;
+
+static atomic_waiter_t *atomic_waiters[ATOMIC_WAIT_BUCKETS];
+
+static bool atomic_wait_remove(atomic_waiter_t *waiter)
+{
+    atomic_waiter_t **link = &atomic_waiters[ATOMIC_WAIT_BUCKET(waiter->ptr)];
+
+    while (*link) {
+        if (*link == waiter) {
+            *link = waiter->next;
+            return true;
+        }
+        link = &(*link)->next;
+    }
+    return false;
+}
+#endif
+
+// Without the RTOS only interrupts can change the value
+static bool atomic_wait_polled(const volatile void *valuePtr, size_t size, uint64_t expectedValue, uint32_t millisec)
+{
+    if (millisec == ATOMIC_WAIT_FOREVER) {
+        while (true) {
+            // Checked with interrupts masked, so the interrupt changing it wakes the sleep
+            core_util_critical_section_enter();
+            if (!atomic_unchanged(valuePtr, size, expectedValue)) {
+                core_util_critical_section_exit();
+                return true;
+            }
+            sleep();
+            core_util_critical_section_exit();
+        }
+    }
+
+#if DEVICE_USTICKER
+    us_timestamp_t start = ticker_read_us(get_us_ticker_data());
+    while (ticker_read_us(get_us_ticker_data()) - start < (us_timestamp_t)millisec * 1000) {
+        if (!atomic_unchanged(valuePtr, size, expectedValue)) {
+            return true;
+        }
+    }
+#endif
+    return !atomic_unchanged(valuePtr, size, expectedValue);
+}
+
+static bool atomic_wait(const volatile void *valuePtr, size_t size, uint64_t expectedValue, uint32_t millisec)
+{
+#ifdef MBED_CONF_RTOS_PRESENT
+    if (osKernelGetState() != osKernelRunning) {
+        return atomic_wait_polled(valuePtr, size, expectedValue, millisec);
+    }
+
+    atomic_waiter_t waiter;
+    waiter.ptr = valuePtr;
+    waiter.thread = osThreadGetId();
+
+    // Listed before the value is checked, a change notified after the check sets the flag
+    core_util_critical_section_enter();
+    if (!atomic_unchanged(valuePtr, size, expectedValue)) {
+        core_util_critical_section_exit();
+        return true;
+    }
+    if (!millisec) {
+        core_util_critical_section_exit();
+        return false;
+    }
+    waiter.next = atomic_waiters[ATOMIC_WAIT_BUCKET(valuePtr)];
+    atomic_waiters[ATOMIC_WAIT_BUCKET(valuePtr)] = &waiter;
+    core_util_critical_section_exit();
+
+    uint32_t flags = osThreadFlagsWait(MBED_ATOMIC_WAIT_FLAG, osFlagsWaitAny, millisec);
+
+    core_util_critical_section_enter();
+    bool listed = atomic_wait_remove(&waiter);
+    core_util_critical_section_exit();
+
+    if (listed) {
+        // Not notified
+        return !atomic_unchanged(valuePtr, size, expectedValue);
+    }
+    if (flags & osFlagsError) {
+        // Notified as the wait timed out, don't leave the flag for the next wait
+        osThreadFlagsClear(MBED_ATOMIC_WAIT_FLAG);
+    }
+    return true;
+#else
+    return atomic_wait_polled(valuePtr, size, expectedValue, millisec);
+#endif
+}
+
+bool core_util_atomic_wait_u32(const volatile uint32_t *valuePtr, uint32_t expectedValue, uint32_t millisec)
+{
+    return atomic_wait(valuePtr, sizeof(uint32_t), expectedValue, millisec);
+}
+
+bool core_util_atomic_wait_u64(const volatile uint64_t *valuePtr, uint64_t expectedValue, uint32_t millisec)
+{
+    return atomic_wait(valuePtr, sizeof(uint64_t), expectedValue, millisec);
+}
+
+static void atomic_notify(const volatile void *valuePtr, bool all)
+{
+#ifdef MBED_CONF_RTOS_PRESENT
+    core_util_critical_section_enter();
+
+    atomic_waiter_t **link = &atomic_waiters[ATOMIC_WAIT_BUCKET(valuePtr)];
+    while (*link) {
+        atomic_waiter_t *waiter = *link;
+        if (waiter->ptr != valuePtr) {
+            link = &waiter->next;
+            continue;
+        }
+        // Unlisted here, so the waiter knows it was notified
+        *link = waiter->next;
+        osThreadFlagsSet(waiter->thread, MBED_ATOMIC_WAIT_FLAG);
+        if (!all) {
+            break;
+        }
+    }
+
+    core_util_critical_section_exit();
+#else
+    // Sleeping waiters are woken by the interrupt that changed the value
+    (void)valuePtr;
+    (void)all;
+#endif
+}
+
+void core_util_atomic_notify_one(const volatile void *valuePtr)
+{
+    atomic_notify(valuePtr, false);
+}
+
+void core_util_atomic_notify_all(const volatile void *valuePtr)
+{
+    atomic_notify(valuePtr, true);
+}
@@ -0,0 +1,75 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_boot_timeline.h"
+#include "platform/mbed_critical.h"
+#include "hal/us_ticker_api.h"
+
+#if defined(MBED_BOOT_TIMELINE_ENABLED) && DEVICE_USTICKER
+
+static us_timestamp_t boot_timeline[MBED_BOOT_STAGE_COUNT];
+static uint32_t boot_timeline_recorded;
+
+void mbed_boot_timeline_record(mbed_boot_stage_t stage)
+{
+    if ((unsigned)stage >= MBED_BOOT_STAGE_COUNT) {
+        return;
+    }
+
+    // Also starts the us ticker if this is the first use, records before the RTOS is up are fine
+    us_timestamp_t now = ticker_read_us(get_us_ticker_data());
+
+    core_util_critical_section_enter();
+    if (!(boot_timeline_recorded & (1UL << stage))) {
+        boot_timeline[stage] = now;
+        boot_timeline_recorded |= 1UL << stage;
+    }
+    core_util_critical_section_exit();
+}
+
+bool mbed_boot_timeline_get(mbed_boot_stage_t stage, uint64_t *timestamp_us)
+{
+    bool recorded = false;
+
+    if ((unsigned)stage >= MBED_BOOT_STAGE_COUNT) {
+        return false;
+    }
+
+    core_util_critical_section_enter();
+    if (boot_timeline_recorded & (1UL << stage)) {
+        *timestamp_us = boot_timeline[stage];
+        recorded = true;
+    }
+    core_util_critical_section_exit();
+    return recorded;
+}
+
+#else
+
+void mbed_boot_timeline_record(mbed_boot_stage_t stage)
+{
+    (void)stage;
+}
+
+bool mbed_boot_timeline_get(mbed_boot_stage_t stage, uint64_t *timestamp_us)
+{
+    (void)stage;
+    (void)timestamp_us;
+    return false;
+}
+
+#endif
@@ -0,0 +1,88 @@
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_boot_timeline boot timeline functions
+ * @{
+ */
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BOOT_TIMELINE_H
+#define MBED_BOOT_TIMELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Boot stages recorded by the boot timeline
+ *
+ * Stages are recorded by the boot sequence, except MBED_BOOT_STAGE_APP_READY which
+ * the application records once it is ready, e.g. when it took its first sample.
+ */
+typedef enum {
+    MBED_BOOT_STAGE_SDK_INIT,           /**< mbed_sdk_init returned, the us ticker starts here */
+    MBED_BOOT_STAGE_RTOS_INIT,          /**< RTOS kernel initialized, scheduler not started yet */
+    MBED_BOOT_STAGE_RTOS_START,         /**< Scheduler started, main thread running */
+    MBED_BOOT_STAGE_CXX_INIT,           /**< C++ static constructors ran */
+    MBED_BOOT_STAGE_MAIN,               /**< mbed_main returned, main about to be called */
+    MBED_BOOT_STAGE_KVSTORE_INIT_START, /**< KVStore storage configuration started */
+    MBED_BOOT_STAGE_KVSTORE_INIT_DONE,  /**< KVStore storage configuration done */
+    MBED_BOOT_STAGE_APP_READY,          /**< Recorded by the application */
+    MBED_BOOT_STAGE_COUNT
+} mbed_boot_stage_t;
+
+/**
+ * Record the time a boot stage was reached
+ *
+ * Only the first time a stage is reached is kept. Does nothing unless
+ * platform.boot-timeline-enabled is set.
+ *
+ * @param stage     Boot stage
+ */
+void mbed_boot_timeline_record(mbed_boot_stage_t stage);
+
+/**
+ * Get the time a boot stage was reached
+ *
+ * Times are us ticker microseconds, so they count from MBED_BOOT_STAGE_SDK_INIT
+ * unless the ticker was started earlier by the target.
+ *
+ * @param stage         Boot stage
+ * @param timestamp_us  Returned time of the stage
+ * @return              true if the stage was recorded
+ */
+bool mbed_boot_timeline_get(mbed_boot_stage_t stage, uint64_t *timestamp_us);
+
+#if defined(MBED_BOOT_TIMELINE_ENABLED)
+#define MBED_BOOT_TIMELINE_RECORD(stage)    mbed_boot_timeline_record(stage)
+#else
+#define MBED_BOOT_TIMELINE_RECORD(stage)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_BOOT_TIMELINE_H
+
+/** @}*/
+
+/** @}*/
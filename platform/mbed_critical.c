@@ -23,9 +23,96 @@
 #include "platform/mbed_assert.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_toolchain.h"
+#include "platform/mbed_stats.h"
+#include <string.h>
 
 static uint32_t critical_section_reentrancy_counter = 0;
 
+/* When MBED_CRITICAL_STATS_ENABLED is set, the outermost critical section is
+   timed with the DWT cycle counter, from entry to just before interrupts are
+   enabled again. The bookkeeping runs with interrupts still disabled, so it
+   needs no locking but adds a few tens of cycles to every section it
+   measures. The longest sections are kept one per caller, and the site table
+   is only scanned for a section longer than the shortest one it holds.
+ */
+#if defined(MBED_CRITICAL_STATS_ENABLED) && defined(DWT_CTRL_CYCCNTENA_Msk)
+#define CRITICAL_STATS 1
+
+#ifndef MBED_CONF_PLATFORM_CRITICAL_STATS_SITES
+#define MBED_CONF_PLATFORM_CRITICAL_STATS_SITES 8
+#endif
+
+#define CRITICAL_STATS_SITES        MBED_CONF_PLATFORM_CRITICAL_STATS_SITES
+#define CRITICAL_STATS_BUCKET_SHIFT 6
+
+static mbed_stats_critical_t critical_stats;
+static mbed_stats_critical_site_t critical_sites[CRITICAL_STATS_SITES];
+static uint32_t critical_sites_min_cycles;
+static uint32_t critical_start_cycles;
+static void *critical_start_caller;
+
+static void critical_stats_start(void *caller)
+{
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    critical_start_caller = caller;
+    critical_start_cycles = DWT->CYCCNT;
+}
+
+static void critical_stats_record_site(void *caller, uint32_t cycles)
+{
+    mbed_stats_critical_site_t *shortest = &critical_sites[0];
+    for (int i = 0; i < CRITICAL_STATS_SITES; i++) {
+        mbed_stats_critical_site_t *site = &critical_sites[i];
+        if (site->caller == caller) {
+            shortest = site;
+            break;
+        }
+        if (site->max_cycles < shortest->max_cycles) {
+            shortest = site;
+        }
+    }
+    if (shortest->caller != caller) {
+        shortest->caller = caller;
+        shortest->max_cycles = 0;
+    }
+    if (cycles > shortest->max_cycles) {
+        shortest->max_cycles = cycles;
+    }
+
+    critical_sites_min_cycles = critical_sites[0].max_cycles;
+    for (int i = 1; i < CRITICAL_STATS_SITES; i++) {
+        if (critical_sites[i].max_cycles < critical_sites_min_cycles) {
+            critical_sites_min_cycles = critical_sites[i].max_cycles;
+        }
+    }
+}
+
+static void critical_stats_stop(void)
+{
+    uint32_t cycles = DWT->CYCCNT - critical_start_cycles;
+
+    critical_stats.count++;
+    if (cycles > critical_stats.max_cycles) {
+        critical_stats.max_cycles = cycles;
+        critical_stats.max_caller = critical_start_caller;
+    }
+
+    uint32_t bucket = 0;
+    for (uint32_t c = cycles >> CRITICAL_STATS_BUCKET_SHIFT; c && bucket < MBED_STATS_CRITICAL_BUCKETS - 1; c >>= 1) {
+        bucket++;
+    }
+    critical_stats.histogram[bucket]++;
+
+    if (cycles > critical_sites_min_cycles) {
+        critical_stats_record_site(critical_start_caller, cycles);
+    }
+}
+#endif
+
 bool core_util_are_interrupts_enabled(void)
 {
 #if defined(__CORTEX_A9)
@@ -63,6 +150,12 @@ void core_util_critical_section_enter(void)
     // If the reentrancy counter overflows something has gone badly wrong.
     MBED_ASSERT(critical_section_reentrancy_counter < UINT32_MAX);
 
+#if CRITICAL_STATS
+    if (critical_section_reentrancy_counter == 0) {
+        critical_stats_start(MBED_CALLER_ADDR());
+    }
+#endif
+
     ++critical_section_reentrancy_counter;
 }
 
@@ -77,6 +170,50 @@ void core_util_critical_section_exit(void)
     --critical_section_reentrancy_counter;
 
     if (critical_section_reentrancy_counter == 0) {
+#if CRITICAL_STATS
+        critical_stats_stop();
+#endif
         hal_critical_section_exit();
     }
 }
+
+size_t mbed_stats_critical_get(mbed_stats_critical_t *stats, mbed_stats_critical_site_t *sites, size_t count)
+{
+    memset(stats, 0, sizeof(mbed_stats_critical_t));
+    size_t filled = 0;
+#if CRITICAL_STATS
+    mbed_stats_critical_site_t copy[CRITICAL_STATS_SITES];
+
+    core_util_critical_section_enter();
+    *stats = critical_stats;
+    memcpy(copy, critical_sites, sizeof(copy));
+    core_util_critical_section_exit();
+
+    // Longest first, skipping unused entries
+    while (sites != NULL && filled < count) {
+        mbed_stats_critical_site_t *longest = NULL;
+        for (int i = 0; i < CRITICAL_STATS_SITES; i++) {
+            if (copy[i].caller != NULL && (longest == NULL || copy[i].max_cycles > longest->max_cycles)) {
+                longest = &copy[i];
+            }
+        }
+        if (longest == NULL) {
+            break;
+        }
+        sites[filled++] = *longest;
+        longest->caller = NULL;
+    }
+#endif
+    return filled;
+}
+
+void mbed_stats_critical_reset(void)
+{
+#if CRITICAL_STATS
+    core_util_critical_section_enter();
+    memset(&critical_stats, 0, sizeof(critical_stats));
+    memset(critical_sites, 0, sizeof(critical_sites));
+    critical_sites_min_cycles = 0;
+    core_util_critical_section_exit();
+#endif
+}
@@ -24,6 +24,7 @@
 #include "platform/mbed_critical.h"
 #include "platform/mbed_error.h"
 #include "platform/mbed_error_hist.h"
+#include "platform/mbed_error_log.h"
 #include "platform/mbed_interface.h"
 #include "platform/mbed_power_mgmt.h"
 #include "platform/mbed_stats.h"
@@ -46,6 +47,12 @@ static void print_error_report(const mbed_error_ctx *ctx, const char *, const ch
 #define ERROR_REPORT(ctx, error_msg, error_filename, error_line) ((void) 0)
 #endif
 
+#if MBED_CONF_PLATFORM_ERROR_LOG_ENABLED
+#define ERROR_LOG_PUT(type, ctx) mbed_error_log_put(type, ctx)
+#else
+#define ERROR_LOG_PUT(type, ctx) ((void) 0)
+#endif
+
 static bool error_in_progress;
 static core_util_atomic_flag halt_in_progress = CORE_UTIL_ATOMIC_FLAG_INIT;
 static int error_count = 0;
@@ -118,6 +125,7 @@ WEAK MBED_NORETURN void error(const char *format, ...)
     // Prevent recursion if error is called again during store+print attempt
     if (!core_util_atomic_exchange_bool(&error_in_progress, true)) {
         handle_error(MBED_ERROR_UNKNOWN, 0, NULL, 0, MBED_CALLER_ADDR());
+        ERROR_LOG_PUT(MBED_ERROR_LOG_FATAL, &last_error_ctx);
         ERROR_REPORT(&last_error_ctx, "Fatal Run-time error", NULL, 0);
 
 #ifndef NDEBUG
@@ -234,6 +242,9 @@ mbed_error_status_t mbed_error_initialize(void)
             }
         }
     }
+#endif
+#if MBED_CONF_PLATFORM_ERROR_LOG_ENABLED
+    mbed_error_log_init();
 #endif
     return MBED_SUCCESS;
 }
@@ -268,7 +279,9 @@ bool mbed_get_error_in_progress(void)
 //Sets a non-fatal error
 mbed_error_status_t mbed_warning(mbed_error_status_t error_status, const char *error_msg, unsigned int error_value, const char *filename, int line_number)
 {
-    return handle_error(error_status, error_value, filename, line_number, MBED_CALLER_ADDR());
+    mbed_error_status_t status = handle_error(error_status, error_value, filename, line_number, MBED_CALLER_ADDR());
+    ERROR_LOG_PUT(MBED_ERROR_LOG_WARNING, &last_error_ctx);
+    return status;
 }
 
 //Sets a fatal error, this function is marked WEAK to be able to override this for some tests
@@ -278,6 +291,7 @@ WEAK MBED_NORETURN mbed_error_status_t mbed_error(mbed_error_status_t error_stat
     if (!core_util_atomic_exchange_bool(&error_in_progress, true)) {
         //set the error reported
         (void) handle_error(error_status, error_value, filename, line_number, MBED_CALLER_ADDR());
+        ERROR_LOG_PUT(MBED_ERROR_LOG_FATAL, &last_error_ctx);
 
         //On fatal errors print the error context/report
         ERROR_REPORT(&last_error_ctx, error_msg, filename, line_number);
@@ -0,0 +1,412 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "device.h"
+#include "platform/mbed_error.h"
+#include "platform/mbed_error_log.h"
+#include "platform/mbed_critical.h"
+
+#if MBED_CONF_PLATFORM_ERROR_LOG_ENABLED && DEVICE_FLASH
+
+#include "hal/flash_api.h"
+#if DEVICE_RESET_REASON
+#include "hal/reset_reason_api.h"
+#endif
+
+#if !defined(MBED_CONF_PLATFORM_ERROR_LOG_ADDRESS) || !defined(MBED_CONF_PLATFORM_ERROR_LOG_SIZE)
+#error The error log needs a reserved flash region, set platform.error-log-address and platform.error-log-size
+#endif
+
+/* Records are programmed one per slot, a slot being the record rounded up to
+   the flash page size. A slot is either erased, a valid record or garbage
+   left by a program interrupted by a reset, which is skipped. Sequence
+   numbers only increase, so the newest record is found by a scan at boot.
+ */
+typedef struct {
+    uint32_t sequence;
+    uint8_t type;
+    uint8_t reserved;
+    uint16_t check;
+    int32_t status;
+    uint32_t value;
+    uint32_t address;
+    uint32_t thread_id;
+} error_log_record_t;
+
+#define NO_SECTOR   UINT32_MAX
+
+static flash_t error_log_flash;
+static bool error_log_ready;
+static uint8_t *slot_buf;
+static uint32_t sector_size;
+static uint32_t slot_size;
+static uint32_t slots_per_sector;
+static uint32_t sector_count;
+static uint32_t total_slots;
+static uint32_t write_slot;
+static uint32_t next_sequence;
+static uint32_t pending_erase;
+static int record_count;
+static uint8_t erase_value;
+
+static uint16_t record_check(const error_log_record_t *record)
+{
+    error_log_record_t copy = *record;
+    copy.check = 0;
+
+    const uint32_t *words = (const uint32_t *)&copy;
+    uint32_t sum = 0x5a5a5a5a;
+    for (size_t i = 0; i < sizeof(copy) / sizeof(uint32_t); i++) {
+        sum = (sum << 3 | sum >> 29) ^ words[i];
+    }
+    return (uint16_t)(sum ^ (sum >> 16));
+}
+
+static uint32_t slot_address(uint32_t slot)
+{
+    // Any space left at the end of a sector is unused
+    return MBED_CONF_PLATFORM_ERROR_LOG_ADDRESS + (slot / slots_per_sector) * sector_size +
+           (slot % slots_per_sector) * slot_size;
+}
+
+static uint32_t sector_address(uint32_t sector)
+{
+    return MBED_CONF_PLATFORM_ERROR_LOG_ADDRESS + sector * sector_size;
+}
+
+static bool slot_is_erased(uint32_t slot)
+{
+    if (flash_read(&error_log_flash, slot_address(slot), slot_buf, slot_size) != 0) {
+        return false;
+    }
+    for (uint32_t i = 0; i < slot_size; i++) {
+        if (slot_buf[i] != erase_value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool slot_read(uint32_t slot, error_log_record_t *record)
+{
+    if (flash_read(&error_log_flash, slot_address(slot), (uint8_t *)record, sizeof(*record)) != 0) {
+        return false;
+    }
+    return record->type >= MBED_ERROR_LOG_WARNING && record->type <= MBED_ERROR_LOG_EVENT &&
+           record->check == record_check(record);
+}
+
+static bool sector_is_erased(uint32_t sector)
+{
+    for (uint32_t slot = sector * slots_per_sector; slot < (sector + 1) * slots_per_sector; slot++) {
+        if (!slot_is_erased(slot)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Count the valid records, including any in the sector queued for erasing
+static void recount(void)
+{
+    error_log_record_t record;
+
+    record_count = 0;
+    for (uint32_t slot = 0; slot < total_slots; slot++) {
+        if (slot_read(slot, &record)) {
+            record_count++;
+        }
+    }
+}
+
+static int erase_sector(uint32_t sector)
+{
+    if (flash_erase_sector(&error_log_flash, sector_address(sector)) != 0) {
+        return -1;
+    }
+    if (pending_erase == sector) {
+        pending_erase = NO_SECTOR;
+    }
+    return 0;
+}
+
+// Move the write position on to the next erased slot
+static int advance(void)
+{
+    write_slot = (write_slot + 1) % total_slots;
+    if (write_slot % slots_per_sector == 0) {
+        uint32_t sector = write_slot / slots_per_sector;
+        if (pending_erase == sector) {
+            // mbed_error_log_maintain was not called in time
+            if (erase_sector(sector) != 0) {
+                return -1;
+            }
+            recount();
+        }
+        pending_erase = (sector + 1) % sector_count;
+    }
+    return 0;
+}
+
+static mbed_error_status_t append(mbed_error_log_type_t type, int32_t status, uint32_t value, uint32_t address, uint32_t thread_id)
+{
+    if (!error_log_ready) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    mbed_error_status_t result = MBED_SUCCESS;
+    core_util_critical_section_enter();
+
+    error_log_record_t *record = (error_log_record_t *)slot_buf;
+    memset(slot_buf, erase_value, slot_size);
+    record->sequence = next_sequence++;
+    record->type = type;
+    record->reserved = 0;
+    record->status = status;
+    record->value = value;
+    record->address = address;
+    record->thread_id = thread_id;
+    record->check = record_check(record);
+
+    if (flash_program_page(&error_log_flash, slot_address(write_slot), slot_buf, slot_size) != 0) {
+        result = MBED_ERROR_WRITE_FAILED;
+    } else if (record_count < (int)total_slots) {
+        record_count++;
+    }
+    if (advance() != 0) {
+        result = MBED_ERROR_WRITE_FAILED;
+    }
+
+    core_util_critical_section_exit();
+    return result;
+}
+
+mbed_error_status_t mbed_error_log_init(void)
+{
+    if (error_log_ready) {
+        return MBED_SUCCESS;
+    }
+
+    if (flash_init(&error_log_flash) != 0) {
+        return MBED_ERROR_INITIALIZATION_FAILED;
+    }
+
+    sector_size = flash_get_sector_size(&error_log_flash, MBED_CONF_PLATFORM_ERROR_LOG_ADDRESS);
+    uint32_t page_size = flash_get_page_size(&error_log_flash);
+    erase_value = flash_get_erase_value(&error_log_flash);
+
+    // Equal sectors, at least two of them, each holding at least two slots
+    slot_size = ((sizeof(error_log_record_t) + page_size - 1) / page_size) * page_size;
+    if (sector_size == MBED_FLASH_INVALID_SIZE || MBED_CONF_PLATFORM_ERROR_LOG_ADDRESS % sector_size ||
+            MBED_CONF_PLATFORM_ERROR_LOG_SIZE % sector_size || MBED_CONF_PLATFORM_ERROR_LOG_SIZE < 2 * sector_size ||
+            sector_size < 2 * slot_size) {
+        flash_free(&error_log_flash);
+        return MBED_ERROR_INVALID_SIZE;
+    }
+    for (uint32_t addr = MBED_CONF_PLATFORM_ERROR_LOG_ADDRESS;
+            addr < MBED_CONF_PLATFORM_ERROR_LOG_ADDRESS + MBED_CONF_PLATFORM_ERROR_LOG_SIZE; addr += sector_size) {
+        if (flash_get_sector_size(&error_log_flash, addr) != sector_size) {
+            flash_free(&error_log_flash);
+            return MBED_ERROR_INVALID_SIZE;
+        }
+    }
+
+    slot_buf = (uint8_t *)malloc(slot_size);
+    if (slot_buf == NULL) {
+        flash_free(&error_log_flash);
+        return MBED_ERROR_OUT_OF_MEMORY;
+    }
+
+    slots_per_sector = sector_size / slot_size;
+    sector_count = MBED_CONF_PLATFORM_ERROR_LOG_SIZE / sector_size;
+    total_slots = slots_per_sector * sector_count;
+    pending_erase = NO_SECTOR;
+
+    // Find the newest record
+    error_log_record_t record;
+    bool found = false;
+    uint32_t newest_slot = 0;
+    uint32_t newest_sequence = 0;
+    for (uint32_t slot = 0; slot < total_slots; slot++) {
+        if (slot_read(slot, &record) && (!found || (int32_t)(record.sequence - newest_sequence) > 0)) {
+            found = true;
+            newest_slot = slot;
+            newest_sequence = record.sequence;
+        }
+    }
+
+    if (found) {
+        next_sequence = newest_sequence + 1;
+        write_slot = newest_slot;
+        // Skip anything a reset interrupted after the newest record
+        do {
+            write_slot = (write_slot + 1) % total_slots;
+        } while (write_slot % slots_per_sector != 0 && !slot_is_erased(write_slot));
+    } else {
+        next_sequence = 1;
+        write_slot = 0;
+    }
+
+    // The current sector, if just entered, and the one after it must be erased
+    uint32_t sector = write_slot / slots_per_sector;
+    uint32_t next_sector = (sector + 1) % sector_count;
+    if ((write_slot % slots_per_sector == 0 && !sector_is_erased(sector) && erase_sector(sector) != 0) ||
+            (!sector_is_erased(next_sector) && erase_sector(next_sector) != 0)) {
+        free(slot_buf);
+        flash_free(&error_log_flash);
+        return MBED_ERROR_WRITE_FAILED;
+    }
+
+    recount();
+    error_log_ready = true;
+
+#if DEVICE_RESET_REASON
+    append(MBED_ERROR_LOG_RESET, 0, hal_reset_reason_get(), 0, 0);
+#else
+    append(MBED_ERROR_LOG_RESET, 0, 0, 0, 0);
+#endif
+    return MBED_SUCCESS;
+}
+
+mbed_error_status_t mbed_error_log_put(mbed_error_log_type_t type, const mbed_error_ctx *error_ctx)
+{
+    return append(type, error_ctx->error_status, error_ctx->error_value, error_ctx->error_address, error_ctx->thread_id);
+}
+
+mbed_error_status_t mbed_error_log_event(int32_t code, uint32_t value)
+{
+    return append(MBED_ERROR_LOG_EVENT, code, value, (uint32_t)MBED_CALLER_ADDR(), 0);
+}
+
+mbed_error_status_t mbed_error_log_maintain(void)
+{
+    if (!error_log_ready) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    mbed_error_status_t result = MBED_SUCCESS;
+    core_util_critical_section_enter();
+    if (pending_erase != NO_SECTOR) {
+        if (erase_sector(pending_erase) != 0) {
+            result = MBED_ERROR_WRITE_FAILED;
+        }
+        recount();
+    }
+    core_util_critical_section_exit();
+    return result;
+}
+
+int mbed_error_log_get_count(void)
+{
+    return error_log_ready ? record_count : 0;
+}
+
+mbed_error_status_t mbed_error_log_get(int index, mbed_error_log_entry_t *entry)
+{
+    if (!error_log_ready) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    core_util_critical_section_enter();
+    int count = record_count;
+    uint32_t slot = write_slot;
+    core_util_critical_section_exit();
+
+    if (index < 0 || index >= count) {
+        return MBED_ERROR_ITEM_NOT_FOUND;
+    }
+
+    // Walk back over the valid records from the newest
+    error_log_record_t record;
+    int skip = count - 1 - index;
+    for (uint32_t i = 0; i < total_slots; i++) {
+        slot = (slot + total_slots - 1) % total_slots;
+        if (!slot_read(slot, &record)) {
+            continue;
+        }
+        if (skip-- == 0) {
+            entry->sequence = record.sequence;
+            entry->type = (mbed_error_log_type_t)record.type;
+            entry->status = record.status;
+            entry->value = record.value;
+            entry->address = record.address;
+            entry->thread_id = record.thread_id;
+            return MBED_SUCCESS;
+        }
+    }
+    return MBED_ERROR_ITEM_NOT_FOUND;
+}
+
+mbed_error_status_t mbed_error_log_reset(void)
+{
+    if (!error_log_ready) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    mbed_error_status_t result = MBED_SUCCESS;
+    core_util_critical_section_enter();
+    for (uint32_t sector = 0; sector < sector_count; sector++) {
+        if (erase_sector(sector) != 0) {
+            result = MBED_ERROR_WRITE_FAILED;
+        }
+    }
+    write_slot = 0;
+    record_count = 0;
+    pending_erase = NO_SECTOR;
+    core_util_critical_section_exit();
+    return result;
+}
+
+#else
+
+mbed_error_status_t mbed_error_log_init(void)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+mbed_error_status_t mbed_error_log_put(mbed_error_log_type_t type, const mbed_error_ctx *error_ctx)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+mbed_error_status_t mbed_error_log_event(int32_t code, uint32_t value)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+mbed_error_status_t mbed_error_log_maintain(void)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+int mbed_error_log_get_count(void)
+{
+    return 0;
+}
+
+mbed_error_status_t mbed_error_log_get(int index, mbed_error_log_entry_t *entry)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+mbed_error_status_t mbed_error_log_reset(void)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+#endif
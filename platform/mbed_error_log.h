@@ -0,0 +1,128 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ERROR_LOG_H
+#define MBED_ERROR_LOG_H
+
+#include <stdint.h>
+#include "platform/mbed_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_error_log Persistent error log
+ *
+ * A ring of compact binary records in a reserved internal flash region,
+ * enabled with platform.error-log-enabled. Errors, fatal errors and resets
+ * are recorded automatically and survive power cycles.
+ *
+ * Appending a record programs one flash page and never erases: the sector
+ * after the one being written is kept erased, and once writing moves into a
+ * new sector the one after it is queued for erasing by
+ * mbed_error_log_maintain. Only if that was never called by the time the
+ * queued sector is reached is it erased as part of an append. The log holds
+ * between (sectors - 1) and sectors worth of the most recent records.
+ *
+ * The region, platform.error-log-address and platform.error-log-size, must
+ * be at least two sectors of equal size outside the application.
+ * @{
+ */
+
+/** Kind of error log record */
+typedef enum {
+    MBED_ERROR_LOG_WARNING = 1,     /**< Non-fatal error, reported with mbed_warning */
+    MBED_ERROR_LOG_FATAL,           /**< Fatal error, reported with mbed_error */
+    MBED_ERROR_LOG_RESET,           /**< System start, value is the reset_reason_t where available */
+    MBED_ERROR_LOG_EVENT            /**< Application event, added with mbed_error_log_event */
+} mbed_error_log_type_t;
+
+/** Error log record */
+typedef struct {
+    uint32_t sequence;              /**< Number of the record, counts up across power cycles */
+    mbed_error_log_type_t type;     /**< Kind of record */
+    mbed_error_status_t status;     /**< Error status, or the event code for application events */
+    uint32_t value;                 /**< Error value */
+    uint32_t address;               /**< Caller address of the error */
+    uint32_t thread_id;             /**< Thread that reported the error, or 0 */
+} mbed_error_log_entry_t;
+
+/** Find the end of the log and record the system start
+ *
+ * Called by mbed_error_initialize at boot. Scans the whole region once and
+ * makes sure the sector ahead of the write position is erased.
+ *
+ * @return  MBED_SUCCESS, MBED_ERROR_UNSUPPORTED if the log is disabled or
+ *          MBED_ERROR_INVALID_SIZE if the region is unusable
+ */
+mbed_error_status_t mbed_error_log_init(void);
+
+/** Append an application event to the log
+ *
+ * @param code   Application defined event code
+ * @param value  Application defined value
+ * @return       MBED_SUCCESS, MBED_ERROR_NOT_READY before mbed_error_log_init
+ *               or MBED_ERROR_WRITE_FAILED
+ */
+mbed_error_status_t mbed_error_log_event(int32_t code, uint32_t value);
+
+/** Erase the sector queued for erasing, if any
+ *
+ * Erasing takes milliseconds and stalls execution from flash on most
+ * targets, so call this when that is acceptable, for example from a low
+ * priority thread or before going to sleep.
+ *
+ * @return  MBED_SUCCESS, MBED_ERROR_NOT_READY or MBED_ERROR_WRITE_FAILED
+ */
+mbed_error_status_t mbed_error_log_maintain(void);
+
+/** Get the number of records in the log
+ *
+ * @return  Number of records, 0 if the log is not initialized
+ */
+int mbed_error_log_get_count(void);
+
+/** Read a record from the log
+ *
+ * Reads walk the flash back from the newest record, they are meant for
+ * post-mortem retrieval rather than frequent use.
+ *
+ * @param index  Index of the record, 0 for the oldest up to count - 1 for the newest
+ * @param entry  Record to fill
+ * @return       MBED_SUCCESS, MBED_ERROR_NOT_READY or MBED_ERROR_ITEM_NOT_FOUND
+ */
+mbed_error_status_t mbed_error_log_get(int index, mbed_error_log_entry_t *entry);
+
+/** Erase the whole log
+ *
+ * @return  MBED_SUCCESS, MBED_ERROR_NOT_READY or MBED_ERROR_WRITE_FAILED
+ */
+mbed_error_status_t mbed_error_log_reset(void);
+
+/** @private Append an error, called by the error handling */
+mbed_error_status_t mbed_error_log_put(mbed_error_log_type_t type, const mbed_error_ctx *error_ctx);
+
+/**@}*/
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
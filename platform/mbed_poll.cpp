@@ -16,9 +16,11 @@
  */
 #include "mbed_poll.h"
 #include "FileHandle.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_retarget.h"
 #if MBED_CONF_RTOS_PRESENT
 #include "rtos/Kernel.h"
-#include "rtos/ThisThread.h"
+#include "rtos/EventFlags.h"
 using namespace rtos;
 #else
 #include "drivers/Timer.h"
@@ -27,66 +29,310 @@ using namespace rtos;
 
 namespace mbed {
 
-// timeout -1 forever, or milliseconds
-int poll(pollfh fhs[], unsigned nfhs, int timeout)
-{
-    /*
-     * TODO Proper wake-up mechanism.
-     * In order to correctly detect availability of read/write a FileHandle, we needed
-     * a select or poll mechanisms. We opted for poll as POSIX defines in
-     * http://pubs.opengroup.org/onlinepubs/009695399/functions/poll.html Currently,
-     * mbed::poll() just spins and scans filehandles looking for any events we are
-     * interested in. In future, his spinning behaviour will be replaced with
-     * condition variables.
+#if MBED_CONF_RTOS_PRESENT
+// Event flag set by poll_wake() for a waiting poll
+#define POLL_WAKE_FLAG 1
+
+// Rescan period for file handles that don't wake poll, in milliseconds
+#define POLL_RESCAN_MS 1
+
+// A thread blocked in poll()
+struct poll_waiter {
+    poll_waiter *next;
+    const pollfh *fhs;
+    unsigned nfhs;
+    EventFlags *flags;
+};
+
+// Lists are modified in critical sections, so poll_wake() can walk them from interrupts
+static poll_waiter *poll_waiters;
+#endif
+static PollSet *poll_sets;
+
+namespace {
+
+// Time since the start of a poll
+class PollTimer {
+public:
+    PollTimer()
+    {
+#if MBED_CONF_RTOS_PRESENT
+        _start = Kernel::get_ms_count();
+#else
+        _timer.start();
+#endif
+    }
+
+    int64_t elapsed_ms()
+    {
+#if MBED_CONF_RTOS_PRESENT
+        return Kernel::get_ms_count() - _start;
+#else
+        return _timer.read_ms();
+#endif
+    }
+
+    /* Waits until woken or until the timeout runs out, or for at most the
+     * rescan period if some file handles don't wake poll. Returns false
+     * once the timeout has run out.
      */
+    bool wait(void *flags, int timeout, bool all_wake)
+    {
+        int64_t remaining = timeout;
+        if (timeout > 0) {
+            remaining -= elapsed_ms();
+            if (remaining <= 0) {
+                return false;
+            }
+        }
 #if MBED_CONF_RTOS_PRESENT
-    uint64_t start_time = 0;
-    if (timeout > 0) {
-        start_time = Kernel::get_ms_count();
+        uint32_t millisec = timeout < 0 ? osWaitForever : (uint32_t)remaining;
+        if (!all_wake && millisec > POLL_RESCAN_MS) {
+            millisec = POLL_RESCAN_MS;
+        }
+        static_cast<EventFlags *>(flags)->wait_any(POLL_WAKE_FLAG, millisec);
+#endif
+        return true;
     }
-#define TIME_ELAPSED() int64_t(Kernel::get_ms_count() - start_time)
+
+private:
+#if MBED_CONF_RTOS_PRESENT
+    uint64_t _start;
+#elif MBED_CONF_PLATFORM_POLL_USE_LOWPOWER_TIMER
+    LowPowerTimer _timer;
 #else
-#if MBED_CONF_PLATFORM_POLL_USE_LOWPOWER_TIMER
-    LowPowerTimer timer;
+    Timer _timer;
+#endif
+};
+
+}
+
+static int poll_scan(pollfh fhs[], unsigned nfhs)
+{
+    int count = 0;
+    for (unsigned n = 0; n < nfhs; n++) {
+        FileHandle *fh = fhs[n].fh;
+        short mask = fhs[n].events | POLLERR | POLLHUP | POLLNVAL;
+        if (fh) {
+            fhs[n].revents = fh->poll(mask) & mask;
+        } else {
+            fhs[n].revents = POLLNVAL;
+        }
+        if (fhs[n].revents) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// timeout -1 forever, or milliseconds
+int poll(pollfh fhs[], unsigned nfhs, int timeout)
+{
+    int count = poll_scan(fhs, nfhs);
+    if (count || timeout == 0) {
+        return count;
+    }
+
+    bool all_wake = true;
+    for (unsigned n = 0; n < nfhs; n++) {
+        if (fhs[n].fh && !fhs[n].fh->wakes_poll()) {
+            all_wake = false;
+        }
+    }
+
+    PollTimer timer;
+#if MBED_CONF_RTOS_PRESENT
+    EventFlags flags;
+    poll_waiter waiter = { NULL, fhs, nfhs, &flags };
+    core_util_critical_section_enter();
+    waiter.next = poll_waiters;
+    poll_waiters = &waiter;
+    core_util_critical_section_exit();
 #else
-    Timer timer;
+    void *flags = NULL;
 #endif
-    if (timeout > 0) {
-        timer.start();
+
+    // Scans once more after registering, so no wake can be missed
+    while (!(count = poll_scan(fhs, nfhs)) && timer.wait(&flags, timeout, all_wake)) {
     }
-#define TIME_ELAPSED() timer.read_ms()
-#endif // MBED_CONF_RTOS_PRESENT
 
-    int count = 0;
-    for (;;) {
-        /* Scan the file handles */
-        for (unsigned n = 0; n < nfhs; n++) {
-            FileHandle *fh = fhs[n].fh;
-            short mask = fhs[n].events | POLLERR | POLLHUP | POLLNVAL;
-            if (fh) {
-                fhs[n].revents = fh->poll(mask) & mask;
-            } else {
-                fhs[n].revents = POLLNVAL;
+#if MBED_CONF_RTOS_PRESENT
+    core_util_critical_section_enter();
+    for (poll_waiter **w = &poll_waiters; *w; w = &(*w)->next) {
+        if (*w == &waiter) {
+            *w = waiter.next;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+#endif
+    return count;
+}
+
+void poll_wake(const FileHandle *fh)
+{
+    core_util_critical_section_enter();
+#if MBED_CONF_RTOS_PRESENT
+    for (poll_waiter *w = poll_waiters; w; w = w->next) {
+        for (unsigned n = 0; n < w->nfhs; n++) {
+            if (w->fhs[n].fh == fh) {
+                w->flags->set(POLL_WAKE_FLAG);
+                break;
             }
-            if (fhs[n].revents) {
-                count++;
+        }
+    }
+#endif
+    for (PollSet *set = poll_sets; set; set = set->_next) {
+        int i = set->find(fh);
+        if (i >= 0) {
+            set->_entries[i].pending = true;
+#if MBED_CONF_RTOS_PRESENT
+            if (set->_flags) {
+                static_cast<EventFlags *>(set->_flags)->set(POLL_WAKE_FLAG);
             }
+#endif
         }
+    }
+    core_util_critical_section_exit();
+}
 
-        if (count) {
+PollSet::PollSet(entry entries[], unsigned size)
+    : _next(NULL), _entries(entries), _size(size), _count(0), _scan(0), _flags(NULL)
+{
+    core_util_critical_section_enter();
+    _next = poll_sets;
+    poll_sets = this;
+    core_util_critical_section_exit();
+}
+
+PollSet::~PollSet()
+{
+    core_util_critical_section_enter();
+    for (PollSet **set = &poll_sets; *set; set = &(*set)->_next) {
+        if (*set == this) {
+            *set = _next;
             break;
         }
+    }
+    core_util_critical_section_exit();
+}
 
-        /* Nothing selected - this is where timeout handling would be needed */
-        if (timeout == 0 || (timeout > 0 && TIME_ELAPSED() > timeout)) {
-            break;
+int PollSet::find(const FileHandle *fh) const
+{
+    for (unsigned i = 0; i < _count; i++) {
+        if (_entries[i].fh == fh) {
+            return i;
         }
-#ifdef MBED_CONF_RTOS_PRESENT
-        // TODO - proper blocking
-        // wait for condition variable, wait queue whatever here
-        rtos::ThisThread::sleep_for(1);
+    }
+    return -1;
+}
+
+int PollSet::add(FileHandle *fh, short events)
+{
+    if (find(fh) >= 0) {
+        return -EEXIST;
+    }
+    if (_count == _size) {
+        return -ENOMEM;
+    }
+
+    // Scanned on the next wait for its current state
+    core_util_critical_section_enter();
+    _entries[_count].fh = fh;
+    _entries[_count].events = events;
+    _entries[_count].pending = true;
+    _count++;
+    core_util_critical_section_exit();
+    return 0;
+}
+
+int PollSet::modify(FileHandle *fh, short events)
+{
+    int i = find(fh);
+    if (i < 0) {
+        return -ENOENT;
+    }
+
+    core_util_critical_section_enter();
+    _entries[i].events = events;
+    _entries[i].pending = true;
+    core_util_critical_section_exit();
+    return 0;
+}
+
+int PollSet::remove(FileHandle *fh)
+{
+    int i = find(fh);
+    if (i < 0) {
+        return -ENOENT;
+    }
+
+    core_util_critical_section_enter();
+    _count--;
+    _entries[i].fh = _entries[_count].fh;
+    _entries[i].events = _entries[_count].events;
+    _entries[i].pending = _entries[_count].pending;
+    core_util_critical_section_exit();
+    return 0;
+}
+
+int PollSet::scan(pollfh ready[], unsigned nready, bool &all_wake)
+{
+    int count = 0;
+    all_wake = true;
+
+    unsigned start = _scan;
+    for (unsigned n = 0; n < _count && (unsigned)count < nready; n++) {
+        unsigned i = (start + n) % _count;
+        entry &e = _entries[i];
+        if (!e.fh->wakes_poll()) {
+            all_wake = false;
+        } else if (!e.pending) {
+            continue;
+        }
+
+        // Cleared before polling, so a wake from now on is kept
+        e.pending = false;
+        short mask = e.events | POLLERR | POLLHUP | POLLNVAL;
+        short revents = e.fh->poll(mask) & mask;
+        if (revents) {
+            // Level triggered, rescanned until the events are gone
+            e.pending = true;
+            ready[count].fh = e.fh;
+            ready[count].events = e.events;
+            ready[count].revents = revents;
+            count++;
+            _scan = i + 1;
+        }
+    }
+
+    return count;
+}
+
+int PollSet::wait(pollfh ready[], unsigned nready, int timeout)
+{
+    bool all_wake;
+    int count = scan(ready, nready, all_wake);
+    if (count || timeout == 0) {
+        return count;
+    }
+
+    PollTimer timer;
+#if MBED_CONF_RTOS_PRESENT
+    EventFlags flags;
+    core_util_critical_section_enter();
+    _flags = &flags;
+    core_util_critical_section_exit();
+#else
+    void *flags = NULL;
 #endif
+
+    while (!(count = scan(ready, nready, all_wake)) && timer.wait(&flags, timeout, all_wake)) {
     }
+
+    core_util_critical_section_enter();
+    _flags = NULL;
+    core_util_critical_section_exit();
     return count;
 }
 
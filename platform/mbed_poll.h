@@ -23,6 +23,8 @@
 #define POLLHUP        0x2000 ///< The device has been disconnected
 #define POLLNVAL       0x4000 ///< The specified file handle value is invalid
 
+#include "platform/NonCopyable.h"
+
 namespace mbed {
 
 class FileHandle;
@@ -44,6 +46,9 @@ struct pollfh {
  * For every file handle provided, poll() examines it for any events registered for that particular
  * file handle.
  *
+ * With an RTOS, poll() blocks until one of the file handles calls poll_wake(). File handles
+ * that don't wake poll (see FileHandle::wakes_poll()) are rescanned every millisecond instead.
+ *
  * @param fhs     an array of PollFh struct carrying a FileHandle and bitmasks of events
  * @param nfhs    number of file handles
  * @param timeout timer value to timeout or -1 for loop forever
@@ -52,6 +57,104 @@ struct pollfh {
  */
 int poll(pollfh fhs[], unsigned nfhs, int timeout);
 
+/** Wake up poll() calls and poll sets waiting on a file handle
+ *
+ * FileHandle implementations returning true from FileHandle::wakes_poll() must call
+ * this whenever the events poll() would return may have changed, typically along with
+ * their sigio() callback.
+ *
+ * @note Interrupt safe, can be called from a critical section.
+ *
+ * @param fh      the file handle whose state changed
+ */
+void poll_wake(const FileHandle *fh);
+
+/** Persistent set of file handles to wait on, similar to epoll
+ *
+ * Unlike poll(), which examines each file handle on every call, a poll set only
+ * rescans the file handles that called poll_wake() since they were last found
+ * without events, or those still having events. File handles that don't wake poll
+ * are rescanned each time. This keeps waiting cheap once many file handles are
+ * watched and few of them are active.
+ *
+ * Storage for the entries is provided by the user:
+ * @code
+ * PollSet::entry entries[16];
+ * PollSet set(entries, 16);
+ * set.add(&serial, POLLIN);
+ * pollfh ready[4];
+ * int count = set.wait(ready, 4, -1);
+ * @endcode
+ *
+ * @note Synchronization level: Not thread safe, a set must be used by one thread at a time.
+ */
+class PollSet : private NonCopyable<PollSet> {
+public:
+    /** Entry of a poll set */
+    struct entry {
+        FileHandle *fh;
+        short events;
+        volatile bool pending;
+    };
+
+    /** Create an empty poll set
+     *
+     * @param entries storage for the entries of the set
+     * @param size    number of entries the storage holds
+     */
+    PollSet(entry entries[], unsigned size);
+
+    ~PollSet();
+
+    /** Add a file handle to the set
+     *
+     * @param fh      file handle
+     * @param events  bitmask of the events to wait for, POLLERR, POLLHUP and POLLNVAL are always reported
+     * @return 0 on success, -EEXIST if the file handle is already in the set, -ENOMEM if the set is full
+     */
+    int add(FileHandle *fh, short events);
+
+    /** Change the events waited for on a file handle of the set
+     *
+     * @param fh      file handle
+     * @param events  bitmask of the events to wait for
+     * @return 0 on success, -ENOENT if the file handle is not in the set
+     */
+    int modify(FileHandle *fh, short events);
+
+    /** Remove a file handle from the set
+     *
+     * @param fh      file handle
+     * @return 0 on success, -ENOENT if the file handle is not in the set
+     */
+    int remove(FileHandle *fh);
+
+    /** Wait for events on the file handles of the set
+     *
+     * File handles are reported in turn, so ones with persistent events don't
+     * starve the others when ready has fewer entries than the set.
+     *
+     * @param ready   array filled with the file handles that have events
+     * @param nready  number of entries in ready
+     * @param timeout timer value to timeout or -1 for loop forever
+     * @return number of file handles stored in ready, 0 if timed out
+     */
+    int wait(pollfh ready[], unsigned nready, int timeout);
+
+private:
+    friend void poll_wake(const FileHandle *fh);
+
+    int find(const FileHandle *fh) const;
+    int scan(pollfh ready[], unsigned nready, bool &all_wake);
+
+    PollSet *_next;
+    entry *_entries;
+    unsigned _size;
+    unsigned _count;
+    unsigned _scan;
+    void *_flags;
+};
+
 /**@}*/
 
 /**@}*/
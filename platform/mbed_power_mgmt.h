@@ -27,6 +27,7 @@
 #include "hal/sleep_api.h"
 #include "mbed_toolchain.h"
 #include "hal/ticker_api.h"
+#include "mbed_stats.h"
 #include <stdbool.h>
 
 #ifdef __cplusplus
@@ -89,7 +90,7 @@ extern "C" {
  *
  */
 
-#ifdef MBED_SLEEP_TRACING_ENABLED
+#if defined(MBED_SLEEP_TRACING_ENABLED) || defined(MBED_SLEEP_STATS_ENABLED)
 
 void sleep_tracker_lock(const char *const filename, int line);
 void sleep_tracker_unlock(const char *const filename, int line);
@@ -116,7 +117,7 @@ void sleep_tracker_unlock(const char *const filename, int line);
 #define sleep_manager_unlock_deep_sleep() \
     sleep_manager_unlock_deep_sleep_internal()
 
-#endif // MBED_SLEEP_TRACING_ENABLED
+#endif // MBED_SLEEP_TRACING_ENABLED || MBED_SLEEP_STATS_ENABLED
 
 /** Lock the deep sleep mode
  *
@@ -158,8 +159,50 @@ bool sleep_manager_can_deep_sleep(void);
  */
 bool sleep_manager_can_deep_sleep_test_check(void);
 
+/** Wake-up latency constraint, owned by the caller of sleep_manager_latency_add
+ *
+ * The members are private to the sleep manager.
+ */
+typedef struct sleep_manager_latency {
+    uint32_t max_latency_us;
+    struct sleep_manager_latency *next;
+} sleep_manager_latency_t;
+
+/** Add a wake-up latency constraint
+ *
+ * While the constraint is added, sleep_manager_sleep_auto() only enters
+ * deep sleep if waking up from it takes no longer than max_latency_us,
+ * platform.deep-sleep-latency for the target. Use this instead of a deep
+ * sleep lock when deep sleep is acceptable as long as the wake-up is quick
+ * enough, for example for interrupts with a response deadline.
+ *
+ * The constraint must stay valid until removed. Adding a constraint that
+ * is already added updates its latency.
+ * This function is IRQ and thread safe
+ *
+ * @param constraint        Constraint to add
+ * @param max_latency_us    Longest tolerable wake-up latency in microseconds
+ */
+void sleep_manager_latency_add(sleep_manager_latency_t *constraint, uint32_t max_latency_us);
+
+/** Remove a wake-up latency constraint
+ *
+ * Removing a constraint that is not added does nothing.
+ * This function is IRQ and thread safe
+ *
+ * @param constraint        Constraint to remove
+ */
+void sleep_manager_latency_remove(sleep_manager_latency_t *constraint);
+
+/** Get the strictest wake-up latency constraint
+ *
+ * @return  Smallest maximum latency of all added constraints in microseconds,
+ *          UINT32_MAX if there are none
+ */
+uint32_t sleep_manager_max_latency(void);
+
 /** Enter auto selected sleep mode. It chooses the sleep or deepsleep modes based
- *  on the deepsleep locking counter
+ *  on the deepsleep locking counter and the wake-up latency constraints
  *
  * This function is IRQ and thread safe
  *
@@ -0,0 +1,547 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_printf.h"
+#include "platform/mbed_retarget.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT 0
+#endif
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
+#endif
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
+#endif
+
+#ifndef MBED_CONF_PLATFORM_STDIO_CONVERT_NEWLINES
+#define MBED_CONF_PLATFORM_STDIO_CONVERT_NEWLINES 0
+#endif
+
+/* Characters gathered on the stack before a write to the file handle */
+#define CHUNK_SIZE 32
+
+#define FLAG_LEFT   (1 << 0)
+#define FLAG_ZERO   (1 << 1)
+
+/* Without 64-bit support, long long arguments are truncated so that the
+ * 64-bit division helpers are not linked in. */
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+typedef unsigned long long value_t;
+#else
+typedef unsigned long value_t;
+#endif
+
+typedef struct output output_t;
+
+struct output {
+    char *buffer;       // Buffer to fill, NULL when writing to a stream
+    size_t size;        // Size of the buffer
+    void (*flush)(output_t *out);
+    int fd;             // Console file descriptor
+    FILE *stream;       // Other streams
+    size_t length;      // Characters output so far
+    size_t used;        // Characters in the chunk
+    bool error;
+    char chunk[CHUNK_SIZE];
+};
+
+static void console_flush(output_t *out)
+{
+    if (out->used && !out->error) {
+        out->error = write(out->fd, out->chunk, out->used) != (ssize_t) out->used;
+    }
+    out->used = 0;
+}
+
+/* Only referenced by fprintf to other streams, so printf does not link
+ * in the C library stdio */
+static void stream_flush(output_t *out)
+{
+    if (out->used && !out->error) {
+        out->error = fwrite(out->chunk, 1, out->used, out->stream) != out->used;
+    }
+    out->used = 0;
+}
+
+static void output_char(output_t *out, char c)
+{
+    if (out->buffer) {
+        if (out->length + 1 < out->size) {
+            out->buffer[out->length] = c;
+        }
+    } else {
+#if MBED_CONF_PLATFORM_STDIO_CONVERT_NEWLINES
+        if (c == '\n' && out->flush == console_flush) {
+            if (out->used == CHUNK_SIZE) {
+                out->flush(out);
+            }
+            out->chunk[out->used++] = '\r';
+        }
+#endif
+        if (out->used == CHUNK_SIZE) {
+            out->flush(out);
+        }
+        out->chunk[out->used++] = c;
+    }
+    out->length++;
+}
+
+static void output_padding(output_t *out, char c, int count)
+{
+    while (count-- > 0) {
+        output_char(out, c);
+    }
+}
+
+static void output_string(output_t *out, const char *str, int length, int width, int flags)
+{
+    if (!(flags & FLAG_LEFT)) {
+        output_padding(out, ' ', width - length);
+    }
+    for (int i = 0; i < length; i++) {
+        output_char(out, str[i]);
+    }
+    if (flags & FLAG_LEFT) {
+        output_padding(out, ' ', width - length);
+    }
+}
+
+static void output_integer(output_t *out, value_t value, bool negative, unsigned base,
+                           bool upper, const char *prefix, int width, int flags)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char text[24];
+    int length = 0;
+
+    do {
+        text[length++] = digits[value % base];
+        value /= base;
+    } while (value);
+
+    int prefix_length = negative ? 1 : (int)strlen(prefix);
+    int padding = width - length - prefix_length;
+
+    if (!(flags & (FLAG_LEFT | FLAG_ZERO))) {
+        output_padding(out, ' ', padding);
+    }
+    if (negative) {
+        output_char(out, '-');
+    } else {
+        while (*prefix) {
+            output_char(out, *prefix++);
+        }
+    }
+    if ((flags & FLAG_ZERO) && !(flags & FLAG_LEFT)) {
+        output_padding(out, '0', padding);
+    }
+    while (length) {
+        output_char(out, text[--length]);
+    }
+    if (flags & FLAG_LEFT) {
+        output_padding(out, ' ', padding);
+    }
+}
+
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
+static void output_double(output_t *out, double value, int precision, int width, int flags)
+{
+    if (value != value) {
+        output_string(out, "nan", 3, width, flags & FLAG_LEFT);
+        return;
+    }
+
+    bool negative = value < 0;
+    if (negative) {
+        value = -value;
+    }
+    if (value > (double)(value_t) -1) {
+        // Out of the range of the integer part
+        output_string(out, negative ? "-inf" : "inf", negative ? 4 : 3, width, flags & FLAG_LEFT);
+        return;
+    }
+
+    if (precision < 0 || precision > MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS) {
+        precision = MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS;
+    }
+
+    value_t scale = 1;
+    for (int i = 0; i < precision; i++) {
+        scale *= 10;
+    }
+    value_t integer = (value_t) value;
+    value_t decimals = (value_t)((value - (double) integer) * scale + 0.5);
+    if (decimals >= scale) {
+        integer++;
+        decimals -= scale;
+    }
+
+    int decimal_width = precision ? precision + 1 : 0;
+    output_integer(out, integer, negative, 10, false, "", (flags & FLAG_LEFT) ? 0 : width - decimal_width, flags & ~FLAG_LEFT);
+    if (precision) {
+        output_char(out, '.');
+        output_integer(out, decimals, false, 10, false, "", precision, FLAG_ZERO);
+    }
+    if (flags & FLAG_LEFT) {
+        // Width includes the decimals, pad what the integer part did not
+        int length = 1 + decimal_width + (negative ? 1 : 0);
+        for (value_t v = integer; v >= 10; v /= 10) {
+            length++;
+        }
+        output_padding(out, ' ', width - length);
+    }
+}
+#endif
+
+static int output_format(output_t *out, const char *format, va_list arguments)
+{
+    while (*format) {
+        if (*format != '%') {
+            output_char(out, *format++);
+            continue;
+        }
+
+        const char *start = format++;
+
+        int flags = 0;
+        for (;; format++) {
+            if (*format == '-') {
+                flags |= FLAG_LEFT;
+            } else if (*format == '0') {
+                flags |= FLAG_ZERO;
+            } else if (*format != '+' && *format != ' ' && *format != '#') {
+                break;
+            }
+        }
+
+        int width = 0;
+        if (*format == '*') {
+            width = va_arg(arguments, int);
+            if (width < 0) {
+                flags |= FLAG_LEFT;
+                width = -width;
+            }
+            format++;
+        } else {
+            while (*format >= '0' && *format <= '9') {
+                width = width * 10 + (*format++ - '0');
+            }
+        }
+
+        int precision = -1;
+        if (*format == '.') {
+            format++;
+            precision = 0;
+            if (*format == '*') {
+                precision = va_arg(arguments, int);
+                format++;
+            } else {
+                while (*format >= '0' && *format <= '9') {
+                    precision = precision * 10 + (*format++ - '0');
+                }
+            }
+        }
+
+        char length = 0;
+        if (*format == 'h' || *format == 'l') {
+            length = *format++;
+            if (*format == length) {
+                length = (length == 'h') ? 'H' : 'L';
+                format++;
+            }
+        } else if (*format == 'j' || *format == 'z' || *format == 't') {
+            length = *format++;
+        }
+
+        char conversion = *format;
+        if (conversion == '\0') {
+            break;
+        }
+        format++;
+
+        switch (conversion) {
+            case 'd':
+            case 'i': {
+                long long value;
+                if (length == 'L' || length == 'j') {
+                    value = va_arg(arguments, long long);
+                } else if (length == 'l') {
+                    value = va_arg(arguments, long);
+                } else if (length == 'z' || length == 't') {
+                    value = va_arg(arguments, ptrdiff_t);
+                } else {
+                    value = va_arg(arguments, int);
+                    if (length == 'H') {
+                        value = (signed char) value;
+                    } else if (length == 'h') {
+                        value = (short) value;
+                    }
+                }
+                value_t magnitude = (value < 0) ? -(value_t) value : (value_t) value;
+                output_integer(out, magnitude, value < 0, 10, false, "", width, flags);
+                break;
+            }
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X': {
+                value_t value;
+                if (length == 'L' || length == 'j') {
+                    value = (value_t) va_arg(arguments, unsigned long long);
+                } else if (length == 'l') {
+                    value = va_arg(arguments, unsigned long);
+                } else if (length == 'z' || length == 't') {
+                    value = va_arg(arguments, size_t);
+                } else {
+                    value = va_arg(arguments, unsigned int);
+                    if (length == 'H') {
+                        value = (unsigned char) value;
+                    } else if (length == 'h') {
+                        value = (unsigned short) value;
+                    }
+                }
+                unsigned base = (conversion == 'u') ? 10 : (conversion == 'o') ? 8 : 16;
+                output_integer(out, value, false, base, conversion == 'X', "", width, flags);
+                break;
+            }
+            case 'p':
+                output_integer(out, (uintptr_t) va_arg(arguments, void *), false, 16, false, "0x", width, flags);
+                break;
+            case 'c': {
+                char c = (char) va_arg(arguments, int);
+                output_string(out, &c, 1, width, flags);
+                break;
+            }
+            case 's': {
+                const char *str = va_arg(arguments, const char *);
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                int str_length = 0;
+                while ((precision < 0 || str_length < precision) && str[str_length]) {
+                    str_length++;
+                }
+                output_string(out, str, str_length, width, flags);
+                break;
+            }
+            case 'f':
+            case 'F': {
+                double value = va_arg(arguments, double);
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
+                output_double(out, value, precision, width, flags);
+#else
+                (void) value;
+                while (start < format) {
+                    output_char(out, *start++);
+                }
+#endif
+                break;
+            }
+            case '%':
+                output_char(out, '%');
+                break;
+            default:
+                // Not supported, the argument can't be skipped so stop here
+                while (start < format) {
+                    output_char(out, *start++);
+                }
+                while (*format) {
+                    output_char(out, *format++);
+                }
+                break;
+        }
+    }
+
+    return out->length;
+}
+
+static void output_init(output_t *out)
+{
+    memset(out, 0, offsetof(output_t, chunk));
+}
+
+static int console_vprintf(int fd, const char *format_str, va_list arguments)
+{
+    output_t out;
+    output_init(&out);
+    out.flush = console_flush;
+    out.fd = fd;
+
+    int length = output_format(&out, format_str, arguments);
+    out.flush(&out);
+    return out.error ? -1 : length;
+}
+
+int mbed_vsnprintf(char *buffer, size_t size, const char *format_str, va_list arguments)
+{
+    output_t out;
+    output_init(&out);
+    out.buffer = buffer;
+    out.size = size;
+
+    int length = output_format(&out, format_str, arguments);
+    if (size) {
+        buffer[(out.length < size) ? out.length : size - 1] = '\0';
+    }
+    return length;
+}
+
+int mbed_snprintf(char *buffer, size_t size, const char *format_str, ...)
+{
+    va_list arguments;
+    va_start(arguments, format_str);
+    int length = mbed_vsnprintf(buffer, size, format_str, arguments);
+    va_end(arguments);
+    return length;
+}
+
+int mbed_vfprintf(FILE *stream, const char *format_str, va_list arguments)
+{
+    if (stream == stdout) {
+        return console_vprintf(STDOUT_FILENO, format_str, arguments);
+    } else if (stream == stderr) {
+        return console_vprintf(STDERR_FILENO, format_str, arguments);
+    }
+
+    output_t out;
+    output_init(&out);
+    out.flush = stream_flush;
+    out.stream = stream;
+
+    int length = output_format(&out, format_str, arguments);
+    out.flush(&out);
+    return out.error ? -1 : length;
+}
+
+int mbed_fprintf(FILE *stream, const char *format_str, ...)
+{
+    va_list arguments;
+    va_start(arguments, format_str);
+    int length = mbed_vfprintf(stream, format_str, arguments);
+    va_end(arguments);
+    return length;
+}
+
+int mbed_vprintf(const char *format_str, va_list arguments)
+{
+    return console_vprintf(STDOUT_FILENO, format_str, arguments);
+}
+
+int mbed_printf(const char *format_str, ...)
+{
+    va_list arguments;
+    va_start(arguments, format_str);
+    int length = console_vprintf(STDOUT_FILENO, format_str, arguments);
+    va_end(arguments);
+    return length;
+}
+
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLED
+
+/* Replace the C library functions. The compiler turns some printf calls
+ * into puts or putchar, so those are replaced as well. */
+
+int printf(const char *format_str, ...)
+{
+    va_list arguments;
+    va_start(arguments, format_str);
+    int length = console_vprintf(STDOUT_FILENO, format_str, arguments);
+    va_end(arguments);
+    return length;
+}
+
+int vprintf(const char *format_str, va_list arguments)
+{
+    return console_vprintf(STDOUT_FILENO, format_str, arguments);
+}
+
+int fprintf(FILE *stream, const char *format_str, ...)
+{
+    va_list arguments;
+    va_start(arguments, format_str);
+    int length = mbed_vfprintf(stream, format_str, arguments);
+    va_end(arguments);
+    return length;
+}
+
+int vfprintf(FILE *stream, const char *format_str, va_list arguments)
+{
+    return mbed_vfprintf(stream, format_str, arguments);
+}
+
+int sprintf(char *buffer, const char *format_str, ...)
+{
+    va_list arguments;
+    va_start(arguments, format_str);
+    int length = mbed_vsnprintf(buffer, SIZE_MAX, format_str, arguments);
+    va_end(arguments);
+    return length;
+}
+
+int vsprintf(char *buffer, const char *format_str, va_list arguments)
+{
+    return mbed_vsnprintf(buffer, SIZE_MAX, format_str, arguments);
+}
+
+int snprintf(char *buffer, size_t size, const char *format_str, ...)
+{
+    va_list arguments;
+    va_start(arguments, format_str);
+    int length = mbed_vsnprintf(buffer, size, format_str, arguments);
+    va_end(arguments);
+    return length;
+}
+
+int vsnprintf(char *buffer, size_t size, const char *format_str, va_list arguments)
+{
+    return mbed_vsnprintf(buffer, size, format_str, arguments);
+}
+
+int puts(const char *str)
+{
+    output_t out;
+    output_init(&out);
+    out.flush = console_flush;
+    out.fd = STDOUT_FILENO;
+
+    while (*str) {
+        output_char(&out, *str++);
+    }
+    output_char(&out, '\n');
+    out.flush(&out);
+    return out.error ? EOF : (int) out.length;
+}
+
+int putchar(int c)
+{
+    output_t out;
+    output_init(&out);
+    out.flush = console_flush;
+    out.fd = STDOUT_FILENO;
+
+    output_char(&out, (char) c);
+    out.flush(&out);
+    return out.error ? EOF : (unsigned char) c;
+}
+
+#endif
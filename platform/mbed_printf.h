@@ -0,0 +1,120 @@
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_printf minimal printf functions
+ * @{
+ */
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PRINTF_H
+#define MBED_PRINTF_H
+
+#include <stdio.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Minimal printf
+ *
+ * These functions format without the toolchain's stdio: no FILE buffers are
+ * allocated and nothing is locked. Console output is written in small
+ * chunks straight to the STDOUT_FILENO file handle.
+ *
+ * Supported conversions are d, i, u, o, x, X, p, c, s and %, with the
+ * '-' and '0' flags, a field width, a precision for s, and the hh, h, l, ll,
+ * j, z and t length modifiers. f and F are supported when
+ * platform.minimal-printf-enable-floating-point is set. Other conversions
+ * are printed as they are written in the format.
+ *
+ * When platform.minimal-printf-enabled is set, they also replace printf,
+ * vprintf, sprintf, vsprintf, snprintf, vsnprintf, fprintf, vfprintf, puts
+ * and putchar of the C library.
+ */
+
+/**
+ * Minimal printf to the console
+ *
+ * @param format    printf format string
+ * @return          Number of characters written, negative on error
+ */
+int mbed_printf(const char *format, ...);
+
+/**
+ * Minimal vprintf to the console
+ *
+ * @param format    printf format string
+ * @param arguments Arguments of the format
+ * @return          Number of characters written, negative on error
+ */
+int mbed_vprintf(const char *format, va_list arguments);
+
+/**
+ * Minimal snprintf
+ *
+ * @param buffer    Buffer to fill, always null terminated if size is not 0
+ * @param size      Size of the buffer
+ * @param format    printf format string
+ * @return          Number of characters the whole output needs, not counting the terminator
+ */
+int mbed_snprintf(char *buffer, size_t size, const char *format, ...);
+
+/**
+ * Minimal vsnprintf
+ *
+ * @param buffer    Buffer to fill, always null terminated if size is not 0
+ * @param size      Size of the buffer
+ * @param format    printf format string
+ * @param arguments Arguments of the format
+ * @return          Number of characters the whole output needs, not counting the terminator
+ */
+int mbed_vsnprintf(char *buffer, size_t size, const char *format, va_list arguments);
+
+/**
+ * Minimal fprintf
+ *
+ * stdout and stderr go straight to their file handles, other streams
+ * through fwrite.
+ *
+ * @param stream    Stream to write to
+ * @param format    printf format string
+ * @return          Number of characters written, negative on error
+ */
+int mbed_fprintf(FILE *stream, const char *format, ...);
+
+/**
+ * Minimal vfprintf
+ *
+ * @param stream    Stream to write to
+ * @param format    printf format string
+ * @param arguments Arguments of the format
+ * @return          Number of characters written, negative on error
+ */
+int mbed_vfprintf(FILE *stream, const char *format, va_list arguments);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_PRINTF_H
+
+/** @}*/
+
+/** @}*/
@@ -0,0 +1,231 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_profiler.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include "device.h"
+#include <string.h>
+
+#if defined(MBED_PROFILER_ENABLED) && DEVICE_USTICKER
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "cmsis.h"
+#include "drivers/Ticker.h"
+#include "platform/SingletonPtr.h"
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "cmsis_os2.h"
+#endif
+
+#ifndef MBED_CONF_PLATFORM_PROFILER_BUCKETS
+#define MBED_CONF_PLATFORM_PROFILER_BUCKETS 128
+#endif
+
+#ifndef MBED_CONF_PLATFORM_PROFILER_RATE
+#define MBED_CONF_PLATFORM_PROFILER_RATE 1000
+#endif
+
+// Buckets probed for a free one before a sample is dropped, bounds the time spent in the interrupt
+#define PROFILER_MAX_PROBES 8
+
+// Offset of the return address in the exception frame, in words
+#define FRAME_PC 6
+
+using namespace mbed;
+
+static SingletonPtr<Ticker> profiler_ticker;
+static mbed_profiler_sample_t profiler_buckets[MBED_CONF_PLATFORM_PROFILER_BUCKETS];
+static mbed_profiler_stats_t profiler_stats;
+static bool profiler_running;
+
+static void profiler_add(uint32_t pc, uint32_t thread_id)
+{
+    uint32_t index = ((pc >> 1) ^ (thread_id >> 3)) % MBED_CONF_PLATFORM_PROFILER_BUCKETS;
+
+    for (int probe = 0; probe < PROFILER_MAX_PROBES; probe++) {
+        mbed_profiler_sample_t *bucket = &profiler_buckets[index];
+        if (!bucket->count) {
+            bucket->pc = pc;
+            bucket->thread_id = thread_id;
+            bucket->count = 1;
+            profiler_stats.buckets++;
+            return;
+        }
+        if (bucket->pc == pc && bucket->thread_id == thread_id) {
+            bucket->count++;
+            return;
+        }
+        index = (index + 1) % MBED_CONF_PLATFORM_PROFILER_BUCKETS;
+    }
+    profiler_stats.dropped++;
+}
+
+static void profiler_sample()
+{
+    profiler_stats.samples++;
+
+#ifdef MBED_CONF_RTOS_PRESENT
+    // Threads run on the process stack once the kernel is running. The ticker interrupt
+    // stacked the interrupted program counter there, unless it preempted another handler.
+    bool in_thread = (osKernelGetState() == osKernelRunning);
+#ifdef SCB_ICSR_RETTOBASE_Msk
+    in_thread = in_thread && (SCB->ICSR & SCB_ICSR_RETTOBASE_Msk);
+#endif
+    if (in_thread) {
+        const uint32_t *frame = (const uint32_t *)__get_PSP();
+        profiler_add(frame[FRAME_PC], (uint32_t)osThreadGetId());
+        return;
+    }
+#endif
+
+    profiler_stats.other++;
+}
+
+bool mbed_profiler_start(uint32_t rate_hz)
+{
+    if (!rate_hz) {
+        rate_hz = MBED_CONF_PLATFORM_PROFILER_RATE;
+    }
+    if (rate_hz > 1000000) {
+        return false;
+    }
+
+    profiler_ticker->attach_us(profiler_sample, 1000000 / rate_hz);
+    profiler_running = true;
+    return true;
+}
+
+void mbed_profiler_stop(void)
+{
+    if (profiler_running) {
+        profiler_ticker->detach();
+        profiler_running = false;
+    }
+}
+
+void mbed_profiler_reset(void)
+{
+    core_util_critical_section_enter();
+    memset(profiler_buckets, 0, sizeof(profiler_buckets));
+    memset(&profiler_stats, 0, sizeof(profiler_stats));
+    core_util_critical_section_exit();
+}
+
+void mbed_profiler_get_stats(mbed_profiler_stats_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+
+    core_util_critical_section_enter();
+    *stats = profiler_stats;
+    core_util_critical_section_exit();
+}
+
+size_t mbed_profiler_get_samples(mbed_profiler_sample_t *samples, size_t count)
+{
+    MBED_ASSERT(samples != NULL || count == 0);
+    size_t returned = 0;
+
+    for (size_t i = 0; i < MBED_CONF_PLATFORM_PROFILER_BUCKETS && returned < count; i++) {
+        // One bucket at a time, to keep interrupts enabled while copying
+        core_util_critical_section_enter();
+        samples[returned] = profiler_buckets[i];
+        core_util_critical_section_exit();
+        if (samples[returned].count) {
+            returned++;
+        }
+    }
+
+    return returned;
+}
+
+void mbed_profiler_dump(void)
+{
+    mbed_profiler_stats_t stats;
+
+    mbed_profiler_get_stats(&stats);
+    printf("PROF total %" PRIu32 " %" PRIu32 " %" PRIu32 "\n", stats.samples, stats.other, stats.dropped);
+
+#ifdef MBED_CONF_RTOS_PRESENT
+    uint32_t thread_n = osThreadGetCount();
+    osThreadId_t *threads = (osThreadId_t *)malloc(sizeof(osThreadId_t) * thread_n);
+    const char **names = (const char **)malloc(sizeof(const char *) * thread_n);
+    // Samples are still useful without the thread names
+    if (threads && names) {
+        // Names are taken with the kernel locked and printed once it is unlocked
+        osKernelLock();
+        thread_n = osThreadEnumerate(threads, thread_n);
+        for (uint32_t i = 0; i < thread_n; i++) {
+            names[i] = osThreadGetName(threads[i]);
+        }
+        osKernelUnlock();
+        for (uint32_t i = 0; i < thread_n; i++) {
+            printf("PROF thread %08" PRIx32 " %s\n", (uint32_t)threads[i], names[i] ? names[i] : "-");
+        }
+    }
+    free(names);
+    free(threads);
+#endif
+
+    for (size_t i = 0; i < MBED_CONF_PLATFORM_PROFILER_BUCKETS; i++) {
+        mbed_profiler_sample_t sample;
+        core_util_critical_section_enter();
+        sample = profiler_buckets[i];
+        core_util_critical_section_exit();
+        if (sample.count) {
+            printf("PROF pc %08" PRIx32 " %08" PRIx32 " %" PRIu32 "\n", sample.pc, sample.thread_id, sample.count);
+        }
+    }
+
+    printf("PROF end\n");
+}
+
+#else
+
+bool mbed_profiler_start(uint32_t rate_hz)
+{
+    (void)rate_hz;
+    return false;
+}
+
+void mbed_profiler_stop(void)
+{
+}
+
+void mbed_profiler_reset(void)
+{
+}
+
+void mbed_profiler_get_stats(mbed_profiler_stats_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_profiler_stats_t));
+}
+
+size_t mbed_profiler_get_samples(mbed_profiler_sample_t *samples, size_t count)
+{
+    (void)samples;
+    (void)count;
+    return 0;
+}
+
+void mbed_profiler_dump(void)
+{
+}
+
+#endif
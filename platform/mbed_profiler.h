@@ -0,0 +1,115 @@
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_profiler sampling profiler functions
+ * @{
+ */
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PROFILER_H
+#define MBED_PROFILER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of times a program counter was sampled in a thread
+ */
+typedef struct {
+    uint32_t pc;        /**< Interrupted program counter */
+    uint32_t thread_id; /**< Thread running when the sample was taken, 0 without an RTOS */
+    uint32_t count;     /**< Number of samples */
+} mbed_profiler_sample_t;
+
+/**
+ * Totals of the samples taken since the profile was reset
+ */
+typedef struct {
+    uint32_t samples;   /**< Samples taken */
+    uint32_t other;     /**< Samples not taken in a thread, e.g. in a nested interrupt or before the RTOS started */
+    uint32_t dropped;   /**< Samples dropped as the histogram was full */
+    uint32_t buckets;   /**< Number of program counter and thread pairs in the histogram */
+} mbed_profiler_stats_t;
+
+/**
+ * Start sampling the interrupted program counter
+ *
+ * Samples are taken from a us ticker interrupt and added to the histogram,
+ * which is kept until mbed_profiler_reset is called. The histogram holds up to
+ * platform.profiler-buckets program counter and thread pairs. Does nothing unless
+ * platform.profiler-enabled is set.
+ *
+ * Only code running in threads is sampled, as the program counter is read from
+ * the exception frame on the thread stack. Deep sleep is locked while sampling.
+ *
+ * @param rate_hz   Samples per second, 0 for platform.profiler-rate
+ * @return          true if sampling started
+ */
+bool mbed_profiler_start(uint32_t rate_hz);
+
+/**
+ * Stop sampling, the histogram is kept
+ */
+void mbed_profiler_stop(void);
+
+/**
+ * Clear the histogram and totals
+ */
+void mbed_profiler_reset(void);
+
+/**
+ * Get the totals of the samples taken
+ *
+ * @param stats     Returned totals
+ */
+void mbed_profiler_get_stats(mbed_profiler_stats_t *stats);
+
+/**
+ * Get the histogram
+ *
+ * Entries are in no particular order.
+ *
+ * @param samples   Array to return the histogram entries in
+ * @param count     Size of the array
+ * @return          Number of entries returned
+ */
+size_t mbed_profiler_get_samples(mbed_profiler_sample_t *samples, size_t count);
+
+/**
+ * Print the histogram to stdout
+ *
+ * Every line starts with "PROF" so the profile can be picked out of the console
+ * output. Running threads are listed with their names. Symbolize the output with
+ * tools/mbed_profiler_report.py and the ELF file of the application.
+ */
+void mbed_profiler_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_PROFILER_H
+
+/** @}*/
+
+/** @}*/
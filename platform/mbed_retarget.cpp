@@ -43,6 +43,7 @@
 #include <stdio.h>
 #include <errno.h>
 #include "platform/mbed_retarget.h"
+#include "cmsis.h"
 
 static SingletonPtr<PlatformMutex> _mutex;
 
@@ -110,24 +111,51 @@ uint32_t mbed_heap_size = 0;
  * we can't just return a Filehandle* from _open and instead have to
  * put it in a filehandles array and return the index into that array
  */
-static FileHandle *filehandles[OPEN_MAX] = { FILE_HANDLE_RESERVED, FILE_HANDLE_RESERVED, FILE_HANDLE_RESERVED };
+static FileHandle *volatile filehandles[OPEN_MAX] = { FILE_HANDLE_RESERVED, FILE_HANDLE_RESERVED, FILE_HANDLE_RESERVED };
 static char stdio_in_prev[OPEN_MAX];
 static char stdio_out_prev[OPEN_MAX];
-static SingletonPtr<PlatformMutex> filehandle_mutex;
+
+/* Descriptors in use are kept in a bitmap, so that neither opening nor closing
+ * a file has to lock or scan the whole filehandles array. Descriptor n is bit
+ * (31 - n % 32) of word n / 32, so the lowest free descriptor of a word is the
+ * count of leading zeros of the inverted word, as POSIX requires.
+ * stdin/stdout/stderr are always in use, the bits past OPEN_MAX are masked.
+ */
+#define FILEHANDLE_WORDS    ((OPEN_MAX + 31) / 32)
+#define FILEHANDLE_BIT(fd)  (0x80000000u >> ((fd) % 32))
+static uint32_t filehandle_used[FILEHANDLE_WORDS] = { 0xE0000000u };
+
+static void release_filehandle(int fd)
+{
+    core_util_atomic_fetch_and_u32(&filehandle_used[fd / 32], ~FILEHANDLE_BIT(fd));
+}
+
+/* Clears the descriptor if it is still bound to fh. Only the caller which
+ * clears it gets true, and gives the descriptor back to the free list.
+ */
+static bool free_filehandle(int fd, FileHandle *fh)
+{
+    if (!core_util_atomic_compare_exchange_strong(&filehandles[fd], &fh, (FileHandle *)NULL)) {
+        return false;
+    }
+    // stdin/stdout/stderr are never handed out again
+    if (fd >= 3) {
+        release_filehandle(fd);
+    }
+    return true;
+}
 
 namespace mbed {
 void mbed_set_unbuffered_stream(std::FILE *_file);
 
 void remove_filehandle(FileHandle *file)
 {
-    filehandle_mutex->lock();
     /* Remove all open filehandles for this */
-    for (unsigned int fh_i = 0; fh_i < sizeof(filehandles) / sizeof(*filehandles); fh_i++) {
+    for (int fh_i = 0; fh_i < OPEN_MAX; fh_i++) {
         if (filehandles[fh_i] == file) {
-            filehandles[fh_i] = NULL;
+            free_filehandle(fh_i, file);
         }
     }
-    filehandle_mutex->unlock();
 }
 }
 
@@ -272,6 +300,12 @@ static FileHandle *default_console()
 #   elif CONSOLE_FLOWCONTROL == CONSOLE_FLOWCONTROL_RTSCTS
     console.set_flow_control(SerialBase::RTSCTS, STDIO_UART_RTS, STDIO_UART_CTS);
 #   endif
+#   if MBED_CONF_PLATFORM_STDIO_BUFFERED_SERIAL_ASYNCH && DEVICE_SERIAL_ASYNCH
+    console.set_asynch(true);
+#   endif
+#   if MBED_CONF_PLATFORM_STDIO_BUFFERED_SERIAL_OVERFLOW_DROP
+    console.set_tx_overflow_drop(true);
+#   endif
 #  else
     static DirectSerial console(STDIO_UART_TX, STDIO_UART_RX, MBED_CONF_PLATFORM_STDIO_BAUD_RATE);
 #  endif
@@ -298,10 +332,10 @@ static FileHandle *get_console(int fd)
 /* Deal with the fact C library may not _open descriptors 0, 1, 2 - auto bind */
 FileHandle *mbed::mbed_file_handle(int fd)
 {
-    if (fd >= OPEN_MAX) {
+    if (fd < 0 || fd >= OPEN_MAX) {
         return NULL;
     }
-    FileHandle *fh = filehandles[fd];
+    FileHandle *fh = core_util_atomic_load(&filehandles[fd]);
     if (fh == FILE_HANDLE_RESERVED && fd < 3) {
         filehandles[fd] = fh = get_console(fd);
     }
@@ -319,7 +353,7 @@ static int handle_open_errors(int error, unsigned filehandle_idx)
 {
     errno = -error;
     // Free file handle
-    filehandles[filehandle_idx] = NULL;
+    free_filehandle(filehandle_idx, FILE_HANDLE_RESERVED);
     return -1;
 }
 
@@ -373,25 +407,23 @@ static inline int openflags_to_posix(int openflags)
 
 static int reserve_filehandle()
 {
-    // find the first empty slot in filehandles, after the slots reserved for stdin/stdout/stderr
-    filehandle_mutex->lock();
-    int fh_i;
-    for (fh_i = 3; fh_i < OPEN_MAX; fh_i++) {
-        /* Take a next free filehandle slot available. */
-        if (filehandles[fh_i] == NULL) {
-            break;
+    // claim the lowest free descriptor
+    for (int word = 0; word < FILEHANDLE_WORDS; word++) {
+        // descriptors past OPEN_MAX in the last word are never free
+        uint32_t past_max = (word == FILEHANDLE_WORDS - 1 && OPEN_MAX % 32) ? 0xFFFFFFFFu >> (OPEN_MAX % 32) : 0;
+        uint32_t used = core_util_atomic_load_u32(&filehandle_used[word]);
+        while (~(used | past_max)) {
+            int fh_i = word * 32 + __CLZ(~(used | past_max));
+            if (core_util_atomic_cas_u32(&filehandle_used[word], &used, used | FILEHANDLE_BIT(fh_i))) {
+                core_util_atomic_store(&filehandles[fh_i], FILE_HANDLE_RESERVED);
+                return fh_i;
+            }
         }
     }
-    if (fh_i >= OPEN_MAX) {
-        /* Too many file handles have been opened */
-        errno = EMFILE;
-        filehandle_mutex->unlock();
-        return -1;
-    }
-    filehandles[fh_i] = FILE_HANDLE_RESERVED;
-    filehandle_mutex->unlock();
 
-    return fh_i;
+    /* Too many file handles have been opened */
+    errno = EMFILE;
+    return -1;
 }
 
 int mbed::bind_to_fd(FileHandle *fh)
@@ -410,8 +442,7 @@ int mbed::bind_to_fd(FileHandle *fh)
 
 static int unbind_from_fd(int fd, FileHandle *fh)
 {
-    if (filehandles[fd] == fh) {
-        filehandles[fd] = NULL;
+    if (free_filehandle(fd, fh)) {
         return 0;
     } else {
         errno = EBADF;
@@ -445,7 +476,7 @@ std::FILE *fdopen(FileHandle *fh, const char *mode)
 {
     // First reserve the integer file descriptor
     int fd = bind_to_fd(fh);
-    if (!fd) {
+    if (fd < 0) {
         return NULL;
     }
     // Then bind that to the C stream. If successful, C library
@@ -565,8 +596,8 @@ extern "C" int PREFIX(_close)(FILEHANDLE fh)
 extern "C" int close(int fildes)
 {
     FileHandle *fhc = mbed_file_handle(fildes);
-    filehandles[fildes] = NULL;
-    if (fhc == NULL) {
+    // Of concurrent closes of the same descriptor, only one closes the handle
+    if (fhc == NULL || !free_filehandle(fildes, fhc)) {
         errno = EBADF;
         return -1;
     }
@@ -785,6 +816,67 @@ extern "C" ssize_t read(int fildes, void *buf, size_t length)
     }
 }
 
+/* The total size must fit the returned ssize_t */
+static bool iov_valid(const struct iovec *iov, int iovcnt)
+{
+    if (iovcnt < 0 || (iovcnt > 0 && iov == NULL)) {
+        return false;
+    }
+
+    size_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        if (iov[i].iov_len > SSIZE_MAX - total) {
+            return false;
+        }
+        total += iov[i].iov_len;
+    }
+    return true;
+}
+
+extern "C" ssize_t writev(int fildes, const struct iovec *iov, int iovcnt)
+{
+    FileHandle *fhc = mbed_file_handle(fildes);
+    if (fhc == NULL) {
+        errno = EBADF;
+        return -1;
+    }
+
+    if (!iov_valid(iov, iovcnt)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ssize_t ret = fhc->writev(iov, iovcnt);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    } else {
+        return ret;
+    }
+}
+
+extern "C" ssize_t readv(int fildes, const struct iovec *iov, int iovcnt)
+{
+    FileHandle *fhc = mbed_file_handle(fildes);
+    if (fhc == NULL) {
+        errno = EBADF;
+        return -1;
+    }
+
+    if (!iov_valid(iov, iovcnt)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ssize_t ret = fhc->readv(iov, iovcnt);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    } else {
+        return ret;
+    }
+}
+
 
 #ifdef __ARMCC_VERSION
 extern "C" int PREFIX(_istty)(FILEHANDLE fh)
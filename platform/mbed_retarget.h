@@ -554,6 +554,12 @@ struct pollfd {
     short revents;
 };
 
+/* sys/uio.h definitions */
+struct iovec {
+    void   *iov_base;  ///< Start of the buffer
+    size_t  iov_len;   ///< Size of the buffer in bytes
+};
+
 /* POSIX-compatible I/O functions */
 #if __cplusplus
 extern "C" {
@@ -568,6 +574,8 @@ extern "C" {
 #endif
     ssize_t write(int fildes, const void *buf, size_t nbyte);
     ssize_t read(int fildes, void *buf, size_t nbyte);
+    ssize_t writev(int fildes, const struct iovec *iov, int iovcnt);
+    ssize_t readv(int fildes, const struct iovec *iov, int iovcnt);
     off_t lseek(int fildes, off_t offset, int whence);
     int ftruncate(int fildes, off_t length);
     int isatty(int fildes);
@@ -0,0 +1,176 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_sched_trace.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include "hal/us_ticker_api.h"
+#include "hal/itm_api.h"
+#include "cmsis.h"
+#include <stdbool.h>
+
+#if defined(MBED_SCHED_TRACE_ENABLED) && DEVICE_USTICKER
+
+#ifndef MBED_CONF_PLATFORM_SCHED_TRACE_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_SCHED_TRACE_BUFFER_SIZE 256
+#endif
+
+#ifndef MBED_CONF_PLATFORM_SCHED_TRACE_ITM_PORT
+#define MBED_CONF_PLATFORM_SCHED_TRACE_ITM_PORT 1
+#endif
+
+#define TRACE_SIZE MBED_CONF_PLATFORM_SCHED_TRACE_BUFFER_SIZE
+MBED_STATIC_ASSERT((TRACE_SIZE & (TRACE_SIZE - 1)) == 0, "platform.sched-trace-buffer-size must be a power of two");
+
+static mbed_sched_trace_event_t trace_buf[TRACE_SIZE];
+// Free running counts, the ring holds trace_head - trace_tail events
+static uint32_t trace_head;
+static uint32_t trace_tail;
+static uint32_t trace_dropped;
+static volatile bool trace_active;
+
+// Must be called in a critical section
+static bool trace_push(uint32_t timestamp, uint16_t type, uint16_t data, uint32_t arg)
+{
+    if (trace_head - trace_tail >= TRACE_SIZE) {
+        return false;
+    }
+    mbed_sched_trace_event_t *ev = &trace_buf[trace_head & (TRACE_SIZE - 1)];
+    ev->timestamp = timestamp;
+    ev->arg = arg;
+    ev->type = type;
+    ev->data = data;
+    trace_head++;
+    return true;
+}
+
+void mbed_sched_trace_start(void)
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    // Makes sure the us ticker is initialized, events read it directly
+    ticker_read(ticker);
+    const ticker_info_t *info = ticker->interface->get_info();
+
+#if DEVICE_ITM
+    mbed_itm_init();
+    ITM->TER |= 1UL << MBED_CONF_PLATFORM_SCHED_TRACE_ITM_PORT;
+#endif
+
+    core_util_critical_section_enter();
+    trace_head = 0;
+    trace_tail = 0;
+    trace_dropped = 0;
+    trace_push(us_ticker_read(), MBED_SCHED_TRACE_START, info->bits, info->frequency);
+    trace_active = true;
+    core_util_critical_section_exit();
+}
+
+void mbed_sched_trace_stop(void)
+{
+    trace_active = false;
+}
+
+void mbed_sched_trace_record(uint16_t type, uint32_t arg)
+{
+    if (!trace_active) {
+        return;
+    }
+
+    core_util_critical_section_enter();
+    uint32_t timestamp = us_ticker_read();
+    if (trace_dropped) {
+        // Keep one slot for the overflow marker so the gap shows up in the timeline
+        if (trace_head - trace_tail < TRACE_SIZE - 1) {
+            trace_push(timestamp, MBED_SCHED_TRACE_OVERFLOW, 0, trace_dropped);
+            trace_dropped = 0;
+        }
+    }
+    if (trace_dropped || !trace_push(timestamp, type, 0, arg)) {
+        trace_dropped++;
+    }
+    core_util_critical_section_exit();
+}
+
+void mbed_sched_trace_isr_enter(void)
+{
+    mbed_sched_trace_record(MBED_SCHED_TRACE_ISR_ENTER, __get_IPSR());
+}
+
+void mbed_sched_trace_isr_exit(void)
+{
+    mbed_sched_trace_record(MBED_SCHED_TRACE_ISR_EXIT, __get_IPSR());
+}
+
+size_t mbed_sched_trace_read(mbed_sched_trace_event_t *events, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; i++) {
+        // Copy one event at a time to keep interrupt latency low
+        core_util_critical_section_enter();
+        if (trace_tail == trace_head) {
+            core_util_critical_section_exit();
+            break;
+        }
+        events[i] = trace_buf[trace_tail & (TRACE_SIZE - 1)];
+        trace_tail++;
+        core_util_critical_section_exit();
+    }
+    return i;
+}
+
+void mbed_sched_trace_swo_flush(void)
+{
+#if DEVICE_ITM
+    mbed_sched_trace_event_t ev;
+    while (mbed_sched_trace_read(&ev, 1)) {
+        mbed_itm_send_block(MBED_CONF_PLATFORM_SCHED_TRACE_ITM_PORT, &ev, sizeof(ev));
+    }
+#endif
+}
+
+#else
+
+void mbed_sched_trace_start(void)
+{
+}
+
+void mbed_sched_trace_stop(void)
+{
+}
+
+void mbed_sched_trace_record(uint16_t type, uint32_t arg)
+{
+}
+
+void mbed_sched_trace_isr_enter(void)
+{
+}
+
+void mbed_sched_trace_isr_exit(void)
+{
+}
+
+size_t mbed_sched_trace_read(mbed_sched_trace_event_t *events, size_t count)
+{
+    return 0;
+}
+
+void mbed_sched_trace_swo_flush(void)
+{
+}
+
+#endif
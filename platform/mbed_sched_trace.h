@@ -0,0 +1,128 @@
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_sched_trace sched_trace functions
+ * @{
+ */
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SCHED_TRACE_H
+#define MBED_SCHED_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * enum Event types recorded by the scheduler trace
+ */
+enum {
+    MBED_SCHED_TRACE_START,             /**< Trace started, arg is the us ticker frequency and data its width in bits */
+    MBED_SCHED_TRACE_OVERFLOW,          /**< Ring was full, arg is the number of events dropped */
+    MBED_SCHED_TRACE_THREAD_SWITCH,     /**< Thread switch, arg is the id of the thread switched to */
+    MBED_SCHED_TRACE_ISR_ENTER,         /**< Interrupt handler entry, arg is the exception number */
+    MBED_SCHED_TRACE_ISR_EXIT,          /**< Interrupt handler exit, arg is the exception number */
+    MBED_SCHED_TRACE_MUTEX_WAIT,        /**< Thread blocked on a mutex, arg is the mutex id */
+    MBED_SCHED_TRACE_SEMAPHORE_WAIT,    /**< Thread blocked on a semaphore, arg is the semaphore id */
+    MBED_SCHED_TRACE_EVENT_FLAGS_WAIT,  /**< Thread blocked on event flags, arg is the event flags id */
+    MBED_SCHED_TRACE_THREAD_FLAGS_WAIT, /**< Thread blocked on its thread flags, arg is the flags waited for */
+    MBED_SCHED_TRACE_QUEUE_GET_WAIT,    /**< Thread blocked on an empty message queue, arg is the queue id */
+    MBED_SCHED_TRACE_QUEUE_PUT_WAIT     /**< Thread blocked on a full message queue, arg is the queue id */
+};
+
+/**
+ * Scheduler trace event, also the binary format streamed over ITM
+ */
+typedef struct {
+    uint32_t timestamp; /**< Raw us ticker count when the event was recorded */
+    uint32_t arg;       /**< Event argument, see the event types */
+    uint16_t type;      /**< Event type */
+    uint16_t data;      /**< Extra event data, see the event types */
+} mbed_sched_trace_event_t;
+
+/**
+ * Start recording scheduler events
+ *
+ * Clears the ring and records an MBED_SCHED_TRACE_START event describing the timestamps.
+ * When the target has an ITM, the ITM stimulus port given by the platform.sched-trace-itm-port
+ * configuration is enabled as well.
+ */
+void mbed_sched_trace_start(void);
+
+/**
+ * Stop recording scheduler events, events already in the ring can still be read
+ */
+void mbed_sched_trace_stop(void);
+
+/**
+ * Record an event
+ *
+ * Safe to call from any context. Does nothing unless the trace is started.
+ *
+ * @param type  Event type
+ * @param arg   Event argument
+ */
+void mbed_sched_trace_record(uint16_t type, uint32_t arg);
+
+/**
+ * Record entry to the currently active interrupt handler
+ */
+void mbed_sched_trace_isr_enter(void);
+
+/**
+ * Record exit from the currently active interrupt handler
+ */
+void mbed_sched_trace_isr_exit(void);
+
+/**
+ * Remove the oldest events from the ring
+ *
+ * @param events    Array to fill with events
+ * @param count     Number of events the array can hold
+ * @return          Number of events read
+ */
+size_t mbed_sched_trace_read(mbed_sched_trace_event_t *events, size_t count);
+
+/**
+ * Stream all events in the ring over ITM
+ *
+ * Each event is sent as a raw mbed_sched_trace_event_t on the configured stimulus port.
+ * The idle thread calls this automatically unless platform.sched-trace-swo-idle-flush is disabled.
+ * Does nothing on targets without an ITM.
+ */
+void mbed_sched_trace_swo_flush(void);
+
+#if defined(MBED_SCHED_TRACE_ENABLED)
+#define MBED_SCHED_TRACE_ISR_ENTER()    mbed_sched_trace_isr_enter()
+#define MBED_SCHED_TRACE_ISR_EXIT()     mbed_sched_trace_isr_exit()
+#else
+#define MBED_SCHED_TRACE_ISR_ENTER()
+#define MBED_SCHED_TRACE_ISR_EXIT()
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_SCHED_TRACE_H
+
+/** @}*/
+
+/** @}*/
@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include "cmsis.h"
 #include "hal/us_ticker_api.h"
+#include "platform/mbed_boot_timeline.h"
 
 /* This startup is for mbed 2 baremetal. There is no config for RTOS for mbed 2,
  * therefore we protect this file with MBED_CONF_RTOS_PRESENT
@@ -75,7 +76,9 @@ int $Super$$main(void);
 
 int $Sub$$main(void)
 {
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_CXX_INIT);
     mbed_main();
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_MAIN);
     return $Super$$main();
 }
 
@@ -86,26 +89,50 @@ void _platform_post_stackheap_init(void)
 #if DEVICE_USTICKER && MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
     us_ticker_init();
 #endif
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_SDK_INIT);
 }
 
 #elif defined (__GNUC__)
 
 extern int __real_main(void);
 
+/* Code run from RAM and ITCM, when the linker script gives it sections of its own, see MBED_RAMFUNC and MBED_ITCM */
+extern uint32_t __ramfunc_load_start__ __attribute__((weak));
+extern uint32_t __ramfunc_start__ __attribute__((weak));
+extern uint32_t __ramfunc_end__ __attribute__((weak));
+extern uint32_t __itcm_load_start__ __attribute__((weak));
+extern uint32_t __itcm_start__ __attribute__((weak));
+extern uint32_t __itcm_end__ __attribute__((weak));
+
+static void mbed_copy_code(uint32_t *load, uint32_t *start, uint32_t *end)
+{
+    while (start < end) {
+        *start++ = *load++;
+    }
+}
+
 void software_init_hook(void)
 {
+    mbed_copy_code(&__ramfunc_load_start__, &__ramfunc_start__, &__ramfunc_end__);
+    mbed_copy_code(&__itcm_load_start__, &__itcm_start__, &__itcm_end__);
+    __DSB();
+    __ISB();
+
     mbed_copy_nvic();
     mbed_sdk_init();
 #if DEVICE_USTICKER && MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
     us_ticker_init();
 #endif
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_SDK_INIT);
     software_init_hook_rtos();
 }
 
 
 int __wrap_main(void)
 {
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_CXX_INIT);
     mbed_main();
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_MAIN);
     return __real_main();
 }
 
@@ -117,6 +144,7 @@ int __low_level_init(void)
 #if DEVICE_USTICKER && MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
     us_ticker_init();
 #endif
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_SDK_INIT);
     return 1;
 }
 
@@ -25,8 +25,10 @@
 
 #include "hal/us_ticker_api.h"
 #include "hal/lp_ticker_api.h"
+#include "hal/mbed_lp_ticker_wrapper.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #if DEVICE_SLEEP
 
@@ -35,13 +37,28 @@ static uint16_t deep_sleep_lock = 0U;
 static us_timestamp_t sleep_time = 0;
 static us_timestamp_t deep_sleep_time = 0;
 
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+// wake-up latency constraints, and the smallest of their latencies
+static sleep_manager_latency_t *latency_list = NULL;
+static uint32_t max_latency = UINT32_MAX;
+
+#ifndef MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY
+#define MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY 1000
+#endif
+
+#ifdef MBED_SLEEP_STATS_ENABLED
+static uint32_t sleep_count = 0;
+static uint32_t deep_sleep_count = 0;
+static us_timestamp_t lock_blocked_time = 0;
+static us_timestamp_t latency_blocked_time = 0;
+#endif
+
+#if (defined(MBED_CPU_STATS_ENABLED) || defined(MBED_SLEEP_STATS_ENABLED)) && DEVICE_LPTICKER
 static ticker_data_t *sleep_ticker = NULL;
 #endif
 
 static inline us_timestamp_t read_us(void)
 {
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if (defined(MBED_CPU_STATS_ENABLED) || defined(MBED_SLEEP_STATS_ENABLED)) && DEVICE_LPTICKER
     if (NULL == sleep_ticker) {
         sleep_ticker = (ticker_data_t *)get_lp_ticker_data();
     }
@@ -71,10 +88,10 @@ us_timestamp_t mbed_time_deepsleep(void)
     return deep_sleep_time;
 }
 
-#ifdef MBED_SLEEP_TRACING_ENABLED
+#if defined(MBED_SLEEP_TRACING_ENABLED) || defined(MBED_SLEEP_STATS_ENABLED)
 
 // Length of the identifier extracted from the driver name to store for logging.
-#define IDENTIFIER_WIDTH 15
+#define IDENTIFIER_WIDTH MBED_STATS_SLEEP_LOCK_NAME_LEN
 
 // Number of drivers that can be stored in the structure
 #define STATISTIC_COUNT  10
@@ -82,6 +99,7 @@ us_timestamp_t mbed_time_deepsleep(void)
 typedef struct sleep_statistic {
     char identifier[IDENTIFIER_WIDTH];
     uint8_t count;
+    us_timestamp_t blocked_time;
 } sleep_statistic_t;
 
 static sleep_statistic_t sleep_stats[STATISTIC_COUNT];
@@ -123,6 +141,7 @@ static sleep_statistic_t *sleep_tracker_add(const char *const filename)
     return NULL;
 }
 
+#ifdef MBED_SLEEP_TRACING_ENABLED
 static void sleep_tracker_print_stats(void)
 {
     mbed_error_printf("Sleep locks held:\r\n");
@@ -139,6 +158,7 @@ static void sleep_tracker_print_stats(void)
                           sleep_stats[i].count);
     }
 }
+#endif
 
 void sleep_tracker_lock(const char *const filename, int line)
 {
@@ -147,11 +167,16 @@ void sleep_tracker_lock(const char *const filename, int line)
     // Entry for this driver does not exist, create one.
     if (stat == NULL) {
         stat = sleep_tracker_add(filename);
+        if (stat == NULL) {
+            return;
+        }
     }
 
     core_util_atomic_incr_u8(&stat->count, 1);
 
+#ifdef MBED_SLEEP_TRACING_ENABLED
     mbed_error_printf("LOCK: %s, ln: %i, lock count: %u\r\n", filename, line, deep_sleep_lock);
+#endif
 }
 
 void sleep_tracker_unlock(const char *const filename, int line)
@@ -166,10 +191,73 @@ void sleep_tracker_unlock(const char *const filename, int line)
 
     core_util_atomic_decr_u8(&stat->count, 1);
 
+#ifdef MBED_SLEEP_TRACING_ENABLED
     mbed_error_printf("UNLOCK: %s, ln: %i, lock count: %u\r\n", filename, line, deep_sleep_lock);
+#endif
+}
+
+#endif // MBED_SLEEP_TRACING_ENABLED || MBED_SLEEP_STATS_ENABLED
+
+#ifdef MBED_SLEEP_STATS_ENABLED
+// Called with interrupts disabled after each sleep
+static void sleep_stats_update(bool deep, bool locked, us_timestamp_t duration)
+{
+    if (deep) {
+        deep_sleep_count++;
+        return;
+    }
+
+    sleep_count++;
+    if (locked) {
+        lock_blocked_time += duration;
+        for (int i = 0; i < STATISTIC_COUNT; ++i) {
+            if (sleep_stats[i].count != 0) {
+                sleep_stats[i].blocked_time += duration;
+            }
+        }
+    } else if (max_latency < MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY) {
+        latency_blocked_time += duration;
+    }
 }
+#endif
 
-#endif // MBED_SLEEP_TRACING_ENABLED
+void mbed_stats_sleep_get(mbed_stats_sleep_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_sleep_t));
+#ifdef MBED_SLEEP_STATS_ENABLED
+    core_util_critical_section_enter();
+    stats->sleep_time = sleep_time;
+    stats->deep_sleep_time = deep_sleep_time;
+    stats->sleep_count = sleep_count;
+    stats->deep_sleep_count = deep_sleep_count;
+    stats->lock_blocked_time = lock_blocked_time;
+    stats->latency_blocked_time = latency_blocked_time;
+    core_util_critical_section_exit();
+#endif
+}
+
+size_t mbed_stats_sleep_lock_get_each(mbed_stats_sleep_lock_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_sleep_lock_t));
+
+    size_t n = 0;
+#ifdef MBED_SLEEP_STATS_ENABLED
+    core_util_critical_section_enter();
+    for (int i = 0; i < STATISTIC_COUNT && n < count; ++i) {
+        if (sleep_stats[i].identifier[0] == '\0') {
+            break;
+        }
+        memcpy(stats[n].name, sleep_stats[i].identifier, IDENTIFIER_WIDTH);
+        stats[n].count = sleep_stats[i].count;
+        stats[n].blocked_time = sleep_stats[i].blocked_time;
+        n++;
+    }
+    core_util_critical_section_exit();
+#endif
+    return n;
+}
 
 void sleep_manager_lock_deep_sleep_internal(void)
 {
@@ -185,9 +273,59 @@ void sleep_manager_unlock_deep_sleep_internal(void)
     }
 }
 
+// Called with interrupts disabled after the constraints change
+static void latency_update(void)
+{
+    max_latency = UINT32_MAX;
+    for (sleep_manager_latency_t *cur = latency_list; cur != NULL; cur = cur->next) {
+        if (cur->max_latency_us < max_latency) {
+            max_latency = cur->max_latency_us;
+        }
+    }
+}
+
+void sleep_manager_latency_add(sleep_manager_latency_t *constraint, uint32_t max_latency_us)
+{
+    core_util_critical_section_enter();
+    sleep_manager_latency_t *cur = latency_list;
+    while (cur != NULL && cur != constraint) {
+        cur = cur->next;
+    }
+    if (cur == NULL) {
+        constraint->next = latency_list;
+        latency_list = constraint;
+    }
+    constraint->max_latency_us = max_latency_us;
+
+    latency_update();
+    core_util_critical_section_exit();
+}
+
+void sleep_manager_latency_remove(sleep_manager_latency_t *constraint)
+{
+    core_util_critical_section_enter();
+    sleep_manager_latency_t **prev = &latency_list;
+    while (*prev != NULL && *prev != constraint) {
+        prev = &(*prev)->next;
+    }
+    if (*prev != NULL) {
+        *prev = constraint->next;
+        constraint->next = NULL;
+    }
+
+    latency_update();
+    core_util_critical_section_exit();
+}
+
+uint32_t sleep_manager_max_latency(void)
+{
+    return core_util_atomic_load_u32(&max_latency);
+}
+
 bool sleep_manager_can_deep_sleep(void)
 {
-    return core_util_atomic_load_u16(&deep_sleep_lock) == 0;
+    return core_util_atomic_load_u16(&deep_sleep_lock) == 0 &&
+           core_util_atomic_load_u32(&max_latency) >= MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY;
 }
 
 bool sleep_manager_can_deep_sleep_test_check()
@@ -221,6 +359,10 @@ void sleep_manager_sleep_auto(void)
     if (sleep_manager_can_deep_sleep()) {
         deep = true;
         hal_deepsleep();
+#if DEVICE_LPTICKER
+        // The us ticker the lp ticker count is extrapolated with stops in deep sleep
+        lp_ticker_wrapper_invalidate();
+#endif
     } else {
         hal_sleep();
     }
@@ -232,6 +374,9 @@ void sleep_manager_sleep_auto(void)
     } else {
         sleep_time += end - start;
     }
+#ifdef MBED_SLEEP_STATS_ENABLED
+    sleep_stats_update(deep, deep_sleep_lock != 0, end - start);
+#endif
     core_util_critical_section_exit();
 }
 
@@ -250,10 +395,38 @@ void sleep_manager_unlock_deep_sleep_internal(void)
 
 }
 
+void sleep_manager_latency_add(sleep_manager_latency_t *constraint, uint32_t max_latency_us)
+{
+
+}
+
+void sleep_manager_latency_remove(sleep_manager_latency_t *constraint)
+{
+
+}
+
+uint32_t sleep_manager_max_latency(void)
+{
+    return UINT32_MAX;
+}
+
 bool sleep_manager_can_deep_sleep(void)
 {
     // no sleep implemented
     return false;
 }
 
+void mbed_stats_sleep_get(mbed_stats_sleep_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_sleep_t));
+}
+
+size_t mbed_stats_sleep_lock_get_each(mbed_stats_sleep_lock_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_sleep_lock_t));
+    return 0;
+}
+
 #endif
@@ -0,0 +1,122 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_splice.h"
+#include "platform/FileHandle.h"
+#include "platform/Buffer.h"
+
+#ifndef MBED_CONF_PLATFORM_SPLICE_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_SPLICE_BUFFER_SIZE 512
+#endif
+
+#ifndef MBED_CONF_PLATFORM_SPLICE_BUFFER_COUNT
+#define MBED_CONF_PLATFORM_SPLICE_BUFFER_COUNT 2
+#endif
+
+namespace mbed {
+
+// Buffers shared by all transfers, in place of one per caller
+static StaticBufferPool<MBED_CONF_PLATFORM_SPLICE_BUFFER_SIZE, MBED_CONF_PLATFORM_SPLICE_BUFFER_COUNT> splice_pool;
+
+static ssize_t file_write(FileHandle *fh, const void *data, size_t size)
+{
+    return fh->write(data, size);
+}
+
+// Write as much as out takes, returning the number of bytes written
+// or the error if none were
+static ssize_t write_all(const Callback<ssize_t(const void *, size_t)> &out, const void *data, size_t size)
+{
+    const uint8_t *ptr = static_cast<const uint8_t *>(data);
+    size_t written = 0;
+
+    while (written < size) {
+        ssize_t ret = out(ptr + written, size - written);
+        if (ret <= 0) {
+            return written ? written : ret;
+        }
+        written += ret;
+    }
+
+    return written;
+}
+
+ssize_t splice(FileHandle *out, FileHandle *in, off_t *offset, size_t length)
+{
+    return splice(callback(file_write, out), in, offset, length);
+}
+
+ssize_t splice(Callback<ssize_t(const void *, size_t)> out, FileHandle *in, off_t *offset, size_t length)
+{
+    off_t saved = 0;
+    if (offset) {
+        saved = in->seek(0, SEEK_CUR);
+        if (saved < 0) {
+            return saved;
+        }
+        off_t pos = in->seek(*offset, SEEK_SET);
+        if (pos < 0) {
+            return pos;
+        }
+    }
+
+    Buffer buffer;
+    size_t copied = 0;
+    ssize_t err = 0;
+
+    while (copied < length) {
+        const void *data;
+        ssize_t got = in->read_in_place(&data, length - copied);
+        if (got == -ENOSYS) {
+            // Taken on first use and kept for the whole transfer
+            if (!buffer) {
+                buffer = splice_pool.alloc(splice_pool.block_size());
+                if (!buffer) {
+                    err = -ENOMEM;
+                    break;
+                }
+            }
+            size_t size = length - copied;
+            got = in->read(buffer.data(), size < buffer.size() ? size : buffer.size());
+            data = buffer.data();
+        }
+        if (got <= 0) {
+            err = got;
+            break;
+        }
+
+        ssize_t written = write_all(out, data, got);
+        if (written < 0) {
+            in->seek(-got, SEEK_CUR);
+            err = written;
+            break;
+        }
+        copied += written;
+        if (written < got) {
+            in->seek(-(got - written), SEEK_CUR);
+            break;
+        }
+    }
+
+    if (offset) {
+        *offset += copied;
+        in->seek(saved, SEEK_SET);
+    }
+
+    return copied ? copied : err;
+}
+
+} // namespace mbed
@@ -0,0 +1,79 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SPLICE_H
+#define MBED_SPLICE_H
+
+#include <stddef.h>
+#include "platform/mbed_retarget.h"
+#include "platform/Callback.h"
+
+namespace mbed {
+
+class FileHandle;
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_splice splice functions
+ * @{
+ */
+
+/** Copy data from one file handle to another without a buffer of your own
+ *
+ * Data the source can read in place (see FileHandle::read_in_place), such
+ * as files on memory-mapped storage, is written straight from storage.
+ * Anything else is copied through one of a few buffers shared by all
+ * transfers, see the platform.splice-buffer-size and
+ * platform.splice-buffer-count configuration options.
+ *
+ * Data read from the source but not accepted by the destination, for
+ * example by a non-blocking file handle, is given back to the source.
+ *
+ * @param out       file handle to write to
+ * @param in        file handle to read from
+ * @param offset    position to start reading from, updated past the bytes
+ *                  copied, leaving the position of in unchanged. NULL to
+ *                  read from, and advance, the position of in
+ * @param length    number of bytes to copy
+ * @return          number of bytes copied, less than length at end of file or
+ *                  when out accepts no more. Negative error code if nothing
+ *                  was copied, -ENOMEM if all shared buffers are in use
+ */
+ssize_t splice(FileHandle *out, FileHandle *in, off_t *offset, size_t length);
+
+/** Copy data from a file handle to a write function without a buffer of your own
+ *
+ * Same as splice(FileHandle *, FileHandle *, off_t *, size_t), with data
+ * passed to a function behaving like FileHandle::write.
+ *
+ * @param out       function writing data, returning the number of bytes
+ *                  written or a negative error code
+ * @param in        file handle to read from
+ * @param offset    position to start reading from, or NULL
+ * @param length    number of bytes to copy
+ * @return          number of bytes copied, or negative error code if nothing
+ *                  was copied
+ */
+ssize_t splice(Callback<ssize_t(const void *, size_t)> out, FileHandle *in, off_t *offset, size_t length);
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif //MBED_SPLICE_H
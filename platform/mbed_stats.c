@@ -4,11 +4,14 @@
 #include "mbed_version.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdbool.h>
 
 #include "device.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
 #include "rtos_idle.h"
+#include "rtos_handlers.h"
+#include "rtx_os.h"
 #elif defined(MBED_STACK_STATS_ENABLED) || defined(MBED_THREAD_STATS_ENABLED) || defined(MBED_CPU_STATS_ENABLED)
 #warning Statistics are currently not supported without the rtos.
 #endif
@@ -95,6 +98,173 @@ size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count)
     return i;
 }
 
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+
+#ifndef MBED_CONF_PLATFORM_STACK_WATERMARK_THREADS
+#define MBED_CONF_PLATFORM_STACK_WATERMARK_THREADS  16
+#endif
+
+#ifndef MBED_CONF_PLATFORM_STACK_WATERMARK_WINDOW
+#define MBED_CONF_PLATFORM_STACK_WATERMARK_WINDOW   32
+#endif
+
+/* Cached watermark of one stack. Like osThreadGetStackSpace, space is the
+ * offset of the lowest word that no longer holds the fill pattern. The idle
+ * thread repeatedly walks the free words below it, cursor marking how far
+ * the current pass has got, and lowers space when it finds a used word.
+ * Stacks only get dirtier, so a pass never needs to look above space.
+ */
+typedef struct {
+    osRtxThread_t *thread;
+    void *stack_mem;
+    uint32_t space;
+    uint32_t cursor;
+    bool scanned;
+} stack_watermark_t;
+
+static stack_watermark_t watermarks[MBED_CONF_PLATFORM_STACK_WATERMARK_THREADS];
+static osThreadId_t watermark_ids[MBED_CONF_PLATFORM_STACK_WATERMARK_THREADS];
+static uint32_t watermark_cnt;
+static uint32_t watermark_next;
+
+// must be called with the kernel locked
+static bool watermark_valid(const stack_watermark_t *w)
+{
+    return w->thread->id == osRtxIdThread && w->thread->stack_mem == w->stack_mem;
+}
+
+// Rebuild the table from the current threads, keeping the entries of
+// threads that still exist. Must be called with the kernel locked
+static void watermark_resync(void)
+{
+    uint32_t thread_n = osThreadEnumerate(watermark_ids, MBED_CONF_PLATFORM_STACK_WATERMARK_THREADS);
+
+    for (uint32_t i = 0; i < thread_n; i++) {
+        osRtxThread_t *thread = (osRtxThread_t *)watermark_ids[i];
+
+        uint32_t j = i;
+        while (j < watermark_cnt && !(watermarks[j].thread == thread && watermark_valid(&watermarks[j]))) {
+            j++;
+        }
+
+        if (j < watermark_cnt) {
+            stack_watermark_t w = watermarks[i];
+            watermarks[i] = watermarks[j];
+            watermarks[j] = w;
+        } else {
+            watermarks[i].thread = thread;
+            watermarks[i].stack_mem = thread->stack_mem;
+            watermarks[i].space = thread->stack_size;
+            watermarks[i].cursor = 4;
+            watermarks[i].scanned = false;
+        }
+    }
+
+    watermark_cnt = thread_n;
+}
+
+// Cached free space of a thread's stack, scanning it in full if it has not
+// been scanned yet. Must be called with the kernel locked
+static uint32_t watermark_space(osThreadId_t thread_id)
+{
+    for (uint32_t i = 0; i < watermark_cnt; i++) {
+        stack_watermark_t *w = &watermarks[i];
+        if (w->thread == (osRtxThread_t *)thread_id && watermark_valid(w)) {
+            if (!w->scanned) {
+                w->space = osThreadGetStackSpace(thread_id);
+                w->cursor = 4;
+                w->scanned = true;
+            }
+            return w->space;
+        }
+    }
+
+    return osThreadGetStackSpace(thread_id);
+}
+#endif
+
+void mbed_stats_stack_watermark_update(void)
+{
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    if ((osRtxConfig.flags & osRtxConfigStackWatermark) == 0U) {
+        return;
+    }
+
+    int32_t lock = osKernelLock();
+
+    if (watermark_next >= watermark_cnt) {
+        watermark_resync();
+        watermark_next = 0;
+    }
+
+    if (watermark_next < watermark_cnt) {
+        stack_watermark_t *w = &watermarks[watermark_next];
+        bool done = true;
+
+        if (watermark_valid(w)) {
+            const uint32_t *stack = (const uint32_t *)w->stack_mem;
+            if (stack[0] != osRtxStackMagicWord) {
+                w->space = 0;
+            } else {
+                uint32_t end = w->cursor + MBED_CONF_PLATFORM_STACK_WATERMARK_WINDOW * 4;
+                if (end > w->space) {
+                    end = w->space;
+                }
+                while (w->cursor < end && stack[w->cursor / 4] == osRtxStackFillPattern) {
+                    w->cursor += 4;
+                }
+                if (w->cursor < end) {
+                    w->space = w->cursor;
+                }
+                done = w->cursor >= w->space;
+            }
+        }
+
+        if (done) {
+            w->scanned = true;
+            w->cursor = 4;
+            watermark_next++;
+        }
+    }
+
+    osKernelRestoreLock(lock);
+#endif
+}
+
+size_t mbed_stats_stack_get_each_cached(mbed_stats_stack_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_stack_t));
+
+    size_t i = 0;
+
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    osThreadId_t *threads;
+
+    threads = malloc(sizeof(osThreadId_t) * count);
+    // Don't fail on lack of memory
+    if (!threads) {
+        return 0;
+    }
+
+    osKernelLock();
+    count = osThreadEnumerate(threads, count);
+
+    for (i = 0; i < count; i++) {
+        uint32_t stack_size = osThreadGetStackSize(threads[i]);
+        stats[i].max_size = stack_size - watermark_space(threads[i]);
+        stats[i].reserved_size = stack_size;
+        stats[i].thread_id = (uint32_t)threads[i];
+        stats[i].stack_cnt = 1;
+    }
+    osKernelUnlock();
+
+    free(threads);
+#endif
+
+    return i;
+}
+
 size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
 {
     MBED_ASSERT(stats != NULL);
@@ -117,6 +287,7 @@ size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
         stats[i].stack_size = osThreadGetStackSize(threads[i]);
         stats[i].stack_space = osThreadGetStackSpace(threads[i]);
         stats[i].name = osThreadGetName(threads[i]);
+        stats[i].cpu_time = rtos_thread_cpu_time(threads[i]);
     }
     osKernelUnlock();
     free(threads);
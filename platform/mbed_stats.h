@@ -48,6 +48,15 @@ extern "C" {
 #ifndef MBED_THREAD_STATS_ENABLED
 #define MBED_THREAD_STATS_ENABLED   1
 #endif
+#ifndef MBED_EVENTS_STATS_ENABLED
+#define MBED_EVENTS_STATS_ENABLED   1
+#endif
+#ifndef MBED_SLEEP_STATS_ENABLED
+#define MBED_SLEEP_STATS_ENABLED    1
+#endif
+#ifndef MBED_NETWORK_STATS_ENABLED
+#define MBED_NETWORK_STATS_ENABLED  1
+#endif
 
 #endif // MBED_ALL_STATS_ENABLED
 
@@ -74,6 +83,40 @@ typedef struct {
  */
 void mbed_stats_heap_get(mbed_stats_heap_t *stats);
 
+/**
+ * struct mbed_stats_heap_site_t definition
+ */
+typedef struct {
+    void *caller;               /**< Return address of the call that allocated the memory */
+    uint32_t alloc_cnt;         /**< Number of allocations made from this call site since reset */
+    uint32_t alloc_size;        /**< Cumulative bytes allocated from this call site since reset */
+} mbed_stats_heap_site_t;
+
+/**
+ * struct mbed_stats_heap_profile_t definition
+ */
+typedef struct {
+    uint32_t free_size;         /**< Bytes currently free on the heap */
+    uint32_t largest_free_size; /**< Size of the largest block that can currently be allocated */
+    uint32_t fragmentation;     /**< Percentage of free_size that cannot be allocated in a single block */
+    uint32_t site_cnt;          /**< Number of distinct call sites recorded */
+    uint32_t dropped_cnt;       /**< Number of allocations from call sites that did not fit in the site table */
+} mbed_stats_heap_profile_t;
+
+/**
+ *  Fill the passed in structures with the heap allocation profile.
+ *
+ *  Requires MBED_HEAP_PROFILE_ENABLED. The largest free block is found by
+ *  probing the heap, so this function takes a few milliseconds and should
+ *  not be called from time-critical code.
+ *
+ *  @param profile  A pointer to the mbed_stats_heap_profile_t structure to fill
+ *  @param sites    A pointer to an array of mbed_stats_heap_site_t structures to fill, may be NULL
+ *  @param count    The number of mbed_stats_heap_site_t structures in the provided array
+ *  @return         The number of mbed_stats_heap_site_t structures that have been filled.
+ */
+size_t mbed_stats_heap_profile_get(mbed_stats_heap_profile_t *profile, mbed_stats_heap_site_t *sites, size_t count);
+
 /**
  * struct mbed_stats_stack_t definition
  */
@@ -103,6 +146,26 @@ void mbed_stats_stack_get(mbed_stats_stack_t *stats);
  */
 size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count);
 
+/**
+ *  Fill the passed array of structures with the stack statistics for each available thread, using
+ *  watermarks cached by the idle thread instead of scanning every stack.
+ *
+ *  The idle thread checks a few words of one stack per idle cycle, so the cached maximum can lag
+ *  behind mbed_stats_stack_get_each until the next pass over that stack completes. A thread that has
+ *  not been scanned yet is scanned in full once. At most MBED_CONF_PLATFORM_STACK_WATERMARK_THREADS
+ *  threads are cached, any others are scanned in full on every call.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_stack_t structures to fill
+ *  @param count    The number of mbed_stats_stack_t structures in the provided array
+ *  @return         The number of mbed_stats_stack_t structures that have been filled.
+ *                  If the number of stacks on the system is less than or equal to count, it will equal the number of stacks on the system.
+ *                  If the number of stacks on the system is greater than count, it will equal count.
+ */
+size_t mbed_stats_stack_get_each_cached(mbed_stats_stack_t *stats, size_t count);
+
+/** @private Advance the cached stack watermarks, called from the idle loop */
+void mbed_stats_stack_watermark_update(void);
+
 /**
  * struct mbed_stats_cpu_t definition
  */
@@ -120,6 +183,52 @@ typedef struct {
  */
 void mbed_stats_cpu_get(mbed_stats_cpu_t *stats);
 
+/**
+ * struct mbed_stats_sleep_t definition
+ *
+ * Times require a low power ticker and are zero without one.
+ */
+typedef struct {
+    us_timestamp_t sleep_time;            /**< Time spent in sleep since the system has started */
+    us_timestamp_t deep_sleep_time;       /**< Time spent in deep sleep since the system has started */
+    uint32_t sleep_count;                 /**< Number of times sleep was entered */
+    uint32_t deep_sleep_count;            /**< Number of times deep sleep was entered */
+    us_timestamp_t lock_blocked_time;     /**< Time spent in sleep instead of deep sleep because of a deep sleep lock */
+    us_timestamp_t latency_blocked_time;  /**< Time spent in sleep instead of deep sleep because of a wake-up latency constraint */
+} mbed_stats_sleep_t;
+
+/** Length of the deep sleep lock names, including the terminator */
+#define MBED_STATS_SLEEP_LOCK_NAME_LEN  15
+
+/**
+ * struct mbed_stats_sleep_lock_t definition
+ */
+typedef struct {
+    char name[MBED_STATS_SLEEP_LOCK_NAME_LEN];  /**< Start of the name of the file that took the lock */
+    uint32_t count;                             /**< Number of times the lock is currently held */
+    us_timestamp_t blocked_time;                /**< Time spent in sleep instead of deep sleep while the lock was held */
+} mbed_stats_sleep_lock_t;
+
+/**
+ *  Fill the passed in structure with sleep state residency statistics.
+ *
+ *  @param stats    A pointer to the mbed_stats_sleep_t structure to fill
+ */
+void mbed_stats_sleep_get(mbed_stats_sleep_t *stats);
+
+/**
+ *  Fill the passed array of stat structures with the statistics of each deep sleep lock.
+ *
+ *  Locks are told apart by the file calling sleep_manager_lock_deep_sleep, so all
+ *  DeepSleepLock objects share one entry. When several locks are held at the same
+ *  time, the blocked time is added to each of them.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_sleep_lock_t structures to fill
+ *  @param count    The number of mbed_stats_sleep_lock_t structures in the provided array
+ *  @return         The number of mbed_stats_sleep_lock_t structures that have been filled.
+ */
+size_t mbed_stats_sleep_lock_get_each(mbed_stats_sleep_lock_t *stats, size_t count);
+
 /**
  * struct mbed_stats_thread_t definition
  */
@@ -130,6 +239,7 @@ typedef struct {
     uint32_t stack_size;        /**< Current number of bytes reserved for the stack */
     uint32_t stack_space;       /**< Current number of free bytes remaining on the stack */
     const char   *name;         /**< Name of the thread */
+    uint64_t cpu_time;          /**< Time in microseconds the thread has been running, requires a microsecond ticker */
 } mbed_stats_thread_t;
 
 /**
@@ -143,6 +253,104 @@ typedef struct {
  */
 size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count);
 
+/** Number of buckets in event queue histograms */
+#define MBED_STATS_EVENTS_BUCKETS   8
+
+/**
+ * struct mbed_stats_events_t definition
+ *
+ * Histogram bucket 0 counts 0 ms, bucket n counts [2^(n-1), 2^n) ms and the last bucket counts everything longer.
+ */
+typedef struct {
+    uint32_t depth;                                 /**< Number of events currently pending */
+    uint32_t max_depth;                             /**< Maximum number of events pending at one time since reset */
+    uint32_t alloc_size;                            /**< Bytes currently allocated for events */
+    uint32_t max_alloc_size;                        /**< Maximum bytes allocated for events at one time since reset */
+    uint32_t slab_size;                             /**< Bytes of the event buffer never allocated yet */
+    uint32_t dispatched;                            /**< Number of events dispatched since reset */
+    uint32_t lateness[MBED_STATS_EVENTS_BUCKETS];   /**< Histogram of ms from event target time to dispatch */
+    uint32_t runtime[MBED_STATS_EVENTS_BUCKETS];    /**< Histogram of ms spent in event callbacks */
+    uint32_t max_runtime;                           /**< Longest callback execution in ms since reset */
+    void (*max_runtime_cb)(void *);                 /**< Callback of the longest execution, to look up in the map file */
+} mbed_stats_events_t;
+
+/**
+ *  Fill the passed in structure with runtime statistics of the shared event queue returned by mbed_event_queue.
+ *  Statistics are zero if the shared event queue wasn't created yet.
+ *
+ *  @param stats    A pointer to the mbed_stats_events_t structure to fill
+ */
+void mbed_stats_events_get(mbed_stats_events_t *stats);
+
+/**
+ * struct mbed_stats_network_pool_t definition
+ */
+typedef struct {
+    const char *name;       /**< Name of the pool, "MEM" for the heap of the stack */
+    uint32_t size;          /**< Number of elements in the pool, or bytes in the heap */
+    uint32_t used;          /**< Number of elements or bytes currently allocated */
+    uint32_t max_used;      /**< Most elements or bytes allocated at one time since the stack started */
+    uint32_t failures;      /**< Number of allocations that failed because the pool was exhausted */
+} mbed_stats_network_pool_t;
+
+/**
+ *  Fill the passed array of stat structures with the memory pool statistics of the lwIP stack.
+ *
+ *  The first structure is the lwIP heap, sized by MEM_SIZE, followed by the lwIP memory pools such
+ *  as TCP_PCB, TCP_SEG and PBUF_POOL. Requires MBED_NETWORK_STATS_ENABLED and the lwIP stack.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_network_pool_t structures to fill
+ *  @param count    The number of mbed_stats_network_pool_t structures in the provided array
+ *  @return         The number of mbed_stats_network_pool_t structures that have been filled.
+ *                  If the number of pools is greater than count, it will equal count.
+ */
+size_t mbed_stats_network_get(mbed_stats_network_pool_t *stats, size_t count);
+
+/** Number of buckets in the critical section duration histogram */
+#define MBED_STATS_CRITICAL_BUCKETS 12
+
+/**
+ * struct mbed_stats_critical_t definition
+ *
+ * Durations are in CPU cycles, divide by SystemCoreClock for seconds. Histogram bucket 0 counts
+ * sections shorter than 64 cycles, bucket n counts [2^(n+5), 2^(n+6)) cycles and the last bucket
+ * counts everything longer.
+ */
+typedef struct {
+    uint32_t count;                                     /**< Number of outermost critical sections since reset */
+    uint32_t max_cycles;                                /**< Longest time interrupts were disabled by a critical section */
+    void *max_caller;                                   /**< Return address of the core_util_critical_section_enter call of the longest section */
+    uint32_t histogram[MBED_STATS_CRITICAL_BUCKETS];    /**< Histogram of critical section durations */
+} mbed_stats_critical_t;
+
+/**
+ * struct mbed_stats_critical_site_t definition
+ */
+typedef struct {
+    void *caller;               /**< Return address of the core_util_critical_section_enter call */
+    uint32_t max_cycles;        /**< Longest section entered from this call site */
+} mbed_stats_critical_site_t;
+
+/**
+ *  Fill the passed in structures with critical section duration statistics.
+ *
+ *  Requires MBED_CRITICAL_STATS_ENABLED and a DWT cycle counter (Cortex-M3 and later). Only sections
+ *  entered with core_util_critical_section_enter are measured, from entry until interrupts are
+ *  enabled again by the outermost exit. The call sites of the longest sections are returned longest
+ *  first, one per call site, and can be looked up in the map file.
+ *
+ *  @param stats    A pointer to the mbed_stats_critical_t structure to fill
+ *  @param sites    A pointer to an array of mbed_stats_critical_site_t structures to fill, may be NULL
+ *  @param count    The number of mbed_stats_critical_site_t structures in the provided array
+ *  @return         The number of mbed_stats_critical_site_t structures that have been filled.
+ */
+size_t mbed_stats_critical_get(mbed_stats_critical_t *stats, mbed_stats_critical_site_t *sites, size_t count);
+
+/**
+ *  Clear the critical section statistics, for example once initialization has finished.
+ */
+void mbed_stats_critical_reset(void);
+
 /**
  * enum mbed_compiler_id_t definition
  */
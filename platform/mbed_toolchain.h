@@ -412,6 +412,71 @@
 #endif
 #endif
 
+/** MBED_RAMFUNC
+ *  Run a function from RAM, copied there at startup, to avoid flash wait
+ *  states in interrupt handlers and tight loops.
+ *
+ *  IAR places it with __ramfunc. GCC and ARM put it in a .ramfunc section,
+ *  which the linker script places in RAM and loads from flash:
+ *  - GCC_ARM: *(.ramfunc*) inside the .data output section, so it is copied
+ *    with the data, or a .ramfunc output section bounded by
+ *    __ramfunc_start__ and __ramfunc_end__ and loaded at
+ *    __ramfunc_load_start__, which mbed boot copies.
+ *  - ARM: *(.ramfunc) in the RW execution region, copied by scatter loading.
+ *  Without that the function stays in flash and works as usual.
+ *
+ *  When the MPU is used, RAM is execute-never unless
+ *  platform.ramfunc-enabled is set.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_RAMFUNC void fir_filter(const int16_t *in, int16_t *out, int n);
+ *  @endcode
+ */
+#ifndef MBED_RAMFUNC
+#if defined(__ICCARM__)
+#define MBED_RAMFUNC __ramfunc
+#elif defined(__CC_ARM)
+#define MBED_RAMFUNC __attribute__((section(".ramfunc"), noinline))
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__arm__)
+#define MBED_RAMFUNC __attribute__((section(".ramfunc"), noinline, long_call))
+#else
+#define MBED_RAMFUNC
+#endif
+#endif
+
+/** MBED_ITCM
+ *  Run a function from the instruction tightly coupled memory of a
+ *  Cortex-M7, which has no wait states and no contention with data
+ *  accesses.
+ *
+ *  The function is put in a .itcm section, which the linker script places in
+ *  the ITCM and loads from flash:
+ *  - GCC_ARM: a .itcm output section bounded by __itcm_start__ and
+ *    __itcm_end__ and loaded at __itcm_load_start__, which mbed boot copies.
+ *  - ARM: an execution region holding *(.itcm), copied by scatter loading.
+ *  - IAR: place in the ITCM region and initialize by copy { section .itcm }.
+ *  Without that, as on cores without ITCM, the function stays in flash.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_ITCM void TIM2_IRQHandler(void);
+ *  @endcode
+ */
+#ifndef MBED_ITCM
+#if defined(__ICCARM__)
+#define MBED_ITCM _Pragma("location=\".itcm\"") __ramfunc
+#elif defined(__CC_ARM)
+#define MBED_ITCM __attribute__((section(".itcm"), noinline))
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__arm__)
+#define MBED_ITCM __attribute__((section(".itcm"), noinline, long_call))
+#else
+#define MBED_ITCM
+#endif
+#endif
+
 /**
  * Macro expanding to a string literal of the enclosing function name.
  *
@@ -28,12 +28,12 @@
 
 namespace rtos {
 
-ConditionVariable::Waiter::Waiter(): sem(0), prev(NULL), next(NULL), in_list(false)
+ConditionVariable::Waiter::Waiter(): sem(0), prev(NULL), next(NULL), in_list(false), notified(false)
 {
     // No initialization to do
 }
 
-ConditionVariable::ConditionVariable(Mutex &mutex): _mutex(mutex), _wait_list(NULL)
+ConditionVariable::ConditionVariable(Mutex &mutex): _mutex(mutex), _wait_list(NULL), _notified_list(NULL)
 {
     // No initialization to do
 }
@@ -56,7 +56,16 @@ bool ConditionVariable::wait_for(uint32_t millisec)
 
     _mutex.lock();
 
-    if (current_thread.in_list) {
+    if (current_thread.notified) {
+        if (current_thread.in_list) {
+            // Notified by notify_all, timed out before its turn to be woken
+            _remove_wait_list(&_notified_list, &current_thread);
+        } else {
+            // Woken in turn by notify_all, wake the next one now the mutex is held
+            _wake_next_notified();
+        }
+        timeout = false;
+    } else if (current_thread.in_list) {
         _remove_wait_list(&_wait_list, &current_thread);
     }
 
@@ -93,9 +102,52 @@ void ConditionVariable::notify_one()
 void ConditionVariable::notify_all()
 {
     MBED_ASSERT(_mutex.get_owner() == ThisThread::get_id());
-    while (_wait_list != NULL) {
+    if (_wait_list == NULL) {
+        return;
+    }
+
+    // Move the waiters to the notified list and wake the first, each woken
+    // waiter wakes the next once it holds the mutex. Waking them all at once
+    // would have all but one go back to sleep on the mutex.
+    Waiter *waiter = _wait_list;
+    do {
+        waiter->notified = true;
+        waiter = waiter->next;
+    } while (waiter != _wait_list);
+
+    if (_notified_list == NULL) {
+        _notified_list = _wait_list;
+        _wait_list = NULL;
+        _wake_next_notified();
+    } else {
+        // Still waking the waiters of a previous notify_all, the woken one
+        // carries on with these
+        Waiter *first = _notified_list;
+        Waiter *last = first->prev;
+        Waiter *added_last = _wait_list->prev;
+        last->next = _wait_list;
+        _wait_list->prev = last;
+        added_last->next = first;
+        first->prev = added_last;
+        _wait_list = NULL;
+    }
+}
+
+void ConditionVariable::notify_n(uint32_t count)
+{
+    MBED_ASSERT(_mutex.get_owner() == ThisThread::get_id());
+    while (_wait_list != NULL && count > 0) {
         _wait_list->sem.release();
         _remove_wait_list(&_wait_list, _wait_list);
+        count--;
+    }
+}
+
+void ConditionVariable::_wake_next_notified()
+{
+    if (_notified_list != NULL) {
+        _notified_list->sem.release();
+        _remove_wait_list(&_notified_list, _notified_list);
     }
 }
 
@@ -147,6 +199,7 @@ void ConditionVariable::_remove_wait_list(Waiter **wait_list, Waiter *waiter)
 ConditionVariable::~ConditionVariable()
 {
     MBED_ASSERT(NULL == _wait_list);
+    MBED_ASSERT(NULL == _notified_list);
 }
 
 }
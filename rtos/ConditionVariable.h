@@ -291,6 +291,10 @@ public:
      * This function unblocks all of the threads waiting for the condition
      * variable.
      *
+     * The waiters are woken one after the other rather than all at once:
+     * each one, once it holds the mutex again, wakes the next. They do not
+     * all contend for the mutex and go back to sleep on it.
+     *
      * @note - The thread calling this function must be the owner of the
      * ConditionVariable's mutex.
      *
@@ -302,6 +306,22 @@ public:
      */
     void notify_all();
 
+    /** Notify up to a number of waiters on this condition variable that a
+     * condition changed.
+     *
+     * This function unblocks as many threads waiting for the condition
+     * variable as requested, or all of them if there are fewer. Use it to
+     * wake only as many threads as there are new work items.
+     *
+     * @param count Maximum number of threads to unblock.
+     *
+     * @note - The thread calling this function must be the owner of the
+     * ConditionVariable's mutex.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    void notify_n(uint32_t count);
+
     /** ConditionVariable destructor.
      *
      * @note You cannot call this function from ISR context.
@@ -316,12 +336,15 @@ protected:
         Waiter *prev;
         Waiter *next;
         bool in_list;
+        bool notified;
     };
 
     static void _add_wait_list(Waiter **wait_list, Waiter *waiter);
     static void _remove_wait_list(Waiter **wait_list, Waiter *waiter);
+    void _wake_next_notified();
     Mutex &_mutex;
     Waiter *_wait_list;
+    Waiter *_notified_list;
 #endif // !defined(DOXYGEN_ONLY)
 };
 
@@ -24,43 +24,34 @@
 #include "rtos/Kernel.h"
 #include "rtos/rtos_idle.h"
 #include "rtos/rtos_handlers.h"
-#include "platform/mbed_critical.h"
+#include "platform/mbed_atomic.h"
+#include "rtx_os.h"
 
 namespace rtos {
 
 uint64_t Kernel::get_ms_count()
 {
-    // CMSIS-RTOS 2.1.0 and 2.1.1 differ in the time type. We assume
-    // our header at least matches the implementation, so we don't try looking
-    // at the run-time version report. (There's no compile-time version report)
+    // The RTX tick count is read directly, osKernelGetTickCount is an SVC call
+    // from thread mode. It is extended to 64 bits without a critical section:
+    // the state holds the number of wraps and the top bit of the last count
+    // seen, and is only replaced if no other caller replaced it meanwhile.
+    static volatile uint32_t tick_state;
 
-    // 2.1.0 uint64_t osKernelGetTickCount(void), not documented as callable from ISR (but RTX does allow)
-    // 2.1.1 uint32_t osKernelGetTickCount(void), callable from ISR
-    // 2.1.x who knows? We assume could go back to uint64_t
-    if (sizeof osKernelGetTickCount() == sizeof(uint64_t)) {
-        return osKernelGetTickCount();
-    } else { /* assume 32-bit */
-        // Based on suggestion in CMSIS-RTOS 2.1.1 docs, but with reentrancy
-        // protection for the tick memory. We use critical section rather than a
-        // mutex, as hopefully this method can be callable from interrupt later -
-        // only thing currently preventing it is that pre CMSIS RTOS 2.1.1, it's
-        // not defined as safe.
-        // We assume this is called multiple times per 32-bit wrap period (49 days).
-        static uint32_t tick_h, tick_l;
+    // State first, a count read before a wrap must not be paired with a state
+    // saved after it
+    uint32_t state = core_util_atomic_load_u32(&tick_state);
+    uint32_t tick32 = core_util_atomic_load_u32((volatile uint32_t *) &osRtxInfo.kernel.tick);
+    uint32_t wraps = state >> 1;
 
-        core_util_critical_section_enter();
-        // The 2.1.1 API says this is legal from an ISR - we assume this means
-        // it's also legal with interrupts disabled. RTX implementation kind
-        // of conflates the two.
-        uint32_t tick32 = osKernelGetTickCount();
-        if (tick32 < tick_l) {
-            tick_h++;
-        }
-        tick_l = tick32;
-        uint64_t ret = ((uint64_t) tick_h << 32) | tick_l;
-        core_util_critical_section_exit();
-        return ret;
+    if ((state & 1) && !(tick32 >> 31)) {
+        wraps++;
     }
+    uint32_t new_state = (wraps << 1) | (tick32 >> 31);
+    if (new_state != state) {
+        core_util_atomic_cas_u32(&tick_state, &state, new_state);
+    }
+
+    return ((uint64_t) wraps << 32) | tick32;
 }
 
 void Kernel::attach_idle_hook(void (*fptr)(void))
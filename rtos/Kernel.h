@@ -40,7 +40,10 @@ namespace Kernel {
      @return  RTOS kernel current tick count
      @note Mbed OS always uses millisecond RTOS ticks, and this could only wrap
            after half a billion years.
-     @note You cannot call this function from ISR context.
+     @note The tick count is read without entering the kernel or a critical
+           section. The 32-bit count of the RTOS is expanded assuming this is
+           called at least once every 24 days.
+     @note You may call this function from ISR context.
  */
 uint64_t get_ms_count();
 
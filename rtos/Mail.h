@@ -179,6 +179,29 @@ public:
         return _pool.calloc_until(millisec);
     }
 
+    /** Allocate several memory blocks of type T, optionally blocking for the first one.
+     *
+     * @param   data      Array to store the allocated blocks in.
+     * @param   count     Number of blocks to allocate.
+     * @param   millisec  Timeout value to wait for the first block, or 0 in case of no timeout. (default: 0)
+     *
+     * @return  Number of blocks allocated, stored from the start of `data`.
+     *
+     * @note You may call this function from ISR context if the millisec parameter is set to 0.
+     */
+    uint32_t alloc_n(T **data, uint32_t count, uint32_t millisec = 0)
+    {
+        if (count == 0 || (data[0] = _pool.alloc_for(millisec)) == NULL) {
+            return 0;
+        }
+
+        uint32_t allocated = 1;
+        while (allocated < count && (data[allocated] = _pool.alloc()) != NULL) {
+            allocated++;
+        }
+        return allocated;
+    }
+
     /** Put a mail in the queue.
      *
      * @param   mptr  Memory block previously allocated with Mail::alloc or Mail::calloc.
@@ -192,6 +215,20 @@ public:
         return _queue.put(mptr);
     }
 
+    /** Put several mails in the queue, waking a waiting receiver at most once.
+     *
+     * @param   data   Array of memory blocks previously allocated with Mail::alloc or Mail::alloc_n.
+     * @param   count  Number of blocks in `data`.
+     *
+     * @return  Number of mails put, taken from the start of `data`.
+     *
+     * @note You may call this function from ISR context.
+     */
+    uint32_t put_n(T *const *data, uint32_t count)
+    {
+        return _queue.put_n(data, count);
+    }
+
     /** Get a mail from the queue.
      *
      * @param millisec Timeout value (default: osWaitForever).
@@ -213,6 +250,21 @@ public:
         return evt;
     }
 
+    /** Get several mails from the queue, waiting for the first one.
+     *
+     * @param   data      Array to store the received memory blocks in.
+     * @param   count     Maximum number of mails to receive.
+     * @param   millisec  Timeout value to wait for the first mail (default: osWaitForever).
+     *
+     * @return  Number of mails received, stored from the start of `data`.
+     *
+     * @note You may call this function from ISR context if the millisec parameter is set to 0.
+     */
+    uint32_t get_n(T **data, uint32_t count, uint32_t millisec = osWaitForever)
+    {
+        return _queue.get_n(data, count, millisec);
+    }
+
     /** Free a memory block from a mail.
      *
      * @param mptr Pointer to the memory block that was obtained with Mail::get.
@@ -226,6 +278,27 @@ public:
         return _pool.free(mptr);
     }
 
+    /** Free several memory blocks from mails.
+     *
+     * @param   data   Array of memory blocks that were obtained with Mail::get or Mail::get_n.
+     * @param   count  Number of blocks in `data`.
+     *
+     * @return  Status code that indicates the execution status of the function (osOK on success).
+     *
+     * @note You may call this function from ISR context.
+     */
+    osStatus free_n(T *const *data, uint32_t count)
+    {
+        osStatus status = osOK;
+        for (uint32_t i = 0; i < count; i++) {
+            osStatus ret = _pool.free(data[i]);
+            if (ret != osOK) {
+                status = ret;
+            }
+        }
+        return status;
+    }
+
 private:
     Queue<T, queue_sz> _queue;
     MemoryPool<T, queue_sz> _pool;
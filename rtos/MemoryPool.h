@@ -24,11 +24,20 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <new>
+#include <utility>
 
 #include "cmsis_os2.h"
 #include "mbed_rtos1_types.h"
 #include "mbed_rtos_storage.h"
 #include "platform/NonCopyable.h"
+#include "platform/mbed_critical.h"
+
+extern "C" {
+    /* RTX memory block primitives, lock free on cores with exclusive access */
+    void *osRtxMemoryPoolAlloc(osRtxMpInfo_t *mp_info);
+    osStatus_t osRtxMemoryPoolFree(osRtxMpInfo_t *mp_info, void *block);
+}
 
 namespace rtos {
 /** \addtogroup rtos */
@@ -45,6 +54,11 @@ namespace rtos {
  @note
  Memory considerations: The memory pool data store and control structures will be created on current thread's stack,
  both for the mbed OS and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
+
+ @note
+ Allocation and deallocation from threads pop and push the pool's free list directly, without a kernel call.
+ The kernel is only entered to block when the pool is exhausted and a timeout is given,
+ to wake a thread that is blocked waiting for a block, or to free a block from an interrupt.
 */
 template<typename T, uint32_t pool_sz>
 class MemoryPool : private mbed::NonCopyable<MemoryPool<T, pool_sz> > {
@@ -82,7 +96,7 @@ public:
     */
     T *alloc(void)
     {
-        return (T *)osMemoryPoolAlloc(_id, 0);
+        return (T *)osRtxMemoryPoolAlloc(&_obj_mem.mp_info);
     }
 
     /** Allocate a memory block from a memory pool, optionally blocking.
@@ -93,7 +107,11 @@ public:
     */
     T *alloc_for(uint32_t millisec)
     {
-        return (T *)osMemoryPoolAlloc(_id, millisec);
+        T *block = alloc();
+        if (block == NULL && millisec != 0) {
+            block = (T *)osMemoryPoolAlloc(_id, millisec);
+        }
+        return block;
     }
 
     /** Allocate a memory block from a memory pool, blocking.
@@ -178,10 +196,84 @@ public:
     */
     osStatus free(T *block)
     {
-        return osMemoryPoolFree(_id, block);
+        // An interrupt may preempt the kernel between it finding the pool empty and
+        // queueing the allocating thread, where no waiter is visible yet. Frees from
+        // interrupts, or with interrupts masked, go through the kernel so that the
+        // waiter list is checked again in post-processing once the kernel is done.
+        if (core_util_is_isr_active() || !core_util_are_interrupts_enabled() || has_waiters()) {
+            return osMemoryPoolFree(_id, block);
+        }
+
+        // A thread can't preempt the kernel, so a thread that started waiting before
+        // the block was returned is always visible here.
+        osStatus status = osRtxMemoryPoolFree(&_obj_mem.mp_info, block);
+        if (status == osOK && has_waiters()) {
+            // Pass a block through the kernel so that the waiter is woken.
+            void *handover = osRtxMemoryPoolAlloc(&_obj_mem.mp_info);
+            if (handover != NULL) {
+                osMemoryPoolFree(_id, handover);
+            }
+        }
+        return status;
+    }
+
+    /** Allocate a memory block from a memory pool, without blocking, and construct an object in it.
+      @param   args  arguments forwarded to the constructor of T
+      @return  address of the constructed object or NULL in case of no memory available.
+
+      @note You may call this function from ISR context if the constructor of T may be called from ISR context.
+    */
+    template<typename... Args>
+    T *construct(Args &&... args)
+    {
+        T *item = alloc();
+        if (item != NULL) {
+            new (item) T(std::forward<Args>(args)...);
+        }
+        return item;
+    }
+
+    /** Allocate a memory block from a memory pool, optionally blocking, and construct an object in it.
+      @param   millisec  timeout value (osWaitForever to wait forever)
+      @param   args      arguments forwarded to the constructor of T
+      @return  address of the constructed object or NULL in case of no memory available.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0
+            and the constructor of T may be called from ISR context.
+    */
+    template<typename... Args>
+    T *construct_for(uint32_t millisec, Args &&... args)
+    {
+        T *item = alloc_for(millisec);
+        if (item != NULL) {
+            new (item) T(std::forward<Args>(args)...);
+        }
+        return item;
+    }
+
+    /** Destroy an object created by construct() and free its memory block.
+      @param   item  address of the object to be destroyed.
+      @return        osOK on successful deallocation, osErrorParameter if given memory block id
+                     is NULL or invalid, or osErrorResource if given memory block is in an
+                     invalid memory pool state.
+
+      @note You may call this function from ISR context if the destructor of T may be called from ISR context.
+    */
+    osStatus destroy(T *item)
+    {
+        if (item == NULL) {
+            return osErrorParameter;
+        }
+        item->~T();
+        return free(item);
     }
 
 private:
+    bool has_waiters() const
+    {
+        return *(osRtxThread_t *const volatile *)&_obj_mem.thread_list != NULL;
+    }
+
     osMemoryPoolId_t             _id;
     char                         _pool_mem[MBED_RTOS_STORAGE_MEM_POOL_MEM_SIZE(pool_sz, sizeof(T))];
     mbed_rtos_storage_mem_pool_t _obj_mem;
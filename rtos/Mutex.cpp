@@ -25,6 +25,8 @@
 #include <string.h>
 #include "mbed_error.h"
 #include "mbed_assert.h"
+#include "mbed_critical.h"
+#include "rtx_os.h"
 
 namespace rtos {
 
@@ -53,8 +55,79 @@ void Mutex::constructor(const char *name)
     MBED_ASSERT(_id || mbed_get_error_in_progress());
 }
 
+/* The fast paths update the RTX control block exactly as the kernel would,
+ * with interrupts masked so that the kernel, which only runs from SVC, PendSV
+ * and interrupt handlers, never sees a partial update. They only handle cases
+ * that need no scheduling: taking a free mutex, taking an owned one again,
+ * and releasing it while no thread waits for it and no priority has been
+ * inherited. Everything else goes through osMutexAcquire and osMutexRelease.
+ */
+bool Mutex::fast_acquire()
+{
+    if (_id == NULL || core_util_is_isr_active()) {
+        return false;
+    }
+
+    bool acquired = false;
+    core_util_critical_section_enter();
+    osRtxThread_t *thread = osRtxInfo.thread.run.curr;
+    if (thread != NULL) {
+        if (_obj_mem.lock == 0) {
+            _obj_mem.owner_thread = thread;
+            _obj_mem.owner_next = thread->mutex_list;
+            _obj_mem.owner_prev = NULL;
+            if (thread->mutex_list != NULL) {
+                thread->mutex_list->owner_prev = &_obj_mem;
+            }
+            thread->mutex_list = &_obj_mem;
+            _obj_mem.lock = 1;
+            acquired = true;
+        } else if (_obj_mem.owner_thread == thread && _obj_mem.lock < osRtxMutexLockLimit) {
+            _obj_mem.lock++;
+            acquired = true;
+        }
+    }
+    core_util_critical_section_exit();
+    return acquired;
+}
+
+bool Mutex::fast_release()
+{
+    if (_id == NULL || core_util_is_isr_active()) {
+        return false;
+    }
+
+    bool released = false;
+    core_util_critical_section_enter();
+    osRtxThread_t *thread = osRtxInfo.thread.run.curr;
+    if (thread != NULL && _obj_mem.lock != 0 && _obj_mem.owner_thread == thread) {
+        if (_obj_mem.lock > 1) {
+            _obj_mem.lock--;
+            released = true;
+        } else if (_obj_mem.thread_list == NULL && thread->priority == thread->priority_base) {
+            if (_obj_mem.owner_next != NULL) {
+                _obj_mem.owner_next->owner_prev = _obj_mem.owner_prev;
+            }
+            if (_obj_mem.owner_prev != NULL) {
+                _obj_mem.owner_prev->owner_next = _obj_mem.owner_next;
+            } else {
+                thread->mutex_list = _obj_mem.owner_next;
+            }
+            _obj_mem.lock = 0;
+            released = true;
+        }
+    }
+    core_util_critical_section_exit();
+    return released;
+}
+
 osStatus Mutex::lock(void)
 {
+    if (fast_acquire()) {
+        _count++;
+        return osOK;
+    }
+
     osStatus status = osMutexAcquire(_id, osWaitForever);
     if (osOK == status) {
         _count++;
@@ -69,6 +142,11 @@ osStatus Mutex::lock(void)
 
 osStatus Mutex::lock(uint32_t millisec)
 {
+    if (fast_acquire()) {
+        _count++;
+        return osOK;
+    }
+
     osStatus status = osMutexAcquire(_id, millisec);
     if (osOK == status) {
         _count++;
@@ -92,8 +170,14 @@ bool Mutex::trylock()
 
 bool Mutex::trylock_for(uint32_t millisec)
 {
+    if (fast_acquire()) {
+        _count++;
+        return true;
+    }
+
     osStatus status = osMutexAcquire(_id, millisec);
     if (status == osOK) {
+        _count++;
         return true;
     }
 
@@ -124,6 +208,11 @@ bool Mutex::trylock_until(uint64_t millisec)
 
 osStatus Mutex::unlock()
 {
+    if (fast_release()) {
+        _count--;
+        return osOK;
+    }
+
     osStatus status = osMutexRelease(_id);
     if (osOK == status) {
         _count--;
@@ -167,6 +167,8 @@ public:
 
 private:
     void constructor(const char *name = NULL);
+    bool fast_acquire();
+    bool fast_release();
     friend class ConditionVariable;
 
     osMutexId_t               _id;
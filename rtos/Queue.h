@@ -27,6 +27,7 @@
 #include "mbed_rtos_storage.h"
 #include "platform/mbed_error.h"
 #include "platform/NonCopyable.h"
+#include "rtos/rtos_handlers.h"
 
 namespace rtos {
 /** \addtogroup rtos */
@@ -209,7 +210,101 @@ public:
         return event;
     }
 
+    /** Inserts several elements to the end of the queue in one batch.
+     *
+     * The messages are inserted with the scheduler locked, so a thread
+     * waiting on the queue is woken at most once for the whole batch instead
+     * of once per message.
+     *
+     * The timeout indicated by the parameter `millisec` specifies how long
+     * the function blocks waiting for space for the first message. The
+     * remaining messages are inserted only while there is space, without
+     * blocking.
+     *
+     * @param  data      Array of pointers to the elements to insert.
+     * @param  count     Number of elements in `data`.
+     * @param  millisec  Timeout to wait for space for the first element, or 0
+     *                   in case of no timeout. (default: 0)
+     * @param  prio      Priority of the operation or 0 in case of default.
+     *                   (default: 0)
+     *
+     * @return Number of elements inserted, taken from the start of `data`.
+     *
+     * @note You may call this function from ISR context if the millisec
+     *       parameter is set to 0.
+     */
+    uint32_t put_n(T *const *data, uint32_t count, uint32_t millisec = 0, uint8_t prio = 0)
+    {
+        int32_t lock = osKernelLock();
+        uint32_t sent = put_available(data, count, prio);
+        if (sent == 0 && count > 0 && millisec != 0 && lock == 0) {
+            // Queue is full, wait for space with the scheduler running
+            osKernelRestoreLock(lock);
+            if (osMessageQueuePut(_id, &data[0], prio, millisec) != osOK) {
+                return 0;
+            }
+            lock = osKernelLock();
+            sent = 1 + put_available(data + 1, count - 1, prio);
+        }
+
+        unlock(lock, sent);
+        return sent;
+    }
+
+    /** Get several messages from the queue in one batch.
+     *
+     * The timeout specified by the parameter `millisec` specifies how long
+     * the function waits for the first message. Messages that are then
+     * already in the queue are retrieved without blocking, with the
+     * scheduler locked so that a thread waiting to insert is woken at most
+     * once for the whole batch.
+     *
+     * @param  data      Array to store the retrieved elements in.
+     * @param  count     Maximum number of elements to retrieve.
+     * @param  millisec  Timeout to wait for the first message.
+     *                   (default: osWaitForever).
+     *
+     * @return Number of elements retrieved, stored from the start of `data`.
+     *
+     * @note You may call this function from ISR context if the millisec
+     *       parameter is set to 0.
+     */
+    uint32_t get_n(T **data, uint32_t count, uint32_t millisec = osWaitForever)
+    {
+        if (count == 0 || osMessageQueueGet(_id, &data[0], NULL, millisec) != osOK) {
+            return 0;
+        }
+
+        int32_t lock = osKernelLock();
+        uint32_t received = 1;
+        while (received < count && osMessageQueueGet(_id, &data[received], NULL, 0) == osOK) {
+            received++;
+        }
+        unlock(lock, received);
+        return received;
+    }
+
 private:
+    uint32_t put_available(T *const *data, uint32_t count, uint8_t prio)
+    {
+        uint32_t sent = 0;
+        while (sent < count && osMessageQueuePut(_id, &data[sent], prio, 0) == osOK) {
+            sent++;
+        }
+        return sent;
+    }
+
+    void unlock(int32_t lock, uint32_t transferred)
+    {
+        // osKernelLock fails in ISR context, where switching is deferred anyway
+        if (lock >= 0) {
+            osKernelRestoreLock(lock);
+            if (lock == 0 && transferred > 0) {
+                rtos_kernel_dispatch();
+            }
+        }
+    }
+
     osMessageQueueId_t            _id;
     char                          _queue_mem[queue_sz * (sizeof(T *) + sizeof(mbed_rtos_storage_message_t))];
     mbed_rtos_storage_msg_queue_t _obj_mem;
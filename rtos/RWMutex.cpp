@@ -0,0 +1,131 @@
+/* Mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "rtos/RWMutex.h"
+#include "rtos/Kernel.h"
+
+#include "platform/mbed_atomic.h"
+
+namespace rtos {
+
+RWMutex::RWMutex(): _readers_done(0, 1), _readers(0), _writer_waiting(false)
+{
+}
+
+RWMutex::RWMutex(const char *name): _write_mutex(name), _readers_done(0, 1), _readers(0), _writer_waiting(false)
+{
+}
+
+void RWMutex::lock()
+{
+    _write_mutex.lock();
+    wait_readers(osWaitForever);
+}
+
+bool RWMutex::trylock()
+{
+    return trylock_for(0);
+}
+
+bool RWMutex::trylock_for(uint32_t millisec)
+{
+    uint64_t start = Kernel::get_ms_count();
+
+    if (!_write_mutex.trylock_for(millisec)) {
+        return false;
+    }
+
+    if (millisec != osWaitForever) {
+        uint64_t elapsed = Kernel::get_ms_count() - start;
+        millisec = elapsed < millisec ? millisec - elapsed : 0;
+    }
+
+    if (!wait_readers(millisec)) {
+        _write_mutex.unlock();
+        return false;
+    }
+    return true;
+}
+
+void RWMutex::unlock()
+{
+    _write_mutex.unlock();
+}
+
+void RWMutex::lock_shared()
+{
+    // Passing through the write mutex makes new readers queue behind a
+    // waiting writer, and boosts the writer while they wait
+    _write_mutex.lock();
+    core_util_atomic_incr_u32(&_readers, 1);
+    _write_mutex.unlock();
+}
+
+bool RWMutex::trylock_shared()
+{
+    return trylock_shared_for(0);
+}
+
+bool RWMutex::trylock_shared_for(uint32_t millisec)
+{
+    if (!_write_mutex.trylock_for(millisec)) {
+        return false;
+    }
+    core_util_atomic_incr_u32(&_readers, 1);
+    _write_mutex.unlock();
+    return true;
+}
+
+void RWMutex::unlock_shared()
+{
+    if (core_util_atomic_decr_u32(&_readers, 1) == 0 && core_util_atomic_load_bool(&_writer_waiting)) {
+        _readers_done.release();
+    }
+}
+
+// Called with the write mutex held, so no new readers can arrive
+bool RWMutex::wait_readers(uint32_t millisec)
+{
+    uint64_t deadline = Kernel::get_ms_count() + millisec;
+
+    core_util_atomic_store_bool(&_writer_waiting, true);
+    while (core_util_atomic_load_u32(&_readers) != 0) {
+        uint32_t wait = osWaitForever;
+        if (millisec != osWaitForever) {
+            uint64_t now = Kernel::get_ms_count();
+            wait = now < deadline ? deadline - now : 0;
+        }
+        // The last reader may have released between our check and a
+        // previous wait, so a token does not guarantee zero readers
+        if (!_readers_done.try_acquire_for(wait) && core_util_atomic_load_u32(&_readers) != 0) {
+            core_util_atomic_store_bool(&_writer_waiting, false);
+            return false;
+        }
+    }
+    core_util_atomic_store_bool(&_writer_waiting, false);
+    return true;
+}
+
+RWMutex::~RWMutex()
+{
+}
+
+}
@@ -0,0 +1,168 @@
+/* Mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef RWMUTEX_H
+#define RWMUTEX_H
+
+#include <stdint.h>
+#include "rtos/Mutex.h"
+#include "rtos/Semaphore.h"
+
+#include "platform/NonCopyable.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+
+/**
+ * \defgroup rtos_RWMutex RWMutex class
+ * @{
+ */
+
+/** The RWMutex class is a readers-writer lock.
+
+ Any number of threads may hold the lock shared (for reading) at the same
+ time, while only one thread may hold it exclusively (for writing), and only
+ when no readers are present. It suits structures that are looked up far more
+ often than they are modified.
+
+ The lock is writer preferring: once a writer is waiting, new readers block
+ until that writer has finished, so a steady stream of readers cannot starve
+ writers. The exclusive side is built on an rtos::Mutex which is held for the
+ whole write section, so readers and writers blocked behind a writer boost its
+ priority through the mutex priority inheritance. Readers are not tracked by
+ owner and are not boosted while a writer waits for them to leave.
+
+ Example:
+ @code
+ RWMutex table_lock;
+
+ int lookup(int key)
+ {
+     table_lock.lock_shared();
+     int value = table[key];
+     table_lock.unlock_shared();
+     return value;
+ }
+
+ void update(int key, int value)
+ {
+     table_lock.lock();
+     table[key] = value;
+     table_lock.unlock();
+ }
+ @endcode
+
+ @note The exclusive lock is recursive in the same way as rtos::Mutex. The
+ shared lock is not: a thread that already holds it shared must not lock it
+ shared again, as a writer arriving in between would deadlock it. A thread
+ holding the lock shared must not try to take it exclusively.
+
+ @note You cannot use member functions of this class in ISR context.
+*/
+class RWMutex : private mbed::NonCopyable<RWMutex> {
+public:
+    /** Create and Initialize a RWMutex object
+     *
+     * @note You cannot call this function from ISR context.
+    */
+    RWMutex();
+
+    /** Create and Initialize a RWMutex object
+
+     @param name name to be used for the underlying mutex. It has to stay allocated for the lifetime of the object.
+     @note You cannot call this function from ISR context.
+    */
+    RWMutex(const char *name);
+
+    /** Wait until the lock can be held exclusively
+
+      @note You cannot call this function from ISR context.
+     */
+    void lock();
+
+    /** Try to lock exclusively, and return immediately
+      @return true if the lock was acquired, false otherwise.
+      @note equivalent to trylock_for(0)
+
+      @note You cannot call this function from ISR context.
+     */
+    bool trylock();
+
+    /** Try to lock exclusively for a specified time
+      @param   millisec  timeout value.
+      @return true if the lock was acquired, false otherwise.
+
+      @note You cannot call this function from ISR context.
+     */
+    bool trylock_for(uint32_t millisec);
+
+    /** Release an exclusive lock previously taken by the same thread
+
+      @note You cannot call this function from ISR context.
+     */
+    void unlock();
+
+    /** Wait until the lock can be held shared
+
+      @note You cannot call this function from ISR context.
+     */
+    void lock_shared();
+
+    /** Try to lock shared, and return immediately
+      @return true if the lock was acquired, false otherwise.
+
+      @note You cannot call this function from ISR context.
+     */
+    bool trylock_shared();
+
+    /** Try to lock shared for a specified time
+      @param   millisec  timeout value.
+      @return true if the lock was acquired, false otherwise.
+
+      @note You cannot call this function from ISR context.
+     */
+    bool trylock_shared_for(uint32_t millisec);
+
+    /** Release a shared lock
+
+      @note You cannot call this function from ISR context.
+     */
+    void unlock_shared();
+
+    /** RWMutex destructor
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    ~RWMutex();
+
+private:
+    bool wait_readers(uint32_t millisec);
+
+    Mutex _write_mutex;
+    Semaphore _readers_done;
+    volatile uint32_t _readers;
+    volatile bool _writer_waiting;
+};
+/** @}*/
+/** @}*/
+}
+#endif
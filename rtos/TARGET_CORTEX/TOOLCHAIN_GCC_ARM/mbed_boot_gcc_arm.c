@@ -36,6 +36,21 @@ extern uint32_t             __HeapLimit;
 
 extern void __libc_init_array(void);
 
+/* Code run from RAM and ITCM, when the linker script gives it sections of its own, see MBED_RAMFUNC and MBED_ITCM */
+extern uint32_t             __ramfunc_load_start__ __attribute__((weak));
+extern uint32_t             __ramfunc_start__ __attribute__((weak));
+extern uint32_t             __ramfunc_end__ __attribute__((weak));
+extern uint32_t             __itcm_load_start__ __attribute__((weak));
+extern uint32_t             __itcm_start__ __attribute__((weak));
+extern uint32_t             __itcm_end__ __attribute__((weak));
+
+static void mbed_copy_code(uint32_t *load, uint32_t *start, uint32_t *end)
+{
+    while (start < end) {
+        *start++ = *load++;
+    }
+}
+
 /*
  * mbed entry point for the GCC toolchain
  *
@@ -43,6 +58,12 @@ extern void __libc_init_array(void);
  */
 void software_init_hook(void)
 {
+    /* Before the MPU makes the ITCM read only */
+    mbed_copy_code(&__ramfunc_load_start__, &__ramfunc_start__, &__ramfunc_end__);
+    mbed_copy_code(&__itcm_load_start__, &__itcm_start__, &__itcm_end__);
+    __DSB();
+    __ISB();
+
     mbed_stack_isr_start = (unsigned char *) &__StackLimit;
     mbed_stack_isr_size = (uint32_t) &__StackTop - (uint32_t) &__StackLimit;
     mbed_heap_start = (unsigned char *) &__end__;
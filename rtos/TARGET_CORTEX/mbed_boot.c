@@ -63,6 +63,7 @@
 #include "mbed_boot.h"
 #include "mbed_error.h"
 #include "mbed_mpu_mgmt.h"
+#include "platform/mbed_boot_timeline.h"
 
 int main(void);
 static void mbed_cpy_nvic(void);
@@ -74,19 +75,28 @@ uint32_t mbed_stack_isr_size = 0;
 void mbed_init(void)
 {
     mbed_mpu_manager_init();
+#if MBED_CONF_PLATFORM_RAMFUNC_ENABLED
+    /* Functions placed with MBED_RAMFUNC are called for the whole life of the application */
+    mbed_mpu_manager_lock_ram_execution();
+#endif
     mbed_cpy_nvic();
     mbed_sdk_init();
 #if DEVICE_USTICKER && MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
     us_ticker_init();
 #endif
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_SDK_INIT);
     mbed_rtos_init();
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_RTOS_INIT);
 }
 
 void mbed_start(void)
 {
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_RTOS_START);
     mbed_toolchain_init();
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_CXX_INIT);
     mbed_main();
     mbed_error_initialize();
+    MBED_BOOT_TIMELINE_RECORD(MBED_BOOT_STAGE_MAIN);
     main();
 }
 
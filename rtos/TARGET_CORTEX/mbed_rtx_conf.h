@@ -73,6 +73,16 @@
 #define OS_STACK_WATERMARK          1
 #endif
 
+// Per-thread CPU time is accounted from the thread switch hook, timed with the us ticker
+#if (defined(MBED_THREAD_STATS_ENABLED) || defined(MBED_ALL_STATS_ENABLED)) && DEVICE_USTICKER
+#define MBED_RTX_THREAD_CPU_TIME_ENABLED 1
+#endif
+
+// The thread switch hook is also used by the scheduler trace
+#if defined(MBED_RTX_THREAD_CPU_TIME_ENABLED) || defined(MBED_SCHED_TRACE_ENABLED)
+#define MBED_RTX_THREAD_SWITCHED_HOOK_ENABLED 1
+#endif
+
 
 #define OS_IDLE_THREAD_TZ_MOD_ID     1
 #define OS_TIMER_THREAD_TZ_MOD_ID    1
@@ -150,7 +160,10 @@
 #define EVR_RTX_THREAD_BLOCKED_DISABLE
 #define EVR_RTX_THREAD_UNBLOCKED_DISABLE
 #define EVR_RTX_THREAD_PREEMPTED_DISABLE
+// Used for per-thread CPU time and by the scheduler trace, see mbed_rtx_handlers.c
+#if !defined(MBED_RTX_THREAD_SWITCHED_HOOK_ENABLED)
 #define EVR_RTX_THREAD_SWITCHED_DISABLE
+#endif
 #define EVR_RTX_THREAD_DESTROYED_DISABLE
 #define EVR_RTX_THREAD_GET_COUNT_DISABLE
 #define EVR_RTX_THREAD_ENUMERATE_DISABLE
@@ -160,7 +173,10 @@
 #define EVR_RTX_THREAD_FLAGS_CLEAR_DONE_DISABLE
 #define EVR_RTX_THREAD_FLAGS_GET_DISABLE
 #define EVR_RTX_THREAD_FLAGS_WAIT_DISABLE
+// Used by the scheduler trace to record blocking waits
+#if !defined(MBED_SCHED_TRACE_ENABLED)
 #define EVR_RTX_THREAD_FLAGS_WAIT_PENDING_DISABLE
+#endif
 #define EVR_RTX_THREAD_FLAGS_WAIT_TIMEOUT_DISABLE
 #define EVR_RTX_THREAD_FLAGS_WAIT_COMPLETED_DISABLE
 #define EVR_RTX_THREAD_FLAGS_WAIT_NOT_COMPLETED_DISABLE
@@ -189,7 +205,9 @@
 #define EVR_RTX_EVENT_FLAGS_CLEAR_DONE_DISABLE
 #define EVR_RTX_EVENT_FLAGS_GET_DISABLE
 #define EVR_RTX_EVENT_FLAGS_WAIT_DISABLE
+#if !defined(MBED_SCHED_TRACE_ENABLED)
 #define EVR_RTX_EVENT_FLAGS_WAIT_PENDING_DISABLE
+#endif
 #define EVR_RTX_EVENT_FLAGS_WAIT_TIMEOUT_DISABLE
 #define EVR_RTX_EVENT_FLAGS_WAIT_COMPLETED_DISABLE
 #define EVR_RTX_EVENT_FLAGS_WAIT_NOT_COMPLETED_DISABLE
@@ -199,7 +217,9 @@
 #define EVR_RTX_MUTEX_CREATED_DISABLE
 #define EVR_RTX_MUTEX_GET_NAME_DISABLE
 #define EVR_RTX_MUTEX_ACQUIRE_DISABLE
+#if !defined(MBED_SCHED_TRACE_ENABLED)
 #define EVR_RTX_MUTEX_ACQUIRE_PENDING_DISABLE
+#endif
 #define EVR_RTX_MUTEX_ACQUIRE_TIMEOUT_DISABLE
 #define EVR_RTX_MUTEX_ACQUIRED_DISABLE
 #define EVR_RTX_MUTEX_NOT_ACQUIRED_DISABLE
@@ -212,7 +232,9 @@
 #define EVR_RTX_SEMAPHORE_CREATED_DISABLE
 #define EVR_RTX_SEMAPHORE_GET_NAME_DISABLE
 #define EVR_RTX_SEMAPHORE_ACQUIRE_DISABLE
+#if !defined(MBED_SCHED_TRACE_ENABLED)
 #define EVR_RTX_SEMAPHORE_ACQUIRE_PENDING_DISABLE
+#endif
 #define EVR_RTX_SEMAPHORE_ACQUIRE_TIMEOUT_DISABLE
 #define EVR_RTX_SEMAPHORE_ACQUIRED_DISABLE
 #define EVR_RTX_SEMAPHORE_NOT_ACQUIRED_DISABLE
@@ -242,13 +264,17 @@
 #define EVR_RTX_MESSAGE_QUEUE_CREATED_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_GET_NAME_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_PUT_DISABLE
+#if !defined(MBED_SCHED_TRACE_ENABLED)
 #define EVR_RTX_MESSAGE_QUEUE_PUT_PENDING_DISABLE
+#endif
 #define EVR_RTX_MESSAGE_QUEUE_PUT_TIMEOUT_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_INSERT_PENDING_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_INSERTED_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_NOT_INSERTED_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_GET_DISABLE
+#if !defined(MBED_SCHED_TRACE_ENABLED)
 #define EVR_RTX_MESSAGE_QUEUE_GET_PENDING_DISABLE
+#endif
 #define EVR_RTX_MESSAGE_QUEUE_GET_TIMEOUT_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_RETRIEVED_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_NOT_RETRIEVED_DISABLE
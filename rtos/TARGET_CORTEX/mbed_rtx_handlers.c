@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 
+#include <stdbool.h>
+#include "cmsis.h"
 #include "cmsis_compiler.h"
 #include "rtx_os.h"
 #include "rtx_evr.h"
@@ -24,6 +26,10 @@
 #include "RTX_Config.h"
 #include "rtos/rtos_handlers.h"
 #include "rtos/rtos_idle.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_stats.h"
+#include "platform/mbed_sched_trace.h"
+#include "hal/us_ticker_api.h"
 
 #ifdef RTE_Compiler_EventRecorder
 #include "EventRecorder.h"              // Keil::Compiler:Event Recorder
@@ -32,10 +38,123 @@
 #define EvtRtxThreadTerminate          EventID(EventLevelAPI, 0xF2U, 0x1AU)
 #endif
 
+#if MBED_RTX_THREAD_CPU_TIME_ENABLED
+
+#ifndef MBED_CONF_RTOS_THREAD_CPU_TIME_SLOTS
+#define MBED_CONF_RTOS_THREAD_CPU_TIME_SLOTS 16
+#endif
+
+typedef struct {
+    osThreadId_t thread;
+    uint64_t time;
+} thread_cpu_time_t;
+
+/* Accumulated run time of each thread. Only touched from the RTX handlers,
+ * which all run at the same exception priority, or with interrupts masked.
+ */
+static thread_cpu_time_t cpu_times[MBED_CONF_RTOS_THREAD_CPU_TIME_SLOTS];
+static thread_cpu_time_t *cpu_time_curr;
+static us_timestamp_t cpu_time_switched;
+
+static thread_cpu_time_t *cpu_time_find(osThreadId_t id, bool insert)
+{
+    thread_cpu_time_t *free_slot = NULL;
+    for (int i = 0; i < MBED_CONF_RTOS_THREAD_CPU_TIME_SLOTS; i++) {
+        if (cpu_times[i].thread == id) {
+            return &cpu_times[i];
+        }
+        if (!free_slot && !cpu_times[i].thread) {
+            free_slot = &cpu_times[i];
+        }
+    }
+
+    if (insert && free_slot) {
+        free_slot->thread = id;
+        free_slot->time = 0;
+        return free_slot;
+    }
+    return NULL;
+}
+
+#endif
+
+#if MBED_RTX_THREAD_SWITCHED_HOOK_ENABLED
+// RTX hook which gets called when the kernel picks the next thread to run
+void EvrRtxThreadSwitched(osThreadId_t thread_id)
+{
+#if MBED_RTX_THREAD_CPU_TIME_ENABLED
+    us_timestamp_t now = ticker_read_us(get_us_ticker_data());
+    if (cpu_time_curr) {
+        cpu_time_curr->time += now - cpu_time_switched;
+    }
+    cpu_time_switched = now;
+    cpu_time_curr = cpu_time_find(thread_id, true);
+#endif
+    mbed_sched_trace_record(MBED_SCHED_TRACE_THREAD_SWITCH, (uint32_t)thread_id);
+}
+#endif
+
+#if defined(MBED_SCHED_TRACE_ENABLED)
+// RTX hooks which get called when a thread is about to block
+void EvrRtxThreadFlagsWaitPending(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    mbed_sched_trace_record(MBED_SCHED_TRACE_THREAD_FLAGS_WAIT, flags);
+}
+
+void EvrRtxEventFlagsWaitPending(osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    mbed_sched_trace_record(MBED_SCHED_TRACE_EVENT_FLAGS_WAIT, (uint32_t)ef_id);
+}
+
+void EvrRtxMutexAcquirePending(osMutexId_t mutex_id, uint32_t timeout)
+{
+    mbed_sched_trace_record(MBED_SCHED_TRACE_MUTEX_WAIT, (uint32_t)mutex_id);
+}
+
+void EvrRtxSemaphoreAcquirePending(osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+    mbed_sched_trace_record(MBED_SCHED_TRACE_SEMAPHORE_WAIT, (uint32_t)semaphore_id);
+}
+
+void EvrRtxMessageQueuePutPending(osMessageQueueId_t mq_id, const void *msg_ptr, uint32_t timeout)
+{
+    mbed_sched_trace_record(MBED_SCHED_TRACE_QUEUE_PUT_WAIT, (uint32_t)mq_id);
+}
+
+void EvrRtxMessageQueueGetPending(osMessageQueueId_t mq_id, void *msg_ptr, uint32_t timeout)
+{
+    mbed_sched_trace_record(MBED_SCHED_TRACE_QUEUE_GET_WAIT, (uint32_t)mq_id);
+}
+#endif
+
+uint64_t rtos_thread_cpu_time(osThreadId_t id)
+{
+    uint64_t time = 0;
+#if MBED_RTX_THREAD_CPU_TIME_ENABLED
+    core_util_critical_section_enter();
+    thread_cpu_time_t *t = cpu_time_find(id, false);
+    if (t) {
+        time = t->time;
+        if (t == cpu_time_curr) {
+            time += ticker_read_us(get_us_ticker_data()) - cpu_time_switched;
+        }
+    }
+    core_util_critical_section_exit();
+#endif
+    return time;
+}
+
 static void (*terminate_hook)(osThreadId_t id);
 
 static void thread_terminate_hook(osThreadId_t id)
 {
+#if MBED_RTX_THREAD_CPU_TIME_ENABLED
+    // Free the slot, a later thread may reuse the same control block
+    thread_cpu_time_t *t = cpu_time_find(id, false);
+    if (t) {
+        t->thread = NULL;
+    }
+#endif
     if (terminate_hook) {
         terminate_hook(id);
     }
@@ -46,6 +165,18 @@ void rtos_attach_thread_terminate_hook(void (*fptr)(osThreadId_t id))
     terminate_hook = fptr;
 }
 
+void rtos_kernel_dispatch(void)
+{
+#if defined(__CORTEX_M)
+    // RTX's PendSV handler finishes by dispatching the highest priority ready thread
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    __DSB();
+    __ISB();
+#else
+    osThreadYield();
+#endif
+}
+
 __NO_RETURN void osRtxIdleThread(void *argument)
 {
     rtos_idle_loop();
@@ -22,6 +22,8 @@
 
 #include "rtos/rtos_idle.h"
 #include "platform/mbed_power_mgmt.h"
+#include "platform/mbed_stats.h"
+#include "platform/mbed_sched_trace.h"
 #include "TimerEvent.h"
 #include "lp_ticker_api.h"
 #include "us_ticker_api.h"
@@ -170,6 +172,12 @@ extern "C" {
     {
         //Continuously call the idle hook function pointer
         while (1) {
+#if defined(MBED_STACK_STATS_ENABLED)
+            mbed_stats_stack_watermark_update();
+#endif
+#if defined(MBED_SCHED_TRACE_ENABLED) && DEVICE_ITM && MBED_CONF_PLATFORM_SCHED_TRACE_SWO_IDLE_FLUSH
+            mbed_sched_trace_swo_flush();
+#endif
             idle_hook_fptr();
         }
     }
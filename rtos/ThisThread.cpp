@@ -26,6 +26,8 @@
 #include "rtos/Kernel.h"
 #include "rtos/rtos_idle.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "rtx_os.h"
 
 namespace rtos {
 
@@ -108,6 +110,61 @@ void ThisThread::sleep_for(uint32_t millisec)
     MBED_ASSERT(status == osOK);
 }
 
+// Delay of the earliest kernel wake-up, a delayed thread or a timer, that
+// falls between millisec and millisec + slack from now, or 0 if there is none.
+// Both lists hold their delays relative to the previous entry.
+static uint32_t coalesce_delay(uint32_t millisec, uint32_t slack)
+{
+    uint32_t delay = 0;
+    uint32_t tick = 0;
+
+    core_util_critical_section_enter();
+    for (osRtxThread_t *thread = osRtxInfo.thread.delay_list; thread != NULL; thread = thread->delay_next) {
+        tick += thread->delay;
+        if (tick >= millisec) {
+            if (tick - millisec <= slack) {
+                delay = tick;
+            }
+            break;
+        }
+    }
+
+    tick = 0;
+    for (osRtxTimer_t *timer = osRtxInfo.timer.list; timer != NULL; timer = timer->next) {
+        tick += timer->tick;
+        if (tick >= millisec) {
+            if (tick - millisec <= slack && (delay == 0 || tick < delay)) {
+                delay = tick;
+            }
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+
+    return delay;
+}
+
+void ThisThread::sleep_for(uint32_t millisec, uint32_t slack)
+{
+    if (slack != 0 && millisec < osWaitForever && slack < osWaitForever - millisec) {
+        uint32_t delay = coalesce_delay(millisec, slack);
+        if (delay == 0) {
+            // Nothing to join, round the wake-up time up to a multiple of the
+            // largest power of two not above slack, so that other sleepers
+            // with similar slack wake on the same tick
+            uint32_t grain = 1;
+            while (grain <= slack / 2) {
+                grain <<= 1;
+            }
+            uint64_t target = Kernel::get_ms_count() + millisec;
+            delay = millisec + (uint32_t)(-target & (grain - 1));
+        }
+        millisec = delay;
+    }
+
+    sleep_for(millisec);
+}
+
 void ThisThread::sleep_until(uint64_t millisec)
 {
     // CMSIS-RTOS 2.1.0 had 64-bit time and osDelayUntil, but that's been revoked.
@@ -157,6 +157,16 @@ uint32_t flags_wait_any_until(uint32_t flags, uint64_t millisec, bool clear = tr
 */
 void sleep_for(uint32_t millisec);
 
+/** Sleep for a specified time period in millisec, allowing a late wake-up
+  The thread may sleep up to @a slack millisec longer than requested, so that
+  it wakes together with other threads or timers due in that window rather
+  than on a tick of its own. This reduces how often the system leaves sleep.
+  @param   millisec  minimum time delay value
+  @param   slack     how much longer, in millisec, the thread may sleep
+  @note You cannot call this function from ISR context.
+*/
+void sleep_for(uint32_t millisec, uint32_t slack);
+
 /** Sleep until a specified time in millisec
   The specified time is according to Kernel::get_ms_count().
   @param   millisec absolute time in millisec
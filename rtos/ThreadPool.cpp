@@ -0,0 +1,288 @@
+/* Mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "rtos/ThreadPool.h"
+#include "rtos/ThisThread.h"
+
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+
+namespace rtos {
+
+ThreadPool::Task::Task(mbed::Callback<void()> func): _func(func), _done(0, 1), _state(Idle)
+{
+}
+
+void ThreadPool::Task::set(mbed::Callback<void()> func)
+{
+    MBED_ASSERT(_state != Queued && _state != Running);
+    _func = func;
+}
+
+bool ThreadPool::Task::done() const
+{
+    return _state == Done;
+}
+
+void ThreadPool::Task::wait()
+{
+    // Put the token back, so every waiter sees the task done
+    _done.acquire();
+    _done.release();
+}
+
+bool ThreadPool::Task::wait_for(uint32_t millisec)
+{
+    if (!_done.try_acquire_for(millisec)) {
+        return false;
+    }
+    _done.release();
+    return true;
+}
+
+ThreadPool::ThreadPool(uint32_t workers, osPriority priority, uint32_t stack_size, uint32_t queue_size, const char *name)
+    : _worker_count(workers), _queue_size(queue_size), _next_worker(0), _work(0), _stopping(false),
+      _for_begin(0), _for_end(0), _for_grain(0), _for_chunks(0), _for_next(0)
+{
+    MBED_ASSERT(workers > 0 && queue_size > 0);
+
+    _workers = new Worker[workers];
+    for (uint32_t i = 0; i < workers; i++) {
+        _workers[i].queue = new Task *[queue_size];
+        _workers[i].head = 0;
+        _workers[i].tail = 0;
+        _workers[i].for_task.set(mbed::callback(this, &ThreadPool::run_chunks));
+        _workers[i].thread = new Thread(priority, stack_size, NULL, name);
+    }
+    for (uint32_t i = 0; i < workers; i++) {
+        _workers[i].thread->start(mbed::callback(this, &ThreadPool::worker_main));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    _stopping = true;
+    for (uint32_t i = 0; i < _worker_count; i++) {
+        _work.release();
+    }
+    for (uint32_t i = 0; i < _worker_count; i++) {
+        _workers[i].thread->join();
+        delete _workers[i].thread;
+        delete[] _workers[i].queue;
+    }
+    delete[] _workers;
+}
+
+uint32_t ThreadPool::workers() const
+{
+    return _worker_count;
+}
+
+bool ThreadPool::submit(Task &task)
+{
+    core_util_critical_section_enter();
+
+    if (task._state == Task::Queued || task._state == Task::Running) {
+        core_util_critical_section_exit();
+        return false;
+    }
+
+    // A worker keeps the jobs it creates, others are spread in turn
+    uint32_t index = current_worker();
+    if (index == _worker_count) {
+        index = _next_worker;
+        _next_worker = (_next_worker + 1) % _worker_count;
+    }
+
+    bool queued = false;
+    for (uint32_t i = 0; i < _worker_count && !queued; i++) {
+        if (task._state == Task::Done) {
+            // Drop the token left for waiters of the previous run
+            task._done.try_acquire();
+        }
+        task._state = Task::Queued;
+        queued = push((index + i) % _worker_count, &task);
+        if (!queued) {
+            task._state = Task::Idle;
+        }
+    }
+
+    core_util_critical_section_exit();
+
+    if (queued) {
+        _work.release();
+    }
+    return queued;
+}
+
+void ThreadPool::wait(Task &task)
+{
+    uint32_t index = current_worker();
+
+    while (!task.done()) {
+        Task *job = take(index);
+        if (!job) {
+            // Nothing left to run, the task is running on another thread
+            task.wait();
+            return;
+        }
+        run(job);
+    }
+}
+
+void ThreadPool::parallel_for(uint32_t begin, uint32_t end, mbed::Callback<void(uint32_t, uint32_t)> body, uint32_t grain)
+{
+    if (begin >= end) {
+        return;
+    }
+    if (!grain) {
+        grain = 1;
+    }
+
+    _for_mutex.lock();
+
+    _for_body = body;
+    _for_begin = begin;
+    _for_end = end;
+    _for_grain = grain;
+    _for_chunks = (end - begin - 1) / grain + 1;
+    _for_next = 0;
+
+    // One helper job per worker, the calling thread takes its share of the chunks too
+    uint32_t helpers = 0;
+    while (helpers < _worker_count && helpers < _for_chunks - 1 && submit(_workers[helpers].for_task)) {
+        helpers++;
+    }
+
+    run_chunks();
+
+    for (uint32_t i = 0; i < helpers; i++) {
+        wait(_workers[i].for_task);
+    }
+
+    _for_mutex.unlock();
+}
+
+void ThreadPool::worker_main()
+{
+    uint32_t index = current_worker();
+
+    while (true) {
+        _work.acquire();
+        if (_stopping) {
+            break;
+        }
+        // Every job comes with a token, but the job may already have been taken by a waiting thread
+        Task *job = take(index);
+        if (job) {
+            run(job);
+        }
+    }
+}
+
+uint32_t ThreadPool::current_worker()
+{
+    osThreadId_t id = ThisThread::get_id();
+
+    for (uint32_t i = 0; i < _worker_count; i++) {
+        if (_workers[i].thread->get_id() == id) {
+            return i;
+        }
+    }
+    return _worker_count;
+}
+
+bool ThreadPool::push(uint32_t index, Task *task)
+{
+    Worker &worker = _workers[index];
+
+    core_util_critical_section_enter();
+
+    bool pushed = (worker.tail - worker.head) < _queue_size;
+    if (pushed) {
+        worker.queue[worker.tail % _queue_size] = task;
+        worker.tail++;
+    }
+
+    core_util_critical_section_exit();
+
+    return pushed;
+}
+
+ThreadPool::Task *ThreadPool::take(uint32_t index)
+{
+    Task *task = NULL;
+
+    core_util_critical_section_enter();
+
+    // Newest of the own jobs first, its data is the most likely to be cached
+    if (index < _worker_count) {
+        Worker &worker = _workers[index];
+        if (worker.tail != worker.head) {
+            worker.tail--;
+            task = worker.queue[worker.tail % _queue_size];
+        }
+    }
+
+    // Otherwise steal the oldest job of another worker
+    for (uint32_t i = 1; i <= _worker_count && !task; i++) {
+        Worker &worker = _workers[(index + i) % _worker_count];
+        if (worker.tail != worker.head) {
+            task = worker.queue[worker.head % _queue_size];
+            worker.head++;
+        }
+    }
+
+    if (task) {
+        task->_state = Task::Running;
+    }
+
+    core_util_critical_section_exit();
+
+    return task;
+}
+
+void ThreadPool::run(Task *task)
+{
+    if (task->_func) {
+        task->_func();
+    }
+
+    // Together, so a task submitted again never inherits the token of this run
+    core_util_critical_section_enter();
+    task->_state = Task::Done;
+    task->_done.release();
+    core_util_critical_section_exit();
+}
+
+void ThreadPool::run_chunks()
+{
+    uint32_t chunk;
+
+    while ((chunk = core_util_atomic_fetch_add_u32(&_for_next, 1)) < _for_chunks) {
+        uint32_t first = _for_begin + chunk * _for_grain;
+        uint32_t last = (_for_end - first > _for_grain) ? first + _for_grain : _for_end;
+        _for_body(first, last);
+    }
+}
+
+}
@@ -0,0 +1,257 @@
+/* Mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stdint.h>
+#include "rtos/Thread.h"
+#include "rtos/Mutex.h"
+#include "rtos/Semaphore.h"
+
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+#ifndef MBED_CONF_RTOS_THREAD_POOL_WORKERS
+#define MBED_CONF_RTOS_THREAD_POOL_WORKERS 2
+#endif
+
+#ifndef MBED_CONF_RTOS_THREAD_POOL_QUEUE_SIZE
+#define MBED_CONF_RTOS_THREAD_POOL_QUEUE_SIZE 16
+#endif
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+
+/**
+ * \defgroup rtos_ThreadPool ThreadPool class
+ * @{
+ */
+
+/** The ThreadPool class runs jobs on a fixed set of worker threads.
+
+ The worker threads and their stacks are created once, with the pool, so
+ running a job costs no thread creation. Each worker has its own queue of
+ jobs: a worker runs the jobs it queued itself newest first, and when its
+ queue is empty takes the oldest job from the queue of another worker. Jobs
+ queued from outside the pool are spread over the workers in turn.
+
+ A job is a ThreadPool::Task owned by the caller, which also serves as the
+ future the caller waits on for the job to complete. Nothing is allocated
+ when a job is submitted.
+
+ Example:
+ @code
+ ThreadPool pool;
+
+ void filter_rows(uint32_t first, uint32_t last)
+ {
+     for (uint32_t row = first; row < last; row++) {
+         filter_row(image, row);
+     }
+ }
+
+ void process()
+ {
+     ThreadPool::Task checksum_task(compute_checksum);
+     pool.submit(checksum_task);
+
+     // Rows in chunks of 8, spread over the workers and this thread
+     pool.parallel_for(0, IMAGE_HEIGHT, filter_rows, 8);
+
+     pool.wait(checksum_task);
+ }
+ @endcode
+
+ @note RTX schedules threads on a single core, so the workers run
+ concurrently with each other and with the submitting thread rather than in
+ parallel. On multi-core devices each core runs its own kernel and a pool
+ only uses the core it was created on.
+*/
+class ThreadPool : private mbed::NonCopyable<ThreadPool> {
+public:
+    /** A job run by a ThreadPool, and the future for its completion
+
+     A task can be submitted again once it has completed.
+    */
+    class Task : private mbed::NonCopyable<Task> {
+    public:
+        /** Create a task
+
+          @param func   function run by the task
+        */
+        Task(mbed::Callback<void()> func = nullptr);
+
+        /** Change the function run by the task
+
+          @param func   function run by the task
+          @note The task must not be queued or running.
+        */
+        void set(mbed::Callback<void()> func);
+
+        /** Check if the task has completed since it was last submitted
+
+          @return true if the task has completed
+        */
+        bool done() const;
+
+        /** Wait for the task to complete
+
+          Use ThreadPool::wait instead from a worker thread of the pool, as a
+          worker blocked here does not run jobs.
+
+          @note You cannot call this function from ISR context.
+        */
+        void wait();
+
+        /** Wait for the task to complete for a specified time
+
+          @param   millisec  timeout value.
+          @return true if the task has completed, false otherwise.
+
+          @note You cannot call this function from ISR context.
+        */
+        bool wait_for(uint32_t millisec);
+
+    private:
+        friend class ThreadPool;
+
+        enum State {
+            Idle,
+            Queued,
+            Running,
+            Done
+        };
+
+        mbed::Callback<void()> _func;
+        Semaphore _done;
+        volatile uint8_t _state;
+    };
+
+    /** Create a ThreadPool and start its workers
+
+      @param   workers      number of worker threads (default: rtos.thread-pool-workers).
+      @param   priority     priority of the worker threads (default: osPriorityNormal).
+      @param   stack_size   stack size (in bytes) of each worker thread (default: OS_STACK_SIZE).
+      @param   queue_size   number of jobs each worker can queue (default: rtos.thread-pool-queue-size).
+      @param   name         name of the worker threads. It has to stay allocated for the lifetime of the pool (default: NULL)
+
+      @note You cannot call this function from ISR context.
+    */
+    ThreadPool(uint32_t workers = MBED_CONF_RTOS_THREAD_POOL_WORKERS,
+               osPriority priority = osPriorityNormal,
+               uint32_t stack_size = OS_STACK_SIZE,
+               uint32_t queue_size = MBED_CONF_RTOS_THREAD_POOL_QUEUE_SIZE,
+               const char *name = NULL);
+
+    /** Queue a task to be run by a worker
+
+      A task submitted by a worker of the pool is queued to that worker,
+      otherwise the workers are used in turn.
+
+      @param   task  task to run. It has to stay allocated until it has completed.
+      @return true if the task was queued, false if it is already queued or
+              running or every queue is full.
+
+      @note You may call this function from ISR context.
+    */
+    bool submit(Task &task);
+
+    /** Wait for a task to complete, running queued jobs meanwhile
+
+      The calling thread runs queued jobs, the task itself first if it is still
+      queued, until the task has completed or no job is left to run. Workers
+      waiting for each other this way cannot deadlock the pool.
+
+      @param   task  task to wait for
+
+      @note You cannot call this function from ISR context.
+    */
+    void wait(Task &task);
+
+    /** Run a function over a range, spread over the workers and the calling thread
+
+      The range is cut in chunks of @a grain indexes, and @a body is called with
+      the first and past-the-end index of each chunk. Chunks are handed out as
+      threads become free, so uneven chunks balance out. Returns once every
+      chunk has been run.
+
+      @param   begin  first index of the range
+      @param   end    past-the-end index of the range
+      @param   body   function run for each chunk
+      @param   grain  number of indexes in a chunk (default: 1)
+
+      @note One parallel_for runs at a time per pool, and @a body must not call
+            parallel_for on the same pool.
+      @note You cannot call this function from ISR context.
+    */
+    void parallel_for(uint32_t begin, uint32_t end, mbed::Callback<void(uint32_t, uint32_t)> body, uint32_t grain = 1);
+
+    /** Get the number of worker threads
+
+      @return number of worker threads
+    */
+    uint32_t workers() const;
+
+    /** Stop the workers and destroy the ThreadPool
+
+      Tasks still queued are not run and must not be waited for.
+
+      @note You cannot call this function from ISR context.
+    */
+    ~ThreadPool();
+
+private:
+    struct Worker {
+        Thread *thread;
+        Task **queue;
+        uint32_t head;
+        uint32_t tail;
+        Task for_task;
+    };
+
+    void worker_main();
+    uint32_t current_worker();
+    bool push(uint32_t index, Task *task);
+    Task *take(uint32_t index);
+    void run(Task *task);
+    void run_chunks();
+
+    Worker *_workers;
+    uint32_t _worker_count;
+    uint32_t _queue_size;
+    uint32_t _next_worker;
+    Semaphore _work;
+    volatile bool _stopping;
+
+    Mutex _for_mutex;
+    mbed::Callback<void(uint32_t, uint32_t)> _for_body;
+    uint32_t _for_begin;
+    uint32_t _for_end;
+    uint32_t _for_grain;
+    uint32_t _for_chunks;
+    volatile uint32_t _for_next;
+};
+/** @}*/
+/** @}*/
+}
+#endif
@@ -30,6 +30,7 @@
 #include "rtos/Thread.h"
 #include "rtos/ThisThread.h"
 #include "rtos/Mutex.h"
+#include "rtos/RWMutex.h"
 #include "rtos/RtosTimer.h"
 #include "rtos/Semaphore.h"
 #include "rtos/Mail.h"
@@ -37,6 +38,7 @@
 #include "rtos/Queue.h"
 #include "rtos/EventFlags.h"
 #include "rtos/ConditionVariable.h"
+#include "rtos/ThreadPool.h"
 
 #ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
 using namespace rtos;
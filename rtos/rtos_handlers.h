@@ -43,6 +43,21 @@ extern "C" {
 void rtos_attach_thread_terminate_hook(void (*fptr)(osThreadId_t id));
 /** @}*/
 
+/** @cond INTERNAL */
+/* Let the scheduler switch to a higher priority thread that was made ready
+ * while the kernel was locked. RTX does not reschedule when the kernel lock
+ * is released, so batch operations performed under the lock call this after
+ * restoring it.
+ */
+void rtos_kernel_dispatch(void);
+
+/* Time in microseconds the thread has spent running, including the current
+ * time slice if it is running now. Only accounted when thread stats are
+ * enabled, otherwise 0.
+ */
+uint64_t rtos_thread_cpu_time(osThreadId_t id);
+/** @endcond */
+
 #ifdef __cplusplus
 }
 #endif
@@ -88,6 +88,12 @@ uint8_t flash_get_erase_value(const flash_t *obj)
     return obj->info.erase_value;
 }
 
+const void *flash_get_mapped_address(const flash_t *obj, uint32_t address)
+{
+    // Reads go through cyhal_flash_read
+    return NULL;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -72,6 +72,7 @@
 #define CY_M0_CORE_IRQ_CHANNEL_IPC_USR      ((IRQn_Type)2)
 #define CY_M0_CORE_IRQ_CHANNEL_PSA_MAILBOX  ((IRQn_Type)3)
 #define CY_M0_CORE_IRQ_CHANNEL_SERIAL       ((IRQn_Type)4)
+#define CY_M0_CORE_IRQ_CHANNEL_IPC_MBED     ((IRQn_Type)5)
 #define CY_M0_CORE_IRQ_CHANNEL_BLE          ((IRQn_Type)7)
 #define CY_M0_CORE_IRQ_CHANNEL_US_TICKER    ((IRQn_Type)8)
 
@@ -83,4 +84,12 @@
 #define CY_GPIO_IRQN_ID                     (0x400)
 #define CY_LP_TICKER_IRQN_ID                (0x500)
 #define CY_PSA_MAILBOX_IRQN_ID              (0x600)
+#define CY_IPC_MBED_IRQN_ID                 (0x700)
+
+/** Inter-core signalling between the application images of both cores,
+ * see ipc_api.c.
+ */
+#ifndef DEVICE_IPC
+#define DEVICE_IPC                          1
+#endif
 #endif
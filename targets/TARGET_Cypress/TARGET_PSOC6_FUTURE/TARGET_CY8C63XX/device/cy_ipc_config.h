@@ -187,6 +187,31 @@
                                             | CY_IPC_CHAN_RPCPIPE_CM4)
 #define CY_IPC_RPCPIPE_INTR_MASK   (uint32_t)( CY_IPC_RPCPIPE_CHAN_MASK_EP0 | CY_IPC_RPCPIPE_CHAN_MASK_EP1 )
 
+/* IPC channels notified by the mbed inter-core HAL (ipc_api.c) */
+#define CY_IPC_CHAN_MBED_FIRST           (uint32_t)(12u)
+#define CY_IPC_CHAN_MBED_COUNT           (uint32_t)(4u)
+/* The DATA register of the first channel holds the address of the shared memory */
+#define CY_IPC_CHAN_MBED_SHARED          CY_IPC_CHAN_MBED_FIRST
+
+#define CY_IPC_INTR_MBED_CM0             (uint32_t)(12u)
+#define CY_IPC_INTR_MBED_CM4             (uint32_t)(13u)
+#define CY_IPC_INTR_MBED_PRIOR           (uint32_t)(3u)
+
+#if (CY_CPU_CORTEX_M0P)
+    #define CY_IPC_INTR_MBED             CY_IPC_INTR_MBED_CM0
+    #define CY_IPC_INTR_MBED_DEST        CY_IPC_INTR_MBED_CM4
+#else
+    #define CY_IPC_INTR_MBED             CY_IPC_INTR_MBED_CM4
+    #define CY_IPC_INTR_MBED_DEST        CY_IPC_INTR_MBED_CM0
+#endif
+
+#define CY_IPC_MBED_CHAN_MASK            (uint32_t)(((0x0001ul << CY_IPC_CHAN_MBED_COUNT) - 1u) << CY_IPC_CHAN_MBED_FIRST)
+
+/* Size of the memory shared by the application images, owned by the CM0+ image */
+#ifndef CY_IPC_MBED_SHARED_SIZE
+#define CY_IPC_MBED_SHARED_SIZE          (uint32_t)(4096u)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
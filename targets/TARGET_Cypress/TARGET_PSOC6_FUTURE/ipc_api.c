@@ -0,0 +1,145 @@
+/*
+ * mbed Microcontroller Library
+ * Copyright (c) 2017-2019 Future Electronics
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include "device.h"
+#include "mbed_error.h"
+#include "ipc_api.h"
+#include "cy_ipc_config.h"
+#include "cy_ipc_drv.h"
+#include "cy_sysint.h"
+#include "psoc6_utils.h"
+
+#if DEVICE_IPC
+
+/*
+ * Inter-core signalling on PSoC6 uses IPC structures CY_IPC_CHAN_MBED_FIRST and up,
+ * one per channel. A core notifies a channel with the notify event of its IPC
+ * structure, which is routed to the interrupt structure of the other core only.
+ * The structures are never locked, so notifying does not wait for the other core.
+ *
+ * Neither the CM0+ nor the CM4 of PSoC6 has a data cache, so the shared memory
+ * needs no cache maintenance, only the memory barriers the callers already use.
+ */
+
+#if defined(TARGET_MCU_PSOC6_M0)
+#define IPC_INTERRUPT_SOURCE    cpuss_interrupts_ipc_12_IRQn
+#else
+#define IPC_INTERRUPT_SOURCE    cpuss_interrupts_ipc_13_IRQn
+#endif
+
+static ipc_handler_t ipc_handler;
+
+// Interrupt configuration.
+static cy_stc_sysint_t ipc_sysint_config = {
+#if defined(TARGET_MCU_PSOC6_M0)
+    .intrSrc = CY_M0_CORE_IRQ_CHANNEL_IPC_MBED,
+    .cm0pSrc = IPC_INTERRUPT_SOURCE,
+#else
+    .intrSrc = IPC_INTERRUPT_SOURCE,
+#endif
+    .intrPriority = CY_IPC_INTR_MBED_PRIOR
+};
+
+#if defined(TARGET_MCU_PSOC6_M0)
+// The shared memory belongs to the CM0+ image, which publishes its address to the CM4.
+static uint8_t ipc_shared_memory[CY_IPC_MBED_SHARED_SIZE] CY_ALIGN(32);
+
+static void ipc_publish_shared_memory(void)
+{
+    Cy_IPC_Drv_WriteDataValue(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_MBED_SHARED),
+                              (uint32_t)ipc_shared_memory);
+}
+#endif
+
+static void ipc_irq_handler(void)
+{
+    IPC_INTR_STRUCT_Type *intr = Cy_IPC_Drv_GetIntrBaseAddr(CY_IPC_INTR_MBED);
+    uint32_t notified = Cy_IPC_Drv_ExtractAcquireMask(Cy_IPC_Drv_GetInterruptStatusMasked(intr));
+
+    Cy_IPC_Drv_ClearInterrupt(intr, CY_IPC_NO_NOTIFICATION, notified);
+    // Read back to make sure the clear completed before returning from the interrupt.
+    (void)Cy_IPC_Drv_GetInterruptStatusMasked(intr);
+
+    for (uint32_t channel = 0; channel < CY_IPC_CHAN_MBED_COUNT; channel++) {
+        if (notified & (1UL << (CY_IPC_CHAN_MBED_FIRST + channel))) {
+            ipc_handler(channel);
+        }
+    }
+}
+
+void ipc_init(ipc_handler_t handler)
+{
+    IPC_INTR_STRUCT_Type *intr = Cy_IPC_Drv_GetIntrBaseAddr(CY_IPC_INTR_MBED);
+
+    ipc_handler = handler;
+
+#if defined(TARGET_MCU_PSOC6_M0)
+    ipc_publish_shared_memory();
+    // Reserve NVIC channel.
+    if (cy_m0_nvic_reserve_channel(CY_M0_CORE_IRQ_CHANNEL_IPC_MBED, CY_IPC_MBED_IRQN_ID) == (IRQn_Type)(-1)) {
+        // No free NVIC channel.
+        error("IPC NVIC channel reservation conflict.");
+    }
+#endif
+
+    // Drop notifications sent before this core was listening, the channels poll their rings on creation.
+    Cy_IPC_Drv_ClearInterrupt(intr, CY_IPC_NO_NOTIFICATION, CY_IPC_MBED_CHAN_MASK);
+    Cy_IPC_Drv_SetInterruptMask(intr, CY_IPC_NO_NOTIFICATION, CY_IPC_MBED_CHAN_MASK);
+
+    Cy_SysInt_Init(&ipc_sysint_config, ipc_irq_handler);
+    NVIC_EnableIRQ(ipc_sysint_config.intrSrc);
+}
+
+void ipc_free(void)
+{
+    NVIC_DisableIRQ(ipc_sysint_config.intrSrc);
+    Cy_IPC_Drv_SetInterruptMask(Cy_IPC_Drv_GetIntrBaseAddr(CY_IPC_INTR_MBED),
+                                CY_IPC_NO_NOTIFICATION, CY_IPC_NO_NOTIFICATION);
+#if defined(TARGET_MCU_PSOC6_M0)
+    cy_m0_nvic_release_channel(ipc_sysint_config.intrSrc, CY_IPC_MBED_IRQN_ID);
+#endif
+    ipc_handler = NULL;
+}
+
+uint32_t ipc_get_channel_count(void)
+{
+    return CY_IPC_CHAN_MBED_COUNT;
+}
+
+void ipc_notify(uint32_t channel)
+{
+    Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_MBED_FIRST + channel),
+                             1UL << CY_IPC_INTR_MBED_DEST);
+}
+
+void *ipc_get_shared_memory(size_t *size)
+{
+    *size = CY_IPC_MBED_SHARED_SIZE;
+#if defined(TARGET_MCU_PSOC6_M0)
+    ipc_publish_shared_memory();
+    return ipc_shared_memory;
+#else
+    // Wait until the CM0+ image has published the memory, it is started first.
+    uint32_t address;
+    while ((address = Cy_IPC_Drv_ReadDataValue(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_MBED_SHARED))) == 0) {
+    }
+    return (void *)address;
+#endif
+}
+
+#endif // DEVICE_IPC
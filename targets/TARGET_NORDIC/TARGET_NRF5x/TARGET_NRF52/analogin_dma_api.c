@@ -0,0 +1,226 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if DEVICE_ANALOGIN_DMA
+
+#include "hal/analogin_dma_api.h"
+
+#include "pinmap.h"
+#include "PeripheralPins.h"
+
+#include "nrf_saadc.h"
+#include "nrf_timer.h"
+#include "nrfx_ppi.h"
+#include "nrfx_errors.h"
+#include "app_util_platform.h"
+
+/* The SAADC has EasyDMA but no double buffering of its own: the END event
+ * restarts it through PPI, which latches the result pointer written on the
+ * previous STARTED event, so conversions continue without software latency.
+ * Conversions are triggered by TIMER3 through a second PPI channel.
+ *
+ * The SAADC is shared with AnalogIn, which must not be used while sampling.
+ */
+#define ADC_DMA_TIMER           NRF_TIMER3
+#define ADC_DMA_TIMER_FREQ      16000000
+
+/* One conversion takes the acquisition time plus 2 us */
+#define ADC_DMA_CONVERSION_US   12
+
+static analogin_dma_t *adc_dma_obj;
+
+/* Interrupt handler used by AnalogIn, implemented in nrfx_saadc.c. */
+void SAADC_IRQHandler(void);
+
+static void adc_dma_scale(int16_t *samples, size_t count)
+{
+    uint16_t *out = (uint16_t *)samples;
+    for (size_t i = 0; i < count; i++) {
+        int32_t value = samples[i];
+        if (value < 0) {
+            value = 0;
+        } else if (value > 0x0FFF) {
+            value = 0x0FFF;
+        }
+        /* Normalize 12 bit ADC value to 16 bit Mbed ADC range. */
+        out[i] = (uint16_t)((value << 4) | (value >> 8));
+    }
+}
+
+static void adc_dma_irq(void)
+{
+    analogin_dma_t *obj = adc_dma_obj;
+
+    if (nrf_saadc_event_check(NRF_SAADC_EVENT_END)) {
+        nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+
+        uint8_t done = obj->filling;
+        obj->filling ^= 1;
+        adc_dma_scale(obj->buffer + done * obj->half, obj->half);
+        obj->handler(obj->id, done ? ANALOGIN_DMA_EVENT_FULL : ANALOGIN_DMA_EVENT_HALF);
+    }
+
+    if (nrf_saadc_event_check(NRF_SAADC_EVENT_STARTED)) {
+        nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+
+        /* Queue the other half, used when END restarts the SAADC */
+        nrf_saadc_buffer_init(obj->buffer + (obj->filling ^ 1) * obj->half, obj->half);
+    }
+}
+
+void analogin_dma_init(analogin_dma_t *obj, const PinName *pins, uint8_t channels)
+{
+    MBED_ASSERT(obj);
+    MBED_ASSERT(channels > 0 && channels <= NRF_SAADC_CHANNEL_COUNT);
+    MBED_ASSERT(adc_dma_obj == NULL);
+
+    /* Scan mode samples every enabled channel on each SAMPLE task, in CH[] order. */
+    for (uint8_t i = 0; i < NRF_SAADC_CHANNEL_COUNT; i++) {
+        nrf_saadc_input_t input = NRF_SAADC_INPUT_DISABLED;
+
+        if (i < channels) {
+            uint32_t channel = pinmap_function(pins[i], PinMap_ADC);
+            MBED_ASSERT(channel != (uint32_t) NC);
+
+            /* Account for an off-by-one in Channel definition and Input definition. */
+            input = channel + 1;
+        }
+
+        /* Same configuration as AnalogIn: the 1/4 gain and VDD/4 makes the reference voltage VDD. */
+        nrf_saadc_channel_config_t channel_config = {
+            .resistor_p = NRF_SAADC_RESISTOR_DISABLED,
+            .resistor_n = NRF_SAADC_RESISTOR_DISABLED,
+            .gain       = NRF_SAADC_GAIN1_4,
+            .reference  = NRF_SAADC_REFERENCE_VDD4,
+            .acq_time   = NRF_SAADC_ACQTIME_10US,
+            .mode       = NRF_SAADC_MODE_SINGLE_ENDED,
+            .burst      = NRF_SAADC_BURST_DISABLED,
+            .pin_p      = input,
+            .pin_n      = NRF_SAADC_INPUT_DISABLED
+        };
+        nrf_saadc_channel_init(i, &channel_config);
+    }
+
+    nrf_saadc_resolution_set(NRF_SAADC_RESOLUTION_12BIT);
+    nrf_saadc_oversample_set(NRF_SAADC_OVERSAMPLE_DISABLED);
+    nrf_saadc_enable();
+
+    nrf_ppi_channel_t ppi;
+    nrfx_err_t ret = nrfx_ppi_channel_alloc(&ppi);
+    MBED_ASSERT(ret == NRFX_SUCCESS);
+    obj->ppi_sample = ppi;
+    ret = nrfx_ppi_channel_alloc(&ppi);
+    MBED_ASSERT(ret == NRFX_SUCCESS);
+    obj->ppi_restart = ppi;
+    (void) ret;
+
+    nrfx_ppi_channel_assign((nrf_ppi_channel_t) obj->ppi_sample,
+                            (uint32_t) nrf_timer_event_address_get(ADC_DMA_TIMER, NRF_TIMER_EVENT_COMPARE0),
+                            nrf_saadc_task_address_get(NRF_SAADC_TASK_SAMPLE));
+    nrfx_ppi_channel_assign((nrf_ppi_channel_t) obj->ppi_restart,
+                            nrf_saadc_event_address_get(NRF_SAADC_EVENT_END),
+                            nrf_saadc_task_address_get(NRF_SAADC_TASK_START));
+
+    nrf_timer_task_trigger(ADC_DMA_TIMER, NRF_TIMER_TASK_STOP);
+    nrf_timer_mode_set(ADC_DMA_TIMER, NRF_TIMER_MODE_TIMER);
+    nrf_timer_frequency_set(ADC_DMA_TIMER, NRF_TIMER_FREQ_16MHz);
+    nrf_timer_bit_width_set(ADC_DMA_TIMER, NRF_TIMER_BIT_WIDTH_32);
+    nrf_timer_shorts_enable(ADC_DMA_TIMER, NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK);
+
+    obj->channels = channels;
+    obj->ticks = 0;
+    obj->handler = NULL;
+    obj->id = 0;
+    adc_dma_obj = obj;
+}
+
+void analogin_dma_free(analogin_dma_t *obj)
+{
+    analogin_dma_stop(obj);
+    nrfx_ppi_channel_free((nrf_ppi_channel_t) obj->ppi_sample);
+    nrfx_ppi_channel_free((nrf_ppi_channel_t) obj->ppi_restart);
+    nrf_timer_shorts_disable(ADC_DMA_TIMER, NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK);
+    adc_dma_obj = NULL;
+}
+
+uint32_t analogin_dma_set_rate(analogin_dma_t *obj, uint32_t hz)
+{
+    uint32_t max_hz = 1000000 / (ADC_DMA_CONVERSION_US * obj->channels);
+    if (hz == 0 || hz > max_hz) {
+        return 0;
+    }
+
+    obj->ticks = (ADC_DMA_TIMER_FREQ + hz / 2) / hz;
+    nrf_timer_cc_write(ADC_DMA_TIMER, NRF_TIMER_CC_CHANNEL0, obj->ticks);
+    return ADC_DMA_TIMER_FREQ / obj->ticks;
+}
+
+int analogin_dma_start(analogin_dma_t *obj, uint16_t *buffer, size_t length, analogin_dma_handler_t handler, uint32_t id)
+{
+    if (!obj->ticks || nrf_saadc_busy_check()) {
+        return -1;
+    }
+
+    obj->buffer = (int16_t *)buffer;
+    obj->half = length / 2;
+    obj->filling = 0;
+    obj->handler = handler;
+    obj->id = id;
+
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+    nrf_saadc_int_disable(NRF_SAADC_INT_ALL);
+    nrf_saadc_int_enable(NRF_SAADC_INT_STARTED | NRF_SAADC_INT_END);
+
+    NVIC_SetVector(SAADC_IRQn, (uint32_t) adc_dma_irq);
+    NRFX_IRQ_PRIORITY_SET(SAADC_IRQn, APP_IRQ_PRIORITY_HIGH);
+    NRFX_IRQ_ENABLE(SAADC_IRQn);
+
+    nrf_saadc_buffer_init(obj->buffer, obj->half);
+    nrf_saadc_task_trigger(NRF_SAADC_TASK_START);
+
+    nrfx_ppi_channel_enable((nrf_ppi_channel_t) obj->ppi_restart);
+    nrfx_ppi_channel_enable((nrf_ppi_channel_t) obj->ppi_sample);
+    nrf_timer_task_trigger(ADC_DMA_TIMER, NRF_TIMER_TASK_CLEAR);
+    nrf_timer_task_trigger(ADC_DMA_TIMER, NRF_TIMER_TASK_START);
+
+    return 0;
+}
+
+void analogin_dma_stop(analogin_dma_t *obj)
+{
+    nrf_timer_task_trigger(ADC_DMA_TIMER, NRF_TIMER_TASK_STOP);
+    nrfx_ppi_channel_disable((nrf_ppi_channel_t) obj->ppi_sample);
+    nrfx_ppi_channel_disable((nrf_ppi_channel_t) obj->ppi_restart);
+
+    NRFX_IRQ_DISABLE(SAADC_IRQn);
+    nrf_saadc_int_disable(NRF_SAADC_INT_ALL);
+
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STOPPED);
+    nrf_saadc_task_trigger(NRF_SAADC_TASK_STOP);
+    while (nrf_saadc_busy_check() && !nrf_saadc_event_check(NRF_SAADC_EVENT_STOPPED)) {
+    }
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STOPPED);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+
+    /* Hand the interrupt back to the nrfx driver used by AnalogIn. */
+    NVIC_SetVector(SAADC_IRQn, (uint32_t) SAADC_IRQHandler);
+    NRFX_IRQ_ENABLE(SAADC_IRQn);
+}
+
+#endif // DEVICE_ANALOGIN_DMA
@@ -105,6 +105,10 @@ struct port_s {
     uint32_t mask;
 };
 
+/* Compile time pin to port mapping, see port_api.h */
+#define PINNAME_TO_PORT(pin)     ((uint32_t)(pin) >> 5)
+#define PINNAME_TO_PORT_PIN(pin) ((uint32_t)(pin) & 0x1F)
+
 struct pwmout_s {
     int instance;
     PinName pin;
@@ -134,6 +138,20 @@ struct analogin_s {
     uint8_t channel;
 };
 
+#if DEVICE_ANALOGIN_DMA
+struct analogin_dma_s {
+    uint8_t channels;
+    uint8_t filling;
+    uint8_t ppi_sample;
+    uint8_t ppi_restart;
+    uint32_t ticks;
+    int16_t *buffer;
+    size_t half;
+    void (*handler)(uint32_t id, uint32_t event);
+    uint32_t id;
+};
+#endif
+
 struct gpio_irq_s {
     uint32_t ch;
 };
@@ -42,6 +42,7 @@
 #include "PeripheralPins.h"
 #include "pinmap_ex.h"
 #include "nrfx_pwm.h"
+#include "platform/mbed_critical.h"
 
 #if 0
 #define DEBUG_PRINTF(...) do { printf(__VA_ARGS__); } while(0)
@@ -76,9 +77,21 @@ static nrfx_pwm_t nordic_nrf5_pwm_instance[] = {
 #endif
 };
 
+/* Sequence playback state of each PWM instance. */
+typedef struct {
+    pwmout_t *obj;
+    nrf_pwm_sequence_t sequence;
+    uint16_t last;
+    bool loop;
+    pwmout_sequence_handler_t handler;
+    uint32_t id;
+} nordic_pwm_sequence_t;
+
+static nordic_pwm_sequence_t nordic_nrf5_pwm_sequence[sizeof(nordic_nrf5_pwm_instance) / sizeof(nrfx_pwm_t)];
+
 /* Helper function for (re)initializing the PWM instance.
  */
-static void nordic_pwm_init(pwmout_t *obj)
+static void nordic_pwm_init(pwmout_t *obj, nrfx_pwm_handler_t handler)
 {
     MBED_ASSERT(obj);
 
@@ -104,7 +117,7 @@ static void nordic_pwm_init(pwmout_t *obj)
     /* Initialize instance with new configuration. */
     ret_code_t result = nrfx_pwm_init(&nordic_nrf5_pwm_instance[obj->instance],
                                       &config,
-                                      NULL);
+                                      handler);
 
     MBED_ASSERT(result == NRFX_SUCCESS);
 }
@@ -117,8 +130,11 @@ static void nordic_pwm_restart(pwmout_t *obj)
     /* Uninitialize PWM instance */
     nrfx_pwm_uninit(&nordic_nrf5_pwm_instance[obj->instance]);
 
+    /* A sequence being played is replaced by the duty-cycle. */
+    nordic_nrf5_pwm_sequence[obj->instance].obj = NULL;
+
     /* (Re)initialize PWM instance. */
-    nordic_pwm_init(obj);
+    nordic_pwm_init(obj, NULL);
 
     /* Set duty-cycle from object. */
     ret_code_t result = nrfx_pwm_simple_playback(&nordic_nrf5_pwm_instance[obj->instance],
@@ -160,7 +176,7 @@ void pwmout_init(pwmout_t *obj, PinName pin)
     obj->pulse |= SEQ_POLARITY_BIT;
 
     /* Initialize PWM instance. */
-    nordic_pwm_init(obj);
+    nordic_pwm_init(obj, NULL);
 }
 
 /** Deinitialize the pwmout object
@@ -175,6 +191,7 @@ void pwmout_free(pwmout_t *obj)
 
     /* Uninitialize PWM instance. */
     nrfx_pwm_uninit(&nordic_nrf5_pwm_instance[obj->instance]);
+    nordic_nrf5_pwm_sequence[obj->instance].obj = NULL;
 }
 
 /** Set the output duty-cycle in range <0.0f, 1.0f>
@@ -199,6 +216,9 @@ void pwmout_write(pwmout_t *obj, float percent)
     /* Store actual percentage passed as parameter to avoid floating point rounding errors. */
     obj->percent = percent;
 
+    /* A sequence being played is replaced by the duty-cycle. */
+    nordic_nrf5_pwm_sequence[obj->instance].obj = NULL;
+
     /* Set new duty-cycle. */
     ret_code_t result = nrfx_pwm_simple_playback(&nordic_nrf5_pwm_instance[obj->instance],
                                                  &obj->sequence,
@@ -348,6 +368,152 @@ void pwmout_pulsewidth_us(pwmout_t *obj, int pulse)
     nordic_pwm_restart(obj);
 }
 
+/* Keep the last duty-cycle of the sequence running, in the object's own sequence. */
+static void nordic_pwm_sequence_hold(nordic_pwm_sequence_t *seq)
+{
+    pwmout_t *obj = seq->obj;
+
+    seq->obj = NULL;
+    obj->pulse = SEQ_POLARITY_BIT | seq->last;
+    obj->percent = (float) seq->last / (float) obj->period;
+
+    nrfx_pwm_simple_playback(&nordic_nrf5_pwm_instance[obj->instance],
+                             &obj->sequence,
+                             1,
+                             NRFX_PWM_FLAG_LOOP);
+}
+
+static void nordic_pwm_sequence_event(int instance, nrfx_pwm_evt_type_t event_type)
+{
+    nordic_pwm_sequence_t *seq = &nordic_nrf5_pwm_sequence[instance];
+
+    if (seq->obj == NULL) {
+        return;
+    }
+
+    if ((event_type == NRFX_PWM_EVT_END_SEQ0) || (event_type == NRFX_PWM_EVT_END_SEQ1)) {
+        if (!seq->loop) {
+            nordic_pwm_sequence_hold(seq);
+        }
+        if (seq->handler) {
+            seq->handler(seq->id, PWMOUT_SEQUENCE_EVENT_COMPLETE);
+        }
+    }
+}
+
+/* The nrfx handlers carry no context, one per instance. */
+static void nordic_pwm_sequence_handler_0(nrfx_pwm_evt_type_t event_type)
+{
+    nordic_pwm_sequence_event(0, event_type);
+}
+
+static void nordic_pwm_sequence_handler_1(nrfx_pwm_evt_type_t event_type)
+{
+    nordic_pwm_sequence_event(1, event_type);
+}
+
+static void nordic_pwm_sequence_handler_2(nrfx_pwm_evt_type_t event_type)
+{
+    nordic_pwm_sequence_event(2, event_type);
+}
+
+static void nordic_pwm_sequence_handler_3(nrfx_pwm_evt_type_t event_type)
+{
+    nordic_pwm_sequence_event(3, event_type);
+}
+
+static const nrfx_pwm_handler_t nordic_pwm_sequence_handlers[] = {
+    nordic_pwm_sequence_handler_0,
+    nordic_pwm_sequence_handler_1,
+    nordic_pwm_sequence_handler_2,
+    nordic_pwm_sequence_handler_3,
+};
+
+/** Get the sequence value for a 100% duty cycle at the current period
+ *
+ * Parameter obj The pwmout object
+ * Return The largest sequence value
+ */
+uint32_t pwmout_sequence_max(pwmout_t *obj)
+{
+    return obj->period;
+}
+
+/** Start playing a sequence of duty cycles
+ *
+ * The PWM peripheral reads the values by EasyDMA, the polarity bit is set in place.
+ */
+int pwmout_sequence_start(pwmout_t *obj, uint16_t *values, size_t count, bool loop, pwmout_sequence_handler_t handler, uint32_t id)
+{
+    DEBUG_PRINTF("pwmout_sequence_start: %d\r\n", count);
+
+    if ((count == 0) || (count > 0x7FFF) || !nrfx_is_in_ram(values)) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if ((values[i] & ~SEQ_POLARITY_BIT) > obj->period) {
+            return -1;
+        }
+        values[i] |= SEQ_POLARITY_BIT;
+    }
+
+    nordic_pwm_sequence_t *seq = &nordic_nrf5_pwm_sequence[obj->instance];
+    seq->sequence.values.p_common = values;
+    seq->sequence.length = count;
+    seq->sequence.repeats = 0;
+    seq->sequence.end_delay = 0;
+    seq->last = values[count - 1] & ~SEQ_POLARITY_BIT;
+    seq->loop = loop;
+    seq->handler = handler;
+    seq->id = id;
+
+    /* Reinitialize the instance with an event handler. */
+    nrfx_pwm_uninit(&nordic_nrf5_pwm_instance[obj->instance]);
+    nordic_pwm_init(obj, nordic_pwm_sequence_handlers[obj->instance]);
+    seq->obj = obj;
+
+    /* Looping plays the sequence in both slots, each end is one complete playback. */
+    ret_code_t result;
+    if (loop) {
+        result = nrfx_pwm_simple_playback(&nordic_nrf5_pwm_instance[obj->instance],
+                                          &seq->sequence,
+                                          2,
+                                          NRFX_PWM_FLAG_LOOP |
+                                          NRFX_PWM_FLAG_SIGNAL_END_SEQ0 |
+                                          NRFX_PWM_FLAG_SIGNAL_END_SEQ1);
+    } else {
+        result = nrfx_pwm_simple_playback(&nordic_nrf5_pwm_instance[obj->instance],
+                                          &seq->sequence,
+                                          1,
+                                          NRFX_PWM_FLAG_SIGNAL_END_SEQ1 |
+                                          NRFX_PWM_FLAG_NO_EVT_FINISHED);
+    }
+
+    if (result != NRFX_SUCCESS) {
+        seq->obj = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+/** Stop playing a sequence, leaving the last duty cycle of the sequence running
+ *
+ * Parameter obj The pwmout object
+ */
+void pwmout_sequence_stop(pwmout_t *obj)
+{
+    DEBUG_PRINTF("pwmout_sequence_stop\r\n");
+
+    nordic_pwm_sequence_t *seq = &nordic_nrf5_pwm_sequence[obj->instance];
+
+    core_util_critical_section_enter();
+    if (seq->obj == obj) {
+        nordic_pwm_sequence_hold(seq);
+    }
+    core_util_critical_section_exit();
+}
+
 const PinMap *pwmout_pinmap()
 {
     return PinMap_PWM_testing;
@@ -56,6 +56,9 @@ TODO
 
 #define MBED_HAL_QSPI_MAX_FREQ          32000000UL
 
+// Start of the XIP region, XIPOFFSET is left at 0
+#define MBED_HAL_QSPI_XIP_BASE          0x12000000UL
+
 // NRF supported R/W opcodes
 #define FASTREAD_opcode     0x0B
 #define READ2O_opcode       0x3B
@@ -82,6 +85,24 @@ TODO
 
 static nrfx_qspi_config_t config;
 
+qspi_status_t qspi_memory_map(qspi_t *obj, const qspi_command_t *command, const void **address)
+{
+    // XIP reads use the read opcode programmed in IFCONFIG0 and can be
+    // mixed freely with tasks, so no separate mode has to be entered
+    qspi_status_t status = qspi_prepare_command(obj, command, false);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+
+    *address = (const void *)MBED_HAL_QSPI_XIP_BASE;
+    return QSPI_STATUS_OK;
+}
+
+qspi_status_t qspi_memory_unmap(qspi_t *obj)
+{
+    return QSPI_STATUS_OK;
+}
+
 // Private helper function to track initialization
 static ret_code_t _qspi_drv_init(void);
 // Private helper function to set NRF frequency divider
@@ -206,6 +227,86 @@ qspi_status_t qspi_prepare_command(qspi_t *obj, const qspi_command_t *command, b
     return QSPI_STATUS_OK;
 }
 
+// Asynchronous transfers bypass nrfx, which is initialized without a handler so that
+// the blocking calls keep polling. The READY interrupt is only enabled while an
+// asynchronous transfer runs.
+static volatile qspi_async_handler_t async_handler;
+static uint32_t async_id;
+
+static void qspi_async_irq(void)
+{
+    if (nrf_qspi_event_check(NRF_QSPI, NRF_QSPI_EVENT_READY)) {
+        nrf_qspi_event_clear(NRF_QSPI, NRF_QSPI_EVENT_READY);
+        nrf_qspi_int_disable(NRF_QSPI, NRF_QSPI_INT_READY_MASK);
+        qspi_async_handler_t handler = async_handler;
+        async_handler = NULL;
+        if (handler) {
+            handler(async_id, QSPI_STATUS_OK);
+        }
+    }
+}
+
+static qspi_status_t qspi_async_start(qspi_t *obj, const qspi_command_t *command, void *data, size_t length, bool write, qspi_async_handler_t handler, uint32_t id)
+{
+    // EasyDMA needs a word aligned buffer in RAM, flash address and length must be divisible by 4
+    if ((length & WORD_MASK) > 0 ||
+        (command->address.value & WORD_MASK) > 0 ||
+        !is_word_aligned(data) ||
+        !nrfx_is_in_ram(data)) {
+        return QSPI_STATUS_INVALID_PARAMETER;
+    }
+
+    qspi_status_t status = qspi_prepare_command(obj, command, write);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+
+    async_handler = handler;
+    async_id = id;
+    if (write) {
+        nrf_qspi_write_buffer_set(NRF_QSPI, data, length, command->address.value);
+    } else {
+        nrf_qspi_read_buffer_set(NRF_QSPI, data, length, command->address.value);
+    }
+
+    nrf_qspi_event_clear(NRF_QSPI, NRF_QSPI_EVENT_READY);
+    NVIC_SetVector(QSPI_IRQn, (uint32_t) qspi_async_irq);
+    NVIC_SetPriority(QSPI_IRQn, config.irq_priority);
+    NVIC_ClearPendingIRQ(QSPI_IRQn);
+    NVIC_EnableIRQ(QSPI_IRQn);
+    nrf_qspi_int_enable(NRF_QSPI, NRF_QSPI_INT_READY_MASK);
+    nrf_qspi_task_trigger(NRF_QSPI, write ? NRF_QSPI_TASK_WRITESTART : NRF_QSPI_TASK_READSTART);
+
+    return QSPI_STATUS_OK;
+}
+
+qspi_status_t qspi_read_async(qspi_t *obj, const qspi_command_t *command, void *data, size_t length, qspi_async_handler_t handler, uint32_t id)
+{
+    // SFDP reads need the custom instruction path
+    if (command->instruction.value == READSFDP_opcode) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    return qspi_async_start(obj, command, data, length, false, handler, id);
+}
+
+qspi_status_t qspi_write_async(qspi_t *obj, const qspi_command_t *command, const void *data, size_t length, qspi_async_handler_t handler, uint32_t id)
+{
+    return qspi_async_start(obj, command, (void *)data, length, true, handler, id);
+}
+
+void qspi_abort_async(qspi_t *obj)
+{
+    nrf_qspi_int_disable(NRF_QSPI, NRF_QSPI_INT_READY_MASK);
+    if (async_handler) {
+        // The peripheral cannot stop a transfer, wait for it to end instead
+        async_handler = NULL;
+        while (!nrf_qspi_event_check(NRF_QSPI, NRF_QSPI_EVENT_READY)) {
+        }
+        nrf_qspi_event_clear(NRF_QSPI, NRF_QSPI_EVENT_READY);
+    }
+}
+
 qspi_status_t qspi_init(qspi_t *obj, PinName io0, PinName io1, PinName io2, PinName io3, PinName sclk, PinName ssel, uint32_t hz, uint8_t mode)
 {
     (void)(obj);
@@ -18,6 +18,7 @@
 #include "string.h"
 #include "cmsis.h"
 #include "mbed_assert.h"
+#include "mbed_critical.h"
 #include "PeripheralNames.h"
 #include "nu_modutil.h"
 #include "nu_bitutil.h"
@@ -26,11 +27,20 @@
 #define NU_PDMA_CH_MAX      PDMA_CH_MAX     /* Specify maximum channels of PDMA */
 #define NU_PDMA_CH_Pos      0               /* Specify first channel number of PDMA */
 #define NU_PDMA_CH_Msk      (((1 << NU_PDMA_CH_MAX) - 1) << NU_PDMA_CH_Pos)
+#define NU_PDMA_TXCNT_MAX   ((PDMA_DSCT_CTL_TXCNT_Msk >> PDMA_DSCT_CTL_TXCNT_Pos) + 1)    /* Specify maximum transfer count of one PDMA run */
 
 struct nu_dma_chn_s {
     void        (*handler)(uint32_t, uint32_t);
     uint32_t    id;
     uint32_t    event;
+
+    /* Chain started by dma_channel_start() */
+    const dma_desc_t    *chain;     // First transfer of the chain
+    const dma_desc_t    *desc;      // Transfer running, NULL if none
+    uint32_t            done;       // Elements of desc transferred by previous runs
+    uint32_t            run;        // Elements of desc in this run
+    dma_handler_t       chain_handler;
+    void                *chain_context;
 };
 
 static int dma_inited = 0;
@@ -38,6 +48,8 @@ static uint32_t dma_chn_mask = 0;
 static struct nu_dma_chn_s dma_chn_arr[NU_PDMA_CH_MAX];
 
 static void pdma_vec(void);
+static void dma_chain_run(int channelid);
+static void dma_chain_handler(uint32_t id, uint32_t event);
 static const struct nu_modinit_s dma_modinit = {DMA_0, PDMA_MODULE, 0, 0, PDMA_RST, PDMA_IRQn, (void *) pdma_vec};
 
 
@@ -83,6 +95,9 @@ int dma_channel_allocate(uint32_t capabilities)
 int dma_channel_free(int channelid)
 {
     if (channelid != DMA_ERROR_OUT_OF_CHANNELS) {
+        if (dma_channel_busy(channelid)) {
+            dma_channel_abort(channelid);
+        }
         dma_chn_mask &= ~(1 << channelid);
     }
 
@@ -102,6 +117,149 @@ void dma_set_handler(int channelid, uint32_t handler, uint32_t id, uint32_t even
     NVIC_EnableIRQ(dma_modinit.irq_n);
 }
 
+int dma_channel_start(int channelid, const dma_desc_t *desc, dma_handler_t handler, void *context)
+{
+    MBED_ASSERT(dma_chn_mask & (1 << channelid));
+
+    struct nu_dma_chn_s *dma_chn = dma_chn_arr + channelid - NU_PDMA_CH_Pos;
+    if (dma_chn->desc) {
+        return DMA_ERROR_BUSY;
+    }
+
+    for (const dma_desc_t *d = desc; d; d = d->next) {
+        if (! d->count) {
+            return DMA_ERROR_UNSUPPORTED;
+        }
+        // No-ops on M480, which has no data cache
+        if (d->direction != DMA_DIRECTION_PERIPH_TO_MEM) {
+            dma_cache_clean(d->src, d->count * d->width);
+        }
+        if (d->direction != DMA_DIRECTION_MEM_TO_PERIPH) {
+            dma_cache_invalidate(d->dst, d->count * d->width);
+        }
+    }
+
+    dma_chn->chain = desc;
+    dma_chn->desc = desc;
+    dma_chn->done = 0;
+    dma_chn->chain_handler = handler;
+    dma_chn->chain_context = context;
+    dma_set_handler(channelid, (uint32_t) dma_chain_handler, channelid, DMA_EVENT_ALL);
+
+    dma_chain_run(channelid);
+
+    return 0;
+}
+
+void dma_channel_abort(int channelid)
+{
+    MBED_ASSERT(dma_chn_mask & (1 << channelid));
+
+    struct nu_dma_chn_s *dma_chn = dma_chn_arr + channelid - NU_PDMA_CH_Pos;
+
+    PDMA_DisableInt(channelid, PDMA_INT_TRANS_DONE);
+    dma_modbase()->CHCTL &= ~(1 << channelid);
+
+    // The chain may have ended meanwhile, its handler is called once
+    core_util_critical_section_enter();
+    const dma_desc_t *desc = dma_chn->desc;
+    dma_chn->desc = NULL;
+    core_util_critical_section_exit();
+
+    if (desc && dma_chn->chain_handler) {
+        dma_chn->chain_handler(dma_chn->chain_context, DMA_ERROR_ABORTED);
+    }
+}
+
+bool dma_channel_busy(int channelid)
+{
+    return dma_chn_arr[channelid - NU_PDMA_CH_Pos].desc != NULL;
+}
+
+/* Program and trigger the next run of the transfer in progress, in pieces of at most NU_PDMA_TXCNT_MAX elements */
+static void dma_chain_run(int channelid)
+{
+    struct nu_dma_chn_s *dma_chn = dma_chn_arr + channelid - NU_PDMA_CH_Pos;
+    const dma_desc_t *desc = dma_chn->desc;
+    uint32_t offset = dma_chn->done * desc->width;
+    uint32_t src = (uint32_t) desc->src;
+    uint32_t dst = (uint32_t) desc->dst;
+
+    dma_chn->run = desc->count - dma_chn->done;
+    if (dma_chn->run > NU_PDMA_TXCNT_MAX) {
+        dma_chn->run = NU_PDMA_TXCNT_MAX;
+    }
+    if (desc->direction != DMA_DIRECTION_PERIPH_TO_MEM) {
+        src += offset;
+    }
+    if (desc->direction != DMA_DIRECTION_MEM_TO_PERIPH) {
+        dst += offset;
+    }
+
+    dma_modbase()->CHCTL |= 1 << channelid;  // Enable this DMA channel
+    PDMA_SetTransferMode(channelid,
+                         (desc->direction == DMA_DIRECTION_MEM_TO_MEM) ? PDMA_MEM : desc->request,
+                         0,  // Scatter-gather disabled
+                         0); // Scatter-gather descriptor address
+    PDMA_SetTransferCnt(channelid,
+                        (desc->width == DMA_WIDTH_8) ? PDMA_WIDTH_8 : (desc->width == DMA_WIDTH_16) ? PDMA_WIDTH_16 : PDMA_WIDTH_32,
+                        dma_chn->run);
+    PDMA_SetTransferAddr(channelid,
+                         src,
+                         (desc->direction == DMA_DIRECTION_PERIPH_TO_MEM) ? PDMA_SAR_FIX : PDMA_SAR_INC,
+                         dst,
+                         (desc->direction == DMA_DIRECTION_MEM_TO_PERIPH) ? PDMA_DAR_FIX : PDMA_DAR_INC);
+    if (desc->direction == DMA_DIRECTION_MEM_TO_MEM) {
+        PDMA_SetBurstType(channelid, PDMA_REQ_BURST, PDMA_BURST_128);
+    } else {
+        PDMA_SetBurstType(channelid, PDMA_REQ_SINGLE, 0);
+    }
+    PDMA_EnableInt(channelid, PDMA_INT_TRANS_DONE);
+    // Software request for memory to memory, the peripheral requests otherwise
+    PDMA_Trigger(channelid);
+}
+
+static void dma_chain_handler(uint32_t id, uint32_t event)
+{
+    int channelid = (int) id;
+    struct nu_dma_chn_s *dma_chn = dma_chn_arr + channelid - NU_PDMA_CH_Pos;
+    const dma_desc_t *desc = dma_chn->desc;
+    int result = DMA_ERROR_TRANSFER;
+
+    if (! desc) {
+        // Aborted
+        return;
+    }
+
+    if (event & DMA_EVENT_TRANSFER_DONE) {
+        dma_chn->done += dma_chn->run;
+        if (dma_chn->done == desc->count) {
+            dma_chn->desc = desc->next;
+            dma_chn->done = 0;
+        }
+        if (dma_chn->desc) {
+            dma_chain_run(channelid);
+            return;
+        }
+        result = 0;
+    }
+
+    PDMA_DisableInt(channelid, PDMA_INT_TRANS_DONE);
+    dma_modbase()->CHCTL &= ~(1 << channelid);
+    dma_chn->desc = NULL;
+
+    // Drop lines the CPU may have fetched while the transfers ran
+    for (const dma_desc_t *d = dma_chn->chain; d; d = d->next) {
+        if (d->direction != DMA_DIRECTION_MEM_TO_PERIPH) {
+            dma_cache_invalidate(d->dst, d->count * d->width);
+        }
+    }
+
+    if (dma_chn->chain_handler) {
+        dma_chn->chain_handler(dma_chn->chain_context, result);
+    }
+}
+
 PDMA_T *dma_modbase(void)
 {
     return (PDMA_T *) NU_MODBASE(dma_modinit.modname);
@@ -73,6 +73,7 @@ static int i2c_addr2data(int address, int read);
 #if DEVICE_I2CSLAVE
 // Convert mbed address to BSP address.
 static int i2c_addr2bspaddr(int address);
+static int i2c_slave_async_irq(i2c_t *obj, uint32_t status);
 #endif  // #if DEVICE_I2CSLAVE
 static void i2c_enable_int(i2c_t *obj);
 static void i2c_disable_int(i2c_t *obj);
@@ -130,6 +131,7 @@ void i2c_init(i2c_t *obj, PinName sda, PinName scl)
     var->obj = obj;
     obj->i2c.tran_ctrl = 0;
     obj->i2c.stop = 0;
+    obj->i2c.slave_handler = NULL;
     i2c_enable_vector_interrupt(obj, (uint32_t) var->vec, 1);
 
     // Mark this module to be inited.
@@ -303,6 +305,120 @@ static int i2c_addr2bspaddr(int address)
     return (address >> 1);
 }
 
+int i2c_slave_transfer_async(i2c_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, i2c_slave_async_handler_t handler, uint32_t id)
+{
+    // No PDMA request for I2C on M480, bytes are moved by the interrupt handler
+    i2c_disable_int(obj);
+
+    if (obj->i2c.slave_handler) {
+        i2c_enable_int(obj);
+        return -1;
+    }
+
+    obj->i2c.slave_tx = (const char *) tx;
+    obj->i2c.slave_tx_length = tx ? tx_length : 0;
+    obj->i2c.slave_rx = (char *) rx;
+    obj->i2c.slave_rx_length = rx ? rx_length : 0;
+    obj->i2c.slave_count = 0;
+    obj->i2c.slave_event = 0;
+    obj->i2c.slave_id = id;
+    obj->i2c.slave_handler = handler;
+
+    i2c_enable_int(obj);
+
+    return 0;
+}
+
+void i2c_slave_abort_async(i2c_t *obj)
+{
+    i2c_disable_int(obj);
+    obj->i2c.slave_handler = NULL;
+    i2c_enable_int(obj);
+}
+
+/* Serve a slave state for the transfer started by i2c_slave_transfer_async, return 0 if the state is not a slave one */
+static int i2c_slave_async_irq(i2c_t *obj, uint32_t status)
+{
+    I2C_T *i2c_base = (I2C_T *) NU_MODBASE(obj->i2c.i2c);
+    uint32_t i2c_ctl = I2C_CTL0_SI_Msk | I2C_CTL0_AA_Msk;
+    int event = 0;
+
+    switch (status) {
+    case 0x60:  // Slave Receive Address ACK
+    case 0x68:  // Slave Receive Arbitration Lost
+    case 0x70:  // GC mode Address ACK
+    case 0x78:  // GC mode Arbitration Lost
+        obj->i2c.slave_event = I2C_SLAVE_EVENT_WRITE_DONE;
+        obj->i2c.slave_count = 0;
+        if (! obj->i2c.slave_rx_length) {
+            // Not acknowledge data without a buffer
+            i2c_ctl &= ~I2C_CTL0_AA_Msk;
+        }
+        break;
+
+    case 0x80:  // Slave Receive Data ACK
+    case 0x90:  // GC mode Data ACK
+        if (obj->i2c.slave_count < obj->i2c.slave_rx_length) {
+            obj->i2c.slave_rx[obj->i2c.slave_count ++] = I2C_GET_DATA(i2c_base);
+        }
+        if (obj->i2c.slave_count == obj->i2c.slave_rx_length) {
+            // Buffer full, not acknowledge the next data
+            i2c_ctl &= ~I2C_CTL0_AA_Msk;
+        }
+        break;
+
+    case 0x88:  // Slave Receive Data NACK
+    case 0x98:  // GC mode Data NACK
+        // Back to not addressed mode, no stop is reported
+        event = I2C_SLAVE_EVENT_WRITE_DONE;
+        break;
+
+    case 0xA8:  // Slave Transmit Address ACK
+    case 0xB0:  // Slave Transmit Arbitration Lost
+        obj->i2c.slave_event = I2C_SLAVE_EVENT_READ_DONE;
+        obj->i2c.slave_count = 0;
+    /* fall through */
+    case 0xB8:  // Slave Transmit Data ACK
+        // Send all ones once the buffer is used up
+        if (obj->i2c.slave_count < obj->i2c.slave_tx_length) {
+            I2C_SET_DATA(i2c_base, obj->i2c.slave_tx[obj->i2c.slave_count ++]);
+        } else {
+            I2C_SET_DATA(i2c_base, 0xFF);
+        }
+        break;
+
+    case 0xC0:  // Slave Transmit Data NACK
+    case 0xC8:  // Slave Transmit Last Data ACK
+        event = I2C_SLAVE_EVENT_READ_DONE;
+        break;
+
+    case 0xA0:  // Slave Repeat Start or Stop
+        event = obj->i2c.slave_event;
+        break;
+
+    case 0x00:  // Bus error
+        event = I2C_SLAVE_EVENT_ERROR;
+        i2c_ctl |= I2C_CTL0_STO_Msk;
+        break;
+
+    default:
+        return 0;
+    }
+
+    obj->i2c.slaveaddr_state = NoData;
+    I2C_SET_CONTROL_REG(i2c_base, i2c_ctl);
+
+    if (event) {
+        // The handler may start the next transfer
+        i2c_slave_async_handler_t handler = obj->i2c.slave_handler;
+        obj->i2c.slave_handler = NULL;
+        obj->i2c.slave_event = 0;
+        handler(obj->i2c.slave_id, event, obj->i2c.slave_count);
+    }
+
+    return 1;
+}
+
 #endif // #if DEVICE_I2CSLAVE
 
 static void i2c_enable_int(i2c_t *obj)
@@ -551,6 +667,12 @@ static void i2c_irq(i2c_t *obj)
 
     status = I2C_GET_STATUS(i2c_base);
 
+#if DEVICE_I2CSLAVE
+    if (obj->i2c.slave_handler && i2c_slave_async_irq(obj, status)) {
+        return;
+    }
+#endif
+
     switch (status) {
     // Master Transmit
     case 0x28:  // Master Transmit Data ACK
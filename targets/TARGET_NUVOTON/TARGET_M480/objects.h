@@ -92,6 +92,13 @@ struct spi_s {
     uint32_t    event;
     //void        (*irq_handler_tx_async)(void);
     //void        (*irq_handler_rx_async)(void);
+
+    // Async slave transfer related fields
+    void        (*slave_handler)(uint32_t id, int event, size_t rx_count);
+    uint32_t    slave_id;
+    uint8_t     slave_done;
+    dma_desc_t  slave_desc_tx;
+    dma_desc_t  slave_desc_rx;
 };
 
 struct i2c_s {
@@ -111,6 +118,16 @@ struct i2c_s {
     uint32_t    event;
     int         stop;
     uint32_t    address;
+
+    // Async slave transfer related fields
+    void        (*slave_handler)(uint32_t id, int event, size_t count);
+    uint32_t    slave_id;
+    const char *slave_tx;
+    size_t      slave_tx_length;
+    char *      slave_rx;
+    size_t      slave_rx_length;
+    size_t      slave_count;
+    int         slave_event;
 };
 
 struct pwmout_s {
@@ -685,12 +685,20 @@ void serial_rx_abort_asynch(serial_t *obj)
     if (obj->serial.dma_usage_rx != DMA_USAGE_NEVER) {
         PDMA_T *pdma_base = dma_modbase();
 
+        // Stop DMA requests first so the count latched below is final. Characters
+        // left in the RX FIFO are received by the next transfer.
+        UART_DISABLE_INT(((UART_T *) NU_MODBASE(obj->serial.uart)), UART_INTEN_RXPDMAEN_Msk);
         if (obj->serial.dma_chn_id_rx != DMA_ERROR_OUT_OF_CHANNELS) {
             PDMA_DisableInt(obj->serial.dma_chn_id_rx, PDMA_INT_TRANS_DONE);
+            // The channel goes idle once its last frame has been moved
+            uint32_t ctl = pdma_base->DSCT[obj->serial.dma_chn_id_rx].CTL;
+            obj->rx_buff.pos = obj->rx_buff.length;
+            if (ctl & PDMA_DSCT_CTL_OPMODE_Msk) {
+                obj->rx_buff.pos -= ((ctl & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) + 1;
+            }
             // NOTE: On NUC472, next PDMA transfer will fail with PDMA_STOP() called. Cause is unknown.
             pdma_base->CHCTL &= ~(1 << obj->serial.dma_chn_id_rx);
         }
-        UART_DISABLE_INT(((UART_T *) NU_MODBASE(obj->serial.uart)), UART_INTEN_RXPDMAEN_Msk);
     }
 
     // Necessary for both interrupt way and DMA way
@@ -698,6 +706,12 @@ void serial_rx_abort_asynch(serial_t *obj)
     serial_rollback_interrupt(obj, RxIrq);
 }
 
+int serial_rx_asynch_received(serial_t *obj)
+{
+    // Kept current per character in interrupt way, latched on abort/completion in DMA way
+    return obj->rx_buff.pos;
+}
+
 uint8_t serial_tx_active(serial_t *obj)
 {
     // NOTE: Judge by serial_is_irq_en(obj, TxIrq) doesn't work with sync/async modes interleaved. Change with TX FIFO empty flag.
@@ -28,6 +28,7 @@
 #if DEVICE_SPI_ASYNCH
 #include "dma_api.h"
 #include "dma.h"
+#include "mbed_critical.h"
 #endif
 
 #define NU_SPI_FRAME_MIN    8
@@ -38,36 +39,68 @@ struct nu_spi_var {
     uint8_t     pdma_perp_tx;
     uint8_t     pdma_perp_rx;
 #endif
+#if DEVICE_SPISLAVE && DEVICE_SPI_ASYNCH
+    spi_t *     slave_obj;
+    void        (*slave_vec)(void);
+#endif
 };
 
+#if DEVICE_SPISLAVE && DEVICE_SPI_ASYNCH
+static void spi0_slave_vec(void);
+static void spi1_slave_vec(void);
+static void spi2_slave_vec(void);
+static void spi3_slave_vec(void);
+static void spi4_slave_vec(void);
+#endif
+
 static struct nu_spi_var spi0_var = {
 #if DEVICE_SPI_ASYNCH
     .pdma_perp_tx       =   PDMA_SPI0_TX,
-    .pdma_perp_rx       =   PDMA_SPI0_RX
+    .pdma_perp_rx       =   PDMA_SPI0_RX,
+#endif
+#if DEVICE_SPISLAVE && DEVICE_SPI_ASYNCH
+    .slave_obj          =   NULL,
+    .slave_vec          =   spi0_slave_vec,
 #endif
 };
 static struct nu_spi_var spi1_var = {
 #if DEVICE_SPI_ASYNCH
     .pdma_perp_tx       =   PDMA_SPI1_TX,
-    .pdma_perp_rx       =   PDMA_SPI1_RX
+    .pdma_perp_rx       =   PDMA_SPI1_RX,
+#endif
+#if DEVICE_SPISLAVE && DEVICE_SPI_ASYNCH
+    .slave_obj          =   NULL,
+    .slave_vec          =   spi1_slave_vec,
 #endif
 };
 static struct nu_spi_var spi2_var = {
 #if DEVICE_SPI_ASYNCH
     .pdma_perp_tx       =   PDMA_SPI2_TX,
-    .pdma_perp_rx       =   PDMA_SPI2_RX
+    .pdma_perp_rx       =   PDMA_SPI2_RX,
+#endif
+#if DEVICE_SPISLAVE && DEVICE_SPI_ASYNCH
+    .slave_obj          =   NULL,
+    .slave_vec          =   spi2_slave_vec,
 #endif
 };
 static struct nu_spi_var spi3_var = {
 #if DEVICE_SPI_ASYNCH
     .pdma_perp_tx       =   PDMA_SPI3_TX,
-    .pdma_perp_rx       =   PDMA_SPI3_RX
+    .pdma_perp_rx       =   PDMA_SPI3_RX,
+#endif
+#if DEVICE_SPISLAVE && DEVICE_SPI_ASYNCH
+    .slave_obj          =   NULL,
+    .slave_vec          =   spi3_slave_vec,
 #endif
 };
 static struct nu_spi_var spi4_var = {
 #if DEVICE_SPI_ASYNCH
     .pdma_perp_tx       =   PDMA_SPI4_TX,
-    .pdma_perp_rx       =   PDMA_SPI4_RX
+    .pdma_perp_rx       =   PDMA_SPI4_RX,
+#endif
+#if DEVICE_SPISLAVE && DEVICE_SPI_ASYNCH
+    .slave_obj          =   NULL,
+    .slave_vec          =   spi4_slave_vec,
 #endif
 };
 
@@ -116,6 +149,13 @@ static int spi_readable(spi_t * obj);
 static void spi_dma_handler_tx(uint32_t id, uint32_t event_dma);
 static void spi_dma_handler_rx(uint32_t id, uint32_t event_dma);
 static uint32_t spi_fifo_depth(spi_t *obj);
+#if DEVICE_SPISLAVE
+static void spi_slave_irq(spi_t *obj);
+static void spi_slave_dma_handler_tx(void *context, int result);
+static void spi_slave_dma_handler_rx(void *context, int result);
+static void spi_slave_async_finish(spi_t *obj, int event);
+static size_t spi_slave_async_stop(spi_t *obj);
+#endif
 #endif
 
 static uint32_t spi_modinit_mask = 0;
@@ -170,6 +210,7 @@ void spi_init(spi_t *obj, PinName mosi, PinName miso, PinName sclk, PinName ssel
     obj->spi.event = 0;
     obj->spi.dma_chn_id_tx = DMA_ERROR_OUT_OF_CHANNELS;
     obj->spi.dma_chn_id_rx = DMA_ERROR_OUT_OF_CHANNELS;
+    obj->spi.slave_handler = NULL;
     
     /* NOTE: We use vector to judge if asynchronous transfer is on-going (spi_active).
      *       At initial time, asynchronous transfer is not on-going and so vector must
@@ -557,6 +598,245 @@ uint8_t spi_active(spi_t *obj)
     return vec ? 1 : 0;
 }
 
+#if DEVICE_SPISLAVE
+
+/* Maximum frames of one buffer, so the remaining count of a PDMA run gives the received count */
+#define NU_SPI_SLAVE_FRAMES_MAX     ((PDMA_DSCT_CTL_TXCNT_Msk >> PDMA_DSCT_CTL_TXCNT_Pos) + 1)
+
+#define NU_SPI_SLAVE_DONE_TX        (1 << 0)
+#define NU_SPI_SLAVE_DONE_RX        (1 << 1)
+
+int spi_slave_transfer_async(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, spi_slave_async_handler_t handler, uint32_t id)
+{
+    SPI_T *spi_base = (SPI_T *) NU_MODBASE(obj->spi.spi);
+    const struct nu_modinit_s *modinit = get_modinit(obj->spi.spi, spi_modinit_tab);
+    MBED_ASSERT(modinit != NULL);
+    MBED_ASSERT(modinit->modname == (int) obj->spi.spi);
+    struct nu_spi_var *var = (struct nu_spi_var *) modinit->var;
+
+    // Only the DMA way, frames are moved while the slave is not in control of the clock
+    uint32_t data_width = spi_get_data_width(obj);
+    uint32_t frame_size = data_width / 8;
+    if ((data_width % 8) ||
+            (! tx_length && ! rx_length) ||
+            (tx_length / frame_size) > NU_SPI_SLAVE_FRAMES_MAX ||
+            (rx_length / frame_size) > NU_SPI_SLAVE_FRAMES_MAX ||
+            spi_active(obj)) {
+        return -1;
+    }
+
+    obj->spi.dma_usage = DMA_USAGE_ALWAYS;
+    spi_check_dma_usage(&obj->spi.dma_usage, &obj->spi.dma_chn_id_tx, &obj->spi.dma_chn_id_rx);
+    if (obj->spi.dma_usage == DMA_USAGE_NEVER) {
+        return -1;
+    }
+
+    /* Between transactions, start from empty FIFOs. Started from the handler while the
+     * master keeps chip select asserted, frames already queued in the FIFOs are kept. */
+    if (spi_base->STATUS & SPI_STATUS_SSLINE_Msk) {
+        SPI_DISABLE_SYNC(spi_base);
+        SPI_ClearRxFIFO(spi_base);
+        SPI_ClearTxFIFO(spi_base);
+        // Send all ones once the TX buffer is used up
+        spi_base->FIFOCTL |= SPI_FIFOCTL_TXUFPOL_Msk;
+    }
+    spi_base->STATUS = SPI_STATUS_SSINAIF_Msk | SPI_STATUS_SLVBEIF_Msk | SPI_STATUS_RXOVIF_Msk | SPI_STATUS_TXUFIF_Msk;
+
+    dma_width_t width = (frame_size == 1) ? DMA_WIDTH_8 : (frame_size == 2) ? DMA_WIDTH_16 : DMA_WIDTH_32;
+    dma_desc_t *desc_tx = &obj->spi.slave_desc_tx;
+    dma_desc_t *desc_rx = &obj->spi.slave_desc_rx;
+
+    desc_tx->direction = DMA_DIRECTION_MEM_TO_PERIPH;
+    desc_tx->width = width;
+    desc_tx->src = tx;
+    desc_tx->dst = &spi_base->TX;
+    desc_tx->count = tx ? tx_length / frame_size : 0;
+    desc_tx->request = var->pdma_perp_tx;
+    desc_tx->next = NULL;
+
+    desc_rx->direction = DMA_DIRECTION_PERIPH_TO_MEM;
+    desc_rx->width = width;
+    desc_rx->src = &spi_base->RX;
+    desc_rx->dst = rx;
+    desc_rx->count = rx ? rx_length / frame_size : 0;
+    desc_rx->request = var->pdma_perp_rx;
+    desc_rx->next = NULL;
+
+    obj->spi.slave_handler = handler;
+    obj->spi.slave_id = id;
+    obj->spi.slave_done = (desc_tx->count ? 0 : NU_SPI_SLAVE_DONE_TX) | (desc_rx->count ? 0 : NU_SPI_SLAVE_DONE_RX);
+
+    if (desc_rx->count) {
+        dma_channel_start(obj->spi.dma_chn_id_rx, desc_rx, spi_slave_dma_handler_rx, obj);
+    }
+    if (desc_tx->count) {
+        dma_channel_start(obj->spi.dma_chn_id_tx, desc_tx, spi_slave_dma_handler_tx, obj);
+    }
+
+    // Chip select going inactive ends the transfer early, a partial frame is an error
+    var->slave_obj = obj;
+    spi_enable_vector_interrupt(obj, (uint32_t) var->slave_vec, 1);
+    spi_base->SSCTL |= SPI_SSCTL_SSINAIEN_Msk | SPI_SSCTL_SLVBEIEN_Msk;
+
+    SPI_ENABLE_SYNC(spi_base);
+
+    // Enable PDMA TX/RX functions simultaneously, see spi_master_transfer
+    spi_base->PDMACTL |= (desc_tx->count ? SPI_PDMACTL_TXPDMAEN_Msk : 0) | (desc_rx->count ? SPI_PDMACTL_RXPDMAEN_Msk : 0);
+
+    return 0;
+}
+
+void spi_slave_abort_async(spi_t *obj)
+{
+    core_util_critical_section_enter();
+    if (obj->spi.slave_handler) {
+        obj->spi.slave_handler = NULL;
+        spi_slave_async_stop(obj);
+    }
+    core_util_critical_section_exit();
+}
+
+static void spi0_slave_vec(void)
+{
+    spi_slave_irq(spi0_var.slave_obj);
+}
+static void spi1_slave_vec(void)
+{
+    spi_slave_irq(spi1_var.slave_obj);
+}
+static void spi2_slave_vec(void)
+{
+    spi_slave_irq(spi2_var.slave_obj);
+}
+static void spi3_slave_vec(void)
+{
+    spi_slave_irq(spi3_var.slave_obj);
+}
+static void spi4_slave_vec(void)
+{
+    spi_slave_irq(spi4_var.slave_obj);
+}
+
+static void spi_slave_irq(spi_t *obj)
+{
+    SPI_T *spi_base = (SPI_T *) NU_MODBASE(obj->spi.spi);
+    uint32_t status = spi_base->STATUS;
+
+    if (status & SPI_STATUS_SLVBEIF_Msk) {
+        spi_base->STATUS = SPI_STATUS_SLVBEIF_Msk | SPI_STATUS_SSINAIF_Msk;
+        spi_slave_async_finish(obj, SPI_SLAVE_EVENT_ERROR);
+    } else if (status & SPI_STATUS_SSINAIF_Msk) {
+        spi_base->STATUS = SPI_STATUS_SSINAIF_Msk;
+        spi_slave_async_finish(obj, SPI_SLAVE_EVENT_DESELECT);
+    }
+}
+
+static void spi_slave_dma_handler_tx(void *context, int result)
+{
+    spi_t *obj = (spi_t *) context;
+
+    if (result != 0) {
+        spi_slave_async_finish(obj, SPI_SLAVE_EVENT_ERROR);
+        return;
+    }
+
+    // The last frames are still in the TX FIFO, the master clocks them out in the next transfer if not in this one
+    core_util_critical_section_enter();
+    obj->spi.slave_done |= NU_SPI_SLAVE_DONE_TX;
+    uint8_t done = obj->spi.slave_done;
+    core_util_critical_section_exit();
+
+    if (done == (NU_SPI_SLAVE_DONE_TX | NU_SPI_SLAVE_DONE_RX)) {
+        spi_slave_async_finish(obj, SPI_SLAVE_EVENT_COMPLETE);
+    }
+}
+
+static void spi_slave_dma_handler_rx(void *context, int result)
+{
+    spi_t *obj = (spi_t *) context;
+
+    if (result != 0) {
+        spi_slave_async_finish(obj, SPI_SLAVE_EVENT_ERROR);
+        return;
+    }
+
+    core_util_critical_section_enter();
+    obj->spi.slave_done |= NU_SPI_SLAVE_DONE_RX;
+    uint8_t done = obj->spi.slave_done;
+    core_util_critical_section_exit();
+
+    if (done == (NU_SPI_SLAVE_DONE_TX | NU_SPI_SLAVE_DONE_RX)) {
+        spi_slave_async_finish(obj, SPI_SLAVE_EVENT_COMPLETE);
+    }
+}
+
+/* End the transfer once, whichever of the SPI and PDMA interrupts comes first */
+static void spi_slave_async_finish(spi_t *obj, int event)
+{
+    size_t rx_count = 0;
+
+    core_util_critical_section_enter();
+    spi_slave_async_handler_t handler = obj->spi.slave_handler;
+    obj->spi.slave_handler = NULL;
+    if (handler) {
+        rx_count = spi_slave_async_stop(obj);
+    }
+    core_util_critical_section_exit();
+
+    if (handler) {
+        handler(obj->spi.slave_id, event, rx_count);
+    }
+}
+
+/* Stop the PDMA channels and interrupts, return the number of bytes received */
+static size_t spi_slave_async_stop(spi_t *obj)
+{
+    SPI_T *spi_base = (SPI_T *) NU_MODBASE(obj->spi.spi);
+    const dma_desc_t *desc_rx = &obj->spi.slave_desc_rx;
+    uint32_t rx_frames = desc_rx->count;
+
+    spi_base->SSCTL &= ~(SPI_SSCTL_SSINAIEN_Msk | SPI_SSCTL_SLVBEIEN_Msk);
+    spi_enable_vector_interrupt(obj, 0, 0);
+    SPI_DISABLE_TX_PDMA(spi_base);
+    SPI_DISABLE_RX_PDMA(spi_base);
+
+    if (! (obj->spi.slave_done & NU_SPI_SLAVE_DONE_TX)) {
+        dma_channel_abort(obj->spi.dma_chn_id_tx);
+    }
+
+    if (! (obj->spi.slave_done & NU_SPI_SLAVE_DONE_RX)) {
+        // The channel goes idle once its last frame has been moved
+        uint32_t ctl = dma_modbase()->DSCT[obj->spi.dma_chn_id_rx].CTL;
+        if (ctl & PDMA_DSCT_CTL_OPMODE_Msk) {
+            rx_frames -= ((ctl & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) + 1;
+        }
+        dma_channel_abort(obj->spi.dma_chn_id_rx);
+
+        // Frames received just before chip select went inactive may not have been moved yet
+        while (rx_frames < desc_rx->count && spi_readable(obj)) {
+            uint32_t value = SPI_READ_RX(spi_base);
+            switch (desc_rx->width) {
+            case DMA_WIDTH_8:
+                ((uint8_t *) desc_rx->dst)[rx_frames] = value;
+                break;
+            case DMA_WIDTH_16:
+                ((uint16_t *) desc_rx->dst)[rx_frames] = value;
+                break;
+            default:
+                ((uint32_t *) desc_rx->dst)[rx_frames] = value;
+                break;
+            }
+            rx_frames ++;
+        }
+    }
+
+    obj->spi.slave_done = NU_SPI_SLAVE_DONE_TX | NU_SPI_SLAVE_DONE_RX;
+
+    return rx_frames * desc_rx->width;
+}
+
+#endif
+
 static int spi_writeable(spi_t * obj)
 {
     // Receive FIFO must not be full to avoid receive FIFO overflow on next transmit/receive
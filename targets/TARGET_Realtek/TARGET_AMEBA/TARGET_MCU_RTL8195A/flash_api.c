@@ -76,3 +76,12 @@ uint8_t flash_get_erase_value(const flash_t *obj)
     return 0xFF;
 }
 
+const void *flash_get_mapped_address(const flash_t *obj, uint32_t address)
+{
+    (void)obj;
+    (void)address;
+
+    // Flash addresses are offsets into the SPI flash, read through the flash controller
+    return NULL;
+}
+
@@ -130,6 +130,10 @@ typedef enum {
 #define STM_PORT(X) (((uint32_t)(X) >> 4) & 0xF)
 #define STM_PIN(X)  ((uint32_t)(X) & 0xF)
 
+/* Compile time pin to port mapping, see port_api.h */
+#define PINNAME_TO_PORT(X)     STM_PORT(X)
+#define PINNAME_TO_PORT_PIN(X) STM_PIN(X)
+
 /*  Defines to be used by application */
 typedef enum {
     PIN_INPUT = 0,
@@ -0,0 +1,273 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_assert.h"
+#include "analogin_dma_api.h"
+
+#if DEVICE_ANALOGIN_DMA
+
+#include "cmsis.h"
+#include "pinmap.h"
+#include "mbed_error.h"
+#include "PeripheralPins.h"
+#include "us_ticker_data.h"
+
+/* Conversions are triggered by TIM2 TRGO, the us ticker must use another timer.
+ * DMA2 stream mapping from the reference manual:
+ *   ADC1: stream 0 channel 0, ADC2: stream 2 channel 1, ADC3: stream 1 channel 2
+ */
+#define ADC_DMA_COUNT 3
+
+static analogin_dma_t *adc_dma_objs[ADC_DMA_COUNT];
+static const IRQn_Type adc_dma_irqn[ADC_DMA_COUNT] = {DMA2_Stream0_IRQn, DMA2_Stream2_IRQn, DMA2_Stream1_IRQn};
+
+static void adc_dma_irq(int index)
+{
+    analogin_dma_t *obj = adc_dma_objs[index];
+    if (obj) {
+        HAL_DMA_IRQHandler(&obj->dma);
+    }
+}
+
+static void adc1_dma_irq(void)
+{
+    adc_dma_irq(0);
+}
+
+#if defined(ADC2)
+static void adc2_dma_irq(void)
+{
+    adc_dma_irq(1);
+}
+#endif
+
+#if defined(ADC3)
+static void adc3_dma_irq(void)
+{
+    adc_dma_irq(2);
+}
+#endif
+
+static analogin_dma_t *obj_from_dma(DMA_HandleTypeDef *hdma)
+{
+    // The ADC handle is the first member of analogin_dma_s
+    return (analogin_dma_t *)hdma->Parent;
+}
+
+static void adc_dma_half(DMA_HandleTypeDef *hdma)
+{
+    analogin_dma_t *obj = obj_from_dma(hdma);
+    obj->handler(obj->id, ANALOGIN_DMA_EVENT_HALF);
+}
+
+static void adc_dma_full(DMA_HandleTypeDef *hdma)
+{
+    analogin_dma_t *obj = obj_from_dma(hdma);
+    obj->handler(obj->id, ANALOGIN_DMA_EVENT_FULL);
+}
+
+static void adc_dma_error(DMA_HandleTypeDef *hdma)
+{
+    analogin_dma_t *obj = obj_from_dma(hdma);
+    HAL_TIM_Base_Stop(&obj->timer);
+    obj->handler(obj->id, ANALOGIN_DMA_EVENT_ERROR);
+}
+
+void analogin_dma_init(analogin_dma_t *obj, const PinName *pins, uint8_t channels)
+{
+    MBED_ASSERT(channels > 0 && channels <= sizeof(obj->channel));
+#if defined(TIM2)
+    MBED_ASSERT(TIM_MST != TIM2);
+#else
+    error("AnalogInDMA needs TIM2");
+#endif
+
+    ADCName adc = (ADCName)pinmap_peripheral(pins[0], PinMap_ADC);
+    MBED_ASSERT(adc != (ADCName)NC);
+
+    for (int i = 0; i < channels; i++) {
+        // Internal channels need dedicated sampling times and are not supported
+        MBED_ASSERT(pins[i] < 0xF0);
+        MBED_ASSERT((ADCName)pinmap_peripheral(pins[i], PinMap_ADC) == adc);
+        uint32_t function = pinmap_function(pins[i], PinMap_ADC);
+        MBED_ASSERT(function != (uint32_t)NC);
+        obj->channel[i] = STM_PIN_CHANNEL(function);
+        pinmap_pinout(pins[i], PinMap_ADC);
+    }
+    obj->channels = channels;
+    obj->handler = NULL;
+    obj->id = 0;
+
+    DMA_Stream_TypeDef *stream = DMA2_Stream0;
+    uint32_t dma_channel = DMA_CHANNEL_0;
+    uint32_t vector = (uint32_t)adc1_dma_irq;
+    obj->index = 0;
+    if (adc == ADC_1) {
+        __HAL_RCC_ADC1_CLK_ENABLE();
+    }
+#if defined(ADC2)
+    if (adc == ADC_2) {
+        __HAL_RCC_ADC2_CLK_ENABLE();
+        stream = DMA2_Stream2;
+        dma_channel = DMA_CHANNEL_1;
+        vector = (uint32_t)adc2_dma_irq;
+        obj->index = 1;
+    }
+#endif
+#if defined(ADC3)
+    if (adc == ADC_3) {
+        __HAL_RCC_ADC3_CLK_ENABLE();
+        stream = DMA2_Stream1;
+        dma_channel = DMA_CHANNEL_2;
+        vector = (uint32_t)adc3_dma_irq;
+        obj->index = 2;
+    }
+#endif
+    MBED_ASSERT(adc_dma_objs[obj->index] == NULL);
+    adc_dma_objs[obj->index] = obj;
+
+    // Scan all channels on each timer trigger, left aligned to give a 16-bit range
+    obj->handle.Instance = (ADC_TypeDef *)adc;
+    obj->handle.State = HAL_ADC_STATE_RESET;
+    obj->handle.Init.ClockPrescaler        = ADC_CLOCK_SYNC_PCLK_DIV2;
+    obj->handle.Init.Resolution            = ADC_RESOLUTION_12B;
+    obj->handle.Init.ScanConvMode          = (channels > 1) ? ENABLE : DISABLE;
+    obj->handle.Init.ContinuousConvMode    = DISABLE;
+    obj->handle.Init.DiscontinuousConvMode = DISABLE;
+    obj->handle.Init.NbrOfDiscConversion   = 0;
+    obj->handle.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_RISING;
+    obj->handle.Init.ExternalTrigConv      = ADC_EXTERNALTRIGCONV_T2_TRGO;
+    obj->handle.Init.DataAlign             = ADC_DATAALIGN_LEFT;
+    obj->handle.Init.NbrOfConversion       = channels;
+    obj->handle.Init.DMAContinuousRequests = ENABLE;
+    obj->handle.Init.EOCSelection          = ADC_EOC_SEQ_CONV;
+    if (HAL_ADC_Init(&obj->handle) != HAL_OK) {
+        error("Cannot initialize ADC");
+    }
+
+    for (int i = 0; i < channels; i++) {
+        ADC_ChannelConfTypeDef sConfig = {0};
+        // ADC_CHANNEL_x is the channel number on this family
+        sConfig.Channel      = obj->channel[i];
+        sConfig.Rank         = i + 1;
+        sConfig.SamplingTime = ADC_SAMPLETIME_15CYCLES;
+        sConfig.Offset       = 0;
+        HAL_ADC_ConfigChannel(&obj->handle, &sConfig);
+    }
+
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    obj->dma.Instance                 = stream;
+    obj->dma.Init.Channel             = dma_channel;
+    obj->dma.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+    obj->dma.Init.PeriphInc           = DMA_PINC_DISABLE;
+    obj->dma.Init.MemInc              = DMA_MINC_ENABLE;
+    obj->dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    obj->dma.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+    obj->dma.Init.Mode                = DMA_CIRCULAR;
+    obj->dma.Init.Priority            = DMA_PRIORITY_HIGH;
+    obj->dma.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&obj->dma) != HAL_OK) {
+        error("Cannot initialize ADC DMA");
+    }
+    __HAL_LINKDMA(&obj->handle, DMA_Handle, obj->dma);
+
+    NVIC_SetVector(adc_dma_irqn[obj->index], vector);
+    NVIC_EnableIRQ(adc_dma_irqn[obj->index]);
+
+    __HAL_RCC_TIM2_CLK_ENABLE();
+    obj->timer.Instance = TIM2;
+    obj->timer.Init.Prescaler         = 0;
+    obj->timer.Init.Period            = 0;
+    obj->timer.Init.ClockDivision     = 0;
+    obj->timer.Init.CounterMode       = TIM_COUNTERMODE_UP;
+    obj->timer.Init.RepetitionCounter = 0;
+}
+
+void analogin_dma_free(analogin_dma_t *obj)
+{
+    analogin_dma_stop(obj);
+    NVIC_DisableIRQ(adc_dma_irqn[obj->index]);
+    HAL_DMA_DeInit(&obj->dma);
+    HAL_ADC_DeInit(&obj->handle);
+    HAL_TIM_Base_DeInit(&obj->timer);
+    adc_dma_objs[obj->index] = NULL;
+}
+
+uint32_t analogin_dma_set_rate(analogin_dma_t *obj, uint32_t hz)
+{
+    RCC_ClkInitTypeDef RCC_ClkInitStruct;
+    uint32_t latency;
+
+    if (hz == 0) {
+        return 0;
+    }
+
+    // TIM2 is on APB1, TIMxCLK = PCLKx when the APB prescaler = 1 else TIMxCLK = 2 * PCLKx
+    HAL_RCC_GetClockConfig(&RCC_ClkInitStruct, &latency);
+    uint32_t clk = HAL_RCC_GetPCLK1Freq();
+    if (RCC_ClkInitStruct.APB1CLKDivider != RCC_HCLK_DIV1) {
+        clk *= 2;
+    }
+
+    // One conversion takes 15 + 12 ADC cycles, the ADC runs at PCLK2 / 2
+    uint32_t max_hz = HAL_RCC_GetPCLK2Freq() / 2 / (27 * obj->channels);
+    if (hz > max_hz || hz > clk) {
+        return 0;
+    }
+
+    // TIM2 is 32-bit, no prescaler needed
+    uint32_t period = (clk + hz / 2) / hz;
+    obj->timer.Init.Period = period - 1;
+    if (HAL_TIM_Base_Init(&obj->timer) != HAL_OK) {
+        return 0;
+    }
+
+    TIM_MasterConfigTypeDef master = {0};
+    master.MasterOutputTrigger = TIM_TRGO_UPDATE;
+    master.MasterSlaveMode     = TIM_MASTERSLAVEMODE_DISABLE;
+    HAL_TIMEx_MasterConfigSynchronization(&obj->timer, &master);
+
+    return clk / period;
+}
+
+int analogin_dma_start(analogin_dma_t *obj, uint16_t *buffer, size_t length, analogin_dma_handler_t handler, uint32_t id)
+{
+    obj->handler = handler;
+    obj->id = id;
+
+    if (HAL_ADC_Start_DMA(&obj->handle, (uint32_t *)buffer, length) != HAL_OK) {
+        return -1;
+    }
+
+    // Report straight from the DMA interrupt, the ADC level callbacks are global
+    obj->dma.XferHalfCpltCallback = adc_dma_half;
+    obj->dma.XferCpltCallback     = adc_dma_full;
+    obj->dma.XferErrorCallback    = adc_dma_error;
+
+    if (HAL_TIM_Base_Start(&obj->timer) != HAL_OK) {
+        HAL_ADC_Stop_DMA(&obj->handle);
+        return -1;
+    }
+    return 0;
+}
+
+void analogin_dma_stop(analogin_dma_t *obj)
+{
+    HAL_TIM_Base_Stop(&obj->timer);
+    HAL_ADC_Stop_DMA(&obj->handle);
+}
+
+#endif
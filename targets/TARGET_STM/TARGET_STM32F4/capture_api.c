@@ -0,0 +1,351 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_assert.h"
+#include "capture_api.h"
+
+#if DEVICE_CAPTURE
+
+#include "cmsis.h"
+#include "pinmap.h"
+#include "mbed_error.h"
+#include "PeripheralPins.h"
+#include "us_ticker_data.h"
+
+/* Only the 32-bit timers TIM2 and TIM5 are supported, so that timestamps are
+ * stored as words by DMA. DMA1 request mapping from the reference manual:
+ *   TIM2 channel 3: CH1 stream 5, CH2 stream 6, CH3 stream 1, CH4 stream 7
+ *   TIM5 channel 6: CH1 stream 2, CH2 stream 4, CH3 stream 0, CH4 stream 3
+ */
+#define CAPTURE_STREAMS 8
+
+static capture_t *capture_objs[CAPTURE_STREAMS];
+static DMA_Stream_TypeDef *const capture_stream[CAPTURE_STREAMS] = {
+    DMA1_Stream0, DMA1_Stream1, DMA1_Stream2, DMA1_Stream3,
+    DMA1_Stream4, DMA1_Stream5, DMA1_Stream6, DMA1_Stream7
+};
+static const IRQn_Type capture_irqn[CAPTURE_STREAMS] = {
+    DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+    DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn
+};
+
+static const uint8_t tim2_streams[4] = {5, 6, 1, 7};
+static const uint8_t tim5_streams[4] = {2, 4, 0, 3};
+
+/* Input filter lengths in sampling clock cycles for ICFilter 0 to 15. The
+ * first three settings sample at the timer clock, the others at the dead-time
+ * clock, which can be divided by 4 for longer filters.
+ */
+static const uint16_t filter_cycles[16] = {
+    0, 2, 4, 8, 12, 16, 24, 32, 48, 64, 80, 96, 128, 160, 192, 256
+};
+
+static void capture_dma_irq(int stream)
+{
+    capture_t *obj = capture_objs[stream];
+    if (obj) {
+        HAL_DMA_IRQHandler(&obj->dma);
+    }
+}
+
+static void capture_dma0_irq(void)
+{
+    capture_dma_irq(0);
+}
+
+static void capture_dma1_irq(void)
+{
+    capture_dma_irq(1);
+}
+
+static void capture_dma2_irq(void)
+{
+    capture_dma_irq(2);
+}
+
+static void capture_dma3_irq(void)
+{
+    capture_dma_irq(3);
+}
+
+static void capture_dma4_irq(void)
+{
+    capture_dma_irq(4);
+}
+
+static void capture_dma5_irq(void)
+{
+    capture_dma_irq(5);
+}
+
+static void capture_dma6_irq(void)
+{
+    capture_dma_irq(6);
+}
+
+static void capture_dma7_irq(void)
+{
+    capture_dma_irq(7);
+}
+
+static void (*const capture_vector[CAPTURE_STREAMS])(void) = {
+    capture_dma0_irq, capture_dma1_irq, capture_dma2_irq, capture_dma3_irq,
+    capture_dma4_irq, capture_dma5_irq, capture_dma6_irq, capture_dma7_irq
+};
+
+static capture_t *obj_from_dma(DMA_HandleTypeDef *hdma)
+{
+    // The timer handle is the first member of capture_s
+    return (capture_t *)hdma->Parent;
+}
+
+static void capture_dma_half(DMA_HandleTypeDef *hdma)
+{
+    capture_t *obj = obj_from_dma(hdma);
+    obj->handler(obj->id, CAPTURE_EVENT_HALF);
+}
+
+static void capture_dma_full(DMA_HandleTypeDef *hdma)
+{
+    capture_t *obj = obj_from_dma(hdma);
+    obj->handler(obj->id, CAPTURE_EVENT_FULL);
+}
+
+static void capture_dma_error(DMA_HandleTypeDef *hdma)
+{
+    capture_t *obj = obj_from_dma(hdma);
+    __HAL_TIM_DISABLE(&obj->timer);
+    obj->handler(obj->id, CAPTURE_EVENT_ERROR);
+}
+
+static uint32_t capture_dma_request(capture_t *obj)
+{
+    switch (obj->channel) {
+        case TIM_CHANNEL_1:
+            return TIM_DMA_CC1;
+        case TIM_CHANNEL_2:
+            return TIM_DMA_CC2;
+        case TIM_CHANNEL_3:
+            return TIM_DMA_CC3;
+        default:
+            return TIM_DMA_CC4;
+    }
+}
+
+static volatile uint32_t *capture_register(capture_t *obj)
+{
+    switch (obj->channel) {
+        case TIM_CHANNEL_1:
+            return &obj->timer.Instance->CCR1;
+        case TIM_CHANNEL_2:
+            return &obj->timer.Instance->CCR2;
+        case TIM_CHANNEL_3:
+            return &obj->timer.Instance->CCR3;
+        default:
+            return &obj->timer.Instance->CCR4;
+    }
+}
+
+void capture_init(capture_t *obj, PinName pin)
+{
+    TIM_TypeDef *tim = (TIM_TypeDef *)pinmap_peripheral(pin, PinMap_PWM);
+    MBED_ASSERT(tim != (TIM_TypeDef *)NC);
+    MBED_ASSERT(tim != TIM_MST);
+
+    uint32_t function = pinmap_function(pin, PinMap_PWM);
+    MBED_ASSERT(function != (uint32_t)NC);
+    // Complementary outputs cannot capture
+    MBED_ASSERT(!STM_PIN_INVERTED(function));
+    int channel = STM_PIN_CHANNEL(function);
+    MBED_ASSERT(channel >= 1 && channel <= 4);
+
+    uint32_t dma_channel;
+    if (tim == TIM2) {
+        __HAL_RCC_TIM2_CLK_ENABLE();
+        obj->stream = tim2_streams[channel - 1];
+        dma_channel = DMA_CHANNEL_3;
+#if defined(TIM5)
+    } else if (tim == TIM5) {
+        __HAL_RCC_TIM5_CLK_ENABLE();
+        obj->stream = tim5_streams[channel - 1];
+        dma_channel = DMA_CHANNEL_6;
+#endif
+    } else {
+        error("Input capture needs a 32-bit timer");
+        return;
+    }
+    MBED_ASSERT(capture_objs[obj->stream] == NULL);
+    capture_objs[obj->stream] = obj;
+
+    static const uint32_t channels[4] = {TIM_CHANNEL_1, TIM_CHANNEL_2, TIM_CHANNEL_3, TIM_CHANNEL_4};
+    obj->channel = channels[channel - 1];
+    obj->filter = 0;
+    obj->length = 0;
+    obj->handler = NULL;
+    obj->id = 0;
+
+    // TIM2 and TIM5 are on APB1, TIMxCLK = PCLKx when the APB prescaler = 1 else TIMxCLK = 2 * PCLKx
+    RCC_ClkInitTypeDef RCC_ClkInitStruct;
+    uint32_t latency;
+    HAL_RCC_GetClockConfig(&RCC_ClkInitStruct, &latency);
+    obj->clock = HAL_RCC_GetPCLK1Freq();
+    if (RCC_ClkInitStruct.APB1CLKDivider != RCC_HCLK_DIV1) {
+        obj->clock *= 2;
+    }
+
+    pinmap_pinout(pin, PinMap_PWM);
+
+    obj->timer.Instance = tim;
+    obj->timer.State = HAL_TIM_STATE_RESET;
+    obj->timer.Init.Prescaler         = 0;
+    obj->timer.Init.Period            = 0xFFFFFFFF;
+    obj->timer.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+    obj->timer.Init.CounterMode       = TIM_COUNTERMODE_UP;
+    obj->timer.Init.RepetitionCounter = 0;
+
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    obj->dma.Instance                 = capture_stream[obj->stream];
+    obj->dma.Init.Channel             = dma_channel;
+    obj->dma.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+    obj->dma.Init.PeriphInc           = DMA_PINC_DISABLE;
+    obj->dma.Init.MemInc              = DMA_MINC_ENABLE;
+    obj->dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    obj->dma.Init.MemDataAlignment    = DMA_MDATAALIGN_WORD;
+    obj->dma.Init.Mode                = DMA_CIRCULAR;
+    obj->dma.Init.Priority            = DMA_PRIORITY_HIGH;
+    obj->dma.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&obj->dma) != HAL_OK) {
+        error("Cannot initialize capture DMA");
+    }
+    obj->dma.Parent = &obj->timer;
+
+    NVIC_SetVector(capture_irqn[obj->stream], (uint32_t)capture_vector[obj->stream]);
+    NVIC_EnableIRQ(capture_irqn[obj->stream]);
+}
+
+void capture_free(capture_t *obj)
+{
+    capture_stop(obj);
+    NVIC_DisableIRQ(capture_irqn[obj->stream]);
+    HAL_DMA_DeInit(&obj->dma);
+    HAL_TIM_IC_DeInit(&obj->timer);
+    capture_objs[obj->stream] = NULL;
+}
+
+uint32_t capture_set_frequency(capture_t *obj, uint32_t hz)
+{
+    if (hz == 0 || hz > obj->clock) {
+        return 0;
+    }
+
+    uint32_t prescaler = (obj->clock + hz / 2) / hz;
+    if (prescaler > 0x10000) {
+        return 0;
+    }
+    obj->timer.Init.Prescaler = prescaler - 1;
+    return obj->clock / prescaler;
+}
+
+uint32_t capture_set_filter(capture_t *obj, uint32_t ns)
+{
+    uint64_t cycles = ((uint64_t)ns * obj->clock + 999999999) / 1000000000;
+
+    // Filters from ICFilter 4 on are sampled at the dead-time clock
+    uint32_t division = TIM_CLOCKDIVISION_DIV1;
+    uint32_t scale = 1;
+    if (cycles > filter_cycles[15]) {
+        division = TIM_CLOCKDIVISION_DIV4;
+        scale = 4;
+    }
+
+    uint32_t filter = 15;
+    for (uint32_t i = 0; i < 16; i++) {
+        uint32_t length = (i < 4) ? filter_cycles[i] : filter_cycles[i] * scale;
+        if (length >= cycles) {
+            filter = i;
+            break;
+        }
+    }
+    obj->filter = filter;
+    obj->timer.Init.ClockDivision = division;
+
+    uint32_t length = (filter < 4) ? filter_cycles[filter] : filter_cycles[filter] * scale;
+    return (uint32_t)(((uint64_t)length * 1000000000) / obj->clock);
+}
+
+int capture_start(capture_t *obj, capture_edge_t edge, uint32_t *buffer, size_t length, capture_handler_t handler, uint32_t id)
+{
+    obj->handler = handler;
+    obj->id = id;
+    obj->length = length;
+
+    if (HAL_TIM_IC_Init(&obj->timer) != HAL_OK) {
+        return -1;
+    }
+
+    TIM_IC_InitTypeDef config = {0};
+    switch (edge) {
+        case CAPTURE_EDGE_RISING:
+            config.ICPolarity = TIM_ICPOLARITY_RISING;
+            break;
+        case CAPTURE_EDGE_FALLING:
+            config.ICPolarity = TIM_ICPOLARITY_FALLING;
+            break;
+        default:
+            config.ICPolarity = TIM_ICPOLARITY_BOTHEDGE;
+            break;
+    }
+    config.ICSelection = TIM_ICSELECTION_DIRECTTI;
+    config.ICPrescaler = TIM_ICPSC_DIV1;
+    config.ICFilter    = obj->filter;
+    if (HAL_TIM_IC_ConfigChannel(&obj->timer, &config, obj->channel) != HAL_OK) {
+        return -1;
+    }
+
+    // Report straight from the DMA interrupt, the timer level callbacks are global
+    obj->dma.XferHalfCpltCallback = capture_dma_half;
+    obj->dma.XferCpltCallback     = capture_dma_full;
+    obj->dma.XferErrorCallback    = capture_dma_error;
+    if (HAL_DMA_Start_IT(&obj->dma, (uint32_t)capture_register(obj), (uint32_t)buffer, length) != HAL_OK) {
+        return -1;
+    }
+
+    __HAL_TIM_SET_COUNTER(&obj->timer, 0);
+    __HAL_TIM_ENABLE_DMA(&obj->timer, capture_dma_request(obj));
+    TIM_CCxChannelCmd(obj->timer.Instance, obj->channel, TIM_CCx_ENABLE);
+    __HAL_TIM_ENABLE(&obj->timer);
+    return 0;
+}
+
+size_t capture_get_position(capture_t *obj)
+{
+    if (obj->length == 0) {
+        return 0;
+    }
+    // NDTR counts down the timestamps left before the buffer wraps
+    return (obj->length - obj->dma.Instance->NDTR) % obj->length;
+}
+
+void capture_stop(capture_t *obj)
+{
+    __HAL_TIM_DISABLE(&obj->timer);
+    TIM_CCxChannelCmd(obj->timer.Instance, obj->channel, TIM_CCx_DISABLE);
+    __HAL_TIM_DISABLE_DMA(&obj->timer, capture_dma_request(obj));
+    HAL_DMA_Abort(&obj->dma);
+    obj->length = 0;
+}
+
+#endif
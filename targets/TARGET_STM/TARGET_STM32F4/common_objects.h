@@ -124,6 +124,33 @@ struct analogin_s {
     uint8_t channel;
 };
 
+#if DEVICE_ANALOGIN_DMA
+struct analogin_dma_s {
+    ADC_HandleTypeDef handle; // must be first, recovered from the DMA handle parent
+    DMA_HandleTypeDef dma;
+    TIM_HandleTypeDef timer;
+    uint8_t channel[16];
+    uint8_t channels;
+    uint8_t index;
+    void (*handler)(uint32_t id, uint32_t event);
+    uint32_t id;
+};
+#endif
+
+#if DEVICE_CAPTURE
+struct capture_s {
+    TIM_HandleTypeDef timer; // must be first, recovered from the DMA handle parent
+    DMA_HandleTypeDef dma;
+    uint32_t channel;
+    uint32_t clock;
+    uint32_t filter;
+    uint32_t length;
+    uint8_t stream;
+    void (*handler)(uint32_t id, uint32_t event);
+    uint32_t id;
+};
+#endif
+
 #define GPIO_IP_WITHOUT_BRR
 #include "gpio_object.h"
 
@@ -0,0 +1,236 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_assert.h"
+#include "pwmout_api.h"
+
+#if DEVICE_PWMOUT
+
+#include "cmsis.h"
+#include "mbed_error.h"
+
+/* Each value is written by DMA into the preloaded compare register on the
+ * timer update event, so it takes effect from the next period. Only timers
+ * with an update DMA request and a 16-bit compare register are supported.
+ * DMA request mapping from the reference manual:
+ *   TIM1_UP: DMA2 stream 5 channel 6    TIM3_UP: DMA1 stream 2 channel 5
+ *   TIM4_UP: DMA1 stream 6 channel 2    TIM8_UP: DMA2 stream 1 channel 7
+ */
+#define SEQUENCE_TIMERS 4
+
+typedef struct {
+    TIM_TypeDef *tim;
+    DMA_Stream_TypeDef *stream;
+    uint32_t channel;
+    IRQn_Type irqn;
+} sequence_dma_t;
+
+static const sequence_dma_t sequence_dma[SEQUENCE_TIMERS] = {
+#if defined(TIM1)
+    {TIM1, DMA2_Stream5, DMA_CHANNEL_6, DMA2_Stream5_IRQn},
+#else
+    {NULL, NULL, 0, (IRQn_Type)0},
+#endif
+#if defined(TIM3)
+    {TIM3, DMA1_Stream2, DMA_CHANNEL_5, DMA1_Stream2_IRQn},
+#else
+    {NULL, NULL, 0, (IRQn_Type)0},
+#endif
+#if defined(TIM4)
+    {TIM4, DMA1_Stream6, DMA_CHANNEL_2, DMA1_Stream6_IRQn},
+#else
+    {NULL, NULL, 0, (IRQn_Type)0},
+#endif
+#if defined(TIM8)
+    {TIM8, DMA2_Stream1, DMA_CHANNEL_7, DMA2_Stream1_IRQn},
+#else
+    {NULL, NULL, 0, (IRQn_Type)0},
+#endif
+};
+
+typedef struct {
+    DMA_HandleTypeDef dma; // must be first, recovered from the DMA handle
+    pwmout_t *obj;
+    uint16_t *values;
+    size_t count;
+    pwmout_sequence_handler_t handler;
+    uint32_t id;
+} sequence_t;
+
+static sequence_t sequences[SEQUENCE_TIMERS];
+
+static void sequence_dma_irq(int index)
+{
+    if (sequences[index].obj) {
+        HAL_DMA_IRQHandler(&sequences[index].dma);
+    }
+}
+
+static void sequence0_dma_irq(void)
+{
+    sequence_dma_irq(0);
+}
+
+static void sequence1_dma_irq(void)
+{
+    sequence_dma_irq(1);
+}
+
+static void sequence2_dma_irq(void)
+{
+    sequence_dma_irq(2);
+}
+
+static void sequence3_dma_irq(void)
+{
+    sequence_dma_irq(3);
+}
+
+static void (*const sequence_vector[SEQUENCE_TIMERS])(void) = {
+    sequence0_dma_irq, sequence1_dma_irq, sequence2_dma_irq, sequence3_dma_irq
+};
+
+static int sequence_index(pwmout_t *obj)
+{
+    for (int i = 0; i < SEQUENCE_TIMERS; i++) {
+        if (sequence_dma[i].tim != NULL && sequence_dma[i].tim == (TIM_TypeDef *)obj->pwm) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static volatile uint32_t *compare_register(pwmout_t *obj)
+{
+    TIM_TypeDef *tim = (TIM_TypeDef *)obj->pwm;
+    switch (obj->channel) {
+        case 1:
+            return &tim->CCR1;
+        case 2:
+            return &tim->CCR2;
+        case 3:
+            return &tim->CCR3;
+        default:
+            return &tim->CCR4;
+    }
+}
+
+// Stop the update requests and leave the output at the last value of the sequence
+static void sequence_end(sequence_t *seq)
+{
+    pwmout_t *obj = seq->obj;
+    uint16_t last = seq->values[seq->count - 1];
+    ((TIM_TypeDef *)obj->pwm)->DIER &= ~TIM_DIER_UDE;
+    *compare_register(obj) = last;
+    obj->pulse = last * obj->prescaler;
+}
+
+static void sequence_complete(DMA_HandleTypeDef *hdma)
+{
+    sequence_t *seq = (sequence_t *)hdma;
+    if (hdma->Init.Mode != DMA_CIRCULAR) {
+        // The last value has just been written to the preload register
+        sequence_end(seq);
+    }
+    if (seq->handler) {
+        seq->handler(seq->id, PWMOUT_SEQUENCE_EVENT_COMPLETE);
+    }
+}
+
+static void sequence_error(DMA_HandleTypeDef *hdma)
+{
+    sequence_t *seq = (sequence_t *)hdma;
+    sequence_end(seq);
+    if (seq->handler) {
+        seq->handler(seq->id, PWMOUT_SEQUENCE_EVENT_ERROR);
+    }
+}
+
+uint32_t pwmout_sequence_max(pwmout_t *obj)
+{
+    if (sequence_index(obj) < 0) {
+        return 0;
+    }
+    return obj->period / obj->prescaler;
+}
+
+int pwmout_sequence_start(pwmout_t *obj, uint16_t *values, size_t count, bool loop, pwmout_sequence_handler_t handler, uint32_t id)
+{
+    int index = sequence_index(obj);
+    if (index < 0 || count == 0 || count > 0xFFFF) {
+        return -1;
+    }
+    sequence_t *seq = &sequences[index];
+    if (seq->obj != NULL && seq->dma.State == HAL_DMA_STATE_BUSY) {
+        // One sequence at a time on each timer
+        return -1;
+    }
+
+    seq->obj = obj;
+    seq->values = values;
+    seq->count = count;
+    seq->handler = handler;
+    seq->id = id;
+
+    if (sequence_dma[index].stream == DMA2_Stream5 || sequence_dma[index].stream == DMA2_Stream1) {
+        __HAL_RCC_DMA2_CLK_ENABLE();
+    } else {
+        __HAL_RCC_DMA1_CLK_ENABLE();
+    }
+    seq->dma.Instance                 = sequence_dma[index].stream;
+    seq->dma.Init.Channel             = sequence_dma[index].channel;
+    seq->dma.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+    seq->dma.Init.PeriphInc           = DMA_PINC_DISABLE;
+    seq->dma.Init.MemInc              = DMA_MINC_ENABLE;
+    seq->dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    seq->dma.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+    seq->dma.Init.Mode                = loop ? DMA_CIRCULAR : DMA_NORMAL;
+    seq->dma.Init.Priority            = DMA_PRIORITY_HIGH;
+    seq->dma.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&seq->dma) != HAL_OK) {
+        seq->obj = NULL;
+        return -1;
+    }
+    seq->dma.XferCpltCallback     = sequence_complete;
+    seq->dma.XferHalfCpltCallback = NULL;
+    seq->dma.XferErrorCallback    = sequence_error;
+
+    NVIC_SetVector(sequence_dma[index].irqn, (uint32_t)sequence_vector[index]);
+    NVIC_EnableIRQ(sequence_dma[index].irqn);
+
+    if (HAL_DMA_Start_IT(&seq->dma, (uint32_t)values, (uint32_t)compare_register(obj), count) != HAL_OK) {
+        seq->obj = NULL;
+        return -1;
+    }
+    // pwmout_write enabled the compare preload, the first value is used from the period after next
+    ((TIM_TypeDef *)obj->pwm)->DIER |= TIM_DIER_UDE;
+    return 0;
+}
+
+void pwmout_sequence_stop(pwmout_t *obj)
+{
+    int index = sequence_index(obj);
+    if (index < 0 || sequences[index].obj != obj) {
+        return;
+    }
+    sequence_t *seq = &sequences[index];
+    HAL_DMA_Abort(&seq->dma);
+    sequence_end(seq);
+    NVIC_DisableIRQ(sequence_dma[index].irqn);
+    seq->obj = NULL;
+}
+
+#endif
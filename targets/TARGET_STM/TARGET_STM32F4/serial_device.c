@@ -712,9 +712,10 @@ void serial_rx_abort_asynch(serial_t *obj)
     __HAL_UART_DISABLE_IT(huart, UART_IT_PE);
     __HAL_UART_DISABLE_IT(huart, UART_IT_ERR);
 
-    // clear flags
-    __HAL_UART_CLEAR_FLAG(huart, UART_FLAG_RXNE);
-    volatile uint32_t tmpval __attribute__((unused)) = huart->Instance->DR; // Clear errors flag
+    // clear error flags, a character already received is left for the next transaction
+    if (huart->Instance->SR & (USART_SR_PE | USART_SR_FE | USART_SR_NE | USART_SR_ORE)) {
+        volatile uint32_t tmpval __attribute__((unused)) = huart->Instance->DR; // Clear errors flag
+    }
 
     // reset states
     huart->RxXferCount = 0;
@@ -726,6 +727,19 @@ void serial_rx_abort_asynch(serial_t *obj)
     }
 }
 
+/**
+ * Get the number of characters received by the ongoing RX transaction, or by
+ * the last one once aborted
+ *
+ * @param obj The serial object
+ * @return The number of characters received
+ */
+int serial_rx_asynch_received(serial_t *obj)
+{
+    // Updated for each character by serial_irq_handler_asynch
+    return obj->rx_buff.pos;
+}
+
 #endif /* DEVICE_SERIAL_ASYNCH */
 
 #if DEVICE_SERIAL_FC
@@ -36,6 +36,12 @@
 static uint32_t GetSector(uint32_t Address);
 static uint32_t GetSectorSize(uint32_t Sector);
 
+/* Asynchronous programming is done one flash word at a time, continued from the interrupt */
+static uint32_t async_address;
+static const uint8_t *async_data;
+static uint32_t async_size;
+static volatile int32_t async_error;
+
 int32_t flash_init(flash_t *obj)
 {
     /* Clear pending flags (if any) */
@@ -203,4 +209,119 @@ uint8_t flash_get_erase_value(const flash_t *obj)
     return 0xFF;
 }
 
+uint32_t flash_get_bank(const flash_t *obj, uint32_t address)
+{
+    return (address < ADDR_FLASH_SECTOR_0_BANK2) ? 0 : 1;
+}
+
+void HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue)
+{
+    async_error = 1;
+}
+
+static void flash_async_start(uint32_t handler)
+{
+    async_error = 0;
+    NVIC_SetVector(FLASH_IRQn, handler);
+    NVIC_ClearPendingIRQ(FLASH_IRQn);
+    NVIC_EnableIRQ(FLASH_IRQn);
+}
+
+static void flash_async_stop(void)
+{
+    NVIC_DisableIRQ(FLASH_IRQn);
+    HAL_FLASH_Lock();
+}
+
+static int32_t flash_async_program_next(void)
+{
+    uint32_t address = async_address;
+    const uint8_t *data = async_data;
+
+    /* Advance first, the interrupt may come before HAL_FLASH_Program_IT returns */
+    async_address += 32;
+    async_data += 32;
+    async_size -= 32;
+
+    if (HAL_FLASH_Program_IT(FLASH_TYPEPROGRAM_FLASHWORD, address, (uint32_t)data) != HAL_OK) {
+        return -1;
+    }
+    return 0;
+}
+
+int32_t flash_erase_sector_asynch(flash_t *obj, uint32_t address, uint32_t handler)
+{
+    FLASH_EraseInitTypeDef EraseInitStruct;
+
+    if ((address >= (FLASH_BASE + FLASH_SIZE)) || (address < FLASH_BASE)) {
+        return -1;
+    }
+
+    if (HAL_FLASH_Unlock() != HAL_OK) {
+        return -1;
+    }
+
+    EraseInitStruct.TypeErase = FLASH_TYPEERASE_SECTORS;
+    EraseInitStruct.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    EraseInitStruct.Sector = GetSector(address);
+    EraseInitStruct.NbSectors = 1;
+    EraseInitStruct.Banks = (address < ADDR_FLASH_SECTOR_0_BANK2) ? FLASH_BANK_1 : FLASH_BANK_2;
+
+    async_size = 0;
+    flash_async_start(handler);
+    if (HAL_FLASHEx_Erase_IT(&EraseInitStruct) != HAL_OK) {
+        flash_async_stop();
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t flash_program_page_asynch(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size, uint32_t handler)
+{
+    if ((address >= (FLASH_BASE + FLASH_SIZE)) || (address < FLASH_BASE)) {
+        return -1;
+    }
+
+    if ((size == 0) || ((size % 32) != 0)) {
+        /* H7 flash devices can only be programmed 256bits/32 bytes at a time */
+        return -1;
+    }
+
+    if (HAL_FLASH_Unlock() != HAL_OK) {
+        return -1;
+    }
+
+    async_address = address;
+    async_data = data;
+    async_size = size;
+    flash_async_start(handler);
+    if (flash_async_program_next() != 0) {
+        flash_async_stop();
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t flash_irq_handler_asynch(flash_t *obj)
+{
+    HAL_FLASH_IRQHandler();
+
+    if (pFlash.ProcedureOnGoing != FLASH_PROC_NONE) {
+        return 0;
+    }
+
+    if ((async_size > 0) && !async_error) {
+        if (flash_async_program_next() == 0) {
+            return 0;
+        }
+        async_error = 1;
+    }
+
+    flash_async_stop();
+
+    return async_error ? -1 : 1;
+}
+
 #endif
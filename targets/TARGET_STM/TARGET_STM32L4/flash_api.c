@@ -20,6 +20,15 @@
 #if DEVICE_FLASH
 #include "mbed_assert.h"
 #include "cmsis.h"
+#include <string.h>
+
+extern FLASH_ProcessTypeDef pFlash;
+
+/* Asynchronous programming is done one double word at a time, continued from the interrupt */
+static uint32_t async_address;
+static const uint8_t *async_data;
+static uint32_t async_size;
+static volatile int32_t async_error;
 
 /**
   * @brief  Gets the page of a given address
@@ -291,4 +300,125 @@ uint8_t flash_get_erase_value(const flash_t *obj)
     return 0xFF;
 }
 
+uint32_t flash_get_bank(const flash_t *obj, uint32_t address)
+{
+    return (GetBank(address) == FLASH_BANK_1) ? 0 : 1;
+}
+
+void HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue)
+{
+    async_error = 1;
+}
+
+static void flash_async_start(uint32_t handler)
+{
+    async_error = 0;
+
+    /* Clear error programming flags */
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+
+    NVIC_SetVector(FLASH_IRQn, handler);
+    NVIC_ClearPendingIRQ(FLASH_IRQn);
+    NVIC_EnableIRQ(FLASH_IRQn);
+}
+
+static void flash_async_stop(void)
+{
+    NVIC_DisableIRQ(FLASH_IRQn);
+    flash_lock();
+}
+
+static int32_t flash_async_program_next(void)
+{
+    uint32_t address = async_address;
+    uint64_t data64;
+
+    /* HW needs an aligned address to program flash, which data doesn't ensure */
+    memcpy(&data64, async_data, sizeof(data64));
+
+    /* Advance first, the interrupt may come before HAL_FLASH_Program_IT returns */
+    async_address += 8;
+    async_data += 8;
+    async_size -= 8;
+
+    if (HAL_FLASH_Program_IT(FLASH_TYPEPROGRAM_DOUBLEWORD, address, data64) != HAL_OK) {
+        return -1;
+    }
+    return 0;
+}
+
+int32_t flash_erase_sector_asynch(flash_t *obj, uint32_t address, uint32_t handler)
+{
+    FLASH_EraseInitTypeDef EraseInitStruct;
+
+    if ((address >= (FLASH_BASE + FLASH_SIZE)) || (address < FLASH_BASE)) {
+        return -1;
+    }
+
+    if (flash_unlock() != HAL_OK) {
+        return -1;
+    }
+
+    EraseInitStruct.TypeErase   = FLASH_TYPEERASE_PAGES;
+    EraseInitStruct.Banks       = GetBank(address);
+    EraseInitStruct.Page        = GetPage(address);
+    EraseInitStruct.NbPages     = 1;
+
+    async_size = 0;
+    flash_async_start(handler);
+    if (HAL_FLASHEx_Erase_IT(&EraseInitStruct) != HAL_OK) {
+        flash_async_stop();
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t flash_program_page_asynch(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size, uint32_t handler)
+{
+    if ((address >= (FLASH_BASE + FLASH_SIZE)) || (address < FLASH_BASE)) {
+        return -1;
+    }
+
+    if ((size == 0) || ((size % 8) != 0)) {
+        /* L4 flash devices can only be programmed 64bits/8 bytes at a time */
+        return -1;
+    }
+
+    if (flash_unlock() != HAL_OK) {
+        return -1;
+    }
+
+    async_address = address;
+    async_data = data;
+    async_size = size;
+    flash_async_start(handler);
+    if (flash_async_program_next() != 0) {
+        flash_async_stop();
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t flash_irq_handler_asynch(flash_t *obj)
+{
+    HAL_FLASH_IRQHandler();
+
+    if (pFlash.ProcedureOnGoing != FLASH_PROC_NONE) {
+        return 0;
+    }
+
+    if ((async_size > 0) && !async_error) {
+        if (flash_async_program_next() == 0) {
+            return 0;
+        }
+        async_error = 1;
+    }
+
+    flash_async_stop();
+
+    return async_error ? -1 : 1;
+}
+
 #endif
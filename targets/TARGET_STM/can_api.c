@@ -26,6 +26,9 @@
 static uint32_t can_irq_ids[2] = {0};
 static can_irq_handler irq_handler;
 
+// Number of filters of each format, the filter handle selects one of them
+#define FDCAN_FILTERS_NBR 8
+
 /** Call all the init functions
  *
  *  @returns
@@ -136,8 +139,8 @@ void can_init_freq(can_t *obj, PinName rd, PinName td, int hz)
     obj->CanHandle.Init.DataTimeSeg1 = 0x1;        // Not used - only in FDCAN
     obj->CanHandle.Init.DataTimeSeg2 = 0x1;        // Not used - only in FDCAN
     obj->CanHandle.Init.MessageRAMOffset = 0;
-    obj->CanHandle.Init.StdFiltersNbr = 1; // to be aligned with the handle parameter in can_filter
-    obj->CanHandle.Init.ExtFiltersNbr = 1; // to be aligned with the handle parameter in can_filter
+    obj->CanHandle.Init.StdFiltersNbr = FDCAN_FILTERS_NBR; // to be aligned with the handle parameter in can_filter
+    obj->CanHandle.Init.ExtFiltersNbr = FDCAN_FILTERS_NBR; // to be aligned with the handle parameter in can_filter
     obj->CanHandle.Init.RxFifo0ElmtsNbr = 8;
     obj->CanHandle.Init.RxFifo0ElmtSize = FDCAN_DATA_BYTES_8;
     obj->CanHandle.Init.RxFifo1ElmtsNbr = 0;
@@ -230,20 +233,22 @@ int can_frequency(can_t *obj, int f)
  */
 int can_filter(can_t *obj, uint32_t id, uint32_t mask, CANFormat format, int32_t handle)
 {
-    UNUSED(handle); // Not supported yet (seems to be a used in read function?)
-
     FDCAN_FilterTypeDef sFilterConfig = {0};
 
+    if (handle < 0 || handle >= FDCAN_FILTERS_NBR) {
+        return 0;
+    }
+
     if (format == CANStandard) {
         sFilterConfig.IdType = FDCAN_STANDARD_ID;
-        sFilterConfig.FilterIndex = 0;
+        sFilterConfig.FilterIndex = handle;
         sFilterConfig.FilterType = FDCAN_FILTER_MASK;
         sFilterConfig.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
         sFilterConfig.FilterID1 = id;
         sFilterConfig.FilterID2 = mask;
     } else if (format == CANExtended) {
         sFilterConfig.IdType = FDCAN_EXTENDED_ID;
-        sFilterConfig.FilterIndex = 0;
+        sFilterConfig.FilterIndex = handle;
         sFilterConfig.FilterType = FDCAN_FILTER_MASK;
         sFilterConfig.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
         sFilterConfig.FilterID1 = id;
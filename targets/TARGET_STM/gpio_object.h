@@ -55,22 +55,40 @@ typedef struct {
     uint32_t ll_pin;
 } gpio_t;
 
-static inline void gpio_write(gpio_t *obj, int value)
+/* Fast GPIO API, see hal/gpio_fast_api.h */
+#define GPIO_FAST_API
+
+static inline void gpio_fast_set(gpio_t *obj)
+{
+    *obj->reg_set = obj->mask;
+}
+
+static inline void gpio_fast_clear(gpio_t *obj)
 {
-    if (value) {
-        *obj->reg_set = obj->mask;
-    } else {
 #ifdef GPIO_IP_WITHOUT_BRR
-        *obj->reg_clr = obj->mask << 16;
+    *obj->reg_clr = obj->mask << 16;
 #else
-        *obj->reg_clr = obj->mask;
+    *obj->reg_clr = obj->mask;
 #endif
+}
+
+static inline int gpio_fast_read(gpio_t *obj)
+{
+    return ((*obj->reg_in & obj->mask) ? 1 : 0);
+}
+
+static inline void gpio_write(gpio_t *obj, int value)
+{
+    if (value) {
+        gpio_fast_set(obj);
+    } else {
+        gpio_fast_clear(obj);
     }
 }
 
 static inline int gpio_read(gpio_t *obj)
 {
-    return ((*obj->reg_in & obj->mask) ? 1 : 0);
+    return gpio_fast_read(obj);
 }
 
 static inline int gpio_is_connected(const gpio_t *obj)
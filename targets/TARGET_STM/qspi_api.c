@@ -320,6 +320,202 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
     return status;
 }
 
+qspi_status_t qspi_memory_map(qspi_t *obj, const qspi_command_t *command, const void **address)
+{
+    QSPI_CommandTypeDef st_command;
+    QSPI_MemoryMappedTypeDef st_mapped;
+    qspi_prepare_command(command, &st_command);
+
+    st_mapped.TimeOutActivation = QSPI_TIMEOUT_COUNTER_DISABLE;
+    st_mapped.TimeOutPeriod = 0;
+
+    if (HAL_QSPI_MemoryMapped(&obj->handle, &st_command, &st_mapped) != HAL_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    // The flash may have been changed since the region was last cached
+    SCB_CleanInvalidateDCache();
+#endif
+
+    *address = (const void *)QSPI_BASE;
+    return QSPI_STATUS_OK;
+}
+
+qspi_status_t qspi_memory_unmap(qspi_t *obj)
+{
+    if (HAL_QSPI_Abort(&obj->handle) != HAL_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    return QSPI_STATUS_OK;
+}
+
+/* Asynchronous transfers are driven by the QUADSPI interrupt. On F4 and F7 the
+ * QUADSPI request is on DMA2 stream 7 channel 3, which is used for the data phase.
+ * Only one QSPI peripheral exists, so the transfer state is kept here. */
+#if defined(TARGET_STM32F4) || defined(TARGET_STM32F7)
+#define QSPI_ASYNC_DMA 1
+static DMA_HandleTypeDef qspi_dma;
+#endif
+
+static qspi_t *qspi_async_obj;
+static qspi_async_handler_t qspi_async_handler;
+static uint32_t qspi_async_id;
+static void *qspi_async_rx_data;
+static size_t qspi_async_length;
+
+static void qspi_irq(void)
+{
+    if (qspi_async_obj) {
+        HAL_QSPI_IRQHandler(&qspi_async_obj->handle);
+    }
+}
+
+static void qspi_async_done(qspi_status_t status)
+{
+    if (!qspi_async_obj) {
+        return;
+    }
+    qspi_async_obj = NULL;
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    if (qspi_async_rx_data) {
+        // Drop lines speculatively loaded while the DMA was running
+        SCB_InvalidateDCache_by_Addr((uint32_t *)qspi_async_rx_data, qspi_async_length);
+    }
+#endif
+
+    qspi_async_handler(qspi_async_id, status);
+}
+
+void HAL_QSPI_RxCpltCallback(QSPI_HandleTypeDef *hqspi)
+{
+    qspi_async_done(QSPI_STATUS_OK);
+}
+
+void HAL_QSPI_TxCpltCallback(QSPI_HandleTypeDef *hqspi)
+{
+    qspi_async_done(QSPI_STATUS_OK);
+}
+
+void HAL_QSPI_ErrorCallback(QSPI_HandleTypeDef *hqspi)
+{
+    qspi_async_done(QSPI_STATUS_ERROR);
+}
+
+#if QSPI_ASYNC_DMA
+static void qspi_dma_irq(void)
+{
+    HAL_DMA_IRQHandler(&qspi_dma);
+}
+
+static bool qspi_dma_capable(const void *data, size_t length)
+{
+#if defined(CCMDATARAM_BASE)
+    // CCM RAM is not reachable by the DMA
+    if ((uint32_t)data >= CCMDATARAM_BASE && (uint32_t)data <= CCMDATARAM_END) {
+        return false;
+    }
+#endif
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    // Cache maintenance works on whole lines, other buffers use the interrupt mode
+    if ((((uint32_t)data | length) & 31) != 0) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+static void qspi_dma_init(qspi_t *obj, uint32_t direction)
+{
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    qspi_dma.Instance                 = DMA2_Stream7;
+    qspi_dma.Init.Channel             = DMA_CHANNEL_3;
+    qspi_dma.Init.Direction           = direction;
+    qspi_dma.Init.PeriphInc           = DMA_PINC_DISABLE;
+    qspi_dma.Init.MemInc              = DMA_MINC_ENABLE;
+    qspi_dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    qspi_dma.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    qspi_dma.Init.Mode                = DMA_NORMAL;
+    qspi_dma.Init.Priority            = DMA_PRIORITY_HIGH;
+    qspi_dma.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+    HAL_DMA_Init(&qspi_dma);
+    __HAL_LINKDMA(&obj->handle, hdma, qspi_dma);
+
+    NVIC_SetVector(DMA2_Stream7_IRQn, (uint32_t)qspi_dma_irq);
+    NVIC_EnableIRQ(DMA2_Stream7_IRQn);
+}
+#endif
+
+static qspi_status_t qspi_async_start(qspi_t *obj, const qspi_command_t *command, void *data, size_t length, bool write, qspi_async_handler_t handler, uint32_t id)
+{
+    QSPI_CommandTypeDef st_command;
+    qspi_prepare_command(command, &st_command);
+
+    st_command.NbData = length;
+
+    if (HAL_QSPI_Command(&obj->handle, &st_command, HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    qspi_async_obj = obj;
+    qspi_async_handler = handler;
+    qspi_async_id = id;
+    qspi_async_rx_data = write ? NULL : data;
+    qspi_async_length = length;
+
+    NVIC_SetVector(QUADSPI_IRQn, (uint32_t)qspi_irq);
+    NVIC_EnableIRQ(QUADSPI_IRQn);
+
+    HAL_StatusTypeDef ret;
+#if QSPI_ASYNC_DMA
+    if (qspi_dma_capable(data, length)) {
+        qspi_dma_init(obj, write ? DMA_MEMORY_TO_PERIPH : DMA_PERIPH_TO_MEMORY);
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+        SCB_CleanInvalidateDCache_by_Addr((uint32_t *)data, length);
+#endif
+        if (write) {
+            ret = HAL_QSPI_Transmit_DMA(&obj->handle, (uint8_t *)data);
+        } else {
+            ret = HAL_QSPI_Receive_DMA(&obj->handle, (uint8_t *)data);
+        }
+    } else
+#endif
+    {
+        qspi_async_rx_data = NULL;
+        if (write) {
+            ret = HAL_QSPI_Transmit_IT(&obj->handle, (uint8_t *)data);
+        } else {
+            ret = HAL_QSPI_Receive_IT(&obj->handle, (uint8_t *)data);
+        }
+    }
+
+    if (ret != HAL_OK) {
+        qspi_async_obj = NULL;
+        return QSPI_STATUS_ERROR;
+    }
+
+    return QSPI_STATUS_OK;
+}
+
+qspi_status_t qspi_read_async(qspi_t *obj, const qspi_command_t *command, void *data, size_t length, qspi_async_handler_t handler, uint32_t id)
+{
+    return qspi_async_start(obj, command, data, length, false, handler, id);
+}
+
+qspi_status_t qspi_write_async(qspi_t *obj, const qspi_command_t *command, const void *data, size_t length, qspi_async_handler_t handler, uint32_t id)
+{
+    return qspi_async_start(obj, command, (void *)data, length, true, handler, id);
+}
+
+void qspi_abort_async(qspi_t *obj)
+{
+    // The blocking abort does not call the HAL callbacks
+    qspi_async_obj = NULL;
+    HAL_QSPI_Abort(&obj->handle);
+}
+
 const PinMap *qspi_master_sclk_pinmap()
 {
     return PinMap_QSPI_SCLK;
@@ -0,0 +1,141 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2019 ARM Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Report the hot spots of a sampling profile.
+
+The profile is the output of mbed_profiler_dump() on the target, the "PROF"
+lines are picked out of the rest of the console output. The sampled program
+counters are resolved to functions with the symbols of the ELF file of the
+application.
+
+    python tools/mbed_profiler_report.py BUILD/app.elf console.log
+    python tools/mbed_profiler_report.py BUILD/app.elf --threads console.log
+"""
+from __future__ import print_function
+
+import argparse
+import bisect
+import sys
+from collections import defaultdict
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+
+class Symbols(object):
+    """Function symbols of an ELF file, sorted by address"""
+
+    def __init__(self, elf_file):
+        elf = ELFFile(elf_file)
+        functions = {}
+        for section in elf.iter_sections():
+            if not isinstance(section, SymbolTableSection):
+                continue
+            for symbol in section.iter_symbols():
+                if symbol["st_info"]["type"] != "STT_FUNC" or not symbol.name:
+                    continue
+                # The Thumb bit is not part of the address
+                address = symbol["st_value"] & ~1
+                functions[address] = (symbol.name, symbol["st_size"])
+        self.addresses = sorted(functions)
+        self.functions = [functions[address] for address in self.addresses]
+
+    def lookup(self, pc):
+        index = bisect.bisect_right(self.addresses, pc) - 1
+        if index >= 0:
+            name, size = self.functions[index]
+            if pc < self.addresses[index] + max(size, 1):
+                return name
+        return "<0x%08x>" % pc
+
+
+class Profile(object):
+    """Samples read from the output of mbed_profiler_dump()"""
+
+    def __init__(self):
+        self.total = 0
+        self.other = 0
+        self.dropped = 0
+        self.threads = {}
+        self.samples = []
+
+    def parse(self, stream):
+        for line in stream:
+            fields = line.split()
+            if "PROF" not in fields:
+                continue
+            # Anything printed before the profile on the same line is skipped
+            fields = fields[fields.index("PROF") + 1:]
+            try:
+                if fields[0] == "total":
+                    self.total, self.other, self.dropped = [int(field) for field in fields[1:4]]
+                elif fields[0] == "thread":
+                    self.threads[int(fields[1], 16)] = " ".join(fields[2:])
+                elif fields[0] == "pc":
+                    self.samples.append((int(fields[1], 16), int(fields[2], 16), int(fields[3])))
+            except (IndexError, ValueError):
+                print("invalid profile line: %s" % line.rstrip(), file=sys.stderr)
+
+    def thread_name(self, thread_id):
+        if not thread_id:
+            return "-"
+        return self.threads.get(thread_id, "%08x" % thread_id)
+
+
+def report(profile, symbols, by_thread, limit, output):
+    """Prints the functions sampled most, optionally split by thread"""
+    counts = defaultdict(int)
+    for pc, thread_id, count in profile.samples:
+        key = (symbols.lookup(pc), profile.thread_name(thread_id) if by_thread else None)
+        counts[key] += count
+
+    total = max(profile.total, 1)
+    print("%d samples, %d outside threads, %d dropped" % (profile.total, profile.other, profile.dropped),
+          file=output)
+    print("", file=output)
+    ranked = sorted(counts.items(), key=lambda item: item[1], reverse=True)
+    for (function, thread), count in ranked[:limit] if limit else ranked:
+        line = "%6.2f%% %8d  %s" % (100.0 * count / total, count, function)
+        if by_thread:
+            line += "  [%s]" % thread
+        print(line, file=output)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the hot spots of a sampling profile")
+    parser.add_argument("elf", help="ELF file of the application")
+    parser.add_argument("input", nargs="?", help="console output with the profile, standard input by default")
+    parser.add_argument("--threads", action="store_true", help="split the functions by thread")
+    parser.add_argument("--limit", type=int, default=0, help="number of functions to list, all by default")
+    args = parser.parse_args()
+
+    with open(args.elf, "rb") as elf_file:
+        symbols = Symbols(elf_file)
+
+    profile = Profile()
+    if args.input:
+        with open(args.input, "r") as stream:
+            profile.parse(stream)
+    else:
+        profile.parse(sys.stdin)
+
+    report(profile, symbols, args.threads, args.limit, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
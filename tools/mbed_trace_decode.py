@@ -0,0 +1,218 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2019 ARM Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Decode mbed-trace deferred trace records.
+
+The records are read with mbed_trace_deferred_read() on the target and
+written as is to a file, a serial port or SWO. The format and group strings
+are read from the ELF file of the application. Records are stamped with the
+32-bit microsecond ticker, which is unwrapped into seconds since the first
+record.
+
+    python tools/mbed_trace_decode.py BUILD/app.elf trace.bin
+    python tools/mbed_trace_decode.py BUILD/app.elf --serial /dev/ttyACM0
+"""
+from __future__ import print_function
+
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+LEVELS = {
+    0x10: "DBG ",
+    0x08: "INFO",
+    0x04: "WARN",
+    0x02: "ERR ",
+}
+
+CONVERSION = re.compile(
+    r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t|L)?([diouxXcfFeEgGaApsn%])"
+)
+
+
+class Image(object):
+    """Strings, pointer and integer sizes of an ELF file"""
+
+    def __init__(self, elf_file):
+        elf = ELFFile(elf_file)
+        self.endian = "<" if elf.little_endian else ">"
+        self.pointer_size = 8 if elf.elfclass == 64 else 4
+        # Allocated sections with contents, where the strings live
+        self.sections = []
+        for section in elf.iter_sections():
+            if (section["sh_flags"] & 0x2) and section["sh_type"] != "SHT_NOBITS":
+                self.sections.append((section["sh_addr"], section.data()))
+        self.strings = {}
+
+    def string(self, address):
+        if address not in self.strings:
+            text = "<0x%x>" % address
+            for start, data in self.sections:
+                if start <= address < start + len(data):
+                    offset = address - start
+                    text = data[offset:data.index(b"\0", offset)].decode("utf-8", "replace")
+                    break
+            self.strings[address] = text
+        return self.strings[address]
+
+    def size(self, length):
+        if length in ("ll", "L", "j"):
+            return 8
+        if length in ("l", "z", "t"):
+            return self.pointer_size
+        return 4
+
+
+class Record(object):
+    """Reads the fields of a record"""
+
+    def __init__(self, image, data):
+        self.image = image
+        self.data = data
+        self.pos = 0
+
+    def integer(self, size, signed):
+        code = {4: "i", 8: "q"}[size]
+        if not signed:
+            code = code.upper()
+        value = struct.unpack_from(self.image.endian + code, self.data, self.pos)[0]
+        self.pos += size
+        return value
+
+    def double(self):
+        value = struct.unpack_from(self.image.endian + "d", self.data, self.pos)[0]
+        self.pos += 8
+        return value
+
+    def pointer(self):
+        return self.integer(self.image.pointer_size, False)
+
+    def string(self):
+        length = self.data[self.pos]
+        value = self.data[self.pos + 1:self.pos + 1 + length].decode("utf-8", "replace")
+        self.pos += 1 + length
+        return value
+
+
+def format_trace(fmt, record):
+    """Formats the arguments of a record like printf"""
+    image = record.image
+
+    def convert(match):
+        flags, width, precision, length, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        if width == "*":
+            width = str(record.integer(4, True))
+        if precision == "*":
+            precision = str(record.integer(4, True))
+        spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+        if conversion in "di":
+            return (spec + "d") % record.integer(image.size(length), True)
+        if conversion in "ouxX":
+            value = record.integer(image.size(length), False)
+            if length == "hh":
+                value &= 0xff
+            elif length == "h":
+                value &= 0xffff
+            return (spec + ("d" if conversion == "u" else conversion)) % value
+        if conversion == "c":
+            return (spec + "c") % chr(record.integer(4, False) & 0xff)
+        if conversion in "aA":
+            return record.double().hex()
+        if conversion in "fFeEgG":
+            return (spec + conversion) % record.double()
+        if conversion == "p":
+            return (spec + "s") % ("0x%x" % record.pointer())
+        if conversion == "s":
+            return (spec + "s") % record.string()
+        return ""
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(image, stream, output):
+    """Decodes records from a stream of bytes until its end"""
+    header = 6 + 2 * image.pointer_size
+    start = None
+    last = 0
+    wraps = 0
+    while True:
+        data = bytearray(stream.read(1))
+        if not data:
+            return
+        data += bytearray(stream.read(max(data[0] - 1, 0)))
+        if len(data) < data[0] or data[0] < 2:
+            return
+        record = Record(image, data)
+        record.pos = 2
+        level = data[1]
+        if level == 0:
+            print("<%d traces dropped>" % record.integer(4, False), file=output)
+            continue
+        if len(data) < header:
+            print("<invalid record>", file=output)
+            continue
+        timestamp = record.integer(4, False)
+        if start is None:
+            start = last = timestamp
+        if timestamp < last:
+            wraps += 1
+        last = timestamp
+        fmt = image.string(record.pointer())
+        group = image.string(record.pointer())
+        try:
+            text = format_trace(fmt, record)
+        except (struct.error, IndexError, TypeError, ValueError):
+            text = fmt + " <invalid arguments>"
+        seconds = ((wraps << 32) + timestamp - start) / 1000000.0
+        print("[%12.6f][%s][%-4s]: %s" % (seconds, LEVELS.get(level, "????"), group, text), file=output)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode mbed-trace deferred trace records")
+    parser.add_argument("elf", help="ELF file of the application")
+    parser.add_argument("input", nargs="?", help="file of trace records, standard input by default")
+    parser.add_argument("--serial", help="read the records from a serial port")
+    parser.add_argument("--baudrate", type=int, default=115200, help="serial port baud rate")
+    args = parser.parse_args()
+
+    with open(args.elf, "rb") as elf_file:
+        image = Image(elf_file)
+
+    if args.serial:
+        import serial
+        stream = serial.Serial(args.serial, args.baudrate)
+    elif args.input:
+        stream = open(args.input, "rb")
+    else:
+        stream = getattr(sys.stdin, "buffer", sys.stdin)
+
+    try:
+        decode(image, stream, sys.stdout)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        stream.close()
+
+
+if __name__ == "__main__":
+    main()
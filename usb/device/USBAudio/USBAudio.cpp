@@ -26,6 +26,9 @@
 #define WRITE_READY_UNBLOCK         (1 << 0)
 #define READ_READY_UNBLOCK          (1 << 1)
 
+// Frames over which the feedback brings the read buffer back to half full
+#define FEEDBACK_CORRECTION_FRAMES  64
+
 class USBAudio::AsyncWrite: public AsyncOp {
 public:
     AsyncWrite(USBAudio *audio, uint8_t *buf, uint32_t size):
@@ -85,7 +88,7 @@ public:
         }
 
         uint32_t actual_size = 0;
-        audio->read_nb(rx_buf, rx_size, &actual_size);
+        audio->_receive_read(rx_buf, rx_size, &actual_size);
         rx_buf += actual_size;
         *rx_actual += actual_size;
         rx_size -= actual_size;
@@ -152,6 +155,10 @@ void USBAudio::_init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t f
 
     _rx_overflow = 0;
     _tx_underflow = 0;
+    _rx_underflow = 0;
+    _rx_level_min = 0;
+    _rx_level_max = 0;
+    _rx_primed = false;
 
     _tx_freq = frequency_tx;
     _rx_freq = frequency_rx;
@@ -167,6 +174,10 @@ void USBAudio::_init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t f
     uint32_t max_frames = _tx_whole_frames_per_xfer + (_tx_fract_frames_per_xfer ? 1 : 0);
     _tx_packet_size_max = max_frames * SAMPLE_SIZE * _tx_channel_count;
     _rx_packet_size_max = (_rx_freq + 1000 - 1) / 1000 * _rx_channel_count * 2;
+#if USBAUDIO_ASYNC
+    // The feedback can ask for up to half a sample more per frame
+    _rx_packet_size_max += _rx_channel_count * 2;
+#endif
 
     _tx_packet_buf = new uint8_t[_tx_packet_size_max]();
     _rx_packet_buf = new uint8_t[_rx_packet_size_max]();
@@ -179,8 +190,11 @@ void USBAudio::_init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t f
 
     EndpointResolver resolver(endpoint_table());
     resolver.endpoint_ctrl(64);
-    _episo_out = resolver.endpoint_out(USB_EP_TYPE_ISO, _tx_packet_size_max);
-    _episo_in = resolver.endpoint_in(USB_EP_TYPE_ISO, _rx_packet_size_max);
+    _episo_out = resolver.endpoint_out(USB_EP_TYPE_ISO, _rx_packet_size_max);
+    _episo_in = resolver.endpoint_in(USB_EP_TYPE_ISO, _tx_packet_size_max);
+#if USBAUDIO_ASYNC
+    _episo_fb = resolver.endpoint_in(USB_EP_TYPE_ISO, sizeof(_rx_feedback));
+#endif
     MBED_ASSERT(resolver.valid());
 
     _channel_config_rx = (_rx_channel_count == 1) ? CHANNEL_M : CHANNEL_L + CHANNEL_R;
@@ -245,10 +259,13 @@ void USBAudio::read_nb(uint8_t *buf, uint32_t size, uint32_t *actual)
 
     lock();
 
-    uint32_t available = _rx_queue.size();
-    uint32_t copy_size = available > size ? size : available;
-    _rx_queue.read(buf, copy_size);
-    *actual = copy_size;
+    bool primed = _rx_primed;
+    _receive_read(buf, size, actual);
+    if (primed && (*actual < size)) {
+        // Let the buffer fill up to half again
+        _rx_underflow++;
+        _rx_primed = false;
+    }
 
     unlock();
 }
@@ -266,6 +283,38 @@ uint32_t USBAudio::read_overflows(bool clear)
     return overflows;
 }
 
+uint32_t USBAudio::read_underflows(bool clear)
+{
+    lock();
+
+    uint32_t underflows = _rx_underflow;
+    if (clear) {
+        _rx_underflow = 0;
+    }
+
+    unlock();
+    return underflows;
+}
+
+uint32_t USBAudio::read_level(uint32_t *min, uint32_t *max, bool clear)
+{
+    lock();
+
+    uint32_t level = _rx_queue.size();
+    if (min) {
+        *min = _rx_level_min;
+    }
+    if (max) {
+        *max = _rx_level_max;
+    }
+    if (clear) {
+        _rx_level_min = level;
+        _rx_level_max = level;
+    }
+
+    unlock();
+    return level;
+}
 
 bool USBAudio::read_ready()
 {
@@ -547,6 +596,11 @@ void USBAudio::callback_set_configuration(uint8_t configuration)
 
         // activate readings on this endpoint
         read_start(_episo_out, _rx_packet_buf, _rx_packet_size_max);
+
+#if USBAUDIO_ASYNC
+        endpoint_add(_episo_fb, sizeof(_rx_feedback), USB_EP_TYPE_ISO,  static_cast<ep_cb_t>(&USBAudio::_feedback_isr));
+        _feedback_isr_next();
+#endif
         ret = true;
     }
     complete_set_configuration(ret);
@@ -608,7 +662,8 @@ const uint8_t *USBAudio::string_iproduct_desc()
                                + (2 * STREAMING_INTERFACE_DESCRIPTOR_LENGTH) \
                                + (2 * FORMAT_TYPE_I_DESCRIPTOR_LENGTH) \
                                + (2 * (ENDPOINT_DESCRIPTOR_LENGTH + 2)) \
-                               + (2 * STREAMING_ENDPOINT_DESCRIPTOR_LENGTH) )
+                               + (2 * STREAMING_ENDPOINT_DESCRIPTOR_LENGTH) \
+                               + (USBAUDIO_ASYNC * (ENDPOINT_DESCRIPTOR_LENGTH + 2)) )
 
 #define TOTAL_CONTROL_INTF_LENGTH    (CONTROL_INTERFACE_DESCRIPTOR_LENGTH + 1 + \
                                       2*INPUT_TERMINAL_DESCRIPTOR_LENGTH     + \
@@ -737,7 +792,7 @@ void USBAudio::_build_configuration_desc()
         INTERFACE_DESCRIPTOR,                   // bDescriptorType
         0x01,                                   // bInterfaceNumber
         0x01,                                   // bAlternateSetting
-        0x01,                                   // bNumEndpoints
+        1 + USBAUDIO_ASYNC,                     // bNumEndpoints
         AUDIO_CLASS,                            // bInterfaceClass
         SUBCLASS_AUDIOSTREAMING,                // bInterfaceSubClass
         0x00,                                   // bInterfaceProtocol
@@ -769,12 +824,20 @@ void USBAudio::_build_configuration_desc()
         ENDPOINT_DESCRIPTOR_LENGTH + 2,         // bLength
         ENDPOINT_DESCRIPTOR,                    // bDescriptorType
         _episo_out,                             // bEndpointAddress
+#if USBAUDIO_ASYNC
+        E_ISOCHRONOUS | E_ASYNCHRONOUS,         // bmAttributes
+#else
         E_ISOCHRONOUS,                          // bmAttributes
+#endif
         (uint8_t)(LSB(_rx_packet_size_max)),    // wMaxPacketSize
         (uint8_t)(MSB(_rx_packet_size_max)),    // wMaxPacketSize
         0x01,                                   // bInterval
         0x00,                                   // bRefresh
+#if USBAUDIO_ASYNC
+        _episo_fb,                              // bSynchAddress
+#else
         0x00,                                   // bSynchAddress
+#endif
 
         // Endpoint - Audio Streaming
         STREAMING_ENDPOINT_DESCRIPTOR_LENGTH,   // bLength
@@ -785,6 +848,19 @@ void USBAudio::_build_configuration_desc()
         LSB(0x0000),                            // wLockDelay
         MSB(0x0000),                            // wLockDelay
 
+#if USBAUDIO_ASYNC
+        // Endpoint - Feedback
+        ENDPOINT_DESCRIPTOR_LENGTH + 2,         // bLength
+        ENDPOINT_DESCRIPTOR,                    // bDescriptorType
+        _episo_fb,                              // bEndpointAddress
+        E_ISOCHRONOUS,                          // bmAttributes
+        (uint8_t)(LSB(sizeof(_rx_feedback))),   // wMaxPacketSize
+        (uint8_t)(MSB(sizeof(_rx_feedback))),   // wMaxPacketSize
+        0x01,                                   // bInterval
+        USBAUDIO_FEEDBACK_REFRESH,              // bRefresh
+        0x00,                                   // bSynchAddress
+#endif
+
 
         // Interface 1, Alternate Setting 0, Audio Streaming - Zero Bandwith
         INTERFACE_DESCRIPTOR_LENGTH,            // bLength
@@ -873,6 +949,9 @@ void USBAudio::_receive_change(ChannelState new_state)
     }
     if (new_state == Opened) {
         // Entering the opened state
+        _rx_primed = false;
+        _rx_level_min = _rx_queue.size();
+        _rx_level_max = _rx_queue.size();
         _read_list.process();
         _rx_done.call(Start);
     }
@@ -884,6 +963,29 @@ void USBAudio::_receive_change(ChannelState new_state)
     }
 }
 
+void USBAudio::_receive_read(uint8_t *buf, uint32_t size, uint32_t *actual)
+{
+    assert_locked();
+
+    *actual = 0;
+    uint32_t available = _rx_queue.size();
+    if (!_rx_primed) {
+        if (available < _rx_queue.free()) {
+            // Wait for the buffer to be half full
+            return;
+        }
+        _rx_primed = true;
+    }
+
+    uint32_t copy_size = available > size ? size : available;
+    _rx_queue.read(buf, copy_size);
+    *actual = copy_size;
+
+    if (_rx_queue.size() < _rx_level_min) {
+        _rx_level_min = _rx_queue.size();
+    }
+}
+
 void USBAudio::_receive_isr()
 {
     assert_locked();
@@ -896,6 +998,9 @@ void USBAudio::_receive_isr()
 
         // Copy data over
         _rx_queue.write(_rx_packet_buf, size);
+        if (_rx_queue.size() > _rx_level_max) {
+            _rx_level_max = _rx_queue.size();
+        }
 
         // Signal that there is more data available
         _read_list.process();
@@ -907,6 +1012,43 @@ void USBAudio::_receive_isr()
     read_start(_episo_out, _rx_packet_buf, _rx_packet_size_max);
 }
 
+#if USBAUDIO_ASYNC
+void USBAudio::_feedback_isr_next()
+{
+    assert_locked();
+
+    // Nominal number of samples per frame
+    int32_t value = ((uint64_t)_rx_freq << 14) / XFER_FREQUENCY_HZ;
+
+    if (_rx_state == Opened) {
+        // Bring the read buffer back to half full, at most half a
+        // sample per frame faster or slower than the nominal rate
+        int32_t error = ((int32_t)_rx_queue.free() - (int32_t)_rx_queue.size()) / 2;
+        int32_t correction = error / (_rx_channel_count * SAMPLE_SIZE) * (1 << 14) / FEEDBACK_CORRECTION_FRAMES;
+        if (correction > (1 << 13)) {
+            correction = 1 << 13;
+        } else if (correction < -(1 << 13)) {
+            correction = -(1 << 13);
+        }
+        value += correction;
+    }
+
+    _rx_feedback[0] = (value >> 0) & 0xFF;
+    _rx_feedback[1] = (value >> 8) & 0xFF;
+    _rx_feedback[2] = (value >> 16) & 0xFF;
+    write_start(_episo_fb, _rx_feedback, sizeof(_rx_feedback));
+}
+
+void USBAudio::_feedback_isr()
+{
+    assert_locked();
+
+    write_finish(_episo_fb);
+
+    _feedback_isr_next();
+}
+#endif
+
 void USBAudio::_send_change(ChannelState new_state)
 {
     assert_locked();
@@ -28,6 +28,19 @@
 #include "ByteBuffer.h"
 #include "rtos/EventFlags.h"
 
+/* Set to 1 to make the speaker stream asynchronous. The host then sends the
+ * number of samples per frame requested on a feedback endpoint, which keeps
+ * the read buffer half full whatever the drift between the host clock and
+ * the clock reading the buffer. */
+#ifndef USBAUDIO_ASYNC
+#define USBAUDIO_ASYNC 0
+#endif
+
+/* The host reads the feedback every 2^USBAUDIO_FEEDBACK_REFRESH frames (1 to 9) */
+#ifndef USBAUDIO_FEEDBACK_REFRESH
+#define USBAUDIO_FEEDBACK_REFRESH 4
+#endif
+
 /**
 * USBAudio example
 *
@@ -80,6 +93,10 @@ public:
     * @param vendor_id Your vendor_id
     * @param product_id Your product_id
     * @param product_release Your product_release
+    *
+    * @note Audio read is buffered for buffer_ms. After the stream starts or
+    * runs dry, reads wait until the buffer is half full to absorb the jitter
+    * of the host.
     */
     USBAudio(bool connect = true, uint32_t frequency_rx = 48000, uint8_t channel_count_rx = 1, uint32_t frequency_tx = 8000, uint8_t channel_count_tx = 1, uint32_t buffer_ms = 10, uint16_t vendor_id = 0x7bb8, uint16_t product_id = 0x1111, uint16_t product_release = 0x0100);
 
@@ -156,6 +173,26 @@ public:
      */
     uint32_t read_overflows(bool clear = false);
 
+    /**
+     * Return the number of nonblocking reads which could not be satisfied
+     *
+     * The read buffer is filled to half again before the next read.
+     *
+     * @param clear Reset the underflow count back to 0
+     * @return Number of calls to read_nb which returned less data than requested
+     */
+    uint32_t read_underflows(bool clear = false);
+
+    /**
+     * Return the level of the read buffer
+     *
+     * @param min set to the lowest level since the last clear, if not NULL
+     * @param max set to the highest level since the last clear, if not NULL
+     * @param clear Reset the lowest and highest levels to the current one
+     * @return Number of bytes in the read buffer
+     */
+    uint32_t read_level(uint32_t *min = NULL, uint32_t *max = NULL, bool clear = false);
+
     /**
      * Check if the audio read channel is open
      *
@@ -276,7 +313,12 @@ private:
     void _build_configuration_desc();
 
     void _receive_change(ChannelState new_state);
+    void _receive_read(uint8_t *buf, uint32_t size, uint32_t *actual);
     void _receive_isr();
+#if USBAUDIO_ASYNC
+    void _feedback_isr_next();
+    void _feedback_isr();
+#endif
     void _send_change(ChannelState new_state);
     void _send_isr_start();
     void _send_isr_next_sync();
@@ -318,6 +360,16 @@ private:
     // Number of times data was not sent due to an underflow
     uint32_t _tx_underflow;
 
+    // Number of times a nonblocking read ran out of data
+    uint32_t _rx_underflow;
+
+    // Lowest and highest read buffer levels since last cleared
+    uint32_t _rx_level_min;
+    uint32_t _rx_level_max;
+
+    // Set once the read buffer has been filled to half
+    bool _rx_primed;
+
     // frequency in Hz
     uint32_t _tx_freq;
     uint32_t _rx_freq;
@@ -360,13 +412,19 @@ private:
     // endpoint numbers
     usb_ep_t _episo_out;    // rx endpoint
     usb_ep_t _episo_in;     // tx endpoint
+#if USBAUDIO_ASYNC
+    usb_ep_t _episo_fb;     // rx feedback endpoint
+
+    // samples per frame requested from the host, 10.14 format
+    uint8_t _rx_feedback[3];
+#endif
 
     // channel config in the configuration descriptor: master, left, right
     uint8_t _channel_config_rx;
     uint8_t _channel_config_tx;
 
     // configuration descriptor
-    uint8_t _config_descriptor[183];
+    uint8_t _config_descriptor[USBAUDIO_ASYNC ? 192 : 183];
 
     // buffer for control requests
     uint8_t _control_receive[2];
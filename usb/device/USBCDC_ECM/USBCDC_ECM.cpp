@@ -22,10 +22,6 @@
 #include "mbed_interface.h"
 #include "mbed_assert.h"
 
-#ifndef MAX_SEGMENT_SIZE
-#define MAX_SEGMENT_SIZE        (1514)
-#endif
-
 #define FLAG_WRITE_DONE         (1 << 0)
 #define FLAG_DISCONNECT         (1 << 1)
 #define FLAG_CONNECT            (1 << 2)
@@ -43,7 +39,7 @@
 #define LINK_SPEED                  (10000000)
 
 USBCDC_ECM::USBCDC_ECM(bool connect_blocking, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
-    : USBDevice(get_usb_phy(), vendor_id, product_id, product_release), _packet_filter(0), _queue(4 * EVENTS_EVENT_SIZE)
+    : USBDevice(get_usb_phy(), vendor_id, product_id, product_release), _queue(8 * EVENTS_EVENT_SIZE), _packet_filter(0)
 {
     _init();
 
@@ -57,7 +53,7 @@ USBCDC_ECM::USBCDC_ECM(bool connect_blocking, uint16_t vendor_id, uint16_t produ
 }
 
 USBCDC_ECM::USBCDC_ECM(USBPhy *phy, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
-    : USBDevice(phy, vendor_id, product_id, product_release), _packet_filter(0), _queue(4 * EVENTS_EVENT_SIZE)
+    : USBDevice(phy, vendor_id, product_id, product_release), _queue(8 * EVENTS_EVENT_SIZE), _packet_filter(0)
 {
 
     _init();
@@ -322,7 +318,7 @@ void USBCDC_ECM::callback_set_interface(uint16_t interface, uint8_t alternate)
         endpoint_add(_bulk_in, MAX_PACKET_SIZE_BULK, USB_EP_TYPE_BULK, &USBCDC_ECM::_bulk_in_callback);
         endpoint_add(_bulk_out, MAX_PACKET_SIZE_BULK, USB_EP_TYPE_BULK, &USBCDC_ECM::_bulk_out_callback);
 
-        read_start(_bulk_out, _bulk_buf, MAX_PACKET_SIZE_BULK);
+        _bulk_out_start();
 
         _queue.call(static_cast<USBCDC_ECM *>(this), &USBCDC_ECM::_notify_connect);
     }
@@ -538,6 +534,13 @@ void USBCDC_ECM::_bulk_in_callback()
     _flags.set(FLAG_WRITE_DONE);
 }
 
+void USBCDC_ECM::_bulk_out_start()
+{
+    assert_locked();
+
+    read_start(_bulk_out, _bulk_buf, MAX_PACKET_SIZE_BULK);
+}
+
 void USBCDC_ECM::_bulk_out_callback()
 {
     assert_locked();
@@ -32,6 +32,10 @@
 #define MAX_PACKET_SIZE_EP0     (64)
 #define DEFAULT_CONFIGURATION   (1)
 
+#ifndef MAX_SEGMENT_SIZE
+#define MAX_SEGMENT_SIZE        (1514)
+#endif
+
 #define PACKET_TYPE_PROMISCUOUS     (1<<0)
 #define PACKET_TYPE_ALL_MULTICAST   (1<<1)
 #define PACKET_TYPE_DIRECTED        (1<<2)
@@ -234,25 +238,52 @@ protected:
     */
     virtual void callback_reset();
 
+    /*
+    * Start receiving on the bulk OUT endpoint once the data interface is enabled
+    *
+    * Warning: Called in ISR context
+    */
+    virtual void _bulk_out_start();
+
+    /*
+    * Called when a packet has been received on the bulk OUT endpoint
+    *
+    * Warning: Called in ISR context
+    */
+    virtual void _bulk_out_callback();
+
+    /*
+    * Send one packet on the bulk IN endpoint, blocking until it is sent
+    *
+    * _write_mutex must be held.
+    *
+    * @returns true if successful false if interrupted due to a state change
+    */
+    bool _write_bulk(uint8_t *buffer, uint32_t size);
+
     uint8_t device_descriptor[18];
 
+    usb_ep_t _bulk_in;
+    usb_ep_t _bulk_out;
+
+    uint8_t _bulk_buf[MAX_PACKET_SIZE_BULK];
+
+    rtos::Mutex _write_mutex;
+
+    events::EventQueue _queue;
+
 private:
 
     usb_ep_t _int_in;
-    usb_ep_t _bulk_in;
-    usb_ep_t _bulk_out;
 
     uint8_t _config_descriptor[80];
     uint8_t _string_imac_addr[26];
 
-    uint8_t _bulk_buf[MAX_PACKET_SIZE_BULK];
     uint16_t _packet_filter;
     ByteBuffer _rx_queue;
 
     rtos::EventFlags _flags;
-    rtos::Mutex _write_mutex;
 
-    events::EventQueue _queue;
     rtos::Thread _thread;
     mbed::Callback<void()> _callback_rx;
     mbed::Callback<void()> _callback_filter;
@@ -260,10 +291,8 @@ private:
     void _init();
     void _int_callback();
     void _bulk_in_callback();
-    void _bulk_out_callback();
     bool _notify_network_connection(uint8_t value);
     bool _notify_connection_speed_change(uint32_t up, uint32_t down);
-    bool _write_bulk(uint8_t *buffer, uint32_t size);
     void _notify_connect();
 };
 
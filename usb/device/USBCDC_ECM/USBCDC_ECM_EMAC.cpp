@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "USBCDC_ECM_EMAC.h"
+#include "usb_phy_api.h"
+#include "mbed_interface.h"
+
+// Whole packets, so the last packet of a frame is read in place too
+#define RX_BUFFER_SIZE      (((MAX_SEGMENT_SIZE + MAX_PACKET_SIZE_BULK - 1) / MAX_PACKET_SIZE_BULK) * MAX_PACKET_SIZE_BULK)
+#define RX_RETRY_MS         (10)
+#define ETH_HEADER_SIZE     (14)
+#define ETH_ALIGN           (4)
+#define ETH_HWADDR_SIZE     (6)
+
+USBCDC_ECM_EMAC::USBCDC_ECM_EMAC(uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
+    : USBCDC_ECM(get_usb_phy(), vendor_id, product_id, product_release)
+{
+    _emac_init();
+    init();
+}
+
+USBCDC_ECM_EMAC::USBCDC_ECM_EMAC(USBPhy *phy, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
+    : USBCDC_ECM(phy, vendor_id, product_id, product_release)
+{
+    _emac_init();
+}
+
+USBCDC_ECM_EMAC::~USBCDC_ECM_EMAC()
+{
+    deinit();
+}
+
+void USBCDC_ECM_EMAC::_emac_init()
+{
+    _memory_manager = NULL;
+    _hwaddr_set = false;
+    _powered = false;
+    _link_up = false;
+
+    _rx_frame = NULL;
+    _rx_spare = NULL;
+    _rx_done = NULL;
+    _rx_done_len = 0;
+    _rx_len = 0;
+    _rx_active = false;
+    _rx_reading = false;
+    _rx_discard = false;
+    _rx_pending = false;
+}
+
+uint32_t USBCDC_ECM_EMAC::get_mtu_size() const
+{
+    return MAX_SEGMENT_SIZE - ETH_HEADER_SIZE;
+}
+
+uint32_t USBCDC_ECM_EMAC::get_align_preference() const
+{
+    return ETH_ALIGN;
+}
+
+void USBCDC_ECM_EMAC::get_ifname(char *name, uint8_t size) const
+{
+    memcpy(name, "us", (size < 2) ? size : 2);
+}
+
+uint8_t USBCDC_ECM_EMAC::get_hwaddr_size() const
+{
+    return ETH_HWADDR_SIZE;
+}
+
+bool USBCDC_ECM_EMAC::get_hwaddr(uint8_t *addr) const
+{
+    if (_hwaddr_set) {
+        memcpy(addr, _hwaddr, ETH_HWADDR_SIZE);
+    } else {
+        // The board address is given to the host in the iMacAddress
+        // string, this end of the link needs another one
+        mbed_mac_address((char *)addr);
+        addr[5] ^= 0x01;
+    }
+    return true;
+}
+
+void USBCDC_ECM_EMAC::set_hwaddr(const uint8_t *addr)
+{
+    memcpy(_hwaddr, addr, ETH_HWADDR_SIZE);
+    _hwaddr_set = true;
+}
+
+bool USBCDC_ECM_EMAC::link_out(emac_mem_buf_t *buf)
+{
+    _write_mutex.lock();
+
+    uint32_t total = _memory_manager->get_total_len(buf);
+    bool ret = ready() && (total <= MAX_SEGMENT_SIZE);
+
+    emac_mem_buf_t *seg = buf;
+    uint32_t offset = 0;
+    uint32_t sent = 0;
+    while (ret && (sent < total)) {
+        while (offset == _memory_manager->get_len(seg)) {
+            seg = _memory_manager->get_next(seg);
+            offset = 0;
+        }
+
+        uint32_t size = (total - sent > MAX_PACKET_SIZE_BULK) ? MAX_PACKET_SIZE_BULK : total - sent;
+        uint8_t *data = static_cast<uint8_t *>(_memory_manager->get_ptr(seg)) + offset;
+        if (_memory_manager->get_len(seg) - offset >= size) {
+            // Send the packet straight from the buffer
+            offset += size;
+        } else {
+            // The packet spans buffers, gather it
+            uint32_t copied = 0;
+            while (copied < size) {
+                while (offset == _memory_manager->get_len(seg)) {
+                    seg = _memory_manager->get_next(seg);
+                    offset = 0;
+                }
+                uint32_t left = _memory_manager->get_len(seg) - offset;
+                uint32_t chunk = (left > size - copied) ? size - copied : left;
+                memcpy(_bulk_buf + copied, static_cast<uint8_t *>(_memory_manager->get_ptr(seg)) + offset, chunk);
+                copied += chunk;
+                offset += chunk;
+            }
+            data = _bulk_buf;
+        }
+
+        ret = _write_bulk(data, size);
+        sent += size;
+    }
+
+    /* Send zero length packet */
+    if (ret && (total % MAX_PACKET_SIZE_BULK == 0)) {
+        ret = _write_bulk(_bulk_buf, 0);
+    }
+
+    _write_mutex.unlock();
+
+    _memory_manager->free(buf);
+    return ret;
+}
+
+bool USBCDC_ECM_EMAC::power_up()
+{
+    lock();
+
+    _powered = true;
+
+    unlock();
+
+    _rx_process();
+    connect();
+    return true;
+}
+
+void USBCDC_ECM_EMAC::power_down()
+{
+    disconnect();
+
+    lock();
+
+    _powered = false;
+    _rx_active = false;
+    emac_mem_buf_t *bufs[] = {_rx_frame, _rx_spare, _rx_done};
+    _rx_frame = NULL;
+    _rx_spare = NULL;
+    _rx_done = NULL;
+
+    unlock();
+
+    for (uint32_t i = 0; i < sizeof(bufs) / sizeof(bufs[0]); i++) {
+        if (bufs[i] != NULL) {
+            _memory_manager->free(bufs[i]);
+        }
+    }
+}
+
+void USBCDC_ECM_EMAC::set_link_input_cb(emac_link_input_cb_t input_cb)
+{
+    _input_cb = input_cb;
+}
+
+void USBCDC_ECM_EMAC::set_link_state_cb(emac_link_state_change_cb_t state_cb)
+{
+    _state_cb = state_cb;
+}
+
+void USBCDC_ECM_EMAC::add_multicast_group(const uint8_t *address)
+{
+    /* The host sends all the frames, the stack filters them */
+}
+
+void USBCDC_ECM_EMAC::remove_multicast_group(const uint8_t *address)
+{
+    /* The host sends all the frames, the stack filters them */
+}
+
+void USBCDC_ECM_EMAC::set_all_multicast(bool all)
+{
+    /* The host sends all the frames, the stack filters them */
+}
+
+void USBCDC_ECM_EMAC::set_memory_manager(EMACMemoryManager &mem_mngr)
+{
+    _memory_manager = &mem_mngr;
+}
+
+void USBCDC_ECM_EMAC::callback_state_change(DeviceState new_state)
+{
+    assert_locked();
+    /* Called in ISR context */
+
+    USBCDC_ECM::callback_state_change(new_state);
+
+    if (new_state != Configured) {
+        _rx_active = false;
+        _rx_reading = false;
+        _link_change(false);
+    }
+}
+
+void USBCDC_ECM_EMAC::callback_set_interface(uint16_t interface, uint8_t alternate)
+{
+    assert_locked();
+    /* Called in ISR context */
+
+    if (!alternate) {
+        _rx_active = false;
+    }
+
+    USBCDC_ECM::callback_set_interface(interface, alternate);
+
+    _link_change(alternate != 0);
+}
+
+void USBCDC_ECM_EMAC::_bulk_out_start()
+{
+    assert_locked();
+
+    _rx_active = true;
+    _rx_reading = false;
+    _rx_len = 0;
+    _rx_discard = false;
+    _read_next();
+}
+
+void USBCDC_ECM_EMAC::_read_next()
+{
+    assert_locked();
+
+    if (!_rx_active || _rx_reading || (_rx_frame == NULL)) {
+        // Resumed once there is a buffer to read into
+        return;
+    }
+
+    uint8_t *data = static_cast<uint8_t *>(_memory_manager->get_ptr(_rx_frame));
+    if (_rx_len + MAX_PACKET_SIZE_BULK <= RX_BUFFER_SIZE) {
+        data += _rx_len;
+    } else {
+        // Oversized frame, drain it over the last packet of the buffer
+        data += RX_BUFFER_SIZE - MAX_PACKET_SIZE_BULK;
+        _rx_discard = true;
+    }
+
+    if (read_start(_bulk_out, data, MAX_PACKET_SIZE_BULK)) {
+        _rx_reading = true;
+    }
+}
+
+void USBCDC_ECM_EMAC::_bulk_out_callback()
+{
+    assert_locked();
+    /* Called in ISR context */
+
+    uint32_t read_size = read_finish(_bulk_out);
+    _rx_reading = false;
+    if (!_rx_active) {
+        return;
+    }
+
+    _rx_len += read_size;
+    if (read_size < MAX_PACKET_SIZE_BULK) {
+        // Short packet, the frame is complete
+        if (!_rx_discard && (_rx_len > 0) && (_rx_done == NULL)) {
+            _rx_done = _rx_frame;
+            _rx_done_len = _rx_len;
+            _rx_frame = _rx_spare;
+            _rx_spare = NULL;
+        }
+        _rx_len = 0;
+        _rx_discard = false;
+
+        if (!_rx_pending) {
+            _rx_pending = true;
+            _queue.call(this, &USBCDC_ECM_EMAC::_rx_process);
+        }
+    }
+
+    _read_next();
+}
+
+void USBCDC_ECM_EMAC::_rx_process()
+{
+    lock();
+
+    emac_mem_buf_t *frame = _rx_done;
+    uint32_t len = _rx_done_len;
+    _rx_done = NULL;
+    _rx_pending = false;
+
+    unlock();
+
+    if (frame != NULL) {
+        _memory_manager->set_len(frame, len);
+        if (_input_cb) {
+            _input_cb(frame);
+        } else {
+            _memory_manager->free(frame);
+        }
+    }
+
+    // Allocate the buffers of the next frames
+    while (true) {
+        lock();
+        bool needed = _powered && ((_rx_frame == NULL) || (_rx_spare == NULL));
+        unlock();
+        if (!needed) {
+            break;
+        }
+
+        emac_mem_buf_t *buf = _memory_manager->alloc_heap(RX_BUFFER_SIZE, ETH_ALIGN);
+        if (buf == NULL) {
+            // Out of memory, the host is held off until a buffer is available
+            lock();
+            if (!_rx_pending) {
+                _rx_pending = true;
+                _queue.call_in(RX_RETRY_MS, this, &USBCDC_ECM_EMAC::_rx_process);
+            }
+            unlock();
+            break;
+        }
+
+        lock();
+        if (_rx_frame == NULL) {
+            _rx_frame = buf;
+            _read_next();
+        } else {
+            _rx_spare = buf;
+        }
+        unlock();
+    }
+}
+
+void USBCDC_ECM_EMAC::_link_change(bool up)
+{
+    assert_locked();
+
+    if (_link_up != up) {
+        _link_up = up;
+        _queue.call(this, &USBCDC_ECM_EMAC::_link_report, up);
+    }
+}
+
+void USBCDC_ECM_EMAC::_link_report(bool up)
+{
+    if (_state_cb) {
+        _state_cb(up);
+    }
+}
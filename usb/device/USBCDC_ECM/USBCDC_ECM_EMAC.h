@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USBCDC_ECM_EMAC_H
+#define USBCDC_ECM_EMAC_H
+
+#include "USBCDC_ECM.h"
+#include "EMAC.h"
+
+/**
+* EMAC on top of USBCDC_ECM
+*
+* The host sees a USB network adapter and the network stack of this device
+* is at the other end of the link. Frames are received straight into
+* buffers of the memory manager and sent straight from them, packet by
+* packet, so they are not copied on their way between USB and the stack.
+*
+* @code
+* #include "mbed.h"
+* #include "EMACInterface.h"
+* #include "USBCDC_ECM_EMAC.h"
+*
+* USBCDC_ECM_EMAC usb_emac;
+* EMACInterface net(usb_emac);
+*
+* int main() {
+*     // The host uses 192.168.7.1
+*     net.set_network("192.168.7.2", "255.255.255.0", "192.168.7.1");
+*     net.connect();
+*
+*     printf("IP address %s\r\n", net.get_ip_address());
+* }
+* @endcode
+*/
+class USBCDC_ECM_EMAC: public USBCDC_ECM, public EMAC {
+public:
+
+    /**
+    * Basic constructor
+    *
+    * The device connects when the network stack powers the EMAC up.
+    *
+    * @note Do not use this constructor in derived classes.
+    *
+    * @param vendor_id Your vendor_id
+    * @param product_id Your product_id
+    * @param product_release Your product_release
+    */
+    USBCDC_ECM_EMAC(uint16_t vendor_id = 0x0700, uint16_t product_id = 0x0101, uint16_t product_release = 0x0001);
+
+    /**
+    * Fully featured constructor
+    *
+    * Construct this object with the supplied USBPhy and parameters. The user
+    * this object is responsible for calling init().
+    *
+    * @note Derived classes must use this constructor and call init()
+    * themselves. Derived classes should also call deinit() in their
+    * destructor. This ensures that no interrupts can occur when the
+    * object is partially constructed or destroyed.
+    *
+    * @param phy USB phy to use
+    * @param vendor_id Your vendor_id
+    * @param product_id Your product_id
+    * @param product_release Your product_release
+    */
+    USBCDC_ECM_EMAC(USBPhy *phy, uint16_t vendor_id, uint16_t product_id, uint16_t product_release);
+
+    /**
+     * Destroy this object
+     *
+     * Any classes which inherit from this class must call deinit
+     * before this destructor runs.
+     */
+    virtual ~USBCDC_ECM_EMAC();
+
+    virtual uint32_t get_mtu_size() const;
+    virtual uint32_t get_align_preference() const;
+    virtual void get_ifname(char *name, uint8_t size) const;
+    virtual uint8_t get_hwaddr_size() const;
+    virtual bool get_hwaddr(uint8_t *addr) const;
+    virtual void set_hwaddr(const uint8_t *addr);
+    virtual bool link_out(emac_mem_buf_t *buf);
+    virtual bool power_up();
+    virtual void power_down();
+    virtual void set_link_input_cb(emac_link_input_cb_t input_cb);
+    virtual void set_link_state_cb(emac_link_state_change_cb_t state_cb);
+    virtual void add_multicast_group(const uint8_t *address);
+    virtual void remove_multicast_group(const uint8_t *address);
+    virtual void set_all_multicast(bool all);
+    virtual void set_memory_manager(EMACMemoryManager &mem_mngr);
+
+protected:
+
+    virtual void callback_state_change(DeviceState new_state);
+    virtual void callback_set_interface(uint16_t interface, uint8_t alternate);
+    virtual void _bulk_out_start();
+    virtual void _bulk_out_callback();
+
+private:
+
+    void _emac_init();
+    void _read_next();
+    void _rx_process();
+    void _link_change(bool up);
+    void _link_report(bool up);
+
+    EMACMemoryManager *_memory_manager;
+    emac_link_input_cb_t _input_cb;
+    emac_link_state_change_cb_t _state_cb;
+    uint8_t _hwaddr[6];
+    bool _hwaddr_set;
+    bool _powered;
+    bool _link_up;
+
+    // Frame being received, next one and last one received
+    emac_mem_buf_t *_rx_frame;
+    emac_mem_buf_t *_rx_spare;
+    emac_mem_buf_t *_rx_done;
+    uint32_t _rx_done_len;
+
+    // Bytes received in the current frame
+    uint32_t _rx_len;
+
+    // Data interface enabled by the host
+    bool _rx_active;
+
+    // A packet is being read
+    bool _rx_reading;
+
+    // Current frame doesn't fit, drop it
+    bool _rx_discard;
+
+    // _rx_process has been queued
+    bool _rx_pending;
+};
+
+#endif
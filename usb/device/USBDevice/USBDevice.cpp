@@ -47,6 +47,7 @@
 /* Other defines */
 #define ENDPOINT_ENABLED (1 << 0)
 #define ENDPOINT_STALLED (1 << 1)
+#define ENDPOINT_RESULT  (1 << 2)
 
 /* The maximum wMaxPacketSize for endpoint 0 */
 #if defined(MAX_PACKET_SIZE_EP0)
@@ -936,6 +937,15 @@ void USBDevice::out(usb_ep_t endpoint)
 
     MBED_ASSERT(info->pending >= 1);
     info->pending -= 1;
+#if USBDEVICE_ENDPOINT_QUEUE > 1
+    info->flags &= ~ENDPOINT_RESULT;
+    if (info->pending) {
+        // Keep the endpoint busy, the result is kept for read_finish
+        info->result_size = _phy->endpoint_read_result(endpoint);
+        info->flags |= ENDPOINT_RESULT;
+        _start_queued(endpoint, info);
+    }
+#endif
     if (info->callback) {
         (this->*(info->callback))();
     }
@@ -954,6 +964,15 @@ void USBDevice::in(usb_ep_t endpoint)
 
     MBED_ASSERT(info->pending >= 1);
     info->pending -= 1;
+#if USBDEVICE_ENDPOINT_QUEUE > 1
+    info->flags &= ~ENDPOINT_RESULT;
+    if (info->pending) {
+        // Keep the endpoint busy, the result is kept for write_finish
+        info->result_size = info->transfer_size;
+        info->flags |= ENDPOINT_RESULT;
+        _start_queued(endpoint, info);
+    }
+#endif
     if (info->callback) {
         (this->*(info->callback))();
     }
@@ -1323,6 +1342,7 @@ void USBDevice::endpoint_abort(usb_ep_t endpoint)
         _phy->endpoint_abort(endpoint);
         info->pending = 0;
     }
+    info->flags &= ~ENDPOINT_RESULT;
 
     unlock();
 }
@@ -1351,12 +1371,23 @@ bool USBDevice::read_start(usb_ep_t endpoint, uint8_t *buffer, uint32_t max_size
         return false;
     }
 
-    if (info->pending) {
-        // Only allow 1 packet
+    if (info->pending >= USBDEVICE_ENDPOINT_QUEUE) {
+        // Only allow USBDEVICE_ENDPOINT_QUEUE packets
         unlock();
         return false;
     }
 
+#if USBDEVICE_ENDPOINT_QUEUE > 1
+    if (info->pending) {
+        // Started when the previous transfers complete
+        info->queue[info->pending - 1].buffer = buffer;
+        info->queue[info->pending - 1].size = info->max_packet_size;
+        info->pending += 1;
+        unlock();
+        return true;
+    }
+#endif
+
     bool ret = _phy->endpoint_read(endpoint, buffer, info->max_packet_size);
     if (ret) {
         info->pending += 1;
@@ -1386,6 +1417,14 @@ uint32_t USBDevice::read_finish(usb_ep_t endpoint)
     }
 
     uint32_t size = 0;
+#if USBDEVICE_ENDPOINT_QUEUE > 1
+    if (info->flags & ENDPOINT_RESULT) {
+        info->flags &= ~ENDPOINT_RESULT;
+        size = info->result_size;
+        unlock();
+        return size;
+    }
+#endif
     size = _phy->endpoint_read_result(endpoint);
     unlock();
     return size;
@@ -1416,12 +1455,23 @@ bool USBDevice::write_start(usb_ep_t endpoint, uint8_t *buffer, uint32_t size)
         return false;
     }
 
-    if (info->pending) {
-        // Only allow 1 packet
+    if (info->pending >= USBDEVICE_ENDPOINT_QUEUE) {
+        // Only allow USBDEVICE_ENDPOINT_QUEUE packets
         unlock();
         return false;
     }
 
+#if USBDEVICE_ENDPOINT_QUEUE > 1
+    if (info->pending) {
+        // Started when the previous transfers complete
+        info->queue[info->pending - 1].buffer = buffer;
+        info->queue[info->pending - 1].size = size;
+        info->pending += 1;
+        unlock();
+        return true;
+    }
+#endif
+
     /* Send report */
     bool ret = _phy->endpoint_write(endpoint, buffer, size);
     if (ret) {
@@ -1456,11 +1506,43 @@ uint32_t USBDevice::write_finish(usb_ep_t endpoint)
     }
 
     ret = info->transfer_size;
+#if USBDEVICE_ENDPOINT_QUEUE > 1
+    if (info->flags & ENDPOINT_RESULT) {
+        info->flags &= ~ENDPOINT_RESULT;
+        ret = info->result_size;
+    }
+#endif
 
     unlock();
     return ret;
 }
 
+#if USBDEVICE_ENDPOINT_QUEUE > 1
+void USBDevice::_start_queued(usb_ep_t endpoint, endpoint_info_t *info)
+{
+    assert_locked();
+
+    endpoint_transfer_t next = info->queue[0];
+    for (uint32_t i = 1; i < info->pending; i++) {
+        info->queue[i - 1] = info->queue[i];
+    }
+
+    bool ret;
+    if (endpoint & 0x80) {
+        ret = _phy->endpoint_write(endpoint, next.buffer, next.size);
+        info->transfer_size = next.size;
+    } else {
+        ret = _phy->endpoint_read(endpoint, next.buffer, next.size);
+    }
+
+    if (!ret) {
+        // The queued transfers are dropped, as if aborted
+        info->transfer_size = 0;
+        info->pending = 0;
+    }
+}
+#endif
+
 const uint8_t *USBDevice::device_desc()
 {
     uint8_t device_descriptor_temp[] = {
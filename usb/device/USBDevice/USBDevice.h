@@ -23,6 +23,14 @@
 #include "USBPhy.h"
 #include "mbed_critical.h"
 
+/* Transfers which can be started on an endpoint before the first one
+ * completes. The next transfer is started as soon as the previous one
+ * completes, before the endpoint callback runs, so classes can keep a
+ * bulk pipe busy. 1 keeps a single transfer per endpoint. */
+#ifndef USBDEVICE_ENDPOINT_QUEUE
+#define USBDEVICE_ENDPOINT_QUEUE 1
+#endif
+
 /**
  * \defgroup usb_device USB Device
  *
@@ -223,6 +231,10 @@ public:
      * Start a read on the given endpoint. The data buffer must remain
      * unchanged until the transfer either completes or is aborted.
      *
+     * Up to USBDEVICE_ENDPOINT_QUEUE reads can be started before the first
+     * one completes. They complete in order, each with a call of the
+     * endpoint callback, where read_finish gives its size.
+     *
      * @param endpoint endpoint to read data from
      * @param buffer buffer to fill with read data
      * @param size The size of data to read. This must be greater than or equal
@@ -246,6 +258,10 @@ public:
      * Write data to an endpoint. The data sent must remain unchanged until
      * the transfer either completes or is aborted.
      *
+     * Up to USBDEVICE_ENDPOINT_QUEUE writes can be started before the first
+     * one completes. They complete in order, each with a call of the
+     * endpoint callback, where write_finish gives its size.
+     *
      * @param endpoint endpoint to write data to
      * @param buffer data to write
      * @param size the size of data to send. This must be less than or equal to the
@@ -546,14 +562,29 @@ private:
     void _complete_set_configuration();
     void _complete_set_interface();
 
+    struct endpoint_transfer_t {
+        uint8_t *buffer;
+        uint32_t size;
+    };
+
     struct endpoint_info_t {
         ep_cb_t callback;
         uint16_t max_packet_size;
         uint16_t transfer_size;
         uint8_t flags;
         uint8_t pending;
+#if USBDEVICE_ENDPOINT_QUEUE > 1
+        // Result of the completed transfer when the next one has been started
+        uint16_t result_size;
+        // Transfers waiting for the one in progress, pending - 1 of them
+        endpoint_transfer_t queue[USBDEVICE_ENDPOINT_QUEUE - 1];
+#endif
     };
 
+#if USBDEVICE_ENDPOINT_QUEUE > 1
+    void _start_queued(usb_ep_t endpoint, endpoint_info_t *info);
+#endif
+
     struct usb_device_t {
         volatile DeviceState state;
         uint8_t configuration;
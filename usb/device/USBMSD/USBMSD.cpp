@@ -105,6 +105,12 @@ void USBMSD::_init()
     memset((void *)&_cbw, 0, sizeof(CBW));
     memset((void *)&_csw, 0, sizeof(CSW));
     _page = NULL;
+    _page_cur = NULL;
+    _page_addr = 0;
+    _page_length = 0;
+    _next_length = 0;
+    _page_size = 0;
+    _bulk_out_data = _bulk_out_buf;
 }
 
 USBMSD::~USBMSD()
@@ -145,12 +151,20 @@ bool USBMSD::connect()
         _block_size = _memory_size / _block_count;
         if (_block_size != 0) {
             free(_page);
-            _page = (uint8_t *)malloc(_block_size * sizeof(uint8_t));
+            _page = NULL;
+            // smaller pages if there is not enough memory, down to one block
+            for (uint32_t blocks = USBMSD_PAGE_BLOCKS; blocks && (_page == NULL); blocks /= 2) {
+                _page_size = blocks * _block_size;
+                _page = (uint8_t *)malloc(2 * _page_size * sizeof(uint8_t));
+            }
             if (_page == NULL) {
                 _mutex.unlock();
                 _mutex_init.unlock();
                 return false;
             }
+            _page_cur = _page;
+            _page_length = 0;
+            _next_length = 0;
         }
     } else {
         _mutex.unlock();
@@ -195,6 +209,7 @@ void USBMSD::disconnect()
     //De-allocate MSD page size:
     free(_page);
     _page = NULL;
+    _page_cur = NULL;
 
     _mutex.unlock();
     _mutex_init.unlock();
@@ -484,7 +499,7 @@ void USBMSD::_process()
             if (!_out_ready) {
                 break;
             }
-            CBWDecode(_bulk_out_buf, _bulk_out_size);
+            CBWDecode(_bulk_out_data, _bulk_out_size);
             _read_next();
             break;
 
@@ -497,14 +512,14 @@ void USBMSD::_process()
                     if (!_out_ready) {
                         break;
                     }
-                    memoryWrite(_bulk_out_buf, _bulk_out_size);
-                    _read_next();
+                    // the next read is started by memoryWrite
+                    memoryWrite(_bulk_out_data, _bulk_out_size);
                     break;
                 case VERIFY10:
                     if (!_out_ready) {
                         break;
                     }
-                    memoryVerify(_bulk_out_buf, _bulk_out_size);
+                    memoryVerify(_bulk_out_data, _bulk_out_size);
                     _read_next();
                     break;
                 // the device has to send data to the host
@@ -555,12 +570,39 @@ void USBMSD::_read_next()
     lock();
 
     MBED_ASSERT(_out_ready);
-    read_start(_bulk_out, _bulk_out_buf, sizeof(_bulk_out_buf));
+    _bulk_out_data = _bulk_out_buf;
+    // data to write is received straight in the page
+    if ((_stage == PROCESS_CBW) && ((_cbw.CB[0] == WRITE10) || (_cbw.CB[0] == WRITE12))) {
+        _bulk_out_data = &_page_cur[_addr - _page_addr];
+    }
+    read_start(_bulk_out, _bulk_out_data, MAX_PACKET);
     _out_ready = false;
 
     unlock();
 }
 
+uint8_t *USBMSD::_other_page()
+{
+    return (_page_cur == _page) ? _page + _page_size : _page;
+}
+
+uint32_t USBMSD::_page_read(uint8_t *page, uint32_t addr)
+{
+    // as many blocks of the transfer as a page can hold
+    if (addr >= _memory_size) {
+        return 0;
+    }
+    uint32_t size = (_length < _memory_size - addr) ? _length : _memory_size - addr;
+    uint32_t count = (size + _block_size - 1) / _block_size;
+    if (count > _page_size / _block_size) {
+        count = _page_size / _block_size;
+    }
+    if (count) {
+        disk_read(page, addr / _block_size, count);
+    }
+    return count * _block_size;
+}
+
 void USBMSD::memoryWrite(uint8_t *buf, uint16_t size)
 {
     if ((_addr + size) > _memory_size) {
@@ -569,25 +611,39 @@ void USBMSD::memoryWrite(uint8_t *buf, uint16_t size)
         endpoint_stall(_bulk_out);
     }
 
-    // we fill an array in RAM of 1 block before writing it in memory
-    for (int i = 0; i < size; i++) {
-        _page[_addr % _block_size + i] = buf[i];
-    }
-
-    // if the array is filled, write it in memory
-    if (!((_addr + size) % _block_size)) {
-        if (!(disk_status() & WRITE_PROTECT)) {
-            disk_write(_page, _addr / _block_size, 1);
-        }
-    }
+    // we fill a page in RAM before writing it in memory, the packet has
+    // already been received in it by _read_next
+    MBED_ASSERT(buf == &_page_cur[_addr - _page_addr]);
 
     _addr += size;
     _length -= size;
     _csw.DataResidue -= size;
 
-    if ((!_length) || (_stage != PROCESS_CBW)) {
+    bool done = (!_length) || (_stage != PROCESS_CBW);
+    if (!done && (_addr - _page_addr < _page_size)) {
+        _read_next();
+        return;
+    }
+
+    // the page is filled: receive the next packet in the other page while
+    // this one is written in memory
+    uint8_t *data = _page_cur;
+    uint32_t block = _page_addr / _block_size;
+    uint32_t count = (_addr - _page_addr) / _block_size;
+    _page_cur = _other_page();
+    _page_addr = _addr;
+    if (!done) {
+        _read_next();
+    }
+
+    if (count && !(disk_status() & WRITE_PROTECT)) {
+        disk_write(data, block, count);
+    }
+
+    if (done) {
         _csw.Status = (_stage == ERROR) ? CSW_FAILED : CSW_PASSED;
         sendCSW();
+        _read_next();
     }
 }
 
@@ -601,14 +657,15 @@ void USBMSD::memoryVerify(uint8_t *buf, uint16_t size)
         endpoint_stall(_bulk_out);
     }
 
-    // beginning of a new block -> load a whole block in RAM
-    if (!(_addr % _block_size)) {
-        disk_read(_page, _addr / _block_size, 1);
+    // end of the page -> load the next blocks in RAM
+    if (_addr >= _page_addr + _page_length) {
+        _page_addr = _addr;
+        _page_length = _page_read(_page_cur, _addr);
     }
 
     // info are in RAM -> no need to re-read memory
     for (n = 0; n < size; n++) {
-        if (_page[_addr % _block_size + n] != buf[n]) {
+        if (_page_cur[_addr - _page_addr + n] != buf[n]) {
             _mem_ok = false;
             break;
         }
@@ -860,13 +917,26 @@ void USBMSD::memoryRead(void)
         _stage = ERROR;
     }
 
-    // we read an entire block
-    if (!(_addr % _block_size)) {
-        disk_read(_page, _addr / _block_size, 1);
+    // the page has been sent: continue with the page read ahead, or read
+    // a new one
+    if (_addr >= _page_addr + _page_length) {
+        if (_next_length) {
+            _page_cur = _other_page();
+            _page_length = _next_length;
+            _next_length = 0;
+        } else {
+            _page_length = _page_read(_page_cur, _addr);
+        }
+        _page_addr = _addr;
     }
 
-    // write data which are in RAM
-    _write_next(&_page[_addr % _block_size], MAX_PACKET);
+    // write data which are in RAM, straight from the page which is left
+    // untouched until the packet has been sent
+    lock();
+    MBED_ASSERT(_in_ready);
+    write_start(_bulk_in, &_page_cur[_addr - _page_addr], n);
+    _in_ready = false;
+    unlock();
 
     _addr += n;
     _length -= n;
@@ -876,6 +946,9 @@ void USBMSD::memoryRead(void)
     if (!_length || (_stage != PROCESS_CBW)) {
         _csw.Status = (_stage == PROCESS_CBW) ? CSW_PASSED : CSW_FAILED;
         _stage = (_stage == PROCESS_CBW) ? SEND_CSW : _stage;
+    } else if (_addr == _page_addr + _page_length) {
+        // read the next page while the last packet of this one is sent
+        _next_length = _page_read(_other_page(), _addr);
     }
 }
 
@@ -905,6 +978,11 @@ bool USBMSD::infoTransfer(void)
 
     _length = n * _block_size;
 
+    // nothing of this transfer in the pages yet
+    _page_addr = _addr;
+    _page_length = 0;
+    _next_length = 0;
+
     if (!_cbw.DataLength) {              // host requests no data
         _csw.Status = CSW_FAILED;
         sendCSW();
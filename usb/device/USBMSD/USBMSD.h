@@ -29,6 +29,12 @@
 
 #include "USBDevice.h"
 
+/* Blocks read from or written to the block device at once. Two pages of
+ * this size are allocated when the device connects. */
+#ifndef USBMSD_PAGE_BLOCKS
+#define USBMSD_PAGE_BLOCKS 4
+#endif
+
 /**
  * USBMSD class: generic class in order to use all kinds of blocks storage chip
  *
@@ -233,9 +239,25 @@ private:
     // memory OK (after a memoryVerify)
     bool _mem_ok;
 
-    // cache in RAM before writing in memory. Useful also to read a block.
+    // two pages of _page_size bytes, cache in RAM before writing in memory.
+    // One is transferred over USB while the other one is read from or
+    // written to the block device.
     uint8_t *_page;
 
+    // page transferred over USB
+    uint8_t *_page_cur;
+
+    // address of the first byte of _page_cur
+    uint32_t _page_addr;
+
+    // bytes read in _page_cur
+    uint32_t _page_length;
+
+    // bytes read ahead in the other page, starting at the end of _page_cur
+    uint32_t _next_length;
+
+    uint32_t _page_size;
+
     int _block_size;
     uint64_t _memory_size;
     uint64_t _block_count;
@@ -245,6 +267,8 @@ private:
     usb_ep_t _bulk_out;
     uint8_t _bulk_in_buf[64];
     uint8_t _bulk_out_buf[64];
+    // where the last packet has been received: _bulk_out_buf or a page
+    uint8_t *_bulk_out_data;
     bool _out_ready;
     bool _in_ready;
     uint32_t _bulk_out_size;
@@ -286,6 +310,8 @@ private:
     void _process();
     void _write_next(uint8_t *data, uint32_t size);
     void _read_next();
+    uint8_t *_other_page();
+    uint32_t _page_read(uint8_t *page, uint32_t addr);
 
     void CBWDecode(uint8_t *buf, uint16_t size);
     void sendCSW(void);
@@ -35,6 +35,13 @@ static const uint8_t cdc_line_coding_default[7] = {0x80, 0x25, 0x00, 0x00, 0x00,
 
 #define CDC_MAX_PACKET_SIZE    64
 
+// Bulk packets larger than 64 bytes are only allowed at high speed
+#if USBCDC_BULK_PACKET_SIZE > 64
+#define CDC_BCD_USB            0x0200
+#else
+#define CDC_BCD_USB            0x0110
+#endif
+
 class USBCDC::AsyncWrite: public AsyncOp {
 public:
     AsyncWrite(USBCDC *serial, uint8_t *buf, uint32_t size):
@@ -55,11 +62,18 @@ public:
             return true;
         }
 
-        uint32_t actual_size = 0;
-        serial->send_nb(tx_buf, tx_size, &actual_size, true);
+        if (serial->_tx_direct != NULL) {
+            // A packet is still being sent straight from tx_buf
+            return false;
+        }
+
+        uint32_t actual_size = serial->_send_direct(tx_buf, tx_size);
+        if (actual_size == 0) {
+            serial->send_nb(tx_buf, tx_size, &actual_size, true);
+        }
         tx_size -= actual_size;
         tx_buf += actual_size;
-        if (tx_size == 0) {
+        if ((tx_size == 0) && (serial->_tx_direct == NULL)) {
             result = true;
             return true;
         }
@@ -173,20 +187,24 @@ void USBCDC::_init()
 
     EndpointResolver resolver(endpoint_table());
     resolver.endpoint_ctrl(CDC_MAX_PACKET_SIZE);
-    _bulk_in = resolver.endpoint_in(USB_EP_TYPE_BULK, CDC_MAX_PACKET_SIZE);
-    _bulk_out = resolver.endpoint_out(USB_EP_TYPE_BULK, CDC_MAX_PACKET_SIZE);
+    _bulk_in = resolver.endpoint_in(USB_EP_TYPE_BULK, USBCDC_BULK_PACKET_SIZE);
+    _bulk_out = resolver.endpoint_out(USB_EP_TYPE_BULK, USBCDC_BULK_PACKET_SIZE);
     _int_in = resolver.endpoint_in(USB_EP_TYPE_INT, CDC_MAX_PACKET_SIZE);
     MBED_ASSERT(resolver.valid());
 
     _terminal_connected = false;
 
     _tx_in_progress = false;
-    _tx_buf = _tx_buffer;
-    _tx_size = 0;
+    _tx_tail = 0;
+    _tx_count = 0;
+    _tx_direct = NULL;
 
     _rx_in_progress = false;
-    _rx_buf = _rx_buffer;
+    _rx_tail = 0;
+    _rx_count = 0;
+    _rx_buf = NULL;
     _rx_size = 0;
+    _rx_available = 0;
 }
 
 void USBCDC::callback_reset()
@@ -292,11 +310,10 @@ void USBCDC::callback_set_configuration(uint8_t configuration)
     if (configuration == DEFAULT_CONFIGURATION) {
         // Configure endpoints > 0
         endpoint_add(_int_in, CDC_MAX_PACKET_SIZE, USB_EP_TYPE_INT);
-        endpoint_add(_bulk_in, CDC_MAX_PACKET_SIZE, USB_EP_TYPE_BULK, &USBCDC::_send_isr);
-        endpoint_add(_bulk_out, CDC_MAX_PACKET_SIZE, USB_EP_TYPE_BULK, &USBCDC::_receive_isr);
+        endpoint_add(_bulk_in, USBCDC_BULK_PACKET_SIZE, USB_EP_TYPE_BULK, &USBCDC::_send_isr);
+        endpoint_add(_bulk_out, USBCDC_BULK_PACKET_SIZE, USB_EP_TYPE_BULK, &USBCDC::_receive_isr);
 
-        read_start(_bulk_out, _rx_buf, sizeof(_rx_buffer));
-        _rx_in_progress = true;
+        _receive_isr_start();
 
         ret = true;
     }
@@ -321,18 +338,22 @@ void USBCDC::_change_terminal_connected(bool connected)
             endpoint_abort(_bulk_in);
             _tx_in_progress = false;
         }
-        _tx_buf = _tx_buffer;
-        _tx_size = 0;
+        _tx_tail = 0;
+        _tx_count = 0;
+        _tx_direct = NULL;
         _tx_list.process();
         MBED_ASSERT(_tx_list.empty());
 
         // Abort RX
         if (_rx_in_progress) {
-            endpoint_abort(_bulk_in);
+            endpoint_abort(_bulk_out);
             _rx_in_progress = false;
         }
-        _rx_buf = _rx_buffer;
+        _rx_tail = 0;
+        _rx_count = 0;
+        _rx_buf = NULL;
         _rx_size = 0;
+        _rx_available = 0;
         _rx_list.process();
         MBED_ASSERT(_rx_list.empty());
 
@@ -380,14 +401,8 @@ void USBCDC::send_nb(uint8_t *buffer, uint32_t size, uint32_t *actual, bool now)
     lock();
 
     *actual = 0;
-    if (_terminal_connected && !_tx_in_progress) {
-        uint32_t free = sizeof(_tx_buffer) - _tx_size;
-        uint32_t write_size = free > size ? size : free;
-        if (size > 0) {
-            memcpy(_tx_buf, buffer, write_size);
-        }
-        _tx_size += write_size;
-        *actual = write_size;
+    if (_terminal_connected) {
+        *actual = _send_queue(buffer, size);
         if (now) {
             _send_isr_start();
         }
@@ -396,12 +411,58 @@ void USBCDC::send_nb(uint8_t *buffer, uint32_t size, uint32_t *actual, bool now)
     unlock();
 }
 
+uint32_t USBCDC::_send_queue(const uint8_t *buffer, uint32_t size)
+{
+    assert_locked();
+
+    uint32_t queued = 0;
+    while (queued < size) {
+        uint8_t last = (_tx_tail + _tx_count + USBCDC_TX_PACKETS - 1) % USBCDC_TX_PACKETS;
+        bool last_busy = (_tx_count == 1) && _tx_in_progress && (_tx_direct == NULL);
+        if ((_tx_count == 0) || last_busy || (_tx_length[last] == USBCDC_BULK_PACKET_SIZE)) {
+            // Start a new packet
+            if (_tx_count == USBCDC_TX_PACKETS) {
+                break;
+            }
+            last = (_tx_tail + _tx_count) % USBCDC_TX_PACKETS;
+            _tx_length[last] = 0;
+            _tx_count++;
+        }
+
+        uint32_t free = USBCDC_BULK_PACKET_SIZE - _tx_length[last];
+        uint32_t write_size = free > size - queued ? size - queued : free;
+        memcpy(&_tx_buffer[last][_tx_length[last]], buffer + queued, write_size);
+        _tx_length[last] += write_size;
+        queued += write_size;
+    }
+    return queued;
+}
+
+uint32_t USBCDC::_send_direct(uint8_t *buffer, uint32_t size)
+{
+    assert_locked();
+
+    // Full packets are sent straight from the application buffer when
+    // nothing is queued before them and the PHY can use the buffer as is
+    if (_tx_in_progress || (_tx_count > 0) || (size < USBCDC_BULK_PACKET_SIZE) ||
+            ((uintptr_t)buffer & 0x3)) {
+        return 0;
+    }
+
+    if (!USBDevice::write_start(_bulk_in, buffer, USBCDC_BULK_PACKET_SIZE)) {
+        return 0;
+    }
+    _tx_in_progress = true;
+    _tx_direct = buffer;
+    return USBCDC_BULK_PACKET_SIZE;
+}
+
 void USBCDC::_send_isr_start()
 {
     assert_locked();
 
-    if (!_tx_in_progress && _tx_size) {
-        if (USBDevice::write_start(_bulk_in, _tx_buffer, _tx_size)) {
+    if (!_tx_in_progress && _tx_count) {
+        if (USBDevice::write_start(_bulk_in, _tx_buffer[_tx_tail], _tx_length[_tx_tail])) {
             _tx_in_progress = true;
         }
     }
@@ -415,13 +476,25 @@ void USBCDC::_send_isr()
 {
     assert_locked();
 
-    write_finish(_bulk_in);
-    _tx_buf = _tx_buffer;
-    _tx_size = 0;
+    uint32_t size = write_finish(_bulk_in);
     _tx_in_progress = false;
+    if (_tx_direct != NULL) {
+        _tx_direct = NULL;
+    } else if (size > 0) {
+        _tx_tail = (_tx_tail + 1) % USBCDC_TX_PACKETS;
+        _tx_count--;
+    }
 
     _tx_list.process();
-    if (!_tx_in_progress) {
+    _send_isr_start();
+    if (!_tx_in_progress && (size == USBCDC_BULK_PACKET_SIZE)) {
+        // End the transfer with a zero length packet so the host
+        // doesn't wait for more data
+        if (USBDevice::write_start(_bulk_in, _tx_buffer[_tx_tail], 0)) {
+            _tx_in_progress = true;
+        }
+    }
+    if (_tx_count < USBCDC_TX_PACKETS) {
         data_tx();
     }
 }
@@ -445,27 +518,41 @@ bool USBCDC::receive(uint8_t *buffer, uint32_t size,  uint32_t *size_read)
 
 void USBCDC::receive_nb(uint8_t *buffer, uint32_t size,  uint32_t *size_read)
 {
+    lock();
 
     *size_read = 0;
-    if (_terminal_connected && !_rx_in_progress) {
-        // Copy data over
-        uint32_t copy_size = _rx_size > size ? size : _rx_size;
-        memcpy(buffer, _rx_buf, copy_size);
-        *size_read = copy_size;
-        _rx_buf += copy_size;
-        _rx_size -= copy_size;
-        if (_rx_size == 0) {
-            _receive_isr_start();
+    if (_terminal_connected) {
+        // Copy data over, packet by packet
+        while ((*size_read < size) && (_rx_count > 0)) {
+            uint32_t copy_size = _rx_size > size - *size_read ? size - *size_read : _rx_size;
+            memcpy(buffer + *size_read, _rx_buf, copy_size);
+            *size_read += copy_size;
+            _rx_buf += copy_size;
+            _rx_size -= copy_size;
+            _rx_available -= copy_size;
+            if (_rx_size == 0) {
+                _rx_tail = (_rx_tail + 1) % USBCDC_RX_PACKETS;
+                _rx_count--;
+                _rx_buf = _rx_buffer[_rx_tail];
+                _rx_size = _rx_count > 0 ? _rx_length[_rx_tail] : 0;
+            }
         }
+        _receive_isr_start();
     }
+
+    unlock();
 }
 
 void USBCDC::_receive_isr_start()
 {
-    if ((_rx_size == 0) && !_rx_in_progress) {
-        // Refill the buffer
-        read_start(_bulk_out, _rx_buffer, sizeof(_rx_buffer));
-        _rx_in_progress = true;
+    assert_locked();
+
+    if (!_rx_in_progress && (_rx_count < USBCDC_RX_PACKETS)) {
+        // Refill the next free packet
+        uint8_t next = (_rx_tail + _rx_count) % USBCDC_RX_PACKETS;
+        if (read_start(_bulk_out, _rx_buffer[next], USBCDC_BULK_PACKET_SIZE)) {
+            _rx_in_progress = true;
+        }
     }
 }
 
@@ -477,15 +564,25 @@ void USBCDC::_receive_isr()
 {
     assert_locked();
 
-    MBED_ASSERT(_rx_size == 0);
-    _rx_buf = _rx_buffer;
-    _rx_size = read_finish(_bulk_out);
+    uint32_t size = read_finish(_bulk_out);
     _rx_in_progress = false;
+    if (size > 0) {
+        uint8_t next = (_rx_tail + _rx_count) % USBCDC_RX_PACKETS;
+        _rx_length[next] = size;
+        if (_rx_count == 0) {
+            _rx_buf = _rx_buffer[next];
+            _rx_size = size;
+        }
+        _rx_count++;
+        _rx_available += size;
+    }
+
+    // Keep receiving while the application catches up
+    _receive_isr_start();
     _rx_list.process();
-    if (!_rx_in_progress) {
+    if (_rx_count > 0) {
         data_rx();
     }
-
 }
 
 const uint8_t *USBCDC::device_desc()
@@ -494,7 +591,7 @@ const uint8_t *USBCDC::device_desc()
     uint8_t device_descriptor_temp[] = {
         18,                   // bLength
         1,                    // bDescriptorType
-        0x10, 0x01,           // bcdUSB
+        LSB(CDC_BCD_USB), MSB(CDC_BCD_USB), // bcdUSB
         2,                    // bDeviceClass
         0,                    // bDeviceSubClass
         0,                    // bDeviceProtocol
@@ -621,8 +718,8 @@ const uint8_t *USBCDC::configuration_desc(uint8_t index)
         ENDPOINT_DESCRIPTOR,        // bDescriptorType
         _bulk_in,                   // bEndpointAddress
         E_BULK,                     // bmAttributes (0x02=bulk)
-        LSB(CDC_MAX_PACKET_SIZE),   // wMaxPacketSize (LSB)
-        MSB(CDC_MAX_PACKET_SIZE),   // wMaxPacketSize (MSB)
+        LSB(USBCDC_BULK_PACKET_SIZE),   // wMaxPacketSize (LSB)
+        MSB(USBCDC_BULK_PACKET_SIZE),   // wMaxPacketSize (MSB)
         0,                          // bInterval
 
         // endpoint descriptor, USB spec 9.6.6, page 269-271, Table 9-13
@@ -630,8 +727,8 @@ const uint8_t *USBCDC::configuration_desc(uint8_t index)
         ENDPOINT_DESCRIPTOR,        // bDescriptorType
         _bulk_out,                  // bEndpointAddress
         E_BULK,                     // bmAttributes (0x02=bulk)
-        LSB(CDC_MAX_PACKET_SIZE),   // wMaxPacketSize (LSB)
-        MSB(CDC_MAX_PACKET_SIZE),   // wMaxPacketSize (MSB)
+        LSB(USBCDC_BULK_PACKET_SIZE),   // wMaxPacketSize (LSB)
+        MSB(USBCDC_BULK_PACKET_SIZE),   // wMaxPacketSize (MSB)
         0                           // bInterval
     };
 
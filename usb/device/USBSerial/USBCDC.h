@@ -25,6 +25,22 @@
 #include "USBDevice.h"
 #include "OperationList.h"
 
+/* Size of the bulk packets. 64 is the only size allowed at full speed,
+ * PHYs running at high speed can use 512. */
+#ifndef USBCDC_BULK_PACKET_SIZE
+#define USBCDC_BULK_PACKET_SIZE 64
+#endif
+
+/* Number of packets buffered in each direction. This lets the application
+ * write ahead of the host and the host send ahead of the application. */
+#ifndef USBCDC_TX_PACKETS
+#define USBCDC_TX_PACKETS 4
+#endif
+
+#ifndef USBCDC_RX_PACKETS
+#define USBCDC_RX_PACKETS 4
+#endif
+
 class AsyncOp;
 
 class USBCDC: public USBDevice {
@@ -85,7 +101,8 @@ public:
     /*
     * Send a buffer
     *
-    * This function blocks until the full contents have been sent.
+    * This function blocks until the full contents have been sent. Full
+    * packets of a word aligned buffer are sent without being copied.
     *
     * @param buffer buffer to be sent
     * @param size length of the buffer
@@ -96,6 +113,8 @@ public:
     /**
      * Send what there is room for
      *
+     * The data is copied to the transmit buffer of USBCDC_TX_PACKETS packets.
+     *
      * @param buffer data to send
      * @param size maximum number of bytes to send
      * @param actual a pointer to where to store the number of bytes sent
@@ -194,6 +213,8 @@ protected:
 
     void _change_terminal_connected(bool connected);
 
+    uint32_t _send_queue(const uint8_t *buffer, uint32_t size);
+    uint32_t _send_direct(uint8_t *buffer, uint32_t size);
     void _send_isr_start();
     void _send_isr();
 
@@ -213,15 +234,21 @@ protected:
 
     OperationList<AsyncWrite> _tx_list;
     bool _tx_in_progress;
-    uint8_t _tx_buffer[64];
-    uint8_t *_tx_buf;
-    uint32_t _tx_size;
+    uint8_t _tx_buffer[USBCDC_TX_PACKETS][USBCDC_BULK_PACKET_SIZE];
+    uint32_t _tx_length[USBCDC_TX_PACKETS];
+    uint8_t _tx_tail;
+    uint8_t _tx_count;
+    uint8_t *_tx_direct;
 
     OperationList<AsyncRead> _rx_list;
     bool _rx_in_progress;
-    uint8_t _rx_buffer[64];
+    uint8_t _rx_buffer[USBCDC_RX_PACKETS][USBCDC_BULK_PACKET_SIZE];
+    uint32_t _rx_length[USBCDC_RX_PACKETS];
+    uint8_t _rx_tail;
+    uint8_t _rx_count;
     uint8_t *_rx_buf;
     uint32_t _rx_size;
+    uint32_t _rx_available;
 };
 
 #endif
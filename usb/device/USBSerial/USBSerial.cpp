@@ -77,10 +77,7 @@ uint8_t USBSerial::available()
 {
     USBCDC::lock();
 
-    uint8_t size = 0;
-    if (!_rx_in_progress) {
-        size = _rx_size > 0xFF ? 0xFF : _rx_size;
-    }
+    uint8_t size = _rx_available > 0xFF ? 0xFF : _rx_available;
 
     USBCDC::unlock();
     return size;